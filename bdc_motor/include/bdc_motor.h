@@ -6,6 +6,8 @@
 #pragma once
 
 #include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
 #include "esp_err.h"
 
 #ifdef __cplusplus
@@ -54,6 +56,43 @@ esp_err_t bdc_motor_disable(bdc_motor_handle_t motor);
  */
 esp_err_t bdc_motor_set_speed(bdc_motor_handle_t motor, uint32_t speed);
 
+/**
+ * @brief Type of BDC motor ramp done callback, called from the ISR context when the target speed is reached
+ *
+ * @param motor: BDC Motor handle
+ * @param user_ctx: User context given in the ramp configuration
+ *
+ * @return Whether a high priority task has been woken up by this function
+ */
+typedef bool (*bdc_motor_ramp_done_cb_t)(bdc_motor_handle_t motor, void *user_ctx);
+
+/**
+ * @brief BDC Motor ramp configuration
+ */
+typedef struct {
+    uint32_t target_speed;            /*!< Speed at the end of the ramp, same unit as for bdc_motor_set_speed */
+    uint32_t acceleration;            /*!< Maximum speed change per second */
+    uint32_t jerk;                    /*!< Maximum acceleration change per second, for an S-curve profile. 0 for a linear ramp */
+    bdc_motor_ramp_done_cb_t done_cb; /*!< Called when the target speed is reached, can be NULL */
+    void *user_ctx;                   /*!< User context passed to done_cb */
+} bdc_motor_ramp_config_t;
+
+/**
+ * @brief Change the speed of BDC motor gradually, the speed is updated at every PWM period without the CPU of the caller
+ *
+ * @note The ramp starts from the last speed set, replaces the ramp in progress, and is canceled by bdc_motor_set_speed.
+ *       The speed only changes while the motor is enabled.
+ *
+ * @param motor: BDC Motor handle
+ * @param config: Ramp configuration
+ *
+ * @return
+ *      - ESP_OK: Start ramp successfully
+ *      - ESP_ERR_INVALID_ARG: Start ramp failed because of invalid parameters
+ *      - ESP_ERR_NOT_SUPPORTED: Start ramp failed because the ramps are not enabled for the motor
+ */
+esp_err_t bdc_motor_ramp_to_speed(bdc_motor_handle_t motor, const bdc_motor_ramp_config_t *config);
+
 /**
  * @brief Forward BDC motor
  *
@@ -124,6 +163,9 @@ typedef struct {
 typedef struct {
     int group_id;           /*!< MCPWM group number */
     uint32_t resolution_hz; /*!< MCPWM timer resolution */
+    struct {
+        uint32_t en_ramp: 1; /*!< Support bdc_motor_ramp_to_speed, at the cost of an interrupt at every PWM period */
+    } flags;                 /*!< Extra configuration flags */
 } bdc_motor_mcpwm_config_t;
 
 /**
@@ -140,6 +182,84 @@ typedef struct {
  */
 esp_err_t bdc_motor_new_mcpwm_device(const bdc_motor_config_t *motor_config, const bdc_motor_mcpwm_config_t *mcpwm_config, bdc_motor_handle_t *ret_motor);
 
+/**
+ * @brief BDC Motor group handle, motors of a group share an MCPWM timer
+ */
+typedef struct bdc_motor_group_t *bdc_motor_group_handle_t;
+
+/**
+ * @brief BDC Motor MCPWM group configuration
+ */
+typedef struct {
+    int group_id;           /*!< MCPWM group number */
+    uint32_t resolution_hz; /*!< MCPWM timer resolution */
+    uint32_t pwm_freq_hz;   /*!< PWM frequency of all motors of the group, in Hz */
+    struct {
+        uint32_t en_ramp: 1; /*!< Support bdc_motor_ramp_to_speed for the motors of the group, at the cost of an interrupt at every PWM period */
+    } flags;                 /*!< Extra configuration flags */
+} bdc_motor_mcpwm_group_config_t;
+
+/**
+ * @brief Create BDC Motor group, whose motors are driven by the same MCPWM timer
+ *
+ * @note An MCPWM group drives up to SOC_MCPWM_OPERATORS_PER_GROUP motors, one per MCPWM operator
+ *
+ * @param config: MCPWM group configuration
+ * @param ret_group: Returned BDC Motor group handle
+ * @return
+ *      - ESP_OK: Create BDC Motor group successfully
+ *      - ESP_ERR_INVALID_ARG: Create BDC Motor group failed because of invalid argument
+ *      - ESP_ERR_NO_MEM: Create BDC Motor group failed because of out of memory
+ *      - ESP_FAIL: Create BDC Motor group failed because some other error
+ */
+esp_err_t bdc_motor_new_mcpwm_group(const bdc_motor_mcpwm_group_config_t *config, bdc_motor_group_handle_t *ret_group);
+
+/**
+ * @brief Create BDC Motor in a group
+ *
+ * @note The motor is used by the same API as other motors. `pwm_freq_hz` of motor_config is not used, the group sets it.
+ *       The shared timer runs while any motor of the group is enabled.
+ *
+ * @param group: BDC Motor group handle
+ * @param motor_config: BDC Motor configuration
+ * @param ret_motor: Returned BDC Motor handle, its index in the group is the lowest index not used by other motors of the group
+ * @return
+ *      - ESP_OK: Create BDC Motor handle successfully
+ *      - ESP_ERR_INVALID_ARG: Create BDC Motor handle failed because of invalid argument
+ *      - ESP_ERR_NOT_FOUND: Create BDC Motor handle failed because the group is full
+ *      - ESP_ERR_NO_MEM: Create BDC Motor handle failed because of out of memory
+ *      - ESP_FAIL: Create BDC Motor handle failed because some other error
+ */
+esp_err_t bdc_motor_new_mcpwm_group_device(bdc_motor_group_handle_t group, const bdc_motor_config_t *motor_config, bdc_motor_handle_t *ret_motor);
+
+/**
+ * @brief Set speed of motors of a group at once
+ *
+ * The compare values of all motors are updated at the same TEZ event of the shared timer,
+ * so the motors change speed in the same PWM period.
+ *
+ * @note Can be called from ISR or timer callbacks
+ *
+ * @param group: BDC Motor group handle
+ * @param speeds: Speeds of motors, indexed by index of the motors in the group. Unused indexes are skipped
+ * @param num_speeds: Number of speeds
+ * @return
+ *      - ESP_OK: Set motor speeds successfully
+ *      - ESP_ERR_INVALID_ARG: Set motor speeds failed because of invalid parameters
+ *      - ESP_FAIL: Set motor speeds failed because other error occurred
+ */
+esp_err_t bdc_motor_group_set_speeds(bdc_motor_group_handle_t group, const uint32_t *speeds, size_t num_speeds);
+
+/**
+ * @brief Free BDC Motor group resources
+ *
+ * @param group: BDC Motor group handle
+ * @return
+ *      - ESP_OK: Free resources successfully
+ *      - ESP_ERR_INVALID_STATE: Free resources failed because motors of the group are not deleted
+ */
+esp_err_t bdc_motor_group_del(bdc_motor_group_handle_t group);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/pulse_cnt.h"
+#include "pid_ctrl.h"
+#include "bdc_motor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief BDC Motor speed controller handle
+ */
+typedef struct bdc_motor_speed_ctrl_t *bdc_motor_speed_ctrl_handle_t;
+
+/**
+ * @brief BDC Motor speed controller configuration
+ */
+typedef struct {
+    bdc_motor_handle_t motor;        /*!< Controlled motor, must be enabled and its direction set before the controller is started */
+    pcnt_unit_handle_t pcnt_unit;    /*!< Encoder counter of the motor, enabled and started. Set `accum_count` flag of the unit
+                                          and watch points at its limits, if the counter can overflow */
+    pid_ctrl_parameter_t pid_param;  /*!< PID parameters, the error is in encoder pulses per control period and the output is the motor speed */
+    uint32_t control_freq_hz;        /*!< Control loop frequency, in Hz */
+    uint32_t task_stack_size;        /*!< Control task stack size, set to 0 to use the default size (2048) */
+    uint32_t task_priority;          /*!< Control task priority, set to 0 to use the default priority (configMAX_PRIORITIES - 1) */
+    int task_core_id;                /*!< Control task core, or tskNO_AFFINITY */
+} bdc_motor_speed_ctrl_config_t;
+
+/**
+ * @brief BDC Motor speed controller status
+ */
+typedef struct {
+    int pulses;                      /*!< Encoder pulses in the last control period, absolute value */
+    float output;                    /*!< Motor speed set in the last control period */
+    uint32_t loops;                  /*!< Executed control periods */
+    uint32_t overruns;               /*!< Control periods missed because the control task was late */
+} bdc_motor_speed_ctrl_status_t;
+
+/**
+ * @brief Create BDC Motor speed controller
+ *
+ * A hardware timer wakes a control task each control period. The task reads the encoder counter, computes PID
+ * and sets the motor speed, so the loop rate doesn't depend on scheduling of application tasks.
+ *
+ * @note The controller is created stopped, with target speed 0. The motor and the counter are not owned by the controller.
+ *
+ * @param config: Speed controller configuration
+ * @param ret_ctrl: Returned speed controller handle
+ * @return
+ *      - ESP_OK: Create speed controller successfully
+ *      - ESP_ERR_INVALID_ARG: Create speed controller failed because of invalid argument
+ *      - ESP_ERR_NO_MEM: Create speed controller failed because of out of memory
+ *      - ESP_FAIL: Create speed controller failed because some other error
+ */
+esp_err_t bdc_motor_new_speed_ctrl(const bdc_motor_speed_ctrl_config_t *config, bdc_motor_speed_ctrl_handle_t *ret_ctrl);
+
+/**
+ * @brief Start the control loop
+ *
+ * @param ctrl: Speed controller handle
+ * @return
+ *      - ESP_OK: Start speed controller successfully
+ *      - ESP_ERR_INVALID_ARG: Start speed controller failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Start speed controller failed because it's already running
+ *      - ESP_FAIL: Start speed controller failed because some other error
+ */
+esp_err_t bdc_motor_speed_ctrl_start(bdc_motor_speed_ctrl_handle_t ctrl);
+
+/**
+ * @brief Stop the control loop, the motor keeps the last speed
+ *
+ * @param ctrl: Speed controller handle
+ * @return
+ *      - ESP_OK: Stop speed controller successfully
+ *      - ESP_ERR_INVALID_ARG: Stop speed controller failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Stop speed controller failed because it's not running
+ *      - ESP_FAIL: Stop speed controller failed because some other error
+ */
+esp_err_t bdc_motor_speed_ctrl_stop(bdc_motor_speed_ctrl_handle_t ctrl);
+
+/**
+ * @brief Set target speed
+ *
+ * @note Takes effect in the next control period. Can be called while the controller runs.
+ *
+ * @param ctrl: Speed controller handle
+ * @param pulses: Target speed, in encoder pulses per control period
+ * @return
+ *      - ESP_OK: Set target speed successfully
+ *      - ESP_ERR_INVALID_ARG: Set target speed failed because of invalid argument
+ */
+esp_err_t bdc_motor_speed_ctrl_set_target(bdc_motor_speed_ctrl_handle_t ctrl, float pulses);
+
+/**
+ * @brief Get status of the control loop
+ *
+ * @param ctrl: Speed controller handle
+ * @param status: Returned status
+ * @return
+ *      - ESP_OK: Get status successfully
+ *      - ESP_ERR_INVALID_ARG: Get status failed because of invalid argument
+ */
+esp_err_t bdc_motor_speed_ctrl_get_status(bdc_motor_speed_ctrl_handle_t ctrl, bdc_motor_speed_ctrl_status_t *status);
+
+/**
+ * @brief Free speed controller resources, the controller must be stopped
+ *
+ * @param ctrl: Speed controller handle
+ * @return
+ *      - ESP_OK: Free resources successfully
+ *      - ESP_ERR_INVALID_ARG: Free resources failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Free resources failed because the controller is running
+ */
+esp_err_t bdc_motor_del_speed_ctrl(bdc_motor_speed_ctrl_handle_t ctrl);
+
+#ifdef __cplusplus
+}
+#endif
@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 #include "esp_err.h"
+#include "bdc_motor.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -55,6 +56,19 @@ struct bdc_motor_t {
      */
     esp_err_t (*set_speed)(bdc_motor_t *motor, uint32_t speed);
 
+    /**
+     * @brief Change the speed of BDC motor gradually, optional
+     *
+     * @param motor: BDC Motor handle
+     * @param config: Ramp configuration
+     *
+     * @return
+     *      - ESP_OK: Start ramp successfully
+     *      - ESP_ERR_INVALID_ARG: Start ramp failed because of invalid parameters
+     *      - ESP_ERR_NOT_SUPPORTED: Start ramp failed because the ramps are not enabled for the motor
+     */
+    esp_err_t (*ramp_to_speed)(bdc_motor_t *motor, const bdc_motor_ramp_config_t *config);
+
     /**
      * @brief Forward BDC motor
      *
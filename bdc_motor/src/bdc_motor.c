@@ -31,6 +31,13 @@ esp_err_t bdc_motor_set_speed(bdc_motor_handle_t motor, uint32_t speed)
     return motor->set_speed(motor, speed);
 }
 
+esp_err_t bdc_motor_ramp_to_speed(bdc_motor_handle_t motor, const bdc_motor_ramp_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(motor && config, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(motor->ramp_to_speed, ESP_ERR_NOT_SUPPORTED, TAG, "ramp not supported");
+    return motor->ramp_to_speed(motor, config);
+}
+
 esp_err_t bdc_motor_forward(bdc_motor_handle_t motor)
 {
     ESP_RETURN_ON_FALSE(motor, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
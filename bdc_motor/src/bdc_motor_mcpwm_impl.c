@@ -4,47 +4,221 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <stdlib.h>
+#include <stdbool.h>
 #include <string.h>
 #include <sys/cdefs.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
 #include "esp_log.h"
 #include "esp_check.h"
+#include "esp_attr.h"
+#include "soc/soc_caps.h"
 #include "driver/mcpwm_prelude.h"
 #include "bdc_motor.h"
 #include "bdc_motor_interface.h"
 
 static const char *TAG = "bdc_motor_mcpwm";
 
+#define BDC_MOTOR_GROUP_MAX_MOTORS SOC_MCPWM_OPERATORS_PER_GROUP
+#define BDC_MOTOR_RAMP_MAX_STEPS   (1 << 30)
+
+typedef struct bdc_motor_mcpwm_obj bdc_motor_mcpwm_obj;
+
+struct bdc_motor_group_t {
+    int group_id;
+    mcpwm_timer_handle_t timer;
+    uint32_t period_ticks;
+    uint32_t pwm_freq_hz; // actual frequency of the timer periods
+    bool ramp_enabled;
+    portMUX_TYPE spinlock; // protects motors and ramps of the motors against the TEZ callback
+    int enable_count; // number of enabled motors, the shared timer runs while it's not zero
+    bdc_motor_mcpwm_obj *motors[BDC_MOTOR_GROUP_MAX_MOTORS]; // indexed by bdc_motor_group_set_speeds
+};
+
+// Speed ramp executed by the TEZ callback of the timer, speeds are compare values in Q32 fixed point
 typedef struct {
+    bool active;
+    int64_t speed;
+    int64_t target;
+    int64_t accel;     // maximum speed change per PWM period
+    int64_t jerk;      // acceleration change per PWM period, 0 for a linear ramp
+    int64_t steps;     // S-curve: current acceleration, in multiples of jerk
+    int64_t max_steps; // S-curve: maximum acceleration, in multiples of jerk
+    bdc_motor_ramp_done_cb_t done_cb;
+    void *user_ctx;
+} bdc_motor_mcpwm_ramp_t;
+
+struct bdc_motor_mcpwm_obj {
     bdc_motor_t base;
+    bdc_motor_group_handle_t group; // NULL if the motor owns its timer
+    bool enabled; // only tracked for motors of a group
     mcpwm_timer_handle_t timer;
     mcpwm_oper_handle_t operator;
     mcpwm_cmpr_handle_t cmpa;
     mcpwm_cmpr_handle_t cmpb;
     mcpwm_gen_handle_t gena;
     mcpwm_gen_handle_t genb;
-} bdc_motor_mcpwm_obj;
+    uint32_t period_ticks;
+    uint32_t pwm_freq_hz;
+    bool ramp_enabled;
+    uint32_t speed; // last compare value
+    portMUX_TYPE spinlock; // protects the ramp, used by motors which own their timer
+    portMUX_TYPE *lock; // spinlock, or spinlock of the group
+    bdc_motor_mcpwm_ramp_t ramp;
+};
+
+// Advance the ramp by one PWM period, called with the lock taken. Returns true if the ramp is finished
+static bool IRAM_ATTR bdc_motor_mcpwm_ramp_step(bdc_motor_mcpwm_obj *mcpwm_motor)
+{
+    bdc_motor_mcpwm_ramp_t *ramp = &mcpwm_motor->ramp;
+    const int64_t diff = ramp->target - ramp->speed;
+    const int64_t dist = diff < 0 ? -diff : diff;
+    int64_t step = ramp->accel;
+    if (ramp->jerk) {
+        // ramp the acceleration down once the remaining speed change is what it takes to reach 0 acceleration
+        if (ramp->steps * (ramp->steps + 1) / 2 >= dist / ramp->jerk) {
+            ramp->steps = MAX(ramp->steps - 1, 1);
+        } else if (ramp->steps < ramp->max_steps) {
+            ramp->steps++;
+        }
+        step = MIN(ramp->steps * ramp->jerk, ramp->accel);
+    }
+    step = MIN(step, dist);
+    ramp->speed += diff < 0 ? -step : step;
+
+    const uint32_t speed = (uint32_t)((ramp->speed + (1LL << 31)) >> 32);
+    if (speed != mcpwm_motor->speed) {
+        mcpwm_comparator_set_compare_value(mcpwm_motor->cmpa, speed);
+        mcpwm_comparator_set_compare_value(mcpwm_motor->cmpb, speed);
+        mcpwm_motor->speed = speed;
+    }
+    if (ramp->speed == ramp->target) {
+        ramp->active = false;
+        return true;
+    }
+    return false;
+}
+
+static bool IRAM_ATTR bdc_motor_mcpwm_on_tez(mcpwm_timer_handle_t timer, const mcpwm_timer_event_data_t *edata, void *user_ctx)
+{
+    bdc_motor_mcpwm_obj *mcpwm_motor = (bdc_motor_mcpwm_obj *)user_ctx;
+    bdc_motor_mcpwm_ramp_t *ramp = &mcpwm_motor->ramp;
+    bdc_motor_ramp_done_cb_t done_cb = NULL;
+    void *cb_ctx = NULL;
+
+    portENTER_CRITICAL_ISR(mcpwm_motor->lock);
+    if (ramp->active && bdc_motor_mcpwm_ramp_step(mcpwm_motor)) {
+        done_cb = ramp->done_cb;
+        cb_ctx = ramp->user_ctx;
+    }
+    portEXIT_CRITICAL_ISR(mcpwm_motor->lock);
+    return done_cb ? done_cb(&mcpwm_motor->base, cb_ctx) : false;
+}
+
+static bool IRAM_ATTR bdc_motor_mcpwm_group_on_tez(mcpwm_timer_handle_t timer, const mcpwm_timer_event_data_t *edata, void *user_ctx)
+{
+    bdc_motor_group_handle_t group = (bdc_motor_group_handle_t)user_ctx;
+    bdc_motor_mcpwm_obj *done_motors[BDC_MOTOR_GROUP_MAX_MOTORS];
+    bdc_motor_ramp_done_cb_t done_cbs[BDC_MOTOR_GROUP_MAX_MOTORS];
+    void *cb_ctxs[BDC_MOTOR_GROUP_MAX_MOTORS];
+    int num_done = 0;
+    bool need_yield = false;
+
+    portENTER_CRITICAL_ISR(&group->spinlock);
+    for (int i = 0; i < BDC_MOTOR_GROUP_MAX_MOTORS; i++) {
+        bdc_motor_mcpwm_obj *mcpwm_motor = group->motors[i];
+        if (mcpwm_motor && mcpwm_motor->ramp.active && bdc_motor_mcpwm_ramp_step(mcpwm_motor) && mcpwm_motor->ramp.done_cb) {
+            done_motors[num_done] = mcpwm_motor;
+            done_cbs[num_done] = mcpwm_motor->ramp.done_cb;
+            cb_ctxs[num_done++] = mcpwm_motor->ramp.user_ctx;
+        }
+    }
+    portEXIT_CRITICAL_ISR(&group->spinlock);
+    for (int i = 0; i < num_done; i++) {
+        need_yield |= done_cbs[i](&done_motors[i]->base, cb_ctxs[i]);
+    }
+    return need_yield;
+}
 
 static esp_err_t bdc_motor_mcpwm_set_speed(bdc_motor_t *motor, uint32_t speed)
 {
     bdc_motor_mcpwm_obj *mcpwm_motor = __containerof(motor, bdc_motor_mcpwm_obj, base);
+    // a speed set by the application cancels the ramp
+    portENTER_CRITICAL(mcpwm_motor->lock);
+    mcpwm_motor->ramp.active = false;
+    portEXIT_CRITICAL(mcpwm_motor->lock);
     ESP_RETURN_ON_ERROR(mcpwm_comparator_set_compare_value(mcpwm_motor->cmpa, speed), TAG, "set compare value failed");
     ESP_RETURN_ON_ERROR(mcpwm_comparator_set_compare_value(mcpwm_motor->cmpb, speed), TAG, "set compare value failed");
+    mcpwm_motor->speed = speed;
+    return ESP_OK;
+}
+
+static esp_err_t bdc_motor_mcpwm_ramp_to_speed(bdc_motor_t *motor, const bdc_motor_ramp_config_t *config)
+{
+    bdc_motor_mcpwm_obj *mcpwm_motor = __containerof(motor, bdc_motor_mcpwm_obj, base);
+    ESP_RETURN_ON_FALSE(mcpwm_motor->ramp_enabled, ESP_ERR_NOT_SUPPORTED, TAG, "ramp not enabled in MCPWM config");
+    ESP_RETURN_ON_FALSE(config->target_speed <= mcpwm_motor->period_ticks && config->acceleration, ESP_ERR_INVALID_ARG, TAG, "invalid ramp config");
+
+    // rates per PWM period, in Q32 fixed point, at least 1 so that the ramp progresses
+    const uint64_t freq = mcpwm_motor->pwm_freq_hz;
+    const int64_t accel = MAX(((uint64_t)config->acceleration << 32) / freq, 1);
+    const int64_t jerk = config->jerk ? MAX(((uint64_t)config->jerk << 32) / freq / freq, 1) : 0;
+
+    portENTER_CRITICAL(mcpwm_motor->lock);
+    mcpwm_motor->ramp = (bdc_motor_mcpwm_ramp_t) {
+        .active = true,
+        .speed = (int64_t)mcpwm_motor->speed << 32,
+        .target = (int64_t)config->target_speed << 32,
+        .accel = accel,
+        .jerk = jerk,
+        .steps = 0,
+        .max_steps = jerk ? MIN((accel + jerk - 1) / jerk, BDC_MOTOR_RAMP_MAX_STEPS) : 0,
+        .done_cb = config->done_cb,
+        .user_ctx = config->user_ctx,
+    };
+    portEXIT_CRITICAL(mcpwm_motor->lock);
     return ESP_OK;
 }
 
 static esp_err_t bdc_motor_mcpwm_enable(bdc_motor_t *motor)
 {
     bdc_motor_mcpwm_obj *mcpwm_motor = __containerof(motor, bdc_motor_mcpwm_obj, base);
+    bdc_motor_group_handle_t group = mcpwm_motor->group;
+    if (group) {
+        ESP_RETURN_ON_FALSE(!mcpwm_motor->enabled, ESP_ERR_INVALID_STATE, TAG, "motor already enabled");
+        if (group->enable_count) {
+            group->enable_count++;
+            mcpwm_motor->enabled = true;
+            return ESP_OK; // shared timer is already running
+        }
+    }
     ESP_RETURN_ON_ERROR(mcpwm_timer_enable(mcpwm_motor->timer), TAG, "enable timer failed");
     ESP_RETURN_ON_ERROR(mcpwm_timer_start_stop(mcpwm_motor->timer, MCPWM_TIMER_START_NO_STOP), TAG, "start timer failed");
+    if (group) {
+        group->enable_count++;
+        mcpwm_motor->enabled = true;
+    }
     return ESP_OK;
 }
 
 static esp_err_t bdc_motor_mcpwm_disable(bdc_motor_t *motor)
 {
     bdc_motor_mcpwm_obj *mcpwm_motor = __containerof(motor, bdc_motor_mcpwm_obj, base);
+    bdc_motor_group_handle_t group = mcpwm_motor->group;
+    if (group) {
+        ESP_RETURN_ON_FALSE(mcpwm_motor->enabled, ESP_ERR_INVALID_STATE, TAG, "motor not enabled");
+        if (group->enable_count > 1) {
+            group->enable_count--;
+            mcpwm_motor->enabled = false;
+            return ESP_OK; // shared timer is still used by other motors
+        }
+    }
     ESP_RETURN_ON_ERROR(mcpwm_timer_start_stop(mcpwm_motor->timer, MCPWM_TIMER_STOP_EMPTY), TAG, "stop timer failed");
     ESP_RETURN_ON_ERROR(mcpwm_timer_disable(mcpwm_motor->timer), TAG, "disable timer failed");
+    if (group) {
+        group->enable_count = 0;
+        mcpwm_motor->enabled = false;
+    }
     return ESP_OK;
 }
 
@@ -80,49 +254,65 @@ static esp_err_t bdc_motor_mcpwm_brake(bdc_motor_t *motor)
     return ESP_OK;
 }
 
+static void bdc_motor_mcpwm_free(bdc_motor_mcpwm_obj *mcpwm_motor)
+{
+    if (mcpwm_motor->gena) {
+        mcpwm_del_generator(mcpwm_motor->gena);
+    }
+    if (mcpwm_motor->genb) {
+        mcpwm_del_generator(mcpwm_motor->genb);
+    }
+    if (mcpwm_motor->cmpa) {
+        mcpwm_del_comparator(mcpwm_motor->cmpa);
+    }
+    if (mcpwm_motor->cmpb) {
+        mcpwm_del_comparator(mcpwm_motor->cmpb);
+    }
+    if (mcpwm_motor->operator) {
+        mcpwm_del_operator(mcpwm_motor->operator);
+    }
+    bdc_motor_group_handle_t group = mcpwm_motor->group;
+    if (group) {
+        // not seen by the TEZ callback of the group any more
+        portENTER_CRITICAL(&group->spinlock);
+        for (int i = 0; i < BDC_MOTOR_GROUP_MAX_MOTORS; i++) {
+            if (group->motors[i] == mcpwm_motor) {
+                group->motors[i] = NULL;
+            }
+        }
+        portEXIT_CRITICAL(&group->spinlock);
+    } else if (mcpwm_motor->timer) {
+        mcpwm_del_timer(mcpwm_motor->timer);
+    }
+    free(mcpwm_motor);
+}
+
 static esp_err_t bdc_motor_mcpwm_del(bdc_motor_t *motor)
 {
     bdc_motor_mcpwm_obj *mcpwm_motor = __containerof(motor, bdc_motor_mcpwm_obj, base);
-    mcpwm_del_generator(mcpwm_motor->gena);
-    mcpwm_del_generator(mcpwm_motor->genb);
-    mcpwm_del_comparator(mcpwm_motor->cmpa);
-    mcpwm_del_comparator(mcpwm_motor->cmpb);
-    mcpwm_del_operator(mcpwm_motor->operator);
-    mcpwm_del_timer(mcpwm_motor->timer);
-    free(mcpwm_motor);
+    if (mcpwm_motor->group && mcpwm_motor->enabled) {
+        // shared timer must keep running for the other motors
+        ESP_RETURN_ON_ERROR(bdc_motor_mcpwm_disable(motor), TAG, "disable motor failed");
+    }
+    bdc_motor_mcpwm_free(mcpwm_motor);
     return ESP_OK;
 }
 
-esp_err_t bdc_motor_new_mcpwm_device(const bdc_motor_config_t *motor_config, const bdc_motor_mcpwm_config_t *mcpwm_config, bdc_motor_handle_t *ret_motor)
+// Create operator, comparators and generators of the motor, connected to mcpwm_motor->timer
+static esp_err_t bdc_motor_mcpwm_init_operator(bdc_motor_mcpwm_obj *mcpwm_motor, int group_id, const bdc_motor_config_t *motor_config)
 {
-    bdc_motor_mcpwm_obj *mcpwm_motor = NULL;
-    esp_err_t ret = ESP_OK;
-    ESP_GOTO_ON_FALSE(motor_config && mcpwm_config && ret_motor, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
-    mcpwm_motor = calloc(1, sizeof(bdc_motor_mcpwm_obj));
-    ESP_GOTO_ON_FALSE(mcpwm_motor, ESP_ERR_NO_MEM, err, TAG, "no mem for rmt motor");
-
-    // mcpwm timer
-    mcpwm_timer_config_t timer_config = {
-        .group_id = mcpwm_config->group_id,
-        .clk_src = MCPWM_TIMER_CLK_SRC_DEFAULT,
-        .resolution_hz = mcpwm_config->resolution_hz,
-        .period_ticks = mcpwm_config->resolution_hz / motor_config->pwm_freq_hz,
-        .count_mode = MCPWM_TIMER_COUNT_MODE_UP,
-    };
-    ESP_GOTO_ON_ERROR(mcpwm_new_timer(&timer_config, &mcpwm_motor->timer), err, TAG, "create MCPWM timer failed");
-
     mcpwm_operator_config_t operator_config = {
-        .group_id = mcpwm_config->group_id,
+        .group_id = group_id,
     };
-    ESP_GOTO_ON_ERROR(mcpwm_new_operator(&operator_config, &mcpwm_motor->operator), err, TAG, "create MCPWM operator failed");
+    ESP_RETURN_ON_ERROR(mcpwm_new_operator(&operator_config, &mcpwm_motor->operator), TAG, "create MCPWM operator failed");
 
-    ESP_GOTO_ON_ERROR(mcpwm_operator_connect_timer(mcpwm_motor->operator, mcpwm_motor->timer), err, TAG, "connect timer and operator failed");
+    ESP_RETURN_ON_ERROR(mcpwm_operator_connect_timer(mcpwm_motor->operator, mcpwm_motor->timer), TAG, "connect timer and operator failed");
 
     mcpwm_comparator_config_t comparator_config = {
         .flags.update_cmp_on_tez = true,
     };
-    ESP_GOTO_ON_ERROR(mcpwm_new_comparator(mcpwm_motor->operator, &comparator_config, &mcpwm_motor->cmpa), err, TAG, "create comparator failed");
-    ESP_GOTO_ON_ERROR(mcpwm_new_comparator(mcpwm_motor->operator, &comparator_config, &mcpwm_motor->cmpb), err, TAG, "create comparator failed");
+    ESP_RETURN_ON_ERROR(mcpwm_new_comparator(mcpwm_motor->operator, &comparator_config, &mcpwm_motor->cmpa), TAG, "create comparator failed");
+    ESP_RETURN_ON_ERROR(mcpwm_new_comparator(mcpwm_motor->operator, &comparator_config, &mcpwm_motor->cmpb), TAG, "create comparator failed");
 
     // set the initial compare value for both comparators
     mcpwm_comparator_set_compare_value(mcpwm_motor->cmpa, 0);
@@ -131,9 +321,9 @@ esp_err_t bdc_motor_new_mcpwm_device(const bdc_motor_config_t *motor_config, con
     mcpwm_generator_config_t generator_config = {
         .gen_gpio_num = motor_config->pwma_gpio_num,
     };
-    ESP_GOTO_ON_ERROR(mcpwm_new_generator(mcpwm_motor->operator, &generator_config, &mcpwm_motor->gena), err, TAG, "create generator failed");
+    ESP_RETURN_ON_ERROR(mcpwm_new_generator(mcpwm_motor->operator, &generator_config, &mcpwm_motor->gena), TAG, "create generator failed");
     generator_config.gen_gpio_num = motor_config->pwmb_gpio_num;
-    ESP_GOTO_ON_ERROR(mcpwm_new_generator(mcpwm_motor->operator, &generator_config, &mcpwm_motor->genb), err, TAG, "create generator failed");
+    ESP_RETURN_ON_ERROR(mcpwm_new_generator(mcpwm_motor->operator, &generator_config, &mcpwm_motor->genb), TAG, "create generator failed");
 
     mcpwm_generator_set_actions_on_timer_event(mcpwm_motor->gena,
             MCPWM_GEN_TIMER_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP, MCPWM_TIMER_EVENT_EMPTY, MCPWM_GEN_ACTION_HIGH),
@@ -155,31 +345,157 @@ esp_err_t bdc_motor_new_mcpwm_device(const bdc_motor_config_t *motor_config, con
     mcpwm_motor->base.coast = bdc_motor_mcpwm_coast;
     mcpwm_motor->base.brake = bdc_motor_mcpwm_brake;
     mcpwm_motor->base.set_speed = bdc_motor_mcpwm_set_speed;
+    mcpwm_motor->base.ramp_to_speed = bdc_motor_mcpwm_ramp_to_speed;
     mcpwm_motor->base.del = bdc_motor_mcpwm_del;
+    return ESP_OK;
+}
+
+esp_err_t bdc_motor_new_mcpwm_device(const bdc_motor_config_t *motor_config, const bdc_motor_mcpwm_config_t *mcpwm_config, bdc_motor_handle_t *ret_motor)
+{
+    bdc_motor_mcpwm_obj *mcpwm_motor = NULL;
+    esp_err_t ret = ESP_OK;
+    ESP_GOTO_ON_FALSE(motor_config && mcpwm_config && ret_motor, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    mcpwm_motor = calloc(1, sizeof(bdc_motor_mcpwm_obj));
+    ESP_GOTO_ON_FALSE(mcpwm_motor, ESP_ERR_NO_MEM, err, TAG, "no mem for rmt motor");
+    mcpwm_motor->spinlock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+    mcpwm_motor->lock = &mcpwm_motor->spinlock;
+
+    // mcpwm timer
+    mcpwm_timer_config_t timer_config = {
+        .group_id = mcpwm_config->group_id,
+        .clk_src = MCPWM_TIMER_CLK_SRC_DEFAULT,
+        .resolution_hz = mcpwm_config->resolution_hz,
+        .period_ticks = mcpwm_config->resolution_hz / motor_config->pwm_freq_hz,
+        .count_mode = MCPWM_TIMER_COUNT_MODE_UP,
+    };
+    ESP_GOTO_ON_ERROR(mcpwm_new_timer(&timer_config, &mcpwm_motor->timer), err, TAG, "create MCPWM timer failed");
+    mcpwm_motor->period_ticks = timer_config.period_ticks;
+    mcpwm_motor->pwm_freq_hz = mcpwm_config->resolution_hz / timer_config.period_ticks;
+
+    ESP_GOTO_ON_ERROR(bdc_motor_mcpwm_init_operator(mcpwm_motor, mcpwm_config->group_id, motor_config), err, TAG, "init MCPWM operator failed");
+
+    if (mcpwm_config->flags.en_ramp) {
+        // callbacks can only be registered before the timer is enabled
+        mcpwm_timer_event_callbacks_t cbs = {
+            .on_empty = bdc_motor_mcpwm_on_tez,
+        };
+        ESP_GOTO_ON_ERROR(mcpwm_timer_register_event_callbacks(mcpwm_motor->timer, &cbs, mcpwm_motor), err, TAG, "register timer callback failed");
+        mcpwm_motor->ramp_enabled = true;
+    }
+
     *ret_motor = &mcpwm_motor->base;
     return ESP_OK;
 
 err:
     if (mcpwm_motor) {
-        if (mcpwm_motor->gena) {
-            mcpwm_del_generator(mcpwm_motor->gena);
-        }
-        if (mcpwm_motor->genb) {
-            mcpwm_del_generator(mcpwm_motor->genb);
-        }
-        if (mcpwm_motor->cmpa) {
-            mcpwm_del_comparator(mcpwm_motor->cmpa);
-        }
-        if (mcpwm_motor->cmpb) {
-            mcpwm_del_comparator(mcpwm_motor->cmpb);
-        }
-        if (mcpwm_motor->operator) {
-            mcpwm_del_operator(mcpwm_motor->operator);
-        }
-        if (mcpwm_motor->timer) {
-            mcpwm_del_timer(mcpwm_motor->timer);
-        }
-        free(mcpwm_motor);
+        bdc_motor_mcpwm_free(mcpwm_motor);
+    }
+    return ret;
+}
+
+esp_err_t bdc_motor_new_mcpwm_group(const bdc_motor_mcpwm_group_config_t *config, bdc_motor_group_handle_t *ret_group)
+{
+    bdc_motor_group_handle_t group = NULL;
+    esp_err_t ret = ESP_OK;
+    ESP_GOTO_ON_FALSE(config && ret_group && config->pwm_freq_hz, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    group = calloc(1, sizeof(struct bdc_motor_group_t));
+    ESP_GOTO_ON_FALSE(group, ESP_ERR_NO_MEM, err, TAG, "no mem for motor group");
+    group->group_id = config->group_id;
+    group->spinlock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+
+    // mcpwm timer shared by all motors of the group
+    mcpwm_timer_config_t timer_config = {
+        .group_id = config->group_id,
+        .clk_src = MCPWM_TIMER_CLK_SRC_DEFAULT,
+        .resolution_hz = config->resolution_hz,
+        .period_ticks = config->resolution_hz / config->pwm_freq_hz,
+        .count_mode = MCPWM_TIMER_COUNT_MODE_UP,
+    };
+    ESP_GOTO_ON_ERROR(mcpwm_new_timer(&timer_config, &group->timer), err, TAG, "create MCPWM timer failed");
+    group->period_ticks = timer_config.period_ticks;
+    group->pwm_freq_hz = config->resolution_hz / timer_config.period_ticks;
+
+    if (config->flags.en_ramp) {
+        // one callback executes the ramps of all motors of the group
+        mcpwm_timer_event_callbacks_t cbs = {
+            .on_empty = bdc_motor_mcpwm_group_on_tez,
+        };
+        ESP_GOTO_ON_ERROR(mcpwm_timer_register_event_callbacks(group->timer, &cbs, group), err, TAG, "register timer callback failed");
+        group->ramp_enabled = true;
+    }
+
+    *ret_group = group;
+    return ESP_OK;
+
+err:
+    if (group && group->timer) {
+        mcpwm_del_timer(group->timer);
+    }
+    free(group);
+    return ret;
+}
+
+esp_err_t bdc_motor_new_mcpwm_group_device(bdc_motor_group_handle_t group, const bdc_motor_config_t *motor_config, bdc_motor_handle_t *ret_motor)
+{
+    bdc_motor_mcpwm_obj *mcpwm_motor = NULL;
+    esp_err_t ret = ESP_OK;
+    ESP_GOTO_ON_FALSE(group && motor_config && ret_motor, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    int index = 0;
+    while (index < BDC_MOTOR_GROUP_MAX_MOTORS && group->motors[index]) {
+        index++;
+    }
+    ESP_GOTO_ON_FALSE(index < BDC_MOTOR_GROUP_MAX_MOTORS, ESP_ERR_NOT_FOUND, err, TAG, "no free slot in motor group");
+    mcpwm_motor = calloc(1, sizeof(bdc_motor_mcpwm_obj));
+    ESP_GOTO_ON_FALSE(mcpwm_motor, ESP_ERR_NO_MEM, err, TAG, "no mem for mcpwm motor");
+    mcpwm_motor->group = group;
+    mcpwm_motor->timer = group->timer;
+    mcpwm_motor->period_ticks = group->period_ticks;
+    mcpwm_motor->pwm_freq_hz = group->pwm_freq_hz;
+    mcpwm_motor->ramp_enabled = group->ramp_enabled;
+    mcpwm_motor->lock = &group->spinlock;
+
+    ESP_GOTO_ON_ERROR(bdc_motor_mcpwm_init_operator(mcpwm_motor, group->group_id, motor_config), err, TAG, "init MCPWM operator failed");
+    // seen by the TEZ callback of the group once initialized
+    portENTER_CRITICAL(&group->spinlock);
+    group->motors[index] = mcpwm_motor;
+    portEXIT_CRITICAL(&group->spinlock);
+
+    *ret_motor = &mcpwm_motor->base;
+    return ESP_OK;
+
+err:
+    if (mcpwm_motor) {
+        bdc_motor_mcpwm_free(mcpwm_motor);
     }
     return ret;
 }
+
+esp_err_t bdc_motor_group_set_speeds(bdc_motor_group_handle_t group, const uint32_t *speeds, size_t num_speeds)
+{
+    ESP_RETURN_ON_FALSE_ISR(group && speeds && num_speeds <= BDC_MOTOR_GROUP_MAX_MOTORS, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    // all comparators of the group take the new values at the same TEZ event of the shared timer
+    for (size_t i = 0; i < num_speeds; i++) {
+        bdc_motor_mcpwm_obj *mcpwm_motor = group->motors[i];
+        if (mcpwm_motor) {
+            // a speed set by the application cancels the ramp
+            portENTER_CRITICAL_SAFE(&group->spinlock);
+            mcpwm_motor->ramp.active = false;
+            portEXIT_CRITICAL_SAFE(&group->spinlock);
+            ESP_RETURN_ON_ERROR_ISR(mcpwm_comparator_set_compare_value(mcpwm_motor->cmpa, speeds[i]), TAG, "set compare value failed");
+            ESP_RETURN_ON_ERROR_ISR(mcpwm_comparator_set_compare_value(mcpwm_motor->cmpb, speeds[i]), TAG, "set compare value failed");
+            mcpwm_motor->speed = speeds[i];
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t bdc_motor_group_del(bdc_motor_group_handle_t group)
+{
+    ESP_RETURN_ON_FALSE(group, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    for (int i = 0; i < BDC_MOTOR_GROUP_MAX_MOTORS; i++) {
+        ESP_RETURN_ON_FALSE(!group->motors[i], ESP_ERR_INVALID_STATE, TAG, "motor %d of the group not deleted", i);
+    }
+    mcpwm_del_timer(group->timer);
+    free(group);
+    return ESP_OK;
+}
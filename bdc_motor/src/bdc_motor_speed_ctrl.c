@@ -0,0 +1,201 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_attr.h"
+#include "driver/gptimer.h"
+#include "bdc_motor_speed_ctrl.h"
+
+#define BDC_MOTOR_SPEED_CTRL_TIMER_RESOLUTION_HZ 1000000 // 1MHz, 1 tick = 1us
+#define BDC_MOTOR_SPEED_CTRL_DEFAULT_TASK_STACK_SIZE 2048
+#define BDC_MOTOR_SPEED_CTRL_DEFAULT_TASK_PRIORITY (configMAX_PRIORITIES - 1)
+
+static const char *TAG = "bdc_motor_speed";
+
+struct bdc_motor_speed_ctrl_t {
+    bdc_motor_handle_t motor;
+    pcnt_unit_handle_t pcnt_unit;
+    pid_ctrl_block_handle_t pid;
+    gptimer_handle_t timer;
+    TaskHandle_t task;
+    SemaphoreHandle_t task_stopped;
+    volatile bool stop_task;
+    bool running;
+    volatile float target;  // pulses per control period
+    int last_count;         // encoder count in the previous control period
+    portMUX_TYPE spinlock;  // protects status
+    bdc_motor_speed_ctrl_status_t status;
+};
+
+static bool IRAM_ATTR bdc_motor_speed_ctrl_on_alarm(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_ctx)
+{
+    BaseType_t task_woken = pdFALSE;
+    struct bdc_motor_speed_ctrl_t *ctrl = (struct bdc_motor_speed_ctrl_t *)user_ctx;
+    vTaskNotifyGiveFromISR(ctrl->task, &task_woken);
+    return task_woken == pdTRUE;
+}
+
+static void bdc_motor_speed_ctrl_task(void *arg)
+{
+    struct bdc_motor_speed_ctrl_t *ctrl = (struct bdc_motor_speed_ctrl_t *)arg;
+
+    while (true) {
+        // number of elapsed control periods, more than one if the task was late
+        uint32_t periods = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (ctrl->stop_task) {
+            break;
+        }
+        int count = 0;
+        pcnt_unit_get_count(ctrl->pcnt_unit, &count);
+        int pulses = abs(count - ctrl->last_count) / (int)periods;
+        ctrl->last_count = count;
+
+        float output = 0;
+        pid_compute(ctrl->pid, ctrl->target - pulses, &output);
+        bdc_motor_set_speed(ctrl->motor, output > 0 ? (uint32_t)output : 0);
+
+        portENTER_CRITICAL(&ctrl->spinlock);
+        ctrl->status.pulses = pulses;
+        ctrl->status.output = output;
+        ctrl->status.loops++;
+        ctrl->status.overruns += periods - 1;
+        portEXIT_CRITICAL(&ctrl->spinlock);
+    }
+
+    xSemaphoreGive(ctrl->task_stopped);
+    vTaskDelete(NULL);
+}
+
+esp_err_t bdc_motor_new_speed_ctrl(const bdc_motor_speed_ctrl_config_t *config, bdc_motor_speed_ctrl_handle_t *ret_ctrl)
+{
+    esp_err_t ret = ESP_OK;
+    struct bdc_motor_speed_ctrl_t *ctrl = NULL;
+    ESP_GOTO_ON_FALSE(config && ret_ctrl && config->motor && config->pcnt_unit, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    ESP_GOTO_ON_FALSE(config->control_freq_hz && config->control_freq_hz <= BDC_MOTOR_SPEED_CTRL_TIMER_RESOLUTION_HZ,
+                      ESP_ERR_INVALID_ARG, err, TAG, "invalid control frequency");
+    ctrl = calloc(1, sizeof(struct bdc_motor_speed_ctrl_t));
+    ESP_GOTO_ON_FALSE(ctrl, ESP_ERR_NO_MEM, err, TAG, "no mem for speed controller");
+    ctrl->motor = config->motor;
+    ctrl->pcnt_unit = config->pcnt_unit;
+    ctrl->spinlock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+
+    pid_ctrl_config_t pid_config = {
+        .init_param = config->pid_param,
+    };
+    ESP_GOTO_ON_ERROR(pid_new_control_block(&pid_config, &ctrl->pid), err, TAG, "create PID control block failed");
+
+    ctrl->task_stopped = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(ctrl->task_stopped, ESP_ERR_NO_MEM, err, TAG, "no mem for semaphore");
+    const uint32_t stack_size = config->task_stack_size ? config->task_stack_size : BDC_MOTOR_SPEED_CTRL_DEFAULT_TASK_STACK_SIZE;
+    const uint32_t priority = config->task_priority ? config->task_priority : BDC_MOTOR_SPEED_CTRL_DEFAULT_TASK_PRIORITY;
+    if (xTaskCreatePinnedToCore(bdc_motor_speed_ctrl_task, "bdc_motor_speed", stack_size, ctrl, priority, &ctrl->task,
+                                config->task_core_id) != pdPASS) {
+        ctrl->task = NULL;
+        ESP_LOGE(TAG, "create control task failed");
+        ret = ESP_ERR_NO_MEM;
+        goto err;
+    }
+
+    gptimer_config_t timer_config = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = BDC_MOTOR_SPEED_CTRL_TIMER_RESOLUTION_HZ,
+    };
+    ESP_GOTO_ON_ERROR(gptimer_new_timer(&timer_config, &ctrl->timer), err, TAG, "create timer failed");
+    gptimer_alarm_config_t alarm_config = {
+        .alarm_count = BDC_MOTOR_SPEED_CTRL_TIMER_RESOLUTION_HZ / config->control_freq_hz,
+        .reload_count = 0,
+        .flags.auto_reload_on_alarm = true,
+    };
+    ESP_GOTO_ON_ERROR(gptimer_set_alarm_action(ctrl->timer, &alarm_config), err, TAG, "set timer alarm failed");
+    gptimer_event_callbacks_t cbs = {
+        .on_alarm = bdc_motor_speed_ctrl_on_alarm,
+    };
+    ESP_GOTO_ON_ERROR(gptimer_register_event_callbacks(ctrl->timer, &cbs, ctrl), err, TAG, "register timer callback failed");
+
+    *ret_ctrl = ctrl;
+    return ESP_OK;
+
+err:
+    if (ctrl) {
+        if (ctrl->timer) {
+            gptimer_del_timer(ctrl->timer);
+        }
+        if (ctrl->task) {
+            ctrl->stop_task = true;
+            xTaskNotifyGive(ctrl->task);
+            xSemaphoreTake(ctrl->task_stopped, portMAX_DELAY);
+        }
+        if (ctrl->task_stopped) {
+            vSemaphoreDelete(ctrl->task_stopped);
+        }
+        if (ctrl->pid) {
+            pid_del_control_block(ctrl->pid);
+        }
+        free(ctrl);
+    }
+    return ret;
+}
+
+esp_err_t bdc_motor_speed_ctrl_start(bdc_motor_speed_ctrl_handle_t ctrl)
+{
+    ESP_RETURN_ON_FALSE(ctrl, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!ctrl->running, ESP_ERR_INVALID_STATE, TAG, "speed controller already running");
+    ESP_RETURN_ON_ERROR(pcnt_unit_get_count(ctrl->pcnt_unit, &ctrl->last_count), TAG, "get encoder count failed");
+    pid_reset_ctrl_block(ctrl->pid);
+    // drop a control period left from the previous run
+    ulTaskNotifyValueClear(ctrl->task, UINT32_MAX);
+    ESP_RETURN_ON_ERROR(gptimer_set_raw_count(ctrl->timer, 0), TAG, "reset timer failed");
+    ESP_RETURN_ON_ERROR(gptimer_enable(ctrl->timer), TAG, "enable timer failed");
+    ESP_RETURN_ON_ERROR(gptimer_start(ctrl->timer), TAG, "start timer failed");
+    ctrl->running = true;
+    return ESP_OK;
+}
+
+esp_err_t bdc_motor_speed_ctrl_stop(bdc_motor_speed_ctrl_handle_t ctrl)
+{
+    ESP_RETURN_ON_FALSE(ctrl, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(ctrl->running, ESP_ERR_INVALID_STATE, TAG, "speed controller not running");
+    ESP_RETURN_ON_ERROR(gptimer_stop(ctrl->timer), TAG, "stop timer failed");
+    ESP_RETURN_ON_ERROR(gptimer_disable(ctrl->timer), TAG, "disable timer failed");
+    ctrl->running = false;
+    return ESP_OK;
+}
+
+esp_err_t bdc_motor_speed_ctrl_set_target(bdc_motor_speed_ctrl_handle_t ctrl, float pulses)
+{
+    ESP_RETURN_ON_FALSE(ctrl, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ctrl->target = pulses;
+    return ESP_OK;
+}
+
+esp_err_t bdc_motor_speed_ctrl_get_status(bdc_motor_speed_ctrl_handle_t ctrl, bdc_motor_speed_ctrl_status_t *status)
+{
+    ESP_RETURN_ON_FALSE(ctrl && status, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    portENTER_CRITICAL(&ctrl->spinlock);
+    *status = ctrl->status;
+    portEXIT_CRITICAL(&ctrl->spinlock);
+    return ESP_OK;
+}
+
+esp_err_t bdc_motor_del_speed_ctrl(bdc_motor_speed_ctrl_handle_t ctrl)
+{
+    ESP_RETURN_ON_FALSE(ctrl, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!ctrl->running, ESP_ERR_INVALID_STATE, TAG, "speed controller is running");
+    gptimer_del_timer(ctrl->timer);
+    ctrl->stop_task = true;
+    xTaskNotifyGive(ctrl->task);
+    xSemaphoreTake(ctrl->task_stopped, portMAX_DELAY);
+    vSemaphoreDelete(ctrl->task_stopped);
+    pid_del_control_block(ctrl->pid);
+    free(ctrl);
+    return ESP_OK;
+}
@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ * Note: same license as Catch2
+ */
+#include <cstdio>
+#include <ostream>
+#include <streambuf>
+
+/* Output streams of Catch2 with CATCH_CONFIG_NOSTDOUT, written by stdio,
+ * so that std::cout and std::cerr are not linked in. */
+namespace {
+
+class FileStreamBuf : public std::streambuf {
+public:
+    explicit FileStreamBuf(FILE *file) : m_file(file) {}
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            fputc(traits_type::to_char_type(c), m_file);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize n) override
+    {
+        return fwrite(s, 1, n, m_file);
+    }
+
+    int sync() override
+    {
+        return fflush(m_file) == 0 ? 0 : -1;
+    }
+
+private:
+    FILE *m_file;
+};
+
+} // namespace
+
+namespace Catch {
+
+std::ostream &cout()
+{
+    static FileStreamBuf buf(stdout);
+    static std::ostream stream(&buf);
+    return stream;
+}
+
+std::ostream &cerr()
+{
+    static FileStreamBuf buf(stderr);
+    static std::ostream stream(&buf);
+    return stream;
+}
+
+std::ostream &clog()
+{
+    return cerr();
+}
+
+} // namespace Catch
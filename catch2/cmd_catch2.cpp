@@ -1,21 +1,43 @@
 /*
- * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: BSL-1.0
  * Note: same license as Catch2
  */
-#if WITH_CONSOLE
+#include <cstdio>
+#include "sdkconfig.h"
 #include "Catch2/src/catch2/catch_config.hpp"
-#include "esp_console.h"
 #include "catch2/catch_session.hpp"
+#include "catch2/internal/catch_stdstreams.hpp"
 #include "cmd_catch2.h"
+#if WITH_CONSOLE
+#include "esp_console.h"
+#endif
 
-static int cmd_catch2(int argc, char **argv)
+extern "C" int run_catch2(int argc, char **argv)
 {
+    // Catch2 allows only one session per application
     static auto session = Catch::Session();
     Catch::ConfigData configData;
+    // Benchmark settings suitable for the target, the command line arguments take precedence
+    configData.benchmarkSamples = CONFIG_CATCH2_BENCHMARK_SAMPLES;
+    configData.benchmarkResamples = CONFIG_CATCH2_BENCHMARK_RESAMPLES;
+    configData.benchmarkWarmupTime = CONFIG_CATCH2_BENCHMARK_WARMUP_TIME_MS;
+#if CONFIG_CATCH2_BENCHMARK_NO_ANALYSIS
+    configData.benchmarkNoAnalysis = true;
+#endif
     session.useConfigData(configData);
-    return session.run(argc, argv);
+    int result = session.run(argc, argv);
+    // Make sure the whole report, e.g. XML, is out before the caller prints anything
+    Catch::cout().flush();
+    fflush(stdout);
+    return result;
+}
+
+#if WITH_CONSOLE
+static int cmd_catch2(int argc, char **argv)
+{
+    return run_catch2(argc, argv);
 }
 
 extern "C" esp_err_t register_catch2(const char *cmd_name)
@@ -3,9 +3,25 @@
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
+#include <algorithm>
+#include <vector>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 TEST_CASE("Test case 1")
 {
     REQUIRE(1 == 1);
 }
+
+TEST_CASE("Benchmark example", "[benchmark]")
+{
+    std::vector<int> values(256);
+
+    BENCHMARK("sort 256 integers") {
+        for (size_t i = 0; i < values.size(); i++) {
+            values[i] = (i * 7919) % values.size();
+        }
+        std::sort(values.begin(), values.end());
+        return values.front();
+    };
+}
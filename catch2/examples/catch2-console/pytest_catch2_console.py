@@ -0,0 +1,21 @@
+# SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Unlicense OR CC0-1.0
+import xml.etree.ElementTree as ET
+
+import pytest
+from pytest_embedded import Dut
+
+
+@pytest.mark.supported_targets
+@pytest.mark.generic
+def test_catch2_console(dut: Dut) -> None:
+    dut.expect_exact('catch2>')
+    dut.write('test -r junit')
+    report = dut.expect(r'<\?xml.*?</testsuites>', timeout=120).group(0).decode()
+
+    testsuites = ET.fromstring(report[report.index('<testsuites'):])
+    testsuite = testsuites.find('testsuite')
+    assert testsuite is not None
+    assert int(testsuite.get('failures', '0')) == 0
+    assert int(testsuite.get('errors', '0')) == 0
+    assert int(testsuite.get('tests', '0')) > 0
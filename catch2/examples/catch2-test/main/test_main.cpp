@@ -1,20 +1,34 @@
 /*
- * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
 #include <stdio.h>
+#include <chrono>
 #include <catch2/catch_session.hpp>
+#include "sdkconfig.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include <inttypes.h>
+#include "esp_timer.h"
+#endif
 
 extern "C" void app_main(void)
 {
+#if !CONFIG_IDF_TARGET_LINUX
+    // Includes the registration of the test cases by the static constructors
+    printf("Time to app_main: %" PRId64 " us\n", esp_timer_get_time());
+#endif
+
     int argc = 1;
     const char *argv[2] = {
         "target_test_main",
         NULL
     };
 
+    auto start = std::chrono::steady_clock::now();
     auto result = Catch::Session().run(argc, argv);
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    printf("Time to run the tests: %lld us\n", (long long)duration.count());
     if (result != 0) {
         printf("Test failed with result %d\n", result);
     } else {
@@ -19,6 +19,19 @@ extern "C" {
  */
 esp_err_t register_catch2(const char *cmd_name);
 
+/**
+ * @brief Run Catch2 tests with the benchmark settings of menuconfig.
+ *
+ * This is what the command registered by register_catch2() runs. The arguments are the same
+ * as for Catch2 tests on the host, e.g. "-r junit" to get a JUnit XML report.
+ * Catch2 allows only one Catch::Session, do not create another one in the application.
+ *
+ * @param argc  Number of arguments, including the program name.
+ * @param argv  Arguments, argv[0] is the program name.
+ * @return int  0 if all tests passed, otherwise the number of failed tests (as Catch::Session::run).
+ */
+int run_catch2(int argc, char **argv);
+
 #ifdef __cplusplus
 }
 #endif
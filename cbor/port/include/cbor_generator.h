@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * CBOR generator with the API of json_generator
+ *
+ * The functions have the names and arguments of the json_gen_* ones of the
+ * json_generator component with a cbor_gen_* prefix, so that the code creating
+ * JSON messages can create CBOR ones by replacing the prefix. The objects and
+ * arrays are encoded as indefinite length CBOR maps and arrays with tinycbor.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "cbor.h"
+#include "cbor_stream.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum nesting of objects and arrays */
+#ifndef CBOR_GEN_MAX_DEPTH
+#define CBOR_GEN_MAX_DEPTH 8
+#endif
+
+/**
+ * @brief CBOR generator context, the elements must not be modified
+ */
+typedef struct {
+    CborEncoder enc[CBOR_GEN_MAX_DEPTH + 1];    /* encoders of the open containers, enc[0] is the buffer */
+    int depth;                                  /* number of open containers */
+    uint8_t *buf;                               /* buffer passed to cbor_gen_start() */
+    size_t buf_size;                            /* size of the buffer */
+    cbor_stream_t *stream;                      /* streaming writer of cbor_gen_start_stream(), NULL if none */
+    CborError err;                              /* first error, the generation stops once set */
+} cbor_gen_t;
+
+/**
+ * @brief Start generating CBOR into a buffer, like json_gen_str_start()
+ *
+ * @param cgen Generator context
+ * @param buf Buffer for the CBOR data
+ * @param buf_size Size of the buffer
+ */
+void cbor_gen_start(cbor_gen_t *cgen, uint8_t *buf, size_t buf_size);
+
+/**
+ * @brief Start generating CBOR flushed out in chunks, like json_gen_str_start() with a flush callback
+ *
+ * See cbor_stream_init().
+ *
+ * @param cgen Generator context
+ * @param stream Streaming writer, must stay valid until cbor_gen_end()
+ * @param buf Chunk buffer
+ * @param buf_size Size of the chunk buffer
+ * @param flush_cb Flush callback for each chunk
+ * @param priv Private data passed to the flush callback
+ */
+void cbor_gen_start_stream(cbor_gen_t *cgen, cbor_stream_t *stream, uint8_t *buf, size_t buf_size,
+                           cbor_stream_flush_cb_t flush_cb, void *priv);
+
+/**
+ * @brief End the CBOR generation, like json_gen_str_end()
+ *
+ * @param cgen Generator context
+ * @param[out] ret_needed Size of the buffer needed if it was too small, can be NULL
+ *
+ * @return Length of the CBOR data, -1 if the buffer was too small, a flush failed or the calls were not balanced
+ */
+int cbor_gen_end(cbor_gen_t *cgen, size_t *ret_needed);
+
+/*
+ * The functions below return 0 on success and -1 on error, after which all calls fail.
+ * Running out of buffer is reported by cbor_gen_end() only, with the size needed.
+ */
+int cbor_gen_start_object(cbor_gen_t *cgen);
+int cbor_gen_end_object(cbor_gen_t *cgen);
+int cbor_gen_start_array(cbor_gen_t *cgen);
+int cbor_gen_end_array(cbor_gen_t *cgen);
+int cbor_gen_push_object(cbor_gen_t *cgen, const char *name);
+int cbor_gen_pop_object(cbor_gen_t *cgen);
+int cbor_gen_push_array(cbor_gen_t *cgen, const char *name);
+int cbor_gen_pop_array(cbor_gen_t *cgen);
+
+int cbor_gen_obj_set_bool(cbor_gen_t *cgen, const char *name, bool val);
+int cbor_gen_obj_set_int(cbor_gen_t *cgen, const char *name, int val);
+int cbor_gen_obj_set_int64(cbor_gen_t *cgen, const char *name, int64_t val);
+int cbor_gen_obj_set_float(cbor_gen_t *cgen, const char *name, float val);
+int cbor_gen_obj_set_double(cbor_gen_t *cgen, const char *name, double val);
+int cbor_gen_obj_set_string(cbor_gen_t *cgen, const char *name, const char *val);
+int cbor_gen_obj_set_string_n(cbor_gen_t *cgen, const char *name, const char *val, size_t val_len);
+/* Binary data as a CBOR byte string, which has no JSON equivalent */
+int cbor_gen_obj_set_bytes(cbor_gen_t *cgen, const char *name, const uint8_t *val, size_t val_len);
+int cbor_gen_obj_set_null(cbor_gen_t *cgen, const char *name);
+
+int cbor_gen_arr_set_bool(cbor_gen_t *cgen, bool val);
+int cbor_gen_arr_set_int(cbor_gen_t *cgen, int val);
+int cbor_gen_arr_set_int64(cbor_gen_t *cgen, int64_t val);
+int cbor_gen_arr_set_float(cbor_gen_t *cgen, float val);
+int cbor_gen_arr_set_double(cbor_gen_t *cgen, double val);
+int cbor_gen_arr_set_string(cbor_gen_t *cgen, const char *val);
+int cbor_gen_arr_set_string_n(cbor_gen_t *cgen, const char *val, size_t val_len);
+int cbor_gen_arr_set_bytes(cbor_gen_t *cgen, const uint8_t *val, size_t val_len);
+int cbor_gen_arr_set_null(cbor_gen_t *cgen);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * CBOR reader with the API of json_parser
+ *
+ * The functions have the names and arguments of the json_parse_*, json_obj_*
+ * and json_arr_* ones of the json_parser component with a cbor_ prefix, so
+ * that the code reading JSON messages can read CBOR ones by replacing the
+ * prefix. The elements are looked up with the tinycbor CborValue API, maps
+ * must have text string keys.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "cbor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum nesting of the objects and arrays entered */
+#ifndef CBOR_PARSE_MAX_DEPTH
+#define CBOR_PARSE_MAX_DEPTH 8
+#endif
+
+/**
+ * @brief CBOR reader context, the elements must not be modified
+ */
+typedef struct {
+    CborParser parser;
+    CborValue stack[CBOR_PARSE_MAX_DEPTH + 1];  /* containers entered, stack[0] is the top level map */
+    int depth;                                  /* number of containers entered */
+} cbor_parse_ctx_t;
+
+/**
+ * @brief Start reading a CBOR message, like json_parse_start()
+ *
+ * The whole message is validated, its top level item must be a map.
+ *
+ * @param cctx Reader context
+ * @param buf CBOR data, must stay valid until cbor_parse_end()
+ * @param len Length of the data
+ *
+ * @return 0 on success, -1 if the data is not a valid CBOR map
+ */
+int cbor_parse_start(cbor_parse_ctx_t *cctx, const uint8_t *buf, size_t len);
+int cbor_parse_end(cbor_parse_ctx_t *cctx);
+
+/*
+ * The functions below return 0 on success and -1 if the element is missing
+ * or has another type. Integers are accepted for the float and double getters,
+ * like in JSON.
+ */
+int cbor_obj_get_array(cbor_parse_ctx_t *cctx, const char *name, int *num_elem);
+int cbor_obj_leave_array(cbor_parse_ctx_t *cctx);
+int cbor_obj_get_object(cbor_parse_ctx_t *cctx, const char *name);
+int cbor_obj_leave_object(cbor_parse_ctx_t *cctx);
+int cbor_obj_get_bool(cbor_parse_ctx_t *cctx, const char *name, bool *val);
+int cbor_obj_get_int(cbor_parse_ctx_t *cctx, const char *name, int *val);
+int cbor_obj_get_int64(cbor_parse_ctx_t *cctx, const char *name, int64_t *val);
+int cbor_obj_get_float(cbor_parse_ctx_t *cctx, const char *name, float *val);
+int cbor_obj_get_double(cbor_parse_ctx_t *cctx, const char *name, double *val);
+/* The string is NULL terminated, size includes the NULL termination */
+int cbor_obj_get_string(cbor_parse_ctx_t *cctx, const char *name, char *val, int size);
+int cbor_obj_get_strlen(cbor_parse_ctx_t *cctx, const char *name, int *strlen);
+/* Byte strings, *len is the size of val on input and the length of the data on output */
+int cbor_obj_get_bytes(cbor_parse_ctx_t *cctx, const char *name, uint8_t *val, size_t *len);
+
+int cbor_arr_get_array(cbor_parse_ctx_t *cctx, uint32_t index);
+int cbor_arr_leave_array(cbor_parse_ctx_t *cctx);
+int cbor_arr_get_object(cbor_parse_ctx_t *cctx, uint32_t index);
+int cbor_arr_leave_object(cbor_parse_ctx_t *cctx);
+int cbor_arr_get_bool(cbor_parse_ctx_t *cctx, uint32_t index, bool *val);
+int cbor_arr_get_int(cbor_parse_ctx_t *cctx, uint32_t index, int *val);
+int cbor_arr_get_int64(cbor_parse_ctx_t *cctx, uint32_t index, int64_t *val);
+int cbor_arr_get_float(cbor_parse_ctx_t *cctx, uint32_t index, float *val);
+int cbor_arr_get_double(cbor_parse_ctx_t *cctx, uint32_t index, double *val);
+int cbor_arr_get_string(cbor_parse_ctx_t *cctx, uint32_t index, char *val, int size);
+int cbor_arr_get_strlen(cbor_parse_ctx_t *cctx, uint32_t index, int *strlen);
+int cbor_arr_get_bytes(cbor_parse_ctx_t *cctx, uint32_t index, uint8_t *val, size_t *len);
+
+/* Type of a struct member decoded by cbor_obj_decode_struct() */
+typedef enum {
+    CBOR_FIELD_BOOL,    /* bool */
+    CBOR_FIELD_INT,     /* int */
+    CBOR_FIELD_INT64,   /* int64_t */
+    CBOR_FIELD_FLOAT,   /* float */
+    CBOR_FIELD_DOUBLE,  /* double */
+    CBOR_FIELD_STRING,  /* char array, NULL terminated text string */
+    CBOR_FIELD_BYTES,   /* uint8_t array, byte string with its length in a size_t member */
+    CBOR_FIELD_OBJECT,  /* struct described by a cbor_struct_desc_t */
+} cbor_field_type_t;
+
+/* Maximum number of fields of a cbor_struct_desc_t, nested objects have their own */
+#define CBOR_STRUCT_MAX_FIELDS 64
+
+typedef struct cbor_struct_desc cbor_struct_desc_t;
+
+/* Member of a C struct decoded from an element of a CBOR map, declare with the CBOR_STRUCT_* macros */
+typedef struct {
+    const char *name;                   /* Text key of the field, NULL for an integer key */
+    int64_t int_key;                    /* Integer key of the field if name is NULL */
+    cbor_field_type_t type;             /* Type of the value and of the member */
+    size_t offset;                      /* Offset of the member in the struct */
+    size_t size;                        /* Size of the member */
+    size_t len_offset;                  /* Offset of the size_t length member for CBOR_FIELD_BYTES */
+    const cbor_struct_desc_t *object;   /* Fields of the member for CBOR_FIELD_OBJECT */
+} cbor_struct_field_t;
+
+struct cbor_struct_desc {
+    const cbor_struct_field_t *fields;
+    int num_fields;
+};
+
+#define CBOR_STRUCT_MEMBER(struct_type, member, field_type) \
+    .type = field_type, .offset = offsetof(struct_type, member), .size = sizeof(((struct_type *)0)->member)
+
+/* Member of type field_type (all but CBOR_FIELD_BYTES and CBOR_FIELD_OBJECT), with a text or an integer key */
+#define CBOR_STRUCT_FIELD(struct_type, member, field_type, key) \
+    { .name = key, CBOR_STRUCT_MEMBER(struct_type, member, field_type) }
+#define CBOR_STRUCT_FIELD_INT_KEY(struct_type, member, field_type, key) \
+    { .name = NULL, .int_key = key, CBOR_STRUCT_MEMBER(struct_type, member, field_type) }
+/* Byte string stored in the array member, and its length in len_member */
+#define CBOR_STRUCT_BYTES(struct_type, member, len_member, key) \
+    { .name = key, CBOR_STRUCT_MEMBER(struct_type, member, CBOR_FIELD_BYTES), .len_offset = offsetof(struct_type, len_member) }
+#define CBOR_STRUCT_BYTES_INT_KEY(struct_type, member, len_member, key) \
+    { .name = NULL, .int_key = key, CBOR_STRUCT_MEMBER(struct_type, member, CBOR_FIELD_BYTES), \
+      .len_offset = offsetof(struct_type, len_member) }
+/* Nested map decoded into the struct member described by member_desc */
+#define CBOR_STRUCT_OBJECT(struct_type, member, key, member_desc) \
+    { .name = key, CBOR_STRUCT_MEMBER(struct_type, member, CBOR_FIELD_OBJECT), .object = &(member_desc) }
+#define CBOR_STRUCT_OBJECT_INT_KEY(struct_type, member, key, member_desc) \
+    { .name = NULL, .int_key = key, CBOR_STRUCT_MEMBER(struct_type, member, CBOR_FIELD_OBJECT), .object = &(member_desc) }
+/* Descriptor of a static array of cbor_struct_field_t */
+#define CBOR_STRUCT_DESC(field_array) { .fields = field_array, .num_fields = sizeof(field_array) / sizeof(field_array[0]) }
+
+/* Decode a map into the struct out in a single pass over its elements, instead of a
+ * cbor_value_map_find_value() scan per field. Elements with other keys are skipped and
+ * members of missing keys are left unchanged, so preset the defaults of optional ones.
+ * Returns 0 if all the fields, including the nested ones, were found.
+ */
+int cbor_map_decode_struct(const CborValue *map, const cbor_struct_desc_t *desc, void *out);
+
+/* Same as cbor_map_decode_struct() for the current object */
+int cbor_obj_decode_struct(cbor_parse_ctx_t *cctx, const cbor_struct_desc_t *desc, void *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Streaming CBOR writer
+ *
+ * A tinycbor write function which collects the encoded data in a small chunk
+ * buffer and hands out each full chunk to a flush callback, like the flush_cb
+ * of json_generator. Documents of any size are then encoded with constant memory,
+ * instead of into a buffer sized for the whole document.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "cbor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Flush callback, called with the next chunk of the CBOR document
+ *
+ * @param data Chunk of the document, valid only during the call
+ * @param len Length of the chunk
+ * @param priv Private data passed to cbor_stream_init()
+ *
+ * @return 0 on success, any other value fails the encoding with CborErrorIO
+ */
+typedef int (*cbor_stream_flush_cb_t)(const uint8_t *data, size_t len, void *priv);
+
+/**
+ * @brief Streaming writer, the elements must not be modified
+ */
+typedef struct {
+    uint8_t *buf;                   /* chunk buffer */
+    size_t buf_size;                /* size of the chunk buffer */
+    size_t used;                    /* bytes in the chunk buffer not flushed yet */
+    size_t total_len;               /* bytes encoded so far */
+    cbor_stream_flush_cb_t flush_cb;
+    void *priv;
+    bool failed;                    /* a flush failed, the writer drops all data */
+} cbor_stream_t;
+
+/**
+ * @brief Initialise a streaming writer and an encoder writing to it
+ *
+ * The encoder is used with the cbor_encode_* and cbor_encoder_* functions of tinycbor
+ * like one initialised with cbor_encoder_init(). Strings of at least the size of the
+ * chunk buffer are passed to the flush callback directly, without being copied.
+ *
+ * @param stream Streaming writer
+ * @param[out] encoder Returned top level encoder
+ * @param buf Chunk buffer
+ * @param buf_size Size of the chunk buffer, also the size of the flushed chunks except the last one
+ * @param flush_cb Flush callback
+ * @param priv Private data passed to the flush callback
+ */
+void cbor_stream_init(cbor_stream_t *stream, CborEncoder *encoder, uint8_t *buf, size_t buf_size,
+                      cbor_stream_flush_cb_t flush_cb, void *priv);
+
+/**
+ * @brief Flush the data left in the chunk buffer, at the end of the document
+ *
+ * @param stream Streaming writer
+ *
+ * @return Total length of the CBOR document, -1 if a flush failed
+ */
+int cbor_stream_end(cbor_stream_t *stream);
+
+#ifdef __cplusplus
+}
+#endif
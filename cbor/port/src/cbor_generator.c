@@ -0,0 +1,265 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "cbor_generator.h"
+
+/* Keep the first error, running out of buffer is not one for tinycbor which
+ * goes on counting the bytes needed
+ */
+static int cbor_gen_check(cbor_gen_t *cgen, CborError err)
+{
+    if (err != CborNoError && err != CborErrorOutOfMemory && cgen->err == CborNoError) {
+        cgen->err = err;
+    }
+    return cgen->err == CborNoError ? 0 : -1;
+}
+
+static inline CborEncoder *cbor_gen_cur(cbor_gen_t *cgen)
+{
+    return &cgen->enc[cgen->depth];
+}
+
+static int cbor_gen_open(cbor_gen_t *cgen, bool map)
+{
+    if (cgen->err != CborNoError) {
+        return -1;
+    }
+    if (cgen->depth >= CBOR_GEN_MAX_DEPTH) {
+        return cbor_gen_check(cgen, CborErrorNestingTooDeep);
+    }
+    CborEncoder *parent = cbor_gen_cur(cgen);
+    CborEncoder *child = &cgen->enc[cgen->depth + 1];
+    CborError err = map ? cbor_encoder_create_map(parent, child, CborIndefiniteLength) :
+                    cbor_encoder_create_array(parent, child, CborIndefiniteLength);
+    if (cbor_gen_check(cgen, err) != 0) {
+        return -1;
+    }
+    cgen->depth++;
+    return 0;
+}
+
+static int cbor_gen_close(cbor_gen_t *cgen)
+{
+    if (cgen->err != CborNoError) {
+        return -1;
+    }
+    if (cgen->depth == 0) {
+        /* More containers closed than opened */
+        return cbor_gen_check(cgen, CborErrorTooFewItems);
+    }
+    cgen->depth--;
+    return cbor_gen_check(cgen, cbor_encoder_close_container(cbor_gen_cur(cgen), &cgen->enc[cgen->depth + 1]));
+}
+
+static int cbor_gen_name(cbor_gen_t *cgen, const char *name)
+{
+    if (cgen->err != CborNoError) {
+        return -1;
+    }
+    return cbor_gen_check(cgen, cbor_encode_text_stringz(cbor_gen_cur(cgen), name));
+}
+
+void cbor_gen_start(cbor_gen_t *cgen, uint8_t *buf, size_t buf_size)
+{
+    memset(cgen, 0, sizeof(cbor_gen_t));
+    cgen->buf = buf;
+    cgen->buf_size = buf_size;
+    cbor_encoder_init(&cgen->enc[0], buf, buf_size, 0);
+}
+
+void cbor_gen_start_stream(cbor_gen_t *cgen, cbor_stream_t *stream, uint8_t *buf, size_t buf_size,
+                           cbor_stream_flush_cb_t flush_cb, void *priv)
+{
+    memset(cgen, 0, sizeof(cbor_gen_t));
+    cgen->stream = stream;
+    cbor_stream_init(stream, &cgen->enc[0], buf, buf_size, flush_cb, priv);
+}
+
+int cbor_gen_end(cbor_gen_t *cgen, size_t *ret_needed)
+{
+    int ret = -1;
+    if (cgen->stream) {
+        if (cgen->err == CborNoError && cgen->depth == 0) {
+            ret = cbor_stream_end(cgen->stream);
+        }
+    } else if (cgen->err == CborNoError && cgen->depth == 0) {
+        size_t extra = cbor_encoder_get_extra_bytes_needed(&cgen->enc[0]);
+        if (extra) {
+            if (ret_needed) {
+                /* The write pointer holds the count once out of buffer */
+                *ret_needed = cgen->buf_size + extra;
+            }
+        } else {
+            ret = cbor_encoder_get_buffer_size(&cgen->enc[0], cgen->buf);
+        }
+    }
+    memset(cgen, 0, sizeof(cbor_gen_t));
+    return ret;
+}
+
+int cbor_gen_start_object(cbor_gen_t *cgen)
+{
+    return cbor_gen_open(cgen, true);
+}
+
+int cbor_gen_end_object(cbor_gen_t *cgen)
+{
+    return cbor_gen_close(cgen);
+}
+
+int cbor_gen_start_array(cbor_gen_t *cgen)
+{
+    return cbor_gen_open(cgen, false);
+}
+
+int cbor_gen_end_array(cbor_gen_t *cgen)
+{
+    return cbor_gen_close(cgen);
+}
+
+int cbor_gen_push_object(cbor_gen_t *cgen, const char *name)
+{
+    cbor_gen_name(cgen, name);
+    return cbor_gen_open(cgen, true);
+}
+
+int cbor_gen_pop_object(cbor_gen_t *cgen)
+{
+    return cbor_gen_close(cgen);
+}
+
+int cbor_gen_push_array(cbor_gen_t *cgen, const char *name)
+{
+    cbor_gen_name(cgen, name);
+    return cbor_gen_open(cgen, false);
+}
+
+int cbor_gen_pop_array(cbor_gen_t *cgen)
+{
+    return cbor_gen_close(cgen);
+}
+
+int cbor_gen_arr_set_bool(cbor_gen_t *cgen, bool val)
+{
+    if (cgen->err != CborNoError) {
+        return -1;
+    }
+    return cbor_gen_check(cgen, cbor_encode_boolean(cbor_gen_cur(cgen), val));
+}
+
+int cbor_gen_arr_set_int(cbor_gen_t *cgen, int val)
+{
+    return cbor_gen_arr_set_int64(cgen, val);
+}
+
+int cbor_gen_arr_set_int64(cbor_gen_t *cgen, int64_t val)
+{
+    if (cgen->err != CborNoError) {
+        return -1;
+    }
+    return cbor_gen_check(cgen, cbor_encode_int(cbor_gen_cur(cgen), val));
+}
+
+int cbor_gen_arr_set_float(cbor_gen_t *cgen, float val)
+{
+    if (cgen->err != CborNoError) {
+        return -1;
+    }
+    return cbor_gen_check(cgen, cbor_encode_float(cbor_gen_cur(cgen), val));
+}
+
+int cbor_gen_arr_set_double(cbor_gen_t *cgen, double val)
+{
+    if (cgen->err != CborNoError) {
+        return -1;
+    }
+    return cbor_gen_check(cgen, cbor_encode_double(cbor_gen_cur(cgen), val));
+}
+
+int cbor_gen_arr_set_string(cbor_gen_t *cgen, const char *val)
+{
+    return cbor_gen_arr_set_string_n(cgen, val, strlen(val));
+}
+
+int cbor_gen_arr_set_string_n(cbor_gen_t *cgen, const char *val, size_t val_len)
+{
+    if (cgen->err != CborNoError) {
+        return -1;
+    }
+    return cbor_gen_check(cgen, cbor_encode_text_string(cbor_gen_cur(cgen), val, val_len));
+}
+
+int cbor_gen_arr_set_bytes(cbor_gen_t *cgen, const uint8_t *val, size_t val_len)
+{
+    if (cgen->err != CborNoError) {
+        return -1;
+    }
+    return cbor_gen_check(cgen, cbor_encode_byte_string(cbor_gen_cur(cgen), val, val_len));
+}
+
+int cbor_gen_arr_set_null(cbor_gen_t *cgen)
+{
+    if (cgen->err != CborNoError) {
+        return -1;
+    }
+    return cbor_gen_check(cgen, cbor_encode_null(cbor_gen_cur(cgen)));
+}
+
+/* An element of an object is its name followed by the value, like an array element */
+int cbor_gen_obj_set_bool(cbor_gen_t *cgen, const char *name, bool val)
+{
+    cbor_gen_name(cgen, name);
+    return cbor_gen_arr_set_bool(cgen, val);
+}
+
+int cbor_gen_obj_set_int(cbor_gen_t *cgen, const char *name, int val)
+{
+    cbor_gen_name(cgen, name);
+    return cbor_gen_arr_set_int64(cgen, val);
+}
+
+int cbor_gen_obj_set_int64(cbor_gen_t *cgen, const char *name, int64_t val)
+{
+    cbor_gen_name(cgen, name);
+    return cbor_gen_arr_set_int64(cgen, val);
+}
+
+int cbor_gen_obj_set_float(cbor_gen_t *cgen, const char *name, float val)
+{
+    cbor_gen_name(cgen, name);
+    return cbor_gen_arr_set_float(cgen, val);
+}
+
+int cbor_gen_obj_set_double(cbor_gen_t *cgen, const char *name, double val)
+{
+    cbor_gen_name(cgen, name);
+    return cbor_gen_arr_set_double(cgen, val);
+}
+
+int cbor_gen_obj_set_string(cbor_gen_t *cgen, const char *name, const char *val)
+{
+    cbor_gen_name(cgen, name);
+    return cbor_gen_arr_set_string_n(cgen, val, strlen(val));
+}
+
+int cbor_gen_obj_set_string_n(cbor_gen_t *cgen, const char *name, const char *val, size_t val_len)
+{
+    cbor_gen_name(cgen, name);
+    return cbor_gen_arr_set_string_n(cgen, val, val_len);
+}
+
+int cbor_gen_obj_set_bytes(cbor_gen_t *cgen, const char *name, const uint8_t *val, size_t val_len)
+{
+    cbor_gen_name(cgen, name);
+    return cbor_gen_arr_set_bytes(cgen, val, val_len);
+}
+
+int cbor_gen_obj_set_null(cbor_gen_t *cgen, const char *name)
+{
+    cbor_gen_name(cgen, name);
+    return cbor_gen_arr_set_null(cgen);
+}
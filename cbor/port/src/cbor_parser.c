@@ -0,0 +1,492 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "cbor_parser.h"
+
+static inline CborValue *cbor_parse_cur(cbor_parse_ctx_t *cctx)
+{
+    return &cctx->stack[cctx->depth];
+}
+
+/* Find the value of an element of the current map */
+static int cbor_obj_get_value(cbor_parse_ctx_t *cctx, const char *name, CborValue *val)
+{
+    CborValue *map = cbor_parse_cur(cctx);
+    if (!cbor_value_is_map(map) || cbor_value_map_find_value(map, name, val) != CborNoError) {
+        return -1;
+    }
+    /* Invalid type if not found */
+    return cbor_value_is_valid(val) ? 0 : -1;
+}
+
+/* Find an element of the current array */
+static int cbor_arr_get_value(cbor_parse_ctx_t *cctx, uint32_t index, CborValue *val)
+{
+    CborValue *arr = cbor_parse_cur(cctx);
+    if (!cbor_value_is_array(arr) || cbor_value_enter_container(arr, val) != CborNoError) {
+        return -1;
+    }
+    while (!cbor_value_at_end(val) && index) {
+        if (cbor_value_advance(val) != CborNoError) {
+            return -1;
+        }
+        index--;
+    }
+    return cbor_value_at_end(val) ? -1 : 0;
+}
+
+static int cbor_parse_enter(cbor_parse_ctx_t *cctx, const CborValue *container)
+{
+    if (cctx->depth >= CBOR_PARSE_MAX_DEPTH) {
+        return -1;
+    }
+    cctx->stack[++cctx->depth] = *container;
+    return 0;
+}
+
+static int cbor_parse_leave(cbor_parse_ctx_t *cctx, CborType type)
+{
+    if (cctx->depth == 0 || cbor_value_get_type(cbor_parse_cur(cctx)) != type) {
+        return -1;
+    }
+    cctx->depth--;
+    return 0;
+}
+
+static int cbor_parse_enter_array(cbor_parse_ctx_t *cctx, CborValue *val, int *num_elem)
+{
+    if (!cbor_value_is_array(val)) {
+        return -1;
+    }
+    if (num_elem) {
+        size_t len = 0;
+        if (cbor_value_is_length_known(val)) {
+            if (cbor_value_get_array_length(val, &len) != CborNoError) {
+                return -1;
+            }
+        } else {
+            /* Indefinite length, count the elements */
+            CborValue elem;
+            if (cbor_value_enter_container(val, &elem) != CborNoError) {
+                return -1;
+            }
+            while (!cbor_value_at_end(&elem)) {
+                if (cbor_value_advance(&elem) != CborNoError) {
+                    return -1;
+                }
+                len++;
+            }
+        }
+        *num_elem = len;
+    }
+    return cbor_parse_enter(cctx, val);
+}
+
+static int cbor_parse_enter_object(cbor_parse_ctx_t *cctx, CborValue *val)
+{
+    if (!cbor_value_is_map(val)) {
+        return -1;
+    }
+    return cbor_parse_enter(cctx, val);
+}
+
+static int cbor_parse_to_bool(CborValue *val, bool *ret)
+{
+    if (!cbor_value_is_boolean(val)) {
+        return -1;
+    }
+    return cbor_value_get_boolean(val, ret) == CborNoError ? 0 : -1;
+}
+
+static int cbor_parse_to_int(CborValue *val, int *ret)
+{
+    if (!cbor_value_is_integer(val)) {
+        return -1;
+    }
+    return cbor_value_get_int_checked(val, ret) == CborNoError ? 0 : -1;
+}
+
+static int cbor_parse_to_int64(CborValue *val, int64_t *ret)
+{
+    if (!cbor_value_is_integer(val)) {
+        return -1;
+    }
+    return cbor_value_get_int64_checked(val, ret) == CborNoError ? 0 : -1;
+}
+
+static int cbor_parse_to_double(CborValue *val, double *ret)
+{
+    CborError err = CborErrorIllegalType;
+    if (cbor_value_is_double(val)) {
+        err = cbor_value_get_double(val, ret);
+    } else if (cbor_value_is_float(val)) {
+        float f;
+        err = cbor_value_get_float(val, &f);
+        *ret = f;
+    } else if (cbor_value_is_half_float(val)) {
+        float f;
+        err = cbor_value_get_half_float_as_float(val, &f);
+        *ret = f;
+    } else if (cbor_value_is_integer(val)) {
+        int64_t i;
+        err = cbor_value_get_int64_checked(val, &i);
+        *ret = i;
+    }
+    return err == CborNoError ? 0 : -1;
+}
+
+static int cbor_parse_to_float(CborValue *val, float *ret)
+{
+    double d;
+    if (cbor_parse_to_double(val, &d) != 0) {
+        return -1;
+    }
+    *ret = d;
+    return 0;
+}
+
+static int cbor_parse_to_string(CborValue *val, char *ret, int size)
+{
+    if (!cbor_value_is_text_string(val) || size <= 0) {
+        return -1;
+    }
+    size_t len = size;
+    if (cbor_value_copy_text_string(val, ret, &len, NULL) != CborNoError) {
+        return -1;
+    }
+    /* No room for the NULL termination */
+    return len < (size_t)size ? 0 : -1;
+}
+
+static int cbor_parse_to_strlen(CborValue *val, int *ret)
+{
+    size_t len;
+    if (!cbor_value_is_text_string(val) || cbor_value_calculate_string_length(val, &len) != CborNoError) {
+        return -1;
+    }
+    *ret = len;
+    return 0;
+}
+
+static int cbor_parse_to_bytes(CborValue *val, uint8_t *ret, size_t *len)
+{
+    if (!cbor_value_is_byte_string(val)) {
+        return -1;
+    }
+    return cbor_value_copy_byte_string(val, ret, len, NULL) == CborNoError ? 0 : -1;
+}
+
+static int cbor_parse_to_value(CborValue *val, cbor_field_type_t type, void *ret, size_t size)
+{
+    switch (type) {
+    case CBOR_FIELD_BOOL:
+        return cbor_parse_to_bool(val, ret);
+    case CBOR_FIELD_INT:
+        return cbor_parse_to_int(val, ret);
+    case CBOR_FIELD_INT64:
+        return cbor_parse_to_int64(val, ret);
+    case CBOR_FIELD_FLOAT:
+        return cbor_parse_to_float(val, ret);
+    case CBOR_FIELD_DOUBLE:
+        return cbor_parse_to_double(val, ret);
+    case CBOR_FIELD_STRING:
+        return cbor_parse_to_string(val, ret, size);
+    default:
+        return -1;
+    }
+}
+
+static bool cbor_key_matches(const CborValue *key, const cbor_struct_field_t *field)
+{
+    if (field->name) {
+        bool equal = false;
+        return cbor_value_is_text_string(key) && cbor_value_text_string_equals(key, field->name, &equal) == CborNoError && equal;
+    }
+    int64_t int_key;
+    return cbor_value_is_integer(key) && cbor_value_get_int64_checked(key, &int_key) == CborNoError && int_key == field->int_key;
+}
+
+static int cbor_decode_field(CborValue *val, const cbor_struct_field_t *field, void *out)
+{
+    void *member = (char *)out + field->offset;
+    if (field->type == CBOR_FIELD_OBJECT) {
+        return cbor_map_decode_struct(val, field->object, member);
+    }
+    if (field->type == CBOR_FIELD_BYTES) {
+        size_t len = field->size;
+        if (cbor_parse_to_bytes(val, member, &len) != 0) {
+            return -1;
+        }
+        memcpy((char *)out + field->len_offset, &len, sizeof(len));
+        return 0;
+    }
+    return cbor_parse_to_value(val, field->type, member, field->size);
+}
+
+int cbor_map_decode_struct(const CborValue *map, const cbor_struct_desc_t *desc, void *out)
+{
+    const cbor_struct_field_t *fields = desc->fields;
+    const int num_fields = desc->num_fields;
+    CborValue it;
+    if (!cbor_value_is_map(map) || num_fields > CBOR_STRUCT_MAX_FIELDS ||
+            cbor_value_enter_container(map, &it) != CborNoError) {
+        return -1;
+    }
+
+    /* Keys are tried from the one after the last match, so that elements in the
+     * order of the fields match at the first try. found has a bit per field.
+     */
+    uint64_t found = 0;
+    int num_found = 0;
+    int next = 0;
+    while (!cbor_value_at_end(&it) && num_found < num_fields) {
+        CborValue key = it;
+        if (cbor_value_advance(&it) != CborNoError) {
+            return -1;
+        }
+        for (int n = 0; n < num_fields; n++) {
+            int i = (next + n) % num_fields;
+            if ((found & (1ULL << i)) || !cbor_key_matches(&key, &fields[i])) {
+                continue;
+            }
+            if (cbor_decode_field(&it, &fields[i], out) == 0) {
+                found |= 1ULL << i;
+                num_found++;
+            }
+            next = (i + 1) % num_fields;
+            break;
+        }
+        if (cbor_value_advance(&it) != CborNoError) {
+            return -1;
+        }
+    }
+    return num_found == num_fields ? 0 : -1;
+}
+
+int cbor_obj_decode_struct(cbor_parse_ctx_t *cctx, const cbor_struct_desc_t *desc, void *out)
+{
+    return cbor_map_decode_struct(cbor_parse_cur(cctx), desc, out);
+}
+
+int cbor_parse_start(cbor_parse_ctx_t *cctx, const uint8_t *buf, size_t len)
+{
+    memset(cctx, 0, sizeof(cbor_parse_ctx_t));
+    if (cbor_parser_init(buf, len, 0, &cctx->parser, &cctx->stack[0]) != CborNoError) {
+        return -1;
+    }
+    /* Validated once, so that the lookups below don't run past the data */
+    if (!cbor_value_is_map(&cctx->stack[0]) || cbor_value_validate_basic(&cctx->stack[0]) != CborNoError) {
+        return -1;
+    }
+    return 0;
+}
+
+int cbor_parse_end(cbor_parse_ctx_t *cctx)
+{
+    memset(cctx, 0, sizeof(cbor_parse_ctx_t));
+    return 0;
+}
+
+int cbor_obj_get_array(cbor_parse_ctx_t *cctx, const char *name, int *num_elem)
+{
+    CborValue val;
+    if (cbor_obj_get_value(cctx, name, &val) != 0) {
+        return -1;
+    }
+    return cbor_parse_enter_array(cctx, &val, num_elem);
+}
+
+int cbor_obj_leave_array(cbor_parse_ctx_t *cctx)
+{
+    return cbor_parse_leave(cctx, CborArrayType);
+}
+
+int cbor_obj_get_object(cbor_parse_ctx_t *cctx, const char *name)
+{
+    CborValue val;
+    if (cbor_obj_get_value(cctx, name, &val) != 0) {
+        return -1;
+    }
+    return cbor_parse_enter_object(cctx, &val);
+}
+
+int cbor_obj_leave_object(cbor_parse_ctx_t *cctx)
+{
+    return cbor_parse_leave(cctx, CborMapType);
+}
+
+int cbor_obj_get_bool(cbor_parse_ctx_t *cctx, const char *name, bool *val)
+{
+    CborValue v;
+    if (cbor_obj_get_value(cctx, name, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_bool(&v, val);
+}
+
+int cbor_obj_get_int(cbor_parse_ctx_t *cctx, const char *name, int *val)
+{
+    CborValue v;
+    if (cbor_obj_get_value(cctx, name, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_int(&v, val);
+}
+
+int cbor_obj_get_int64(cbor_parse_ctx_t *cctx, const char *name, int64_t *val)
+{
+    CborValue v;
+    if (cbor_obj_get_value(cctx, name, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_int64(&v, val);
+}
+
+int cbor_obj_get_float(cbor_parse_ctx_t *cctx, const char *name, float *val)
+{
+    CborValue v;
+    if (cbor_obj_get_value(cctx, name, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_float(&v, val);
+}
+
+int cbor_obj_get_double(cbor_parse_ctx_t *cctx, const char *name, double *val)
+{
+    CborValue v;
+    if (cbor_obj_get_value(cctx, name, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_double(&v, val);
+}
+
+int cbor_obj_get_string(cbor_parse_ctx_t *cctx, const char *name, char *val, int size)
+{
+    CborValue v;
+    if (cbor_obj_get_value(cctx, name, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_string(&v, val, size);
+}
+
+int cbor_obj_get_strlen(cbor_parse_ctx_t *cctx, const char *name, int *strlen)
+{
+    CborValue v;
+    if (cbor_obj_get_value(cctx, name, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_strlen(&v, strlen);
+}
+
+int cbor_obj_get_bytes(cbor_parse_ctx_t *cctx, const char *name, uint8_t *val, size_t *len)
+{
+    CborValue v;
+    if (cbor_obj_get_value(cctx, name, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_bytes(&v, val, len);
+}
+
+int cbor_arr_get_array(cbor_parse_ctx_t *cctx, uint32_t index)
+{
+    CborValue val;
+    if (cbor_arr_get_value(cctx, index, &val) != 0) {
+        return -1;
+    }
+    return cbor_parse_enter_array(cctx, &val, NULL);
+}
+
+int cbor_arr_leave_array(cbor_parse_ctx_t *cctx)
+{
+    return cbor_parse_leave(cctx, CborArrayType);
+}
+
+int cbor_arr_get_object(cbor_parse_ctx_t *cctx, uint32_t index)
+{
+    CborValue val;
+    if (cbor_arr_get_value(cctx, index, &val) != 0) {
+        return -1;
+    }
+    return cbor_parse_enter_object(cctx, &val);
+}
+
+int cbor_arr_leave_object(cbor_parse_ctx_t *cctx)
+{
+    return cbor_parse_leave(cctx, CborMapType);
+}
+
+int cbor_arr_get_bool(cbor_parse_ctx_t *cctx, uint32_t index, bool *val)
+{
+    CborValue v;
+    if (cbor_arr_get_value(cctx, index, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_bool(&v, val);
+}
+
+int cbor_arr_get_int(cbor_parse_ctx_t *cctx, uint32_t index, int *val)
+{
+    CborValue v;
+    if (cbor_arr_get_value(cctx, index, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_int(&v, val);
+}
+
+int cbor_arr_get_int64(cbor_parse_ctx_t *cctx, uint32_t index, int64_t *val)
+{
+    CborValue v;
+    if (cbor_arr_get_value(cctx, index, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_int64(&v, val);
+}
+
+int cbor_arr_get_float(cbor_parse_ctx_t *cctx, uint32_t index, float *val)
+{
+    CborValue v;
+    if (cbor_arr_get_value(cctx, index, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_float(&v, val);
+}
+
+int cbor_arr_get_double(cbor_parse_ctx_t *cctx, uint32_t index, double *val)
+{
+    CborValue v;
+    if (cbor_arr_get_value(cctx, index, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_double(&v, val);
+}
+
+int cbor_arr_get_string(cbor_parse_ctx_t *cctx, uint32_t index, char *val, int size)
+{
+    CborValue v;
+    if (cbor_arr_get_value(cctx, index, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_string(&v, val, size);
+}
+
+int cbor_arr_get_strlen(cbor_parse_ctx_t *cctx, uint32_t index, int *strlen)
+{
+    CborValue v;
+    if (cbor_arr_get_value(cctx, index, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_strlen(&v, strlen);
+}
+
+int cbor_arr_get_bytes(cbor_parse_ctx_t *cctx, uint32_t index, uint8_t *val, size_t *len)
+{
+    CborValue v;
+    if (cbor_arr_get_value(cctx, index, &v) != 0) {
+        return -1;
+    }
+    return cbor_parse_to_bytes(&v, val, len);
+}
@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "cbor_stream.h"
+
+static int cbor_stream_flush(cbor_stream_t *stream, const uint8_t *data, size_t len)
+{
+    if (len && !stream->failed && stream->flush_cb(data, len, stream->priv) != 0) {
+        stream->failed = true;
+    }
+    return stream->failed ? -1 : 0;
+}
+
+static CborError cbor_stream_write(void *token, const void *data, size_t len, CborEncoderAppendType append)
+{
+    cbor_stream_t *stream = token;
+    const uint8_t *p = data;
+    (void)append;
+
+    if (stream->failed) {
+        return CborErrorIO;
+    }
+    stream->total_len += len;
+    /* Large strings go out as they are, after the data before them */
+    if (len >= stream->buf_size) {
+        if (cbor_stream_flush(stream, stream->buf, stream->used) != 0 || cbor_stream_flush(stream, p, len) != 0) {
+            return CborErrorIO;
+        }
+        stream->used = 0;
+        return CborNoError;
+    }
+    while (len) {
+        size_t copy_len = stream->buf_size - stream->used;
+        if (copy_len > len) {
+            copy_len = len;
+        }
+        memcpy(stream->buf + stream->used, p, copy_len);
+        stream->used += copy_len;
+        p += copy_len;
+        len -= copy_len;
+        if (stream->used == stream->buf_size) {
+            if (cbor_stream_flush(stream, stream->buf, stream->used) != 0) {
+                return CborErrorIO;
+            }
+            stream->used = 0;
+        }
+    }
+    return CborNoError;
+}
+
+void cbor_stream_init(cbor_stream_t *stream, CborEncoder *encoder, uint8_t *buf, size_t buf_size,
+                      cbor_stream_flush_cb_t flush_cb, void *priv)
+{
+    memset(stream, 0, sizeof(cbor_stream_t));
+    stream->buf = buf;
+    stream->buf_size = buf_size;
+    stream->flush_cb = flush_cb;
+    stream->priv = priv;
+    cbor_encoder_init_writer(encoder, cbor_stream_write, stream);
+}
+
+int cbor_stream_end(cbor_stream_t *stream)
+{
+    if (cbor_stream_flush(stream, stream->buf, stream->used) != 0) {
+        return -1;
+    }
+    stream->used = 0;
+    return stream->total_len;
+}
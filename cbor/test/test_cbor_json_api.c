@@ -0,0 +1,224 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <math.h>
+#include "cbor_generator.h"
+#include "cbor_parser.h"
+#include "unity.h"
+
+static const uint8_t s_bytes[] = {0x00, 0x01, 0xfe, 0xff};
+
+/* Same document as the json_generator example, with the CBOR only types */
+static void generate_test_doc(cbor_gen_t *cgen)
+{
+    cbor_gen_start_object(cgen);
+    cbor_gen_obj_set_bool(cgen, "bool_val", true);
+    cbor_gen_obj_set_int(cgen, "int_val", -2017);
+    cbor_gen_obj_set_int64(cgen, "int_64", 109174583252);
+    cbor_gen_obj_set_float(cgen, "float_val", 2.5f);
+    cbor_gen_obj_set_double(cgen, "double_val", 3.25);
+    cbor_gen_obj_set_string(cgen, "str_val", "CBOR Generator");
+    cbor_gen_obj_set_string_n(cgen, "str_n", "truncated", 5);
+    cbor_gen_obj_set_bytes(cgen, "bytes_val", s_bytes, sizeof(s_bytes));
+    cbor_gen_obj_set_null(cgen, "null_val");
+    cbor_gen_push_array(cgen, "arr");
+    cbor_gen_arr_set_bool(cgen, false);
+    cbor_gen_arr_set_int(cgen, 7);
+    cbor_gen_arr_set_float(cgen, 0.5f);
+    cbor_gen_arr_set_string(cgen, "elem");
+    cbor_gen_arr_set_bytes(cgen, s_bytes, 2);
+    cbor_gen_start_object(cgen);
+    cbor_gen_obj_set_int(cgen, "in_arr", 42);
+    cbor_gen_end_object(cgen);
+    cbor_gen_start_array(cgen);
+    cbor_gen_arr_set_int(cgen, 1);
+    cbor_gen_arr_set_int(cgen, 2);
+    cbor_gen_end_array(cgen);
+    cbor_gen_pop_array(cgen);
+    cbor_gen_push_object(cgen, "features");
+    cbor_gen_obj_set_bool(cgen, "objects", true);
+    cbor_gen_obj_set_string(cgen, "arrays", "yes");
+    cbor_gen_pop_object(cgen);
+    cbor_gen_end_object(cgen);
+}
+
+TEST_CASE("cbor generator and parser round trip", "[cbor]")
+{
+    uint8_t buf[256];
+    cbor_gen_t cgen;
+    cbor_gen_start(&cgen, buf, sizeof(buf));
+    generate_test_doc(&cgen);
+    int len = cbor_gen_end(&cgen, NULL);
+    TEST_ASSERT_GREATER_THAN(0, len);
+
+    cbor_parse_ctx_t cctx;
+    TEST_ASSERT_EQUAL(0, cbor_parse_start(&cctx, buf, len));
+
+    bool bool_val;
+    int int_val, num_elem;
+    int64_t int64_val;
+    float float_val;
+    double double_val;
+    char str_val[32];
+    uint8_t bytes_val[8];
+    size_t bytes_len;
+
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_bool(&cctx, "bool_val", &bool_val));
+    TEST_ASSERT_TRUE(bool_val);
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_int(&cctx, "int_val", &int_val));
+    TEST_ASSERT_EQUAL_INT(-2017, int_val);
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_int64(&cctx, "int_64", &int64_val));
+    TEST_ASSERT(int64_val == 109174583252);
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_float(&cctx, "float_val", &float_val));
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, float_val);
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_double(&cctx, "double_val", &double_val));
+    TEST_ASSERT(double_val == 3.25);
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_string(&cctx, "str_val", str_val, sizeof(str_val)));
+    TEST_ASSERT_EQUAL_STRING("CBOR Generator", str_val);
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_strlen(&cctx, "str_n", &int_val));
+    TEST_ASSERT_EQUAL_INT(5, int_val);
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_string(&cctx, "str_n", str_val, sizeof(str_val)));
+    TEST_ASSERT_EQUAL_STRING("trunc", str_val);
+    bytes_len = sizeof(bytes_val);
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_bytes(&cctx, "bytes_val", bytes_val, &bytes_len));
+    TEST_ASSERT_EQUAL(sizeof(s_bytes), bytes_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(s_bytes, bytes_val, sizeof(s_bytes));
+
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_array(&cctx, "arr", &num_elem));
+    TEST_ASSERT_EQUAL_INT(7, num_elem);
+    TEST_ASSERT_EQUAL(0, cbor_arr_get_bool(&cctx, 0, &bool_val));
+    TEST_ASSERT_FALSE(bool_val);
+    TEST_ASSERT_EQUAL(0, cbor_arr_get_int(&cctx, 1, &int_val));
+    TEST_ASSERT_EQUAL_INT(7, int_val);
+    TEST_ASSERT_EQUAL(0, cbor_arr_get_float(&cctx, 2, &float_val));
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, float_val);
+    TEST_ASSERT_EQUAL(0, cbor_arr_get_string(&cctx, 3, str_val, sizeof(str_val)));
+    TEST_ASSERT_EQUAL_STRING("elem", str_val);
+    bytes_len = sizeof(bytes_val);
+    TEST_ASSERT_EQUAL(0, cbor_arr_get_bytes(&cctx, 4, bytes_val, &bytes_len));
+    TEST_ASSERT_EQUAL(2, bytes_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(s_bytes, bytes_val, 2);
+    TEST_ASSERT_EQUAL(0, cbor_arr_get_object(&cctx, 5));
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_int(&cctx, "in_arr", &int_val));
+    TEST_ASSERT_EQUAL_INT(42, int_val);
+    TEST_ASSERT_EQUAL(0, cbor_arr_leave_object(&cctx));
+    TEST_ASSERT_EQUAL(0, cbor_arr_get_array(&cctx, 6));
+    TEST_ASSERT_EQUAL(0, cbor_arr_get_int(&cctx, 1, &int_val));
+    TEST_ASSERT_EQUAL_INT(2, int_val);
+    TEST_ASSERT_EQUAL(0, cbor_arr_leave_array(&cctx));
+    TEST_ASSERT_EQUAL(0, cbor_obj_leave_array(&cctx));
+
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_object(&cctx, "features"));
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_bool(&cctx, "objects", &bool_val));
+    TEST_ASSERT_TRUE(bool_val);
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_string(&cctx, "arrays", str_val, sizeof(str_val)));
+    TEST_ASSERT_EQUAL_STRING("yes", str_val);
+    TEST_ASSERT_EQUAL(0, cbor_obj_leave_object(&cctx));
+
+    cbor_parse_end(&cctx);
+}
+
+TEST_CASE("cbor parser rejects missing and mistyped elements", "[cbor]")
+{
+    uint8_t buf[256];
+    cbor_gen_t cgen;
+    cbor_gen_start(&cgen, buf, sizeof(buf));
+    generate_test_doc(&cgen);
+    int len = cbor_gen_end(&cgen, NULL);
+    TEST_ASSERT_GREATER_THAN(0, len);
+
+    cbor_parse_ctx_t cctx;
+    TEST_ASSERT_EQUAL(0, cbor_parse_start(&cctx, buf, len));
+
+    bool bool_val;
+    int int_val, num_elem;
+    double double_val;
+    char str_val[8];
+    uint8_t bytes_val[2];
+    size_t bytes_len = sizeof(bytes_val);
+
+    TEST_ASSERT_EQUAL(-1, cbor_obj_get_int(&cctx, "no_such_key", &int_val));
+    TEST_ASSERT_EQUAL(-1, cbor_obj_get_int(&cctx, "str_val", &int_val));
+    TEST_ASSERT_EQUAL(-1, cbor_obj_get_bool(&cctx, "null_val", &bool_val));
+    TEST_ASSERT_EQUAL(-1, cbor_obj_get_string(&cctx, "bytes_val", str_val, sizeof(str_val)));
+    TEST_ASSERT_EQUAL(-1, cbor_obj_get_bytes(&cctx, "str_val", bytes_val, &bytes_len));
+    TEST_ASSERT_EQUAL(-1, cbor_obj_get_array(&cctx, "features", &num_elem));
+    TEST_ASSERT_EQUAL(-1, cbor_obj_get_object(&cctx, "arr"));
+    /* Integers are accepted as floating point numbers, like in json_parser */
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_double(&cctx, "int_val", &double_val));
+    TEST_ASSERT(double_val == -2017.0);
+
+    /* No room for the string and its NULL termination, or for the bytes */
+    TEST_ASSERT_EQUAL(-1, cbor_obj_get_string(&cctx, "str_val", str_val, sizeof(str_val)));
+    bytes_len = sizeof(bytes_val);
+    TEST_ASSERT_EQUAL(-1, cbor_obj_get_bytes(&cctx, "bytes_val", bytes_val, &bytes_len));
+
+    /* Out of range integer */
+    TEST_ASSERT_EQUAL(-1, cbor_obj_get_int(&cctx, "int_64", &int_val));
+
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_array(&cctx, "arr", &num_elem));
+    TEST_ASSERT_EQUAL(-1, cbor_arr_get_int(&cctx, num_elem, &int_val));
+    TEST_ASSERT_EQUAL(-1, cbor_arr_get_int(&cctx, 3, &int_val));
+    /* Leaving a container of the other type */
+    TEST_ASSERT_EQUAL(-1, cbor_obj_leave_object(&cctx));
+    TEST_ASSERT_EQUAL(0, cbor_obj_leave_array(&cctx));
+    /* and more containers than entered */
+    TEST_ASSERT_EQUAL(-1, cbor_obj_leave_object(&cctx));
+
+    cbor_parse_end(&cctx);
+
+    /* The top level must be a map */
+    const uint8_t top_array[] = {0x81, 0x01};
+    TEST_ASSERT_EQUAL(-1, cbor_parse_start(&cctx, top_array, sizeof(top_array)));
+    /* and complete */
+    TEST_ASSERT_EQUAL(-1, cbor_parse_start(&cctx, buf, len - 1));
+}
+
+TEST_CASE("cbor generator reports the buffer size needed", "[cbor]")
+{
+    uint8_t buf[256];
+    cbor_gen_t cgen;
+    cbor_gen_start(&cgen, buf, sizeof(buf));
+    generate_test_doc(&cgen);
+    int len = cbor_gen_end(&cgen, NULL);
+    TEST_ASSERT_GREATER_THAN(0, len);
+
+    uint8_t small[16];
+    size_t needed = 0;
+    cbor_gen_start(&cgen, small, sizeof(small));
+    generate_test_doc(&cgen);
+    TEST_ASSERT_EQUAL(-1, cbor_gen_end(&cgen, &needed));
+    TEST_ASSERT_EQUAL(len, needed);
+
+    /* The size needed is enough */
+    uint8_t exact[256];
+    cbor_gen_start(&cgen, exact, needed);
+    generate_test_doc(&cgen);
+    TEST_ASSERT_EQUAL(len, cbor_gen_end(&cgen, NULL));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(buf, exact, len);
+}
+
+TEST_CASE("cbor generator fails on unbalanced containers", "[cbor]")
+{
+    uint8_t buf[64];
+    cbor_gen_t cgen;
+
+    /* Not closed */
+    cbor_gen_start(&cgen, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(0, cbor_gen_start_object(&cgen));
+    TEST_ASSERT_EQUAL(0, cbor_gen_push_array(&cgen, "arr"));
+    TEST_ASSERT_EQUAL(0, cbor_gen_pop_array(&cgen));
+    TEST_ASSERT_EQUAL(-1, cbor_gen_end(&cgen, NULL));
+
+    /* Closed once too often, the calls after the error fail */
+    cbor_gen_start(&cgen, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(0, cbor_gen_start_object(&cgen));
+    TEST_ASSERT_EQUAL(0, cbor_gen_end_object(&cgen));
+    TEST_ASSERT_EQUAL(-1, cbor_gen_end_object(&cgen));
+    TEST_ASSERT_EQUAL(-1, cbor_gen_start_object(&cgen));
+    TEST_ASSERT_EQUAL(-1, cbor_gen_end(&cgen, NULL));
+}
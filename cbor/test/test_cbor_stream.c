@@ -0,0 +1,175 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "cbor_stream.h"
+#include "cbor_generator.h"
+#include "unity.h"
+
+#define TEST_MAX_CHUNKS 128
+
+/* Collects the flushed chunks, and fails the flush number fail_at if not 0 */
+typedef struct {
+    uint8_t data[256];
+    size_t len;
+    size_t chunk_len[TEST_MAX_CHUNKS];
+    int num_chunks;
+    int fail_at;
+} test_sink_t;
+
+static int test_flush_cb(const uint8_t *data, size_t len, void *priv)
+{
+    test_sink_t *sink = priv;
+    TEST_ASSERT_LESS_THAN(TEST_MAX_CHUNKS, sink->num_chunks);
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(sink->data) - sink->len, len);
+    sink->chunk_len[sink->num_chunks++] = len;
+    if (sink->fail_at && sink->num_chunks == sink->fail_at) {
+        return -1;
+    }
+    memcpy(sink->data + sink->len, data, len);
+    sink->len += len;
+    return 0;
+}
+
+TEST_CASE("cbor stream flushes full chunks", "[cbor]")
+{
+    test_sink_t sink = {0};
+    cbor_stream_t stream;
+    CborEncoder enc;
+    uint8_t chunk[4];
+    cbor_stream_init(&stream, &enc, chunk, sizeof(chunk), test_flush_cb, &sink);
+
+    /* Small integers are encoded in one byte, the data ends at a chunk boundary */
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL(CborNoError, cbor_encode_uint(&enc, i));
+    }
+    TEST_ASSERT_EQUAL(2, sink.num_chunks);
+    TEST_ASSERT_EQUAL(4, sink.chunk_len[0]);
+    TEST_ASSERT_EQUAL(4, sink.chunk_len[1]);
+    /* Nothing left to flush */
+    TEST_ASSERT_EQUAL(8, cbor_stream_end(&stream));
+    TEST_ASSERT_EQUAL(2, sink.num_chunks);
+    const uint8_t expected[] = {0, 1, 2, 3, 4, 5, 6, 7};
+    TEST_ASSERT_EQUAL(sizeof(expected), sink.len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, sink.data, sizeof(expected));
+
+    /* An item crossing a chunk boundary is split, the rest is flushed at the end */
+    memset(&sink, 0, sizeof(sink));
+    cbor_stream_init(&stream, &enc, chunk, sizeof(chunk), test_flush_cb, &sink);
+    TEST_ASSERT_EQUAL(CborNoError, cbor_encode_uint(&enc, 1));
+    TEST_ASSERT_EQUAL(CborNoError, cbor_encode_uint(&enc, 0x12345678));
+    TEST_ASSERT_EQUAL(1, sink.num_chunks);
+    TEST_ASSERT_EQUAL(6, cbor_stream_end(&stream));
+    TEST_ASSERT_EQUAL(2, sink.num_chunks);
+    TEST_ASSERT_EQUAL(4, sink.chunk_len[0]);
+    TEST_ASSERT_EQUAL(2, sink.chunk_len[1]);
+    const uint8_t expected_split[] = {0x01, 0x1a, 0x12, 0x34, 0x56, 0x78};
+    TEST_ASSERT_EQUAL(sizeof(expected_split), sink.len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_split, sink.data, sizeof(expected_split));
+}
+
+TEST_CASE("cbor stream passes large strings directly", "[cbor]")
+{
+    test_sink_t sink = {0};
+    cbor_stream_t stream;
+    CborEncoder enc;
+    uint8_t chunk[8];
+    const char str[] = "0123456789abcdef";
+    cbor_stream_init(&stream, &enc, chunk, sizeof(chunk), test_flush_cb, &sink);
+
+    /* The string header is flushed before the string, which is not copied */
+    TEST_ASSERT_EQUAL(CborNoError, cbor_encode_text_stringz(&enc, str));
+    TEST_ASSERT_EQUAL(2, sink.num_chunks);
+    TEST_ASSERT_EQUAL(1, sink.chunk_len[0]);
+    TEST_ASSERT_EQUAL(strlen(str), sink.chunk_len[1]);
+    /* A string of exactly the chunk size too */
+    TEST_ASSERT_EQUAL(CborNoError, cbor_encode_text_string(&enc, str, sizeof(chunk)));
+    TEST_ASSERT_EQUAL(4, sink.num_chunks);
+    TEST_ASSERT_EQUAL(1, sink.chunk_len[2]);
+    TEST_ASSERT_EQUAL(sizeof(chunk), sink.chunk_len[3]);
+    TEST_ASSERT_EQUAL(1 + strlen(str) + 1 + sizeof(chunk), cbor_stream_end(&stream));
+    TEST_ASSERT_EQUAL(4, sink.num_chunks);
+
+    TEST_ASSERT_EQUAL_HEX8(0x70, sink.data[0]);
+    TEST_ASSERT_EQUAL_MEMORY(str, sink.data + 1, strlen(str));
+    TEST_ASSERT_EQUAL_HEX8(0x68, sink.data[1 + strlen(str)]);
+    TEST_ASSERT_EQUAL_MEMORY(str, sink.data + 2 + strlen(str), sizeof(chunk));
+}
+
+TEST_CASE("cbor stream fails once a flush fails", "[cbor]")
+{
+    test_sink_t sink = {.fail_at = 2};
+    cbor_stream_t stream;
+    CborEncoder enc;
+    uint8_t chunk[4];
+    cbor_stream_init(&stream, &enc, chunk, sizeof(chunk), test_flush_cb, &sink);
+
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(CborNoError, cbor_encode_uint(&enc, i));
+    }
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(CborNoError, cbor_encode_uint(&enc, i));
+    }
+    /* The second chunk fails, and no more data goes to the callback */
+    TEST_ASSERT_EQUAL(CborErrorIO, cbor_encode_uint(&enc, 3));
+    TEST_ASSERT_EQUAL(CborErrorIO, cbor_encode_uint(&enc, 4));
+    TEST_ASSERT_EQUAL(-1, cbor_stream_end(&stream));
+    TEST_ASSERT_EQUAL(2, sink.num_chunks);
+    TEST_ASSERT_EQUAL(4, sink.len);
+
+    /* Failing the last flush fails the end */
+    memset(&sink, 0, sizeof(sink));
+    sink.fail_at = 1;
+    cbor_stream_init(&stream, &enc, chunk, sizeof(chunk), test_flush_cb, &sink);
+    TEST_ASSERT_EQUAL(CborNoError, cbor_encode_uint(&enc, 1));
+    TEST_ASSERT_EQUAL(-1, cbor_stream_end(&stream));
+    TEST_ASSERT_EQUAL(1, sink.num_chunks);
+}
+
+static void generate_stream_doc(cbor_gen_t *cgen)
+{
+    cbor_gen_start_object(cgen);
+    cbor_gen_obj_set_string(cgen, "name", "a name longer than a chunk");
+    cbor_gen_push_array(cgen, "values");
+    for (int i = 0; i < 20; i++) {
+        cbor_gen_arr_set_int(cgen, i * 100);
+    }
+    cbor_gen_pop_array(cgen);
+    cbor_gen_obj_set_double(cgen, "ratio", 0.25);
+    cbor_gen_end_object(cgen);
+}
+
+TEST_CASE("cbor generator streams the same data as into a buffer", "[cbor]")
+{
+    uint8_t buf[256];
+    cbor_gen_t cgen;
+    cbor_gen_start(&cgen, buf, sizeof(buf));
+    generate_stream_doc(&cgen);
+    int len = cbor_gen_end(&cgen, NULL);
+    TEST_ASSERT_GREATER_THAN(0, len);
+
+    /* Chunk sizes dividing the document or not */
+    const size_t chunk_sizes[] = {1, 4, 7, 16, len, len + 1};
+    for (size_t i = 0; i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); i++) {
+        test_sink_t sink = {0};
+        cbor_stream_t stream;
+        uint8_t chunk[sizeof(buf) + 1];
+        cbor_gen_start_stream(&cgen, &stream, chunk, chunk_sizes[i], test_flush_cb, &sink);
+        generate_stream_doc(&cgen);
+        TEST_ASSERT_EQUAL(len, cbor_gen_end(&cgen, NULL));
+        TEST_ASSERT_EQUAL(len, sink.len);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(buf, sink.data, len);
+    }
+
+    /* A failing flush fails the generation */
+    test_sink_t sink = {.fail_at = 1};
+    cbor_stream_t stream;
+    uint8_t chunk[8];
+    cbor_gen_start_stream(&cgen, &stream, chunk, sizeof(chunk), test_flush_cb, &sink);
+    generate_stream_doc(&cgen);
+    TEST_ASSERT_EQUAL(-1, cbor_gen_end(&cgen, NULL));
+    TEST_ASSERT_EQUAL(1, sink.num_chunks);
+}
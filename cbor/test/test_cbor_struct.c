@@ -0,0 +1,230 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "cbor_generator.h"
+#include "cbor_parser.h"
+#include "unity.h"
+
+typedef struct {
+    int x;
+    int y;
+} test_point_t;
+
+typedef struct {
+    bool enabled;
+    int count;
+    int64_t big;
+    float ratio;
+    double precise;
+    char name[16];
+    uint8_t key[8];
+    size_t key_len;
+    test_point_t pos;
+} test_config_t;
+
+static const cbor_struct_field_t s_point_fields[] = {
+    CBOR_STRUCT_FIELD(test_point_t, x, CBOR_FIELD_INT, "x"),
+    CBOR_STRUCT_FIELD(test_point_t, y, CBOR_FIELD_INT, "y"),
+};
+static const cbor_struct_desc_t s_point_desc = CBOR_STRUCT_DESC(s_point_fields);
+
+static const cbor_struct_field_t s_config_fields[] = {
+    CBOR_STRUCT_FIELD(test_config_t, enabled, CBOR_FIELD_BOOL, "enabled"),
+    CBOR_STRUCT_FIELD(test_config_t, count, CBOR_FIELD_INT, "count"),
+    CBOR_STRUCT_FIELD(test_config_t, big, CBOR_FIELD_INT64, "big"),
+    CBOR_STRUCT_FIELD(test_config_t, ratio, CBOR_FIELD_FLOAT, "ratio"),
+    CBOR_STRUCT_FIELD(test_config_t, precise, CBOR_FIELD_DOUBLE, "precise"),
+    CBOR_STRUCT_FIELD(test_config_t, name, CBOR_FIELD_STRING, "name"),
+    CBOR_STRUCT_BYTES(test_config_t, key, key_len, "key"),
+    CBOR_STRUCT_OBJECT(test_config_t, pos, "pos", s_point_desc),
+};
+static const cbor_struct_desc_t s_config_desc = CBOR_STRUCT_DESC(s_config_fields);
+
+static const uint8_t s_key[] = {0xde, 0xad, 0xbe, 0xef};
+
+/* Defaults of the members, to check the ones left unchanged */
+static const test_config_t s_config_default = {
+    .count = -1,
+    .big = -1,
+    .ratio = -1.0f,
+    .precise = -1.0,
+    .name = "default",
+    .key_len = 0,
+    .pos = {.x = -1, .y = -1},
+};
+
+typedef enum {
+    TEST_DOC_COMPLETE,
+    TEST_DOC_MISSING,       /* without "count" and "pos" "y" */
+    TEST_DOC_MISTYPED,      /* with a string "count" and a too long "name" */
+} test_doc_t;
+
+/* Config map with the elements in another order than the fields, and extra ones */
+static int generate_config(uint8_t *buf, size_t size, test_doc_t doc)
+{
+    cbor_gen_t cgen;
+    cbor_gen_start(&cgen, buf, size);
+    cbor_gen_start_object(&cgen);
+    cbor_gen_obj_set_string(&cgen, "name", doc == TEST_DOC_MISTYPED ? "a name too long for the member" : "device");
+    cbor_gen_obj_set_int(&cgen, "extra_int", 5);
+    cbor_gen_push_object(&cgen, "pos");
+    cbor_gen_obj_set_int(&cgen, "x", 10);
+    if (doc != TEST_DOC_MISSING) {
+        cbor_gen_obj_set_int(&cgen, "y", 20);
+    }
+    cbor_gen_obj_set_int(&cgen, "z", 30);
+    cbor_gen_pop_object(&cgen);
+    cbor_gen_obj_set_bool(&cgen, "enabled", true);
+    if (doc == TEST_DOC_MISTYPED) {
+        cbor_gen_obj_set_string(&cgen, "count", "3");
+    } else if (doc == TEST_DOC_COMPLETE) {
+        cbor_gen_obj_set_int(&cgen, "count", 3);
+    }
+    cbor_gen_push_array(&cgen, "extra_array");
+    cbor_gen_arr_set_int(&cgen, 1);
+    cbor_gen_arr_set_string(&cgen, "count");
+    cbor_gen_pop_array(&cgen);
+    cbor_gen_obj_set_int64(&cgen, "big", 109174583252);
+    /* An integer for a floating point member */
+    cbor_gen_obj_set_int(&cgen, "ratio", 2);
+    cbor_gen_obj_set_double(&cgen, "precise", 0.125);
+    cbor_gen_obj_set_bytes(&cgen, "key", s_key, sizeof(s_key));
+    cbor_gen_end_object(&cgen);
+    return cbor_gen_end(&cgen, NULL);
+}
+
+static void decode_config(const uint8_t *buf, int len, int expected_ret, test_config_t *config)
+{
+    TEST_ASSERT_GREATER_THAN(0, len);
+    CborParser parser;
+    CborValue map;
+    TEST_ASSERT_EQUAL(CborNoError, cbor_parser_init(buf, len, 0, &parser, &map));
+    *config = s_config_default;
+    TEST_ASSERT_EQUAL(expected_ret, cbor_map_decode_struct(&map, &s_config_desc, config));
+}
+
+TEST_CASE("cbor struct decoding of all fields", "[cbor]")
+{
+    uint8_t buf[256];
+    test_config_t config;
+    decode_config(buf, generate_config(buf, sizeof(buf), TEST_DOC_COMPLETE), 0, &config);
+
+    TEST_ASSERT_TRUE(config.enabled);
+    TEST_ASSERT_EQUAL_INT(3, config.count);
+    TEST_ASSERT(config.big == 109174583252);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, config.ratio);
+    TEST_ASSERT(config.precise == 0.125);
+    TEST_ASSERT_EQUAL_STRING("device", config.name);
+    TEST_ASSERT_EQUAL(sizeof(s_key), config.key_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(s_key, config.key, sizeof(s_key));
+    TEST_ASSERT_EQUAL_INT(10, config.pos.x);
+    TEST_ASSERT_EQUAL_INT(20, config.pos.y);
+}
+
+TEST_CASE("cbor struct decoding with missing fields", "[cbor]")
+{
+    uint8_t buf[256];
+    test_config_t config;
+    decode_config(buf, generate_config(buf, sizeof(buf), TEST_DOC_MISSING), -1, &config);
+
+    /* The missing members keep their defaults, the others are decoded */
+    TEST_ASSERT_EQUAL_INT(s_config_default.count, config.count);
+    TEST_ASSERT_EQUAL_INT(10, config.pos.x);
+    TEST_ASSERT_EQUAL_INT(s_config_default.pos.y, config.pos.y);
+    TEST_ASSERT_TRUE(config.enabled);
+    TEST_ASSERT(config.big == 109174583252);
+    TEST_ASSERT_EQUAL_STRING("device", config.name);
+    TEST_ASSERT_EQUAL(sizeof(s_key), config.key_len);
+}
+
+TEST_CASE("cbor struct decoding with mistyped fields", "[cbor]")
+{
+    uint8_t buf[256];
+    test_config_t config;
+    decode_config(buf, generate_config(buf, sizeof(buf), TEST_DOC_MISTYPED), -1, &config);
+
+    /* A value of another type is not converted, the member is left unchanged */
+    TEST_ASSERT_EQUAL_INT(s_config_default.count, config.count);
+    TEST_ASSERT_TRUE(config.enabled);
+    TEST_ASSERT(config.precise == 0.125);
+    TEST_ASSERT_EQUAL_INT(10, config.pos.x);
+    TEST_ASSERT_EQUAL_INT(20, config.pos.y);
+
+    /* A bytes member too small for the value fails too */
+    static const cbor_struct_field_t small_fields[] = {
+        CBOR_STRUCT_BYTES(test_config_t, key, key_len, "key"),
+    };
+    static const cbor_struct_desc_t small_desc = CBOR_STRUCT_DESC(small_fields);
+    const uint8_t long_key[sizeof(((test_config_t *)0)->key) + 1] = {0};
+    cbor_gen_t cgen;
+    cbor_gen_start(&cgen, buf, sizeof(buf));
+    cbor_gen_start_object(&cgen);
+    cbor_gen_obj_set_bytes(&cgen, "key", long_key, sizeof(long_key));
+    cbor_gen_end_object(&cgen);
+    int len = cbor_gen_end(&cgen, NULL);
+    TEST_ASSERT_GREATER_THAN(0, len);
+    CborParser parser;
+    CborValue map;
+    TEST_ASSERT_EQUAL(CborNoError, cbor_parser_init(buf, len, 0, &parser, &map));
+    config = s_config_default;
+    TEST_ASSERT_EQUAL(-1, cbor_map_decode_struct(&map, &small_desc, &config));
+    TEST_ASSERT_EQUAL(s_config_default.key_len, config.key_len);
+
+    /* Not a map */
+    const uint8_t array[] = {0x81, 0x01};
+    TEST_ASSERT_EQUAL(CborNoError, cbor_parser_init(array, sizeof(array), 0, &parser, &map));
+    TEST_ASSERT_EQUAL(-1, cbor_map_decode_struct(&map, &s_config_desc, &config));
+}
+
+TEST_CASE("cbor struct decoding with integer keys", "[cbor]")
+{
+    static const cbor_struct_field_t fields[] = {
+        CBOR_STRUCT_FIELD_INT_KEY(test_point_t, x, CBOR_FIELD_INT, 1),
+        CBOR_STRUCT_FIELD_INT_KEY(test_point_t, y, CBOR_FIELD_INT, -2),
+    };
+    static const cbor_struct_desc_t desc = CBOR_STRUCT_DESC(fields);
+
+    /* COSE like map with a text key equal to the text of an integer one */
+    uint8_t buf[32];
+    CborEncoder enc, map_enc;
+    cbor_encoder_init(&enc, buf, sizeof(buf), 0);
+    TEST_ASSERT_EQUAL(CborNoError, cbor_encoder_create_map(&enc, &map_enc, 4));
+    cbor_encode_int(&map_enc, -2);
+    cbor_encode_int(&map_enc, 200);
+    cbor_encode_text_stringz(&map_enc, "1");
+    cbor_encode_int(&map_enc, 0);
+    cbor_encode_int(&map_enc, 3);
+    cbor_encode_int(&map_enc, 300);
+    cbor_encode_int(&map_enc, 1);
+    cbor_encode_int(&map_enc, 100);
+    TEST_ASSERT_EQUAL(CborNoError, cbor_encoder_close_container(&enc, &map_enc));
+
+    CborParser parser;
+    CborValue map;
+    TEST_ASSERT_EQUAL(CborNoError, cbor_parser_init(buf, cbor_encoder_get_buffer_size(&enc, buf), 0, &parser, &map));
+    test_point_t point = {0};
+    TEST_ASSERT_EQUAL(0, cbor_map_decode_struct(&map, &desc, &point));
+    TEST_ASSERT_EQUAL_INT(100, point.x);
+    TEST_ASSERT_EQUAL_INT(200, point.y);
+}
+
+TEST_CASE("cbor struct decoding of the current object", "[cbor]")
+{
+    uint8_t buf[256];
+    int len = generate_config(buf, sizeof(buf), TEST_DOC_COMPLETE);
+    TEST_ASSERT_GREATER_THAN(0, len);
+
+    cbor_parse_ctx_t cctx;
+    TEST_ASSERT_EQUAL(0, cbor_parse_start(&cctx, buf, len));
+    TEST_ASSERT_EQUAL(0, cbor_obj_get_object(&cctx, "pos"));
+    test_point_t point = {0};
+    TEST_ASSERT_EQUAL(0, cbor_obj_decode_struct(&cctx, &s_point_desc, &point));
+    TEST_ASSERT_EQUAL_INT(10, point.x);
+    TEST_ASSERT_EQUAL_INT(20, point.y);
+    TEST_ASSERT_EQUAL(0, cbor_obj_leave_object(&cctx));
+    cbor_parse_end(&cctx);
+}
@@ -4,6 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+
 #include "ccomp_timer.h"
 
 #include "ccomp_timer_impl.h"
@@ -13,74 +17,274 @@
 #include "freertos/semphr.h"
 
 #include "esp_log.h"
+#include "esp_attr.h"
 #include "esp_intr_alloc.h"
+#include "esp_private/esp_clk.h"
 
+typedef enum {
+    CCOMP_TIMER_STOPPED = 0,    // timer is not measuring, the elapsed time is kept
+    CCOMP_TIMER_RUNNING,        // timer is measuring on core_id
+    CCOMP_TIMER_PAUSED          // timer is not measuring, the elapsed time is added to when resumed
+} ccomp_timer_run_state_t;
 
-esp_err_t ccomp_timer_start(void)
+struct ccomp_timer_t {
+    ccomp_timer_run_state_t state;          // state of the timer
+    int core_id;                            // core counting the cycles while the timer is running
+    ccomp_timer_impl_counters_t start;      // counters of the core when the timer was started or resumed
+    ccomp_timer_impl_counters_t counters;   // counts accumulated until the timer was paused or stopped
+};
+
+// Timers used by ccomp_timer_start, one for each core
+static struct ccomp_timer_t s_core_timers[portNUM_PROCESSORS];
+
+// Number of running timers on each core, the implementation keeps time while it's not zero
+static int s_running_timers[portNUM_PROCESSORS];
+
+// Add the counts elapsed since start, the counters not counted by the target stay -1
+static void IRAM_ATTR counters_add(ccomp_timer_impl_counters_t *counters, const ccomp_timer_impl_counters_t *start,
+                                   const ccomp_timer_impl_counters_t *now)
+{
+    counters->cycles += now->cycles - start->cycles;
+    counters->i_stalls = now->i_stalls < 0 ? -1 : counters->i_stalls + now->i_stalls - start->i_stalls;
+    counters->d_stalls = now->d_stalls < 0 ? -1 : counters->d_stalls + now->d_stalls - start->d_stalls;
+    counters->instructions = now->instructions < 0 ? -1 : counters->instructions + now->instructions - start->instructions;
+}
+
+// Start counting on the current core, called with the implementation lock held
+static esp_err_t timer_run(struct ccomp_timer_t *timer)
 {
     esp_err_t err = ESP_OK;
+    int core_id = xPortGetCoreID();
 
-    ccomp_timer_impl_lock();
-    if (ccomp_timer_impl_is_init()) {
-        if (ccomp_timer_impl_is_active()) {
-            err = ESP_ERR_INVALID_STATE;
+    if (s_running_timers[core_id] == 0) {
+        if (!ccomp_timer_impl_is_init()) {
+            err = ccomp_timer_impl_init();
+        }
+        if (err == ESP_OK) {
+            err = ccomp_timer_impl_reset();
+        }
+        if (err == ESP_OK) {
+            err = ccomp_timer_impl_start();
+        }
+        if (err != ESP_OK) {
+            return err;
         }
-    } else {
-        err = ccomp_timer_impl_init();
+    }
+    s_running_timers[core_id]++;
+
+    timer->core_id = core_id;
+    ccomp_timer_impl_get_counters(&timer->start);
+    timer->state = CCOMP_TIMER_RUNNING;
+    return ESP_OK;
+}
+
+// Stop counting and accumulate the elapsed cycles, called with the implementation lock held
+static esp_err_t IRAM_ATTR timer_halt(struct ccomp_timer_t *timer, ccomp_timer_run_state_t state)
+{
+    esp_err_t err = ESP_OK;
+    int core_id = xPortGetCoreID();
+
+    // The cycles of the other core can't be read from this one
+    if (timer->core_id != core_id) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    ccomp_timer_impl_counters_t now;
+    ccomp_timer_impl_get_counters(&now);
+    counters_add(&timer->counters, &timer->start, &now);
+    timer->state = state;
+
+    if (--s_running_timers[core_id] == 0) {
+        err = ccomp_timer_impl_stop();
+        if (err == ESP_OK) {
+            err = ccomp_timer_impl_deinit();
+        }
+    }
+    return err;
+}
+
+esp_err_t ccomp_timer_create(ccomp_timer_handle_t *ret_timer)
+{
+    if (!ret_timer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct ccomp_timer_t *timer = calloc(1, sizeof(struct ccomp_timer_t));
+    if (!timer) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    *ret_timer = timer;
+    return ESP_OK;
+}
+
+esp_err_t ccomp_timer_delete(ccomp_timer_handle_t timer)
+{
+    if (!timer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (timer->state == CCOMP_TIMER_RUNNING) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    free(timer);
+    return ESP_OK;
+}
+
+esp_err_t ccomp_timer_handle_start(ccomp_timer_handle_t timer)
+{
+    esp_err_t err = ESP_ERR_INVALID_STATE;
+
+    if (!timer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ccomp_timer_impl_lock();
+    if (timer->state != CCOMP_TIMER_RUNNING) {
+        memset(&timer->counters, 0, sizeof(timer->counters));
+        err = timer_run(timer);
     }
     ccomp_timer_impl_unlock();
 
-    if (err != ESP_OK) {
-        goto fail;
+    return err;
+}
+
+esp_err_t IRAM_ATTR ccomp_timer_handle_stop(ccomp_timer_handle_t timer)
+{
+    esp_err_t err = ESP_ERR_INVALID_STATE;
+
+    if (!timer) {
+        return ESP_ERR_INVALID_ARG;
     }
 
-    err = ccomp_timer_impl_reset();
+    ccomp_timer_impl_lock();
+    if (timer->state == CCOMP_TIMER_RUNNING) {
+        err = timer_halt(timer, CCOMP_TIMER_STOPPED);
+    } else if (timer->state == CCOMP_TIMER_PAUSED) {
+        timer->state = CCOMP_TIMER_STOPPED;
+        err = ESP_OK;
+    }
+    ccomp_timer_impl_unlock();
+
+    return err;
+}
 
-    if (err != ESP_OK) {
-        goto fail;
+esp_err_t IRAM_ATTR ccomp_timer_handle_pause(ccomp_timer_handle_t timer)
+{
+    esp_err_t err = ESP_ERR_INVALID_STATE;
+
+    if (!timer) {
+        return ESP_ERR_INVALID_ARG;
     }
 
-    err = ccomp_timer_impl_start();
+    ccomp_timer_impl_lock();
+    if (timer->state == CCOMP_TIMER_RUNNING) {
+        err = timer_halt(timer, CCOMP_TIMER_PAUSED);
+    }
+    ccomp_timer_impl_unlock();
 
-    if (err == ESP_OK) {
-        return ESP_OK;
+    return err;
+}
+
+esp_err_t ccomp_timer_handle_resume(ccomp_timer_handle_t timer)
+{
+    esp_err_t err = ESP_ERR_INVALID_STATE;
+
+    if (!timer) {
+        return ESP_ERR_INVALID_ARG;
     }
 
-fail:
+    ccomp_timer_impl_lock();
+    if (timer->state == CCOMP_TIMER_PAUSED) {
+        err = timer_run(timer);
+    }
+    ccomp_timer_impl_unlock();
+
     return err;
 }
 
-int64_t IRAM_ATTR ccomp_timer_stop(void)
+esp_err_t IRAM_ATTR ccomp_timer_handle_get_stats(ccomp_timer_handle_t timer, ccomp_timer_stats_t *ret_stats)
 {
     esp_err_t err = ESP_OK;
+
+    if (!timer || !ret_stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
     ccomp_timer_impl_lock();
-    if (!ccomp_timer_impl_is_active()) {
-        err = ESP_ERR_INVALID_STATE;
+    ccomp_timer_impl_counters_t counters = timer->counters;
+    if (timer->state == CCOMP_TIMER_RUNNING) {
+        if (timer->core_id == xPortGetCoreID()) {
+            ccomp_timer_impl_counters_t now;
+            ccomp_timer_impl_get_counters(&now);
+            counters_add(&counters, &timer->start, &now);
+        } else {
+            err = ESP_ERR_INVALID_STATE;
+        }
     }
     ccomp_timer_impl_unlock();
 
-    if (err != ESP_OK) {
-        goto fail;
+    if (err == ESP_OK) {
+        // Compensate by the stall cycles counted by the target
+        int64_t cycles = counters.cycles - MAX(counters.i_stalls, 0) - MAX(counters.d_stalls, 0);
+        ret_stats->time = (cycles * 1000000) / esp_clk_cpu_freq();
+        ret_stats->cycles = counters.cycles;
+        ret_stats->i_stall_cycles = counters.i_stalls;
+        ret_stats->d_stall_cycles = counters.d_stalls;
+        ret_stats->instructions = counters.instructions;
     }
+    return err;
+}
+
+esp_err_t IRAM_ATTR ccomp_timer_handle_get_time(ccomp_timer_handle_t timer, int64_t *ret_time)
+{
+    ccomp_timer_stats_t stats;
 
-    err = ccomp_timer_impl_stop();
-    if (err != ESP_OK) {
-        goto fail;
+    if (!ret_time) {
+        return ESP_ERR_INVALID_ARG;
     }
 
-    int64_t t = ccomp_timer_get_time();
+    esp_err_t err = ccomp_timer_handle_get_stats(timer, &stats);
+    if (err == ESP_OK) {
+        *ret_time = stats.time;
+    }
+    return err;
+}
 
-    err = ccomp_timer_impl_deinit();
+esp_err_t ccomp_timer_start(void)
+{
+    return ccomp_timer_handle_start(&s_core_timers[xPortGetCoreID()]);
+}
+
+int64_t IRAM_ATTR ccomp_timer_stop(void)
+{
+    struct ccomp_timer_t *timer = &s_core_timers[xPortGetCoreID()];
+    int64_t t = -1;
+
+    if (ccomp_timer_handle_stop(timer) != ESP_OK) {
+        return -1;
+    }
 
-    if (err == ESP_OK && t != -1) {
-        return t;
+    if (ccomp_timer_handle_get_time(timer, &t) != ESP_OK) {
+        return -1;
     }
 
-fail:
-    return -1;
+    return t;
 }
 
 int64_t IRAM_ATTR ccomp_timer_get_time(void)
 {
-    return ccomp_timer_impl_get_time();
+    int64_t t = -1;
+
+    if (ccomp_timer_handle_get_time(&s_core_timers[xPortGetCoreID()], &t) != ESP_OK) {
+        return -1;
+    }
+
+    return t;
+}
+
+esp_err_t IRAM_ATTR ccomp_timer_get_stats(ccomp_timer_stats_t *ret_stats)
+{
+    return ccomp_timer_handle_get_stats(&s_core_timers[xPortGetCoreID()], ret_stats);
 }
@@ -5,12 +5,14 @@
  */
 
 #include <stdint.h>
-#include "freertos/portmacro.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "esp_freertos_hooks.h"
 #include "soc/soc_caps.h"
 #include "esp_rom_sys.h"
 #include "esp_cpu.h"
-#include "esp_private/esp_clk.h"
+#include "riscv/rvruntime-frames.h"
+#include "ccomp_timer_impl.h"
 
 typedef enum {
     PERF_TIMER_UNINIT = 0,  // timer has not been initialized yet
@@ -72,11 +74,14 @@ esp_err_t IRAM_ATTR ccomp_timer_impl_stop(void)
     return ESP_OK;
 }
 
-int64_t IRAM_ATTR ccomp_timer_impl_get_time(void)
+void IRAM_ATTR ccomp_timer_impl_get_counters(ccomp_timer_impl_counters_t *counters)
 {
     update_ccount();
-    int64_t cycles = s_status[esp_cpu_get_core_id()].ccount;
-    return (cycles * 1000000) / esp_clk_cpu_freq();
+    counters->cycles = s_status[esp_cpu_get_core_id()].ccount;
+    // The only performance counter is used as the cycle counter
+    counters->i_stalls = -1;
+    counters->d_stalls = -1;
+    counters->instructions = -1;
 }
 
 esp_err_t ccomp_timer_impl_reset(void)
@@ -86,6 +91,14 @@ esp_err_t ccomp_timer_impl_reset(void)
     return ESP_OK;
 }
 
+uint32_t IRAM_ATTR ccomp_timer_impl_get_interrupted_pc(void)
+{
+    // The interrupt entry saves the interrupted context on the task stack and stores the stack pointer
+    // into pxTopOfStack, which is the first member of the TCB
+    RvExcFrame *frame = *(RvExcFrame **)xTaskGetCurrentTaskHandle();
+    return frame->mepc;
+}
+
 bool ccomp_timer_impl_is_init(void)
 {
     return s_status[esp_cpu_get_core_id()].state != PERF_TIMER_UNINIT;
@@ -13,15 +13,24 @@
 #include "esp_attr.h"
 #include "eri.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "esp_freertos_hooks.h"
 #include "perfmon.h"
+#include "xtensa/config/core-isa.h"
 #include "xtensa/core-macros.h"
 #include "xtensa/xt_perf_consts.h"
 #include "xtensa-debug-module.h"
-#include "esp_private/esp_clk.h"
+#include "xtensa_context.h"
 
 #define D_STALL_COUNTER_ID 0
 #define I_STALL_COUNTER_ID 1
+#define INSN_COUNTER_ID 2
+
+// Executed instructions are counted only if the core has a counter left
+#define CCOMP_TIMER_COUNT_INSN (XCHAL_NUM_PERF_COUNTERS > INSN_COUNTER_ID)
+
+// Each counter overflow adds 2^32 counts
+#define COUNTER_OVFL_COUNTS ((int64_t)1 << 32)
 
 typedef enum {
     PERF_TIMER_UNINIT = 0,              // timer has not been initialized yet
@@ -32,6 +41,7 @@ typedef enum {
 typedef struct {
     int i_ovfl;                         // number of times instruction stall counter has overflowed
     int d_ovfl;                         // number of times data stall counter has overflowed
+    int insn_ovfl;                      // number of times instruction counter has overflowed
     uint32_t last_ccount;               // last CCOUNT value, updated every os tick
     ccomp_timer_state_t state;          // state of the timer
     intr_handle_t intr_handle;          // handle to allocated handler for perfmon counter overflows, so that it can be freed during deinit
@@ -44,6 +54,7 @@ ccomp_timer_status_t s_status[] = {
     {
         .i_ovfl = 0,
         .d_ovfl = 0,
+        .insn_ovfl = 0,
         .ccount = 0,
         .last_ccount = 0,
         .state = PERF_TIMER_UNINIT,
@@ -53,6 +64,7 @@ ccomp_timer_status_t s_status[] = {
     {
         .i_ovfl = 0,
         .d_ovfl = 0,
+        .insn_ovfl = 0,
         .ccount = 0,
         .last_ccount = 0,
         .state = PERF_TIMER_UNINIT,
@@ -83,7 +95,7 @@ static void inline update_overflow(int id, int *cnt)
         *cnt += 1;
         // Clear overflow and PerfMonInt asserted bits. The only valid bits in PMSTAT is the ones we're trying to clear. So it should be
         // ok to just modify the whole register.
-        eri_write(ERI_PERFMON_PMSTAT0 + id, ~0x0);
+        eri_write(ERI_PERFMON_PMSTAT0 + id * sizeof(int32_t), ~0x0);
     }
 }
 
@@ -91,6 +103,9 @@ static void IRAM_ATTR perf_counter_overflow_handler(void *args)
 {
     update_overflow(D_STALL_COUNTER_ID, &s_status[xPortGetCoreID()].d_ovfl);
     update_overflow(I_STALL_COUNTER_ID, &s_status[xPortGetCoreID()].i_ovfl);
+#if CCOMP_TIMER_COUNT_INSN
+    update_overflow(INSN_COUNTER_ID, &s_status[xPortGetCoreID()].insn_ovfl);
+#endif
 }
 
 static void set_perfmon_interrupt(bool enable)
@@ -108,6 +123,16 @@ static void set_perfmon_interrupt(bool enable)
 
     eri_write(ERI_PERFMON_PMCTRL0 + D_STALL_COUNTER_ID * sizeof(int32_t), d_pmctrl);
     eri_write(ERI_PERFMON_PMCTRL0 + I_STALL_COUNTER_ID * sizeof(int32_t), i_pmctrl);
+
+#if CCOMP_TIMER_COUNT_INSN
+    uint32_t insn_pmctrl = eri_read(ERI_PERFMON_PMCTRL0 + INSN_COUNTER_ID * sizeof(int32_t));
+    if (enable) {
+        insn_pmctrl |= PMCTRL_INTEN;
+    } else {
+        insn_pmctrl &= ~PMCTRL_INTEN;
+    }
+    eri_write(ERI_PERFMON_PMCTRL0 + INSN_COUNTER_ID * sizeof(int32_t), insn_pmctrl);
+#endif
 }
 
 
@@ -127,6 +152,11 @@ esp_err_t ccomp_timer_impl_init(void)
     xtensa_perfmon_init(I_STALL_COUNTER_ID,
                         XTPERF_CNT_I_STALL,
                         XTPERF_MASK_I_STALL_BUSY, 0, -1);
+#if CCOMP_TIMER_COUNT_INSN
+    xtensa_perfmon_init(INSN_COUNTER_ID,
+                        XTPERF_CNT_INSN,
+                        XTPERF_MASK_INSN_ALL, 0, -1);
+#endif
 
     set_perfmon_interrupt(true);
     s_status[xPortGetCoreID()].state = PERF_TIMER_IDLE;
@@ -167,29 +197,45 @@ esp_err_t IRAM_ATTR ccomp_timer_impl_stop(void)
     return ESP_OK;
 }
 
-int64_t IRAM_ATTR ccomp_timer_impl_get_time(void)
+void IRAM_ATTR ccomp_timer_impl_get_counters(ccomp_timer_impl_counters_t *counters)
 {
     update_ccount();
-    int64_t d_stalls = xtensa_perfmon_value(D_STALL_COUNTER_ID) +
-                       s_status[xPortGetCoreID()].d_ovfl * (1 << sizeof(int32_t));
-    int64_t i_stalls = xtensa_perfmon_value(I_STALL_COUNTER_ID) +
-                       s_status[xPortGetCoreID()].i_ovfl * (1 << sizeof(int32_t));
-    int64_t stalls = d_stalls + i_stalls;
-    int64_t cycles = s_status[xPortGetCoreID()].ccount;
-    return ((cycles - stalls) * 1000000) / esp_clk_cpu_freq();
+    counters->cycles = s_status[xPortGetCoreID()].ccount;
+    counters->d_stalls = xtensa_perfmon_value(D_STALL_COUNTER_ID) +
+                         s_status[xPortGetCoreID()].d_ovfl * COUNTER_OVFL_COUNTS;
+    counters->i_stalls = xtensa_perfmon_value(I_STALL_COUNTER_ID) +
+                         s_status[xPortGetCoreID()].i_ovfl * COUNTER_OVFL_COUNTS;
+#if CCOMP_TIMER_COUNT_INSN
+    counters->instructions = xtensa_perfmon_value(INSN_COUNTER_ID) +
+                             s_status[xPortGetCoreID()].insn_ovfl * COUNTER_OVFL_COUNTS;
+#else
+    counters->instructions = -1;
+#endif
 }
 
 esp_err_t ccomp_timer_impl_reset(void)
 {
     xtensa_perfmon_reset(D_STALL_COUNTER_ID);
     xtensa_perfmon_reset(I_STALL_COUNTER_ID);
+#if CCOMP_TIMER_COUNT_INSN
+    xtensa_perfmon_reset(INSN_COUNTER_ID);
+#endif
     s_status[xPortGetCoreID()].d_ovfl = 0;
     s_status[xPortGetCoreID()].i_ovfl = 0;
+    s_status[xPortGetCoreID()].insn_ovfl = 0;
     s_status[xPortGetCoreID()].ccount = 0;
     s_status[xPortGetCoreID()].last_ccount = 0;
     return ESP_OK;
 }
 
+uint32_t IRAM_ATTR ccomp_timer_impl_get_interrupted_pc(void)
+{
+    // The interrupt entry saves the interrupted context on the task stack and stores the stack pointer
+    // into pxTopOfStack, which is the first member of the TCB
+    XtExcFrame *frame = *(XtExcFrame **)xTaskGetCurrentTaskHandle();
+    return frame->pc;
+}
+
 bool ccomp_timer_impl_is_init(void)
 {
     return s_status[xPortGetCoreID()].state != PERF_TIMER_UNINIT;
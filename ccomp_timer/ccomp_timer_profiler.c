@@ -0,0 +1,224 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "ccomp_timer_profiler.h"
+
+#include "ccomp_timer_impl.h"
+
+#include "freertos/FreeRTOS.h"
+
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_freertos_hooks.h"
+
+typedef struct {
+    uint32_t *pcs;              // sampled program counters, written only by the tick hook of the core
+    atomic_size_t num_samples;  // number of valid entries in pcs, published after the entry is written
+    size_t num_dropped;         // samples not recorded because pcs is full
+    uint32_t ticks;             // ticks since the last sample
+} ccomp_timer_profiler_core_t;
+
+typedef struct {
+    uint32_t pc;
+    uint32_t count;
+} ccomp_timer_profiler_entry_t;
+
+static ccomp_timer_profiler_core_t s_cores[portNUM_PROCESSORS];
+static uint32_t s_sample_period_ticks;
+static size_t s_max_samples;
+static bool s_running;
+
+static void IRAM_ATTR profiler_tick_hook(void)
+{
+    ccomp_timer_profiler_core_t *core = &s_cores[xPortGetCoreID()];
+
+    if (++core->ticks < s_sample_period_ticks) {
+        return;
+    }
+    core->ticks = 0;
+
+    // Only this core appends to its buffer, readers see the entries below num_samples
+    size_t n = atomic_load_explicit(&core->num_samples, memory_order_relaxed);
+    if (n < s_max_samples) {
+        core->pcs[n] = ccomp_timer_impl_get_interrupted_pc();
+        atomic_store_explicit(&core->num_samples, n + 1, memory_order_release);
+    } else {
+        core->num_dropped++;
+    }
+}
+
+static void free_buffers(void)
+{
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        free(s_cores[i].pcs);
+        s_cores[i].pcs = NULL;
+    }
+}
+
+esp_err_t ccomp_timer_profiler_start(const ccomp_timer_profiler_config_t *config)
+{
+    esp_err_t err = ESP_OK;
+    int registered = 0;
+
+    if (!config || !config->max_samples) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    free_buffers();
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        // Written from the tick interrupt, keep it in internal memory
+        s_cores[i].pcs = heap_caps_malloc(config->max_samples * sizeof(uint32_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (!s_cores[i].pcs) {
+            err = ESP_ERR_NO_MEM;
+            goto fail;
+        }
+        atomic_init(&s_cores[i].num_samples, 0);
+        s_cores[i].num_dropped = 0;
+        s_cores[i].ticks = 0;
+    }
+    s_sample_period_ticks = config->sample_period_ticks ? config->sample_period_ticks : 1;
+    s_max_samples = config->max_samples;
+
+    for (; registered < portNUM_PROCESSORS; registered++) {
+        err = esp_register_freertos_tick_hook_for_cpu(profiler_tick_hook, registered);
+        if (err != ESP_OK) {
+            goto fail;
+        }
+    }
+
+    s_running = true;
+    return ESP_OK;
+
+fail:
+    while (registered--) {
+        esp_deregister_freertos_tick_hook_for_cpu(profiler_tick_hook, registered);
+    }
+    free_buffers();
+    return err;
+}
+
+esp_err_t ccomp_timer_profiler_stop(void)
+{
+    if (!s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        esp_deregister_freertos_tick_hook_for_cpu(profiler_tick_hook, i);
+    }
+
+    s_running = false;
+    return ESP_OK;
+}
+
+esp_err_t ccomp_timer_profiler_get_samples(int core_id, const uint32_t **ret_pcs, size_t *ret_num_samples, size_t *ret_num_dropped)
+{
+    if (core_id < 0 || core_id >= portNUM_PROCESSORS || !ret_pcs || !ret_num_samples) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!s_cores[core_id].pcs) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    *ret_pcs = s_cores[core_id].pcs;
+    *ret_num_samples = atomic_load_explicit(&s_cores[core_id].num_samples, memory_order_acquire);
+    if (ret_num_dropped) {
+        *ret_num_dropped = s_cores[core_id].num_dropped;
+    }
+    return ESP_OK;
+}
+
+static int compare_pc(const void *a, const void *b)
+{
+    uint32_t pc_a = ((const ccomp_timer_profiler_entry_t *)a)->pc;
+    uint32_t pc_b = ((const ccomp_timer_profiler_entry_t *)b)->pc;
+    return (pc_a > pc_b) - (pc_a < pc_b);
+}
+
+static int compare_count(const void *a, const void *b)
+{
+    uint32_t count_a = ((const ccomp_timer_profiler_entry_t *)a)->count;
+    uint32_t count_b = ((const ccomp_timer_profiler_entry_t *)b)->count;
+    return (count_a < count_b) - (count_a > count_b);
+}
+
+esp_err_t ccomp_timer_profiler_print(size_t max_entries)
+{
+    const uint32_t *pcs[portNUM_PROCESSORS];
+    size_t num_samples[portNUM_PROCESSORS];
+    size_t num_dropped[portNUM_PROCESSORS];
+    size_t total = 0;
+    size_t dropped = 0;
+
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        esp_err_t err = ccomp_timer_profiler_get_samples(i, &pcs[i], &num_samples[i], &num_dropped[i]);
+        if (err != ESP_OK) {
+            return err;
+        }
+        total += num_samples[i];
+        dropped += num_dropped[i];
+    }
+
+    ccomp_timer_profiler_entry_t *entries = calloc(total ? total : 1, sizeof(ccomp_timer_profiler_entry_t));
+    if (!entries) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    size_t n = 0;
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        for (size_t j = 0; j < num_samples[i]; j++) {
+            entries[n].pc = pcs[i][j];
+            entries[n].count = 1;
+            n++;
+        }
+    }
+
+    // Merge equal program counters, then order by number of samples
+    qsort(entries, n, sizeof(ccomp_timer_profiler_entry_t), compare_pc);
+    size_t num_entries = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (num_entries && entries[num_entries - 1].pc == entries[i].pc) {
+            entries[num_entries - 1].count++;
+        } else {
+            entries[num_entries++] = entries[i];
+        }
+    }
+    qsort(entries, num_entries, sizeof(ccomp_timer_profiler_entry_t), compare_count);
+
+    if (max_entries == 0 || max_entries > num_entries) {
+        max_entries = num_entries;
+    }
+
+    printf("ccomp_timer profile: %u samples, %u dropped\n", (unsigned)total, (unsigned)dropped);
+    printf("  samples       %%  pc\n");
+    for (size_t i = 0; i < max_entries; i++) {
+        printf("%9u  %5.1f%%  0x%08x\n", (unsigned)entries[i].count,
+               100.0f * entries[i].count / total, (unsigned)entries[i].pc);
+    }
+
+    free(entries);
+    return ESP_OK;
+}
+
+esp_err_t ccomp_timer_profiler_clear(void)
+{
+    if (s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    free_buffers();
+    return ESP_OK;
+}
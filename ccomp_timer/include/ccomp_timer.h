@@ -48,6 +48,143 @@ int64_t ccomp_timer_stop(void);
  */
 int64_t ccomp_timer_get_time(void);
 
+/**
+ * @brief Counts of a cache compensated timer, to tell whether the measured code is bound by computation or by memory access
+ */
+typedef struct {
+    int64_t time;           // Cache compensated time in microseconds, the same as returned by ccomp_timer_get_time
+    int64_t cycles;         // CPU cycles, including the stall cycles
+    int64_t i_stall_cycles; // Cycles stalled by instruction fetch, e.g. by I-cache misses, -1 if not counted by the target
+    int64_t d_stall_cycles; // Cycles stalled by data access, e.g. by D-cache misses, including PSRAM access, -1 if not counted by the target
+    int64_t instructions;   // Executed instructions, -1 if not counted by the target
+} ccomp_timer_stats_t;
+
+/**
+ * Return the counts of the timer on the current core without stopping the timer.
+ *
+ * @note Like ccomp_timer_get_time, the counts are kept once ccomp_timer_stop has been called.
+ *
+ * @param[out] ret_stats Returned counts from the last ccomp_timer_start call on the current core
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: ret_stats is NULL
+ */
+esp_err_t ccomp_timer_get_stats(ccomp_timer_stats_t *ret_stats);
+
+/**
+ * @brief Type of cache compensated timer handle
+ *
+ * Unlike the timer of ccomp_timer_start, any number of these timers can measure at the same time,
+ * e.g. nested regions of code or regions running on different cores.
+ */
+typedef struct ccomp_timer_t *ccomp_timer_handle_t;
+
+/**
+ * @brief Create a cache compensated timer.
+ *
+ * @param[out] ret_timer Returned timer handle
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: ret_timer is NULL
+ *  - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t ccomp_timer_create(ccomp_timer_handle_t *ret_timer);
+
+/**
+ * @brief Delete a cache compensated timer.
+ *
+ * @param timer Timer handle, created by ccomp_timer_create
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: timer is NULL
+ *  - ESP_ERR_INVALID_STATE: The timer is still measuring, stop it first.
+ */
+esp_err_t ccomp_timer_delete(ccomp_timer_handle_t timer);
+
+/**
+ * @brief Reset the elapsed time of the timer and start measuring on the current core.
+ *
+ * @note The cycles are counted by the current core, so the measuring task has to be pinned to it
+ *       until the timer is paused or stopped.
+ *
+ * @param timer Timer handle, created by ccomp_timer_create
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: timer is NULL
+ *  - ESP_ERR_INVALID_STATE: The timer has already been started previously.
+ *  - Others: Fail
+ */
+esp_err_t ccomp_timer_handle_start(ccomp_timer_handle_t timer);
+
+/**
+ * @brief Stop measuring, keeping the elapsed time.
+ *
+ * @param timer Timer handle, created by ccomp_timer_create
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: timer is NULL
+ *  - ESP_ERR_INVALID_STATE: The timer hasn't been started, or it's measuring on the other core.
+ *  - Others: Fail
+ */
+esp_err_t ccomp_timer_handle_stop(ccomp_timer_handle_t timer);
+
+/**
+ * @brief Pause measuring, e.g. to exclude a part of the measured region.
+ *
+ * @param timer Timer handle, created by ccomp_timer_create
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: timer is NULL
+ *  - ESP_ERR_INVALID_STATE: The timer isn't measuring, or it's measuring on the other core.
+ *  - Others: Fail
+ */
+esp_err_t ccomp_timer_handle_pause(ccomp_timer_handle_t timer);
+
+/**
+ * @brief Resume measuring on the current core, adding to the time elapsed before ccomp_timer_handle_pause.
+ *
+ * @param timer Timer handle, created by ccomp_timer_create
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: timer is NULL
+ *  - ESP_ERR_INVALID_STATE: The timer isn't paused.
+ *  - Others: Fail
+ */
+esp_err_t ccomp_timer_handle_resume(ccomp_timer_handle_t timer);
+
+/**
+ * @brief Get the elapsed time of the timer, without stopping it.
+ *
+ * @param timer Timer handle, created by ccomp_timer_create
+ * @param[out] ret_time Returned elapsed time in microseconds, while the timer was measuring since ccomp_timer_handle_start
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: timer or ret_time is NULL
+ *  - ESP_ERR_INVALID_STATE: The timer is measuring on the other core.
+ */
+esp_err_t ccomp_timer_handle_get_time(ccomp_timer_handle_t timer, int64_t *ret_time);
+
+/**
+ * @brief Get the counts of the timer, without stopping it.
+ *
+ * @param timer Timer handle, created by ccomp_timer_create
+ * @param[out] ret_stats Returned counts, while the timer was measuring since ccomp_timer_handle_start
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: timer or ret_stats is NULL
+ *  - ESP_ERR_INVALID_STATE: The timer is measuring on the other core.
+ */
+esp_err_t ccomp_timer_handle_get_stats(ccomp_timer_handle_t timer, ccomp_timer_stats_t *ret_stats);
+
 #ifdef __cplusplus
 }
 #endif
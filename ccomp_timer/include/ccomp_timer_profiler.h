@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Configuration of the sampling profiler
+ */
+typedef struct {
+    uint32_t sample_period_ticks;   // Record the interrupted program counter every this many FreeRTOS ticks, 0 is the same as 1
+    size_t max_samples;             // Size of the sample buffer of each core, recording on a core stops once its buffer is full
+} ccomp_timer_profiler_config_t;
+
+/**
+ * @brief Start recording the interrupted program counter of all cores from the FreeRTOS tick interrupt.
+ *
+ * @note Samples of a previous run are discarded.
+ *
+ * @param config Profiler configuration
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: config is NULL or max_samples is 0
+ *  - ESP_ERR_INVALID_STATE: The profiler is already running.
+ *  - ESP_ERR_NO_MEM: Out of memory for the sample buffers
+ *  - Others: Fail
+ */
+esp_err_t ccomp_timer_profiler_start(const ccomp_timer_profiler_config_t *config);
+
+/**
+ * @brief Stop recording, keeping the samples.
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_STATE: The profiler isn't running.
+ */
+esp_err_t ccomp_timer_profiler_stop(void);
+
+/**
+ * @brief Get the samples recorded on a core.
+ *
+ * @note Can be called while the profiler is running, the returned samples aren't modified anymore.
+ *
+ * @param core_id Core the samples were recorded on
+ * @param[out] ret_pcs Returned array of sampled program counters, valid until the profiler is started again or cleared
+ * @param[out] ret_num_samples Returned number of samples
+ * @param[out] ret_num_dropped Returned number of samples dropped because the buffer is full, can be NULL
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: Invalid core_id, ret_pcs or ret_num_samples is NULL
+ *  - ESP_ERR_INVALID_STATE: The profiler has never been started, or has been cleared.
+ */
+esp_err_t ccomp_timer_profiler_get_samples(int core_id, const uint32_t **ret_pcs, size_t *ret_num_samples, size_t *ret_num_dropped);
+
+/**
+ * @brief Print a flat histogram of the sampled program counters of all cores to the console, most frequent first.
+ *
+ * The addresses are decoded to function names and source lines by IDF Monitor.
+ *
+ * @param max_entries Maximum number of printed program counters, 0 for all of them
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_STATE: The profiler has never been started, or has been cleared.
+ *  - ESP_ERR_NO_MEM: Out of memory for sorting the samples
+ */
+esp_err_t ccomp_timer_profiler_print(size_t max_entries);
+
+/**
+ * @brief Free the sample buffers.
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_STATE: The profiler is running.
+ */
+esp_err_t ccomp_timer_profiler_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
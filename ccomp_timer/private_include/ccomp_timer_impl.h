@@ -62,11 +62,32 @@ esp_err_t ccomp_timer_impl_stop(void);
 esp_err_t ccomp_timer_impl_reset(void);
 
 /**
- * @brief Get the elapsed time kept track of by the underlying implementation in microseconds.
+ * @brief Counters kept track of by the underlying implementation
+ */
+typedef struct {
+    int64_t cycles;         // CPU cycles, including stall cycles
+    int64_t i_stalls;       // cycles stalled by instruction fetch, -1 if not counted by the target
+    int64_t d_stalls;       // cycles stalled by data access, -1 if not counted by the target
+    int64_t instructions;   // executed instructions, -1 if not counted by the target
+} ccomp_timer_impl_counters_t;
+
+/**
+ * @brief Get the counters kept track of by the underlying implementation on the current core,
+ * since ccomp_timer_impl_reset.
+ *
+ * @param[out] counters The elapsed counts.
+ */
+void ccomp_timer_impl_get_counters(ccomp_timer_impl_counters_t *counters);
+
+/**
+ * @brief Get the program counter interrupted on the current core. Should be called from an ISR, e.g. a tick hook.
+ *
+ * @note Read from the frame saved by the outermost interrupt, so if the ISR is nested it's the program counter
+ * of the task interrupted by the outer ISR.
  *
- * @return The elapsed time in microseconds. Set to -1 if the operation is unsuccessful.
+ * @return The interrupted program counter.
  */
-int64_t ccomp_timer_impl_get_time(void);
+uint32_t ccomp_timer_impl_get_interrupted_pc(void);
 
 /**
  * @brief Obtain an internal critical section used in the implementation. Should be treated
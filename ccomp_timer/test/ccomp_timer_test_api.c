@@ -19,6 +19,8 @@
 
 #include "unity.h"
 
+#include "sdkconfig.h"
+
 #ifndef CONFIG_FREERTOS_UNICORE
 static void start_timer(void *param)
 {
@@ -169,3 +171,83 @@ TEST_CASE("timers for each core counts independently", "[ccomp_timer]")
     TEST_ASSERT_GREATER_THAN(t_2, t_1);
 }
 #endif
+
+TEST_CASE("nested timers count independently", "[ccomp_timer]")
+{
+    ccomp_timer_handle_t outer = NULL;
+    ccomp_timer_handle_t inner = NULL;
+    int64_t t_outer = 0;
+    int64_t t_inner = 0;
+    int64_t t_paused = 0;
+
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_create(&outer));
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_create(&inner));
+
+    // Stopping and pausing a non started timer
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, ccomp_timer_handle_stop(inner));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, ccomp_timer_handle_pause(inner));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, ccomp_timer_handle_resume(inner));
+
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_handle_start(outer));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, ccomp_timer_handle_start(outer));
+    // The timer of ccomp_timer_start can run at the same time
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_start());
+
+    int temp = 10000;
+    computation(&temp);
+
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_handle_start(inner));
+    computation(&temp);
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_handle_pause(inner));
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_handle_get_time(inner, &t_paused));
+
+    // Work while paused is not counted
+    computation(&temp);
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_handle_get_time(inner, &t_inner));
+    TEST_ASSERT_EQUAL(t_paused, t_inner);
+
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_handle_resume(inner));
+    computation(&temp);
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_handle_stop(inner));
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_handle_get_time(inner, &t_inner));
+    TEST_ASSERT_GREATER_THAN(t_paused, t_inner);
+
+    // Deleting a running timer
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, ccomp_timer_delete(outer));
+
+    TEST_ASSERT_GREATER_OR_EQUAL(0, ccomp_timer_stop());
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_handle_stop(outer));
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_handle_get_time(outer, &t_outer));
+
+    // The outer timer counted the whole region, including the inner one
+    TEST_ASSERT_GREATER_THAN(t_inner, t_outer);
+
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_delete(inner));
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_delete(outer));
+}
+
+TEST_CASE("getting the counts works", "[ccomp_timer]")
+{
+    ccomp_timer_stats_t stats;
+
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_start());
+
+    int temp = 10000;
+    computation(&temp);
+
+    TEST_ASSERT_GREATER_OR_EQUAL(0, ccomp_timer_stop());
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_get_stats(&stats));
+
+    // The counts are kept once the timer is stopped
+    TEST_ASSERT_EQUAL(ccomp_timer_get_time(), stats.time);
+    TEST_ASSERT_GREATER_THAN(0, stats.cycles);
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
+    TEST_ASSERT_GREATER_OR_EQUAL(0, stats.i_stall_cycles);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, stats.d_stall_cycles);
+    TEST_ASSERT_LESS_OR_EQUAL(stats.cycles, stats.i_stall_cycles + stats.d_stall_cycles);
+#else
+    TEST_ASSERT_EQUAL(-1, stats.i_stall_cycles);
+    TEST_ASSERT_EQUAL(-1, stats.d_stall_cycles);
+#endif
+    TEST_ASSERT_NOT_EQUAL(0, stats.instructions);
+}
@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <stdint.h>
+
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include "ccomp_timer_profiler.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "unity.h"
+
+static void IRAM_ATTR __attribute__((noinline)) busy_loop(int64_t duration_us)
+{
+    int64_t end = esp_timer_get_time() + duration_us;
+    while (esp_timer_get_time() < end) {
+        for (volatile int i = 0; i < 1000; i++) {
+        }
+    }
+}
+
+TEST_CASE("profiler samples the interrupted program counter", "[ccomp_timer]")
+{
+    ccomp_timer_profiler_config_t config = {
+        .sample_period_ticks = 1,
+        .max_samples = 64,
+    };
+    const uint32_t *pcs = NULL;
+    size_t num_samples = 0;
+    size_t num_dropped = 0;
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, ccomp_timer_profiler_stop());
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_profiler_start(&config));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, ccomp_timer_profiler_start(&config));
+
+    // Busy for more ticks than the buffer holds
+    busy_loop(2 * config.max_samples * portTICK_PERIOD_MS * 1000);
+
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_profiler_stop());
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_profiler_get_samples(xPortGetCoreID(), &pcs, &num_samples, &num_dropped));
+    TEST_ASSERT_EQUAL(config.max_samples, num_samples);
+    TEST_ASSERT_GREATER_THAN(0, num_dropped);
+
+    // The interrupted code is mostly the busy loop
+    int in_busy_loop = 0;
+    for (size_t i = 0; i < num_samples; i++) {
+        if (pcs[i] >= (uint32_t)busy_loop && pcs[i] < (uint32_t)busy_loop + 128) {
+            in_busy_loop++;
+        }
+    }
+    TEST_ASSERT_GREATER_THAN(0, in_busy_loop);
+
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_profiler_print(10));
+    TEST_ASSERT_EQUAL(ESP_OK, ccomp_timer_profiler_clear());
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, ccomp_timer_profiler_print(10));
+}
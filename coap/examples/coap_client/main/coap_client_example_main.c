@@ -33,6 +33,10 @@
 
 #include "coap3/coap.h"
 
+#ifdef CONFIG_COAP_DTLS_RESUME
+#include "esp_attr.h"
+#include "coap_dtls_resume.h"
+#endif /* CONFIG_COAP_DTLS_RESUME */
 
 #ifndef CONFIG_COAP_CLIENT_SUPPORT
 #error COAP_CLIENT_SUPPORT needs to be enabled
@@ -79,6 +83,13 @@ static int resp_wait = 1;
 static coap_optlist_t *optlist = NULL;
 static int wait_ms;
 
+#ifdef CONFIG_COAP_DTLS_RESUME
+/* DTLS session of the last connection, kept in RTC memory across software resets and deep sleep,
+   so that the next connection takes an abbreviated handshake */
+static RTC_NOINIT_ATTR uint8_t dtls_state[1024];
+static RTC_NOINIT_ATTR size_t dtls_state_len;
+#endif /* CONFIG_COAP_DTLS_RESUME */
+
 #ifdef CONFIG_COAP_MBEDTLS_PKI
 /* CA cert, taken from coap_ca.pem
    Client cert, taken from coap_client.crt
@@ -329,6 +340,14 @@ static void coap_example_client(void *p)
     coap_set_log_handler(coap_log_handler);
     coap_set_log_level(EXAMPLE_COAP_LOG_DEFAULT_LEVEL);
 
+#ifdef CONFIG_COAP_DTLS_RESUME
+    /* The state is checked, the memory holds garbage after a power-on reset */
+    if (dtls_state_len <= sizeof(dtls_state) &&
+            coap_dtls_resume_load(dtls_state, dtls_state_len) == ESP_OK) {
+        ESP_LOGI(TAG, "Resuming the DTLS session of the last connection");
+    }
+#endif /* CONFIG_COAP_DTLS_RESUME */
+
     /* Set up the CoAP context */
     ctx = coap_new_context(NULL);
     if (!ctx) {
@@ -439,6 +458,11 @@ static void coap_example_client(void *p)
                 }
             }
         }
+#ifdef CONFIG_COAP_DTLS_RESUME
+        if (!resp_wait && proto == COAP_PROTO_DTLS) {
+            coap_dtls_resume_save(session, dtls_state, sizeof(dtls_state), &dtls_state_len);
+        }
+#endif /* CONFIG_COAP_DTLS_RESUME */
         for (int countdown = 10; countdown >= 0; countdown--) {
             ESP_LOGI(TAG, "%d... ", countdown);
             vTaskDelay(1000 / portTICK_PERIOD_MS);
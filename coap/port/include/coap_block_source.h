@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_partition.h"
+#include "coap3/coap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Block-wise (RFC 7959) responses served from flash
+ *
+ * A block source serves a large payload from an esp_partition or a FILE* with Block2 responses.
+ * For every request the requested block is read directly into the payload of the response PDU,
+ * so the memory used doesn't depend on the size of the payload and there is no intermediate copy.
+ * File sources keep track of the position, so sequential blocks are read without seeking and
+ * keep using the read-ahead of the stdio buffer.
+ *
+ * Call coap_block_source_response() from the GET handler of the resource, in place of
+ * coap_add_data_large_response().
+ */
+
+/**
+ * @brief Handle of a block source
+ */
+typedef struct coap_block_source *coap_block_source_handle_t;
+
+/**
+ * @brief Create a block source serving a region of a partition
+ *
+ * @param[in]  partition  Partition holding the payload
+ * @param[in]  offset     Offset of the payload in the partition
+ * @param[in]  size       Size of the payload
+ * @param[in]  media_type Content-Format of the payload, e.g. COAP_MEDIATYPE_APPLICATION_OCTET_STREAM
+ * @param[out] ret_source Block source handle
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument, or the region is outside of the partition
+ *     - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t coap_block_source_new_partition(const esp_partition_t *partition, size_t offset, size_t size,
+        uint16_t media_type, coap_block_source_handle_t *ret_source);
+
+/**
+ * @brief Create a block source serving a file
+ *
+ * The file must stay open while the source is used, and is not closed by coap_block_source_delete().
+ *
+ * @param[in]  file       File opened for reading
+ * @param[in]  size       Size of the payload, read from the start of the file
+ * @param[in]  media_type Content-Format of the payload
+ * @param[out] ret_source Block source handle
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument
+ *     - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t coap_block_source_new_file(FILE *file, size_t size, uint16_t media_type,
+                                     coap_block_source_handle_t *ret_source);
+
+/**
+ * @brief Delete a block source
+ *
+ * @param[in] source Block source handle
+ */
+void coap_block_source_delete(coap_block_source_handle_t source);
+
+/**
+ * @brief Fill the response to a GET request with the requested block
+ *
+ * Takes the block number and size from the Block2 option of the request, block 0 when missing.
+ * The block size is lowered to fit the maximum PDU size of the session. Adds the Content-Format,
+ * Block2 and, for the first block, Size2 options and sets the code to 2.05 Content, or
+ * 4.02 Bad Option when the block is past the end of the payload.
+ *
+ * @param[in] source   Block source handle
+ * @param[in] session  Session of the request
+ * @param[in] request  Request
+ * @param[in] response Response passed to the handler
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument, or the block is past the end of the payload
+ *     - ESP_ERR_NO_MEM: The options or the block don't fit in the response
+ *     - ESP_FAIL: Reading the block failed, the code is set to 5.00 Internal Server Error
+ */
+esp_err_t coap_block_source_response(coap_block_source_handle_t source, coap_session_t *session,
+                                     const coap_pdu_t *request, coap_pdu_t *response);
+
+#ifdef __cplusplus
+}
+#endif
@@ -38,7 +38,9 @@
 
 #define HAVE_LIMITS_H
 
+#ifndef CONFIG_COAP_RESOURCES_HASH
 #define COAP_RESOURCES_NOHASH
+#endif /* ! CONFIG_COAP_RESOURCES_HASH */
 
 /* Note: If neither of COAP_CLIENT_SUPPORT or COAP_SERVER_SUPPORT is set,
    then libcoap sets both for backward compatability */
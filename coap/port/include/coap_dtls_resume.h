@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "coap3/coap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * DTLS session resumption, enabled by CONFIG_COAP_DTLS_RESUME
+ *
+ * Once a DTLS client session is connected, its Mbed TLS session (session ID or ticket, and master secret)
+ * is exported with coap_dtls_resume_save() into a buffer, which the application keeps in RTC memory or NVS.
+ * After a reset or deep sleep, coap_dtls_resume_load() gives it back, and the next DTLS client session to the
+ * same server starts with an abbreviated handshake: one round trip and no key exchange, instead of the full
+ * handshake. If the server doesn't know the session any more, the full handshake takes place.
+ *
+ * With CONFIG_COAP_DTLS_CID, the client sessions negotiate a DTLS Connection ID (RFC 9146) with servers which
+ * support it, so a connected session survives a change of the client address or port, e.g. by a NAT.
+ *
+ * With CONFIG_COAP_DTLS_SERVER_TICKETS, DTLS server sessions issue session tickets, so that clients resume their
+ * sessions without the server keeping any state.
+ */
+
+/**
+ * @brief Export the DTLS session of a connected client session
+ *
+ * The session is also kept in memory, so that new sessions to the same server are resumed until the reset.
+ * Call it once the session is connected, e.g. on COAP_EVENT_DTLS_CONNECTED or after the first response.
+ *
+ * @param[in]  session CoAP client session, over DTLS
+ * @param[out] buf     Buffer receiving the state, NULL to get its length
+ * @param[in]  size    Size of buf
+ * @param[out] len     Length of the state
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument, or not a DTLS client session
+ *     - ESP_ERR_INVALID_STATE: The session is not connected
+ *     - ESP_ERR_INVALID_SIZE: buf is too small, *len is the required size
+ *     - ESP_ERR_NO_MEM: No free entry among CONFIG_COAP_DTLS_RESUME_MAX_PEERS, or not enough memory
+ *     - ESP_FAIL: Mbed TLS error
+ */
+esp_err_t coap_dtls_resume_save(coap_session_t *session, uint8_t *buf, size_t size, size_t *len);
+
+/**
+ * @brief Give back a state exported by coap_dtls_resume_save(), to resume the next DTLS session to its server
+ *
+ * Must be called before the session is created, by the same firmware.
+ *
+ * @param[in] buf State
+ * @param[in] len Length of the state
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument
+ *     - ESP_ERR_INVALID_VERSION: The state was not saved by this firmware, or is corrupted
+ *     - ESP_ERR_NO_MEM: No free entry among CONFIG_COAP_DTLS_RESUME_MAX_PEERS, or not enough memory
+ */
+esp_err_t coap_dtls_resume_load(const uint8_t *buf, size_t len);
+
+/**
+ * @brief Forget the session of a server, or of all servers
+ *
+ * The next session to the server takes the full handshake. A session unknown to the server falls back to the
+ * full handshake anyway, this is e.g. for a server whose keys or certificate changed.
+ *
+ * @param[in] server Address of the server, NULL for all servers
+ */
+void coap_dtls_resume_forget(const coap_address_t *server);
+
+#ifdef __cplusplus
+}
+#endif
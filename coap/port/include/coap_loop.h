@@ -0,0 +1,212 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include <sys/select.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "coap3/coap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Event loop driving several CoAP contexts and application sockets with one select()
+ *
+ * The loop collects the sockets of all its contexts, the application file descriptors added with
+ * coap_loop_add_fd() and an eventfd, waits for them with a single select() bounded by the earliest
+ * libcoap timeout, and processes the contexts which have work to do. Client, server and observe
+ * contexts can so share one task instead of running coap_io_process() in a task each.
+ *
+ * The loop runs either in its own task, or in a select() loop of the application with
+ * coap_loop_prepare_fds() and coap_loop_process_fds().
+ *
+ * libcoap is not thread safe: use the contexts of a loop from its task only, e.g. with coap_loop_call().
+ * Adding and removing contexts and file descriptors is safe from any task.
+ *
+ * The eventfd VFS is registered by coap_loop_create() if the application hasn't registered it.
+ */
+
+/**
+ * @brief Handle of a loop
+ */
+typedef struct coap_loop *coap_loop_handle_t;
+
+/**
+ * @brief Callback for a readable application file descriptor, called from the loop
+ */
+typedef void (*coap_loop_fd_cb_t)(int fd, void *arg);
+
+/**
+ * @brief Function run in the loop by coap_loop_call()
+ */
+typedef void (*coap_loop_call_cb_t)(void *arg);
+
+/**
+ * @brief Loop configuration
+ */
+typedef struct {
+    uint32_t task_stack_size;   /**< Stack size of the loop task, 0 to run the loop from the application */
+    UBaseType_t task_priority;  /**< Priority of the loop task */
+    BaseType_t task_core_id;    /**< Core of the loop task, tskNO_AFFINITY for any */
+    size_t max_calls;           /**< Number of coap_loop_call() requests waiting at most */
+} coap_loop_config_t;
+
+/**
+ * @brief Default loop configuration, running the loop in its own task
+ */
+#define COAP_LOOP_DEFAULT_CONFIG() {    \
+    .task_stack_size = 6144,            \
+    .task_priority = 5,                 \
+    .task_core_id = tskNO_AFFINITY,     \
+    .max_calls = 8,                     \
+}
+
+/**
+ * @brief Create a loop
+ *
+ * @param[in]  config   Loop configuration
+ * @param[out] ret_loop Loop handle
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument
+ *     - ESP_ERR_NO_MEM: Out of memory
+ *     - ESP_FAIL: The eventfd could not be created
+ */
+esp_err_t coap_loop_create(const coap_loop_config_t *config, coap_loop_handle_t *ret_loop);
+
+/**
+ * @brief Delete a loop
+ *
+ * Stops the loop task. The contexts and file descriptors of the loop are not freed or closed.
+ * Must not be called from the loop.
+ *
+ * @param[in] loop Loop handle
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument
+ */
+esp_err_t coap_loop_delete(coap_loop_handle_t loop);
+
+/**
+ * @brief Add a context to the loop
+ *
+ * @param[in] loop Loop handle
+ * @param[in] ctx  CoAP context
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument
+ *     - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t coap_loop_add_context(coap_loop_handle_t loop, coap_context_t *ctx);
+
+/**
+ * @brief Remove a context from the loop
+ *
+ * The context is no longer used by the loop when the function returns, and can be freed.
+ *
+ * @param[in] loop Loop handle
+ * @param[in] ctx  CoAP context
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument
+ *     - ESP_ERR_NOT_FOUND: The context is not in the loop
+ */
+esp_err_t coap_loop_remove_context(coap_loop_handle_t loop, coap_context_t *ctx);
+
+/**
+ * @brief Add an application file descriptor, `cb` is called from the loop when it is readable
+ *
+ * @param[in] loop Loop handle
+ * @param[in] fd   File descriptor
+ * @param[in] cb   Callback
+ * @param[in] arg  Argument of the callback
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument
+ *     - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t coap_loop_add_fd(coap_loop_handle_t loop, int fd, coap_loop_fd_cb_t cb, void *arg);
+
+/**
+ * @brief Remove an application file descriptor from the loop
+ *
+ * @param[in] loop Loop handle
+ * @param[in] fd   File descriptor
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument
+ *     - ESP_ERR_NOT_FOUND: The file descriptor is not in the loop
+ */
+esp_err_t coap_loop_remove_fd(coap_loop_handle_t loop, int fd);
+
+/**
+ * @brief Run a function in the loop, e.g. to send a request from another task
+ *
+ * The loop is woken up, so the timeouts are recomputed after the function has run.
+ *
+ * @param[in] loop Loop handle
+ * @param[in] cb   Function
+ * @param[in] arg  Argument of the function
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument
+ *     - ESP_ERR_NO_MEM: `max_calls` requests are already waiting
+ */
+esp_err_t coap_loop_call(coap_loop_handle_t loop, coap_loop_call_cb_t cb, void *arg);
+
+/**
+ * @brief Add the file descriptors of the loop to the sets of an application select()
+ *
+ * @param[in]    loop     Loop handle
+ * @param[inout] nfds     Highest file descriptor plus one, updated
+ * @param[inout] readfds  Read set
+ * @param[inout] writefds Write set
+ * @param[inout] exceptfds Exception set
+ *
+ * @return Time until the next libcoap timeout in milliseconds, 0 if there is none
+ */
+uint32_t coap_loop_prepare_fds(coap_loop_handle_t loop, int *nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds);
+
+/**
+ * @brief Process the contexts and file descriptors of the loop after the application select()
+ *
+ * Must be called after every coap_loop_prepare_fds(), also when select() timed out.
+ *
+ * @param[in] loop      Loop handle
+ * @param[in] readfds   Read set returned by select()
+ * @param[in] writefds  Write set returned by select()
+ * @param[in] exceptfds Exception set returned by select()
+ */
+void coap_loop_process_fds(coap_loop_handle_t loop, const fd_set *readfds, const fd_set *writefds, const fd_set *exceptfds);
+
+/**
+ * @brief Wait for and process the events of the loop once
+ *
+ * Used by the loop task, or by applications running the loop themselves.
+ *
+ * @param[in] loop       Loop handle
+ * @param[in] max_wait_ms Maximum time to wait, UINT32_MAX to wait until an event or timeout
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument
+ *     - ESP_FAIL: select() failed
+ */
+esp_err_t coap_loop_run_once(coap_loop_handle_t loop, uint32_t max_wait_ms);
+
+#ifdef __cplusplus
+}
+#endif
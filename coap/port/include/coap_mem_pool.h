@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stddef.h>
+#include "esp_err.h"
+#include "coap3/coap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Static memory pools for libcoap, enabled by CONFIG_COAP_MEMORY_POOLS
+ *
+ * The allocations of libcoap for COAP_PDU, COAP_PDU_BUF, COAP_SESSION, COAP_NODE and COAP_STRING
+ * are served from per-type pools of fixed size blocks. Allocations larger than the block size,
+ * or made when the pool is exhausted, fall back to the heap.
+ */
+
+/**
+ * @brief Statistics of a pool
+ */
+typedef struct {
+    size_t block_size;  /**< Size of the blocks */
+    size_t count;       /**< Number of blocks */
+    size_t used;        /**< Blocks in use */
+    size_t peak;        /**< Maximum number of blocks in use at once */
+    size_t fallbacks;   /**< Allocations taken from the heap, because the pool was exhausted or the block too small */
+    size_t largest;     /**< Largest allocation requested */
+} coap_mem_pool_stats_t;
+
+/**
+ * @brief Get the statistics of the pool of a memory type
+ *
+ * @param[in]  type  Memory type, e.g. COAP_PDU
+ * @param[out] stats Statistics
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument
+ *     - ESP_ERR_NOT_FOUND: The type has no pool
+ */
+esp_err_t coap_mem_pool_get_stats(coap_memory_tag_t type, coap_mem_pool_stats_t *stats);
+
+/**
+ * @brief Reset the peak usage, fallback count and largest allocation of all the pools
+ */
+void coap_mem_pool_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
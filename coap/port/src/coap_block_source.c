@@ -0,0 +1,134 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <sys/param.h>
+#include "esp_check.h"
+#include "coap_block_source.h"
+
+static const char *TAG = "coap_block_source";
+
+#define BLOCK_SZX_MAX       6       // 1024 bytes, BERT is not used
+#define BLOCK_PDU_OVERHEAD  64      // Header, token and options of a Block2 response
+
+typedef struct coap_block_source {
+    const esp_partition_t *partition;
+    FILE *file;
+    size_t offset;          // Offset of the payload in the partition
+    size_t size;
+    size_t file_pos;        // Current position of the file, to read sequential blocks without seeking
+    uint16_t media_type;
+} coap_block_source_t;
+
+esp_err_t coap_block_source_new_partition(const esp_partition_t *partition, size_t offset, size_t size,
+        uint16_t media_type, coap_block_source_handle_t *ret_source)
+{
+    ESP_RETURN_ON_FALSE(partition && ret_source && offset <= partition->size && size <= partition->size - offset,
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+
+    coap_block_source_t *source = calloc(1, sizeof(coap_block_source_t));
+    ESP_RETURN_ON_FALSE(source, ESP_ERR_NO_MEM, TAG, "Failed to allocate block source");
+    source->partition = partition;
+    source->offset = offset;
+    source->size = size;
+    source->media_type = media_type;
+    *ret_source = source;
+    return ESP_OK;
+}
+
+esp_err_t coap_block_source_new_file(FILE *file, size_t size, uint16_t media_type,
+                                     coap_block_source_handle_t *ret_source)
+{
+    ESP_RETURN_ON_FALSE(file && ret_source, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+
+    coap_block_source_t *source = calloc(1, sizeof(coap_block_source_t));
+    ESP_RETURN_ON_FALSE(source, ESP_ERR_NO_MEM, TAG, "Failed to allocate block source");
+    source->file = file;
+    source->size = size;
+    // Unknown until the first read
+    source->file_pos = SIZE_MAX;
+    source->media_type = media_type;
+    *ret_source = source;
+    return ESP_OK;
+}
+
+void coap_block_source_delete(coap_block_source_handle_t source)
+{
+    free(source);
+}
+
+static esp_err_t block_read(coap_block_source_t *source, size_t offset, uint8_t *buf, size_t len)
+{
+    if (source->partition) {
+        return esp_partition_read(source->partition, source->offset + offset, buf, len);
+    }
+
+    if (source->file_pos != offset) {
+        if (fseek(source->file, (long)offset, SEEK_SET) != 0) {
+            source->file_pos = SIZE_MAX;
+            return ESP_FAIL;
+        }
+        source->file_pos = offset;
+    }
+    const size_t n = fread(buf, 1, len, source->file);
+    source->file_pos = (n == len) ? source->file_pos + n : SIZE_MAX;
+    return (n == len) ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t add_uint_option(coap_pdu_t *pdu, coap_option_num_t number, unsigned int value)
+{
+    uint8_t buf[4];
+    return coap_add_option(pdu, number, coap_encode_var_safe(buf, sizeof(buf), value), buf) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t coap_block_source_response(coap_block_source_handle_t source, coap_session_t *session,
+                                     const coap_pdu_t *request, coap_pdu_t *response)
+{
+    ESP_RETURN_ON_FALSE(source && session && request && response, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+
+    unsigned int szx = BLOCK_SZX_MAX;
+    const size_t max_pdu_size = coap_session_max_pdu_size(session);
+    while (szx > 0 && (1u << (szx + 4)) + BLOCK_PDU_OVERHEAD > max_pdu_size) {
+        szx--;
+    }
+
+    size_t offset = 0;
+    coap_block_b_t block;
+    if (coap_get_block_b(session, request, COAP_OPTION_BLOCK2, &block)) {
+        // A smaller block size than requested keeps the same offset, as allowed by RFC 7959
+        offset = (size_t)block.num << (block.szx + 4);
+        szx = MIN(szx, block.szx);
+    }
+    const size_t block_size = 1u << (szx + 4);
+    if (offset >= source->size && !(offset == 0 && source->size == 0)) {
+        coap_pdu_set_code(response, COAP_RESPONSE_CODE_BAD_OPTION);
+        return ESP_ERR_INVALID_ARG;
+    }
+    const size_t len = MIN(block_size, source->size - offset);
+    const bool more = offset + len < source->size;
+
+    coap_pdu_set_code(response, COAP_RESPONSE_CODE_CONTENT);
+    ESP_RETURN_ON_ERROR(add_uint_option(response, COAP_OPTION_CONTENT_FORMAT, source->media_type), TAG,
+                        "Failed to add Content-Format");
+    ESP_RETURN_ON_ERROR(add_uint_option(response, COAP_OPTION_BLOCK2, ((offset / block_size) << 4) | ((unsigned int)more << 3) | szx),
+                        TAG, "Failed to add Block2");
+    if (offset == 0) {
+        ESP_RETURN_ON_ERROR(add_uint_option(response, COAP_OPTION_SIZE2, source->size), TAG, "Failed to add Size2");
+    }
+    if (len == 0) {
+        return ESP_OK;
+    }
+
+    // Read the block straight into the payload of the PDU
+    uint8_t *payload = coap_add_data_after(response, len);
+    ESP_RETURN_ON_FALSE(payload, ESP_ERR_NO_MEM, TAG, "Failed to add %u bytes of payload", (unsigned)len);
+    if (block_read(source, offset, payload, len) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to read %u bytes at offset %u", (unsigned)len, (unsigned)offset);
+        coap_pdu_set_code(response, COAP_RESPONSE_CODE_INTERNAL_ERROR);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,277 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/lock.h>
+#include "esp_check.h"
+#include "esp_random.h"
+#include "esp_rom_crc.h"
+#include "mbedtls/ssl.h"
+#if CONFIG_COAP_DTLS_SERVER_TICKETS
+#include "mbedtls/ssl_ticket.h"
+#endif
+#include "coap_dtls_resume.h"
+
+static const char *TAG = "coap_dtls_resume";
+
+#define STATE_MAGIC     0x31524443  // "CDR1"
+
+/* Header of the state, followed by the session serialized by mbedtls_ssl_session_save() */
+typedef struct {
+    uint32_t magic;
+    uint32_t crc;                   // Of what follows the CRC
+    uint32_t session_len;
+    coap_address_t peer;
+} state_header_t;
+
+typedef struct {
+    bool used;
+    bool has_session;
+    coap_address_t peer;
+    mbedtls_ssl_session session;
+} peer_session_t;
+
+static peer_session_t s_peers[CONFIG_COAP_DTLS_RESUME_MAX_PEERS];
+static _lock_t s_lock;
+
+/* Session being set up by libcoap in this task, see the wrappers below */
+static __thread coap_session_t *s_setup_session;
+static __thread bool s_setup_client;
+
+#if CONFIG_COAP_DTLS_SERVER_TICKETS
+static mbedtls_ssl_ticket_context s_ticket_ctx;
+static bool s_ticket_ready;
+#endif
+
+/* Called with the lock held */
+static peer_session_t *peer_find(const coap_address_t *peer, bool add)
+{
+    peer_session_t *free_entry = NULL;
+    for (int i = 0; i < CONFIG_COAP_DTLS_RESUME_MAX_PEERS; i++) {
+        if (s_peers[i].used && coap_address_equals(&s_peers[i].peer, peer)) {
+            return &s_peers[i];
+        }
+        if (!s_peers[i].used && !free_entry) {
+            free_entry = &s_peers[i];
+        }
+    }
+    if (!add || !free_entry) {
+        return NULL;
+    }
+    mbedtls_ssl_session_init(&free_entry->session);
+    free_entry->peer = *peer;
+    free_entry->used = true;
+    free_entry->has_session = false;
+    return free_entry;
+}
+
+/* Called with the lock held */
+static void peer_free(peer_session_t *entry)
+{
+    mbedtls_ssl_session_free(&entry->session);
+    entry->used = false;
+}
+
+#if CONFIG_COAP_DTLS_SERVER_TICKETS
+static int ticket_rng(void *ctx, unsigned char *buf, size_t len)
+{
+    esp_fill_random(buf, len);
+    return 0;
+}
+
+static void server_conf_tickets(const mbedtls_ssl_config *conf)
+{
+    _lock_acquire(&s_lock);
+    if (!s_ticket_ready) {
+        // The ticket keys are generated once, tickets issued before a reset of the server are not accepted after it
+        mbedtls_ssl_ticket_init(&s_ticket_ctx);
+        s_ticket_ready = mbedtls_ssl_ticket_setup(&s_ticket_ctx, ticket_rng, NULL, MBEDTLS_CIPHER_AES_128_GCM,
+                         CONFIG_COAP_DTLS_SERVER_TICKET_LIFETIME) == 0;
+    }
+    _lock_release(&s_lock);
+    if (s_ticket_ready) {
+        // The configuration belongs to the Mbed TLS environment of the session, set up by libcoap
+        mbedtls_ssl_conf_session_tickets_cb((mbedtls_ssl_config *)conf, mbedtls_ssl_ticket_write,
+                                            mbedtls_ssl_ticket_parse, &s_ticket_ctx);
+    } else {
+        ESP_LOGW(TAG, "Failed to set up the session tickets");
+    }
+}
+#endif /* CONFIG_COAP_DTLS_SERVER_TICKETS */
+
+static void client_ssl_resume(mbedtls_ssl_context *ssl, coap_session_t *session)
+{
+#if CONFIG_COAP_DTLS_CID
+    // Empty own CID: the server sends no CID, the client sends the CID given by the server
+    if (mbedtls_ssl_set_cid(ssl, MBEDTLS_SSL_CID_ENABLED, NULL, 0) != 0) {
+        ESP_LOGW(TAG, "Failed to enable the Connection ID");
+    }
+#endif
+    _lock_acquire(&s_lock);
+    peer_session_t *entry = peer_find(coap_session_get_addr_remote(session), false);
+    if (entry && entry->has_session && mbedtls_ssl_set_session(ssl, &entry->session) != 0) {
+        ESP_LOGW(TAG, "Failed to resume the session, full handshake");
+    }
+    _lock_release(&s_lock);
+}
+
+/* libcoap and Mbed TLS functions, see --wrap in CMakeLists.txt. libcoap builds both the client and the server when neither is selected */
+int __real_mbedtls_ssl_setup(mbedtls_ssl_context *ssl, const mbedtls_ssl_config *conf);
+
+#if COAP_CLIENT_SUPPORT || !COAP_SERVER_SUPPORT
+void *__real_coap_dtls_new_client_session(coap_session_t *session);
+
+void *__wrap_coap_dtls_new_client_session(coap_session_t *session)
+{
+    s_setup_session = session;
+    s_setup_client = true;
+    void *tls = __real_coap_dtls_new_client_session(session);
+    s_setup_session = NULL;
+    return tls;
+}
+#endif
+
+#if COAP_SERVER_SUPPORT || !COAP_CLIENT_SUPPORT
+void *__real_coap_dtls_new_server_session(coap_session_t *session);
+
+void *__wrap_coap_dtls_new_server_session(coap_session_t *session)
+{
+    s_setup_session = session;
+    s_setup_client = false;
+    void *tls = __real_coap_dtls_new_server_session(session);
+    s_setup_session = NULL;
+    return tls;
+}
+#endif
+
+/* Called by libcoap between the configuration of the session and the start of the handshake, and by other users of Mbed TLS */
+int __wrap_mbedtls_ssl_setup(mbedtls_ssl_context *ssl, const mbedtls_ssl_config *conf)
+{
+    coap_session_t *session = s_setup_session;
+    if (session == NULL) {
+        return __real_mbedtls_ssl_setup(ssl, conf);
+    }
+    s_setup_session = NULL;
+
+#if CONFIG_COAP_DTLS_SERVER_TICKETS
+    if (!s_setup_client) {
+        server_conf_tickets(conf);
+    }
+#endif
+    int ret = __real_mbedtls_ssl_setup(ssl, conf);
+    if (ret == 0 && s_setup_client) {
+        client_ssl_resume(ssl, session);
+    }
+    return ret;
+}
+
+esp_err_t coap_dtls_resume_save(coap_session_t *session, uint8_t *buf, size_t size, size_t *len)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(session && len && (buf || size == 0), ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(coap_session_get_proto(session) == COAP_PROTO_DTLS &&
+                        coap_session_get_type(session) == COAP_SESSION_TYPE_CLIENT,
+                        ESP_ERR_INVALID_ARG, TAG, "Not a DTLS client session");
+    coap_tls_library_t tls_lib;
+    mbedtls_ssl_context *ssl = coap_session_get_tls(session, &tls_lib);
+    ESP_RETURN_ON_FALSE(ssl && tls_lib == COAP_TLS_LIBRARY_MBEDTLS &&
+                        coap_session_get_state(session) == COAP_SESSION_STATE_ESTABLISHED,
+                        ESP_ERR_INVALID_STATE, TAG, "Session not connected");
+
+    _lock_acquire(&s_lock);
+    peer_session_t *entry = peer_find(coap_session_get_addr_remote(session), true);
+    ESP_GOTO_ON_FALSE(entry, ESP_ERR_NO_MEM, out, TAG, "No free peer entry");
+
+    mbedtls_ssl_session exported;
+    mbedtls_ssl_session_init(&exported);
+    int mret = mbedtls_ssl_get_session(ssl, &exported);
+    if (mret == 0) {
+        // The entry takes the ownership of the ticket and certificate of the exported session
+        mbedtls_ssl_session_free(&entry->session);
+        entry->session = exported;
+        entry->has_session = true;
+    } else {
+        mbedtls_ssl_session_free(&exported);
+        // Since Mbed TLS 3.0 a session is exported once per connection, the entry holds it from the first export
+        if (mret != MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE || !entry->has_session) {
+            if (!entry->has_session) {
+                peer_free(entry);
+            }
+            ESP_LOGE(TAG, "Failed to export the session: -0x%x", -mret);
+            ret = ESP_FAIL;
+            goto out;
+        }
+    }
+
+    const size_t header_len = sizeof(state_header_t);
+    size_t session_len = 0;
+    mret = mbedtls_ssl_session_save(&entry->session, size > header_len ? buf + header_len : NULL,
+                                    size > header_len ? size - header_len : 0, &session_len);
+    *len = header_len + session_len;
+    ESP_GOTO_ON_FALSE(mret != MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL, ESP_ERR_INVALID_SIZE, out, TAG, "Buffer too small");
+    ESP_GOTO_ON_FALSE(mret == 0, ESP_FAIL, out, TAG, "Failed to serialize the session: -0x%x", -mret);
+
+    state_header_t header = {
+        .magic = STATE_MAGIC,
+        .session_len = session_len,
+        .peer = entry->peer,
+    };
+    memcpy(buf, &header, header_len);
+    header.crc = esp_rom_crc32_le(0, buf + offsetof(state_header_t, session_len), *len - offsetof(state_header_t, session_len));
+    memcpy(buf + offsetof(state_header_t, crc), &header.crc, sizeof(header.crc));
+
+out:
+    _lock_release(&s_lock);
+    return ret;
+}
+
+esp_err_t coap_dtls_resume_load(const uint8_t *buf, size_t len)
+{
+    esp_err_t ret = ESP_OK;
+    state_header_t header;
+    ESP_RETURN_ON_FALSE(buf && len >= sizeof(header), ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    memcpy(&header, buf, sizeof(header));
+    ESP_RETURN_ON_FALSE(header.magic == STATE_MAGIC && header.session_len == len - sizeof(header) &&
+                        header.crc == esp_rom_crc32_le(0, buf + offsetof(state_header_t, session_len),
+                                                       len - offsetof(state_header_t, session_len)),
+                        ESP_ERR_INVALID_VERSION, TAG, "Invalid state");
+
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    int mret = mbedtls_ssl_session_load(&session, buf + sizeof(header), header.session_len);
+    if (mret != 0) {
+        mbedtls_ssl_session_free(&session);
+        ESP_LOGE(TAG, "Failed to load the session: -0x%x", -mret);
+        return mret == MBEDTLS_ERR_SSL_ALLOC_FAILED ? ESP_ERR_NO_MEM : ESP_ERR_INVALID_VERSION;
+    }
+
+    _lock_acquire(&s_lock);
+    peer_session_t *entry = peer_find(&header.peer, true);
+    if (entry) {
+        mbedtls_ssl_session_free(&entry->session);
+        entry->session = session;
+        entry->has_session = true;
+    } else {
+        mbedtls_ssl_session_free(&session);
+        ESP_LOGE(TAG, "No free peer entry");
+        ret = ESP_ERR_NO_MEM;
+    }
+    _lock_release(&s_lock);
+    return ret;
+}
+
+void coap_dtls_resume_forget(const coap_address_t *server)
+{
+    _lock_acquire(&s_lock);
+    for (int i = 0; i < CONFIG_COAP_DTLS_RESUME_MAX_PEERS; i++) {
+        if (s_peers[i].used && (server == NULL || coap_address_equals(&s_peers[i].peer, server))) {
+            peer_free(&s_peers[i]);
+        }
+    }
+    _lock_release(&s_lock);
+}
@@ -0,0 +1,409 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_check.h"
+#include "esp_vfs_eventfd.h"
+#include "coap_loop.h"
+/* coap_socket_t and coap_io_prepare_io() are only available to the port */
+#include "coap3/coap_internal.h"
+
+static const char *TAG = "coap_loop";
+
+#define LOOP_MAX_SOCKETS    64      // Same as the socket array of a libcoap context
+
+typedef struct loop_ctx {
+    coap_context_t *ctx;            // NULL when removed while the loop is processing
+    coap_socket_t *sockets[LOOP_MAX_SOCKETS];
+    unsigned int num_sockets;       // Sockets collected by the last coap_loop_prepare_fds()
+    struct loop_ctx *next;
+} loop_ctx_t;
+
+typedef struct loop_fd {
+    int fd;                         // -1 when removed while the loop is processing
+    coap_loop_fd_cb_t cb;
+    void *arg;
+    struct loop_fd *next;
+} loop_fd_t;
+
+typedef struct {
+    coap_loop_call_cb_t cb;
+    void *arg;
+} loop_call_t;
+
+struct coap_loop {
+    SemaphoreHandle_t lock;         // Recursive, held while processing so callbacks can modify the loop
+    loop_ctx_t *ctxs;
+    loop_fd_t *fds;
+    bool processing;
+    bool purge;                     // Entries were removed while processing
+    int event_fd;
+    QueueHandle_t calls;
+    TaskHandle_t task;
+    SemaphoreHandle_t task_done;
+    volatile bool stop;
+};
+
+static void loop_wake(struct coap_loop *loop)
+{
+    const uint64_t one = 1;
+    if (write(loop->event_fd, &one, sizeof(one)) != sizeof(one)) {
+        ESP_LOGW(TAG, "Failed to wake up the loop");
+    }
+}
+
+static void loop_lock(struct coap_loop *loop)
+{
+    xSemaphoreTakeRecursive(loop->lock, portMAX_DELAY);
+}
+
+static void loop_unlock(struct coap_loop *loop)
+{
+    xSemaphoreGiveRecursive(loop->lock);
+}
+
+static void loop_task(void *arg)
+{
+    struct coap_loop *loop = (struct coap_loop *)arg;
+    while (!loop->stop) {
+        coap_loop_run_once(loop, UINT32_MAX);
+    }
+    xSemaphoreGive(loop->task_done);
+    vTaskDelete(NULL);
+}
+
+static void loop_free(struct coap_loop *loop)
+{
+    while (loop->ctxs) {
+        loop_ctx_t *next = loop->ctxs->next;
+        free(loop->ctxs);
+        loop->ctxs = next;
+    }
+    while (loop->fds) {
+        loop_fd_t *next = loop->fds->next;
+        free(loop->fds);
+        loop->fds = next;
+    }
+    if (loop->event_fd >= 0) {
+        close(loop->event_fd);
+    }
+    if (loop->calls) {
+        vQueueDelete(loop->calls);
+    }
+    if (loop->task_done) {
+        vSemaphoreDelete(loop->task_done);
+    }
+    if (loop->lock) {
+        vSemaphoreDelete(loop->lock);
+    }
+    free(loop);
+}
+
+esp_err_t coap_loop_create(const coap_loop_config_t *config, coap_loop_handle_t *ret_loop)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_loop && config->max_calls > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+
+    esp_vfs_eventfd_config_t eventfd_config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+    ret = esp_vfs_eventfd_register(&eventfd_config);
+    // ESP_ERR_INVALID_STATE: already registered by the application
+    ESP_RETURN_ON_FALSE(ret == ESP_OK || ret == ESP_ERR_INVALID_STATE, ret, TAG, "Failed to register eventfd");
+    ret = ESP_OK;
+
+    struct coap_loop *loop = calloc(1, sizeof(struct coap_loop));
+    ESP_RETURN_ON_FALSE(loop, ESP_ERR_NO_MEM, TAG, "Failed to allocate loop");
+    loop->event_fd = eventfd(0, 0);
+    ESP_GOTO_ON_FALSE(loop->event_fd >= 0, ESP_FAIL, fail, TAG, "Failed to create eventfd");
+    loop->lock = xSemaphoreCreateRecursiveMutex();
+    loop->task_done = xSemaphoreCreateBinary();
+    loop->calls = xQueueCreate(config->max_calls, sizeof(loop_call_t));
+    ESP_GOTO_ON_FALSE(loop->lock && loop->task_done && loop->calls, ESP_ERR_NO_MEM, fail, TAG, "Failed to create loop objects");
+
+    if (config->task_stack_size) {
+        ESP_GOTO_ON_FALSE(xTaskCreatePinnedToCore(loop_task, "coap_loop", config->task_stack_size, loop,
+                          config->task_priority, &loop->task, config->task_core_id) == pdPASS,
+                          ESP_ERR_NO_MEM, fail, TAG, "Failed to create loop task");
+    }
+    *ret_loop = loop;
+    return ESP_OK;
+
+fail:
+    loop_free(loop);
+    return ret;
+}
+
+esp_err_t coap_loop_delete(coap_loop_handle_t loop)
+{
+    ESP_RETURN_ON_FALSE(loop, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    if (loop->task) {
+        loop->stop = true;
+        loop_wake(loop);
+        xSemaphoreTake(loop->task_done, portMAX_DELAY);
+    }
+    loop_free(loop);
+    return ESP_OK;
+}
+
+esp_err_t coap_loop_add_context(coap_loop_handle_t loop, coap_context_t *ctx)
+{
+    ESP_RETURN_ON_FALSE(loop && ctx, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    loop_ctx_t *entry = calloc(1, sizeof(loop_ctx_t));
+    ESP_RETURN_ON_FALSE(entry, ESP_ERR_NO_MEM, TAG, "Failed to allocate context entry");
+    entry->ctx = ctx;
+
+    loop_lock(loop);
+    entry->next = loop->ctxs;
+    loop->ctxs = entry;
+    loop_unlock(loop);
+    loop_wake(loop);
+    return ESP_OK;
+}
+
+esp_err_t coap_loop_remove_context(coap_loop_handle_t loop, coap_context_t *ctx)
+{
+    ESP_RETURN_ON_FALSE(loop && ctx, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    loop_lock(loop);
+    for (loop_ctx_t **entry = &loop->ctxs; *entry; entry = &(*entry)->next) {
+        if ((*entry)->ctx != ctx) {
+            continue;
+        }
+        if (loop->processing) {
+            // Called from a callback of the loop, unlinked when processing ends
+            (*entry)->ctx = NULL;
+            loop->purge = true;
+        } else {
+            loop_ctx_t *removed = *entry;
+            *entry = removed->next;
+            free(removed);
+        }
+        ret = ESP_OK;
+        break;
+    }
+    loop_unlock(loop);
+    return ret;
+}
+
+esp_err_t coap_loop_add_fd(coap_loop_handle_t loop, int fd, coap_loop_fd_cb_t cb, void *arg)
+{
+    ESP_RETURN_ON_FALSE(loop && fd >= 0 && cb, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    loop_fd_t *entry = calloc(1, sizeof(loop_fd_t));
+    ESP_RETURN_ON_FALSE(entry, ESP_ERR_NO_MEM, TAG, "Failed to allocate fd entry");
+    entry->fd = fd;
+    entry->cb = cb;
+    entry->arg = arg;
+
+    loop_lock(loop);
+    entry->next = loop->fds;
+    loop->fds = entry;
+    loop_unlock(loop);
+    loop_wake(loop);
+    return ESP_OK;
+}
+
+esp_err_t coap_loop_remove_fd(coap_loop_handle_t loop, int fd)
+{
+    ESP_RETURN_ON_FALSE(loop && fd >= 0, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    loop_lock(loop);
+    for (loop_fd_t **entry = &loop->fds; *entry; entry = &(*entry)->next) {
+        if ((*entry)->fd != fd) {
+            continue;
+        }
+        if (loop->processing) {
+            (*entry)->fd = -1;
+            loop->purge = true;
+        } else {
+            loop_fd_t *removed = *entry;
+            *entry = removed->next;
+            free(removed);
+        }
+        ret = ESP_OK;
+        break;
+    }
+    loop_unlock(loop);
+    return ret;
+}
+
+esp_err_t coap_loop_call(coap_loop_handle_t loop, coap_loop_call_cb_t cb, void *arg)
+{
+    ESP_RETURN_ON_FALSE(loop && cb, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    const loop_call_t call = {
+        .cb = cb,
+        .arg = arg,
+    };
+    ESP_RETURN_ON_FALSE(xQueueSend(loop->calls, &call, 0) == pdTRUE, ESP_ERR_NO_MEM, TAG, "Too many calls waiting");
+    loop_wake(loop);
+    return ESP_OK;
+}
+
+static inline void fd_add(int fd, fd_set *set, int *nfds)
+{
+    FD_SET(fd, set);
+    *nfds = MAX(*nfds, fd + 1);
+}
+
+uint32_t coap_loop_prepare_fds(coap_loop_handle_t loop, int *nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds)
+{
+    uint32_t timeout_ms = 0;
+
+    loop_lock(loop);
+    fd_add(loop->event_fd, readfds, nfds);
+    for (loop_fd_t *entry = loop->fds; entry; entry = entry->next) {
+        fd_add(entry->fd, readfds, nfds);
+    }
+    for (loop_ctx_t *entry = loop->ctxs; entry; entry = entry->next) {
+        coap_tick_t now;
+        coap_ticks(&now);
+        const unsigned int ctx_timeout_ms = coap_io_prepare_io(entry->ctx, entry->sockets, LOOP_MAX_SOCKETS,
+                                            &entry->num_sockets, now);
+        if (ctx_timeout_ms && (timeout_ms == 0 || ctx_timeout_ms < timeout_ms)) {
+            timeout_ms = ctx_timeout_ms;
+        }
+        for (unsigned int i = 0; i < entry->num_sockets; i++) {
+            const coap_socket_t *socket = entry->sockets[i];
+            if (socket->flags & COAP_SOCKET_WANT_READ) {
+                fd_add(socket->fd, readfds, nfds);
+            }
+            if (socket->flags & COAP_SOCKET_WANT_WRITE) {
+                fd_add(socket->fd, writefds, nfds);
+            }
+#if !COAP_DISABLE_TCP
+            if (socket->flags & COAP_SOCKET_WANT_ACCEPT) {
+                fd_add(socket->fd, readfds, nfds);
+            }
+            if (socket->flags & COAP_SOCKET_WANT_CONNECT) {
+                fd_add(socket->fd, writefds, nfds);
+                fd_add(socket->fd, exceptfds, nfds);
+            }
+#endif /* !COAP_DISABLE_TCP */
+        }
+    }
+    loop_unlock(loop);
+    return timeout_ms;
+}
+
+static void loop_purge(struct coap_loop *loop)
+{
+    for (loop_ctx_t **entry = &loop->ctxs; *entry;) {
+        if (!(*entry)->ctx) {
+            loop_ctx_t *removed = *entry;
+            *entry = removed->next;
+            free(removed);
+        } else {
+            entry = &(*entry)->next;
+        }
+    }
+    for (loop_fd_t **entry = &loop->fds; *entry;) {
+        if ((*entry)->fd < 0) {
+            loop_fd_t *removed = *entry;
+            *entry = removed->next;
+            free(removed);
+        } else {
+            entry = &(*entry)->next;
+        }
+    }
+    loop->purge = false;
+}
+
+void coap_loop_process_fds(coap_loop_handle_t loop, const fd_set *readfds, const fd_set *writefds, const fd_set *exceptfds)
+{
+    loop_lock(loop);
+    loop->processing = true;
+
+    // Flag the ready sockets before any callback can change the sessions
+    for (loop_ctx_t *entry = loop->ctxs; entry; entry = entry->next) {
+        for (unsigned int i = 0; i < entry->num_sockets; i++) {
+            coap_socket_t *socket = entry->sockets[i];
+            if ((socket->flags & COAP_SOCKET_WANT_READ) && FD_ISSET(socket->fd, readfds)) {
+                socket->flags |= COAP_SOCKET_CAN_READ;
+            }
+            if ((socket->flags & COAP_SOCKET_WANT_WRITE) && FD_ISSET(socket->fd, writefds)) {
+                socket->flags |= COAP_SOCKET_CAN_WRITE;
+            }
+#if !COAP_DISABLE_TCP
+            if ((socket->flags & COAP_SOCKET_WANT_ACCEPT) && FD_ISSET(socket->fd, readfds)) {
+                socket->flags |= COAP_SOCKET_CAN_ACCEPT;
+            }
+            if ((socket->flags & COAP_SOCKET_WANT_CONNECT) &&
+                    (FD_ISSET(socket->fd, writefds) || FD_ISSET(socket->fd, exceptfds))) {
+                socket->flags |= COAP_SOCKET_CAN_CONNECT;
+            }
+#endif /* !COAP_DISABLE_TCP */
+        }
+        // The sockets can be freed by the processing below
+        entry->num_sockets = 0;
+    }
+
+    if (FD_ISSET(loop->event_fd, readfds)) {
+        uint64_t count;
+        if (read(loop->event_fd, &count, sizeof(count)) != sizeof(count)) {
+            ESP_LOGW(TAG, "Failed to read eventfd");
+        }
+    }
+    loop_call_t call;
+    while (xQueueReceive(loop->calls, &call, 0) == pdTRUE) {
+        call.cb(call.arg);
+    }
+    for (loop_fd_t *entry = loop->fds; entry; entry = entry->next) {
+        if (entry->fd >= 0 && FD_ISSET(entry->fd, readfds)) {
+            entry->cb(entry->fd, entry->arg);
+        }
+    }
+    for (loop_ctx_t *entry = loop->ctxs; entry; entry = entry->next) {
+        if (entry->ctx) {
+            coap_tick_t now;
+            coap_ticks(&now);
+            coap_io_do_io(entry->ctx, now);
+        }
+    }
+
+    loop->processing = false;
+    if (loop->purge) {
+        loop_purge(loop);
+    }
+    loop_unlock(loop);
+}
+
+esp_err_t coap_loop_run_once(coap_loop_handle_t loop, uint32_t max_wait_ms)
+{
+    ESP_RETURN_ON_FALSE(loop, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    fd_set readfds, writefds, exceptfds;
+    FD_ZERO(&readfds);
+    FD_ZERO(&writefds);
+    FD_ZERO(&exceptfds);
+    int nfds = 0;
+
+    const uint32_t timeout_ms = coap_loop_prepare_fds(loop, &nfds, &readfds, &writefds, &exceptfds);
+    const uint32_t wait_ms = timeout_ms ? MIN(timeout_ms, max_wait_ms) : max_wait_ms;
+    struct timeval tv = {
+        .tv_sec = wait_ms / 1000,
+        .tv_usec = (wait_ms % 1000) * 1000,
+    };
+    const int result = select(nfds, &readfds, &writefds, &exceptfds, wait_ms == UINT32_MAX ? NULL : &tv);
+    if (result <= 0) {
+        // Timed out or failed, only the timeouts of the contexts are processed
+        FD_ZERO(&readfds);
+        FD_ZERO(&writefds);
+        FD_ZERO(&exceptfds);
+    }
+    coap_loop_process_fds(loop, &readfds, &writefds, &exceptfds);
+    if (result < 0 && errno != EINTR) {
+        ESP_LOGE(TAG, "select() failed: errno %d", errno);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,194 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "coap_mem_pool.h"
+
+#define POOL_BLOCK_SIZE(size)   (((size) + 7) & ~7)
+
+typedef struct {
+    coap_memory_tag_t type;
+    size_t block_size;
+    size_t count;
+    uint8_t *storage;
+    void *free_list;            // Free blocks, linked through their first word
+    coap_mem_pool_stats_t stats;
+} mem_pool_t;
+
+#define POOL_STORAGE(name)                                                                              \
+    static uint8_t s_##name##_storage[CONFIG_COAP_MEM_POOL_##name##_COUNT *                             \
+                                      POOL_BLOCK_SIZE(CONFIG_COAP_MEM_POOL_##name##_SIZE)] __attribute__((aligned(8)))
+
+#define POOL(tag, name) {                                               \
+    .type = tag,                                                        \
+    .block_size = POOL_BLOCK_SIZE(CONFIG_COAP_MEM_POOL_##name##_SIZE),  \
+    .count = CONFIG_COAP_MEM_POOL_##name##_COUNT,                       \
+    .storage = s_##name##_storage,                                      \
+}
+
+POOL_STORAGE(PDU);
+POOL_STORAGE(PDU_BUF);
+POOL_STORAGE(SESSION);
+POOL_STORAGE(NODE);
+POOL_STORAGE(STRING);
+
+static mem_pool_t s_pools[] = {
+    POOL(COAP_PDU, PDU),
+    POOL(COAP_PDU_BUF, PDU_BUF),
+    POOL(COAP_SESSION, SESSION),
+    POOL(COAP_NODE, NODE),
+    POOL(COAP_STRING, STRING),
+};
+
+static portMUX_TYPE s_pool_lock = portMUX_INITIALIZER_UNLOCKED;
+static bool s_pools_initialized;
+
+/* The heap allocator of libcoap, see --wrap in CMakeLists.txt */
+void *__real_coap_malloc_type(coap_memory_tag_t type, size_t size);
+void *__real_coap_realloc_type(coap_memory_tag_t type, void *p, size_t size);
+void __real_coap_free_type(coap_memory_tag_t type, void *p);
+
+/* Called with the lock held */
+static void pools_init(void)
+{
+    for (size_t i = 0; i < sizeof(s_pools) / sizeof(s_pools[0]); i++) {
+        mem_pool_t *pool = &s_pools[i];
+        pool->free_list = NULL;
+        for (size_t j = pool->count; j > 0; j--) {
+            void **block = (void **)(pool->storage + (j - 1) * pool->block_size);
+            *block = pool->free_list;
+            pool->free_list = block;
+        }
+        pool->stats.block_size = pool->block_size;
+        pool->stats.count = pool->count;
+    }
+    s_pools_initialized = true;
+}
+
+static mem_pool_t *pool_by_type(coap_memory_tag_t type)
+{
+    for (size_t i = 0; i < sizeof(s_pools) / sizeof(s_pools[0]); i++) {
+        if (s_pools[i].type == type && s_pools[i].count > 0) {
+            return &s_pools[i];
+        }
+    }
+    return NULL;
+}
+
+/* libcoap doesn't always free with the type it allocated with, so the pool is found by address */
+static mem_pool_t *pool_by_addr(const void *p)
+{
+    for (size_t i = 0; i < sizeof(s_pools) / sizeof(s_pools[0]); i++) {
+        const mem_pool_t *pool = &s_pools[i];
+        if ((const uint8_t *)p >= pool->storage && (const uint8_t *)p < pool->storage + pool->count * pool->block_size) {
+            return &s_pools[i];
+        }
+    }
+    return NULL;
+}
+
+void *__wrap_coap_malloc_type(coap_memory_tag_t type, size_t size)
+{
+    mem_pool_t *pool = pool_by_type(type);
+    if (pool) {
+        void **block = NULL;
+        portENTER_CRITICAL(&s_pool_lock);
+        if (!s_pools_initialized) {
+            pools_init();
+        }
+        if (size > pool->stats.largest) {
+            pool->stats.largest = size;
+        }
+        if (size <= pool->block_size && pool->free_list) {
+            block = pool->free_list;
+            pool->free_list = *block;
+            if (++pool->stats.used > pool->stats.peak) {
+                pool->stats.peak = pool->stats.used;
+            }
+        } else {
+            pool->stats.fallbacks++;
+        }
+        portEXIT_CRITICAL(&s_pool_lock);
+        if (block) {
+            return block;
+        }
+    }
+    return __real_coap_malloc_type(type, size);
+}
+
+void __wrap_coap_free_type(coap_memory_tag_t type, void *p)
+{
+    if (!p) {
+        return;
+    }
+    mem_pool_t *pool = pool_by_addr(p);
+    if (!pool) {
+        __real_coap_free_type(type, p);
+        return;
+    }
+    portENTER_CRITICAL(&s_pool_lock);
+    *(void **)p = pool->free_list;
+    pool->free_list = p;
+    pool->stats.used--;
+    portEXIT_CRITICAL(&s_pool_lock);
+}
+
+void *__wrap_coap_realloc_type(coap_memory_tag_t type, void *p, size_t size)
+{
+    if (!p) {
+        return __wrap_coap_malloc_type(type, size);
+    }
+    if (size == 0) {
+        __wrap_coap_free_type(type, p);
+        return NULL;
+    }
+    mem_pool_t *pool = pool_by_addr(p);
+    if (!pool) {
+        return __real_coap_realloc_type(type, p, size);
+    }
+    if (size <= pool->block_size) {
+        return p;
+    }
+    // Outgrown the block, move to a larger block from the heap
+    void *new_p = __wrap_coap_malloc_type(type, size);
+    if (new_p) {
+        memcpy(new_p, p, pool->block_size);
+        __wrap_coap_free_type(type, p);
+    }
+    return new_p;
+}
+
+esp_err_t coap_mem_pool_get_stats(coap_memory_tag_t type, coap_mem_pool_stats_t *stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    mem_pool_t *pool = pool_by_type(type);
+    if (!pool) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    portENTER_CRITICAL(&s_pool_lock);
+    if (!s_pools_initialized) {
+        pools_init();
+    }
+    *stats = pool->stats;
+    portEXIT_CRITICAL(&s_pool_lock);
+    return ESP_OK;
+}
+
+void coap_mem_pool_reset_stats(void)
+{
+    portENTER_CRITICAL(&s_pool_lock);
+    for (size_t i = 0; i < sizeof(s_pools) / sizeof(s_pools[0]); i++) {
+        coap_mem_pool_stats_t *stats = &s_pools[i].stats;
+        stats->peak = stats->used;
+        stats->fallbacks = 0;
+        stats->largest = 0;
+    }
+    portEXIT_CRITICAL(&s_pool_lock);
+}
@@ -26,9 +26,31 @@
 // Entry point of coremark benchmark
 extern int main(void);
 
+#if CONFIG_COREMARK_EXAMPLE_PLACEMENT_BENCHMARK
+// Runs coremark with the data in each memory available as heap
+extern void coremark_placement_benchmark(void);
+#endif
+
+#if CONFIG_COREMARK_MULTITHREAD
+// Number of coremark contexts running at the same time, one per core by default
+extern unsigned long default_num_contexts;
+#endif
+
 void app_main(void)
 {
+#if CONFIG_COREMARK_MULTITHREAD
+    // Run a single context first, the difference to the per-core scores below is the interference between the cores
+    unsigned long num_contexts = default_num_contexts;
+    default_num_contexts = 1;
+    printf("Running coremark on one core...\n");
+    main();
+    default_num_contexts = num_contexts;
+#endif
+#if CONFIG_COREMARK_EXAMPLE_PLACEMENT_BENCHMARK
+    coremark_placement_benchmark();
+#else
     printf("Running coremark...\n");
     main();
+#endif
     printf("CPU frequency: %d MHz\n", CPU_FREQ);
 }
@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include "coremark.h"
+#include "core_portme.h"
+#include "sdkconfig.h"
+#include "esp_heap_caps.h"
+#include "esp_private/esp_clk.h"
+
+/* Entry point of coremark benchmark */
+int main(void);
+
+typedef struct {
+    const char *name;   /* printed name of the memory */
+    ee_u32 caps;        /* heap capabilities of the data blocks */
+} data_location_t;
+
+static const data_location_t s_data_locations[] = {
+    { "DRAM", MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT },
+#if CONFIG_SPIRAM
+    { "PSRAM", MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT },
+#endif
+#if defined(MALLOC_CAP_RTCRAM) && !(CONFIG_IDF_TARGET_ESP32 && MULTITHREAD > 1)
+    /* Not on ESP32 with multiple contexts, the APP CPU can't access RTC fast memory */
+    { "RTC fast", MALLOC_CAP_RTCRAM },
+#endif
+};
+
+#define NUM_DATA_LOCATIONS (sizeof(s_data_locations) / sizeof(s_data_locations[0]))
+
+/* Function : coremark_placement_benchmark
+    Run CoreMark with the data blocks in each memory available as heap and print a table of the scores.
+
+    The code placement is selected at build time by CONFIG_COREMARK_CODE_IN_IRAM, build with both settings
+    to complete the table.
+*/
+void coremark_placement_benchmark(void)
+{
+    double scores[NUM_DATA_LOCATIONS];
+    bool available[NUM_DATA_LOCATIONS];
+    ee_u32 default_caps = coremark_data_caps;
+    ee_u32 num_contexts = default_num_contexts < MULTITHREAD ? default_num_contexts : MULTITHREAD;
+
+    for (size_t i = 0; i < NUM_DATA_LOCATIONS; i++) {
+        /* Each context allocates a data block */
+        available[i] = heap_caps_get_free_size(s_data_locations[i].caps) >= num_contexts * TOTAL_DATA_SIZE &&
+                       heap_caps_get_largest_free_block(s_data_locations[i].caps) >= TOTAL_DATA_SIZE;
+        if (!available[i]) {
+            continue;
+        }
+        ee_printf("Running coremark with data in %s...\n", s_data_locations[i].name);
+        coremark_data_caps = s_data_locations[i].caps;
+        main();
+        scores[i] = coremark_last_score;
+    }
+    coremark_data_caps = default_caps;
+
+    double mhz = esp_clk_cpu_freq() / 1000000.0;
+    ee_printf("CoreMark memory placement, code in %s, %d context(s), %d MHz:\n", MEM_LOCATION, (int)num_contexts, (int)mhz);
+    ee_printf("Data       Iterations/Sec  CoreMark/MHz\n");
+    for (size_t i = 0; i < NUM_DATA_LOCATIONS; i++) {
+        if (available[i]) {
+            ee_printf("%-9s  %14.3f  %12.3f\n", s_data_locations[i].name, scores[i], scores[i] / mhz);
+        } else {
+            ee_printf("%-9s  %14s  %12s\n", s_data_locations[i].name, "n/a", "n/a");
+        }
+    }
+}
@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "esp_timer.h"
+#include "esp_heap_caps.h"
 
 #if VALIDATION_RUN
 volatile ee_s32 seed1_volatile = 0x3415;
@@ -98,7 +99,83 @@ secs_ret time_in_secs(CORE_TICKS ticks)
     return retval;
 }
 
-ee_u32 default_num_contexts = 1;
+ee_u32 default_num_contexts = MULTITHREAD;
+
+ee_u32 coremark_data_caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+double coremark_last_score;
+
+#if (MEM_METHOD == MEM_MALLOC)
+/* Function : portable_malloc
+    Provide malloc() functionality in a platform specific way.
+*/
+void *portable_malloc(size_t size)
+{
+    return heap_caps_malloc(size, coremark_data_caps);
+}
+/* Function : portable_free
+    Provide free() functionality in a platform specific way.
+*/
+void portable_free(void *p)
+{
+    heap_caps_free(p);
+}
+#endif
+
+#if (MULTITHREAD > 1)
+#define CONTEXT_TASK_STACK_SIZE 4096
+
+/* Contexts started by core_start_parallel, reported by portable_fini */
+static core_results *s_contexts[MULTITHREAD];
+static ee_u32 s_num_contexts;
+
+static void context_task(void *arg)
+{
+    core_results *res = (core_results *)arg;
+    res->port.start_us = esp_timer_get_time();
+    iterate(res);
+    res->port.stop_us = esp_timer_get_time();
+    xSemaphoreGive(res->port.done);
+    vTaskDelete(NULL);
+}
+
+/* Function : core_start_parallel
+    Start iterating the context in a task pinned to the next core.
+
+    The task has the priority of the calling task, so it doesn't delay starting the other contexts.
+*/
+ee_u8 core_start_parallel(core_results *res)
+{
+    res->port.core_id = s_num_contexts % SOC_CPU_CORES_NUM;
+    res->port.done = xSemaphoreCreateBinary();
+    if (!res->port.done) {
+        ee_printf("ERROR! No memory for context %d\n", (int)s_num_contexts);
+        return 1;
+    }
+    if (xTaskCreatePinnedToCore(context_task, "coremark", CONTEXT_TASK_STACK_SIZE, res, uxTaskPriorityGet(NULL),
+                                NULL, res->port.core_id) != pdPASS) {
+        ee_printf("ERROR! Failed to create task of context %d\n", (int)s_num_contexts);
+        vSemaphoreDelete(res->port.done);
+        res->port.done = NULL;
+        return 1;
+    }
+    s_contexts[s_num_contexts++] = res;
+    return 0;
+}
+
+/* Function : core_stop_parallel
+    Wait for the context to finish iterating.
+*/
+ee_u8 core_stop_parallel(core_results *res)
+{
+    if (!res->port.done) {
+        return 1;
+    }
+    xSemaphoreTake(res->port.done, portMAX_DELAY);
+    vSemaphoreDelete(res->port.done);
+    res->port.done = NULL;
+    return 0;
+}
+#endif
 
 /* Function : portable_init
     Target specific initialization code
@@ -112,6 +189,9 @@ void portable_init(core_portable *p, int *argc, char *argv[])
     if (sizeof(ee_u32) != 4) {
         ee_printf("ERROR! Please define ee_u32 to a 32b unsigned type!\n");
     }
+#if (MULTITHREAD > 1)
+    s_num_contexts = 0;
+#endif
     p->portable_id = 1;
 }
 /* Function : portable_fini
@@ -119,5 +199,19 @@ void portable_init(core_portable *p, int *argc, char *argv[])
 */
 void portable_fini(core_portable *p)
 {
+    /* Called with the port of the first context */
+    const core_results *first = (const core_results *)((const char *)p - offsetof(core_results, port));
+    ee_u32 iterations = first->iterations;
+#if (MULTITHREAD > 1)
+    /* Iterations/Sec reported by CoreMark are the total of all contexts */
+    iterations = 0;
+    for (ee_u32 i = 0; i < s_num_contexts; i++) {
+        const core_results *res = s_contexts[i];
+        double secs = (res->port.stop_us - res->port.start_us) / 1000000.0;
+        ee_printf("[%d]Iterations/Sec: %f (core %d)\n", (int)i, res->iterations / secs, res->port.core_id);
+        iterations += res->iterations;
+    }
+#endif
+    coremark_last_score = iterations / time_in_secs(get_time());
     p->portable_id = 0;
 }
@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdio>
+#include <functional>
+
+#include <eigen3/Eigen/Eigen>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "esp_idf_version.h"
+#include "sdkconfig.h"
+#include "ccomp_timer.h"
+
+extern "C" void app_main(void);
+
+/* Minimum duration of the runs of each case, in microseconds */
+#define BENCH_MIN_TIME_US   200000
+
+/* Sizes of the dynamic-size matrices */
+static const int s_sizes[] = { 4, 8, 16, 32 };
+
+/* Keeps the results alive, so the computations aren't optimized out */
+static volatile double s_sink;
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
+#define BENCH_HEAP_PEAK_SUPPORTED 1
+#else
+#define BENCH_HEAP_PEAK_SUPPORTED 0
+#endif
+
+static void bench_run(const char *name, const char *scalar, int size, const std::function<double()> &fn)
+{
+    /* Warm up the caches and allocate the lazily allocated memory */
+    s_sink = fn();
+
+#if BENCH_HEAP_PEAK_SUPPORTED
+    size_t free_before = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    heap_caps_monitor_local_minimum_free_size_start();
+#endif
+    int runs = 0;
+    int64_t time = 0;
+    ccomp_timer_start();
+    do {
+        s_sink = fn();
+        runs++;
+        time = ccomp_timer_get_time();
+    } while (time < BENCH_MIN_TIME_US);
+    time = ccomp_timer_stop();
+#if BENCH_HEAP_PEAK_SUPPORTED
+    size_t peak = free_before - heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    heap_caps_monitor_local_minimum_free_size_stop();
+    printf("%-16s %-7s %4d %12.1f %10u\n", name, scalar, size, (double)time / runs, (unsigned)peak);
+#else
+    printf("%-16s %-7s %4d %12.1f %10s\n", name, scalar, size, (double)time / runs, "n/a");
+#endif
+
+    /* Let the idle task run, so that the task watchdog isn't triggered by long cases */
+    vTaskDelay(1);
+}
+
+/* Decompositions and products of dynamic-size matrices */
+template <typename S>
+static void bench_dynamic(const char *scalar)
+{
+    using Matrix = Eigen::Matrix<S, Eigen::Dynamic, Eigen::Dynamic>;
+    using Vector = Eigen::Matrix<S, Eigen::Dynamic, 1>;
+
+    for (int n : s_sizes) {
+        Matrix a = Matrix::Random(n, n);
+        Matrix b = Matrix::Random(n, n);
+        Vector v = Vector::Random(n);
+        /* Least squares fit of 2n observations */
+        Matrix obs = Matrix::Random(2 * n, n);
+        Vector y = Vector::Random(2 * n);
+
+        bench_run("gemm", scalar, n, [&]() {
+            Matrix c = a * b;
+            return (double)c(0, 0);
+        });
+        bench_run("lu_solve", scalar, n, [&]() {
+            Eigen::PartialPivLU<Matrix> lu(a);
+            Vector x = lu.solve(v);
+            return (double)x(0);
+        });
+        bench_run("llt_solve", scalar, n, [&]() {
+            Matrix spd = a * a.transpose() + Matrix::Identity(n, n);
+            Eigen::LLT<Matrix> llt(spd);
+            Vector x = llt.solve(v);
+            return (double)x(0);
+        });
+        bench_run("qr_lstsq", scalar, n, [&]() {
+            Vector x = obs.householderQr().solve(y);
+            return (double)x(0);
+        });
+        bench_run("jacobi_svd", scalar, n, [&]() {
+            Eigen::JacobiSVD<Matrix> svd(a, Eigen::ComputeThinU | Eigen::ComputeThinV);
+            return (double)svd.singularValues()(0);
+        });
+        bench_run("bdc_svd", scalar, n, [&]() {
+            Eigen::BDCSVD<Matrix> svd(a, Eigen::ComputeThinU | Eigen::ComputeThinV);
+            return (double)svd.singularValues()(0);
+        });
+    }
+}
+
+/* Small fixed-size operations, e.g. of a Kalman filter, without heap allocation */
+template <typename S, int N>
+static void bench_fixed(const char *scalar)
+{
+    using Matrix = Eigen::Matrix<S, N, N>;
+    using Vector = Eigen::Matrix<S, N, 1>;
+
+    Matrix a = Matrix::Random();
+    Matrix b = Matrix::Random();
+    Vector v = Vector::Random();
+
+    bench_run("fixed_gemm", scalar, N, [&]() {
+        Matrix c = a * b;
+        return (double)c(0, 0);
+    });
+    bench_run("fixed_inverse", scalar, N, [&]() {
+        Matrix c = a.inverse();
+        return (double)c(0, 0);
+    });
+    bench_run("fixed_kalman", scalar, N, [&]() {
+        /* Covariance prediction and update of a filter with N states, N measurements */
+        Matrix p = a * b * a.transpose() + Matrix::Identity();
+        Matrix s = p + Matrix::Identity();
+        Matrix k = p * s.inverse();
+        Vector x = k * v;
+        return (double)x(0);
+    });
+}
+
+void app_main(void)
+{
+    printf("Eigen benchmark, %s, optimization: %s\n", CONFIG_IDF_TARGET,
+#if CONFIG_COMPILER_OPTIMIZATION_PERF
+           "-O2"
+#elif CONFIG_COMPILER_OPTIMIZATION_SIZE
+           "-Os"
+#else
+           "-Og or -O0"
+#endif
+          );
+    printf("%-16s %-7s %4s %12s %10s\n", "case", "scalar", "size", "time [us]", "heap peak");
+
+    bench_fixed<float, 3>("float");
+    bench_fixed<float, 4>("float");
+    bench_fixed<float, 6>("float");
+    bench_fixed<double, 3>("double");
+    bench_fixed<double, 4>("double");
+    bench_fixed<double, 6>("double");
+    bench_dynamic<float>("float");
+    bench_dynamic<double>("double");
+
+    printf("Benchmark finished\n");
+}
@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "sdkconfig.h"
+#include "esp_heap_caps.h"
+#include "esp_idf_version.h"
+#include <eigen3/Eigen/Core>
+#if CONFIG_EIGEN_USE_ESP_DSP
+#include "dspm_mult.h"
+#endif
+
+namespace esp_eigen {
+
+/**
+ * @brief Allocator placing the blocks in internal RAM or PSRAM depending on their size
+ *
+ * With PSRAM enabled, blocks of CONFIG_EIGEN_PSRAM_THRESHOLD bytes or more are allocated in PSRAM,
+ * so that large matrices do not exhaust internal RAM, and smaller ones stay in the faster internal RAM.
+ * If the preferred memory is full, the other one is used. Without PSRAM, all blocks are in internal RAM.
+ * It replaces Eigen::aligned_allocator in standard containers of Eigen objects:
+ *
+ * \code{.cpp}
+ * std::vector<Eigen::Matrix4f, esp_eigen::allocator<Eigen::Matrix4f>> poses;
+ * \endcode
+ *
+ * @tparam T Type of the allocated objects
+ */
+template <class T>
+class allocator {
+public:
+    using value_type = T;
+
+    allocator() noexcept = default;
+    template <class U> allocator(const allocator<U> &) noexcept {}
+
+    T *allocate(std::size_t n)
+    {
+        const std::size_t size = n * sizeof(T);
+        const std::size_t align = alignof(T) > sizeof(void *) ? alignof(T) : sizeof(void *);
+        const uint32_t internal = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+#ifdef CONFIG_EIGEN_PSRAM_THRESHOLD
+        const uint32_t psram = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+        const bool large = size >= CONFIG_EIGEN_PSRAM_THRESHOLD;
+        void *p = heap_caps_aligned_alloc(align, size, large ? psram : internal);
+        if (p == nullptr) {
+            p = heap_caps_aligned_alloc(align, size, large ? internal : psram);
+        }
+#else
+        void *p = heap_caps_aligned_alloc(align, size, internal);
+#endif
+        if (p == nullptr) {
+            Eigen::internal::throw_std_bad_alloc();
+        }
+        return static_cast<T *>(p);
+    }
+
+    void deallocate(T *p, std::size_t) noexcept
+    {
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+        heap_caps_free(p);
+#else
+        heap_caps_aligned_free(p);
+#endif
+    }
+};
+
+template <class T, class U>
+bool operator==(const allocator<T> &, const allocator<U> &) noexcept
+{
+    return true;
+}
+template <class T, class U>
+bool operator!=(const allocator<T> &, const allocator<U> &) noexcept
+{
+    return false;
+}
+
+/**
+ * @brief Product of float matrices, c = a * b
+ *
+ * With CONFIG_EIGEN_USE_ESP_DSP, products whose dimensions are all at least CONFIG_EIGEN_ESP_DSP_MIN_SIZE
+ * are computed by dspm_mult_f32() of esp-dsp, optimized for the FPU of ESP32 and ESP32-S3.
+ * Otherwise, and if an operand is not contiguous or `c` overlaps an operand, Eigen computes the product.
+ *
+ * \code{.cpp}
+ * Eigen::MatrixXf c;
+ * esp_eigen::multiply(a, b, c);       // instead of c = a * b
+ * \endcode
+ *
+ * @param a Left operand
+ * @param b Right operand, b.rows() must be equal to a.cols()
+ * @param c Result, resized to a.rows() x b.cols(). Column-major float matrix, e.g. Eigen::MatrixXf
+ */
+template <typename Derived>
+void multiply(const Eigen::Ref<const Eigen::MatrixXf> &a, const Eigen::Ref<const Eigen::MatrixXf> &b,
+              Eigen::PlainObjectBase<Derived> &c)
+{
+    static_assert(std::is_same<typename Derived::Scalar, float>::value, "esp_eigen::multiply() result must be a float matrix");
+    static_assert(!Derived::IsRowMajor, "esp_eigen::multiply() result must be column-major");
+    eigen_assert(a.cols() == b.rows());
+#if CONFIG_EIGEN_USE_ESP_DSP
+    const Eigen::Index m = a.rows(), k = a.cols(), n = b.cols();
+    if (m >= CONFIG_EIGEN_ESP_DSP_MIN_SIZE && k >= CONFIG_EIGEN_ESP_DSP_MIN_SIZE && n >= CONFIG_EIGEN_ESP_DSP_MIN_SIZE &&
+            a.outerStride() == m && b.outerStride() == k) {
+        /* Checked before resizing, which would free an operand stored in c */
+        const float *c_end = c.data() + c.size();
+        const bool overlap = (c.data() < a.data() + m * k && a.data() < c_end) ||
+                             (c.data() < b.data() + k * n && b.data() < c_end);
+        if (!overlap) {
+            c.resize(m, n);
+            /* Column-major c = a * b is row-major c^T = b^T * a^T */
+            if (dspm_mult_f32(b.data(), a.data(), c.data(), n, k, m) == ESP_OK) {
+                return;
+            }
+        }
+    }
+#endif
+    c = a * b;
+}
+
+#if defined(EIGEN_RUNTIME_NO_MALLOC)
+/**
+ * @brief Scope in which Eigen must not allocate heap memory
+ *
+ * Available with CONFIG_EIGEN_MALLOC_CHECK_RUNTIME. Any heap allocation made by Eigen while the object
+ * exists fails an assertion, e.g. to verify that a filter made of fixed-size matrices does not allocate:
+ *
+ * \code{.cpp}
+ * {
+ *     esp_eigen::no_malloc_scope no_malloc;
+ *     kalman_update(state, measurement);
+ * }
+ * \endcode
+ *
+ * The check applies to all tasks, as the flag of Eigen is global.
+ */
+class no_malloc_scope {
+public:
+    no_malloc_scope() : previous(Eigen::internal::is_malloc_allowed())
+    {
+        Eigen::internal::set_is_malloc_allowed(false);
+    }
+    ~no_malloc_scope()
+    {
+        Eigen::internal::set_is_malloc_allowed(previous);
+    }
+    no_malloc_scope(const no_malloc_scope &) = delete;
+    no_malloc_scope &operator=(const no_malloc_scope &) = delete;
+
+private:
+    bool previous;
+};
+#endif
+
+} // namespace esp_eigen
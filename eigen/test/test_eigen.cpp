@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_eigen.hpp"
+#include "unity.h"
+
+static void test_multiply(Eigen::Index m, Eigen::Index k, Eigen::Index n)
+{
+    const Eigen::MatrixXf a = Eigen::MatrixXf::Random(m, k);
+    const Eigen::MatrixXf b = Eigen::MatrixXf::Random(k, n);
+    const Eigen::MatrixXf expected = a * b;
+
+    Eigen::MatrixXf c;
+    esp_eigen::multiply(a, b, c);
+    TEST_ASSERT_EQUAL(m, c.rows());
+    TEST_ASSERT_EQUAL(n, c.cols());
+    TEST_ASSERT_TRUE(c.isApprox(expected, 1e-5f));
+}
+
+TEST_CASE("multiply matches Eigen product", "[eigen]")
+{
+    // Below and above CONFIG_EIGEN_ESP_DSP_MIN_SIZE, square and rectangular
+    test_multiply(3, 3, 3);
+    test_multiply(2, 5, 7);
+    test_multiply(16, 16, 16);
+    test_multiply(9, 20, 12);
+    test_multiply(24, 10, 1);
+}
+
+TEST_CASE("multiply with non-contiguous operands and fixed-size result", "[eigen]")
+{
+    const Eigen::MatrixXf a = Eigen::MatrixXf::Random(20, 20);
+    const Eigen::MatrixXf b = Eigen::MatrixXf::Random(20, 20);
+
+    // Blocks of a larger matrix have an outer stride different from their number of rows
+    Eigen::MatrixXf c;
+    esp_eigen::multiply(a.block(2, 2, 12, 10), b.block(0, 4, 10, 14), c);
+    TEST_ASSERT_TRUE(c.isApprox(a.block(2, 2, 12, 10) * b.block(0, 4, 10, 14), 1e-5f));
+
+    const Eigen::MatrixXf a2 = a.topLeftCorner(12, 16);
+    const Eigen::MatrixXf b2 = b.topLeftCorner(16, 12);
+    Eigen::Matrix<float, 12, 12> fixed;
+    esp_eigen::multiply(a2, b2, fixed);
+    TEST_ASSERT_TRUE(fixed.isApprox(a2 * b2, 1e-5f));
+}
+
+TEST_CASE("multiply with result aliasing an operand", "[eigen]")
+{
+    Eigen::MatrixXf a = Eigen::MatrixXf::Random(16, 16);
+    const Eigen::MatrixXf b = Eigen::MatrixXf::Random(16, 16);
+    const Eigen::MatrixXf expected = a * b;
+
+    esp_eigen::multiply(a, b, a);
+    TEST_ASSERT_TRUE(a.isApprox(expected, 1e-5f));
+}
@@ -36,6 +36,15 @@
 #define BUFFSIZE 1024
 #define PATCH_HEADER_SIZE 64
 #define DIGEST_SIZE 32
+#define CHECKPOINT_NVS_NAMESPACE "delta_ota"
+#define CHECKPOINT_NVS_KEY "checkpoint"
+
+// esp_ota_resume() is needed to continue writing a partially written partition
+#if (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)) && CONFIG_EXAMPLE_CHECKPOINT_INTERVAL > 0
+#define EXAMPLE_RESUME_SUPPORTED 1
+#else
+#define EXAMPLE_RESUME_SUPPORTED 0
+#endif
 static uint32_t esp_delta_ota_magic = 0xfccdde10;
 
 static const char *TAG = "https_delta_ota_example";
@@ -49,6 +58,8 @@ static esp_ota_handle_t ota_handle;
 
 #define IMG_HEADER_LEN sizeof(esp_image_header_t)
 
+static bool chip_id_verified = false;
+
 static bool verify_chip_id(void *bin_header_data)
 {
     esp_image_header_t *header = (esp_image_header_t *)bin_header_data;
@@ -70,7 +81,6 @@ static esp_err_t write_cb(const uint8_t *buf_p, size_t size)
     }
 
     static char header_data[IMG_HEADER_LEN];
-    static bool chip_id_verified = false;
     static int header_data_read = 0;
     int index = 0;
 
@@ -106,6 +116,46 @@ static esp_err_t read_cb(uint8_t *buf_p, size_t size, int src_offset)
     return esp_partition_read(current_partition, src_offset, buf_p, size);
 }
 
+#if EXAMPLE_RESUME_SUPPORTED
+static esp_err_t checkpoint_save_cb(const void *data, size_t size, void *user_data)
+{
+    nvs_handle_t nvs = *(nvs_handle_t *)user_data;
+    esp_err_t err = nvs_set_blob(nvs, CHECKPOINT_NVS_KEY, data, size);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return nvs_commit(nvs);
+}
+
+/* Restores the delta OTA state from the last checkpoint, if any, and reopens the
+ * destination partition at the point where it was interrupted. */
+static bool resume_from_checkpoint(nvs_handle_t nvs, esp_delta_ota_handle_t handle, esp_delta_ota_checkpoint_info_t *info)
+{
+    size_t size = 0;
+    if (nvs_get_blob(nvs, CHECKPOINT_NVS_KEY, NULL, &size) != ESP_OK || size == 0) {
+        return false;
+    }
+    void *data = malloc(size);
+    if (!data) {
+        return false;
+    }
+    bool resumed = false;
+    if (nvs_get_blob(nvs, CHECKPOINT_NVS_KEY, data, &size) == ESP_OK &&
+            esp_delta_ota_resume(handle, data, size, info) == ESP_OK &&
+            esp_ota_resume(destination_partition, OTA_SIZE_UNKNOWN, info->output_offset, &ota_handle) == ESP_OK) {
+        // The image header is at the start of the partition and was verified before the checkpoint
+        chip_id_verified = true;
+        resumed = true;
+    }
+    free(data);
+    if (!resumed) {
+        ESP_LOGW(TAG, "Unable to resume from checkpoint, starting over");
+        nvs_erase_key(nvs, CHECKPOINT_NVS_KEY);
+    }
+    return resumed;
+}
+#endif
+
 static void reboot(void)
 {
     for (int i = 5; i > 0; i--) {
@@ -156,40 +206,27 @@ static void ota_example_task(void *pvParameter)
     config.skip_cert_common_name_check = true;
 #endif
 
-    esp_http_client_handle_t client = esp_http_client_init(&config);
-    if (client == NULL) {
-        ESP_LOGE(TAG, "Failed to initialise HTTP connection");
-        vTaskDelete(NULL);
-    }
-    err = esp_http_client_open(client, 0);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to open HTTP connection: %s", esp_err_to_name(err));
-        esp_http_client_cleanup(client);
-        vTaskSuspend(NULL);
-    }
-    esp_http_client_fetch_headers(client);
+    esp_http_client_handle_t client = NULL;
+    esp_delta_ota_handle_t handle = NULL;
 
     current_partition = esp_ota_get_running_partition();
     destination_partition = esp_ota_get_next_update_partition(NULL);
 
     if (current_partition == NULL || destination_partition == NULL) {
         ESP_LOGE(TAG, "Error getting partition information");
-        goto error;
+        vTaskDelete(NULL);
     }
 
     if (current_partition->subtype >= ESP_PARTITION_SUBTYPE_APP_OTA_MAX ||
             destination_partition->subtype >= ESP_PARTITION_SUBTYPE_APP_OTA_MAX) {
-        goto error;
+        vTaskDelete(NULL);
     }
 
-    err = esp_ota_begin(destination_partition, OTA_SIZE_UNKNOWN, &(ota_handle));
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "esp_ota_begin failed: %s", esp_err_to_name(err));
-        goto error;
-    }
     esp_delta_ota_cfg_t cfg = {
         .read_cb = &read_cb,
+        .pipeline = ESP_DELTA_OTA_PIPELINE_DEFAULT(),
     };
+    cfg.pipeline.ring_buf_size = CONFIG_EXAMPLE_PIPELINE_BUF_SIZE;
 
 #if (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0))
     char *user_data = "https_delta_ota";
@@ -199,20 +236,70 @@ static void ota_example_task(void *pvParameter)
     cfg.write_cb = &write_cb;
 #endif
 
-    esp_delta_ota_handle_t handle = esp_delta_ota_init(&cfg);
+    bool resumed = false;
+    esp_delta_ota_checkpoint_info_t resume_info = { 0 };
+#if EXAMPLE_RESUME_SUPPORTED
+    static nvs_handle_t nvs;
+    if (nvs_open(CHECKPOINT_NVS_NAMESPACE, NVS_READWRITE, &nvs) == ESP_OK) {
+        cfg.checkpoint.interval = CONFIG_EXAMPLE_CHECKPOINT_INTERVAL;
+        cfg.checkpoint.save_cb = &checkpoint_save_cb;
+        cfg.checkpoint.user_data = &nvs;
+    }
+#endif
+
+    handle = esp_delta_ota_init(&cfg);
     if (handle == NULL) {
         ESP_LOGE(TAG, "delta_ota_set_cfg failed");
-        goto error;
+        vTaskDelete(NULL);
     }
 
-    // Read size equal to patch header to verify the header
-    int data_read = esp_http_client_read(client, ota_write_data, PATCH_HEADER_SIZE);
-    if (data_read != PATCH_HEADER_SIZE) {
-        ESP_LOGE(TAG, "Patch Header not received");
-        goto error;
+#if EXAMPLE_RESUME_SUPPORTED
+    if (cfg.checkpoint.save_cb) {
+        resumed = resume_from_checkpoint(nvs, handle, &resume_info);
     }
-    if (!verify_patch_header(ota_write_data)) {
-        ESP_LOGE(TAG, "Patch Header verification failed");
+#endif
+
+    client = esp_http_client_init(&config);
+    if (client == NULL) {
+        ESP_LOGE(TAG, "Failed to initialise HTTP connection");
+        esp_delta_ota_deinit(handle);
+        vTaskDelete(NULL);
+    }
+    if (resumed) {
+        // Skip the patch header and the part of the patch that was already applied
+        char range[32];
+        snprintf(range, sizeof(range), "bytes=%u-", (unsigned)(PATCH_HEADER_SIZE + resume_info.patch_offset));
+        esp_http_client_set_header(client, "Range", range);
+        ESP_LOGI(TAG, "Resuming update, requesting %s", range);
+    }
+    err = esp_http_client_open(client, 0);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to open HTTP connection: %s", esp_err_to_name(err));
+        esp_http_client_cleanup(client);
+        esp_delta_ota_deinit(handle);
+        vTaskSuspend(NULL);
+    }
+    esp_http_client_fetch_headers(client);
+
+    if (!resumed) {
+        err = esp_ota_begin(destination_partition, OTA_SIZE_UNKNOWN, &(ota_handle));
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "esp_ota_begin failed: %s", esp_err_to_name(err));
+            goto error;
+        }
+
+        // Read size equal to patch header to verify the header
+        int data_read = esp_http_client_read(client, ota_write_data, PATCH_HEADER_SIZE);
+        if (data_read != PATCH_HEADER_SIZE) {
+            ESP_LOGE(TAG, "Patch Header not received");
+            goto error;
+        }
+        if (!verify_patch_header(ota_write_data)) {
+            ESP_LOGE(TAG, "Patch Header verification failed");
+            goto error;
+        }
+    } else if (esp_http_client_get_status_code(client) != 206) {
+        ESP_LOGE(TAG, "Server doesn't support range requests");
         goto error;
     }
 
@@ -253,9 +340,16 @@ static void ota_example_task(void *pvParameter)
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "esp_ota_set_boot_partition() failed : %s", esp_err_to_name(err));
     }
+#if EXAMPLE_RESUME_SUPPORTED
+    if (cfg.checkpoint.save_cb) {
+        nvs_erase_key(nvs, CHECKPOINT_NVS_KEY);
+        nvs_commit(nvs);
+    }
+#endif
     http_cleanup(client);
     reboot();
 error:
+    esp_delta_ota_deinit(handle);
     http_cleanup(client);
     vTaskDelete(NULL);
 }
@@ -6,7 +6,11 @@
 
 #pragma once
 
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
 #include "esp_err.h"
+#include "esp_partition.h"
+#include "esp_encrypted_img.h"
 #include <esp_idf_version.h>
 
 #ifdef __cplusplus
@@ -19,6 +23,46 @@ extern "C" {
 #define DEPRECATED_ATTRIBUTE
 #endif
 
+/**
+ * @brief Default size of the buffer used to coalesce writes to the write callback
+ *
+ * Matches the flash sector size, so that with an aligned destination every write
+ * except the final one covers whole sectors.
+ */
+#define ESP_DELTA_OTA_DEFAULT_WRITE_BUF_SIZE    4096
+
+/**
+ * @brief Suggested size for esp_delta_ota_cfg_t::read_cache_size
+ */
+#define ESP_DELTA_OTA_DEFAULT_READ_CACHE_SIZE   4096
+
+/**
+ * @brief Default stack size of the patch task used in pipelined mode
+ */
+#define ESP_DELTA_OTA_DEFAULT_PIPELINE_TASK_STACK_SIZE  4096
+
+/**
+ * @brief Default size of the ring buffer used in pipelined mode
+ */
+#define ESP_DELTA_OTA_DEFAULT_PIPELINE_RING_BUF_SIZE    8192
+
+/**
+ * @brief Default configuration of the pipelined mode, for esp_delta_ota_cfg_t::pipeline
+ *
+ * The patch task runs on any core, at the priority of the task calling esp_delta_ota_init().
+ */
+#define ESP_DELTA_OTA_PIPELINE_DEFAULT() {                          \
+    .ring_buf_size = ESP_DELTA_OTA_DEFAULT_PIPELINE_RING_BUF_SIZE,  \
+    .task_stack_size = 0,                                           \
+    .task_priority = 0,                                             \
+    .task_core_id = tskNO_AFFINITY,                                 \
+}
+
+/**
+ * @brief Size of the blocks esp_delta_ota_feed_encrypted_patch() decrypts at a time, see CONFIG_ESP_DELTA_OTA_DECRYPT_BLOCK_SIZE
+ */
+#define ESP_DELTA_OTA_DECRYPT_BLOCK_SIZE    CONFIG_ESP_DELTA_OTA_DECRYPT_BLOCK_SIZE
+
 typedef void *esp_delta_ota_handle_t;
 
 // Callback for reading the source data
@@ -28,17 +72,71 @@ typedef esp_err_t (*src_read_cb_t)(uint8_t *buf_p, size_t size, int src_offset);
 typedef esp_err_t (*merged_stream_write_cb_t)(const uint8_t *buf_p, size_t size);
 typedef esp_err_t (*merged_stream_write_cb_with_user_ctx_t)(const uint8_t *buf_p, size_t size, void *user_data);
 
+// Callback for persisting a checkpoint, e.g. to NVS. Must not return before the data is stored.
+typedef esp_err_t (*esp_delta_ota_checkpoint_cb_t)(const void *data, size_t size, void *user_data);
+
 typedef struct esp_delta_ota_cfg {
     void *user_data;              /*!< User Data */
-    src_read_cb_t read_cb;        /*!< Read Callback */
+    src_read_cb_t read_cb;        /*!< Read Callback. May be NULL if src_partition is set */
     union {
         merged_stream_write_cb_with_user_ctx_t write_cb_with_user_data;     /*!< Write Callback with user data */
         merged_stream_write_cb_t write_cb DEPRECATED_ATTRIBUTE;             /*!< Write Callback */
     };
+    size_t write_buf_size;        /*!< Size of the write coalescing buffer. The write callback is only called with
+                                       multiples of this size, except for the final tail passed from
+                                       esp_delta_ota_finalize(). 0 selects ESP_DELTA_OTA_DEFAULT_WRITE_BUF_SIZE */
+    size_t read_cache_size;       /*!< Size of the read-ahead cache over the source image. Small reads issued by
+                                       detools are served from this window instead of separate read_cb calls.
+                                       0 disables the cache */
+    const esp_partition_t *src_partition; /*!< Source partition, used when read_cb is NULL. The partition is memory-mapped
+                                               so that source reads go through the flash cache; if mapping fails,
+                                               it is read with esp_partition_read() through the read cache instead */
+    struct {
+        size_t ring_buf_size;     /*!< Size of the ring buffer between esp_delta_ota_feed_patch() and the patch task.
+                                       0 applies the patch synchronously in esp_delta_ota_feed_patch() */
+        uint32_t task_stack_size; /*!< Stack size of the patch task. 0 selects ESP_DELTA_OTA_DEFAULT_PIPELINE_TASK_STACK_SIZE */
+        unsigned task_priority;   /*!< Priority of the patch task. 0 selects the priority of the task calling esp_delta_ota_init() */
+        int task_core_id;         /*!< Core the patch task is pinned to, or tskNO_AFFINITY or a negative value for
+                                       any core. Note that 0 pins the task to core 0: start from
+                                       ESP_DELTA_OTA_PIPELINE_DEFAULT() */
+    } pipeline;                   /*!< Pipelined mode: the patch is applied in a separate task, so that downloading the
+                                       patch and writing the new image overlap. The read and write callbacks are then
+                                       called from that task */
+    struct {
+        size_t interval;          /*!< Number of patch bytes between checkpoints. 0 disables checkpointing */
+        esp_delta_ota_checkpoint_cb_t save_cb; /*!< Called with the serialized state once every `interval` patch bytes.
+                                                    The state is only consistent if all data passed to the write
+                                                    callback so far has been persisted */
+        void *user_data;          /*!< User data passed to save_cb */
+    } checkpoint;                 /*!< Checkpoints for resuming an interrupted update with esp_delta_ota_resume() */
 } esp_delta_ota_cfg_t;
 
+/**
+ * @brief Position of the update restored by esp_delta_ota_resume()
+ */
+typedef struct {
+    size_t patch_offset;          /*!< Number of patch bytes already applied. Feeding continues from this offset */
+    size_t output_offset;         /*!< Number of bytes already passed to the write callback. The destination must
+                                       continue from this offset */
+} esp_delta_ota_checkpoint_info_t;
+
 #undef DEPRECATED_ATTRIBUTE
 
+/**
+ * @brief Statistics of a patch application, see CONFIG_ESP_DELTA_OTA_ENABLE_STATS
+ */
+typedef struct {
+    uint64_t bytes_in;            /*!< Patch bytes applied */
+    uint64_t bytes_out;           /*!< Bytes passed to the write callback */
+    uint32_t read_calls;          /*!< Source reads issued by detools */
+    uint32_t src_read_calls;      /*!< Reads from read_cb or the source partition, i.e. ones not served by the read cache or mmap */
+    int64_t read_time_us;         /*!< Total time spent reading the source */
+    uint32_t write_calls;         /*!< Calls of the write callback */
+    int64_t write_time_us;        /*!< Total time spent in the write callback */
+    int64_t decompress_time_us;   /*!< Time spent in detools itself (decompression and patching), excluding reads and writes */
+    size_t min_free_heap;         /*!< Lowest free heap size observed after each applied chunk */
+} esp_delta_ota_stats_t;
+
 /**
  * @brief Initializes the delta OTA process
  *
@@ -48,9 +146,30 @@ typedef struct esp_delta_ota_cfg {
  */
 esp_delta_ota_handle_t esp_delta_ota_init(esp_delta_ota_cfg_t *cfg);
 
+/**
+ * @brief Restore the state of an interrupted update from a checkpoint
+ *
+ * Must be called right after esp_delta_ota_init(), with the same configuration and patch as the
+ * interrupted update. On success, feed the patch starting at info->patch_offset and continue writing
+ * the destination at info->output_offset.
+ *
+ * @param[in]  handle    esp_delta_ota_handle_t handle
+ * @param[in]  data      checkpoint data, as passed to esp_delta_ota_cfg_t::checkpoint.save_cb
+ * @param[in]  size      size of the checkpoint data
+ * @param[out] info      position to resume from
+ * @return - ESP_OK
+ *         - ESP_ERR_INVALID_ARG
+ *         - ESP_ERR_INVALID_STATE     if the patch is already being applied
+ *         - ESP_ERR_INVALID_VERSION   if the checkpoint doesn't match this build or configuration
+ */
+esp_err_t esp_delta_ota_resume(esp_delta_ota_handle_t handle, const void *data, size_t size, esp_delta_ota_checkpoint_info_t *info);
+
 /**
  * @brief This function performs the patch applying operation on the source data.
  *
+ * In pipelined mode, the data is only copied to the ring buffer, blocking while it is full, and the patch
+ * is applied in the patch task. An error there is reported from the next call or from esp_delta_ota_finalize().
+ *
  * @param[in] handle    esp_delta_ota_handle_t handle
  * @param[in] buf       pointer to patch buffer
  * @param[in] size      size of patch buffer.
@@ -60,14 +179,54 @@ esp_delta_ota_handle_t esp_delta_ota_init(esp_delta_ota_cfg_t *cfg);
  */
 esp_err_t esp_delta_ota_feed_patch(esp_delta_ota_handle_t handle, const uint8_t *buf, int size);
 
+/**
+ * @brief Decrypt a chunk of a patch in "ESP Encrypted Image" format and apply it
+ *
+ * Raw bytes as received from the network go in; they are decrypted with esp_encrypted_img_decrypt_data()
+ * in blocks of at most ESP_DELTA_OTA_DECRYPT_BLOCK_SIZE bytes, and each decrypted block is fed to the
+ * patcher directly. The only intermediate buffer is the decrypted block, which is kept in the handle and
+ * reused for all calls. If the decrypt handle was started with esp_decrypt_cfg_t::data_out_buf_size,
+ * its own output buffer is used instead.
+ *
+ * @note The authentication tag of the encrypted patch is only checked by esp_encrypted_img_decrypt_end(),
+ *       call it after this function has been called with the whole patch and before booting the new
+ *       image. Creating and ending the decrypt handle is up to the caller.
+ *
+ * @param[in] handle          esp_delta_ota_handle_t handle
+ * @param[in] decrypt_handle  handle returned by esp_encrypted_img_decrypt_start()
+ * @param[in] buf             pointer to encrypted patch data
+ * @param[in] size            size of encrypted patch data
+ * @return - ESP_OK
+ *         - ESP_ERR_INVALID_ARG
+ *         - ESP_ERR_NO_MEM
+ *         - ESP_FAIL
+ */
+esp_err_t esp_delta_ota_feed_encrypted_patch(esp_delta_ota_handle_t handle, esp_decrypt_handle_t decrypt_handle, const uint8_t *buf, int size);
+
 /**
  * @brief This function finishes the patch applying operation.
  *
+ * In pipelined mode, this waits until the patch task has consumed all data fed so far.
+ * Any data still held in the write coalescing buffer is passed to the write callback.
+ *
  * @param[in] handle    esp_delta_ota_handle_t
  * @return int
  */
 esp_err_t esp_delta_ota_finalize(esp_delta_ota_handle_t handle);
 
+/**
+ * @brief Get the statistics of the patch application
+ *
+ * In pipelined mode, the numbers are updated by the patch task and should be read after esp_delta_ota_finalize().
+ *
+ * @param[in]  handle    esp_delta_ota_handle_t
+ * @param[out] stats     statistics collected so far
+ * @return - ESP_OK
+ *         - ESP_ERR_INVALID_ARG
+ *         - ESP_ERR_NOT_SUPPORTED   if CONFIG_ESP_DELTA_OTA_ENABLE_STATS is disabled
+ */
+esp_err_t esp_delta_ota_get_stats(esp_delta_ota_handle_t handle, esp_delta_ota_stats_t *stats);
+
 /**
  * @brief Clean-up delta ota process
  *
@@ -6,17 +6,40 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <inttypes.h>
+#include <sys/param.h>
 
+#include "sdkconfig.h"
 #include "esp_err.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/ringbuf.h"
 
 #include "esp_delta_ota.h"
 #include "detools.h"
 
 static const char *TAG = "esp_delta_ota";
 
+#define ESP_DELTA_OTA_CHECKPOINT_MAGIC  0xd17a0c40
+
+typedef struct {
+    uint32_t magic;
+    uint32_t state_size;        // Guards against checkpoints from a build with a different detools layout
+    uint32_t write_buf_size;
+    uint32_t patch_offset;
+    uint32_t output_offset;
+    int32_t src_offset;
+    uint32_t write_buf_len;
+    struct detools_apply_patch_t state;
+    uint8_t write_buf[];        // Data not yet passed to the write callback
+} esp_delta_ota_checkpoint_t;
+
 typedef struct esp_delta_ota_ctx {
     void *user_data;
     src_read_cb_t read_cb;
@@ -26,15 +49,54 @@ typedef struct esp_delta_ota_ctx {
     };
     struct detools_apply_patch_t *apply_patch;
     int src_offset;
+    const esp_partition_t *src_partition;
+    const uint8_t *src_map;
+#if (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0))
+    esp_partition_mmap_handle_t src_map_handle;
+#else
+    spi_flash_mmap_handle_t src_map_handle;
+#endif
+    uint8_t *read_cache;
+    size_t read_cache_size;
+    size_t read_cache_len;
+    int read_cache_offset;
+    uint8_t *write_buf;
+    size_t write_buf_size;
+    size_t write_buf_len;
+    RingbufHandle_t pipe_rb;
+    SemaphoreHandle_t pipe_done;
+    bool pipe_running;
+    volatile bool pipe_eof;
+    volatile esp_err_t pipe_err;
+    bool started;
+    size_t patch_offset;
+    size_t output_offset;
+    size_t checkpoint_interval;
+    size_t next_checkpoint;
+    esp_delta_ota_checkpoint_cb_t checkpoint_cb;
+    void *checkpoint_user_data;
+    esp_delta_ota_checkpoint_t *checkpoint;
+    char *decrypt_buf;
+#if CONFIG_ESP_DELTA_OTA_ENABLE_STATS
+    esp_delta_ota_stats_t stats;
+#endif
 } esp_delta_ota_ctx;
 
-static int esp_delta_ota_write_cb(void *arg_p, const uint8_t *buf_p, size_t size)
+#if CONFIG_ESP_DELTA_OTA_ENABLE_STATS
+#define STATS_TIME_START()              int64_t stats_start = esp_timer_get_time()
+#define STATS_ADD_TIME(ctx, field)      ((ctx)->stats.field += esp_timer_get_time() - stats_start)
+#define STATS_INC(ctx, field, n)        ((ctx)->stats.field += (n))
+#else
+#define STATS_TIME_START()
+#define STATS_ADD_TIME(ctx, field)
+#define STATS_INC(ctx, field, n)
+#endif
+
+static esp_err_t esp_delta_ota_write_out(esp_delta_ota_ctx *handle, const uint8_t *buf_p, size_t size)
 {
-    if (size <= 0) {
-        return ESP_ERR_INVALID_ARG;
-    }
-    esp_delta_ota_ctx *handle = (esp_delta_ota_ctx *)arg_p;
     esp_err_t err = ESP_OK;
+    STATS_TIME_START();
+    STATS_INC(handle, write_calls, 1);
     if (!handle->user_data) {
         err = handle->write_cb(buf_p, size);
         if (err != ESP_OK) {
@@ -48,6 +110,85 @@ static int esp_delta_ota_write_cb(void *arg_p, const uint8_t *buf_p, size_t size
             return ESP_FAIL;
         }
     }
+    STATS_ADD_TIME(handle, write_time_us);
+    STATS_INC(handle, bytes_out, size);
+    handle->output_offset += size;
+    return ESP_OK;
+}
+
+static int esp_delta_ota_write_cb(void *arg_p, const uint8_t *buf_p, size_t size)
+{
+    if (size <= 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_delta_ota_ctx *handle = (esp_delta_ota_ctx *)arg_p;
+    while (size > 0) {
+        // Nothing buffered: pass whole blocks straight through without copying
+        if (handle->write_buf_len == 0 && size >= handle->write_buf_size) {
+            size_t len = size - (size % handle->write_buf_size);
+            if (esp_delta_ota_write_out(handle, buf_p, len) != ESP_OK) {
+                return ESP_FAIL;
+            }
+            buf_p += len;
+            size -= len;
+            continue;
+        }
+        size_t len = MIN(size, handle->write_buf_size - handle->write_buf_len);
+        memcpy(handle->write_buf + handle->write_buf_len, buf_p, len);
+        handle->write_buf_len += len;
+        buf_p += len;
+        size -= len;
+        if (handle->write_buf_len == handle->write_buf_size) {
+            if (esp_delta_ota_write_out(handle, handle->write_buf, handle->write_buf_len) != ESP_OK) {
+                return ESP_FAIL;
+            }
+            handle->write_buf_len = 0;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t esp_delta_ota_src_read(esp_delta_ota_ctx *handle, uint8_t *buf_p, size_t size, int src_offset)
+{
+    STATS_INC(handle, src_read_calls, 1);
+    if (handle->read_cb) {
+        return handle->read_cb(buf_p, size, src_offset);
+    }
+    return esp_partition_read(handle->src_partition, src_offset, buf_p, size);
+}
+
+static esp_err_t esp_delta_ota_cached_read(esp_delta_ota_ctx *handle, uint8_t *buf_p, size_t size, int src_offset)
+{
+    while (size > 0) {
+        if (src_offset >= handle->read_cache_offset && src_offset < handle->read_cache_offset + (int)handle->read_cache_len) {
+            size_t pos = src_offset - handle->read_cache_offset;
+            size_t len = MIN(size, handle->read_cache_len - pos);
+            memcpy(buf_p, handle->read_cache + pos, len);
+            buf_p += len;
+            size -= len;
+            src_offset += len;
+            continue;
+        }
+        if (size >= handle->read_cache_size) {
+            return esp_delta_ota_src_read(handle, buf_p, size, src_offset);
+        }
+        size_t len = handle->read_cache_size;
+        if (handle->src_partition && src_offset + len > handle->src_partition->size) {
+            len = MAX(size, handle->src_partition->size - src_offset);
+        }
+        handle->read_cache_len = 0;
+        esp_err_t err = esp_delta_ota_src_read(handle, handle->read_cache, len, src_offset);
+        if (err != ESP_OK && len > size) {
+            // The window may run past the end of the source, retry with just what was asked for
+            len = size;
+            err = esp_delta_ota_src_read(handle, handle->read_cache, len, src_offset);
+        }
+        if (err != ESP_OK) {
+            return err;
+        }
+        handle->read_cache_offset = src_offset;
+        handle->read_cache_len = len;
+    }
     return ESP_OK;
 }
 
@@ -57,11 +198,25 @@ static int esp_delta_ota_read_cb(void *arg_p, uint8_t *buf_p, size_t size)
         return -ESP_ERR_INVALID_ARG;
     }
     esp_delta_ota_ctx *handle = (esp_delta_ota_ctx *)arg_p;
-    esp_err_t err = handle->read_cb(buf_p, size, handle->src_offset);
+    esp_err_t err = ESP_OK;
+    STATS_TIME_START();
+    STATS_INC(handle, read_calls, 1);
+    if (handle->src_map) {
+        if (handle->src_offset < 0 || handle->src_offset + size > handle->src_partition->size) {
+            err = ESP_ERR_INVALID_SIZE;
+        } else {
+            memcpy(buf_p, handle->src_map + handle->src_offset, size);
+        }
+    } else if (handle->read_cache) {
+        err = esp_delta_ota_cached_read(handle, buf_p, size, handle->src_offset);
+    } else {
+        err = esp_delta_ota_src_read(handle, buf_p, size, handle->src_offset);
+    }
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Error in read_cb(): %s", esp_err_to_name(err));
         return ESP_FAIL;
     }
+    STATS_ADD_TIME(handle, read_time_us);
     handle->src_offset += size;
     return ESP_OK;
 }
@@ -73,8 +228,168 @@ static int esp_delta_ota_seek_cb(void *arg_p, int offset)
     return ESP_OK;
 }
 
+static void esp_delta_ota_src_release(esp_delta_ota_ctx *ctx)
+{
+    if (ctx->src_map) {
+#if (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0))
+        esp_partition_munmap(ctx->src_map_handle);
+#else
+        spi_flash_munmap(ctx->src_map_handle);
+#endif
+        ctx->src_map = NULL;
+    }
+    free(ctx->read_cache);
+    ctx->read_cache = NULL;
+}
+
+static esp_err_t esp_delta_ota_src_setup(esp_delta_ota_ctx *ctx, const esp_delta_ota_cfg_t *cfg)
+{
+    ctx->src_partition = cfg->src_partition;
+    if (!ctx->read_cb && ctx->src_partition) {
+        const void *map = NULL;
+#if (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0))
+        esp_err_t err = esp_partition_mmap(ctx->src_partition, 0, ctx->src_partition->size, ESP_PARTITION_MMAP_DATA, &map, &ctx->src_map_handle);
+#else
+        esp_err_t err = esp_partition_mmap(ctx->src_partition, 0, ctx->src_partition->size, SPI_FLASH_MMAP_DATA, &map, &ctx->src_map_handle);
+#endif
+        if (err == ESP_OK) {
+            ctx->src_map = map;
+            return ESP_OK;
+        }
+        ESP_LOGW(TAG, "Unable to mmap source partition (%s), falling back to esp_partition_read()", esp_err_to_name(err));
+    }
+    ctx->read_cache_size = cfg->read_cache_size;
+    if (ctx->read_cache_size) {
+        ctx->read_cache = malloc(ctx->read_cache_size);
+        if (!ctx->read_cache) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    return ESP_OK;
+}
+
+static void esp_delta_ota_save_checkpoint(esp_delta_ota_ctx *ctx)
+{
+    esp_delta_ota_checkpoint_t *cp = ctx->checkpoint;
+    cp->magic = ESP_DELTA_OTA_CHECKPOINT_MAGIC;
+    cp->state_size = sizeof(cp->state);
+    cp->write_buf_size = ctx->write_buf_size;
+    cp->patch_offset = ctx->patch_offset;
+    cp->output_offset = ctx->output_offset;
+    cp->src_offset = ctx->src_offset;
+    cp->write_buf_len = ctx->write_buf_len;
+    memcpy(&cp->state, ctx->apply_patch, sizeof(cp->state));
+    memcpy(cp->write_buf, ctx->write_buf, ctx->write_buf_len);
+    esp_err_t err = ctx->checkpoint_cb(cp, sizeof(*cp) + ctx->write_buf_len, ctx->checkpoint_user_data);
+    if (err != ESP_OK) {
+        // Not fatal, the update can still complete; a resume just restarts from an older checkpoint
+        ESP_LOGW(TAG, "Error in checkpoint save_cb(): %s", esp_err_to_name(err));
+    }
+}
+
+static esp_err_t esp_delta_ota_process(esp_delta_ota_ctx *ctx, const uint8_t *buf, size_t size)
+{
+#if CONFIG_ESP_DELTA_OTA_ENABLE_STATS
+    // Reads and writes happen from within detools, take them out of its share
+    int64_t io_time = ctx->stats.read_time_us + ctx->stats.write_time_us;
+    STATS_TIME_START();
+#endif
+    int err = detools_apply_patch_process(ctx->apply_patch, buf, size);
+    if (err != 0) {
+        ESP_LOGE(TAG, "Error while applying patch: %s", detools_error_as_string(err));
+        return ESP_FAIL;
+    }
+#if CONFIG_ESP_DELTA_OTA_ENABLE_STATS
+    STATS_ADD_TIME(ctx, decompress_time_us);
+    ctx->stats.decompress_time_us -= ctx->stats.read_time_us + ctx->stats.write_time_us - io_time;
+    ctx->stats.bytes_in += size;
+    ctx->stats.min_free_heap = MIN(ctx->stats.min_free_heap, heap_caps_get_free_size(MALLOC_CAP_DEFAULT));
+#endif
+    ctx->patch_offset += size;
+    if (ctx->checkpoint && ctx->patch_offset >= ctx->next_checkpoint) {
+        esp_delta_ota_save_checkpoint(ctx);
+        ctx->next_checkpoint = ctx->patch_offset + ctx->checkpoint_interval;
+    }
+    return ESP_OK;
+}
+
+static void esp_delta_ota_pipeline_task(void *arg)
+{
+    esp_delta_ota_ctx *ctx = (esp_delta_ota_ctx *)arg;
+    while (1) {
+        // Sample the flag before receiving: once it's set, everything has been fed and an empty buffer means done
+        bool eof = ctx->pipe_eof;
+        size_t size = 0;
+        uint8_t *buf = xRingbufferReceiveUpTo(ctx->pipe_rb, &size, pdMS_TO_TICKS(10), SIZE_MAX);
+        if (buf) {
+            // Keep draining after an error, so that esp_delta_ota_feed_patch() never blocks forever
+            if (ctx->pipe_err == ESP_OK) {
+                ctx->pipe_err = esp_delta_ota_process(ctx, buf, size);
+            }
+            vRingbufferReturnItem(ctx->pipe_rb, buf);
+        } else if (eof) {
+            break;
+        }
+    }
+    xSemaphoreGive(ctx->pipe_done);
+    vTaskDelete(NULL);
+}
+
+static void esp_delta_ota_pipeline_stop(esp_delta_ota_ctx *ctx)
+{
+    if (ctx->pipe_running) {
+        ctx->pipe_eof = true;
+        xSemaphoreTake(ctx->pipe_done, portMAX_DELAY);
+        ctx->pipe_running = false;
+    }
+}
+
+static void esp_delta_ota_pipeline_release(esp_delta_ota_ctx *ctx)
+{
+    if (ctx->pipe_running) {
+        // Discard whatever is still queued
+        ctx->pipe_err = ESP_FAIL;
+        esp_delta_ota_pipeline_stop(ctx);
+    }
+    if (ctx->pipe_rb) {
+        vRingbufferDelete(ctx->pipe_rb);
+        ctx->pipe_rb = NULL;
+    }
+    if (ctx->pipe_done) {
+        vSemaphoreDelete(ctx->pipe_done);
+        ctx->pipe_done = NULL;
+    }
+}
+
+static esp_err_t esp_delta_ota_pipeline_setup(esp_delta_ota_ctx *ctx, const esp_delta_ota_cfg_t *cfg)
+{
+    if (!cfg->pipeline.ring_buf_size) {
+        return ESP_OK;
+    }
+    ctx->pipe_rb = xRingbufferCreate(cfg->pipeline.ring_buf_size, RINGBUF_TYPE_BYTEBUF);
+    ctx->pipe_done = xSemaphoreCreateBinary();
+    if (!ctx->pipe_rb || !ctx->pipe_done) {
+        ESP_LOGE(TAG, "Unable to allocate memory");
+        return ESP_ERR_NO_MEM;
+    }
+    uint32_t stack_size = cfg->pipeline.task_stack_size ? cfg->pipeline.task_stack_size : ESP_DELTA_OTA_DEFAULT_PIPELINE_TASK_STACK_SIZE;
+    UBaseType_t priority = cfg->pipeline.task_priority ? cfg->pipeline.task_priority : uxTaskPriorityGet(NULL);
+    BaseType_t core_id = (cfg->pipeline.task_core_id < 0) ? tskNO_AFFINITY : cfg->pipeline.task_core_id;
+    if (xTaskCreatePinnedToCore(esp_delta_ota_pipeline_task, "delta_ota", stack_size, ctx, priority, NULL,
+                                core_id) != pdPASS) {
+        ESP_LOGE(TAG, "Unable to create patch task");
+        return ESP_ERR_NO_MEM;
+    }
+    ctx->pipe_running = true;
+    return ESP_OK;
+}
+
 esp_delta_ota_handle_t esp_delta_ota_init(esp_delta_ota_cfg_t *cfg)
 {
+    if (!cfg || (!cfg->read_cb && !cfg->src_partition)) {
+        ESP_LOGE(TAG, "Either read_cb or src_partition must be set");
+        return NULL;
+    }
     esp_delta_ota_ctx *ctx = calloc(1, sizeof(esp_delta_ota_ctx));
     if (!ctx) {
         ESP_LOGE(TAG, "Unable to allocate memory");
@@ -83,23 +398,90 @@ esp_delta_ota_handle_t esp_delta_ota_init(esp_delta_ota_cfg_t *cfg)
     ctx->user_data = cfg->user_data;
     ctx->read_cb = cfg->read_cb;
     ctx->write_cb_with_user_data = cfg->write_cb_with_user_data;
+    ctx->write_buf_size = cfg->write_buf_size ? cfg->write_buf_size : ESP_DELTA_OTA_DEFAULT_WRITE_BUF_SIZE;
+#if CONFIG_ESP_DELTA_OTA_ENABLE_STATS
+    ctx->stats.min_free_heap = SIZE_MAX;
+#endif
+    ctx->write_buf = malloc(ctx->write_buf_size);
     ctx->apply_patch = calloc(1, sizeof(struct detools_apply_patch_t));
-    if (!ctx->apply_patch) {
+    if (!ctx->write_buf || !ctx->apply_patch || esp_delta_ota_src_setup(ctx, cfg) != ESP_OK) {
         ESP_LOGE(TAG, "Unable to allocate memory");
-        free(ctx);
-        ctx = NULL;
-        return NULL;
+        goto err;
     }
     int ret = detools_apply_patch_init(ctx->apply_patch, &esp_delta_ota_read_cb, &esp_delta_ota_seek_cb, 0, &esp_delta_ota_write_cb, ctx);
     if (ret < 0) {
         ESP_LOGE(TAG, "Error while initializing delta_ota: %s", detools_error_as_string(ret));
-        free(ctx->apply_patch);
-        ctx->apply_patch = NULL;
-        free(ctx);
-        ctx = NULL;
-        return NULL;
+        goto err;
+    }
+    if (cfg->checkpoint.interval && cfg->checkpoint.save_cb) {
+        ctx->checkpoint_interval = cfg->checkpoint.interval;
+        ctx->next_checkpoint = cfg->checkpoint.interval;
+        ctx->checkpoint_cb = cfg->checkpoint.save_cb;
+        ctx->checkpoint_user_data = cfg->checkpoint.user_data;
+        ctx->checkpoint = malloc(sizeof(esp_delta_ota_checkpoint_t) + ctx->write_buf_size);
+        if (!ctx->checkpoint) {
+            ESP_LOGE(TAG, "Unable to allocate memory");
+            goto err;
+        }
+    }
+    if (esp_delta_ota_pipeline_setup(ctx, cfg) != ESP_OK) {
+        goto err;
     }
     return (esp_delta_ota_handle_t)ctx;
+
+err:
+    esp_delta_ota_pipeline_release(ctx);
+    free(ctx->checkpoint);
+    esp_delta_ota_src_release(ctx);
+    free(ctx->apply_patch);
+    free(ctx->write_buf);
+    free(ctx);
+    return NULL;
+}
+
+esp_err_t esp_delta_ota_resume(esp_delta_ota_handle_t handle, const void *data, size_t size, esp_delta_ota_checkpoint_info_t *info)
+{
+    if (handle == NULL || data == NULL || info == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_delta_ota_ctx *ctx = (esp_delta_ota_ctx *)handle;
+    if (ctx->started) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    const esp_delta_ota_checkpoint_t *cp = (const esp_delta_ota_checkpoint_t *)data;
+    if (size < sizeof(*cp) || cp->magic != ESP_DELTA_OTA_CHECKPOINT_MAGIC || cp->state_size != sizeof(cp->state) ||
+            cp->write_buf_size != ctx->write_buf_size || cp->write_buf_len >= ctx->write_buf_size ||
+            size != sizeof(*cp) + cp->write_buf_len) {
+        ESP_LOGE(TAG, "Checkpoint doesn't match this build or configuration");
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    /* The saved state holds pointers: our callbacks and their argument, the patch reader's back-pointer
+     * and its decompressor functions. Keep the ones set up by detools_apply_patch_init() in this run
+     * and take everything else from the checkpoint. */
+    struct detools_apply_patch_t fresh = *ctx->apply_patch;
+    *ctx->apply_patch = cp->state;
+    ctx->apply_patch->from_read = fresh.from_read;
+    ctx->apply_patch->from_seek = fresh.from_seek;
+    ctx->apply_patch->to_write = fresh.to_write;
+    ctx->apply_patch->arg_p = fresh.arg_p;
+    ctx->apply_patch->patch_reader.apply_patch_p = fresh.patch_reader.apply_patch_p;
+    ctx->apply_patch->patch_reader.destroy = fresh.patch_reader.destroy;
+    ctx->apply_patch->patch_reader.decompress = fresh.patch_reader.decompress;
+
+    ctx->patch_offset = cp->patch_offset;
+    ctx->output_offset = cp->output_offset;
+    ctx->src_offset = cp->src_offset;
+    ctx->read_cache_len = 0;
+    memcpy(ctx->write_buf, cp->write_buf, cp->write_buf_len);
+    ctx->write_buf_len = cp->write_buf_len;
+    ctx->next_checkpoint = ctx->patch_offset + ctx->checkpoint_interval;
+    ctx->started = true;
+
+    info->patch_offset = ctx->patch_offset;
+    info->output_offset = ctx->output_offset;
+    ESP_LOGI(TAG, "Resuming at patch offset %" PRIu32 ", output offset %" PRIu32, cp->patch_offset, cp->output_offset);
+    return ESP_OK;
 }
 
 esp_err_t esp_delta_ota_feed_patch(esp_delta_ota_handle_t handle, const uint8_t *buf, int size)
@@ -108,12 +490,60 @@ esp_err_t esp_delta_ota_feed_patch(esp_delta_ota_handle_t handle, const uint8_t
         return ESP_ERR_INVALID_ARG;
     }
     esp_delta_ota_ctx *ctx = (esp_delta_ota_ctx *)handle;
+    ctx->started = true;
 
-    int err = detools_apply_patch_process(ctx->apply_patch, (const uint8_t *)buf, size);
-    if (err != 0) {
-        ESP_LOGE(TAG, "Error while applying patch: %s", detools_error_as_string(err));
+    if (!ctx->pipe_rb) {
+        return esp_delta_ota_process(ctx, buf, size);
+    }
+    if (!ctx->pipe_running || ctx->pipe_err != ESP_OK) {
         return ESP_FAIL;
     }
+    size_t max_chunk = xRingbufferGetMaxItemSize(ctx->pipe_rb);
+    while (size > 0) {
+        size_t len = MIN((size_t)size, max_chunk);
+        if (xRingbufferSend(ctx->pipe_rb, buf, len, portMAX_DELAY) != pdTRUE) {
+            return ESP_FAIL;
+        }
+        buf += len;
+        size -= len;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_delta_ota_feed_encrypted_patch(esp_delta_ota_handle_t handle, esp_decrypt_handle_t decrypt_handle, const uint8_t *buf, int size)
+{
+    if (handle == NULL || decrypt_handle == NULL || buf == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_delta_ota_ctx *ctx = (esp_delta_ota_ctx *)handle;
+
+    while (size > 0) {
+        int len = MIN(size, ESP_DELTA_OTA_DECRYPT_BLOCK_SIZE);
+        pre_enc_decrypt_arg_t args = {
+            .data_in = (const char *)buf,
+            .data_in_len = len,
+            // Handed back every time so that esp_encrypted_img_decrypt_data() reallocs it in place, unless
+            // the decrypt handle has an output buffer of its own
+            .data_out = ctx->decrypt_buf,
+            .data_out_len = 0,
+        };
+        esp_err_t err = esp_encrypted_img_decrypt_data(decrypt_handle, &args);
+        if (!args.data_out_owned) {
+            ctx->decrypt_buf = args.data_out;
+        }
+        if (err != ESP_OK && err != ESP_ERR_NOT_FINISHED) {
+            ESP_LOGE(TAG, "Error while decrypting patch: %s", esp_err_to_name(err));
+            return err;
+        }
+        if (args.data_out_len > 0) {
+            err = esp_delta_ota_feed_patch(handle, (const uint8_t *)args.data_out, args.data_out_len);
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
+        buf += len;
+        size -= len;
+    }
     return ESP_OK;
 }
 
@@ -124,12 +554,42 @@ esp_err_t esp_delta_ota_finalize(esp_delta_ota_handle_t handle)
     }
     esp_delta_ota_ctx *ctx = (esp_delta_ota_ctx *)handle;
 
+    if (ctx->pipe_rb) {
+        esp_delta_ota_pipeline_stop(ctx);
+        if (ctx->pipe_err != ESP_OK) {
+            return ctx->pipe_err;
+        }
+    }
     int err = detools_apply_patch_finalize(ctx->apply_patch);
     if (err < 0) {
         ESP_LOGE(TAG, "Error while finishing the patching: %s", detools_error_as_string(err));
         return ESP_FAIL;
     }
+    if (ctx->write_buf_len > 0) {
+        esp_err_t ret = esp_delta_ota_write_out(ctx, ctx->write_buf, ctx->write_buf_len);
+        ctx->write_buf_len = 0;
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_delta_ota_get_stats(esp_delta_ota_handle_t handle, esp_delta_ota_stats_t *stats)
+{
+    if (handle == NULL || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+#if CONFIG_ESP_DELTA_OTA_ENABLE_STATS
+    esp_delta_ota_ctx *ctx = (esp_delta_ota_ctx *)handle;
+    *stats = ctx->stats;
+    if (stats->min_free_heap == SIZE_MAX) {
+        stats->min_free_heap = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+    }
     return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
 }
 
 esp_err_t esp_delta_ota_deinit(esp_delta_ota_handle_t handle)
@@ -139,8 +599,16 @@ esp_err_t esp_delta_ota_deinit(esp_delta_ota_handle_t handle)
     }
     esp_delta_ota_ctx *ctx = (esp_delta_ota_ctx *)handle;
 
+    esp_delta_ota_pipeline_release(ctx);
+    free(ctx->checkpoint);
+    ctx->checkpoint = NULL;
+    free(ctx->decrypt_buf);
+    ctx->decrypt_buf = NULL;
     free(ctx->apply_patch);
     ctx->apply_patch = NULL;
+    esp_delta_ota_src_release(ctx);
+    free(ctx->write_buf);
+    ctx->write_buf = NULL;
     free(ctx);
     ctx = NULL;
     return ESP_OK;
@@ -5,8 +5,12 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
 #include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 #include "unity.h"
 #include "esp_delta_ota.h"
@@ -20,6 +24,11 @@ extern const uint8_t patch_bin_start[] asm("_binary_patch_bin_start");
 extern const uint8_t patch_bin_end[]   asm("_binary_patch_bin_end");
 extern const uint8_t bad_patch_bin_start[] asm("_binary_bad_patch_bin_start");
 extern const uint8_t bad_patch_bin_end[]   asm("_binary_bad_patch_bin_end");
+// patch.bin encrypted with esp_enc_img_gen.py and the RSA key of the esp_encrypted_img tests
+extern const uint8_t patch_enc_bin_start[] asm("_binary_patch_enc_bin_start");
+extern const uint8_t patch_enc_bin_end[]   asm("_binary_patch_enc_bin_end");
+extern const uint8_t rsa_private_pem_start[] asm("_binary_patch_rsa_private_key_pem_start");
+extern const uint8_t rsa_private_pem_end[]   asm("_binary_patch_rsa_private_key_pem_end");
 
 static uint8_t output_buffer[1300] = {0};
 static int output_index = 0;
@@ -116,3 +125,298 @@ TEST_CASE("Sending 1 byte of patch at once", "[esp_delta_ota]")
 
     TEST_ASSERT_EQUAL_INT(0, memcmp(new_bin_start, output_buffer, output_index));
 }
+
+static int write_calls = 0;
+static int write_unaligned_calls = 0;
+#define TEST_WRITE_BUF_SIZE 256
+static esp_err_t counting_write_cb(const uint8_t *buf_p, size_t size, void *user_data)
+{
+    if (size % TEST_WRITE_BUF_SIZE) {
+        write_unaligned_calls++;
+    }
+    write_calls++;
+    return write_cb(buf_p, size);
+}
+
+TEST_CASE("Writes are coalesced into aligned blocks", "[esp_delta_ota]")
+{
+    memset(output_buffer, 0, 1000);
+    output_index = 0;
+    write_calls = 0;
+    write_unaligned_calls = 0;
+    esp_delta_ota_cfg_t cfg = {
+        .user_data = &write_calls,
+        .read_cb = &read_cb,
+        .write_cb_with_user_data = &counting_write_cb,
+        .write_buf_size = TEST_WRITE_BUF_SIZE,
+    };
+
+    esp_delta_ota_handle_t handle = esp_delta_ota_init(&cfg);
+    TEST_ASSERT_NOT_NULL(handle);
+    esp_err_t err = ESP_OK;
+
+    for (int i = 0; i < patch_bin_end - patch_bin_start; i++) {
+        err = esp_delta_ota_feed_patch(handle, patch_bin_start + i, 1);
+        TEST_ESP_OK(err);
+    }
+    err = esp_delta_ota_finalize(handle);
+    TEST_ESP_OK(err);
+
+    err = esp_delta_ota_deinit(handle);
+    TEST_ESP_OK(err);
+
+    // Only the tail flushed from esp_delta_ota_finalize() may be a partial block
+    const int new_bin_size = new_bin_end - new_bin_start;
+    TEST_ASSERT_EQUAL_INT(new_bin_size, output_index);
+    TEST_ASSERT_LESS_OR_EQUAL_INT((new_bin_size + TEST_WRITE_BUF_SIZE - 1) / TEST_WRITE_BUF_SIZE, write_calls);
+    TEST_ASSERT_LESS_OR_EQUAL_INT(1, write_unaligned_calls);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(new_bin_start, output_buffer, output_index));
+}
+
+static int read_calls = 0;
+static esp_err_t counting_read_cb(uint8_t *buf_p, size_t size, int src_offset)
+{
+    read_calls++;
+    if (src_offset + size > base_bin_end - base_bin_start) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return read_cb(buf_p, size, src_offset);
+}
+
+static void apply_patch_counting_reads(size_t read_cache_size)
+{
+    memset(output_buffer, 0, 1000);
+    output_index = 0;
+    read_calls = 0;
+    esp_delta_ota_cfg_t cfg = {
+        .read_cb = &counting_read_cb,
+        .write_cb = &write_cb,
+        .read_cache_size = read_cache_size,
+    };
+
+    esp_delta_ota_handle_t handle = esp_delta_ota_init(&cfg);
+    TEST_ASSERT_NOT_NULL(handle);
+
+    esp_err_t err = esp_delta_ota_feed_patch(handle, patch_bin_start, patch_bin_end - patch_bin_start);
+    TEST_ESP_OK(err);
+
+    err = esp_delta_ota_finalize(handle);
+    TEST_ESP_OK(err);
+
+    err = esp_delta_ota_deinit(handle);
+    TEST_ESP_OK(err);
+
+    TEST_ASSERT_EQUAL_INT(0, memcmp(new_bin_start, output_buffer, new_bin_end - new_bin_start));
+}
+
+TEST_CASE("Source reads are served from the read cache", "[esp_delta_ota]")
+{
+    apply_patch_counting_reads(0);
+    int uncached_read_calls = read_calls;
+
+    // Windows running past the end of the base image are refused by the callback and retried with the exact size
+    apply_patch_counting_reads(512);
+    TEST_ASSERT_LESS_OR_EQUAL_INT(uncached_read_calls, read_calls);
+    TEST_ASSERT_GREATER_THAN(0, read_calls);
+}
+
+TEST_CASE("Pipelined patch application", "[esp_delta_ota]")
+{
+    memset(output_buffer, 0, 1000);
+    output_index = 0;
+    esp_delta_ota_cfg_t cfg = {
+        .read_cb = &read_cb,
+        .write_cb = &write_cb,
+        .pipeline = ESP_DELTA_OTA_PIPELINE_DEFAULT(),
+    };
+    cfg.pipeline.ring_buf_size = 256;
+
+    esp_delta_ota_handle_t handle = esp_delta_ota_init(&cfg);
+    TEST_ASSERT_NOT_NULL(handle);
+    esp_err_t err = ESP_OK;
+
+    // Feed in pieces larger than the ring buffer as well as single bytes
+    const int patch_size = patch_bin_end - patch_bin_start;
+    err = esp_delta_ota_feed_patch(handle, patch_bin_start, patch_size / 2);
+    TEST_ESP_OK(err);
+    for (int i = patch_size / 2; i < patch_size; i++) {
+        err = esp_delta_ota_feed_patch(handle, patch_bin_start + i, 1);
+        TEST_ESP_OK(err);
+    }
+    err = esp_delta_ota_finalize(handle);
+    TEST_ESP_OK(err);
+
+    err = esp_delta_ota_deinit(handle);
+    TEST_ESP_OK(err);
+
+    TEST_ASSERT_EQUAL_INT(new_bin_end - new_bin_start, output_index);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(new_bin_start, output_buffer, output_index));
+}
+
+TEST_CASE("Pipelined mode can be deinitialized without finalizing", "[esp_delta_ota]")
+{
+    esp_delta_ota_cfg_t cfg = {
+        .read_cb = &read_cb,
+        .write_cb = &write_cb,
+        .pipeline = ESP_DELTA_OTA_PIPELINE_DEFAULT(),
+    };
+    cfg.pipeline.ring_buf_size = 256;
+
+    esp_delta_ota_handle_t handle = esp_delta_ota_init(&cfg);
+    TEST_ASSERT_NOT_NULL(handle);
+    TEST_ESP_OK(esp_delta_ota_feed_patch(handle, patch_bin_start, patch_bin_end - patch_bin_start));
+    TEST_ESP_OK(esp_delta_ota_deinit(handle));
+}
+
+static uint8_t *checkpoint_data = NULL;
+static size_t checkpoint_size = 0;
+static esp_err_t checkpoint_cb(const void *data, size_t size, void *user_data)
+{
+    free(checkpoint_data);
+    checkpoint_data = malloc(size);
+    if (!checkpoint_data) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(checkpoint_data, data, size);
+    checkpoint_size = size;
+    return ESP_OK;
+}
+
+TEST_CASE("Resuming from a checkpoint", "[esp_delta_ota]")
+{
+    memset(output_buffer, 0, sizeof(output_buffer));
+    output_index = 0;
+    esp_delta_ota_cfg_t cfg = {
+        .read_cb = &read_cb,
+        .write_cb = &write_cb,
+        .write_buf_size = 128,
+        .checkpoint = {
+            .interval = 200,
+            .save_cb = &checkpoint_cb,
+        },
+    };
+
+    // Interrupt the update two thirds in
+    const int patch_size = patch_bin_end - patch_bin_start;
+    esp_delta_ota_handle_t handle = esp_delta_ota_init(&cfg);
+    TEST_ASSERT_NOT_NULL(handle);
+    for (int i = 0; i < patch_size * 2 / 3; i++) {
+        TEST_ESP_OK(esp_delta_ota_feed_patch(handle, patch_bin_start + i, 1));
+    }
+    TEST_ESP_OK(esp_delta_ota_deinit(handle));
+    TEST_ASSERT_NOT_NULL(checkpoint_data);
+
+    handle = esp_delta_ota_init(&cfg);
+    TEST_ASSERT_NOT_NULL(handle);
+    esp_delta_ota_checkpoint_info_t info;
+    TEST_ESP_OK(esp_delta_ota_resume(handle, checkpoint_data, checkpoint_size, &info));
+    TEST_ASSERT_GREATER_THAN(0, info.patch_offset);
+    TEST_ASSERT_EQUAL_INT(0, info.output_offset % 128);
+
+    // Anything written after the checkpoint is lost with the interrupted run
+    memset(output_buffer + info.output_offset, 0, sizeof(output_buffer) - info.output_offset);
+    output_index = info.output_offset;
+    TEST_ESP_OK(esp_delta_ota_feed_patch(handle, patch_bin_start + info.patch_offset, patch_size - info.patch_offset));
+    TEST_ESP_OK(esp_delta_ota_finalize(handle));
+    TEST_ESP_OK(esp_delta_ota_deinit(handle));
+
+    TEST_ASSERT_EQUAL_INT(new_bin_end - new_bin_start, output_index);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(new_bin_start, output_buffer, output_index));
+    free(checkpoint_data);
+    checkpoint_data = NULL;
+}
+
+TEST_CASE("Resuming is refused once the patch is being applied", "[esp_delta_ota]")
+{
+    esp_delta_ota_cfg_t cfg = {
+        .read_cb = &read_cb,
+        .write_cb = &write_cb,
+    };
+    esp_delta_ota_handle_t handle = esp_delta_ota_init(&cfg);
+    TEST_ASSERT_NOT_NULL(handle);
+    uint8_t bogus[16] = {0};
+    esp_delta_ota_checkpoint_info_t info;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_VERSION, esp_delta_ota_resume(handle, bogus, sizeof(bogus), &info));
+    TEST_ESP_OK(esp_delta_ota_feed_patch(handle, patch_bin_start, 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_delta_ota_resume(handle, bogus, sizeof(bogus), &info));
+    TEST_ESP_OK(esp_delta_ota_deinit(handle));
+}
+
+TEST_CASE("Patch application statistics", "[esp_delta_ota]")
+{
+    memset(output_buffer, 0, 1000);
+    output_index = 0;
+    esp_delta_ota_cfg_t cfg = {
+        .read_cb = &read_cb,
+        .write_cb = &write_cb,
+    };
+
+    esp_delta_ota_handle_t handle = esp_delta_ota_init(&cfg);
+    TEST_ASSERT_NOT_NULL(handle);
+    TEST_ESP_OK(esp_delta_ota_feed_patch(handle, patch_bin_start, patch_bin_end - patch_bin_start));
+    TEST_ESP_OK(esp_delta_ota_finalize(handle));
+
+    esp_delta_ota_stats_t stats;
+    esp_err_t err = esp_delta_ota_get_stats(handle, &stats);
+#if CONFIG_ESP_DELTA_OTA_ENABLE_STATS
+    TEST_ESP_OK(err);
+    TEST_ASSERT_EQUAL_INT(patch_bin_end - patch_bin_start, stats.bytes_in);
+    TEST_ASSERT_EQUAL_INT(new_bin_end - new_bin_start, stats.bytes_out);
+    TEST_ASSERT_GREATER_THAN(0, stats.write_calls);
+    TEST_ASSERT_GREATER_OR_EQUAL(stats.src_read_calls, stats.read_calls);
+    TEST_ASSERT_GREATER_THAN(0, stats.min_free_heap);
+#else
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, err);
+#endif
+    TEST_ESP_OK(esp_delta_ota_deinit(handle));
+}
+
+TEST_CASE("Encrypted patch fed across decryption blocks", "[esp_delta_ota]")
+{
+    // Output of the plain patch, as reference
+    memset(output_buffer, 0, sizeof(output_buffer));
+    output_index = 0;
+    esp_delta_ota_cfg_t cfg = {
+        .read_cb = &read_cb,
+        .write_cb = &write_cb,
+    };
+    esp_delta_ota_handle_t handle = esp_delta_ota_init(&cfg);
+    TEST_ASSERT_NOT_NULL(handle);
+    TEST_ESP_OK(esp_delta_ota_feed_patch(handle, patch_bin_start, patch_bin_end - patch_bin_start));
+    TEST_ESP_OK(esp_delta_ota_finalize(handle));
+    TEST_ESP_OK(esp_delta_ota_deinit(handle));
+    const int plain_len = output_index;
+    uint8_t *plain_output = malloc(plain_len);
+    TEST_ASSERT_NOT_NULL(plain_output);
+    memcpy(plain_output, output_buffer, plain_len);
+
+    memset(output_buffer, 0, sizeof(output_buffer));
+    output_index = 0;
+    handle = esp_delta_ota_init(&cfg);
+    TEST_ASSERT_NOT_NULL(handle);
+    esp_decrypt_cfg_t decrypt_cfg = {
+        .rsa_priv_key = (char *)rsa_private_pem_start,
+        .rsa_priv_key_len = rsa_private_pem_end - rsa_private_pem_start,
+    };
+    esp_decrypt_handle_t decrypt_handle = esp_encrypted_img_decrypt_start(&decrypt_cfg);
+    TEST_ASSERT_NOT_NULL(decrypt_handle);
+
+    // Chunks ending inside the image header, inside a block and on both sides of block boundaries
+    const int chunk_sizes[] = { 1, ESP_DELTA_OTA_DECRYPT_BLOCK_SIZE - 1, ESP_DELTA_OTA_DECRYPT_BLOCK_SIZE + 1,
+                                2 * ESP_DELTA_OTA_DECRYPT_BLOCK_SIZE + 3, 7, 511
+                              };
+    const uint8_t *buf = patch_enc_bin_start;
+    for (int i = 0; buf < patch_enc_bin_end; i++) {
+        const int len = MIN(chunk_sizes[i % (sizeof(chunk_sizes) / sizeof(chunk_sizes[0]))], patch_enc_bin_end - buf);
+        TEST_ESP_OK(esp_delta_ota_feed_encrypted_patch(handle, decrypt_handle, buf, len));
+        buf += len;
+    }
+    TEST_ESP_OK(esp_encrypted_img_decrypt_end(decrypt_handle));
+    TEST_ESP_OK(esp_delta_ota_finalize(handle));
+    TEST_ESP_OK(esp_delta_ota_deinit(handle));
+
+    TEST_ASSERT_EQUAL_INT(plain_len, output_index);
+    TEST_ASSERT_EQUAL_MEMORY(plain_output, output_buffer, plain_len);
+    TEST_ASSERT_EQUAL_MEMORY(new_bin_start, output_buffer, new_bin_end - new_bin_start);
+    free(plain_output);
+}
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <esp_err.h>
 #include <esp_idf_version.h>
 
@@ -52,6 +53,24 @@ extern "C" {
 
 typedef void *esp_decrypt_handle_t;
 
+#define ESP_ENCRYPTED_IMG_KEY_SIZE          32  /*!< Size of the AES-256 GCM key of an image */
+#define ESP_ENCRYPTED_IMG_KEY_DIGEST_SIZE   32  /*!< Size of the SHA-256 digest identifying the image a key belongs to */
+
+/**
+ * @brief GCM key of an image, unwrapped from its header with the RSA private key
+ *
+ * It can be exported from a decrypt handle with esp_encrypted_img_export_key() and passed to later
+ * decrypt sessions of the same image through esp_decrypt_cfg_t::gcm_key, which then skip the RSA step.
+ *
+ * @note This is the plain text key of the image. Keep it in protected storage only, e.g. NVS with
+ *       NVS encryption enabled.
+ */
+typedef struct {
+    uint8_t key[ESP_ENCRYPTED_IMG_KEY_SIZE];                /*!< AES-256 GCM key */
+    uint8_t enc_key_digest[ESP_ENCRYPTED_IMG_KEY_DIGEST_SIZE];  /*!< SHA-256 of the RSA wrapped key in the image header.
+                                                                 The key is only used for an image whose header matches */
+} esp_encrypted_img_key_t;
+
 typedef struct {
     union {
         const char *rsa_priv_key;                       /*!< 3072 bit RSA private key in PEM format */
@@ -65,6 +84,19 @@ typedef struct {
                                                              but it is not accurate (meaning wise) and hence it would
                                                              be removed in the next major release */
     };
+    size_t data_out_buf_size;                           /*!< If non-zero, the handle allocates an output buffer of this size
+                                                             and every esp_encrypted_img_decrypt_data() call decrypts into it,
+                                                             so decryption does not allocate per call. It grows if a call
+                                                             produces more output; to avoid that, make it at least the largest
+                                                             data_in_len plus CONFIG_ESP_ENCRYPTED_IMG_DECRYPT_BATCH_SIZE.
+                                                             0 reallocates data_out on every call */
+    const uint8_t *x25519_priv_key;                     /*!< Raw 32 byte X25519 private key, for images generated with an
+                                                             X25519 public key instead of an RSA one. rsa_priv_key may be NULL
+                                                             if only such images are decrypted */
+    const esp_encrypted_img_key_t *gcm_key;            /*!< Optional key exported from an earlier session with
+                                                             esp_encrypted_img_export_key(). If it belongs to the image,
+                                                             decryption of the key with the private key is skipped; otherwise
+                                                             the private key is used. It may be NULL if this is set */
 } esp_decrypt_cfg_t;
 
 #undef DEPRECATED_ATTRIBUTE
@@ -74,6 +106,9 @@ typedef struct {
     size_t data_in_len;     /*!< Input data length */
     char *data_out;         /*!< Pointer to decrypted data */
     size_t data_out_len;    /*!< Output data length */
+    bool data_out_owned;    /*!< Set by esp_encrypted_img_decrypt_data() if data_out points to the buffer owned by the
+                                 handle (see esp_decrypt_cfg_t::data_out_buf_size). It is then valid until the next call
+                                 and must not be freed */
 } pre_enc_decrypt_arg_t;
 
 
@@ -96,7 +131,8 @@ esp_decrypt_handle_t esp_encrypted_img_decrypt_start(const esp_decrypt_cfg_t *cf
 * This function must be called in a loop since input data might not contain whole binary at once.
 * This function must be called till it return ESP_OK.
 *
-* @note args->data_out must be freed after use provided args->data_out_len is greater than 0
+* @note args->data_out must be freed after use provided args->data_out_len is greater than 0,
+*       unless args->data_out_owned is set
 *
 * @param[in]        ctx                 esp_decrypt_handle_t handle
 * @param[in/out]    args                pointer to pre_enc_decrypt_arg_t
@@ -152,6 +188,114 @@ bool esp_encrypted_img_is_complete_data_received(esp_decrypt_handle_t ctx);
 */
 esp_err_t esp_encrypted_img_decrypt_abort(esp_decrypt_handle_t ctx);
 
+/**
+* @brief  Export the GCM key of the image being decrypted
+*
+* The key is available once the image header has been processed by esp_encrypted_img_decrypt_data().
+* Passing it to a later session through esp_decrypt_cfg_t::gcm_key saves the RSA decryption when the
+* same image is decrypted again, e.g. when an OTA update is retried. Store it only once
+* esp_encrypted_img_decrypt_end() has verified the image.
+*
+* @param[in]   ctx   esp_decrypt_handle_t handle
+* @param[out]  key   Key and digest of the wrapped key
+*
+* @return
+*    - ESP_ERR_INVALID_ARG      Invalid argument
+*    - ESP_ERR_INVALID_STATE    The key has not been read from the image yet
+*    - ESP_OK                   Success
+*/
+esp_err_t esp_encrypted_img_export_key(esp_decrypt_handle_t ctx, esp_encrypted_img_key_t *key);
+
+/**
+ * @brief Default size of the blocks handed to the write callback of a decrypt pipeline
+ */
+#define ESP_ENCRYPTED_IMG_PIPELINE_DEFAULT_BLOCK_SIZE       4096
+
+/**
+ * @brief Default stack size of the write task of a decrypt pipeline
+ */
+#define ESP_ENCRYPTED_IMG_PIPELINE_DEFAULT_TASK_STACK_SIZE  4096
+
+typedef void *esp_encrypted_img_pipeline_handle_t;
+
+/**
+ * @brief Callback receiving decrypted data from a decrypt pipeline, e.g. calling esp_ota_write()
+ *
+ * It is called from the write task of the pipeline.
+ */
+typedef esp_err_t (*esp_encrypted_img_write_cb_t)(const char *data, size_t len, void *user_data);
+
+typedef struct {
+    esp_decrypt_cfg_t decrypt_cfg;          /*!< Configuration of the decrypt handle, data_out_buf_size is ignored */
+    esp_encrypted_img_write_cb_t write_cb;  /*!< Callback receiving the decrypted data, in blocks of block_size bytes
+                                                 except for the last one */
+    void *user_data;                        /*!< User data passed to write_cb */
+    size_t block_size;                      /*!< Size of the two output blocks. 0 selects ESP_ENCRYPTED_IMG_PIPELINE_DEFAULT_BLOCK_SIZE */
+    uint32_t task_stack_size;               /*!< Stack size of the write task. 0 selects ESP_ENCRYPTED_IMG_PIPELINE_DEFAULT_TASK_STACK_SIZE */
+    unsigned task_priority;                 /*!< Priority of the write task. 0 selects the priority of the calling task */
+    int task_core_id;                       /*!< Core the write task is pinned to, or tskNO_AFFINITY */
+} esp_encrypted_img_pipeline_cfg_t;
+
+/**
+* @brief  Start a decrypt pipeline
+*
+* A decrypt pipeline decrypts into two output blocks in turn. Decryption runs in the task calling
+* esp_encrypted_img_pipeline_write(), while full blocks are passed to the write callback in a separate
+* write task, so that decrypting one block overlaps with writing the previous one to flash.
+*
+* @param[in]   cfg   pointer to esp_encrypted_img_pipeline_cfg_t structure
+*
+* @return
+*    - NULL    On failure
+*    - esp_encrypted_img_pipeline_handle_t handle
+*/
+esp_encrypted_img_pipeline_handle_t esp_encrypted_img_pipeline_start(const esp_encrypted_img_pipeline_cfg_t *cfg);
+
+/**
+* @brief  Decrypt encrypted image data and queue it for writing
+*
+* Like esp_encrypted_img_decrypt_data(), this must be called in a loop until it returns ESP_OK. It blocks
+* while both output blocks are waiting to be written.
+*
+* @param[in]   handle   esp_encrypted_img_pipeline_handle_t handle
+* @param[in]   data     Encrypted image data
+* @param[in]   len      Length of data
+*
+* @return
+*    - ESP_ERR_NOT_FINISHED     More data is expected
+*    - ESP_OK                   The whole image has been received
+*    - ESP_ERR_INVALID_ARG      Invalid arguments
+*    - Any other error from decryption or from the write callback, after which the pipeline must be aborted
+*/
+esp_err_t esp_encrypted_img_pipeline_write(esp_encrypted_img_pipeline_handle_t handle, const char *data, size_t len);
+
+/**
+* @brief  Write the remaining data, verify the image and free the pipeline
+*
+* @note Decrypted data is passed to the write callback before the authentication tag has been checked,
+*       so the written image must not be used unless this returns ESP_OK.
+*
+* @param[in]   handle   esp_encrypted_img_pipeline_handle_t handle
+*
+* @return
+*    - ESP_OK                   Success
+*    - ESP_ERR_INVALID_ARG      Invalid argument
+*    - ESP_FAIL                 The image is incomplete or its verification failed
+*    - Any other error from the write callback
+*/
+esp_err_t esp_encrypted_img_pipeline_end(esp_encrypted_img_pipeline_handle_t handle);
+
+/**
+* @brief  Abort a decrypt pipeline, discarding data not written yet, and free it
+*
+* @param[in]   handle   esp_encrypted_img_pipeline_handle_t handle
+*
+* @return
+*    - ESP_ERR_INVALID_ARG  Invalid argument
+*    - ESP_OK               Success
+*/
+esp_err_t esp_encrypted_img_pipeline_abort(esp_encrypted_img_pipeline_handle_t handle);
+
 /**
 * @brief  Get the size of pre encrypted binary image header (`struct pre_enc_bin_header`). The initial header in
 *         the image contains magic, credentials (symmetric key) and few other parameters. This API could be useful
@@ -4,7 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
 #include <string.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
 #include "esp_encrypted_img.h"
 #include <errno.h>
 #include <esp_log.h>
@@ -15,6 +18,9 @@
 #include "mbedtls/entropy.h"
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/gcm.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/ecdh.h"
+#include "mbedtls/md.h"
 #include "sys/param.h"
 
 static const char *TAG = "esp_encrypted_img";
@@ -36,6 +42,27 @@ typedef enum {
 #define BIN_SIZE_DATA       4
 #define AUTH_SIZE           16
 #define RESERVED_HEADER     88
+#define GCM_BATCH_SIZE      (CONFIG_ESP_ENCRYPTED_IMG_DECRYPT_BATCH_SIZE & ~(16 - 1))
+
+/*
+ * In images of the X25519 format, the enc_gcm field of the header holds the ephemeral public key of the
+ * sender, followed by the GCM key encrypted with AES-256-GCM (zero nonce, no additional data) under
+ * HKDF-SHA256(X25519(recipient key, ephemeral key), salt = ephemeral public key, info = X25519_HKDF_INFO).
+ */
+#define X25519_KEY_SIZE     32
+#define X25519_WRAP_IV_SIZE 12
+#define X25519_HKDF_INFO    "esp_encrypted_img x25519"
+
+/*
+ * In images of the chunked format, the first 4 bytes of extra_header hold the chunk size and the auth field
+ * is unused. The data is split into chunks of that size (the last one may be shorter), each one followed by
+ * its own 16 byte tag. Chunk i is encrypted with AES-256-GCM under the nonce iv[0..7) | i (big endian) |
+ * 1 for the last chunk, 0 otherwise, and the image size and chunk size (little endian) as additional data,
+ * so that chunks cannot be reordered, dropped or truncated.
+ */
+#define CHUNK_SIZE_DATA         4
+#define CHUNK_NONCE_SIZE        12
+#define CHUNK_NONCE_PREFIX_SIZE 7
 
 struct esp_encrypted_img_handle {
     char *rsa_pem;
@@ -47,8 +74,24 @@ struct esp_encrypted_img_handle {
     char auth_tag[AUTH_SIZE];
     esp_encrypted_img_state state;
     mbedtls_gcm_context gcm_ctx;
+    bool x25519_image;
+    bool chunked;
+    uint32_t chunk_size;
+    uint32_t chunk_count;
+    uint32_t chunk_index;
+    uint32_t chunk_len;         // Encrypted data of the current chunk, without its tag
+    uint32_t chunk_read;        // Encrypted data of the current chunk read
+    uint32_t tag_read;          // Bytes of the tag of the current chunk read
+    uint32_t image_len;         // Size of the decrypted image
+    bool has_x25519_key;
+    uint8_t x25519_priv_key[X25519_KEY_SIZE];
+    uint8_t enc_key_digest[ESP_ENCRYPTED_IMG_KEY_DIGEST_SIZE];
+    bool has_cached_key;
+    esp_encrypted_img_key_t cached_key;
     size_t cache_buf_len;
     char *cache_buf;
+    char *data_out_buf;
+    size_t data_out_buf_size;
 };
 
 typedef struct {
@@ -63,9 +106,22 @@ typedef struct {
 
 // Magic Byte is created using command: echo -n "esp_encrypted_img" | sha256sum
 static uint32_t esp_enc_img_magic = 0x0788b6cf;
+// Magic Byte is created using command: echo -n "esp_encrypted_img_x25519" | sha256sum
+static uint32_t esp_enc_img_x25519_magic = 0x327c4619;
+// Magic Byte is created using command: echo -n "esp_encrypted_img_chunked" | sha256sum
+static uint32_t esp_enc_img_chunked_magic = 0x8edc50b5;
+// Magic Byte is created using command: echo -n "esp_encrypted_img_x25519_chunked" | sha256sum
+static uint32_t esp_enc_img_x25519_chunked_magic = 0x66555f5e;
 
 typedef struct esp_encrypted_img_handle esp_encrypted_img_t;
 
+static bool verify_magic(esp_encrypted_img_t *handle, uint32_t recv_magic)
+{
+    handle->x25519_image = (recv_magic == esp_enc_img_x25519_magic || recv_magic == esp_enc_img_x25519_chunked_magic);
+    handle->chunked = (recv_magic == esp_enc_img_chunked_magic || recv_magic == esp_enc_img_x25519_chunked_magic);
+    return recv_magic == esp_enc_img_magic || handle->x25519_image || handle->chunked;
+}
+
 static int decipher_gcm_key(const char *enc_gcm, esp_encrypted_img_t *handle)
 {
     int ret = 1;
@@ -102,26 +158,163 @@ static int decipher_gcm_key(const char *enc_gcm, esp_encrypted_img_t *handle)
         ESP_LOGE(TAG, "failed\n  ! mbedtls_pk_decrypt returned -0x%04x\n", (unsigned int) - ret );
         goto exit;
     }
-    handle->cache_buf = realloc(handle->cache_buf, 16);
+exit:
+    mbedtls_pk_free( &pk );
+    mbedtls_entropy_free( &entropy );
+    mbedtls_ctr_drbg_free( &ctr_drbg );
+
+    return (ret);
+}
+
+#if defined(MBEDTLS_ECP_DP_CURVE25519_ENABLED)
+static int hkdf_sha256(const uint8_t *salt, size_t salt_len, const uint8_t *ikm, size_t ikm_len, uint8_t okm[32])
+{
+    const mbedtls_md_info_t *md = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    const uint8_t info[] = X25519_HKDF_INFO "\x01";    // A single block of output: T(1) = HMAC(PRK, info | 0x01)
+    uint8_t prk[32];
+    int ret = mbedtls_md_hmac(md, salt, salt_len, ikm, ikm_len, prk);
+    if (ret == 0) {
+        ret = mbedtls_md_hmac(md, prk, sizeof(prk), info, sizeof(info) - 1, okm);
+    }
+    memset(prk, 0, sizeof(prk));
+    return ret;
+}
+
+static int decipher_gcm_key_x25519(const char *enc_gcm, esp_encrypted_img_t *handle)
+{
+    const uint8_t *eph_pub = (const uint8_t *)enc_gcm;
+    const uint8_t *wrapped_key = eph_pub + X25519_KEY_SIZE;
+    const uint8_t *wrap_tag = wrapped_key + GCM_KEY_SIZE;
+    const uint8_t wrap_iv[X25519_WRAP_IV_SIZE] = { 0 };
+    uint8_t shared[X25519_KEY_SIZE];
+    uint8_t kek[32];
+    int ret;
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point Q;
+    mbedtls_mpi d, z;
+    mbedtls_gcm_context wrap_ctx;
+    mbedtls_entropy_context entropy;
+    mbedtls_ctr_drbg_context ctr_drbg;
+    const char *pers = "esp_encrypted_img_x25519";
+
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&Q);
+    mbedtls_mpi_init(&d);
+    mbedtls_mpi_init(&z);
+    mbedtls_gcm_init(&wrap_ctx);
+    mbedtls_ctr_drbg_init(&ctr_drbg);
+    mbedtls_entropy_init(&entropy);
+
+    // The random generator is only used to blind the scalar multiplication
+    if ((ret = mbedtls_ctr_drbg_seed(&ctr_drbg, mbedtls_entropy_func, &entropy,
+                                     (const unsigned char *)pers, strlen(pers))) != 0) {
+        ESP_LOGE(TAG, "failed\n  ! mbedtls_ctr_drbg_seed returned -0x%04x\n", (unsigned int) - ret);
+        goto exit;
+    }
+
+    // X25519 private keys are clamped as described in RFC 7748
+    handle->x25519_priv_key[0] &= 248;
+    handle->x25519_priv_key[X25519_KEY_SIZE - 1] &= 127;
+    handle->x25519_priv_key[X25519_KEY_SIZE - 1] |= 64;
+    if ((ret = mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_CURVE25519)) != 0 ||
+            (ret = mbedtls_mpi_read_binary_le(&d, handle->x25519_priv_key, X25519_KEY_SIZE)) != 0 ||
+            (ret = mbedtls_ecp_point_read_binary(&grp, &Q, eph_pub, X25519_KEY_SIZE)) != 0) {
+        ESP_LOGE(TAG, "failed\n  ! Loading X25519 keys returned -0x%04x\n", (unsigned int) - ret);
+        goto exit;
+    }
+    if ((ret = mbedtls_ecdh_compute_shared(&grp, &z, &Q, &d, mbedtls_ctr_drbg_random, &ctr_drbg)) != 0 ||
+            (ret = mbedtls_mpi_write_binary_le(&z, shared, sizeof(shared))) != 0) {
+        ESP_LOGE(TAG, "failed\n  ! mbedtls_ecdh_compute_shared returned -0x%04x\n", (unsigned int) - ret);
+        goto exit;
+    }
+    if ((ret = hkdf_sha256(eph_pub, X25519_KEY_SIZE, shared, sizeof(shared), kek)) != 0) {
+        ESP_LOGE(TAG, "failed\n  ! HKDF returned -0x%04x\n", (unsigned int) - ret);
+        goto exit;
+    }
+    if ((ret = mbedtls_gcm_setkey(&wrap_ctx, MBEDTLS_CIPHER_ID_AES, kek, sizeof(kek) * 8)) != 0 ||
+            (ret = mbedtls_gcm_auth_decrypt(&wrap_ctx, GCM_KEY_SIZE, wrap_iv, sizeof(wrap_iv), NULL, 0,
+                                            wrap_tag, AUTH_SIZE, wrapped_key, (unsigned char *)handle->gcm_key)) != 0) {
+        ESP_LOGE(TAG, "failed\n  ! Unwrapping the GCM key returned -0x%04x\n", (unsigned int) - ret);
+        goto exit;
+    }
+exit:
+    memset(shared, 0, sizeof(shared));
+    memset(kek, 0, sizeof(kek));
+    mbedtls_gcm_free(&wrap_ctx);
+    mbedtls_mpi_free(&z);
+    mbedtls_mpi_free(&d);
+    mbedtls_ecp_point_free(&Q);
+    mbedtls_ecp_group_free(&grp);
+    mbedtls_entropy_free(&entropy);
+    mbedtls_ctr_drbg_free(&ctr_drbg);
+    return ret;
+}
+#endif /* MBEDTLS_ECP_DP_CURVE25519_ENABLED */
+
+/*
+ * Obtain the GCM key for the wrapped key enc_gcm from the image header: from the cached key if it was
+ * exported from the same image, which is identified by the digest of the wrapped key, or from RSA.
+ */
+static int unwrap_gcm_key(const char *enc_gcm, esp_encrypted_img_t *handle)
+{
+    int ret;
+#if (MBEDTLS_VERSION_NUMBER < 0x03000000)
+    ret = mbedtls_sha256_ret((const unsigned char *)enc_gcm, ENC_GCM_KEY_SIZE, handle->enc_key_digest, 0);
+#else
+    ret = mbedtls_sha256((const unsigned char *)enc_gcm, ENC_GCM_KEY_SIZE, handle->enc_key_digest, 0);
+#endif
+    if (ret != 0) {
+        ESP_LOGE(TAG, "failed\n  ! mbedtls_sha256 returned -0x%04x\n", (unsigned int) - ret);
+        goto exit;
+    }
+
+    if (handle->has_cached_key &&
+            memcmp(handle->cached_key.enc_key_digest, handle->enc_key_digest, ESP_ENCRYPTED_IMG_KEY_DIGEST_SIZE) == 0) {
+        ESP_LOGI(TAG, "Using cached GCM key");
+        memcpy(handle->gcm_key, handle->cached_key.key, GCM_KEY_SIZE);
+    } else if (handle->x25519_image && handle->has_x25519_key) {
+#if defined(MBEDTLS_ECP_DP_CURVE25519_ENABLED)
+        if ((ret = decipher_gcm_key_x25519(enc_gcm, handle)) != 0) {
+            goto exit;
+        }
+#else
+        ESP_LOGE(TAG, "X25519 images require CONFIG_MBEDTLS_ECP_DP_CURVE25519_ENABLED");
+        ret = ESP_FAIL;
+        goto exit;
+#endif
+    } else if (!handle->x25519_image && handle->rsa_pem) {
+        if ((ret = decipher_gcm_key(enc_gcm, handle)) != 0) {
+            goto exit;
+        }
+    } else if (handle->has_cached_key) {
+        ESP_LOGE(TAG, "Cached GCM key does not belong to this image");
+        ret = ESP_FAIL;
+        goto exit;
+    } else {
+        ESP_LOGE(TAG, "No %s key to decrypt this image", handle->x25519_image ? "X25519" : "RSA");
+        ret = ESP_FAIL;
+        goto exit;
+    }
+
+    handle->cache_buf = realloc(handle->cache_buf, GCM_BATCH_SIZE);
     if (!handle->cache_buf) {
-        return ESP_ERR_NO_MEM;
+        ret = ESP_ERR_NO_MEM;
+        goto exit;
     }
     handle->state = ESP_PRE_ENC_IMG_READ_IV;
     handle->binary_file_read = 0;
     handle->cache_buf_len = 0;
 exit:
-    mbedtls_pk_free( &pk );
-    mbedtls_entropy_free( &entropy );
-    mbedtls_ctr_drbg_free( &ctr_drbg );
+    memset(&handle->cached_key, 0, sizeof(handle->cached_key));
+    memset(handle->x25519_priv_key, 0, sizeof(handle->x25519_priv_key));
     free(handle->rsa_pem);
     handle->rsa_pem = NULL;
-
-    return (ret);
+    return ret;
 }
 
 esp_decrypt_handle_t esp_encrypted_img_decrypt_start(const esp_decrypt_cfg_t *cfg)
 {
-    if (cfg == NULL || cfg->rsa_priv_key == NULL) {
+    if (cfg == NULL || (cfg->rsa_priv_key == NULL && cfg->x25519_priv_key == NULL && cfg->gcm_key == NULL)) {
         ESP_LOGE(TAG, "esp_encrypted_img_decrypt_start : Invalid argument");
         return NULL;
     }
@@ -133,10 +326,24 @@ esp_decrypt_handle_t esp_encrypted_img_decrypt_start(const esp_decrypt_cfg_t *cf
         goto failure;
     }
 
-    handle->rsa_pem = calloc(1, cfg->rsa_priv_key_len);
-    if (!handle->rsa_pem) {
-        ESP_LOGE(TAG, "Couldn't allocate memory to handle->rsa_pem");
-        goto failure;
+    if (cfg->rsa_priv_key) {
+        handle->rsa_pem = calloc(1, cfg->rsa_priv_key_len);
+        if (!handle->rsa_pem) {
+            ESP_LOGE(TAG, "Couldn't allocate memory to handle->rsa_pem");
+            goto failure;
+        }
+        memcpy(handle->rsa_pem, cfg->rsa_priv_key, cfg->rsa_priv_key_len);
+        handle->rsa_len = cfg->rsa_priv_key_len;
+    }
+
+    if (cfg->x25519_priv_key) {
+        memcpy(handle->x25519_priv_key, cfg->x25519_priv_key, X25519_KEY_SIZE);
+        handle->has_x25519_key = true;
+    }
+
+    if (cfg->gcm_key) {
+        memcpy(&handle->cached_key, cfg->gcm_key, sizeof(handle->cached_key));
+        handle->has_cached_key = true;
     }
 
     handle->cache_buf = calloc(1, ENC_GCM_KEY_SIZE);
@@ -145,8 +352,15 @@ esp_decrypt_handle_t esp_encrypted_img_decrypt_start(const esp_decrypt_cfg_t *cf
         goto failure;
     }
 
-    memcpy(handle->rsa_pem, cfg->rsa_priv_key, cfg->rsa_priv_key_len);
-    handle->rsa_len = cfg->rsa_priv_key_len;
+    if (cfg->data_out_buf_size) {
+        handle->data_out_buf = malloc(cfg->data_out_buf_size);
+        if (!handle->data_out_buf) {
+            ESP_LOGE(TAG, "Couldn't allocate memory to handle->data_out_buf");
+            goto failure;
+        }
+        handle->data_out_buf_size = cfg->data_out_buf_size;
+    }
+
     handle->state = ESP_PRE_ENC_IMG_READ_MAGIC;
 
     esp_decrypt_handle_t ctx = (esp_decrypt_handle_t)handle;
@@ -154,97 +368,231 @@ esp_decrypt_handle_t esp_encrypted_img_decrypt_start(const esp_decrypt_cfg_t *cf
 
 failure:
     if (handle) {
+        free(handle->data_out_buf);
+        free(handle->cache_buf);
         free(handle->rsa_pem);
         free(handle);
     }
     return NULL;
 }
 
-static esp_err_t process_bin(esp_encrypted_img_t *handle, pre_enc_decrypt_arg_t *args, int curr_index)
+static esp_err_t gcm_decrypt(esp_encrypted_img_t *handle, const char *in, size_t len, char *out)
 {
-    size_t data_len = args->data_in_len;
-    size_t data_out_size = args->data_out_len;
-#if !(MBEDTLS_VERSION_NUMBER < 0x03000000)
-    size_t olen;
-#endif
-    handle->binary_file_read += data_len - curr_index;
-    int dec_len = 0;
-    if (handle->binary_file_read != handle->binary_file_len) {
-        size_t copy_len = 0;
-
-        if ((handle->cache_buf_len + (data_len - curr_index)) - (handle->cache_buf_len + (data_len - curr_index)) % 16 > 0) {
-            data_out_size = (handle->cache_buf_len + (data_len - curr_index)) - (handle->cache_buf_len + (data_len - curr_index)) % 16;
-            args->data_out = realloc(args->data_out, data_out_size);
-            if (!args->data_out) {
-                return ESP_ERR_NO_MEM;
-            }
-        }
-        if (handle->cache_buf_len != 0) {
-            copy_len = MIN(16 - handle->cache_buf_len, data_len - curr_index);
-            memcpy(handle->cache_buf + handle->cache_buf_len, args->data_in + curr_index, copy_len);
-            handle->cache_buf_len += copy_len;
-            if (handle->cache_buf_len != 16) {
-                args->data_out_len = 0;
-                return ESP_ERR_NOT_FINISHED;
-            }
 #if (MBEDTLS_VERSION_NUMBER < 0x03000000)
-            if (mbedtls_gcm_update(&handle->gcm_ctx, 16, (const unsigned char *)handle->cache_buf, (unsigned char *) args->data_out) != 0) {
+    if (mbedtls_gcm_update(&handle->gcm_ctx, len, (const unsigned char *)in, (unsigned char *)out) != 0) {
 #else
-            if (mbedtls_gcm_update(&handle->gcm_ctx, (const unsigned char *)handle->cache_buf, 16, (unsigned char *) args->data_out, data_out_size, &olen) != 0) {
+    size_t olen;
+    if (mbedtls_gcm_update(&handle->gcm_ctx, (const unsigned char *)in, len, (unsigned char *)out, len, &olen) != 0) {
 #endif
-                return ESP_FAIL;
-            }
-            dec_len = 16;
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/*
+ * Encrypted data is decrypted in batches of GCM_BATCH_SIZE bytes, so that every GCM update but the last
+ * one of a GCM message covers a whole batch: data is decrypted straight from the input where possible and
+ * the rest is collected in cache_buf. With flush, the end of the message, the rest is decrypted as well.
+ */
+static esp_err_t decrypt_batches(esp_encrypted_img_t *handle, const char *data_in, size_t data_len, bool flush, char *out, size_t *out_len)
+{
+    size_t dec_len = 0;
+    *out_len = 0;
+    if (handle->cache_buf_len != 0) {
+        size_t copy_len = MIN(GCM_BATCH_SIZE - handle->cache_buf_len, data_len);
+        memcpy(handle->cache_buf + handle->cache_buf_len, data_in, copy_len);
+        handle->cache_buf_len += copy_len;
+        data_in += copy_len;
+        data_len -= copy_len;
+        if (handle->cache_buf_len < GCM_BATCH_SIZE && !flush) {
+            return ESP_OK;
         }
-        handle->cache_buf_len = (data_len - curr_index - copy_len) % 16;
-        if (handle->cache_buf_len != 0) {
-            data_len -= handle->cache_buf_len;
-            memcpy(handle->cache_buf, args->data_in + (data_len), handle->cache_buf_len);
+        if (gcm_decrypt(handle, handle->cache_buf, handle->cache_buf_len, out) != ESP_OK) {
+            return ESP_FAIL;
         }
+        dec_len = handle->cache_buf_len;
+        handle->cache_buf_len = 0;
+    }
 
-        if (data_len - copy_len - curr_index > 0) {
-#if (MBEDTLS_VERSION_NUMBER < 0x03000000)
-            if (mbedtls_gcm_update(&handle->gcm_ctx, data_len - copy_len - curr_index, (const unsigned char *)args->data_in + curr_index + copy_len, (unsigned char *)args->data_out + dec_len) != 0) {
-#else
-            if (mbedtls_gcm_update(&handle->gcm_ctx, (const unsigned char *)args->data_in + curr_index + copy_len, data_len - copy_len - curr_index, (unsigned char *)args->data_out + dec_len, data_out_size - dec_len, &olen) != 0) {
-#endif
-                return ESP_FAIL;
+    size_t direct_len = flush ? data_len : data_len - data_len % GCM_BATCH_SIZE;
+    if (direct_len > 0) {
+        if (gcm_decrypt(handle, data_in, direct_len, out + dec_len) != ESP_OK) {
+            return ESP_FAIL;
+        }
+        dec_len += direct_len;
+        data_in += direct_len;
+        data_len -= direct_len;
+    }
+
+    memcpy(handle->cache_buf, data_in, data_len);
+    handle->cache_buf_len = data_len;
+    *out_len = dec_len;
+    return ESP_OK;
+}
+
+static esp_err_t alloc_data_out(esp_encrypted_img_t *handle, pre_enc_decrypt_arg_t *args, size_t data_out_size)
+{
+    if (handle->data_out_buf) {
+        if (data_out_size > handle->data_out_buf_size) {
+            char *buf = realloc(handle->data_out_buf, data_out_size);
+            if (!buf) {
+                return ESP_ERR_NO_MEM;
             }
+            handle->data_out_buf = buf;
+            handle->data_out_buf_size = data_out_size;
+        }
+        args->data_out = handle->data_out_buf;
+    } else {
+        args->data_out = realloc(args->data_out, data_out_size);
+        if (!args->data_out) {
+            return ESP_ERR_NO_MEM;
         }
-        args->data_out_len = dec_len + data_len - curr_index - copy_len;
-        return ESP_ERR_NOT_FINISHED;
     }
-    data_out_size = handle->cache_buf_len + data_len - curr_index;
-    args->data_out = realloc(args->data_out, data_out_size);
-    if (!args->data_out) {
-        return ESP_ERR_NO_MEM;
+    return ESP_OK;
+}
+
+static esp_err_t process_bin(esp_encrypted_img_t *handle, pre_enc_decrypt_arg_t *args, int curr_index)
+{
+    const char *data_in = args->data_in + curr_index;
+    size_t data_len = args->data_in_len - curr_index;
+    handle->binary_file_read += data_len;
+    const bool last = (handle->binary_file_read == handle->binary_file_len);
+
+    size_t total_len = handle->cache_buf_len + data_len;
+    size_t data_out_size = last ? total_len : total_len - total_len % GCM_BATCH_SIZE;
+    args->data_out_len = 0;
+    args->data_out_owned = (handle->data_out_buf != NULL);
+    if (data_out_size == 0) {
+        memcpy(handle->cache_buf + handle->cache_buf_len, data_in, data_len);
+        handle->cache_buf_len += data_len;
+        return last ? ESP_OK : ESP_ERR_NOT_FINISHED;
+    }
+    esp_err_t err = alloc_data_out(handle, args, data_out_size);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    if (decrypt_batches(handle, data_in, data_len, last, args->data_out, &args->data_out_len) != ESP_OK) {
+        return ESP_FAIL;
     }
-    size_t copy_len = 0;
+    return last ? ESP_OK : ESP_ERR_NOT_FINISHED;
+}
 
-    copy_len = MIN(16 - handle->cache_buf_len, data_len - curr_index);
-    memcpy(handle->cache_buf + handle->cache_buf_len, args->data_in + curr_index, copy_len);
-    handle->cache_buf_len += copy_len;
+static esp_err_t start_chunk(esp_encrypted_img_t *handle)
+{
+    const bool last = (handle->chunk_index + 1 == handle->chunk_count);
+    uint8_t nonce[CHUNK_NONCE_SIZE];
+    memcpy(nonce, handle->iv, CHUNK_NONCE_PREFIX_SIZE);
+    nonce[7] = handle->chunk_index >> 24;
+    nonce[8] = handle->chunk_index >> 16;
+    nonce[9] = handle->chunk_index >> 8;
+    nonce[10] = handle->chunk_index;
+    nonce[11] = last;
+    uint8_t aad[BIN_SIZE_DATA + CHUNK_SIZE_DATA];
+    memcpy(aad, &handle->image_len, BIN_SIZE_DATA);
+    memcpy(aad + BIN_SIZE_DATA, &handle->chunk_size, CHUNK_SIZE_DATA);
+
+    handle->chunk_len = last ? handle->image_len - handle->chunk_index * handle->chunk_size : handle->chunk_size;
+    handle->chunk_read = 0;
+    handle->tag_read = 0;
 #if (MBEDTLS_VERSION_NUMBER < 0x03000000)
-    if (mbedtls_gcm_update(&handle->gcm_ctx, handle->cache_buf_len, (const unsigned char *)handle->cache_buf, (unsigned char *)args->data_out) != 0) {
+    if (mbedtls_gcm_starts(&handle->gcm_ctx, MBEDTLS_GCM_DECRYPT, nonce, sizeof(nonce), aad, sizeof(aad)) != 0) {
 #else
-    if (mbedtls_gcm_update(&handle->gcm_ctx,  (const unsigned char *)handle->cache_buf, handle->cache_buf_len, (unsigned char *)args->data_out, data_out_size, &olen) != 0) {
+    if (mbedtls_gcm_starts(&handle->gcm_ctx, MBEDTLS_GCM_DECRYPT, nonce, sizeof(nonce)) != 0 ||
+            mbedtls_gcm_update_ad(&handle->gcm_ctx, aad, sizeof(aad)) != 0) {
 #endif
+        ESP_LOGE(TAG, "Error: mbedtls_gcm_starts failed for chunk %" PRIu32, handle->chunk_index);
         return ESP_FAIL;
     }
-    if (data_len - curr_index - copy_len > 0) {
+    return ESP_OK;
+}
+
+static esp_err_t finish_chunk(esp_encrypted_img_t *handle)
+{
+    unsigned char got_auth[AUTH_SIZE] = {0};
 #if (MBEDTLS_VERSION_NUMBER < 0x03000000)
-        if (mbedtls_gcm_update(&handle->gcm_ctx, data_len - curr_index - copy_len, (const unsigned char *)(args->data_in + curr_index + copy_len), (unsigned char *)(args->data_out + 16)) != 0) {
+    int ret = mbedtls_gcm_finish(&handle->gcm_ctx, got_auth, AUTH_SIZE);
 #else
-        if (mbedtls_gcm_update(&handle->gcm_ctx,  (const unsigned char *)(args->data_in + curr_index + copy_len), data_len - curr_index - copy_len, (unsigned char *)(args->data_out + 16), data_out_size - 16, &olen) != 0) {
+    size_t olen;
+    int ret = mbedtls_gcm_finish(&handle->gcm_ctx, NULL, 0, &olen, got_auth, AUTH_SIZE);
 #endif
-            return ESP_FAIL;
+    if (ret != 0 || memcmp(got_auth, handle->auth_tag, AUTH_SIZE) != 0) {
+        ESP_LOGE(TAG, "Invalid Auth of chunk %" PRIu32, handle->chunk_index);
+        return ESP_FAIL;
+    }
+    handle->chunk_index++;
+    return (handle->chunk_index < handle->chunk_count) ? start_chunk(handle) : ESP_OK;
+}
+
+static esp_err_t start_chunked(esp_encrypted_img_t *handle)
+{
+    if (handle->chunk_size == 0) {
+        ESP_LOGE(TAG, "Invalid chunk size");
+        return ESP_FAIL;
+    }
+    // From here, binary_file_len counts the tags of the chunks too
+    handle->image_len = handle->binary_file_len;
+    handle->chunk_count = handle->image_len / handle->chunk_size + (handle->image_len % handle->chunk_size != 0);
+    uint64_t data_len = (uint64_t)handle->image_len + (uint64_t)handle->chunk_count * AUTH_SIZE;
+    if (data_len > UINT32_MAX) {
+        ESP_LOGE(TAG, "Invalid image size");
+        return ESP_FAIL;
+    }
+    handle->binary_file_len = data_len;
+    handle->chunk_index = 0;
+    return (handle->chunk_count > 0) ? start_chunk(handle) : ESP_OK;
+}
+
+/*
+ * Data of a chunked image is passed to the caller as it is decrypted, but the tag of each chunk is checked
+ * as soon as it is received: a corrupted image is rejected after at most one chunk instead of at the end.
+ */
+static esp_err_t process_chunks(esp_encrypted_img_t *handle, pre_enc_decrypt_arg_t *args, int curr_index)
+{
+    const char *data_in = args->data_in + curr_index;
+    size_t data_len = args->data_in_len - curr_index;
+    size_t out_len = 0;
+    args->data_out_len = 0;
+    args->data_out_owned = (handle->data_out_buf != NULL);
+
+    // The output is at most the encrypted data received plus the data cached by the previous call
+    if (handle->cache_buf_len + data_len > 0) {
+        esp_err_t err = alloc_data_out(handle, args, handle->cache_buf_len + data_len);
+        if (err != ESP_OK) {
+            return err;
         }
     }
 
-    args->data_out_len = handle->cache_buf_len + data_len - copy_len - curr_index;
-    handle->cache_buf_len = 0;
+    while (data_len > 0) {
+        if (handle->chunk_read < handle->chunk_len) {
+            size_t len = MIN(data_len, handle->chunk_len - handle->chunk_read);
+            handle->chunk_read += len;
+            size_t dec_len;
+            if (decrypt_batches(handle, data_in, len, handle->chunk_read == handle->chunk_len, args->data_out + out_len, &dec_len) != ESP_OK) {
+                return ESP_FAIL;
+            }
+            out_len += dec_len;
+            data_in += len;
+            data_len -= len;
+            handle->binary_file_read += len;
+        } else if (handle->chunk_index < handle->chunk_count) {
+            size_t len = MIN(data_len, AUTH_SIZE - handle->tag_read);
+            memcpy(handle->auth_tag + handle->tag_read, data_in, len);
+            handle->tag_read += len;
+            data_in += len;
+            data_len -= len;
+            handle->binary_file_read += len;
+            if (handle->tag_read == AUTH_SIZE && finish_chunk(handle) != ESP_OK) {
+                return ESP_FAIL;
+            }
+        } else {
+            ESP_LOGE(TAG, "Data after the last chunk");
+            return ESP_FAIL;
+        }
+    }
 
-    return ESP_OK;
+    args->data_out_len = out_len;
+    return (handle->chunk_index == handle->chunk_count) ? ESP_OK : ESP_ERR_NOT_FINISHED;
 }
 
 static void read_and_cache_data(esp_encrypted_img_t *handle, pre_enc_decrypt_arg_t *args, int *curr_index, int data_size)
@@ -283,7 +631,7 @@ esp_err_t esp_encrypted_img_decrypt_data(esp_decrypt_handle_t ctx, pre_enc_decry
         if (handle->cache_buf_len == 0 && (args->data_in_len - curr_index) >= MAGIC_SIZE) {
             uint32_t recv_magic = *(uint32_t *)args->data_in;
 
-            if (recv_magic != esp_enc_img_magic) {
+            if (!verify_magic(handle, recv_magic)) {
                 ESP_LOGE(TAG, "Magic Verification failed");
                 free(handle->rsa_pem);
                 handle->rsa_pem = NULL;
@@ -295,7 +643,7 @@ esp_err_t esp_encrypted_img_decrypt_data(esp_decrypt_handle_t ctx, pre_enc_decry
             if (handle->binary_file_read == MAGIC_SIZE) {
                 uint32_t recv_magic = *(uint32_t *)handle->cache_buf;
 
-                if (recv_magic != esp_enc_img_magic) {
+                if (!verify_magic(handle, recv_magic)) {
                     ESP_LOGE(TAG, "Magic Verification failed");
                     free(handle->rsa_pem);
                     handle->rsa_pem = NULL;
@@ -312,7 +660,7 @@ esp_err_t esp_encrypted_img_decrypt_data(esp_decrypt_handle_t ctx, pre_enc_decry
     /* falls through */
     case ESP_PRE_ENC_IMG_READ_GCM:
         if (handle->cache_buf_len == 0 && args->data_in_len - curr_index >= ENC_GCM_KEY_SIZE) {
-            if (decipher_gcm_key(args->data_in + curr_index, handle) != 0) {
+            if (unwrap_gcm_key(args->data_in + curr_index, handle) != 0) {
                 ESP_LOGE(TAG, "Unable to decipher GCM key");
                 return ESP_FAIL;
             }
@@ -320,7 +668,7 @@ esp_err_t esp_encrypted_img_decrypt_data(esp_decrypt_handle_t ctx, pre_enc_decry
         } else {
             read_and_cache_data(handle, args, &curr_index, ENC_GCM_KEY_SIZE);
             if (handle->cache_buf_len == ENC_GCM_KEY_SIZE) {
-                if (decipher_gcm_key(handle->cache_buf, handle) != 0) {
+                if (unwrap_gcm_key(handle->cache_buf, handle) != 0) {
                     ESP_LOGE(TAG, "Unable to decipher GCM key");
                     return ESP_FAIL;
                 }
@@ -346,10 +694,11 @@ esp_err_t esp_encrypted_img_decrypt_data(esp_decrypt_handle_t ctx, pre_enc_decry
                 ESP_LOGE(TAG, "Error: mbedtls_gcm_set_key: -0x%04x\n", (unsigned int) - err);
                 return ESP_FAIL;
             }
+            // Every chunk of a chunked image is started with its own nonce once the header is read
 #if (MBEDTLS_VERSION_NUMBER < 0x03000000)
-            if (mbedtls_gcm_starts(&handle->gcm_ctx, MBEDTLS_GCM_DECRYPT, (const unsigned char *)handle->iv, IV_SIZE, NULL, 0) != 0) {
+            if (!handle->chunked && mbedtls_gcm_starts(&handle->gcm_ctx, MBEDTLS_GCM_DECRYPT, (const unsigned char *)handle->iv, IV_SIZE, NULL, 0) != 0) {
 #else
-            if (mbedtls_gcm_starts(&handle->gcm_ctx, MBEDTLS_GCM_DECRYPT, (const unsigned char *)handle->iv, IV_SIZE) != 0) {
+            if (!handle->chunked && mbedtls_gcm_starts(&handle->gcm_ctx, MBEDTLS_GCM_DECRYPT, (const unsigned char *)handle->iv, IV_SIZE) != 0) {
 #endif
                 ESP_LOGE(TAG, "Error: mbedtls_gcm_starts: -0x%04x\n", (unsigned int) - err);
                 return ESP_FAIL;
@@ -391,20 +740,27 @@ esp_err_t esp_encrypted_img_decrypt_data(esp_decrypt_handle_t ctx, pre_enc_decry
         }
     /* falls through */
     case ESP_PRE_ENC_IMG_READ_EXTRA_HEADER: {
-        int temp = curr_index;
-        curr_index += MIN(args->data_in_len - curr_index, RESERVED_HEADER - handle->binary_file_read);
-        handle->binary_file_read += MIN(args->data_in_len - temp, RESERVED_HEADER - handle->binary_file_read);
+        size_t len = MIN(args->data_in_len - curr_index, RESERVED_HEADER - handle->binary_file_read);
+        if (handle->binary_file_read < CHUNK_SIZE_DATA) {
+            memcpy((uint8_t *)&handle->chunk_size + handle->binary_file_read, args->data_in + curr_index,
+                   MIN(len, CHUNK_SIZE_DATA - handle->binary_file_read));
+        }
+        curr_index += len;
+        handle->binary_file_read += len;
         if (handle->binary_file_read == RESERVED_HEADER) {
             handle->state = ESP_PRE_ENC_DATA_DECODE_STATE;
             handle->binary_file_read = 0;
             handle->cache_buf_len = 0;
+            if (handle->chunked && start_chunked(handle) != ESP_OK) {
+                return ESP_FAIL;
+            }
         } else {
             return ESP_ERR_NOT_FINISHED;
         }
     }
 /* falls through */
     case ESP_PRE_ENC_DATA_DECODE_STATE:
-        err = process_bin(handle, args, curr_index);
+        err = handle->chunked ? process_chunks(handle, args, curr_index) : process_bin(handle, args, curr_index);
         return err;
     }
     return ESP_OK;
@@ -427,6 +783,11 @@ esp_err_t esp_encrypted_img_decrypt_end(esp_decrypt_handle_t ctx)
             err = ESP_FAIL;
             goto exit;
         }
+        if (handle->chunked) {
+            // Every chunk was authenticated when its tag was read
+            err = (handle->chunk_index == handle->chunk_count) ? ESP_OK : ESP_FAIL;
+            goto exit;
+        }
 
         unsigned char got_auth[AUTH_SIZE] = {0};
 #if (MBEDTLS_VERSION_NUMBER < 0x03000000)
@@ -449,6 +810,7 @@ esp_err_t esp_encrypted_img_decrypt_end(esp_decrypt_handle_t ctx)
     err = ESP_OK;
 exit:
     mbedtls_gcm_free(&handle->gcm_ctx);
+    free(handle->data_out_buf);
     free(handle->cache_buf);
     free(handle->rsa_pem);
     free(handle);
@@ -469,12 +831,28 @@ esp_err_t esp_encrypted_img_decrypt_abort(esp_decrypt_handle_t ctx)
         return ESP_ERR_INVALID_ARG;
     }
     mbedtls_gcm_free(&handle->gcm_ctx);
+    free(handle->data_out_buf);
     free(handle->cache_buf);
     free(handle->rsa_pem);
     free(handle);
     return ESP_OK;
 }
 
+esp_err_t esp_encrypted_img_export_key(esp_decrypt_handle_t ctx, esp_encrypted_img_key_t *key)
+{
+    esp_encrypted_img_t *handle = (esp_encrypted_img_t *)ctx;
+    if (handle == NULL || key == NULL) {
+        ESP_LOGE(TAG, "esp_encrypted_img_export_key: Invalid argument");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->state == ESP_PRE_ENC_IMG_READ_MAGIC || handle->state == ESP_PRE_ENC_IMG_READ_GCM) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    memcpy(key->key, handle->gcm_key, GCM_KEY_SIZE);
+    memcpy(key->enc_key_digest, handle->enc_key_digest, ESP_ENCRYPTED_IMG_KEY_DIGEST_SIZE);
+    return ESP_OK;
+}
+
 uint16_t esp_encrypted_img_get_header_size(void)
 {
     return HEADER_DATA_SIZE;
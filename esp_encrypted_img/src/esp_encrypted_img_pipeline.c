@@ -0,0 +1,224 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_encrypted_img.h"
+#include <esp_log.h>
+#include <esp_err.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "sys/param.h"
+
+static const char *TAG = "esp_encrypted_img";
+
+#define PIPELINE_BLOCKS     2
+
+typedef struct {
+    char *buf;
+    size_t len;     /* A NULL buf stops the write task */
+} pipeline_block_t;
+
+typedef struct {
+    esp_decrypt_handle_t decrypt_handle;
+    esp_encrypted_img_write_cb_t write_cb;
+    void *user_data;
+    size_t block_size;
+    char *blocks[PIPELINE_BLOCKS];
+    QueueHandle_t free_queue;       /* Blocks that can be decrypted into */
+    QueueHandle_t full_queue;       /* Blocks waiting to be written */
+    SemaphoreHandle_t done;
+    bool running;
+    volatile bool discard;
+    volatile esp_err_t write_err;
+    pipeline_block_t cur;
+} esp_encrypted_img_pipeline_t;
+
+static void pipeline_task(void *arg)
+{
+    esp_encrypted_img_pipeline_t *pipe = (esp_encrypted_img_pipeline_t *)arg;
+    pipeline_block_t block;
+    while (xQueueReceive(pipe->full_queue, &block, portMAX_DELAY) == pdTRUE && block.buf) {
+        // Keep returning blocks after an error, so that esp_encrypted_img_pipeline_write() never blocks forever
+        if (pipe->write_err == ESP_OK && !pipe->discard) {
+            pipe->write_err = pipe->write_cb(block.buf, block.len, pipe->user_data);
+            if (pipe->write_err != ESP_OK) {
+                ESP_LOGE(TAG, "Write callback failed: %s", esp_err_to_name(pipe->write_err));
+            }
+        }
+        xQueueSend(pipe->free_queue, &block.buf, portMAX_DELAY);
+    }
+    xSemaphoreGive(pipe->done);
+    vTaskDelete(NULL);
+}
+
+static void pipeline_stop(esp_encrypted_img_pipeline_t *pipe)
+{
+    if (pipe->running) {
+        if (pipe->cur.buf && pipe->cur.len && !pipe->discard) {
+            xQueueSend(pipe->full_queue, &pipe->cur, portMAX_DELAY);
+            pipe->cur.buf = NULL;
+        }
+        pipeline_block_t stop = { 0 };
+        xQueueSend(pipe->full_queue, &stop, portMAX_DELAY);
+        xSemaphoreTake(pipe->done, portMAX_DELAY);
+        pipe->running = false;
+    }
+}
+
+static void pipeline_free(esp_encrypted_img_pipeline_t *pipe)
+{
+    if (pipe->full_queue) {
+        vQueueDelete(pipe->full_queue);
+    }
+    if (pipe->free_queue) {
+        vQueueDelete(pipe->free_queue);
+    }
+    if (pipe->done) {
+        vSemaphoreDelete(pipe->done);
+    }
+    for (int i = 0; i < PIPELINE_BLOCKS; i++) {
+        free(pipe->blocks[i]);
+    }
+    free(pipe);
+}
+
+esp_encrypted_img_pipeline_handle_t esp_encrypted_img_pipeline_start(const esp_encrypted_img_pipeline_cfg_t *cfg)
+{
+    if (cfg == NULL || cfg->write_cb == NULL) {
+        ESP_LOGE(TAG, "esp_encrypted_img_pipeline_start : Invalid argument");
+        return NULL;
+    }
+    esp_encrypted_img_pipeline_t *pipe = calloc(1, sizeof(esp_encrypted_img_pipeline_t));
+    if (!pipe) {
+        ESP_LOGE(TAG, "Couldn't allocate memory to pipeline");
+        return NULL;
+    }
+    pipe->write_cb = cfg->write_cb;
+    pipe->user_data = cfg->user_data;
+    pipe->block_size = cfg->block_size ? cfg->block_size : ESP_ENCRYPTED_IMG_PIPELINE_DEFAULT_BLOCK_SIZE;
+
+    pipe->free_queue = xQueueCreate(PIPELINE_BLOCKS, sizeof(char *));
+    pipe->full_queue = xQueueCreate(PIPELINE_BLOCKS + 1, sizeof(pipeline_block_t));
+    pipe->done = xSemaphoreCreateBinary();
+    if (!pipe->free_queue || !pipe->full_queue || !pipe->done) {
+        ESP_LOGE(TAG, "Couldn't allocate memory to pipeline");
+        goto failure;
+    }
+    for (int i = 0; i < PIPELINE_BLOCKS; i++) {
+        pipe->blocks[i] = malloc(pipe->block_size);
+        if (!pipe->blocks[i]) {
+            ESP_LOGE(TAG, "Couldn't allocate memory to pipeline blocks");
+            goto failure;
+        }
+        xQueueSend(pipe->free_queue, &pipe->blocks[i], 0);
+    }
+
+    // Decrypted data is copied to the blocks, so let the decrypt handle reuse its own output buffer
+    esp_decrypt_cfg_t decrypt_cfg = cfg->decrypt_cfg;
+    decrypt_cfg.data_out_buf_size = pipe->block_size + CONFIG_ESP_ENCRYPTED_IMG_DECRYPT_BATCH_SIZE;
+    pipe->decrypt_handle = esp_encrypted_img_decrypt_start(&decrypt_cfg);
+    if (!pipe->decrypt_handle) {
+        goto failure;
+    }
+
+    uint32_t stack_size = cfg->task_stack_size ? cfg->task_stack_size : ESP_ENCRYPTED_IMG_PIPELINE_DEFAULT_TASK_STACK_SIZE;
+    UBaseType_t priority = cfg->task_priority ? cfg->task_priority : uxTaskPriorityGet(NULL);
+    if (xTaskCreatePinnedToCore(pipeline_task, "enc_img_write", stack_size, pipe, priority, NULL,
+                                cfg->task_core_id) != pdPASS) {
+        ESP_LOGE(TAG, "Couldn't create write task");
+        esp_encrypted_img_decrypt_abort(pipe->decrypt_handle);
+        goto failure;
+    }
+    pipe->running = true;
+    return (esp_encrypted_img_pipeline_handle_t)pipe;
+
+failure:
+    pipeline_free(pipe);
+    return NULL;
+}
+
+esp_err_t esp_encrypted_img_pipeline_write(esp_encrypted_img_pipeline_handle_t handle, const char *data, size_t len)
+{
+    esp_encrypted_img_pipeline_t *pipe = (esp_encrypted_img_pipeline_t *)handle;
+    if (pipe == NULL || data == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (pipe->write_err != ESP_OK) {
+        return pipe->write_err;
+    }
+
+    pre_enc_decrypt_arg_t args = {
+        .data_in = data,
+        .data_in_len = len,
+    };
+    esp_err_t err = esp_encrypted_img_decrypt_data(pipe->decrypt_handle, &args);
+    if (err != ESP_OK && err != ESP_ERR_NOT_FINISHED) {
+        return err;
+    }
+
+    const char *out = args.data_out;
+    size_t out_len = args.data_out_len;
+    while (out_len > 0) {
+        if (!pipe->cur.buf) {
+            xQueueReceive(pipe->free_queue, &pipe->cur.buf, portMAX_DELAY);
+            pipe->cur.len = 0;
+            if (pipe->write_err != ESP_OK) {
+                return pipe->write_err;
+            }
+        }
+        size_t copy_len = MIN(pipe->block_size - pipe->cur.len, out_len);
+        memcpy(pipe->cur.buf + pipe->cur.len, out, copy_len);
+        pipe->cur.len += copy_len;
+        out += copy_len;
+        out_len -= copy_len;
+        if (pipe->cur.len == pipe->block_size) {
+            xQueueSend(pipe->full_queue, &pipe->cur, portMAX_DELAY);
+            pipe->cur.buf = NULL;
+        }
+    }
+    return err;
+}
+
+esp_err_t esp_encrypted_img_pipeline_end(esp_encrypted_img_pipeline_handle_t handle)
+{
+    esp_encrypted_img_pipeline_t *pipe = (esp_encrypted_img_pipeline_t *)handle;
+    if (pipe == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err;
+    if (!esp_encrypted_img_is_complete_data_received(pipe->decrypt_handle)) {
+        ESP_LOGE(TAG, "Image is incomplete");
+        pipe->discard = true;
+        pipeline_stop(pipe);
+        esp_encrypted_img_decrypt_abort(pipe->decrypt_handle);
+        err = ESP_FAIL;
+    } else {
+        pipeline_stop(pipe);
+        err = esp_encrypted_img_decrypt_end(pipe->decrypt_handle);
+        if (err == ESP_OK) {
+            err = pipe->write_err;
+        }
+    }
+    pipeline_free(pipe);
+    return err;
+}
+
+esp_err_t esp_encrypted_img_pipeline_abort(esp_encrypted_img_pipeline_handle_t handle)
+{
+    esp_encrypted_img_pipeline_t *pipe = (esp_encrypted_img_pipeline_t *)handle;
+    if (pipe == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pipe->discard = true;
+    pipeline_stop(pipe);
+    esp_encrypted_img_decrypt_abort(pipe->decrypt_handle);
+    pipeline_free(pipe);
+    return ESP_OK;
+}
@@ -4,7 +4,11 @@
  * SPDX-License-Identifier: Unlicense OR CC0-1.0
  */
 #include <stdio.h>
+#include <string.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
 #include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 #include "unity.h"
 #if __has_include("esp_random.h")
@@ -20,6 +24,15 @@ extern const uint8_t rsa_private_pem_end[]   asm("_binary_test_rsa_private_key_p
 extern const uint8_t bin_start[] asm("_binary_image_bin_start");
 extern const uint8_t bin_end[]   asm("_binary_image_bin_end");
 
+extern const uint8_t x25519_private_key_start[] asm("_binary_test_x25519_private_key_bin_start");
+
+extern const uint8_t x25519_bin_start[] asm("_binary_image_x25519_bin_start");
+extern const uint8_t x25519_bin_end[]   asm("_binary_image_x25519_bin_end");
+
+// image.bin encrypted again with --chunk-size 1024
+extern const uint8_t chunked_bin_start[] asm("_binary_image_chunked_bin_start");
+extern const uint8_t chunked_bin_end[]   asm("_binary_image_chunked_bin_end");
+
 TEST_CASE("Sending all data at once", "[encrypted_img]")
 {
     esp_decrypt_cfg_t cfg = {
@@ -357,3 +370,289 @@ TEST_CASE("Test canceling decryption frees memory", "[encrypted_img]")
     // +/- 16 bytes to allow for some small fluctuations
     TEST_ASSERT(abs(free_bytes_start - free_bytes_end) <= 16);
 }
+
+TEST_CASE("Sending data in chunks larger than the decryption batch", "[encrypted_img]")
+{
+    esp_decrypt_cfg_t cfg = {
+        .rsa_priv_key = (char *)rsa_private_pem_start,
+        .rsa_priv_key_len = rsa_private_pem_end - rsa_private_pem_start,
+    };
+    esp_decrypt_handle_t ctx = esp_encrypted_img_decrypt_start(&cfg);
+    TEST_ASSERT_NOT_NULL(ctx);
+
+    pre_enc_decrypt_arg_t *args = calloc(1, sizeof(pre_enc_decrypt_arg_t));
+    TEST_ASSERT_NOT_NULL(args);
+
+    esp_err_t err;
+    const int chunk_size = CONFIG_ESP_ENCRYPTED_IMG_DECRYPT_BATCH_SIZE + 1000;
+    int decrypted = 0;
+    int i = 0;
+    do {
+        int x = MIN(chunk_size, (bin_end - bin_start) - i);
+        args->data_in = (char *)(bin_start + i);
+        i += x;
+        args->data_in_len = x;
+        err = esp_encrypted_img_decrypt_data(ctx, args);
+        if (err == ESP_FAIL) {
+            printf("ESP_FAIL ERROR\n");
+            break;
+        }
+        decrypted += args->data_out_len;
+    } while (err != ESP_OK);
+
+    TEST_ESP_OK(err);
+    TEST_ASSERT_EQUAL_INT((bin_end - bin_start) - esp_encrypted_img_get_header_size(), decrypted);
+
+    err = esp_encrypted_img_decrypt_end(ctx);
+    TEST_ESP_OK(err);
+    if (args->data_out) {
+        free(args->data_out);
+    }
+    free(args);
+}
+
+TEST_CASE("Decrypting into the handle's output buffer", "[encrypted_img]")
+{
+    const int chunk_size = 1024;
+    esp_decrypt_cfg_t cfg = {
+        .rsa_priv_key = (char *)rsa_private_pem_start,
+        .rsa_priv_key_len = rsa_private_pem_end - rsa_private_pem_start,
+        .data_out_buf_size = chunk_size + CONFIG_ESP_ENCRYPTED_IMG_DECRYPT_BATCH_SIZE,
+    };
+    esp_decrypt_handle_t ctx = esp_encrypted_img_decrypt_start(&cfg);
+    TEST_ASSERT_NOT_NULL(ctx);
+
+    pre_enc_decrypt_arg_t args = { 0 };
+    esp_err_t err;
+    char *data_out = NULL;
+    int decrypted = 0;
+    int i = 0;
+    do {
+        int x = MIN(chunk_size, (bin_end - bin_start) - i);
+        args.data_in = (char *)(bin_start + i);
+        i += x;
+        args.data_in_len = x;
+        err = esp_encrypted_img_decrypt_data(ctx, &args);
+        if (err == ESP_FAIL) {
+            printf("ESP_FAIL ERROR\n");
+            break;
+        }
+        if (args.data_out_len > 0) {
+            // The same buffer is used for every call
+            TEST_ASSERT_TRUE(args.data_out_owned);
+            if (data_out) {
+                TEST_ASSERT_EQUAL_PTR(data_out, args.data_out);
+            }
+            data_out = args.data_out;
+            decrypted += args.data_out_len;
+        }
+    } while (err != ESP_OK);
+
+    TEST_ESP_OK(err);
+    TEST_ASSERT_EQUAL_INT((bin_end - bin_start) - esp_encrypted_img_get_header_size(), decrypted);
+
+    // The output buffer is freed with the handle
+    err = esp_encrypted_img_decrypt_end(ctx);
+    TEST_ESP_OK(err);
+}
+
+TEST_CASE("Decrypting again with an exported key", "[encrypted_img]")
+{
+    esp_decrypt_cfg_t cfg = {
+        .rsa_priv_key = (char *)rsa_private_pem_start,
+        .rsa_priv_key_len = rsa_private_pem_end - rsa_private_pem_start,
+    };
+    esp_decrypt_handle_t ctx = esp_encrypted_img_decrypt_start(&cfg);
+    TEST_ASSERT_NOT_NULL(ctx);
+
+    esp_encrypted_img_key_t key;
+    TEST_ESP_ERR(ESP_ERR_INVALID_STATE, esp_encrypted_img_export_key(ctx, &key));
+
+    pre_enc_decrypt_arg_t args = {
+        .data_in = (char *)bin_start,
+        .data_in_len = bin_end - bin_start,
+    };
+    TEST_ESP_OK(esp_encrypted_img_decrypt_data(ctx, &args));
+    TEST_ESP_OK(esp_encrypted_img_export_key(ctx, &key));
+    TEST_ESP_OK(esp_encrypted_img_decrypt_end(ctx));
+    free(args.data_out);
+
+    // Without the RSA key, the image is decrypted with the exported key only
+    esp_decrypt_cfg_t key_cfg = {
+        .gcm_key = &key,
+    };
+    ctx = esp_encrypted_img_decrypt_start(&key_cfg);
+    TEST_ASSERT_NOT_NULL(ctx);
+    memset(&args, 0, sizeof(args));
+    args.data_in = (char *)bin_start;
+    args.data_in_len = bin_end - bin_start;
+    TEST_ESP_OK(esp_encrypted_img_decrypt_data(ctx, &args));
+    TEST_ESP_OK(esp_encrypted_img_decrypt_end(ctx));
+    free(args.data_out);
+
+    // A key that does not belong to the image is refused
+    key.enc_key_digest[0] ^= 0xff;
+    ctx = esp_encrypted_img_decrypt_start(&key_cfg);
+    TEST_ASSERT_NOT_NULL(ctx);
+    memset(&args, 0, sizeof(args));
+    args.data_in = (char *)bin_start;
+    args.data_in_len = bin_end - bin_start;
+    TEST_ESP_ERR(ESP_FAIL, esp_encrypted_img_decrypt_data(ctx, &args));
+    TEST_ESP_OK(esp_encrypted_img_decrypt_abort(ctx));
+}
+
+TEST_CASE("Decrypting an image encrypted with an X25519 key", "[encrypted_img]")
+{
+    esp_decrypt_cfg_t cfg = {
+        .x25519_priv_key = x25519_private_key_start,
+    };
+    esp_decrypt_handle_t ctx = esp_encrypted_img_decrypt_start(&cfg);
+    TEST_ASSERT_NOT_NULL(ctx);
+
+    pre_enc_decrypt_arg_t args = { 0 };
+    esp_err_t err;
+    int decrypted = 0;
+    int i = 0;
+    do {
+        int x = MIN(100, (x25519_bin_end - x25519_bin_start) - i);
+        args.data_in = (char *)(x25519_bin_start + i);
+        i += x;
+        args.data_in_len = x;
+        err = esp_encrypted_img_decrypt_data(ctx, &args);
+        if (err == ESP_FAIL) {
+            printf("ESP_FAIL ERROR\n");
+            break;
+        }
+        decrypted += args.data_out_len;
+    } while (err != ESP_OK);
+
+    TEST_ESP_OK(err);
+    TEST_ASSERT_EQUAL_INT((x25519_bin_end - x25519_bin_start) - esp_encrypted_img_get_header_size(), decrypted);
+    err = esp_encrypted_img_decrypt_end(ctx);
+    TEST_ESP_OK(err);
+    free(args.data_out);
+
+    // The RSA key cannot decrypt it
+    esp_decrypt_cfg_t rsa_cfg = {
+        .rsa_priv_key = (char *)rsa_private_pem_start,
+        .rsa_priv_key_len = rsa_private_pem_end - rsa_private_pem_start,
+    };
+    ctx = esp_encrypted_img_decrypt_start(&rsa_cfg);
+    TEST_ASSERT_NOT_NULL(ctx);
+    memset(&args, 0, sizeof(args));
+    args.data_in = (char *)x25519_bin_start;
+    args.data_in_len = x25519_bin_end - x25519_bin_start;
+    TEST_ESP_ERR(ESP_FAIL, esp_encrypted_img_decrypt_data(ctx, &args));
+    TEST_ESP_OK(esp_encrypted_img_decrypt_abort(ctx));
+}
+
+TEST_CASE("Decrypting an image authenticated in chunks", "[encrypted_img]")
+{
+    const int chunk_size = 1024;
+    const int image_size = chunked_bin_end - chunked_bin_start;
+    const int data_size = image_size - esp_encrypted_img_get_header_size();
+    const int num_chunks = (data_size + chunk_size + 16 - 1) / (chunk_size + 16);
+    esp_decrypt_cfg_t cfg = {
+        .rsa_priv_key = (char *)rsa_private_pem_start,
+        .rsa_priv_key_len = rsa_private_pem_end - rsa_private_pem_start,
+    };
+    esp_decrypt_handle_t ctx = esp_encrypted_img_decrypt_start(&cfg);
+    TEST_ASSERT_NOT_NULL(ctx);
+
+    pre_enc_decrypt_arg_t args = { 0 };
+    esp_err_t err;
+    int decrypted = 0;
+    int i = 0;
+    do {
+        int x = MIN(100, image_size - i);
+        args.data_in = (char *)(chunked_bin_start + i);
+        i += x;
+        args.data_in_len = x;
+        err = esp_encrypted_img_decrypt_data(ctx, &args);
+        if (err == ESP_FAIL) {
+            printf("ESP_FAIL ERROR\n");
+            break;
+        }
+        decrypted += args.data_out_len;
+    } while (err != ESP_OK);
+
+    TEST_ESP_OK(err);
+    TEST_ASSERT_EQUAL_INT(data_size - num_chunks * 16, decrypted);
+    TEST_ASSERT_TRUE(esp_encrypted_img_is_complete_data_received(ctx));
+    err = esp_encrypted_img_decrypt_end(ctx);
+    TEST_ESP_OK(err);
+    free(args.data_out);
+
+    // A corrupted first chunk is rejected as soon as its tag is received, not at the end of the image
+    uint8_t *image = malloc(image_size);
+    TEST_ASSERT_NOT_NULL(image);
+    memcpy(image, chunked_bin_start, image_size);
+    image[esp_encrypted_img_get_header_size() + 10] ^= 0x01;
+
+    ctx = esp_encrypted_img_decrypt_start(&cfg);
+    TEST_ASSERT_NOT_NULL(ctx);
+    memset(&args, 0, sizeof(args));
+    i = 0;
+    do {
+        int x = MIN(100, image_size - i);
+        args.data_in = (char *)(image + i);
+        i += x;
+        args.data_in_len = x;
+        err = esp_encrypted_img_decrypt_data(ctx, &args);
+        free(args.data_out);
+        args.data_out = NULL;
+    } while (err == ESP_ERR_NOT_FINISHED);
+
+    TEST_ESP_ERR(ESP_FAIL, err);
+    TEST_ASSERT_LESS_OR_EQUAL(esp_encrypted_img_get_header_size() + chunk_size + 16 + 100, i);
+    TEST_ESP_OK(esp_encrypted_img_decrypt_abort(ctx));
+
+    // Truncating the image by a whole chunk is detected too
+    memcpy(image, chunked_bin_start, image_size);
+    ctx = esp_encrypted_img_decrypt_start(&cfg);
+    TEST_ASSERT_NOT_NULL(ctx);
+    memset(&args, 0, sizeof(args));
+    args.data_in = (char *)image;
+    args.data_in_len = image_size - (chunk_size + 16);
+    TEST_ESP_ERR(ESP_ERR_NOT_FINISHED, esp_encrypted_img_decrypt_data(ctx, &args));
+    free(args.data_out);
+    TEST_ASSERT_FALSE(esp_encrypted_img_is_complete_data_received(ctx));
+    TEST_ASSERT_NOT_EQUAL(ESP_OK, esp_encrypted_img_decrypt_end(ctx));
+    free(image);
+}
+
+static esp_err_t pipeline_write_cb(const char *data, size_t len, void *user_data)
+{
+    TEST_ASSERT_LESS_OR_EQUAL(1024, len);
+    *(size_t *)user_data += len;
+    return ESP_OK;
+}
+
+TEST_CASE("Decrypting through the decrypt pipeline", "[encrypted_img]")
+{
+    size_t written = 0;
+    esp_encrypted_img_pipeline_cfg_t cfg = {
+        .decrypt_cfg = {
+            .rsa_priv_key = (char *)rsa_private_pem_start,
+            .rsa_priv_key_len = rsa_private_pem_end - rsa_private_pem_start,
+        },
+        .write_cb = pipeline_write_cb,
+        .user_data = &written,
+        .block_size = 1024,
+        .task_core_id = tskNO_AFFINITY,
+    };
+    esp_encrypted_img_pipeline_handle_t pipe = esp_encrypted_img_pipeline_start(&cfg);
+    TEST_ASSERT_NOT_NULL(pipe);
+
+    esp_err_t err;
+    int i = 0;
+    do {
+        int x = MIN(700, (bin_end - bin_start) - i);
+        err = esp_encrypted_img_pipeline_write(pipe, (const char *)(bin_start + i), x);
+        i += x;
+    } while (err == ESP_ERR_NOT_FINISHED);
+    TEST_ESP_OK(err);
+
+    TEST_ESP_OK(esp_encrypted_img_pipeline_end(pipe));
+    TEST_ASSERT_EQUAL_INT((bin_end - bin_start) - esp_encrypted_img_get_header_size(), written);
+}
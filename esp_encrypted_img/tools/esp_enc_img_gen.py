@@ -1,7 +1,7 @@
 #!/usr/bin/env python
 #
 # Encrypted image generation tool. This tool helps in generating encrypted binary image
-# in pre-defined format with assistance of RSA-3072 bit key.
+# in pre-defined format with assistance of RSA-3072 bit key or X25519 key.
 #
 # SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: Apache-2.0
@@ -10,12 +10,19 @@ import argparse
 import os
 import sys
 
-from cryptography.hazmat.primitives import serialization
-from cryptography.hazmat.primitives.asymmetric import padding
+from cryptography.hazmat.primitives import hashes, serialization
+from cryptography.hazmat.primitives.asymmetric import padding, x25519
 from cryptography.hazmat.primitives.ciphers.aead import AESGCM
+from cryptography.hazmat.primitives.kdf.hkdf import HKDF
 
 # Magic Byte is created using command: echo -n "esp_encrypted_img" | sha256sum
 esp_enc_img_magic = 0x0788b6cf
+# Magic Byte is created using command: echo -n "esp_encrypted_img_x25519" | sha256sum
+esp_enc_img_x25519_magic = 0x327c4619
+# Magic Byte is created using command: echo -n "esp_encrypted_img_chunked" | sha256sum
+esp_enc_img_chunked_magic = 0x8edc50b5
+# Magic Byte is created using command: echo -n "esp_encrypted_img_x25519_chunked" | sha256sum
+esp_enc_img_x25519_chunked_magic = 0x66555f5e
 
 GCM_KEY_SIZE = 32
 MAGIC_SIZE = 4
@@ -25,6 +32,13 @@ BIN_SIZE_DATA = 4
 AUTH_SIZE = 16
 RESERVED_HEADER = (512 - (MAGIC_SIZE + ENC_GCM_KEY_SIZE + IV_SIZE + BIN_SIZE_DATA + AUTH_SIZE))
 
+X25519_KEY_SIZE = 32
+X25519_WRAP_IV = bytes(12)
+X25519_HKDF_INFO = b'esp_encrypted_img x25519'
+
+CHUNK_SIZE_DATA = 4
+CHUNK_NONCE_PREFIX_SIZE = 7
+
 
 def generate_key_GCM(size: int) -> bytes:
     return os.urandom(int(size))
@@ -40,7 +54,57 @@ def encrypt_binary(plaintext: bytes, key: bytes, IV: bytes) -> tuple:
     return ct[:len(plaintext)], ct[len(plaintext):]
 
 
-def encrypt(input_file: str, rsa_key_file_name: str, output_file: str) -> None:
+def chunk_nonce(IV: bytes, index: int, last: bool) -> bytes:
+    return IV[:CHUNK_NONCE_PREFIX_SIZE] + index.to_bytes(4, 'big') + (b'\x01' if last else b'\x00')
+
+
+def chunk_aad(bin_size: int, chunk_size: int) -> bytes:
+    return bin_size.to_bytes(BIN_SIZE_DATA, 'little') + chunk_size.to_bytes(CHUNK_SIZE_DATA, 'little')
+
+
+def encrypt_binary_chunked(plaintext: bytes, key: bytes, IV: bytes, chunk_size: int) -> bytes:
+    # Every chunk is followed by its own tag, so that the device rejects a corrupted image early
+    encobj = AESGCM(key)
+    aad = chunk_aad(len(plaintext), chunk_size)
+    count = (len(plaintext) + chunk_size - 1) // chunk_size
+    chunks = [encobj.encrypt(chunk_nonce(IV, i, i == count - 1), plaintext[i * chunk_size:(i + 1) * chunk_size], aad)
+              for i in range(count)]
+    return b''.join(chunks)
+
+
+def decrypt_binary_chunked(data: bytes, bin_size: int, key: bytes, IV: bytes, chunk_size: int) -> bytes:
+    encobj = AESGCM(key)
+    aad = chunk_aad(bin_size, chunk_size)
+    count = (bin_size + chunk_size - 1) // chunk_size
+    plaintext = b''
+    for i in range(count):
+        chunk = data[i * (chunk_size + AUTH_SIZE):(i + 1) * (chunk_size + AUTH_SIZE)]
+        plaintext += encobj.decrypt(chunk_nonce(IV, i, i == count - 1), chunk, aad)
+    return plaintext
+
+
+def x25519_kek(shared_secret: bytes, ephemeral_public_key: bytes) -> bytes:
+    return HKDF(algorithm=hashes.SHA256(), length=GCM_KEY_SIZE, salt=ephemeral_public_key,
+                info=X25519_HKDF_INFO).derive(shared_secret)
+
+
+def wrap_key_x25519(gcm_key: bytes, public_key: x25519.X25519PublicKey) -> bytes:
+    # The ephemeral public key is followed by the GCM key and its tag, encrypted with the derived key
+    ephemeral_key = x25519.X25519PrivateKey.generate()
+    ephemeral_public_key = ephemeral_key.public_key().public_bytes(serialization.Encoding.Raw, serialization.PublicFormat.Raw)
+    kek = x25519_kek(ephemeral_key.exchange(public_key), ephemeral_public_key)
+    wrapped_key = ephemeral_public_key + AESGCM(kek).encrypt(X25519_WRAP_IV, gcm_key, None)
+    return wrapped_key + bytearray(ENC_GCM_KEY_SIZE - len(wrapped_key))
+
+
+def unwrap_key_x25519(encrypted_gcm_key: bytes, private_key: x25519.X25519PrivateKey) -> bytes:
+    ephemeral_public_key = encrypted_gcm_key[:X25519_KEY_SIZE]
+    shared_secret = private_key.exchange(x25519.X25519PublicKey.from_public_bytes(ephemeral_public_key))
+    kek = x25519_kek(shared_secret, ephemeral_public_key)
+    return AESGCM(kek).decrypt(X25519_WRAP_IV, encrypted_gcm_key[X25519_KEY_SIZE:X25519_KEY_SIZE + GCM_KEY_SIZE + AUTH_SIZE], None)
+
+
+def encrypt(input_file: str, rsa_key_file_name: str, output_file: str, chunk_size: int = 0) -> None:
     print('Encrypting image ...')
     with open(input_file, 'rb') as image:
         data = image.read()
@@ -59,16 +123,27 @@ def encrypt(input_file: str, rsa_key_file_name: str, output_file: str) -> None:
     gcm_key = generate_key_GCM(GCM_KEY_SIZE)
     iv = generate_IV_GCM()
 
-    encrypted_gcm_key = public_key.encrypt(gcm_key, padding.PKCS1v15())
-    ciphertext, authtag = encrypt_binary(data, gcm_key, iv)
+    if isinstance(public_key, x25519.X25519PublicKey):
+        magic = esp_enc_img_x25519_chunked_magic if chunk_size else esp_enc_img_x25519_magic
+        encrypted_gcm_key = wrap_key_x25519(gcm_key, public_key)
+    else:
+        magic = esp_enc_img_chunked_magic if chunk_size else esp_enc_img_magic
+        encrypted_gcm_key = public_key.encrypt(gcm_key, padding.PKCS1v15())
+    if chunk_size:
+        # The tag of each chunk follows it, the auth field of the header is unused
+        ciphertext, authtag = encrypt_binary_chunked(data, gcm_key, iv, chunk_size), bytes(AUTH_SIZE)
+        extra_header = chunk_size.to_bytes(CHUNK_SIZE_DATA, 'little') + bytearray(RESERVED_HEADER - CHUNK_SIZE_DATA)
+    else:
+        ciphertext, authtag = encrypt_binary(data, gcm_key, iv)
+        extra_header = bytearray(RESERVED_HEADER)
 
     with open(output_file, 'wb') as image:
-        image.write(esp_enc_img_magic.to_bytes(MAGIC_SIZE, 'little'))
+        image.write(magic.to_bytes(MAGIC_SIZE, 'little'))
         image.write((encrypted_gcm_key))
         image.write((iv))
-        image.write(len(ciphertext).to_bytes(BIN_SIZE_DATA, 'little'))
+        image.write(len(data).to_bytes(BIN_SIZE_DATA, 'little'))
         image.write(authtag)
-        image.write(bytearray(RESERVED_HEADER))
+        image.write(extra_header)
         image.write(ciphertext)
 
     print('Done')
@@ -86,23 +161,33 @@ def decrypt(input_file: str, rsa_key: str, output_file: str) -> None:
         private_key = serialization.load_pem_private_key(key_file.read(), password=None)
 
     with open(input_file, 'rb') as file:
-        recv_magic = file.read(MAGIC_SIZE)
-        if(int.from_bytes(recv_magic, 'little') != esp_enc_img_magic):
+        recv_magic = int.from_bytes(file.read(MAGIC_SIZE), 'little')
+        if(recv_magic not in (esp_enc_img_magic, esp_enc_img_x25519_magic, esp_enc_img_chunked_magic, esp_enc_img_x25519_chunked_magic)):
             print('Error: Magic Verification Failed', file=sys.stderr)
             raise SystemExit(1)
         print('Magic verified successfully')
 
         encrypted_gcm_key = file.read(ENC_GCM_KEY_SIZE)
-        gcm_key = private_key.decrypt(encrypted_gcm_key, padding.PKCS1v15())
+        if(recv_magic in (esp_enc_img_x25519_magic, esp_enc_img_x25519_chunked_magic)):
+            if not isinstance(private_key, x25519.X25519PrivateKey):
+                print('Error: The image was encrypted with an X25519 key', file=sys.stderr)
+                raise SystemExit(1)
+            gcm_key = unwrap_key_x25519(encrypted_gcm_key, private_key)
+        else:
+            gcm_key = private_key.decrypt(encrypted_gcm_key, padding.PKCS1v15())
 
         iv = file.read(IV_SIZE)
         bin_size = int.from_bytes(file.read(BIN_SIZE_DATA), 'little')
         auth = file.read(AUTH_SIZE)
 
-        file.read(RESERVED_HEADER)
-        enc_bin = file.read(bin_size)
+        extra_header = file.read(RESERVED_HEADER)
+        enc_bin = file.read()
 
-    decrypted_binary = decrypt_binary(enc_bin, auth, gcm_key, iv)
+    if(recv_magic in (esp_enc_img_chunked_magic, esp_enc_img_x25519_chunked_magic)):
+        chunk_size = int.from_bytes(extra_header[:CHUNK_SIZE_DATA], 'little')
+        decrypted_binary = decrypt_binary_chunked(enc_bin, bin_size, gcm_key, iv, chunk_size)
+    else:
+        decrypted_binary = decrypt_binary(enc_bin[:bin_size], auth, gcm_key, iv)
 
     with open(output_file, 'wb') as file:
         file.write(decrypted_binary)
@@ -115,13 +200,19 @@ def main() -> None:
     subparsers.add_parser('encrypt', help='Encrypt an binary')
     subparsers.add_parser('decrypt', help='Decrypt an encrypted image')
     parser.add_argument('input_file')
-    parser.add_argument('RSA_key', help='Private key for decryption and Private/Public key for encryption')
+    parser.add_argument('RSA_key', help='Private key for decryption and Private/Public key for encryption, RSA-3072 or X25519')
     parser.add_argument('output_file_name')
+    parser.add_argument('--chunk-size', type=int, default=0,
+                        help='Encrypt the image in chunks of this size, each one with its own authentication tag, '
+                             'so that the device rejects a corrupted image early (e.g. 65536). 0 for one tag for the whole image')
 
     args = parser.parse_args()
 
     if(args.operation == 'encrypt'):
-        encrypt(args.input_file, args.RSA_key, args.output_file_name)
+        if args.chunk_size < 0 or args.chunk_size >= 1 << 32:
+            print('Error: Invalid chunk size', file=sys.stderr)
+            raise SystemExit(1)
+        encrypt(args.input_file, args.RSA_key, args.output_file_name, args.chunk_size)
     if(args.operation == 'decrypt'):
         decrypt(args.input_file, args.RSA_key, args.output_file_name)
 
@@ -6,12 +6,28 @@
 
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
 #include "esp_err.h"
+#include "sdkconfig.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Size of TJpgDec work buffer
+ *
+ * Independent on the size of the image. Table conversion for huffman decoding needs a bigger buffer.
+ */
+#if CONFIG_JD_FASTDECODE_TABLE
+#define ESP_JPEG_WORK_BUF_SIZE  65472
+#elif CONFIG_JD_FASTDECODE_32BIT
+#define ESP_JPEG_WORK_BUF_SIZE  3500
+#else
+#define ESP_JPEG_WORK_BUF_SIZE  3100
+#endif
+
 /**
  * @brief Scale of output image
  *
@@ -30,8 +46,49 @@ typedef enum {
 typedef enum {
     JPEG_IMAGE_FORMAT_RGB888 = 0,   /*!< Format RGB888 */
     JPEG_IMAGE_FORMAT_RGB565,       /*!< Format RGB565 */
+    JPEG_IMAGE_FORMAT_GRAY,         /*!< Format Grayscale (8-bit luma) */
+    JPEG_IMAGE_FORMAT_YUV422,       /*!< Format YUV422, packed as Y0 U Y1 V (YUYV) */
 } esp_jpeg_image_format_t;
 
+/**
+ * @brief Input stream callback
+ *
+ * Called by the decoder whenever it needs more compressed data. The decoder requests up to JD_SZBUF bytes at once.
+ *
+ * @param user_data: User data set in esp_jpeg_image_cfg_t::in_user_data
+ * @param buf: Buffer to be filled with data. If NULL, `len` bytes shall be skipped in the stream.
+ * @param len: Number of bytes requested
+ *
+ * @return Number of bytes read (or skipped). Value lower than `len` signals end of stream or an error.
+ */
+typedef uint32_t (*esp_jpeg_read_cb_t)(void *user_data, uint8_t *buf, uint32_t len);
+
+/**
+ * @brief Rectangle of the output image
+ *
+ */
+typedef struct {
+    uint16_t x;         /*!< Left column */
+    uint16_t y;         /*!< Top row */
+    uint16_t width;     /*!< Width of the rectangle in pixels */
+    uint16_t height;    /*!< Height of the rectangle in pixels */
+} esp_jpeg_rect_t;
+
+/**
+ * @brief Output band callback
+ *
+ * Called by the decoder each time one row of MCUs (band of 8 or 16 pixel rows before scaling) is decoded.
+ * The band spans the whole width of the output image (or crop rectangle).
+ *
+ * @param user_data: User data set in esp_jpeg_image_cfg_t::out_user_data
+ * @param rect: Position and size of the band in the output image
+ * @param pixels: Decoded pixels in selected output format, `rect->width * rect->height` pixels.
+ *                The buffer is reused for the next band, it is valid only until the callback returns.
+ *
+ * @return true to continue decoding, false to abort it
+ */
+typedef bool (*esp_jpeg_out_cb_t)(void *user_data, const esp_jpeg_rect_t *rect, const uint8_t *pixels);
+
 /**
  * @brief JPEG Configuration Type
  *
@@ -39,7 +96,7 @@ typedef enum {
 typedef struct esp_jpeg_image_cfg_s {
     uint8_t *indata;        /*!< Input JPEG image */
     uint32_t indata_size;   /*!< Size of input image  */
-    uint8_t *outbuf;        /*!< Output buffer */
+    uint8_t *outbuf;        /*!< Output buffer. With `out_cb`, it is used as band buffer (optional). */
     uint32_t outbuf_size;   /*!< Output buffer size */
     esp_jpeg_image_format_t out_format; /*!< Output image format */
     esp_jpeg_image_scale_t  out_scale; /*!< Output scale */
@@ -50,7 +107,15 @@ typedef struct esp_jpeg_image_cfg_s {
 
     struct {
         uint32_t read;  /*!< Internal count of read bytes */
+        uint8_t *band;  /*!< Internal band buffer for output callback */
     } priv;
+
+    esp_jpeg_read_cb_t in_cb; /*!< Input stream callback. If set, `indata` and `indata_size` are not used. */
+    void *in_user_data;     /*!< User data passed to `in_cb` */
+    esp_jpeg_out_cb_t out_cb; /*!< Output band callback. If set, the whole output image is not stored in `outbuf`. */
+    void *out_user_data;    /*!< User data passed to `out_cb` */
+    esp_jpeg_rect_t crop;   /*!< Crop rectangle in scaled image coordinates. Only this part of the image is decoded and output.
+                                 Zero width or height means whole image. */
 } esp_jpeg_image_cfg_t;
 
 /**
@@ -62,21 +127,153 @@ typedef struct esp_jpeg_image_output_s {
     uint16_t height;   /*!< Height of the output image */
 } esp_jpeg_image_output_t;
 
+/**
+ * @brief Chroma subsampling of JPEG image
+ *
+ */
+typedef enum {
+    JPEG_IMAGE_SUBSAMPLING_GRAY = 0, /*!< Grayscale image, no chroma */
+    JPEG_IMAGE_SUBSAMPLING_444,      /*!< No chroma subsampling */
+    JPEG_IMAGE_SUBSAMPLING_422,      /*!< Chroma subsampled 2:1 horizontally */
+    JPEG_IMAGE_SUBSAMPLING_420,      /*!< Chroma subsampled 2:1 horizontally and vertically */
+    JPEG_IMAGE_SUBSAMPLING_OTHER,    /*!< Other subsampling, not supported by the decoder */
+} esp_jpeg_image_subsampling_t;
+
+/**
+ * @brief JPEG image info, parsed from the headers only
+ *
+ */
+typedef struct {
+    uint16_t width;             /*!< Width of the image */
+    uint16_t height;            /*!< Height of the image */
+    uint8_t components;         /*!< Number of color components (1: grayscale, 3: YCbCr) */
+    esp_jpeg_image_subsampling_t subsampling; /*!< Chroma subsampling */
+    uint16_t restart_interval;  /*!< Restart interval in MCUs, 0 if not used */
+    bool supported;             /*!< The image can be decoded (baseline JPEG with supported subsampling) */
+    uint32_t output_size[JPEG_IMAGE_SCALE_1_8 + 1]; /*!< Output buffer size for `out_format`, indexed by esp_jpeg_image_scale_t */
+} esp_jpeg_image_info_t;
+
+/**
+ * @brief Get JPEG image info without decoding
+ *
+ * Only the JPEG segments before the start of scan are parsed. No memory is allocated.
+ *
+ * @note When the input callback is used, the input stream is consumed up to the start of scan.
+ *       It must be rewound before decoding the image.
+ *
+ * @param cfg: Configuration structure, only input and `out_format` are used
+ * @param info: Output image info
+ *
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if invalid argument
+ *      - ESP_FAIL              if the input is not a valid JPEG image
+ */
+esp_err_t esp_jpeg_get_image_info(esp_jpeg_image_cfg_t *cfg, esp_jpeg_image_info_t *info);
+
 /**
  * @brief Decode JPEG image
  *
  * @note This function is blocking.
+ * @note If `cfg->crop` is set, the output image (and `img`) has the size of the crop rectangle.
+ *       Blocks out of the rectangle are skipped and decoding stops after the last row of the rectangle.
+ * @note If `cfg->out_cb` is set, the image is passed to the callback in bands of MCU rows
+ *       and the output buffer needs only the size of one band (`width * MCU height * bytes per pixel`).
+ *       If `cfg->outbuf` is NULL or smaller than one band, the band buffer is allocated internally.
  *
  * @param cfg: Configuration structure
  * @param img: Output image info
  *
  * @return
  *      - ESP_OK            on success
+ *      - ESP_ERR_INVALID_ARG if there is no input data or input callback
+ *      - ESP_ERR_NOT_SUPPORTED if selected output format is not supported with current configuration
  *      - ESP_ERR_NO_MEM    if there is no memory for allocating main structure
- *      - ESP_FAIL          if there is an error in decoding JPEG
+ *      - ESP_FAIL          if there is an error in decoding JPEG or decoding was aborted by `out_cb`
  */
 esp_err_t esp_jpeg_decode(esp_jpeg_image_cfg_t *cfg, esp_jpeg_image_output_t *img);
 
+/**
+ * @brief Reusable JPEG decoder handle
+ *
+ */
+typedef struct esp_jpeg_decoder_s *esp_jpeg_decoder_handle_t;
+
+/**
+ * @brief JPEG decoder configuration
+ *
+ */
+typedef struct {
+    uint8_t *workbuf;       /*!< Work buffer (optional). If NULL, it is allocated with `caps`. */
+    uint32_t workbuf_size;  /*!< Size of work buffer, at least ESP_JPEG_WORK_BUF_SIZE */
+    uint32_t caps;          /*!< Memory caps (MALLOC_CAP_*) for decoder buffers. 0 means MALLOC_CAP_DEFAULT. */
+    struct {
+        uint8_t parallel: 1; /*!< Decode images with restart intervals on both cores, see esp_jpeg_decoder_decode() */
+        uint8_t stream: 1;   /*!< Stream mode for MJPEG frames: tables are kept between images, see esp_jpeg_decoder_decode() */
+    } flags;
+} esp_jpeg_decoder_config_t;
+
+/**
+ * @brief Create reusable JPEG decoder
+ *
+ * The decoder holds the work buffer and the decompressor state, so repeated decoding
+ * (e.g. slideshow or video frames) does not allocate memory for each image.
+ *
+ * @param config: Decoder configuration, can be NULL for default configuration
+ * @param ret_decoder: Returned decoder handle
+ *
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if invalid argument
+ *      - ESP_ERR_INVALID_SIZE  if user work buffer is too small
+ *      - ESP_ERR_NOT_SUPPORTED if parallel decoding is requested on single core or with the ROM decoder,
+ *                              or stream mode with the ROM decoder
+ *      - ESP_ERR_NO_MEM        if there is no memory for the decoder
+ */
+esp_err_t esp_jpeg_decoder_create(const esp_jpeg_decoder_config_t *config, esp_jpeg_decoder_handle_t *ret_decoder);
+
+/**
+ * @brief Decode JPEG image with reusable decoder
+ *
+ * Same as esp_jpeg_decode(), but buffers of the decoder are reused.
+ *
+ * With `flags.parallel`, images with restart intervals (DRI marker) are split in two slices of restart intervals,
+ * the second slice is decoded by a task on the other core into the same output buffer.
+ * Parallel decoding is used only for images in memory (`indata`) decoded to the output buffer (no `out_cb`),
+ * other images are decoded on the calling core.
+ *
+ * With `flags.stream`, the quantization and huffman tables are built in a buffer of the decoder and kept for the next image.
+ * DQT/DHT segments with the same content as in the previous image are not built again, and images without DHT segment
+ * (e.g. MJPEG frames of UVC cameras) are decoded with the standard huffman tables.
+ *
+ * @note The decoder must not be used from more tasks at once.
+ *
+ * @param decoder: Decoder handle
+ * @param cfg: Configuration structure
+ * @param img: Output image info
+ *
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED if selected output format is not supported with current configuration
+ *      - ESP_ERR_NO_MEM        if there is not enough size in the output buffer or no memory for band buffer
+ *      - ESP_FAIL              if there is an error in decoding JPEG or decoding was aborted by `out_cb`
+ */
+esp_err_t esp_jpeg_decoder_decode(esp_jpeg_decoder_handle_t decoder, esp_jpeg_image_cfg_t *cfg, esp_jpeg_image_output_t *img);
+
+/**
+ * @brief Destroy JPEG decoder
+ *
+ * User provided work buffer is not freed.
+ *
+ * @param decoder: Decoder handle
+ *
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if invalid argument
+ */
+esp_err_t esp_jpeg_decoder_destroy(esp_jpeg_decoder_handle_t decoder);
+
 #ifdef __cplusplus
 }
 #endif
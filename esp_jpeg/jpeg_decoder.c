@@ -6,7 +6,10 @@
 
 #include <string.h>
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_system.h"
+#include "esp_heap_caps.h"
 #include "esp_rom_caps.h"
 #include "esp_log.h"
 #include "esp_err.h"
@@ -33,15 +36,16 @@ typedef int jpeg_decode_out_t;
 
 static const char *TAG = "JPEG";
 
+#ifndef MIN
+#define MIN(a, b)       (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b)       (((a) > (b)) ? (a) : (b))
+#endif
+
 #define LOBYTE(u16)     ((uint8_t)(((uint16_t)(u16)) & 0xff))
 #define HIBYTE(u16)     ((uint8_t)((((uint16_t)(u16))>>8) & 0xff))
 
-#if defined(JD_FASTDECODE) && (JD_FASTDECODE == 2)
-#define JPEG_WORK_BUF_SIZE  65472
-#else
-#define JPEG_WORK_BUF_SIZE  3100    /* Recommended buffer size; Independent on the size of the image */
-#endif
-
 /* If not set JD_FORMAT, it is set in ROM to RGB888, otherwise, it can be set in config */
 #ifndef JD_FORMAT
 #define JD_FORMAT 0
@@ -53,8 +57,71 @@ static const char *TAG = "JPEG";
 #elif  (JD_FORMAT==1)
 #define ESP_JPEG_COLOR_BYTES    2
 #elif  (JD_FORMAT==2)
-#error Grayscale image output format is not supported
 #define ESP_JPEG_COLOR_BYTES    1
+#elif  (JD_FORMAT==3)
+#define ESP_JPEG_COLOR_BYTES    3
+#endif
+
+/* Maximum length of SOF segment content (4 components) */
+#define JPEG_SOF_MAX_LEN    (6 + 3 * 4)
+
+/* Parallel decoding of restart interval slices needs TJpgDec compiled from this component and a second core */
+#if !CONFIG_JD_USE_ROM && !CONFIG_FREERTOS_UNICORE && (portNUM_PROCESSORS > 1)
+#define JPEG_PARALLEL_SUPPORTED 1
+#else
+#define JPEG_PARALLEL_SUPPORTED 0
+#endif
+
+#define JPEG_SLICE_TASK_STACK_SIZE  3072
+
+/* Tables kept between images in stream mode: 4 quantization tables and 4 huffman tables of baseline JPEG,
+   plus the raw DQT/DHT segments of the previous image for comparison */
+#if CONFIG_JD_FASTDECODE_TABLE
+#define JPEG_STREAM_TBL_POOL_SIZE   (2304 + 6144)
+#else
+#define JPEG_STREAM_TBL_POOL_SIZE   2304
+#endif
+#define JPEG_STREAM_SEGS_SIZE       1024
+
+/* Row converter from TJpgDec output format to selected output format */
+typedef void (*jpeg_row_conv_t)(uint8_t *dst, const uint8_t *src, uint32_t x, uint32_t pixels);
+
+/* JPEG decoder context */
+struct esp_jpeg_decoder_s {
+    JDEC jdec;              /* TJpgDec decompressor object */
+    esp_jpeg_image_cfg_t *cfg; /* Configuration of the image being decoded */
+    jpeg_row_conv_t row_conv; /* Row converter selected for the image */
+    esp_jpeg_rect_t crop;   /* Decoded part of the image, in scaled coordinates */
+    JRECT roi;              /* Decoded part of the image, as TJpgDec rectangle */
+    bool roi_done;          /* Decoding was stopped below the decoded part */
+    uint8_t out_color_bytes; /* Bytes per pixel of the output image */
+    uint8_t *workbuf;       /* TJpgDec work buffer */
+    uint32_t workbuf_size;  /* Size of work buffer */
+    bool workbuf_owned;     /* Work buffer was allocated by the decoder */
+    uint32_t caps;          /* Memory caps for allocations */
+    uint8_t *band;          /* Band buffer for output callback */
+    uint32_t band_size;     /* Size of band buffer */
+#if !CONFIG_JD_USE_ROM
+    JDTBL *stream;          /* Tables kept between images in stream mode (NULL if not used) */
+#endif
+#if JPEG_PARALLEL_SUPPORTED
+    struct jpeg_slice_worker_s *worker; /* Decoder of the second slice on the other core (can be NULL) */
+#endif
+};
+
+#if JPEG_PARALLEL_SUPPORTED
+/* Worker decoding the second slice of restart intervals */
+typedef struct jpeg_slice_worker_s {
+    struct esp_jpeg_decoder_s dec; /* Own decoder context with own work buffer */
+    esp_jpeg_image_cfg_t cfg;   /* Copy of image configuration, with own input position */
+    uint32_t offset;            /* Input offset of the slice (behind the RST marker) */
+    uint16_t rsti;              /* First restart interval of the slice */
+    uint16_t nrsti;             /* Number of restart intervals in the slice */
+    JRESULT res;                /* Result of the slice decoding */
+    bool exit;                  /* Request to exit the task */
+    TaskHandle_t task;          /* Worker task */
+    SemaphoreHandle_t done;     /* Given by the worker when the slice is decoded */
+} jpeg_slice_worker_t;
 #endif
 
 /*******************************************************************************
@@ -62,51 +129,292 @@ static const char *TAG = "JPEG";
 *******************************************************************************/
 static uint8_t jpeg_get_div_by_scale(esp_jpeg_image_scale_t scale);
 static uint8_t jpeg_get_color_bytes(esp_jpeg_image_format_t format);
+static esp_jpeg_image_subsampling_t jpeg_get_subsampling(const uint8_t *sof, uint8_t components);
+#if (JD_FORMAT == 3)
+/* YCbCr from TJPGD, without color conversion */
+static void jpeg_row_ycbcr_to_gray(uint8_t *dst, const uint8_t *src, uint32_t x, uint32_t pixels)
+{
+    while (pixels--) {
+        *dst++ = src[0];
+        src += 3;
+    }
+}
+
+/* YUYV: chroma is shared by pixel pairs starting at even column of the output image */
+static void jpeg_row_ycbcr_to_yuv422(uint8_t *dst, const uint8_t *src, uint32_t x, uint32_t pixels)
+{
+    if (pixels && (x & 1)) {
+        /* Second pixel of a pair which started in the previous block */
+        dst[0] = src[0];
+        dst[1] = src[2];
+        dst += 2;
+        src += 3;
+        pixels--;
+    }
+    while (pixels >= 2) {
+        dst[0] = src[0];
+        dst[1] = (src[1] + src[4]) >> 1;
+        dst[2] = src[3];
+        dst[3] = (src[2] + src[5]) >> 1;
+        dst += 4;
+        src += 6;
+        pixels -= 2;
+    }
+    if (pixels) {
+        /* First pixel of a pair, which ends in the next block or at the right edge */
+        dst[0] = src[0];
+        dst[1] = src[1];
+    }
+}
+#endif
+
+static jpeg_row_conv_t jpeg_get_row_conv(const esp_jpeg_image_cfg_t *cfg);
+
+static esp_err_t jpeg_decoder_init(struct esp_jpeg_decoder_s *decoder, const esp_jpeg_decoder_config_t *config);
+static void jpeg_decoder_deinit(struct esp_jpeg_decoder_s *decoder);
+static JRESULT jpeg_prepare(struct esp_jpeg_decoder_s *decoder);
 
+#if JPEG_PARALLEL_SUPPORTED
+static esp_err_t jpeg_slice_worker_create(struct esp_jpeg_decoder_s *decoder, const esp_jpeg_decoder_config_t *config);
+static void jpeg_slice_worker_destroy(jpeg_slice_worker_t *worker);
+static JRESULT jpeg_decode_parallel(struct esp_jpeg_decoder_s *decoder);
+#endif
+
+static uint32_t jpeg_read_input(esp_jpeg_image_cfg_t *cfg, uint8_t *buff, uint32_t nbyte);
 static unsigned int jpeg_decode_in_cb(JDEC *jd, uint8_t *buff, unsigned int nbyte);
 static jpeg_decode_out_t jpeg_decode_out_cb(JDEC *jd, void *bitmap, JRECT *rect);
 /*******************************************************************************
 * Public API functions
 *******************************************************************************/
 
-esp_err_t esp_jpeg_decode(esp_jpeg_image_cfg_t *cfg, esp_jpeg_image_output_t *img)
+esp_err_t esp_jpeg_decoder_create(const esp_jpeg_decoder_config_t *config, esp_jpeg_decoder_handle_t *ret_decoder)
+{
+    esp_err_t ret = ESP_OK;
+    esp_jpeg_decoder_handle_t decoder = NULL;
+
+    ESP_RETURN_ON_FALSE(ret_decoder, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    decoder = heap_caps_calloc(1, sizeof(struct esp_jpeg_decoder_s), MALLOC_CAP_DEFAULT);
+    ESP_RETURN_ON_FALSE(decoder, ESP_ERR_NO_MEM, TAG, "no mem for JPEG decoder");
+
+    ESP_GOTO_ON_ERROR(jpeg_decoder_init(decoder, config), err, TAG, "JPEG decoder init failed");
+
+    if (config && config->flags.parallel) {
+#if JPEG_PARALLEL_SUPPORTED
+        ESP_GOTO_ON_ERROR(jpeg_slice_worker_create(decoder, config), err, TAG, "JPEG slice worker create failed");
+#else
+        ESP_GOTO_ON_FALSE(false, ESP_ERR_NOT_SUPPORTED, err, TAG, "Parallel decoding is not supported with current configuration");
+#endif
+    }
+
+    *ret_decoder = decoder;
+    return ESP_OK;
+
+err:
+    jpeg_decoder_deinit(decoder);
+    free(decoder);
+    return ret;
+}
+
+esp_err_t esp_jpeg_decoder_destroy(esp_jpeg_decoder_handle_t decoder)
+{
+    ESP_RETURN_ON_FALSE(decoder, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+#if JPEG_PARALLEL_SUPPORTED
+    if (decoder->worker) {
+        jpeg_slice_worker_destroy(decoder->worker);
+    }
+#endif
+    jpeg_decoder_deinit(decoder);
+    free(decoder);
+    return ESP_OK;
+}
+
+esp_err_t esp_jpeg_decoder_decode(esp_jpeg_decoder_handle_t decoder, esp_jpeg_image_cfg_t *cfg, esp_jpeg_image_output_t *img)
 {
     esp_err_t ret = ESP_OK;
-    uint8_t *workbuf = NULL;
     JRESULT res;
-    JDEC JDEC;
 
-    assert(cfg != NULL);
-    assert(img != NULL);
+    ESP_RETURN_ON_FALSE(decoder && cfg && img, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(cfg->in_cb || cfg->indata, ESP_ERR_INVALID_ARG, TAG, "no input data or input callback");
 
-    workbuf = heap_caps_malloc(JPEG_WORK_BUF_SIZE, MALLOC_CAP_DEFAULT);
-    ESP_GOTO_ON_FALSE(workbuf, ESP_ERR_NO_MEM, err, TAG, "no mem for JPEG work buffer");
+    /* Select pixel conversion once for the whole image */
+    decoder->row_conv = jpeg_get_row_conv(cfg);
+    ESP_RETURN_ON_FALSE(decoder->row_conv, ESP_ERR_NOT_SUPPORTED, TAG, "Selected output format is not supported!");
 
+    decoder->cfg = cfg;
     cfg->priv.read = 0;
 
     /* Prepare image */
-    res = jd_prepare(&JDEC, jpeg_decode_in_cb, workbuf, JPEG_WORK_BUF_SIZE, cfg);
+    res = jpeg_prepare(decoder);
     ESP_GOTO_ON_FALSE((res == JDR_OK), ESP_FAIL, err, TAG, "Error in preparing JPEG image!");
 
     uint8_t scale_div = jpeg_get_div_by_scale(cfg->out_scale);
     uint8_t out_color_bytes = jpeg_get_color_bytes(cfg->out_format);
 
     /* Size of output image */
-    uint32_t outsize = (JDEC.height / scale_div) * (JDEC.width / scale_div) * out_color_bytes;
-    ESP_GOTO_ON_FALSE((outsize <= cfg->outbuf_size), ESP_ERR_NO_MEM, err, TAG, "Not enough size in output buffer!");
+    img->height = decoder->jdec.height / scale_div;
+    img->width = decoder->jdec.width / scale_div;
+    decoder->out_color_bytes = out_color_bytes;
+    decoder->roi_done = false;
+
+    if (cfg->crop.width && cfg->crop.height) {
+        ESP_GOTO_ON_FALSE((cfg->crop.x + cfg->crop.width <= img->width) && (cfg->crop.y + cfg->crop.height <= img->height),
+                          ESP_ERR_INVALID_ARG, err, TAG, "Crop rectangle out of the image!");
+        decoder->crop = cfg->crop;
+        img->width = cfg->crop.width;
+        img->height = cfg->crop.height;
+    } else {
+        decoder->crop = (esp_jpeg_rect_t) {
+            .x = 0,
+            .y = 0,
+            .width = img->width,
+            .height = img->height,
+        };
+    }
+    decoder->roi = (JRECT) {
+        .left = decoder->crop.x,
+        .right = decoder->crop.x + decoder->crop.width - 1,
+        .top = decoder->crop.y,
+        .bottom = decoder->crop.y + decoder->crop.height - 1,
+    };
+#if !CONFIG_JD_USE_ROM
+    /* MCUs out of the crop rectangle are not transformed at all */
+    decoder->jdec.roi = &decoder->roi;
+#endif
 
-    /* Size of output image */
-    img->height = JDEC.height / scale_div;
-    img->width = JDEC.width / scale_div;
+    if (cfg->out_cb) {
+        /* Only one row of MCUs is stored at once */
+        uint32_t bandsize = img->width * ((decoder->jdec.msy * 8) / scale_div) * out_color_bytes;
+        if (cfg->outbuf && bandsize <= cfg->outbuf_size) {
+            cfg->priv.band = cfg->outbuf;
+        } else {
+            /* Band buffer is kept in the decoder and reused while big enough */
+            if (bandsize > decoder->band_size) {
+                free(decoder->band);
+                decoder->band_size = 0;
+                decoder->band = heap_caps_malloc(bandsize, decoder->caps);
+                ESP_GOTO_ON_FALSE(decoder->band, ESP_ERR_NO_MEM, err, TAG, "no mem for JPEG band buffer");
+                decoder->band_size = bandsize;
+            }
+            cfg->priv.band = decoder->band;
+        }
+    } else {
+        uint32_t outsize = img->height * img->width * out_color_bytes;
+        ESP_GOTO_ON_FALSE((outsize <= cfg->outbuf_size), ESP_ERR_NO_MEM, err, TAG, "Not enough size in output buffer!");
+    }
 
     /* Decode JPEG */
-    res = jd_decomp(&JDEC, jpeg_decode_out_cb, cfg->out_scale);
+#if JPEG_PARALLEL_SUPPORTED
+    if (decoder->worker && decoder->jdec.nrst && !cfg->in_cb && !cfg->out_cb) {
+        res = jpeg_decode_parallel(decoder);
+    } else
+#endif
+    {
+        res = jd_decomp(&decoder->jdec, jpeg_decode_out_cb, cfg->out_scale);
+    }
+    if (res == JDR_INTR && decoder->roi_done) {
+        res = JDR_OK;   /* Stopped after the crop rectangle */
+    }
     ESP_GOTO_ON_FALSE((res == JDR_OK), ESP_FAIL, err, TAG, "Error in decoding JPEG image!");
 
 err:
-    if (workbuf) {
-        free(workbuf);
+    cfg->priv.band = NULL;
+    decoder->cfg = NULL;
+
+    return ret;
+}
+
+esp_err_t esp_jpeg_get_image_info(esp_jpeg_image_cfg_t *cfg, esp_jpeg_image_info_t *info)
+{
+    uint8_t seg[JPEG_SOF_MAX_LEN];
+    uint16_t marker = 0;
+    uint32_t len;
+
+    ESP_RETURN_ON_FALSE(cfg && info, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(cfg->in_cb || cfg->indata, ESP_ERR_INVALID_ARG, TAG, "no input data or input callback");
+
+    memset(info, 0, sizeof(esp_jpeg_image_info_t));
+    cfg->priv.read = 0;
+
+    /* Find SOI marker */
+    do {
+        ESP_RETURN_ON_FALSE(jpeg_read_input(cfg, seg, 1) == 1, ESP_FAIL, TAG, "SOI marker not found!");
+        marker = marker << 8 | seg[0];
+    } while (marker != 0xFFD8);
+
+    /* Parse JPEG segments up to the start of scan, the tables are not loaded */
+    for (;;) {
+        ESP_RETURN_ON_FALSE(jpeg_read_input(cfg, seg, 4) == 4, ESP_FAIL, TAG, "Unexpected end of JPEG image!");
+        marker = (seg[0] << 8) | seg[1];
+        len = (seg[2] << 8) | seg[3];
+        ESP_RETURN_ON_FALSE((seg[0] == 0xFF && len > 2), ESP_FAIL, TAG, "Invalid JPEG segment!");
+        len -= 2;
+
+        switch (marker & 0xFF) {
+        case 0xC0:  /* SOF0 (baseline JPEG) */
+        case 0xC1:  /* SOF1 */
+        case 0xC2:  /* SOF2 (progressive JPEG) */
+        case 0xC3:  /* SOF3 */
+        case 0xC5:  /* SOF5 */
+        case 0xC6:  /* SOF6 */
+        case 0xC7:  /* SOF7 */
+        case 0xC9:  /* SOF9 */
+        case 0xCA:  /* SOF10 */
+        case 0xCB:  /* SOF11 */
+        case 0xCD:  /* SOF13 */
+        case 0xCE:  /* SOF14 */
+        case 0xCF:  /* SOF15 */
+            ESP_RETURN_ON_FALSE((len >= 6 && len <= sizeof(seg)), ESP_FAIL, TAG, "Invalid SOF segment!");
+            ESP_RETURN_ON_FALSE(jpeg_read_input(cfg, seg, len) == len, ESP_FAIL, TAG, "Unexpected end of JPEG image!");
+            info->height = (seg[1] << 8) | seg[2];
+            info->width = (seg[3] << 8) | seg[4];
+            info->components = seg[5];
+            ESP_RETURN_ON_FALSE((len >= 6 + 3 * info->components), ESP_FAIL, TAG, "Invalid SOF segment!");
+            info->subsampling = jpeg_get_subsampling(seg, info->components);
+            /* The same conditions as checked by TJpgDec */
+            info->supported = ((marker & 0xFF) == 0xC0) && (info->components == 1 || info->components == 3) &&
+                              (info->subsampling != JPEG_IMAGE_SUBSAMPLING_OTHER);
+            break;
+
+        case 0xDD:  /* DRI - Define Restart Interval */
+            ESP_RETURN_ON_FALSE((len >= 2), ESP_FAIL, TAG, "Invalid DRI segment!");
+            ESP_RETURN_ON_FALSE(jpeg_read_input(cfg, seg, 2) == 2, ESP_FAIL, TAG, "Unexpected end of JPEG image!");
+            info->restart_interval = (seg[0] << 8) | seg[1];
+            ESP_RETURN_ON_FALSE(jpeg_read_input(cfg, NULL, len - 2) == len - 2, ESP_FAIL, TAG, "Unexpected end of JPEG image!");
+            break;
+
+        case 0xDA:  /* SOS - Start of Scan */
+            ESP_RETURN_ON_FALSE((info->width && info->height), ESP_FAIL, TAG, "SOF marker not found!");
+            for (int i = 0; i < JPEG_IMAGE_SCALE_1_8 + 1; i++) {
+                uint8_t scale_div = jpeg_get_div_by_scale((esp_jpeg_image_scale_t)i);
+                info->output_size[i] = (info->width / scale_div) * (info->height / scale_div) * jpeg_get_color_bytes(cfg->out_format);
+            }
+            return ESP_OK;
+
+        case 0xD9:  /* EOI */
+            ESP_LOGE(TAG, "SOF marker not found!");
+            return ESP_FAIL;
+
+        default:    /* DQT, DHT, comment, exif or etc.. are skipped */
+            ESP_RETURN_ON_FALSE(jpeg_read_input(cfg, NULL, len) == len, ESP_FAIL, TAG, "Unexpected end of JPEG image!");
+            break;
+        }
     }
+}
+
+esp_err_t esp_jpeg_decode(esp_jpeg_image_cfg_t *cfg, esp_jpeg_image_output_t *img)
+{
+    esp_err_t ret = ESP_OK;
+    struct esp_jpeg_decoder_s decoder;
+
+    assert(cfg != NULL);
+    assert(img != NULL);
+
+    /* One-shot decoder, all buffers are released after decoding */
+    ESP_RETURN_ON_ERROR(jpeg_decoder_init(&decoder, NULL), TAG, "JPEG decoder init failed");
+    ret = esp_jpeg_decoder_decode(&decoder, cfg, img);
+    jpeg_decoder_deinit(&decoder);
 
     return ret;
 }
@@ -115,84 +423,470 @@ err:
 * Private API functions
 *******************************************************************************/
 
-static unsigned int jpeg_decode_in_cb(JDEC *dec, uint8_t *buff, unsigned int nbyte)
+static esp_err_t jpeg_decoder_init(struct esp_jpeg_decoder_s *decoder, const esp_jpeg_decoder_config_t *config)
 {
-    assert(dec != NULL);
+    memset(decoder, 0, sizeof(struct esp_jpeg_decoder_s));
+    decoder->caps = (config && config->caps) ? config->caps : MALLOC_CAP_DEFAULT;
+
+    if (config && config->workbuf) {
+        ESP_RETURN_ON_FALSE(config->workbuf_size >= ESP_JPEG_WORK_BUF_SIZE, ESP_ERR_INVALID_SIZE, TAG, "JPEG work buffer too small");
+        decoder->workbuf = config->workbuf;
+        decoder->workbuf_size = config->workbuf_size;
+    } else {
+        decoder->workbuf = heap_caps_malloc(ESP_JPEG_WORK_BUF_SIZE, decoder->caps);
+        ESP_RETURN_ON_FALSE(decoder->workbuf, ESP_ERR_NO_MEM, TAG, "no mem for JPEG work buffer");
+        decoder->workbuf_size = ESP_JPEG_WORK_BUF_SIZE;
+        decoder->workbuf_owned = true;
+    }
+
+    if (config && config->flags.stream) {
+#if CONFIG_JD_USE_ROM
+        ESP_RETURN_ON_FALSE(false, ESP_ERR_NOT_SUPPORTED, TAG, "Stream mode is not supported with the ROM decoder");
+#else
+        /* Cache structure, tables pool and segments in one allocation, the pool stays word aligned */
+        JDTBL *stream = heap_caps_calloc(1, sizeof(JDTBL) + JPEG_STREAM_TBL_POOL_SIZE + JPEG_STREAM_SEGS_SIZE, decoder->caps);
+        ESP_RETURN_ON_FALSE(stream, ESP_ERR_NO_MEM, TAG, "no mem for JPEG stream tables");
+        stream->pool = (uint8_t *)stream + sizeof(JDTBL);
+        stream->sz_pool = JPEG_STREAM_TBL_POOL_SIZE;
+        stream->segs = (uint8_t *)stream->pool + JPEG_STREAM_TBL_POOL_SIZE;
+        stream->sz_segs = JPEG_STREAM_SEGS_SIZE;
+        decoder->stream = stream;
+#endif
+    }
 
+    return ESP_OK;
+}
+
+static void jpeg_decoder_deinit(struct esp_jpeg_decoder_s *decoder)
+{
+    if (decoder->workbuf_owned) {
+        free(decoder->workbuf);
+    }
+    free(decoder->band);
+#if !CONFIG_JD_USE_ROM
+    free(decoder->stream);
+    decoder->stream = NULL;
+#endif
+    decoder->workbuf = NULL;
+    decoder->band = NULL;
+    decoder->band_size = 0;
+}
+
+static JRESULT jpeg_prepare(struct esp_jpeg_decoder_s *decoder)
+{
+#if !CONFIG_JD_USE_ROM
+    if (decoder->stream) {
+        return jd_prepare_stream(&decoder->jdec, jpeg_decode_in_cb, decoder->workbuf, decoder->workbuf_size, decoder, decoder->stream);
+    }
+#endif
+    return jd_prepare(&decoder->jdec, jpeg_decode_in_cb, decoder->workbuf, decoder->workbuf_size, decoder);
+}
+
+#if JPEG_PARALLEL_SUPPORTED
+static void jpeg_slice_task(void *arg)
+{
+    jpeg_slice_worker_t *worker = (jpeg_slice_worker_t *)arg;
+    struct esp_jpeg_decoder_s *dec = &worker->dec;
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (worker->exit) {
+            break;
+        }
+
+        /* Headers are parsed again into own tables, then the input is moved to the slice */
+        worker->cfg.priv.read = 0;
+        worker->res = jpeg_prepare(dec);
+        if (worker->res == JDR_OK) {
+            dec->jdec.roi = &dec->roi;
+            worker->cfg.priv.read = worker->offset;
+            worker->res = jd_decomp_rst(&dec->jdec, jpeg_decode_out_cb, worker->cfg.out_scale, worker->rsti, worker->nrsti);
+        }
+        xSemaphoreGive(worker->done);
+    }
+
+    xSemaphoreGive(worker->done);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t jpeg_slice_worker_create(struct esp_jpeg_decoder_s *decoder, const esp_jpeg_decoder_config_t *config)
+{
+    esp_err_t ret = ESP_OK;
+    jpeg_slice_worker_t *worker = heap_caps_calloc(1, sizeof(jpeg_slice_worker_t), MALLOC_CAP_DEFAULT);
+    ESP_RETURN_ON_FALSE(worker, ESP_ERR_NO_MEM, TAG, "no mem for JPEG slice worker");
+
+    /* User work buffer is used by the first slice only */
+    esp_jpeg_decoder_config_t worker_config = {
+        .caps = config->caps,
+        .flags = {
+            .stream = config->flags.stream,
+        },
+    };
+    ESP_GOTO_ON_ERROR(jpeg_decoder_init(&worker->dec, &worker_config), err, TAG, "JPEG slice decoder init failed");
+
+    worker->done = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(worker->done, ESP_ERR_NO_MEM, err, TAG, "no mem for JPEG slice semaphore");
+
+    /* The worker runs on the other core with the same priority as the creator */
+    BaseType_t core = (xPortGetCoreID() == 0) ? 1 : 0;
+    BaseType_t res = xTaskCreatePinnedToCore(jpeg_slice_task, "jpeg_slice", JPEG_SLICE_TASK_STACK_SIZE, worker,
+                     uxTaskPriorityGet(NULL), &worker->task, core);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "no mem for JPEG slice task");
+
+    decoder->worker = worker;
+    return ESP_OK;
+
+err:
+    if (worker->done) {
+        vSemaphoreDelete(worker->done);
+    }
+    jpeg_decoder_deinit(&worker->dec);
+    free(worker);
+    return ret;
+}
+
+static void jpeg_slice_worker_destroy(jpeg_slice_worker_t *worker)
+{
+    worker->exit = true;
+    xTaskNotifyGive(worker->task);
+    xSemaphoreTake(worker->done, portMAX_DELAY);
+
+    vSemaphoreDelete(worker->done);
+    jpeg_decoder_deinit(&worker->dec);
+    free(worker);
+}
+
+/* Offset behind the n-th RST marker in entropy coded data, 0 if not found */
+static uint32_t jpeg_find_rst(const uint8_t *data, uint32_t start, uint32_t size, uint32_t n)
+{
+    const uint8_t *p = data + start;
+    const uint8_t *end = data + size;
+
+    /* 0xFF in entropy coded data is always followed by 0x00 (stuffing) or by a marker */
+    while (p + 1 < end && (p = memchr(p, 0xFF, end - p - 1)) != NULL) {
+        if ((p[1] & 0xF8) == 0xD0 && --n == 0) {
+            return (p + 2) - data;
+        }
+        p += 2;
+    }
+
+    return 0;
+}
+
+static JRESULT jpeg_decode_parallel(struct esp_jpeg_decoder_s *decoder)
+{
+    JDEC *jd = &decoder->jdec;
+    esp_jpeg_image_cfg_t *cfg = decoder->cfg;
+    jpeg_slice_worker_t *worker = decoder->worker;
+
+    /* Start of entropy coded data: jd_prepare() has read ahead the data in input buffer */
+    uint32_t scan_start = cfg->priv.read - jd->dctr;
+
+    uint32_t mx = jd->msx * 8, my = jd->msy * 8;
+    uint32_t mcus = ((jd->width + mx - 1) / mx) * ((jd->height + my - 1) / my);
+    uint32_t nrsti = (mcus + jd->nrst - 1) / jd->nrst;
+    uint16_t half = nrsti / 2;
+    uint32_t offset = half ? jpeg_find_rst(cfg->indata, scan_start, cfg->indata_size, half) : 0;
+    if (!offset) {
+        /* Nothing to split */
+        return jd_decomp(jd, jpeg_decode_out_cb, cfg->out_scale);
+    }
+
+    /* Second half of restart intervals is decoded on the other core */
+    worker->cfg = *cfg;
+    worker->dec.cfg = &worker->cfg;
+    worker->dec.row_conv = decoder->row_conv;
+    worker->dec.crop = decoder->crop;
+    worker->dec.roi = decoder->roi;
+    worker->dec.roi_done = false;
+    worker->dec.out_color_bytes = decoder->out_color_bytes;
+    worker->offset = offset;
+    worker->rsti = half;
+    worker->nrsti = nrsti - half;
+    xTaskNotifyGive(worker->task);
+
+    /* First half is decoded here */
+    cfg->priv.read = scan_start;
+    JRESULT res = jd_decomp_rst(jd, jpeg_decode_out_cb, cfg->out_scale, 0, half);
+
+    xSemaphoreTake(worker->done, portMAX_DELAY);
+    worker->dec.cfg = NULL;
+
+    /* Stop below the crop rectangle is not an error in any slice */
+    if (res == JDR_INTR && decoder->roi_done) {
+        res = JDR_OK;
+    }
+    if (worker->res == JDR_INTR && worker->dec.roi_done) {
+        worker->res = JDR_OK;
+    }
+    return (res != JDR_OK) ? res : worker->res;
+}
+#endif
+
+static uint32_t jpeg_read_input(esp_jpeg_image_cfg_t *cfg, uint8_t *buff, uint32_t nbyte)
+{
     uint32_t to_read = nbyte;
-    esp_jpeg_image_cfg_t *cfg = (esp_jpeg_image_cfg_t *)dec->device;
-    assert(cfg != NULL);
 
-    if (buff) {
+    if (cfg->in_cb) {
+        /* Pull data from user stream (NULL buffer means skip) */
+        to_read = cfg->in_cb(cfg->in_user_data, buff, to_read);
+        cfg->priv.read += to_read;
+    } else {
         if (cfg->priv.read + to_read > cfg->indata_size) {
             to_read = cfg->indata_size - cfg->priv.read;
         }
 
-        /* Copy data from JPEG image */
-        memcpy(buff, &cfg->indata[cfg->priv.read], to_read);
-        cfg->priv.read += to_read;
-    } else if (buff == NULL) {
-        /* Skip data */
+        if (buff) {
+            /* Copy data from JPEG image */
+            memcpy(buff, &cfg->indata[cfg->priv.read], to_read);
+        }
+        /* NULL buffer means skip data */
         cfg->priv.read += to_read;
     }
 
     return to_read;
 }
 
+static unsigned int jpeg_decode_in_cb(JDEC *dec, uint8_t *buff, unsigned int nbyte)
+{
+    assert(dec != NULL);
+
+    struct esp_jpeg_decoder_s *decoder = (struct esp_jpeg_decoder_s *)dec->device;
+    assert(decoder != NULL);
+    assert(decoder->cfg != NULL);
+
+    return jpeg_read_input(decoder->cfg, buff, nbyte);
+}
+
 static jpeg_decode_out_t jpeg_decode_out_cb(JDEC *dec, void *bitmap, JRECT *rect)
 {
-    uint16_t color = 0;
     assert(dec != NULL);
 
-    esp_jpeg_image_cfg_t *cfg = (esp_jpeg_image_cfg_t *)dec->device;
-    assert(cfg != NULL);
+    struct esp_jpeg_decoder_s *decoder = (struct esp_jpeg_decoder_s *)dec->device;
+    assert(decoder != NULL);
+    esp_jpeg_image_cfg_t *cfg = decoder->cfg;
     assert(bitmap != NULL);
     assert(rect != NULL);
 
-    uint8_t scale_div = jpeg_get_div_by_scale(cfg->out_scale);
-    uint8_t out_color_bytes = jpeg_get_color_bytes(cfg->out_format);
+    const JRECT *roi = &decoder->roi;
+    if (rect->top > roi->bottom) {
+        /* Rest of the image is not needed */
+        decoder->roi_done = true;
+        return 0;
+    }
+    if (rect->bottom < roi->top || rect->right < roi->left || rect->left > roi->right) {
+        /* The block is out of the crop rectangle */
+        return 1;
+    }
 
-    /* Copy decoded image data to output buffer */
-    uint8_t *in = (uint8_t *)bitmap;
-    uint32_t line = dec->width / scale_div;
-    uint8_t *dst = (uint8_t *)cfg->outbuf;
-    for (int y = rect->top; y <= rect->bottom; y++) {
-        for (int x = rect->left; x <= rect->right; x++) {
-            if ( (JD_FORMAT == 0 && cfg->out_format == JPEG_IMAGE_FORMAT_RGB888) ||
-                    (JD_FORMAT == 1 && cfg->out_format == JPEG_IMAGE_FORMAT_RGB565) ) {
-                /* Output image format is same as set in TJPGD */
-                for (int b = 0; b < ESP_JPEG_COLOR_BYTES; b++) {
-                    if (JD_FORMAT == 1 && cfg->flags.swap_color_bytes) {
-                        dst[(y * line * out_color_bytes) + x * out_color_bytes + b] = in[out_color_bytes - b - 1];
-                    } else {
-                        dst[(y * line * out_color_bytes) + x * out_color_bytes + b] = in[b];
-                    }
-                }
-            } else if (JD_FORMAT == 0 && cfg->out_format == JPEG_IMAGE_FORMAT_RGB565) {
-                /* Output image format is not same as set in TJPGD */
-                /* We need to convert the 3 bytes in `in` to a rgb565 value */
-                color = ((in[0] & 0xF8) << 8);
-                color |= ((in[1] & 0xFC) << 3);
-                color |= (in[2] >> 3);
-
-                if (cfg->flags.swap_color_bytes) {
-                    dst[(y * line * out_color_bytes) + (x * out_color_bytes)] = HIBYTE(color);
-                    dst[(y * line * out_color_bytes) + (x * out_color_bytes) + 1] = LOBYTE(color);
-                } else {
-                    dst[(y * line * out_color_bytes) + (x * out_color_bytes) + 1] = HIBYTE(color);
-                    dst[(y * line * out_color_bytes) + (x * out_color_bytes)] = LOBYTE(color);
-                }
-            } else {
-                ESP_LOGE(TAG, "Selected output format is not supported!");
-                assert(0);
-            }
-            in += ESP_JPEG_COLOR_BYTES;
-        }
+    /* Part of the block in the crop rectangle */
+    const uint16_t left = MAX(rect->left, roi->left);
+    const uint16_t right = MIN(rect->right, roi->right);
+    const uint16_t top = MAX(rect->top, roi->top);
+    const uint16_t bottom = MIN(rect->bottom, roi->bottom);
+
+    const uint32_t stride = decoder->crop.width * decoder->out_color_bytes;
+    const uint32_t in_stride = (rect->right - rect->left + 1) * ESP_JPEG_COLOR_BYTES;
+    const uint32_t pixels = right - left + 1;
+    const uint32_t x = left - roi->left;
+
+    /* Copy decoded image data to output buffer, row by row */
+    const uint8_t *in = (const uint8_t *)bitmap + ((top - rect->top) * in_stride) + ((left - rect->left) * ESP_JPEG_COLOR_BYTES);
+    uint8_t *dst = (uint8_t *)cfg->outbuf + ((top - roi->top) * stride);
+    if (cfg->out_cb) {
+        /* Rows of the band are stored from the beginning of the band buffer */
+        dst = cfg->priv.band;
+    }
+    dst += x * decoder->out_color_bytes;
+    for (int y = top; y <= bottom; y++) {
+        decoder->row_conv(dst, in, x, pixels);
+        in += in_stride;
+        dst += stride;
+    }
+
+    /* The last MCU in the row completes the band */
+    if (cfg->out_cb && right == roi->right) {
+        esp_jpeg_rect_t band = {
+            .x = 0,
+            .y = top - roi->top,
+            .width = decoder->crop.width,
+            .height = bottom - top + 1,
+        };
+        return cfg->out_cb(cfg->out_user_data, &band, cfg->priv.band) ? 1 : 0;
     }
 
     return 1;
 }
 
+/* Output image format is same as set in TJPGD */
+static void jpeg_row_copy(uint8_t *dst, const uint8_t *src, uint32_t x, uint32_t pixels)
+{
+    memcpy(dst, src, pixels * ESP_JPEG_COLOR_BYTES);
+}
+
+#if (JD_FORMAT == 1)
+/* RGB565 from TJPGD with swapped bytes */
+static void jpeg_row_rgb565_swap(uint8_t *dst, const uint8_t *src, uint32_t x, uint32_t pixels)
+{
+    while (pixels--) {
+        dst[0] = src[1];
+        dst[1] = src[0];
+        dst += 2;
+        src += 2;
+    }
+}
+#endif
+
+#if (JD_FORMAT == 0)
+/* RGB888 from TJPGD converted to RGB565 */
+static inline uint16_t jpeg_rgb888_to_rgb565(const uint8_t *in)
+{
+    return ((in[0] & 0xF8) << 8) | ((in[1] & 0xFC) << 3) | (in[2] >> 3);
+}
+
+static void jpeg_row_rgb888_to_rgb565(uint8_t *dst, const uint8_t *src, uint32_t x, uint32_t pixels)
+{
+    while (pixels--) {
+        uint16_t color = jpeg_rgb888_to_rgb565(src);
+        dst[0] = LOBYTE(color);
+        dst[1] = HIBYTE(color);
+        dst += 2;
+        src += 3;
+    }
+}
+
+static void jpeg_row_rgb888_to_rgb565_swap(uint8_t *dst, const uint8_t *src, uint32_t x, uint32_t pixels)
+{
+    while (pixels--) {
+        uint16_t color = jpeg_rgb888_to_rgb565(src);
+        dst[0] = HIBYTE(color);
+        dst[1] = LOBYTE(color);
+        dst += 2;
+        src += 3;
+    }
+}
+#endif
+
+#if (JD_FORMAT == 0)
+/* RGB888 from TJPGD converted to luma (full range BT.601, as used in JPEG) */
+static inline uint8_t jpeg_rgb888_to_y(const uint8_t *in)
+{
+    return (77 * in[0] + 150 * in[1] + 29 * in[2]) >> 8;
+}
+
+static inline int jpeg_rgb888_to_u(const uint8_t *in)
+{
+    return ((-43 * in[0] - 85 * in[1] + 128 * in[2]) >> 8) + 128;
+}
+
+static inline int jpeg_rgb888_to_v(const uint8_t *in)
+{
+    return ((128 * in[0] - 107 * in[1] - 21 * in[2]) >> 8) + 128;
+}
+
+static void jpeg_row_rgb888_to_gray(uint8_t *dst, const uint8_t *src, uint32_t x, uint32_t pixels)
+{
+    while (pixels--) {
+        *dst++ = jpeg_rgb888_to_y(src);
+        src += 3;
+    }
+}
+
+/* YUYV: chroma is shared by pixel pairs starting at even column of the output image.
+ * Converted back from RGB888 for the ROM code, TJPGD built with JD_FORMAT 3 outputs YCbCr directly. */
+static void jpeg_row_rgb888_to_yuv422(uint8_t *dst, const uint8_t *src, uint32_t x, uint32_t pixels)
+{
+    if (pixels && (x & 1)) {
+        /* Second pixel of a pair which started in the previous block */
+        dst[0] = jpeg_rgb888_to_y(src);
+        dst[1] = jpeg_rgb888_to_v(src);
+        dst += 2;
+        src += 3;
+        pixels--;
+    }
+    while (pixels >= 2) {
+        dst[0] = jpeg_rgb888_to_y(src);
+        dst[1] = (jpeg_rgb888_to_u(src) + jpeg_rgb888_to_u(src + 3)) >> 1;
+        dst[2] = jpeg_rgb888_to_y(src + 3);
+        dst[3] = (jpeg_rgb888_to_v(src) + jpeg_rgb888_to_v(src + 3)) >> 1;
+        dst += 4;
+        src += 6;
+        pixels -= 2;
+    }
+    if (pixels) {
+        /* First pixel of a pair, which ends in the next block or at the right edge */
+        dst[0] = jpeg_rgb888_to_y(src);
+        dst[1] = jpeg_rgb888_to_u(src);
+    }
+}
+#endif
+
+static jpeg_row_conv_t jpeg_get_row_conv(const esp_jpeg_image_cfg_t *cfg)
+{
+    switch (cfg->out_format) {
+    case JPEG_IMAGE_FORMAT_RGB888:
+#if (JD_FORMAT == 0)
+        return jpeg_row_copy;
+#else
+        return NULL;
+#endif
+    case JPEG_IMAGE_FORMAT_RGB565:
+#if (JD_FORMAT == 0)
+        return cfg->flags.swap_color_bytes ? jpeg_row_rgb888_to_rgb565_swap : jpeg_row_rgb888_to_rgb565;
+#elif (JD_FORMAT == 1)
+        return cfg->flags.swap_color_bytes ? jpeg_row_rgb565_swap : jpeg_row_copy;
+#else
+        return NULL;
+#endif
+    case JPEG_IMAGE_FORMAT_GRAY:
+#if (JD_FORMAT == 0)
+        return jpeg_row_rgb888_to_gray;
+#elif (JD_FORMAT == 2)
+        return jpeg_row_copy;
+#elif (JD_FORMAT == 3)
+        return jpeg_row_ycbcr_to_gray;
+#else
+        return NULL;
+#endif
+    case JPEG_IMAGE_FORMAT_YUV422:
+#if (JD_FORMAT == 0)
+        return jpeg_row_rgb888_to_yuv422;
+#elif (JD_FORMAT == 3)
+        return jpeg_row_ycbcr_to_yuv422;
+#else
+        return NULL;
+#endif
+    }
+
+    return NULL;
+}
+
+static esp_jpeg_image_subsampling_t jpeg_get_subsampling(const uint8_t *sof, uint8_t components)
+{
+    if (components == 1) {
+        return JPEG_IMAGE_SUBSAMPLING_GRAY;
+    }
+
+    /* Chroma components must use sampling factor 1 */
+    for (int i = 1; i < components; i++) {
+        if (sof[7 + 3 * i] != 0x11) {
+            return JPEG_IMAGE_SUBSAMPLING_OTHER;
+        }
+    }
+
+    /* Sampling factor of Y component */
+    switch (sof[7]) {
+    case 0x11:
+        return JPEG_IMAGE_SUBSAMPLING_444;
+    case 0x21:
+        return JPEG_IMAGE_SUBSAMPLING_422;
+    case 0x22:
+        return JPEG_IMAGE_SUBSAMPLING_420;
+    }
+
+    return JPEG_IMAGE_SUBSAMPLING_OTHER;
+}
+
 static uint8_t jpeg_get_div_by_scale(esp_jpeg_image_scale_t scale)
 {
     switch (scale) {
@@ -222,6 +916,12 @@ static uint8_t jpeg_get_color_bytes(esp_jpeg_image_format_t format)
     /* RGB565 (16-bit/pix) */
     case JPEG_IMAGE_FORMAT_RGB565:
         return 2;
+    /* Grayscale (8-bit/pix) */
+    case JPEG_IMAGE_FORMAT_GRAY:
+        return 1;
+    /* YUV422 (16-bit/pix) */
+    case JPEG_IMAGE_FORMAT_YUV422:
+        return 2;
     }
 
     return 1;
@@ -0,0 +1,192 @@
+unsigned char logo_rst_jpg[] = {
+    0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43,
+    0x00, 0x03, 0x02, 0x02, 0x03, 0x02, 0x02, 0x03, 0x03, 0x03, 0x03, 0x04,
+    0x03, 0x03, 0x04, 0x05, 0x08, 0x05, 0x05, 0x04, 0x04, 0x05, 0x0a, 0x07,
+    0x07, 0x06, 0x08, 0x0c, 0x0a, 0x0c, 0x0c, 0x0b, 0x0a, 0x0b, 0x0b, 0x0d,
+    0x0e, 0x12, 0x10, 0x0d, 0x0e, 0x11, 0x0e, 0x0b, 0x0b, 0x10, 0x16, 0x10,
+    0x11, 0x13, 0x14, 0x15, 0x15, 0x15, 0x0c, 0x0f, 0x17, 0x18, 0x16, 0x14,
+    0x18, 0x12, 0x14, 0x15, 0x14, 0xff, 0xdb, 0x00, 0x43, 0x01, 0x03, 0x04,
+    0x04, 0x05, 0x04, 0x05, 0x09, 0x05, 0x05, 0x09, 0x14, 0x0d, 0x0b, 0x0d,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0xff, 0xc0, 0x00, 0x11, 0x08, 0x00, 0x2e, 0x00, 0x2e, 0x03,
+    0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xff, 0xc4, 0x00,
+    0x1f, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0xff, 0xc4, 0x00, 0xb5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7d, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3,
+    0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6,
+    0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9,
+    0xda, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1,
+    0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xff, 0xc4, 0x00,
+    0x1f, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0xff, 0xc4, 0x00, 0xb5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0, 0x15,
+    0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18,
+    0x19, 0x1a, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa,
+    0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4,
+    0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7,
+    0xd8, 0xd9, 0xda, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea,
+    0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xff, 0xdd, 0x00,
+    0x04, 0x00, 0x01, 0xff, 0xda, 0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x11,
+    0x03, 0x11, 0x00, 0x3f, 0x00, 0xf1, 0xf9, 0x66, 0x65, 0x77, 0x26, 0x42,
+    0x00, 0x27, 0x24, 0xb7, 0x4a, 0xb3, 0xa4, 0xe9, 0xba, 0x9e, 0xbf, 0xaa,
+    0xdb, 0x69, 0x7a, 0x5d, 0x95, 0xe6, 0xa5, 0xaa, 0x5c, 0xb6, 0xd8, 0x6c,
+    0xad, 0x62, 0x67, 0x9a, 0x43, 0xdf, 0x08, 0x39, 0xe9, 0xce, 0x4f, 0x02,
+    0xbb, 0x9f, 0x84, 0x1e, 0x1c, 0xd2, 0x25, 0xbc, 0xf1, 0x17, 0x8d, 0x3c,
+    0x53, 0x6a, 0x2f, 0x7c, 0x27, 0xe0, 0xdb, 0x65, 0xbf, 0xb9, 0xb2, 0x6e,
+    0x16, 0xfe, 0xf1, 0xdf, 0x65, 0xa5, 0xa1, 0x3f, 0xdd, 0x67, 0x19, 0x6e,
+    0x0f, 0xca, 0xb8, 0x23, 0x04, 0xd7, 0xbf, 0x7e, 0xce, 0x5e, 0x2d, 0xf8,
+    0xad, 0xe1, 0xcd, 0x5f, 0xc5, 0xbe, 0x3e, 0xd5, 0xfe, 0x14, 0x6b, 0x1e,
+    0x31, 0xbe, 0xf1, 0x53, 0x41, 0x37, 0xf6, 0x9c, 0x2d, 0x0d, 0x9c, 0x91,
+    0xc4, 0xa0, 0x8d, 0x91, 0x24, 0x9f, 0x39, 0x8c, 0x82, 0x80, 0x01, 0x8e,
+    0x11, 0x7a, 0xf5, 0xaf, 0xc7, 0xb0, 0x98, 0x15, 0x5d, 0xc3, 0x9e, 0x4d,
+    0x29, 0x76, 0x4d, 0xe8, 0xba, 0xe9, 0xdd, 0xe8, 0xbe, 0x7d, 0x8f, 0xed,
+    0x2c, 0xd7, 0x39, 0x78, 0x1a, 0x75, 0x5d, 0x18, 0x46, 0x52, 0x82, 0x4b,
+    0xde, 0x9c, 0x60, 0x9c, 0xdd, 0x9a, 0x8a, 0x72, 0xb2, 0x76, 0x8b, 0xe7,
+    0x96, 0xab, 0x47, 0x14, 0xae, 0xdb, 0xe5, 0xff, 0xd0, 0xe0, 0xed, 0xfc,
+    0x09, 0xaa, 0xd9, 0xf8, 0xa6, 0xcf, 0x43, 0xf1, 0x4b, 0xcb, 0xe0, 0x0f,
+    0xb4, 0x16, 0x53, 0xa8, 0x78, 0x92, 0xd6, 0x68, 0x2d, 0xe2, 0x20, 0x12,
+    0x01, 0x3b, 0x79, 0xc9, 0x18, 0x18, 0xe3, 0x9e, 0x48, 0x15, 0xea, 0xde,
+    0x21, 0xfd, 0x8a, 0xbe, 0x25, 0xe9, 0x9a, 0x2a, 0x6a, 0xfa, 0x15, 0xc6,
+    0x8d, 0xe3, 0x8d, 0x35, 0xe3, 0xf3, 0x52, 0x5d, 0x06, 0xf7, 0x2f, 0x22,
+    0xfa, 0xa2, 0xb8, 0x01, 0xff, 0x00, 0xe0, 0x2c, 0x6b, 0xeb, 0xad, 0x3f,
+    0xf6, 0x9d, 0xf0, 0x07, 0x8c, 0x2f, 0x17, 0xc2, 0x7e, 0x3d, 0xd1, 0x6f,
+    0xbc, 0x19, 0xa8, 0xdd, 0xfc, 0x9f, 0xd9, 0x5e, 0x35, 0xd3, 0xc4, 0x50,
+    0x5c, 0x1c, 0xe3, 0x0b, 0x23, 0x66, 0x36, 0xeb, 0xc6, 0x48, 0xce, 0x6b,
+    0x23, 0xc4, 0x1f, 0x02, 0xbc, 0x41, 0xf0, 0x42, 0xee, 0xe3, 0xc5, 0x9f,
+    0x04, 0xa6, 0x65, 0xb6, 0xcf, 0x9d, 0xa8, 0x78, 0x0a, 0xea, 0x52, 0xf6,
+    0x17, 0xe9, 0xd5, 0x8d, 0xb1, 0x24, 0x98, 0x65, 0xc7, 0x4c, 0x70, 0x78,
+    0x1d, 0x3e, 0x53, 0xf0, 0x30, 0xc9, 0xb0, 0xdc, 0x8d, 0xc5, 0xb9, 0xae,
+    0xeb, 0x49, 0x2f, 0x97, 0x5f, 0xc1, 0xfa, 0x9f, 0xd1, 0x75, 0x78, 0xcf,
+    0x32, 0x55, 0x61, 0x4e, 0xad, 0x35, 0x87, 0xa8, 0xd6, 0x8a, 0x6b, 0x9a,
+    0x95, 0x4f, 0x49, 0xab, 0x38, 0xf6, 0x4e, 0xf2, 0x87, 0x76, 0xb5, 0x67,
+    0xff, 0xd1, 0xf2, 0x2b, 0x98, 0xee, 0xac, 0x6e, 0xe7, 0xb4, 0xba, 0x8a,
+    0x7b, 0x4b, 0xbb, 0x77, 0x31, 0xcd, 0x6d, 0x70, 0x8d, 0x1c, 0x91, 0x38,
+    0xea, 0xac, 0xad, 0x82, 0xa7, 0xd8, 0xd4, 0xba, 0x74, 0x8e, 0xd7, 0x04,
+    0x6f, 0x6f, 0xba, 0x7f, 0x88, 0x8e, 0xe2, 0xbe, 0xe8, 0xf8, 0xc1, 0xe0,
+    0x5f, 0x0c, 0x7e, 0xd7, 0xdf, 0x08, 0xa4, 0xf8, 0x85, 0xe0, 0xbb, 0x63,
+    0x6d, 0xe3, 0x6d, 0x2a, 0x27, 0x49, 0x6d, 0x64, 0x4d, 0x97, 0x2c, 0xf1,
+    0x8c, 0xcb, 0x61, 0x72, 0xbf, 0xdf, 0x1f, 0xc0, 0x4f, 0x43, 0xb7, 0x07,
+    0x6b, 0x1a, 0xf8, 0x53, 0x49, 0x91, 0x66, 0x94, 0x3a, 0x93, 0xb5, 0xa3,
+    0xc8, 0xe3, 0xe9, 0x5f, 0x8d, 0xe3, 0xb0, 0x52, 0xc1, 0x54, 0x8a, 0x4f,
+    0x9a, 0x32, 0xd5, 0x3e, 0xe8, 0xfe, 0xd3, 0xc9, 0xb3, 0x98, 0x67, 0x18,
+    0x79, 0xb7, 0x07, 0x4e, 0xad, 0x37, 0xcb, 0x38, 0x3d, 0xe3, 0x2f, 0xd5,
+    0x3e, 0x8f, 0xd7, 0xb1, 0xff, 0xd2, 0xef, 0x7f, 0x67, 0x1d, 0x13, 0x4c,
+    0xd5, 0x7c, 0x2d, 0xf0, 0xf7, 0x4b, 0xd4, 0xa0, 0x86, 0x4b, 0x2d, 0x73,
+    0xe2, 0x1d, 0xcd, 0xc5, 0xe0, 0x9b, 0xee, 0xcc, 0x6c, 0xec, 0x0b, 0x5b,
+    0xc4, 0xc3, 0xa3, 0x29, 0x90, 0x83, 0xb4, 0xf0, 0x4d, 0x7d, 0x99, 0xf1,
+    0x5b, 0xc7, 0x5e, 0x36, 0xf0, 0x5c, 0xfa, 0x74, 0x9e, 0x16, 0xf8, 0x79,
+    0x2f, 0x8e, 0x6c, 0x64, 0x57, 0x6b, 0xd7, 0xb7, 0xd4, 0xe2, 0xb6, 0x96,
+    0xdc, 0x8c, 0x6d, 0x0b, 0x1b, 0x8c, 0xbe, 0x72, 0x4f, 0x1e, 0x98, 0xef,
+    0x5f, 0x9d, 0xfe, 0x0f, 0xba, 0xba, 0xd7, 0xfe, 0x01, 0x78, 0xb7, 0x4b,
+    0xd3, 0x67, 0x7b, 0x7d, 0x7f, 0xc1, 0x9a, 0xe5, 0xbf, 0x8c, 0x6c, 0xa4,
+    0xb6, 0x2c, 0xb7, 0x0b, 0x6e, 0xcb, 0xe4, 0x5c, 0x49, 0x19, 0x1f, 0xf3,
+    0xc9, 0x82, 0x48, 0x4f, 0x6e, 0x2b, 0xdd, 0x3c, 0x09, 0xfb, 0x69, 0x7c,
+    0x55, 0xb1, 0xf0, 0x54, 0x3e, 0x24, 0xf1, 0x1f, 0xc3, 0x59, 0x3c, 0x49,
+    0xe1, 0x4b, 0x6f, 0x92, 0xe7, 0xc4, 0xba, 0x70, 0x6b, 0x6d, 0xea, 0x0e,
+    0xd6, 0x93, 0x61, 0x05, 0x0e, 0x0f, 0x04, 0x8c, 0x26, 0x41, 0xe5, 0x7b,
+    0x7c, 0x36, 0x5d, 0x8d, 0xa5, 0x4a, 0x8a, 0xa5, 0x26, 0xe3, 0x74, 0x9a,
+    0x69, 0x5f, 0x6d, 0x1d, 0xf4, 0x7d, 0x53, 0xe9, 0xd4, 0xfe, 0x82, 0xe2,
+    0x4c, 0x87, 0x17, 0x8e, 0xc6, 0xfd, 0x6e, 0x94, 0x61, 0x55, 0x42, 0x52,
+    0x8b, 0xa7, 0x39, 0x38, 0xdd, 0xcb, 0xde, 0x8b, 0x4f, 0x9a, 0x37, 0x6e,
+    0x32, 0x8a, 0x49, 0x49, 0x3b, 0xc5, 0x2b, 0x3b, 0x34, 0xbf, 0xff, 0xd3,
+    0xfb, 0x7f, 0xc3, 0x9f, 0x14, 0x7e, 0x1e, 0x7e, 0xd2, 0x70, 0xea, 0x1e,
+    0x07, 0xf1, 0x36, 0x81, 0x2d, 0x96, 0xbb, 0x12, 0x16, 0xbb, 0xf0, 0xa7,
+    0x89, 0xed, 0x3c, 0xab, 0xa4, 0x03, 0xac, 0x91, 0x7f, 0x7b, 0x1d, 0x43,
+    0x21, 0xc8, 0xeb, 0xc5, 0x73, 0x1e, 0x0e, 0xbd, 0xd5, 0xff, 0x00, 0x65,
+    0xdf, 0x88, 0x7a, 0x47, 0x81, 0x35, 0xbd, 0x4a, 0xe3, 0x58, 0xf8, 0x63,
+    0xe2, 0x29, 0x8d, 0xb7, 0x86, 0xf5, 0x5b, 0xd7, 0xdf, 0x36, 0x95, 0x75,
+    0xd5, 0x6c, 0x65, 0x7e, 0xe8, 0xdf, 0xc0, 0x4f, 0xd3, 0xa0, 0x38, 0xd7,
+    0xf8, 0xbb, 0xe1, 0x7d, 0x1f, 0xf6, 0x85, 0xf8, 0x41, 0xa6, 0xfc, 0x42,
+    0xf0, 0x5d, 0xc9, 0x83, 0xc4, 0xfa, 0x65, 0xb1, 0xd6, 0x3c, 0x39, 0xad,
+    0x44, 0xbb, 0x27, 0x8e, 0x48, 0xf2, 0xcd, 0x03, 0xff, 0x00, 0xb2, 0xc5,
+    0x59, 0x19, 0x0e, 0x40, 0x6f, 0xa7, 0x2b, 0xe3, 0x19, 0x2d, 0xff, 0x00,
+    0x69, 0xaf, 0xd9, 0x06, 0x5d, 0x5d, 0x62, 0x5b, 0x7b, 0xdd, 0x43, 0x46,
+    0xfe, 0xd4, 0xb6, 0xd9, 0xd6, 0xde, 0xfa, 0x00, 0x5f, 0xe4, 0x3d, 0x46,
+    0x24, 0x8d, 0x97, 0x3d, 0x70, 0x4d, 0x78, 0x32, 0x73, 0x6d, 0xc9, 0x34,
+    0xe6, 0x97, 0x34, 0x64, 0xbe, 0xd2, 0xea, 0x9f, 0xf5, 0xd5, 0x34, 0x7e,
+    0x93, 0x49, 0x50, 0x8c, 0x15, 0x26, 0xa5, 0x1c, 0x3d, 0x49, 0xfb, 0x3a,
+    0x94, 0xe4, 0xee, 0xe9, 0x54, 0xe9, 0x38, 0xb7, 0x67, 0xdd, 0xae, 0xbe,
+    0xec, 0xa1, 0x2b, 0xab, 0x37, 0xff, 0xd4, 0xfb, 0x03, 0xe2, 0x2d, 0x9f,
+    0xfc, 0x28, 0x0f, 0x8e, 0x9a, 0x27, 0xc4, 0x2d, 0x38, 0x7d, 0x9f, 0xc2,
+    0x9e, 0x31, 0xba, 0x8f, 0x45, 0xf1, 0x45, 0xaa, 0x71, 0x14, 0x77, 0x4d,
+    0x91, 0x6d, 0x7b, 0x8e, 0xc7, 0x39, 0x57, 0x3e, 0x84, 0xf5, 0x2d, 0x9a,
+    0xf8, 0x47, 0xe2, 0x56, 0x8d, 0x6d, 0xe1, 0xdf, 0x8c, 0x9e, 0x39, 0xd2,
+    0xec, 0x80, 0x16, 0x76, 0x9a, 0xc5, 0xe4, 0x70, 0x85, 0xe8, 0x10, 0xcb,
+    0xb8, 0x01, 0x8f, 0x4d, 0xd8, 0xfc, 0x2b, 0xef, 0x6f, 0x18, 0xea, 0x96,
+    0xff, 0x00, 0x1b, 0xbf, 0x62, 0x4b, 0xcd, 0x63, 0x53, 0x9a, 0x28, 0x24,
+    0xbf, 0xf0, 0xc8, 0xbf, 0x92, 0x79, 0x98, 0x05, 0x4b, 0xa8, 0x90, 0x3e,
+    0xec, 0xf6, 0xfd, 0xec, 0x7c, 0x7d, 0x6b, 0xf3, 0x73, 0x48, 0x62, 0xf2,
+    0x06, 0xc1, 0x19, 0x8f, 0x38, 0x3d, 0x47, 0x4e, 0xb5, 0xf9, 0xbe, 0x7b,
+    0x24, 0x9c, 0x23, 0x05, 0xee, 0xcb, 0xde, 0x5e, 0x57, 0xdf, 0xef, 0xdf,
+    0xd6, 0xe7, 0xf4, 0xdf, 0x02, 0xc2, 0x73, 0xa7, 0x5e, 0xa5, 0x77, 0xfb,
+    0xda, 0x5f, 0xb9, 0x97, 0x9a, 0x83, 0xf7, 0x1b, 0x7d, 0xe2, 0xaf, 0x0f,
+    0xf0, 0xa4, 0x7f, 0xff, 0xd5, 0xf3, 0xef, 0x02, 0xf8, 0xe3, 0x51, 0xf8,
+    0x6f, 0xe3, 0x4b, 0x2f, 0x11, 0x69, 0x4b, 0x14, 0xf7, 0x16, 0xac, 0xe9,
+    0x2d, 0xa5, 0xc0, 0xcc, 0x37, 0x70, 0x38, 0xdb, 0x2c, 0x12, 0x8e, 0xe8,
+    0xeb, 0x91, 0xec, 0x70, 0x7b, 0x57, 0xd9, 0x3a, 0xb7, 0xc7, 0xfb, 0x7f,
+    0xf8, 0x66, 0x8b, 0x8b, 0x3f, 0x86, 0x1e, 0x12, 0xb9, 0xf1, 0x0e, 0x8f,
+    0x1e, 0x98, 0xfa, 0x64, 0xd0, 0x89, 0x44, 0x93, 0xe8, 0x4a, 0xc8, 0x54,
+    0xa5, 0xcd, 0xb8, 0xcc, 0x8e, 0xaa, 0xa5, 0xb6, 0xc8, 0xb9, 0x56, 0x0a,
+    0x32, 0x47, 0x24, 0xfc, 0x3d, 0x2d, 0x8c, 0x9e, 0x63, 0x64, 0xa8, 0x24,
+    0x93, 0xc1, 0x35, 0x77, 0xc3, 0xfa, 0x96, 0xb3, 0xe1, 0x3d, 0x66, 0x1d,
+    0x5b, 0x42, 0xd5, 0x6e, 0x74, 0x6d, 0x56, 0x11, 0x88, 0xef, 0x2c, 0x66,
+    0x68, 0xa4, 0x00, 0xf5, 0x52, 0x47, 0x55, 0x3d, 0xd4, 0xe4, 0x1f, 0x4a,
+    0xfc, 0x7b, 0x05, 0x8f, 0xa9, 0x84, 0x52, 0xa7, 0xf6, 0x65, 0xe9, 0x75,
+    0x7e, 0xd7, 0xfe, 0xbd, 0x0f, 0xec, 0xfc, 0xe3, 0x22, 0xc2, 0xe6, 0xd2,
+    0xa7, 0x5e, 0x69, 0x39, 0xd3, 0x69, 0xab, 0xdf, 0x96, 0x56, 0xbd, 0x94,
+    0xac, 0xd3, 0xd2, 0xee, 0xcf, 0xa5, 0xde, 0x8d, 0x68, 0x7f, 0xff, 0xd6,
+    0xfa, 0xaf, 0xf6, 0x6b, 0xf1, 0xaf, 0x83, 0xfe, 0x1a, 0xfe, 0xc8, 0x96,
+    0xf7, 0x09, 0xe2, 0x9d, 0x3b, 0x54, 0x6d, 0x2f, 0x4e, 0xb9, 0xbe, 0xbe,
+    0x86, 0x39, 0xc7, 0x99, 0x0c, 0xce, 0x59, 0xcc, 0x06, 0x33, 0xf3, 0x06,
+    0x05, 0x82, 0x60, 0x8f, 0x98, 0xf2, 0x32, 0x08, 0xac, 0xef, 0x81, 0xbf,
+    0x15, 0x3c, 0x15, 0xf0, 0xdf, 0xf6, 0x3d, 0xd2, 0x6d, 0x75, 0x2f, 0x16,
+    0x69, 0x27, 0x53, 0x5d, 0x3a, 0xe8, 0x1d, 0x3e, 0x3b, 0xa5, 0x7b, 0x83,
+    0x73, 0x2b, 0x48, 0xe2, 0xdd, 0x62, 0x1f, 0x39, 0x70, 0x5c, 0x2e, 0xd0,
+    0x3a, 0xfb, 0x73, 0x5f, 0x2e, 0x4d, 0xf1, 0xe3, 0x55, 0xd6, 0x5d, 0xe6,
+    0xf1, 0x57, 0x82, 0xbc, 0x07, 0xe3, 0x3b, 0xe7, 0x3b, 0x9f, 0x51, 0xd5,
+    0x34, 0x35, 0x8a, 0xed, 0xff, 0x00, 0xde, 0x96, 0x12, 0x9b, 0xbf, 0x11,
+    0x40, 0xf8, 0xf9, 0xe2, 0x0d, 0x2b, 0xe6, 0xf0, 0x9f, 0x86, 0xbc, 0x19,
+    0xe0, 0x19, 0xca, 0x14, 0x37, 0xbe, 0x1f, 0xd1, 0x10, 0x5e, 0x6d, 0x3c,
+    0x1c, 0x4f, 0x2e, 0xf6, 0x1f, 0x86, 0x2b, 0xf3, 0xd8, 0xe6, 0xd4, 0xa1,
+    0xc8, 0xe2, 0xfe, 0x18, 0xf2, 0xad, 0x1d, 0xf5, 0xb7, 0x9d, 0xba, 0x2e,
+    0xbf, 0x33, 0xfa, 0x52, 0xb7, 0x08, 0x56, 0xc4, 0xba, 0xca, 0xad, 0xdb,
+    0xab, 0x55, 0x55, 0x6f, 0x9a, 0x3c, 0xba, 0x73, 0x69, 0x7e, 0x5e, 0x6f,
+    0xb6, 0xf5, 0xe4, 0x5d, 0x34, 0x3f, 0xff, 0xd7, 0x4d, 0x71, 0x3e, 0x21,
+    0xf8, 0x7f, 0xf6, 0x7a, 0xb0, 0xd0, 0x3c, 0x6f, 0xe2, 0x63, 0xe1, 0xad,
+    0x10, 0xac, 0x2d, 0xa1, 0xf8, 0x2a, 0xe2, 0xd9, 0x45, 0xf6, 0xa4, 0x04,
+    0x9b, 0x99, 0xe5, 0x0a, 0x03, 0xc5, 0x0a, 0x9c, 0xb0, 0x32, 0xf0, 0xcc,
+    0xa0, 0x63, 0xee, 0xd7, 0x93, 0xe9, 0xbf, 0xf1, 0xf2, 0x7f, 0xdc, 0x3f,
+    0xcc, 0x54, 0xba, 0x8c, 0x9a, 0x86, 0xb5, 0xa9, 0x5c, 0xea, 0x5a, 0x95,
+    0xf4, 0xfa, 0x96, 0xa3, 0x72, 0xdb, 0xe7, 0xbc, 0xbc, 0x99, 0xa5, 0x9a,
+    0x56, 0xf5, 0x66, 0x6c, 0x93, 0xfd, 0x29, 0x74, 0xfb, 0x39, 0x05, 0xc1,
+    0xc1, 0x5c, 0xed, 0x3d, 0x49, 0xf5, 0x1e, 0xd5, 0xf8, 0xa5, 0x7a, 0xbe,
+    0xda, 0x69, 0xa4, 0xec, 0x95, 0xb5, 0x77, 0x7f, 0xf0, 0x3d, 0x11, 0xfd,
+    0xcf, 0x85, 0xa1, 0xf5, 0x6a, 0x53, 0xe6, 0xe5, 0xbc, 0x9b, 0x93, 0xe5,
+    0x8a, 0x8a, 0xbb, 0xdf, 0xcd, 0xf9, 0xca, 0x4d, 0xb6, 0xee, 0xf4, 0x56,
+    0x8a, 0xff, 0xd9,
+};
+unsigned int logo_rst_jpg_len = 2259;
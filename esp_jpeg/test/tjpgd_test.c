@@ -14,6 +14,7 @@
 #include "../include/jpeg_decoder.h"
 #include "test_logo_jpg.h"
 #include "test_logo_rgb888.h"
+#include "test_logo_rst_jpg.h"
 
 #define TESTW 46
 #define TESTH 46
@@ -76,3 +77,527 @@ TEST_CASE("Test JPEG decompression library", "[esp_jpeg]")
 
     free(decoded);
 }
+
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;
+    uint32_t pos;
+} test_jpeg_stream_t;
+
+static uint32_t test_jpeg_read_cb(void *user_data, uint8_t *buf, uint32_t len)
+{
+    test_jpeg_stream_t *stream = (test_jpeg_stream_t *)user_data;
+
+    if (stream->pos + len > stream->size) {
+        len = stream->size - stream->pos;
+    }
+    if (buf) {
+        memcpy(buf, &stream->data[stream->pos], len);
+    }
+    stream->pos += len;
+    return len;
+}
+
+TEST_CASE("Test JPEG decompression from input stream", "[esp_jpeg]")
+{
+    unsigned char *decoded, *p, *o;
+    int x;
+    int decoded_outsize = TESTW * TESTH * 3;
+
+    decoded = malloc(decoded_outsize);
+    TEST_ASSERT_NOT_NULL(decoded);
+
+    test_jpeg_stream_t stream = {
+        .data = logo_jpg,
+        .size = sizeof(logo_jpg),
+        .pos = 0,
+    };
+
+    /* JPEG decode */
+    esp_jpeg_image_cfg_t jpeg_cfg = {
+        .in_cb = test_jpeg_read_cb,
+        .in_user_data = &stream,
+        .outbuf = decoded,
+        .outbuf_size = decoded_outsize,
+        .out_format = JPEG_IMAGE_FORMAT_RGB888,
+        .out_scale = JPEG_IMAGE_SCALE_0,
+    };
+    esp_jpeg_image_output_t outimg;
+    esp_err_t err = esp_jpeg_decode(&jpeg_cfg, &outimg);
+    TEST_ASSERT_EQUAL(err, ESP_OK);
+
+    /* Decoded image size */
+    TEST_ASSERT_EQUAL(outimg.width, TESTW);
+    TEST_ASSERT_EQUAL(outimg.height, TESTH);
+
+    p = decoded;
+    o = logo_rgb888;
+    for (x = 0; x < outimg.width * outimg.height; x++) {
+        /* The color can be +- 2 */
+        TEST_ASSERT(p[0] >= (o[0] - 2) && p[0] <= (o[0] + 2));
+        TEST_ASSERT(p[1] >= (o[1] - 2) && p[1] <= (o[1] + 2));
+        TEST_ASSERT(p[2] >= (o[2] - 2) && p[2] <= (o[2] + 2));
+
+        p += 3;
+        o += 3;
+    }
+
+    free(decoded);
+}
+
+typedef struct {
+    uint8_t *frame;
+    int bands;
+    int next_row;
+} test_jpeg_band_ctx_t;
+
+static bool test_jpeg_band_cb(void *user_data, const esp_jpeg_rect_t *rect, const uint8_t *pixels)
+{
+    test_jpeg_band_ctx_t *ctx = (test_jpeg_band_ctx_t *)user_data;
+
+    /* Bands come in order and span the whole width */
+    TEST_ASSERT_EQUAL(rect->x, 0);
+    TEST_ASSERT_EQUAL(rect->width, TESTW);
+    TEST_ASSERT_EQUAL(rect->y, ctx->next_row);
+
+    memcpy(&ctx->frame[rect->y * TESTW * 3], pixels, rect->width * rect->height * 3);
+    ctx->next_row += rect->height;
+    ctx->bands++;
+    return true;
+}
+
+TEST_CASE("Test JPEG decompression with band output callback", "[esp_jpeg]")
+{
+    unsigned char *decoded, *p, *o;
+    int x;
+    int decoded_outsize = TESTW * TESTH * 3;
+
+    decoded = malloc(decoded_outsize);
+    TEST_ASSERT_NOT_NULL(decoded);
+
+    test_jpeg_band_ctx_t ctx = {
+        .frame = decoded,
+    };
+
+    /* JPEG decode, no output buffer is given */
+    esp_jpeg_image_cfg_t jpeg_cfg = {
+        .indata = (uint8_t *)logo_jpg,
+        .indata_size = sizeof(logo_jpg),
+        .out_cb = test_jpeg_band_cb,
+        .out_user_data = &ctx,
+        .out_format = JPEG_IMAGE_FORMAT_RGB888,
+        .out_scale = JPEG_IMAGE_SCALE_0,
+    };
+    esp_jpeg_image_output_t outimg;
+    esp_err_t err = esp_jpeg_decode(&jpeg_cfg, &outimg);
+    TEST_ASSERT_EQUAL(err, ESP_OK);
+
+    TEST_ASSERT_EQUAL(outimg.width, TESTW);
+    TEST_ASSERT_EQUAL(outimg.height, TESTH);
+    TEST_ASSERT_EQUAL(ctx.next_row, TESTH);
+    TEST_ASSERT_GREATER_THAN(1, ctx.bands);
+
+    p = decoded;
+    o = logo_rgb888;
+    for (x = 0; x < outimg.width * outimg.height; x++) {
+        /* The color can be +- 2 */
+        TEST_ASSERT(p[0] >= (o[0] - 2) && p[0] <= (o[0] + 2));
+        TEST_ASSERT(p[1] >= (o[1] - 2) && p[1] <= (o[1] + 2));
+        TEST_ASSERT(p[2] >= (o[2] - 2) && p[2] <= (o[2] + 2));
+
+        p += 3;
+        o += 3;
+    }
+
+    free(decoded);
+}
+
+TEST_CASE("Test JPEG decompression with reusable decoder", "[esp_jpeg]")
+{
+    unsigned char *decoded, *p, *o;
+    int x;
+    int decoded_outsize = TESTW * TESTH * 3;
+
+    decoded = malloc(decoded_outsize);
+    TEST_ASSERT_NOT_NULL(decoded);
+    uint8_t *workbuf = malloc(ESP_JPEG_WORK_BUF_SIZE);
+    TEST_ASSERT_NOT_NULL(workbuf);
+
+    /* Too small work buffer is refused */
+    esp_jpeg_decoder_handle_t decoder = NULL;
+    esp_jpeg_decoder_config_t decoder_cfg = {
+        .workbuf = workbuf,
+        .workbuf_size = ESP_JPEG_WORK_BUF_SIZE - 1,
+    };
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, esp_jpeg_decoder_create(&decoder_cfg, &decoder));
+
+    decoder_cfg.workbuf_size = ESP_JPEG_WORK_BUF_SIZE;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decoder_create(&decoder_cfg, &decoder));
+
+    /* Decode the same image more times with the same decoder */
+    for (int i = 0; i < 3; i++) {
+        memset(decoded, 0, decoded_outsize);
+        esp_jpeg_image_cfg_t jpeg_cfg = {
+            .indata = (uint8_t *)logo_jpg,
+            .indata_size = sizeof(logo_jpg),
+            .outbuf = decoded,
+            .outbuf_size = decoded_outsize,
+            .out_format = JPEG_IMAGE_FORMAT_RGB888,
+            .out_scale = JPEG_IMAGE_SCALE_0,
+        };
+        esp_jpeg_image_output_t outimg;
+        TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decoder_decode(decoder, &jpeg_cfg, &outimg));
+        TEST_ASSERT_EQUAL(outimg.width, TESTW);
+        TEST_ASSERT_EQUAL(outimg.height, TESTH);
+
+        p = decoded;
+        o = logo_rgb888;
+        for (x = 0; x < outimg.width * outimg.height; x++) {
+            /* The color can be +- 2 */
+            TEST_ASSERT(p[0] >= (o[0] - 2) && p[0] <= (o[0] + 2));
+            TEST_ASSERT(p[1] >= (o[1] - 2) && p[1] <= (o[1] + 2));
+            TEST_ASSERT(p[2] >= (o[2] - 2) && p[2] <= (o[2] + 2));
+
+            p += 3;
+            o += 3;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decoder_destroy(decoder));
+    free(workbuf);
+    free(decoded);
+}
+
+TEST_CASE("Test JPEG decompression to RGB565", "[esp_jpeg]")
+{
+    unsigned char *decoded, *p, *o;
+    int x;
+    int decoded_outsize = TESTW * TESTH * 2;
+
+    decoded = malloc(decoded_outsize);
+    TEST_ASSERT_NOT_NULL(decoded);
+
+    for (int swap = 0; swap <= 1; swap++) {
+        esp_jpeg_image_cfg_t jpeg_cfg = {
+            .indata = (uint8_t *)logo_jpg,
+            .indata_size = sizeof(logo_jpg),
+            .outbuf = decoded,
+            .outbuf_size = decoded_outsize,
+            .out_format = JPEG_IMAGE_FORMAT_RGB565,
+            .out_scale = JPEG_IMAGE_SCALE_0,
+            .flags = {
+                .swap_color_bytes = swap,
+            }
+        };
+        esp_jpeg_image_output_t outimg;
+        TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decode(&jpeg_cfg, &outimg));
+        TEST_ASSERT_EQUAL(outimg.width, TESTW);
+        TEST_ASSERT_EQUAL(outimg.height, TESTH);
+
+        p = decoded;
+        o = logo_rgb888;
+        for (x = 0; x < outimg.width * outimg.height; x++) {
+            uint16_t color = swap ? ((p[0] << 8) | p[1]) : ((p[1] << 8) | p[0]);
+            int r = (color >> 8) & 0xF8;
+            int g = (color >> 3) & 0xFC;
+            int b = (color << 3) & 0xF8;
+
+            /* The color can be +- 2, plus the precision lost in RGB565 */
+            TEST_ASSERT(r >= (o[0] - 10) && r <= (o[0] + 2));
+            TEST_ASSERT(g >= (o[1] - 6) && g <= (o[1] + 2));
+            TEST_ASSERT(b >= (o[2] - 10) && b <= (o[2] + 2));
+
+            p += 2;
+            o += 3;
+        }
+    }
+
+    free(decoded);
+}
+
+TEST_CASE("Test JPEG decompression to grayscale and YUV422", "[esp_jpeg]")
+{
+    unsigned char *decoded, *p, *o;
+    int x;
+    int decoded_outsize = TESTW * TESTH * 2;
+
+    decoded = malloc(decoded_outsize);
+    TEST_ASSERT_NOT_NULL(decoded);
+
+    esp_jpeg_image_cfg_t jpeg_cfg = {
+        .indata = (uint8_t *)logo_jpg,
+        .indata_size = sizeof(logo_jpg),
+        .outbuf = decoded,
+        .outbuf_size = decoded_outsize,
+        .out_format = JPEG_IMAGE_FORMAT_GRAY,
+        .out_scale = JPEG_IMAGE_SCALE_0,
+    };
+    esp_jpeg_image_output_t outimg;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decode(&jpeg_cfg, &outimg));
+    TEST_ASSERT_EQUAL(outimg.width, TESTW);
+    TEST_ASSERT_EQUAL(outimg.height, TESTH);
+
+    p = decoded;
+    o = logo_rgb888;
+    for (x = 0; x < outimg.width * outimg.height; x++) {
+        int luma = (77 * o[0] + 150 * o[1] + 29 * o[2]) >> 8;
+        /* The luma can be +- 3 */
+        TEST_ASSERT(p[0] >= (luma - 3) && p[0] <= (luma + 3));
+        p += 1;
+        o += 3;
+    }
+
+#if !CONFIG_JD_FORMAT_GRAYSCALE
+    jpeg_cfg.out_format = JPEG_IMAGE_FORMAT_YUV422;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decode(&jpeg_cfg, &outimg));
+
+    /* Every pixel has its luma on even bytes */
+    p = decoded;
+    o = logo_rgb888;
+    for (x = 0; x < outimg.width * outimg.height; x++) {
+        int luma = (77 * o[0] + 150 * o[1] + 29 * o[2]) >> 8;
+        TEST_ASSERT(p[0] >= (luma - 3) && p[0] <= (luma + 3));
+        p += 2;
+        o += 3;
+    }
+
+    /* Pixel pairs share the average of their chroma, the width is even */
+    p = decoded;
+    o = logo_rgb888;
+    for (x = 0; x < outimg.width * outimg.height; x += 2) {
+        int u = ((((-43 * o[0] - 85 * o[1] + 128 * o[2]) >> 8) + 128) +
+                 (((-43 * o[3] - 85 * o[4] + 128 * o[5]) >> 8) + 128)) >> 1;
+        int v = ((((128 * o[0] - 107 * o[1] - 21 * o[2]) >> 8) + 128) +
+                 (((128 * o[3] - 107 * o[4] - 21 * o[5]) >> 8) + 128)) >> 1;
+        TEST_ASSERT(p[1] >= (u - 3) && p[1] <= (u + 3));
+        TEST_ASSERT(p[3] >= (v - 3) && p[3] <= (v + 3));
+        p += 4;
+        o += 6;
+    }
+#endif
+
+    free(decoded);
+}
+
+TEST_CASE("Test JPEG image info", "[esp_jpeg]")
+{
+    esp_jpeg_image_cfg_t jpeg_cfg = {
+        .indata = (uint8_t *)logo_jpg,
+        .indata_size = sizeof(logo_jpg),
+        .out_format = JPEG_IMAGE_FORMAT_RGB888,
+    };
+    esp_jpeg_image_info_t info;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_get_image_info(&jpeg_cfg, &info));
+
+    TEST_ASSERT_EQUAL(TESTW, info.width);
+    TEST_ASSERT_EQUAL(TESTH, info.height);
+    TEST_ASSERT_EQUAL(3, info.components);
+    TEST_ASSERT_TRUE(info.supported);
+    TEST_ASSERT_EQUAL(TESTW * TESTH * 3, info.output_size[JPEG_IMAGE_SCALE_0]);
+    TEST_ASSERT_EQUAL((TESTW / 2) * (TESTH / 2) * 3, info.output_size[JPEG_IMAGE_SCALE_1_2]);
+    TEST_ASSERT_EQUAL((TESTW / 8) * (TESTH / 8) * 3, info.output_size[JPEG_IMAGE_SCALE_1_8]);
+
+    /* Headers only were read */
+    TEST_ASSERT_LESS_THAN(sizeof(logo_jpg), jpeg_cfg.priv.read);
+
+    /* Truncated image */
+    jpeg_cfg.indata_size = 100;
+    TEST_ASSERT_EQUAL(ESP_FAIL, esp_jpeg_get_image_info(&jpeg_cfg, &info));
+}
+
+TEST_CASE("Test JPEG decompression with crop rectangle", "[esp_jpeg]")
+{
+    const esp_jpeg_rect_t crop = {
+        .x = 13,
+        .y = 17,
+        .width = 21,
+        .height = 10,
+    };
+    unsigned char *decoded, *p, *o;
+    int decoded_outsize = crop.width * crop.height * 3;
+
+    decoded = malloc(decoded_outsize);
+    TEST_ASSERT_NOT_NULL(decoded);
+
+    esp_jpeg_image_cfg_t jpeg_cfg = {
+        .indata = (uint8_t *)logo_jpg,
+        .indata_size = sizeof(logo_jpg),
+        .outbuf = decoded,
+        .outbuf_size = decoded_outsize,
+        .out_format = JPEG_IMAGE_FORMAT_RGB888,
+        .out_scale = JPEG_IMAGE_SCALE_0,
+        .crop = crop,
+    };
+    esp_jpeg_image_output_t outimg;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decode(&jpeg_cfg, &outimg));
+    TEST_ASSERT_EQUAL(crop.width, outimg.width);
+    TEST_ASSERT_EQUAL(crop.height, outimg.height);
+
+    /* Decoding stopped before the end of the image */
+    TEST_ASSERT_LESS_THAN(sizeof(logo_jpg), jpeg_cfg.priv.read);
+
+    p = decoded;
+    for (int y = 0; y < crop.height; y++) {
+        o = logo_rgb888 + ((crop.y + y) * TESTW + crop.x) * 3;
+        for (int x = 0; x < crop.width; x++) {
+            /* The color can be +- 2 */
+            TEST_ASSERT(p[0] >= (o[0] - 2) && p[0] <= (o[0] + 2));
+            TEST_ASSERT(p[1] >= (o[1] - 2) && p[1] <= (o[1] + 2));
+            TEST_ASSERT(p[2] >= (o[2] - 2) && p[2] <= (o[2] + 2));
+            p += 3;
+            o += 3;
+        }
+    }
+
+    /* Crop rectangle out of the image */
+    jpeg_cfg.crop.x = TESTW - crop.width + 1;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_jpeg_decode(&jpeg_cfg, &outimg));
+
+    free(decoded);
+}
+
+TEST_CASE("Test JPEG parallel decompression of restart intervals", "[esp_jpeg]")
+{
+    unsigned char *decoded, *reference;
+    int decoded_outsize = TESTW * TESTH * 3;
+
+    decoded = calloc(1, decoded_outsize);
+    reference = calloc(1, decoded_outsize);
+    TEST_ASSERT_NOT_NULL(decoded);
+    TEST_ASSERT_NOT_NULL(reference);
+
+    esp_jpeg_image_cfg_t jpeg_cfg = {
+        .indata = (uint8_t *)logo_rst_jpg,
+        .indata_size = sizeof(logo_rst_jpg),
+        .outbuf = reference,
+        .outbuf_size = decoded_outsize,
+        .out_format = JPEG_IMAGE_FORMAT_RGB888,
+        .out_scale = JPEG_IMAGE_SCALE_0,
+    };
+    esp_jpeg_image_info_t info;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_get_image_info(&jpeg_cfg, &info));
+    TEST_ASSERT_EQUAL(1, info.restart_interval);
+
+    /* Sequential decoding as reference */
+    esp_jpeg_image_output_t outimg;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decode(&jpeg_cfg, &outimg));
+
+    esp_jpeg_decoder_handle_t decoder = NULL;
+    esp_jpeg_decoder_config_t decoder_cfg = {
+        .flags = {
+            .parallel = 1,
+        },
+    };
+    esp_err_t err = esp_jpeg_decoder_create(&decoder_cfg, &decoder);
+    if (err == ESP_ERR_NOT_SUPPORTED) {
+        free(decoded);
+        free(reference);
+        TEST_IGNORE_MESSAGE("Parallel decoding is not supported with current configuration");
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, err);
+
+    jpeg_cfg.outbuf = decoded;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decoder_decode(decoder, &jpeg_cfg, &outimg));
+    TEST_ASSERT_EQUAL(TESTW, outimg.width);
+    TEST_ASSERT_EQUAL(TESTH, outimg.height);
+    TEST_ASSERT_EQUAL_MEMORY(reference, decoded, decoded_outsize);
+
+    /* Image without restart intervals is decoded on one core */
+    jpeg_cfg.indata = (uint8_t *)logo_jpg;
+    jpeg_cfg.indata_size = sizeof(logo_jpg);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decoder_decode(decoder, &jpeg_cfg, &outimg));
+    TEST_ASSERT_EQUAL(TESTW, outimg.width);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decoder_destroy(decoder));
+    free(decoded);
+    free(reference);
+}
+
+/* MJPEG frame of a UVC camera: JPEG image without DHT segments */
+static uint32_t test_jpeg_strip_dht(const uint8_t *in, uint32_t size, uint8_t *out)
+{
+    uint32_t i = 2, o = 2;
+
+    memcpy(out, in, 2);
+    while (i + 4 <= size) {
+        uint32_t len = ((in[i + 2] << 8) | in[i + 3]) + 2;
+        if (in[i + 1] == 0xDA) {
+            /* Start of scan and the rest of the image */
+            memcpy(out + o, in + i, size - i);
+            return o + size - i;
+        }
+        if (in[i + 1] != 0xC4) {
+            memcpy(out + o, in + i, len);
+            o += len;
+        }
+        i += len;
+    }
+    return o;
+}
+
+TEST_CASE("Test JPEG decompression of MJPEG stream", "[esp_jpeg]")
+{
+    unsigned char *decoded, *reference, *mjpeg;
+    int decoded_outsize = TESTW * TESTH * 3;
+
+    decoded = calloc(1, decoded_outsize);
+    reference = calloc(1, decoded_outsize);
+    mjpeg = malloc(sizeof(logo_rst_jpg));
+    TEST_ASSERT_NOT_NULL(decoded);
+    TEST_ASSERT_NOT_NULL(reference);
+    TEST_ASSERT_NOT_NULL(mjpeg);
+    uint32_t mjpeg_size = test_jpeg_strip_dht(logo_rst_jpg, sizeof(logo_rst_jpg), mjpeg);
+    TEST_ASSERT_LESS_THAN(sizeof(logo_rst_jpg), mjpeg_size);
+
+    /* The image has the standard huffman tables, so the reference is decoded from the whole image */
+    esp_jpeg_image_cfg_t jpeg_cfg = {
+        .indata = (uint8_t *)logo_rst_jpg,
+        .indata_size = sizeof(logo_rst_jpg),
+        .outbuf = reference,
+        .outbuf_size = decoded_outsize,
+        .out_format = JPEG_IMAGE_FORMAT_RGB888,
+        .out_scale = JPEG_IMAGE_SCALE_0,
+    };
+    esp_jpeg_image_output_t outimg;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decode(&jpeg_cfg, &outimg));
+
+    /* Without DHT, the image cannot be decoded without stream mode */
+    jpeg_cfg.indata = mjpeg;
+    jpeg_cfg.indata_size = mjpeg_size;
+    jpeg_cfg.outbuf = decoded;
+    TEST_ASSERT_EQUAL(ESP_FAIL, esp_jpeg_decode(&jpeg_cfg, &outimg));
+
+    esp_jpeg_decoder_handle_t decoder = NULL;
+    esp_jpeg_decoder_config_t decoder_cfg = {
+        .flags = {
+            .stream = 1,
+        },
+    };
+    esp_err_t err = esp_jpeg_decoder_create(&decoder_cfg, &decoder);
+    if (err == ESP_ERR_NOT_SUPPORTED) {
+        free(decoded);
+        free(reference);
+        free(mjpeg);
+        TEST_IGNORE_MESSAGE("Stream mode is not supported with the ROM decoder");
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, err);
+
+    /* Frames with the same tables, then an image with other tables, then frames again */
+    for (int i = 0; i < 5; i++) {
+        const bool other_tables = (i == 2);
+        jpeg_cfg.indata = other_tables ? (uint8_t *)logo_jpg : mjpeg;
+        jpeg_cfg.indata_size = other_tables ? sizeof(logo_jpg) : mjpeg_size;
+        memset(decoded, 0, decoded_outsize);
+        TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decoder_decode(decoder, &jpeg_cfg, &outimg));
+        TEST_ASSERT_EQUAL(TESTW, outimg.width);
+        TEST_ASSERT_EQUAL(TESTH, outimg.height);
+        if (!other_tables) {
+            TEST_ASSERT_EQUAL_MEMORY(reference, decoded, decoded_outsize);
+        }
+    }
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_jpeg_decoder_destroy(decoder));
+    free(decoded);
+    free(reference);
+    free(mjpeg);
+}
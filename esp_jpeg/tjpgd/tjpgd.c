@@ -754,7 +754,8 @@ static void block_idct (
 /*-----------------------------------------------------------------------*/
 
 static JRESULT mcu_load (
-    JDEC *jd        /* Pointer to the decompressor object */
+    JDEC *jd,       /* Pointer to the decompressor object */
+    int idct        /* 0:Only decode the stream (MCU is not output), 1:Apply IDCT */
 )
 {
     int32_t *tmp = (int32_t *)jd->workbuf;  /* Block working buffer for de-quantize and IDCT */
@@ -828,7 +829,7 @@ static JRESULT mcu_load (
                 }
             } while (++z < 64);     /* Next AC element */
 
-            if (JD_FORMAT != 2 || !cmp) {   /* C components may not be processed if in grayscale output */
+            if (idct && (JD_FORMAT != 2 || !cmp)) {   /* C components may not be processed if in grayscale output */
                 if (z == 1 || (JD_USE_SCALE && jd->scale == 3)) {   /* If no AC element or scale ratio is 1/8, IDCT can be ommited and the block is filled with DC value */
                     d = (jd_yuv_t)((*tmp / 256) + 128);
                     if (JD_FASTDECODE >= 1) {
@@ -887,7 +888,7 @@ static JRESULT mcu_output (
     if (!JD_USE_SCALE || jd->scale != 3) {  /* Not for 1/8 scaling */
         pix = (uint8_t *)jd->workbuf;
 
-        if (JD_FORMAT != 2) {   /* RGB output (build an RGB MCU from Y/C component) */
+        if (JD_FORMAT != 2) {   /* RGB or YCbCr output (build an RGB/YCbCr MCU from Y/C component) */
             for (iy = 0; iy < my; iy++) {
                 pc = py = jd->mcubuf;
                 if (my == 16) {     /* Double block height? */
@@ -911,9 +912,15 @@ static JRESULT mcu_output (
                         pc++;                       /* Step forward chroma pointer every pixel */
                     }
                     yy = *py++;         /* Get Y component */
-                    *pix++ = /*R*/ BYTECLIP(yy + ((int)(1.402 * CVACC) * cr) / CVACC);
-                    *pix++ = /*G*/ BYTECLIP(yy - ((int)(0.344 * CVACC) * cb + (int)(0.714 * CVACC) * cr) / CVACC);
-                    *pix++ = /*B*/ BYTECLIP(yy + ((int)(1.772 * CVACC) * cb) / CVACC);
+                    if (JD_FORMAT == 3) {   /* YCbCr output, no color conversion */
+                        *pix++ = BYTECLIP(yy);
+                        *pix++ = BYTECLIP(cb + 128);
+                        *pix++ = BYTECLIP(cr + 128);
+                    } else {
+                        *pix++ = /*R*/ BYTECLIP(yy + ((int)(1.402 * CVACC) * cr) / CVACC);
+                        *pix++ = /*G*/ BYTECLIP(yy - ((int)(0.344 * CVACC) * cb + (int)(0.714 * CVACC) * cr) / CVACC);
+                        *pix++ = /*B*/ BYTECLIP(yy + ((int)(1.772 * CVACC) * cb) / CVACC);
+                    }
                 }
             }
         } else {    /* Monochrome output (build a grayscale MCU from Y comopnent) */
@@ -930,7 +937,7 @@ static JRESULT mcu_output (
                             py += 64 - 8;    /* Jump to next block if double block height */
                         }
                     }
-                    *pix++ = (uint8_t) * py++;          /* Get and store a Y value as grayscale */
+                    *pix++ = BYTECLIP(*py++);          /* Get and store a Y value as grayscale */
                 }
             }
         }
@@ -983,12 +990,16 @@ static JRESULT mcu_output (
             for (ix = 0; ix < mx; ix += 8) {
                 yy = *py;   /* Get Y component */
                 py += 64;
-                if (JD_FORMAT != 2) {
+                if (JD_FORMAT == 3) {
+                    *pix++ = BYTECLIP(yy);
+                    *pix++ = BYTECLIP(cb + 128);
+                    *pix++ = BYTECLIP(cr + 128);
+                } else if (JD_FORMAT != 2) {
                     *pix++ = /*R*/ BYTECLIP(yy + ((int)(1.402 * CVACC) * cr / CVACC));
                     *pix++ = /*G*/ BYTECLIP(yy - ((int)(0.344 * CVACC) * cb + (int)(0.714 * CVACC) * cr) / CVACC);
                     *pix++ = /*B*/ BYTECLIP(yy + ((int)(1.772 * CVACC) * cb / CVACC));
                 } else {
-                    *pix++ = yy;
+                    *pix++ = BYTECLIP(yy);
                 }
             }
         }
@@ -1034,29 +1045,217 @@ static JRESULT mcu_output (
 
 
 
+#define LDB_WORD(ptr)       (uint16_t)(((uint16_t)*((uint8_t*)(ptr))<<8)|(uint16_t)*(uint8_t*)((ptr)+1))
+
+
+
 /*-----------------------------------------------------------------------*/
-/* Analyze the JPEG image and Initialize decompressor object             */
+/* Tables kept between the images of a stream                            */
 /*-----------------------------------------------------------------------*/
 
-#define LDB_WORD(ptr)       (uint16_t)(((uint16_t)*((uint8_t*)(ptr))<<8)|(uint16_t)*(uint8_t*)((ptr)+1))
+/* Content of DHT segment with the standard huffman tables (ITU-T T.81 Annex K.3),
+   used by MJPEG frames without DHT segment */
+static const uint8_t StdDht[] = {
+    0x00,   /* DC table 0 (luminance) */
+    0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B,
+    0x10,   /* AC table 0 (luminance) */
+    0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7D,
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+    0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0,
+    0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7,
+    0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5,
+    0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE1, 0xE2,
+    0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+    0xF9, 0xFA,
+    0x01,   /* DC table 1 (chrominance) */
+    0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B,
+    0x11,   /* AC table 1 (chrominance) */
+    0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77,
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+    0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0,
+    0x15, 0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19, 0x1A, 0x26,
+    0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+    0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+    0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5,
+    0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3,
+    0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA,
+    0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+    0xF9, 0xFA
+};
 
+#define TBL_NOCACHE ((size_t)-1)    /* The tables of the image are not cached */
 
-JRESULT jd_prepare (
+
+static void load_tbl (JDEC *jd, const JDTBL *tc)
+{
+    memcpy(jd->huffbits, tc->huffbits, sizeof jd->huffbits);
+    memcpy(jd->huffcode, tc->huffcode, sizeof jd->huffcode);
+    memcpy(jd->huffdata, tc->huffdata, sizeof jd->huffdata);
+    memcpy(jd->qttbl, tc->qttbl, sizeof jd->qttbl);
+#if JD_FASTDECODE == 2
+    memcpy(jd->longofs, tc->longofs, sizeof jd->longofs);
+    memcpy(jd->hufflut_ac, tc->hufflut_ac, sizeof jd->hufflut_ac);
+    memcpy(jd->hufflut_dc, tc->hufflut_dc, sizeof jd->hufflut_dc);
+#endif
+}
+
+
+static void save_tbl (const JDEC *jd, JDTBL *tc)
+{
+    memcpy(tc->huffbits, jd->huffbits, sizeof tc->huffbits);
+    memcpy(tc->huffcode, jd->huffcode, sizeof tc->huffcode);
+    memcpy(tc->huffdata, jd->huffdata, sizeof tc->huffdata);
+    memcpy(tc->qttbl, jd->qttbl, sizeof tc->qttbl);
+#if JD_FASTDECODE == 2
+    memcpy(tc->longofs, jd->longofs, sizeof tc->longofs);
+    memcpy(tc->hufflut_ac, jd->hufflut_ac, sizeof tc->hufflut_ac);
+    memcpy(tc->hufflut_dc, jd->hufflut_dc, sizeof tc->hufflut_dc);
+#endif
+}
+
+
+static void forget_tbl (JDTBL *tc)
+{
+    JDEC empty;
+
+
+    memset(&empty, 0, sizeof empty);
+    save_tbl(&empty, tc);   /* No table in the cache, the memory pool is still used */
+    tc->nsegs = 0;
+}
+
+
+static void reset_tbl (JDEC *jd, JDTBL *tc)
+{
+    forget_tbl(tc);
+    load_tbl(jd, tc);       /* No table in the decompressor */
+    tc->used = 0;
+}
+
+
+/* Create the tables of a DQT (0xDB) or DHT (0xC4) segment in the memory pool of the cache */
+static JRESULT create_tbl (JDEC *jd, JDTBL *tc, uint8_t type, const uint8_t *data, size_t ndata)
+{
+    void *pool = jd->pool;
+    size_t sz_pool = jd->sz_pool;
+    JRESULT rc;
+
+
+    jd->pool = (uint8_t *)tc->pool + tc->used;
+    jd->sz_pool = tc->sz_pool - tc->used;
+    rc = (type == 0xC4) ? create_huffman_tbl(jd, data, ndata) : create_qt_tbl(jd, data, ndata);
+    tc->used = tc->sz_pool - jd->sz_pool;
+    jd->pool = pool; jd->sz_pool = sz_pool;
+
+    return rc;
+}
+
+
+/* Build again the tables of the first nsegs bytes of cached segments */
+static JRESULT rebuild_tbl (JDEC *jd, JDTBL *tc, size_t nsegs)
+{
+    size_t ofs, len;
+    JRESULT rc;
+
+
+    reset_tbl(jd, tc);
+    for (ofs = 0; ofs < nsegs; ofs += 3 + len) {
+        len = LDB_WORD(tc->segs + ofs + 1);
+        rc = create_tbl(jd, tc, tc->segs[ofs], tc->segs + ofs + 3, len);
+        if (rc) {
+            reset_tbl(jd, tc);
+            return rc;
+        }
+    }
+    tc->nsegs = nsegs;
+    save_tbl(jd, tc);
+
+    return JDR_OK;
+}
+
+
+/* Load the tables of a segment, unless the previous image had the same segment at the same position */
+static JRESULT cache_tbl (JDEC *jd, JDTBL *tc, uint8_t type, const uint8_t *data, size_t ndata, size_t *cofs)
+{
+    uint8_t *cs;
+    JRESULT rc;
+
+
+    if (*cofs == TBL_NOCACHE) {     /* Segments of the image do not fit in the cache */
+        return create_tbl(jd, tc, type, data, ndata);
+    }
+
+    cs = tc->segs + *cofs;
+    if (*cofs + 3 + ndata <= tc->nsegs && cs[0] == type && LDB_WORD(cs + 1) == ndata && !memcmp(cs + 3, data, ndata)) {
+        *cofs += 3 + ndata;         /* Same segment, its tables are already built */
+        return JDR_OK;
+    }
+
+    /* Different segment: the tables of the preceding segments are built again and this segment is added */
+    rc = rebuild_tbl(jd, tc, *cofs);
+    if (rc) {
+        return rc;
+    }
+    rc = create_tbl(jd, tc, type, data, ndata);
+    if (rc) {
+        reset_tbl(jd, tc);
+        return rc;
+    }
+    if (*cofs + 3 + ndata > tc->sz_segs) {
+        *cofs = TBL_NOCACHE;        /* The tables are kept for this image only */
+        forget_tbl(tc);
+        return JDR_OK;
+    }
+    cs[0] = type;
+    cs[1] = (uint8_t)(ndata >> 8); cs[2] = (uint8_t)ndata;
+    memcpy(cs + 3, data, ndata);
+    *cofs += 3 + ndata;
+    tc->nsegs = *cofs;
+    save_tbl(jd, tc);
+
+    return JDR_OK;
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Analyze the JPEG image and Initialize decompressor object             */
+/*-----------------------------------------------------------------------*/
+/* With the table cache (tc), the DQT/DHT tables are built in the memory pool
+   of the cache and kept for the next image. The tables of segments identical
+   to the previous image are not built again, and the standard huffman tables
+   are used when there is no DHT segment (MJPEG) */
+
+JRESULT jd_prepare_stream (
     JDEC *jd,               /* Blank decompressor object */
     size_t (*infunc)(JDEC *, uint8_t *, size_t), /* JPEG strem input function */
     void *pool,             /* Working buffer for the decompression session */
     size_t sz_pool,         /* Size of working buffer */
-    void *dev               /* I/O device identifier for the session */
+    void *dev,              /* I/O device identifier for the session */
+    JDTBL *tc               /* Table cache of the stream (NULL:tables are built in the working buffer) */
 )
 {
     uint8_t *seg, b;
     uint16_t marker;
     unsigned int n, i, ofs;
-    size_t len;
+    size_t len, cofs;
+    int dht;
     JRESULT rc;
 
 
     memset(jd, 0, sizeof (JDEC));   /* Clear decompression object (this might be a problem if machine's null pointer is not all bits zero) */
+    if (tc) {
+        load_tbl(jd, tc);   /* Tables of the previous image */
+    }
+    cofs = 0; dht = 0;      /* Offset of the next segment in the cache, DHT segment found */
     jd->pool = pool;        /* Work memroy */
     jd->sz_pool = sz_pool;  /* Size of given work memory */
     jd->infunc = infunc;    /* Stream input function */
@@ -1144,10 +1343,11 @@ JRESULT jd_prepare (
                 return JDR_INP;    /* Load segment data */
             }
 
-            rc = create_huffman_tbl(jd, seg, len);  /* Create huffman tables */
+            rc = tc ? cache_tbl(jd, tc, 0xC4, seg, len, &cofs) : create_huffman_tbl(jd, seg, len);  /* Create huffman tables */
             if (rc) {
                 return rc;
             }
+            dht = 1;
             break;
 
         case 0xDB:  /* DQT - Define Quaitizer Tables */
@@ -1158,7 +1358,7 @@ JRESULT jd_prepare (
                 return JDR_INP;    /* Load segment data */
             }
 
-            rc = create_qt_tbl(jd, seg, len);   /* Create de-quantizer tables */
+            rc = tc ? cache_tbl(jd, tc, 0xDB, seg, len, &cofs) : create_qt_tbl(jd, seg, len);  /* Create de-quantizer tables */
             if (rc) {
                 return rc;
             }
@@ -1179,6 +1379,21 @@ JRESULT jd_prepare (
                 return JDR_FMT3;    /* Err: Wrong color components */
             }
 
+            if (tc) {
+                if (!dht) {         /* No DHT segment: standard huffman tables */
+                    rc = cache_tbl(jd, tc, 0xC4, StdDht, sizeof StdDht, &cofs);
+                    if (rc) {
+                        return rc;
+                    }
+                }
+                if (cofs != TBL_NOCACHE && cofs != tc->nsegs) { /* Less segments than in the previous image */
+                    rc = rebuild_tbl(jd, tc, cofs);
+                    if (rc) {
+                        return rc;
+                    }
+                }
+            }
+
             /* Check if all tables corresponding to each components have been loaded */
             for (i = 0; i < jd->ncomp; i++) {
                 b = seg[2 + 2 * i]; /* Get huffman table ID */
@@ -1247,6 +1462,20 @@ JRESULT jd_prepare (
 
 
 
+JRESULT jd_prepare (
+    JDEC *jd,               /* Blank decompressor object */
+    size_t (*infunc)(JDEC *, uint8_t *, size_t), /* JPEG strem input function */
+    void *pool,             /* Working buffer for the decompression session */
+    size_t sz_pool,         /* Size of working buffer */
+    void *dev               /* I/O device identifier for the session */
+)
+{
+    return jd_prepare_stream(jd, infunc, pool, sz_pool, dev, 0);
+}
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Start to decompress the JPEG picture                                  */
 /*-----------------------------------------------------------------------*/
@@ -1259,6 +1488,7 @@ JRESULT jd_decomp (
 {
     unsigned int x, y, mx, my;
     uint16_t rst, rsc;
+    int out;
     JRESULT rc;
 
 
@@ -1274,6 +1504,9 @@ JRESULT jd_decomp (
 
     rc = JDR_OK;
     for (y = 0; y < jd->height; y += my) {      /* Vertical loop of MCUs */
+        if (jd->roi && (y >> jd->scale) > jd->roi->bottom) {
+            break;    /* Rest of the image is below the region of interest */
+        }
         for (x = 0; x < jd->width; x += mx) {   /* Horizontal loop of MCUs */
             if (jd->nrst && rst++ == jd->nrst) {    /* Process restart interval if enabled */
                 rc = restart(jd, rsc++);
@@ -1282,10 +1515,15 @@ JRESULT jd_decomp (
                 }
                 rst = 1;
             }
-            rc = mcu_load(jd);                  /* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
+            out = !jd->roi || (((x + mx) >> jd->scale) > jd->roi->left && (x >> jd->scale) <= jd->roi->right &&
+                               ((y + my) >> jd->scale) > jd->roi->top);  /* Is the MCU in the region of interest? */
+            rc = mcu_load(jd, out);             /* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
             if (rc != JDR_OK) {
                 return rc;
             }
+            if (!out) {
+                continue;    /* Huffman stream is decoded to keep DC values, but the MCU is not output */
+            }
             rc = mcu_output(jd, outfunc, x, y); /* Output the MCU (YCbCr to RGB, scaling and output) */
             if (rc != JDR_OK) {
                 return rc;
@@ -1295,3 +1533,79 @@ JRESULT jd_decomp (
 
     return rc;
 }
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Decompress a slice of restart intervals (for parallel decoding)       */
+/*-----------------------------------------------------------------------*/
+/* The input stream must be positioned just behind the RST marker which precedes
+   the first interval of the slice (or at the start of scan for the first interval) */
+
+JRESULT jd_decomp_rst (
+    JDEC *jd,                               /* Initialized decompression object */
+    int (*outfunc)(JDEC *, void *, JRECT *), /* RGB output function */
+    uint8_t scale,                          /* Output de-scaling factor (0 to 3) */
+    uint16_t rsti,                          /* First restart interval of the slice */
+    uint16_t nrsti                          /* Number of restart intervals in the slice */
+)
+{
+    unsigned int x, y, mx, my, n, mcu, mcu_end, mcu_row;
+    uint16_t rst, rsc;
+    int out;
+    JRESULT rc;
+
+
+    if (scale > (JD_USE_SCALE ? 3 : 0) || !jd->nrst) {
+        return JDR_PAR;
+    }
+    jd->scale = scale;
+
+    mx = jd->msx * 8; my = jd->msy * 8;         /* Size of the MCU (pixel) */
+    mcu_row = (jd->width + mx - 1) / mx;        /* Number of MCUs in a row */
+    n = mcu_row * ((jd->height + my - 1) / my); /* Number of MCUs in the image */
+    mcu = (unsigned int)rsti * jd->nrst;        /* First MCU of the slice */
+    mcu_end = mcu + (unsigned int)nrsti * jd->nrst;
+    if (mcu_end > n) {
+        mcu_end = n;
+    }
+
+    /* Discard buffered input, the stream has been moved to the slice */
+    jd->dctr = 0; jd->dbit = 0;
+#if JD_FASTDECODE >= 1
+    jd->wreg = 0; jd->marker = 0;
+#endif
+    jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;   /* Initialize DC values */
+    rst = 0; rsc = rsti;
+
+    rc = JDR_OK;
+    for (; mcu < mcu_end; mcu++) {
+        x = (mcu % mcu_row) * mx; y = (mcu / mcu_row) * my;
+        if (jd->roi && (y >> jd->scale) > jd->roi->bottom) {
+            break;    /* Rest of the slice is below the region of interest */
+        }
+        if (rst++ == jd->nrst) {                /* Process restart interval */
+            rc = restart(jd, rsc++);
+            if (rc != JDR_OK) {
+                return rc;
+            }
+            rst = 1;
+        }
+        out = !jd->roi || (((x + mx) >> jd->scale) > jd->roi->left && (x >> jd->scale) <= jd->roi->right &&
+                           ((y + my) >> jd->scale) > jd->roi->top);  /* Is the MCU in the region of interest? */
+        rc = mcu_load(jd, out);                 /* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
+        if (rc != JDR_OK) {
+            return rc;
+        }
+        if (!out) {
+            continue;
+        }
+        rc = mcu_output(jd, outfunc, x, y);     /* Output the MCU (YCbCr to RGB, scaling and output) */
+        if (rc != JDR_OK) {
+            return rc;
+        }
+    }
+
+    return rc;
+}
@@ -86,13 +86,37 @@ struct JDEC {
     size_t sz_pool;             /* Size of momory pool (bytes available) */
     size_t (*infunc)(JDEC *, uint8_t *, size_t); /* Pointer to jpeg stream input function */
     void *device;               /* Pointer to I/O device identifiler for the session */
+    const JRECT *roi;           /* Region of interest in output image (NULL:whole image), MCUs out of it are not transformed nor output */
 };
 
 
 
+/* Tables kept between the images of a stream (e.g. MJPEG frames) */
+typedef struct {
+    void *pool;                 /* Memory pool for the tables (word aligned) */
+    size_t sz_pool;             /* Size of memory pool */
+    size_t used;                /* Bytes of memory pool used by the tables */
+    uint8_t *segs;              /* Copy of the DQT/DHT segments the tables were built from: type, length (2 bytes), content */
+    size_t sz_segs;             /* Size of segment buffer */
+    size_t nsegs;               /* Bytes of segment buffer used */
+    uint8_t *huffbits[2][2];    /* Tables built from the segments */
+    uint16_t *huffcode[2][2];
+    uint8_t *huffdata[2][2];
+    int32_t *qttbl[4];
+#if JD_FASTDECODE == 2
+    uint8_t longofs[2][2];
+    uint16_t *hufflut_ac[2];
+    uint8_t *hufflut_dc[2];
+#endif
+} JDTBL;
+
+
+
 /* TJpgDec API functions */
 JRESULT jd_prepare (JDEC *jd, size_t (*infunc)(JDEC *, uint8_t *, size_t), void *pool, size_t sz_pool, void *dev);
+JRESULT jd_prepare_stream (JDEC *jd, size_t (*infunc)(JDEC *, uint8_t *, size_t), void *pool, size_t sz_pool, void *dev, JDTBL *tc);
 JRESULT jd_decomp (JDEC *jd, int (*outfunc)(JDEC *, void *, JRECT *), uint8_t scale);
+JRESULT jd_decomp_rst (JDEC *jd, int (*outfunc)(JDEC *, void *, JRECT *), uint8_t scale, uint16_t rsti, uint16_t nrsti);
 
 
 #ifdef __cplusplus
@@ -12,6 +12,7 @@
 /  0: RGB888 (24-bit/pix)
 /  1: RGB565 (16-bit/pix)
 /  2: Grayscale (8-bit/pix)
+/  3: YCbCr (24-bit/pix), without color conversion
 */
 
 #define JD_USE_SCALE    CONFIG_JD_USE_SCALE
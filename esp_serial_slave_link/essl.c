@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
@@ -68,18 +70,32 @@ esp_err_t essl_send_packet(essl_handle_t handle, const void *start, size_t lengt
     uint32_t pre = xTaskGetTickCount();
     uint32_t now;
     uint32_t remain_wait_ms = 0;
+    const int64_t start_us = esp_timer_get_time();
+    int64_t attempt_us;
 
     do {
         now = xTaskGetTickCount();
         remain_wait_ms = pdTICKS_TO_MS(TIME_REMAIN(pre, now, timeout_ticks));
+        attempt_us = esp_timer_get_time();
         err = handle->send_packet(handle->args, start, length, remain_wait_ms);
         if (err == ESP_OK) {
             break;
         } else if (err != ESP_ERR_NOT_FOUND) {
-            return err;
+            break;
         } // else ESP_ERR_NOT_FOUND
         //the slave is not ready, retry
+        handle->stats.tx_retries++;
     } while (remain_wait_ms > 0);
+
+    // The time before the last attempt was spent waiting for the slave buffers
+    handle->stats.tx_wait_us += attempt_us - start_us;
+    handle->stats.tx_time_us += esp_timer_get_time() - start_us;
+    if (err == ESP_OK) {
+        handle->stats.tx_bytes += length;
+        handle->stats.tx_packets++;
+    } else if (err != ESP_ERR_NOT_FOUND) {
+        handle->stats.errors++;
+    }
     return err;
 }
 
@@ -100,6 +116,7 @@ esp_err_t essl_get_packet(essl_handle_t handle, void *out_data, size_t size, siz
     uint32_t pre = xTaskGetTickCount();
     uint32_t now = 3;
     uint32_t wait_remain_ms = 0;
+    const int64_t start_us = esp_timer_get_time();
     int data_available = handle->get_rx_data_size(handle->args);
 
     // if there is already enough data to read, skip the length update.
@@ -110,17 +127,22 @@ esp_err_t essl_get_packet(essl_handle_t handle, void *out_data, size_t size, siz
             wait_remain_ms = pdTICKS_TO_MS(TIME_REMAIN(pre, now, timeout_ticks));
             err = handle->update_rx_data_size(handle->args, wait_remain_ms);
             if (err != ESP_OK) {
+                handle->stats.errors++;
                 return err;
             }
             data_available = handle->get_rx_data_size(handle->args);
             if (data_available > 0) {
                 break;
             }
+            handle->stats.rx_retries++;
         } while (wait_remain_ms > 0);
     }
 
+    const int64_t read_us = esp_timer_get_time();
+    handle->stats.rx_wait_us += read_us - start_us;
     if (data_available == 0) {
         //the slave has no data to send
+        handle->stats.rx_time_us += read_us - start_us;
         return ESP_ERR_NOT_FOUND;
     }
 
@@ -128,9 +150,13 @@ esp_err_t essl_get_packet(essl_handle_t handle, void *out_data, size_t size, siz
     now = xTaskGetTickCount();
     wait_remain_ms = pdTICKS_TO_MS(TIME_REMAIN(pre, now, timeout_ticks));
     err = handle->get_packet(handle->args, out_data, len, wait_remain_ms);
+    handle->stats.rx_time_us += esp_timer_get_time() - start_us;
     if (err != ESP_OK) {
+        handle->stats.errors++;
         return err;
     }
+    handle->stats.rx_bytes += len;
+    handle->stats.rx_packets++;
 
     *out_length = len;
     if (len < data_available) {
@@ -148,7 +174,9 @@ esp_err_t essl_get_tx_buffer_num(essl_handle_t handle, uint32_t *out_tx_num, uin
         return ESP_ERR_NOT_SUPPORTED;
     }
 
+    const int64_t start_us = esp_timer_get_time();
     esp_err_t err = handle->update_tx_buffer_num(handle->args, wait_ms);
+    handle->stats.tx_wait_us += esp_timer_get_time() - start_us;
     if (err != ESP_OK) {
         return err;
     }
@@ -175,6 +203,24 @@ esp_err_t essl_get_rx_data_size(essl_handle_t handle, uint32_t *out_rx_size, uin
     return ESP_OK;
 }
 
+esp_err_t essl_get_stats(essl_handle_t handle, essl_stats_t *out_stats)
+{
+    if (handle == NULL || out_stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_stats = handle->stats;
+    return ESP_OK;
+}
+
+esp_err_t essl_reset_stats(essl_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(&handle->stats, 0, sizeof(essl_stats_t));
+    return ESP_OK;
+}
+
 esp_err_t essl_write_reg(essl_handle_t handle, uint8_t addr, uint8_t value, uint8_t *value_o, uint32_t wait_ms)
 {
     CHECK_EXECUTE_CMD(handle, write_reg, addr, value, value_o, wait_ms);
@@ -185,6 +231,41 @@ esp_err_t essl_read_reg(essl_handle_t handle, uint8_t add, uint8_t *value_o, uin
     CHECK_EXECUTE_CMD(handle, read_reg, add, value_o, wait_ms);
 }
 
+esp_err_t essl_write_regs(essl_handle_t handle, uint8_t addr, const uint8_t *values, size_t len, uint32_t wait_ms)
+{
+    if (handle == NULL || values == NULL || len == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->write_regs) {
+        return handle->write_regs(handle->args, addr, values, len, wait_ms);
+    }
+    // One transaction per register if the device cannot access a range at once
+    for (size_t i = 0; i < len; i++) {
+        esp_err_t err = essl_write_reg(handle, addr + i, values[i], NULL, wait_ms);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t essl_read_regs(essl_handle_t handle, uint8_t addr, uint8_t *values_o, size_t len, uint32_t wait_ms)
+{
+    if (handle == NULL || values_o == NULL || len == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->read_regs) {
+        return handle->read_regs(handle->args, addr, values_o, len, wait_ms);
+    }
+    for (size_t i = 0; i < len; i++) {
+        esp_err_t err = essl_read_reg(handle, addr + i, &values_o[i], wait_ms);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
 esp_err_t essl_wait_int(essl_handle_t handle, TickType_t wait_ms)
 {
     CHECK_EXECUTE_CMD(handle, wait_int, wait_ms);
@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include "esp_check.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+#include "essl.h"
+#include "essl_internal.h"
+
+static const char TAG[] = "essl_async";
+
+typedef enum {
+    ESSL_ASYNC_OP_SEND,
+    ESSL_ASYNC_OP_GET,
+    ESSL_ASYNC_OP_STOP,
+} essl_async_op_t;
+
+typedef struct {
+    essl_async_op_t op;
+    void *data;
+    size_t length;
+    uint32_t wait_ms;
+    essl_packet_cb_t cb;
+    void *arg;
+} essl_async_req_t;
+
+typedef struct {
+    QueueHandle_t queue;
+    TaskHandle_t task;
+    SemaphoreHandle_t done;     ///< Given by the task when it exits.
+} essl_async_t;
+
+static void essl_async_task(void *arg)
+{
+    essl_handle_t handle = (essl_handle_t)arg;
+    essl_async_t *async = handle->async;
+    essl_async_req_t req;
+
+    for (;;) {
+        xQueueReceive(async->queue, &req, portMAX_DELAY);
+        if (req.op == ESSL_ASYNC_OP_STOP) {
+            break;
+        }
+
+        esp_err_t err;
+        size_t length = 0;
+        if (req.op == ESSL_ASYNC_OP_SEND) {
+            err = essl_send_packet(handle, req.data, req.length, req.wait_ms);
+            if (err == ESP_OK) {
+                length = req.length;
+            }
+        } else {
+            err = essl_get_packet(handle, req.data, req.length, &length, req.wait_ms);
+        }
+        if (req.cb) {
+            req.cb(handle, err, req.data, length, req.arg);
+        }
+    }
+
+    xSemaphoreGive(async->done);
+    vTaskDelete(NULL);
+}
+
+esp_err_t essl_async_start(essl_handle_t handle, const essl_async_config_t *config)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(handle && config && config->queue_size > 0, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(handle->async == NULL, ESP_ERR_INVALID_STATE, TAG, "async API already started");
+
+    essl_async_t *async = calloc(1, sizeof(essl_async_t));
+    ESP_RETURN_ON_FALSE(async, ESP_ERR_NO_MEM, TAG, "no mem for async context");
+    async->queue = xQueueCreate(config->queue_size, sizeof(essl_async_req_t));
+    async->done = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(async->queue && async->done, ESP_ERR_NO_MEM, err, TAG, "no mem for async queue");
+
+    handle->async = async;
+    BaseType_t core_id = (config->task_core_id < 0) ? tskNO_AFFINITY : config->task_core_id;
+    BaseType_t res = xTaskCreatePinnedToCore(essl_async_task, "essl_async", config->task_stack_size, handle,
+                     config->task_priority, &async->task, core_id);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "no mem for async task");
+    return ESP_OK;
+
+err:
+    handle->async = NULL;
+    if (async->queue) {
+        vQueueDelete(async->queue);
+    }
+    if (async->done) {
+        vSemaphoreDelete(async->done);
+    }
+    free(async);
+    return ret;
+}
+
+esp_err_t essl_async_stop(essl_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    essl_async_t *async = handle->async;
+    ESP_RETURN_ON_FALSE(async, ESP_ERR_INVALID_STATE, TAG, "async API not started");
+
+    // Queued after the pending requests, so that they are completed first
+    const essl_async_req_t req = {
+        .op = ESSL_ASYNC_OP_STOP,
+    };
+    xQueueSend(async->queue, &req, portMAX_DELAY);
+    xSemaphoreTake(async->done, portMAX_DELAY);
+
+    handle->async = NULL;
+    vQueueDelete(async->queue);
+    vSemaphoreDelete(async->done);
+    free(async);
+    return ESP_OK;
+}
+
+static esp_err_t essl_async_queue(essl_handle_t handle, const essl_async_req_t *req)
+{
+    ESP_RETURN_ON_FALSE(handle && req->data && req->length, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    essl_async_t *async = handle->async;
+    ESP_RETURN_ON_FALSE(async, ESP_ERR_INVALID_STATE, TAG, "async API not started");
+
+    if (xQueueSend(async->queue, req, pdMS_TO_TICKS(req->wait_ms)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
+esp_err_t essl_send_packet_async(essl_handle_t handle, const void *start, size_t length, uint32_t wait_ms,
+                                 essl_packet_cb_t cb, void *arg)
+{
+    const essl_async_req_t req = {
+        .op = ESSL_ASYNC_OP_SEND,
+        .data = (void *)start,
+        .length = length,
+        .wait_ms = wait_ms,
+        .cb = cb,
+        .arg = arg,
+    };
+    return essl_async_queue(handle, &req);
+}
+
+esp_err_t essl_get_packet_async(essl_handle_t handle, void *out_data, size_t size, uint32_t wait_ms,
+                                essl_packet_cb_t cb, void *arg)
+{
+    const essl_async_req_t req = {
+        .op = ESSL_ASYNC_OP_GET,
+        .data = out_data,
+        .length = size,
+        .wait_ms = wait_ms,
+        .cb = cb,
+        .arg = arg,
+    };
+    return essl_async_queue(handle, &req);
+}
@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <stdatomic.h>
 #include <esp_types.h>
 #include <esp_err.h>
+#include "essl.h"
 
 /** Context used by the ``esp_serial_slave_link`` component.
  */
@@ -23,6 +25,8 @@ struct essl_dev_t {
     esp_err_t (*get_packet)(void *ctx, void *out_data, size_t size, uint32_t wait_ms);
     esp_err_t (*write_reg)(void *ctx, uint8_t addr, uint8_t value, uint8_t *value_o, uint32_t wait_ms);
     esp_err_t (*read_reg)(void *ctx, uint8_t add, uint8_t *value_o, uint32_t wait_ms);
+    esp_err_t (*write_regs)(void *ctx, uint8_t addr, const uint8_t *values, size_t len, uint32_t wait_ms);
+    esp_err_t (*read_regs)(void *ctx, uint8_t addr, uint8_t *values_o, size_t len, uint32_t wait_ms);
     esp_err_t (*wait_int)(void *ctx, uint32_t wait_ms);
     esp_err_t (*clear_intr)(void *ctx, uint32_t intr_mask, uint32_t wait_ms);
     esp_err_t (*get_intr)(void *ctx, uint32_t *intr_raw, uint32_t *intr_st, uint32_t wait_ms);
@@ -33,6 +37,19 @@ struct essl_dev_t {
     uint32_t (*get_tx_buffer_num)(void *ctx);
     uint32_t (*get_rx_data_size)(void *ctx);
     void (*reset_cnt)(void *ctx);
+
+    void *async;    ///< Context of the asynchronous API, NULL when it is not started.
+    void *stream;   ///< Context of the streaming receive, NULL when it is not started.
+    essl_stats_t stats; ///< Transfer statistics, updated by the functions of ``essl.c``.
 };
 
 typedef struct essl_dev_t essl_dev_t;
+
+/** Context of the streaming receive, ``stream`` member of the device.
+ */
+typedef struct {
+    uint8_t *ring;
+    size_t size;            ///< Size of the ring, a power of two.
+    atomic_size_t head;     ///< Total bytes received, written by essl_stream_receive(), wraps around.
+    atomic_size_t tail;     ///< Total bytes consumed, written by essl_stream_consume(), wraps around.
+} essl_stream_t;
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include "soc/soc_caps.h"
 #include "esp_log.h"
 #include "sdmmc_cmd.h"
@@ -33,6 +34,12 @@ static const char TAG[] = "essl_sdio";
 
 #define ESSL_CMD53_END_ADDR    0x1f800
 
+// Block length used by the SDMMC host driver for CMD53 block mode, also the maximum length of byte mode.
+// Block mode is only used if the function 1 block size of the slave is the same.
+#define ESSL_SDIO_HOST_BLOCK_SIZE   512
+
+#define ESSL_MIN(a, b)   ((a) < (b) ? (a) : (b))
+
 #define TX_BUFFER_MAX   0x1000
 #define TX_BUFFER_MASK  0xFFF
 #define RX_BYTE_MAX     0x100000
@@ -54,6 +61,8 @@ static const char TAG[] = "essl_sdio";
     .get_packet = essl_sdio_get_packet,\
     .write_reg = essl_sdio_write_reg,\
     .read_reg = essl_sdio_read_reg,\
+    .write_regs = essl_sdio_write_regs,\
+    .read_regs = essl_sdio_read_regs,\
     .wait_int = essl_sdio_wait_int,\
     .send_slave_intr = essl_sdio_send_slave_intr, \
     .get_intr = essl_sdio_get_intr, \
@@ -77,6 +86,7 @@ typedef struct {
     ///< If this is too large, it takes time to send stuff bits; while if too small, intervals between blocks cost much.
     ///< Should be set according to length of data, and larger than ``TRANS_LEN_MAX/511``.
     ///< Block size of the SDIO function 1. After the initialization this will hold the value the slave really do. Valid value is 1-2048.
+    bool            pad_to_block;       ///< Send and receive the tail of packets in a padded block, see ``essl_sdio_config_t``.
 } essl_sdio_context_t;
 
 
@@ -121,8 +131,9 @@ esp_err_t essl_sdio_init_dev(essl_handle_t *out_handle, const essl_sdio_config_t
 
     *arg = (essl_sdio_context_t) {
         .card = config->card,
-        .block_size = 0x200,
+        .block_size = ESSL_SDIO_HOST_BLOCK_SIZE,
         .buffer_size = config->recv_buffer_size,
+        .pad_to_block = config->pad_to_block,
         .tx_sent_buffers = 0,
         .rx_got_bytes = 0,
     };
@@ -250,6 +261,9 @@ esp_err_t essl_sdio_init(void *arg, uint32_t wait_ms)
         ESP_LOGW(TAG, "Function1 block size %d different than set value %d", bs_read, ctx->block_size);
         ctx->block_size = bs_read;
     }
+    if (ctx->block_size != ESSL_SDIO_HOST_BLOCK_SIZE) {
+        ESP_LOGW(TAG, "Function1 block size %d not supported by the host, using byte mode only", ctx->block_size);
+    }
     return ESP_OK;
 }
 
@@ -293,20 +307,25 @@ esp_err_t essl_sdio_send_packet(void *arg, const void *start, size_t length, uin
 
     uint8_t *start_ptr = (uint8_t *)start;
     uint32_t len_remain = length;
+    const int block_size = ctx->block_size;
+    const bool block_mode = (block_size == ESSL_SDIO_HOST_BLOCK_SIZE);
     do {
-        const int block_size = 512;
         /* Though the driver supports to split packet of unaligned size into
          * length of 4x and 1~3, we still send aligned size of data to get
          * higher effeciency. The length is determined by the SDIO address, and
          * the remainning will be discard by the slave hardware.
          */
-        int block_n = len_remain / block_size;
+        int block_n = block_mode ? len_remain / block_size : 0;
         int len_to_send;
-        if (block_n) {
+        if (block_n && ctx->pad_to_block && len_remain % block_size) {
+            /* For the same reason, the tail is sent in a padded block of the same transfer */
+            len_to_send = len_remain;
+            err = sdmmc_io_write_blocks(ctx->card, 1, ESSL_CMD53_END_ADDR - len_remain, start_ptr, (block_n + 1) * block_size);
+        } else if (block_n) {
             len_to_send = block_n * block_size;
             err = sdmmc_io_write_blocks(ctx->card, 1, ESSL_CMD53_END_ADDR - len_remain, start_ptr, len_to_send);
         } else {
-            len_to_send = len_remain;
+            len_to_send = ESSL_MIN(len_remain, ESSL_SDIO_HOST_BLOCK_SIZE);
             err = sdmmc_io_write_bytes(ctx->card, 1, ESSL_CMD53_END_ADDR - len_remain, start_ptr, (len_to_send + 3) & (~3));
         }
         if (err != ESP_OK) {
@@ -338,16 +357,21 @@ esp_err_t essl_sdio_get_packet(void *arg, void *out_data, size_t size, uint32_t
 
     uint8_t *start = out_data;
     uint32_t len_remain = size;
+    const int block_size = ctx->block_size;
+    const bool block_mode = (block_size == ESSL_SDIO_HOST_BLOCK_SIZE);
     do {
-        const int block_size = 512; //currently our driver don't support block size other than 512
         int len_to_send;
 
-        int block_n = len_remain / block_size;
-        if (block_n != 0) {
+        int block_n = block_mode ? len_remain / block_size : 0;
+        if (block_n != 0 && ctx->pad_to_block && len_remain % block_size != 0) {
+            /* Get the tail in a padded block of the same transfer, the data past the end address is ignored */
+            len_to_send = len_remain;
+            err = sdmmc_io_read_blocks(ctx->card, 1, ESSL_CMD53_END_ADDR - len_remain, start, (block_n + 1) * block_size);
+        } else if (block_n != 0) {
             len_to_send = block_n * block_size;
             err = sdmmc_io_read_blocks(ctx->card, 1, ESSL_CMD53_END_ADDR - len_remain, start, len_to_send);
         } else {
-            len_to_send = len_remain;
+            len_to_send = ESSL_MIN(len_remain, ESSL_SDIO_HOST_BLOCK_SIZE);
             /* though the driver supports to split packet of unaligned size into length
              * of 4x and 1~3, we still get aligned size of data to get higher
              * effeciency. The length is determined by the SDIO address, and the
@@ -443,6 +467,52 @@ esp_err_t essl_sdio_read_reg(void *arg, uint8_t add, uint8_t *value_o, uint32_t
     return ret;
 }
 
+/**
+ * Access a range of the general purpose registers, one CMD53 per contiguous part of the range.
+ * The registers are W0-W5 (0-23) and W6 (24-27), which are not adjacent, then W8-W15 (28-59), W7 is skipped (interrupts).
+ */
+static esp_err_t essl_sdio_access_regs(essl_sdio_context_t *ctx, uint8_t addr, uint8_t *values, size_t len, bool write)
+{
+    // Word aligned and DMA capable buffer for the SDMMC host, as large as the largest contiguous part
+    uint32_t buf[8];
+    esp_err_t err = ESP_OK;
+
+    if (len == 0 || addr + len > 60) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    while (len > 0) {
+        uint8_t end = (addr < 24) ? 24 : ((addr < 28) ? 28 : 60);
+        size_t len_part = ESSL_MIN(len, end - addr);
+        uint8_t pos = (addr >= 28) ? addr + 4 : addr;
+        if (write) {
+            memcpy(buf, values, len_part);
+            err = essl_sdio_write_bytes(ctx->card, HOST_SLCHOST_CONF_W_REG(pos), (uint8_t *)buf, len_part);
+        } else {
+            err = essl_sdio_read_bytes(ctx->card, HOST_SLCHOST_CONF_W_REG(pos), (uint8_t *)buf, len_part);
+            memcpy(values, buf, len_part);
+        }
+        if (err != ESP_OK) {
+            return err;
+        }
+        addr += len_part;
+        values += len_part;
+        len -= len_part;
+    }
+    return ESP_OK;
+}
+
+esp_err_t essl_sdio_write_regs(void *arg, uint8_t addr, const uint8_t *values, size_t len, uint32_t wait_ms)
+{
+    ESP_LOGV(TAG, "write_regs: %d bytes at %d", (int)len, addr);
+    return essl_sdio_access_regs(arg, addr, (uint8_t *)values, len, true);
+}
+
+esp_err_t essl_sdio_read_regs(void *arg, uint8_t addr, uint8_t *values_o, size_t len, uint32_t wait_ms)
+{
+    ESP_LOGV(TAG, "read_regs: %d bytes at %d", (int)len, addr);
+    return essl_sdio_access_regs(arg, addr, values_o, len, false);
+}
+
 esp_err_t essl_sdio_clear_intr(void *arg, uint32_t intr_mask, uint32_t wait_ms)
 {
     ESP_LOGV(TAG, "clear_intr: %08"PRIX32, intr_mask);
@@ -458,6 +528,17 @@ esp_err_t essl_sdio_get_intr(void *arg, uint32_t *intr_raw, uint32_t *intr_st, u
         return ESP_ERR_INVALID_ARG;
     }
 
+    if (intr_raw != NULL && intr_st != NULL) {
+        // Both registers by one CMD53, from INT_RAW to INT_ST
+        uint32_t regs[(HOST_SLC0HOST_INT_ST_REG - HOST_SLC0HOST_INT_RAW_REG) / 4 + 1];
+        r = essl_sdio_read_bytes(ctx->card, HOST_SLC0HOST_INT_RAW_REG, (uint8_t *) regs, sizeof(regs));
+        if (r != ESP_OK) {
+            return r;
+        }
+        *intr_raw = regs[0];
+        *intr_st = regs[(HOST_SLC0HOST_INT_ST_REG - HOST_SLC0HOST_INT_RAW_REG) / 4];
+        return ESP_OK;
+    }
     if (intr_raw != NULL) {
         r = essl_sdio_read_bytes(ctx->card, HOST_SLC0HOST_INT_RAW_REG, (uint8_t *) intr_raw, 4);
         if (r != ESP_OK) {
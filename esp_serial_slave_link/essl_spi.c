@@ -10,8 +10,11 @@
 #include "esp_check.h"
 #include "esp_memory_utils.h"
 #include "esp_private/periph_ctrl.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 
 #include "driver/spi_master.h"
+#include "driver/gpio.h"
 #include "hal/spi_types.h"
 #include "hal/spi_ll.h"
 
@@ -30,6 +33,8 @@
     .get_packet = essl_spi_get_packet,\
     .write_reg = essl_spi_write_reg,\
     .read_reg = essl_spi_read_reg,\
+    .write_regs = essl_spi_write_regs,\
+    .read_regs = essl_spi_read_regs,\
 }
 
 static const char TAG[] = "essl_spi";
@@ -51,6 +56,12 @@ typedef struct {
         size_t                  slave_tx_bytes;         // Number of the TX bytes that has been loaded by the Slave
         uint8_t                 rx_sync_reg;            // The pre-negotiated register ID for Master-RX-SLAVE-TX synchronization. 1 word (4 Bytes) will be reserved for the synchronization.
     } master_in;
+    /* Handshake line, NULL semaphores when the sync registers are polled */
+    struct {
+        gpio_num_t              gpio;                   // GPIO toggled by the Slave after updating a sync register.
+        SemaphoreHandle_t       tx_sem;                 // Given by each edge, tx_sync_reg may have changed.
+        SemaphoreHandle_t       rx_sem;                 // Given by each edge, rx_sync_reg may have changed.
+    } handshake;
 } essl_spi_context_t;
 
 static uint16_t get_hd_command(spi_command_t cmd_t, uint32_t flags)
@@ -249,6 +260,81 @@ esp_err_t essl_spi_wrdma(spi_device_handle_t spi, const uint8_t *data, int len,
     return essl_spi_wrdma_done(spi, flags);
 }
 
+/**
+ * Transfer the segments with up to `depth` transactions queued, the next segment is queued while the current one is
+ * on the bus. The segments are done in order, so the slot of a segment is free when the one `depth` segments before
+ * has been got back.
+ */
+static esp_err_t essl_spi_dma_queued(spi_device_handle_t spi, bool rx, uint8_t *data, int len, int seg_len, int depth, uint32_t flags)
+{
+    spi_transaction_ext_t trans[ESSL_SPI_QUEUE_DEPTH_MAX];
+    const uint16_t cmd = get_hd_command(rx ? SPI_CMD_HD_RDDMA : SPI_CMD_HD_WRDMA, flags);
+    const int dummy_bits = get_hd_dummy_bits(flags);
+    int queued = 0;
+    int issued = 0;
+    esp_err_t ret = ESP_OK;
+
+    seg_len = (seg_len > 0) ? seg_len : len;
+    depth = MAX(1, MIN(depth, ESSL_SPI_QUEUE_DEPTH_MAX));
+
+    while (queued > 0 || (len > 0 && ret == ESP_OK)) {
+        if (len > 0 && ret == ESP_OK && queued < depth) {
+            int send_len = MIN(seg_len, len);
+            spi_transaction_ext_t *t = &trans[issued % depth];
+            *t = (spi_transaction_ext_t) {
+                .base = {
+                    .cmd = cmd,
+                    .flags = flags | SPI_TRANS_VARIABLE_DUMMY,
+                },
+                .dummy_bits = dummy_bits,
+            };
+            if (rx) {
+                t->base.rxlength = send_len * 8;
+                t->base.rx_buffer = data;
+            } else {
+                t->base.length = send_len * 8;
+                t->base.tx_buffer = data;
+            }
+            ret = spi_device_queue_trans(spi, (spi_transaction_t *)t, portMAX_DELAY);
+            if (ret == ESP_OK) {
+                queued++;
+                issued++;
+                len -= send_len;
+                data += send_len;
+            }
+            continue;
+        }
+
+        spi_transaction_t *done_t;
+        esp_err_t err = spi_device_get_trans_result(spi, &done_t, portMAX_DELAY);
+        if (err != ESP_OK) {
+            return err;
+        }
+        queued--;
+    }
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    return rx ? essl_spi_rddma_done(spi, flags) : essl_spi_wrdma_done(spi, flags);
+}
+
+esp_err_t essl_spi_rddma_queued(spi_device_handle_t spi, uint8_t *out_data, int len, int seg_len, int queue_depth, uint32_t flags)
+{
+    if (!esp_ptr_dma_capable(out_data) || ((intptr_t)out_data % 4) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return essl_spi_dma_queued(spi, true, out_data, len, seg_len, queue_depth, flags);
+}
+
+esp_err_t essl_spi_wrdma_queued(spi_device_handle_t spi, const uint8_t *data, int len, int seg_len, int queue_depth, uint32_t flags)
+{
+    if (!esp_ptr_dma_capable(data)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return essl_spi_dma_queued(spi, false, (uint8_t *)data, len, seg_len, queue_depth, flags);
+}
+
 esp_err_t essl_spi_int(spi_device_handle_t spi, int int_n, uint32_t flags)
 {
     spi_transaction_t end_t = {
@@ -264,12 +350,77 @@ static esp_err_t essl_spi_update_rx_data_size(void *arg, uint32_t wait_ms);
 static uint32_t essl_spi_get_tx_buffer_num(void *arg);
 static esp_err_t essl_spi_update_tx_buffer_num(void *arg, uint32_t wait_ms);
 
+static void IRAM_ATTR essl_spi_handshake_isr(void *arg)
+{
+    essl_spi_context_t *ctx = arg;
+    BaseType_t do_yield = pdFALSE;
+
+    // One line for both registers, each direction reads its register again
+    xSemaphoreGiveFromISR(ctx->handshake.tx_sem, &do_yield);
+    xSemaphoreGiveFromISR(ctx->handshake.rx_sem, &do_yield);
+    if (do_yield) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void essl_spi_handshake_deinit(essl_spi_context_t *ctx)
+{
+    if (ctx->handshake.tx_sem && ctx->handshake.rx_sem) {
+        gpio_isr_handler_remove(ctx->handshake.gpio);
+        gpio_reset_pin(ctx->handshake.gpio);
+    }
+    if (ctx->handshake.tx_sem) {
+        vSemaphoreDelete(ctx->handshake.tx_sem);
+        ctx->handshake.tx_sem = NULL;
+    }
+    if (ctx->handshake.rx_sem) {
+        vSemaphoreDelete(ctx->handshake.rx_sem);
+        ctx->handshake.rx_sem = NULL;
+    }
+}
+
+static esp_err_t essl_spi_handshake_init(essl_spi_context_t *ctx, gpio_num_t gpio)
+{
+    esp_err_t ret = ESP_OK;
+    ctx->handshake.gpio = gpio;
+    ctx->handshake.tx_sem = xSemaphoreCreateBinary();
+    ctx->handshake.rx_sem = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(ctx->handshake.tx_sem && ctx->handshake.rx_sem, ESP_ERR_NO_MEM, err, TAG, "no mem for handshake semaphores");
+    // The registers are read once at the beginning, whatever the state of the line
+    xSemaphoreGive(ctx->handshake.tx_sem);
+    xSemaphoreGive(ctx->handshake.rx_sem);
+
+    const gpio_config_t io_conf = {
+        .pin_bit_mask = BIT64(gpio),
+        .mode = GPIO_MODE_INPUT,
+        .intr_type = GPIO_INTR_ANYEDGE,
+    };
+    ESP_GOTO_ON_ERROR(gpio_config(&io_conf), err, TAG, "handshake GPIO config failed");
+    // The ISR service may already be installed by the application
+    ret = gpio_install_isr_service(0);
+    ESP_GOTO_ON_FALSE(ret == ESP_OK || ret == ESP_ERR_INVALID_STATE, ret, err, TAG, "GPIO ISR service install failed");
+    ESP_GOTO_ON_ERROR(gpio_isr_handler_add(gpio, essl_spi_handshake_isr, ctx), err, TAG, "handshake ISR add failed");
+    return ESP_OK;
+
+err:
+    if (ctx->handshake.tx_sem) {
+        vSemaphoreDelete(ctx->handshake.tx_sem);
+        ctx->handshake.tx_sem = NULL;
+    }
+    if (ctx->handshake.rx_sem) {
+        vSemaphoreDelete(ctx->handshake.rx_sem);
+        ctx->handshake.rx_sem = NULL;
+    }
+    return ret;
+}
+
 esp_err_t essl_spi_init_dev(essl_handle_t *out_handle, const essl_spi_config_t *init_config)
 {
     ESP_RETURN_ON_FALSE(init_config->spi, ESP_ERR_INVALID_STATE, TAG, "Check SPI initialization first");
     ESP_RETURN_ON_FALSE(init_config->tx_sync_reg <= (SOC_SPI_MAXIMUM_BUFFER_SIZE - 1) * 4, ESP_ERR_INVALID_ARG, TAG, "GPSPI supports %d-byte-width internal registers", SOC_SPI_MAXIMUM_BUFFER_SIZE);
     ESP_RETURN_ON_FALSE(init_config->rx_sync_reg <= (SOC_SPI_MAXIMUM_BUFFER_SIZE - 1) * 4, ESP_ERR_INVALID_ARG, TAG, "GPSPI supports %d-byte-width internal registers", SOC_SPI_MAXIMUM_BUFFER_SIZE);
     ESP_RETURN_ON_FALSE(init_config->tx_sync_reg != init_config->rx_sync_reg, ESP_ERR_INVALID_ARG, TAG, "Should use different word of registers for synchronization");
+    ESP_RETURN_ON_FALSE(!init_config->use_handshake || GPIO_IS_VALID_GPIO(init_config->handshake_gpio), ESP_ERR_INVALID_ARG, TAG, "Invalid handshake GPIO");
 
     essl_spi_context_t *context = calloc(1, sizeof(essl_spi_context_t));
     essl_dev_t *dev = calloc(1, sizeof(essl_dev_t));
@@ -286,6 +437,15 @@ esp_err_t essl_spi_init_dev(essl_handle_t *out_handle, const essl_spi_config_t *
         .master_in.rx_sync_reg = init_config->rx_sync_reg
     };
 
+    if (init_config->use_handshake) {
+        esp_err_t ret = essl_spi_handshake_init(context, init_config->handshake_gpio);
+        if (ret != ESP_OK) {
+            free(context);
+            free(dev);
+            return ret;
+        }
+    }
+
     *dev = ESSL_SPI_DEFAULT_DEV_FUNC();
     dev->args = context;
 
@@ -297,11 +457,49 @@ esp_err_t essl_spi_init_dev(essl_handle_t *out_handle, const essl_spi_config_t *
 esp_err_t essl_spi_deinit_dev(essl_handle_t handle)
 {
     ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_STATE, TAG, "ESSL SPI is not in use");
+    essl_spi_handshake_deinit(handle->args);
     free(handle->args);
     free(handle);
     return ESP_OK;
 }
 
+/**
+ * Read a sync register until the last 2 readings are the same, after an edge of the handshake line if any.
+ * Reason: SPI transaction is carried on per 1 Byte. So when Master is reading the shared register, if the
+ * register value is changed by Slave at this time, Master may get wrong data. The edge only tells that the
+ * register has changed, it does not tell that the Slave is done writing it. An edge during the reading
+ * gives the semaphore again, and only makes the next call read the register at once.
+ *
+ * @return ESP_ERR_TIMEOUT if there was no edge within `wait_ms`, the register is unchanged.
+ */
+static esp_err_t essl_spi_read_sync_reg(essl_spi_context_t *ctx, uint8_t reg, SemaphoreHandle_t sem, uint32_t wait_ms, uint32_t *out_value)
+{
+    uint32_t updated_value = 0;
+    uint32_t previous_value = 0;
+    esp_err_t ret;
+
+    if (sem && xSemaphoreTake(sem, pdMS_TO_TICKS(wait_ms)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    ret = essl_spi_rdbuf_polling(ctx->spi, (uint8_t *)&previous_value, reg, sizeof(uint32_t), 0);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    while (1) {
+        ret = essl_spi_rdbuf_polling(ctx->spi, (uint8_t *)&updated_value, reg, sizeof(uint32_t), 0);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        if (updated_value == previous_value) {
+            break;
+        }
+        previous_value = updated_value;
+    }
+    *out_value = updated_value;
+    return ESP_OK;
+}
+
 void essl_spi_reset_cnt(void *arg)
 {
     essl_spi_context_t *ctx = arg;
@@ -312,19 +510,32 @@ void essl_spi_reset_cnt(void *arg)
 }
 
 //------------------------------------ RX ----------------------------------//
+// Whether the registers from addr to addr + len - 1 are free of the words reserved for synchronization
+static bool essl_spi_regs_valid(essl_spi_context_t *ctx, uint8_t addr, size_t len)
+{
+    uint8_t tx_reg = ctx->master_out.tx_sync_reg;
+    uint8_t rx_reg = ctx->master_in.rx_sync_reg;
+    return !(addr < tx_reg + 4 && (size_t)tx_reg < addr + len) && !(addr < rx_reg + 4 && (size_t)rx_reg < addr + len);
+}
+
 esp_err_t essl_spi_read_reg(void *arg, uint8_t addr, uint8_t *out_value, uint32_t wait_ms)
 {
     essl_spi_context_t *ctx = arg;
     ESP_RETURN_ON_FALSE(arg, ESP_ERR_INVALID_STATE, TAG, "Check ESSL SPI initialization first");
-    uint8_t reserved_1_head = ctx->master_out.tx_sync_reg < ctx->master_in.rx_sync_reg ? ctx->master_out.tx_sync_reg : ctx->master_in.rx_sync_reg;
-    uint8_t reserved_1_tail = reserved_1_head + 3;
-    uint8_t reserved_2_head = ctx->master_out.tx_sync_reg < ctx->master_in.rx_sync_reg ? ctx->master_in.rx_sync_reg : ctx->master_out.tx_sync_reg;
-    uint8_t reserved_2_tail = reserved_2_head + 3;
-    ESP_RETURN_ON_FALSE(addr < reserved_1_head || (addr > reserved_1_tail && addr < reserved_2_head) || addr > reserved_2_tail, ESP_ERR_INVALID_ARG, TAG, "Invalid address");
+    ESP_RETURN_ON_FALSE(essl_spi_regs_valid(ctx, addr, sizeof(uint8_t)), ESP_ERR_INVALID_ARG, TAG, "Invalid address");
 
     return essl_spi_rdbuf(ctx->spi, out_value, addr, sizeof(uint8_t), 0);
 }
 
+esp_err_t essl_spi_read_regs(void *arg, uint8_t addr, uint8_t *out_values, size_t len, uint32_t wait_ms)
+{
+    essl_spi_context_t *ctx = arg;
+    ESP_RETURN_ON_FALSE(arg, ESP_ERR_INVALID_STATE, TAG, "Check ESSL SPI initialization first");
+    ESP_RETURN_ON_FALSE(len > 0 && addr + len <= SOC_SPI_MAXIMUM_BUFFER_SIZE && essl_spi_regs_valid(ctx, addr, len), ESP_ERR_INVALID_ARG, TAG, "Invalid address");
+
+    return essl_spi_rdbuf(ctx->spi, out_values, addr, len, 0);
+}
+
 static uint32_t essl_spi_get_rx_data_size(void *arg)
 {
     essl_spi_context_t *ctx = arg;
@@ -336,31 +547,19 @@ static esp_err_t essl_spi_update_rx_data_size(void *arg, uint32_t wait_ms)
 {
     essl_spi_context_t *ctx = arg;
     uint32_t updated_size = 0;
-    uint32_t previous_size = 0;
     esp_err_t ret;
 
-    ret = essl_spi_rdbuf_polling(ctx->spi, (uint8_t *)&previous_size, ctx->master_in.rx_sync_reg, sizeof(uint32_t), 0);
+    ret = essl_spi_read_sync_reg(ctx, ctx->master_in.rx_sync_reg, ctx->handshake.rx_sem, wait_ms, &updated_size);
+    if (ret == ESP_ERR_TIMEOUT) {
+        // No update from the Slave, the previous size is still valid
+        return ESP_OK;
+    }
     if (ret != ESP_OK) {
         return ret;
     }
-
-    /**
-     * Read until the last 2 reading result are same. Reason:
-     * SPI transaction is carried on per 1 Byte. So when Master is reading the shared register, if the
-     * register value is changed by Slave at this time, Master may get wrong data.
-     */
-    while (1) {
-        ret = essl_spi_rdbuf_polling(ctx->spi, (uint8_t *)&updated_size, ctx->master_in.rx_sync_reg, sizeof(uint32_t), 0);
-        if (ret != ESP_OK) {
-            return ret;
-        }
-        if (updated_size == previous_size) {
-            ctx->master_in.slave_tx_bytes = updated_size;
-            ESP_LOGV(TAG, "updated: slave prepared tx buffer is: %d bytes", (unsigned int)updated_size);
-            return ret;
-        }
-        previous_size = updated_size;
-    }
+    ctx->master_in.slave_tx_bytes = updated_size;
+    ESP_LOGV(TAG, "updated: slave prepared tx buffer is: %d bytes", (unsigned int)updated_size);
+    return ESP_OK;
 }
 
 esp_err_t essl_spi_get_packet(void *arg, void *out_data, size_t size, uint32_t wait_ms)
@@ -405,16 +604,21 @@ esp_err_t essl_spi_write_reg(void *arg, uint8_t addr, uint8_t value, uint8_t *ou
 {
     essl_spi_context_t *ctx = arg;
     ESP_RETURN_ON_FALSE(arg, ESP_ERR_INVALID_STATE, TAG, "Check ESSL SPI initialization first");
-    uint8_t reserved_1_head = ctx->master_out.tx_sync_reg < ctx->master_in.rx_sync_reg ? ctx->master_out.tx_sync_reg : ctx->master_in.rx_sync_reg;
-    uint8_t reserved_1_tail = reserved_1_head + 3;
-    uint8_t reserved_2_head = ctx->master_out.tx_sync_reg < ctx->master_in.rx_sync_reg ? ctx->master_in.rx_sync_reg : ctx->master_out.tx_sync_reg;
-    uint8_t reserved_2_tail = reserved_2_head + 3;
-    ESP_RETURN_ON_FALSE(addr < reserved_1_head || (addr > reserved_1_tail && addr < reserved_2_head) || addr > reserved_2_tail, ESP_ERR_INVALID_ARG, TAG, "Invalid address");
+    ESP_RETURN_ON_FALSE(essl_spi_regs_valid(ctx, addr, sizeof(uint8_t)), ESP_ERR_INVALID_ARG, TAG, "Invalid address");
     ESP_RETURN_ON_FALSE(out_value == NULL, ESP_ERR_NOT_SUPPORTED, TAG, "This feature is not supported");
 
     return essl_spi_wrbuf(ctx->spi, &value, addr, sizeof(uint8_t), 0);
 }
 
+esp_err_t essl_spi_write_regs(void *arg, uint8_t addr, const uint8_t *values, size_t len, uint32_t wait_ms)
+{
+    essl_spi_context_t *ctx = arg;
+    ESP_RETURN_ON_FALSE(arg, ESP_ERR_INVALID_STATE, TAG, "Check ESSL SPI initialization first");
+    ESP_RETURN_ON_FALSE(len > 0 && addr + len <= SOC_SPI_MAXIMUM_BUFFER_SIZE && essl_spi_regs_valid(ctx, addr, len), ESP_ERR_INVALID_ARG, TAG, "Invalid address");
+
+    return essl_spi_wrbuf(ctx->spi, values, addr, len, 0);
+}
+
 static uint32_t essl_spi_get_tx_buffer_num(void *arg)
 {
     essl_spi_context_t *ctx = arg;
@@ -426,31 +630,19 @@ static esp_err_t essl_spi_update_tx_buffer_num(void *arg, uint32_t wait_ms)
 {
     essl_spi_context_t *ctx = arg;
     uint32_t updated_num = 0;
-    uint32_t previous_size = 0;
     esp_err_t ret;
 
-    ret = essl_spi_rdbuf_polling(ctx->spi, (uint8_t *)&previous_size, ctx->master_out.tx_sync_reg, sizeof(uint32_t), 0);
+    ret = essl_spi_read_sync_reg(ctx, ctx->master_out.tx_sync_reg, ctx->handshake.tx_sem, wait_ms, &updated_num);
+    if (ret == ESP_ERR_TIMEOUT) {
+        // No update from the Slave, the previous number is still valid
+        return ESP_OK;
+    }
     if (ret != ESP_OK) {
         return ret;
     }
-
-    /**
-     * Read until the last 2 reading result are same. Reason:
-     * SPI transaction is carried on per 1 Byte. So when Master is reading the shared register, if the
-     * register value is changed by Slave at this time, Master may get wrong data.
-     */
-    while (1) {
-        ret = essl_spi_rdbuf_polling(ctx->spi, (uint8_t *)&updated_num, ctx->master_out.tx_sync_reg, sizeof(uint32_t), 0);
-        if (ret != ESP_OK) {
-            return ret;
-        }
-        if (updated_num == previous_size) {
-            ctx->master_out.slave_rx_buf_num = updated_num;
-            ESP_LOGV(TAG, "updated: slave prepared rx buffer: %d", (unsigned int)updated_num);
-            return ret;
-        }
-        previous_size = updated_num;
-    }
+    ctx->master_out.slave_rx_buf_num = updated_num;
+    ESP_LOGV(TAG, "updated: slave prepared rx buffer: %d", (unsigned int)updated_num);
+    return ESP_OK;
 }
 
 esp_err_t essl_spi_send_packet(void *arg, const void *data, size_t size, uint32_t wait_ms)
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <sys/param.h>
+#include "esp_check.h"
+#include "esp_memory_utils.h"
+
+#include "essl.h"
+#include "essl_internal.h"
+
+static const char TAG[] = "essl_stream";
+
+/* The data are read by multiples of 4 bytes, so that the write position stays word aligned for the DMA,
+ * and the SDIO reads, rounded up to 4 bytes, do not overwrite unread data. */
+#define ESSL_STREAM_ALIGN   4
+
+esp_err_t essl_stream_start(essl_handle_t handle, uint8_t *ring, size_t size)
+{
+    // A power of two divides the range of the counters, so the positions stay right when they wrap
+    ESP_RETURN_ON_FALSE(handle && ring && size >= ESSL_STREAM_ALIGN && (size & (size - 1)) == 0,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(esp_ptr_dma_capable(ring) && (intptr_t)ring % ESSL_STREAM_ALIGN == 0, ESP_ERR_INVALID_ARG,
+                        TAG, "ring buffer should be DMA capable and aligned to 4");
+    ESP_RETURN_ON_FALSE(handle->get_packet && handle->update_rx_data_size && handle->get_rx_data_size,
+                        ESP_ERR_NOT_SUPPORTED, TAG, "receiving not supported for the current device");
+    ESP_RETURN_ON_FALSE(handle->stream == NULL, ESP_ERR_INVALID_STATE, TAG, "stream already started");
+
+    essl_stream_t *stream = calloc(1, sizeof(essl_stream_t));
+    ESP_RETURN_ON_FALSE(stream, ESP_ERR_NO_MEM, TAG, "no mem for stream context");
+    stream->ring = ring;
+    stream->size = size;
+    atomic_init(&stream->head, 0);
+    atomic_init(&stream->tail, 0);
+
+    handle->stream = stream;
+    return ESP_OK;
+}
+
+esp_err_t essl_stream_stop(essl_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(handle->stream, ESP_ERR_INVALID_STATE, TAG, "stream not started");
+
+    free(handle->stream);
+    handle->stream = NULL;
+    return ESP_OK;
+}
+
+esp_err_t essl_stream_receive(essl_handle_t handle, uint32_t wait_ms, size_t *out_length)
+{
+    ESP_RETURN_ON_FALSE(handle && out_length, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    essl_stream_t *stream = handle->stream;
+    ESP_RETURN_ON_FALSE(stream, ESP_ERR_INVALID_STATE, TAG, "stream not started");
+    *out_length = 0;
+
+    size_t available = handle->get_rx_data_size(handle->args);
+    if (available < ESSL_STREAM_ALIGN) {
+        esp_err_t err = handle->update_rx_data_size(handle->args, wait_ms);
+        if (err != ESP_OK) {
+            return err;
+        }
+        available = handle->get_rx_data_size(handle->args);
+    }
+
+    // The free space wraps at most once, so at most 2 reads
+    size_t head = atomic_load_explicit(&stream->head, memory_order_relaxed);
+    for (int i = 0; i < 2; i++) {
+        size_t used = head - atomic_load_explicit(&stream->tail, memory_order_acquire);
+        size_t pos = head & (stream->size - 1);
+        size_t len = MIN(MIN(available, stream->size - used), stream->size - pos);
+        len &= ~(size_t)(ESSL_STREAM_ALIGN - 1);
+        if (len == 0) {
+            break;
+        }
+
+        esp_err_t err = handle->get_packet(handle->args, stream->ring + pos, len, wait_ms);
+        if (err != ESP_OK) {
+            handle->stats.errors++;
+            return err;
+        }
+        handle->stats.rx_bytes += len;
+        handle->stats.rx_packets++;
+        head += len;
+        available -= len;
+        *out_length += len;
+        // Publish the data to the consumer
+        atomic_store_explicit(&stream->head, head, memory_order_release);
+    }
+
+    return (*out_length != 0) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t essl_stream_peek(essl_handle_t handle, const uint8_t **out_data, size_t *out_length)
+{
+    ESP_RETURN_ON_FALSE(handle && out_data && out_length, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    essl_stream_t *stream = handle->stream;
+    ESP_RETURN_ON_FALSE(stream, ESP_ERR_INVALID_STATE, TAG, "stream not started");
+
+    size_t tail = atomic_load_explicit(&stream->tail, memory_order_relaxed);
+    size_t used = atomic_load_explicit(&stream->head, memory_order_acquire) - tail;
+    size_t pos = tail & (stream->size - 1);
+    *out_data = stream->ring + pos;
+    *out_length = MIN(used, stream->size - pos);
+    return ESP_OK;
+}
+
+esp_err_t essl_stream_consume(essl_handle_t handle, size_t length)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    essl_stream_t *stream = handle->stream;
+    ESP_RETURN_ON_FALSE(stream, ESP_ERR_INVALID_STATE, TAG, "stream not started");
+
+    size_t tail = atomic_load_explicit(&stream->tail, memory_order_relaxed);
+    size_t used = atomic_load_explicit(&stream->head, memory_order_acquire) - tail;
+    ESP_RETURN_ON_FALSE(length <= used, ESP_ERR_INVALID_SIZE, TAG, "consuming more than received");
+    // Release the space to the producer once the data have been used
+    atomic_store_explicit(&stream->tail, tail + length, memory_order_release);
+    return ESP_OK;
+}
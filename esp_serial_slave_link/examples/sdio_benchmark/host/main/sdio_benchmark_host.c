@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/sdmmc_host.h"
+#include "sdmmc_cmd.h"
+#include "esp_serial_slave_link/essl.h"
+#include "esp_serial_slave_link/essl_sdio.h"
+
+/* Shared with the slave */
+#define BENCH_RECV_BUFFER_SIZE  512     // Receiving buffer size of the slave
+#define BENCH_REG_SIZE          0       // Registers 0-3: size of the packets sent by the slave
+#define BENCH_REG_COUNT         4       // Registers 4-7: number of packets sent by the slave
+#define BENCH_INTR_SEND         0       // Slave interrupt starting the sending
+
+#define BENCH_TIMEOUT_MS        1000
+
+#if CONFIG_EXAMPLE_SDIO_4BIT
+#define BENCH_BUS_WIDTH         4
+#else
+#define BENCH_BUS_WIDTH         1
+#endif
+#if CONFIG_EXAMPLE_SDIO_HIGHSPEED
+#define BENCH_FREQ_KHZ          SDMMC_FREQ_HIGHSPEED
+#else
+#define BENCH_FREQ_KHZ          SDMMC_FREQ_DEFAULT
+#endif
+
+static const char *TAG = "sdio_benchmark";
+
+static const size_t s_packet_sizes[] = {64, 128, 256, 512, 1024, 2048, 4096};
+
+static void print_stats(const char *direction, size_t packet_size, const essl_stats_t *stats, bool tx)
+{
+    uint64_t bytes = tx ? stats->tx_bytes : stats->rx_bytes;
+    uint32_t packets = tx ? stats->tx_packets : stats->rx_packets;
+    int64_t time_us = tx ? stats->tx_time_us : stats->rx_time_us;
+    int64_t wait_us = tx ? stats->tx_wait_us : stats->rx_wait_us;
+    uint32_t retries = tx ? stats->tx_retries : stats->rx_retries;
+
+    printf("%-8s %8u %10.1f %12.1f %10"PRIu32" %8.1f %8"PRIu32"\n", direction, (unsigned)packet_size,
+           time_us ? bytes * 1000.0 / time_us : 0.0, packets ? (double)time_us / packets : 0.0,
+           retries, time_us ? wait_us * 100.0 / time_us : 0.0, stats->errors);
+}
+
+static esp_err_t bench_send(essl_handle_t handle, uint8_t *buf, size_t packet_size, int count)
+{
+    for (int i = 0; i < count; i++) {
+        ESP_RETURN_ON_ERROR(essl_send_packet(handle, buf, packet_size, BENCH_TIMEOUT_MS), TAG, "send failed");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t bench_receive(essl_handle_t handle, uint8_t *buf, size_t packet_size, int count)
+{
+    uint32_t regs[2] = {packet_size, count};
+    ESP_RETURN_ON_ERROR(essl_write_regs(handle, BENCH_REG_SIZE, (uint8_t *)regs, sizeof(regs), BENCH_TIMEOUT_MS),
+                        TAG, "write registers failed");
+    ESP_RETURN_ON_ERROR(essl_send_slave_intr(handle, BIT(BENCH_INTR_SEND), BENCH_TIMEOUT_MS), TAG, "interrupt failed");
+
+    size_t remain = packet_size * count;
+    while (remain > 0) {
+        size_t length = 0;
+        esp_err_t err = essl_get_packet(handle, buf, MIN(packet_size, remain), &length, BENCH_TIMEOUT_MS);
+        if (err != ESP_OK && err != ESP_ERR_NOT_FINISHED) {
+            ESP_LOGE(TAG, "receive failed with %zu bytes remaining: %s", remain, esp_err_to_name(err));
+            return err;
+        }
+        remain -= length;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t slave_init(essl_handle_t *out_handle)
+{
+    sdmmc_host_t config = SDMMC_HOST_DEFAULT();
+    config.flags = BENCH_BUS_WIDTH == 4 ? SDMMC_HOST_FLAG_4BIT : SDMMC_HOST_FLAG_1BIT;
+    config.max_freq_khz = BENCH_FREQ_KHZ;
+
+    sdmmc_slot_config_t slot_config = SDMMC_SLOT_CONFIG_DEFAULT();
+    slot_config.width = BENCH_BUS_WIDTH;
+    ESP_RETURN_ON_ERROR(sdmmc_host_init(), TAG, "host init failed");
+    ESP_RETURN_ON_ERROR(sdmmc_host_init_slot(SDMMC_HOST_SLOT_1, &slot_config), TAG, "slot init failed");
+
+    sdmmc_card_t *card = calloc(1, sizeof(sdmmc_card_t));
+    ESP_RETURN_ON_FALSE(card, ESP_ERR_NO_MEM, TAG, "no mem for card");
+    ESP_LOGI(TAG, "waiting for the slave...");
+    while (sdmmc_card_init(&config, card) != ESP_OK) {
+        vTaskDelay(pdMS_TO_TICKS(1000));
+    }
+    sdmmc_card_print_info(stdout, card);
+
+    essl_sdio_config_t ser_config = {
+        .card = card,
+        .recv_buffer_size = BENCH_RECV_BUFFER_SIZE,
+    };
+    ESP_RETURN_ON_ERROR(essl_sdio_init_dev(out_handle, &ser_config), TAG, "essl init failed");
+    ESP_RETURN_ON_ERROR(essl_init(*out_handle, BENCH_TIMEOUT_MS), TAG, "slave init failed");
+    return essl_wait_for_ready(*out_handle, BENCH_TIMEOUT_MS);
+}
+
+void app_main(void)
+{
+    essl_handle_t handle;
+    ESP_ERROR_CHECK(slave_init(&handle));
+
+    const size_t max_size = s_packet_sizes[sizeof(s_packet_sizes) / sizeof(s_packet_sizes[0]) - 1];
+    uint8_t *buf = heap_caps_malloc(max_size, MALLOC_CAP_DMA);
+    assert(buf);
+    for (size_t i = 0; i < max_size; i++) {
+        buf[i] = i;
+    }
+
+    printf("\nSDIO %d-bit, %d kHz, %d bytes per packet size\n", BENCH_BUS_WIDTH, BENCH_FREQ_KHZ,
+           CONFIG_EXAMPLE_TRANSFER_SIZE);
+    printf("%-8s %8s %10s %12s %10s %8s %8s\n", "dir", "packet", "kB/s", "us/packet", "retries", "wait %", "errors");
+    for (size_t i = 0; i < sizeof(s_packet_sizes) / sizeof(s_packet_sizes[0]); i++) {
+        const size_t packet_size = s_packet_sizes[i];
+        const int count = CONFIG_EXAMPLE_TRANSFER_SIZE / packet_size;
+        essl_stats_t stats;
+
+        essl_reset_stats(handle);
+        ESP_ERROR_CHECK(bench_send(handle, buf, packet_size, count));
+        essl_get_stats(handle, &stats);
+        print_stats("to slave", packet_size, &stats, true);
+
+        essl_reset_stats(handle);
+        ESP_ERROR_CHECK(bench_receive(handle, buf, packet_size, count));
+        essl_get_stats(handle, &stats);
+        print_stats("to host", packet_size, &stats, false);
+    }
+
+    free(buf);
+    ESP_LOGI(TAG, "done");
+}
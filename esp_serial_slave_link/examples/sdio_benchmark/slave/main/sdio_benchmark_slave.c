@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/sdio_slave.h"
+
+/* Shared with the host */
+#define BENCH_RECV_BUFFER_SIZE  512     // Receiving buffer size, also set in the host
+#define BENCH_REG_SIZE          0       // Registers 0-3: size of the packets to send
+#define BENCH_REG_COUNT         4       // Registers 4-7: number of packets to send
+#define BENCH_INTR_SEND         0       // Host interrupt starting the sending
+
+#define BENCH_RECV_BUFFER_NUM   32
+#define BENCH_SEND_QUEUE_SIZE   8
+#define BENCH_SEND_BUFFER_SIZE  4096    // Largest packet of the host sweep
+
+static const char *TAG = "sdio_benchmark";
+
+/* The received data are dropped, the buffers are loaded again right away */
+static void recv_task(void *arg)
+{
+    for (;;) {
+        sdio_slave_buf_handle_t handle;
+        uint8_t *addr;
+        size_t len;
+        if (sdio_slave_recv(&handle, &addr, &len, portMAX_DELAY) == ESP_OK) {
+            ESP_ERROR_CHECK(sdio_slave_recv_load_buf(handle));
+        }
+    }
+}
+
+static uint32_t read_reg32(int pos)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= (uint32_t)sdio_slave_read_reg(pos + i) << (8 * i);
+    }
+    return value;
+}
+
+static void send_packets(const uint8_t *buf, size_t packet_size, uint32_t count)
+{
+    uint32_t queued = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        // Recycle the oldest transfer once the queue is full
+        if (queued == BENCH_SEND_QUEUE_SIZE) {
+            ESP_ERROR_CHECK(sdio_slave_send_get_finished(NULL, portMAX_DELAY));
+            queued--;
+        }
+        ESP_ERROR_CHECK(sdio_slave_send_queue((uint8_t *)buf, packet_size, NULL, portMAX_DELAY));
+        queued++;
+    }
+    while (queued > 0) {
+        ESP_ERROR_CHECK(sdio_slave_send_get_finished(NULL, portMAX_DELAY));
+        queued--;
+    }
+}
+
+void app_main(void)
+{
+    sdio_slave_config_t config = {
+        .sending_mode = SDIO_SLAVE_SEND_STREAM,
+        .send_queue_size = BENCH_SEND_QUEUE_SIZE,
+        .recv_buffer_size = BENCH_RECV_BUFFER_SIZE,
+    };
+    ESP_ERROR_CHECK(sdio_slave_initialize(&config));
+
+    uint8_t *recv_bufs = heap_caps_malloc(BENCH_RECV_BUFFER_NUM * BENCH_RECV_BUFFER_SIZE, MALLOC_CAP_DMA);
+    uint8_t *send_buf = heap_caps_malloc(BENCH_SEND_BUFFER_SIZE, MALLOC_CAP_DMA);
+    assert(recv_bufs && send_buf);
+    memset(send_buf, 0xA5, BENCH_SEND_BUFFER_SIZE);
+    for (int i = 0; i < BENCH_RECV_BUFFER_NUM; i++) {
+        sdio_slave_buf_handle_t handle = sdio_slave_recv_register_buf(recv_bufs + i * BENCH_RECV_BUFFER_SIZE);
+        assert(handle);
+        ESP_ERROR_CHECK(sdio_slave_recv_load_buf(handle));
+    }
+
+    ESP_ERROR_CHECK(sdio_slave_start());
+    xTaskCreate(recv_task, "recv_task", 2048, NULL, 5, NULL);
+    ESP_LOGI(TAG, "ready");
+
+    for (;;) {
+        if (sdio_slave_wait_int(BENCH_INTR_SEND, portMAX_DELAY) != ESP_OK) {
+            continue;
+        }
+        size_t packet_size = read_reg32(BENCH_REG_SIZE);
+        uint32_t count = read_reg32(BENCH_REG_COUNT);
+        if (packet_size == 0 || packet_size > BENCH_SEND_BUFFER_SIZE) {
+            ESP_LOGE(TAG, "invalid packet size %u", (unsigned)packet_size);
+            continue;
+        }
+        ESP_LOGI(TAG, "sending %"PRIu32" packets of %u bytes", count, (unsigned)packet_size);
+        send_packets(send_buf, packet_size, count);
+    }
+}
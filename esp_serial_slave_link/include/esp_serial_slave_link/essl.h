@@ -7,6 +7,8 @@
 #pragma once
 
 
+#include <stdint.h>
+#include <stddef.h>
 #include "esp_err.h"
 
 #ifdef __cplusplus
@@ -143,6 +145,40 @@ esp_err_t essl_write_reg(essl_handle_t handle, uint8_t addr, uint8_t value, uint
  */
 esp_err_t essl_read_reg(essl_handle_t handle, uint8_t add, uint8_t *value_o, uint32_t wait_ms);
 
+/** Write consecutive general purpose R/W registers (8-bit) of ESSL slave.
+ *
+ * The registers are written by one transaction per contiguous range of the slave, instead of one per register.
+ *
+ * @param handle Handle of a ``essl`` device.
+ * @param addr Address of the first register to write, the range must be valid as for ``essl_write_reg``.
+ * @param values Values to write to the registers.
+ * @param len Number of registers to write.
+ * @param wait_ms Millisecond to wait before timeout, will not wait at all if set to 0-9.
+ *
+ * @return
+ *      - ESP_OK Success
+ *      - ESP_ERR_INVALID_ARG Invalid argument, or a register of the range is not valid
+ *      - One of the error codes from SDMMC/SPI host controller
+ */
+esp_err_t essl_write_regs(essl_handle_t handle, uint8_t addr, const uint8_t *values, size_t len, uint32_t wait_ms);
+
+/** Read consecutive general purpose R/W registers (8-bit) of ESSL slave.
+ *
+ * The registers are read by one transaction per contiguous range of the slave, instead of one per register.
+ *
+ * @param handle Handle of a ``essl`` device.
+ * @param addr Address of the first register to read, the range must be valid as for ``essl_read_reg``.
+ * @param values_o Output values read from the registers.
+ * @param len Number of registers to read.
+ * @param wait_ms Millisecond to wait before timeout, will not wait at all if set to 0-9.
+ *
+ * @return
+ *      - ESP_OK Success
+ *      - ESP_ERR_INVALID_ARG Invalid argument, or a register of the range is not valid
+ *      - One of the error codes from SDMMC/SPI host controller
+ */
+esp_err_t essl_read_regs(essl_handle_t handle, uint8_t addr, uint8_t *values_o, size_t len, uint32_t wait_ms);
+
 /** wait for an interrupt of the slave
  *
  * @param handle Handle of an ESSL device.
@@ -221,6 +257,223 @@ esp_err_t essl_get_intr_ena(essl_handle_t handle, uint32_t *ena_mask_o, uint32_t
  */
 esp_err_t essl_send_slave_intr(essl_handle_t handle, uint32_t intr_mask, uint32_t wait_ms);
 
+/**
+ * @brief Callback of a packet request of the asynchronous API, called in the transfer task.
+ *
+ * @param handle Handle of the ESSL device.
+ * @param err Result of the transfer, as returned by ``essl_send_packet`` or ``essl_get_packet``.
+ * @param data Buffer of the request.
+ * @param length Length of the data sent or received.
+ * @param arg User argument of the request.
+ */
+typedef void (*essl_packet_cb_t)(essl_handle_t handle, esp_err_t err, void *data, size_t length, void *arg);
+
+/// Configuration of the asynchronous API
+typedef struct {
+    size_t queue_size;      ///< Maximum number of pending packet requests.
+    size_t task_stack_size; ///< Stack size of the transfer task, the callbacks run in this task.
+    unsigned task_priority; ///< Priority of the transfer task.
+    int task_core_id;       ///< Core of the transfer task, -1 for no affinity.
+} essl_async_config_t;
+
+/// Default configuration of the asynchronous API
+#define ESSL_ASYNC_DEFAULT_CONFIG() { \
+    .queue_size = 8, \
+    .task_stack_size = 4096, \
+    .task_priority = 5, \
+    .task_core_id = -1, \
+}
+
+/** Start the asynchronous API of an ESSL device.
+ *
+ * Packet requests are queued and transferred one after the other by a task, so that the next packet
+ * is prepared while the previous one is transferred, and the bus does not wait for the application.
+ * While the asynchronous API is started, other ``essl_`` functions must not be called for the device,
+ * except the asynchronous ones.
+ *
+ * @param handle Handle of an initialized ESSL device.
+ * @param config Configuration of the asynchronous API.
+ *
+ * @return
+ *      - ESP_OK:                Success
+ *      - ESP_ERR_INVALID_ARG:   Invalid argument
+ *      - ESP_ERR_INVALID_STATE: The asynchronous API is already started
+ *      - ESP_ERR_NO_MEM:        Memory exhausted
+ */
+esp_err_t essl_async_start(essl_handle_t handle, const essl_async_config_t *config);
+
+/** Stop the asynchronous API of an ESSL device.
+ *
+ * The pending requests are completed before it returns. Call it before deinitializing the device.
+ *
+ * @param handle Handle of an ESSL device.
+ *
+ * @return
+ *      - ESP_OK:                Success
+ *      - ESP_ERR_INVALID_ARG:   Invalid argument
+ *      - ESP_ERR_INVALID_STATE: The asynchronous API is not started
+ */
+esp_err_t essl_async_stop(essl_handle_t handle);
+
+/** Queue a packet to send to the slave.
+ *
+ * The packet is sent as by ``essl_send_packet``, then ``cb`` is called. The buffer must stay valid until then.
+ *
+ * @param handle Handle of an ESSL device.
+ * @param start Start address of the packet to send.
+ * @param length Length of data to send, if the packet is over-size, the it will be divided into blocks and hold into different buffers automatically.
+ * @param wait_ms Millisecond to wait for a free slot in the queue, then for the slave to be ready to receive the packet.
+ * @param cb Callback called when the packet is sent or failed, can be NULL.
+ * @param arg User argument of the callback.
+ *
+ * @return
+ *      - ESP_OK:                The packet is queued
+ *      - ESP_ERR_INVALID_ARG:   Invalid argument
+ *      - ESP_ERR_INVALID_STATE: The asynchronous API is not started
+ *      - ESP_ERR_TIMEOUT:       The queue is full
+ */
+esp_err_t essl_send_packet_async(essl_handle_t handle, const void *start, size_t length, uint32_t wait_ms,
+                                 essl_packet_cb_t cb, void *arg);
+
+/** Queue a request to get a packet from the slave.
+ *
+ * The packet is received as by ``essl_get_packet``, then ``cb`` is called with the received length. The buffer must stay valid until then.
+ *
+ * @param handle Handle of an ESSL device.
+ * @param[out] out_data Data output address
+ * @param size The size of the output buffer.
+ * @param wait_ms Millisecond to wait for a free slot in the queue, then for the slave to have data to send.
+ * @param cb Callback called when the packet is received or failed, can be NULL.
+ * @param arg User argument of the callback.
+ *
+ * @return
+ *      - ESP_OK:                The request is queued
+ *      - ESP_ERR_INVALID_ARG:   Invalid argument
+ *      - ESP_ERR_INVALID_STATE: The asynchronous API is not started
+ *      - ESP_ERR_TIMEOUT:       The queue is full
+ */
+esp_err_t essl_get_packet_async(essl_handle_t handle, void *out_data, size_t size, uint32_t wait_ms,
+                                essl_packet_cb_t cb, void *arg);
+
+/** Start receiving a continuous stream from the slave into a ring buffer.
+ *
+ * ``essl_stream_receive`` reads the data of the slave directly into the free space of the ring, and the
+ * consumer uses them in place with ``essl_stream_peek`` and ``essl_stream_consume``, without any copy.
+ * One task may receive while another one consumes. While the stream is started, ``essl_get_packet``
+ * must not be called for the device.
+ *
+ * @note The data are read by multiples of 4 bytes, a tail of 1 to 3 bytes is received with the next data of the slave.
+ * @note The SDIO ``pad_to_block`` option must not be used, the padding would be written past the free space.
+ *
+ * @param handle Handle of an initialized ESSL device.
+ * @param ring Ring buffer, DMA capable and aligned to 4. It must stay valid until ``essl_stream_stop``.
+ * @param size Size of the ring buffer, a power of two, at least 4.
+ *
+ * @return
+ *      - ESP_OK:                Success
+ *      - ESP_ERR_INVALID_ARG:   Invalid argument, or the ring buffer is not suitable for the DMA
+ *      - ESP_ERR_NOT_SUPPORTED: The device does not support receiving
+ *      - ESP_ERR_INVALID_STATE: The stream is already started
+ *      - ESP_ERR_NO_MEM:        Memory exhausted
+ */
+esp_err_t essl_stream_start(essl_handle_t handle, uint8_t *ring, size_t size);
+
+/** Stop receiving the stream, the unconsumed data are dropped.
+ *
+ * @param handle Handle of an ESSL device.
+ *
+ * @return
+ *      - ESP_OK:                Success
+ *      - ESP_ERR_INVALID_ARG:   Invalid argument
+ *      - ESP_ERR_INVALID_STATE: The stream is not started
+ */
+esp_err_t essl_stream_stop(essl_handle_t handle);
+
+/** Receive the data the slave has sent into the free space of the ring buffer.
+ *
+ * At most two reads are done, before and after the end of the ring. Data which do not fit are received
+ * by the next call, after the consumer has freed some space.
+ *
+ * @param handle Handle of an ESSL device.
+ * @param wait_ms Millisecond to wait for the slave to have data to send.
+ * @param[out] out_length Number of bytes received.
+ *
+ * @return
+ *      - ESP_OK:                Some data are received
+ *      - ESP_ERR_INVALID_ARG:   Invalid argument
+ *      - ESP_ERR_INVALID_STATE: The stream is not started
+ *      - ESP_ERR_NOT_FOUND:     The slave has no data to send, or the ring buffer is full
+ *      - One of the error codes from SDMMC/SPI host controller
+ */
+esp_err_t essl_stream_receive(essl_handle_t handle, uint32_t wait_ms, size_t *out_length);
+
+/** Get the received data which are not consumed yet.
+ *
+ * Only the data before the end of the ring are returned, the data after the wrap are returned once they are consumed.
+ *
+ * @param handle Handle of an ESSL device.
+ * @param[out] out_data Start of the data in the ring buffer.
+ * @param[out] out_length Number of bytes available at ``out_data``, 0 if there is no data.
+ *
+ * @return
+ *      - ESP_OK:                Success
+ *      - ESP_ERR_INVALID_ARG:   Invalid argument
+ *      - ESP_ERR_INVALID_STATE: The stream is not started
+ */
+esp_err_t essl_stream_peek(essl_handle_t handle, const uint8_t **out_data, size_t *out_length);
+
+/** Release the space of data which have been used, so that new data can be received into it.
+ *
+ * @param handle Handle of an ESSL device.
+ * @param length Number of bytes to release, from the start of the data returned by ``essl_stream_peek``.
+ *
+ * @return
+ *      - ESP_OK:                Success
+ *      - ESP_ERR_INVALID_ARG:   Invalid argument
+ *      - ESP_ERR_INVALID_STATE: The stream is not started
+ *      - ESP_ERR_INVALID_SIZE:  ``length`` is larger than the received data
+ */
+esp_err_t essl_stream_consume(essl_handle_t handle, size_t length);
+
+/// Transfer statistics of an ESSL device
+typedef struct {
+    uint64_t tx_bytes;      ///< Bytes sent by ``essl_send_packet``.
+    uint64_t rx_bytes;      ///< Bytes received by ``essl_get_packet``.
+    uint32_t tx_packets;    ///< Packets sent.
+    uint32_t rx_packets;    ///< Packets received.
+    uint32_t tx_retries;    ///< Attempts to send while the slave had not enough buffers.
+    uint32_t rx_retries;    ///< Updates of the slave data size which found no data.
+    uint32_t errors;        ///< Failed transfers, timeouts excluded.
+    int64_t tx_wait_us;     ///< Time waiting for the slave buffers, also in ``essl_get_tx_buffer_num``, in microseconds.
+    int64_t rx_wait_us;     ///< Time waiting for the slave data, in microseconds.
+    int64_t tx_time_us;     ///< Total time in ``essl_send_packet``, in microseconds.
+    int64_t rx_time_us;     ///< Total time in ``essl_get_packet``, in microseconds.
+} essl_stats_t;
+
+/** Get the transfer statistics of an ESSL device.
+ *
+ * The statistics are counted since the initialization of the device or the last ``essl_reset_stats``.
+ * The throughput is e.g. ``tx_bytes * 1000000 / tx_time_us`` bytes per second.
+ *
+ * @param handle Handle of an ESSL device.
+ * @param[out] out_stats Output of the statistics.
+ *
+ * @return
+ *      - ESP_OK:                Success
+ *      - ESP_ERR_INVALID_ARG:   Invalid argument
+ */
+esp_err_t essl_get_stats(essl_handle_t handle, essl_stats_t *out_stats);
+
+/** Reset the transfer statistics of an ESSL device.
+ *
+ * @param handle Handle of an ESSL device.
+ *
+ * @return
+ *      - ESP_OK:                Success
+ *      - ESP_ERR_INVALID_ARG:   Invalid argument
+ */
+esp_err_t essl_reset_stats(essl_handle_t handle);
+
 #ifdef __cplusplus
 }
 #endif
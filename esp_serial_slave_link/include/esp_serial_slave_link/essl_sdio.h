@@ -23,6 +23,9 @@ extern "C" {
 typedef struct {
     sdmmc_card_t *card;     ///< The initialized sdmmc card pointer of the slave.
     int recv_buffer_size;   ///< The pre-negotiated recv buffer size used by both the host and the slave.
+    bool pad_to_block;      ///< Transfer the tail of packets longer than a block (512 bytes) in a padded block of the same CMD53, instead of an extra byte mode CMD53.
+    ///< The ESP SDIO slaves ignore the padding. The buffers given to ``essl_send_packet`` and ``essl_get_packet`` must then be
+    ///< accessible up to their length rounded up to a multiple of 512 bytes.
 } essl_sdio_config_t;
 
 
@@ -221,6 +224,38 @@ esp_err_t essl_sdio_write_reg(void *arg, uint8_t addr, uint8_t value, uint8_t *v
  */
 esp_err_t essl_sdio_read_reg(void *arg, uint8_t add, uint8_t *value_o, uint32_t wait_ms);
 
+/**
+ * Write consecutive general purpose R/W registers (8-bit) of an ESSL SDIO slave, by one CMD53 per contiguous range.
+ *
+ * @param arg Context of the component.
+ * @param addr Address of the first register to write. Valid address: 0-59, the reserved registers are skipped as for ``essl_sdio_write_reg``.
+ * @param values Values to write to the registers.
+ * @param len Number of registers to write.
+ * @param wait_ms Time to wait before timeout, in ms.
+ *
+ * @return
+ *      - ESP_OK Success
+ *      - ESP_ERR_INVALID_ARG Range not valid.
+ *      - One of the error codes from SDMMC host controller
+ */
+esp_err_t essl_sdio_write_regs(void *arg, uint8_t addr, const uint8_t *values, size_t len, uint32_t wait_ms);
+
+/**
+ * Read consecutive general purpose R/W registers (8-bit) of an ESSL SDIO slave, by one CMD53 per contiguous range.
+ *
+ * @param arg Context of the component.
+ * @param addr Address of the first register to read. Valid address: 0-59, the reserved registers are skipped as for ``essl_sdio_read_reg``.
+ * @param values_o Output values read from the registers.
+ * @param len Number of registers to read.
+ * @param wait_ms Time to wait before timeout, in ms.
+ *
+ * @return
+ *      - ESP_OK Success
+ *      - ESP_ERR_INVALID_ARG Range not valid.
+ *      - One of the error codes from SDMMC host controller
+ */
+esp_err_t essl_sdio_read_regs(void *arg, uint8_t addr, uint8_t *values_o, size_t len, uint32_t wait_ms);
+
 /**
  * Send interrupts to slave. Each bit of the interrupt will be triggered.
  *
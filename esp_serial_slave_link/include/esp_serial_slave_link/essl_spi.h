@@ -8,6 +8,7 @@
 
 #include "esp_err.h"
 #include "driver/spi_master.h"
+#include "driver/gpio.h"
 
 #include "esp_serial_slave_link/essl.h"
 
@@ -15,12 +16,17 @@
 extern "C" {
 #endif
 
+/// Maximum number of segment transactions queued by ``essl_spi_rddma_queued`` and ``essl_spi_wrdma_queued``
+#define ESSL_SPI_QUEUE_DEPTH_MAX    4
+
 /// Configuration of ESSL SPI device
 typedef struct {
     spi_device_handle_t *spi;           ///< Pointer to SPI device handle.
     uint32_t            tx_buf_size;    ///< The pre-negotiated Master TX buffer size used by both the host and the slave.
     uint8_t             tx_sync_reg;    ///< The pre-negotiated register ID for Master-TX-SLAVE-RX synchronization. 1 word (4 Bytes) will be reserved for the synchronization.
     uint8_t             rx_sync_reg;    ///< The pre-negotiated register ID for Master-RX-Slave-TX synchronization. 1 word (4 Bytes) will be reserved for the synchronization.
+    gpio_num_t          handshake_gpio; ///< GPIO toggled by the slave after each update of `tx_sync_reg` or `rx_sync_reg`, used only if `use_handshake` is set.
+    bool                use_handshake;  ///< Read the synchronization registers only after an edge of `handshake_gpio`, instead of polling them.
 } essl_spi_config_t;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -34,13 +40,17 @@ typedef struct {
 /**
  * @brief Initialize the ESSL SPI device function list and get its handle
  *
+ * The synchronization registers are read until two reads match. With `use_handshake`, they are read only
+ * after an edge of `handshake_gpio`, and `wait_ms` of ``essl_get_packet`` and ``essl_send_packet`` is the
+ * time to wait for an edge when the slave has not loaded enough buffers.
+ *
  * @param[out] out_handle    Output of the handle
  * @param      init_config   Configuration for the ESSL SPI device
  * @return
  *        - ESP_OK:                On success
  *        - ESP_ERR_NO_MEM:        Memory exhausted
  *        - ESP_ERR_INVALID_STATE: SPI driver is not initialized
- *        - ESP_ERR_INVALID_ARG:   Wrong register ID
+ *        - ESP_ERR_INVALID_ARG:   Wrong register ID or handshake GPIO
  */
 esp_err_t essl_spi_init_dev(essl_handle_t *out_handle, const essl_spi_config_t *init_config);
 
@@ -71,6 +81,24 @@ esp_err_t essl_spi_deinit_dev(essl_handle_t handle);
  */
 esp_err_t essl_spi_read_reg(void *arg, uint8_t addr, uint8_t *out_value, uint32_t wait_ms);
 
+/**
+ * @brief Read consecutive shared registers by one transaction
+ *
+ * @note The registers for Master/Slave synchronization are reserved, the range must not include them.
+ *
+ * @param      arg         Context of the component. (Member ``arg`` from ``essl_handle_t``)
+ * @param      addr        Address of the first shared register.
+ * @param[out] out_values  Read buffer for the shared registers.
+ * @param      len         Number of registers to read, ``addr + len`` should not be larger than SOC_SPI_MAXIMUM_BUFFER_SIZE.
+ * @param      wait_ms     Time to wait before timeout (reserved for future use, user should set this to 0).
+ * @return
+ *        - ESP_OK:                success
+ *        - ESP_ERR_INVALID_STATE: ESSL SPI has not been initialized.
+ *        - ESP_ERR_INVALID_ARG:   The range is not valid.
+ *        - or other return value from :cpp:func:`spi_device_transmit`.
+ */
+esp_err_t essl_spi_read_regs(void *arg, uint8_t addr, uint8_t *out_values, size_t len, uint32_t wait_ms);
+
 /**
  * @brief Get a packet from Slave
  *
@@ -107,6 +135,24 @@ esp_err_t essl_spi_get_packet(void *arg, void *out_data, size_t size, uint32_t w
  */
 esp_err_t essl_spi_write_reg(void *arg, uint8_t addr, uint8_t value, uint8_t *out_value, uint32_t wait_ms);
 
+/**
+ * @brief Write consecutive shared registers by one transaction
+ *
+ * @note The registers for Master/Slave synchronization are reserved, the range must not include them.
+ *
+ * @param arg      Context of the component. (Member ``arg`` from ``essl_handle_t``)
+ * @param addr     Address of the first shared register.
+ * @param values   Values to write to the shared registers.
+ * @param len      Number of registers to write, ``addr + len`` should not be larger than SOC_SPI_MAXIMUM_BUFFER_SIZE.
+ * @param wait_ms  Time to wait before timeout (reserved for future use, user should set this to 0).
+ * @return
+ *        - ESP_OK:                success
+ *        - ESP_ERR_INVALID_STATE: ESSL SPI has not been initialized.
+ *        - ESP_ERR_INVALID_ARG:   The range is not valid.
+ *        - or other return value from :cpp:func:`spi_device_transmit`.
+ */
+esp_err_t essl_spi_write_regs(void *arg, uint8_t addr, const uint8_t *values, size_t len, uint32_t wait_ms);
+
 /**
  * @brief Send a packet to Slave
  *
@@ -307,6 +353,49 @@ esp_err_t essl_spi_wrdma_seg(spi_device_handle_t spi, const uint8_t *data, int s
  */
 esp_err_t essl_spi_wrdma_done(spi_device_handle_t spi, uint32_t flags);
 
+/**
+ * @brief Receive long buffer in segments from the slave through its DMA, with the segments queued.
+ *
+ * Same as :cpp:func:`essl_spi_rddma`, but up to ``queue_depth`` segments are queued by
+ * :cpp:func:`spi_device_queue_trans`, so that the next segment starts as soon as the previous one is done,
+ * without waiting for the task to be scheduled between them. The gain is the largest for short segments
+ * and high clock frequencies.
+ *
+ * @note The ``queue_size`` of the SPI device must not be smaller than ``queue_depth``, and no other
+ *       transaction must be queued to the device meanwhile.
+ *
+ * @param      spi          SPI device handle representing the slave
+ * @param[out] out_data     Buffer to hold the received data, DMA capable and aligned to 4
+ * @param      len          Total length of data to receive.
+ * @param      seg_len      Length of each segment, as for :cpp:func:`essl_spi_rddma`. Should be multiples of 4.
+ * @param      queue_depth  Number of segments queued at the same time, up to ESSL_SPI_QUEUE_DEPTH_MAX.
+ * @param      flags        `SPI_TRANS_*` flags to control the transaction mode, e.g. `SPI_TRANS_MODE_QIO`
+ *                          for the widest mode of the slave, if the bus has the 4 data lines.
+ * @return
+ *      - ESP_OK: success
+ *      - ESP_ERR_INVALID_ARG: the buffer is not DMA capable or not aligned to 4
+ *      - or other return value from :cpp:func:`spi_device_queue_trans`.
+ */
+esp_err_t essl_spi_rddma_queued(spi_device_handle_t spi, uint8_t *out_data, int len, int seg_len, int queue_depth, uint32_t flags);
+
+/**
+ * @brief Send long buffer in segments to the slave through its DMA, with the segments queued.
+ *
+ * Same as :cpp:func:`essl_spi_wrdma`, with up to ``queue_depth`` segments queued, see :cpp:func:`essl_spi_rddma_queued`.
+ *
+ * @param spi          SPI device handle representing the slave
+ * @param data         Buffer for data to send, DMA capable
+ * @param len          Total length of data to send.
+ * @param seg_len      Length of each segment, as for :cpp:func:`essl_spi_wrdma`.
+ * @param queue_depth  Number of segments queued at the same time, up to ESSL_SPI_QUEUE_DEPTH_MAX.
+ * @param flags        `SPI_TRANS_*` flags to control the transaction mode of the transactions to send.
+ * @return
+ *      - ESP_OK: success
+ *      - ESP_ERR_INVALID_ARG: the buffer is not DMA capable
+ *      - or other return value from :cpp:func:`spi_device_queue_trans`.
+ */
+esp_err_t essl_spi_wrdma_queued(spi_device_handle_t spi, const uint8_t *data, int len, int seg_len, int queue_depth, uint32_t flags);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,121 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/param.h>
+#include "esp_heap_caps.h"
+#include "unity.h"
+#include "essl_internal.h"
+
+#define RING_SIZE   16
+
+/* Slave sending bytes counting modulo a prime, which does not align with the ring */
+typedef struct {
+    size_t sent;
+    size_t available;
+} fake_slave_t;
+
+static uint8_t pattern(size_t offset)
+{
+    return offset % 251;
+}
+
+static esp_err_t fake_update_rx_data_size(void *ctx, uint32_t wait_ms)
+{
+    return ESP_OK;
+}
+
+static uint32_t fake_get_rx_data_size(void *ctx)
+{
+    return ((fake_slave_t *)ctx)->available;
+}
+
+static esp_err_t fake_get_packet(void *ctx, void *out_data, size_t size, uint32_t wait_ms)
+{
+    fake_slave_t *slave = ctx;
+    TEST_ASSERT_LESS_OR_EQUAL(slave->available, size);
+    for (size_t i = 0; i < size; i++) {
+        ((uint8_t *)out_data)[i] = pattern(slave->sent + i);
+    }
+    slave->sent += size;
+    slave->available -= size;
+    return ESP_OK;
+}
+
+TEST_CASE("essl stream ring size", "[essl]")
+{
+    fake_slave_t slave = {};
+    essl_dev_t dev = {
+        .args = &slave,
+        .update_rx_data_size = fake_update_rx_data_size,
+        .get_rx_data_size = fake_get_rx_data_size,
+        .get_packet = fake_get_packet,
+    };
+    uint8_t *ring = heap_caps_malloc(24, MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(ring);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, essl_stream_start(&dev, ring, 24));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, essl_stream_start(&dev, ring, 12));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, essl_stream_start(&dev, ring, 2));
+    TEST_ASSERT_EQUAL(ESP_OK, essl_stream_start(&dev, ring, RING_SIZE));
+    TEST_ASSERT_EQUAL(ESP_OK, essl_stream_stop(&dev));
+
+    free(ring);
+}
+
+TEST_CASE("essl stream across the wrap of the counters", "[essl]")
+{
+    fake_slave_t slave = {};
+    essl_dev_t dev = {
+        .args = &slave,
+        .update_rx_data_size = fake_update_rx_data_size,
+        .get_rx_data_size = fake_get_rx_data_size,
+        .get_packet = fake_get_packet,
+    };
+    uint8_t *ring = heap_caps_malloc(RING_SIZE, MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(ring);
+    TEST_ASSERT_EQUAL(ESP_OK, essl_stream_start(&dev, ring, RING_SIZE));
+
+    // Start as if about 4 GiB had been streamed already
+    essl_stream_t *stream = dev.stream;
+    atomic_store(&stream->head, SIZE_MAX - 7);
+    atomic_store(&stream->tail, SIZE_MAX - 7);
+
+    // The received data are split by the end of the ring, which is also where the counters wrap
+    size_t received;
+    slave.available = 12;
+    TEST_ASSERT_EQUAL(ESP_OK, essl_stream_receive(&dev, 0, &received));
+    TEST_ASSERT_EQUAL(12, received);
+    TEST_ASSERT_EQUAL(4, atomic_load(&stream->head));
+
+    const uint8_t *data;
+    size_t length;
+    TEST_ASSERT_EQUAL(ESP_OK, essl_stream_peek(&dev, &data, &length));
+    TEST_ASSERT_EQUAL_PTR(ring + RING_SIZE - 8, data);
+    TEST_ASSERT_EQUAL(8, length);
+
+    // Consume by odd amounts, across the wrap and for many turns of the ring
+    size_t consumed = 0;
+    while (consumed < 1000) {
+        slave.available = 12;
+        esp_err_t err = essl_stream_receive(&dev, 0, &received);
+        TEST_ASSERT(err == ESP_OK || err == ESP_ERR_NOT_FOUND);
+
+        TEST_ASSERT_EQUAL(ESP_OK, essl_stream_peek(&dev, &data, &length));
+        TEST_ASSERT_NOT_EQUAL(0, length);
+        length = MIN(length, 5);
+        for (size_t i = 0; i < length; i++) {
+            TEST_ASSERT_EQUAL_UINT8(pattern(consumed + i), data[i]);
+        }
+        TEST_ASSERT_EQUAL(ESP_OK, essl_stream_consume(&dev, length));
+        consumed += length;
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, essl_stream_consume(&dev, RING_SIZE + 1));
+
+    TEST_ASSERT_EQUAL(ESP_OK, essl_stream_stop(&dev));
+    free(ring);
+}
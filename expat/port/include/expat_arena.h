@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "sdkconfig.h"
+#include "expat.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Per-parser arena allocator for expat
+ *
+ * The parser returned by expat_arena_parser_create() gets its memory from a bump allocator
+ * through XML_ParserCreate_MM(). Memory is taken from chunks of `chunk_size` bytes and
+ * frees are no-ops, so expat's many small allocations don't take the heap lock and
+ * don't fragment the heap. All of it is released at once by expat_arena_parser_reset(),
+ * which keeps the chunks for the next document, or by expat_arena_delete().
+ *
+ * expat's memory handling functions get no context argument, so the arena is bound to the
+ * calling task while the expat_arena functions run. Allocations made by other expat calls,
+ * e.g. XML_SetBase(), are taken from the heap and remain valid.
+ *
+ * An arena holds one parser and must only be used by one task at a time.
+ */
+
+/**
+ * @brief Handle of an arena
+ */
+typedef struct expat_arena *expat_arena_handle_t;
+
+/**
+ * @brief Arena configuration
+ */
+typedef struct {
+    uint32_t heap_caps;     /**< Heap capabilities of the chunks, 0 for MALLOC_CAP_DEFAULT */
+    size_t chunk_size;      /**< Size of the chunks, 0 for CONFIG_EXPAT_ARENA_CHUNK_SIZE */
+} expat_arena_config_t;
+
+#if CONFIG_EXPAT_ARENA_MEM_SPIRAM
+#define EXPAT_ARENA_HEAP_CAPS   MALLOC_CAP_SPIRAM
+#elif CONFIG_EXPAT_ARENA_MEM_INTERNAL
+#define EXPAT_ARENA_HEAP_CAPS   MALLOC_CAP_INTERNAL
+#else
+#define EXPAT_ARENA_HEAP_CAPS   MALLOC_CAP_DEFAULT
+#endif
+
+/**
+ * @brief Default arena configuration, as selected in menuconfig
+ */
+#define EXPAT_ARENA_DEFAULT_CONFIG() {              \
+    .heap_caps = EXPAT_ARENA_HEAP_CAPS,             \
+    .chunk_size = CONFIG_EXPAT_ARENA_CHUNK_SIZE,    \
+}
+
+/**
+ * @brief Create an arena
+ *
+ * The first chunk is allocated here.
+ *
+ * @param[in]  config    Arena configuration
+ * @param[out] ret_arena Arena handle
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid argument
+ *     - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t expat_arena_create(const expat_arena_config_t *config, expat_arena_handle_t *ret_arena);
+
+/**
+ * @brief Delete an arena, its parser and all its memory
+ *
+ * @param[in] arena Arena handle
+ */
+void expat_arena_delete(expat_arena_handle_t arena);
+
+/**
+ * @brief Create the parser of the arena
+ *
+ * Same as XML_ParserCreate(), with the memory of the parser taken from the arena.
+ *
+ * @param[in] arena    Arena handle
+ * @param[in] encoding Encoding of the document, NULL if not known in advance
+ *
+ * @return Parser, NULL if out of memory or if the arena already holds a parser
+ */
+XML_Parser expat_arena_parser_create(expat_arena_handle_t arena, const XML_Char *encoding);
+
+/**
+ * @brief Reset the parser of the arena for a new document
+ *
+ * Unlike XML_ParserReset(), which frees and reallocates the internal structures one by one,
+ * the arena is rewound in O(1) and a new parser is created from its first chunk. As with
+ * XML_ParserReset(), handlers and user data have to be set again.
+ *
+ * @param[in] arena    Arena handle
+ * @param[in] encoding Encoding of the next document, NULL if not known in advance
+ *
+ * @return New parser, which replaces the previous one. NULL if out of memory.
+ */
+XML_Parser expat_arena_parser_reset(expat_arena_handle_t arena, const XML_Char *encoding);
+
+/**
+ * @brief Parse a part of the document with the parser of the arena
+ *
+ * Same as XML_Parse(), with the allocations made by the parser taken from the arena.
+ */
+enum XML_Status expat_arena_parse(expat_arena_handle_t arena, const char *s, int len, int is_final);
+
+/**
+ * @brief Get a buffer for the next part of the document from the parser of the arena
+ *
+ * Same as XML_GetBuffer(), use expat_arena_parse_buffer() to parse it.
+ */
+void *expat_arena_get_buffer(expat_arena_handle_t arena, int len);
+
+/**
+ * @brief Parse the buffer returned by expat_arena_get_buffer()
+ *
+ * Same as XML_ParseBuffer(), with the allocations made by the parser taken from the arena.
+ */
+enum XML_Status expat_arena_parse_buffer(expat_arena_handle_t arena, int len, int is_final);
+
+/**
+ * @brief Number of bytes of the arena in use, without the allocations taken from the heap directly
+ *
+ * @param[in] arena Arena handle
+ *
+ * @return Bytes in use
+ */
+size_t expat_arena_get_used(expat_arena_handle_t arena);
+
+#ifdef __cplusplus
+}
+#endif
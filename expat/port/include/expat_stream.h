@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+#include "expat.h"
+#if CONFIG_EXPAT_STREAM_HTTP_CLIENT
+#include "esp_http_client.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Callback reading the next part of the document
+ *
+ * @param[in]  ctx Context given to expat_stream_parse()
+ * @param[out] buf Buffer of the parser to read the data into
+ * @param[in]  len Size of the buffer
+ *
+ * @return Number of bytes read, 0 at the end of the document, negative on error
+ */
+typedef int (*expat_stream_read_cb_t)(void *ctx, char *buf, int len);
+
+/**
+ * @brief Parse a document read in chunks
+ *
+ * The data is read with `read_cb` directly into the buffer returned by XML_GetBuffer() and
+ * parsed with XML_ParseBuffer(), without the copy XML_Parse() makes from a buffer of the
+ * application. The buffer is allocated once and reused for all the chunks.
+ *
+ * Suspending the parser with XML_StopParser() is not supported.
+ *
+ * @param[in] parser     Parser with the handlers set
+ * @param[in] read_cb    Callback reading the document
+ * @param[in] ctx        Context passed to `read_cb`
+ * @param[in] chunk_size Maximum number of bytes to read at once, 0 for CONFIG_EXPAT_STREAM_CHUNK_SIZE
+ *
+ * @return
+ *     - ESP_OK: The whole document was parsed
+ *     - ESP_ERR_INVALID_ARG: Invalid argument
+ *     - ESP_ERR_NO_MEM: The parse buffer could not be allocated
+ *     - ESP_ERR_INVALID_RESPONSE: The document is not well-formed, see XML_GetErrorCode()
+ *     - ESP_ERR_INVALID_STATE: The parser was stopped or suspended by a handler
+ *     - ESP_FAIL: `read_cb` failed
+ */
+esp_err_t expat_stream_parse(XML_Parser parser, expat_stream_read_cb_t read_cb, void *ctx, int chunk_size);
+
+#if CONFIG_EXPAT_STREAM_HTTP_CLIENT
+/**
+ * @brief Parse the body of an HTTP response
+ *
+ * Same as expat_stream_parse() with esp_http_client_read() as the read callback, so the body is
+ * read directly into the buffer of the parser. The connection must be opened with
+ * esp_http_client_open() and the headers fetched with esp_http_client_fetch_headers().
+ *
+ * @param[in] parser     Parser with the handlers set
+ * @param[in] client     HTTP client with the headers of the response fetched
+ * @param[in] chunk_size Maximum number of bytes to read at once, 0 for CONFIG_EXPAT_STREAM_CHUNK_SIZE
+ *
+ * @return Same as expat_stream_parse(), ESP_FAIL if reading the body failed
+ */
+esp_err_t expat_stream_parse_http_client(XML_Parser parser, esp_http_client_handle_t client, int chunk_size);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,281 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "expat_arena.h"
+
+static const char *TAG = "expat_arena";
+
+#define ARENA_ALIGN         8
+#define ARENA_ALIGN_UP(x)   (((x) + ARENA_ALIGN - 1) & ~((uintptr_t)ARENA_ALIGN - 1))
+
+typedef struct arena_chunk {
+    struct arena_chunk *next;
+    uint8_t *start;
+    uint8_t *end;
+} arena_chunk_t;
+
+/* Header in front of every allocation */
+typedef struct {
+    struct expat_arena *arena;  // Arena of a block in a chunk, NULL for a block taken from the heap
+    size_t size;                // Requested size of a block in a chunk, heap caps of a heap block
+} arena_block_t;
+
+_Static_assert(sizeof(arena_block_t) % ARENA_ALIGN == 0, "Block header must keep the alignment");
+
+struct expat_arena {
+    uint32_t heap_caps;
+    size_t chunk_size;
+    size_t large_size;          // Blocks larger than this are taken from the heap
+    arena_chunk_t *first;
+    arena_chunk_t *cur;
+    uint8_t *pos;               // Next free byte of the current chunk
+    size_t used;
+    XML_Parser parser;
+};
+
+/* Arena of the expat_arena call running on this task, used by arena_malloc() */
+static __thread struct expat_arena *s_bound_arena;
+
+static arena_chunk_t *chunk_create(struct expat_arena *arena)
+{
+    arena_chunk_t *chunk = heap_caps_malloc(sizeof(arena_chunk_t) + ARENA_ALIGN + arena->chunk_size, arena->heap_caps);
+    if (!chunk) {
+        ESP_LOGE(TAG, "Failed to allocate chunk of %u bytes", (unsigned)arena->chunk_size);
+        return NULL;
+    }
+    chunk->next = NULL;
+    chunk->start = (uint8_t *)ARENA_ALIGN_UP((uintptr_t)(chunk + 1));
+    chunk->end = chunk->start + arena->chunk_size;
+    return chunk;
+}
+
+static void *heap_block_alloc(size_t size, uint32_t caps)
+{
+    arena_block_t *block = heap_caps_malloc(sizeof(arena_block_t) + size, caps);
+    if (!block) {
+        return NULL;
+    }
+    block->arena = NULL;
+    block->size = caps;
+    return block + 1;
+}
+
+static void *arena_block_alloc(struct expat_arena *arena, size_t size)
+{
+    const size_t need = ARENA_ALIGN_UP(sizeof(arena_block_t) + size);
+    if (need > arena->large_size) {
+        return heap_block_alloc(size, arena->heap_caps);
+    }
+    if (arena->pos + need > arena->cur->end) {
+        // Chunks kept by expat_arena_parser_reset() are reused before allocating new ones
+        if (!arena->cur->next) {
+            arena->cur->next = chunk_create(arena);
+            if (!arena->cur->next) {
+                return NULL;
+            }
+        }
+        arena->cur = arena->cur->next;
+        arena->pos = arena->cur->start;
+    }
+    arena_block_t *block = (arena_block_t *)arena->pos;
+    block->arena = arena;
+    block->size = size;
+    arena->pos += need;
+    arena->used += need;
+    return block + 1;
+}
+
+static inline bool arena_block_is_last(const arena_block_t *block)
+{
+    const struct expat_arena *arena = block->arena;
+    return (const uint8_t *)block + ARENA_ALIGN_UP(sizeof(arena_block_t) + block->size) == arena->pos;
+}
+
+static void *arena_malloc(size_t size)
+{
+    struct expat_arena *arena = s_bound_arena;
+    if (!arena) {
+        return heap_block_alloc(size, MALLOC_CAP_DEFAULT);
+    }
+    return arena_block_alloc(arena, size);
+}
+
+static void *arena_realloc(void *ptr, size_t size)
+{
+    if (!ptr) {
+        return arena_malloc(size);
+    }
+    arena_block_t *block = (arena_block_t *)ptr - 1;
+    if (!block->arena) {
+        const uint32_t caps = block->size;
+        block = heap_caps_realloc(block, sizeof(arena_block_t) + size, caps);
+        return block ? block + 1 : NULL;
+    }
+    if (size <= block->size) {
+        return ptr;
+    }
+
+    struct expat_arena *arena = block->arena;
+    const size_t old_need = ARENA_ALIGN_UP(sizeof(arena_block_t) + block->size);
+    const size_t need = ARENA_ALIGN_UP(sizeof(arena_block_t) + size);
+    // The last block of the current chunk grows in place
+    if (arena_block_is_last(block) && need <= arena->large_size && (uint8_t *)block + need <= arena->cur->end) {
+        arena->pos = (uint8_t *)block + need;
+        arena->used += need - old_need;
+        block->size = size;
+        return ptr;
+    }
+    void *new_ptr = arena_block_alloc(arena, size);
+    if (new_ptr) {
+        memcpy(new_ptr, ptr, block->size);
+    }
+    return new_ptr;
+}
+
+static void arena_free(void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+    arena_block_t *block = (arena_block_t *)ptr - 1;
+    if (!block->arena) {
+        heap_caps_free(block);
+    } else if (arena_block_is_last(block)) {
+        // Give back the last block, other blocks are released by the reset of the arena
+        struct expat_arena *arena = block->arena;
+        arena->used -= arena->pos - (uint8_t *)block;
+        arena->pos = (uint8_t *)block;
+    }
+}
+
+static const XML_Memory_Handling_Suite s_arena_suite = {
+    .malloc_fcn = arena_malloc,
+    .realloc_fcn = arena_realloc,
+    .free_fcn = arena_free,
+};
+
+static inline struct expat_arena *arena_bind(struct expat_arena *arena)
+{
+    struct expat_arena *prev = s_bound_arena;
+    s_bound_arena = arena;
+    return prev;
+}
+
+static inline void arena_unbind(struct expat_arena *prev)
+{
+    s_bound_arena = prev;
+}
+
+esp_err_t expat_arena_create(const expat_arena_config_t *config, expat_arena_handle_t *ret_arena)
+{
+    ESP_RETURN_ON_FALSE(config && ret_arena, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+
+    struct expat_arena *arena = calloc(1, sizeof(struct expat_arena));
+    ESP_RETURN_ON_FALSE(arena, ESP_ERR_NO_MEM, TAG, "Failed to allocate arena");
+    arena->heap_caps = config->heap_caps ? config->heap_caps : MALLOC_CAP_DEFAULT;
+    arena->chunk_size = ARENA_ALIGN_UP(config->chunk_size ? config->chunk_size : CONFIG_EXPAT_ARENA_CHUNK_SIZE);
+    arena->large_size = arena->chunk_size / 2;
+
+    arena->first = chunk_create(arena);
+    if (!arena->first) {
+        free(arena);
+        return ESP_ERR_NO_MEM;
+    }
+    arena->cur = arena->first;
+    arena->pos = arena->first->start;
+    *ret_arena = arena;
+    return ESP_OK;
+}
+
+void expat_arena_delete(expat_arena_handle_t arena)
+{
+    if (!arena) {
+        return;
+    }
+    if (arena->parser) {
+        struct expat_arena *prev = arena_bind(arena);
+        XML_ParserFree(arena->parser);
+        arena_unbind(prev);
+    }
+    arena_chunk_t *chunk = arena->first;
+    while (chunk) {
+        arena_chunk_t *next = chunk->next;
+        heap_caps_free(chunk);
+        chunk = next;
+    }
+    free(arena);
+}
+
+XML_Parser expat_arena_parser_create(expat_arena_handle_t arena, const XML_Char *encoding)
+{
+    if (!arena || arena->parser) {
+        return NULL;
+    }
+    struct expat_arena *prev = arena_bind(arena);
+    arena->parser = XML_ParserCreate_MM(encoding, &s_arena_suite, NULL);
+    arena_unbind(prev);
+    return arena->parser;
+}
+
+XML_Parser expat_arena_parser_reset(expat_arena_handle_t arena, const XML_Char *encoding)
+{
+    if (!arena) {
+        return NULL;
+    }
+    if (arena->parser) {
+        // Frees the blocks taken from the heap, the chunks are rewound below
+        struct expat_arena *prev = arena_bind(arena);
+        XML_ParserFree(arena->parser);
+        arena_unbind(prev);
+        arena->parser = NULL;
+    }
+    arena->cur = arena->first;
+    arena->pos = arena->first->start;
+    arena->used = 0;
+    return expat_arena_parser_create(arena, encoding);
+}
+
+enum XML_Status expat_arena_parse(expat_arena_handle_t arena, const char *s, int len, int is_final)
+{
+    if (!arena || !arena->parser) {
+        return XML_STATUS_ERROR;
+    }
+    struct expat_arena *prev = arena_bind(arena);
+    enum XML_Status status = XML_Parse(arena->parser, s, len, is_final);
+    arena_unbind(prev);
+    return status;
+}
+
+void *expat_arena_get_buffer(expat_arena_handle_t arena, int len)
+{
+    if (!arena || !arena->parser) {
+        return NULL;
+    }
+    struct expat_arena *prev = arena_bind(arena);
+    void *buf = XML_GetBuffer(arena->parser, len);
+    arena_unbind(prev);
+    return buf;
+}
+
+enum XML_Status expat_arena_parse_buffer(expat_arena_handle_t arena, int len, int is_final)
+{
+    if (!arena || !arena->parser) {
+        return XML_STATUS_ERROR;
+    }
+    struct expat_arena *prev = arena_bind(arena);
+    enum XML_Status status = XML_ParseBuffer(arena->parser, len, is_final);
+    arena_unbind(prev);
+    return status;
+}
+
+size_t expat_arena_get_used(expat_arena_handle_t arena)
+{
+    return arena ? arena->used : 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_check.h"
+#include "esp_log.h"
+#include "expat_stream.h"
+
+static const char *TAG = "expat_stream";
+
+static esp_err_t parse_status_to_err(XML_Parser parser, enum XML_Status status)
+{
+    if (status == XML_STATUS_OK) {
+        return ESP_OK;
+    }
+    if (status == XML_STATUS_SUSPENDED || XML_GetErrorCode(parser) == XML_ERROR_ABORTED) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    ESP_LOGE(TAG, "%s at line %lu", XML_ErrorString(XML_GetErrorCode(parser)),
+             (unsigned long)XML_GetCurrentLineNumber(parser));
+    return ESP_ERR_INVALID_RESPONSE;
+}
+
+esp_err_t expat_stream_parse(XML_Parser parser, expat_stream_read_cb_t read_cb, void *ctx, int chunk_size)
+{
+    ESP_RETURN_ON_FALSE(parser && read_cb && chunk_size >= 0, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    if (chunk_size == 0) {
+        chunk_size = CONFIG_EXPAT_STREAM_CHUNK_SIZE;
+    }
+
+    while (true) {
+        // expat reuses its buffer once the previous chunk has been parsed
+        char *buf = XML_GetBuffer(parser, chunk_size);
+        ESP_RETURN_ON_FALSE(buf, ESP_ERR_NO_MEM, TAG, "Failed to get parse buffer of %d bytes", chunk_size);
+        const int len = read_cb(ctx, buf, chunk_size);
+        ESP_RETURN_ON_FALSE(len >= 0, ESP_FAIL, TAG, "Failed to read document");
+
+        const esp_err_t ret = parse_status_to_err(parser, XML_ParseBuffer(parser, len, len == 0));
+        if (ret != ESP_OK || len == 0) {
+            return ret;
+        }
+    }
+}
+
+#if CONFIG_EXPAT_STREAM_HTTP_CLIENT
+static int http_client_read(void *ctx, char *buf, int len)
+{
+    return esp_http_client_read((esp_http_client_handle_t)ctx, buf, len);
+}
+
+esp_err_t expat_stream_parse_http_client(XML_Parser parser, esp_http_client_handle_t client, int chunk_size)
+{
+    ESP_RETURN_ON_FALSE(client, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    return expat_stream_parse(parser, http_client_read, client, chunk_size);
+}
+#endif
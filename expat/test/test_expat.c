@@ -5,7 +5,16 @@
  */
 
 #include <expat.h>
+#include "sdkconfig.h"
+#include "esp_timer.h"
+#include "expat_stream.h"
+#if CONFIG_EXPAT_ARENA_ALLOCATOR
+#include "expat_arena.h"
+#endif
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/param.h>
 #include "unity.h"
 
 typedef struct {
@@ -117,3 +126,133 @@ TEST_CASE("Expat parses XML", "[expat]")
     TEST_ASSERT_EQUAL(strlen(test_expected), strlen(user_data.output));
     TEST_ASSERT_EQUAL_STRING(test_expected, user_data.output);
 }
+
+typedef struct {
+    int items_total;
+    int items_generated;
+    int state;                  // 0: document start, 1: items, 2: document end, 3: done
+    char pending[64];
+    int pending_len;
+    int pending_off;
+    size_t bytes;
+} doc_gen_t;
+
+#define DOC_ITEM_FMT    "<item id=\"%d\">value of the item</item>"
+
+static int doc_gen_read(void *ctx, char *buf, int len)
+{
+    doc_gen_t *gen = (doc_gen_t *) ctx;
+    int off = 0;
+
+    while (off < len && gen->state < 3) {
+        if (gen->pending_off == gen->pending_len) {
+            if (gen->state == 0) {
+                gen->pending_len = snprintf(gen->pending, sizeof(gen->pending), "<list>");
+                gen->state = 1;
+            } else if (gen->state == 1 && gen->items_generated < gen->items_total) {
+                gen->pending_len = snprintf(gen->pending, sizeof(gen->pending), DOC_ITEM_FMT, gen->items_generated++);
+            } else if (gen->state == 1) {
+                gen->pending_len = snprintf(gen->pending, sizeof(gen->pending), "</list>");
+                gen->state = 2;
+            } else {
+                gen->state = 3;
+                break;
+            }
+            gen->pending_off = 0;
+        }
+        int n = MIN(len - off, gen->pending_len - gen->pending_off);
+        memcpy(buf + off, gen->pending + gen->pending_off, n);
+        gen->pending_off += n;
+        off += n;
+    }
+    gen->bytes += off;
+    return off;
+}
+
+static void XMLCALL count_element(void *userData, const XML_Char *name, const XML_Char **atts)
+{
+    if (strcmp(name, "item") == 0) {
+        ++*(int *) userData;
+    }
+}
+
+TEST_CASE("Expat streaming parse throughput", "[expat]")
+{
+    const int items = 4000;
+    const int chunk_size = 1024;
+
+    for (int copy = 0; copy < 2; copy++) {
+        doc_gen_t gen = { .items_total = items };
+        int count = 0;
+        XML_Parser parser = XML_ParserCreate(NULL);
+        TEST_ASSERT_NOT_NULL(parser);
+        XML_SetUserData(parser, &count);
+        XML_SetStartElementHandler(parser, count_element);
+
+        int64_t start = esp_timer_get_time();
+        if (copy) {
+            // Glue code reading into a buffer of the application, which XML_Parse() copies again
+            char *buf = malloc(chunk_size);
+            TEST_ASSERT_NOT_NULL(buf);
+            int len;
+            do {
+                len = doc_gen_read(&gen, buf, chunk_size);
+                TEST_ASSERT_EQUAL(XML_STATUS_OK, XML_Parse(parser, buf, len, len == 0));
+            } while (len > 0);
+            free(buf);
+        } else {
+            TEST_ASSERT_EQUAL(ESP_OK, expat_stream_parse(parser, doc_gen_read, &gen, chunk_size));
+        }
+        int64_t elapsed = esp_timer_get_time() - start;
+        XML_ParserFree(parser);
+
+        TEST_ASSERT_EQUAL(items, count);
+        printf("%s: %u bytes in %lld us, %lld KB/s\n", copy ? "XML_Parse" : "expat_stream_parse",
+               (unsigned) gen.bytes, elapsed, (int64_t) gen.bytes * 1000000 / 1024 / MAX(elapsed, 1));
+    }
+}
+
+#if CONFIG_EXPAT_ARENA_ALLOCATOR
+TEST_CASE("Expat parses XML with arena allocator", "[expat]")
+{
+    const char test_in[] = "<html><title>Page title</title><body><h>header</h><ol><li>A</li>"\
+                           "<li>B</li><li>C</li></ol></body></html>";
+    expat_arena_config_t config = EXPAT_ARENA_DEFAULT_CONFIG();
+    config.chunk_size = 1024; // Make the parser use several chunks
+    expat_arena_handle_t arena = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, expat_arena_create(&config, &arena));
+
+    XML_Parser parser = expat_arena_parser_create(arena, NULL);
+    TEST_ASSERT_NOT_NULL(parser);
+    TEST_ASSERT_NULL(expat_arena_parser_create(arena, NULL)); // one parser per arena
+    const size_t used_after_create = expat_arena_get_used(arena);
+    TEST_ASSERT_NOT_EQUAL(0, used_after_create);
+
+    char first_output[512];
+    for (int i = 0; i < 2; i++) {
+        user_data_t user_data = {
+            .depth = 0,
+            .output = { '\0' },
+            .output_off = 0
+        };
+        XML_SetUserData(parser, &user_data);
+        XML_SetElementHandler(parser, start_element, end_element);
+        XML_SetCharacterDataHandler(parser, data_handler);
+
+        TEST_ASSERT_NOT_EQUAL(XML_STATUS_ERROR, expat_arena_parse(arena, test_in, strlen(test_in), 1));
+        TEST_ASSERT_EQUAL(0, user_data.depth);
+        if (i == 0) {
+            strlcpy(first_output, user_data.output, sizeof(first_output));
+        } else {
+            TEST_ASSERT_EQUAL_STRING(first_output, user_data.output);
+        }
+
+        // The arena is rewound and the new parser takes the same memory
+        parser = expat_arena_parser_reset(arena, NULL);
+        TEST_ASSERT_NOT_NULL(parser);
+        TEST_ASSERT_EQUAL(used_after_create, expat_arena_get_used(arena));
+    }
+
+    expat_arena_delete(arena);
+}
+#endif
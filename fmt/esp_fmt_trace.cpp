@@ -0,0 +1,104 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+
+#if CONFIG_FMT_TRACE_ENABLE
+
+#include <atomic>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "esp_fmt_trace.hpp"
+
+namespace esp_fmt {
+
+namespace {
+
+constexpr size_t RING_WORDS = CONFIG_FMT_TRACE_BUFFER_SIZE / sizeof(uint32_t);
+static_assert((RING_WORDS & (RING_WORDS - 1)) == 0, "CONFIG_FMT_TRACE_BUFFER_SIZE must be a power of 2");
+
+/* Record header: descriptor address, timestamp in us, then payload size | core << 16 | dropped << 24 */
+constexpr size_t HEADER_WORDS = 3;
+
+/* Written by its core with interrupts masked, read by one task, so no lock is needed between the cores */
+struct ring_t {
+    uint32_t buf[RING_WORDS];
+    std::atomic<uint32_t> head;     ///< Total words written, published after the record
+    std::atomic<uint32_t> tail;     ///< Total words read
+    uint32_t dropped;               ///< Records dropped since the last written one
+};
+
+ring_t s_rings[portNUM_PROCESSORS];
+std::atomic<uint32_t> s_dropped;
+
+} // namespace
+
+namespace detail {
+
+void trace_write(const trace_desc_t *desc, const uint32_t *payload, size_t size)
+{
+    const size_t words = HEADER_WORDS + size / sizeof(uint32_t);
+    UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    const int core = xPortGetCoreID();
+    ring_t &ring = s_rings[core];
+
+    uint32_t head = ring.head.load(std::memory_order_relaxed);
+    if (RING_WORDS - (head - ring.tail.load(std::memory_order_acquire)) < words) {
+        if (ring.dropped < UINT8_MAX) {
+            ring.dropped++;
+        }
+        s_dropped.fetch_add(1, std::memory_order_relaxed);
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+        return;
+    }
+
+    ring.buf[head++ % RING_WORDS] = reinterpret_cast<uintptr_t>(desc);
+    ring.buf[head++ % RING_WORDS] = static_cast<uint32_t>(esp_timer_get_time());
+    ring.buf[head++ % RING_WORDS] = size | (core << 16) | (ring.dropped << 24);
+    for (size_t i = 0; i < size / sizeof(uint32_t); i++) {
+        ring.buf[head++ % RING_WORDS] = payload[i];
+    }
+    ring.dropped = 0;
+    ring.head.store(head, std::memory_order_release);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+}
+
+} // namespace detail
+
+size_t trace_read(int core, void *buf, size_t size)
+{
+    if (core < 0 || core >= portNUM_PROCESSORS) {
+        return 0;
+    }
+    ring_t &ring = s_rings[core];
+    uint32_t *out = static_cast<uint32_t *>(buf);
+    const size_t max_words = size / sizeof(uint32_t);
+    size_t copied = 0;
+
+    uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+    const uint32_t head = ring.head.load(std::memory_order_acquire);
+    while (tail != head) {
+        const size_t words = HEADER_WORDS + (ring.buf[(tail + 2) % RING_WORDS] & 0xffff) / sizeof(uint32_t);
+        if (copied + words > max_words) {
+            break;
+        }
+        for (size_t i = 0; i < words; i++) {
+            out[copied++] = ring.buf[tail++ % RING_WORDS];
+        }
+    }
+    // Give the space back to the writer once the records are copied
+    ring.tail.store(tail, std::memory_order_release);
+    return copied * sizeof(uint32_t);
+}
+
+uint32_t trace_dropped()
+{
+    return s_dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace esp_fmt
+
+#endif // CONFIG_FMT_TRACE_ENABLE
@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include "sdkconfig.h"
+#include "esp_idf_version.h"
+#include "esp_log.h"
+#include <fmt/compile.h>
+
+/**
+ * @file esp_fmt_log.hpp
+ * @brief ESP log macros formatting with {fmt}
+ *
+ * The format string is compiled with FMT_COMPILE, the line is formatted into a stack buffer
+ * of CONFIG_FMT_LOG_BUFFER_SIZE bytes with fmt::format_to_n, then written at once, without printf:
+ *
+ * @code{cpp}
+ * ESP_FMT_LOGI(TAG, "received {} bytes from {:#x}", len, addr);
+ * @endcode
+ *
+ * The lines have the same prefix as ESP_LOGx, and the same log levels apply. Longer lines are truncated.
+ */
+
+/** @cond */
+#define ESP_FMT_LOG_LEVEL_LOCAL(level, tag, format, ...) do {                                   \
+        if (LOG_LOCAL_LEVEL >= level) {                                                         \
+            esp_fmt::log(level, tag, FMT_COMPILE(format), ##__VA_ARGS__);                       \
+        }                                                                                       \
+    } while (0)
+/** @endcond */
+
+#define ESP_FMT_LOGE(tag, format, ...) ESP_FMT_LOG_LEVEL_LOCAL(ESP_LOG_ERROR, tag, format, ##__VA_ARGS__)
+#define ESP_FMT_LOGW(tag, format, ...) ESP_FMT_LOG_LEVEL_LOCAL(ESP_LOG_WARN, tag, format, ##__VA_ARGS__)
+#define ESP_FMT_LOGI(tag, format, ...) ESP_FMT_LOG_LEVEL_LOCAL(ESP_LOG_INFO, tag, format, ##__VA_ARGS__)
+#define ESP_FMT_LOGD(tag, format, ...) ESP_FMT_LOG_LEVEL_LOCAL(ESP_LOG_DEBUG, tag, format, ##__VA_ARGS__)
+#define ESP_FMT_LOGV(tag, format, ...) ESP_FMT_LOG_LEVEL_LOCAL(ESP_LOG_VERBOSE, tag, format, ##__VA_ARGS__)
+
+namespace esp_fmt {
+
+namespace detail {
+
+constexpr char level_letter(esp_log_level_t level)
+{
+    return level == ESP_LOG_ERROR ? 'E' : level == ESP_LOG_WARN ? 'W' : level == ESP_LOG_INFO ? 'I' :
+           level == ESP_LOG_DEBUG ? 'D' : 'V';
+}
+
+constexpr const char *level_color(esp_log_level_t level)
+{
+    return level == ESP_LOG_ERROR ? LOG_COLOR_E : level == ESP_LOG_WARN ? LOG_COLOR_W : level == ESP_LOG_INFO ? LOG_COLOR_I :
+           level == ESP_LOG_DEBUG ? LOG_COLOR_D : LOG_COLOR_V;
+}
+
+/* Checked before formatting, so that disabled lines cost no formatting */
+inline bool enabled(esp_log_level_t level, const char *tag)
+{
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    return esp_log_level_get(tag) >= level;
+#else
+    return true;
+#endif
+}
+
+inline char *prefix(char *out, size_t size, esp_log_level_t level, const char *tag)
+{
+#if CONFIG_LOG_TIMESTAMP_SOURCE_SYSTEM
+    const char *timestamp = esp_log_system_timestamp();
+#else
+    uint32_t timestamp = esp_log_timestamp();
+#endif
+    return fmt::format_to_n(out, size, FMT_COMPILE("{}{} ({}) {}: "), level_color(level), level_letter(level),
+                            timestamp, tag).out;
+}
+
+inline void write(esp_log_level_t level, const char *tag, const char *line, size_t len)
+{
+#if CONFIG_FMT_LOG_OUTPUT_STDOUT
+    (void)level;
+    (void)tag;
+    fwrite(line, 1, len, stdout);
+#else
+    esp_log_write(level, tag, "%.*s", static_cast<int>(len), line);
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief Format and write a log line, used by the ESP_FMT_LOGx macros
+ *
+ * @param level Log level of the line
+ * @param tag Tag of the line
+ * @param format Format string, compiled with FMT_COMPILE by the macros
+ * @param args Arguments of the format string
+ */
+template <typename S, typename... Args>
+void log(esp_log_level_t level, const char *tag, const S &format, const Args &... args)
+{
+    if (!detail::enabled(level, tag)) {
+        return;
+    }
+
+    static constexpr char suffix[] = LOG_RESET_COLOR "\n";
+    char line[CONFIG_FMT_LOG_BUFFER_SIZE];
+    char *const limit = line + sizeof(line) - (sizeof(suffix) - 1);
+    char *out = detail::prefix(line, limit - line, level, tag);
+    out = fmt::format_to_n(out, limit - out, format, args...).out;
+    memcpy(out, suffix, sizeof(suffix) - 1);
+    out += sizeof(suffix) - 1;
+    detail::write(level, tag, line, out - line);
+}
+
+} // namespace esp_fmt
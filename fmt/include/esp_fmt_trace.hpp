@@ -0,0 +1,194 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "sdkconfig.h"
+#include <fmt/format.h>
+
+/**
+ * @file esp_fmt_trace.hpp
+ * @brief Deferred logging: the messages are formatted on the host
+ *
+ * ESP_FMT_TRACE stores the address of a descriptor of the call site and the raw values of the arguments
+ * in a ring buffer of the current core. The descriptor, placed in the .rodata.esp_fmt_trace section,
+ * holds the format string and the types of the arguments, so the messages are formatted from the ELF file
+ * by tools/esp_fmt_trace_decode.py:
+ *
+ * @code{cpp}
+ * ESP_FMT_TRACE("rx {} bytes, rssi {}", len, rssi);
+ * ...
+ * size_t len = esp_fmt::trace_read(core, buf, sizeof(buf));   // e.g. in a low priority task
+ * fwrite(buf, 1, len, trace_file);
+ * @endcode
+ *
+ * The format string is checked against the arguments at compile time. The arguments can be integers,
+ * bool, char, float, double, pointers and C strings, which are copied, up to CONFIG_FMT_TRACE_MAX_RECORD_SIZE
+ * bytes per record. Records which do not fit in the ring buffer are dropped, and their number is reported
+ * in the next record of the core.
+ *
+ * Available with CONFIG_FMT_TRACE_ENABLE, otherwise ESP_FMT_TRACE does nothing and its arguments
+ * are not evaluated.
+ */
+
+#if CONFIG_FMT_TRACE_ENABLE
+#define ESP_FMT_TRACE(format, ...) do {                                                         \
+        struct esp_fmt_trace_site {                                                             \
+            static constexpr const char *str() { return format; }                               \
+        };                                                                                      \
+        esp_fmt::detail::trace<esp_fmt_trace_site>(format, ##__VA_ARGS__);                      \
+    } while (0)
+#else
+#define ESP_FMT_TRACE(format, ...) do { } while (0)
+#endif
+
+namespace esp_fmt {
+
+/**
+ * @brief Copy the whole records of the ring buffer of a core, and free their space
+ *
+ * Records are written to the buffer of the core calling ESP_FMT_TRACE. Only one task should read
+ * the records of a core. The data read from all cores can be concatenated into one file for the decoder.
+ *
+ * @param core Core whose records are read
+ * @param buf Destination buffer
+ * @param size Size of the destination buffer, at least CONFIG_FMT_TRACE_MAX_RECORD_SIZE + 12 bytes
+ *             to be sure that a record fits
+ * @return Number of bytes copied, 0 if there is no record or the core is invalid
+ */
+size_t trace_read(int core, void *buf, size_t size);
+
+/**
+ * @brief Total number of records dropped because a ring buffer was full
+ */
+uint32_t trace_dropped();
+
+namespace detail {
+
+/* Read by the decoder from the ELF file, the layout must not change */
+struct trace_desc_t {
+    const char *format;
+    const char *types;
+};
+
+void trace_write(const trace_desc_t *desc, const uint32_t *payload, size_t size);
+
+class trace_packer {
+public:
+    trace_packer(uint32_t *buf, size_t words) : pos(buf), end(buf + words) {}
+
+    void word(uint32_t value)
+    {
+        if (pos < end) {
+            *pos++ = value;
+        }
+    }
+
+    /* Length, then the characters padded to a word, truncated to the space left */
+    void string(const char *s)
+    {
+        if (pos >= end) {
+            return;
+        }
+        size_t max = (end - pos - 1) * sizeof(uint32_t);
+        size_t len = s ? strnlen(s, max) : 0;
+        *pos++ = len;
+        memcpy(pos, s, len);
+        pos += (len + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    }
+
+    uint32_t *pos;
+    uint32_t *const end;
+};
+
+/* Type code in the descriptor and encoding of each type of argument */
+template <typename T, typename = void> struct trace_arg {
+    static_assert(sizeof(T) == 0, "type not supported by ESP_FMT_TRACE");
+};
+
+template <typename T>
+struct trace_arg<T, typename std::enable_if<std::is_integral<T>::value && sizeof(T) <= 4>::type> {
+    static constexpr char code = std::is_same<T, bool>::value ? 'b' : std::is_same<T, char>::value ? 'c' :
+                                 std::is_signed<T>::value ? 'i' : 'u';
+    static void pack(trace_packer &p, T value)
+    {
+        p.word(static_cast<uint32_t>(value));
+    }
+};
+
+template <typename T>
+struct trace_arg<T, typename std::enable_if<std::is_integral<T>::value && sizeof(T) == 8>::type> {
+    static constexpr char code = std::is_signed<T>::value ? 'I' : 'U';
+    static void pack(trace_packer &p, T value)
+    {
+        p.word(static_cast<uint32_t>(value));
+        p.word(static_cast<uint32_t>(static_cast<uint64_t>(value) >> 32));
+    }
+};
+
+template <> struct trace_arg<float> {
+    static constexpr char code = 'f';
+    static void pack(trace_packer &p, float value)
+    {
+        uint32_t word;
+        memcpy(&word, &value, sizeof(word));
+        p.word(word);
+    }
+};
+
+template <> struct trace_arg<double> {
+    static constexpr char code = 'd';
+    static void pack(trace_packer &p, double value)
+    {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        trace_arg<uint64_t>::pack(p, bits);
+    }
+};
+
+template <typename T>
+struct trace_arg<T *, typename std::enable_if<std::is_same<typename std::remove_cv<T>::type, char>::value>::type> {
+    static constexpr char code = 's';
+    static void pack(trace_packer &p, const char *value)
+    {
+        p.string(value);
+    }
+};
+
+template <typename T>
+struct trace_arg<T *, typename std::enable_if<!std::is_same<typename std::remove_cv<T>::type, char>::value>::type> {
+    static constexpr char code = 'p';
+    static void pack(trace_packer &p, const T *value)
+    {
+        p.word(reinterpret_cast<uintptr_t>(value));
+    }
+};
+
+template <typename... T> struct trace_signature {
+    static constexpr char value[sizeof...(T) + 1] = {trace_arg<typename std::decay<T>::type>::code..., '\0'};
+};
+
+template <typename Site, typename... T>
+void trace(fmt::format_string<T...> format, const T &... args)
+{
+    (void)format;
+    __attribute__((section(".rodata.esp_fmt_trace")))
+    static const trace_desc_t desc = {Site::str(), trace_signature<T...>::value};
+
+    uint32_t payload[CONFIG_FMT_TRACE_MAX_RECORD_SIZE / sizeof(uint32_t)];
+    trace_packer packer(payload, sizeof(payload) / sizeof(payload[0]));
+    using expand = int[];
+    (void)expand{0, (trace_arg<typename std::decay<T>::type>::pack(packer, args), 0)...};
+    trace_write(&desc, payload, (packer.pos - payload) * sizeof(uint32_t));
+}
+
+} // namespace detail
+
+} // namespace esp_fmt
@@ -0,0 +1,157 @@
+#!/usr/bin/env python
+#
+# Decoder of the records written by ESP_FMT_TRACE. The format strings and the types of the arguments
+# are read from the ELF file of the application.
+#
+# SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+
+import argparse
+import struct
+import sys
+
+from elftools.elf.constants import SH_FLAGS
+from elftools.elf.elffile import ELFFile
+
+# Descriptor address, timestamp in us, payload size | core << 16 | dropped << 24
+HEADER = struct.Struct('<III')
+
+# Type code of the descriptor: struct format of the value
+SCALARS = {
+    'i': '<i', 'u': '<I', 'b': '<I', 'c': '<I', 'p': '<I',
+    'I': '<q', 'U': '<Q', 'f': '<f', 'd': '<d',
+}
+
+
+class Bool:
+    def __init__(self, value: int) -> None:
+        self.value = value
+
+    def __format__(self, spec: str) -> str:
+        if spec in ('', 's'):
+            return 'true' if self.value else 'false'
+        return format(self.value, spec)
+
+
+class Char:
+    def __init__(self, value: int) -> None:
+        self.value = value & 0xff
+
+    def __format__(self, spec: str) -> str:
+        if spec == '' or spec[-1:] not in 'bBdoxX':
+            return format(chr(self.value), spec)
+        return format(self.value, spec)
+
+
+class Pointer:
+    def __init__(self, value: int) -> None:
+        self.value = value
+
+    def __format__(self, spec: str) -> str:
+        return format(hex(self.value), spec.rstrip('p'))
+
+
+class Elf:
+    def __init__(self, path: str) -> None:
+        with open(path, 'rb') as f:
+            elf = ELFFile(f)
+            self.pointer = '<I' if elf.elfclass == 32 else '<Q'
+            self.sections = [(s['sh_addr'], s.data()) for s in elf.iter_sections()
+                             if s['sh_flags'] & SH_FLAGS.SHF_ALLOC and s['sh_type'] != 'SHT_NOBITS']
+
+    def _find(self, addr: int) -> tuple:
+        for start, data in self.sections:
+            if start <= addr < start + len(data):
+                return data, addr - start
+        raise KeyError('address 0x{:x} not found in the ELF file'.format(addr))
+
+    def read_pointer(self, addr: int) -> int:
+        data, offset = self._find(addr)
+        return struct.unpack_from(self.pointer, data, offset)[0]
+
+    def read_string(self, addr: int) -> str:
+        data, offset = self._find(addr)
+        return data[offset:data.index(b'\0', offset)].decode(errors='replace')
+
+
+def decode_args(types: str, payload: bytes) -> list:
+    args = []
+    offset = 0
+    for code in types:
+        if code == 's':
+            length = struct.unpack_from('<I', payload, offset)[0]
+            offset += 4
+            args.append(payload[offset:offset + length].decode(errors='replace'))
+            offset += (length + 3) & ~3
+            continue
+        fmt = SCALARS[code]
+        value = struct.unpack_from(fmt, payload, offset)[0]
+        offset += struct.calcsize(fmt)
+        if code == 'b':
+            value = Bool(value)
+        elif code == 'c':
+            value = Char(value)
+        elif code == 'p':
+            value = Pointer(value)
+        args.append(value)
+    return args
+
+
+def decode(elf: Elf, data: bytes) -> list:
+    descriptors = {}
+    last_timestamp = {}
+    records = []
+    offset = 0
+    while offset + HEADER.size <= len(data):
+        desc, timestamp, info = HEADER.unpack_from(data, offset)
+        size, core, dropped = info & 0xffff, (info >> 16) & 0xff, info >> 24
+        payload = data[offset + HEADER.size:offset + HEADER.size + size]
+        if len(payload) < size:
+            break
+        offset += HEADER.size + size
+
+        # The timestamps are 32 bits, they wrap after 71 minutes
+        high, last = last_timestamp.get(core, (0, 0))
+        if timestamp < last:
+            high += 1 << 32
+        last_timestamp[core] = (high, timestamp)
+        timestamp += high
+
+        if desc not in descriptors:
+            descriptors[desc] = (elf.read_string(elf.read_pointer(desc)),
+                                 elf.read_string(elf.read_pointer(desc + struct.calcsize(elf.pointer))))
+        format_str, types = descriptors[desc]
+        try:
+            args = decode_args(types, payload)
+            message = format_str.format(*args)
+        except (struct.error, ValueError, IndexError, KeyError) as e:
+            message = '{} (cannot format: {})'.format(format_str, e)
+        if dropped:
+            records.append((timestamp, core, '{}{} records dropped'.format(dropped, '+' if dropped == 0xff else '')))
+        records.append((timestamp, core, message))
+
+    if offset != len(data):
+        print('warning: {} bytes of incomplete record ignored'.format(len(data) - offset), file=sys.stderr)
+    # Records of the cores are merged by time
+    records.sort(key=lambda r: r[0])
+    return records
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description='Decode the records of ESP_FMT_TRACE')
+    parser.add_argument('elf', help='ELF file of the application')
+    parser.add_argument('input', help='Records read by esp_fmt::trace_read(), - for stdin')
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    if args.input == '-':
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.input, 'rb') as f:
+            data = f.read()
+    for timestamp, core, message in decode(elf, data):
+        print('[{:.6f}] {}: {}'.format(timestamp / 1e6, core, message))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,206 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_partition.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Cache of rendered glyphs, on top of a pool of FreeType faces.
+ *
+ * Faces are registered once, from a file, a partition or a memory buffer, and
+ * are opened by the FreeType cache manager (FTC_Manager), which keeps up to
+ * `max_faces` of them and `max_sizes` of their sizes open. Glyphs are rendered to 8-bit alpha bitmaps
+ * and kept in a least recently used cache, keyed by face, pixel size and glyph
+ * index, in memory with the `glyph_caps` capabilities. Rendering a string which
+ * was already drawn then only copies the bitmaps.
+ *
+ * A cache is not thread safe, it should be used from a single task or protected
+ * by the application.
+ */
+
+/**
+ * @brief Handle of a glyph cache
+ */
+typedef struct esp_ft_cache *esp_ft_cache_handle_t;
+
+/**
+ * @brief Glyph cache configuration
+ */
+typedef struct {
+    unsigned int max_faces;     /*!< Maximum number of faces kept open, 0 for FreeType's default (2) */
+    unsigned int max_sizes;     /*!< Maximum number of face sizes kept open, 0 for FreeType's default (4) */
+    size_t glyph_budget;        /*!< Maximum number of bytes used by the cached glyphs, including their headers */
+    uint32_t glyph_caps;        /*!< Heap capabilities of the glyph memory. Internal memory is used if there is no memory with these capabilities. */
+} esp_ft_cache_config_t;
+
+/** Default glyph cache configuration: 64 kB of glyphs in PSRAM */
+#define ESP_FT_CACHE_DEFAULT_CONFIG() { \
+    .max_faces = 2,                     \
+    .max_sizes = 4,                     \
+    .glyph_budget = 64 * 1024,          \
+    .glyph_caps = MALLOC_CAP_SPIRAM,    \
+}
+
+/**
+ * @brief Rendered glyph
+ *
+ * The bitmap is `width * rows` bytes of 8-bit alpha, with `width` bytes per row.
+ * The glyph is owned by the cache. It is valid until the next call to
+ * esp_ft_cache_get_glyph() or esp_ft_cache_clear() on the same cache.
+ */
+typedef struct {
+    uint32_t glyph_index;   /*!< Index of the glyph in the face */
+    int16_t left;           /*!< Horizontal distance from the pen position to the left of the bitmap, in pixels */
+    int16_t top;            /*!< Vertical distance from the baseline to the top of the bitmap, in pixels (up is positive) */
+    uint16_t width;         /*!< Width of the bitmap, in pixels */
+    uint16_t rows;          /*!< Height of the bitmap, in pixels */
+    int16_t advance_x;      /*!< Horizontal advance of the pen, in pixels */
+    int16_t advance_y;      /*!< Vertical advance of the pen, in pixels */
+    const uint8_t *bitmap;  /*!< Alpha values of the pixels */
+} esp_ft_glyph_t;
+
+/**
+ * @brief Glyph cache statistics
+ */
+typedef struct {
+    uint32_t hits;          /*!< Number of glyphs found in the cache */
+    uint32_t misses;        /*!< Number of glyphs which had to be rendered */
+    uint32_t evictions;     /*!< Number of glyphs removed to stay within the budget */
+    uint32_t glyphs;        /*!< Number of glyphs in the cache */
+    size_t bytes;           /*!< Number of bytes used by the glyphs in the cache */
+} esp_ft_cache_stats_t;
+
+/**
+ * @brief Create a glyph cache
+ *
+ * A FreeType library instance is created for the cache.
+ *
+ * @param[in]  config  Cache configuration
+ * @param[out] ret_cache  Handle of the created cache
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_NO_MEM: Out of memory
+ *      - ESP_FAIL: FreeType could not be initialized
+ */
+esp_err_t esp_ft_cache_new(const esp_ft_cache_config_t *config, esp_ft_cache_handle_t *ret_cache);
+
+/**
+ * @brief Delete a glyph cache, its faces and its FreeType library instance
+ *
+ * @param[in] cache  Handle of the cache
+ */
+void esp_ft_cache_delete(esp_ft_cache_handle_t cache);
+
+/**
+ * @brief Add a face from a font in memory
+ *
+ * The face is opened right away, to check the font, and stays in the face pool
+ * until other faces push it out.
+ *
+ * @param[in]  cache  Handle of the cache
+ * @param[in]  data  Font file data, must stay valid until the cache is deleted
+ * @param[in]  size  Size of the font file data
+ * @param[in]  face_index  Index of the face in the font file, usually 0
+ * @param[out] ret_face_id  Identifier of the face, used with esp_ft_cache_get_glyph()
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_NO_MEM: Out of memory
+ *      - ESP_FAIL: The font could not be opened by FreeType
+ */
+esp_err_t esp_ft_cache_add_face_from_memory(esp_ft_cache_handle_t cache, const void *data, size_t size,
+                                            long face_index, int *ret_face_id);
+
+/**
+ * @brief Add a face from a font file
+ *
+ * Same as esp_ft_cache_add_face_from_memory(), except that the font is read from
+ * the file system each time FreeType opens the face again.
+ *
+ * @param[in]  cache  Handle of the cache
+ * @param[in]  path  Path of the font file, copied
+ * @param[in]  face_index  Index of the face in the font file, usually 0
+ * @param[out] ret_face_id  Identifier of the face, used with esp_ft_cache_get_glyph()
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_NO_MEM: Out of memory
+ *      - ESP_FAIL: The font could not be opened by FreeType
+ */
+esp_err_t esp_ft_cache_add_face_from_file(esp_ft_cache_handle_t cache, const char *path,
+                                          long face_index, int *ret_face_id);
+
+/**
+ * @brief Add a face from a font stored in a partition
+ *
+ * Same as esp_ft_cache_add_face_from_memory(), except that the font is read in
+ * place from flash, see esp_ft_new_partition_face().
+ *
+ * @param[in]  cache  Handle of the cache
+ * @param[in]  partition  Partition containing the font
+ * @param[in]  offset  Offset of the font file in the partition
+ * @param[in]  size  Size of the font file, or 0 for the rest of the partition
+ * @param[in]  face_index  Index of the face in the font file, usually 0
+ * @param[out] ret_face_id  Identifier of the face, used with esp_ft_cache_get_glyph()
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_NO_MEM: Out of memory
+ *      - ESP_FAIL: The font could not be opened by FreeType
+ */
+esp_err_t esp_ft_cache_add_face_from_partition(esp_ft_cache_handle_t cache, const esp_partition_t *partition,
+        size_t offset, size_t size, long face_index, int *ret_face_id);
+
+/**
+ * @brief Get the rendered glyph of a character
+ *
+ * The glyph is taken from the cache, or rendered and added to the cache, after
+ * removing the least recently used glyphs if the budget would be exceeded.
+ *
+ * @param[in]  cache  Handle of the cache
+ * @param[in]  face_id  Identifier of the face
+ * @param[in]  pixel_size  Height of the characters, in pixels
+ * @param[in]  charcode  Unicode code point of the character
+ * @param[out] glyph  Rendered glyph
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument or unknown face
+ *      - ESP_ERR_NO_MEM: Out of memory, or the glyph alone is larger than the budget
+ *      - ESP_FAIL: FreeType could not render the glyph
+ */
+esp_err_t esp_ft_cache_get_glyph(esp_ft_cache_handle_t cache, int face_id, uint16_t pixel_size,
+                                 uint32_t charcode, esp_ft_glyph_t *glyph);
+
+/**
+ * @brief Remove all the glyphs from the cache
+ *
+ * The faces stay registered and the statistics are not reset.
+ *
+ * @param[in] cache  Handle of the cache
+ */
+void esp_ft_cache_clear(esp_ft_cache_handle_t cache);
+
+/**
+ * @brief Get the statistics of the cache
+ *
+ * @param[in]  cache  Handle of the cache
+ * @param[out] stats  Statistics
+ */
+void esp_ft_cache_get_stats(esp_ft_cache_handle_t cache, esp_ft_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_partition.h"
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Open a FreeType face from a font stored in a partition
+ *
+ * The font is mapped with esp_partition_mmap() and read by FreeType in place, so
+ * it does not have to be copied to RAM. If the whole font cannot be mapped, it is
+ * read through mapped windows of CONFIG_FREETYPE_PARTITION_WINDOW_SIZE instead,
+ * and with esp_partition_read() if no window can be mapped either.
+ *
+ * The mapping is released by FT_Done_Face().
+ *
+ * @param[in]  library  FreeType library instance
+ * @param[in]  partition  Partition containing the font
+ * @param[in]  offset  Offset of the font file in the partition
+ * @param[in]  size  Size of the font file, or 0 for the rest of the partition
+ * @param[in]  face_index  Index of the face in the font file, usually 0
+ * @param[out] ret_face  Opened face
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument, or the font is outside of the partition
+ *      - ESP_ERR_NO_MEM: Out of memory
+ *      - ESP_FAIL: The font could not be opened by FreeType
+ */
+esp_err_t esp_ft_new_partition_face(FT_Library library, const esp_partition_t *partition, size_t offset, size_t size,
+                                    long face_index, FT_Face *ret_face);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,339 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_ft_cache.h"
+#include "esp_ft_partition.h"
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_CACHE_H
+
+static const char *TAG = "esp_ft_cache";
+
+#define ESP_FT_CACHE_BUCKETS    64
+
+typedef struct {
+    char *path;             /* Font file, or NULL */
+    const esp_partition_t *partition;   /* Partition of the font, or NULL */
+    size_t offset;          /* Offset of the font in the partition */
+    const void *data;       /* Font in memory, if there is neither a path nor a partition */
+    size_t size;
+    long face_index;
+} esp_ft_face_t;
+
+typedef struct esp_ft_entry {
+    struct esp_ft_entry *hash_next;
+    struct esp_ft_entry *lru_prev;  /* More recently used */
+    struct esp_ft_entry *lru_next;  /* Less recently used */
+    size_t bytes;
+    int face_id;
+    uint16_t pixel_size;
+    esp_ft_glyph_t glyph;
+    uint8_t bitmap[];
+} esp_ft_entry_t;
+
+struct esp_ft_cache {
+    FT_Library library;
+    FTC_Manager manager;
+    FTC_CMapCache cmap_cache;
+    esp_ft_face_t **faces;
+    int num_faces;
+    size_t glyph_budget;
+    uint32_t glyph_caps;
+    esp_ft_entry_t *buckets[ESP_FT_CACHE_BUCKETS];
+    esp_ft_entry_t *lru_head;       /* Most recently used */
+    esp_ft_entry_t *lru_tail;       /* Least recently used */
+    esp_ft_cache_stats_t stats;
+};
+
+static FT_Error face_requester(FTC_FaceID face_id, FT_Library library, FT_Pointer req_data, FT_Face *aface)
+{
+    const esp_ft_face_t *face = face_id;
+
+    if (face->path) {
+        return FT_New_Face(library, face->path, face->face_index, aface);
+    }
+    if (face->partition) {
+        esp_err_t err = esp_ft_new_partition_face(library, face->partition, face->offset, face->size,
+                        face->face_index, aface);
+        return err == ESP_OK ? 0 : err == ESP_ERR_NO_MEM ? FT_Err_Out_Of_Memory : FT_Err_Cannot_Open_Resource;
+    }
+    return FT_New_Memory_Face(library, face->data, face->size, face->face_index, aface);
+}
+
+esp_err_t esp_ft_cache_new(const esp_ft_cache_config_t *config, esp_ft_cache_handle_t *ret_cache)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_cache, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    struct esp_ft_cache *cache = calloc(1, sizeof(struct esp_ft_cache));
+    ESP_RETURN_ON_FALSE(cache, ESP_ERR_NO_MEM, TAG, "no memory for cache");
+    cache->glyph_budget = config->glyph_budget;
+    cache->glyph_caps = config->glyph_caps;
+
+    ESP_GOTO_ON_FALSE(FT_Init_FreeType(&cache->library) == 0, ESP_FAIL, err, TAG, "FT_Init_FreeType failed");
+    ESP_GOTO_ON_FALSE(FTC_Manager_New(cache->library, config->max_faces, config->max_sizes, 0,
+                                      face_requester, cache, &cache->manager) == 0,
+                      ESP_ERR_NO_MEM, err, TAG, "FTC_Manager_New failed");
+    ESP_GOTO_ON_FALSE(FTC_CMapCache_New(cache->manager, &cache->cmap_cache) == 0,
+                      ESP_ERR_NO_MEM, err, TAG, "FTC_CMapCache_New failed");
+
+    *ret_cache = cache;
+    return ESP_OK;
+
+err:
+    esp_ft_cache_delete(cache);
+    return ret;
+}
+
+void esp_ft_cache_delete(esp_ft_cache_handle_t cache)
+{
+    if (cache == NULL) {
+        return;
+    }
+    esp_ft_cache_clear(cache);
+    if (cache->manager) {
+        FTC_Manager_Done(cache->manager);
+    }
+    if (cache->library) {
+        FT_Done_FreeType(cache->library);
+    }
+    for (int i = 0; i < cache->num_faces; i++) {
+        free(cache->faces[i]->path);
+        free(cache->faces[i]);
+    }
+    free(cache->faces);
+    free(cache);
+}
+
+static esp_err_t add_face(esp_ft_cache_handle_t cache, esp_ft_face_t *face, int *ret_face_id)
+{
+    esp_ft_face_t **faces = realloc(cache->faces, (cache->num_faces + 1) * sizeof(esp_ft_face_t *));
+    if (faces == NULL) {
+        free(face->path);
+        free(face);
+        ESP_LOGE(TAG, "no memory for face");
+        return ESP_ERR_NO_MEM;
+    }
+    cache->faces = faces;
+
+    /* Open the face now, so that an invalid font is reported here */
+    FT_Face ft_face;
+    FT_Error error = FTC_Manager_LookupFace(cache->manager, face, &ft_face);
+    if (error) {
+        FTC_Manager_RemoveFaceID(cache->manager, face);
+        free(face->path);
+        free(face);
+        ESP_LOGE(TAG, "failed to open face (FreeType error 0x%x)", error);
+        return ESP_FAIL;
+    }
+
+    faces[cache->num_faces] = face;
+    *ret_face_id = cache->num_faces++;
+    return ESP_OK;
+}
+
+esp_err_t esp_ft_cache_add_face_from_memory(esp_ft_cache_handle_t cache, const void *data, size_t size,
+                                            long face_index, int *ret_face_id)
+{
+    ESP_RETURN_ON_FALSE(cache && data && size && ret_face_id, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_ft_face_t *face = calloc(1, sizeof(esp_ft_face_t));
+    ESP_RETURN_ON_FALSE(face, ESP_ERR_NO_MEM, TAG, "no memory for face");
+    face->data = data;
+    face->size = size;
+    face->face_index = face_index;
+    return add_face(cache, face, ret_face_id);
+}
+
+esp_err_t esp_ft_cache_add_face_from_file(esp_ft_cache_handle_t cache, const char *path,
+                                          long face_index, int *ret_face_id)
+{
+    ESP_RETURN_ON_FALSE(cache && path && ret_face_id, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_ft_face_t *face = calloc(1, sizeof(esp_ft_face_t));
+    ESP_RETURN_ON_FALSE(face, ESP_ERR_NO_MEM, TAG, "no memory for face");
+    face->path = strdup(path);
+    if (face->path == NULL) {
+        free(face);
+        ESP_LOGE(TAG, "no memory for face");
+        return ESP_ERR_NO_MEM;
+    }
+    face->face_index = face_index;
+    return add_face(cache, face, ret_face_id);
+}
+
+esp_err_t esp_ft_cache_add_face_from_partition(esp_ft_cache_handle_t cache, const esp_partition_t *partition,
+        size_t offset, size_t size, long face_index, int *ret_face_id)
+{
+    ESP_RETURN_ON_FALSE(cache && partition && ret_face_id, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_ft_face_t *face = calloc(1, sizeof(esp_ft_face_t));
+    ESP_RETURN_ON_FALSE(face, ESP_ERR_NO_MEM, TAG, "no memory for face");
+    face->partition = partition;
+    face->offset = offset;
+    face->size = size;
+    face->face_index = face_index;
+    return add_face(cache, face, ret_face_id);
+}
+
+static inline unsigned int entry_hash(int face_id, uint16_t pixel_size, uint32_t glyph_index)
+{
+    uint32_t h = glyph_index * 2654435761U ^ ((uint32_t)pixel_size << 16) ^ (uint32_t)face_id;
+    return (h ^ (h >> 15)) % ESP_FT_CACHE_BUCKETS;
+}
+
+static void lru_unlink(esp_ft_cache_handle_t cache, esp_ft_entry_t *entry)
+{
+    if (entry->lru_prev) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        cache->lru_head = entry->lru_next;
+    }
+    if (entry->lru_next) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        cache->lru_tail = entry->lru_prev;
+    }
+}
+
+static void lru_push_head(esp_ft_cache_handle_t cache, esp_ft_entry_t *entry)
+{
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_head;
+    if (cache->lru_head) {
+        cache->lru_head->lru_prev = entry;
+    } else {
+        cache->lru_tail = entry;
+    }
+    cache->lru_head = entry;
+}
+
+static void remove_entry(esp_ft_cache_handle_t cache, esp_ft_entry_t *entry)
+{
+    esp_ft_entry_t **pp = &cache->buckets[entry_hash(entry->face_id, entry->pixel_size, entry->glyph.glyph_index)];
+    while (*pp != entry) {
+        pp = &(*pp)->hash_next;
+    }
+    *pp = entry->hash_next;
+    lru_unlink(cache, entry);
+    cache->stats.glyphs--;
+    cache->stats.bytes -= entry->bytes;
+    heap_caps_free(entry);
+}
+
+static esp_err_t render_glyph(esp_ft_cache_handle_t cache, int face_id, uint16_t pixel_size,
+                              uint32_t glyph_index, esp_ft_entry_t **ret_entry)
+{
+    FTC_ScalerRec scaler = {
+        .face_id = cache->faces[face_id],
+        .width = 0,
+        .height = pixel_size,
+        .pixel = 1,
+    };
+    FT_Size size;
+    FT_Error error = FTC_Manager_LookupSize(cache->manager, &scaler, &size);
+    if (error == 0) {
+        error = FT_Load_Glyph(size->face, glyph_index, FT_LOAD_RENDER);
+    }
+    ESP_RETURN_ON_FALSE(error == 0, ESP_FAIL, TAG, "failed to render glyph %" PRIu32 " (FreeType error 0x%x)",
+                        glyph_index, error);
+
+    FT_GlyphSlot slot = size->face->glyph;
+    const FT_Bitmap *bitmap = &slot->bitmap;
+    ESP_RETURN_ON_FALSE(bitmap->pixel_mode == FT_PIXEL_MODE_GRAY || bitmap->pixel_mode == FT_PIXEL_MODE_MONO,
+                        ESP_FAIL, TAG, "unsupported pixel mode %d", bitmap->pixel_mode);
+
+    size_t bitmap_bytes = (size_t)bitmap->width * bitmap->rows;
+    size_t bytes = sizeof(esp_ft_entry_t) + bitmap_bytes;
+    ESP_RETURN_ON_FALSE(bytes <= cache->glyph_budget, ESP_ERR_NO_MEM, TAG, "glyph larger than the cache budget");
+    while (cache->stats.bytes + bytes > cache->glyph_budget) {
+        remove_entry(cache, cache->lru_tail);
+        cache->stats.evictions++;
+    }
+
+    esp_ft_entry_t *entry = heap_caps_malloc_prefer(bytes, 2, cache->glyph_caps, MALLOC_CAP_DEFAULT);
+    ESP_RETURN_ON_FALSE(entry, ESP_ERR_NO_MEM, TAG, "no memory for glyph");
+    entry->bytes = bytes;
+    entry->face_id = face_id;
+    entry->pixel_size = pixel_size;
+    entry->glyph = (esp_ft_glyph_t) {
+        .glyph_index = glyph_index,
+        .left = slot->bitmap_left,
+        .top = slot->bitmap_top,
+        .width = bitmap->width,
+        .rows = bitmap->rows,
+        .advance_x = (slot->advance.x + 32) >> 6,
+        .advance_y = (slot->advance.y + 32) >> 6,
+        .bitmap = entry->bitmap,
+    };
+
+    for (unsigned int y = 0; y < bitmap->rows; y++) {
+        const uint8_t *src = bitmap->buffer + (ptrdiff_t)y * bitmap->pitch;
+        uint8_t *dst = entry->bitmap + (size_t)y * bitmap->width;
+        if (bitmap->pixel_mode == FT_PIXEL_MODE_GRAY) {
+            memcpy(dst, src, bitmap->width);
+        } else {
+            for (unsigned int x = 0; x < bitmap->width; x++) {
+                dst[x] = (src[x >> 3] & (0x80 >> (x & 7))) ? 0xff : 0;
+            }
+        }
+    }
+
+    *ret_entry = entry;
+    return ESP_OK;
+}
+
+esp_err_t esp_ft_cache_get_glyph(esp_ft_cache_handle_t cache, int face_id, uint16_t pixel_size,
+                                 uint32_t charcode, esp_ft_glyph_t *glyph)
+{
+    ESP_RETURN_ON_FALSE(cache && glyph && pixel_size, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(face_id >= 0 && face_id < cache->num_faces, ESP_ERR_INVALID_ARG, TAG, "unknown face");
+
+    uint32_t glyph_index = FTC_CMapCache_Lookup(cache->cmap_cache, cache->faces[face_id], -1, charcode);
+
+    unsigned int bucket = entry_hash(face_id, pixel_size, glyph_index);
+    for (esp_ft_entry_t *entry = cache->buckets[bucket]; entry; entry = entry->hash_next) {
+        if (entry->glyph.glyph_index == glyph_index && entry->pixel_size == pixel_size && entry->face_id == face_id) {
+            lru_unlink(cache, entry);
+            lru_push_head(cache, entry);
+            cache->stats.hits++;
+            *glyph = entry->glyph;
+            return ESP_OK;
+        }
+    }
+
+    cache->stats.misses++;
+    esp_ft_entry_t *entry;
+    esp_err_t ret = render_glyph(cache, face_id, pixel_size, glyph_index, &entry);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    entry->hash_next = cache->buckets[bucket];
+    cache->buckets[bucket] = entry;
+    lru_push_head(cache, entry);
+    cache->stats.glyphs++;
+    cache->stats.bytes += entry->bytes;
+    *glyph = entry->glyph;
+    return ESP_OK;
+}
+
+void esp_ft_cache_clear(esp_ft_cache_handle_t cache)
+{
+    while (cache->lru_tail) {
+        remove_entry(cache, cache->lru_tail);
+    }
+}
+
+void esp_ft_cache_get_stats(esp_ft_cache_handle_t cache, esp_ft_cache_stats_t *stats)
+{
+    *stats = cache->stats;
+}
@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_idf_version.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_ft_partition.h"
+
+static const char *TAG = "esp_ft_partition";
+
+#if (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0))
+typedef esp_partition_mmap_handle_t esp_ft_map_handle_t;
+#define ESP_FT_MMAP_DATA    ESP_PARTITION_MMAP_DATA
+#define esp_ft_munmap       esp_partition_munmap
+#else
+typedef spi_flash_mmap_handle_t esp_ft_map_handle_t;
+#define ESP_FT_MMAP_DATA    SPI_FLASH_MMAP_DATA
+#define esp_ft_munmap       spi_flash_munmap
+#endif
+
+#define ESP_FT_WINDOW_SIZE  (CONFIG_FREETYPE_PARTITION_WINDOW_SIZE * 1024)
+#define ESP_FT_WINDOWS      2
+
+typedef struct {
+    const uint8_t *data;        /* NULL if the window is not mapped */
+    unsigned long start;        /* Offset of the window in the font */
+    unsigned long len;
+    esp_ft_map_handle_t handle;
+} esp_ft_window_t;
+
+typedef struct {
+    FT_StreamRec stream;        /* Must be first, the context is freed through it */
+    const esp_partition_t *partition;
+    size_t offset;
+    esp_ft_map_handle_t font_handle;
+    esp_ft_window_t windows[ESP_FT_WINDOWS];
+    int next_window;            /* Window replaced by the next mapping */
+} esp_ft_partition_stream_t;
+
+static const esp_ft_window_t *map_window(esp_ft_partition_stream_t *ctx, unsigned long pos)
+{
+    esp_ft_window_t *window = &ctx->windows[ctx->next_window];
+    const void *data;
+
+    if (window->data) {
+        esp_ft_munmap(window->handle);
+        window->data = NULL;
+    }
+    window->start = pos - pos % ESP_FT_WINDOW_SIZE;
+    window->len = ctx->stream.size - window->start;
+    if (window->len > ESP_FT_WINDOW_SIZE) {
+        window->len = ESP_FT_WINDOW_SIZE;
+    }
+    if (esp_partition_mmap(ctx->partition, ctx->offset + window->start, window->len, ESP_FT_MMAP_DATA,
+                           &data, &window->handle) != ESP_OK) {
+        return NULL;
+    }
+    window->data = data;
+    ctx->next_window = (ctx->next_window + 1) % ESP_FT_WINDOWS;
+    return window;
+}
+
+static const esp_ft_window_t *find_window(esp_ft_partition_stream_t *ctx, unsigned long pos)
+{
+    for (int i = 0; i < ESP_FT_WINDOWS; i++) {
+        const esp_ft_window_t *window = &ctx->windows[i];
+        if (window->data && pos >= window->start && pos < window->start + window->len) {
+            return window;
+        }
+    }
+    return map_window(ctx, pos);
+}
+
+static unsigned long window_read(FT_Stream stream, unsigned long offset, unsigned char *buffer, unsigned long count)
+{
+    esp_ft_partition_stream_t *ctx = stream->descriptor.pointer;
+
+    /* A count of 0 is a seek, which returns 0 on success */
+    if (count == 0) {
+        return offset > stream->size;
+    }
+    if (offset >= stream->size) {
+        return 0;
+    }
+    if (count > stream->size - offset) {
+        count = stream->size - offset;
+    }
+
+    unsigned long done = 0;
+    while (done < count) {
+        unsigned long pos = offset + done;
+        const esp_ft_window_t *window = find_window(ctx, pos);
+        if (window == NULL) {
+            if (esp_partition_read(ctx->partition, ctx->offset + pos, buffer + done, count - done) != ESP_OK) {
+                ESP_LOGE(TAG, "failed to read font at 0x%lx", pos);
+                return done;
+            }
+            return count;
+        }
+        unsigned long len = window->start + window->len - pos;
+        if (len > count - done) {
+            len = count - done;
+        }
+        memcpy(buffer + done, window->data + (pos - window->start), len);
+        done += len;
+    }
+    return done;
+}
+
+static void stream_close(FT_Stream stream)
+{
+    esp_ft_partition_stream_t *ctx = stream->descriptor.pointer;
+
+    if (stream->base) {
+        esp_ft_munmap(ctx->font_handle);
+    }
+    for (int i = 0; i < ESP_FT_WINDOWS; i++) {
+        if (ctx->windows[i].data) {
+            esp_ft_munmap(ctx->windows[i].handle);
+        }
+    }
+    free(ctx);
+}
+
+esp_err_t esp_ft_new_partition_face(FT_Library library, const esp_partition_t *partition, size_t offset, size_t size,
+                                    long face_index, FT_Face *ret_face)
+{
+    ESP_RETURN_ON_FALSE(library && partition && ret_face, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(offset < partition->size, ESP_ERR_INVALID_ARG, TAG, "offset outside of the partition");
+    if (size == 0) {
+        size = partition->size - offset;
+    }
+    ESP_RETURN_ON_FALSE(size <= partition->size - offset, ESP_ERR_INVALID_ARG, TAG, "font outside of the partition");
+
+    esp_ft_partition_stream_t *ctx = calloc(1, sizeof(esp_ft_partition_stream_t));
+    ESP_RETURN_ON_FALSE(ctx, ESP_ERR_NO_MEM, TAG, "no memory for font stream");
+    ctx->partition = partition;
+    ctx->offset = offset;
+    ctx->stream.size = size;
+    ctx->stream.descriptor.pointer = ctx;
+    ctx->stream.close = stream_close;
+
+    /* A stream with a base and no read function is read from memory by FreeType */
+    const void *data;
+    if (esp_partition_mmap(partition, offset, size, ESP_FT_MMAP_DATA, &data, &ctx->font_handle) == ESP_OK) {
+        ctx->stream.base = (unsigned char *)data;
+    } else {
+        ESP_LOGD(TAG, "font of %u bytes cannot be mapped, reading it through windows", (unsigned int)size);
+        ctx->stream.read = window_read;
+    }
+
+    FT_Open_Args args = {
+        .flags = FT_OPEN_STREAM,
+        .stream = &ctx->stream,
+    };
+    /* The stream is closed by FreeType if the face cannot be opened, and by FT_Done_Face() otherwise */
+    FT_Error error = FT_Open_Face(library, &args, face_index, ret_face);
+    ESP_RETURN_ON_FALSE(error == 0, error == FT_Err_Out_Of_Memory ? ESP_ERR_NO_MEM : ESP_FAIL, TAG,
+                        "failed to open face (FreeType error 0x%x)", error);
+    return ESP_OK;
+}
@@ -6,6 +6,7 @@
  *  <hr>
  ******************************************************************************/
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "../support/support.h"
@@ -1090,3 +1091,410 @@ int32_t _IQ1atan2PU(int32_t y, int32_t x)
 {
     return __IQNatan2(y, x, TYPE_PU, 1);
 }
+
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ29 inputs.
+ *
+ * @param y               IQ29 type inputs y.
+ * @param x               IQ29 type inputs x.
+ * @param out             IQ29 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ29atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 29);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ28 inputs.
+ *
+ * @param y               IQ28 type inputs y.
+ * @param x               IQ28 type inputs x.
+ * @param out             IQ28 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ28atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 28);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ27 inputs.
+ *
+ * @param y               IQ27 type inputs y.
+ * @param x               IQ27 type inputs x.
+ * @param out             IQ27 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ27atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 27);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ26 inputs.
+ *
+ * @param y               IQ26 type inputs y.
+ * @param x               IQ26 type inputs x.
+ * @param out             IQ26 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ26atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 26);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ25 inputs.
+ *
+ * @param y               IQ25 type inputs y.
+ * @param x               IQ25 type inputs x.
+ * @param out             IQ25 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ25atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 25);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ24 inputs.
+ *
+ * @param y               IQ24 type inputs y.
+ * @param x               IQ24 type inputs x.
+ * @param out             IQ24 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ24atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 24);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ23 inputs.
+ *
+ * @param y               IQ23 type inputs y.
+ * @param x               IQ23 type inputs x.
+ * @param out             IQ23 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ23atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 23);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ22 inputs.
+ *
+ * @param y               IQ22 type inputs y.
+ * @param x               IQ22 type inputs x.
+ * @param out             IQ22 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ22atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 22);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ21 inputs.
+ *
+ * @param y               IQ21 type inputs y.
+ * @param x               IQ21 type inputs x.
+ * @param out             IQ21 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ21atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 21);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ20 inputs.
+ *
+ * @param y               IQ20 type inputs y.
+ * @param x               IQ20 type inputs x.
+ * @param out             IQ20 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ20atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 20);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ19 inputs.
+ *
+ * @param y               IQ19 type inputs y.
+ * @param x               IQ19 type inputs x.
+ * @param out             IQ19 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ19atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 19);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ18 inputs.
+ *
+ * @param y               IQ18 type inputs y.
+ * @param x               IQ18 type inputs x.
+ * @param out             IQ18 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ18atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 18);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ17 inputs.
+ *
+ * @param y               IQ17 type inputs y.
+ * @param x               IQ17 type inputs x.
+ * @param out             IQ17 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ17atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 17);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ16 inputs.
+ *
+ * @param y               IQ16 type inputs y.
+ * @param x               IQ16 type inputs x.
+ * @param out             IQ16 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ16atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 16);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ15 inputs.
+ *
+ * @param y               IQ15 type inputs y.
+ * @param x               IQ15 type inputs x.
+ * @param out             IQ15 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ15atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 15);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ14 inputs.
+ *
+ * @param y               IQ14 type inputs y.
+ * @param x               IQ14 type inputs x.
+ * @param out             IQ14 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ14atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 14);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ13 inputs.
+ *
+ * @param y               IQ13 type inputs y.
+ * @param x               IQ13 type inputs x.
+ * @param out             IQ13 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ13atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 13);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ12 inputs.
+ *
+ * @param y               IQ12 type inputs y.
+ * @param x               IQ12 type inputs x.
+ * @param out             IQ12 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ12atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 12);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ11 inputs.
+ *
+ * @param y               IQ11 type inputs y.
+ * @param x               IQ11 type inputs x.
+ * @param out             IQ11 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ11atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 11);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ10 inputs.
+ *
+ * @param y               IQ10 type inputs y.
+ * @param x               IQ10 type inputs x.
+ * @param out             IQ10 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ10atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 10);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ9 inputs.
+ *
+ * @param y               IQ9 type inputs y.
+ * @param x               IQ9 type inputs x.
+ * @param out             IQ9 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ9atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 9);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ8 inputs.
+ *
+ * @param y               IQ8 type inputs y.
+ * @param x               IQ8 type inputs x.
+ * @param out             IQ8 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ8atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 8);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ7 inputs.
+ *
+ * @param y               IQ7 type inputs y.
+ * @param x               IQ7 type inputs x.
+ * @param out             IQ7 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ7atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 7);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ6 inputs.
+ *
+ * @param y               IQ6 type inputs y.
+ * @param x               IQ6 type inputs x.
+ * @param out             IQ6 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ6atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 6);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ5 inputs.
+ *
+ * @param y               IQ5 type inputs y.
+ * @param x               IQ5 type inputs x.
+ * @param out             IQ5 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ5atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 5);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ4 inputs.
+ *
+ * @param y               IQ4 type inputs y.
+ * @param x               IQ4 type inputs x.
+ * @param out             IQ4 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ4atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 4);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ3 inputs.
+ *
+ * @param y               IQ3 type inputs y.
+ * @param x               IQ3 type inputs x.
+ * @param out             IQ3 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ3atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 3);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ2 inputs.
+ *
+ * @param y               IQ2 type inputs y.
+ * @param x               IQ2 type inputs x.
+ * @param out             IQ2 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ2atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 2);
+    }
+}
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of IQ1 inputs.
+ *
+ * @param y               IQ1 type inputs y.
+ * @param x               IQ1 type inputs x.
+ * @param out             IQ1 type results of arctangent, can be the same array as y or x.
+ * @param n               Number of elements.
+ */
+void _IQ1atan2_array(const int32_t *y, const int32_t *x, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNatan2(y[i], x[i], TYPE_RAD, 1);
+    }
+}
@@ -1,3 +1,4 @@
+#include <stddef.h>
 #include "_IQNdiv.h"
 
 /* RTS Functions */
@@ -763,3 +764,424 @@ uint32_t _UIQ31div(uint32_t a, uint32_t b)
 {
     return __IQNdiv(a, b, TYPE_UNSIGNED, 31);
 }
+
+/**
+ * @brief Divides arrays of values of IQ30 format.
+ *
+ * @param a               IQ30 type numerators.
+ * @param b               IQ30 type denominators.
+ * @param out             IQ30 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ30div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 30);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ29 format.
+ *
+ * @param a               IQ29 type numerators.
+ * @param b               IQ29 type denominators.
+ * @param out             IQ29 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ29div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 29);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ28 format.
+ *
+ * @param a               IQ28 type numerators.
+ * @param b               IQ28 type denominators.
+ * @param out             IQ28 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ28div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 28);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ27 format.
+ *
+ * @param a               IQ27 type numerators.
+ * @param b               IQ27 type denominators.
+ * @param out             IQ27 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ27div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 27);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ26 format.
+ *
+ * @param a               IQ26 type numerators.
+ * @param b               IQ26 type denominators.
+ * @param out             IQ26 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ26div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 26);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ25 format.
+ *
+ * @param a               IQ25 type numerators.
+ * @param b               IQ25 type denominators.
+ * @param out             IQ25 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ25div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 25);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ24 format.
+ *
+ * @param a               IQ24 type numerators.
+ * @param b               IQ24 type denominators.
+ * @param out             IQ24 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ24div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 24);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ23 format.
+ *
+ * @param a               IQ23 type numerators.
+ * @param b               IQ23 type denominators.
+ * @param out             IQ23 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ23div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 23);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ22 format.
+ *
+ * @param a               IQ22 type numerators.
+ * @param b               IQ22 type denominators.
+ * @param out             IQ22 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ22div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 22);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ21 format.
+ *
+ * @param a               IQ21 type numerators.
+ * @param b               IQ21 type denominators.
+ * @param out             IQ21 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ21div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 21);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ20 format.
+ *
+ * @param a               IQ20 type numerators.
+ * @param b               IQ20 type denominators.
+ * @param out             IQ20 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ20div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 20);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ19 format.
+ *
+ * @param a               IQ19 type numerators.
+ * @param b               IQ19 type denominators.
+ * @param out             IQ19 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ19div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 19);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ18 format.
+ *
+ * @param a               IQ18 type numerators.
+ * @param b               IQ18 type denominators.
+ * @param out             IQ18 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ18div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 18);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ17 format.
+ *
+ * @param a               IQ17 type numerators.
+ * @param b               IQ17 type denominators.
+ * @param out             IQ17 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ17div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 17);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ16 format.
+ *
+ * @param a               IQ16 type numerators.
+ * @param b               IQ16 type denominators.
+ * @param out             IQ16 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ16div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 16);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ15 format.
+ *
+ * @param a               IQ15 type numerators.
+ * @param b               IQ15 type denominators.
+ * @param out             IQ15 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ15div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 15);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ14 format.
+ *
+ * @param a               IQ14 type numerators.
+ * @param b               IQ14 type denominators.
+ * @param out             IQ14 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ14div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 14);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ13 format.
+ *
+ * @param a               IQ13 type numerators.
+ * @param b               IQ13 type denominators.
+ * @param out             IQ13 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ13div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 13);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ12 format.
+ *
+ * @param a               IQ12 type numerators.
+ * @param b               IQ12 type denominators.
+ * @param out             IQ12 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ12div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 12);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ11 format.
+ *
+ * @param a               IQ11 type numerators.
+ * @param b               IQ11 type denominators.
+ * @param out             IQ11 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ11div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 11);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ10 format.
+ *
+ * @param a               IQ10 type numerators.
+ * @param b               IQ10 type denominators.
+ * @param out             IQ10 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ10div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 10);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ9 format.
+ *
+ * @param a               IQ9 type numerators.
+ * @param b               IQ9 type denominators.
+ * @param out             IQ9 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ9div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 9);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ8 format.
+ *
+ * @param a               IQ8 type numerators.
+ * @param b               IQ8 type denominators.
+ * @param out             IQ8 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ8div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 8);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ7 format.
+ *
+ * @param a               IQ7 type numerators.
+ * @param b               IQ7 type denominators.
+ * @param out             IQ7 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ7div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 7);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ6 format.
+ *
+ * @param a               IQ6 type numerators.
+ * @param b               IQ6 type denominators.
+ * @param out             IQ6 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ6div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 6);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ5 format.
+ *
+ * @param a               IQ5 type numerators.
+ * @param b               IQ5 type denominators.
+ * @param out             IQ5 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ5div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 5);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ4 format.
+ *
+ * @param a               IQ4 type numerators.
+ * @param b               IQ4 type denominators.
+ * @param out             IQ4 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ4div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 4);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ3 format.
+ *
+ * @param a               IQ3 type numerators.
+ * @param b               IQ3 type denominators.
+ * @param out             IQ3 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ3div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 3);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ2 format.
+ *
+ * @param a               IQ2 type numerators.
+ * @param b               IQ2 type denominators.
+ * @param out             IQ2 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ2div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 2);
+    }
+}
+/**
+ * @brief Divides arrays of values of IQ1 format.
+ *
+ * @param a               IQ1 type numerators.
+ * @param b               IQ1 type denominators.
+ * @param out             IQ1 type results of the divisions, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ1div_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNdiv(a[i], b[i], TYPE_DEFAULT, 1);
+    }
+}
@@ -9,6 +9,7 @@
 #define ti_iq_iqndiv__include
 #include <stdint.h>
 
+#include "sdkconfig.h"
 #include "../support/support.h"
 #include "_IQNtables.h"
 
@@ -31,6 +32,120 @@
  *
  * @return                IQN type result of the multiplication.
  */
+#if CONFIG_IQMATH_HW_DIV
+/**
+ * @brief Divide a 64-bit unsigned value by a 32-bit one, with 32-bit divisions.
+ *
+ * Long division in base 2^16 (Hacker's Delight, divlu), using two hardware
+ * 32-bit divisions instead of the generic 64-bit division of libgcc.
+ *
+ * @param u1              High word of the numerator, must be lower than v.
+ * @param u0              Low word of the numerator.
+ * @param v               Denominator.
+ *
+ * @return                Quotient, rounded toward zero.
+ */
+__STATIC_INLINE uint32_t __IQNdivlu(uint32_t u1, uint32_t u0, uint32_t v)
+{
+    const uint32_t b = 0x10000;
+    uint32_t un1, un0, vn1, vn0, q1, q0, un32, un21, un10, rhat;
+    int s;
+
+    /* Normalize the divisor so that its MSB is set, and the numerator along. */
+    s = __builtin_clz(v);
+    v <<= s;
+    vn1 = v >> 16;
+    vn0 = v & 0xffff;
+    un32 = s ? (u1 << s) | (u0 >> (32 - s)) : u1;
+    un10 = u0 << s;
+    un1 = un10 >> 16;
+    un0 = un10 & 0xffff;
+
+    /* First 16-bit digit of the quotient, corrected at most twice. */
+    q1 = un32 / vn1;
+    rhat = un32 - q1 * vn1;
+    while (q1 >= b || q1 * vn0 > b * rhat + un1) {
+        q1--;
+        rhat += vn1;
+        if (rhat >= b) {
+            break;
+        }
+    }
+
+    /* Second 16-bit digit of the quotient. */
+    un21 = un32 * b + un1 - q1 * v;
+    q0 = un21 / vn1;
+    rhat = un21 - q0 * vn1;
+    while (q0 >= b || q0 * vn0 > b * rhat + un0) {
+        q0--;
+        rhat += vn1;
+        if (rhat >= b) {
+            break;
+        }
+    }
+
+    return q1 * b + q0;
+}
+
+/**
+ * @brief Divide two values of IQN type, with the hardware divider.
+ *
+ * The quotient is exact, rounded toward zero, so it can differ in the last
+ * bits from the Newton-Raphson approximation used otherwise.
+ *
+ * @param iqNInput1       IQN type value numerator to be divided.
+ * @param iqNInput2       IQN type value denominator to divide by.
+ * @param type            Specify operation is signed or unsigned.
+ * @param q_value         IQ format.
+ *
+ * @return                IQN type result of the division.
+ */
+__STATIC_INLINE int_fast32_t __IQNdiv(int_fast32_t iqNInput1, int_fast32_t iqNInput2, const uint8_t type, const int8_t q_value)
+{
+    uint8_t ui8Sign = 0;
+    uint32_t uiqNInput1 = (uint32_t)iqNInput1;
+    uint32_t uiqNInput2 = (uint32_t)iqNInput2;
+    uint64_t uiiqNInput1;
+    uint32_t uiqNResult;
+
+    /* Check for divide by zero */
+    if (iqNInput2 == 0) {
+        return INT32_MAX;
+    }
+    if (type == TYPE_DEFAULT) {
+        /* save signs and take magnitudes */
+        if (iqNInput2 < 0) {
+            ui8Sign = 1;
+            uiqNInput2 = -uiqNInput2;
+        }
+        if (iqNInput1 < 0) {
+            ui8Sign ^= 1;
+            uiqNInput1 = -uiqNInput1;
+        }
+    }
+
+    /* Check for saturation, the quotient must fit in 32 bits. */
+    uiiqNInput1 = (uint64_t)uiqNInput1 << q_value;
+    if ((uint32_t)(uiiqNInput1 >> 32) >= uiqNInput2) {
+        return ui8Sign ? INT32_MIN : INT32_MAX;
+    }
+    uiqNResult = __IQNdivlu((uint32_t)(uiiqNInput1 >> 32), (uint32_t)uiiqNInput1, uiqNInput2);
+
+    /*
+     * Saturate unsigned results too: _UIQ31div(a, a) would otherwise give
+     * 0x80000000, out of the coefficient table of atan2.
+     */
+    if (uiqNResult > INT32_MAX) {
+        return (type == TYPE_DEFAULT && ui8Sign) ? INT32_MIN : INT32_MAX;
+    }
+
+    /* Add the sign and return. */
+    if (type == TYPE_DEFAULT) {
+        return ui8Sign ? -(int_fast32_t)uiqNResult : (int_fast32_t)uiqNResult;
+    }
+    return uiqNResult;
+}
+#else
 #if defined (__TI_COMPILER_VERSION__)
 #pragma FUNC_ALWAYS_INLINE(__IQNdiv)
 #elif defined(__IAR_SYSTEMS_ICC__)
@@ -159,9 +274,14 @@ __STATIC_INLINE int_fast32_t __IQNdiv(int_fast32_t iqNInput1, int_fast32_t iqNIn
             }
         }
     } else {
+        /* The approximation can round a ratio of 1.0 up to 0x80000000 too. */
+        if (uiqNResult > INT32_MAX) {
+            return INT32_MAX;
+        }
         return uiqNResult;
     }
 }
+#endif /* CONFIG_IQMATH_HW_DIV */
 // TODO: unless we find a different use for it, or we are intending to keep same params as RTS function, I see no use for TYPE here.
 #if ((defined (__IQMATH_USE_MATHACL__)) && (defined (__MSPM0_HAS_MATHACL__)))
 /**
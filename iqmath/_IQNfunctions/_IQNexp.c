@@ -20,6 +20,7 @@
  * @param iqN_MIN           Minimum parameter value.
  * @param iqN_MAX           Maximum parameter value.
  * @param q_value           IQ format.
+ * @param ui8Order          Order of the Taylor series, up to _IQ30exp_order.
  *
  *
  * @return                  IQN type result of exponential.
@@ -29,7 +30,7 @@
 #elif defined(__IAR_SYSTEMS_ICC__)
 #pragma inline=forced
 #endif
-__STATIC_INLINE int_fast32_t __IQNexp(int_fast32_t iqNInput, const uint_fast32_t *iqNLookupTable, uint8_t ui8IntegerOffset, const int_fast32_t iqN_MIN, const int_fast32_t iqN_MAX, const int8_t q_value)
+__STATIC_INLINE int_fast32_t __IQNexp(int_fast32_t iqNInput, const uint_fast32_t *iqNLookupTable, uint8_t ui8IntegerOffset, const int_fast32_t iqN_MIN, const int_fast32_t iqN_MAX, const int8_t q_value, const uint8_t ui8Order)
 {
     uint8_t ui8Count;
     int_fast16_t i16Integer;
@@ -103,14 +104,14 @@ __STATIC_INLINE int_fast32_t __IQNexp(int_fast32_t iqNInput, const uint_fast32_t
 
     /*
      * Initialize the coefficient pointer to the Taylor Series iq30 coefficients
-     * for the exponential functions. Set the iq30 result to the first
-     * coefficient in the table.
+     * for the exponential functions, skipping the highest orders for a lower
+     * order. Set the iq30 result to the first coefficient.
      */
-    piq30Coeffs = _IQ30exp_coeffs;
+    piq30Coeffs = &_IQ30exp_coeffs[_IQ30exp_order - ui8Order];
     uiq30FractionalResult = *piq30Coeffs++;
 
     /* Compute exp^(iq31Fractional). */
-    for (ui8Count = _IQ30exp_order; ui8Count > 0; ui8Count--) {
+    for (ui8Count = ui8Order; ui8Count > 0; ui8Count--) {
         uiq30FractionalResult = __mpyf_l(iq31Fractional, uiq30FractionalResult);
         uiq30FractionalResult += *piq30Coeffs++;
     }
@@ -146,7 +147,7 @@ __STATIC_INLINE int_fast32_t __IQNexp(int_fast32_t iqNInput, const uint_fast32_t
  */
 int32_t _IQ30exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup30, _IQNexp_offset[30 - 1], _IQNexp_min[30 - 1], _IQNexp_max[30 - 1], 30);
+    return __IQNexp(a, _IQNexp_lookup30, _IQNexp_offset[30 - 1], _IQNexp_min[30 - 1], _IQNexp_max[30 - 1], 30, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ29 input.
@@ -157,7 +158,7 @@ int32_t _IQ30exp(int32_t a)
  */
 int32_t _IQ29exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup29, _IQNexp_offset[29 - 1], _IQNexp_min[29 - 1], _IQNexp_max[29 - 1], 29);
+    return __IQNexp(a, _IQNexp_lookup29, _IQNexp_offset[29 - 1], _IQNexp_min[29 - 1], _IQNexp_max[29 - 1], 29, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ28 input.
@@ -168,7 +169,7 @@ int32_t _IQ29exp(int32_t a)
  */
 int32_t _IQ28exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup28, _IQNexp_offset[28 - 1], _IQNexp_min[28 - 1], _IQNexp_max[28 - 1], 28);
+    return __IQNexp(a, _IQNexp_lookup28, _IQNexp_offset[28 - 1], _IQNexp_min[28 - 1], _IQNexp_max[28 - 1], 28, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ27 input.
@@ -179,7 +180,7 @@ int32_t _IQ28exp(int32_t a)
  */
 int32_t _IQ27exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup27, _IQNexp_offset[27 - 1], _IQNexp_min[27 - 1], _IQNexp_max[27 - 1], 27);
+    return __IQNexp(a, _IQNexp_lookup27, _IQNexp_offset[27 - 1], _IQNexp_min[27 - 1], _IQNexp_max[27 - 1], 27, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ26 input.
@@ -190,7 +191,7 @@ int32_t _IQ27exp(int32_t a)
  */
 int32_t _IQ26exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup26, _IQNexp_offset[26 - 1], _IQNexp_min[26 - 1], _IQNexp_max[26 - 1], 26);
+    return __IQNexp(a, _IQNexp_lookup26, _IQNexp_offset[26 - 1], _IQNexp_min[26 - 1], _IQNexp_max[26 - 1], 26, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ25 input.
@@ -201,7 +202,7 @@ int32_t _IQ26exp(int32_t a)
  */
 int32_t _IQ25exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup25, _IQNexp_offset[25 - 1], _IQNexp_min[25 - 1], _IQNexp_max[25 - 1], 25);
+    return __IQNexp(a, _IQNexp_lookup25, _IQNexp_offset[25 - 1], _IQNexp_min[25 - 1], _IQNexp_max[25 - 1], 25, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ24 input.
@@ -212,7 +213,7 @@ int32_t _IQ25exp(int32_t a)
  */
 int32_t _IQ24exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup24, _IQNexp_offset[24 - 1], _IQNexp_min[24 - 1], _IQNexp_max[24 - 1], 24);
+    return __IQNexp(a, _IQNexp_lookup24, _IQNexp_offset[24 - 1], _IQNexp_min[24 - 1], _IQNexp_max[24 - 1], 24, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ23 input.
@@ -223,7 +224,7 @@ int32_t _IQ24exp(int32_t a)
  */
 int32_t _IQ23exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup23, _IQNexp_offset[23 - 1], _IQNexp_min[23 - 1], _IQNexp_max[23 - 1], 23);
+    return __IQNexp(a, _IQNexp_lookup23, _IQNexp_offset[23 - 1], _IQNexp_min[23 - 1], _IQNexp_max[23 - 1], 23, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ22 input.
@@ -234,7 +235,7 @@ int32_t _IQ23exp(int32_t a)
  */
 int32_t _IQ22exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup22, _IQNexp_offset[22 - 1], _IQNexp_min[22 - 1], _IQNexp_max[22 - 1], 22);
+    return __IQNexp(a, _IQNexp_lookup22, _IQNexp_offset[22 - 1], _IQNexp_min[22 - 1], _IQNexp_max[22 - 1], 22, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ21 input.
@@ -245,7 +246,7 @@ int32_t _IQ22exp(int32_t a)
  */
 int32_t _IQ21exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup21, _IQNexp_offset[21 - 1], _IQNexp_min[21 - 1], _IQNexp_max[21 - 1], 21);
+    return __IQNexp(a, _IQNexp_lookup21, _IQNexp_offset[21 - 1], _IQNexp_min[21 - 1], _IQNexp_max[21 - 1], 21, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ20 input.
@@ -256,7 +257,7 @@ int32_t _IQ21exp(int32_t a)
  */
 int32_t _IQ20exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup20, _IQNexp_offset[20 - 1], _IQNexp_min[20 - 1], _IQNexp_max[20 - 1], 20);
+    return __IQNexp(a, _IQNexp_lookup20, _IQNexp_offset[20 - 1], _IQNexp_min[20 - 1], _IQNexp_max[20 - 1], 20, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ19 input.
@@ -267,7 +268,7 @@ int32_t _IQ20exp(int32_t a)
  */
 int32_t _IQ19exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup19, _IQNexp_offset[19 - 1], _IQNexp_min[19 - 1], _IQNexp_max[19 - 1], 19);
+    return __IQNexp(a, _IQNexp_lookup19, _IQNexp_offset[19 - 1], _IQNexp_min[19 - 1], _IQNexp_max[19 - 1], 19, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ18 input.
@@ -278,7 +279,7 @@ int32_t _IQ19exp(int32_t a)
  */
 int32_t _IQ18exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup18, _IQNexp_offset[18 - 1], _IQNexp_min[18 - 1], _IQNexp_max[18 - 1], 18);
+    return __IQNexp(a, _IQNexp_lookup18, _IQNexp_offset[18 - 1], _IQNexp_min[18 - 1], _IQNexp_max[18 - 1], 18, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ17 input.
@@ -289,7 +290,7 @@ int32_t _IQ18exp(int32_t a)
  */
 int32_t _IQ17exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup17, _IQNexp_offset[17 - 1], _IQNexp_min[17 - 1], _IQNexp_max[17 - 1], 17);
+    return __IQNexp(a, _IQNexp_lookup17, _IQNexp_offset[17 - 1], _IQNexp_min[17 - 1], _IQNexp_max[17 - 1], 17, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ16 input.
@@ -300,7 +301,7 @@ int32_t _IQ17exp(int32_t a)
  */
 int32_t _IQ16exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup16, _IQNexp_offset[16 - 1], _IQNexp_min[16 - 1], _IQNexp_max[16 - 1], 16);
+    return __IQNexp(a, _IQNexp_lookup16, _IQNexp_offset[16 - 1], _IQNexp_min[16 - 1], _IQNexp_max[16 - 1], 16, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ15 input.
@@ -311,7 +312,7 @@ int32_t _IQ16exp(int32_t a)
  */
 int32_t _IQ15exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup15, _IQNexp_offset[15 - 1], _IQNexp_min[15 - 1], _IQNexp_max[15 - 1], 15);
+    return __IQNexp(a, _IQNexp_lookup15, _IQNexp_offset[15 - 1], _IQNexp_min[15 - 1], _IQNexp_max[15 - 1], 15, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ14 input.
@@ -322,7 +323,7 @@ int32_t _IQ15exp(int32_t a)
  */
 int32_t _IQ14exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup14, _IQNexp_offset[14 - 1], _IQNexp_min[14 - 1], _IQNexp_max[14 - 1], 14);
+    return __IQNexp(a, _IQNexp_lookup14, _IQNexp_offset[14 - 1], _IQNexp_min[14 - 1], _IQNexp_max[14 - 1], 14, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ13 input.
@@ -333,7 +334,7 @@ int32_t _IQ14exp(int32_t a)
  */
 int32_t _IQ13exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup13, _IQNexp_offset[13 - 1], _IQNexp_min[13 - 1], _IQNexp_max[13 - 1], 13);
+    return __IQNexp(a, _IQNexp_lookup13, _IQNexp_offset[13 - 1], _IQNexp_min[13 - 1], _IQNexp_max[13 - 1], 13, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ12 input.
@@ -344,7 +345,7 @@ int32_t _IQ13exp(int32_t a)
  */
 int32_t _IQ12exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup12, _IQNexp_offset[12 - 1], _IQNexp_min[12 - 1], _IQNexp_max[12 - 1], 12);
+    return __IQNexp(a, _IQNexp_lookup12, _IQNexp_offset[12 - 1], _IQNexp_min[12 - 1], _IQNexp_max[12 - 1], 12, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ11 input.
@@ -355,7 +356,7 @@ int32_t _IQ12exp(int32_t a)
  */
 int32_t _IQ11exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup11, _IQNexp_offset[11 - 1], _IQNexp_min[11 - 1], _IQNexp_max[11 - 1], 11);
+    return __IQNexp(a, _IQNexp_lookup11, _IQNexp_offset[11 - 1], _IQNexp_min[11 - 1], _IQNexp_max[11 - 1], 11, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ10 input.
@@ -366,7 +367,7 @@ int32_t _IQ11exp(int32_t a)
  */
 int32_t _IQ10exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup10, _IQNexp_offset[10 - 1], _IQNexp_min[10 - 1], _IQNexp_max[10 - 1], 10);
+    return __IQNexp(a, _IQNexp_lookup10, _IQNexp_offset[10 - 1], _IQNexp_min[10 - 1], _IQNexp_max[10 - 1], 10, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ9 input.
@@ -377,7 +378,7 @@ int32_t _IQ10exp(int32_t a)
  */
 int32_t _IQ9exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup9, _IQNexp_offset[9 - 1], _IQNexp_min[9 - 1], _IQNexp_max[9 - 1], 9);
+    return __IQNexp(a, _IQNexp_lookup9, _IQNexp_offset[9 - 1], _IQNexp_min[9 - 1], _IQNexp_max[9 - 1], 9, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ8 input.
@@ -388,7 +389,7 @@ int32_t _IQ9exp(int32_t a)
  */
 int32_t _IQ8exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup8, _IQNexp_offset[8 - 1], _IQNexp_min[8 - 1], _IQNexp_max[8 - 1], 8);
+    return __IQNexp(a, _IQNexp_lookup8, _IQNexp_offset[8 - 1], _IQNexp_min[8 - 1], _IQNexp_max[8 - 1], 8, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ7 input.
@@ -399,7 +400,7 @@ int32_t _IQ8exp(int32_t a)
  */
 int32_t _IQ7exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup7, _IQNexp_offset[7 - 1], _IQNexp_min[7 - 1], _IQNexp_max[7 - 1], 7);
+    return __IQNexp(a, _IQNexp_lookup7, _IQNexp_offset[7 - 1], _IQNexp_min[7 - 1], _IQNexp_max[7 - 1], 7, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ6 input.
@@ -410,7 +411,7 @@ int32_t _IQ7exp(int32_t a)
  */
 int32_t _IQ6exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup6, _IQNexp_offset[6 - 1], _IQNexp_min[6 - 1], _IQNexp_max[6 - 1], 6);
+    return __IQNexp(a, _IQNexp_lookup6, _IQNexp_offset[6 - 1], _IQNexp_min[6 - 1], _IQNexp_max[6 - 1], 6, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ5 input.
@@ -421,7 +422,7 @@ int32_t _IQ6exp(int32_t a)
  */
 int32_t _IQ5exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup5, _IQNexp_offset[5 - 1], _IQNexp_min[5 - 1], _IQNexp_max[5 - 1], 5);
+    return __IQNexp(a, _IQNexp_lookup5, _IQNexp_offset[5 - 1], _IQNexp_min[5 - 1], _IQNexp_max[5 - 1], 5, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ4 input.
@@ -432,7 +433,7 @@ int32_t _IQ5exp(int32_t a)
  */
 int32_t _IQ4exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup4, _IQNexp_offset[4 - 1], _IQNexp_min[4 - 1], _IQNexp_max[4 - 1], 4);
+    return __IQNexp(a, _IQNexp_lookup4, _IQNexp_offset[4 - 1], _IQNexp_min[4 - 1], _IQNexp_max[4 - 1], 4, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ3 input.
@@ -443,7 +444,7 @@ int32_t _IQ4exp(int32_t a)
  */
 int32_t _IQ3exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup3, _IQNexp_offset[3 - 1], _IQNexp_min[3 - 1], _IQNexp_max[3 - 1], 3);
+    return __IQNexp(a, _IQNexp_lookup3, _IQNexp_offset[3 - 1], _IQNexp_min[3 - 1], _IQNexp_max[3 - 1], 3, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ2 input.
@@ -454,7 +455,7 @@ int32_t _IQ3exp(int32_t a)
  */
 int32_t _IQ2exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup2, _IQNexp_offset[2 - 1], _IQNexp_min[2 - 1], _IQNexp_max[2 - 1], 2);
+    return __IQNexp(a, _IQNexp_lookup2, _IQNexp_offset[2 - 1], _IQNexp_min[2 - 1], _IQNexp_max[2 - 1], 2, _IQ30exp_order);
 }
 /**
  * @brief Computes the exponential of an IQ1 input.
@@ -465,5 +466,338 @@ int32_t _IQ2exp(int32_t a)
  */
 int32_t _IQ1exp(int32_t a)
 {
-    return __IQNexp(a, _IQNexp_lookup1, _IQNexp_offset[1 - 1], _IQNexp_min[1 - 1], _IQNexp_max[1 - 1], 1);
+    return __IQNexp(a, _IQNexp_lookup1, _IQNexp_offset[1 - 1], _IQNexp_min[1 - 1], _IQNexp_max[1 - 1], 1, _IQ30exp_order);
+}
+
+/* IQ fast exp functions, lower order Taylor series */
+
+/**
+ * @brief Computes the exponential of an IQ30 input, with reduced accuracy.
+ *
+ * @param a               IQ30 type input.
+ *
+ * @return                IQ30 type result of exponential.
+ */
+int32_t _IQ30exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup30, _IQNexp_offset[30 - 1], _IQNexp_min[30 - 1], _IQNexp_max[30 - 1], 30, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ29 input, with reduced accuracy.
+ *
+ * @param a               IQ29 type input.
+ *
+ * @return                IQ29 type result of exponential.
+ */
+int32_t _IQ29exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup29, _IQNexp_offset[29 - 1], _IQNexp_min[29 - 1], _IQNexp_max[29 - 1], 29, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ28 input, with reduced accuracy.
+ *
+ * @param a               IQ28 type input.
+ *
+ * @return                IQ28 type result of exponential.
+ */
+int32_t _IQ28exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup28, _IQNexp_offset[28 - 1], _IQNexp_min[28 - 1], _IQNexp_max[28 - 1], 28, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ27 input, with reduced accuracy.
+ *
+ * @param a               IQ27 type input.
+ *
+ * @return                IQ27 type result of exponential.
+ */
+int32_t _IQ27exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup27, _IQNexp_offset[27 - 1], _IQNexp_min[27 - 1], _IQNexp_max[27 - 1], 27, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ26 input, with reduced accuracy.
+ *
+ * @param a               IQ26 type input.
+ *
+ * @return                IQ26 type result of exponential.
+ */
+int32_t _IQ26exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup26, _IQNexp_offset[26 - 1], _IQNexp_min[26 - 1], _IQNexp_max[26 - 1], 26, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ25 input, with reduced accuracy.
+ *
+ * @param a               IQ25 type input.
+ *
+ * @return                IQ25 type result of exponential.
+ */
+int32_t _IQ25exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup25, _IQNexp_offset[25 - 1], _IQNexp_min[25 - 1], _IQNexp_max[25 - 1], 25, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ24 input, with reduced accuracy.
+ *
+ * @param a               IQ24 type input.
+ *
+ * @return                IQ24 type result of exponential.
+ */
+int32_t _IQ24exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup24, _IQNexp_offset[24 - 1], _IQNexp_min[24 - 1], _IQNexp_max[24 - 1], 24, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ23 input, with reduced accuracy.
+ *
+ * @param a               IQ23 type input.
+ *
+ * @return                IQ23 type result of exponential.
+ */
+int32_t _IQ23exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup23, _IQNexp_offset[23 - 1], _IQNexp_min[23 - 1], _IQNexp_max[23 - 1], 23, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ22 input, with reduced accuracy.
+ *
+ * @param a               IQ22 type input.
+ *
+ * @return                IQ22 type result of exponential.
+ */
+int32_t _IQ22exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup22, _IQNexp_offset[22 - 1], _IQNexp_min[22 - 1], _IQNexp_max[22 - 1], 22, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ21 input, with reduced accuracy.
+ *
+ * @param a               IQ21 type input.
+ *
+ * @return                IQ21 type result of exponential.
+ */
+int32_t _IQ21exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup21, _IQNexp_offset[21 - 1], _IQNexp_min[21 - 1], _IQNexp_max[21 - 1], 21, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ20 input, with reduced accuracy.
+ *
+ * @param a               IQ20 type input.
+ *
+ * @return                IQ20 type result of exponential.
+ */
+int32_t _IQ20exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup20, _IQNexp_offset[20 - 1], _IQNexp_min[20 - 1], _IQNexp_max[20 - 1], 20, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ19 input, with reduced accuracy.
+ *
+ * @param a               IQ19 type input.
+ *
+ * @return                IQ19 type result of exponential.
+ */
+int32_t _IQ19exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup19, _IQNexp_offset[19 - 1], _IQNexp_min[19 - 1], _IQNexp_max[19 - 1], 19, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ18 input, with reduced accuracy.
+ *
+ * @param a               IQ18 type input.
+ *
+ * @return                IQ18 type result of exponential.
+ */
+int32_t _IQ18exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup18, _IQNexp_offset[18 - 1], _IQNexp_min[18 - 1], _IQNexp_max[18 - 1], 18, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ17 input, with reduced accuracy.
+ *
+ * @param a               IQ17 type input.
+ *
+ * @return                IQ17 type result of exponential.
+ */
+int32_t _IQ17exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup17, _IQNexp_offset[17 - 1], _IQNexp_min[17 - 1], _IQNexp_max[17 - 1], 17, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ16 input, with reduced accuracy.
+ *
+ * @param a               IQ16 type input.
+ *
+ * @return                IQ16 type result of exponential.
+ */
+int32_t _IQ16exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup16, _IQNexp_offset[16 - 1], _IQNexp_min[16 - 1], _IQNexp_max[16 - 1], 16, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ15 input, with reduced accuracy.
+ *
+ * @param a               IQ15 type input.
+ *
+ * @return                IQ15 type result of exponential.
+ */
+int32_t _IQ15exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup15, _IQNexp_offset[15 - 1], _IQNexp_min[15 - 1], _IQNexp_max[15 - 1], 15, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ14 input, with reduced accuracy.
+ *
+ * @param a               IQ14 type input.
+ *
+ * @return                IQ14 type result of exponential.
+ */
+int32_t _IQ14exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup14, _IQNexp_offset[14 - 1], _IQNexp_min[14 - 1], _IQNexp_max[14 - 1], 14, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ13 input, with reduced accuracy.
+ *
+ * @param a               IQ13 type input.
+ *
+ * @return                IQ13 type result of exponential.
+ */
+int32_t _IQ13exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup13, _IQNexp_offset[13 - 1], _IQNexp_min[13 - 1], _IQNexp_max[13 - 1], 13, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ12 input, with reduced accuracy.
+ *
+ * @param a               IQ12 type input.
+ *
+ * @return                IQ12 type result of exponential.
+ */
+int32_t _IQ12exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup12, _IQNexp_offset[12 - 1], _IQNexp_min[12 - 1], _IQNexp_max[12 - 1], 12, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ11 input, with reduced accuracy.
+ *
+ * @param a               IQ11 type input.
+ *
+ * @return                IQ11 type result of exponential.
+ */
+int32_t _IQ11exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup11, _IQNexp_offset[11 - 1], _IQNexp_min[11 - 1], _IQNexp_max[11 - 1], 11, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ10 input, with reduced accuracy.
+ *
+ * @param a               IQ10 type input.
+ *
+ * @return                IQ10 type result of exponential.
+ */
+int32_t _IQ10exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup10, _IQNexp_offset[10 - 1], _IQNexp_min[10 - 1], _IQNexp_max[10 - 1], 10, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ9 input, with reduced accuracy.
+ *
+ * @param a               IQ9 type input.
+ *
+ * @return                IQ9 type result of exponential.
+ */
+int32_t _IQ9exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup9, _IQNexp_offset[9 - 1], _IQNexp_min[9 - 1], _IQNexp_max[9 - 1], 9, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ8 input, with reduced accuracy.
+ *
+ * @param a               IQ8 type input.
+ *
+ * @return                IQ8 type result of exponential.
+ */
+int32_t _IQ8exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup8, _IQNexp_offset[8 - 1], _IQNexp_min[8 - 1], _IQNexp_max[8 - 1], 8, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ7 input, with reduced accuracy.
+ *
+ * @param a               IQ7 type input.
+ *
+ * @return                IQ7 type result of exponential.
+ */
+int32_t _IQ7exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup7, _IQNexp_offset[7 - 1], _IQNexp_min[7 - 1], _IQNexp_max[7 - 1], 7, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ6 input, with reduced accuracy.
+ *
+ * @param a               IQ6 type input.
+ *
+ * @return                IQ6 type result of exponential.
+ */
+int32_t _IQ6exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup6, _IQNexp_offset[6 - 1], _IQNexp_min[6 - 1], _IQNexp_max[6 - 1], 6, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ5 input, with reduced accuracy.
+ *
+ * @param a               IQ5 type input.
+ *
+ * @return                IQ5 type result of exponential.
+ */
+int32_t _IQ5exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup5, _IQNexp_offset[5 - 1], _IQNexp_min[5 - 1], _IQNexp_max[5 - 1], 5, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ4 input, with reduced accuracy.
+ *
+ * @param a               IQ4 type input.
+ *
+ * @return                IQ4 type result of exponential.
+ */
+int32_t _IQ4exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup4, _IQNexp_offset[4 - 1], _IQNexp_min[4 - 1], _IQNexp_max[4 - 1], 4, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ3 input, with reduced accuracy.
+ *
+ * @param a               IQ3 type input.
+ *
+ * @return                IQ3 type result of exponential.
+ */
+int32_t _IQ3exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup3, _IQNexp_offset[3 - 1], _IQNexp_min[3 - 1], _IQNexp_max[3 - 1], 3, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ2 input, with reduced accuracy.
+ *
+ * @param a               IQ2 type input.
+ *
+ * @return                IQ2 type result of exponential.
+ */
+int32_t _IQ2exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup2, _IQNexp_offset[2 - 1], _IQNexp_min[2 - 1], _IQNexp_max[2 - 1], 2, _IQ30exp_order_fast);
+}
+/**
+ * @brief Computes the exponential of an IQ1 input, with reduced accuracy.
+ *
+ * @param a               IQ1 type input.
+ *
+ * @return                IQ1 type result of exponential.
+ */
+int32_t _IQ1exp_fast(int32_t a)
+{
+    return __IQNexp(a, _IQNexp_lookup1, _IQNexp_offset[1 - 1], _IQNexp_min[1 - 1], _IQNexp_max[1 - 1], 1, _IQ30exp_order_fast);
 }
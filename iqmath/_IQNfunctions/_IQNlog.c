@@ -17,6 +17,7 @@
  * @param iqNInput          IQN type input.
  * @param iqNMin            Minimum parameter value.
  * @param q_value           IQ format.
+ * @param ui8Order          Order of the Taylor series, up to _IQ30log_order.
  *
  * @return                  IQN type result of exponential.
  */
@@ -25,7 +26,7 @@
 #elif defined(__IAR_SYSTEMS_ICC__)
 #pragma inline=forced
 #endif
-__STATIC_INLINE int_fast32_t __IQNlog(int_fast32_t iqNInput, const int_fast32_t iqNMin, const int8_t q_value)
+__STATIC_INLINE int_fast32_t __IQNlog(int_fast32_t iqNInput, const int_fast32_t iqNMin, const int8_t q_value, const uint8_t ui8Order)
 {
     uint8_t ui8Counter;
     int_fast16_t i16Exp;
@@ -81,15 +82,16 @@ __STATIC_INLINE int_fast32_t __IQNlog(int_fast32_t iqNInput, const int_fast32_t
 
     /*
      * Initialize the coefficient pointer to the Taylor Series iq30 coefficients
-     * for the logarithm functions. Set the iq30 result to the first
-     * coefficient in the table. Subtract one from the iq31 input.
+     * for the logarithm functions, skipping the highest orders for a lower
+     * order. Set the iq30 result to the first coefficient. Subtract one from
+     * the iq31 input.
      */
-    piq30Coeffs = _IQ30log_coeffs;
+    piq30Coeffs = &_IQ30log_coeffs[_IQ30log_order - ui8Order];
     iq30Result = *piq30Coeffs++;
     uiq31Input -= iq31_one;
 
     /* Calculate log(uiq31Input) using the iq30 Taylor Series coefficients. */
-    for (ui8Counter = _IQ30log_order; ui8Counter > 0; ui8Counter--) {
+    for (ui8Counter = ui8Order; ui8Counter > 0; ui8Counter--) {
         iq30Result = __mpyf_l(uiq31Input, iq30Result);
         iq30Result += *piq30Coeffs++;
     }
@@ -127,7 +129,7 @@ __STATIC_INLINE int_fast32_t __IQNlog(int_fast32_t iqNInput, const int_fast32_t
  */
 int32_t _IQ30log(int32_t a)
 {
-    return __IQNlog(a, _IQNlog_min[30 - 27], 30);
+    return __IQNlog(a, _IQNlog_min[30 - 27], 30, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ29 input.
@@ -138,7 +140,7 @@ int32_t _IQ30log(int32_t a)
  */
 int32_t _IQ29log(int32_t a)
 {
-    return __IQNlog(a, _IQNlog_min[29 - 27], 29);
+    return __IQNlog(a, _IQNlog_min[29 - 27], 29, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ28 input.
@@ -149,7 +151,7 @@ int32_t _IQ29log(int32_t a)
  */
 int32_t _IQ28log(int32_t a)
 {
-    return __IQNlog(a, _IQNlog_min[28 - 27], 28);
+    return __IQNlog(a, _IQNlog_min[28 - 27], 28, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ27 input.
@@ -160,7 +162,7 @@ int32_t _IQ28log(int32_t a)
  */
 int32_t _IQ27log(int32_t a)
 {
-    return __IQNlog(a, _IQNlog_min[27 - 27], 27);
+    return __IQNlog(a, _IQNlog_min[27 - 27], 27, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ26 input.
@@ -171,7 +173,7 @@ int32_t _IQ27log(int32_t a)
  */
 int32_t _IQ26log(int32_t a)
 {
-    return __IQNlog(a, 1, 26);
+    return __IQNlog(a, 1, 26, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ25 input.
@@ -182,7 +184,7 @@ int32_t _IQ26log(int32_t a)
  */
 int32_t _IQ25log(int32_t a)
 {
-    return __IQNlog(a, 1, 25);
+    return __IQNlog(a, 1, 25, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ24 input.
@@ -193,7 +195,7 @@ int32_t _IQ25log(int32_t a)
  */
 int32_t _IQ24log(int32_t a)
 {
-    return __IQNlog(a, 1, 24);
+    return __IQNlog(a, 1, 24, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ23 input.
@@ -204,7 +206,7 @@ int32_t _IQ24log(int32_t a)
  */
 int32_t _IQ23log(int32_t a)
 {
-    return __IQNlog(a, 1, 23);
+    return __IQNlog(a, 1, 23, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ22 input.
@@ -215,7 +217,7 @@ int32_t _IQ23log(int32_t a)
  */
 int32_t _IQ22log(int32_t a)
 {
-    return __IQNlog(a, 1, 22);
+    return __IQNlog(a, 1, 22, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ21 input.
@@ -226,7 +228,7 @@ int32_t _IQ22log(int32_t a)
  */
 int32_t _IQ21log(int32_t a)
 {
-    return __IQNlog(a, 1, 21);
+    return __IQNlog(a, 1, 21, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ20 input.
@@ -237,7 +239,7 @@ int32_t _IQ21log(int32_t a)
  */
 int32_t _IQ20log(int32_t a)
 {
-    return __IQNlog(a, 1, 20);
+    return __IQNlog(a, 1, 20, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ19 input.
@@ -248,7 +250,7 @@ int32_t _IQ20log(int32_t a)
  */
 int32_t _IQ19log(int32_t a)
 {
-    return __IQNlog(a, 1, 19);
+    return __IQNlog(a, 1, 19, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ18 input.
@@ -259,7 +261,7 @@ int32_t _IQ19log(int32_t a)
  */
 int32_t _IQ18log(int32_t a)
 {
-    return __IQNlog(a, 1, 18);
+    return __IQNlog(a, 1, 18, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ17 input.
@@ -270,7 +272,7 @@ int32_t _IQ18log(int32_t a)
  */
 int32_t _IQ17log(int32_t a)
 {
-    return __IQNlog(a, 1, 17);
+    return __IQNlog(a, 1, 17, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ16 input.
@@ -281,7 +283,7 @@ int32_t _IQ17log(int32_t a)
  */
 int32_t _IQ16log(int32_t a)
 {
-    return __IQNlog(a, 1, 16);
+    return __IQNlog(a, 1, 16, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ15 input.
@@ -292,7 +294,7 @@ int32_t _IQ16log(int32_t a)
  */
 int32_t _IQ15log(int32_t a)
 {
-    return __IQNlog(a, 1, 15);
+    return __IQNlog(a, 1, 15, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ14 input.
@@ -303,7 +305,7 @@ int32_t _IQ15log(int32_t a)
  */
 int32_t _IQ14log(int32_t a)
 {
-    return __IQNlog(a, 1, 14);
+    return __IQNlog(a, 1, 14, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ13 input.
@@ -314,7 +316,7 @@ int32_t _IQ14log(int32_t a)
  */
 int32_t _IQ13log(int32_t a)
 {
-    return __IQNlog(a, 1, 13);
+    return __IQNlog(a, 1, 13, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ12 input.
@@ -325,7 +327,7 @@ int32_t _IQ13log(int32_t a)
  */
 int32_t _IQ12log(int32_t a)
 {
-    return __IQNlog(a, 1, 12);
+    return __IQNlog(a, 1, 12, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ11 input.
@@ -336,7 +338,7 @@ int32_t _IQ12log(int32_t a)
  */
 int32_t _IQ11log(int32_t a)
 {
-    return __IQNlog(a, 1, 11);
+    return __IQNlog(a, 1, 11, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ10 input.
@@ -347,7 +349,7 @@ int32_t _IQ11log(int32_t a)
  */
 int32_t _IQ10log(int32_t a)
 {
-    return __IQNlog(a, 1, 10);
+    return __IQNlog(a, 1, 10, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ9 input.
@@ -358,7 +360,7 @@ int32_t _IQ10log(int32_t a)
  */
 int32_t _IQ9log(int32_t a)
 {
-    return __IQNlog(a, 1, 9);
+    return __IQNlog(a, 1, 9, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ8 input.
@@ -369,7 +371,7 @@ int32_t _IQ9log(int32_t a)
  */
 int32_t _IQ8log(int32_t a)
 {
-    return __IQNlog(a, 1, 8);
+    return __IQNlog(a, 1, 8, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ7 input.
@@ -380,7 +382,7 @@ int32_t _IQ8log(int32_t a)
  */
 int32_t _IQ7log(int32_t a)
 {
-    return __IQNlog(a, 1, 7);
+    return __IQNlog(a, 1, 7, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ6 input.
@@ -391,7 +393,7 @@ int32_t _IQ7log(int32_t a)
  */
 int32_t _IQ6log(int32_t a)
 {
-    return __IQNlog(a, 1, 6);
+    return __IQNlog(a, 1, 6, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ5 input.
@@ -402,7 +404,7 @@ int32_t _IQ6log(int32_t a)
  */
 int32_t _IQ5log(int32_t a)
 {
-    return __IQNlog(a, 1, 5);
+    return __IQNlog(a, 1, 5, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ4 input.
@@ -413,7 +415,7 @@ int32_t _IQ5log(int32_t a)
  */
 int32_t _IQ4log(int32_t a)
 {
-    return __IQNlog(a, 1, 4);
+    return __IQNlog(a, 1, 4, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ3 input.
@@ -424,7 +426,7 @@ int32_t _IQ4log(int32_t a)
  */
 int32_t _IQ3log(int32_t a)
 {
-    return __IQNlog(a, 1, 3);
+    return __IQNlog(a, 1, 3, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ2 input.
@@ -435,7 +437,7 @@ int32_t _IQ3log(int32_t a)
  */
 int32_t _IQ2log(int32_t a)
 {
-    return __IQNlog(a, 1, 2);
+    return __IQNlog(a, 1, 2, _IQ30log_order);
 }
 /**
  * @brief Computes the base-e logarithm of an IQ1 input.
@@ -446,5 +448,338 @@ int32_t _IQ2log(int32_t a)
  */
 int32_t _IQ1log(int32_t a)
 {
-    return __IQNlog(a, 1, 1);
+    return __IQNlog(a, 1, 1, _IQ30log_order);
+}
+
+/* IQ fast log functions, lower order Taylor series */
+
+/**
+ * @brief Computes the base-e logarithm of an IQ30 input, with reduced accuracy.
+ *
+ * @param a                 IQ30 type input.
+ *
+ * @return                  IQ30 type result of logarithm.
+ */
+int32_t _IQ30log_fast(int32_t a)
+{
+    return __IQNlog(a, _IQNlog_min[30 - 27], 30, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ29 input, with reduced accuracy.
+ *
+ * @param a                 IQ29 type input.
+ *
+ * @return                  IQ29 type result of logarithm.
+ */
+int32_t _IQ29log_fast(int32_t a)
+{
+    return __IQNlog(a, _IQNlog_min[29 - 27], 29, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ28 input, with reduced accuracy.
+ *
+ * @param a                 IQ28 type input.
+ *
+ * @return                  IQ28 type result of logarithm.
+ */
+int32_t _IQ28log_fast(int32_t a)
+{
+    return __IQNlog(a, _IQNlog_min[28 - 27], 28, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ27 input, with reduced accuracy.
+ *
+ * @param a                 IQ27 type input.
+ *
+ * @return                  IQ27 type result of logarithm.
+ */
+int32_t _IQ27log_fast(int32_t a)
+{
+    return __IQNlog(a, _IQNlog_min[27 - 27], 27, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ26 input, with reduced accuracy.
+ *
+ * @param a                 IQ26 type input.
+ *
+ * @return                  IQ26 type result of logarithm.
+ */
+int32_t _IQ26log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 26, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ25 input, with reduced accuracy.
+ *
+ * @param a                 IQ25 type input.
+ *
+ * @return                  IQ25 type result of logarithm.
+ */
+int32_t _IQ25log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 25, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ24 input, with reduced accuracy.
+ *
+ * @param a                 IQ24 type input.
+ *
+ * @return                  IQ24 type result of logarithm.
+ */
+int32_t _IQ24log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 24, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ23 input, with reduced accuracy.
+ *
+ * @param a                 IQ23 type input.
+ *
+ * @return                  IQ23 type result of logarithm.
+ */
+int32_t _IQ23log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 23, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ22 input, with reduced accuracy.
+ *
+ * @param a                 IQ22 type input.
+ *
+ * @return                  IQ22 type result of logarithm.
+ */
+int32_t _IQ22log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 22, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ21 input, with reduced accuracy.
+ *
+ * @param a                 IQ21 type input.
+ *
+ * @return                  IQ21 type result of logarithm.
+ */
+int32_t _IQ21log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 21, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ20 input, with reduced accuracy.
+ *
+ * @param a                 IQ20 type input.
+ *
+ * @return                  IQ20 type result of logarithm.
+ */
+int32_t _IQ20log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 20, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ19 input, with reduced accuracy.
+ *
+ * @param a                 IQ19 type input.
+ *
+ * @return                  IQ19 type result of logarithm.
+ */
+int32_t _IQ19log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 19, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ18 input, with reduced accuracy.
+ *
+ * @param a                 IQ18 type input.
+ *
+ * @return                  IQ18 type result of logarithm.
+ */
+int32_t _IQ18log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 18, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ17 input, with reduced accuracy.
+ *
+ * @param a                 IQ17 type input.
+ *
+ * @return                  IQ17 type result of logarithm.
+ */
+int32_t _IQ17log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 17, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ16 input, with reduced accuracy.
+ *
+ * @param a                 IQ16 type input.
+ *
+ * @return                  IQ16 type result of logarithm.
+ */
+int32_t _IQ16log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 16, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ15 input, with reduced accuracy.
+ *
+ * @param a                 IQ15 type input.
+ *
+ * @return                  IQ15 type result of logarithm.
+ */
+int32_t _IQ15log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 15, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ14 input, with reduced accuracy.
+ *
+ * @param a                 IQ14 type input.
+ *
+ * @return                  IQ14 type result of logarithm.
+ */
+int32_t _IQ14log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 14, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ13 input, with reduced accuracy.
+ *
+ * @param a                 IQ13 type input.
+ *
+ * @return                  IQ13 type result of logarithm.
+ */
+int32_t _IQ13log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 13, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ12 input, with reduced accuracy.
+ *
+ * @param a                 IQ12 type input.
+ *
+ * @return                  IQ12 type result of logarithm.
+ */
+int32_t _IQ12log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 12, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ11 input, with reduced accuracy.
+ *
+ * @param a                 IQ11 type input.
+ *
+ * @return                  IQ11 type result of logarithm.
+ */
+int32_t _IQ11log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 11, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ10 input, with reduced accuracy.
+ *
+ * @param a                 IQ10 type input.
+ *
+ * @return                  IQ10 type result of logarithm.
+ */
+int32_t _IQ10log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 10, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ9 input, with reduced accuracy.
+ *
+ * @param a                 IQ9 type input.
+ *
+ * @return                  IQ9 type result of logarithm.
+ */
+int32_t _IQ9log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 9, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ8 input, with reduced accuracy.
+ *
+ * @param a                 IQ8 type input.
+ *
+ * @return                  IQ8 type result of logarithm.
+ */
+int32_t _IQ8log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 8, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ7 input, with reduced accuracy.
+ *
+ * @param a                 IQ7 type input.
+ *
+ * @return                  IQ7 type result of logarithm.
+ */
+int32_t _IQ7log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 7, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ6 input, with reduced accuracy.
+ *
+ * @param a                 IQ6 type input.
+ *
+ * @return                  IQ6 type result of logarithm.
+ */
+int32_t _IQ6log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 6, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ5 input, with reduced accuracy.
+ *
+ * @param a                 IQ5 type input.
+ *
+ * @return                  IQ5 type result of logarithm.
+ */
+int32_t _IQ5log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 5, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ4 input, with reduced accuracy.
+ *
+ * @param a                 IQ4 type input.
+ *
+ * @return                  IQ4 type result of logarithm.
+ */
+int32_t _IQ4log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 4, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ3 input, with reduced accuracy.
+ *
+ * @param a                 IQ3 type input.
+ *
+ * @return                  IQ3 type result of logarithm.
+ */
+int32_t _IQ3log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 3, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ2 input, with reduced accuracy.
+ *
+ * @param a                 IQ2 type input.
+ *
+ * @return                  IQ2 type result of logarithm.
+ */
+int32_t _IQ2log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 2, _IQ30log_order_fast);
+}
+/**
+ * @brief Computes the base-e logarithm of an IQ1 input, with reduced accuracy.
+ *
+ * @param a                 IQ1 type input.
+ *
+ * @return                  IQ1 type result of logarithm.
+ */
+int32_t _IQ1log_fast(int32_t a)
+{
+    return __IQNlog(a, 1, 1, _IQ30log_order_fast);
 }
@@ -4,6 +4,7 @@
  *
  *  <hr>
  ******************************************************************************/
+#include <stddef.h>
 #include "_IQNmpy.h"
 
 /**
@@ -378,3 +379,424 @@ int32_t _IQ1mpy(int32_t a, int32_t b)
 {
     return __IQNmpy(a, b, 1);
 }
+
+/**
+ * @brief Multiplies arrays of values of IQ30 format.
+ *
+ * @param a               IQ30 type values to be multiplied.
+ * @param b               IQ30 type values to be multiplied.
+ * @param out             IQ30 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ30mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 30);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ29 format.
+ *
+ * @param a               IQ29 type values to be multiplied.
+ * @param b               IQ29 type values to be multiplied.
+ * @param out             IQ29 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ29mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 29);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ28 format.
+ *
+ * @param a               IQ28 type values to be multiplied.
+ * @param b               IQ28 type values to be multiplied.
+ * @param out             IQ28 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ28mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 28);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ27 format.
+ *
+ * @param a               IQ27 type values to be multiplied.
+ * @param b               IQ27 type values to be multiplied.
+ * @param out             IQ27 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ27mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 27);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ26 format.
+ *
+ * @param a               IQ26 type values to be multiplied.
+ * @param b               IQ26 type values to be multiplied.
+ * @param out             IQ26 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ26mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 26);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ25 format.
+ *
+ * @param a               IQ25 type values to be multiplied.
+ * @param b               IQ25 type values to be multiplied.
+ * @param out             IQ25 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ25mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 25);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ24 format.
+ *
+ * @param a               IQ24 type values to be multiplied.
+ * @param b               IQ24 type values to be multiplied.
+ * @param out             IQ24 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ24mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 24);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ23 format.
+ *
+ * @param a               IQ23 type values to be multiplied.
+ * @param b               IQ23 type values to be multiplied.
+ * @param out             IQ23 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ23mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 23);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ22 format.
+ *
+ * @param a               IQ22 type values to be multiplied.
+ * @param b               IQ22 type values to be multiplied.
+ * @param out             IQ22 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ22mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 22);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ21 format.
+ *
+ * @param a               IQ21 type values to be multiplied.
+ * @param b               IQ21 type values to be multiplied.
+ * @param out             IQ21 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ21mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 21);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ20 format.
+ *
+ * @param a               IQ20 type values to be multiplied.
+ * @param b               IQ20 type values to be multiplied.
+ * @param out             IQ20 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ20mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 20);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ19 format.
+ *
+ * @param a               IQ19 type values to be multiplied.
+ * @param b               IQ19 type values to be multiplied.
+ * @param out             IQ19 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ19mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 19);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ18 format.
+ *
+ * @param a               IQ18 type values to be multiplied.
+ * @param b               IQ18 type values to be multiplied.
+ * @param out             IQ18 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ18mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 18);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ17 format.
+ *
+ * @param a               IQ17 type values to be multiplied.
+ * @param b               IQ17 type values to be multiplied.
+ * @param out             IQ17 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ17mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 17);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ16 format.
+ *
+ * @param a               IQ16 type values to be multiplied.
+ * @param b               IQ16 type values to be multiplied.
+ * @param out             IQ16 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ16mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 16);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ15 format.
+ *
+ * @param a               IQ15 type values to be multiplied.
+ * @param b               IQ15 type values to be multiplied.
+ * @param out             IQ15 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ15mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 15);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ14 format.
+ *
+ * @param a               IQ14 type values to be multiplied.
+ * @param b               IQ14 type values to be multiplied.
+ * @param out             IQ14 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ14mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 14);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ13 format.
+ *
+ * @param a               IQ13 type values to be multiplied.
+ * @param b               IQ13 type values to be multiplied.
+ * @param out             IQ13 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ13mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 13);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ12 format.
+ *
+ * @param a               IQ12 type values to be multiplied.
+ * @param b               IQ12 type values to be multiplied.
+ * @param out             IQ12 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ12mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 12);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ11 format.
+ *
+ * @param a               IQ11 type values to be multiplied.
+ * @param b               IQ11 type values to be multiplied.
+ * @param out             IQ11 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ11mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 11);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ10 format.
+ *
+ * @param a               IQ10 type values to be multiplied.
+ * @param b               IQ10 type values to be multiplied.
+ * @param out             IQ10 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ10mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 10);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ9 format.
+ *
+ * @param a               IQ9 type values to be multiplied.
+ * @param b               IQ9 type values to be multiplied.
+ * @param out             IQ9 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ9mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 9);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ8 format.
+ *
+ * @param a               IQ8 type values to be multiplied.
+ * @param b               IQ8 type values to be multiplied.
+ * @param out             IQ8 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ8mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 8);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ7 format.
+ *
+ * @param a               IQ7 type values to be multiplied.
+ * @param b               IQ7 type values to be multiplied.
+ * @param out             IQ7 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ7mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 7);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ6 format.
+ *
+ * @param a               IQ6 type values to be multiplied.
+ * @param b               IQ6 type values to be multiplied.
+ * @param out             IQ6 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ6mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 6);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ5 format.
+ *
+ * @param a               IQ5 type values to be multiplied.
+ * @param b               IQ5 type values to be multiplied.
+ * @param out             IQ5 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ5mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 5);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ4 format.
+ *
+ * @param a               IQ4 type values to be multiplied.
+ * @param b               IQ4 type values to be multiplied.
+ * @param out             IQ4 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ4mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 4);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ3 format.
+ *
+ * @param a               IQ3 type values to be multiplied.
+ * @param b               IQ3 type values to be multiplied.
+ * @param out             IQ3 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ3mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 3);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ2 format.
+ *
+ * @param a               IQ2 type values to be multiplied.
+ * @param b               IQ2 type values to be multiplied.
+ * @param out             IQ2 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ2mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 2);
+    }
+}
+/**
+ * @brief Multiplies arrays of values of IQ1 format.
+ *
+ * @param a               IQ1 type values to be multiplied.
+ * @param b               IQ1 type values to be multiplied.
+ * @param out             IQ1 type results of the multiplications, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQ1mpy_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNmpy(a[i], b[i], 1);
+    }
+}
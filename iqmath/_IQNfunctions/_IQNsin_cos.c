@@ -6,6 +6,7 @@
  *  <hr>
  ******************************************************************************/
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "../support/support.h"
@@ -33,6 +34,14 @@
  * @brief Used to specify per-unit result
  */
 #define TYPE_PU      (1)
+/*!
+ * @brief Used to specify full accuracy
+ */
+#define ACCURACY_FULL   (0)
+/*!
+ * @brief Used to specify fast computation with reduced accuracy
+ */
+#define ACCURACY_FAST   (1)
 
 
 #if ((!defined (__IQMATH_USE_MATHACL__)) || (!defined (__MSPM0_HAS_MATHACL__)))
@@ -181,6 +190,69 @@ __STATIC_INLINE int_fast32_t __IQNcalcCos(uint_fast32_t uiq31Input)
     return iq31Res;
 }
 
+/*
+ * Fast versions of the two functions above, with a linear interpolation
+ * between the lookup table values instead of the Taylor series:
+ *
+ *     sin(Radian) = S(k) + 64*x*(S(k+1) - S(k))
+ *     cos(Radian) = C(k) + 64*x*(C(k+1) - C(k))
+ *
+ * The interpolation error is at most (1/64)^2/8, about 3.1e-5 (15 bits of
+ * accuracy), with one multiplication instead of four.
+ */
+/**
+ * @brief Computes the sine of an UIQ31 input with reduced accuracy.
+ *
+ * @param uiq31Input      UIQ31 type input, up to pi/4.
+ *
+ * @return                UIQ31 type result of sine.
+ */
+#if defined (__TI_COMPILER_VERSION__)
+#pragma FUNC_ALWAYS_INLINE(__IQNcalcSinFast)
+#elif defined(__IAR_SYSTEMS_ICC__)
+#pragma inline=forced
+#endif
+__STATIC_INLINE int_fast32_t __IQNcalcSinFast(uint_fast32_t uiq31Input)
+{
+    uint_fast16_t index;
+    int_fast32_t iq31Frac;
+
+    /* Calculate index for sin lookup using bits 31:26 */
+    index = (uint_fast16_t)(uiq31Input >> 25) & 0x003f;
+
+    /* Fraction of the step between two table values, 64*x in iq31. */
+    iq31Frac = (uiq31Input & 0x01ffffff) << 6;
+
+    /* S(k) + 64*x*(S(k+1) - S(k)) */
+    return _IQ31SinLookup[index] + __mpyf_l(_IQ31SinLookup[index + 1] - _IQ31SinLookup[index], iq31Frac);
+}
+/**
+ * @brief Computes the cosine of an UIQ31 input with reduced accuracy.
+ *
+ * @param uiq31Input      UIQ31 type input, up to pi/4.
+ *
+ * @return                UIQ31 type result of cosine.
+ */
+#if defined (__TI_COMPILER_VERSION__)
+#pragma FUNC_ALWAYS_INLINE(__IQNcalcCosFast)
+#elif defined(__IAR_SYSTEMS_ICC__)
+#pragma inline=forced
+#endif
+__STATIC_INLINE int_fast32_t __IQNcalcCosFast(uint_fast32_t uiq31Input)
+{
+    uint_fast16_t index;
+    int_fast32_t iq31Frac;
+
+    /* Calculate index for cos lookup using bits 31:26 */
+    index = (uint_fast16_t)(uiq31Input >> 25) & 0x003f;
+
+    /* Fraction of the step between two table values, 64*x in iq31. */
+    iq31Frac = (uiq31Input & 0x01ffffff) << 6;
+
+    /* C(k) + 64*x*(C(k+1) - C(k)) */
+    return _IQ31CosLookup[index] + __mpyf_l(_IQ31CosLookup[index + 1] - _IQ31CosLookup[index], iq31Frac);
+}
+
 /**
  * @brief Computes the sine or cosine of an IQN input.
  *
@@ -188,6 +260,7 @@ __STATIC_INLINE int_fast32_t __IQNcalcCos(uint_fast32_t uiq31Input)
  * @param q_value         IQ format.
  * @param type            Specifies sine or cosine operation.
  * @param format          Specifies radians or per-unit operation.
+ * @param accuracy        Specifies full accuracy or fast operation.
  *
  * @return                IQN type result of sin or cosine operation.
  */
@@ -197,7 +270,7 @@ __STATIC_INLINE int_fast32_t __IQNcalcCos(uint_fast32_t uiq31Input)
 #pragma inline=forced
 #endif
 __STATIC_INLINE int_fast32_t __IQNsin_cos(int_fast32_t iqNInput, const int8_t q_value,
-        const int8_t type, const int8_t format)
+        const int8_t type, const int8_t format, const int8_t accuracy)
 {
     uint8_t ui8Sign = 0;
     uint_fast16_t ui16IntState;
@@ -292,17 +365,17 @@ __STATIC_INLINE int_fast32_t __IQNsin_cos(int_fast32_t iqNInput, const int8_t q_
         /* If input is greater than pi/4 use sin for calculations */
         if (uiq31Input > iq31_quarterPi) {
             uiq31Input = iq31_halfPi - uiq31Input;
-            uiq31Result = __IQNcalcSin(uiq31Input);
+            uiq31Result = (accuracy == ACCURACY_FAST) ? __IQNcalcSinFast(uiq31Input) : __IQNcalcSin(uiq31Input);
         } else {
-            uiq31Result = __IQNcalcCos(uiq31Input);
+            uiq31Result = (accuracy == ACCURACY_FAST) ? __IQNcalcCosFast(uiq31Input) : __IQNcalcCos(uiq31Input);
         }
     } else if (type == TYPE_SIN) {
         /* If input is greater than pi/4 use cos for calculations */
         if (uiq31Input > iq31_quarterPi) {
             uiq31Input = iq31_halfPi - uiq31Input;
-            uiq31Result = __IQNcalcCos(uiq31Input);
+            uiq31Result = (accuracy == ACCURACY_FAST) ? __IQNcalcCosFast(uiq31Input) : __IQNcalcCos(uiq31Input);
         } else {
-            uiq31Result = __IQNcalcSin(uiq31Input);
+            uiq31Result = (accuracy == ACCURACY_FAST) ? __IQNcalcSinFast(uiq31Input) : __IQNcalcSin(uiq31Input);
         }
     }
 
@@ -330,6 +403,7 @@ __STATIC_INLINE int_fast32_t __IQNsin_cos(int_fast32_t iqNInput, const int8_t q_
  * @param q_value         IQ format.
  * @param type            Specifies sine or cosine operation.
  * @param format          Specifies radians or per-unit operation.
+ * @param accuracy        Specifies full accuracy or fast operation.
  *
  * @return                IQN type result of sin or cosine operation.
  */
@@ -339,10 +413,12 @@ __STATIC_INLINE int_fast32_t __IQNsin_cos(int_fast32_t iqNInput, const int8_t q_
 #pragma inline=forced
 #endif
 __STATIC_INLINE int_fast32_t __IQNsin_cos(int_fast32_t iqNInput, const int8_t q_value,
-        const int8_t type, const int8_t format)
+        const int8_t type, const int8_t format, const int8_t accuracy)
 {
     int_fast32_t res, res1, resMult, resDiv;
     int_fast32_t iq31input;
+    /* MathACL is fast at full accuracy */
+    (void)accuracy;
     /* Per unit API */
     if (format == TYPE_PU) {
         /* multiply by 2 for MathACL scaling. */
@@ -396,7 +472,7 @@ __STATIC_INLINE int_fast32_t __IQNsin_cos(int_fast32_t iqNInput, const int8_t q_
  */
 int32_t _IQ29sin(int32_t a)
 {
-    return __IQNsin_cos(a, 29, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 29, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ28 input.
@@ -407,7 +483,7 @@ int32_t _IQ29sin(int32_t a)
  */
 int32_t _IQ28sin(int32_t a)
 {
-    return __IQNsin_cos(a, 28, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 28, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ27 input.
@@ -418,7 +494,7 @@ int32_t _IQ28sin(int32_t a)
  */
 int32_t _IQ27sin(int32_t a)
 {
-    return __IQNsin_cos(a, 27, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 27, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ26 input.
@@ -429,7 +505,7 @@ int32_t _IQ27sin(int32_t a)
  */
 int32_t _IQ26sin(int32_t a)
 {
-    return __IQNsin_cos(a, 26, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 26, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ25 input.
@@ -440,7 +516,7 @@ int32_t _IQ26sin(int32_t a)
  */
 int32_t _IQ25sin(int32_t a)
 {
-    return __IQNsin_cos(a, 25, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 25, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ24 input.
@@ -451,7 +527,7 @@ int32_t _IQ25sin(int32_t a)
  */
 int32_t _IQ24sin(int32_t a)
 {
-    return __IQNsin_cos(a, 24, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 24, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ23 input.
@@ -462,7 +538,7 @@ int32_t _IQ24sin(int32_t a)
  */
 int32_t _IQ23sin(int32_t a)
 {
-    return __IQNsin_cos(a, 23, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 23, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ22 input.
@@ -473,7 +549,7 @@ int32_t _IQ23sin(int32_t a)
  */
 int32_t _IQ22sin(int32_t a)
 {
-    return __IQNsin_cos(a, 22, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 22, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ21 input.
@@ -484,7 +560,7 @@ int32_t _IQ22sin(int32_t a)
  */
 int32_t _IQ21sin(int32_t a)
 {
-    return __IQNsin_cos(a, 21, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 21, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ20 input.
@@ -495,7 +571,7 @@ int32_t _IQ21sin(int32_t a)
  */
 int32_t _IQ20sin(int32_t a)
 {
-    return __IQNsin_cos(a, 20, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 20, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ19 input.
@@ -506,7 +582,7 @@ int32_t _IQ20sin(int32_t a)
  */
 int32_t _IQ19sin(int32_t a)
 {
-    return __IQNsin_cos(a, 19, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 19, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ18 input.
@@ -517,7 +593,7 @@ int32_t _IQ19sin(int32_t a)
  */
 int32_t _IQ18sin(int32_t a)
 {
-    return __IQNsin_cos(a, 18, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 18, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ17 input.
@@ -528,7 +604,7 @@ int32_t _IQ18sin(int32_t a)
  */
 int32_t _IQ17sin(int32_t a)
 {
-    return __IQNsin_cos(a, 17, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 17, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ16 input.
@@ -539,7 +615,7 @@ int32_t _IQ17sin(int32_t a)
  */
 int32_t _IQ16sin(int32_t a)
 {
-    return __IQNsin_cos(a, 16, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 16, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ15 input.
@@ -550,7 +626,7 @@ int32_t _IQ16sin(int32_t a)
  */
 int32_t _IQ15sin(int32_t a)
 {
-    return __IQNsin_cos(a, 15, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 15, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ14 input.
@@ -561,7 +637,7 @@ int32_t _IQ15sin(int32_t a)
  */
 int32_t _IQ14sin(int32_t a)
 {
-    return __IQNsin_cos(a, 14, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 14, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ13 input.
@@ -572,7 +648,7 @@ int32_t _IQ14sin(int32_t a)
  */
 int32_t _IQ13sin(int32_t a)
 {
-    return __IQNsin_cos(a, 13, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 13, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ12 input.
@@ -583,7 +659,7 @@ int32_t _IQ13sin(int32_t a)
  */
 int32_t _IQ12sin(int32_t a)
 {
-    return __IQNsin_cos(a, 12, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 12, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ11 input.
@@ -594,7 +670,7 @@ int32_t _IQ12sin(int32_t a)
  */
 int32_t _IQ11sin(int32_t a)
 {
-    return __IQNsin_cos(a, 11, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 11, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ10 input.
@@ -605,7 +681,7 @@ int32_t _IQ11sin(int32_t a)
  */
 int32_t _IQ10sin(int32_t a)
 {
-    return __IQNsin_cos(a, 10, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 10, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ9 input.
@@ -616,7 +692,7 @@ int32_t _IQ10sin(int32_t a)
  */
 int32_t _IQ9sin(int32_t a)
 {
-    return __IQNsin_cos(a, 9, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 9, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ8 input.
@@ -627,7 +703,7 @@ int32_t _IQ9sin(int32_t a)
  */
 int32_t _IQ8sin(int32_t a)
 {
-    return __IQNsin_cos(a, 8, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 8, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ7 input.
@@ -638,7 +714,7 @@ int32_t _IQ8sin(int32_t a)
  */
 int32_t _IQ7sin(int32_t a)
 {
-    return __IQNsin_cos(a, 7, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 7, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ6 input.
@@ -649,7 +725,7 @@ int32_t _IQ7sin(int32_t a)
  */
 int32_t _IQ6sin(int32_t a)
 {
-    return __IQNsin_cos(a, 6, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 6, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ5 input.
@@ -660,7 +736,7 @@ int32_t _IQ6sin(int32_t a)
  */
 int32_t _IQ5sin(int32_t a)
 {
-    return __IQNsin_cos(a, 5, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 5, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ4 input.
@@ -671,7 +747,7 @@ int32_t _IQ5sin(int32_t a)
  */
 int32_t _IQ4sin(int32_t a)
 {
-    return __IQNsin_cos(a, 4, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 4, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ3 input.
@@ -682,7 +758,7 @@ int32_t _IQ4sin(int32_t a)
  */
 int32_t _IQ3sin(int32_t a)
 {
-    return __IQNsin_cos(a, 3, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 3, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ2 input.
@@ -693,7 +769,7 @@ int32_t _IQ3sin(int32_t a)
  */
 int32_t _IQ2sin(int32_t a)
 {
-    return __IQNsin_cos(a, 2, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 2, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ1 input.
@@ -704,7 +780,7 @@ int32_t _IQ2sin(int32_t a)
  */
 int32_t _IQ1sin(int32_t a)
 {
-    return __IQNsin_cos(a, 1, TYPE_SIN, TYPE_RAD);
+    return __IQNsin_cos(a, 1, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
 }
 
 /* IQ cos functions */
@@ -717,7 +793,7 @@ int32_t _IQ1sin(int32_t a)
  */
 int32_t _IQ29cos(int32_t a)
 {
-    return __IQNsin_cos(a, 29, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 29, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ28 input.
@@ -728,7 +804,7 @@ int32_t _IQ29cos(int32_t a)
  */
 int32_t _IQ28cos(int32_t a)
 {
-    return __IQNsin_cos(a, 28, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 28, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ27 input.
@@ -739,7 +815,7 @@ int32_t _IQ28cos(int32_t a)
  */
 int32_t _IQ27cos(int32_t a)
 {
-    return __IQNsin_cos(a, 27, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 27, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ26 input.
@@ -750,7 +826,7 @@ int32_t _IQ27cos(int32_t a)
  */
 int32_t _IQ26cos(int32_t a)
 {
-    return __IQNsin_cos(a, 26, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 26, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ25 input.
@@ -761,7 +837,7 @@ int32_t _IQ26cos(int32_t a)
  */
 int32_t _IQ25cos(int32_t a)
 {
-    return __IQNsin_cos(a, 25, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 25, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ24 input.
@@ -772,7 +848,7 @@ int32_t _IQ25cos(int32_t a)
  */
 int32_t _IQ24cos(int32_t a)
 {
-    return __IQNsin_cos(a, 24, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 24, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ23 input.
@@ -783,7 +859,7 @@ int32_t _IQ24cos(int32_t a)
  */
 int32_t _IQ23cos(int32_t a)
 {
-    return __IQNsin_cos(a, 23, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 23, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ22 input.
@@ -794,7 +870,7 @@ int32_t _IQ23cos(int32_t a)
  */
 int32_t _IQ22cos(int32_t a)
 {
-    return __IQNsin_cos(a, 22, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 22, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ21 input.
@@ -805,7 +881,7 @@ int32_t _IQ22cos(int32_t a)
  */
 int32_t _IQ21cos(int32_t a)
 {
-    return __IQNsin_cos(a, 21, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 21, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ20 input.
@@ -816,7 +892,7 @@ int32_t _IQ21cos(int32_t a)
  */
 int32_t _IQ20cos(int32_t a)
 {
-    return __IQNsin_cos(a, 20, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 20, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ19 input.
@@ -827,7 +903,7 @@ int32_t _IQ20cos(int32_t a)
  */
 int32_t _IQ19cos(int32_t a)
 {
-    return __IQNsin_cos(a, 19, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 19, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ18 input.
@@ -838,7 +914,7 @@ int32_t _IQ19cos(int32_t a)
  */
 int32_t _IQ18cos(int32_t a)
 {
-    return __IQNsin_cos(a, 18, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 18, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ17 input.
@@ -849,7 +925,7 @@ int32_t _IQ18cos(int32_t a)
  */
 int32_t _IQ17cos(int32_t a)
 {
-    return __IQNsin_cos(a, 17, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 17, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ16 input.
@@ -860,7 +936,7 @@ int32_t _IQ17cos(int32_t a)
  */
 int32_t _IQ16cos(int32_t a)
 {
-    return __IQNsin_cos(a, 16, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 16, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ15 input.
@@ -871,7 +947,7 @@ int32_t _IQ16cos(int32_t a)
  */
 int32_t _IQ15cos(int32_t a)
 {
-    return __IQNsin_cos(a, 15, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 15, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ14 input.
@@ -882,7 +958,7 @@ int32_t _IQ15cos(int32_t a)
  */
 int32_t _IQ14cos(int32_t a)
 {
-    return __IQNsin_cos(a, 14, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 14, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ13 input.
@@ -893,7 +969,7 @@ int32_t _IQ14cos(int32_t a)
  */
 int32_t _IQ13cos(int32_t a)
 {
-    return __IQNsin_cos(a, 13, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 13, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ12 input.
@@ -904,7 +980,7 @@ int32_t _IQ13cos(int32_t a)
  */
 int32_t _IQ12cos(int32_t a)
 {
-    return __IQNsin_cos(a, 12, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 12, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ11 input.
@@ -915,7 +991,7 @@ int32_t _IQ12cos(int32_t a)
  */
 int32_t _IQ11cos(int32_t a)
 {
-    return __IQNsin_cos(a, 11, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 11, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ10 input.
@@ -926,7 +1002,7 @@ int32_t _IQ11cos(int32_t a)
  */
 int32_t _IQ10cos(int32_t a)
 {
-    return __IQNsin_cos(a, 10, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 10, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ9 input.
@@ -937,7 +1013,7 @@ int32_t _IQ10cos(int32_t a)
  */
 int32_t _IQ9cos(int32_t a)
 {
-    return __IQNsin_cos(a, 9, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 9, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ8 input.
@@ -948,7 +1024,7 @@ int32_t _IQ9cos(int32_t a)
  */
 int32_t _IQ8cos(int32_t a)
 {
-    return __IQNsin_cos(a, 8, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 8, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ7 input.
@@ -959,7 +1035,7 @@ int32_t _IQ8cos(int32_t a)
  */
 int32_t _IQ7cos(int32_t a)
 {
-    return __IQNsin_cos(a, 7, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 7, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ6 input.
@@ -970,7 +1046,7 @@ int32_t _IQ7cos(int32_t a)
  */
 int32_t _IQ6cos(int32_t a)
 {
-    return __IQNsin_cos(a, 6, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 6, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ5 input.
@@ -981,7 +1057,7 @@ int32_t _IQ6cos(int32_t a)
  */
 int32_t _IQ5cos(int32_t a)
 {
-    return __IQNsin_cos(a, 5, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 5, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ4 input.
@@ -992,7 +1068,7 @@ int32_t _IQ5cos(int32_t a)
  */
 int32_t _IQ4cos(int32_t a)
 {
-    return __IQNsin_cos(a, 4, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 4, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ3 input.
@@ -1003,7 +1079,7 @@ int32_t _IQ4cos(int32_t a)
  */
 int32_t _IQ3cos(int32_t a)
 {
-    return __IQNsin_cos(a, 3, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 3, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ2 input.
@@ -1014,7 +1090,7 @@ int32_t _IQ3cos(int32_t a)
  */
 int32_t _IQ2cos(int32_t a)
 {
-    return __IQNsin_cos(a, 2, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 2, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ1 input.
@@ -1025,7 +1101,7 @@ int32_t _IQ2cos(int32_t a)
  */
 int32_t _IQ1cos(int32_t a)
 {
-    return __IQNsin_cos(a, 1, TYPE_COS, TYPE_RAD);
+    return __IQNsin_cos(a, 1, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
 }
 
 /* IQ sinPU functions */
@@ -1038,7 +1114,7 @@ int32_t _IQ1cos(int32_t a)
  */
 int32_t _IQ31sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 31, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 31, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ30 input.
@@ -1049,7 +1125,7 @@ int32_t _IQ31sinPU(int32_t a)
  */
 int32_t _IQ30sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 30, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 30, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ29 input.
@@ -1060,7 +1136,7 @@ int32_t _IQ30sinPU(int32_t a)
  */
 int32_t _IQ29sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 29, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 29, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ28 input.
@@ -1071,7 +1147,7 @@ int32_t _IQ29sinPU(int32_t a)
  */
 int32_t _IQ28sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 28, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 28, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ27 input.
@@ -1082,7 +1158,7 @@ int32_t _IQ28sinPU(int32_t a)
  */
 int32_t _IQ27sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 27, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 27, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ26 input.
@@ -1093,7 +1169,7 @@ int32_t _IQ27sinPU(int32_t a)
  */
 int32_t _IQ26sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 26, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 26, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ25 input.
@@ -1104,7 +1180,7 @@ int32_t _IQ26sinPU(int32_t a)
  */
 int32_t _IQ25sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 25, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 25, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ24 input.
@@ -1115,7 +1191,7 @@ int32_t _IQ25sinPU(int32_t a)
  */
 int32_t _IQ24sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 24, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 24, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ23 input.
@@ -1126,7 +1202,7 @@ int32_t _IQ24sinPU(int32_t a)
  */
 int32_t _IQ23sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 23, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 23, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ22 input.
@@ -1137,7 +1213,7 @@ int32_t _IQ23sinPU(int32_t a)
  */
 int32_t _IQ22sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 22, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 22, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ21 input.
@@ -1148,7 +1224,7 @@ int32_t _IQ22sinPU(int32_t a)
  */
 int32_t _IQ21sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 21, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 21, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ20 input.
@@ -1159,7 +1235,7 @@ int32_t _IQ21sinPU(int32_t a)
  */
 int32_t _IQ20sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 20, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 20, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ19 input.
@@ -1170,7 +1246,7 @@ int32_t _IQ20sinPU(int32_t a)
  */
 int32_t _IQ19sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 19, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 19, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ18 input.
@@ -1181,7 +1257,7 @@ int32_t _IQ19sinPU(int32_t a)
  */
 int32_t _IQ18sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 18, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 18, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ17 input.
@@ -1192,7 +1268,7 @@ int32_t _IQ18sinPU(int32_t a)
  */
 int32_t _IQ17sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 17, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 17, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ16 input.
@@ -1203,7 +1279,7 @@ int32_t _IQ17sinPU(int32_t a)
  */
 int32_t _IQ16sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 16, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 16, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ15 input.
@@ -1214,7 +1290,7 @@ int32_t _IQ16sinPU(int32_t a)
  */
 int32_t _IQ15sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 15, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 15, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ14 input.
@@ -1225,7 +1301,7 @@ int32_t _IQ15sinPU(int32_t a)
  */
 int32_t _IQ14sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 14, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 14, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ13 input.
@@ -1236,7 +1312,7 @@ int32_t _IQ14sinPU(int32_t a)
  */
 int32_t _IQ13sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 13, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 13, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ12 input.
@@ -1247,7 +1323,7 @@ int32_t _IQ13sinPU(int32_t a)
  */
 int32_t _IQ12sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 12, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 12, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ11 input.
@@ -1258,7 +1334,7 @@ int32_t _IQ12sinPU(int32_t a)
  */
 int32_t _IQ11sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 11, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 11, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ10 input.
@@ -1269,7 +1345,7 @@ int32_t _IQ11sinPU(int32_t a)
  */
 int32_t _IQ10sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 10, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 10, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ9 input.
@@ -1280,7 +1356,7 @@ int32_t _IQ10sinPU(int32_t a)
  */
 int32_t _IQ9sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 9, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 9, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ8 input.
@@ -1291,7 +1367,7 @@ int32_t _IQ9sinPU(int32_t a)
  */
 int32_t _IQ8sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 8, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 8, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ7 input.
@@ -1302,7 +1378,7 @@ int32_t _IQ8sinPU(int32_t a)
  */
 int32_t _IQ7sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 7, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 7, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ6 input.
@@ -1313,7 +1389,7 @@ int32_t _IQ7sinPU(int32_t a)
  */
 int32_t _IQ6sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 6, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 6, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ5 input.
@@ -1324,7 +1400,7 @@ int32_t _IQ6sinPU(int32_t a)
  */
 int32_t _IQ5sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 5, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 5, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ4 input.
@@ -1335,7 +1411,7 @@ int32_t _IQ5sinPU(int32_t a)
  */
 int32_t _IQ4sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 4, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 4, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ3 input.
@@ -1346,7 +1422,7 @@ int32_t _IQ4sinPU(int32_t a)
  */
 int32_t _IQ3sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 3, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 3, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ2 input.
@@ -1357,7 +1433,7 @@ int32_t _IQ3sinPU(int32_t a)
  */
 int32_t _IQ2sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 2, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 2, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the sine of an IQ1 input.
@@ -1368,7 +1444,7 @@ int32_t _IQ2sinPU(int32_t a)
  */
 int32_t _IQ1sinPU(int32_t a)
 {
-    return __IQNsin_cos(a, 1, TYPE_SIN, TYPE_PU);
+    return __IQNsin_cos(a, 1, TYPE_SIN, TYPE_PU, ACCURACY_FULL);
 }
 
 /* IQ cosPU functions */
@@ -1381,7 +1457,7 @@ int32_t _IQ1sinPU(int32_t a)
  */
 int32_t _IQ31cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 31, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 31, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ30 input.
@@ -1392,7 +1468,7 @@ int32_t _IQ31cosPU(int32_t a)
  */
 int32_t _IQ30cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 30, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 30, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ29 input.
@@ -1403,7 +1479,7 @@ int32_t _IQ30cosPU(int32_t a)
  */
 int32_t _IQ29cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 29, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 29, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ28 input.
@@ -1414,7 +1490,7 @@ int32_t _IQ29cosPU(int32_t a)
  */
 int32_t _IQ28cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 28, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 28, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ27 input.
@@ -1425,7 +1501,7 @@ int32_t _IQ28cosPU(int32_t a)
  */
 int32_t _IQ27cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 27, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 27, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ26 input.
@@ -1436,7 +1512,7 @@ int32_t _IQ27cosPU(int32_t a)
  */
 int32_t _IQ26cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 26, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 26, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ25 input.
@@ -1447,7 +1523,7 @@ int32_t _IQ26cosPU(int32_t a)
  */
 int32_t _IQ25cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 25, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 25, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ24 input.
@@ -1458,7 +1534,7 @@ int32_t _IQ25cosPU(int32_t a)
  */
 int32_t _IQ24cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 24, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 24, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ23 input.
@@ -1469,7 +1545,7 @@ int32_t _IQ24cosPU(int32_t a)
  */
 int32_t _IQ23cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 23, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 23, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ22 input.
@@ -1480,7 +1556,7 @@ int32_t _IQ23cosPU(int32_t a)
  */
 int32_t _IQ22cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 22, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 22, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ21 input.
@@ -1491,7 +1567,7 @@ int32_t _IQ22cosPU(int32_t a)
  */
 int32_t _IQ21cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 21, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 21, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ20 input.
@@ -1502,7 +1578,7 @@ int32_t _IQ21cosPU(int32_t a)
  */
 int32_t _IQ20cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 20, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 20, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ19 input.
@@ -1513,7 +1589,7 @@ int32_t _IQ20cosPU(int32_t a)
  */
 int32_t _IQ19cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 19, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 19, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ18 input.
@@ -1524,7 +1600,7 @@ int32_t _IQ19cosPU(int32_t a)
  */
 int32_t _IQ18cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 18, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 18, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ17 input.
@@ -1535,7 +1611,7 @@ int32_t _IQ18cosPU(int32_t a)
  */
 int32_t _IQ17cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 17, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 17, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ16 input.
@@ -1546,7 +1622,7 @@ int32_t _IQ17cosPU(int32_t a)
  */
 int32_t _IQ16cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 16, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 16, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ15 input.
@@ -1557,7 +1633,7 @@ int32_t _IQ16cosPU(int32_t a)
  */
 int32_t _IQ15cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 15, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 15, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ14 input.
@@ -1568,7 +1644,7 @@ int32_t _IQ15cosPU(int32_t a)
  */
 int32_t _IQ14cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 14, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 14, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ13 input.
@@ -1579,7 +1655,7 @@ int32_t _IQ14cosPU(int32_t a)
  */
 int32_t _IQ13cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 13, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 13, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ12 input.
@@ -1590,7 +1666,7 @@ int32_t _IQ13cosPU(int32_t a)
  */
 int32_t _IQ12cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 12, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 12, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ11 input.
@@ -1601,7 +1677,7 @@ int32_t _IQ12cosPU(int32_t a)
  */
 int32_t _IQ11cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 11, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 11, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ10 input.
@@ -1612,7 +1688,7 @@ int32_t _IQ11cosPU(int32_t a)
  */
 int32_t _IQ10cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 10, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 10, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ9 input.
@@ -1623,7 +1699,7 @@ int32_t _IQ10cosPU(int32_t a)
  */
 int32_t _IQ9cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 9, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 9, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ8 input.
@@ -1634,7 +1710,7 @@ int32_t _IQ9cosPU(int32_t a)
  */
 int32_t _IQ8cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 8, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 8, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ7 input.
@@ -1645,7 +1721,7 @@ int32_t _IQ8cosPU(int32_t a)
  */
 int32_t _IQ7cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 7, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 7, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ6 input.
@@ -1656,7 +1732,7 @@ int32_t _IQ7cosPU(int32_t a)
  */
 int32_t _IQ6cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 6, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 6, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ5 input.
@@ -1667,7 +1743,7 @@ int32_t _IQ6cosPU(int32_t a)
  */
 int32_t _IQ5cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 5, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 5, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ4 input.
@@ -1678,7 +1754,7 @@ int32_t _IQ5cosPU(int32_t a)
  */
 int32_t _IQ4cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 4, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 4, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ3 input.
@@ -1689,7 +1765,7 @@ int32_t _IQ4cosPU(int32_t a)
  */
 int32_t _IQ3cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 3, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 3, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ2 input.
@@ -1700,7 +1776,7 @@ int32_t _IQ3cosPU(int32_t a)
  */
 int32_t _IQ2cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 2, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 2, TYPE_COS, TYPE_PU, ACCURACY_FULL);
 }
 /**
  * @brief Computes the cosine of an IQ1 input.
@@ -1711,5 +1787,1401 @@ int32_t _IQ2cosPU(int32_t a)
  */
 int32_t _IQ1cosPU(int32_t a)
 {
-    return __IQNsin_cos(a, 1, TYPE_COS, TYPE_PU);
+    return __IQNsin_cos(a, 1, TYPE_COS, TYPE_PU, ACCURACY_FULL);
+}
+
+/**
+ * @brief Computes the sine of an array of IQ29 inputs.
+ *
+ * @param in              IQ29 type inputs.
+ * @param out             IQ29 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ29sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 29, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ28 inputs.
+ *
+ * @param in              IQ28 type inputs.
+ * @param out             IQ28 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ28sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 28, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ27 inputs.
+ *
+ * @param in              IQ27 type inputs.
+ * @param out             IQ27 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ27sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 27, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ26 inputs.
+ *
+ * @param in              IQ26 type inputs.
+ * @param out             IQ26 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ26sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 26, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ25 inputs.
+ *
+ * @param in              IQ25 type inputs.
+ * @param out             IQ25 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ25sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 25, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ24 inputs.
+ *
+ * @param in              IQ24 type inputs.
+ * @param out             IQ24 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ24sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 24, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ23 inputs.
+ *
+ * @param in              IQ23 type inputs.
+ * @param out             IQ23 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ23sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 23, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ22 inputs.
+ *
+ * @param in              IQ22 type inputs.
+ * @param out             IQ22 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ22sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 22, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ21 inputs.
+ *
+ * @param in              IQ21 type inputs.
+ * @param out             IQ21 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ21sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 21, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ20 inputs.
+ *
+ * @param in              IQ20 type inputs.
+ * @param out             IQ20 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ20sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 20, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ19 inputs.
+ *
+ * @param in              IQ19 type inputs.
+ * @param out             IQ19 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ19sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 19, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ18 inputs.
+ *
+ * @param in              IQ18 type inputs.
+ * @param out             IQ18 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ18sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 18, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ17 inputs.
+ *
+ * @param in              IQ17 type inputs.
+ * @param out             IQ17 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ17sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 17, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ16 inputs.
+ *
+ * @param in              IQ16 type inputs.
+ * @param out             IQ16 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ16sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 16, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ15 inputs.
+ *
+ * @param in              IQ15 type inputs.
+ * @param out             IQ15 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ15sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 15, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ14 inputs.
+ *
+ * @param in              IQ14 type inputs.
+ * @param out             IQ14 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ14sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 14, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ13 inputs.
+ *
+ * @param in              IQ13 type inputs.
+ * @param out             IQ13 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ13sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 13, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ12 inputs.
+ *
+ * @param in              IQ12 type inputs.
+ * @param out             IQ12 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ12sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 12, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ11 inputs.
+ *
+ * @param in              IQ11 type inputs.
+ * @param out             IQ11 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ11sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 11, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ10 inputs.
+ *
+ * @param in              IQ10 type inputs.
+ * @param out             IQ10 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ10sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 10, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ9 inputs.
+ *
+ * @param in              IQ9 type inputs.
+ * @param out             IQ9 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ9sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 9, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ8 inputs.
+ *
+ * @param in              IQ8 type inputs.
+ * @param out             IQ8 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ8sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 8, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ7 inputs.
+ *
+ * @param in              IQ7 type inputs.
+ * @param out             IQ7 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ7sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 7, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ6 inputs.
+ *
+ * @param in              IQ6 type inputs.
+ * @param out             IQ6 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ6sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 6, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ5 inputs.
+ *
+ * @param in              IQ5 type inputs.
+ * @param out             IQ5 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ5sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 5, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ4 inputs.
+ *
+ * @param in              IQ4 type inputs.
+ * @param out             IQ4 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ4sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 4, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ3 inputs.
+ *
+ * @param in              IQ3 type inputs.
+ * @param out             IQ3 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ3sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 3, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ2 inputs.
+ *
+ * @param in              IQ2 type inputs.
+ * @param out             IQ2 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ2sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 2, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the sine of an array of IQ1 inputs.
+ *
+ * @param in              IQ1 type inputs.
+ * @param out             IQ1 type results of sine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ1sin_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 1, TYPE_SIN, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ29 inputs.
+ *
+ * @param in              IQ29 type inputs.
+ * @param out             IQ29 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ29cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 29, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ28 inputs.
+ *
+ * @param in              IQ28 type inputs.
+ * @param out             IQ28 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ28cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 28, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ27 inputs.
+ *
+ * @param in              IQ27 type inputs.
+ * @param out             IQ27 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ27cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 27, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ26 inputs.
+ *
+ * @param in              IQ26 type inputs.
+ * @param out             IQ26 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ26cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 26, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ25 inputs.
+ *
+ * @param in              IQ25 type inputs.
+ * @param out             IQ25 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ25cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 25, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ24 inputs.
+ *
+ * @param in              IQ24 type inputs.
+ * @param out             IQ24 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ24cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 24, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ23 inputs.
+ *
+ * @param in              IQ23 type inputs.
+ * @param out             IQ23 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ23cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 23, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ22 inputs.
+ *
+ * @param in              IQ22 type inputs.
+ * @param out             IQ22 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ22cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 22, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ21 inputs.
+ *
+ * @param in              IQ21 type inputs.
+ * @param out             IQ21 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ21cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 21, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ20 inputs.
+ *
+ * @param in              IQ20 type inputs.
+ * @param out             IQ20 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ20cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 20, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ19 inputs.
+ *
+ * @param in              IQ19 type inputs.
+ * @param out             IQ19 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ19cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 19, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ18 inputs.
+ *
+ * @param in              IQ18 type inputs.
+ * @param out             IQ18 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ18cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 18, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ17 inputs.
+ *
+ * @param in              IQ17 type inputs.
+ * @param out             IQ17 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ17cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 17, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ16 inputs.
+ *
+ * @param in              IQ16 type inputs.
+ * @param out             IQ16 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ16cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 16, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ15 inputs.
+ *
+ * @param in              IQ15 type inputs.
+ * @param out             IQ15 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ15cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 15, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ14 inputs.
+ *
+ * @param in              IQ14 type inputs.
+ * @param out             IQ14 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ14cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 14, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ13 inputs.
+ *
+ * @param in              IQ13 type inputs.
+ * @param out             IQ13 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ13cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 13, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ12 inputs.
+ *
+ * @param in              IQ12 type inputs.
+ * @param out             IQ12 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ12cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 12, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ11 inputs.
+ *
+ * @param in              IQ11 type inputs.
+ * @param out             IQ11 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ11cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 11, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ10 inputs.
+ *
+ * @param in              IQ10 type inputs.
+ * @param out             IQ10 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ10cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 10, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ9 inputs.
+ *
+ * @param in              IQ9 type inputs.
+ * @param out             IQ9 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ9cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 9, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ8 inputs.
+ *
+ * @param in              IQ8 type inputs.
+ * @param out             IQ8 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ8cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 8, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ7 inputs.
+ *
+ * @param in              IQ7 type inputs.
+ * @param out             IQ7 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ7cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 7, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ6 inputs.
+ *
+ * @param in              IQ6 type inputs.
+ * @param out             IQ6 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ6cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 6, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ5 inputs.
+ *
+ * @param in              IQ5 type inputs.
+ * @param out             IQ5 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ5cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 5, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ4 inputs.
+ *
+ * @param in              IQ4 type inputs.
+ * @param out             IQ4 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ4cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 4, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ3 inputs.
+ *
+ * @param in              IQ3 type inputs.
+ * @param out             IQ3 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ3cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 3, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ2 inputs.
+ *
+ * @param in              IQ2 type inputs.
+ * @param out             IQ2 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ2cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 2, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+/**
+ * @brief Computes the cosine of an array of IQ1 inputs.
+ *
+ * @param in              IQ1 type inputs.
+ * @param out             IQ1 type results of cosine, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ1cos_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsin_cos(in[i], 1, TYPE_COS, TYPE_RAD, ACCURACY_FULL);
+    }
+}
+
+/* IQ fast sin and cos functions, linear interpolation of the lookup tables */
+
+/**
+ * @brief Computes the sine of an IQ29 input, with reduced accuracy.
+ *
+ * @param a               IQ29 type input.
+ *
+ * @return                IQ29 type result of sine operation, in radians.
+ */
+int32_t _IQ29sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 29, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ28 input, with reduced accuracy.
+ *
+ * @param a               IQ28 type input.
+ *
+ * @return                IQ28 type result of sine operation, in radians.
+ */
+int32_t _IQ28sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 28, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ27 input, with reduced accuracy.
+ *
+ * @param a               IQ27 type input.
+ *
+ * @return                IQ27 type result of sine operation, in radians.
+ */
+int32_t _IQ27sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 27, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ26 input, with reduced accuracy.
+ *
+ * @param a               IQ26 type input.
+ *
+ * @return                IQ26 type result of sine operation, in radians.
+ */
+int32_t _IQ26sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 26, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ25 input, with reduced accuracy.
+ *
+ * @param a               IQ25 type input.
+ *
+ * @return                IQ25 type result of sine operation, in radians.
+ */
+int32_t _IQ25sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 25, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ24 input, with reduced accuracy.
+ *
+ * @param a               IQ24 type input.
+ *
+ * @return                IQ24 type result of sine operation, in radians.
+ */
+int32_t _IQ24sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 24, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ23 input, with reduced accuracy.
+ *
+ * @param a               IQ23 type input.
+ *
+ * @return                IQ23 type result of sine operation, in radians.
+ */
+int32_t _IQ23sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 23, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ22 input, with reduced accuracy.
+ *
+ * @param a               IQ22 type input.
+ *
+ * @return                IQ22 type result of sine operation, in radians.
+ */
+int32_t _IQ22sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 22, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ21 input, with reduced accuracy.
+ *
+ * @param a               IQ21 type input.
+ *
+ * @return                IQ21 type result of sine operation, in radians.
+ */
+int32_t _IQ21sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 21, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ20 input, with reduced accuracy.
+ *
+ * @param a               IQ20 type input.
+ *
+ * @return                IQ20 type result of sine operation, in radians.
+ */
+int32_t _IQ20sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 20, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ19 input, with reduced accuracy.
+ *
+ * @param a               IQ19 type input.
+ *
+ * @return                IQ19 type result of sine operation, in radians.
+ */
+int32_t _IQ19sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 19, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ18 input, with reduced accuracy.
+ *
+ * @param a               IQ18 type input.
+ *
+ * @return                IQ18 type result of sine operation, in radians.
+ */
+int32_t _IQ18sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 18, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ17 input, with reduced accuracy.
+ *
+ * @param a               IQ17 type input.
+ *
+ * @return                IQ17 type result of sine operation, in radians.
+ */
+int32_t _IQ17sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 17, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ16 input, with reduced accuracy.
+ *
+ * @param a               IQ16 type input.
+ *
+ * @return                IQ16 type result of sine operation, in radians.
+ */
+int32_t _IQ16sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 16, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ15 input, with reduced accuracy.
+ *
+ * @param a               IQ15 type input.
+ *
+ * @return                IQ15 type result of sine operation, in radians.
+ */
+int32_t _IQ15sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 15, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ14 input, with reduced accuracy.
+ *
+ * @param a               IQ14 type input.
+ *
+ * @return                IQ14 type result of sine operation, in radians.
+ */
+int32_t _IQ14sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 14, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ13 input, with reduced accuracy.
+ *
+ * @param a               IQ13 type input.
+ *
+ * @return                IQ13 type result of sine operation, in radians.
+ */
+int32_t _IQ13sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 13, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ12 input, with reduced accuracy.
+ *
+ * @param a               IQ12 type input.
+ *
+ * @return                IQ12 type result of sine operation, in radians.
+ */
+int32_t _IQ12sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 12, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ11 input, with reduced accuracy.
+ *
+ * @param a               IQ11 type input.
+ *
+ * @return                IQ11 type result of sine operation, in radians.
+ */
+int32_t _IQ11sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 11, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ10 input, with reduced accuracy.
+ *
+ * @param a               IQ10 type input.
+ *
+ * @return                IQ10 type result of sine operation, in radians.
+ */
+int32_t _IQ10sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 10, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ9 input, with reduced accuracy.
+ *
+ * @param a               IQ9 type input.
+ *
+ * @return                IQ9 type result of sine operation, in radians.
+ */
+int32_t _IQ9sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 9, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ8 input, with reduced accuracy.
+ *
+ * @param a               IQ8 type input.
+ *
+ * @return                IQ8 type result of sine operation, in radians.
+ */
+int32_t _IQ8sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 8, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ7 input, with reduced accuracy.
+ *
+ * @param a               IQ7 type input.
+ *
+ * @return                IQ7 type result of sine operation, in radians.
+ */
+int32_t _IQ7sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 7, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ6 input, with reduced accuracy.
+ *
+ * @param a               IQ6 type input.
+ *
+ * @return                IQ6 type result of sine operation, in radians.
+ */
+int32_t _IQ6sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 6, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ5 input, with reduced accuracy.
+ *
+ * @param a               IQ5 type input.
+ *
+ * @return                IQ5 type result of sine operation, in radians.
+ */
+int32_t _IQ5sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 5, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ4 input, with reduced accuracy.
+ *
+ * @param a               IQ4 type input.
+ *
+ * @return                IQ4 type result of sine operation, in radians.
+ */
+int32_t _IQ4sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 4, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ3 input, with reduced accuracy.
+ *
+ * @param a               IQ3 type input.
+ *
+ * @return                IQ3 type result of sine operation, in radians.
+ */
+int32_t _IQ3sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 3, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ2 input, with reduced accuracy.
+ *
+ * @param a               IQ2 type input.
+ *
+ * @return                IQ2 type result of sine operation, in radians.
+ */
+int32_t _IQ2sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 2, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the sine of an IQ1 input, with reduced accuracy.
+ *
+ * @param a               IQ1 type input.
+ *
+ * @return                IQ1 type result of sine operation, in radians.
+ */
+int32_t _IQ1sin_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 1, TYPE_SIN, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ29 input, with reduced accuracy.
+ *
+ * @param a               IQ29 type input.
+ *
+ * @return                IQ29 type result of cosine operation, in radians.
+ */
+int32_t _IQ29cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 29, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ28 input, with reduced accuracy.
+ *
+ * @param a               IQ28 type input.
+ *
+ * @return                IQ28 type result of cosine operation, in radians.
+ */
+int32_t _IQ28cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 28, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ27 input, with reduced accuracy.
+ *
+ * @param a               IQ27 type input.
+ *
+ * @return                IQ27 type result of cosine operation, in radians.
+ */
+int32_t _IQ27cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 27, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ26 input, with reduced accuracy.
+ *
+ * @param a               IQ26 type input.
+ *
+ * @return                IQ26 type result of cosine operation, in radians.
+ */
+int32_t _IQ26cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 26, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ25 input, with reduced accuracy.
+ *
+ * @param a               IQ25 type input.
+ *
+ * @return                IQ25 type result of cosine operation, in radians.
+ */
+int32_t _IQ25cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 25, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ24 input, with reduced accuracy.
+ *
+ * @param a               IQ24 type input.
+ *
+ * @return                IQ24 type result of cosine operation, in radians.
+ */
+int32_t _IQ24cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 24, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ23 input, with reduced accuracy.
+ *
+ * @param a               IQ23 type input.
+ *
+ * @return                IQ23 type result of cosine operation, in radians.
+ */
+int32_t _IQ23cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 23, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ22 input, with reduced accuracy.
+ *
+ * @param a               IQ22 type input.
+ *
+ * @return                IQ22 type result of cosine operation, in radians.
+ */
+int32_t _IQ22cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 22, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ21 input, with reduced accuracy.
+ *
+ * @param a               IQ21 type input.
+ *
+ * @return                IQ21 type result of cosine operation, in radians.
+ */
+int32_t _IQ21cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 21, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ20 input, with reduced accuracy.
+ *
+ * @param a               IQ20 type input.
+ *
+ * @return                IQ20 type result of cosine operation, in radians.
+ */
+int32_t _IQ20cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 20, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ19 input, with reduced accuracy.
+ *
+ * @param a               IQ19 type input.
+ *
+ * @return                IQ19 type result of cosine operation, in radians.
+ */
+int32_t _IQ19cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 19, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ18 input, with reduced accuracy.
+ *
+ * @param a               IQ18 type input.
+ *
+ * @return                IQ18 type result of cosine operation, in radians.
+ */
+int32_t _IQ18cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 18, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ17 input, with reduced accuracy.
+ *
+ * @param a               IQ17 type input.
+ *
+ * @return                IQ17 type result of cosine operation, in radians.
+ */
+int32_t _IQ17cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 17, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ16 input, with reduced accuracy.
+ *
+ * @param a               IQ16 type input.
+ *
+ * @return                IQ16 type result of cosine operation, in radians.
+ */
+int32_t _IQ16cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 16, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ15 input, with reduced accuracy.
+ *
+ * @param a               IQ15 type input.
+ *
+ * @return                IQ15 type result of cosine operation, in radians.
+ */
+int32_t _IQ15cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 15, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ14 input, with reduced accuracy.
+ *
+ * @param a               IQ14 type input.
+ *
+ * @return                IQ14 type result of cosine operation, in radians.
+ */
+int32_t _IQ14cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 14, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ13 input, with reduced accuracy.
+ *
+ * @param a               IQ13 type input.
+ *
+ * @return                IQ13 type result of cosine operation, in radians.
+ */
+int32_t _IQ13cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 13, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ12 input, with reduced accuracy.
+ *
+ * @param a               IQ12 type input.
+ *
+ * @return                IQ12 type result of cosine operation, in radians.
+ */
+int32_t _IQ12cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 12, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ11 input, with reduced accuracy.
+ *
+ * @param a               IQ11 type input.
+ *
+ * @return                IQ11 type result of cosine operation, in radians.
+ */
+int32_t _IQ11cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 11, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ10 input, with reduced accuracy.
+ *
+ * @param a               IQ10 type input.
+ *
+ * @return                IQ10 type result of cosine operation, in radians.
+ */
+int32_t _IQ10cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 10, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ9 input, with reduced accuracy.
+ *
+ * @param a               IQ9 type input.
+ *
+ * @return                IQ9 type result of cosine operation, in radians.
+ */
+int32_t _IQ9cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 9, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ8 input, with reduced accuracy.
+ *
+ * @param a               IQ8 type input.
+ *
+ * @return                IQ8 type result of cosine operation, in radians.
+ */
+int32_t _IQ8cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 8, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ7 input, with reduced accuracy.
+ *
+ * @param a               IQ7 type input.
+ *
+ * @return                IQ7 type result of cosine operation, in radians.
+ */
+int32_t _IQ7cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 7, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ6 input, with reduced accuracy.
+ *
+ * @param a               IQ6 type input.
+ *
+ * @return                IQ6 type result of cosine operation, in radians.
+ */
+int32_t _IQ6cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 6, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ5 input, with reduced accuracy.
+ *
+ * @param a               IQ5 type input.
+ *
+ * @return                IQ5 type result of cosine operation, in radians.
+ */
+int32_t _IQ5cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 5, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ4 input, with reduced accuracy.
+ *
+ * @param a               IQ4 type input.
+ *
+ * @return                IQ4 type result of cosine operation, in radians.
+ */
+int32_t _IQ4cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 4, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ3 input, with reduced accuracy.
+ *
+ * @param a               IQ3 type input.
+ *
+ * @return                IQ3 type result of cosine operation, in radians.
+ */
+int32_t _IQ3cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 3, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ2 input, with reduced accuracy.
+ *
+ * @param a               IQ2 type input.
+ *
+ * @return                IQ2 type result of cosine operation, in radians.
+ */
+int32_t _IQ2cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 2, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
+}
+/**
+ * @brief Computes the cosine of an IQ1 input, with reduced accuracy.
+ *
+ * @param a               IQ1 type input.
+ *
+ * @return                IQ1 type result of cosine operation, in radians.
+ */
+int32_t _IQ1cos_fast(int32_t a)
+{
+    return __IQNsin_cos(a, 1, TYPE_COS, TYPE_RAD, ACCURACY_FAST);
 }
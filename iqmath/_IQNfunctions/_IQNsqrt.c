@@ -6,6 +6,7 @@
  *  <hr>
  ******************************************************************************/
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "../support/support.h"
@@ -1746,3 +1747,408 @@ int32_t _IQ1imag(int32_t a, int32_t b)
 {
     return __IQNsqrt(a, b, 1, TYPE_IMAG);
 }
+
+/**
+ * @brief Computes the square root of an array of IQ30 inputs.
+ *
+ * @param in              IQ30 type inputs.
+ * @param out             IQ30 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ30sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 30, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ29 inputs.
+ *
+ * @param in              IQ29 type inputs.
+ * @param out             IQ29 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ29sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 29, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ28 inputs.
+ *
+ * @param in              IQ28 type inputs.
+ * @param out             IQ28 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ28sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 28, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ27 inputs.
+ *
+ * @param in              IQ27 type inputs.
+ * @param out             IQ27 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ27sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 27, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ26 inputs.
+ *
+ * @param in              IQ26 type inputs.
+ * @param out             IQ26 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ26sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 26, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ25 inputs.
+ *
+ * @param in              IQ25 type inputs.
+ * @param out             IQ25 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ25sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 25, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ24 inputs.
+ *
+ * @param in              IQ24 type inputs.
+ * @param out             IQ24 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ24sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 24, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ23 inputs.
+ *
+ * @param in              IQ23 type inputs.
+ * @param out             IQ23 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ23sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 23, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ22 inputs.
+ *
+ * @param in              IQ22 type inputs.
+ * @param out             IQ22 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ22sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 22, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ21 inputs.
+ *
+ * @param in              IQ21 type inputs.
+ * @param out             IQ21 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ21sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 21, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ20 inputs.
+ *
+ * @param in              IQ20 type inputs.
+ * @param out             IQ20 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ20sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 20, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ19 inputs.
+ *
+ * @param in              IQ19 type inputs.
+ * @param out             IQ19 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ19sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 19, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ18 inputs.
+ *
+ * @param in              IQ18 type inputs.
+ * @param out             IQ18 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ18sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 18, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ17 inputs.
+ *
+ * @param in              IQ17 type inputs.
+ * @param out             IQ17 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ17sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 17, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ16 inputs.
+ *
+ * @param in              IQ16 type inputs.
+ * @param out             IQ16 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ16sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 16, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ15 inputs.
+ *
+ * @param in              IQ15 type inputs.
+ * @param out             IQ15 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ15sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 15, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ14 inputs.
+ *
+ * @param in              IQ14 type inputs.
+ * @param out             IQ14 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ14sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 14, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ13 inputs.
+ *
+ * @param in              IQ13 type inputs.
+ * @param out             IQ13 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ13sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 13, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ12 inputs.
+ *
+ * @param in              IQ12 type inputs.
+ * @param out             IQ12 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ12sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 12, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ11 inputs.
+ *
+ * @param in              IQ11 type inputs.
+ * @param out             IQ11 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ11sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 11, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ10 inputs.
+ *
+ * @param in              IQ10 type inputs.
+ * @param out             IQ10 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ10sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 10, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ9 inputs.
+ *
+ * @param in              IQ9 type inputs.
+ * @param out             IQ9 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ9sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 9, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ8 inputs.
+ *
+ * @param in              IQ8 type inputs.
+ * @param out             IQ8 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ8sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 8, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ7 inputs.
+ *
+ * @param in              IQ7 type inputs.
+ * @param out             IQ7 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ7sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 7, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ6 inputs.
+ *
+ * @param in              IQ6 type inputs.
+ * @param out             IQ6 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ6sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 6, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ5 inputs.
+ *
+ * @param in              IQ5 type inputs.
+ * @param out             IQ5 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ5sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 5, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ4 inputs.
+ *
+ * @param in              IQ4 type inputs.
+ * @param out             IQ4 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ4sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 4, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ3 inputs.
+ *
+ * @param in              IQ3 type inputs.
+ * @param out             IQ3 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ3sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 3, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ2 inputs.
+ *
+ * @param in              IQ2 type inputs.
+ * @param out             IQ2 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ2sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 2, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the square root of an array of IQ1 inputs.
+ *
+ * @param in              IQ1 type inputs.
+ * @param out             IQ1 type results of square root, can be the same array as in.
+ * @param n               Number of elements.
+ */
+void _IQ1sqrt_array(const int32_t *in, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(in[i], 0, 1, TYPE_SQRT);
+    }
+}
+/**
+ * @brief Computes the magnitude of arrays of two orthogonal inputs.
+ *
+ * @param a               IQN type inputs.
+ * @param b               IQN type inputs.
+ * @param out             IQN type results of magnitude, can be the same array as a or b.
+ * @param n               Number of elements.
+ */
+void _IQmag_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = __IQNsqrt(a[i], b[i], 31, TYPE_MAG);
+    }
+}
@@ -5,6 +5,8 @@
 
 /* LOG lookup and coefficient tables. */
 #define _IQ30log_order  14
+/* Order of the fast log functions, the error is below 1.5*(1/3)^7/7 (1e-4). */
+#define _IQ30log_order_fast 6
 extern const uint_fast32_t _IQNlog_min[5];
 extern const uint_fast32_t _IQ30log_coeffs[15];
 
@@ -20,6 +22,8 @@ extern const int_fast32_t _IQ32atan_coeffs[132];
 
 /* Tables for exp function. Min/Max and integer lookup for each q type */
 #define _IQ30exp_order  10
+/* Order of the fast exp functions, the relative error is below 2*ln(2)^7/7! (3.1e-5). */
+#define _IQ30exp_order_fast 6
 extern const uint_fast32_t _IQNexp_min[30];
 extern const uint_fast32_t _IQNexp_max[30];
 extern const uint_fast16_t _IQNexp_offset[30];
@@ -6516,6 +6516,1305 @@ extern int16_t _IQ1toa(char *string, const char *format, _iq1 input);
  */
 #define _IQabs(A)               (((A) < 0) ? - (A) : (A))
 
+//*****************************************************************************
+//
+// Array versions of functions, computing the results for whole buffers at
+// once. The output array can be the same as an input array.
+//
+//*****************************************************************************
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+extern void _IQ29sin_array(const _iq29 *in, _iq29 *out, size_t n);
+extern void _IQ28sin_array(const _iq28 *in, _iq28 *out, size_t n);
+extern void _IQ27sin_array(const _iq27 *in, _iq27 *out, size_t n);
+extern void _IQ26sin_array(const _iq26 *in, _iq26 *out, size_t n);
+extern void _IQ25sin_array(const _iq25 *in, _iq25 *out, size_t n);
+extern void _IQ24sin_array(const _iq24 *in, _iq24 *out, size_t n);
+extern void _IQ23sin_array(const _iq23 *in, _iq23 *out, size_t n);
+extern void _IQ22sin_array(const _iq22 *in, _iq22 *out, size_t n);
+extern void _IQ21sin_array(const _iq21 *in, _iq21 *out, size_t n);
+extern void _IQ20sin_array(const _iq20 *in, _iq20 *out, size_t n);
+extern void _IQ19sin_array(const _iq19 *in, _iq19 *out, size_t n);
+extern void _IQ18sin_array(const _iq18 *in, _iq18 *out, size_t n);
+extern void _IQ17sin_array(const _iq17 *in, _iq17 *out, size_t n);
+extern void _IQ16sin_array(const _iq16 *in, _iq16 *out, size_t n);
+extern void _IQ15sin_array(const _iq15 *in, _iq15 *out, size_t n);
+extern void _IQ14sin_array(const _iq14 *in, _iq14 *out, size_t n);
+extern void _IQ13sin_array(const _iq13 *in, _iq13 *out, size_t n);
+extern void _IQ12sin_array(const _iq12 *in, _iq12 *out, size_t n);
+extern void _IQ11sin_array(const _iq11 *in, _iq11 *out, size_t n);
+extern void _IQ10sin_array(const _iq10 *in, _iq10 *out, size_t n);
+extern void _IQ9sin_array(const _iq9 *in, _iq9 *out, size_t n);
+extern void _IQ8sin_array(const _iq8 *in, _iq8 *out, size_t n);
+extern void _IQ7sin_array(const _iq7 *in, _iq7 *out, size_t n);
+extern void _IQ6sin_array(const _iq6 *in, _iq6 *out, size_t n);
+extern void _IQ5sin_array(const _iq5 *in, _iq5 *out, size_t n);
+extern void _IQ4sin_array(const _iq4 *in, _iq4 *out, size_t n);
+extern void _IQ3sin_array(const _iq3 *in, _iq3 *out, size_t n);
+extern void _IQ2sin_array(const _iq2 *in, _iq2 *out, size_t n);
+extern void _IQ1sin_array(const _iq1 *in, _iq1 *out, size_t n);
+extern void _IQ29cos_array(const _iq29 *in, _iq29 *out, size_t n);
+extern void _IQ28cos_array(const _iq28 *in, _iq28 *out, size_t n);
+extern void _IQ27cos_array(const _iq27 *in, _iq27 *out, size_t n);
+extern void _IQ26cos_array(const _iq26 *in, _iq26 *out, size_t n);
+extern void _IQ25cos_array(const _iq25 *in, _iq25 *out, size_t n);
+extern void _IQ24cos_array(const _iq24 *in, _iq24 *out, size_t n);
+extern void _IQ23cos_array(const _iq23 *in, _iq23 *out, size_t n);
+extern void _IQ22cos_array(const _iq22 *in, _iq22 *out, size_t n);
+extern void _IQ21cos_array(const _iq21 *in, _iq21 *out, size_t n);
+extern void _IQ20cos_array(const _iq20 *in, _iq20 *out, size_t n);
+extern void _IQ19cos_array(const _iq19 *in, _iq19 *out, size_t n);
+extern void _IQ18cos_array(const _iq18 *in, _iq18 *out, size_t n);
+extern void _IQ17cos_array(const _iq17 *in, _iq17 *out, size_t n);
+extern void _IQ16cos_array(const _iq16 *in, _iq16 *out, size_t n);
+extern void _IQ15cos_array(const _iq15 *in, _iq15 *out, size_t n);
+extern void _IQ14cos_array(const _iq14 *in, _iq14 *out, size_t n);
+extern void _IQ13cos_array(const _iq13 *in, _iq13 *out, size_t n);
+extern void _IQ12cos_array(const _iq12 *in, _iq12 *out, size_t n);
+extern void _IQ11cos_array(const _iq11 *in, _iq11 *out, size_t n);
+extern void _IQ10cos_array(const _iq10 *in, _iq10 *out, size_t n);
+extern void _IQ9cos_array(const _iq9 *in, _iq9 *out, size_t n);
+extern void _IQ8cos_array(const _iq8 *in, _iq8 *out, size_t n);
+extern void _IQ7cos_array(const _iq7 *in, _iq7 *out, size_t n);
+extern void _IQ6cos_array(const _iq6 *in, _iq6 *out, size_t n);
+extern void _IQ5cos_array(const _iq5 *in, _iq5 *out, size_t n);
+extern void _IQ4cos_array(const _iq4 *in, _iq4 *out, size_t n);
+extern void _IQ3cos_array(const _iq3 *in, _iq3 *out, size_t n);
+extern void _IQ2cos_array(const _iq2 *in, _iq2 *out, size_t n);
+extern void _IQ1cos_array(const _iq1 *in, _iq1 *out, size_t n);
+extern void _IQ30sqrt_array(const _iq30 *in, _iq30 *out, size_t n);
+extern void _IQ29sqrt_array(const _iq29 *in, _iq29 *out, size_t n);
+extern void _IQ28sqrt_array(const _iq28 *in, _iq28 *out, size_t n);
+extern void _IQ27sqrt_array(const _iq27 *in, _iq27 *out, size_t n);
+extern void _IQ26sqrt_array(const _iq26 *in, _iq26 *out, size_t n);
+extern void _IQ25sqrt_array(const _iq25 *in, _iq25 *out, size_t n);
+extern void _IQ24sqrt_array(const _iq24 *in, _iq24 *out, size_t n);
+extern void _IQ23sqrt_array(const _iq23 *in, _iq23 *out, size_t n);
+extern void _IQ22sqrt_array(const _iq22 *in, _iq22 *out, size_t n);
+extern void _IQ21sqrt_array(const _iq21 *in, _iq21 *out, size_t n);
+extern void _IQ20sqrt_array(const _iq20 *in, _iq20 *out, size_t n);
+extern void _IQ19sqrt_array(const _iq19 *in, _iq19 *out, size_t n);
+extern void _IQ18sqrt_array(const _iq18 *in, _iq18 *out, size_t n);
+extern void _IQ17sqrt_array(const _iq17 *in, _iq17 *out, size_t n);
+extern void _IQ16sqrt_array(const _iq16 *in, _iq16 *out, size_t n);
+extern void _IQ15sqrt_array(const _iq15 *in, _iq15 *out, size_t n);
+extern void _IQ14sqrt_array(const _iq14 *in, _iq14 *out, size_t n);
+extern void _IQ13sqrt_array(const _iq13 *in, _iq13 *out, size_t n);
+extern void _IQ12sqrt_array(const _iq12 *in, _iq12 *out, size_t n);
+extern void _IQ11sqrt_array(const _iq11 *in, _iq11 *out, size_t n);
+extern void _IQ10sqrt_array(const _iq10 *in, _iq10 *out, size_t n);
+extern void _IQ9sqrt_array(const _iq9 *in, _iq9 *out, size_t n);
+extern void _IQ8sqrt_array(const _iq8 *in, _iq8 *out, size_t n);
+extern void _IQ7sqrt_array(const _iq7 *in, _iq7 *out, size_t n);
+extern void _IQ6sqrt_array(const _iq6 *in, _iq6 *out, size_t n);
+extern void _IQ5sqrt_array(const _iq5 *in, _iq5 *out, size_t n);
+extern void _IQ4sqrt_array(const _iq4 *in, _iq4 *out, size_t n);
+extern void _IQ3sqrt_array(const _iq3 *in, _iq3 *out, size_t n);
+extern void _IQ2sqrt_array(const _iq2 *in, _iq2 *out, size_t n);
+extern void _IQ1sqrt_array(const _iq1 *in, _iq1 *out, size_t n);
+extern void _IQ29atan2_array(const _iq29 *y, const _iq29 *x, _iq29 *out, size_t n);
+extern void _IQ28atan2_array(const _iq28 *y, const _iq28 *x, _iq28 *out, size_t n);
+extern void _IQ27atan2_array(const _iq27 *y, const _iq27 *x, _iq27 *out, size_t n);
+extern void _IQ26atan2_array(const _iq26 *y, const _iq26 *x, _iq26 *out, size_t n);
+extern void _IQ25atan2_array(const _iq25 *y, const _iq25 *x, _iq25 *out, size_t n);
+extern void _IQ24atan2_array(const _iq24 *y, const _iq24 *x, _iq24 *out, size_t n);
+extern void _IQ23atan2_array(const _iq23 *y, const _iq23 *x, _iq23 *out, size_t n);
+extern void _IQ22atan2_array(const _iq22 *y, const _iq22 *x, _iq22 *out, size_t n);
+extern void _IQ21atan2_array(const _iq21 *y, const _iq21 *x, _iq21 *out, size_t n);
+extern void _IQ20atan2_array(const _iq20 *y, const _iq20 *x, _iq20 *out, size_t n);
+extern void _IQ19atan2_array(const _iq19 *y, const _iq19 *x, _iq19 *out, size_t n);
+extern void _IQ18atan2_array(const _iq18 *y, const _iq18 *x, _iq18 *out, size_t n);
+extern void _IQ17atan2_array(const _iq17 *y, const _iq17 *x, _iq17 *out, size_t n);
+extern void _IQ16atan2_array(const _iq16 *y, const _iq16 *x, _iq16 *out, size_t n);
+extern void _IQ15atan2_array(const _iq15 *y, const _iq15 *x, _iq15 *out, size_t n);
+extern void _IQ14atan2_array(const _iq14 *y, const _iq14 *x, _iq14 *out, size_t n);
+extern void _IQ13atan2_array(const _iq13 *y, const _iq13 *x, _iq13 *out, size_t n);
+extern void _IQ12atan2_array(const _iq12 *y, const _iq12 *x, _iq12 *out, size_t n);
+extern void _IQ11atan2_array(const _iq11 *y, const _iq11 *x, _iq11 *out, size_t n);
+extern void _IQ10atan2_array(const _iq10 *y, const _iq10 *x, _iq10 *out, size_t n);
+extern void _IQ9atan2_array(const _iq9 *y, const _iq9 *x, _iq9 *out, size_t n);
+extern void _IQ8atan2_array(const _iq8 *y, const _iq8 *x, _iq8 *out, size_t n);
+extern void _IQ7atan2_array(const _iq7 *y, const _iq7 *x, _iq7 *out, size_t n);
+extern void _IQ6atan2_array(const _iq6 *y, const _iq6 *x, _iq6 *out, size_t n);
+extern void _IQ5atan2_array(const _iq5 *y, const _iq5 *x, _iq5 *out, size_t n);
+extern void _IQ4atan2_array(const _iq4 *y, const _iq4 *x, _iq4 *out, size_t n);
+extern void _IQ3atan2_array(const _iq3 *y, const _iq3 *x, _iq3 *out, size_t n);
+extern void _IQ2atan2_array(const _iq2 *y, const _iq2 *x, _iq2 *out, size_t n);
+extern void _IQ1atan2_array(const _iq1 *y, const _iq1 *x, _iq1 *out, size_t n);
+extern void _IQ30div_array(const _iq30 *a, const _iq30 *b, _iq30 *out, size_t n);
+extern void _IQ29div_array(const _iq29 *a, const _iq29 *b, _iq29 *out, size_t n);
+extern void _IQ28div_array(const _iq28 *a, const _iq28 *b, _iq28 *out, size_t n);
+extern void _IQ27div_array(const _iq27 *a, const _iq27 *b, _iq27 *out, size_t n);
+extern void _IQ26div_array(const _iq26 *a, const _iq26 *b, _iq26 *out, size_t n);
+extern void _IQ25div_array(const _iq25 *a, const _iq25 *b, _iq25 *out, size_t n);
+extern void _IQ24div_array(const _iq24 *a, const _iq24 *b, _iq24 *out, size_t n);
+extern void _IQ23div_array(const _iq23 *a, const _iq23 *b, _iq23 *out, size_t n);
+extern void _IQ22div_array(const _iq22 *a, const _iq22 *b, _iq22 *out, size_t n);
+extern void _IQ21div_array(const _iq21 *a, const _iq21 *b, _iq21 *out, size_t n);
+extern void _IQ20div_array(const _iq20 *a, const _iq20 *b, _iq20 *out, size_t n);
+extern void _IQ19div_array(const _iq19 *a, const _iq19 *b, _iq19 *out, size_t n);
+extern void _IQ18div_array(const _iq18 *a, const _iq18 *b, _iq18 *out, size_t n);
+extern void _IQ17div_array(const _iq17 *a, const _iq17 *b, _iq17 *out, size_t n);
+extern void _IQ16div_array(const _iq16 *a, const _iq16 *b, _iq16 *out, size_t n);
+extern void _IQ15div_array(const _iq15 *a, const _iq15 *b, _iq15 *out, size_t n);
+extern void _IQ14div_array(const _iq14 *a, const _iq14 *b, _iq14 *out, size_t n);
+extern void _IQ13div_array(const _iq13 *a, const _iq13 *b, _iq13 *out, size_t n);
+extern void _IQ12div_array(const _iq12 *a, const _iq12 *b, _iq12 *out, size_t n);
+extern void _IQ11div_array(const _iq11 *a, const _iq11 *b, _iq11 *out, size_t n);
+extern void _IQ10div_array(const _iq10 *a, const _iq10 *b, _iq10 *out, size_t n);
+extern void _IQ9div_array(const _iq9 *a, const _iq9 *b, _iq9 *out, size_t n);
+extern void _IQ8div_array(const _iq8 *a, const _iq8 *b, _iq8 *out, size_t n);
+extern void _IQ7div_array(const _iq7 *a, const _iq7 *b, _iq7 *out, size_t n);
+extern void _IQ6div_array(const _iq6 *a, const _iq6 *b, _iq6 *out, size_t n);
+extern void _IQ5div_array(const _iq5 *a, const _iq5 *b, _iq5 *out, size_t n);
+extern void _IQ4div_array(const _iq4 *a, const _iq4 *b, _iq4 *out, size_t n);
+extern void _IQ3div_array(const _iq3 *a, const _iq3 *b, _iq3 *out, size_t n);
+extern void _IQ2div_array(const _iq2 *a, const _iq2 *b, _iq2 *out, size_t n);
+extern void _IQ1div_array(const _iq1 *a, const _iq1 *b, _iq1 *out, size_t n);
+extern void _IQ30mpy_array(const _iq30 *a, const _iq30 *b, _iq30 *out, size_t n);
+extern void _IQ29mpy_array(const _iq29 *a, const _iq29 *b, _iq29 *out, size_t n);
+extern void _IQ28mpy_array(const _iq28 *a, const _iq28 *b, _iq28 *out, size_t n);
+extern void _IQ27mpy_array(const _iq27 *a, const _iq27 *b, _iq27 *out, size_t n);
+extern void _IQ26mpy_array(const _iq26 *a, const _iq26 *b, _iq26 *out, size_t n);
+extern void _IQ25mpy_array(const _iq25 *a, const _iq25 *b, _iq25 *out, size_t n);
+extern void _IQ24mpy_array(const _iq24 *a, const _iq24 *b, _iq24 *out, size_t n);
+extern void _IQ23mpy_array(const _iq23 *a, const _iq23 *b, _iq23 *out, size_t n);
+extern void _IQ22mpy_array(const _iq22 *a, const _iq22 *b, _iq22 *out, size_t n);
+extern void _IQ21mpy_array(const _iq21 *a, const _iq21 *b, _iq21 *out, size_t n);
+extern void _IQ20mpy_array(const _iq20 *a, const _iq20 *b, _iq20 *out, size_t n);
+extern void _IQ19mpy_array(const _iq19 *a, const _iq19 *b, _iq19 *out, size_t n);
+extern void _IQ18mpy_array(const _iq18 *a, const _iq18 *b, _iq18 *out, size_t n);
+extern void _IQ17mpy_array(const _iq17 *a, const _iq17 *b, _iq17 *out, size_t n);
+extern void _IQ16mpy_array(const _iq16 *a, const _iq16 *b, _iq16 *out, size_t n);
+extern void _IQ15mpy_array(const _iq15 *a, const _iq15 *b, _iq15 *out, size_t n);
+extern void _IQ14mpy_array(const _iq14 *a, const _iq14 *b, _iq14 *out, size_t n);
+extern void _IQ13mpy_array(const _iq13 *a, const _iq13 *b, _iq13 *out, size_t n);
+extern void _IQ12mpy_array(const _iq12 *a, const _iq12 *b, _iq12 *out, size_t n);
+extern void _IQ11mpy_array(const _iq11 *a, const _iq11 *b, _iq11 *out, size_t n);
+extern void _IQ10mpy_array(const _iq10 *a, const _iq10 *b, _iq10 *out, size_t n);
+extern void _IQ9mpy_array(const _iq9 *a, const _iq9 *b, _iq9 *out, size_t n);
+extern void _IQ8mpy_array(const _iq8 *a, const _iq8 *b, _iq8 *out, size_t n);
+extern void _IQ7mpy_array(const _iq7 *a, const _iq7 *b, _iq7 *out, size_t n);
+extern void _IQ6mpy_array(const _iq6 *a, const _iq6 *b, _iq6 *out, size_t n);
+extern void _IQ5mpy_array(const _iq5 *a, const _iq5 *b, _iq5 *out, size_t n);
+extern void _IQ4mpy_array(const _iq4 *a, const _iq4 *b, _iq4 *out, size_t n);
+extern void _IQ3mpy_array(const _iq3 *a, const _iq3 *b, _iq3 *out, size_t n);
+extern void _IQ2mpy_array(const _iq2 *a, const _iq2 *b, _iq2 *out, size_t n);
+extern void _IQ1mpy_array(const _iq1 *a, const _iq1 *b, _iq1 *out, size_t n);
+extern void _IQmag_array(const int32_t *a, const int32_t *b, int32_t *out, size_t n);
+#endif /* DOXYGEN_SHOULD_SKIP_THIS */
+
+/**
+ * @brief Computes the sine of an array of global IQ format inputs.
+ *
+ * @param in               Global IQ format inputs.
+ * @param out              Global IQ format results of sine.
+ * @param n                Number of elements.
+ */
+#if GLOBAL_IQ == 29
+#define _IQsin_array(in, out, n)        _IQ29sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQsin_array(in, out, n)        _IQ28sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQsin_array(in, out, n)        _IQ27sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQsin_array(in, out, n)        _IQ26sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQsin_array(in, out, n)        _IQ25sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQsin_array(in, out, n)        _IQ24sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQsin_array(in, out, n)        _IQ23sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQsin_array(in, out, n)        _IQ22sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQsin_array(in, out, n)        _IQ21sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQsin_array(in, out, n)        _IQ20sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQsin_array(in, out, n)        _IQ19sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQsin_array(in, out, n)        _IQ18sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQsin_array(in, out, n)        _IQ17sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQsin_array(in, out, n)        _IQ16sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQsin_array(in, out, n)        _IQ15sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQsin_array(in, out, n)        _IQ14sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQsin_array(in, out, n)        _IQ13sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQsin_array(in, out, n)        _IQ12sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQsin_array(in, out, n)        _IQ11sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQsin_array(in, out, n)        _IQ10sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQsin_array(in, out, n)        _IQ9sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQsin_array(in, out, n)        _IQ8sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQsin_array(in, out, n)        _IQ7sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQsin_array(in, out, n)        _IQ6sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQsin_array(in, out, n)        _IQ5sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQsin_array(in, out, n)        _IQ4sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQsin_array(in, out, n)        _IQ3sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQsin_array(in, out, n)        _IQ2sin_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQsin_array(in, out, n)        _IQ1sin_array(in, out, n)
+#endif
+
+/**
+ * @brief Computes the cosine of an array of global IQ format inputs.
+ *
+ * @param in               Global IQ format inputs.
+ * @param out              Global IQ format results of cosine.
+ * @param n                Number of elements.
+ */
+#if GLOBAL_IQ == 29
+#define _IQcos_array(in, out, n)        _IQ29cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQcos_array(in, out, n)        _IQ28cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQcos_array(in, out, n)        _IQ27cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQcos_array(in, out, n)        _IQ26cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQcos_array(in, out, n)        _IQ25cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQcos_array(in, out, n)        _IQ24cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQcos_array(in, out, n)        _IQ23cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQcos_array(in, out, n)        _IQ22cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQcos_array(in, out, n)        _IQ21cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQcos_array(in, out, n)        _IQ20cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQcos_array(in, out, n)        _IQ19cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQcos_array(in, out, n)        _IQ18cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQcos_array(in, out, n)        _IQ17cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQcos_array(in, out, n)        _IQ16cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQcos_array(in, out, n)        _IQ15cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQcos_array(in, out, n)        _IQ14cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQcos_array(in, out, n)        _IQ13cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQcos_array(in, out, n)        _IQ12cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQcos_array(in, out, n)        _IQ11cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQcos_array(in, out, n)        _IQ10cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQcos_array(in, out, n)        _IQ9cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQcos_array(in, out, n)        _IQ8cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQcos_array(in, out, n)        _IQ7cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQcos_array(in, out, n)        _IQ6cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQcos_array(in, out, n)        _IQ5cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQcos_array(in, out, n)        _IQ4cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQcos_array(in, out, n)        _IQ3cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQcos_array(in, out, n)        _IQ2cos_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQcos_array(in, out, n)        _IQ1cos_array(in, out, n)
+#endif
+
+/**
+ * @brief Computes the square root of an array of global IQ format inputs.
+ *
+ * @param in               Global IQ format inputs.
+ * @param out              Global IQ format results of square root.
+ * @param n                Number of elements.
+ */
+#if GLOBAL_IQ == 30
+#define _IQsqrt_array(in, out, n)       _IQ30sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 29
+#define _IQsqrt_array(in, out, n)       _IQ29sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQsqrt_array(in, out, n)       _IQ28sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQsqrt_array(in, out, n)       _IQ27sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQsqrt_array(in, out, n)       _IQ26sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQsqrt_array(in, out, n)       _IQ25sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQsqrt_array(in, out, n)       _IQ24sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQsqrt_array(in, out, n)       _IQ23sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQsqrt_array(in, out, n)       _IQ22sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQsqrt_array(in, out, n)       _IQ21sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQsqrt_array(in, out, n)       _IQ20sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQsqrt_array(in, out, n)       _IQ19sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQsqrt_array(in, out, n)       _IQ18sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQsqrt_array(in, out, n)       _IQ17sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQsqrt_array(in, out, n)       _IQ16sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQsqrt_array(in, out, n)       _IQ15sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQsqrt_array(in, out, n)       _IQ14sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQsqrt_array(in, out, n)       _IQ13sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQsqrt_array(in, out, n)       _IQ12sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQsqrt_array(in, out, n)       _IQ11sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQsqrt_array(in, out, n)       _IQ10sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQsqrt_array(in, out, n)       _IQ9sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQsqrt_array(in, out, n)       _IQ8sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQsqrt_array(in, out, n)       _IQ7sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQsqrt_array(in, out, n)       _IQ6sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQsqrt_array(in, out, n)       _IQ5sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQsqrt_array(in, out, n)       _IQ4sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQsqrt_array(in, out, n)       _IQ3sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQsqrt_array(in, out, n)       _IQ2sqrt_array(in, out, n)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQsqrt_array(in, out, n)       _IQ1sqrt_array(in, out, n)
+#endif
+
+/**
+ * @brief Computes the 4-quadrant arctangent of arrays of global IQ format inputs.
+ *
+ * @param y                Global IQ format inputs y.
+ * @param x                Global IQ format inputs x.
+ * @param out              Global IQ format results of arctangent.
+ * @param n                Number of elements.
+ */
+#if GLOBAL_IQ == 29
+#define _IQatan2_array(y, x, out, n)    _IQ29atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQatan2_array(y, x, out, n)    _IQ28atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQatan2_array(y, x, out, n)    _IQ27atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQatan2_array(y, x, out, n)    _IQ26atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQatan2_array(y, x, out, n)    _IQ25atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQatan2_array(y, x, out, n)    _IQ24atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQatan2_array(y, x, out, n)    _IQ23atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQatan2_array(y, x, out, n)    _IQ22atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQatan2_array(y, x, out, n)    _IQ21atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQatan2_array(y, x, out, n)    _IQ20atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQatan2_array(y, x, out, n)    _IQ19atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQatan2_array(y, x, out, n)    _IQ18atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQatan2_array(y, x, out, n)    _IQ17atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQatan2_array(y, x, out, n)    _IQ16atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQatan2_array(y, x, out, n)    _IQ15atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQatan2_array(y, x, out, n)    _IQ14atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQatan2_array(y, x, out, n)    _IQ13atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQatan2_array(y, x, out, n)    _IQ12atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQatan2_array(y, x, out, n)    _IQ11atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQatan2_array(y, x, out, n)    _IQ10atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQatan2_array(y, x, out, n)    _IQ9atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQatan2_array(y, x, out, n)    _IQ8atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQatan2_array(y, x, out, n)    _IQ7atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQatan2_array(y, x, out, n)    _IQ6atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQatan2_array(y, x, out, n)    _IQ5atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQatan2_array(y, x, out, n)    _IQ4atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQatan2_array(y, x, out, n)    _IQ3atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQatan2_array(y, x, out, n)    _IQ2atan2_array(y, x, out, n)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQatan2_array(y, x, out, n)    _IQ1atan2_array(y, x, out, n)
+#endif
+
+/**
+ * @brief Divides arrays of global IQ format numbers.
+ *
+ * @param a                Global IQ format numerators.
+ * @param b                Global IQ format denominators.
+ * @param out              Global IQ format results of the divisions.
+ * @param n                Number of elements.
+ */
+#if GLOBAL_IQ == 30
+#define _IQdiv_array(a, b, out, n)      _IQ30div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 29
+#define _IQdiv_array(a, b, out, n)      _IQ29div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQdiv_array(a, b, out, n)      _IQ28div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQdiv_array(a, b, out, n)      _IQ27div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQdiv_array(a, b, out, n)      _IQ26div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQdiv_array(a, b, out, n)      _IQ25div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQdiv_array(a, b, out, n)      _IQ24div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQdiv_array(a, b, out, n)      _IQ23div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQdiv_array(a, b, out, n)      _IQ22div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQdiv_array(a, b, out, n)      _IQ21div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQdiv_array(a, b, out, n)      _IQ20div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQdiv_array(a, b, out, n)      _IQ19div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQdiv_array(a, b, out, n)      _IQ18div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQdiv_array(a, b, out, n)      _IQ17div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQdiv_array(a, b, out, n)      _IQ16div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQdiv_array(a, b, out, n)      _IQ15div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQdiv_array(a, b, out, n)      _IQ14div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQdiv_array(a, b, out, n)      _IQ13div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQdiv_array(a, b, out, n)      _IQ12div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQdiv_array(a, b, out, n)      _IQ11div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQdiv_array(a, b, out, n)      _IQ10div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQdiv_array(a, b, out, n)      _IQ9div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQdiv_array(a, b, out, n)      _IQ8div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQdiv_array(a, b, out, n)      _IQ7div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQdiv_array(a, b, out, n)      _IQ6div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQdiv_array(a, b, out, n)      _IQ5div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQdiv_array(a, b, out, n)      _IQ4div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQdiv_array(a, b, out, n)      _IQ3div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQdiv_array(a, b, out, n)      _IQ2div_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQdiv_array(a, b, out, n)      _IQ1div_array(a, b, out, n)
+#endif
+
+/**
+ * @brief Multiplies arrays of global IQ format numbers.
+ *
+ * @param a                Global IQ format numbers to be multiplied.
+ * @param b                Global IQ format numbers to be multiplied.
+ * @param out              Global IQ format results of the multiplications.
+ * @param n                Number of elements.
+ */
+#if GLOBAL_IQ == 30
+#define _IQmpy_array(a, b, out, n)      _IQ30mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 29
+#define _IQmpy_array(a, b, out, n)      _IQ29mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQmpy_array(a, b, out, n)      _IQ28mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQmpy_array(a, b, out, n)      _IQ27mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQmpy_array(a, b, out, n)      _IQ26mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQmpy_array(a, b, out, n)      _IQ25mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQmpy_array(a, b, out, n)      _IQ24mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQmpy_array(a, b, out, n)      _IQ23mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQmpy_array(a, b, out, n)      _IQ22mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQmpy_array(a, b, out, n)      _IQ21mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQmpy_array(a, b, out, n)      _IQ20mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQmpy_array(a, b, out, n)      _IQ19mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQmpy_array(a, b, out, n)      _IQ18mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQmpy_array(a, b, out, n)      _IQ17mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQmpy_array(a, b, out, n)      _IQ16mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQmpy_array(a, b, out, n)      _IQ15mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQmpy_array(a, b, out, n)      _IQ14mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQmpy_array(a, b, out, n)      _IQ13mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQmpy_array(a, b, out, n)      _IQ12mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQmpy_array(a, b, out, n)      _IQ11mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQmpy_array(a, b, out, n)      _IQ10mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQmpy_array(a, b, out, n)      _IQ9mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQmpy_array(a, b, out, n)      _IQ8mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQmpy_array(a, b, out, n)      _IQ7mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQmpy_array(a, b, out, n)      _IQ6mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQmpy_array(a, b, out, n)      _IQ5mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQmpy_array(a, b, out, n)      _IQ4mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQmpy_array(a, b, out, n)      _IQ3mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQmpy_array(a, b, out, n)      _IQ2mpy_array(a, b, out, n)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQmpy_array(a, b, out, n)      _IQ1mpy_array(a, b, out, n)
+#endif
+
+//*****************************************************************************
+//
+// Fast versions of functions, trading accuracy for speed:
+//  - sin and cos interpolate linearly between the lookup table values, with an
+//    error below 3.1e-5.
+//  - exp uses a Taylor series of order 6 instead of 10, with a relative error
+//    below 3.1e-5.
+//  - log uses a Taylor series of order 6 instead of 14, with an error below
+//    1e-4.
+// The result is also limited by the resolution of the IQ format.
+//
+//*****************************************************************************
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+extern _iq29 _IQ29sin_fast(_iq29 A);
+extern _iq28 _IQ28sin_fast(_iq28 A);
+extern _iq27 _IQ27sin_fast(_iq27 A);
+extern _iq26 _IQ26sin_fast(_iq26 A);
+extern _iq25 _IQ25sin_fast(_iq25 A);
+extern _iq24 _IQ24sin_fast(_iq24 A);
+extern _iq23 _IQ23sin_fast(_iq23 A);
+extern _iq22 _IQ22sin_fast(_iq22 A);
+extern _iq21 _IQ21sin_fast(_iq21 A);
+extern _iq20 _IQ20sin_fast(_iq20 A);
+extern _iq19 _IQ19sin_fast(_iq19 A);
+extern _iq18 _IQ18sin_fast(_iq18 A);
+extern _iq17 _IQ17sin_fast(_iq17 A);
+extern _iq16 _IQ16sin_fast(_iq16 A);
+extern _iq15 _IQ15sin_fast(_iq15 A);
+extern _iq14 _IQ14sin_fast(_iq14 A);
+extern _iq13 _IQ13sin_fast(_iq13 A);
+extern _iq12 _IQ12sin_fast(_iq12 A);
+extern _iq11 _IQ11sin_fast(_iq11 A);
+extern _iq10 _IQ10sin_fast(_iq10 A);
+extern _iq9 _IQ9sin_fast(_iq9 A);
+extern _iq8 _IQ8sin_fast(_iq8 A);
+extern _iq7 _IQ7sin_fast(_iq7 A);
+extern _iq6 _IQ6sin_fast(_iq6 A);
+extern _iq5 _IQ5sin_fast(_iq5 A);
+extern _iq4 _IQ4sin_fast(_iq4 A);
+extern _iq3 _IQ3sin_fast(_iq3 A);
+extern _iq2 _IQ2sin_fast(_iq2 A);
+extern _iq1 _IQ1sin_fast(_iq1 A);
+extern _iq29 _IQ29cos_fast(_iq29 A);
+extern _iq28 _IQ28cos_fast(_iq28 A);
+extern _iq27 _IQ27cos_fast(_iq27 A);
+extern _iq26 _IQ26cos_fast(_iq26 A);
+extern _iq25 _IQ25cos_fast(_iq25 A);
+extern _iq24 _IQ24cos_fast(_iq24 A);
+extern _iq23 _IQ23cos_fast(_iq23 A);
+extern _iq22 _IQ22cos_fast(_iq22 A);
+extern _iq21 _IQ21cos_fast(_iq21 A);
+extern _iq20 _IQ20cos_fast(_iq20 A);
+extern _iq19 _IQ19cos_fast(_iq19 A);
+extern _iq18 _IQ18cos_fast(_iq18 A);
+extern _iq17 _IQ17cos_fast(_iq17 A);
+extern _iq16 _IQ16cos_fast(_iq16 A);
+extern _iq15 _IQ15cos_fast(_iq15 A);
+extern _iq14 _IQ14cos_fast(_iq14 A);
+extern _iq13 _IQ13cos_fast(_iq13 A);
+extern _iq12 _IQ12cos_fast(_iq12 A);
+extern _iq11 _IQ11cos_fast(_iq11 A);
+extern _iq10 _IQ10cos_fast(_iq10 A);
+extern _iq9 _IQ9cos_fast(_iq9 A);
+extern _iq8 _IQ8cos_fast(_iq8 A);
+extern _iq7 _IQ7cos_fast(_iq7 A);
+extern _iq6 _IQ6cos_fast(_iq6 A);
+extern _iq5 _IQ5cos_fast(_iq5 A);
+extern _iq4 _IQ4cos_fast(_iq4 A);
+extern _iq3 _IQ3cos_fast(_iq3 A);
+extern _iq2 _IQ2cos_fast(_iq2 A);
+extern _iq1 _IQ1cos_fast(_iq1 A);
+extern _iq30 _IQ30exp_fast(_iq30 A);
+extern _iq29 _IQ29exp_fast(_iq29 A);
+extern _iq28 _IQ28exp_fast(_iq28 A);
+extern _iq27 _IQ27exp_fast(_iq27 A);
+extern _iq26 _IQ26exp_fast(_iq26 A);
+extern _iq25 _IQ25exp_fast(_iq25 A);
+extern _iq24 _IQ24exp_fast(_iq24 A);
+extern _iq23 _IQ23exp_fast(_iq23 A);
+extern _iq22 _IQ22exp_fast(_iq22 A);
+extern _iq21 _IQ21exp_fast(_iq21 A);
+extern _iq20 _IQ20exp_fast(_iq20 A);
+extern _iq19 _IQ19exp_fast(_iq19 A);
+extern _iq18 _IQ18exp_fast(_iq18 A);
+extern _iq17 _IQ17exp_fast(_iq17 A);
+extern _iq16 _IQ16exp_fast(_iq16 A);
+extern _iq15 _IQ15exp_fast(_iq15 A);
+extern _iq14 _IQ14exp_fast(_iq14 A);
+extern _iq13 _IQ13exp_fast(_iq13 A);
+extern _iq12 _IQ12exp_fast(_iq12 A);
+extern _iq11 _IQ11exp_fast(_iq11 A);
+extern _iq10 _IQ10exp_fast(_iq10 A);
+extern _iq9 _IQ9exp_fast(_iq9 A);
+extern _iq8 _IQ8exp_fast(_iq8 A);
+extern _iq7 _IQ7exp_fast(_iq7 A);
+extern _iq6 _IQ6exp_fast(_iq6 A);
+extern _iq5 _IQ5exp_fast(_iq5 A);
+extern _iq4 _IQ4exp_fast(_iq4 A);
+extern _iq3 _IQ3exp_fast(_iq3 A);
+extern _iq2 _IQ2exp_fast(_iq2 A);
+extern _iq1 _IQ1exp_fast(_iq1 A);
+extern _iq30 _IQ30log_fast(_iq30 A);
+extern _iq29 _IQ29log_fast(_iq29 A);
+extern _iq28 _IQ28log_fast(_iq28 A);
+extern _iq27 _IQ27log_fast(_iq27 A);
+extern _iq26 _IQ26log_fast(_iq26 A);
+extern _iq25 _IQ25log_fast(_iq25 A);
+extern _iq24 _IQ24log_fast(_iq24 A);
+extern _iq23 _IQ23log_fast(_iq23 A);
+extern _iq22 _IQ22log_fast(_iq22 A);
+extern _iq21 _IQ21log_fast(_iq21 A);
+extern _iq20 _IQ20log_fast(_iq20 A);
+extern _iq19 _IQ19log_fast(_iq19 A);
+extern _iq18 _IQ18log_fast(_iq18 A);
+extern _iq17 _IQ17log_fast(_iq17 A);
+extern _iq16 _IQ16log_fast(_iq16 A);
+extern _iq15 _IQ15log_fast(_iq15 A);
+extern _iq14 _IQ14log_fast(_iq14 A);
+extern _iq13 _IQ13log_fast(_iq13 A);
+extern _iq12 _IQ12log_fast(_iq12 A);
+extern _iq11 _IQ11log_fast(_iq11 A);
+extern _iq10 _IQ10log_fast(_iq10 A);
+extern _iq9 _IQ9log_fast(_iq9 A);
+extern _iq8 _IQ8log_fast(_iq8 A);
+extern _iq7 _IQ7log_fast(_iq7 A);
+extern _iq6 _IQ6log_fast(_iq6 A);
+extern _iq5 _IQ5log_fast(_iq5 A);
+extern _iq4 _IQ4log_fast(_iq4 A);
+extern _iq3 _IQ3log_fast(_iq3 A);
+extern _iq2 _IQ2log_fast(_iq2 A);
+extern _iq1 _IQ1log_fast(_iq1 A);
+#endif /* DOXYGEN_SHOULD_SKIP_THIS */
+
+/**
+ * @brief Computes the sine of a global IQ format input, with reduced accuracy.
+ *
+ * @param A               Global IQ format input.
+ *
+ * @return                Global IQ format result of sine, in radians.
+ */
+#if GLOBAL_IQ == 29
+#define _IQsin_fast(A)          _IQ29sin_fast(A)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQsin_fast(A)          _IQ28sin_fast(A)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQsin_fast(A)          _IQ27sin_fast(A)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQsin_fast(A)          _IQ26sin_fast(A)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQsin_fast(A)          _IQ25sin_fast(A)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQsin_fast(A)          _IQ24sin_fast(A)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQsin_fast(A)          _IQ23sin_fast(A)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQsin_fast(A)          _IQ22sin_fast(A)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQsin_fast(A)          _IQ21sin_fast(A)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQsin_fast(A)          _IQ20sin_fast(A)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQsin_fast(A)          _IQ19sin_fast(A)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQsin_fast(A)          _IQ18sin_fast(A)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQsin_fast(A)          _IQ17sin_fast(A)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQsin_fast(A)          _IQ16sin_fast(A)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQsin_fast(A)          _IQ15sin_fast(A)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQsin_fast(A)          _IQ14sin_fast(A)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQsin_fast(A)          _IQ13sin_fast(A)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQsin_fast(A)          _IQ12sin_fast(A)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQsin_fast(A)          _IQ11sin_fast(A)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQsin_fast(A)          _IQ10sin_fast(A)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQsin_fast(A)          _IQ9sin_fast(A)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQsin_fast(A)          _IQ8sin_fast(A)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQsin_fast(A)          _IQ7sin_fast(A)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQsin_fast(A)          _IQ6sin_fast(A)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQsin_fast(A)          _IQ5sin_fast(A)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQsin_fast(A)          _IQ4sin_fast(A)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQsin_fast(A)          _IQ3sin_fast(A)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQsin_fast(A)          _IQ2sin_fast(A)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQsin_fast(A)          _IQ1sin_fast(A)
+#endif
+
+/**
+ * @brief Computes the cosine of a global IQ format input, with reduced accuracy.
+ *
+ * @param A               Global IQ format input.
+ *
+ * @return                Global IQ format result of cosine, in radians.
+ */
+#if GLOBAL_IQ == 29
+#define _IQcos_fast(A)          _IQ29cos_fast(A)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQcos_fast(A)          _IQ28cos_fast(A)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQcos_fast(A)          _IQ27cos_fast(A)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQcos_fast(A)          _IQ26cos_fast(A)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQcos_fast(A)          _IQ25cos_fast(A)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQcos_fast(A)          _IQ24cos_fast(A)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQcos_fast(A)          _IQ23cos_fast(A)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQcos_fast(A)          _IQ22cos_fast(A)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQcos_fast(A)          _IQ21cos_fast(A)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQcos_fast(A)          _IQ20cos_fast(A)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQcos_fast(A)          _IQ19cos_fast(A)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQcos_fast(A)          _IQ18cos_fast(A)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQcos_fast(A)          _IQ17cos_fast(A)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQcos_fast(A)          _IQ16cos_fast(A)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQcos_fast(A)          _IQ15cos_fast(A)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQcos_fast(A)          _IQ14cos_fast(A)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQcos_fast(A)          _IQ13cos_fast(A)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQcos_fast(A)          _IQ12cos_fast(A)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQcos_fast(A)          _IQ11cos_fast(A)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQcos_fast(A)          _IQ10cos_fast(A)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQcos_fast(A)          _IQ9cos_fast(A)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQcos_fast(A)          _IQ8cos_fast(A)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQcos_fast(A)          _IQ7cos_fast(A)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQcos_fast(A)          _IQ6cos_fast(A)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQcos_fast(A)          _IQ5cos_fast(A)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQcos_fast(A)          _IQ4cos_fast(A)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQcos_fast(A)          _IQ3cos_fast(A)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQcos_fast(A)          _IQ2cos_fast(A)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQcos_fast(A)          _IQ1cos_fast(A)
+#endif
+
+/**
+ * @brief Computes the exponential of a global IQ format input, with reduced accuracy.
+ *
+ * @param A               Global IQ format input.
+ *
+ * @return                Global IQ format result of exponential.
+ */
+#if GLOBAL_IQ == 30
+#define _IQexp_fast(A)          _IQ30exp_fast(A)
+#endif
+#if GLOBAL_IQ == 29
+#define _IQexp_fast(A)          _IQ29exp_fast(A)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQexp_fast(A)          _IQ28exp_fast(A)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQexp_fast(A)          _IQ27exp_fast(A)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQexp_fast(A)          _IQ26exp_fast(A)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQexp_fast(A)          _IQ25exp_fast(A)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQexp_fast(A)          _IQ24exp_fast(A)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQexp_fast(A)          _IQ23exp_fast(A)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQexp_fast(A)          _IQ22exp_fast(A)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQexp_fast(A)          _IQ21exp_fast(A)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQexp_fast(A)          _IQ20exp_fast(A)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQexp_fast(A)          _IQ19exp_fast(A)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQexp_fast(A)          _IQ18exp_fast(A)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQexp_fast(A)          _IQ17exp_fast(A)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQexp_fast(A)          _IQ16exp_fast(A)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQexp_fast(A)          _IQ15exp_fast(A)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQexp_fast(A)          _IQ14exp_fast(A)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQexp_fast(A)          _IQ13exp_fast(A)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQexp_fast(A)          _IQ12exp_fast(A)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQexp_fast(A)          _IQ11exp_fast(A)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQexp_fast(A)          _IQ10exp_fast(A)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQexp_fast(A)          _IQ9exp_fast(A)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQexp_fast(A)          _IQ8exp_fast(A)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQexp_fast(A)          _IQ7exp_fast(A)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQexp_fast(A)          _IQ6exp_fast(A)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQexp_fast(A)          _IQ5exp_fast(A)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQexp_fast(A)          _IQ4exp_fast(A)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQexp_fast(A)          _IQ3exp_fast(A)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQexp_fast(A)          _IQ2exp_fast(A)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQexp_fast(A)          _IQ1exp_fast(A)
+#endif
+
+/**
+ * @brief Computes the base-e logarithm of a global IQ format input, with reduced accuracy.
+ *
+ * @param A               Global IQ format input.
+ *
+ * @return                Global IQ format result of logarithm.
+ */
+#if GLOBAL_IQ == 30
+#define _IQlog_fast(A)          _IQ30log_fast(A)
+#endif
+#if GLOBAL_IQ == 29
+#define _IQlog_fast(A)          _IQ29log_fast(A)
+#endif
+#if GLOBAL_IQ == 28
+#define _IQlog_fast(A)          _IQ28log_fast(A)
+#endif
+#if GLOBAL_IQ == 27
+#define _IQlog_fast(A)          _IQ27log_fast(A)
+#endif
+#if GLOBAL_IQ == 26
+#define _IQlog_fast(A)          _IQ26log_fast(A)
+#endif
+#if GLOBAL_IQ == 25
+#define _IQlog_fast(A)          _IQ25log_fast(A)
+#endif
+#if GLOBAL_IQ == 24
+#define _IQlog_fast(A)          _IQ24log_fast(A)
+#endif
+#if GLOBAL_IQ == 23
+#define _IQlog_fast(A)          _IQ23log_fast(A)
+#endif
+#if GLOBAL_IQ == 22
+#define _IQlog_fast(A)          _IQ22log_fast(A)
+#endif
+#if GLOBAL_IQ == 21
+#define _IQlog_fast(A)          _IQ21log_fast(A)
+#endif
+#if GLOBAL_IQ == 20
+#define _IQlog_fast(A)          _IQ20log_fast(A)
+#endif
+#if GLOBAL_IQ == 19
+#define _IQlog_fast(A)          _IQ19log_fast(A)
+#endif
+#if GLOBAL_IQ == 18
+#define _IQlog_fast(A)          _IQ18log_fast(A)
+#endif
+#if GLOBAL_IQ == 17
+#define _IQlog_fast(A)          _IQ17log_fast(A)
+#endif
+#if GLOBAL_IQ == 16
+#define _IQlog_fast(A)          _IQ16log_fast(A)
+#endif
+#if GLOBAL_IQ == 15
+#define _IQlog_fast(A)          _IQ15log_fast(A)
+#endif
+#if GLOBAL_IQ == 14
+#define _IQlog_fast(A)          _IQ14log_fast(A)
+#endif
+#if GLOBAL_IQ == 13
+#define _IQlog_fast(A)          _IQ13log_fast(A)
+#endif
+#if GLOBAL_IQ == 12
+#define _IQlog_fast(A)          _IQ12log_fast(A)
+#endif
+#if GLOBAL_IQ == 11
+#define _IQlog_fast(A)          _IQ11log_fast(A)
+#endif
+#if GLOBAL_IQ == 10
+#define _IQlog_fast(A)          _IQ10log_fast(A)
+#endif
+#if GLOBAL_IQ == 9
+#define _IQlog_fast(A)          _IQ9log_fast(A)
+#endif
+#if GLOBAL_IQ == 8
+#define _IQlog_fast(A)          _IQ8log_fast(A)
+#endif
+#if GLOBAL_IQ == 7
+#define _IQlog_fast(A)          _IQ7log_fast(A)
+#endif
+#if GLOBAL_IQ == 6
+#define _IQlog_fast(A)          _IQ6log_fast(A)
+#endif
+#if GLOBAL_IQ == 5
+#define _IQlog_fast(A)          _IQ5log_fast(A)
+#endif
+#if GLOBAL_IQ == 4
+#define _IQlog_fast(A)          _IQ4log_fast(A)
+#endif
+#if GLOBAL_IQ == 3
+#define _IQlog_fast(A)          _IQ3log_fast(A)
+#endif
+#if GLOBAL_IQ == 2
+#define _IQlog_fast(A)          _IQ2log_fast(A)
+#endif
+#if GLOBAL_IQ == 1
+#define _IQlog_fast(A)          _IQ1log_fast(A)
+#endif
+
+//*****************************************************************************
+//
+// Inline multiplications and conversions to floating point, if enabled in
+// menuconfig.
+//
+//*****************************************************************************
+#include "sdkconfig.h"
+#if CONFIG_IQMATH_INLINE
+#include "IQmathLib_inline.h"
+#endif
+
 //*****************************************************************************
 //
 // Mark the end of the C bindings section for C++ compilers.
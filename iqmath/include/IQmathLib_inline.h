@@ -0,0 +1,240 @@
+/*!****************************************************************************
+ *  @file       IQmathLib_inline.h
+ *  @brief      Inline versions of the IQN multiplications and conversion to
+ *  floating point, used instead of the library functions when
+ *  CONFIG_IQMATH_INLINE is enabled.
+ *
+ *  The functions are always inlined, so the compiler can keep the operands in
+ *  registers and schedule the 64-bit multiplication with the surrounding
+ *  code. The library functions are still available, e.g. through pointers.
+ *  The results are identical to the ones of the library functions.
+ *
+ *  This file is included by IQmathLib.h, it must not be included directly.
+ *
+ *  <hr>
+ ******************************************************************************/
+#ifndef __IQMATHLIB_INLINE_H__
+#define __IQMATHLIB_INLINE_H__
+
+#include <stdint.h>
+#include "esp_attr.h"
+
+/**
+ * @brief Multiply two values of IQN type.
+ *
+ * @param iqNInput1       IQN type value input to be multiplied.
+ * @param iqNInput2       IQN type value input to be multiplied.
+ * @param q_value         IQ format.
+ *
+ * @return                IQN type result of the multiplication.
+ */
+FORCE_INLINE_ATTR int32_t __IQNmpy_inline(int32_t iqNInput1, int32_t iqNInput2, const int8_t q_value)
+{
+    return (int32_t)(((int64_t)iqNInput1 * iqNInput2) >> q_value);
+}
+
+/**
+ * @brief Multiply two values of IQN type, with rounding.
+ *
+ * @param iqNInput1       IQN type value input to be multiplied.
+ * @param iqNInput2       IQN type value input to be multiplied.
+ * @param q_value         IQ format.
+ *
+ * @return                IQN type result of the multiplication.
+ */
+FORCE_INLINE_ATTR int32_t __IQNrmpy_inline(int32_t iqNInput1, int32_t iqNInput2, const int8_t q_value)
+{
+    return (int32_t)(((int64_t)iqNInput1 * iqNInput2 + ((uint32_t)1 << (q_value - 1))) >> q_value);
+}
+
+/**
+ * @brief Multiply two values of IQN type, with rounding and saturation.
+ *
+ * @param iqNInput1       IQN type value input to be multiplied.
+ * @param iqNInput2       IQN type value input to be multiplied.
+ * @param q_value         IQ format.
+ *
+ * @return                IQN type result of the multiplication.
+ */
+FORCE_INLINE_ATTR int32_t __IQNrsmpy_inline(int32_t iqNInput1, int32_t iqNInput2, const int8_t q_value)
+{
+    int64_t iqNResult = ((int64_t)iqNInput1 * iqNInput2 + ((uint32_t)1 << (q_value - 1))) >> q_value;
+
+    if (iqNResult > INT32_MAX) {
+        return INT32_MAX;
+    } else if (iqNResult < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t)iqNResult;
+}
+
+/**
+ * @brief Converts IQN type to floating point.
+ *
+ * Same rounding as the library function, with the input normalized by a count
+ * of leading zeros instead of a loop.
+ *
+ * @param iqNInput        IQN type value input to be converted.
+ * @param q_value         IQ format.
+ *
+ * @return                Conversion of iqNInput to floating point.
+ */
+FORCE_INLINE_ATTR float __IQNtoF_inline(int32_t iqNInput, const int8_t q_value)
+{
+    union {
+        uint32_t u;
+        float f;
+    } result;
+    uint32_t sign = 0;
+    uint32_t uiq31Input = (uint32_t)iqNInput;
+
+    if (iqNInput == 0) {
+        return 0;
+    }
+    if (iqNInput < 0) {
+        sign = 0x80000000;
+        uiq31Input = -uiq31Input;
+    }
+
+    /* Scale the input to uiq31 and the exponent accordingly */
+    int shift = __builtin_clz(uiq31Input);
+    uiq31Input <<= shift;
+    uint32_t exp = (uint32_t)(127 + 31 - q_value - shift) << 23;
+
+    /*
+     * Round to 24 bits and remove the implied MSB. The add propagates a
+     * mantissa overflow from rounding to the exponent.
+     */
+    result.u = (((uiq31Input + 0x80) >> 8) & ~0x00800000) + exp + sign;
+    return result.f;
+}
+
+/* Multiplications */
+#define _IQ30mpy(A, B)  __IQNmpy_inline(A, B, 30)
+#define _IQ29mpy(A, B)  __IQNmpy_inline(A, B, 29)
+#define _IQ28mpy(A, B)  __IQNmpy_inline(A, B, 28)
+#define _IQ27mpy(A, B)  __IQNmpy_inline(A, B, 27)
+#define _IQ26mpy(A, B)  __IQNmpy_inline(A, B, 26)
+#define _IQ25mpy(A, B)  __IQNmpy_inline(A, B, 25)
+#define _IQ24mpy(A, B)  __IQNmpy_inline(A, B, 24)
+#define _IQ23mpy(A, B)  __IQNmpy_inline(A, B, 23)
+#define _IQ22mpy(A, B)  __IQNmpy_inline(A, B, 22)
+#define _IQ21mpy(A, B)  __IQNmpy_inline(A, B, 21)
+#define _IQ20mpy(A, B)  __IQNmpy_inline(A, B, 20)
+#define _IQ19mpy(A, B)  __IQNmpy_inline(A, B, 19)
+#define _IQ18mpy(A, B)  __IQNmpy_inline(A, B, 18)
+#define _IQ17mpy(A, B)  __IQNmpy_inline(A, B, 17)
+#define _IQ16mpy(A, B)  __IQNmpy_inline(A, B, 16)
+#define _IQ15mpy(A, B)  __IQNmpy_inline(A, B, 15)
+#define _IQ14mpy(A, B)  __IQNmpy_inline(A, B, 14)
+#define _IQ13mpy(A, B)  __IQNmpy_inline(A, B, 13)
+#define _IQ12mpy(A, B)  __IQNmpy_inline(A, B, 12)
+#define _IQ11mpy(A, B)  __IQNmpy_inline(A, B, 11)
+#define _IQ10mpy(A, B)  __IQNmpy_inline(A, B, 10)
+#define _IQ9mpy(A, B)   __IQNmpy_inline(A, B, 9)
+#define _IQ8mpy(A, B)   __IQNmpy_inline(A, B, 8)
+#define _IQ7mpy(A, B)   __IQNmpy_inline(A, B, 7)
+#define _IQ6mpy(A, B)   __IQNmpy_inline(A, B, 6)
+#define _IQ5mpy(A, B)   __IQNmpy_inline(A, B, 5)
+#define _IQ4mpy(A, B)   __IQNmpy_inline(A, B, 4)
+#define _IQ3mpy(A, B)   __IQNmpy_inline(A, B, 3)
+#define _IQ2mpy(A, B)   __IQNmpy_inline(A, B, 2)
+#define _IQ1mpy(A, B)   __IQNmpy_inline(A, B, 1)
+
+/* Multiplications with rounding */
+#define _IQ30rmpy(A, B) __IQNrmpy_inline(A, B, 30)
+#define _IQ29rmpy(A, B) __IQNrmpy_inline(A, B, 29)
+#define _IQ28rmpy(A, B) __IQNrmpy_inline(A, B, 28)
+#define _IQ27rmpy(A, B) __IQNrmpy_inline(A, B, 27)
+#define _IQ26rmpy(A, B) __IQNrmpy_inline(A, B, 26)
+#define _IQ25rmpy(A, B) __IQNrmpy_inline(A, B, 25)
+#define _IQ24rmpy(A, B) __IQNrmpy_inline(A, B, 24)
+#define _IQ23rmpy(A, B) __IQNrmpy_inline(A, B, 23)
+#define _IQ22rmpy(A, B) __IQNrmpy_inline(A, B, 22)
+#define _IQ21rmpy(A, B) __IQNrmpy_inline(A, B, 21)
+#define _IQ20rmpy(A, B) __IQNrmpy_inline(A, B, 20)
+#define _IQ19rmpy(A, B) __IQNrmpy_inline(A, B, 19)
+#define _IQ18rmpy(A, B) __IQNrmpy_inline(A, B, 18)
+#define _IQ17rmpy(A, B) __IQNrmpy_inline(A, B, 17)
+#define _IQ16rmpy(A, B) __IQNrmpy_inline(A, B, 16)
+#define _IQ15rmpy(A, B) __IQNrmpy_inline(A, B, 15)
+#define _IQ14rmpy(A, B) __IQNrmpy_inline(A, B, 14)
+#define _IQ13rmpy(A, B) __IQNrmpy_inline(A, B, 13)
+#define _IQ12rmpy(A, B) __IQNrmpy_inline(A, B, 12)
+#define _IQ11rmpy(A, B) __IQNrmpy_inline(A, B, 11)
+#define _IQ10rmpy(A, B) __IQNrmpy_inline(A, B, 10)
+#define _IQ9rmpy(A, B)  __IQNrmpy_inline(A, B, 9)
+#define _IQ8rmpy(A, B)  __IQNrmpy_inline(A, B, 8)
+#define _IQ7rmpy(A, B)  __IQNrmpy_inline(A, B, 7)
+#define _IQ6rmpy(A, B)  __IQNrmpy_inline(A, B, 6)
+#define _IQ5rmpy(A, B)  __IQNrmpy_inline(A, B, 5)
+#define _IQ4rmpy(A, B)  __IQNrmpy_inline(A, B, 4)
+#define _IQ3rmpy(A, B)  __IQNrmpy_inline(A, B, 3)
+#define _IQ2rmpy(A, B)  __IQNrmpy_inline(A, B, 2)
+#define _IQ1rmpy(A, B)  __IQNrmpy_inline(A, B, 1)
+
+/* Multiplications with rounding and saturation */
+#define _IQ30rsmpy(A, B) __IQNrsmpy_inline(A, B, 30)
+#define _IQ29rsmpy(A, B) __IQNrsmpy_inline(A, B, 29)
+#define _IQ28rsmpy(A, B) __IQNrsmpy_inline(A, B, 28)
+#define _IQ27rsmpy(A, B) __IQNrsmpy_inline(A, B, 27)
+#define _IQ26rsmpy(A, B) __IQNrsmpy_inline(A, B, 26)
+#define _IQ25rsmpy(A, B) __IQNrsmpy_inline(A, B, 25)
+#define _IQ24rsmpy(A, B) __IQNrsmpy_inline(A, B, 24)
+#define _IQ23rsmpy(A, B) __IQNrsmpy_inline(A, B, 23)
+#define _IQ22rsmpy(A, B) __IQNrsmpy_inline(A, B, 22)
+#define _IQ21rsmpy(A, B) __IQNrsmpy_inline(A, B, 21)
+#define _IQ20rsmpy(A, B) __IQNrsmpy_inline(A, B, 20)
+#define _IQ19rsmpy(A, B) __IQNrsmpy_inline(A, B, 19)
+#define _IQ18rsmpy(A, B) __IQNrsmpy_inline(A, B, 18)
+#define _IQ17rsmpy(A, B) __IQNrsmpy_inline(A, B, 17)
+#define _IQ16rsmpy(A, B) __IQNrsmpy_inline(A, B, 16)
+#define _IQ15rsmpy(A, B) __IQNrsmpy_inline(A, B, 15)
+#define _IQ14rsmpy(A, B) __IQNrsmpy_inline(A, B, 14)
+#define _IQ13rsmpy(A, B) __IQNrsmpy_inline(A, B, 13)
+#define _IQ12rsmpy(A, B) __IQNrsmpy_inline(A, B, 12)
+#define _IQ11rsmpy(A, B) __IQNrsmpy_inline(A, B, 11)
+#define _IQ10rsmpy(A, B) __IQNrsmpy_inline(A, B, 10)
+#define _IQ9rsmpy(A, B) __IQNrsmpy_inline(A, B, 9)
+#define _IQ8rsmpy(A, B) __IQNrsmpy_inline(A, B, 8)
+#define _IQ7rsmpy(A, B) __IQNrsmpy_inline(A, B, 7)
+#define _IQ6rsmpy(A, B) __IQNrsmpy_inline(A, B, 6)
+#define _IQ5rsmpy(A, B) __IQNrsmpy_inline(A, B, 5)
+#define _IQ4rsmpy(A, B) __IQNrsmpy_inline(A, B, 4)
+#define _IQ3rsmpy(A, B) __IQNrsmpy_inline(A, B, 3)
+#define _IQ2rsmpy(A, B) __IQNrsmpy_inline(A, B, 2)
+#define _IQ1rsmpy(A, B) __IQNrsmpy_inline(A, B, 1)
+
+/* Conversions to floating point */
+#define _IQ30toF(A)     __IQNtoF_inline(A, 30)
+#define _IQ29toF(A)     __IQNtoF_inline(A, 29)
+#define _IQ28toF(A)     __IQNtoF_inline(A, 28)
+#define _IQ27toF(A)     __IQNtoF_inline(A, 27)
+#define _IQ26toF(A)     __IQNtoF_inline(A, 26)
+#define _IQ25toF(A)     __IQNtoF_inline(A, 25)
+#define _IQ24toF(A)     __IQNtoF_inline(A, 24)
+#define _IQ23toF(A)     __IQNtoF_inline(A, 23)
+#define _IQ22toF(A)     __IQNtoF_inline(A, 22)
+#define _IQ21toF(A)     __IQNtoF_inline(A, 21)
+#define _IQ20toF(A)     __IQNtoF_inline(A, 20)
+#define _IQ19toF(A)     __IQNtoF_inline(A, 19)
+#define _IQ18toF(A)     __IQNtoF_inline(A, 18)
+#define _IQ17toF(A)     __IQNtoF_inline(A, 17)
+#define _IQ16toF(A)     __IQNtoF_inline(A, 16)
+#define _IQ15toF(A)     __IQNtoF_inline(A, 15)
+#define _IQ14toF(A)     __IQNtoF_inline(A, 14)
+#define _IQ13toF(A)     __IQNtoF_inline(A, 13)
+#define _IQ12toF(A)     __IQNtoF_inline(A, 12)
+#define _IQ11toF(A)     __IQNtoF_inline(A, 11)
+#define _IQ10toF(A)     __IQNtoF_inline(A, 10)
+#define _IQ9toF(A)      __IQNtoF_inline(A, 9)
+#define _IQ8toF(A)      __IQNtoF_inline(A, 8)
+#define _IQ7toF(A)      __IQNtoF_inline(A, 7)
+#define _IQ6toF(A)      __IQNtoF_inline(A, 6)
+#define _IQ5toF(A)      __IQNtoF_inline(A, 5)
+#define _IQ4toF(A)      __IQNtoF_inline(A, 4)
+#define _IQ3toF(A)      __IQNtoF_inline(A, 3)
+#define _IQ2toF(A)      __IQNtoF_inline(A, 2)
+#define _IQ1toF(A)      __IQNtoF_inline(A, 1)
+
+#endif // __IQMATHLIB_INLINE_H__
@@ -0,0 +1,263 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include "IQmathLib.h"
+
+/**
+ * @file iq.hpp
+ * @brief Fixed-point value type with the Q format as a template parameter.
+ *
+ * iqmath::iq<N> holds an IQN number, so formats can be mixed in a translation unit without
+ * GLOBAL_IQ, and the operators call the IQmath function of the right format:
+ *
+ * @code{cpp}
+ * using namespace iqmath;
+ * constexpr iq<24> gain(0.75);               // converted at compile time
+ * iq<15> x = iq<15>(2.5);
+ * iq<24> y = gain * x;                       // mixed formats, one multiply and one shift
+ * float f = sin(y).to_float();
+ * @endcode
+ */
+namespace iqmath {
+
+namespace detail {
+
+/* IQmath functions of each format, the names of the C functions contain the format */
+template <int N> struct fn;
+
+#define IQMATH_DETAIL_FN(N)                                                                 \
+    template <> struct fn<N> {                                                              \
+        static int32_t mpy(int32_t a, int32_t b) { return _IQ##N##mpy(a, b); }              \
+        static int32_t rmpy(int32_t a, int32_t b) { return _IQ##N##rmpy(a, b); }            \
+        static int32_t rsmpy(int32_t a, int32_t b) { return _IQ##N##rsmpy(a, b); }          \
+        static int32_t div(int32_t a, int32_t b) { return _IQ##N##div(a, b); }              \
+        static int32_t sqrt(int32_t a) { return _IQ##N##sqrt(a); }                          \
+        static float toF(int32_t a) { return _IQ##N##toF(a); }                              \
+        IQMATH_DETAIL_TRIG_FN(N)                                                            \
+    };
+
+/* The trigonometric functions are not available in IQ30 */
+#define IQMATH_DETAIL_TRIG_FN(N)                                                            \
+        static int32_t sin(int32_t a) { return _IQ##N##sin(a); }                            \
+        static int32_t cos(int32_t a) { return _IQ##N##cos(a); }                            \
+        static int32_t atan2(int32_t y, int32_t x) { return _IQ##N##atan2(y, x); }
+
+IQMATH_DETAIL_FN(1)  IQMATH_DETAIL_FN(2)  IQMATH_DETAIL_FN(3)  IQMATH_DETAIL_FN(4)  IQMATH_DETAIL_FN(5)
+IQMATH_DETAIL_FN(6)  IQMATH_DETAIL_FN(7)  IQMATH_DETAIL_FN(8)  IQMATH_DETAIL_FN(9)  IQMATH_DETAIL_FN(10)
+IQMATH_DETAIL_FN(11) IQMATH_DETAIL_FN(12) IQMATH_DETAIL_FN(13) IQMATH_DETAIL_FN(14) IQMATH_DETAIL_FN(15)
+IQMATH_DETAIL_FN(16) IQMATH_DETAIL_FN(17) IQMATH_DETAIL_FN(18) IQMATH_DETAIL_FN(19) IQMATH_DETAIL_FN(20)
+IQMATH_DETAIL_FN(21) IQMATH_DETAIL_FN(22) IQMATH_DETAIL_FN(23) IQMATH_DETAIL_FN(24) IQMATH_DETAIL_FN(25)
+IQMATH_DETAIL_FN(26) IQMATH_DETAIL_FN(27) IQMATH_DETAIL_FN(28) IQMATH_DETAIL_FN(29)
+
+#undef IQMATH_DETAIL_TRIG_FN
+#define IQMATH_DETAIL_TRIG_FN(N)
+IQMATH_DETAIL_FN(30)
+
+#undef IQMATH_DETAIL_TRIG_FN
+#undef IQMATH_DETAIL_FN
+
+/* Shift left for positive counts, right for negative ones */
+constexpr int64_t shift(int64_t value, int count)
+{
+    return count >= 0 ? value * (static_cast<int64_t>(1) << count) : value >> -count;
+}
+
+} // namespace detail
+
+/**
+ * @brief IQN fixed-point number
+ *
+ * @tparam N IQ format, number of fractional bits, from 1 to 30
+ */
+template <int N>
+class iq {
+    static_assert(N >= 1 && N <= 30, "IQ format must be between 1 and 30");
+
+public:
+    static constexpr int q = N; /*!< IQ format */
+
+    constexpr iq() : value(0) {}
+
+    /**
+     * @brief Convert a floating point value, as _IQN(A)
+     *
+     * Conversion of constants is done at compile time.
+     */
+    constexpr explicit iq(double a) : value(static_cast<int32_t>(a * (static_cast<int32_t>(1) << N))) {}
+
+    /**
+     * @brief Convert an IQ number of another format, as _IQNtoIQ() and _IQtoIQN()
+     */
+    template <int M>
+    constexpr explicit iq(iq<M> a) : value(static_cast<int32_t>(detail::shift(a.raw(), N - M))) {}
+
+    /** @brief Make an IQN number from its integer representation */
+    static constexpr iq from_raw(int32_t raw)
+    {
+        iq r;
+        r.value = raw;
+        return r;
+    }
+
+    /** @brief Integer representation of the number */
+    constexpr int32_t raw() const
+    {
+        return value;
+    }
+
+    /** @brief Convert to floating point, as _IQNtoF() */
+    float to_float() const
+    {
+        return detail::fn<N>::toF(value);
+    }
+
+    constexpr iq operator-() const
+    {
+        return from_raw(-value);
+    }
+    constexpr iq &operator+=(iq b)
+    {
+        value += b.value;
+        return *this;
+    }
+    constexpr iq &operator-=(iq b)
+    {
+        value -= b.value;
+        return *this;
+    }
+    iq &operator*=(iq b)
+    {
+        value = detail::fn<N>::mpy(value, b.value);
+        return *this;
+    }
+    iq &operator/=(iq b)
+    {
+        value = detail::fn<N>::div(value, b.value);
+        return *this;
+    }
+
+private:
+    int32_t value;
+};
+
+template <int N> constexpr iq<N> operator+(iq<N> a, iq<N> b)
+{
+    return a += b;
+}
+template <int N> constexpr iq<N> operator-(iq<N> a, iq<N> b)
+{
+    return a -= b;
+}
+/** @brief Multiply, as _IQNmpy() */
+template <int N> iq<N> operator*(iq<N> a, iq<N> b)
+{
+    return a *= b;
+}
+/** @brief Divide, as _IQNdiv() */
+template <int N> iq<N> operator/(iq<N> a, iq<N> b)
+{
+    return a /= b;
+}
+/** @brief Multiply by an integer, as _IQNmpyI32() without saturation */
+template <int N> constexpr iq<N> operator*(iq<N> a, int32_t b)
+{
+    return iq<N>::from_raw(a.raw() * b);
+}
+template <int N> constexpr iq<N> operator*(int32_t a, iq<N> b)
+{
+    return b * a;
+}
+
+template <int N> constexpr bool operator==(iq<N> a, iq<N> b)
+{
+    return a.raw() == b.raw();
+}
+template <int N> constexpr bool operator!=(iq<N> a, iq<N> b)
+{
+    return a.raw() != b.raw();
+}
+template <int N> constexpr bool operator<(iq<N> a, iq<N> b)
+{
+    return a.raw() < b.raw();
+}
+template <int N> constexpr bool operator<=(iq<N> a, iq<N> b)
+{
+    return a.raw() <= b.raw();
+}
+template <int N> constexpr bool operator>(iq<N> a, iq<N> b)
+{
+    return a.raw() > b.raw();
+}
+template <int N> constexpr bool operator>=(iq<N> a, iq<N> b)
+{
+    return a.raw() >= b.raw();
+}
+
+/**
+ * @brief Multiply numbers of different formats into the format R
+ *
+ * The product is shifted once by N + M - R, instead of converting an operand
+ * and multiplying with _IQNmpy(). The result is not saturated.
+ */
+template <int R, int N, int M>
+constexpr iq<R> mpy(iq<N> a, iq<M> b)
+{
+    return iq<R>::from_raw(static_cast<int32_t>(detail::shift(static_cast<int64_t>(a.raw()) * b.raw(), R - N - M)));
+}
+
+/** @brief Multiply numbers of different formats, the result has the format of the first one */
+template <int N, int M, typename = typename std::enable_if<N != M>::type>
+constexpr iq<N> operator*(iq<N> a, iq<M> b)
+{
+    return mpy<N>(a, b);
+}
+
+/** @brief Multiply with rounding, as _IQNrmpy() */
+template <int N> iq<N> rmpy(iq<N> a, iq<N> b)
+{
+    return iq<N>::from_raw(detail::fn<N>::rmpy(a.raw(), b.raw()));
+}
+/** @brief Multiply with rounding and saturation, as _IQNrsmpy() */
+template <int N> iq<N> rsmpy(iq<N> a, iq<N> b)
+{
+    return iq<N>::from_raw(detail::fn<N>::rsmpy(a.raw(), b.raw()));
+}
+/** @brief Absolute value, as _IQNabs() */
+template <int N> constexpr iq<N> abs(iq<N> a)
+{
+    return a.raw() < 0 ? -a : a;
+}
+/** @brief Square root, as _IQNsqrt() */
+template <int N> iq<N> sqrt(iq<N> a)
+{
+    return iq<N>::from_raw(detail::fn<N>::sqrt(a.raw()));
+}
+/** @brief Magnitude sqrt(a^2 + b^2), as _IQNmag() */
+template <int N> iq<N> mag(iq<N> a, iq<N> b)
+{
+    return iq<N>::from_raw(_IQmag(a.raw(), b.raw()));
+}
+/** @brief Sine of an angle in radians, as _IQNsin(), not available in IQ30 */
+template <int N> iq<N> sin(iq<N> a)
+{
+    return iq<N>::from_raw(detail::fn<N>::sin(a.raw()));
+}
+/** @brief Cosine of an angle in radians, as _IQNcos(), not available in IQ30 */
+template <int N> iq<N> cos(iq<N> a)
+{
+    return iq<N>::from_raw(detail::fn<N>::cos(a.raw()));
+}
+/** @brief 4-quadrant arctangent in radians, as _IQNatan2(), not available in IQ30 */
+template <int N> iq<N> atan2(iq<N> y, iq<N> x)
+{
+    return iq<N>::from_raw(detail::fn<N>::atan2(y.raw(), x.raw()));
+}
+
+} // namespace iqmath
@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include "IQmathLib.h"
+#include "unity.h"
+
+/* Hidden unsigned IQ31 division of _IQNatan2 */
+extern uint32_t _UIQ31div(uint32_t a, uint32_t b);
+
+static const float s_magnitudes[] = {0.001f, 0.5f, 1.0f, 3.0f, 100.0f};
+
+TEST_CASE("IQ division of equal magnitudes", "[iqmath]")
+{
+    for (size_t i = 0; i < sizeof(s_magnitudes) / sizeof(s_magnitudes[0]); i++) {
+        const _iq24 a = _IQ24(s_magnitudes[i]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6, 1.0f, _IQ24toF(_IQ24div(a, a)));
+        TEST_ASSERT_FLOAT_WITHIN(1e-6, -1.0f, _IQ24toF(_IQ24div(-a, a)));
+        TEST_ASSERT_FLOAT_WITHIN(1e-6, -1.0f, _IQ24toF(_IQ24div(a, -a)));
+        TEST_ASSERT_FLOAT_WITHIN(1e-6, 1.0f, _IQ24toF(_IQ24div(-a, -a)));
+    }
+    // Exact in Q30, where 1.0 is one bit below the saturation
+    TEST_ASSERT_EQUAL_INT32(_IQ30(1.0), _IQ30div(_IQ30(0.75), _IQ30(0.75)));
+    TEST_ASSERT_EQUAL_INT32(_IQ30(-1.0), _IQ30div(_IQ30(-0.75), _IQ30(0.75)));
+}
+
+TEST_CASE("IQ atan2 of equal magnitudes", "[iqmath]")
+{
+    // The ratio of atan2 saturates below 1.0, the top bits index its coefficient table
+    TEST_ASSERT_EQUAL_UINT32(0x7fffffff, _UIQ31div(_IQ24(1), _IQ24(1)));
+    TEST_ASSERT_EQUAL_UINT32(0x7fffffff, _UIQ31div(INT32_MAX, INT32_MAX));
+
+    for (size_t i = 0; i < sizeof(s_magnitudes) / sizeof(s_magnitudes[0]); i++) {
+        for (int y_sign = -1; y_sign <= 1; y_sign += 2) {
+            for (int x_sign = -1; x_sign <= 1; x_sign += 2) {
+                const float y = y_sign * s_magnitudes[i];
+                const float x = x_sign * s_magnitudes[i];
+                TEST_ASSERT_FLOAT_WITHIN(1e-5, atan2f(y, x), _IQ24toF(_IQ24atan2(_IQ24(y), _IQ24(x))));
+                TEST_ASSERT_FLOAT_WITHIN(1e-5, atan2f(y, x) / (2 * M_PI),
+                                         _IQ24toF(_IQ24atan2PU(_IQ24(y), _IQ24(x))));
+            }
+        }
+    }
+    // Largest magnitudes of the format
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, M_PI / 4, _IQ24toF(_IQ24atan2(INT32_MAX, INT32_MAX)));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, -3 * M_PI / 4, _IQ24toF(_IQ24atan2(-INT32_MAX, -INT32_MAX)));
+}
@@ -25,6 +25,9 @@
 #define JSMN_H
 
 #include <stddef.h>
+#ifdef JSMN_FAST_SCAN
+#include <stdint.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -65,6 +68,9 @@ enum jsmnerr {
  * type     type (object, array, string etc.)
  * start    start position in JSON data string
  * end      end position in JSON data string
+ * next     with JSMN_SUBTREE_END, offset to the next token which is not a child,
+ *          for objects and arrays it is set when they are closed. Keys have their
+ *          value as child in the size field, but it isn't included here.
  */
 typedef struct jsmntok {
     jsmntype_t type;
@@ -74,6 +80,9 @@ typedef struct jsmntok {
 #ifdef JSMN_PARENT_LINKS
     int parent;
 #endif
+#ifdef JSMN_SUBTREE_END
+    int next;   /* offset to the token after this one and its children */
+#endif
 } jsmntok_t;
 
 /**
@@ -115,6 +124,9 @@ static jsmntok_t *jsmn_alloc_token(jsmn_parser *parser, jsmntok_t *tokens,
     tok->size = 0;
 #ifdef JSMN_PARENT_LINKS
     tok->parent = -1;
+#endif
+#ifdef JSMN_SUBTREE_END
+    tok->next = 1;
 #endif
     return tok;
 }
@@ -190,6 +202,54 @@ found:
     return 0;
 }
 
+#ifdef JSMN_FAST_SCAN
+/*
+ * Word at a time scanning: skip aligned 32-bit words of the input at once
+ * when none of their bytes needs to be looked at.
+ */
+typedef uint32_t __attribute__((__may_alias__)) jsmn_word_t;
+
+#define JSMN_WORD_ONES 0x01010101UL
+#define JSMN_WORD_HIGHS 0x80808080UL
+/* Non zero if a byte of the word is zero */
+#define JSMN_WORD_HAS_ZERO(w) (((w) - JSMN_WORD_ONES) & ~(w) & JSMN_WORD_HIGHS)
+/* Non zero if a byte of the word is c */
+#define JSMN_WORD_HAS_BYTE(w, c) JSMN_WORD_HAS_ZERO((w) ^ (JSMN_WORD_ONES * (unsigned char)(c)))
+
+/**
+ * Skips the words of a string body without quote, backslash or null terminator.
+ * Stops before the word which ends the input, so pos stays less than len.
+ */
+static unsigned int jsmn_skip_string_words(const char *js, const size_t len,
+        unsigned int pos)
+{
+    while (((uintptr_t)(js + pos) & (sizeof(jsmn_word_t) - 1)) == 0 &&
+            pos + sizeof(jsmn_word_t) < len) {
+        jsmn_word_t w = *(const jsmn_word_t *)(js + pos);
+        if (JSMN_WORD_HAS_ZERO(w) || JSMN_WORD_HAS_BYTE(w, '\"') ||
+                JSMN_WORD_HAS_BYTE(w, '\\')) {
+            break;
+        }
+        pos += sizeof(jsmn_word_t);
+    }
+    return pos;
+}
+
+/**
+ * Skips the words of only spaces in indentation, same bounds as above.
+ */
+static unsigned int jsmn_skip_space_words(const char *js, const size_t len,
+        unsigned int pos)
+{
+    while (((uintptr_t)(js + pos) & (sizeof(jsmn_word_t) - 1)) == 0 &&
+            pos + sizeof(jsmn_word_t) < len &&
+            *(const jsmn_word_t *)(js + pos) == JSMN_WORD_ONES * ' ') {
+        pos += sizeof(jsmn_word_t);
+    }
+    return pos;
+}
+#endif
+
 /**
  * Fills next token with JSON string.
  */
@@ -205,7 +265,15 @@ static int jsmn_parse_string(jsmn_parser *parser, const char *js,
     parser->pos++;
 
     for (; parser->pos < len && js[parser->pos] != '\0'; parser->pos++) {
-        char c = js[parser->pos];
+        char c;
+
+#ifdef JSMN_FAST_SCAN
+        parser->pos = jsmn_skip_string_words(js, len, parser->pos);
+        if (js[parser->pos] == '\0') {
+            break;
+        }
+#endif
+        c = js[parser->pos];
 
         /* Quote: end of string */
         if (c == '\"') {
@@ -327,6 +395,9 @@ JSMN_API int jsmn_parse(jsmn_parser *parser, const char *js, const size_t len,
                         return JSMN_ERROR_INVAL;
                     }
                     token->end = parser->pos + 1;
+#ifdef JSMN_SUBTREE_END
+                    token->next = parser->toknext - (int)(token - tokens);
+#endif
                     parser->toksuper = token->parent;
                     break;
                 }
@@ -347,6 +418,9 @@ JSMN_API int jsmn_parse(jsmn_parser *parser, const char *js, const size_t len,
                     }
                     parser->toksuper = -1;
                     token->end = parser->pos + 1;
+#ifdef JSMN_SUBTREE_END
+                    token->next = parser->toknext - (int)(token - tokens);
+#endif
                     break;
                 }
             }
@@ -377,6 +451,10 @@ JSMN_API int jsmn_parse(jsmn_parser *parser, const char *js, const size_t len,
         case '\r':
         case '\n':
         case ' ':
+#ifdef JSMN_FAST_SCAN
+            /* The loop steps past the last skipped space */
+            parser->pos = jsmn_skip_space_words(js, len, parser->pos + 1) - 1;
+#endif
             break;
         case ':':
             parser->toksuper = parser->toknext - 1;
@@ -38,6 +38,11 @@ extern "C"
 #define JSON_FLOAT_PRECISION 5
 #endif
 
+/** Double precision i.e. number of digits after decimal point, at most 18 like the float one */
+#ifndef JSON_DOUBLE_PRECISION
+#define JSON_DOUBLE_PRECISION 10
+#endif
+
 /** JSON string flush callback prototype
  *
  * This is a prototype of the function that needs to be passed to
@@ -50,6 +55,36 @@ extern "C"
  */
 typedef void (*json_gen_flush_cb_t) (char *buf, void *priv);
 
+/** Segment of the JSON string passed to the vector flush callback */
+typedef struct {
+    /** Start of the segment, not NULL terminated */
+    const char *data;
+    /** Length of the segment */
+    int len;
+} json_gen_seg_t;
+
+/** JSON string vector flush callback prototype
+ *
+ * This is a prototype of the function that can be passed to json_gen_str_start_vec()
+ * and which will be invoked either when the buffer or the segment array is full,
+ * or when json_gen_str_end() is invoked. The segments, in order, are the next part
+ * of the JSON string. They point either into the JSON buffer or to data added by
+ * reference, like with json_gen_obj_set_string_ref(), so they can be sent out
+ * without copying, Eg. with sendmsg() or consecutive esp_http_client_write() calls.
+ *
+ * \param[in] segs Array of segments
+ * \param[in] num_segs Number of segments
+ * \param[in] priv Private data passed to json_gen_str_start_vec()
+ *
+ * \return 0 on success, any other value aborts the generation
+ */
+typedef int (*json_gen_flush_vec_cb_t) (const json_gen_seg_t *segs, int num_segs, void *priv);
+
+/** Data added by reference shorter than this is copied to the buffer instead */
+#ifndef JSON_GEN_MIN_REF_LEN
+#define JSON_GEN_MIN_REF_LEN 32
+#endif
+
 /** JSON String structure
  *
  * Please do not set/modify any elements.
@@ -70,6 +105,18 @@ typedef struct {
     char *free_ptr;
     /** Total length */
     int total_len;
+    /** (For Internal use only) Vector flush callback of json_gen_str_start_vec() */
+    json_gen_flush_vec_cb_t flush_vec_cb;
+    /** (For Internal use only) */
+    json_gen_seg_t *segs;
+    /** (For Internal use only) */
+    int max_segs;
+    /** (For Internal use only) */
+    int num_segs;
+    /** (For Internal use only) Start of the buffered data not in segs yet */
+    char *seg_start;
+    /** (For Internal use only) Set once the vector flush callback failed */
+    bool flush_failed;
 } json_gen_str_t;
 
 /** Start a JSON String
@@ -93,6 +140,30 @@ typedef struct {
 void json_gen_str_start(json_gen_str_t *jstr, char *buf, int buf_size,
                         json_gen_flush_cb_t flush_cb, void *priv);
 
+/** Start a JSON String with a vector flush callback
+ *
+ * Same as json_gen_str_start(), but the JSON string is flushed out as an array
+ * of segments to flush_vec_cb. Strings added by reference, with
+ * json_gen_obj_set_string_ref(), json_gen_arr_set_string_ref() and
+ * json_gen_add_to_long_string_ref(), are then passed as segments of their own
+ * instead of being copied into the buffer.
+ *
+ * \note The segments are not NULL terminated.
+ *
+ * \param[out] jstr Pointer to an allocated \ref json_gen_str_t structure.
+ * \param[out] buf Pointer to an allocated buffer into which the JSON
+ * string will be written, except the data added by reference
+ * \param[in] buf_size Size of the buffer
+ * \param[out] segs Array of segments used for the flush callback, the
+ * referenced data is copied if it has less than 3 elements
+ * \param[in] max_segs Number of elements of segs
+ * \param[in] flush_vec_cb Pointer to the flushing function of type \ref json_gen_flush_vec_cb_t
+ * \param[in] priv Private data to be passed to the flushing function callback.
+ */
+void json_gen_str_start_vec(json_gen_str_t *jstr, char *buf, int buf_size,
+                            json_gen_seg_t *segs, int max_segs,
+                            json_gen_flush_vec_cb_t flush_vec_cb, void *priv);
+
 /** End JSON string
  *
  * This should be the last function to be called after the entire JSON string
@@ -102,6 +173,7 @@ void json_gen_str_start(json_gen_str_t *jstr, char *buf, int buf_size,
  * json_gen_str_start()
  *
  * \return Total length of the JSON created, including the NULL termination byte.
+ * \return -1 if any call of the vector flush callback failed
  */
 int json_gen_str_end(json_gen_str_t *jstr);
 
@@ -176,6 +248,22 @@ int json_gen_end_array(json_gen_str_t *jstr);
  */
 int json_gen_push_object(json_gen_str_t *jstr, char *name);
 
+/** Push a named JSON object, with the length of the name
+ *
+ * Same as json_gen_push_object(), for names which are not NULL terminated
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] name Name of the object
+ * \param[in] name_len Length of the name
+
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_push_object_n(json_gen_str_t *jstr, const char *name, int name_len);
+
 /** Pop a named JSON object
  *
  * This ends a JSON object by adding a '}'. This is basically same as
@@ -210,6 +298,25 @@ int json_gen_pop_object(json_gen_str_t *jstr);
  */
 int json_gen_push_object_str(json_gen_str_t *jstr, char *name, char *object_str);
 
+/** Push a JSON object string, with the lengths of the name and the object string
+ *
+ * Same as json_gen_push_object_str(), for strings which are not NULL terminated
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] name Name of the object
+ * \param[in] name_len Length of the name
+ * \param[in] object_str The pre-formatted JSON object string
+ * \param[in] object_len Length of the object string
+
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_push_object_str_n(json_gen_str_t *jstr, const char *name, int name_len,
+                               const char *object_str, int object_len);
+
 /** Push a named JSON array
  *
  * This adds a JSON array like "name":[
@@ -225,6 +332,22 @@ int json_gen_push_object_str(json_gen_str_t *jstr, char *name, char *object_str)
  */
 int json_gen_push_array(json_gen_str_t *jstr, char *name);
 
+/** Push a named JSON array, with the length of the name
+ *
+ * Same as json_gen_push_array(), for names which are not NULL terminated
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] name Name of the array
+ * \param[in] name_len Length of the name
+
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_push_array_n(json_gen_str_t *jstr, const char *name, int name_len);
+
 /** Pop a named JSON array
  *
  * This ends a JSON array by adding a ']'. This is basically same as
@@ -259,6 +382,25 @@ int json_gen_pop_array(json_gen_str_t *jstr);
  */
 int json_gen_push_array_str(json_gen_str_t *jstr, char *name, char *array_str);
 
+/** Push a JSON array string, with the lengths of the name and the array string
+ *
+ * Same as json_gen_push_array_str(), for strings which are not NULL terminated
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] name Name of the array
+ * \param[in] name_len Length of the name
+ * \param[in] array_str The pre-formatted JSON array string
+ * \param[in] array_len Length of the array string
+
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_push_array_str_n(json_gen_str_t *jstr, const char *name, int name_len,
+                              const char *array_str, int array_len);
+
 /** Add a boolean element to an object
  *
  * This adds a boolean element to an object. Eg. "bool_val":true
@@ -316,9 +458,49 @@ int json_gen_obj_set_int(json_gen_str_t *jstr, char *name, int val);
  */
 int json_gen_obj_set_float(json_gen_str_t *jstr, char *name, float val);
 
+/** Add a 64-bit integer element to an object
+ *
+ * This adds an integer element to an object. Eg. "int_val":109174583252
+ *
+ * \note This must be called between json_gen_start_object()/json_gen_push_object()
+ * and json_gen_end_object()/json_gen_pop_object()
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] name Name of the element
+ * \param[in] val 64-bit integer value of the element
+ *
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_obj_set_int64(json_gen_str_t *jstr, char *name, int64_t val);
+
+/** Add a double element to an object
+ *
+ * This adds a double element to an object, with JSON_DOUBLE_PRECISION digits
+ * after the decimal point. Eg. "double_val":23.8000000000
+ *
+ * \note This must be called between json_gen_start_object()/json_gen_push_object()
+ * and json_gen_end_object()/json_gen_pop_object()
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] name Name of the element
+ * \param[in] val Double value of the element
+ *
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_obj_set_double(json_gen_str_t *jstr, char *name, double val);
+
 /** Add a string element to an object
  *
  * This adds a string element to an object. Eg. "string_val":"my_string"
+ * Quotes, backslashes and control characters in the string are escaped.
  *
  * \note This must be called between json_gen_start_object()/json_gen_push_object()
  * and json_gen_end_object()/json_gen_pop_object()
@@ -335,6 +517,51 @@ int json_gen_obj_set_float(json_gen_str_t *jstr, char *name, float val);
  */
 int json_gen_obj_set_string(json_gen_str_t *jstr, char *name, char *val);
 
+/** Add a string element to an object, with the lengths of the name and the value
+ *
+ * Same as json_gen_obj_set_string(), for strings which are not NULL terminated
+ * or can contain NULL characters, which are escaped as \\u0000
+ *
+ * \note This must be called between json_gen_start_object()/json_gen_push_object()
+ * and json_gen_end_object()/json_gen_pop_object()
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] name Name of the element
+ * \param[in] name_len Length of the name
+ * \param[in] val String value of the element
+ * \param[in] val_len Length of the value
+
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_obj_set_string_n(json_gen_str_t *jstr, const char *name, int name_len, const char *val, int val_len);
+
+/** Add a string element to an object by reference
+ *
+ * With json_gen_str_start_vec(), the value is passed to the vector flush callback
+ * as a segment instead of being copied. Else, it is copied like with
+ * json_gen_obj_set_string_n().
+ *
+ * \note The value is not escaped, it must not contain quotes, backslashes or
+ * control characters, like base64 data. It must stay valid until it is flushed
+ * out, i.e. until json_gen_str_end() to be safe.
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] name Name of the element
+ * \param[in] val String value of the element
+ * \param[in] val_len Length of the value
+
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_obj_set_string_ref(json_gen_str_t *jstr, char *name, const char *val, int val_len);
+
 /** Add a NULL element to an object
  *
  * This adds a NULL element to an object. Eg. "null_val":null
@@ -401,6 +628,38 @@ int json_gen_arr_set_int(json_gen_str_t *jstr, int val);
  */
 int json_gen_arr_set_float(json_gen_str_t *jstr, float val);
 
+/** Add a 64-bit integer element to an array
+ *
+ * \note This must be called between json_gen_start_array()/json_gen_push_array()
+ * and json_gen_end_array()/json_gen_pop_array()
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] val 64-bit integer value of the element
+ *
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_arr_set_int64(json_gen_str_t *jstr, int64_t val);
+
+/** Add a double element to an array
+ *
+ * \note This must be called between json_gen_start_array()/json_gen_push_array()
+ * and json_gen_end_array()/json_gen_pop_array()
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] val Double value of the element
+ *
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_arr_set_double(json_gen_str_t *jstr, double val);
+
 /** Add a string element to an array
  *
  * \note This must be called between json_gen_start_array()/json_gen_push_array()
@@ -417,6 +676,44 @@ int json_gen_arr_set_float(json_gen_str_t *jstr, float val);
  */
 int json_gen_arr_set_string(json_gen_str_t *jstr, char *val);
 
+/** Add a string element to an array, with the length of the value
+ *
+ * Same as json_gen_arr_set_string(), for strings which are not NULL terminated
+ * or can contain NULL characters, which are escaped as \\u0000
+ *
+ * \note This must be called between json_gen_start_array()/json_gen_push_array()
+ * and json_gen_end_array()/json_gen_pop_array()
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] val String value of the element
+ * \param[in] val_len Length of the value
+
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_arr_set_string_n(json_gen_str_t *jstr, const char *val, int val_len);
+
+/** Add a string element to an array by reference
+ *
+ * Same as json_gen_obj_set_string_ref(), for arrays.
+ *
+ * \note The value is not escaped and must stay valid until it is flushed out.
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] val String value of the element
+ * \param[in] val_len Length of the value
+
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_arr_set_string_ref(json_gen_str_t *jstr, const char *val, int val_len);
+
 /** Add a NULL element to an array
  *
  * \note This must be called between json_gen_start_array()/json_gen_push_array()
@@ -491,6 +788,40 @@ int json_gen_arr_start_long_string(json_gen_str_t *jstr, char *val);
  */
 int json_gen_add_to_long_string(json_gen_str_t *jstr, char *val);
 
+/** Add to a JSON Long string, with the length of the string
+ *
+ * Same as json_gen_add_to_long_string(), for strings which are not NULL terminated
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] val The string to be added
+ * \param[in] val_len Length of the string
+
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_add_to_long_string_n(json_gen_str_t *jstr, const char *val, int val_len);
+
+/** Add to a JSON Long string by reference
+ *
+ * Same as json_gen_obj_set_string_ref(), for adding to long strings.
+ *
+ * \note The string is not escaped and must stay valid until it is flushed out.
+ *
+ * \param[in] jstr Pointer to the \ref json_gen_str_t structure initialised by
+ * json_gen_str_start()
+ * \param[in] val The string to be added
+ * \param[in] val_len Length of the string
+
+ * \return 0 on Success
+ * \return -1 if buffer is out of space (possible only if no callback function
+ * is passed to json_gen_str_start(). Else, buffer will be flushed out and new data
+ * added after that
+ */
+int json_gen_add_to_long_string_ref(json_gen_str_t *jstr, const char *val, int val_len);
+
 /** End a JSON Long string
  *
  * This ends the string initialised by json_gen_obj_start_long_string() or
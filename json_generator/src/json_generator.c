@@ -18,41 +18,82 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
+#include <math.h>
 
 #include <json_generator.h>
 
 #define MAX_INT_IN_STR      24
 #define MAX_FLOAT_IN_STR    30
+/* Sign, 20 digits of the integer part, point, fraction and NULL termination */
+#define MAX_FIXED_IN_STR(precision)  (23 + (precision))
+
+/* The fixed point conversions keep the fraction digits in an uint64_t */
+#if JSON_FLOAT_PRECISION > 18 || JSON_DOUBLE_PRECISION > 18
+#error "JSON_FLOAT_PRECISION and JSON_DOUBLE_PRECISION can't be more than 18"
+#endif
 
 static inline int json_gen_get_empty_len(json_gen_str_t *jstr)
 {
     return (jstr->buf_size - (jstr->free_ptr - jstr->buf) - 1);
 }
 
+/* End the run of data buffered since the last segment, as a segment */
+static inline void json_gen_close_run(json_gen_str_t *jstr)
+{
+    if (jstr->free_ptr > jstr->seg_start) {
+        jstr->segs[jstr->num_segs].data = jstr->seg_start;
+        jstr->segs[jstr->num_segs].len = jstr->free_ptr - jstr->seg_start;
+        jstr->num_segs++;
+        jstr->seg_start = jstr->free_ptr;
+    }
+}
+
+/* Hand the buffered segments to the vector flush callback and reuse the buffer.
+ * A failure is sticky: the JSON string is incomplete, so all the following calls fail.
+ */
+static int json_gen_flush_vec(json_gen_str_t *jstr)
+{
+    if (jstr->flush_failed) {
+        return -1;
+    }
+    json_gen_close_run(jstr);
+    if (jstr->num_segs && jstr->flush_vec_cb(jstr->segs, jstr->num_segs, jstr->priv) != 0) {
+        jstr->flush_failed = true;
+    }
+    jstr->num_segs = 0;
+    jstr->free_ptr = jstr->buf;
+    jstr->seg_start = jstr->buf;
+    return jstr->flush_failed ? -1 : 0;
+}
+
 /* This will add the incoming string to the JSON string buffer
  * and flush it out if the buffer is full. Note that the data being
  * flushed out will always be equal to the size of the buffer unless
  * this is the last chunk being flushed out on json_gen_end_str()
  */
-static int json_gen_add_to_str(json_gen_str_t *jstr, char *str)
+static int json_gen_add_to_str_len(json_gen_str_t *jstr, const char *str, int len)
 {
-    if (!str) {
-        return 0;
+    if (jstr->flush_failed) {
+        return -1;
     }
-    int len = strlen(str);
     jstr->total_len += len;
     if (jstr->buf == NULL) {
         return 0;
     }
-    char *cur_ptr = str;
     while (1) {
         int len_remaining = json_gen_get_empty_len(jstr);
         int copy_len = len_remaining > len ? len : len_remaining;
-        memmove(jstr->free_ptr, cur_ptr, copy_len);
-        cur_ptr += copy_len;
+        memcpy(jstr->free_ptr, str, copy_len);
+        str += copy_len;
         jstr->free_ptr += copy_len;
         len -= copy_len;
         if (len) {
+            if (jstr->flush_vec_cb) {
+                if (json_gen_flush_vec(jstr) != 0) {
+                    return -1;
+                }
+                continue;
+            }
             *jstr->free_ptr = '\0';
             /* Report error if the buffer is full and no flush callback
              * is registered
@@ -69,6 +110,95 @@ static int json_gen_add_to_str(json_gen_str_t *jstr, char *str)
     return 0;
 }
 
+/* Add data by reference, it is passed as its own segment to the vector flush
+ * callback instead of being copied. Without one, or for short data, it is copied.
+ */
+static int json_gen_add_ref(json_gen_str_t *jstr, const char *data, int len)
+{
+    /* Room for the run before the data, the data and the run after it */
+    if (!jstr->buf || !jstr->flush_vec_cb || jstr->max_segs < 3 || len < JSON_GEN_MIN_REF_LEN) {
+        return json_gen_add_to_str_len(jstr, data, len);
+    }
+    if (jstr->flush_failed) {
+        return -1;
+    }
+    jstr->total_len += len;
+    if (jstr->num_segs + 3 > jstr->max_segs && json_gen_flush_vec(jstr) != 0) {
+        return -1;
+    }
+    json_gen_close_run(jstr);
+    jstr->segs[jstr->num_segs].data = data;
+    jstr->segs[jstr->num_segs].len = len;
+    jstr->num_segs++;
+    return 0;
+}
+
+static int json_gen_add_to_str(json_gen_str_t *jstr, const char *str)
+{
+    if (!str) {
+        return 0;
+    }
+    return json_gen_add_to_str_len(jstr, str, strlen(str));
+}
+
+/* Length of string literals known at compile time */
+#define json_gen_add_literal(jstr, literal) json_gen_add_to_str_len(jstr, literal, sizeof(literal) - 1)
+
+static inline bool json_gen_needs_escape(unsigned char c)
+{
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+/* Add a string escaped as per the JSON specification, without the quotes.
+ * Runs of characters which need no escaping are copied as a whole.
+ */
+static int json_gen_add_escaped(json_gen_str_t *jstr, const char *str, int len)
+{
+    static const char hex[] = "0123456789abcdef";
+    const char *end = str + len;
+    int ret = 0;
+    while (str < end) {
+        const char *run = str;
+        while (str < end && !json_gen_needs_escape(*str)) {
+            str++;
+        }
+        if (str > run) {
+            ret = json_gen_add_to_str_len(jstr, run, str - run);
+        }
+        if (str == end) {
+            break;
+        }
+        char esc[6] = {'\\', 0};
+        int esc_len = 2;
+        switch (*str) {
+        case '"': esc[1] = '"'; break;
+        case '\\': esc[1] = '\\'; break;
+        case '\b': esc[1] = 'b'; break;
+        case '\f': esc[1] = 'f'; break;
+        case '\n': esc[1] = 'n'; break;
+        case '\r': esc[1] = 'r'; break;
+        case '\t': esc[1] = 't'; break;
+        default:
+            /* Other control characters */
+            memcpy(&esc[1], "u00", 3);
+            esc[4] = hex[(unsigned char)*str >> 4];
+            esc[5] = hex[*str & 0xf];
+            esc_len = 6;
+            break;
+        }
+        ret = json_gen_add_to_str_len(jstr, esc, esc_len);
+        str++;
+    }
+    return ret;
+}
+
+static int json_gen_add_escaped_str(json_gen_str_t *jstr, const char *str)
+{
+    if (!str) {
+        return 0;
+    }
+    return json_gen_add_escaped(jstr, str, strlen(str));
+}
 
 void json_gen_str_start(json_gen_str_t *jstr, char *buf, int buf_size,
                         json_gen_flush_cb_t flush_cb, void *priv)
@@ -81,32 +211,47 @@ void json_gen_str_start(json_gen_str_t *jstr, char *buf, int buf_size,
     jstr->priv = priv;
 }
 
+void json_gen_str_start_vec(json_gen_str_t *jstr, char *buf, int buf_size,
+                            json_gen_seg_t *segs, int max_segs,
+                            json_gen_flush_vec_cb_t flush_vec_cb, void *priv)
+{
+    json_gen_str_start(jstr, buf, buf_size, NULL, priv);
+    jstr->flush_vec_cb = flush_vec_cb;
+    jstr->segs = segs;
+    jstr->max_segs = max_segs;
+    jstr->seg_start = buf;
+}
+
 int json_gen_str_end(json_gen_str_t *jstr)
 {
-    int total_len = jstr->total_len;
-    if (jstr->buf) {
+    int total_len = jstr->total_len + 1; /* +1 for the NULL termination */
+    if (jstr->flush_vec_cb) {
+        if (json_gen_flush_vec(jstr) != 0) {
+            total_len = -1;
+        }
+    } else if (jstr->buf) {
         *jstr->free_ptr = '\0';
         if (jstr->flush_cb) {
             jstr->flush_cb(jstr->buf, jstr->priv);
         }
     }
     memset(jstr, 0, sizeof(json_gen_str_t));
-    return total_len + 1; /* +1 for the NULL termination */
+    return total_len;
 }
 
 static inline void json_gen_handle_comma(json_gen_str_t *jstr)
 {
     if (jstr->comma_req) {
-        json_gen_add_to_str(jstr, ",");
+        json_gen_add_literal(jstr, ",");
     }
 }
 
 
-static int json_gen_handle_name(json_gen_str_t *jstr, char *name)
+static int json_gen_handle_name(json_gen_str_t *jstr, const char *name, int name_len)
 {
-    json_gen_add_to_str(jstr, "\"");
-    json_gen_add_to_str(jstr, name);
-    return json_gen_add_to_str(jstr, "\":");
+    json_gen_add_literal(jstr, "\"");
+    json_gen_add_escaped(jstr, name, name_len);
+    return json_gen_add_literal(jstr, "\":");
 }
 
 
@@ -114,13 +259,13 @@ int json_gen_start_object(json_gen_str_t *jstr)
 {
     json_gen_handle_comma(jstr);
     jstr->comma_req = false;
-    return json_gen_add_to_str(jstr, "{");
+    return json_gen_add_literal(jstr, "{");
 }
 
 int json_gen_end_object(json_gen_str_t *jstr)
 {
     jstr->comma_req = true;
-    return json_gen_add_to_str(jstr, "}");
+    return json_gen_add_literal(jstr, "}");
 }
 
 
@@ -128,71 +273,94 @@ int json_gen_start_array(json_gen_str_t *jstr)
 {
     json_gen_handle_comma(jstr);
     jstr->comma_req = false;
-    return json_gen_add_to_str(jstr, "[");
+    return json_gen_add_literal(jstr, "[");
 }
 
 int json_gen_end_array(json_gen_str_t *jstr)
 {
     jstr->comma_req = true;
-    return json_gen_add_to_str(jstr, "]");
+    return json_gen_add_literal(jstr, "]");
 }
 
-int json_gen_push_object(json_gen_str_t *jstr, char *name)
+int json_gen_push_object_n(json_gen_str_t *jstr, const char *name, int name_len)
 {
     json_gen_handle_comma(jstr);
-    json_gen_handle_name(jstr, name);
+    json_gen_handle_name(jstr, name, name_len);
     jstr->comma_req = false;
-    return json_gen_add_to_str(jstr, "{");
+    return json_gen_add_literal(jstr, "{");
+}
+
+int json_gen_push_object(json_gen_str_t *jstr, char *name)
+{
+    return json_gen_push_object_n(jstr, name, strlen(name));
 }
 
 int json_gen_pop_object(json_gen_str_t *jstr)
 {
     jstr->comma_req = true;
-    return json_gen_add_to_str(jstr, "}");
+    return json_gen_add_literal(jstr, "}");
 }
 
-int json_gen_push_object_str(json_gen_str_t *jstr, char *name, char *object_str)
+int json_gen_push_object_str_n(json_gen_str_t *jstr, const char *name, int name_len,
+                               const char *object_str, int object_len)
 {
     json_gen_handle_comma(jstr);
-    json_gen_handle_name(jstr, name);
+    json_gen_handle_name(jstr, name, name_len);
     jstr->comma_req = true;
-    return json_gen_add_to_str(jstr, object_str);
+    return json_gen_add_to_str_len(jstr, object_str, object_len);
 }
 
-int json_gen_push_array(json_gen_str_t *jstr, char *name)
+int json_gen_push_object_str(json_gen_str_t *jstr, char *name, char *object_str)
+{
+    return json_gen_push_object_str_n(jstr, name, strlen(name), object_str, strlen(object_str));
+}
+
+int json_gen_push_array_n(json_gen_str_t *jstr, const char *name, int name_len)
 {
     json_gen_handle_comma(jstr);
-    json_gen_handle_name(jstr, name);
+    json_gen_handle_name(jstr, name, name_len);
     jstr->comma_req = false;
-    return json_gen_add_to_str(jstr, "[");
+    return json_gen_add_literal(jstr, "[");
+}
+
+int json_gen_push_array(json_gen_str_t *jstr, char *name)
+{
+    return json_gen_push_array_n(jstr, name, strlen(name));
 }
+
 int json_gen_pop_array(json_gen_str_t *jstr)
 {
     jstr->comma_req = true;
-    return json_gen_add_to_str(jstr, "]");
+    return json_gen_add_literal(jstr, "]");
 }
 
-int json_gen_push_array_str(json_gen_str_t *jstr, char *name, char *array_str)
+int json_gen_push_array_str_n(json_gen_str_t *jstr, const char *name, int name_len,
+                              const char *array_str, int array_len)
 {
     json_gen_handle_comma(jstr);
-    json_gen_handle_name(jstr, name);
+    json_gen_handle_name(jstr, name, name_len);
     jstr->comma_req = true;
-    return json_gen_add_to_str(jstr, array_str);
+    return json_gen_add_to_str_len(jstr, array_str, array_len);
+}
+
+int json_gen_push_array_str(json_gen_str_t *jstr, char *name, char *array_str)
+{
+    return json_gen_push_array_str_n(jstr, name, strlen(name), array_str, strlen(array_str));
 }
 
 static int json_gen_set_bool(json_gen_str_t *jstr, bool val)
 {
     jstr->comma_req = true;
     if (val) {
-        return json_gen_add_to_str(jstr, "true");
+        return json_gen_add_literal(jstr, "true");
     } else {
-        return json_gen_add_to_str(jstr, "false");
+        return json_gen_add_literal(jstr, "false");
     }
 }
 int json_gen_obj_set_bool(json_gen_str_t *jstr, char *name, bool val)
 {
     json_gen_handle_comma(jstr);
-    json_gen_handle_name(jstr, name);
+    json_gen_handle_name(jstr, name, strlen(name));
     return json_gen_set_bool(jstr, val);
 }
 
@@ -202,18 +370,182 @@ int json_gen_arr_set_bool(json_gen_str_t *jstr, bool val)
     return json_gen_set_bool(jstr, val);
 }
 
+static const char s_digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const uint64_t s_pow10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL,
+};
+
+/* Write the decimal digits of val backwards, ending just before end, with at least min_digits digits.
+ * Returns the first digit. 64-bit divisions are done only while val doesn't fit 32 bits.
+ */
+static char *json_gen_u64_to_str(uint64_t val, char *end, int min_digits)
+{
+    char *p = end;
+    while (val > UINT32_MAX) {
+        uint32_t pair = val % 100;
+        val /= 100;
+        p -= 2;
+        memcpy(p, &s_digit_pairs[pair * 2], 2);
+    }
+    uint32_t v = val;
+    while (v >= 100) {
+        uint32_t pair = v % 100;
+        v /= 100;
+        p -= 2;
+        memcpy(p, &s_digit_pairs[pair * 2], 2);
+    }
+    if (v >= 10) {
+        p -= 2;
+        memcpy(p, &s_digit_pairs[v * 2], 2);
+    } else {
+        *--p = '0' + v;
+    }
+    while (end - p < min_digits) {
+        *--p = '0';
+    }
+    return p;
+}
+
+/* Format a signed 64-bit integer like "%lld", str has MAX_INT_IN_STR bytes */
+static char *json_gen_int64_to_str(int64_t val, char *str)
+{
+    char *end = str + MAX_INT_IN_STR - 1;
+    *end = '\0';
+    uint64_t mag = val < 0 ? 0 - (uint64_t)val : (uint64_t)val;
+    char *p = json_gen_u64_to_str(mag, end, 1);
+    if (val < 0) {
+        *--p = '-';
+    }
+    return p;
+}
+
+/* Format integer and fraction parts like "%.*f", returns the start of the string ending at end */
+static char *json_gen_fixed_to_str(bool negative, uint64_t int_part, uint64_t frac_part, int precision, char *end)
+{
+    char *p = end;
+    *p = '\0';
+    if (precision > 0) {
+        p = json_gen_u64_to_str(frac_part, p, precision);
+        *--p = '.';
+    }
+    p = json_gen_u64_to_str(int_part, p, 1);
+    if (negative) {
+        *--p = '-';
+    }
+    return p;
+}
+
+/* Format a double like "%.*f" with the rounding of printf, to the nearest and ties to even.
+ * Returns NULL if the integer part doesn't fit 64 bits, or val isn't finite.
+ */
+static char *json_gen_double_to_str(double val, int precision, char *end)
+{
+    double mag = fabs(val);
+    /* The scaled fraction must stay below 2^53 for the steps below to be exact, and the total below 2^64 */
+    if (precision > 15 || !(mag < 18446744073709551616.0)) {
+        return NULL;
+    }
+    double int_part = floor(mag);
+    double frac = mag - int_part;   /* exact */
+    double scale = s_pow10[precision];
+    double prod = frac * scale;
+    /* Rounding error of the product, prod + err is the exact value */
+    double err = fma(frac, scale, -prod);
+    double digits = floor(prod);
+    /* prod - digits is exact, and so is the comparison with one half when it matters */
+    double half = (prod - digits) - 0.5;
+    uint64_t frac_part = digits;
+    if (half > 0 || (half == 0 && (err > 0 || (err == 0 && (frac_part & 1))))) {
+        frac_part++;
+    }
+    uint64_t int_val = int_part;
+    if (frac_part >= s_pow10[precision]) {
+        frac_part -= s_pow10[precision];
+        int_val++;
+    }
+    return json_gen_fixed_to_str(signbit(val), int_val, frac_part, precision, end);
+}
+
+/* Format a float like "%.*f" */
+static char *json_gen_float_to_str(float val, int precision, char *end)
+{
+#if JSON_FLOAT_PRECISION <= 12
+    /* A float times up to 10^12 is exact as double, rint rounds like printf */
+    double scaled = rint(fabs((double)val) * s_pow10[precision]);
+    if (scaled < 18446744073709551616.0) {
+        uint64_t r = scaled;
+        uint64_t int_part, frac_part;
+        if (r <= UINT32_MAX) {
+            int_part = (uint32_t)r / (uint32_t)s_pow10[precision];
+            frac_part = (uint32_t)r % (uint32_t)s_pow10[precision];
+        } else {
+            int_part = r / s_pow10[precision];
+            frac_part = r % s_pow10[precision];
+        }
+        return json_gen_fixed_to_str(signbit(val), int_part, frac_part, precision, end);
+    }
+#endif
+    return json_gen_double_to_str(val, precision, end);
+}
+
+/* Values of 2^64 and more, and non finite ones, are rare enough for printf.
+ * Not inlined, so that its large buffer is on the stack only when needed.
+ */
+static int __attribute__((noinline)) json_gen_add_large_double(json_gen_str_t *jstr, double val, int precision)
+{
+    /* Up to 309 digits of the integer part of a double */
+    char str[MAX_FIXED_IN_STR(18) + 309];
+    snprintf(str, sizeof(str), "%.*f", precision, val);
+    return json_gen_add_to_str(jstr, str);
+}
+
 static int json_gen_set_int(json_gen_str_t *jstr, int val)
 {
     jstr->comma_req = true;
     char str[MAX_INT_IN_STR];
-    snprintf(str, MAX_INT_IN_STR, "%d", val);
-    return json_gen_add_to_str(jstr, str);
+    char *p = json_gen_int64_to_str(val, str);
+    return json_gen_add_to_str_len(jstr, p, &str[sizeof(str) - 1] - p);
+}
+
+static int json_gen_set_int64(json_gen_str_t *jstr, int64_t val)
+{
+    jstr->comma_req = true;
+    char str[MAX_INT_IN_STR];
+    char *p = json_gen_int64_to_str(val, str);
+    return json_gen_add_to_str_len(jstr, p, &str[sizeof(str) - 1] - p);
+}
+
+int json_gen_obj_set_int64(json_gen_str_t *jstr, char *name, int64_t val)
+{
+    json_gen_handle_comma(jstr);
+    json_gen_handle_name(jstr, name, strlen(name));
+    return json_gen_set_int64(jstr, val);
+}
+
+int json_gen_arr_set_int64(json_gen_str_t *jstr, int64_t val)
+{
+    json_gen_handle_comma(jstr);
+    return json_gen_set_int64(jstr, val);
 }
 
 int json_gen_obj_set_int(json_gen_str_t *jstr, char *name, int val)
 {
     json_gen_handle_comma(jstr);
-    json_gen_handle_name(jstr, name);
+    json_gen_handle_name(jstr, name, strlen(name));
     return json_gen_set_int(jstr, val);
 }
 
@@ -227,14 +559,17 @@ int json_gen_arr_set_int(json_gen_str_t *jstr, int val)
 static int json_gen_set_float(json_gen_str_t *jstr, float val)
 {
     jstr->comma_req = true;
-    char str[MAX_FLOAT_IN_STR];
-    snprintf(str, MAX_FLOAT_IN_STR, "%.*f", JSON_FLOAT_PRECISION, val);
-    return json_gen_add_to_str(jstr, str);
+    char str[MAX_FIXED_IN_STR(JSON_FLOAT_PRECISION)];
+    char *p = json_gen_float_to_str(val, JSON_FLOAT_PRECISION, &str[sizeof(str) - 1]);
+    if (!p) {
+        return json_gen_add_large_double(jstr, val, JSON_FLOAT_PRECISION);
+    }
+    return json_gen_add_to_str_len(jstr, p, &str[sizeof(str) - 1] - p);
 }
 int json_gen_obj_set_float(json_gen_str_t *jstr, char *name, float val)
 {
     json_gen_handle_comma(jstr);
-    json_gen_handle_name(jstr, name);
+    json_gen_handle_name(jstr, name, strlen(name));
     return json_gen_set_float(jstr, val);
 }
 int json_gen_arr_set_float(json_gen_str_t *jstr, float val)
@@ -243,38 +578,72 @@ int json_gen_arr_set_float(json_gen_str_t *jstr, float val)
     return json_gen_set_float(jstr, val);
 }
 
-static int json_gen_set_string(json_gen_str_t *jstr, char *val)
+static int json_gen_set_double(json_gen_str_t *jstr, double val)
+{
+    jstr->comma_req = true;
+    char str[MAX_FIXED_IN_STR(JSON_DOUBLE_PRECISION)];
+    char *p = json_gen_double_to_str(val, JSON_DOUBLE_PRECISION, &str[sizeof(str) - 1]);
+    if (!p) {
+        return json_gen_add_large_double(jstr, val, JSON_DOUBLE_PRECISION);
+    }
+    return json_gen_add_to_str_len(jstr, p, &str[sizeof(str) - 1] - p);
+}
+
+int json_gen_obj_set_double(json_gen_str_t *jstr, char *name, double val)
+{
+    json_gen_handle_comma(jstr);
+    json_gen_handle_name(jstr, name, strlen(name));
+    return json_gen_set_double(jstr, val);
+}
+
+int json_gen_arr_set_double(json_gen_str_t *jstr, double val)
+{
+    json_gen_handle_comma(jstr);
+    return json_gen_set_double(jstr, val);
+}
+
+static int json_gen_set_string(json_gen_str_t *jstr, const char *val, int val_len)
 {
     jstr->comma_req = true;
-    json_gen_add_to_str(jstr, "\"");
-    json_gen_add_to_str(jstr, val);
-    return json_gen_add_to_str(jstr, "\"");
+    json_gen_add_literal(jstr, "\"");
+    json_gen_add_escaped(jstr, val, val_len);
+    return json_gen_add_literal(jstr, "\"");
+}
+
+int json_gen_obj_set_string_n(json_gen_str_t *jstr, const char *name, int name_len, const char *val, int val_len)
+{
+    json_gen_handle_comma(jstr);
+    json_gen_handle_name(jstr, name, name_len);
+    return json_gen_set_string(jstr, val, val_len);
 }
 
 int json_gen_obj_set_string(json_gen_str_t *jstr, char *name, char *val)
+{
+    return json_gen_obj_set_string_n(jstr, name, strlen(name), val, val ? strlen(val) : 0);
+}
+
+int json_gen_arr_set_string_n(json_gen_str_t *jstr, const char *val, int val_len)
 {
     json_gen_handle_comma(jstr);
-    json_gen_handle_name(jstr, name);
-    return json_gen_set_string(jstr, val);
+    return json_gen_set_string(jstr, val, val_len);
 }
 
 int json_gen_arr_set_string(json_gen_str_t *jstr, char *val)
 {
-    json_gen_handle_comma(jstr);
-    return json_gen_set_string(jstr, val);
+    return json_gen_arr_set_string_n(jstr, val, val ? strlen(val) : 0);
 }
 
 static int json_gen_set_long_string(json_gen_str_t *jstr, char *val)
 {
     jstr->comma_req = true;
-    json_gen_add_to_str(jstr, "\"");
-    return json_gen_add_to_str(jstr, val);
+    json_gen_add_literal(jstr, "\"");
+    return json_gen_add_escaped_str(jstr, val);
 }
 
 int json_gen_obj_start_long_string(json_gen_str_t *jstr, char *name, char *val)
 {
     json_gen_handle_comma(jstr);
-    json_gen_handle_name(jstr, name);
+    json_gen_handle_name(jstr, name, strlen(name));
     return json_gen_set_long_string(jstr, val);
 }
 
@@ -284,24 +653,55 @@ int json_gen_arr_start_long_string(json_gen_str_t *jstr, char *val)
     return json_gen_set_long_string(jstr, val);
 }
 
+int json_gen_add_to_long_string_n(json_gen_str_t *jstr, const char *val, int val_len)
+{
+    return json_gen_add_escaped(jstr, val, val_len);
+}
+
 int json_gen_add_to_long_string(json_gen_str_t *jstr, char *val)
 {
-    return json_gen_add_to_str(jstr, val);
+    return json_gen_add_escaped_str(jstr, val);
 }
 
 int json_gen_end_long_string(json_gen_str_t *jstr)
 {
-    return json_gen_add_to_str(jstr, "\"");
+    return json_gen_add_literal(jstr, "\"");
+}
+
+static int json_gen_set_string_ref(json_gen_str_t *jstr, const char *val, int val_len)
+{
+    jstr->comma_req = true;
+    json_gen_add_literal(jstr, "\"");
+    json_gen_add_ref(jstr, val, val_len);
+    return json_gen_add_literal(jstr, "\"");
+}
+
+int json_gen_obj_set_string_ref(json_gen_str_t *jstr, char *name, const char *val, int val_len)
+{
+    json_gen_handle_comma(jstr);
+    json_gen_handle_name(jstr, name, strlen(name));
+    return json_gen_set_string_ref(jstr, val, val_len);
+}
+
+int json_gen_arr_set_string_ref(json_gen_str_t *jstr, const char *val, int val_len)
+{
+    json_gen_handle_comma(jstr);
+    return json_gen_set_string_ref(jstr, val, val_len);
+}
+
+int json_gen_add_to_long_string_ref(json_gen_str_t *jstr, const char *val, int val_len)
+{
+    return json_gen_add_ref(jstr, val, val_len);
 }
 static int json_gen_set_null(json_gen_str_t *jstr)
 {
     jstr->comma_req = true;
-    return json_gen_add_to_str(jstr, "null");
+    return json_gen_add_literal(jstr, "null");
 }
 int json_gen_obj_set_null(json_gen_str_t *jstr, char *name)
 {
     json_gen_handle_comma(jstr);
-    json_gen_handle_name(jstr, name);
+    json_gen_handle_name(jstr, name, strlen(name));
     return json_gen_set_null(jstr);
 }
 
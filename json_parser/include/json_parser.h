@@ -19,6 +19,7 @@
 #define JSMN_PARENT_LINKS
 #define JSMN_HEADER
 #include <jsmn.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -33,6 +34,11 @@ extern "C"
 typedef jsmn_parser json_parser_t;
 typedef jsmntok_t json_tok_t;
 
+/* Number of tokens the token arrays of json_parse_start() and json_parse_start_pool() grow by */
+#ifndef JSON_PARSER_TOKEN_CHUNK
+#define JSON_PARSER_TOKEN_CHUNK 16
+#endif
+
 typedef struct {
     json_parser_t parser;
     const char *js;
@@ -41,10 +47,82 @@ typedef struct {
     int num_tokens;
 } jparse_ctx_t;
 
+/* Token array reused across documents by json_parse_start_pool(), initialise with JSON_TOK_POOL_INIT */
+typedef struct {
+    json_tok_t *tokens;
+    int max_tokens;
+} json_tok_pool_t;
+
+#define JSON_TOK_POOL_INIT { .tokens = NULL, .max_tokens = 0 }
+
 int json_parse_start(jparse_ctx_t *jctx, const char *js, int len);
 int json_parse_end(jparse_ctx_t *jctx);
 int json_parse_start_static(jparse_ctx_t *jctx, const char *js, int len, json_tok_t *buffer_tokens, int buffer_tokens_max_count);
 int json_parse_end_static(jparse_ctx_t *jctx);
+int json_parse_start_pool(jparse_ctx_t *jctx, const char *js, int len, json_tok_pool_t *pool);
+int json_parse_end_pool(jparse_ctx_t *jctx);
+void json_tok_pool_free(json_tok_pool_t *pool);
+
+/* Type of a field extracted by json_obj_get_fields(), and of the variable val points to */
+typedef enum {
+    JSON_FIELD_BOOL,    /* bool */
+    JSON_FIELD_INT,     /* int */
+    JSON_FIELD_INT64,   /* int64_t */
+    JSON_FIELD_FLOAT,   /* float */
+    JSON_FIELD_DOUBLE,  /* double */
+    JSON_FIELD_STRING,  /* char array of size bytes */
+    JSON_FIELD_OBJECT,  /* struct described by a json_struct_desc_t, json_obj_decode_struct() only */
+} json_field_type_t;
+
+typedef struct {
+    const char *name;           /* Key of the field */
+    json_field_type_t type;     /* Expected type of the value */
+    void *val;                  /* Variable the value is stored to */
+    int size;                   /* Size of the string buffer for JSON_FIELD_STRING */
+    bool found;                 /* Set if the key was found and its value stored */
+} json_field_t;
+
+/* Extract a list of fields of the current object in a single pass over it.
+ * Returns OS_SUCCESS if all the fields were found, check found of the optional ones otherwise.
+ */
+int json_obj_get_fields(jparse_ctx_t *jctx, json_field_t *fields, int num_fields);
+
+/* Maximum number of fields of a json_struct_desc_t, nested objects have their own */
+#define JSON_STRUCT_MAX_FIELDS 64
+
+typedef struct json_struct_desc json_struct_desc_t;
+
+/* Member of a C struct decoded from a key of a JSON object, declare with the JSON_STRUCT_* macros */
+typedef struct {
+    const char *name;                   /* Key of the field */
+    json_field_type_t type;             /* Type of the value and of the member */
+    size_t offset;                      /* Offset of the member in the struct */
+    int size;                           /* Size of the member for JSON_FIELD_STRING */
+    const json_struct_desc_t *object;   /* Fields of the member for JSON_FIELD_OBJECT */
+} json_struct_field_t;
+
+struct json_struct_desc {
+    const json_struct_field_t *fields;
+    int num_fields;
+};
+
+#define JSON_STRUCT_BOOL(struct_type, member, key)   { .name = key, .type = JSON_FIELD_BOOL, .offset = offsetof(struct_type, member) }
+#define JSON_STRUCT_INT(struct_type, member, key)    { .name = key, .type = JSON_FIELD_INT, .offset = offsetof(struct_type, member) }
+#define JSON_STRUCT_INT64(struct_type, member, key)  { .name = key, .type = JSON_FIELD_INT64, .offset = offsetof(struct_type, member) }
+#define JSON_STRUCT_FLOAT(struct_type, member, key)  { .name = key, .type = JSON_FIELD_FLOAT, .offset = offsetof(struct_type, member) }
+#define JSON_STRUCT_DOUBLE(struct_type, member, key) { .name = key, .type = JSON_FIELD_DOUBLE, .offset = offsetof(struct_type, member) }
+#define JSON_STRUCT_STRING(struct_type, member, key) { .name = key, .type = JSON_FIELD_STRING, .offset = offsetof(struct_type, member), \
+                                                       .size = sizeof(((struct_type *)0)->member) }
+#define JSON_STRUCT_OBJECT(struct_type, member, key, member_desc) { .name = key, .type = JSON_FIELD_OBJECT, .offset = offsetof(struct_type, member), \
+                                                                   .object = &(member_desc) }
+/* Descriptor of a static array of json_struct_field_t */
+#define JSON_STRUCT_DESC(field_array) { .fields = field_array, .num_fields = sizeof(field_array) / sizeof(field_array[0]) }
+
+/* Decode the current object into the struct out in a single pass over its tokens.
+ * Members of missing keys are left unchanged, so preset the defaults of optional ones.
+ * Returns OS_SUCCESS if all the fields, including the nested ones, were found.
+ */
+int json_obj_decode_struct(jparse_ctx_t *jctx, const json_struct_desc_t *desc, void *out);
 
 int json_obj_get_array(jparse_ctx_t *jctx, const char *name, int *num_elem);
 int json_obj_leave_array(jparse_ctx_t *jctx);
@@ -54,8 +132,11 @@ int json_obj_get_bool(jparse_ctx_t *jctx, const char *name, bool *val);
 int json_obj_get_int(jparse_ctx_t *jctx, const char *name, int *val);
 int json_obj_get_int64(jparse_ctx_t *jctx, const char *name, int64_t *val);
 int json_obj_get_float(jparse_ctx_t *jctx, const char *name, float *val);
+int json_obj_get_double(jparse_ctx_t *jctx, const char *name, double *val);
 int json_obj_get_string(jparse_ctx_t *jctx, const char *name, char *val, int size);
 int json_obj_get_strlen(jparse_ctx_t *jctx, const char *name, int *strlen);
+/* Get a string without copying it, val points into the document and is not null terminated */
+int json_obj_get_string_view(jparse_ctx_t *jctx, const char *name, const char **val, int *len);
 int json_obj_get_object_str(jparse_ctx_t *jctx, const char *name, char *val, int size);
 int json_obj_get_object_strlen(jparse_ctx_t *jctx, const char *name, int *strlen);
 int json_obj_get_array_str(jparse_ctx_t *jctx, const char *name, char *val, int size);
@@ -69,8 +150,16 @@ int json_arr_get_bool(jparse_ctx_t *jctx, uint32_t index, bool *val);
 int json_arr_get_int(jparse_ctx_t *jctx, uint32_t index, int *val);
 int json_arr_get_int64(jparse_ctx_t *jctx, uint32_t index, int64_t *val);
 int json_arr_get_float(jparse_ctx_t *jctx, uint32_t index, float *val);
+int json_arr_get_double(jparse_ctx_t *jctx, uint32_t index, double *val);
 int json_arr_get_string(jparse_ctx_t *jctx, uint32_t index, char *val, int size);
 int json_arr_get_strlen(jparse_ctx_t *jctx, uint32_t index, int *strlen);
+int json_arr_get_string_view(jparse_ctx_t *jctx, uint32_t index, const char **val, int *len);
+
+/* Replace the escape sequences of the len bytes of a string by the characters, in place.
+ * Use on a string view of a modifiable document, or on a copied string. len is updated to the unescaped length,
+ * the string is not null terminated. Returns -OS_FAIL on an invalid escape sequence.
+ */
+int json_str_unescape(char *str, int *len);
 
 #ifdef __cplusplus
 }
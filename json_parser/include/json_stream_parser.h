@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef _JSON_STREAM_PARSER_H_
+#define _JSON_STREAM_PARSER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <json_parser.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef enum {
+    JSON_STREAM_OBJECT_START,
+    JSON_STREAM_OBJECT_END,
+    JSON_STREAM_ARRAY_START,
+    JSON_STREAM_ARRAY_END,
+    JSON_STREAM_STRING,         /* value is the string without the quotes, escape sequences are kept */
+    JSON_STREAM_PRIMITIVE,      /* value is a number, true, false or null */
+} json_stream_event_type_t;
+
+/* Object or array around an event, and the position of the event in it */
+typedef struct {
+    bool is_array;
+    const char *key;            /* Key of the current member of an object, not null terminated */
+    int key_len;
+    int index;                  /* Index of the current element of an array, or member of an object */
+} json_stream_level_t;
+
+typedef struct {
+    json_stream_event_type_t type;
+    const char *value;          /* Text of a string or primitive, not null terminated, valid during the callback */
+    int value_len;
+    bool more;                  /* Set on all but the last piece of a string longer than max_value_len */
+    int depth;                  /* Number of objects and arrays around the event */
+    const json_stream_level_t *path;    /* Those objects and arrays, outermost first */
+} json_stream_event_t;
+
+/* Called for each event, any return value but OS_SUCCESS stops the parsing */
+typedef int (*json_stream_cb_t)(const json_stream_event_t *event, void *priv);
+
+typedef struct {
+    json_stream_cb_t cb;
+    void *priv;                 /* Passed to cb */
+    int max_depth;              /* Maximum nesting of objects and arrays, 0 for 16 */
+    int max_key_len;            /* Maximum length of keys, 0 for 64 */
+    int max_value_len;          /* Longest primitive, and length of the pieces of longer strings, 0 for 256 */
+} json_stream_config_t;
+
+typedef struct json_stream_parser *json_stream_handle_t;
+
+/* Start parsing a document fed in chunks, the memory used is bounded by the configured limits, not the document.
+ * Returns NULL if out of memory or cb is NULL.
+ */
+json_stream_handle_t json_stream_start(const json_stream_config_t *config);
+
+/* Parse the next chunk of the document, calling the callback for the events in it.
+ * Returns -OS_FAIL on invalid JSON, exceeded limits or if the callback stopped the parsing.
+ */
+int json_stream_feed(json_stream_handle_t parser, const char *data, int len);
+
+/* End the document and free the parser.
+ * Returns OS_SUCCESS if a complete document was parsed without errors.
+ */
+int json_stream_end(json_stream_handle_t parser);
+
+/* Format the path of an event as "/key/index/...", the keys are not escaped.
+ * The path of the start and end events of an object or array is the path of the object or array.
+ */
+int json_stream_get_path(const json_stream_event_t *event, char *buf, int size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _JSON_STREAM_PARSER_H_ */
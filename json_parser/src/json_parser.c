@@ -30,8 +30,15 @@ static bool token_matches_str(jparse_ctx_t *ctx, json_tok_t *tok, const char *st
             && (strlen(str) == (size_t) (tok->end - tok->start)));
 }
 
+/* Returns the last token of the element, a key and its value are an element */
 static json_tok_t *json_skip_elem(json_tok_t *token)
 {
+#ifdef JSMN_SUBTREE_END
+    if (token->type != JSMN_OBJECT && token->type != JSMN_ARRAY && token->size) {
+        token++;
+    }
+    return token + token->next - 1;
+#else
     json_tok_t *cur = token;
     int cnt = cur->size;
     while (cnt--) {
@@ -39,6 +46,7 @@ static json_tok_t *json_skip_elem(json_tok_t *token)
         cur = json_skip_elem(cur);
     }
     return cur;
+#endif
 }
 
 static int json_tok_to_bool(jparse_ctx_t *jctx, json_tok_t *tok, bool *val)
@@ -92,6 +100,26 @@ static int json_tok_to_float(jparse_ctx_t *jctx, json_tok_t *tok, float *val)
     return -OS_FAIL;
 }
 
+static int json_tok_to_double(jparse_ctx_t *jctx, json_tok_t *tok, double *val)
+{
+    const char *tok_start = &jctx->js[tok->start];
+    const char *tok_end = &jctx->js[tok->end];
+    char *endptr;
+    double d = strtod(tok_start, &endptr);
+    if (endptr == tok_end) {
+        *val = d;
+        return OS_SUCCESS;
+    }
+    return -OS_FAIL;
+}
+
+static int json_tok_to_string_view(jparse_ctx_t *jctx, json_tok_t *tok, const char **val, int *len)
+{
+    *val = jctx->js + tok->start;
+    *len = tok->end - tok->start;
+    return OS_SUCCESS;
+}
+
 static int json_tok_to_string(jparse_ctx_t *jctx, json_tok_t *tok, char *val, int size)
 {
     if ((tok->end - tok->start) > (size - 1)) {
@@ -102,6 +130,12 @@ static int json_tok_to_string(jparse_ctx_t *jctx, json_tok_t *tok, char *val, in
     return OS_SUCCESS;
 }
 
+static bool token_matches_key(jparse_ctx_t *ctx, json_tok_t *tok, const char *key, size_t key_len)
+{
+    return ((size_t) (tok->end - tok->start) == key_len)
+           && (memcmp(ctx->js + tok->start, key, key_len) == 0);
+}
+
 static json_tok_t *json_obj_search(jparse_ctx_t *jctx, const char *key)
 {
     json_tok_t *tok = jctx->cur;
@@ -113,9 +147,10 @@ static json_tok_t *json_obj_search(jparse_ctx_t *jctx, const char *key)
         return NULL;
     }
 
+    size_t key_len = strlen(key);
     while (size--) {
         tok++;
-        if (token_matches_str(jctx, tok, key)) {
+        if (token_matches_key(jctx, tok, key, key_len)) {
             return tok;
         }
         tok = json_skip_elem(tok);
@@ -225,6 +260,24 @@ int json_obj_get_float(jparse_ctx_t *jctx, const char *name, float *val)
     return json_tok_to_float(jctx, tok, val);
 }
 
+int json_obj_get_double(jparse_ctx_t *jctx, const char *name, double *val)
+{
+    json_tok_t *tok = json_obj_get_val_tok(jctx, name, JSMN_PRIMITIVE);
+    if (!tok) {
+        return -OS_FAIL;
+    }
+    return json_tok_to_double(jctx, tok, val);
+}
+
+int json_obj_get_string_view(jparse_ctx_t *jctx, const char *name, const char **val, int *len)
+{
+    json_tok_t *tok = json_obj_get_val_tok(jctx, name, JSMN_STRING);
+    if (!tok) {
+        return -OS_FAIL;
+    }
+    return json_tok_to_string_view(jctx, tok, val, len);
+}
+
 int json_obj_get_string(jparse_ctx_t *jctx, const char *name, char *val, int size)
 {
     json_tok_t *tok = json_obj_get_val_tok(jctx, name, JSMN_STRING);
@@ -281,6 +334,109 @@ int json_obj_get_array_strlen(jparse_ctx_t *jctx, const char *name, int *strlen)
     return OS_SUCCESS;
 }
 
+static int json_tok_to_value(jparse_ctx_t *jctx, json_tok_t *tok, json_field_type_t type, void *val, int size)
+{
+    switch (type) {
+    case JSON_FIELD_BOOL:
+        return tok->type == JSMN_PRIMITIVE ? json_tok_to_bool(jctx, tok, val) : -OS_FAIL;
+    case JSON_FIELD_INT:
+        return tok->type == JSMN_PRIMITIVE ? json_tok_to_int(jctx, tok, val) : -OS_FAIL;
+    case JSON_FIELD_INT64:
+        return tok->type == JSMN_PRIMITIVE ? json_tok_to_int64(jctx, tok, val) : -OS_FAIL;
+    case JSON_FIELD_FLOAT:
+        return tok->type == JSMN_PRIMITIVE ? json_tok_to_float(jctx, tok, val) : -OS_FAIL;
+    case JSON_FIELD_DOUBLE:
+        return tok->type == JSMN_PRIMITIVE ? json_tok_to_double(jctx, tok, val) : -OS_FAIL;
+    case JSON_FIELD_STRING:
+        return tok->type == JSMN_STRING ? json_tok_to_string(jctx, tok, val, size) : -OS_FAIL;
+    default:
+        return -OS_FAIL;
+    }
+}
+
+int json_obj_get_fields(jparse_ctx_t *jctx, json_field_t *fields, int num_fields)
+{
+    json_tok_t *tok = jctx->cur;
+    if (tok->type != JSMN_OBJECT) {
+        return -OS_FAIL;
+    }
+
+    for (int i = 0; i < num_fields; i++) {
+        fields[i].found = false;
+    }
+
+    /* Keys usually come in the order of the fields, so the search for the next key
+     * starts at the field after the last match. Extracting fields in document order
+     * takes one pass over the object.
+     */
+    int num_found = 0;
+    int next = 0;
+    int size = tok->size;
+    while (size-- && num_found < num_fields) {
+        tok++;
+        for (int n = 0; n < num_fields; n++) {
+            json_field_t *field = &fields[(next + n) % num_fields];
+            if (field->found || !token_matches_key(jctx, tok, field->name, strlen(field->name))) {
+                continue;
+            }
+            if (json_tok_to_value(jctx, tok + 1, field->type, field->val, field->size) == OS_SUCCESS) {
+                field->found = true;
+                num_found++;
+            }
+            next = (next + n + 1) % num_fields;
+            break;
+        }
+        tok = json_skip_elem(tok);
+    }
+    return num_found == num_fields ? OS_SUCCESS : -OS_FAIL;
+}
+
+static int json_obj_decode(jparse_ctx_t *jctx, json_tok_t *obj, const json_struct_desc_t *desc, void *out)
+{
+    const json_struct_field_t *fields = desc->fields;
+    const int num_fields = desc->num_fields;
+    if (obj->type != JSMN_OBJECT || num_fields > JSON_STRUCT_MAX_FIELDS) {
+        return -OS_FAIL;
+    }
+
+    /* Same order heuristic as json_obj_get_fields(), found has a bit per field */
+    uint64_t found = 0;
+    int num_found = 0;
+    int next = 0;
+    int size = obj->size;
+    json_tok_t *tok = obj;
+    while (size-- && num_found < num_fields) {
+        tok++;
+        for (int n = 0; n < num_fields; n++) {
+            int i = (next + n) % num_fields;
+            const json_struct_field_t *field = &fields[i];
+            if ((found & (1ULL << i)) || !token_matches_key(jctx, tok, field->name, strlen(field->name))) {
+                continue;
+            }
+            void *val = (char *)out + field->offset;
+            int ret;
+            if (field->type == JSON_FIELD_OBJECT) {
+                ret = json_obj_decode(jctx, tok + 1, field->object, val);
+            } else {
+                ret = json_tok_to_value(jctx, tok + 1, field->type, val, field->size);
+            }
+            if (ret == OS_SUCCESS) {
+                found |= 1ULL << i;
+                num_found++;
+            }
+            next = (i + 1) % num_fields;
+            break;
+        }
+        tok = json_skip_elem(tok);
+    }
+    return num_found == num_fields ? OS_SUCCESS : -OS_FAIL;
+}
+
+int json_obj_decode_struct(jparse_ctx_t *jctx, const json_struct_desc_t *desc, void *out)
+{
+    return json_obj_decode(jctx, jctx->cur, desc, out);
+}
+
 static json_tok_t *json_arr_search(jparse_ctx_t *ctx, uint32_t index)
 {
     json_tok_t *tok = ctx->cur;
@@ -384,6 +540,24 @@ int json_arr_get_float(jparse_ctx_t *jctx, uint32_t index, float *val)
     return json_tok_to_float(jctx, tok, val);
 }
 
+int json_arr_get_double(jparse_ctx_t *jctx, uint32_t index, double *val)
+{
+    json_tok_t *tok = json_arr_get_val_tok(jctx, index, JSMN_PRIMITIVE);
+    if (!tok) {
+        return -OS_FAIL;
+    }
+    return json_tok_to_double(jctx, tok, val);
+}
+
+int json_arr_get_string_view(jparse_ctx_t *jctx, uint32_t index, const char **val, int *len)
+{
+    json_tok_t *tok = json_arr_get_val_tok(jctx, index, JSMN_STRING);
+    if (!tok) {
+        return -OS_FAIL;
+    }
+    return json_tok_to_string_view(jctx, tok, val, len);
+}
+
 int json_arr_get_string(jparse_ctx_t *jctx, uint32_t index, char *val, int size)
 {
     json_tok_t *tok = json_arr_get_val_tok(jctx, index, JSMN_STRING);
@@ -403,27 +577,54 @@ int json_arr_get_strlen(jparse_ctx_t *jctx, uint32_t index, int *strlen)
     return OS_SUCCESS;
 }
 
-int json_parse_start(jparse_ctx_t *jctx, const char *js, int len)
+/* Parse js into *tokens, growing the array by JSON_PARSER_TOKEN_CHUNK tokens whenever jsmn runs out of them.
+ * jsmn stops at the element it had no token for, so the parse resumes from there instead of starting over.
+ */
+static int json_parse_grow(jparse_ctx_t *jctx, const char *js, int len, json_tok_t **tokens, int *max_tokens)
 {
-    memset(jctx, 0, sizeof(jparse_ctx_t));
     jsmn_init(&jctx->parser);
-    int num_tokens = jsmn_parse(&jctx->parser, js, len, NULL, 0);
-    if (num_tokens <= 0) {
-        return -OS_FAIL;
+    while (1) {
+        int ret = JSMN_ERROR_NOMEM;
+        if (*tokens && *max_tokens > 0) {
+            ret = jsmn_parse(&jctx->parser, js, len, *tokens, *max_tokens);
+        }
+        if (ret != JSMN_ERROR_NOMEM) {
+            return ret;
+        }
+        int new_max_tokens = *max_tokens + JSON_PARSER_TOKEN_CHUNK;
+        json_tok_t *new_tokens = realloc(*tokens, new_max_tokens * sizeof(json_tok_t));
+        if (!new_tokens) {
+            return JSMN_ERROR_NOMEM;
+        }
+        *tokens = new_tokens;
+        *max_tokens = new_max_tokens;
     }
-    jctx->num_tokens = num_tokens;
-    jctx->tokens = calloc(num_tokens, sizeof(json_tok_t));
-    if (!jctx->tokens) {
-        return -OS_FAIL;
+}
+
+int json_parse_start(jparse_ctx_t *jctx, const char *js, int len)
+{
+    memset(jctx, 0, sizeof(jparse_ctx_t));
+    /* Roughly one token per 8 characters, the grown array is trimmed to the tokens used */
+    int max_tokens = len / 8;
+    json_tok_t *tokens = NULL;
+    if (max_tokens > 0) {
+        tokens = malloc(max_tokens * sizeof(json_tok_t));
     }
-    jctx->js = js;
-    jsmn_init(&jctx->parser);
-    int ret = jsmn_parse(&jctx->parser, js, len, jctx->tokens, jctx->num_tokens);
+    int ret = json_parse_grow(jctx, js, len, &tokens, &max_tokens);
     if (ret <= 0) {
-        free(jctx->tokens);
+        free(tokens);
         memset(jctx, 0, sizeof(jparse_ctx_t));
         return -OS_FAIL;
     }
+    if (ret < max_tokens) {
+        json_tok_t *trimmed = realloc(tokens, ret * sizeof(json_tok_t));
+        if (trimmed) {
+            tokens = trimmed;
+        }
+    }
+    jctx->num_tokens = ret;
+    jctx->tokens = tokens;
+    jctx->js = js;
     jctx->cur = jctx->tokens;
     return OS_SUCCESS;
 }
@@ -437,31 +638,56 @@ int json_parse_end(jparse_ctx_t *jctx)
     return OS_SUCCESS;
 }
 
-int json_parse_start_static(jparse_ctx_t *jctx, const char *js, int len, json_tok_t *buffer_tokens, int buffer_tokens_max_count)
+int json_parse_start_pool(jparse_ctx_t *jctx, const char *js, int len, json_tok_pool_t *pool)
 {
-    // Init
-    memset(buffer_tokens, 0, buffer_tokens_max_count * sizeof(json_tok_t));
     memset(jctx, 0, sizeof(jparse_ctx_t));
-
-    // Check fit
-    jsmn_init(&jctx->parser);
-    int num_tokens = jsmn_parse(&jctx->parser, js, len, NULL, 0);
-    if (num_tokens <= 0 || num_tokens > buffer_tokens_max_count) {
+    if (!pool) {
         return -OS_FAIL;
     }
-
-    // Set struct
-    jctx->num_tokens = num_tokens;
-    jctx->tokens = buffer_tokens;
+    int ret = json_parse_grow(jctx, js, len, &pool->tokens, &pool->max_tokens);
+    if (ret <= 0) {
+        memset(jctx, 0, sizeof(jparse_ctx_t));
+        return -OS_FAIL;
+    }
+    jctx->num_tokens = ret;
+    jctx->tokens = pool->tokens;
     jctx->js = js;
+    jctx->cur = jctx->tokens;
+    return OS_SUCCESS;
+}
+
+int json_parse_end_pool(jparse_ctx_t *jctx)
+{
+    /* The tokens stay in the pool for the next document */
+    memset(jctx, 0, sizeof(jparse_ctx_t));
+    return OS_SUCCESS;
+}
+
+void json_tok_pool_free(json_tok_pool_t *pool)
+{
+    if (pool) {
+        free(pool->tokens);
+        pool->tokens = NULL;
+        pool->max_tokens = 0;
+    }
+}
 
-    // Parse
+int json_parse_start_static(jparse_ctx_t *jctx, const char *js, int len, json_tok_t *buffer_tokens, int buffer_tokens_max_count)
+{
+    memset(jctx, 0, sizeof(jparse_ctx_t));
+
+    // Parse, running out of tokens means that the document doesn't fit
     jsmn_init(&jctx->parser);
-    int ret = jsmn_parse(&jctx->parser, js, len, jctx->tokens, jctx->num_tokens);
+    int ret = jsmn_parse(&jctx->parser, js, len, buffer_tokens, buffer_tokens_max_count);
     if (ret <= 0) {
         memset(jctx, 0, sizeof(jparse_ctx_t));
         return -OS_FAIL;
     }
+
+    // Set struct
+    jctx->num_tokens = ret;
+    jctx->tokens = buffer_tokens;
+    jctx->js = js;
     jctx->cur = jctx->tokens;
     return OS_SUCCESS;
 }
@@ -472,3 +698,104 @@ int json_parse_end_static(jparse_ctx_t *jctx)
     return OS_SUCCESS;
 }
 
+
+static int json_hex_to_u16(const char *hex, uint32_t *val)
+{
+    *val = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = hex[i];
+        int digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            return -OS_FAIL;
+        }
+        *val = (*val << 4) | digit;
+    }
+    return OS_SUCCESS;
+}
+
+int json_str_unescape(char *str, int *len)
+{
+    const char *in = str;
+    const char *end = str + *len;
+    char *out = str;
+
+    /* The unescaped string is never longer, so it is written over the escaped one */
+    while (in < end) {
+        if (*in != '\\') {
+            *out++ = *in++;
+            continue;
+        }
+        if (++in == end) {
+            return -OS_FAIL;
+        }
+        char c = *in++;
+        switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+            *out++ = c;
+            break;
+        case 'b':
+            *out++ = '\b';
+            break;
+        case 'f':
+            *out++ = '\f';
+            break;
+        case 'n':
+            *out++ = '\n';
+            break;
+        case 'r':
+            *out++ = '\r';
+            break;
+        case 't':
+            *out++ = '\t';
+            break;
+        case 'u': {
+            uint32_t cp;
+            if (end - in < 4 || json_hex_to_u16(in, &cp) != OS_SUCCESS) {
+                return -OS_FAIL;
+            }
+            in += 4;
+            /* Characters outside of the BMP are escaped as a surrogate pair */
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                uint32_t low;
+                if (end - in < 6 || in[0] != '\\' || in[1] != 'u' || json_hex_to_u16(in + 2, &low) != OS_SUCCESS ||
+                        low < 0xDC00 || low > 0xDFFF) {
+                    return -OS_FAIL;
+                }
+                in += 6;
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                return -OS_FAIL;
+            }
+            /* UTF-8 */
+            if (cp < 0x80) {
+                *out++ = cp;
+            } else if (cp < 0x800) {
+                *out++ = 0xC0 | (cp >> 6);
+                *out++ = 0x80 | (cp & 0x3F);
+            } else if (cp < 0x10000) {
+                *out++ = 0xE0 | (cp >> 12);
+                *out++ = 0x80 | ((cp >> 6) & 0x3F);
+                *out++ = 0x80 | (cp & 0x3F);
+            } else {
+                *out++ = 0xF0 | (cp >> 18);
+                *out++ = 0x80 | ((cp >> 12) & 0x3F);
+                *out++ = 0x80 | ((cp >> 6) & 0x3F);
+                *out++ = 0x80 | (cp & 0x3F);
+            }
+            break;
+        }
+        default:
+            return -OS_FAIL;
+        }
+    }
+    *len = out - str;
+    return OS_SUCCESS;
+}
@@ -0,0 +1,308 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <json_stream_parser.h>
+
+#define JSON_STREAM_DEFAULT_MAX_DEPTH       16
+#define JSON_STREAM_DEFAULT_MAX_KEY_LEN     64
+#define JSON_STREAM_DEFAULT_MAX_VALUE_LEN   256
+
+/* What the grammar allows next, outside of strings and primitives */
+typedef enum {
+    EXPECT_VALUE,
+    EXPECT_VALUE_OR_END,    /* just after '[' */
+    EXPECT_KEY,
+    EXPECT_KEY_OR_END,      /* just after '{' */
+    EXPECT_COLON,
+    EXPECT_COMMA_OR_END,
+    EXPECT_NOTHING,         /* the root value is complete */
+} json_stream_state_t;
+
+typedef enum {
+    LEX_NONE,
+    LEX_STRING,
+    LEX_ESCAPE,             /* the character after a backslash in a string */
+    LEX_PRIMITIVE,
+} json_stream_lex_t;
+
+struct json_stream_parser {
+    json_stream_config_t config;
+    json_stream_level_t *levels;    /* max_depth levels, the first depth are the open objects and arrays */
+    char *keys;                     /* max_key_len bytes for the key of each level */
+    char *token;                    /* string, key or primitive being lexed */
+    int token_len;
+    int depth;
+    json_stream_state_t state;
+    json_stream_lex_t lex;
+    bool token_is_key;
+    bool failed;
+};
+
+json_stream_handle_t json_stream_start(const json_stream_config_t *config)
+{
+    if (!config || !config->cb) {
+        return NULL;
+    }
+    json_stream_config_t cfg = *config;
+    cfg.max_depth = cfg.max_depth > 0 ? cfg.max_depth : JSON_STREAM_DEFAULT_MAX_DEPTH;
+    cfg.max_key_len = cfg.max_key_len > 0 ? cfg.max_key_len : JSON_STREAM_DEFAULT_MAX_KEY_LEN;
+    cfg.max_value_len = cfg.max_value_len > 0 ? cfg.max_value_len : JSON_STREAM_DEFAULT_MAX_VALUE_LEN;
+
+    /* Everything in one allocation, the parser doesn't allocate while parsing */
+    size_t levels_size = cfg.max_depth * sizeof(json_stream_level_t);
+    size_t keys_size = (size_t)cfg.max_depth * cfg.max_key_len;
+    /* Keys are lexed into the token buffer too */
+    size_t token_size = cfg.max_value_len > cfg.max_key_len ? cfg.max_value_len : cfg.max_key_len;
+    struct json_stream_parser *parser = calloc(1, sizeof(struct json_stream_parser) + levels_size + keys_size + token_size);
+    if (!parser) {
+        return NULL;
+    }
+    parser->config = cfg;
+    parser->levels = (json_stream_level_t *)(parser + 1);
+    parser->keys = (char *)parser->levels + levels_size;
+    parser->token = parser->keys + keys_size;
+    for (int i = 0; i < cfg.max_depth; i++) {
+        parser->levels[i].key = parser->keys + i * cfg.max_key_len;
+    }
+    parser->state = EXPECT_VALUE;
+    return parser;
+}
+
+static int json_stream_emit(struct json_stream_parser *parser, json_stream_event_type_t type, bool more)
+{
+    json_stream_event_t event = {
+        .type = type,
+        .value = parser->token,
+        .value_len = parser->token_len,
+        .more = more,
+        .depth = parser->depth,
+        .path = parser->levels,
+    };
+    return parser->config.cb(&event, parser->config.priv);
+}
+
+static void json_stream_value_done(struct json_stream_parser *parser)
+{
+    parser->state = parser->depth ? EXPECT_COMMA_OR_END : EXPECT_NOTHING;
+}
+
+static int json_stream_open(struct json_stream_parser *parser, bool is_array)
+{
+    if (parser->depth == parser->config.max_depth) {
+        return -OS_FAIL;
+    }
+    parser->token_len = 0;
+    if (json_stream_emit(parser, is_array ? JSON_STREAM_ARRAY_START : JSON_STREAM_OBJECT_START, false) != OS_SUCCESS) {
+        return -OS_FAIL;
+    }
+    json_stream_level_t *level = &parser->levels[parser->depth++];
+    level->is_array = is_array;
+    level->key_len = 0;
+    level->index = 0;
+    parser->state = is_array ? EXPECT_VALUE_OR_END : EXPECT_KEY_OR_END;
+    return OS_SUCCESS;
+}
+
+static int json_stream_close(struct json_stream_parser *parser, bool is_array)
+{
+    bool can_close = parser->state == EXPECT_COMMA_OR_END ||
+                     parser->state == (is_array ? EXPECT_VALUE_OR_END : EXPECT_KEY_OR_END);
+    if (!parser->depth || parser->levels[parser->depth - 1].is_array != is_array || !can_close) {
+        return -OS_FAIL;
+    }
+    parser->depth--;
+    parser->token_len = 0;
+    if (json_stream_emit(parser, is_array ? JSON_STREAM_ARRAY_END : JSON_STREAM_OBJECT_END, false) != OS_SUCCESS) {
+        return -OS_FAIL;
+    }
+    json_stream_value_done(parser);
+    return OS_SUCCESS;
+}
+
+static int json_stream_string_done(struct json_stream_parser *parser)
+{
+    if (parser->token_is_key) {
+        json_stream_level_t *level = &parser->levels[parser->depth - 1];
+        memcpy((char *)level->key, parser->token, parser->token_len);
+        level->key_len = parser->token_len;
+        parser->state = EXPECT_COLON;
+    } else {
+        if (json_stream_emit(parser, JSON_STREAM_STRING, false) != OS_SUCCESS) {
+            return -OS_FAIL;
+        }
+        json_stream_value_done(parser);
+    }
+    parser->token_len = 0;
+    parser->lex = LEX_NONE;
+    return OS_SUCCESS;
+}
+
+static int json_stream_string_char(struct json_stream_parser *parser, char c)
+{
+    int max_len = parser->token_is_key ? parser->config.max_key_len : parser->config.max_value_len;
+    if (parser->token_len == max_len) {
+        /* Deliver long strings in pieces, keys have to fit */
+        if (parser->token_is_key || json_stream_emit(parser, JSON_STREAM_STRING, true) != OS_SUCCESS) {
+            return -OS_FAIL;
+        }
+        parser->token_len = 0;
+    }
+    parser->token[parser->token_len++] = c;
+    return OS_SUCCESS;
+}
+
+static int json_stream_primitive_done(struct json_stream_parser *parser)
+{
+    parser->lex = LEX_NONE;
+    if (json_stream_emit(parser, JSON_STREAM_PRIMITIVE, false) != OS_SUCCESS) {
+        return -OS_FAIL;
+    }
+    parser->token_len = 0;
+    json_stream_value_done(parser);
+    return OS_SUCCESS;
+}
+
+/* Handle a character outside of strings and primitives */
+static int json_stream_structural_char(struct json_stream_parser *parser, char c)
+{
+    bool expect_value = parser->state == EXPECT_VALUE || parser->state == EXPECT_VALUE_OR_END;
+    bool expect_key = parser->state == EXPECT_KEY || parser->state == EXPECT_KEY_OR_END;
+
+    switch (c) {
+    case ' ':
+    case '\t':
+    case '\r':
+    case '\n':
+        return OS_SUCCESS;
+    case '{':
+    case '[':
+        return expect_value ? json_stream_open(parser, c == '[') : -OS_FAIL;
+    case '}':
+    case ']':
+        return json_stream_close(parser, c == ']');
+    case '"':
+        if (!expect_value && !expect_key) {
+            return -OS_FAIL;
+        }
+        parser->lex = LEX_STRING;
+        parser->token_is_key = expect_key;
+        parser->token_len = 0;
+        return OS_SUCCESS;
+    case ':':
+        if (parser->state != EXPECT_COLON) {
+            return -OS_FAIL;
+        }
+        parser->state = EXPECT_VALUE;
+        return OS_SUCCESS;
+    case ',': {
+        if (parser->state != EXPECT_COMMA_OR_END) {
+            return -OS_FAIL;
+        }
+        json_stream_level_t *level = &parser->levels[parser->depth - 1];
+        level->index++;
+        parser->state = level->is_array ? EXPECT_VALUE : EXPECT_KEY;
+        return OS_SUCCESS;
+    }
+    default:
+        /* Primitives are numbers, true, false and null, like in strict jsmn */
+        if (!expect_value || !(c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n')) {
+            return -OS_FAIL;
+        }
+        parser->lex = LEX_PRIMITIVE;
+        parser->token[0] = c;
+        parser->token_len = 1;
+        return OS_SUCCESS;
+    }
+}
+
+static int json_stream_char(struct json_stream_parser *parser, char c)
+{
+    switch (parser->lex) {
+    case LEX_STRING:
+        if (c == '"') {
+            return json_stream_string_done(parser);
+        }
+        if ((unsigned char)c < 0x20) {
+            return -OS_FAIL;
+        }
+        if (c == '\\') {
+            parser->lex = LEX_ESCAPE;
+        }
+        return json_stream_string_char(parser, c);
+    case LEX_ESCAPE:
+        parser->lex = LEX_STRING;
+        return json_stream_string_char(parser, c);
+    case LEX_PRIMITIVE:
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' || c == ']' || c == '}') {
+            /* The delimiter is handled once the primitive is done */
+            if (json_stream_primitive_done(parser) != OS_SUCCESS) {
+                return -OS_FAIL;
+            }
+            return json_stream_structural_char(parser, c);
+        }
+        if (parser->token_len == parser->config.max_value_len || (unsigned char)c < 0x20 || c == '"' || c == ':') {
+            return -OS_FAIL;
+        }
+        parser->token[parser->token_len++] = c;
+        return OS_SUCCESS;
+    case LEX_NONE:
+    default:
+        return json_stream_structural_char(parser, c);
+    }
+}
+
+int json_stream_feed(json_stream_handle_t parser, const char *data, int len)
+{
+    if (!parser || parser->failed) {
+        return -OS_FAIL;
+    }
+    for (int i = 0; i < len; i++) {
+        if (json_stream_char(parser, data[i]) != OS_SUCCESS) {
+            parser->failed = true;
+            return -OS_FAIL;
+        }
+    }
+    return OS_SUCCESS;
+}
+
+int json_stream_end(json_stream_handle_t parser)
+{
+    if (!parser) {
+        return -OS_FAIL;
+    }
+    /* A primitive at the root has no delimiter */
+    if (!parser->failed && parser->lex == LEX_PRIMITIVE && json_stream_primitive_done(parser) != OS_SUCCESS) {
+        parser->failed = true;
+    }
+    int ret = (!parser->failed && parser->state == EXPECT_NOTHING) ? OS_SUCCESS : -OS_FAIL;
+    free(parser);
+    return ret;
+}
+
+int json_stream_get_path(const json_stream_event_t *event, char *buf, int size)
+{
+    int len = 0;
+    if (!event || !buf || size <= 0) {
+        return -OS_FAIL;
+    }
+    buf[0] = '\0';
+    for (int i = 0; i < event->depth; i++) {
+        const json_stream_level_t *level = &event->path[i];
+        int n;
+        if (level->is_array) {
+            n = snprintf(buf + len, size - len, "/%d", level->index);
+        } else {
+            n = snprintf(buf + len, size - len, "/%.*s", level->key_len, level->key);
+        }
+        if (n < 0 || n >= size - len) {
+            return -OS_FAIL;
+        }
+        len += n;
+    }
+    return OS_SUCCESS;
+}
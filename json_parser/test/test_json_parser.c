@@ -58,4 +58,222 @@ TEST_CASE("json_parser basic tests", "[json_parser]")
     TEST_ASSERT(int64_val == 109174583252);
 
     json_parse_end(&jctx);
-}
\ No newline at end of file
+}
+
+TEST_CASE("json_parser reuses a token pool", "[json_parser]")
+{
+    jparse_ctx_t jctx;
+    json_tok_pool_t pool = JSON_TOK_POOL_INIT;
+    int int_val;
+
+    // The pool grows to fit the first document
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_parse_start_pool(&jctx, json_test_str, strlen(json_test_str), &pool));
+    TEST_ASSERT_NOT_NULL(pool.tokens);
+    TEST_ASSERT_GREATER_OR_EQUAL(jctx.num_tokens, pool.max_tokens);
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_int(&jctx, "int_val", &int_val));
+    TEST_ASSERT_EQUAL_INT(2017, int_val);
+    json_parse_end_pool(&jctx);
+
+    // and is reused as is for a smaller one
+    json_tok_t *tokens = pool.tokens;
+    int max_tokens = pool.max_tokens;
+    const char *small_str = "{\"int_val\":42}";
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_parse_start_pool(&jctx, small_str, strlen(small_str), &pool));
+    TEST_ASSERT_EQUAL_PTR(tokens, pool.tokens);
+    TEST_ASSERT_EQUAL(max_tokens, pool.max_tokens);
+    TEST_ASSERT_EQUAL(3, jctx.num_tokens);
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_int(&jctx, "int_val", &int_val));
+    TEST_ASSERT_EQUAL_INT(42, int_val);
+    json_parse_end_pool(&jctx);
+
+    // Invalid documents fail without touching the context
+    TEST_ASSERT_NOT_EQUAL(OS_SUCCESS, json_parse_start_pool(&jctx, "{\"int_val\":", 11, &pool));
+    TEST_ASSERT_NULL(jctx.tokens);
+
+    json_tok_pool_free(&pool);
+    TEST_ASSERT_NULL(pool.tokens);
+}
+
+TEST_CASE("json_parser static parse checks the buffer size", "[json_parser]")
+{
+    jparse_ctx_t jctx;
+    json_tok_t tokens[32];
+    int int_val;
+
+    TEST_ASSERT_NOT_EQUAL(OS_SUCCESS, json_parse_start_static(&jctx, json_test_str, strlen(json_test_str), tokens, 8));
+
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_parse_start_static(&jctx, json_test_str, strlen(json_test_str), tokens, 32));
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_int(&jctx, "int_val", &int_val));
+    TEST_ASSERT_EQUAL_INT(2017, int_val);
+    json_parse_end_static(&jctx);
+}
+
+TEST_CASE("json_parser extracts a list of fields", "[json_parser]")
+{
+    jparse_ctx_t jctx;
+    char str_val[64];
+    char arrays[8];
+    int int_val;
+    int64_t int64_val;
+    bool bool_val, objects;
+    float float_val;
+    int missing_val;
+
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_parse_start(&jctx, json_test_str, strlen(json_test_str)));
+
+    // Not in document order, and the last one is optional
+    json_field_t fields[] = {
+        { .name = "int_val", .type = JSON_FIELD_INT, .val = &int_val },
+        { .name = "str_val", .type = JSON_FIELD_STRING, .val = str_val, .size = sizeof(str_val) },
+        { .name = "bool_val", .type = JSON_FIELD_BOOL, .val = &bool_val },
+        { .name = "float_val", .type = JSON_FIELD_FLOAT, .val = &float_val },
+        { .name = "int_64", .type = JSON_FIELD_INT64, .val = &int64_val },
+        { .name = "missing", .type = JSON_FIELD_INT, .val = &missing_val },
+    };
+    const int num_fields = sizeof(fields) / sizeof(fields[0]);
+    TEST_ASSERT_NOT_EQUAL(OS_SUCCESS, json_obj_get_fields(&jctx, fields, num_fields));
+    for (int i = 0; i < num_fields - 1; ++i) {
+        TEST_ASSERT(fields[i].found);
+    }
+    TEST_ASSERT_EQUAL(false, fields[num_fields - 1].found);
+    TEST_ASSERT_EQUAL_INT(2017, int_val);
+    TEST_ASSERT_EQUAL_STRING("JSON Parser", str_val);
+    TEST_ASSERT_EQUAL(false, bool_val);
+    TEST_ASSERT(fabs(float_val - 2.0f) < 0.0001f);
+    TEST_ASSERT(int64_val == 109174583252);
+
+    // Values of the wrong type aren't stored
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_object(&jctx, "features"));
+    json_field_t feature_fields[] = {
+        { .name = "objects", .type = JSON_FIELD_BOOL, .val = &objects },
+        { .name = "arrays", .type = JSON_FIELD_STRING, .val = arrays, .size = sizeof(arrays) },
+    };
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_fields(&jctx, feature_fields, 2));
+    TEST_ASSERT_EQUAL(true, objects);
+    TEST_ASSERT_EQUAL_STRING("yes", arrays);
+    feature_fields[1].type = JSON_FIELD_INT;
+    TEST_ASSERT_NOT_EQUAL(OS_SUCCESS, json_obj_get_fields(&jctx, feature_fields, 2));
+    TEST_ASSERT_EQUAL(false, feature_fields[1].found);
+    json_obj_leave_object(&jctx);
+
+    json_parse_end(&jctx);
+}
+
+typedef struct {
+    bool objects;
+    char arrays[8];
+} test_features_t;
+
+typedef struct {
+    char str_val[16];
+    float float_val;
+    int int_val;
+    bool bool_val;
+    test_features_t features;
+    int64_t int_64;
+    int missing;
+} test_struct_t;
+
+static const json_struct_field_t s_features_fields[] = {
+    JSON_STRUCT_BOOL(test_features_t, objects, "objects"),
+    JSON_STRUCT_STRING(test_features_t, arrays, "arrays"),
+};
+static const json_struct_desc_t s_features_desc = JSON_STRUCT_DESC(s_features_fields);
+
+static const json_struct_field_t s_test_fields[] = {
+    JSON_STRUCT_STRING(test_struct_t, str_val, "str_val"),
+    JSON_STRUCT_FLOAT(test_struct_t, float_val, "float_val"),
+    JSON_STRUCT_INT(test_struct_t, int_val, "int_val"),
+    JSON_STRUCT_BOOL(test_struct_t, bool_val, "bool_val"),
+    JSON_STRUCT_OBJECT(test_struct_t, features, "features", s_features_desc),
+    JSON_STRUCT_INT64(test_struct_t, int_64, "int_64"),
+};
+static const json_struct_desc_t s_test_desc = JSON_STRUCT_DESC(s_test_fields);
+
+TEST_CASE("json_parser decodes a struct", "[json_parser]")
+{
+    jparse_ctx_t jctx;
+    test_struct_t out = { .missing = 7 };
+
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_parse_start(&jctx, json_test_str, strlen(json_test_str)));
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_decode_struct(&jctx, &s_test_desc, &out));
+    TEST_ASSERT_EQUAL_STRING("JSON Parser", out.str_val);
+    TEST_ASSERT(fabs(out.float_val - 2.0f) < 0.0001f);
+    TEST_ASSERT_EQUAL_INT(2017, out.int_val);
+    TEST_ASSERT_EQUAL(false, out.bool_val);
+    TEST_ASSERT_EQUAL(true, out.features.objects);
+    TEST_ASSERT_EQUAL_STRING("yes", out.features.arrays);
+    TEST_ASSERT(out.int_64 == 109174583252);
+    TEST_ASSERT_EQUAL_INT(7, out.missing);
+
+    // Strings longer than the member fail the field instead of overflowing it
+    json_parse_end(&jctx);
+    const char *long_str = "{\"objects\":true,\"arrays\":\"much too long\"}";
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_parse_start(&jctx, long_str, strlen(long_str)));
+    TEST_ASSERT_NOT_EQUAL(OS_SUCCESS, json_obj_decode_struct(&jctx, &s_features_desc, &out.features));
+    TEST_ASSERT_EQUAL_STRING("yes", out.features.arrays);
+    json_parse_end(&jctx);
+}
+
+TEST_CASE("json_parser gets doubles and string views", "[json_parser]")
+{
+    char js[] = "{\"pi\":3.14159265358979,\"big\":109174583252,\"path\":\"a\\/b\\tc \\u00e9\\u20ac\\ud83d\\ude00\","
+                "\"list\":[\"x\\\"y\", 2.5]}";
+    jparse_ctx_t jctx;
+    double d;
+    int64_t i64;
+    const char *view;
+    int len;
+
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_parse_start(&jctx, js, strlen(js)));
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_double(&jctx, "pi", &d));
+    TEST_ASSERT(fabs(d - 3.14159265358979) < 1e-12);
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_int64(&jctx, "big", &i64));
+    TEST_ASSERT(i64 == 109174583252);
+
+    // The view points into the document, which is modifiable here and can be unescaped in place
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_string_view(&jctx, "path", &view, &len));
+    TEST_ASSERT(view > js && view < js + sizeof(js));
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_str_unescape((char *)view, &len));
+    TEST_ASSERT_EQUAL(15, len);
+    TEST_ASSERT_EQUAL(0, memcmp("a/b\tc \xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80", view, len));
+
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_array(&jctx, "list", &len));
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_arr_get_string_view(&jctx, 0, &view, &len));
+    TEST_ASSERT_EQUAL(4, len);
+    TEST_ASSERT_EQUAL(0, memcmp("x\\\"y", view, len));
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_arr_get_double(&jctx, 1, &d));
+    TEST_ASSERT(d == 2.5);
+    json_obj_leave_array(&jctx);
+    json_parse_end(&jctx);
+
+    // Invalid escape sequences
+    char bad_escape[] = "a\\x";
+    len = strlen(bad_escape);
+    TEST_ASSERT_NOT_EQUAL(OS_SUCCESS, json_str_unescape(bad_escape, &len));
+    char lone_surrogate[] = "\\ud83d";
+    len = strlen(lone_surrogate);
+    TEST_ASSERT_NOT_EQUAL(OS_SUCCESS, json_str_unescape(lone_surrogate, &len));
+}
+
+TEST_CASE("json_parser skips nested elements", "[json_parser]")
+{
+    const char *js = "{\"a\":[[1,2,{\"x\":[3,4]}],{\"y\":{\"z\":[]}},\"s\"],\"b\":{\"c\":{\"d\":5}},\"e\":6}";
+    jparse_ctx_t jctx;
+    int int_val;
+    char str_val[4];
+
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_parse_start(&jctx, js, strlen(js)));
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_int(&jctx, "e", &int_val));
+    TEST_ASSERT_EQUAL_INT(6, int_val);
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_array(&jctx, "a", &int_val));
+    TEST_ASSERT_EQUAL_INT(3, int_val);
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_arr_get_string(&jctx, 2, str_val, sizeof(str_val)));
+    TEST_ASSERT_EQUAL_STRING("s", str_val);
+    json_obj_leave_array(&jctx);
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_object(&jctx, "b"));
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_object(&jctx, "c"));
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_obj_get_int(&jctx, "d", &int_val));
+    TEST_ASSERT_EQUAL_INT(5, int_val);
+    json_parse_end(&jctx);
+}
@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <string.h>
+#include "json_stream_parser.h"
+#include "unity.h"
+
+static const char s_stream_test_str[] =
+    "{\"str_val\" : \"JSON \\\"Parser\\\"\",\n"
+    "\"int_val\" : -2017,\n"
+    "\"supported_el\" : [\"bool\", [true, null], {\"x\": 1.5e3}],\n"
+    "\"features\" : { \"objects\":true, \"arrays\":\"yes\"},\n"
+    "\"empty\" : {}}";
+
+static const char *s_expected_events =
+    "{ \n"
+    "s /str_val JSON \\\"Parser\\\"\n"
+    "p /int_val -2017\n"
+    "[ /supported_el\n"
+    "s /supported_el/0 bool\n"
+    "[ /supported_el/1\n"
+    "p /supported_el/1/0 true\n"
+    "p /supported_el/1/1 null\n"
+    "] /supported_el/1\n"
+    "{ /supported_el/2\n"
+    "p /supported_el/2/x 1.5e3\n"
+    "} /supported_el/2\n"
+    "] /supported_el\n"
+    "{ /features\n"
+    "p /features/objects true\n"
+    "s /features/arrays yes\n"
+    "} /features\n"
+    "{ /empty\n"
+    "} /empty\n"
+    "} \n";
+
+typedef struct {
+    char out[1024];
+    int len;
+    bool more;          // the last event was a piece of a string
+} stream_test_ctx_t;
+
+static int stream_test_cb(const json_stream_event_t *event, void *priv)
+{
+    static const char types[] = "{}[]sp";
+    stream_test_ctx_t *ctx = priv;
+    char path[64];
+
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_stream_get_path(event, path, sizeof(path)));
+    int n;
+    if (event->type == JSON_STREAM_STRING || event->type == JSON_STREAM_PRIMITIVE) {
+        // The pieces of a long string are concatenated
+        if (!ctx->more) {
+            ctx->len += snprintf(ctx->out + ctx->len, sizeof(ctx->out) - ctx->len, "%c %s ", types[event->type], path);
+        }
+        n = snprintf(ctx->out + ctx->len, sizeof(ctx->out) - ctx->len, "%.*s%s", event->value_len, event->value,
+                     event->more ? "" : "\n");
+        ctx->more = event->more;
+    } else {
+        n = snprintf(ctx->out + ctx->len, sizeof(ctx->out) - ctx->len, "%c %s\n", types[event->type], path);
+    }
+    ctx->len += n;
+    return OS_SUCCESS;
+}
+
+static void stream_test_parse(int chunk_size, int max_value_len)
+{
+    stream_test_ctx_t ctx = { 0 };
+    json_stream_config_t config = {
+        .cb = stream_test_cb,
+        .priv = &ctx,
+        .max_depth = 3,
+        .max_value_len = max_value_len,
+    };
+    json_stream_handle_t parser = json_stream_start(&config);
+    TEST_ASSERT_NOT_NULL(parser);
+
+    const int len = strlen(s_stream_test_str);
+    for (int i = 0; i < len; i += chunk_size) {
+        int n = len - i < chunk_size ? len - i : chunk_size;
+        TEST_ASSERT_EQUAL(OS_SUCCESS, json_stream_feed(parser, s_stream_test_str + i, n));
+    }
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_stream_end(parser));
+    TEST_ASSERT_EQUAL_STRING(s_expected_events, ctx.out);
+}
+
+TEST_CASE("json_stream_parser emits events independently of the chunks", "[json_parser]")
+{
+    stream_test_parse(sizeof(s_stream_test_str), 0);
+    stream_test_parse(1, 0);
+    stream_test_parse(7, 0);
+    // Strings are delivered in pieces
+    stream_test_parse(5, 6);
+}
+
+TEST_CASE("json_stream_parser rejects invalid documents", "[json_parser]")
+{
+    static const char *invalid[] = {
+        "{\"a\":1,}",
+        "{\"a\" 1}",
+        "[1 2]",
+        "{\"a\":[1}",
+        "{1:2}",
+        "[[[[1]]]]",    // deeper than max_depth
+        "{\"a\":1}}",
+        "{\"a\":1",     // incomplete
+        "[\"too long primitive\", 1234567890]",
+    };
+    stream_test_ctx_t ctx;
+    json_stream_config_t config = {
+        .cb = stream_test_cb,
+        .priv = &ctx,
+        .max_depth = 3,
+        .max_value_len = 8,
+    };
+
+    for (int i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        memset(&ctx, 0, sizeof(ctx));
+        json_stream_handle_t parser = json_stream_start(&config);
+        TEST_ASSERT_NOT_NULL(parser);
+        json_stream_feed(parser, invalid[i], strlen(invalid[i]));
+        TEST_ASSERT_NOT_EQUAL(OS_SUCCESS, json_stream_end(parser));
+    }
+
+    // A primitive at the root ends with the document
+    memset(&ctx, 0, sizeof(ctx));
+    json_stream_handle_t parser = json_stream_start(&config);
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_stream_feed(parser, "42", 2));
+    TEST_ASSERT_EQUAL(OS_SUCCESS, json_stream_end(parser));
+    TEST_ASSERT_EQUAL_STRING("p  42\n", ctx.out);
+}
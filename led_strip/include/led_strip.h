@@ -6,9 +6,11 @@
 #pragma once
 
 #include <stdint.h>
+#include <stddef.h>
 #include "esp_err.h"
 #include "led_strip_rmt.h"
 #include "led_strip_spi.h"
+#include "led_strip_anim.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -50,6 +52,58 @@ esp_err_t led_strip_set_pixel(led_strip_handle_t strip, uint32_t index, uint32_t
  */
 esp_err_t led_strip_set_pixel_rgbw(led_strip_handle_t strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue, uint32_t white);
 
+/**
+ * @brief Set colors of consecutive pixels
+ *
+ * @note Colors are reordered for the strip in one loop, which is much faster than calling `led_strip_set_pixel` for each pixel
+ * @note LED_STRIP_COLOR_FORMAT_RGBW is only supported by strips with the white component, other formats set white component to 0
+ *
+ * @param strip: LED strip
+ * @param start: index of the first pixel to set
+ * @param count: number of pixels to set
+ * @param pixels: colors of the pixels, 3 or 4 bytes per pixel depending on `format`
+ * @param format: color format of `pixels`
+ *
+ * @return
+ *      - ESP_OK: Set pixels successfully
+ *      - ESP_ERR_INVALID_ARG: Set pixels failed because of invalid parameters
+ *      - ESP_FAIL: Set pixels failed because other error occurred
+ */
+esp_err_t led_strip_set_pixels(led_strip_handle_t strip, uint32_t start, uint32_t count, const uint8_t *pixels, led_strip_color_format_t format);
+
+/**
+ * @brief Set consecutive pixels to the same RGB color
+ *
+ * @param strip: LED strip
+ * @param start: index of the first pixel to set
+ * @param count: number of pixels to set
+ * @param red: red part of color
+ * @param green: green part of color
+ * @param blue: blue part of color
+ *
+ * @return
+ *      - ESP_OK: Fill pixels successfully
+ *      - ESP_ERR_INVALID_ARG: Fill pixels failed because of invalid parameters
+ *      - ESP_FAIL: Fill pixels failed because other error occurred
+ */
+esp_err_t led_strip_fill(led_strip_handle_t strip, uint32_t start, uint32_t count, uint32_t red, uint32_t green, uint32_t blue);
+
+/**
+ * @brief Set brightness applied to all pixels when they are sent to the strip
+ *
+ * @note Pixel memory is not changed, the brightness is applied by the encoder (together with gamma correction, if configured)
+ * @note Takes effect from the next refresh, don't call it while a refresh is in progress
+ *
+ * @param strip: LED strip
+ * @param brightness: brightness, 255 means full brightness (default)
+ *
+ * @return
+ *      - ESP_OK: Set brightness successfully
+ *      - ESP_ERR_INVALID_ARG: Set brightness failed because of invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED: The backend doesn't support brightness (only RMT backend supports it)
+ */
+esp_err_t led_strip_set_brightness(led_strip_handle_t strip, uint8_t brightness);
+
 /**
  * @brief Refresh memory colors to LEDs
  *
@@ -64,6 +118,76 @@ esp_err_t led_strip_set_pixel_rgbw(led_strip_handle_t strip, uint32_t index, uin
  */
 esp_err_t led_strip_refresh(led_strip_handle_t strip);
 
+/**
+ * @brief Start refreshing memory colors to LEDs, without waiting for the end of transmission
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - ESP_OK: Refresh started successfully
+ *      - ESP_FAIL: Refresh failed because some other error occurred
+ *
+ * @note:
+ *      Without `flags.double_buffer`, pixels must not be changed until `led_strip_refresh_wait_done` returns.
+ * @note:
+ *      With `flags.double_buffer`, the written pixels are sent from the other buffer and the next frame can be set right away.
+ *      Calling this function again waits for the end of the previous refresh first.
+ */
+esp_err_t led_strip_refresh_async(led_strip_handle_t strip);
+
+/**
+ * @brief Wait for the end of refresh started by `led_strip_refresh_async`
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - ESP_OK: Refresh finished successfully
+ *      - ESP_FAIL: Refresh failed because some other error occurred
+ */
+esp_err_t led_strip_refresh_wait_done(led_strip_handle_t strip);
+
+/**
+ * @brief Create a group of LED strips refreshed together
+ *
+ * @note Strips can use different backends. The strips are not owned by the group and must outlive it.
+ *
+ * @param strips: Array of LED strips
+ * @param num_strips: Number of LED strips in the array
+ * @param ret_group: Returned LED strip group handle
+ *
+ * @return
+ *      - ESP_OK: Create LED strip group successfully
+ *      - ESP_ERR_INVALID_ARG: Create LED strip group failed because of invalid argument
+ *      - ESP_ERR_NO_MEM: Create LED strip group failed because of out of memory
+ */
+esp_err_t led_strip_new_group(const led_strip_handle_t *strips, size_t num_strips, led_strip_group_handle_t *ret_group);
+
+/**
+ * @brief Refresh all LED strips of a group
+ *
+ * Transmissions of all strips are started back to back and waited for once,
+ * so the refresh takes as long as the longest strip instead of the sum of all strips.
+ *
+ * @param group: LED strip group
+ *
+ * @return
+ *      - ESP_OK: Refresh successfully
+ *      - ESP_ERR_INVALID_ARG: Refresh failed because of invalid argument
+ *      - ESP_FAIL: Refresh failed because some other error occurred
+ */
+esp_err_t led_strip_group_refresh(led_strip_group_handle_t group);
+
+/**
+ * @brief Free LED strip group resources, the strips are not deleted
+ *
+ * @param group: LED strip group
+ *
+ * @return
+ *      - ESP_OK: Free resources successfully
+ *      - ESP_ERR_INVALID_ARG: Free resources failed because of invalid argument
+ */
+esp_err_t led_strip_group_del(led_strip_group_handle_t group);
+
 /**
  * @brief Clear LED strip (turn off all LEDs)
  *
@@ -0,0 +1,196 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+#include "led_strip_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief LED strip animation handle
+ */
+typedef struct led_strip_anim_t *led_strip_anim_handle_t;
+
+/**
+ * @brief Callback rendering a frame of an animation
+ *
+ * @note Called from the animation task once per frame period. Pixels are set by `led_strip_anim_set_pixels` and `led_strip_anim_fill`.
+ *
+ * @param anim: Animation handle
+ * @param frame: Number of the frame, counted from `led_strip_anim_start`
+ * @param user_ctx: User context from led_strip_anim_config_t
+ */
+typedef void (*led_strip_anim_frame_cb_t)(led_strip_anim_handle_t anim, uint32_t frame, void *user_ctx);
+
+/**
+ * @brief LED strip animation configuration
+ */
+typedef struct {
+    led_strip_handle_t strip;             /*!< LED strip driven by the animation, must outlive the animation */
+    uint32_t num_leds;                    /*!< Number of LEDs of the strip */
+    led_strip_color_format_t color_format; /*!< Color format of pixels set by `led_strip_anim_set_pixels` */
+    uint32_t fps;                         /*!< Frames per second */
+    led_strip_anim_frame_cb_t frame_cb;   /*!< Frame rendering callback, can be NULL if pixels are only set from other tasks */
+    void *user_ctx;                       /*!< User context passed to frame_cb */
+    uint32_t task_stack_size;             /*!< Animation task stack size, set to 0 to use the default size (4096) */
+    uint32_t task_priority;               /*!< Animation task priority, set to 0 to use the default priority (5) */
+    int task_core_id;                     /*!< Animation task core, or tskNO_AFFINITY or a negative value for any core.
+                                               Note that 0 pins the task to core 0: start from LED_STRIP_ANIM_DEFAULT_CONFIG() */
+} led_strip_anim_config_t;
+
+/**
+ * @brief Default animation configuration: 30 frames per second, default task stack size and priority, any core
+ *
+ * @note strip, num_leds, color_format and frame_cb must be set after
+ */
+#define LED_STRIP_ANIM_DEFAULT_CONFIG() {       \
+    .strip = NULL,                              \
+    .num_leds = 0,                              \
+    .color_format = LED_STRIP_COLOR_FORMAT_RGB, \
+    .fps = 30,                                  \
+    .frame_cb = NULL,                           \
+    .user_ctx = NULL,                           \
+    .task_stack_size = 0,                       \
+    .task_priority = 0,                         \
+    .task_core_id = tskNO_AFFINITY,             \
+}
+
+/**
+ * @brief LED strip animation statistics
+ */
+typedef struct {
+    uint32_t frames;            /*!< Elapsed frame periods */
+    uint32_t refreshes;         /*!< Frames sent to the strip */
+    uint32_t skipped;           /*!< Frames not sent because no pixel changed */
+    uint32_t overruns;          /*!< Frame periods missed because rendering and refreshing took longer than the period */
+} led_strip_anim_stats_t;
+
+/**
+ * @brief Create LED strip animation
+ *
+ * The animation keeps a copy of the pixel colors. Each frame period, it calls `frame_cb`,
+ * passes only the pixels changed since the previous frame to the strip and refreshes it.
+ * If no pixel changed, the refresh is skipped.
+ *
+ * @note The animation is created stopped. Pixels of the strip must not be changed by other API while the animation runs.
+ *
+ * @param config: Animation configuration
+ * @param ret_anim: Returned animation handle
+ *
+ * @return
+ *      - ESP_OK: Create animation successfully
+ *      - ESP_ERR_INVALID_ARG: Create animation failed because of invalid argument
+ *      - ESP_ERR_NO_MEM: Create animation failed because of out of memory
+ */
+esp_err_t led_strip_anim_new(const led_strip_anim_config_t *config, led_strip_anim_handle_t *ret_anim);
+
+/**
+ * @brief Start running the animation
+ *
+ * @note All pixels are sent to the strip in the first frame.
+ *
+ * @param anim: Animation handle
+ *
+ * @return
+ *      - ESP_OK: Start animation successfully
+ *      - ESP_ERR_INVALID_ARG: Start animation failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Start animation failed because it's already running
+ *      - ESP_ERR_NO_MEM: Start animation failed because the task can't be created
+ */
+esp_err_t led_strip_anim_start(led_strip_anim_handle_t anim);
+
+/**
+ * @brief Stop running the animation, after the current frame is sent
+ *
+ * @note Must not be called from `frame_cb`
+ *
+ * @param anim: Animation handle
+ *
+ * @return
+ *      - ESP_OK: Stop animation successfully
+ *      - ESP_ERR_INVALID_ARG: Stop animation failed because of invalid argument
+ */
+esp_err_t led_strip_anim_stop(led_strip_anim_handle_t anim);
+
+/**
+ * @brief Set colors of consecutive pixels of the animation
+ *
+ * @note Can be called from `frame_cb` or other tasks, the pixels are sent in the next frame if their colors changed.
+ *
+ * @param anim: Animation handle
+ * @param start: Index of the first pixel to set
+ * @param count: Number of pixels to set
+ * @param pixels: Colors of the pixels, in `color_format` of the animation
+ *
+ * @return
+ *      - ESP_OK: Set pixels successfully
+ *      - ESP_ERR_INVALID_ARG: Set pixels failed because of invalid argument
+ */
+esp_err_t led_strip_anim_set_pixels(led_strip_anim_handle_t anim, uint32_t start, uint32_t count, const uint8_t *pixels);
+
+/**
+ * @brief Set consecutive pixels of the animation to the same RGB color
+ *
+ * @note Can be called from `frame_cb` or other tasks. White component is cleared in RGBW color format.
+ *
+ * @param anim: Animation handle
+ * @param start: Index of the first pixel to set
+ * @param count: Number of pixels to set
+ * @param red: Red part of color
+ * @param green: Green part of color
+ * @param blue: Blue part of color
+ *
+ * @return
+ *      - ESP_OK: Fill pixels successfully
+ *      - ESP_ERR_INVALID_ARG: Fill pixels failed because of invalid argument
+ */
+esp_err_t led_strip_anim_fill(led_strip_anim_handle_t anim, uint32_t start, uint32_t count, uint8_t red, uint8_t green, uint8_t blue);
+
+/**
+ * @brief Send all pixels in the next frame, even if they didn't change
+ *
+ * @note E.g. after changing brightness of the strip by `led_strip_set_brightness`
+ *
+ * @param anim: Animation handle
+ *
+ * @return
+ *      - ESP_OK: Invalidate pixels successfully
+ *      - ESP_ERR_INVALID_ARG: Invalidate pixels failed because of invalid argument
+ */
+esp_err_t led_strip_anim_invalidate(led_strip_anim_handle_t anim);
+
+/**
+ * @brief Get animation statistics
+ *
+ * @param anim: Animation handle
+ * @param stats: Returned statistics
+ *
+ * @return
+ *      - ESP_OK: Get statistics successfully
+ *      - ESP_ERR_INVALID_ARG: Get statistics failed because of invalid argument
+ */
+esp_err_t led_strip_anim_get_stats(led_strip_anim_handle_t anim, led_strip_anim_stats_t *stats);
+
+/**
+ * @brief Stop the animation and free its resources, the strip is not deleted
+ *
+ * @param anim: Animation handle
+ *
+ * @return
+ *      - ESP_OK: Free resources successfully
+ *      - ESP_ERR_INVALID_ARG: Free resources failed because of invalid argument
+ */
+esp_err_t led_strip_anim_del(led_strip_anim_handle_t anim);
+
+#ifdef __cplusplus
+}
+#endif
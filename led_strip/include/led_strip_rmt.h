@@ -20,7 +20,9 @@ extern "C" {
 typedef struct {
     rmt_clock_source_t clk_src; /*!< RMT clock source */
     uint32_t resolution_hz;     /*!< RMT tick resolution, if set to zero, a default resolution (10MHz) will be applied */
-    size_t mem_block_symbols;   /*!< How many RMT symbols can one RMT channel hold at one time. Set to 0 will fallback to use the default size. */
+    size_t mem_block_symbols;   /*!< How many RMT symbols can one RMT channel hold at one time. Set to 0 will fallback to use the default size.
+                                     Without DMA, a bigger size makes refreshing of long strips more tolerant to interrupt latency. */
+    float gamma;                /*!< Gamma correction applied to color components while encoding (e.g. 2.8), set to 0 to disable it */
     struct {
         uint32_t with_dma: 1;   /*!< Use DMA to transmit data */
     } flags;
@@ -20,6 +20,15 @@ typedef enum {
     LED_PIXEL_FORMAT_INVALID /*!< Invalid pixel format */
 } led_pixel_format_t;
 
+/**
+ * @brief Color format of pixels passed to `led_strip_set_pixels`
+ */
+typedef enum {
+    LED_STRIP_COLOR_FORMAT_RGB,  /*!< 3 bytes per pixel: red, green, blue */
+    LED_STRIP_COLOR_FORMAT_GRB,  /*!< 3 bytes per pixel: green, red, blue, the order sent to WS2812 */
+    LED_STRIP_COLOR_FORMAT_RGBW, /*!< 4 bytes per pixel: red, green, blue, white */
+} led_strip_color_format_t;
+
 /**
  * @brief LED strip model
  * @note Different led model may have different timing parameters, so we need to distinguish them.
@@ -35,6 +44,11 @@ typedef enum {
  */
 typedef struct led_strip_t *led_strip_handle_t;
 
+/**
+ * @brief LED strip group handle
+ */
+typedef struct led_strip_group_t *led_strip_group_handle_t;
+
 /**
  * @brief LED Strip Configuration
  */
@@ -46,6 +60,7 @@ typedef struct {
 
     struct {
         uint32_t invert_out: 1; /*!< Invert output signal */
+        uint32_t double_buffer: 1; /*!< Allocate two pixel buffers, so that pixels can be set while the previous refresh is transmitted */
     } flags;
 } led_strip_config_t;
 
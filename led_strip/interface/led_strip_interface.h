@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 #include "esp_err.h"
+#include "led_strip_types.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -88,6 +89,73 @@ struct led_strip_t {
      *      - ESP_FAIL: Free resources failed because error occurred
      */
     esp_err_t (*del)(led_strip_t *strip);
+
+    /**
+     * @brief Set colors of consecutive pixels (optional, `set_pixel` is called for each pixel if not set)
+     *
+     * @param strip: LED strip
+     * @param start: index of the first pixel to set
+     * @param count: number of pixels to set
+     * @param pixels: colors of the pixels
+     * @param format: color format of `pixels`
+     *
+     * @return
+     *      - ESP_OK: Set pixels successfully
+     *      - ESP_ERR_INVALID_ARG: Set pixels failed because of invalid parameters
+     */
+    esp_err_t (*set_pixels)(led_strip_t *strip, uint32_t start, uint32_t count, const uint8_t *pixels, led_strip_color_format_t format);
+
+    /**
+     * @brief Set consecutive pixels to the same RGB color (optional, `set_pixel` is called for each pixel if not set)
+     *
+     * @param strip: LED strip
+     * @param start: index of the first pixel to set
+     * @param count: number of pixels to set
+     * @param red: red part of color
+     * @param green: green part of color
+     * @param blue: blue part of color
+     *
+     * @return
+     *      - ESP_OK: Fill pixels successfully
+     *      - ESP_ERR_INVALID_ARG: Fill pixels failed because of invalid parameters
+     */
+    esp_err_t (*fill)(led_strip_t *strip, uint32_t start, uint32_t count, uint32_t red, uint32_t green, uint32_t blue);
+
+    /**
+     * @brief Set brightness applied to all pixels when they are sent (optional)
+     *
+     * @param strip: LED strip
+     * @param brightness: brightness, 255 means full brightness
+     *
+     * @return
+     *      - ESP_OK: Set brightness successfully
+     */
+    esp_err_t (*set_brightness)(led_strip_t *strip, uint8_t brightness);
+
+    /**
+     * @brief Start flushing memory colors to LEDs, without waiting for the end of transmission
+     *
+     * @param strip: LED strip
+     *
+     * @return
+     *      - ESP_OK: Refresh started successfully
+     *      - ESP_FAIL: Refresh failed because some other error occurred
+     *
+     * @note:
+     *      Pixels must not be changed until `refresh_wait_done` returns.
+     */
+    esp_err_t (*refresh_async)(led_strip_t *strip);
+
+    /**
+     * @brief Wait for the end of transmission started by `refresh_async`
+     *
+     * @param strip: LED strip
+     *
+     * @return
+     *      - ESP_OK: Refresh finished successfully
+     *      - ESP_FAIL: Refresh failed because some other error occurred
+     */
+    esp_err_t (*refresh_wait_done)(led_strip_t *strip);
 };
 
 #ifdef __cplusplus
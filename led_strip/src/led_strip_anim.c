@@ -0,0 +1,258 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "led_strip.h"
+#include "led_strip_anim.h"
+
+#define LED_STRIP_ANIM_DEFAULT_TASK_STACK_SIZE 4096
+#define LED_STRIP_ANIM_DEFAULT_TASK_PRIORITY   5
+
+static const char *TAG = "led_strip_anim";
+
+struct led_strip_anim_t {
+    led_strip_anim_config_t config;
+    uint8_t bytes_per_pixel;
+    TickType_t period;
+    SemaphoreHandle_t mutex;        // protects pixels and the dirty range
+    SemaphoreHandle_t task_stopped;
+    TaskHandle_t task;
+    volatile bool stop_task;
+    uint32_t dirty_start;           // pixels changed since the last frame, dirty_start == dirty_end if none
+    uint32_t dirty_end;
+    led_strip_anim_stats_t stats;
+    uint8_t pixels[];               // colors in config.color_format
+};
+
+static void led_strip_anim_mark_dirty(struct led_strip_anim_t *anim, uint32_t start, uint32_t end)
+{
+    if (anim->dirty_start == anim->dirty_end) {
+        anim->dirty_start = start;
+        anim->dirty_end = end;
+    } else {
+        anim->dirty_start = MIN(anim->dirty_start, start);
+        anim->dirty_end = MAX(anim->dirty_end, end);
+    }
+}
+
+// Copies a pixel, returns true if its color changed
+static inline bool led_strip_anim_update_pixel(uint8_t *dst, const uint8_t *src, uint8_t size)
+{
+    if (memcmp(dst, src, size) == 0) {
+        return false;
+    }
+    memcpy(dst, src, size);
+    return true;
+}
+
+// Passes the changed pixels to the strip and starts refreshing it
+static void led_strip_anim_flush(struct led_strip_anim_t *anim)
+{
+    const led_strip_anim_config_t *config = &anim->config;
+    led_strip_handle_t strip = config->strip;
+
+    xSemaphoreTake(anim->mutex, portMAX_DELAY);
+    if (anim->dirty_start == anim->dirty_end) {
+        xSemaphoreGive(anim->mutex);
+        anim->stats.skipped++;
+        return;
+    }
+    const uint32_t start = anim->dirty_start;
+    const uint32_t count = anim->dirty_end - start;
+    anim->dirty_start = anim->dirty_end = 0;
+    // Pixel memory of the strip must not be changed while the previous frame is transmitted
+    esp_err_t ret = led_strip_refresh_wait_done(strip);
+    if (ret == ESP_OK) {
+        ret = led_strip_set_pixels(strip, start, count, anim->pixels + start * anim->bytes_per_pixel, config->color_format);
+    }
+    xSemaphoreGive(anim->mutex);
+
+    if (ret == ESP_OK) {
+        ret = led_strip_refresh_async(strip);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "refresh failed: %s", esp_err_to_name(ret));
+        return;
+    }
+    anim->stats.refreshes++;
+}
+
+static void led_strip_anim_task(void *arg)
+{
+    struct led_strip_anim_t *anim = arg;
+    const led_strip_anim_config_t *config = &anim->config;
+    TickType_t last_wake = xTaskGetTickCount();
+    uint32_t frame = 0;
+
+    while (!anim->stop_task) {
+        if (config->frame_cb) {
+            config->frame_cb(anim, frame, config->user_ctx);
+        }
+        led_strip_anim_flush(anim);
+        anim->stats.frames++;
+        frame++;
+        // Don't catch up with the missed periods by rendering frames back to back
+        if (xTaskDelayUntil(&last_wake, anim->period) == pdFALSE) {
+            anim->stats.overruns++;
+            last_wake = xTaskGetTickCount();
+        }
+    }
+
+    led_strip_refresh_wait_done(config->strip);
+    xSemaphoreGive(anim->task_stopped);
+    vTaskDelete(NULL);
+}
+
+esp_err_t led_strip_anim_new(const led_strip_anim_config_t *config, led_strip_anim_handle_t *ret_anim)
+{
+    esp_err_t ret = ESP_OK;
+    struct led_strip_anim_t *anim = NULL;
+    ESP_RETURN_ON_FALSE(config && ret_anim && config->strip && config->num_leds && config->fps, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->color_format <= LED_STRIP_COLOR_FORMAT_RGBW, ESP_ERR_INVALID_ARG, TAG, "invalid color format");
+    const uint8_t bytes_per_pixel = config->color_format == LED_STRIP_COLOR_FORMAT_RGBW ? 4 : 3;
+
+    anim = calloc(1, sizeof(struct led_strip_anim_t) + config->num_leds * bytes_per_pixel);
+    ESP_RETURN_ON_FALSE(anim, ESP_ERR_NO_MEM, TAG, "no mem for led strip animation");
+    anim->config = *config;
+    anim->bytes_per_pixel = bytes_per_pixel;
+    anim->period = MAX(configTICK_RATE_HZ / config->fps, 1);
+    if (configTICK_RATE_HZ % config->fps) {
+        ESP_LOGW(TAG, "%"PRIu32" fps rounded to %"PRIu32" ticks per frame", config->fps, (uint32_t)anim->period);
+    }
+    anim->mutex = xSemaphoreCreateMutex();
+    anim->task_stopped = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(anim->mutex && anim->task_stopped, ESP_ERR_NO_MEM, err, TAG, "no mem for semaphores");
+
+    *ret_anim = anim;
+    return ESP_OK;
+err:
+    if (anim->mutex) {
+        vSemaphoreDelete(anim->mutex);
+    }
+    if (anim->task_stopped) {
+        vSemaphoreDelete(anim->task_stopped);
+    }
+    free(anim);
+    return ret;
+}
+
+esp_err_t led_strip_anim_start(led_strip_anim_handle_t anim)
+{
+    ESP_RETURN_ON_FALSE(anim, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!anim->task, ESP_ERR_INVALID_STATE, TAG, "animation already running");
+    const led_strip_anim_config_t *config = &anim->config;
+
+    led_strip_anim_invalidate(anim);
+    anim->stop_task = false;
+    const uint32_t stack_size = config->task_stack_size ? config->task_stack_size : LED_STRIP_ANIM_DEFAULT_TASK_STACK_SIZE;
+    const uint32_t priority = config->task_priority ? config->task_priority : LED_STRIP_ANIM_DEFAULT_TASK_PRIORITY;
+    const BaseType_t core_id = (config->task_core_id < 0) ? tskNO_AFFINITY : config->task_core_id;
+    if (xTaskCreatePinnedToCore(led_strip_anim_task, "led_strip_anim", stack_size, anim, priority, &anim->task,
+                                core_id) != pdPASS) {
+        anim->task = NULL;
+        ESP_LOGE(TAG, "create animation task failed");
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t led_strip_anim_stop(led_strip_anim_handle_t anim)
+{
+    ESP_RETURN_ON_FALSE(anim, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (!anim->task) {
+        return ESP_OK;
+    }
+    anim->stop_task = true;
+    xSemaphoreTake(anim->task_stopped, portMAX_DELAY);
+    anim->task = NULL;
+    return ESP_OK;
+}
+
+esp_err_t led_strip_anim_set_pixels(led_strip_anim_handle_t anim, uint32_t start, uint32_t count, const uint8_t *pixels)
+{
+    ESP_RETURN_ON_FALSE(anim && (pixels || !count), ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(start <= anim->config.num_leds && count <= anim->config.num_leds - start, ESP_ERR_INVALID_ARG, TAG,
+                        "index out of maximum number of LEDs");
+    const uint8_t size = anim->bytes_per_pixel;
+    uint8_t *dst = anim->pixels + start * size;
+    uint32_t first = UINT32_MAX;
+    uint32_t last = 0;
+
+    xSemaphoreTake(anim->mutex, portMAX_DELAY);
+    for (uint32_t i = 0; i < count; i++, dst += size, pixels += size) {
+        if (led_strip_anim_update_pixel(dst, pixels, size)) {
+            first = MIN(first, i);
+            last = i;
+        }
+    }
+    if (first != UINT32_MAX) {
+        led_strip_anim_mark_dirty(anim, start + first, start + last + 1);
+    }
+    xSemaphoreGive(anim->mutex);
+    return ESP_OK;
+}
+
+esp_err_t led_strip_anim_fill(led_strip_anim_handle_t anim, uint32_t start, uint32_t count, uint8_t red, uint8_t green, uint8_t blue)
+{
+    ESP_RETURN_ON_FALSE(anim, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(start <= anim->config.num_leds && count <= anim->config.num_leds - start, ESP_ERR_INVALID_ARG, TAG,
+                        "index out of maximum number of LEDs");
+    const uint8_t size = anim->bytes_per_pixel;
+    uint8_t color[4] = {red, green, blue, 0};
+    if (anim->config.color_format == LED_STRIP_COLOR_FORMAT_GRB) {
+        color[0] = green;
+        color[1] = red;
+    }
+    uint8_t *dst = anim->pixels + start * size;
+    uint32_t first = UINT32_MAX;
+    uint32_t last = 0;
+
+    xSemaphoreTake(anim->mutex, portMAX_DELAY);
+    for (uint32_t i = 0; i < count; i++, dst += size) {
+        if (led_strip_anim_update_pixel(dst, color, size)) {
+            first = MIN(first, i);
+            last = i;
+        }
+    }
+    if (first != UINT32_MAX) {
+        led_strip_anim_mark_dirty(anim, start + first, start + last + 1);
+    }
+    xSemaphoreGive(anim->mutex);
+    return ESP_OK;
+}
+
+esp_err_t led_strip_anim_invalidate(led_strip_anim_handle_t anim)
+{
+    ESP_RETURN_ON_FALSE(anim, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    xSemaphoreTake(anim->mutex, portMAX_DELAY);
+    led_strip_anim_mark_dirty(anim, 0, anim->config.num_leds);
+    xSemaphoreGive(anim->mutex);
+    return ESP_OK;
+}
+
+esp_err_t led_strip_anim_get_stats(led_strip_anim_handle_t anim, led_strip_anim_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(anim && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    *stats = anim->stats;
+    return ESP_OK;
+}
+
+esp_err_t led_strip_anim_del(led_strip_anim_handle_t anim)
+{
+    ESP_RETURN_ON_FALSE(anim, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_ERROR(led_strip_anim_stop(anim), TAG, "stop animation failed");
+    vSemaphoreDelete(anim->mutex);
+    vSemaphoreDelete(anim->task_stopped);
+    free(anim);
+    return ESP_OK;
+}
@@ -3,6 +3,9 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
 #include "esp_log.h"
 #include "esp_check.h"
 #include "led_strip.h"
@@ -10,6 +13,11 @@
 
 static const char *TAG = "led_strip";
 
+struct led_strip_group_t {
+    size_t num_strips;
+    led_strip_handle_t strips[];
+};
+
 esp_err_t led_strip_set_pixel(led_strip_handle_t strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue)
 {
     ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
@@ -22,12 +30,122 @@ esp_err_t led_strip_set_pixel_rgbw(led_strip_handle_t strip, uint32_t index, uin
     return strip->set_pixel_rgbw(strip, index, red, green, blue, white);
 }
 
+esp_err_t led_strip_set_pixels(led_strip_handle_t strip, uint32_t start, uint32_t count, const uint8_t *pixels, led_strip_color_format_t format)
+{
+    ESP_RETURN_ON_FALSE(strip && (pixels || !count), ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (strip->set_pixels) {
+        return strip->set_pixels(strip, start, count, pixels, format);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t *p = pixels + i * (format == LED_STRIP_COLOR_FORMAT_RGBW ? 4 : 3);
+        esp_err_t ret;
+        switch (format) {
+        case LED_STRIP_COLOR_FORMAT_RGB:
+            ret = strip->set_pixel(strip, start + i, p[0], p[1], p[2]);
+            break;
+        case LED_STRIP_COLOR_FORMAT_GRB:
+            ret = strip->set_pixel(strip, start + i, p[1], p[0], p[2]);
+            break;
+        case LED_STRIP_COLOR_FORMAT_RGBW:
+            ret = strip->set_pixel_rgbw(strip, start + i, p[0], p[1], p[2], p[3]);
+            break;
+        default:
+            ret = ESP_ERR_INVALID_ARG;
+            break;
+        }
+        ESP_RETURN_ON_ERROR(ret, TAG, "set pixel %"PRIu32" failed", start + i);
+    }
+    return ESP_OK;
+}
+
+esp_err_t led_strip_fill(led_strip_handle_t strip, uint32_t start, uint32_t count, uint32_t red, uint32_t green, uint32_t blue)
+{
+    ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (strip->fill) {
+        return strip->fill(strip, start, count, red, green, blue);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        ESP_RETURN_ON_ERROR(strip->set_pixel(strip, start + i, red, green, blue), TAG, "set pixel %"PRIu32" failed", start + i);
+    }
+    return ESP_OK;
+}
+
+esp_err_t led_strip_set_brightness(led_strip_handle_t strip, uint8_t brightness)
+{
+    ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(strip->set_brightness, ESP_ERR_NOT_SUPPORTED, TAG, "brightness not supported by backend");
+    return strip->set_brightness(strip, brightness);
+}
+
 esp_err_t led_strip_refresh(led_strip_handle_t strip)
 {
     ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
     return strip->refresh(strip);
 }
 
+esp_err_t led_strip_refresh_async(led_strip_handle_t strip)
+{
+    ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    // Backends without asynchronous refresh are refreshed synchronously
+    if (!strip->refresh_async) {
+        return strip->refresh(strip);
+    }
+    return strip->refresh_async(strip);
+}
+
+esp_err_t led_strip_refresh_wait_done(led_strip_handle_t strip)
+{
+    ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (!strip->refresh_wait_done) {
+        return ESP_OK;
+    }
+    return strip->refresh_wait_done(strip);
+}
+
+esp_err_t led_strip_new_group(const led_strip_handle_t *strips, size_t num_strips, led_strip_group_handle_t *ret_group)
+{
+    ESP_RETURN_ON_FALSE(strips && num_strips && ret_group, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    for (size_t i = 0; i < num_strips; i++) {
+        ESP_RETURN_ON_FALSE(strips[i], ESP_ERR_INVALID_ARG, TAG, "invalid strip %u", (unsigned)i);
+    }
+    struct led_strip_group_t *group = calloc(1, sizeof(struct led_strip_group_t) + num_strips * sizeof(led_strip_handle_t));
+    ESP_RETURN_ON_FALSE(group, ESP_ERR_NO_MEM, TAG, "no mem for strip group");
+    memcpy(group->strips, strips, num_strips * sizeof(led_strip_handle_t));
+    group->num_strips = num_strips;
+    *ret_group = group;
+    return ESP_OK;
+}
+
+esp_err_t led_strip_group_refresh(led_strip_group_handle_t group)
+{
+    ESP_RETURN_ON_FALSE(group, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_err_t ret = ESP_OK;
+    size_t started = 0;
+
+    for (; started < group->num_strips; started++) {
+        ret = led_strip_refresh_async(group->strips[started]);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "refresh strip %u failed", (unsigned)started);
+            break;
+        }
+    }
+    // Wait for all started transmissions, even if some strip failed
+    for (size_t i = 0; i < started; i++) {
+        esp_err_t wait_ret = led_strip_refresh_wait_done(group->strips[i]);
+        if (ret == ESP_OK) {
+            ret = wait_ret;
+        }
+    }
+    return ret;
+}
+
+esp_err_t led_strip_group_del(led_strip_group_handle_t group)
+{
+    ESP_RETURN_ON_FALSE(group, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(group);
+    return ESP_OK;
+}
+
 esp_err_t led_strip_clear(led_strip_handle_t strip)
 {
     ESP_RETURN_ON_FALSE(strip, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
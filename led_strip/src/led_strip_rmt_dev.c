@@ -8,6 +8,7 @@
 #include <sys/cdefs.h>
 #include "esp_log.h"
 #include "esp_check.h"
+#include "esp_heap_caps.h"
 #include "driver/rmt_tx.h"
 #include "led_strip.h"
 #include "led_strip_interface.h"
@@ -22,6 +23,13 @@
 #define LED_STRIP_RMT_DEFAULT_MEM_BLOCK_SYMBOLS 48
 #endif
 
+// Pixels are read by the encoder in RMT interrupt, which runs while the cache is disabled if it's IRAM safe
+#if CONFIG_RMT_ISR_IRAM_SAFE
+#define LED_STRIP_RMT_MEM_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#else
+#define LED_STRIP_RMT_MEM_CAPS MALLOC_CAP_DEFAULT
+#endif
+
 static const char *TAG = "led_strip_rmt";
 
 typedef struct {
@@ -30,7 +38,10 @@ typedef struct {
     rmt_encoder_handle_t strip_encoder;
     uint32_t strip_len;
     uint8_t bytes_per_pixel;
-    uint8_t pixel_buf[];
+    bool tx_pending;        // refresh started by refresh_async, not waited for yet
+    uint8_t *pixel_buf;     // buffer written by set_pixel
+    uint8_t *tx_buf;        // buffer being transmitted, different from pixel_buf in double buffered mode
+    uint8_t buf[];
 } led_strip_rmt_obj;
 
 static esp_err_t led_strip_rmt_set_pixel(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue)
@@ -62,21 +73,118 @@ static esp_err_t led_strip_rmt_set_pixel_rgbw(led_strip_t *strip, uint32_t index
     return ESP_OK;
 }
 
-static esp_err_t led_strip_rmt_refresh(led_strip_t *strip)
+static esp_err_t led_strip_rmt_set_pixels(led_strip_t *strip, uint32_t start, uint32_t count, const uint8_t *pixels, led_strip_color_format_t format)
 {
     led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_FALSE(start <= rmt_strip->strip_len && count <= rmt_strip->strip_len - start, ESP_ERR_INVALID_ARG, TAG,
+                        "index out of maximum number of LEDs");
+    ESP_RETURN_ON_FALSE(format <= LED_STRIP_COLOR_FORMAT_RGBW, ESP_ERR_INVALID_ARG, TAG, "invalid color format");
+    ESP_RETURN_ON_FALSE(format != LED_STRIP_COLOR_FORMAT_RGBW || rmt_strip->bytes_per_pixel == 4, ESP_ERR_INVALID_ARG, TAG,
+                        "wrong LED pixel format, expected 4 bytes per pixel");
+    const uint8_t bytes_per_pixel = rmt_strip->bytes_per_pixel;
+    uint8_t *dst = rmt_strip->pixel_buf + start * bytes_per_pixel;
+
+    switch (format) {
+    case LED_STRIP_COLOR_FORMAT_GRB:
+        if (bytes_per_pixel == 3) {
+            // Already in the order sent to the strip
+            memcpy(dst, pixels, count * 3);
+            break;
+        }
+    // fall through
+    case LED_STRIP_COLOR_FORMAT_RGB: {
+        const uint8_t r = format == LED_STRIP_COLOR_FORMAT_RGB ? 0 : 1;
+        const uint8_t g = 1 - r;
+        for (uint32_t i = 0; i < count; i++, pixels += 3, dst += bytes_per_pixel) {
+            dst[0] = pixels[g];
+            dst[1] = pixels[r];
+            dst[2] = pixels[2];
+            if (bytes_per_pixel > 3) {
+                dst[3] = 0;
+            }
+        }
+        break;
+    }
+    case LED_STRIP_COLOR_FORMAT_RGBW:
+        for (uint32_t i = 0; i < count; i++, pixels += 4, dst += 4) {
+            dst[0] = pixels[1];
+            dst[1] = pixels[0];
+            dst[2] = pixels[2];
+            dst[3] = pixels[3];
+        }
+        break;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_fill(led_strip_t *strip, uint32_t start, uint32_t count, uint32_t red, uint32_t green, uint32_t blue)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_FALSE(start <= rmt_strip->strip_len && count <= rmt_strip->strip_len - start, ESP_ERR_INVALID_ARG, TAG,
+                        "index out of maximum number of LEDs");
+    const uint8_t bytes_per_pixel = rmt_strip->bytes_per_pixel;
+    const uint8_t pixel[4] = {green & 0xFF, red & 0xFF, blue & 0xFF, 0};
+    uint8_t *dst = rmt_strip->pixel_buf + start * bytes_per_pixel;
+
+    for (uint32_t i = 0; i < count; i++, dst += bytes_per_pixel) {
+        memcpy(dst, pixel, bytes_per_pixel);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_set_brightness(led_strip_t *strip, uint8_t brightness)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    rmt_led_strip_encoder_set_brightness(rmt_strip->strip_encoder, brightness);
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_refresh_wait_done(led_strip_t *strip)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    if (!rmt_strip->tx_pending) {
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_ERROR(rmt_tx_wait_all_done(rmt_strip->rmt_chan, -1), TAG, "flush RMT channel failed");
+    rmt_strip->tx_pending = false;
+    ESP_RETURN_ON_ERROR(rmt_disable(rmt_strip->rmt_chan), TAG, "disable RMT channel failed");
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_refresh_async(led_strip_t *strip)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    const size_t buf_size = rmt_strip->strip_len * rmt_strip->bytes_per_pixel;
     rmt_transmit_config_t tx_conf = {
         .loop_count = 0,
     };
 
-    ESP_RETURN_ON_ERROR(rmt_enable(rmt_strip->rmt_chan), TAG, "enable RMT channel failed");
-    ESP_RETURN_ON_ERROR(rmt_transmit(rmt_strip->rmt_chan, rmt_strip->strip_encoder, rmt_strip->pixel_buf,
-                                     rmt_strip->strip_len * rmt_strip->bytes_per_pixel, &tx_conf), TAG, "transmit pixels by RMT failed");
-    ESP_RETURN_ON_ERROR(rmt_tx_wait_all_done(rmt_strip->rmt_chan, -1), TAG, "flush RMT channel failed");
-    ESP_RETURN_ON_ERROR(rmt_disable(rmt_strip->rmt_chan), TAG, "disable RMT channel failed");
+    if (rmt_strip->tx_buf != rmt_strip->pixel_buf) {
+        // Double buffered: send the written buffer, keep writing to a copy of it
+        if (rmt_strip->tx_pending) {
+            ESP_RETURN_ON_ERROR(rmt_tx_wait_all_done(rmt_strip->rmt_chan, -1), TAG, "flush RMT channel failed");
+        }
+        uint8_t *written = rmt_strip->pixel_buf;
+        rmt_strip->pixel_buf = rmt_strip->tx_buf;
+        rmt_strip->tx_buf = written;
+        memcpy(rmt_strip->pixel_buf, rmt_strip->tx_buf, buf_size);
+    }
+
+    if (!rmt_strip->tx_pending) {
+        ESP_RETURN_ON_ERROR(rmt_enable(rmt_strip->rmt_chan), TAG, "enable RMT channel failed");
+    }
+    rmt_strip->tx_pending = true;
+    ESP_RETURN_ON_ERROR(rmt_transmit(rmt_strip->rmt_chan, rmt_strip->strip_encoder, rmt_strip->tx_buf,
+                                     buf_size, &tx_conf), TAG, "transmit pixels by RMT failed");
     return ESP_OK;
 }
 
+static esp_err_t led_strip_rmt_refresh(led_strip_t *strip)
+{
+    ESP_RETURN_ON_ERROR(led_strip_rmt_refresh_async(strip), TAG, "refresh failed");
+    return led_strip_rmt_refresh_wait_done(strip);
+}
+
 static esp_err_t led_strip_rmt_clear(led_strip_t *strip)
 {
     led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
@@ -88,6 +196,7 @@ static esp_err_t led_strip_rmt_clear(led_strip_t *strip)
 static esp_err_t led_strip_rmt_del(led_strip_t *strip)
 {
     led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_ERROR(led_strip_rmt_refresh_wait_done(strip), TAG, "wait for refresh failed");
     ESP_RETURN_ON_ERROR(rmt_del_channel(rmt_strip->rmt_chan), TAG, "delete RMT channel failed");
     ESP_RETURN_ON_ERROR(rmt_del_encoder(rmt_strip->strip_encoder), TAG, "delete strip encoder failed");
     free(rmt_strip);
@@ -108,8 +217,12 @@ esp_err_t led_strip_new_rmt_device(const led_strip_config_t *led_config, const l
     } else {
         assert(false);
     }
-    rmt_strip = calloc(1, sizeof(led_strip_rmt_obj) + led_config->max_leds * bytes_per_pixel);
+    const size_t buf_size = led_config->max_leds * bytes_per_pixel;
+    const int num_bufs = led_config->flags.double_buffer ? 2 : 1;
+    rmt_strip = heap_caps_calloc(1, sizeof(led_strip_rmt_obj) + buf_size * num_bufs, LED_STRIP_RMT_MEM_CAPS);
     ESP_GOTO_ON_FALSE(rmt_strip, ESP_ERR_NO_MEM, err, TAG, "no mem for rmt strip");
+    rmt_strip->pixel_buf = rmt_strip->buf;
+    rmt_strip->tx_buf = rmt_strip->buf + buf_size * (num_bufs - 1);
     uint32_t resolution = rmt_config->resolution_hz ? rmt_config->resolution_hz : LED_STRIP_RMT_DEFAULT_RESOLUTION;
 
     // for backward compatibility, if the user does not set the clk_src, use the default value
@@ -135,7 +248,8 @@ esp_err_t led_strip_new_rmt_device(const led_strip_config_t *led_config, const l
 
     led_strip_encoder_config_t strip_encoder_conf = {
         .resolution = resolution,
-        .led_model = led_config->led_model
+        .led_model = led_config->led_model,
+        .gamma = rmt_config->gamma,
     };
     ESP_GOTO_ON_ERROR(rmt_new_led_strip_encoder(&strip_encoder_conf, &rmt_strip->strip_encoder), err, TAG, "create LED strip encoder failed");
 
@@ -144,7 +258,12 @@ esp_err_t led_strip_new_rmt_device(const led_strip_config_t *led_config, const l
     rmt_strip->strip_len = led_config->max_leds;
     rmt_strip->base.set_pixel = led_strip_rmt_set_pixel;
     rmt_strip->base.set_pixel_rgbw = led_strip_rmt_set_pixel_rgbw;
+    rmt_strip->base.set_pixels = led_strip_rmt_set_pixels;
+    rmt_strip->base.fill = led_strip_rmt_fill;
+    rmt_strip->base.set_brightness = led_strip_rmt_set_brightness;
     rmt_strip->base.refresh = led_strip_rmt_refresh;
+    rmt_strip->base.refresh_async = led_strip_rmt_refresh_async;
+    rmt_strip->base.refresh_wait_done = led_strip_rmt_refresh_wait_done;
     rmt_strip->base.clear = led_strip_rmt_clear;
     rmt_strip->base.del = led_strip_rmt_del;
 
@@ -4,9 +4,26 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <math.h>
+#include <sys/param.h>
 #include "esp_check.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
 #include "led_strip_rmt_encoder.h"
 
+// The encoder is called from RMT interrupt to refill RMT memory. If the interrupt is IRAM safe,
+// the encoder and its data must be accessible while the cache is disabled.
+#if CONFIG_RMT_ISR_IRAM_SAFE
+#define LED_STRIP_ENCODER_ATTR IRAM_ATTR
+#define LED_STRIP_ENCODER_MEM_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#else
+#define LED_STRIP_ENCODER_ATTR
+#define LED_STRIP_ENCODER_MEM_CAPS MALLOC_CAP_DEFAULT
+#endif
+
+// Number of color bytes translated by the lookup table at once
+#define LED_STRIP_ENCODER_CHUNK_SIZE 32
+
 static const char *TAG = "led_rmt_encoder";
 
 typedef struct {
@@ -15,9 +32,50 @@ typedef struct {
     rmt_encoder_t *copy_encoder;
     int state;
     rmt_symbol_word_t reset_code;
+    bool use_lut;           // translate color bytes by lut before encoding
+    size_t chunk_offset;    // offset of the chunk in the pixel data
+    size_t chunk_len;       // length of the chunk, 0 if no chunk is being encoded
+    uint8_t chunk[LED_STRIP_ENCODER_CHUNK_SIZE];
+    uint8_t gamma_lut[256];
+    uint8_t lut[256];       // gamma_lut scaled by brightness
 } rmt_led_strip_encoder_t;
 
-static size_t rmt_encode_led_strip(rmt_encoder_t *encoder, rmt_channel_handle_t channel, const void *primary_data, size_t data_size, rmt_encode_state_t *ret_state)
+// Encodes pixel data translated by the lookup table, in chunks. The bytes encoder resumes a chunk
+// after RMT_ENCODING_MEM_FULL, so a chunk stays unchanged until it's completely encoded.
+static size_t LED_STRIP_ENCODER_ATTR rmt_encode_led_strip_lut(rmt_led_strip_encoder_t *led_encoder, rmt_channel_handle_t channel,
+                                                              const uint8_t *data, size_t data_size, rmt_encode_state_t *ret_state)
+{
+    rmt_encoder_handle_t bytes_encoder = led_encoder->bytes_encoder;
+    rmt_encode_state_t session_state = 0;
+    size_t encoded_symbols = 0;
+
+    *ret_state = 0;
+    while (led_encoder->chunk_offset < data_size) {
+        if (led_encoder->chunk_len == 0) {
+            led_encoder->chunk_len = MIN(data_size - led_encoder->chunk_offset, LED_STRIP_ENCODER_CHUNK_SIZE);
+            const uint8_t *src = data + led_encoder->chunk_offset;
+            for (size_t i = 0; i < led_encoder->chunk_len; i++) {
+                led_encoder->chunk[i] = led_encoder->lut[src[i]];
+            }
+        }
+        encoded_symbols += bytes_encoder->encode(bytes_encoder, channel, led_encoder->chunk, led_encoder->chunk_len, &session_state);
+        if (session_state & RMT_ENCODING_COMPLETE) {
+            led_encoder->chunk_offset += led_encoder->chunk_len;
+            led_encoder->chunk_len = 0;
+        }
+        if (session_state & RMT_ENCODING_MEM_FULL) {
+            *ret_state |= RMT_ENCODING_MEM_FULL;
+            break;
+        }
+    }
+    if (led_encoder->chunk_offset >= data_size) {
+        led_encoder->chunk_offset = 0;
+        *ret_state |= RMT_ENCODING_COMPLETE;
+    }
+    return encoded_symbols;
+}
+
+static size_t LED_STRIP_ENCODER_ATTR rmt_encode_led_strip(rmt_encoder_t *encoder, rmt_channel_handle_t channel, const void *primary_data, size_t data_size, rmt_encode_state_t *ret_state)
 {
     rmt_led_strip_encoder_t *led_encoder = __containerof(encoder, rmt_led_strip_encoder_t, base);
     rmt_encoder_handle_t bytes_encoder = led_encoder->bytes_encoder;
@@ -27,7 +85,11 @@ static size_t rmt_encode_led_strip(rmt_encoder_t *encoder, rmt_channel_handle_t
     size_t encoded_symbols = 0;
     switch (led_encoder->state) {
     case 0: // send RGB data
-        encoded_symbols += bytes_encoder->encode(bytes_encoder, channel, primary_data, data_size, &session_state);
+        if (led_encoder->use_lut) {
+            encoded_symbols += rmt_encode_led_strip_lut(led_encoder, channel, primary_data, data_size, &session_state);
+        } else {
+            encoded_symbols += bytes_encoder->encode(bytes_encoder, channel, primary_data, data_size, &session_state);
+        }
         if (session_state & RMT_ENCODING_COMPLETE) {
             led_encoder->state = 1; // switch to next state when current encoding session finished
         }
@@ -62,26 +124,47 @@ static esp_err_t rmt_del_led_strip_encoder(rmt_encoder_t *encoder)
     return ESP_OK;
 }
 
-static esp_err_t rmt_led_strip_encoder_reset(rmt_encoder_t *encoder)
+static esp_err_t LED_STRIP_ENCODER_ATTR rmt_led_strip_encoder_reset(rmt_encoder_t *encoder)
 {
     rmt_led_strip_encoder_t *led_encoder = __containerof(encoder, rmt_led_strip_encoder_t, base);
     rmt_encoder_reset(led_encoder->bytes_encoder);
     rmt_encoder_reset(led_encoder->copy_encoder);
     led_encoder->state = 0;
+    led_encoder->chunk_offset = 0;
+    led_encoder->chunk_len = 0;
     return ESP_OK;
 }
 
+void rmt_led_strip_encoder_set_brightness(rmt_encoder_handle_t encoder, uint8_t brightness)
+{
+    rmt_led_strip_encoder_t *led_encoder = __containerof(encoder, rmt_led_strip_encoder_t, base);
+    bool identity = true;
+    for (int i = 0; i < 256; i++) {
+        led_encoder->lut[i] = (led_encoder->gamma_lut[i] * brightness + 127) / 255;
+        identity &= led_encoder->lut[i] == i;
+    }
+    // Pixel data are encoded directly without correction and full brightness
+    led_encoder->use_lut = !identity;
+}
+
 esp_err_t rmt_new_led_strip_encoder(const led_strip_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder)
 {
     esp_err_t ret = ESP_OK;
     rmt_led_strip_encoder_t *led_encoder = NULL;
     ESP_GOTO_ON_FALSE(config && ret_encoder, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
     ESP_GOTO_ON_FALSE(config->led_model < LED_MODEL_INVALID, ESP_ERR_INVALID_ARG, err, TAG, "invalid led model");
-    led_encoder = calloc(1, sizeof(rmt_led_strip_encoder_t));
+    led_encoder = heap_caps_calloc(1, sizeof(rmt_led_strip_encoder_t), LED_STRIP_ENCODER_MEM_CAPS);
     ESP_GOTO_ON_FALSE(led_encoder, ESP_ERR_NO_MEM, err, TAG, "no mem for led strip encoder");
     led_encoder->base.encode = rmt_encode_led_strip;
     led_encoder->base.del = rmt_del_led_strip_encoder;
     led_encoder->base.reset = rmt_led_strip_encoder_reset;
+    for (int i = 0; i < 256; i++) {
+        led_encoder->gamma_lut[i] = i;
+        if (config->gamma > 0 && config->gamma != 1) {
+            led_encoder->gamma_lut[i] = lroundf(powf(i / 255.0f, config->gamma) * 255.0f);
+        }
+    }
+    rmt_led_strip_encoder_set_brightness(&led_encoder->base, 255);
     rmt_bytes_encoder_config_t bytes_encoder_config;
     if (config->led_model == LED_MODEL_SK6812) {
         bytes_encoder_config = (rmt_bytes_encoder_config_t) {
@@ -19,6 +19,7 @@ extern "C" {
 typedef struct {
     uint32_t resolution;   /*!< Encoder resolution, in Hz */
     led_model_t led_model; /*!< LED model */
+    float gamma;           /*!< Gamma correction applied while encoding, 0 or 1 means no correction */
 } led_strip_encoder_config_t;
 
 /**
@@ -33,6 +34,14 @@ typedef struct {
  */
 esp_err_t rmt_new_led_strip_encoder(const led_strip_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder);
 
+/**
+ * @brief Set brightness applied to all color components while encoding
+ *
+ * @param encoder Encoder handle
+ * @param brightness Brightness, 255 means full brightness
+ */
+void rmt_led_strip_encoder_set_brightness(rmt_encoder_handle_t encoder, uint8_t brightness);
+
 #ifdef __cplusplus
 }
 #endif
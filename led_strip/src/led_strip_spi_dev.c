@@ -26,25 +26,90 @@ typedef struct {
     led_strip_t base;
     spi_host_device_t spi_host;
     spi_device_handle_t spi_device;
+    spi_transaction_t tx_conf;  // queued by refresh_async, must live until the transaction is done
     uint32_t strip_len;
     uint8_t bytes_per_pixel;
-    uint8_t pixel_buf[];
+    bool tx_pending;        // refresh started by refresh_async, not waited for yet
+    uint8_t *pixel_buf;     // buffer written by set_pixel
+    uint8_t *tx_buf;        // buffer being transmitted, different from pixel_buf in double buffered mode
+    uint8_t buf[];
 } led_strip_spi_obj;
 
-// please make sure to zero-initialize the buf before calling this function
-static void __led_strip_spi_bit(uint8_t data, uint8_t *buf)
+// Each color of 1 bit is represented by 3 bits of SPI, low_level:100 ,high_level:110
+// So a color byte occupies 3 bytes of SPI, MSB first. The table holds the SPI bytes of each color byte.
+static const uint8_t s_spi_color_byte_lut[256][SPI_BYTES_PER_COLOR_BYTE] = {
+    {0x92, 0x49, 0x24}, {0x92, 0x49, 0x26}, {0x92, 0x49, 0x34}, {0x92, 0x49, 0x36},
+    {0x92, 0x49, 0xA4}, {0x92, 0x49, 0xA6}, {0x92, 0x49, 0xB4}, {0x92, 0x49, 0xB6},
+    {0x92, 0x4D, 0x24}, {0x92, 0x4D, 0x26}, {0x92, 0x4D, 0x34}, {0x92, 0x4D, 0x36},
+    {0x92, 0x4D, 0xA4}, {0x92, 0x4D, 0xA6}, {0x92, 0x4D, 0xB4}, {0x92, 0x4D, 0xB6},
+    {0x92, 0x69, 0x24}, {0x92, 0x69, 0x26}, {0x92, 0x69, 0x34}, {0x92, 0x69, 0x36},
+    {0x92, 0x69, 0xA4}, {0x92, 0x69, 0xA6}, {0x92, 0x69, 0xB4}, {0x92, 0x69, 0xB6},
+    {0x92, 0x6D, 0x24}, {0x92, 0x6D, 0x26}, {0x92, 0x6D, 0x34}, {0x92, 0x6D, 0x36},
+    {0x92, 0x6D, 0xA4}, {0x92, 0x6D, 0xA6}, {0x92, 0x6D, 0xB4}, {0x92, 0x6D, 0xB6},
+    {0x93, 0x49, 0x24}, {0x93, 0x49, 0x26}, {0x93, 0x49, 0x34}, {0x93, 0x49, 0x36},
+    {0x93, 0x49, 0xA4}, {0x93, 0x49, 0xA6}, {0x93, 0x49, 0xB4}, {0x93, 0x49, 0xB6},
+    {0x93, 0x4D, 0x24}, {0x93, 0x4D, 0x26}, {0x93, 0x4D, 0x34}, {0x93, 0x4D, 0x36},
+    {0x93, 0x4D, 0xA4}, {0x93, 0x4D, 0xA6}, {0x93, 0x4D, 0xB4}, {0x93, 0x4D, 0xB6},
+    {0x93, 0x69, 0x24}, {0x93, 0x69, 0x26}, {0x93, 0x69, 0x34}, {0x93, 0x69, 0x36},
+    {0x93, 0x69, 0xA4}, {0x93, 0x69, 0xA6}, {0x93, 0x69, 0xB4}, {0x93, 0x69, 0xB6},
+    {0x93, 0x6D, 0x24}, {0x93, 0x6D, 0x26}, {0x93, 0x6D, 0x34}, {0x93, 0x6D, 0x36},
+    {0x93, 0x6D, 0xA4}, {0x93, 0x6D, 0xA6}, {0x93, 0x6D, 0xB4}, {0x93, 0x6D, 0xB6},
+    {0x9A, 0x49, 0x24}, {0x9A, 0x49, 0x26}, {0x9A, 0x49, 0x34}, {0x9A, 0x49, 0x36},
+    {0x9A, 0x49, 0xA4}, {0x9A, 0x49, 0xA6}, {0x9A, 0x49, 0xB4}, {0x9A, 0x49, 0xB6},
+    {0x9A, 0x4D, 0x24}, {0x9A, 0x4D, 0x26}, {0x9A, 0x4D, 0x34}, {0x9A, 0x4D, 0x36},
+    {0x9A, 0x4D, 0xA4}, {0x9A, 0x4D, 0xA6}, {0x9A, 0x4D, 0xB4}, {0x9A, 0x4D, 0xB6},
+    {0x9A, 0x69, 0x24}, {0x9A, 0x69, 0x26}, {0x9A, 0x69, 0x34}, {0x9A, 0x69, 0x36},
+    {0x9A, 0x69, 0xA4}, {0x9A, 0x69, 0xA6}, {0x9A, 0x69, 0xB4}, {0x9A, 0x69, 0xB6},
+    {0x9A, 0x6D, 0x24}, {0x9A, 0x6D, 0x26}, {0x9A, 0x6D, 0x34}, {0x9A, 0x6D, 0x36},
+    {0x9A, 0x6D, 0xA4}, {0x9A, 0x6D, 0xA6}, {0x9A, 0x6D, 0xB4}, {0x9A, 0x6D, 0xB6},
+    {0x9B, 0x49, 0x24}, {0x9B, 0x49, 0x26}, {0x9B, 0x49, 0x34}, {0x9B, 0x49, 0x36},
+    {0x9B, 0x49, 0xA4}, {0x9B, 0x49, 0xA6}, {0x9B, 0x49, 0xB4}, {0x9B, 0x49, 0xB6},
+    {0x9B, 0x4D, 0x24}, {0x9B, 0x4D, 0x26}, {0x9B, 0x4D, 0x34}, {0x9B, 0x4D, 0x36},
+    {0x9B, 0x4D, 0xA4}, {0x9B, 0x4D, 0xA6}, {0x9B, 0x4D, 0xB4}, {0x9B, 0x4D, 0xB6},
+    {0x9B, 0x69, 0x24}, {0x9B, 0x69, 0x26}, {0x9B, 0x69, 0x34}, {0x9B, 0x69, 0x36},
+    {0x9B, 0x69, 0xA4}, {0x9B, 0x69, 0xA6}, {0x9B, 0x69, 0xB4}, {0x9B, 0x69, 0xB6},
+    {0x9B, 0x6D, 0x24}, {0x9B, 0x6D, 0x26}, {0x9B, 0x6D, 0x34}, {0x9B, 0x6D, 0x36},
+    {0x9B, 0x6D, 0xA4}, {0x9B, 0x6D, 0xA6}, {0x9B, 0x6D, 0xB4}, {0x9B, 0x6D, 0xB6},
+    {0xD2, 0x49, 0x24}, {0xD2, 0x49, 0x26}, {0xD2, 0x49, 0x34}, {0xD2, 0x49, 0x36},
+    {0xD2, 0x49, 0xA4}, {0xD2, 0x49, 0xA6}, {0xD2, 0x49, 0xB4}, {0xD2, 0x49, 0xB6},
+    {0xD2, 0x4D, 0x24}, {0xD2, 0x4D, 0x26}, {0xD2, 0x4D, 0x34}, {0xD2, 0x4D, 0x36},
+    {0xD2, 0x4D, 0xA4}, {0xD2, 0x4D, 0xA6}, {0xD2, 0x4D, 0xB4}, {0xD2, 0x4D, 0xB6},
+    {0xD2, 0x69, 0x24}, {0xD2, 0x69, 0x26}, {0xD2, 0x69, 0x34}, {0xD2, 0x69, 0x36},
+    {0xD2, 0x69, 0xA4}, {0xD2, 0x69, 0xA6}, {0xD2, 0x69, 0xB4}, {0xD2, 0x69, 0xB6},
+    {0xD2, 0x6D, 0x24}, {0xD2, 0x6D, 0x26}, {0xD2, 0x6D, 0x34}, {0xD2, 0x6D, 0x36},
+    {0xD2, 0x6D, 0xA4}, {0xD2, 0x6D, 0xA6}, {0xD2, 0x6D, 0xB4}, {0xD2, 0x6D, 0xB6},
+    {0xD3, 0x49, 0x24}, {0xD3, 0x49, 0x26}, {0xD3, 0x49, 0x34}, {0xD3, 0x49, 0x36},
+    {0xD3, 0x49, 0xA4}, {0xD3, 0x49, 0xA6}, {0xD3, 0x49, 0xB4}, {0xD3, 0x49, 0xB6},
+    {0xD3, 0x4D, 0x24}, {0xD3, 0x4D, 0x26}, {0xD3, 0x4D, 0x34}, {0xD3, 0x4D, 0x36},
+    {0xD3, 0x4D, 0xA4}, {0xD3, 0x4D, 0xA6}, {0xD3, 0x4D, 0xB4}, {0xD3, 0x4D, 0xB6},
+    {0xD3, 0x69, 0x24}, {0xD3, 0x69, 0x26}, {0xD3, 0x69, 0x34}, {0xD3, 0x69, 0x36},
+    {0xD3, 0x69, 0xA4}, {0xD3, 0x69, 0xA6}, {0xD3, 0x69, 0xB4}, {0xD3, 0x69, 0xB6},
+    {0xD3, 0x6D, 0x24}, {0xD3, 0x6D, 0x26}, {0xD3, 0x6D, 0x34}, {0xD3, 0x6D, 0x36},
+    {0xD3, 0x6D, 0xA4}, {0xD3, 0x6D, 0xA6}, {0xD3, 0x6D, 0xB4}, {0xD3, 0x6D, 0xB6},
+    {0xDA, 0x49, 0x24}, {0xDA, 0x49, 0x26}, {0xDA, 0x49, 0x34}, {0xDA, 0x49, 0x36},
+    {0xDA, 0x49, 0xA4}, {0xDA, 0x49, 0xA6}, {0xDA, 0x49, 0xB4}, {0xDA, 0x49, 0xB6},
+    {0xDA, 0x4D, 0x24}, {0xDA, 0x4D, 0x26}, {0xDA, 0x4D, 0x34}, {0xDA, 0x4D, 0x36},
+    {0xDA, 0x4D, 0xA4}, {0xDA, 0x4D, 0xA6}, {0xDA, 0x4D, 0xB4}, {0xDA, 0x4D, 0xB6},
+    {0xDA, 0x69, 0x24}, {0xDA, 0x69, 0x26}, {0xDA, 0x69, 0x34}, {0xDA, 0x69, 0x36},
+    {0xDA, 0x69, 0xA4}, {0xDA, 0x69, 0xA6}, {0xDA, 0x69, 0xB4}, {0xDA, 0x69, 0xB6},
+    {0xDA, 0x6D, 0x24}, {0xDA, 0x6D, 0x26}, {0xDA, 0x6D, 0x34}, {0xDA, 0x6D, 0x36},
+    {0xDA, 0x6D, 0xA4}, {0xDA, 0x6D, 0xA6}, {0xDA, 0x6D, 0xB4}, {0xDA, 0x6D, 0xB6},
+    {0xDB, 0x49, 0x24}, {0xDB, 0x49, 0x26}, {0xDB, 0x49, 0x34}, {0xDB, 0x49, 0x36},
+    {0xDB, 0x49, 0xA4}, {0xDB, 0x49, 0xA6}, {0xDB, 0x49, 0xB4}, {0xDB, 0x49, 0xB6},
+    {0xDB, 0x4D, 0x24}, {0xDB, 0x4D, 0x26}, {0xDB, 0x4D, 0x34}, {0xDB, 0x4D, 0x36},
+    {0xDB, 0x4D, 0xA4}, {0xDB, 0x4D, 0xA6}, {0xDB, 0x4D, 0xB4}, {0xDB, 0x4D, 0xB6},
+    {0xDB, 0x69, 0x24}, {0xDB, 0x69, 0x26}, {0xDB, 0x69, 0x34}, {0xDB, 0x69, 0x36},
+    {0xDB, 0x69, 0xA4}, {0xDB, 0x69, 0xA6}, {0xDB, 0x69, 0xB4}, {0xDB, 0x69, 0xB6},
+    {0xDB, 0x6D, 0x24}, {0xDB, 0x6D, 0x26}, {0xDB, 0x6D, 0x34}, {0xDB, 0x6D, 0x36},
+    {0xDB, 0x6D, 0xA4}, {0xDB, 0x6D, 0xA6}, {0xDB, 0x6D, 0xB4}, {0xDB, 0x6D, 0xB6},
+};
+
+static inline void __led_strip_spi_bit(uint8_t data, uint8_t *buf)
 {
-    // Each color of 1 bit is represented by 3 bits of SPI, low_level:100 ,high_level:110
-    // So a color byte occupies 3 bytes of SPI.
-    *(buf + 2) |= data & BIT(0) ? BIT(2) | BIT(1) : BIT(2);
-    *(buf + 2) |= data & BIT(1) ? BIT(5) | BIT(4) : BIT(5);
-    *(buf + 2) |= data & BIT(2) ? BIT(7) : 0x00;
-    *(buf + 1) |= BIT(0);
-    *(buf + 1) |= data & BIT(3) ? BIT(3) | BIT(2) : BIT(3);
-    *(buf + 1) |= data & BIT(4) ? BIT(6) | BIT(5) : BIT(6);
-    *(buf + 0) |= data & BIT(5) ? BIT(1) | BIT(0) : BIT(1);
-    *(buf + 0) |= data & BIT(6) ? BIT(4) | BIT(3) : BIT(4);
-    *(buf + 0) |= data & BIT(7) ? BIT(7) | BIT(6) : BIT(7);
+    const uint8_t *pattern = s_spi_color_byte_lut[data];
+    buf[0] = pattern[0];
+    buf[1] = pattern[1];
+    buf[2] = pattern[2];
 }
 
 static esp_err_t led_strip_spi_set_pixel(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue)
@@ -53,7 +118,6 @@ static esp_err_t led_strip_spi_set_pixel(led_strip_t *strip, uint32_t index, uin
     ESP_RETURN_ON_FALSE(index < spi_strip->strip_len, ESP_ERR_INVALID_ARG, TAG, "index out of maximum number of LEDs");
     // LED_PIXEL_FORMAT_GRB takes 72bits(9bytes)
     uint32_t start = index * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
-    memset(spi_strip->pixel_buf + start, 0, spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE);
     __led_strip_spi_bit(green, &spi_strip->pixel_buf[start]);
     __led_strip_spi_bit(red, &spi_strip->pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE]);
     __led_strip_spi_bit(blue, &spi_strip->pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * 2]);
@@ -71,7 +135,6 @@ static esp_err_t led_strip_spi_set_pixel_rgbw(led_strip_t *strip, uint32_t index
     // LED_PIXEL_FORMAT_GRBW takes 96bits(12bytes)
     uint32_t start = index * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
     // SK6812 component order is GRBW
-    memset(spi_strip->pixel_buf + start, 0, spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE);
     __led_strip_spi_bit(green, &spi_strip->pixel_buf[start]);
     __led_strip_spi_bit(red, &spi_strip->pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE]);
     __led_strip_spi_bit(blue, &spi_strip->pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * 2]);
@@ -80,25 +143,101 @@ static esp_err_t led_strip_spi_set_pixel_rgbw(led_strip_t *strip, uint32_t index
     return ESP_OK;
 }
 
-static esp_err_t led_strip_spi_refresh(led_strip_t *strip)
+static esp_err_t led_strip_spi_set_pixels(led_strip_t *strip, uint32_t start, uint32_t count, const uint8_t *pixels, led_strip_color_format_t format)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    ESP_RETURN_ON_FALSE(start <= spi_strip->strip_len && count <= spi_strip->strip_len - start, ESP_ERR_INVALID_ARG, TAG,
+                        "index out of maximum number of LEDs");
+    ESP_RETURN_ON_FALSE(format <= LED_STRIP_COLOR_FORMAT_RGBW, ESP_ERR_INVALID_ARG, TAG, "invalid color format");
+    ESP_RETURN_ON_FALSE(format != LED_STRIP_COLOR_FORMAT_RGBW || spi_strip->bytes_per_pixel == 4, ESP_ERR_INVALID_ARG, TAG,
+                        "wrong LED pixel format, expected 4 bytes per pixel");
+    const uint8_t bytes_per_pixel = spi_strip->bytes_per_pixel;
+    const uint8_t src_bytes = format == LED_STRIP_COLOR_FORMAT_RGBW ? 4 : 3;
+    // Offsets of green and red in the source pixel
+    const uint8_t g = format == LED_STRIP_COLOR_FORMAT_GRB ? 0 : 1;
+    const uint8_t r = 1 - g;
+    uint8_t *dst = spi_strip->pixel_buf + start * bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
+
+    for (uint32_t i = 0; i < count; i++, pixels += src_bytes, dst += bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE) {
+        __led_strip_spi_bit(pixels[g], dst);
+        __led_strip_spi_bit(pixels[r], dst + SPI_BYTES_PER_COLOR_BYTE);
+        __led_strip_spi_bit(pixels[2], dst + SPI_BYTES_PER_COLOR_BYTE * 2);
+        if (bytes_per_pixel > 3) {
+            __led_strip_spi_bit(src_bytes > 3 ? pixels[3] : 0, dst + SPI_BYTES_PER_COLOR_BYTE * 3);
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_spi_fill(led_strip_t *strip, uint32_t start, uint32_t count, uint32_t red, uint32_t green, uint32_t blue)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    ESP_RETURN_ON_FALSE(start <= spi_strip->strip_len && count <= spi_strip->strip_len - start, ESP_ERR_INVALID_ARG, TAG,
+                        "index out of maximum number of LEDs");
+    const size_t pixel_size = spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
+    uint8_t *dst = spi_strip->pixel_buf + start * pixel_size;
+
+    if (count == 0) {
+        return ESP_OK;
+    }
+    // Encode the first pixel once, copy it to the others
+    ESP_RETURN_ON_ERROR(led_strip_spi_set_pixel(strip, start, red, green, blue), TAG, "set pixel failed");
+    for (uint32_t i = 1; i < count; i++) {
+        memcpy(dst + i * pixel_size, dst, pixel_size);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_spi_refresh_wait_done(led_strip_t *strip)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    spi_transaction_t *tx_conf;
+
+    if (!spi_strip->tx_pending) {
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_ERROR(spi_device_get_trans_result(spi_strip->spi_device, &tx_conf, portMAX_DELAY), TAG, "wait for SPI transaction failed");
+    spi_strip->tx_pending = false;
+
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_spi_refresh_async(led_strip_t *strip)
 {
     led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
-    spi_transaction_t tx_conf;
-    memset(&tx_conf, 0, sizeof(tx_conf));
+    const size_t buf_size = spi_strip->strip_len * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
+    spi_transaction_t *tx_conf = &spi_strip->tx_conf;
+
+    // The transaction descriptor is reused, so the previous transaction must be done
+    ESP_RETURN_ON_ERROR(led_strip_spi_refresh_wait_done(strip), TAG, "wait for previous refresh failed");
+    if (spi_strip->tx_buf != spi_strip->pixel_buf) {
+        // Double buffered: send the written buffer, keep writing to a copy of it
+        uint8_t *written = spi_strip->pixel_buf;
+        spi_strip->pixel_buf = spi_strip->tx_buf;
+        spi_strip->tx_buf = written;
+        memcpy(spi_strip->pixel_buf, spi_strip->tx_buf, buf_size);
+    }
 
-    tx_conf.length = spi_strip->strip_len * spi_strip->bytes_per_pixel * SPI_BITS_PER_COLOR_BYTE;
-    tx_conf.tx_buffer = spi_strip->pixel_buf;
-    tx_conf.rx_buffer = NULL;
-    ESP_RETURN_ON_ERROR(spi_device_transmit(spi_strip->spi_device, &tx_conf), TAG, "transmit pixels by SPI failed");
+    memset(tx_conf, 0, sizeof(spi_transaction_t));
+    tx_conf->length = spi_strip->strip_len * spi_strip->bytes_per_pixel * SPI_BITS_PER_COLOR_BYTE;
+    tx_conf->tx_buffer = spi_strip->tx_buf;
+    tx_conf->rx_buffer = NULL;
+    ESP_RETURN_ON_ERROR(spi_device_queue_trans(spi_strip->spi_device, tx_conf, portMAX_DELAY), TAG, "transmit pixels by SPI failed");
+    spi_strip->tx_pending = true;
 
     return ESP_OK;
 }
 
+static esp_err_t led_strip_spi_refresh(led_strip_t *strip)
+{
+    ESP_RETURN_ON_ERROR(led_strip_spi_refresh_async(strip), TAG, "refresh failed");
+    return led_strip_spi_refresh_wait_done(strip);
+}
+
 static esp_err_t led_strip_spi_clear(led_strip_t *strip)
 {
     led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
     //Write zero to turn off all leds
-    memset(spi_strip->pixel_buf, 0, spi_strip->strip_len * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE);
     uint8_t *buf = spi_strip->pixel_buf;
     for (int index = 0; index < spi_strip->strip_len * spi_strip->bytes_per_pixel; index++) {
         __led_strip_spi_bit(0, buf);
@@ -112,6 +251,7 @@ static esp_err_t led_strip_spi_del(led_strip_t *strip)
 {
     led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
 
+    ESP_RETURN_ON_ERROR(led_strip_spi_refresh_wait_done(strip), TAG, "wait for refresh failed");
     ESP_RETURN_ON_ERROR(spi_bus_remove_device(spi_strip->spi_device), TAG, "delete spi device failed");
     ESP_RETURN_ON_ERROR(spi_bus_free(spi_strip->spi_host), TAG, "free spi bus failed");
 
@@ -138,9 +278,13 @@ esp_err_t led_strip_new_spi_device(const led_strip_config_t *led_config, const l
         // DMA buffer must be placed in internal SRAM
         mem_caps |= MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA;
     }
-    spi_strip = heap_caps_calloc(1, sizeof(led_strip_spi_obj) + led_config->max_leds * bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE, mem_caps);
+    const size_t buf_size = led_config->max_leds * bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
+    const int num_bufs = led_config->flags.double_buffer ? 2 : 1;
+    spi_strip = heap_caps_calloc(1, sizeof(led_strip_spi_obj) + buf_size * num_bufs, mem_caps);
 
     ESP_GOTO_ON_FALSE(spi_strip, ESP_ERR_NO_MEM, err, TAG, "no mem for spi strip");
+    spi_strip->pixel_buf = spi_strip->buf;
+    spi_strip->tx_buf = spi_strip->buf + buf_size * (num_bufs - 1);
 
     spi_strip->spi_host = spi_config->spi_bus;
     // for backward compatibility, if the user does not set the clk_src, use the default value
@@ -189,7 +333,11 @@ esp_err_t led_strip_new_spi_device(const led_strip_config_t *led_config, const l
     spi_strip->strip_len = led_config->max_leds;
     spi_strip->base.set_pixel = led_strip_spi_set_pixel;
     spi_strip->base.set_pixel_rgbw = led_strip_spi_set_pixel_rgbw;
+    spi_strip->base.set_pixels = led_strip_spi_set_pixels;
+    spi_strip->base.fill = led_strip_spi_fill;
     spi_strip->base.refresh = led_strip_spi_refresh;
+    spi_strip->base.refresh_async = led_strip_spi_refresh_async;
+    spi_strip->base.refresh_wait_done = led_strip_spi_refresh_wait_done;
     spi_strip->base.clear = led_strip_spi_clear;
     spi_strip->base.del = led_strip_spi_del;
 
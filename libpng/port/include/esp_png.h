@@ -0,0 +1,104 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Input stream callback
+ *
+ * @param user_data: User data set in esp_png_image_cfg_t::in_user_data
+ * @param buf: Buffer to be filled with data
+ * @param len: Number of bytes requested
+ *
+ * @return Number of bytes read. Value lower than `len` signals end of stream or an error.
+ */
+typedef uint32_t (*esp_png_read_cb_t)(void *user_data, uint8_t *buf, uint32_t len);
+
+/**
+ * @brief Rectangle of the output image
+ *
+ */
+typedef struct {
+    uint16_t x;         /*!< Left column */
+    uint16_t y;         /*!< Top row */
+    uint16_t width;     /*!< Width of the rectangle in pixels */
+    uint16_t height;    /*!< Height of the rectangle in pixels */
+} esp_png_rect_t;
+
+/**
+ * @brief Output band callback
+ *
+ * Called each time `band_height` rows of the image are decoded, and for the last rows of the image.
+ * The band spans the whole width of the image.
+ *
+ * @param user_data: User data set in esp_png_image_cfg_t::out_user_data
+ * @param rect: Position and size of the band in the image
+ * @param pixels: RGB565 pixels, `rect->width * rect->height` pixels.
+ *                The buffer is reused for the next band, it is valid only until the callback returns.
+ *
+ * @return true to continue decoding, false to abort it
+ */
+typedef bool (*esp_png_out_cb_t)(void *user_data, const esp_png_rect_t *rect, const uint16_t *pixels);
+
+/**
+ * @brief PNG decoding configuration
+ *
+ */
+typedef struct {
+    const uint8_t *indata;      /*!< Input PNG image */
+    uint32_t indata_size;       /*!< Size of input image */
+    esp_png_read_cb_t in_cb;    /*!< Input stream callback. If set, `indata` and `indata_size` are not used. */
+    void *in_user_data;         /*!< User data passed to `in_cb` */
+    esp_png_out_cb_t out_cb;    /*!< Output band callback */
+    void *out_user_data;        /*!< User data passed to `out_cb` */
+    uint16_t band_height;       /*!< Number of rows per band, 0 for 16 */
+    uint16_t background;        /*!< RGB565 color which transparent pixels are blended with */
+    struct {
+        uint8_t swap_color_bytes: 1; /*!< Output pixels in big endian byte order, as expected by most SPI LCDs */
+    } flags;
+} esp_png_image_cfg_t;
+
+/**
+ * @brief PNG output info
+ *
+ */
+typedef struct {
+    uint16_t width;     /*!< Width of the image */
+    uint16_t height;    /*!< Height of the image */
+} esp_png_image_output_t;
+
+/**
+ * @brief Decode a PNG image to RGB565 bands
+ *
+ * The image is decoded row by row with the progressive reader of libpng. All color types
+ * and bit depths are converted to RGB565, blending pixels with an alpha channel or a
+ * transparent color against `background`. Only one band of RGB565 pixels is kept in
+ * memory, instead of the whole RGBA image.
+ *
+ * @param cfg: Configuration structure
+ * @param img: Output image info, may be NULL
+ *
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED if the image is interlaced, which needs the whole image in memory
+ *      - ESP_ERR_NO_MEM        if there is no memory for the decoder or the band buffer
+ *      - ESP_FAIL              if there is an error in decoding PNG, the input ended early, or decoding was
+ *                              aborted by `out_cb`
+ */
+esp_err_t esp_png_decode_rgb565(const esp_png_image_cfg_t *cfg, esp_png_image_output_t *img);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,211 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_check.h"
+#include "png.h"
+#include "esp_png.h"
+
+static const char *TAG = "esp_png";
+
+#define ESP_PNG_DEFAULT_BAND_HEIGHT 16
+#define ESP_PNG_CHUNK_SIZE          1024
+
+typedef struct {
+    png_structp png;
+    png_infop info;
+    const esp_png_image_cfg_t *cfg;
+    uint16_t *band;                 /* RGB565 pixels of the current band */
+    uint32_t width;
+    uint32_t height;
+    uint32_t band_height;
+    uint32_t band_y;                /* First row of the current band */
+    uint32_t band_rows;             /* Rows decoded in the current band */
+    uint8_t bg_r, bg_g, bg_b;       /* Background color expanded to 8 bits per channel */
+    bool done;
+    esp_err_t err;                  /* Error reported by the callbacks, ESP_FAIL by default */
+} esp_png_ctx_t;
+
+static void esp_png_error(png_structp png, png_const_charp msg)
+{
+    ESP_LOGE(TAG, "%s", msg);
+    png_longjmp(png, 1);
+}
+
+static void esp_png_warning(png_structp png, png_const_charp msg)
+{
+    ESP_LOGD(TAG, "%s", msg);
+}
+
+static void esp_png_fail(esp_png_ctx_t *ctx, esp_err_t err, const char *msg)
+{
+    ctx->err = err;
+    png_error(ctx->png, msg);
+}
+
+static void esp_png_info_cb(png_structp png, png_infop info)
+{
+    esp_png_ctx_t *ctx = png_get_progressive_ptr(png);
+    png_uint_32 width, height;
+    int bit_depth, color_type, interlace;
+
+    png_get_IHDR(png, info, &width, &height, &bit_depth, &color_type, &interlace, NULL, NULL);
+    if (interlace != PNG_INTERLACE_NONE) {
+        esp_png_fail(ctx, ESP_ERR_NOT_SUPPORTED, "interlaced images are not supported");
+    }
+    if (width > UINT16_MAX || height > UINT16_MAX) {
+        esp_png_fail(ctx, ESP_ERR_NOT_SUPPORTED, "image too large");
+    }
+
+    /* Convert every format to 8-bit RGBA, so that rows are converted to RGB565 in one place */
+    if (color_type == PNG_COLOR_TYPE_PALETTE) {
+        png_set_palette_to_rgb(png);
+    }
+    if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8) {
+        png_set_expand_gray_1_2_4_to_8(png);
+    }
+    if (png_get_valid(png, info, PNG_INFO_tRNS)) {
+        png_set_tRNS_to_alpha(png);
+    }
+    if (bit_depth == 16) {
+        png_set_strip_16(png);
+    }
+    if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA) {
+        png_set_gray_to_rgb(png);
+    }
+    png_set_filler(png, 0xff, PNG_FILLER_AFTER);
+    png_read_update_info(png, info);
+    if (png_get_rowbytes(png, info) != width * 4) {
+        esp_png_fail(ctx, ESP_FAIL, "unexpected row format");
+    }
+
+    ctx->width = width;
+    ctx->height = height;
+    if (ctx->band_height > height) {
+        ctx->band_height = height;
+    }
+    ctx->band = malloc(width * ctx->band_height * sizeof(uint16_t));
+    if (ctx->band == NULL) {
+        esp_png_fail(ctx, ESP_ERR_NO_MEM, "no memory for band buffer");
+    }
+}
+
+static inline uint8_t esp_png_blend(uint8_t fg, uint8_t bg, uint8_t alpha)
+{
+    return (fg * alpha + bg * (255 - alpha) + 127) / 255;
+}
+
+static void esp_png_row_cb(png_structp png, png_bytep row, png_uint_32 row_num, int pass)
+{
+    esp_png_ctx_t *ctx = png_get_progressive_ptr(png);
+
+    if (row == NULL || row_num >= ctx->height) {
+        return;
+    }
+
+    uint16_t *out = ctx->band + ctx->band_rows * ctx->width;
+    for (uint32_t x = 0; x < ctx->width; x++, row += 4) {
+        uint8_t r = row[0], g = row[1], b = row[2], a = row[3];
+        if (a != 0xff) {
+            r = esp_png_blend(r, ctx->bg_r, a);
+            g = esp_png_blend(g, ctx->bg_g, a);
+            b = esp_png_blend(b, ctx->bg_b, a);
+        }
+        uint16_t px = ((r & 0xf8) << 8) | ((g & 0xfc) << 3) | (b >> 3);
+        out[x] = ctx->cfg->flags.swap_color_bytes ? (uint16_t)((px << 8) | (px >> 8)) : px;
+    }
+
+    ctx->band_rows++;
+    if (ctx->band_rows == ctx->band_height || row_num == ctx->height - 1) {
+        esp_png_rect_t rect = {
+            .x = 0,
+            .y = ctx->band_y,
+            .width = ctx->width,
+            .height = ctx->band_rows,
+        };
+        if (!ctx->cfg->out_cb(ctx->cfg->out_user_data, &rect, ctx->band)) {
+            esp_png_fail(ctx, ESP_FAIL, "decoding aborted by output callback");
+        }
+        ctx->band_y += ctx->band_rows;
+        ctx->band_rows = 0;
+    }
+}
+
+static void esp_png_end_cb(png_structp png, png_infop info)
+{
+    esp_png_ctx_t *ctx = png_get_progressive_ptr(png);
+    ctx->done = true;
+}
+
+static void esp_png_feed(esp_png_ctx_t *ctx, uint8_t *chunk)
+{
+    const esp_png_image_cfg_t *cfg = ctx->cfg;
+
+    if (cfg->in_cb == NULL) {
+        png_process_data(ctx->png, ctx->info, (png_bytep)cfg->indata, cfg->indata_size);
+        return;
+    }
+    while (!ctx->done) {
+        uint32_t len = cfg->in_cb(cfg->in_user_data, chunk, ESP_PNG_CHUNK_SIZE);
+        if (len > 0) {
+            png_process_data(ctx->png, ctx->info, chunk, len);
+        }
+        if (len < ESP_PNG_CHUNK_SIZE) {
+            break;
+        }
+    }
+}
+
+esp_err_t esp_png_decode_rgb565(const esp_png_image_cfg_t *cfg, esp_png_image_output_t *img)
+{
+    ESP_RETURN_ON_FALSE(cfg && cfg->out_cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(cfg->in_cb || (cfg->indata && cfg->indata_size), ESP_ERR_INVALID_ARG, TAG, "no input");
+
+    esp_png_ctx_t *ctx = calloc(1, sizeof(esp_png_ctx_t) + (cfg->in_cb ? ESP_PNG_CHUNK_SIZE : 0));
+    ESP_RETURN_ON_FALSE(ctx, ESP_ERR_NO_MEM, TAG, "no memory for decoder");
+    ctx->cfg = cfg;
+    ctx->err = ESP_FAIL;
+    ctx->band_height = cfg->band_height ? cfg->band_height : ESP_PNG_DEFAULT_BAND_HEIGHT;
+    ctx->bg_r = ((cfg->background >> 11) & 0x1f) * 255 / 31;
+    ctx->bg_g = ((cfg->background >> 5) & 0x3f) * 255 / 63;
+    ctx->bg_b = (cfg->background & 0x1f) * 255 / 31;
+
+    esp_err_t ret = ESP_ERR_NO_MEM;
+    ctx->png = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, esp_png_error, esp_png_warning);
+    if (ctx->png) {
+        ctx->info = png_create_info_struct(ctx->png);
+    }
+    if (ctx->info == NULL) {
+        ESP_LOGE(TAG, "no memory for libpng");
+        goto cleanup;
+    }
+
+    if (setjmp(png_jmpbuf(ctx->png))) {
+        ret = ctx->err;
+        goto cleanup;
+    }
+    png_set_progressive_read_fn(ctx->png, ctx, esp_png_info_cb, esp_png_row_cb, esp_png_end_cb);
+    esp_png_feed(ctx, (uint8_t *)(ctx + 1));
+
+    if (!ctx->done) {
+        ESP_LOGE(TAG, "unexpected end of input");
+        ret = ESP_FAIL;
+        goto cleanup;
+    }
+    if (img) {
+        img->width = ctx->width;
+        img->height = ctx->height;
+    }
+    ret = ESP_OK;
+
+cleanup:
+    png_destroy_read_struct(&ctx->png, &ctx->info, NULL);
+    free(ctx->band);
+    free(ctx);
+    return ret;
+}
@@ -0,0 +1,196 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+
+#if CONFIG_LIBPNG_FILTER_OPTIMIZATIONS
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "pngpriv.h"
+#include "png_filter_esp.h"
+
+#ifdef PNG_READ_SUPPORTED
+
+/*
+ * libpng aligns the rows passed to the unfilter functions to 16 bytes
+ * (PNG_ALIGNED_MEMORY_SUPPORTED), so 8-bit RGBA pixels can be processed as
+ * 32-bit words. The byte lanes of a word are added and averaged without carries
+ * between them. The alignment is still checked, the byte loops are used if the
+ * rows are not aligned.
+ */
+typedef uint32_t __attribute__((__may_alias__)) png_esp_word;
+
+#define PNG_ESP_LOW7    0x7f7f7f7fU
+#define PNG_ESP_HIGH1   0x80808080U
+
+static inline uint32_t png_esp_add_bytes(uint32_t a, uint32_t b)
+{
+    return ((a & PNG_ESP_LOW7) + (b & PNG_ESP_LOW7)) ^ ((a ^ b) & PNG_ESP_HIGH1);
+}
+
+static inline uint32_t png_esp_avg_bytes(uint32_t a, uint32_t b)
+{
+    return (a & b) + (((a ^ b) >> 1) & PNG_ESP_LOW7);
+}
+
+static inline int png_esp_aligned(png_const_bytep a, png_const_bytep b)
+{
+    return ((((uintptr_t)a) | ((uintptr_t)b)) & 3) == 0;
+}
+
+static void png_read_filter_row_up_esp(png_row_infop row_info, png_bytep row, png_const_bytep prev_row)
+{
+    size_t n = row_info->rowbytes;
+
+    if (png_esp_aligned(row, prev_row)) {
+        png_esp_word *rp = (png_esp_word *)row;
+        const png_esp_word *pp = (const png_esp_word *)prev_row;
+        for (; n >= 4; n -= 4, rp++, pp++) {
+            *rp = png_esp_add_bytes(*rp, *pp);
+        }
+        row = (png_bytep)rp;
+        prev_row = (png_const_bytep)pp;
+    }
+    for (; n > 0; n--, row++, prev_row++) {
+        *row = (png_byte)(*row + *prev_row);
+    }
+}
+
+static void png_read_filter_row_sub4_esp(png_row_infop row_info, png_bytep row, png_const_bytep prev_row)
+{
+    size_t n = row_info->rowbytes;
+
+    if (((uintptr_t)row & 3) == 0) {
+        png_esp_word *rp = (png_esp_word *)row;
+        uint32_t left = 0;
+        for (; n >= 4; n -= 4, rp++) {
+            left = png_esp_add_bytes(*rp, left);
+            *rp = left;
+        }
+        return;
+    }
+    png_byte a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+    for (; n >= 4; n -= 4, row += 4) {
+        row[0] = a0 = (png_byte)(row[0] + a0);
+        row[1] = a1 = (png_byte)(row[1] + a1);
+        row[2] = a2 = (png_byte)(row[2] + a2);
+        row[3] = a3 = (png_byte)(row[3] + a3);
+    }
+}
+
+static void png_read_filter_row_sub3_esp(png_row_infop row_info, png_bytep row, png_const_bytep prev_row)
+{
+    size_t n = row_info->rowbytes;
+    png_byte a0 = 0, a1 = 0, a2 = 0;
+
+    for (; n >= 3; n -= 3, row += 3) {
+        row[0] = a0 = (png_byte)(row[0] + a0);
+        row[1] = a1 = (png_byte)(row[1] + a1);
+        row[2] = a2 = (png_byte)(row[2] + a2);
+    }
+}
+
+static void png_read_filter_row_avg4_esp(png_row_infop row_info, png_bytep row, png_const_bytep prev_row)
+{
+    size_t n = row_info->rowbytes;
+
+    if (png_esp_aligned(row, prev_row)) {
+        png_esp_word *rp = (png_esp_word *)row;
+        const png_esp_word *pp = (const png_esp_word *)prev_row;
+        uint32_t left = 0;
+        for (; n >= 4; n -= 4, rp++, pp++) {
+            left = png_esp_add_bytes(*rp, png_esp_avg_bytes(left, *pp));
+            *rp = left;
+        }
+        return;
+    }
+    png_byte a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+    for (; n >= 4; n -= 4, row += 4, prev_row += 4) {
+        row[0] = a0 = (png_byte)(row[0] + ((a0 + prev_row[0]) >> 1));
+        row[1] = a1 = (png_byte)(row[1] + ((a1 + prev_row[1]) >> 1));
+        row[2] = a2 = (png_byte)(row[2] + ((a2 + prev_row[2]) >> 1));
+        row[3] = a3 = (png_byte)(row[3] + ((a3 + prev_row[3]) >> 1));
+    }
+}
+
+static void png_read_filter_row_avg3_esp(png_row_infop row_info, png_bytep row, png_const_bytep prev_row)
+{
+    size_t n = row_info->rowbytes;
+    png_byte a0 = 0, a1 = 0, a2 = 0;
+
+    for (; n >= 3; n -= 3, row += 3, prev_row += 3) {
+        row[0] = a0 = (png_byte)(row[0] + ((a0 + prev_row[0]) >> 1));
+        row[1] = a1 = (png_byte)(row[1] + ((a1 + prev_row[1]) >> 1));
+        row[2] = a2 = (png_byte)(row[2] + ((a2 + prev_row[2]) >> 1));
+    }
+}
+
+/* Same predictor and tie breaking as png_read_filter_row_paeth_multibyte_pixel() */
+static inline int png_esp_paeth(int a, int b, int c)
+{
+    int pa = b - c;
+    int pb = a - c;
+    int pc = abs(pa + pb);
+
+    pa = abs(pa);
+    pb = abs(pb);
+    if (pb < pa) {
+        pa = pb;
+        a = b;
+    }
+    return pc < pa ? c : a;
+}
+
+/*
+ * The left (a) and upper left (c) pixels are kept in locals, instead of being
+ * read back from the rows for every byte. For the first pixel a and c are 0,
+ * for which the predictor is b.
+ */
+static inline __attribute__((always_inline))
+void png_esp_paeth_row(png_bytep row, png_const_bytep prev_row, size_t n, const unsigned int bpp)
+{
+    int a[4] = { 0 };
+    int c[4] = { 0 };
+
+    for (; n >= bpp; n -= bpp, row += bpp, prev_row += bpp) {
+        for (unsigned int i = 0; i < bpp; i++) {
+            int b = prev_row[i];
+            a[i] = (png_byte)(row[i] + png_esp_paeth(a[i], b, c[i]));
+            c[i] = b;
+            row[i] = (png_byte)a[i];
+        }
+    }
+}
+
+static void png_read_filter_row_paeth4_esp(png_row_infop row_info, png_bytep row, png_const_bytep prev_row)
+{
+    png_esp_paeth_row(row, prev_row, row_info->rowbytes, 4);
+}
+
+static void png_read_filter_row_paeth3_esp(png_row_infop row_info, png_bytep row, png_const_bytep prev_row)
+{
+    png_esp_paeth_row(row, prev_row, row_info->rowbytes, 3);
+}
+
+void png_init_filter_functions_esp(png_structp pp, unsigned int bpp)
+{
+    pp->read_filter[PNG_FILTER_VALUE_UP - 1] = png_read_filter_row_up_esp;
+
+    if (bpp == 4) {
+        pp->read_filter[PNG_FILTER_VALUE_SUB - 1] = png_read_filter_row_sub4_esp;
+        pp->read_filter[PNG_FILTER_VALUE_AVG - 1] = png_read_filter_row_avg4_esp;
+        pp->read_filter[PNG_FILTER_VALUE_PAETH - 1] = png_read_filter_row_paeth4_esp;
+    } else if (bpp == 3) {
+        pp->read_filter[PNG_FILTER_VALUE_SUB - 1] = png_read_filter_row_sub3_esp;
+        pp->read_filter[PNG_FILTER_VALUE_AVG - 1] = png_read_filter_row_avg3_esp;
+        pp->read_filter[PNG_FILTER_VALUE_PAETH - 1] = png_read_filter_row_paeth3_esp;
+    }
+}
+
+#endif /* PNG_READ_SUPPORTED */
+
+#endif /* CONFIG_LIBPNG_FILTER_OPTIMIZATIONS */
@@ -0,0 +1,19 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Force-included in pngrutil.c when CONFIG_LIBPNG_FILTER_OPTIMIZATIONS is set,
+ * so that png_init_filter_functions() installs the unfilter functions of
+ * png_filter_esp.c, like the arm/ and intel/ directories of libpng do.
+ */
+
+#pragma once
+
+struct png_struct_def;
+
+void png_init_filter_functions_esp(struct png_struct_def *pp, unsigned int bpp);
+
+#define PNG_FILTER_OPTIMIZATIONS png_init_filter_functions_esp
@@ -0,0 +1,295 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "crypto_aead_aes256gcm.h"
+#include "core.h"
+#include "randombytes.h"
+#include "utils.h"
+#include "mbedtls/gcm.h"
+
+/* AES256-GCM on top of mbedTLS GCM, which uses the AES peripheral (and the GCM support of the
+   peripheral where available) when hardware AES is enabled in mbedTLS.
+
+   libsodium doesn't provide a function to free a crypto_aead_aes256gcm_state, and a software mbedTLS GCM
+   context owns heap memory. So the state only holds the key, and every operation sets up a GCM context
+   on the stack. Setting the key of the AES peripheral is cheap compared to expanding it in software.
+*/
+
+typedef struct {
+    unsigned char key[crypto_aead_aes256gcm_KEYBYTES];
+} aes256gcm_state;
+
+_Static_assert(sizeof(aes256gcm_state) <= sizeof(crypto_aead_aes256gcm_state), "state too small");
+
+static int
+aes256gcm_crypt(const unsigned char *k, int mode, unsigned char *out, const unsigned char *in,
+                unsigned long long len, const unsigned char *ad, unsigned long long adlen,
+                const unsigned char *npub, unsigned char *mac)
+{
+    mbedtls_gcm_context ctx;
+    int ret;
+
+    mbedtls_gcm_init(&ctx);
+    ret = mbedtls_gcm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, k, crypto_aead_aes256gcm_KEYBYTES * 8);
+    if (ret == 0) {
+        if (mode == MBEDTLS_GCM_ENCRYPT) {
+            ret = mbedtls_gcm_crypt_and_tag(&ctx, MBEDTLS_GCM_ENCRYPT, (size_t) len,
+                                            npub, crypto_aead_aes256gcm_NPUBBYTES,
+                                            ad, (size_t) adlen, in, out,
+                                            crypto_aead_aes256gcm_ABYTES, mac);
+        } else {
+            ret = mbedtls_gcm_auth_decrypt(&ctx, (size_t) len,
+                                           npub, crypto_aead_aes256gcm_NPUBBYTES,
+                                           ad, (size_t) adlen, mac,
+                                           crypto_aead_aes256gcm_ABYTES, in, out);
+        }
+    }
+    mbedtls_gcm_free(&ctx);
+    return ret == 0 ? 0 : -1;
+}
+
+int
+crypto_aead_aes256gcm_beforenm(crypto_aead_aes256gcm_state *ctx_,
+                               const unsigned char *k)
+{
+    aes256gcm_state *ctx = (aes256gcm_state *) (void *) ctx_;
+
+    memcpy(ctx->key, k, sizeof ctx->key);
+    return 0;
+}
+
+int
+crypto_aead_aes256gcm_encrypt_detached_afternm(unsigned char *c,
+        unsigned char *mac, unsigned long long *maclen_p,
+        const unsigned char *m, unsigned long long mlen,
+        const unsigned char *ad, unsigned long long adlen,
+        const unsigned char *nsec,
+        const unsigned char *npub,
+        const crypto_aead_aes256gcm_state *ctx_)
+{
+    const aes256gcm_state *ctx = (const aes256gcm_state *) (const void *) ctx_;
+
+    (void) nsec;
+    if (mlen > crypto_aead_aes256gcm_MESSAGEBYTES_MAX) {
+        sodium_misuse();
+    }
+    if (aes256gcm_crypt(ctx->key, MBEDTLS_GCM_ENCRYPT, c, m, mlen, ad, adlen, npub, mac) != 0) {
+        memset(mac, 0, crypto_aead_aes256gcm_ABYTES);
+        if (maclen_p != NULL) {
+            *maclen_p = 0ULL;
+        }
+        return -1;
+    }
+    if (maclen_p != NULL) {
+        *maclen_p = crypto_aead_aes256gcm_ABYTES;
+    }
+    return 0;
+}
+
+int
+crypto_aead_aes256gcm_encrypt_afternm(unsigned char *c, unsigned long long *clen_p,
+                                      const unsigned char *m, unsigned long long mlen,
+                                      const unsigned char *ad, unsigned long long adlen,
+                                      const unsigned char *nsec,
+                                      const unsigned char *npub,
+                                      const crypto_aead_aes256gcm_state *ctx_)
+{
+    unsigned long long clen = 0ULL;
+    int ret;
+
+    if (mlen > crypto_aead_aes256gcm_MESSAGEBYTES_MAX) {
+        sodium_misuse();
+    }
+    ret = crypto_aead_aes256gcm_encrypt_detached_afternm(c, c + mlen, NULL, m, mlen, ad, adlen,
+            nsec, npub, ctx_);
+    if (ret == 0) {
+        clen = mlen + crypto_aead_aes256gcm_ABYTES;
+    }
+    if (clen_p != NULL) {
+        *clen_p = clen;
+    }
+    return ret;
+}
+
+int
+crypto_aead_aes256gcm_decrypt_detached_afternm(unsigned char *m, unsigned char *nsec,
+        const unsigned char *c, unsigned long long clen,
+        const unsigned char *mac,
+        const unsigned char *ad, unsigned long long adlen,
+        const unsigned char *npub,
+        const crypto_aead_aes256gcm_state *ctx_)
+{
+    const aes256gcm_state *ctx = (const aes256gcm_state *) (const void *) ctx_;
+
+    (void) nsec;
+    if (clen > crypto_aead_aes256gcm_MESSAGEBYTES_MAX) {
+        sodium_misuse();
+    }
+    if (aes256gcm_crypt(ctx->key, MBEDTLS_GCM_DECRYPT, m, c, clen, ad, adlen, npub,
+                        (unsigned char *) mac) != 0) {
+        if (m != NULL) {
+            memset(m, 0, (size_t) clen);
+        }
+        return -1;
+    }
+    return 0;
+}
+
+int
+crypto_aead_aes256gcm_decrypt_afternm(unsigned char *m, unsigned long long *mlen_p,
+                                      unsigned char *nsec,
+                                      const unsigned char *c, unsigned long long clen,
+                                      const unsigned char *ad, unsigned long long adlen,
+                                      const unsigned char *npub,
+                                      const crypto_aead_aes256gcm_state *ctx_)
+{
+    unsigned long long mlen = 0ULL;
+    int ret = -1;
+
+    if (clen >= crypto_aead_aes256gcm_ABYTES) {
+        ret = crypto_aead_aes256gcm_decrypt_detached_afternm(m, nsec, c, clen - crypto_aead_aes256gcm_ABYTES,
+                c + clen - crypto_aead_aes256gcm_ABYTES,
+                ad, adlen, npub, ctx_);
+    }
+    if (ret == 0) {
+        mlen = clen - crypto_aead_aes256gcm_ABYTES;
+    }
+    if (mlen_p != NULL) {
+        *mlen_p = mlen;
+    }
+    return ret;
+}
+
+int
+crypto_aead_aes256gcm_encrypt_detached(unsigned char *c,
+                                       unsigned char *mac,
+                                       unsigned long long *maclen_p,
+                                       const unsigned char *m,
+                                       unsigned long long mlen,
+                                       const unsigned char *ad,
+                                       unsigned long long adlen,
+                                       const unsigned char *nsec,
+                                       const unsigned char *npub,
+                                       const unsigned char *k)
+{
+    crypto_aead_aes256gcm_state ctx;
+    int ret;
+
+    crypto_aead_aes256gcm_beforenm(&ctx, k);
+    ret = crypto_aead_aes256gcm_encrypt_detached_afternm(c, mac, maclen_p, m, mlen, ad, adlen,
+            nsec, npub, &ctx);
+    sodium_memzero(&ctx, sizeof ctx);
+    return ret;
+}
+
+int
+crypto_aead_aes256gcm_encrypt(unsigned char *c,
+                              unsigned long long *clen_p,
+                              const unsigned char *m,
+                              unsigned long long mlen,
+                              const unsigned char *ad,
+                              unsigned long long adlen,
+                              const unsigned char *nsec,
+                              const unsigned char *npub,
+                              const unsigned char *k)
+{
+    crypto_aead_aes256gcm_state ctx;
+    int ret;
+
+    crypto_aead_aes256gcm_beforenm(&ctx, k);
+    ret = crypto_aead_aes256gcm_encrypt_afternm(c, clen_p, m, mlen, ad, adlen, nsec, npub, &ctx);
+    sodium_memzero(&ctx, sizeof ctx);
+    return ret;
+}
+
+int
+crypto_aead_aes256gcm_decrypt_detached(unsigned char *m,
+                                       unsigned char *nsec,
+                                       const unsigned char *c,
+                                       unsigned long long clen,
+                                       const unsigned char *mac,
+                                       const unsigned char *ad,
+                                       unsigned long long adlen,
+                                       const unsigned char *npub,
+                                       const unsigned char *k)
+{
+    crypto_aead_aes256gcm_state ctx;
+    int ret;
+
+    crypto_aead_aes256gcm_beforenm(&ctx, k);
+    ret = crypto_aead_aes256gcm_decrypt_detached_afternm(m, nsec, c, clen, mac, ad, adlen, npub, &ctx);
+    sodium_memzero(&ctx, sizeof ctx);
+    return ret;
+}
+
+int
+crypto_aead_aes256gcm_decrypt(unsigned char *m,
+                              unsigned long long *mlen_p,
+                              unsigned char *nsec,
+                              const unsigned char *c,
+                              unsigned long long clen,
+                              const unsigned char *ad,
+                              unsigned long long adlen,
+                              const unsigned char *npub,
+                              const unsigned char *k)
+{
+    crypto_aead_aes256gcm_state ctx;
+    int ret;
+
+    crypto_aead_aes256gcm_beforenm(&ctx, k);
+    ret = crypto_aead_aes256gcm_decrypt_afternm(m, mlen_p, nsec, c, clen, ad, adlen, npub, &ctx);
+    sodium_memzero(&ctx, sizeof ctx);
+    return ret;
+}
+
+int
+crypto_aead_aes256gcm_is_available(void)
+{
+    return 1;
+}
+
+size_t
+crypto_aead_aes256gcm_keybytes(void)
+{
+    return crypto_aead_aes256gcm_KEYBYTES;
+}
+
+size_t
+crypto_aead_aes256gcm_nsecbytes(void)
+{
+    return crypto_aead_aes256gcm_NSECBYTES;
+}
+
+size_t
+crypto_aead_aes256gcm_npubbytes(void)
+{
+    return crypto_aead_aes256gcm_NPUBBYTES;
+}
+
+size_t
+crypto_aead_aes256gcm_abytes(void)
+{
+    return crypto_aead_aes256gcm_ABYTES;
+}
+
+size_t
+crypto_aead_aes256gcm_statebytes(void)
+{
+    return (sizeof(crypto_aead_aes256gcm_state) + (size_t) 15U) & ~(size_t) 15U;
+}
+
+size_t
+crypto_aead_aes256gcm_messagebytes_max(void)
+{
+    return crypto_aead_aes256gcm_MESSAGEBYTES_MAX;
+}
+
+void
+crypto_aead_aes256gcm_keygen(unsigned char k[crypto_aead_aes256gcm_KEYBYTES])
+{
+    randombytes_buf(k, crypto_aead_aes256gcm_KEYBYTES);
+}
@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "crypto_hash_sha256.h"
+#include "utils.h"
+#include "crypto_hash_sha_hardware.h"
+
+#define SHA256_BLOCK_SIZE 64
+
+_Static_assert(sizeof(((crypto_hash_sha256_state *)0)->buf) == SHA256_BLOCK_SIZE, "buf mismatch");
+
+int
+crypto_hash_sha256_init(crypto_hash_sha256_state *state)
+{
+    state->count = 0;
+    return 0;
+}
+
+int
+crypto_hash_sha256_update(crypto_hash_sha256_state *state,
+                          const unsigned char *in, unsigned long long inlen)
+{
+    return sha_hardware_update(SHA2_256, SHA256_BLOCK_SIZE, state->state, &state->count, state->buf, in, inlen);
+}
+
+int
+crypto_hash_sha256_final(crypto_hash_sha256_state *state, unsigned char *out)
+{
+    int ret = sha_hardware_final(SHA2_256, SHA256_BLOCK_SIZE, state->state, &state->count, state->buf,
+                                 out, crypto_hash_sha256_BYTES);
+    sodium_memzero((void *) state, sizeof *state);
+    return ret;
+}
+
+int
+crypto_hash_sha256(unsigned char *out, const unsigned char *in,
+                   unsigned long long inlen)
+{
+    crypto_hash_sha256_state state;
+
+    crypto_hash_sha256_init(&state);
+    int ret = crypto_hash_sha256_update(&state, in, inlen);
+    if (ret != 0) {
+        sodium_memzero((void *) &state, sizeof state);
+        return ret;
+    }
+    return crypto_hash_sha256_final(&state, out);
+}
@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "crypto_hash_sha512.h"
+#include "utils.h"
+#include "crypto_hash_sha_hardware.h"
+
+#define SHA512_BLOCK_SIZE 128
+
+_Static_assert(sizeof(((crypto_hash_sha512_state *)0)->buf) == SHA512_BLOCK_SIZE, "buf mismatch");
+
+int
+crypto_hash_sha512_init(crypto_hash_sha512_state *state)
+{
+    state->count[0] = 0;
+    state->count[1] = 0;
+    return 0;
+}
+
+int
+crypto_hash_sha512_update(crypto_hash_sha512_state *state,
+                          const unsigned char *in, unsigned long long inlen)
+{
+    return sha_hardware_update(SHA2_512, SHA512_BLOCK_SIZE, state->state, &state->count[0], state->buf, in, inlen);
+}
+
+int
+crypto_hash_sha512_final(crypto_hash_sha512_state *state, unsigned char *out)
+{
+    int ret = sha_hardware_final(SHA2_512, SHA512_BLOCK_SIZE, state->state, &state->count[0], state->buf,
+                                 out, crypto_hash_sha512_BYTES);
+    sodium_memzero((void *) state, sizeof *state);
+    return ret;
+}
+
+int
+crypto_hash_sha512(unsigned char *out, const unsigned char *in,
+                   unsigned long long inlen)
+{
+    crypto_hash_sha512_state state;
+
+    crypto_hash_sha512_init(&state);
+    int ret = crypto_hash_sha512_update(&state, in, inlen);
+    if (ret != 0) {
+        sodium_memzero((void *) &state, sizeof state);
+        return ret;
+    }
+    return crypto_hash_sha512_final(&state, out);
+}
@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+/* Common part of the SHA256 & SHA512 implementations on the SHA peripheral.
+
+   Unlike the mbedTLS wrappers, these don't map the libsodium state to a mbedTLS context. The peripheral is
+   acquired for each update only, and the intermediate digest is saved to the 'state' field of the libsodium
+   state structure in between, then restored with esp_sha_write_digest_state(). This needs a peripheral which
+   can resume from a saved digest (SOC_SHA_SUPPORT_RESUME), so not ESP32.
+
+   As in the mbedTLS wrappers, the 'count' field holds a *byte* count rather than libsodium's bit count,
+   and 'state' holds the digest in the format of the peripheral.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "soc/soc_caps.h"
+#if SOC_SHA_SUPPORT_DMA
+#include "sha/sha_dma.h"
+#else
+#include "sha/sha_block.h"
+#endif
+
+static int sha_hardware_process(esp_sha_type type, size_t block_size, void *digest_state, bool first_block,
+                                const uint8_t *buf, size_t buf_len, const uint8_t *in, size_t in_len)
+{
+    int ret = 0;
+
+    esp_sha_acquire_hardware();
+    if (!first_block) {
+        esp_sha_write_digest_state(type, digest_state);
+    }
+#if SOC_SHA_SUPPORT_DMA
+    // All the blocks in one DMA transfer, esp_sha_dma() falls back to block mode for input in flash
+    ret = esp_sha_dma(type, in, in_len, buf, buf_len, first_block);
+#else
+    if (buf_len) {
+        esp_sha_block(type, buf, first_block);
+        first_block = false;
+    }
+    for (size_t off = 0; off < in_len; off += block_size) {
+        esp_sha_block(type, in + off, first_block);
+        first_block = false;
+    }
+#endif /* SOC_SHA_SUPPORT_DMA */
+    esp_sha_read_digest_state(type, digest_state);
+    esp_sha_release_hardware();
+    return ret;
+}
+
+static int sha_hardware_update(esp_sha_type type, size_t block_size, void *digest_state, uint64_t *count,
+                               uint8_t *buf, const unsigned char *in, unsigned long long inlen)
+{
+    const size_t fill = *count % block_size;
+    const bool first_block = *count - fill == 0;
+
+    *count += inlen;
+    if (inlen < block_size - fill) {
+        memcpy(buf + fill, in, inlen);
+        return 0;
+    }
+
+    size_t buf_len = 0;
+    if (fill) {
+        const size_t n = block_size - fill;
+        memcpy(buf + fill, in, n);
+        in += n;
+        inlen -= n;
+        buf_len = block_size;
+    }
+    const size_t full_len = inlen - inlen % block_size;
+    int ret = sha_hardware_process(type, block_size, digest_state, first_block, buf, buf_len, in, full_len);
+    memcpy(buf, in + full_len, inlen - full_len);
+    return ret;
+}
+
+static int sha_hardware_final(esp_sha_type type, size_t block_size, void *digest_state, uint64_t *count,
+                              uint8_t *buf, unsigned char *out, size_t out_len)
+{
+    const uint64_t bit_count = *count * 8;
+    size_t fill = *count % block_size;
+    bool first_block = *count - fill == 0;
+
+    buf[fill++] = 0x80;
+    // The length takes the last 8 bytes of a SHA256 block and the last 16 bytes of a SHA512 block
+    const size_t len_size = block_size / 8;
+    if (fill > block_size - len_size) {
+        memset(buf + fill, 0, block_size - fill);
+        int ret = sha_hardware_process(type, block_size, digest_state, first_block, buf, block_size, NULL, 0);
+        if (ret != 0) {
+            return ret;
+        }
+        first_block = false;
+        fill = 0;
+    }
+    memset(buf + fill, 0, block_size - 8 - fill);
+    for (int i = 0; i < 8; i++) {
+        buf[block_size - 1 - i] = (uint8_t)(bit_count >> (8 * i));
+    }
+    int ret = sha_hardware_process(type, block_size, digest_state, first_block, buf, block_size, NULL, 0);
+    if (ret == 0) {
+        memcpy(out, digest_state, out_len);
+    }
+    return ret;
+}
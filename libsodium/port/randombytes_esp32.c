@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2017-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2017-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -11,6 +11,135 @@
 #endif
 #include "randombytes_internal.h"
 
+#if CONFIG_LIBSODIUM_RANDOMBYTES_DRBG
+#include <string.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sodium/crypto_stream_chacha20.h"
+#include "sodium/utils.h"
+
+/*
+  ChaCha20 DRBG with fast key erasure, seeded from the hardware RNG.
+
+  Each core owns a buffer of keystream. Every refill generates one buffer with the
+  current key; its first bytes become the next key and are wiped, so bytes already
+  returned cannot be recomputed from the state. Fresh hardware entropy is XORed into
+  the key every CONFIG_LIBSODIUM_RANDOMBYTES_DRBG_RESEED_BYTES of output.
+
+  The state of a core is only used with the scheduler suspended on that core, so
+  tasks never share a buffer and interrupts stay enabled. Requests larger than
+  DRBG_DIRECT_THRESHOLD draw a one-time key from the buffer and are generated
+  directly into the caller's memory, outside the scheduler lock.
+*/
+
+#define DRBG_KEY_BYTES        crypto_stream_chacha20_KEYBYTES
+#define DRBG_BUFFER_BYTES     512
+#define DRBG_DIRECT_THRESHOLD 256
+
+typedef struct {
+    uint8_t buf[DRBG_BUFFER_BYTES];
+    size_t available;       /* unread bytes at the end of buf */
+    size_t since_reseed;    /* bytes of output since the last reseed */
+    bool seeded;
+    bool reseed;            /* set by stir() */
+} drbg_state_t;
+
+static drbg_state_t s_drbg[portNUM_PROCESSORS];
+
+static const uint8_t s_zero_nonce[crypto_stream_chacha20_NONCEBYTES];
+
+/* The key lives in the first DRBG_KEY_BYTES of buf, which are never handed out */
+static void drbg_refill(drbg_state_t *s)
+{
+    if (!s->seeded || s->reseed || s->since_reseed >= CONFIG_LIBSODIUM_RANDOMBYTES_DRBG_RESEED_BYTES) {
+        uint8_t seed[DRBG_KEY_BYTES];
+        esp_fill_random(seed, sizeof(seed));
+        for (size_t i = 0; i < DRBG_KEY_BYTES; i++) {
+            s->buf[i] ^= seed[i];
+        }
+        sodium_memzero(seed, sizeof(seed));
+        s->seeded = true;
+        s->reseed = false;
+        s->since_reseed = 0;
+    }
+    uint8_t key[DRBG_KEY_BYTES];
+    memcpy(key, s->buf, sizeof(key));
+    crypto_stream_chacha20(s->buf, sizeof(s->buf), s_zero_nonce, key);
+    sodium_memzero(key, sizeof(key));
+    s->available = DRBG_BUFFER_BYTES - DRBG_KEY_BYTES;
+}
+
+/* Copies out and wipes len bytes of buffered output, len <= DRBG_BUFFER_BYTES - DRBG_KEY_BYTES */
+static void drbg_take(drbg_state_t *s, uint8_t *out, size_t len)
+{
+    while (len > 0) {
+        if (s->available == 0 || s->reseed) {
+            drbg_refill(s);
+        }
+        size_t n = len < s->available ? len : s->available;
+        uint8_t *src = s->buf + DRBG_BUFFER_BYTES - s->available;
+        memcpy(out, src, n);
+        sodium_memzero(src, n);
+        s->available -= n;
+        s->since_reseed += n;
+        out += n;
+        len -= n;
+    }
+}
+
+static void randombytes_esp32_buf(void *const buf, const size_t size)
+{
+    if (size == 0) {
+        return;
+    }
+    if (xPortInIsrContext()) {
+        esp_fill_random(buf, size);
+        return;
+    }
+
+    bool direct = size > DRBG_DIRECT_THRESHOLD;
+    uint8_t key[DRBG_KEY_BYTES];
+
+    vTaskSuspendAll();
+    drbg_state_t *s = &s_drbg[xPortGetCoreID()];
+    if (direct) {
+        drbg_take(s, key, sizeof(key));
+        s->since_reseed += size;
+    } else {
+        drbg_take(s, buf, size);
+    }
+    xTaskResumeAll();
+
+    if (direct) {
+        crypto_stream_chacha20(buf, size, s_zero_nonce, key);
+        sodium_memzero(key, sizeof(key));
+    }
+}
+
+static uint32_t randombytes_esp32_random(void)
+{
+    uint32_t r;
+    randombytes_esp32_buf(&r, sizeof(r));
+    return r;
+}
+
+static void randombytes_esp32_stir(void)
+{
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        s_drbg[i].reseed = true;
+    }
+}
+
+static int randombytes_esp32_close(void)
+{
+    vTaskSuspendAll();
+    sodium_memzero(s_drbg, sizeof(s_drbg));
+    xTaskResumeAll();
+    return 0;
+}
+#endif // CONFIG_LIBSODIUM_RANDOMBYTES_DRBG
+
 static const char *randombytes_esp32xx_implementation_name(void)
 {
     return CONFIG_IDF_TARGET;
@@ -23,6 +152,16 @@ static const char *randombytes_esp32xx_implementation_name(void)
   Note that this RNG is selected by default (see randombytes_default.h), so there
   is no need to call randombytes_set_implementation().
 */
+#if CONFIG_LIBSODIUM_RANDOMBYTES_DRBG
+const struct randombytes_implementation randombytes_esp32_implementation = {
+    .implementation_name = randombytes_esp32xx_implementation_name,
+    .random = randombytes_esp32_random,
+    .stir = randombytes_esp32_stir,
+    .uniform = NULL,
+    .buf = randombytes_esp32_buf,
+    .close = randombytes_esp32_close,
+};
+#else
 const struct randombytes_implementation randombytes_esp32_implementation = {
     .implementation_name = randombytes_esp32xx_implementation_name,
     .random = esp_random,
@@ -31,3 +170,4 @@ const struct randombytes_implementation randombytes_esp32_implementation = {
     .buf = esp_fill_random,
     .close = NULL,
 };
+#endif
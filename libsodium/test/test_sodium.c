@@ -3,9 +3,25 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <string.h>
+#include <sys/param.h>
 #include "unity.h"
+#include "sdkconfig.h"
 #include "sodium/crypto_hash_sha256.h"
 #include "sodium/crypto_hash_sha512.h"
+#include "sodium/randombytes.h"
+#include "sodium/crypto_scalarmult.h"
+#include "sodium/crypto_sign.h"
+#include "sodium/utils.h"
+#include "esp_timer.h"
+#include "mbedtls/version.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/sha512.h"
+
+#if (MBEDTLS_VERSION_NUMBER < 0x03000000)
+#define mbedtls_sha256 mbedtls_sha256_ret
+#define mbedtls_sha512 mbedtls_sha512_ret
+#endif
 
 /* Note: a lot of these libsodium test programs assert() things, but they're not complete unit tests - most expect
    output to be compared to the matching .exp file.
@@ -58,6 +74,16 @@ TEST_CASE("sign tests", "[libsodium]")
     TEST_ASSERT_EQUAL(0, sign_xmain() );
 }
 
+#if CONFIG_LIBSODIUM_USE_MBEDTLS_AES_GCM
+extern int aead_aes256gcm_xmain(void);
+
+TEST_CASE("aead_aes256gcm test vectors", "[libsodium]")
+{
+    printf("Running aead_aes256gcm\n");
+    TEST_ASSERT_EQUAL(0, aead_aes256gcm_xmain());
+}
+#endif
+
 extern int hash_xmain(void);
 
 TEST_CASE("hash tests", "[libsodium]")
@@ -124,3 +150,187 @@ TEST_CASE("sha512 sanity check", "[libsodium]")
     crypto_hash_sha512_final(&state, calculated);
     TEST_ASSERT_EQUAL_MEMORY(expected, calculated, crypto_hash_sha512_bytes());
 }
+
+TEST_CASE("sha256 & sha512 multi-block updates match mbedTLS", "[libsodium]")
+{
+    static uint8_t in[1000];
+    uint8_t expected[64];
+    uint8_t calculated[64];
+
+    for (int i = 0; i < sizeof(in); i++) {
+        in[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    // Lengths and update sizes around the block sizes and the padding boundaries
+    const size_t lens[] = { 0, 55, 56, 63, 64, 111, 112, 127, 128, 129, 300, sizeof(in) };
+    const size_t chunks[] = { 1, 13, 64, 100, 128, 200, sizeof(in) };
+    for (int l = 0; l < sizeof(lens) / sizeof(lens[0]); l++) {
+        const size_t len = lens[l];
+        for (int c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+            const size_t chunk = chunks[c];
+
+            crypto_hash_sha256_state state256;
+            crypto_hash_sha256_init(&state256);
+            for (size_t off = 0; off < len; off += chunk) {
+                crypto_hash_sha256_update(&state256, in + off, MIN(chunk, len - off));
+            }
+            crypto_hash_sha256_final(&state256, calculated);
+            TEST_ASSERT_EQUAL(0, mbedtls_sha256(in, len, expected, 0));
+            TEST_ASSERT_EQUAL_MEMORY(expected, calculated, crypto_hash_sha256_bytes());
+
+            crypto_hash_sha512_state state512;
+            crypto_hash_sha512_init(&state512);
+            for (size_t off = 0; off < len; off += chunk) {
+                crypto_hash_sha512_update(&state512, in + off, MIN(chunk, len - off));
+            }
+            crypto_hash_sha512_final(&state512, calculated);
+            TEST_ASSERT_EQUAL(0, mbedtls_sha512(in, len, expected, 0));
+            TEST_ASSERT_EQUAL_MEMORY(expected, calculated, crypto_hash_sha512_bytes());
+        }
+    }
+}
+
+TEST_CASE("randombytes output does not repeat across request sizes", "[libsodium]")
+{
+    // Sizes around the DRBG buffer and the direct-generation threshold
+    const size_t sizes[] = { 1, 4, 24, 255, 256, 257, 480, 481, 1000 };
+    uint8_t prev[1000] = { 0 };
+    uint8_t out[1000];
+
+    for (int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        for (int j = 0; j < 20; j++) {
+            const size_t len = sizes[i];
+            randombytes_buf(out, len);
+            if (len >= 16) {
+                TEST_ASSERT_NOT_EQUAL(0, memcmp(prev, out, 16));
+            }
+            memcpy(prev, out, 16);
+        }
+    }
+
+    uint32_t a = randombytes_random();
+    randombytes_stir();
+    uint32_t b = randombytes_random();
+    TEST_ASSERT_NOT_EQUAL(a, b);
+}
+
+static void hex_to_bin(uint8_t *bin, size_t bin_len, const char *hex)
+{
+    size_t len = 0;
+    TEST_ASSERT_EQUAL(0, sodium_hex2bin(bin, bin_len, hex, strlen(hex), NULL, &len, NULL));
+    TEST_ASSERT_EQUAL(bin_len, len);
+}
+
+static void check_x25519(const char *scalar_hex, const char *point_hex, const char *expected_hex)
+{
+    uint8_t scalar[crypto_scalarmult_SCALARBYTES];
+    uint8_t point[crypto_scalarmult_BYTES];
+    uint8_t expected[crypto_scalarmult_BYTES];
+    uint8_t calculated[crypto_scalarmult_BYTES];
+
+    hex_to_bin(scalar, sizeof(scalar), scalar_hex);
+    hex_to_bin(expected, sizeof(expected), expected_hex);
+    if (point_hex) {
+        hex_to_bin(point, sizeof(point), point_hex);
+        TEST_ASSERT_EQUAL(0, crypto_scalarmult(calculated, scalar, point));
+    } else {
+        TEST_ASSERT_EQUAL(0, crypto_scalarmult_base(calculated, scalar));
+    }
+    TEST_ASSERT_EQUAL_MEMORY(expected, calculated, sizeof(expected));
+}
+
+// RFC 7748 sections 5.2 and 6.1
+TEST_CASE("x25519 test vectors", "[libsodium][timeout=60]")
+{
+    check_x25519("a546e36bf0527c9d3b16154b82465edd62144c0ac1fc5a18506a2244ba449ac4",
+                 "e6db6867583030db3594c1a424b15f7c726624ec26b3353b10a903a6d0ab1c4c",
+                 "c3da55379de9c6908e94ea4df28d084f32eccf03491c71f754b4075577a28552");
+    // The most significant bit of the point is ignored
+    check_x25519("4b66e9d4d1b4673c5ad22691957d6af5c11b6421e0ea01d42ca4169e7918ba0d",
+                 "e5210f12786811d3f4b7959d0538ae2c31dbe7106fc03c3efc4cd549c715a493",
+                 "95cbde9476e8907d7aade45cb4b873f88b595a68799fa152e6f8f7647aac7957");
+
+    // Diffie-Hellman, the public keys from the fixed base and from the ladder
+    const char *alice_sk = "77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a";
+    const char *alice_pk = "8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a";
+    const char *bob_sk = "5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb";
+    const char *bob_pk = "de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f";
+    const char *base = "0900000000000000000000000000000000000000000000000000000000000000";
+    const char *shared = "4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742";
+    check_x25519(alice_sk, NULL, alice_pk);
+    check_x25519(alice_sk, base, alice_pk);
+    check_x25519(bob_sk, NULL, bob_pk);
+    check_x25519(bob_sk, base, bob_pk);
+    check_x25519(alice_sk, bob_pk, shared);
+    check_x25519(bob_sk, alice_pk, shared);
+
+    // Iterated, the result is the next scalar and the scalar the next point
+    uint8_t k[crypto_scalarmult_BYTES] = { 9 };
+    uint8_t u[crypto_scalarmult_BYTES] = { 9 };
+    uint8_t r[crypto_scalarmult_BYTES];
+    uint8_t expected[crypto_scalarmult_BYTES];
+    for (int i = 1; i <= 1000; i++) {
+        TEST_ASSERT_EQUAL(0, crypto_scalarmult(r, k, u));
+        memcpy(u, k, sizeof(u));
+        memcpy(k, r, sizeof(k));
+        if (i == 1) {
+            hex_to_bin(expected, sizeof(expected), "422c8e7a6227d7bca1350b3e2bb7279f7897b87bb6854b783c60e80311ae3079");
+            TEST_ASSERT_EQUAL_MEMORY(expected, k, sizeof(expected));
+        }
+    }
+    hex_to_bin(expected, sizeof(expected), "684cf59ba83309552800ef566f2f4d3c1c3887c49360e3875f2eb94d99532c51");
+    TEST_ASSERT_EQUAL_MEMORY(expected, k, sizeof(expected));
+}
+
+// Time per operation of the ref10 curve arithmetic, to compare the builds with and without
+// CONFIG_LIBSODIUM_CURVE25519_OPTIMIZE_SPEED
+#if CONFIG_LIBSODIUM_CURVE25519_OPTIMIZE_SPEED
+#define CURVE25519_BUILD "-O2"
+#else
+#define CURVE25519_BUILD "project optimization"
+#endif
+
+TEST_CASE("x25519 and ed25519 timing", "[libsodium][timeout=60]")
+{
+    const int iterations = 20;
+    uint8_t scalar[crypto_scalarmult_SCALARBYTES];
+    uint8_t point[crypto_scalarmult_BYTES];
+    uint8_t shared[crypto_scalarmult_BYTES];
+    uint8_t pk[crypto_sign_PUBLICKEYBYTES];
+    uint8_t sk[crypto_sign_SECRETKEYBYTES];
+    uint8_t sig[crypto_sign_BYTES];
+    const uint8_t message[] = "libsodium ed25519 timing";
+
+    randombytes_buf(scalar, sizeof(scalar));
+    TEST_ASSERT_EQUAL(0, crypto_scalarmult_base(point, scalar));
+    TEST_ASSERT_EQUAL(0, crypto_sign_keypair(pk, sk));
+    TEST_ASSERT_EQUAL(0, crypto_sign_detached(sig, NULL, message, sizeof(message), sk));
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < iterations; i++) {
+        TEST_ASSERT_EQUAL(0, crypto_scalarmult(shared, scalar, point));
+    }
+    int64_t scalarmult_us = (esp_timer_get_time() - start) / iterations;
+
+    start = esp_timer_get_time();
+    for (int i = 0; i < iterations; i++) {
+        TEST_ASSERT_EQUAL(0, crypto_scalarmult_base(point, scalar));
+    }
+    int64_t scalarmult_base_us = (esp_timer_get_time() - start) / iterations;
+
+    start = esp_timer_get_time();
+    for (int i = 0; i < iterations; i++) {
+        TEST_ASSERT_EQUAL(0, crypto_sign_detached(sig, NULL, message, sizeof(message), sk));
+    }
+    int64_t sign_us = (esp_timer_get_time() - start) / iterations;
+
+    start = esp_timer_get_time();
+    for (int i = 0; i < iterations; i++) {
+        TEST_ASSERT_EQUAL(0, crypto_sign_verify_detached(sig, message, sizeof(message), pk));
+    }
+    int64_t verify_us = (esp_timer_get_time() - start) / iterations;
+
+    printf("curve25519 arithmetic (%s): x25519 %lld us, x25519 base %lld us, ed25519 sign %lld us, verify %lld us\n",
+           CURVE25519_BUILD, (long long)scalarmult_us, (long long)scalarmult_base_us, (long long)sign_us,
+           (long long)verify_us);
+}
@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "sdkconfig.h"
+#include <nghttp2/nghttp2.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** HPACK decoder table size to advertise with SETTINGS_HEADER_TABLE_SIZE */
+#define NGHTTP2_PORT_HEADER_TABLE_SIZE CONFIG_NGHTTP2_HPACK_INFLATE_TABLE_SIZE
+
+/**
+ * @brief Create session options with the limits set in menuconfig
+ *
+ * The returned options set the HPACK encoder table size and the maximum sent
+ * header block length. Pass them to nghttp2_session_client_new3() or
+ * nghttp2_session_server_new3() and delete them with nghttp2_option_del().
+ *
+ * @return Options, or NULL if out of memory
+ */
+nghttp2_option *nghttp2_port_option_new(void);
+
+/**
+ * @brief Create an allocator for one session
+ *
+ * With CONFIG_NGHTTP2_MEM_POOL enabled, the allocator serves small allocations
+ * from a slab of fixed size blocks and larger ones from the heap. It is not
+ * thread safe: it must only be used by one session, which is itself only used
+ * by one task at a time.
+ *
+ * Pass it to nghttp2_session_client_new3() or nghttp2_session_server_new3() and
+ * delete it with nghttp2_port_mem_del() after the session was deleted.
+ *
+ * @return Allocator, or NULL if the pool is disabled or out of memory, in
+ *         which case nghttp2 uses its default allocator
+ */
+nghttp2_mem *nghttp2_port_mem_new(void);
+
+/**
+ * @brief Delete an allocator created with nghttp2_port_mem_new()
+ *
+ * @param[in] mem  Allocator, may be NULL
+ */
+void nghttp2_port_mem_del(nghttp2_mem *mem);
+
+#ifdef __cplusplus
+}
+#endif
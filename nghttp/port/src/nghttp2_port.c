@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_heap_caps.h"
+#include "nghttp2_port.h"
+
+nghttp2_option *nghttp2_port_option_new(void)
+{
+    nghttp2_option *option;
+    if (nghttp2_option_new(&option) != 0) {
+        return NULL;
+    }
+    nghttp2_option_set_max_deflate_dynamic_table_size(option, CONFIG_NGHTTP2_HPACK_DEFLATE_TABLE_SIZE);
+    nghttp2_option_set_max_send_header_block_length(option, CONFIG_NGHTTP2_MAX_SEND_HEADER_BLOCK_LENGTH);
+    return option;
+}
+
+#if CONFIG_NGHTTP2_MEM_POOL
+
+#define POOL_BLOCK_SIZE  ((CONFIG_NGHTTP2_MEM_POOL_BLOCK_SIZE + 7) & ~7)
+#define POOL_BLOCKS      CONFIG_NGHTTP2_MEM_POOL_BLOCKS
+
+typedef struct pool_block {
+    struct pool_block *next;
+} pool_block_t;
+
+typedef struct {
+    nghttp2_mem mem;
+    pool_block_t *free_list;
+    uint8_t *slab;
+} mem_pool_t;
+
+static inline bool pool_owns(const mem_pool_t *pool, const void *ptr)
+{
+    return (const uint8_t *)ptr >= pool->slab && (const uint8_t *)ptr < pool->slab + POOL_BLOCK_SIZE * POOL_BLOCKS;
+}
+
+static void *pool_malloc(size_t size, void *mem_user_data)
+{
+    mem_pool_t *pool = mem_user_data;
+    if (size <= POOL_BLOCK_SIZE && pool->free_list) {
+        pool_block_t *block = pool->free_list;
+        pool->free_list = block->next;
+        return block;
+    }
+    return malloc(size);
+}
+
+static void pool_free(void *ptr, void *mem_user_data)
+{
+    mem_pool_t *pool = mem_user_data;
+    if (pool_owns(pool, ptr)) {
+        pool_block_t *block = ptr;
+        block->next = pool->free_list;
+        pool->free_list = block;
+        return;
+    }
+    free(ptr);
+}
+
+static void *pool_calloc(size_t nmemb, size_t size, void *mem_user_data)
+{
+    if (size && nmemb > SIZE_MAX / size) {
+        return NULL;
+    }
+    void *ptr = pool_malloc(nmemb * size, mem_user_data);
+    if (ptr) {
+        memset(ptr, 0, nmemb * size);
+    }
+    return ptr;
+}
+
+static void *pool_realloc(void *ptr, size_t size, void *mem_user_data)
+{
+    mem_pool_t *pool = mem_user_data;
+    if (!pool_owns(pool, ptr)) {
+        /* Heap allocations stay on the heap, nghttp2 mostly grows its buffers */
+        return realloc(ptr, size);
+    }
+    if (size <= POOL_BLOCK_SIZE) {
+        return ptr;
+    }
+    void *new_ptr = malloc(size);
+    if (new_ptr) {
+        memcpy(new_ptr, ptr, POOL_BLOCK_SIZE);
+        pool_free(ptr, pool);
+    }
+    return new_ptr;
+}
+
+nghttp2_mem *nghttp2_port_mem_new(void)
+{
+    mem_pool_t *pool = calloc(1, sizeof(*pool));
+    if (!pool) {
+        return NULL;
+    }
+    pool->slab = heap_caps_aligned_alloc(8, POOL_BLOCK_SIZE * POOL_BLOCKS, MALLOC_CAP_DEFAULT);
+    if (!pool->slab) {
+        free(pool);
+        return NULL;
+    }
+    for (int i = POOL_BLOCKS - 1; i >= 0; i--) {
+        pool_block_t *block = (pool_block_t *)(pool->slab + i * POOL_BLOCK_SIZE);
+        block->next = pool->free_list;
+        pool->free_list = block;
+    }
+    pool->mem = (nghttp2_mem) {
+        .mem_user_data = pool,
+        .malloc = pool_malloc,
+        .free = pool_free,
+        .calloc = pool_calloc,
+        .realloc = pool_realloc,
+    };
+    return &pool->mem;
+}
+
+void nghttp2_port_mem_del(nghttp2_mem *mem)
+{
+    if (!mem) {
+        return;
+    }
+    mem_pool_t *pool = mem->mem_user_data;
+    free(pool->slab);
+    free(pool);
+}
+
+#else
+
+nghttp2_mem *nghttp2_port_mem_new(void)
+{
+    return NULL;
+}
+
+void nghttp2_port_mem_del(nghttp2_mem *mem)
+{
+}
+
+#endif // CONFIG_NGHTTP2_MEM_POOL
@@ -62,6 +62,27 @@ esp_err_t onewire_bus_write_bit(onewire_bus_handle_t bus, uint8_t tx_bit);
  */
 esp_err_t onewire_bus_read_bit(onewire_bus_handle_t bus, uint8_t *rx_bit);
 
+/**
+ * @brief Execute search triplets of the ROM search algorithm
+ *
+ * @note Each triplet reads a bit and its complement from the devices, then writes the taken direction:
+ *       the read bit if the bit and its complement differ, otherwise (discrepancy) the bit from `directions`.
+ *       Must be called after a reset pulse and the SEARCH ROM command. Bit arrays are LSB first.
+ *
+ * @param[in] bus 1-Wire bus handle
+ * @param[in] directions Directions to take at discrepancies, `num_triplets` bits
+ * @param[out] taken Taken directions, i.e. the found ROM number, `num_triplets` bits
+ * @param[out] discrepancies Set bits mark discrepancies, `num_triplets` bits
+ * @param[in] num_triplets Number of triplets, typically 64
+ * @return
+ *      - ESP_OK: Execute search triplets successfully
+ *      - ESP_ERR_INVALID_ARG: Execute search triplets failed because of invalid argument
+ *      - ESP_ERR_NOT_FOUND: No devices participated in the search
+ *      - ESP_FAIL: Execute search triplets failed because of other errors
+ */
+esp_err_t onewire_bus_search_triplets(onewire_bus_handle_t bus, const uint8_t *directions, uint8_t *taken, uint8_t *discrepancies,
+                                      size_t num_triplets);
+
 /**
  * @brief Send reset pulse to the bus, and check if there are devices attached to the bus
  *
@@ -74,6 +95,96 @@ esp_err_t onewire_bus_read_bit(onewire_bus_handle_t bus, uint8_t *rx_bit);
  */
 esp_err_t onewire_bus_reset(onewire_bus_handle_t bus);
 
+/**
+ * @brief Execute a sequence of transactions while holding the bus
+ *
+ * @note Transactions are executed back to back, e.g. to read many devices addressed by MATCH ROM,
+ *       or to start conversion of all devices by SKIP ROM. A transaction whose device is not present
+ *       gets `ESP_ERR_NOT_FOUND` as its result and the next transactions are still executed.
+ *
+ * @param[in] bus 1-Wire bus handle
+ * @param[inout] trans Array of transactions, their `result` is set
+ * @param[in] num_trans Number of transactions
+ * @return
+ *      - ESP_OK: All transactions were executed, check `result` of each one
+ *      - ESP_ERR_INVALID_ARG: Execute transactions failed because of invalid argument
+ *      - ESP_FAIL: Execute transactions failed because of other errors, following transactions are not executed
+ */
+esp_err_t onewire_bus_transaction(onewire_bus_handle_t bus, onewire_bus_transaction_t *trans, size_t num_trans);
+
+/**
+ * @brief Start executing a sequence of transactions, without waiting for the bus
+ *
+ * @note Transactions are queued and executed like by `onewire_bus_transaction` in a task of the bus,
+ *       which calls `done_cb` when they are done. The transactions and their buffers must stay valid until then.
+ *
+ * @param[in] bus 1-Wire bus handle
+ * @param[inout] trans Array of transactions, their `result` is set
+ * @param[in] num_trans Number of transactions
+ * @param[in] done_cb Callback called after the transactions are executed
+ * @param[in] user_ctx User context passed to done_cb
+ * @return
+ *      - ESP_OK: Transactions were queued
+ *      - ESP_ERR_INVALID_ARG: Queue transactions failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Queue transactions failed because too many transactions are pending
+ *      - ESP_ERR_NO_MEM: Queue transactions failed because the task of the bus can't be created
+ *      - ESP_ERR_NOT_SUPPORTED: Asynchronous transactions are not supported by the bus backend
+ */
+esp_err_t onewire_bus_transaction_async(onewire_bus_handle_t bus, onewire_bus_transaction_t *trans, size_t num_trans,
+                                        onewire_bus_transaction_done_cb_t done_cb, void *user_ctx);
+
+/**
+ * @brief Set the speed of the following operations of the bus, including reset pulses
+ *
+ * @note This only changes the timings of the bus master. Devices are switched to overdrive by an overdrive ROM command,
+ *       see `onewire_bus_overdrive_skip_rom` and `onewire_bus_overdrive_match_rom`, and back to standard speed
+ *       by a reset pulse at standard speed.
+ *
+ * @param[in] bus 1-Wire bus handle
+ * @param[in] speed Bus speed
+ * @return
+ *      - ESP_OK: Set speed successfully
+ *      - ESP_ERR_INVALID_ARG: Set speed failed because of invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED: Set speed failed because the speed is not supported or not enabled by the bus backend,
+ *                               e.g. `en_overdrive` of `onewire_bus_rmt_config_t` isn't set
+ */
+esp_err_t onewire_bus_set_speed(onewire_bus_handle_t bus, onewire_bus_speed_t speed);
+
+/**
+ * @brief Switch all overdrive capable devices to overdrive speed and select them, by OVERDRIVE SKIP ROM
+ *
+ * @note A reset pulse and the command are sent at standard speed, then the bus is set to overdrive speed,
+ *       so that the function command and its data follow at overdrive speed. Devices stay at overdrive speed,
+ *       and can be addressed after an overdrive reset pulse, until `onewire_bus_set_speed` sets standard speed back
+ *       and a reset pulse is sent.
+ *
+ * @param[in] bus 1-Wire bus handle
+ * @return
+ *      - ESP_OK: Devices are switched to overdrive speed
+ *      - ESP_ERR_INVALID_ARG: Switch to overdrive failed because of invalid argument
+ *      - ESP_ERR_NOT_FOUND: Switch to overdrive failed because no device answered the reset pulse
+ *      - ESP_ERR_NOT_SUPPORTED: Switch to overdrive failed because overdrive is not enabled by the bus backend
+ *      - ESP_FAIL: Switch to overdrive failed because of other errors
+ */
+esp_err_t onewire_bus_overdrive_skip_rom(onewire_bus_handle_t bus);
+
+/**
+ * @brief Switch a device to overdrive speed and select it, by OVERDRIVE MATCH ROM
+ *
+ * @note A reset pulse and the command are sent at standard speed, the address at overdrive speed.
+ *       The bus is left at overdrive speed, see `onewire_bus_overdrive_skip_rom`.
+ *
+ * @param[in] bus 1-Wire bus handle
+ * @param[in] address Address of the device
+ * @return
+ *      - ESP_OK: The device is switched to overdrive speed
+ *      - ESP_ERR_INVALID_ARG: Switch to overdrive failed because of invalid argument
+ *      - ESP_ERR_NOT_FOUND: Switch to overdrive failed because no device answered the reset pulse
+ *      - ESP_ERR_NOT_SUPPORTED: Switch to overdrive failed because overdrive is not enabled by the bus backend
+ *      - ESP_FAIL: Switch to overdrive failed because of other errors
+ */
+esp_err_t onewire_bus_overdrive_match_rom(onewire_bus_handle_t bus, onewire_device_address_t address);
+
 /**
  * @brief Free 1-Wire bus resources
  *
@@ -19,6 +19,12 @@ extern "C" {
 typedef struct {
     uint32_t max_rx_bytes; /*!< Set the largest possible single receive size,
                                 which determins the size of the internal buffer that used to save the receiving RMT symbols */
+    uint32_t async_task_priority; /*!< Priority of the task executing transactions started by `onewire_bus_transaction_async`,
+                                       set to 0 to use the default priority (5). The task is created by the first asynchronous transaction */
+    struct {
+        uint32_t en_overdrive: 1; /*!< Support overdrive speed, set by `onewire_bus_set_speed`. The RMT channels then run at 10 MHz
+                                       instead of 1 MHz, for the sub-microsecond overdrive timings */
+    } flags; /*!< RMT backend config flags */
 } onewire_bus_rmt_config_t;
 
 /**
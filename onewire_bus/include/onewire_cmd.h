@@ -10,3 +10,5 @@
 #define ONEWIRE_CMD_SKIP_ROM           0xCC
 #define ONEWIRE_CMD_SEARCH_ALARM       0xEC
 #define ONEWIRE_CMD_READ_POWER_SUPPLY  0xB4
+#define ONEWIRE_CMD_OVERDRIVE_SKIP_ROM  0x3C
+#define ONEWIRE_CMD_OVERDRIVE_MATCH_ROM 0x69
@@ -6,6 +6,9 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,6 +29,42 @@ typedef uint64_t onewire_device_address_t;
  */
 typedef struct onewire_device_iter_t *onewire_device_iter_handle_t;
 
+/**
+ * @brief 1-Wire bus transaction, executed by `onewire_bus_transaction`
+ *
+ * Optional reset pulse, then `tx_data` is written and `rx_buf_size` bytes are read to `rx_buf`.
+ */
+typedef struct {
+    bool reset;              /*!< Send reset pulse and check device presence first */
+    const uint8_t *tx_data;  /*!< Data to write, e.g. MATCH ROM command, ROM ID and function command */
+    size_t tx_data_size;     /*!< Size of tx_data, in bytes, can be 0 */
+    uint8_t *rx_buf;         /*!< Buffer to store data read after writing */
+    size_t rx_buf_size;      /*!< Number of bytes to read, can be 0 */
+    esp_err_t result;        /*!< Returned result of this transaction, ESP_ERR_NOT_FOUND if no device presence was detected */
+} onewire_bus_transaction_t;
+
+/**
+ * @brief Callback of transactions started by `onewire_bus_transaction_async`
+ *
+ * @note Called from the task executing transactions of the bus, transactions of the bus are not executed until the callback returns.
+ *
+ * @param[in] bus 1-Wire bus handle
+ * @param[in] trans Executed transactions, with their `result` set
+ * @param[in] num_trans Number of transactions
+ * @param[in] result Same as the return value of `onewire_bus_transaction`
+ * @param[in] user_ctx User context passed to `onewire_bus_transaction_async`
+ */
+typedef void (*onewire_bus_transaction_done_cb_t)(onewire_bus_handle_t bus, onewire_bus_transaction_t *trans, size_t num_trans,
+        esp_err_t result, void *user_ctx);
+
+/**
+ * @brief 1-Wire bus speed
+ */
+typedef enum {
+    ONEWIRE_BUS_SPEED_STANDARD,  /*!< Standard speed, about 15 kbps */
+    ONEWIRE_BUS_SPEED_OVERDRIVE, /*!< Overdrive speed, about 100 kbps, only understood by devices switched to it by an overdrive ROM command */
+} onewire_bus_speed_t;
+
 /**
  * @brief 1-Wire bus configuration
  */
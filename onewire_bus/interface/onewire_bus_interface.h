@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 #include "esp_err.h"
+#include "onewire_types.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,6 +69,21 @@ struct onewire_bus_t {
      */
     esp_err_t (*read_bit)(onewire_bus_handle_t handle, uint8_t *rx_bit);
 
+    /**
+     * @brief Execute search triplets of the ROM search algorithm (optional, `read_bit` and `write_bit` are called if not set)
+     *
+     * @param[in] bus 1-Wire bus handle
+     * @param[in] directions Directions to take at discrepancies, `num_triplets` bits
+     * @param[out] taken Taken directions, `num_triplets` bits
+     * @param[out] discrepancies Set bits mark discrepancies, `num_triplets` bits
+     * @param[in] num_triplets Number of triplets
+     * @return
+     *      - ESP_OK: Execute search triplets successfully
+     *      - ESP_ERR_NOT_FOUND: No devices participated in the search
+     *      - ESP_FAIL: Execute search triplets failed because of other errors
+     */
+    esp_err_t (*search_triplets)(onewire_bus_t *bus, const uint8_t *directions, uint8_t *taken, uint8_t *discrepancies, size_t num_triplets);
+
     /**
      * @brief Send reset pulse to the bus, and check if there are devices attached to the bus
      *
@@ -80,6 +96,45 @@ struct onewire_bus_t {
      */
     esp_err_t (*reset)(onewire_bus_t *bus);
 
+    /**
+     * @brief Execute a sequence of transactions while holding the bus (optional, `reset`, `write_bytes` and `read_bytes` are called if not set)
+     *
+     * @param[in] bus 1-Wire bus handle
+     * @param[inout] trans Array of transactions, their `result` is set
+     * @param[in] num_trans Number of transactions
+     * @return
+     *      - ESP_OK: All transactions were executed
+     *      - ESP_FAIL: Execute transactions failed because of other errors
+     */
+    esp_err_t (*transaction)(onewire_bus_t *bus, onewire_bus_transaction_t *trans, size_t num_trans);
+
+    /**
+     * @brief Start executing a sequence of transactions, call `done_cb` when they are done (optional)
+     *
+     * @param[in] bus 1-Wire bus handle
+     * @param[inout] trans Array of transactions, their `result` is set
+     * @param[in] num_trans Number of transactions
+     * @param[in] done_cb Callback called after the transactions are executed
+     * @param[in] user_ctx User context passed to done_cb
+     * @return
+     *      - ESP_OK: Transactions were queued
+     *      - ESP_ERR_INVALID_STATE: Too many transactions are pending
+     *      - ESP_ERR_NO_MEM: No memory to execute transactions
+     */
+    esp_err_t (*transaction_async)(onewire_bus_t *bus, onewire_bus_transaction_t *trans, size_t num_trans,
+                                   onewire_bus_transaction_done_cb_t done_cb, void *user_ctx);
+
+    /**
+     * @brief Set the speed of the following operations of the bus (optional, only standard speed is supported if not set)
+     *
+     * @param[in] bus 1-Wire bus handle
+     * @param[in] speed Bus speed
+     * @return
+     *      - ESP_OK: Set speed successfully
+     *      - ESP_ERR_NOT_SUPPORTED: The speed is not supported by the bus
+     */
+    esp_err_t (*set_speed)(onewire_bus_t *bus, onewire_bus_speed_t speed);
+
     /**
      * @brief Free 1-Wire bus resources
      *
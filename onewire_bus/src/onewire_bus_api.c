@@ -3,10 +3,12 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <string.h>
 #include "esp_log.h"
 #include "esp_check.h"
 #include "onewire_types.h"
 #include "onewire_bus_interface.h"
+#include "onewire_cmd.h"
 
 static const char *TAG = "1-wire";
 
@@ -40,6 +42,130 @@ esp_err_t onewire_bus_read_bit(onewire_bus_handle_t bus, uint8_t *rx_bit)
     return bus->read_bit(bus, rx_bit);
 }
 
+static esp_err_t onewire_bus_check_transactions(const onewire_bus_transaction_t *trans, size_t num_trans)
+{
+    ESP_RETURN_ON_FALSE(trans || !num_trans, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    for (size_t i = 0; i < num_trans; i++) {
+        ESP_RETURN_ON_FALSE((trans[i].tx_data || !trans[i].tx_data_size) && (trans[i].rx_buf || !trans[i].rx_buf_size),
+                            ESP_ERR_INVALID_ARG, TAG, "invalid transaction %u", (unsigned)i);
+        ESP_RETURN_ON_FALSE(trans[i].tx_data_size <= UINT8_MAX, ESP_ERR_INVALID_ARG, TAG, "transaction %u writes too many bytes", (unsigned)i);
+    }
+    return ESP_OK;
+}
+
+esp_err_t onewire_bus_transaction(onewire_bus_handle_t bus, onewire_bus_transaction_t *trans, size_t num_trans)
+{
+    ESP_RETURN_ON_FALSE(bus, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_ERROR(onewire_bus_check_transactions(trans, num_trans), TAG, "invalid transactions");
+    if (bus->transaction) {
+        return bus->transaction(bus, trans, num_trans);
+    }
+
+    // backend without transaction support, execute them one by one
+    for (size_t i = 0; i < num_trans; i++) {
+        onewire_bus_transaction_t *t = &trans[i];
+        t->result = ESP_OK;
+        if (t->reset) {
+            t->result = bus->reset(bus);
+            if (t->result == ESP_ERR_NOT_FOUND) {
+                continue;
+            }
+            ESP_RETURN_ON_ERROR(t->result, TAG, "reset bus failed");
+        }
+        if (t->tx_data_size) {
+            t->result = bus->write_bytes(bus, t->tx_data, t->tx_data_size);
+            ESP_RETURN_ON_ERROR(t->result, TAG, "write bytes failed");
+        }
+        if (t->rx_buf_size) {
+            t->result = bus->read_bytes(bus, t->rx_buf, t->rx_buf_size);
+            ESP_RETURN_ON_ERROR(t->result, TAG, "read bytes failed");
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t onewire_bus_transaction_async(onewire_bus_handle_t bus, onewire_bus_transaction_t *trans, size_t num_trans,
+                                        onewire_bus_transaction_done_cb_t done_cb, void *user_ctx)
+{
+    ESP_RETURN_ON_FALSE(bus && done_cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_ERROR(onewire_bus_check_transactions(trans, num_trans), TAG, "invalid transactions");
+    ESP_RETURN_ON_FALSE(bus->transaction_async, ESP_ERR_NOT_SUPPORTED, TAG, "asynchronous transactions not supported by backend");
+    return bus->transaction_async(bus, trans, num_trans, done_cb, user_ctx);
+}
+
+esp_err_t onewire_bus_search_triplets(onewire_bus_handle_t bus, const uint8_t *directions, uint8_t *taken, uint8_t *discrepancies,
+                                      size_t num_triplets)
+{
+    ESP_RETURN_ON_FALSE(bus && directions && taken && discrepancies, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    memset(taken, 0, (num_triplets + 7) / 8);
+    memset(discrepancies, 0, (num_triplets + 7) / 8);
+    if (bus->search_triplets) {
+        return bus->search_triplets(bus, directions, taken, discrepancies, num_triplets);
+    }
+
+    // backend without search triplets, read and write bit by bit
+    for (size_t i = 0; i < num_triplets; i++) {
+        const uint8_t mask = 1 << (i % 8);
+        uint8_t id_bit = 0;
+        uint8_t cmp_id_bit = 0;
+        ESP_RETURN_ON_ERROR(bus->read_bit(bus, &id_bit), TAG, "read id bit failed");
+        ESP_RETURN_ON_ERROR(bus->read_bit(bus, &cmp_id_bit), TAG, "read complement id bit failed");
+        if (id_bit && cmp_id_bit) {
+            return ESP_ERR_NOT_FOUND;
+        }
+        uint8_t direction = id_bit;
+        if (id_bit == cmp_id_bit) {
+            discrepancies[i / 8] |= mask;
+            direction = (directions[i / 8] & mask) ? 1 : 0;
+        }
+        if (direction) {
+            taken[i / 8] |= mask;
+        }
+        ESP_RETURN_ON_ERROR(bus->write_bit(bus, direction), TAG, "write direction bit failed");
+    }
+    return ESP_OK;
+}
+
+esp_err_t onewire_bus_set_speed(onewire_bus_handle_t bus, onewire_bus_speed_t speed)
+{
+    ESP_RETURN_ON_FALSE(bus, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (!bus->set_speed) {
+        ESP_RETURN_ON_FALSE(speed == ONEWIRE_BUS_SPEED_STANDARD, ESP_ERR_NOT_SUPPORTED, TAG, "speed not supported by backend");
+        return ESP_OK;
+    }
+    return bus->set_speed(bus, speed);
+}
+
+// Reset pulse and overdrive ROM command at standard speed, then the bus is switched to overdrive speed
+static esp_err_t onewire_bus_overdrive_rom_cmd(onewire_bus_handle_t bus, uint8_t cmd)
+{
+    ESP_RETURN_ON_FALSE(bus, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(bus->set_speed, ESP_ERR_NOT_SUPPORTED, TAG, "overdrive not supported by backend");
+    // check that the bus supports overdrive before the devices are switched to it
+    ESP_RETURN_ON_ERROR(bus->set_speed(bus, ONEWIRE_BUS_SPEED_OVERDRIVE), TAG, "overdrive not supported");
+    ESP_RETURN_ON_ERROR(bus->set_speed(bus, ONEWIRE_BUS_SPEED_STANDARD), TAG, "set standard speed failed");
+    esp_err_t ret = bus->reset(bus);
+    if (ret == ESP_ERR_NOT_FOUND) {
+        return ret;
+    }
+    ESP_RETURN_ON_ERROR(ret, TAG, "reset bus failed");
+    ESP_RETURN_ON_ERROR(bus->write_bytes(bus, &cmd, 1), TAG, "send overdrive ROM command failed");
+    return bus->set_speed(bus, ONEWIRE_BUS_SPEED_OVERDRIVE);
+}
+
+esp_err_t onewire_bus_overdrive_skip_rom(onewire_bus_handle_t bus)
+{
+    return onewire_bus_overdrive_rom_cmd(bus, ONEWIRE_CMD_OVERDRIVE_SKIP_ROM);
+}
+
+esp_err_t onewire_bus_overdrive_match_rom(onewire_bus_handle_t bus, onewire_device_address_t address)
+{
+    ESP_RETURN_ON_ERROR(onewire_bus_overdrive_rom_cmd(bus, ONEWIRE_CMD_OVERDRIVE_MATCH_ROM), TAG, "switch to overdrive failed");
+    uint8_t rom_number[sizeof(onewire_device_address_t)];
+    memcpy(rom_number, &address, sizeof(rom_number));
+    return bus->write_bytes(bus, rom_number, sizeof(rom_number));
+}
+
 esp_err_t onewire_bus_del(onewire_bus_handle_t bus)
 {
     ESP_RETURN_ON_FALSE(bus, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <string.h>
+#include <sys/param.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
@@ -17,7 +18,11 @@
 static const char *TAG = "1-wire.rmt";
 
 #define ONEWIRE_RMT_RESOLUTION_HZ               1000000 // RMT channel default resolution for 1-wire bus, 1MHz, 1tick = 1us
+#define ONEWIRE_RMT_OVERDRIVE_RESOLUTION_HZ     10000000 // RMT channel resolution if overdrive is enabled, 10MHz, 1tick = 0.1us
 #define ONEWIRE_RMT_DEFAULT_TRANS_QUEUE_SIZE    4
+#define ONEWIRE_RMT_ASYNC_QUEUE_SIZE            4
+#define ONEWIRE_RMT_ASYNC_TASK_STACK_SIZE       3072
+#define ONEWIRE_RMT_ASYNC_TASK_PRIORITY         5
 
 // the memory size of each RMT channel, in words (4 bytes)
 #if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
@@ -107,71 +112,139 @@ Read 0 bit:
 // refer to https://www.maximintegrated.com/en/design/technical-documents/app-notes/3/3829.html for more information
 #define ONEWIRE_SLOT_RECOVERY_DURATION          2  // recovery time between each bit, should be longer in parasite power mode
 #define ONEWIRE_SLOT_BIT_SAMPLE_TIME            15 // how long after bit start pulse should the master sample from the bus
+#define ONEWIRE_GLITCH_DURATION                 1  // shorter pulses are ignored by the receiver
+
+// overdrive timings, in ns, refer to https://www.analog.com/en/resources/technical-articles/1wire-communication-through-software.html
+#define ONEWIRE_OVERDRIVE_RESET_PULSE_DURATION_NS               70000
+#define ONEWIRE_OVERDRIVE_RESET_WAIT_DURATION_NS                48500
+#define ONEWIRE_OVERDRIVE_RESET_PRESENCE_WAIT_DURATION_MIN_NS   1000
+#define ONEWIRE_OVERDRIVE_RESET_PRESENCE_DURATION_MIN_NS        7000
+#define ONEWIRE_OVERDRIVE_SLOT_START_DURATION_NS                1000
+#define ONEWIRE_OVERDRIVE_SLOT_BIT_DURATION_NS                  6500
+#define ONEWIRE_OVERDRIVE_SLOT_RECOVERY_DURATION_NS             2500
+#define ONEWIRE_OVERDRIVE_SLOT_BIT_SAMPLE_TIME_NS               2000
+#define ONEWIRE_OVERDRIVE_GLITCH_DURATION_NS                    200
+
+// Timings of a bus speed, in ns
+typedef struct {
+    uint32_t reset_pulse;
+    uint32_t reset_wait;
+    uint32_t reset_presence_wait_min;
+    uint32_t reset_presence_min;
+    uint32_t slot_start;
+    uint32_t slot_bit;
+    uint32_t slot_recovery;
+    uint32_t slot_bit_sample_time;
+    uint32_t glitch;
+} onewire_rmt_timing_t;
+
+static const onewire_rmt_timing_t onewire_rmt_timings[] = {
+    [ONEWIRE_BUS_SPEED_STANDARD] = {
+        .reset_pulse = ONEWIRE_RESET_PULSE_DURATION * 1000,
+        .reset_wait = ONEWIRE_RESET_WAIT_DURATION * 1000,
+        .reset_presence_wait_min = ONEWIRE_RESET_PRESENCE_WAIT_DURATION_MIN * 1000,
+        .reset_presence_min = ONEWIRE_RESET_PRESENCE_DURATION_MIN * 1000,
+        .slot_start = ONEWIRE_SLOT_START_DURATION * 1000,
+        .slot_bit = ONEWIRE_SLOT_BIT_DURATION * 1000,
+        .slot_recovery = ONEWIRE_SLOT_RECOVERY_DURATION * 1000,
+        .slot_bit_sample_time = ONEWIRE_SLOT_BIT_SAMPLE_TIME * 1000,
+        .glitch = ONEWIRE_GLITCH_DURATION * 1000,
+    },
+    [ONEWIRE_BUS_SPEED_OVERDRIVE] = {
+        .reset_pulse = ONEWIRE_OVERDRIVE_RESET_PULSE_DURATION_NS,
+        .reset_wait = ONEWIRE_OVERDRIVE_RESET_WAIT_DURATION_NS,
+        .reset_presence_wait_min = ONEWIRE_OVERDRIVE_RESET_PRESENCE_WAIT_DURATION_MIN_NS,
+        .reset_presence_min = ONEWIRE_OVERDRIVE_RESET_PRESENCE_DURATION_MIN_NS,
+        .slot_start = ONEWIRE_OVERDRIVE_SLOT_START_DURATION_NS,
+        .slot_bit = ONEWIRE_OVERDRIVE_SLOT_BIT_DURATION_NS,
+        .slot_recovery = ONEWIRE_OVERDRIVE_SLOT_RECOVERY_DURATION_NS,
+        .slot_bit_sample_time = ONEWIRE_OVERDRIVE_SLOT_BIT_SAMPLE_TIME_NS,
+        .glitch = ONEWIRE_OVERDRIVE_GLITCH_DURATION_NS,
+    },
+};
+
+// Symbols, thresholds (in RMT ticks) and encoders of a bus speed, built from its timings at the resolution of the channels
+typedef struct {
+    rmt_symbol_word_t reset_pulse_symbol;
+    rmt_symbol_word_t bit0_symbol;
+    rmt_symbol_word_t bit1_symbol;
+    rmt_symbol_word_t read_slot_symbols[8]; /*!< read slots generated by the write/read encoder, a byte at once */
+    uint32_t reset_presence_wait_min;
+    uint32_t reset_presence_min;
+    uint32_t slot_bit_sample_time;
+    rmt_receive_config_t rx_config; /*!< receiving a reset pulse */
+    rmt_receive_config_t rx_slots_config; /*!< receiving bit slots only (no reset pulse) */
+    rmt_encoder_handle_t bytes_encoder; /*!< used to encode commands and data */
+    rmt_encoder_handle_t write_read_encoder; /*!< used to encode written bytes followed by read slots */
+} onewire_rmt_speed_t;
+
+// Data of the write/read encoder: bytes to write, followed by read slots
+typedef struct {
+    const uint8_t *tx_data; /*!< bytes to write before the read slots */
+    size_t tx_data_size; /*!< size of tx_data, in bytes */
+    size_t num_read_slots; /*!< number of read slots, one per bit to read */
+} onewire_rmt_write_read_t;
+
+typedef struct {
+    rmt_encoder_t base; /*!< base class */
+    rmt_encoder_handle_t bytes_encoder; /*!< encodes written bytes */
+    rmt_encoder_handle_t copy_encoder; /*!< encodes read slots */
+    const rmt_symbol_word_t *read_slot_symbols; /*!< 8 read slots */
+    int state; /*!< 0: writing bytes, 1: generating read slots */
+    size_t read_slots_done; /*!< number of read slots encoded so far */
+} onewire_rmt_write_read_encoder_t;
 
 typedef struct {
     onewire_bus_t base; /*!< base class */
     rmt_channel_handle_t tx_channel; /*!< rmt tx channel handler */
     rmt_channel_handle_t rx_channel; /*!< rmt rx channel handler */
 
-    rmt_encoder_handle_t tx_bytes_encoder; /*!< used to encode commands and data */
     rmt_encoder_handle_t tx_copy_encoder; /*!< used to encode reset pulse and bits */
+    onewire_rmt_speed_t speeds[2]; /*!< indexed by onewire_bus_speed_t, overdrive is only built if enabled */
+    const onewire_rmt_speed_t *speed; /*!< current speed, changed with bus_mutex taken */
+    onewire_rmt_write_read_t tx_write_read; /*!< data of the write/read encoder, must live until the transmission is done */
 
     rmt_symbol_word_t *rx_symbols_buf; /*!< hold rmt raw symbols */
+    uint8_t *rx_dest; /*!< read bytes are decoded here by the rx done callback, if not NULL */
+    size_t rx_dest_size; /*!< size of rx_dest, in bytes */
+    size_t rx_skip_symbols; /*!< received symbols of written bytes, skipped before decoding */
 
     size_t max_rx_bytes; /*!< buffer size in byte for single receive transaction */
 
     QueueHandle_t receive_queue;
     SemaphoreHandle_t bus_mutex;
-} onewire_bus_rmt_obj_t;
-
-const static rmt_symbol_word_t onewire_reset_pulse_symbol = {
-    .level0 = 0,
-    .duration0 = ONEWIRE_RESET_PULSE_DURATION,
-    .level1 = 1,
-    .duration1 = ONEWIRE_RESET_WAIT_DURATION
-};
 
-const static rmt_symbol_word_t onewire_bit0_symbol = {
-    .level0 = 0,
-    .duration0 = ONEWIRE_SLOT_START_DURATION + ONEWIRE_SLOT_BIT_DURATION,
-    .level1 = 1,
-    .duration1 = ONEWIRE_SLOT_RECOVERY_DURATION
-};
+    uint32_t async_task_priority; /*!< priority of the task executing asynchronous transactions */
+    QueueHandle_t async_queue; /*!< pending asynchronous transactions, created with the task by the first one */
+    SemaphoreHandle_t async_task_stopped;
+} onewire_bus_rmt_obj_t;
 
-const static rmt_symbol_word_t onewire_bit1_symbol = {
-    .level0 = 0,
-    .duration0 = ONEWIRE_SLOT_START_DURATION,
-    .level1 = 1,
-    .duration1 = ONEWIRE_SLOT_BIT_DURATION + ONEWIRE_SLOT_RECOVERY_DURATION
-};
+typedef struct {
+    onewire_bus_transaction_t *trans;
+    size_t num_trans;
+    onewire_bus_transaction_done_cb_t done_cb; /*!< NULL to stop the task */
+    void *user_ctx;
+} onewire_bus_rmt_async_req_t;
 
 const static rmt_transmit_config_t onewire_rmt_tx_config = {
     .loop_count = 0,     // no transfer loop
     .flags.eot_level = 1 // onewire bus should be released in IDLE
 };
 
-const static rmt_receive_config_t onewire_rmt_rx_config = {
-    .signal_range_min_ns = 1000000000 / ONEWIRE_RMT_RESOLUTION_HZ,
-    .signal_range_max_ns = (ONEWIRE_RESET_PULSE_DURATION + ONEWIRE_RESET_WAIT_DURATION) * 1000,
-};
-
 static esp_err_t onewire_bus_rmt_read_bit(onewire_bus_handle_t bus, uint8_t *rx_bit);
 static esp_err_t onewire_bus_rmt_write_bit(onewire_bus_handle_t bus, uint8_t tx_bit);
 static esp_err_t onewire_bus_rmt_read_bytes(onewire_bus_handle_t bus, uint8_t *rx_buf, size_t rx_buf_size);
 static esp_err_t onewire_bus_rmt_write_bytes(onewire_bus_handle_t bus, const uint8_t *tx_data, uint8_t tx_data_size);
 static esp_err_t onewire_bus_rmt_reset(onewire_bus_handle_t bus);
+static esp_err_t onewire_bus_rmt_search_triplets(onewire_bus_handle_t bus, const uint8_t *directions, uint8_t *taken,
+        uint8_t *discrepancies, size_t num_triplets);
+static esp_err_t onewire_bus_rmt_transaction(onewire_bus_handle_t bus, onewire_bus_transaction_t *trans, size_t num_trans);
+static esp_err_t onewire_bus_rmt_transaction_async(onewire_bus_handle_t bus, onewire_bus_transaction_t *trans, size_t num_trans,
+        onewire_bus_transaction_done_cb_t done_cb, void *user_ctx);
+static esp_err_t onewire_bus_rmt_set_speed(onewire_bus_handle_t bus, onewire_bus_speed_t speed);
 static esp_err_t onewire_bus_rmt_del(onewire_bus_handle_t bus);
 static esp_err_t onewire_bus_rmt_destroy(onewire_bus_rmt_obj_t *bus_rmt);
 
-static bool onewire_rmt_rx_done_callback(rmt_channel_handle_t channel, const rmt_rx_done_event_data_t *edata, void *user_data)
-{
-    BaseType_t task_woken = pdFALSE;
-    onewire_bus_rmt_obj_t *bus_rmt = (onewire_bus_rmt_obj_t *)user_data;
-
-    xQueueSendFromISR(bus_rmt->receive_queue, edata, &task_woken);
-
-    return task_woken;
-}
 
 /*
 [0].0 means symbol[0].duration0
@@ -203,18 +276,18 @@ after init  | Pulse |      | Presence |
 
               [0].0  [0].1     [1].0    [1].1
 */
-static bool onewire_rmt_check_presence_pulse(rmt_symbol_word_t *rmt_symbols, size_t symbol_num)
+static bool onewire_rmt_check_presence_pulse(const onewire_rmt_speed_t *speed, rmt_symbol_word_t *rmt_symbols, size_t symbol_num)
 {
     bool ret = false;
     if (symbol_num >= 2) { // there should be at lease 2 symbols(3 or 4 edges)
         if (rmt_symbols[0].level1 == 1) { // bus is high before reset pulse
-            if (rmt_symbols[0].duration1 > ONEWIRE_RESET_PRESENCE_WAIT_DURATION_MIN &&
-                    rmt_symbols[1].duration0 > ONEWIRE_RESET_PRESENCE_DURATION_MIN) {
+            if (rmt_symbols[0].duration1 > speed->reset_presence_wait_min &&
+                    rmt_symbols[1].duration0 > speed->reset_presence_min) {
                 ret = true;
             }
         } else { // bus is low before reset pulse(first pulse after rmt channel init)
-            if (rmt_symbols[0].duration0 > ONEWIRE_RESET_PRESENCE_WAIT_DURATION_MIN &&
-                    rmt_symbols[1].duration1 > ONEWIRE_RESET_PRESENCE_DURATION_MIN) {
+            if (rmt_symbols[0].duration0 > speed->reset_presence_wait_min &&
+                    rmt_symbols[1].duration1 > speed->reset_presence_min) {
                 ret = true;
             }
         }
@@ -222,25 +295,187 @@ static bool onewire_rmt_check_presence_pulse(rmt_symbol_word_t *rmt_symbols, siz
     return ret;
 }
 
-static void onewire_rmt_decode_data(rmt_symbol_word_t *rmt_symbols, size_t symbol_num, uint8_t *rx_buf, size_t rx_buf_size)
+// Decode read slots to bytes, LSB first, returns the number of decoded bits
+static size_t onewire_rmt_decode_data(const onewire_rmt_speed_t *speed, const rmt_symbol_word_t *rmt_symbols, size_t symbol_num,
+                                      uint8_t *rx_buf, size_t rx_buf_size)
 {
-    size_t byte_pos = 0;
-    size_t bit_pos = 0;
-    for (size_t i = 0; i < symbol_num; i ++) {
-        if (rmt_symbols[i].duration0 > ONEWIRE_SLOT_BIT_SAMPLE_TIME) { // 0 bit
-            rx_buf[byte_pos] &= ~(1 << bit_pos); // LSB first
-        } else { // 1 bit
-            rx_buf[byte_pos] |= 1 << bit_pos;
+    const size_t num_bits = MIN(symbol_num, rx_buf_size * 8);
+    uint8_t byte = 0;
+    for (size_t i = 0; i < num_bits; i ++) {
+        if (rmt_symbols[i].duration0 <= speed->slot_bit_sample_time) { // 1 bit, 0 bit is pulled down by device
+            byte |= 1 << (i % 8);
+        }
+        if (i % 8 == 7 || i == num_bits - 1) {
+            rx_buf[i / 8] = byte;
+            byte = 0;
         }
-        bit_pos ++;
-        if (bit_pos >= 8) {
-            bit_pos = 0;
-            byte_pos ++;
-            if (byte_pos >= rx_buf_size) {
-                break;
+    }
+    return num_bits;
+}
+
+static bool onewire_rmt_rx_done_callback(rmt_channel_handle_t channel, const rmt_rx_done_event_data_t *edata, void *user_data)
+{
+    BaseType_t task_woken = pdFALSE;
+    onewire_bus_rmt_obj_t *bus_rmt = (onewire_bus_rmt_obj_t *)user_data;
+
+    // decode read bytes right to the destination, the task only checks the number of received symbols
+    if (bus_rmt->rx_dest && edata->num_symbols > bus_rmt->rx_skip_symbols) {
+        onewire_rmt_decode_data(bus_rmt->speed, edata->received_symbols + bus_rmt->rx_skip_symbols, edata->num_symbols - bus_rmt->rx_skip_symbols,
+                                bus_rmt->rx_dest, bus_rmt->rx_dest_size);
+    }
+    xQueueSendFromISR(bus_rmt->receive_queue, edata, &task_woken);
+
+    return task_woken;
+}
+
+static size_t onewire_rmt_encode_write_read(rmt_encoder_t *encoder, rmt_channel_handle_t channel, const void *primary_data,
+        size_t data_size, rmt_encode_state_t *ret_state)
+{
+    onewire_rmt_write_read_encoder_t *write_read_encoder = __containerof(encoder, onewire_rmt_write_read_encoder_t, base);
+    const onewire_rmt_write_read_t *write_read = (const onewire_rmt_write_read_t *)primary_data;
+    rmt_encode_state_t session_state = RMT_ENCODING_RESET;
+    rmt_encode_state_t state = RMT_ENCODING_RESET;
+    size_t encoded_symbols = 0;
+
+    switch (write_read_encoder->state) {
+    case 0: // write bytes
+        if (write_read->tx_data_size) {
+            rmt_encoder_handle_t bytes_encoder = write_read_encoder->bytes_encoder;
+            encoded_symbols += bytes_encoder->encode(bytes_encoder, channel, write_read->tx_data, write_read->tx_data_size, &session_state);
+            if (session_state & RMT_ENCODING_COMPLETE) {
+                write_read_encoder->state = 1; // switch to next state when current encoding session finished
+            }
+            if (session_state & RMT_ENCODING_MEM_FULL) {
+                state |= RMT_ENCODING_MEM_FULL;
+                goto out; // yield if there's no free space for encoding artifacts
             }
         }
+        write_read_encoder->state = 1;
+    // fall-through
+    case 1: // read slots, a byte at once
+        while (write_read_encoder->read_slots_done < write_read->num_read_slots) {
+            rmt_encoder_handle_t copy_encoder = write_read_encoder->copy_encoder;
+            const size_t num_slots = MIN(write_read->num_read_slots - write_read_encoder->read_slots_done, 8);
+            session_state = RMT_ENCODING_RESET;
+            encoded_symbols += copy_encoder->encode(copy_encoder, channel, write_read_encoder->read_slot_symbols,
+                                                    num_slots * sizeof(rmt_symbol_word_t), &session_state);
+            if (session_state & RMT_ENCODING_COMPLETE) {
+                write_read_encoder->read_slots_done += num_slots;
+            }
+            if (session_state & RMT_ENCODING_MEM_FULL) {
+                state |= RMT_ENCODING_MEM_FULL;
+                goto out; // yield if there's no free space for encoding artifacts
+            }
+        }
+        write_read_encoder->state = 0; // back to the initial encoding session
+        write_read_encoder->read_slots_done = 0;
+        state |= RMT_ENCODING_COMPLETE;
     }
+out:
+    *ret_state = state;
+    return encoded_symbols;
+}
+
+static esp_err_t onewire_rmt_del_write_read_encoder(rmt_encoder_t *encoder)
+{
+    onewire_rmt_write_read_encoder_t *write_read_encoder = __containerof(encoder, onewire_rmt_write_read_encoder_t, base);
+    rmt_del_encoder(write_read_encoder->bytes_encoder);
+    rmt_del_encoder(write_read_encoder->copy_encoder);
+    free(write_read_encoder);
+    return ESP_OK;
+}
+
+static esp_err_t onewire_rmt_write_read_encoder_reset(rmt_encoder_t *encoder)
+{
+    onewire_rmt_write_read_encoder_t *write_read_encoder = __containerof(encoder, onewire_rmt_write_read_encoder_t, base);
+    rmt_encoder_reset(write_read_encoder->bytes_encoder);
+    rmt_encoder_reset(write_read_encoder->copy_encoder);
+    write_read_encoder->state = 0;
+    write_read_encoder->read_slots_done = 0;
+    return ESP_OK;
+}
+
+// Encoder writing bytes followed by read slots, which are generated without a buffer of 0xFF bytes
+static esp_err_t onewire_rmt_new_write_read_encoder(const rmt_bytes_encoder_config_t *bytes_encoder_config,
+        const rmt_symbol_word_t *read_slot_symbols, rmt_encoder_handle_t *ret_encoder)
+{
+    esp_err_t ret = ESP_OK;
+    onewire_rmt_write_read_encoder_t *write_read_encoder = calloc(1, sizeof(onewire_rmt_write_read_encoder_t));
+    ESP_RETURN_ON_FALSE(write_read_encoder, ESP_ERR_NO_MEM, TAG, "no mem for write/read encoder");
+    write_read_encoder->base.encode = onewire_rmt_encode_write_read;
+    write_read_encoder->base.del = onewire_rmt_del_write_read_encoder;
+    write_read_encoder->base.reset = onewire_rmt_write_read_encoder_reset;
+    write_read_encoder->read_slot_symbols = read_slot_symbols;
+
+    ESP_GOTO_ON_ERROR(rmt_new_bytes_encoder(bytes_encoder_config, &write_read_encoder->bytes_encoder), err, TAG, "create bytes encoder failed");
+    rmt_copy_encoder_config_t copy_encoder_config = {};
+    ESP_GOTO_ON_ERROR(rmt_new_copy_encoder(&copy_encoder_config, &write_read_encoder->copy_encoder), err, TAG, "create copy encoder failed");
+
+    *ret_encoder = &write_read_encoder->base;
+    return ESP_OK;
+err:
+    if (write_read_encoder->bytes_encoder) {
+        rmt_del_encoder(write_read_encoder->bytes_encoder);
+    }
+    free(write_read_encoder);
+    return ret;
+}
+
+static uint32_t onewire_rmt_ns_to_ticks(uint32_t ns, uint32_t resolution_hz)
+{
+    return (uint64_t)ns * resolution_hz / 1000000000;
+}
+
+// Build the symbols and encoders of a speed from its timings
+static esp_err_t onewire_rmt_init_speed(onewire_rmt_speed_t *speed, const onewire_rmt_timing_t *timing, uint32_t resolution_hz)
+{
+    speed->reset_pulse_symbol = (rmt_symbol_word_t) {
+        .level0 = 0,
+        .duration0 = onewire_rmt_ns_to_ticks(timing->reset_pulse, resolution_hz),
+        .level1 = 1,
+        .duration1 = onewire_rmt_ns_to_ticks(timing->reset_wait, resolution_hz),
+    };
+    speed->bit0_symbol = (rmt_symbol_word_t) {
+        .level0 = 0,
+        .duration0 = onewire_rmt_ns_to_ticks(timing->slot_start + timing->slot_bit, resolution_hz),
+        .level1 = 1,
+        .duration1 = onewire_rmt_ns_to_ticks(timing->slot_recovery, resolution_hz),
+    };
+    speed->bit1_symbol = (rmt_symbol_word_t) {
+        .level0 = 0,
+        .duration0 = onewire_rmt_ns_to_ticks(timing->slot_start, resolution_hz),
+        .level1 = 1,
+        .duration1 = onewire_rmt_ns_to_ticks(timing->slot_bit + timing->slot_recovery, resolution_hz),
+    };
+    for (int i = 0; i < 8; i++) {
+        speed->read_slot_symbols[i] = speed->bit1_symbol;
+    }
+    speed->reset_presence_wait_min = onewire_rmt_ns_to_ticks(timing->reset_presence_wait_min, resolution_hz);
+    speed->reset_presence_min = onewire_rmt_ns_to_ticks(timing->reset_presence_min, resolution_hz);
+    speed->slot_bit_sample_time = onewire_rmt_ns_to_ticks(timing->slot_bit_sample_time, resolution_hz);
+
+    speed->rx_config = (rmt_receive_config_t) {
+        .signal_range_min_ns = timing->glitch,
+        .signal_range_max_ns = timing->reset_pulse + timing->reset_wait,
+    };
+    // the bus is idle once a level lasts longer than two slots
+    speed->rx_slots_config = (rmt_receive_config_t) {
+        .signal_range_min_ns = timing->glitch,
+        .signal_range_max_ns = (timing->slot_start + timing->slot_bit + timing->slot_recovery) * 2,
+    };
+
+    // create rmt bytes encoder to transmit 1-wire commands and data
+    rmt_bytes_encoder_config_t bytes_encoder_config = {
+        .bit0 = speed->bit0_symbol,
+        .bit1 = speed->bit1_symbol,
+        .flags.msb_first = 0,
+    };
+    ESP_RETURN_ON_ERROR(rmt_new_bytes_encoder(&bytes_encoder_config, &speed->bytes_encoder), TAG, "create bytes encoder failed");
+
+    // create encoder to transmit 1-wire data followed by read slots
+    ESP_RETURN_ON_ERROR(onewire_rmt_new_write_read_encoder(&bytes_encoder_config, speed->read_slot_symbols, &speed->write_read_encoder),
+                        TAG, "create write/read encoder failed");
+    return ESP_OK;
 }
 
 esp_err_t onewire_new_bus_rmt(const onewire_bus_config_t *bus_config, const onewire_bus_rmt_config_t *rmt_config, onewire_bus_handle_t *ret_bus)
@@ -252,14 +487,15 @@ esp_err_t onewire_new_bus_rmt(const onewire_bus_config_t *bus_config, const onew
     bus_rmt = calloc(1, sizeof(onewire_bus_rmt_obj_t));
     ESP_RETURN_ON_FALSE(bus_rmt, ESP_ERR_NO_MEM, TAG, "no mem for onewire_bus_rmt_obj_t");
 
-    // create rmt bytes encoder to transmit 1-wire commands and data
-    rmt_bytes_encoder_config_t bytes_encoder_config = {
-        .bit0 = onewire_bit0_symbol,
-        .bit1 = onewire_bit1_symbol,
-        .flags.msb_first = 0,
-    };
-    ESP_GOTO_ON_ERROR(rmt_new_bytes_encoder(&bytes_encoder_config, &bus_rmt->tx_bytes_encoder),
-                      err, TAG, "create bytes encoder failed");
+    // overdrive timings need a finer resolution, which can't be changed once the channels are created
+    const uint32_t resolution_hz = rmt_config->flags.en_overdrive ? ONEWIRE_RMT_OVERDRIVE_RESOLUTION_HZ : ONEWIRE_RMT_RESOLUTION_HZ;
+    ESP_GOTO_ON_ERROR(onewire_rmt_init_speed(&bus_rmt->speeds[ONEWIRE_BUS_SPEED_STANDARD], &onewire_rmt_timings[ONEWIRE_BUS_SPEED_STANDARD], resolution_hz),
+                      err, TAG, "init standard speed failed");
+    if (rmt_config->flags.en_overdrive) {
+        ESP_GOTO_ON_ERROR(onewire_rmt_init_speed(&bus_rmt->speeds[ONEWIRE_BUS_SPEED_OVERDRIVE], &onewire_rmt_timings[ONEWIRE_BUS_SPEED_OVERDRIVE], resolution_hz),
+                          err, TAG, "init overdrive speed failed");
+    }
+    bus_rmt->speed = &bus_rmt->speeds[ONEWIRE_BUS_SPEED_STANDARD];
 
     // create rmt copy encoder to transmit 1-wire reset pulse or bits
     rmt_copy_encoder_config_t copy_encoder_config = {};
@@ -269,7 +505,7 @@ esp_err_t onewire_new_bus_rmt(const onewire_bus_config_t *bus_config, const onew
     // Note: must create rmt rx channel before tx channel
     rmt_rx_channel_config_t onewire_rx_channel_cfg = {
         .clk_src = RMT_CLK_SRC_DEFAULT,
-        .resolution_hz = ONEWIRE_RMT_RESOLUTION_HZ,
+        .resolution_hz = resolution_hz,
         .gpio_num = bus_config->bus_gpio_num,
         .mem_block_symbols = ONEWIRE_RMT_RX_MEM_BLOCK_SIZE,
     };
@@ -279,7 +515,7 @@ esp_err_t onewire_new_bus_rmt(const onewire_bus_config_t *bus_config, const onew
     // create rmt tx channel
     rmt_tx_channel_config_t onewire_tx_channel_cfg = {
         .clk_src = RMT_CLK_SRC_DEFAULT,
-        .resolution_hz = ONEWIRE_RMT_RESOLUTION_HZ,
+        .resolution_hz = resolution_hz,
         .gpio_num = bus_config->bus_gpio_num,
         .mem_block_symbols = ONEWIRE_RMT_DEFAULT_MEM_BLOCK_SYMBOLS,
         .trans_queue_depth = ONEWIRE_RMT_DEFAULT_TRANS_QUEUE_SIZE,
@@ -293,6 +529,7 @@ esp_err_t onewire_new_bus_rmt(const onewire_bus_config_t *bus_config, const onew
     bus_rmt->rx_symbols_buf = malloc(rmt_config->max_rx_bytes * sizeof(rmt_symbol_word_t) * 8);
     ESP_GOTO_ON_FALSE(bus_rmt->rx_symbols_buf, ESP_ERR_NO_MEM, err, TAG, "no mem to store received RMT symbols");
     bus_rmt->max_rx_bytes = rmt_config->max_rx_bytes;
+    bus_rmt->async_task_priority = rmt_config->async_task_priority ? rmt_config->async_task_priority : ONEWIRE_RMT_ASYNC_TASK_PRIORITY;
 
     bus_rmt->receive_queue = xQueueCreate(1, sizeof(rmt_rx_done_event_data_t));
     ESP_GOTO_ON_FALSE(bus_rmt->receive_queue, ESP_ERR_NO_MEM, err, TAG, "receive queue creation failed");
@@ -327,6 +564,10 @@ esp_err_t onewire_new_bus_rmt(const onewire_bus_config_t *bus_config, const onew
     bus_rmt->base.write_bytes = onewire_bus_rmt_write_bytes;
     bus_rmt->base.read_bit = onewire_bus_rmt_read_bit;
     bus_rmt->base.read_bytes = onewire_bus_rmt_read_bytes;
+    bus_rmt->base.search_triplets = onewire_bus_rmt_search_triplets;
+    bus_rmt->base.transaction = onewire_bus_rmt_transaction;
+    bus_rmt->base.transaction_async = onewire_bus_rmt_transaction_async;
+    bus_rmt->base.set_speed = onewire_bus_rmt_set_speed;
     *ret_bus = &bus_rmt->base;
 
     return ret;
@@ -341,8 +582,21 @@ err:
 
 static esp_err_t onewire_bus_rmt_destroy(onewire_bus_rmt_obj_t *bus_rmt)
 {
-    if (bus_rmt->tx_bytes_encoder) {
-        rmt_del_encoder(bus_rmt->tx_bytes_encoder);
+    if (bus_rmt->async_queue) {
+        // pending transactions are executed before the task stops
+        const onewire_bus_rmt_async_req_t stop_req = {};
+        xQueueSend(bus_rmt->async_queue, &stop_req, portMAX_DELAY);
+        xSemaphoreTake(bus_rmt->async_task_stopped, portMAX_DELAY);
+        vQueueDelete(bus_rmt->async_queue);
+        vSemaphoreDelete(bus_rmt->async_task_stopped);
+    }
+    for (int i = 0; i < 2; i++) {
+        if (bus_rmt->speeds[i].bytes_encoder) {
+            rmt_del_encoder(bus_rmt->speeds[i].bytes_encoder);
+        }
+        if (bus_rmt->speeds[i].write_read_encoder) {
+            rmt_del_encoder(bus_rmt->speeds[i].write_read_encoder);
+        }
     }
     if (bus_rmt->tx_copy_encoder) {
         rmt_del_encoder(bus_rmt->tx_copy_encoder);
@@ -374,27 +628,76 @@ static esp_err_t onewire_bus_rmt_del(onewire_bus_handle_t bus)
     return onewire_bus_rmt_destroy(bus_rmt);
 }
 
-static esp_err_t onewire_bus_rmt_reset(onewire_bus_handle_t bus)
-{
-    onewire_bus_rmt_obj_t *bus_rmt = __containerof(bus, onewire_bus_rmt_obj_t, base);
-    esp_err_t ret = ESP_OK;
+// the following functions are called with bus_mutex taken
 
-    xSemaphoreTake(bus_rmt->bus_mutex, portMAX_DELAY);
+static esp_err_t onewire_bus_rmt_do_reset(onewire_bus_rmt_obj_t *bus_rmt)
+{
     // send reset pulse while receive presence pulse
-    ESP_GOTO_ON_ERROR(rmt_receive(bus_rmt->rx_channel, bus_rmt->rx_symbols_buf, sizeof(rmt_symbol_word_t) * 2, &onewire_rmt_rx_config),
-                      err, TAG, "1-wire reset pulse receive failed");
-    ESP_GOTO_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->tx_copy_encoder, &onewire_reset_pulse_symbol, sizeof(onewire_reset_pulse_symbol), &onewire_rmt_tx_config),
-                      err, TAG, "1-wire reset pulse transmit failed");
+    const onewire_rmt_speed_t *speed = bus_rmt->speed;
+    ESP_RETURN_ON_ERROR(rmt_receive(bus_rmt->rx_channel, bus_rmt->rx_symbols_buf, sizeof(rmt_symbol_word_t) * 2, &speed->rx_config),
+                        TAG, "1-wire reset pulse receive failed");
+    ESP_RETURN_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->tx_copy_encoder, &speed->reset_pulse_symbol, sizeof(speed->reset_pulse_symbol), &onewire_rmt_tx_config),
+                        TAG, "1-wire reset pulse transmit failed");
 
     // wait and check presence pulse
     rmt_rx_done_event_data_t rmt_rx_evt_data;
-    ESP_GOTO_ON_FALSE(xQueueReceive(bus_rmt->receive_queue, &rmt_rx_evt_data, pdMS_TO_TICKS(1000)) == pdPASS,
-                      ESP_ERR_TIMEOUT, err, TAG, "1-wire reset pulse receive timeout");
-    if (onewire_rmt_check_presence_pulse(rmt_rx_evt_data.received_symbols, rmt_rx_evt_data.num_symbols) == false) {
-        ret = ESP_ERR_NOT_FOUND;
+    ESP_RETURN_ON_FALSE(xQueueReceive(bus_rmt->receive_queue, &rmt_rx_evt_data, pdMS_TO_TICKS(1000)) == pdPASS,
+                        ESP_ERR_TIMEOUT, TAG, "1-wire reset pulse receive timeout");
+    if (onewire_rmt_check_presence_pulse(speed, rmt_rx_evt_data.received_symbols, rmt_rx_evt_data.num_symbols) == false) {
+        return ESP_ERR_NOT_FOUND;
     }
+    return ESP_OK;
+}
+
+static esp_err_t onewire_bus_rmt_do_write_bytes(onewire_bus_rmt_obj_t *bus_rmt, const uint8_t *tx_data, size_t tx_data_size)
+{
+    // transmit data with the bytes encoder
+    ESP_RETURN_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->speed->bytes_encoder, tx_data, tx_data_size, &onewire_rmt_tx_config),
+                        TAG, "1-wire data transmit failed");
+    // wait the transmission to complete
+    ESP_RETURN_ON_ERROR(rmt_tx_wait_all_done(bus_rmt->tx_channel, 50), TAG, "wait for 1-wire data transmit failed");
+    return ESP_OK;
+}
+
+// Write tx_data, followed by read slots to receive rx_buf_size bytes, in one RMT transaction.
+// Every slot is a single low pulse, so the received symbols of the written bytes are simply skipped.
+static esp_err_t onewire_bus_rmt_do_write_read(onewire_bus_rmt_obj_t *bus_rmt, const uint8_t *tx_data, size_t tx_data_size,
+        uint8_t *rx_buf, size_t rx_buf_size)
+{
+    esp_err_t ret = ESP_OK;
+    const size_t num_symbols = (tx_data_size + rx_buf_size) * 8;
+    bus_rmt->tx_write_read = (onewire_rmt_write_read_t) {
+        .tx_data = tx_data,
+        .tx_data_size = tx_data_size,
+        .num_read_slots = rx_buf_size * 8,
+    };
+    bus_rmt->rx_dest = rx_buf;
+    bus_rmt->rx_dest_size = rx_buf_size;
+    bus_rmt->rx_skip_symbols = tx_data_size * 8;
+
+    // transmit read slots while receiving, the data is decoded by the rx done callback
+    ESP_GOTO_ON_ERROR(rmt_receive(bus_rmt->rx_channel, bus_rmt->rx_symbols_buf, num_symbols * sizeof(rmt_symbol_word_t), &bus_rmt->speed->rx_slots_config),
+                      err, TAG, "1-wire data receive failed");
+    ESP_GOTO_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->speed->write_read_encoder, &bus_rmt->tx_write_read, sizeof(bus_rmt->tx_write_read), &onewire_rmt_tx_config),
+                      err, TAG, "1-wire data transmit failed");
+
+    // wait the transmission finishes
+    rmt_rx_done_event_data_t rmt_rx_evt_data;
+    ESP_GOTO_ON_FALSE(xQueueReceive(bus_rmt->receive_queue, &rmt_rx_evt_data, pdMS_TO_TICKS(1000)) == pdPASS, ESP_ERR_TIMEOUT,
+                      err, TAG, "1-wire data receive timeout");
+    ESP_GOTO_ON_FALSE(rmt_rx_evt_data.num_symbols >= num_symbols, ESP_ERR_INVALID_RESPONSE, err, TAG, "1-wire data receive incomplete");
 
 err:
+    bus_rmt->rx_dest = NULL;
+    return ret;
+}
+
+static esp_err_t onewire_bus_rmt_reset(onewire_bus_handle_t bus)
+{
+    onewire_bus_rmt_obj_t *bus_rmt = __containerof(bus, onewire_bus_rmt_obj_t, base);
+
+    xSemaphoreTake(bus_rmt->bus_mutex, portMAX_DELAY);
+    esp_err_t ret = onewire_bus_rmt_do_reset(bus_rmt);
     xSemaphoreGive(bus_rmt->bus_mutex);
     return ret;
 }
@@ -402,58 +705,206 @@ err:
 static esp_err_t onewire_bus_rmt_write_bytes(onewire_bus_handle_t bus, const uint8_t *tx_data, uint8_t tx_data_size)
 {
     onewire_bus_rmt_obj_t *bus_rmt = __containerof(bus, onewire_bus_rmt_obj_t, base);
-    esp_err_t ret = ESP_OK;
 
     xSemaphoreTake(bus_rmt->bus_mutex, portMAX_DELAY);
-    // transmit data with the bytes encoder
-    ESP_GOTO_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->tx_bytes_encoder, tx_data, tx_data_size, &onewire_rmt_tx_config),
-                      err, TAG, "1-wire data transmit failed");
-    // wait the transmission to complete
-    ESP_GOTO_ON_ERROR(rmt_tx_wait_all_done(bus_rmt->tx_channel, 50), err, TAG, "wait for 1-wire data transmit failed");
-
-err:
+    esp_err_t ret = onewire_bus_rmt_do_write_bytes(bus_rmt, tx_data, tx_data_size);
     xSemaphoreGive(bus_rmt->bus_mutex);
     return ret;
 }
 
-// While receiving data, we use rmt transmit channel to send 0xFF to generate read pulse,
+// While receiving data, we use rmt transmit channel to generate read slots,
 // at the same time, receive channel is used to record weather the bus is pulled down by device.
 static esp_err_t onewire_bus_rmt_read_bytes(onewire_bus_handle_t bus, uint8_t *rx_buf, size_t rx_buf_size)
 {
     onewire_bus_rmt_obj_t *bus_rmt = __containerof(bus, onewire_bus_rmt_obj_t, base);
-    esp_err_t ret = ESP_OK;
     ESP_RETURN_ON_FALSE(rx_buf_size <= bus_rmt->max_rx_bytes, ESP_ERR_INVALID_ARG, TAG, "rx_buf_size too large for buffer to hold");
-    memset(rx_buf, 0, rx_buf_size);
 
     xSemaphoreTake(bus_rmt->bus_mutex, portMAX_DELAY);
+    esp_err_t ret = onewire_bus_rmt_do_write_read(bus_rmt, NULL, 0, rx_buf, rx_buf_size);
+    xSemaphoreGive(bus_rmt->bus_mutex);
+    return ret;
+}
 
-    // transmit one bits to generate read clock
-    uint8_t tx_buffer[rx_buf_size];
-    memset(tx_buffer, 0xFF, rx_buf_size);
-    // transmit 1 bits while receiving
-    ESP_GOTO_ON_ERROR(rmt_receive(bus_rmt->rx_channel, bus_rmt->rx_symbols_buf, rx_buf_size * 8 * sizeof(rmt_symbol_word_t), &onewire_rmt_rx_config),
-                      err, TAG, "1-wire data receive failed");
-    ESP_GOTO_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->tx_bytes_encoder, tx_buffer, sizeof(tx_buffer), &onewire_rmt_tx_config),
-                      err, TAG, "1-wire data transmit failed");
+static esp_err_t onewire_bus_rmt_do_transaction(onewire_bus_rmt_obj_t *bus_rmt, onewire_bus_transaction_t *trans)
+{
+    if (trans->reset) {
+        esp_err_t ret = onewire_bus_rmt_do_reset(bus_rmt);
+        if (ret == ESP_ERR_NOT_FOUND) {
+            return ret; // reported by the transaction result
+        }
+        ESP_RETURN_ON_ERROR(ret, TAG, "reset bus failed");
+    }
+    if (!trans->rx_buf_size) {
+        if (trans->tx_data_size) {
+            ESP_RETURN_ON_ERROR(onewire_bus_rmt_do_write_bytes(bus_rmt, trans->tx_data, trans->tx_data_size), TAG, "write bytes failed");
+        }
+        return ESP_OK;
+    }
+    size_t tx_data_size = trans->tx_data_size;
+    if (tx_data_size + trans->rx_buf_size > bus_rmt->max_rx_bytes) {
+        // write and read don't fit one receive transaction
+        if (tx_data_size) {
+            ESP_RETURN_ON_ERROR(onewire_bus_rmt_do_write_bytes(bus_rmt, trans->tx_data, tx_data_size), TAG, "write bytes failed");
+        }
+        tx_data_size = 0;
+    }
+    ESP_RETURN_ON_ERROR(onewire_bus_rmt_do_write_read(bus_rmt, trans->tx_data, tx_data_size, trans->rx_buf, trans->rx_buf_size),
+                        TAG, "read bytes failed");
+    return ESP_OK;
+}
 
-    // wait the transmission finishes and decode data
-    rmt_rx_done_event_data_t rmt_rx_evt_data;
-    ESP_GOTO_ON_FALSE(xQueueReceive(bus_rmt->receive_queue, &rmt_rx_evt_data, pdMS_TO_TICKS(1000)) == pdPASS, ESP_ERR_TIMEOUT,
-                      err, TAG, "1-wire data receive timeout");
-    onewire_rmt_decode_data(rmt_rx_evt_data.received_symbols, rmt_rx_evt_data.num_symbols, rx_buf, rx_buf_size);
+static esp_err_t onewire_bus_rmt_transaction(onewire_bus_handle_t bus, onewire_bus_transaction_t *trans, size_t num_trans)
+{
+    onewire_bus_rmt_obj_t *bus_rmt = __containerof(bus, onewire_bus_rmt_obj_t, base);
+    esp_err_t ret = ESP_OK;
+    for (size_t i = 0; i < num_trans; i++) {
+        ESP_RETURN_ON_FALSE(trans[i].rx_buf_size <= bus_rmt->max_rx_bytes, ESP_ERR_INVALID_ARG, TAG,
+                            "rx_buf_size of transaction %u too large for buffer to hold", (unsigned)i);
+    }
+
+    xSemaphoreTake(bus_rmt->bus_mutex, portMAX_DELAY);
+    for (size_t i = 0; i < num_trans; i++) {
+        trans[i].result = onewire_bus_rmt_do_transaction(bus_rmt, &trans[i]);
+        // a missing device doesn't prevent the other transactions
+        if (trans[i].result != ESP_OK && trans[i].result != ESP_ERR_NOT_FOUND) {
+            ret = trans[i].result;
+            break;
+        }
+    }
+    xSemaphoreGive(bus_rmt->bus_mutex);
+    return ret;
+}
+
+// Each step transmits the direction slot of the previous triplet followed by the two read slots of the next one,
+// so a triplet takes one RMT transmit and receive, without waiting for the transmission of the direction bit.
+static esp_err_t onewire_bus_rmt_search_triplets(onewire_bus_handle_t bus, const uint8_t *directions, uint8_t *taken,
+        uint8_t *discrepancies, size_t num_triplets)
+{
+    onewire_bus_rmt_obj_t *bus_rmt = __containerof(bus, onewire_bus_rmt_obj_t, base);
+    esp_err_t ret = ESP_OK;
+    rmt_symbol_word_t step_symbols[3];
+    uint8_t direction = 0;
+
+    xSemaphoreTake(bus_rmt->bus_mutex, portMAX_DELAY);
+    const onewire_rmt_speed_t *speed = bus_rmt->speed;
+    for (size_t i = 0; i < num_triplets; i++) {
+        const uint8_t mask = 1 << (i % 8);
+        size_t num_symbols = 0;
+        if (i > 0) {
+            step_symbols[num_symbols++] = direction ? speed->bit1_symbol : speed->bit0_symbol;
+        }
+        step_symbols[num_symbols++] = speed->bit1_symbol;
+        step_symbols[num_symbols++] = speed->bit1_symbol;
+
+        ESP_GOTO_ON_ERROR(rmt_receive(bus_rmt->rx_channel, bus_rmt->rx_symbols_buf, num_symbols * sizeof(rmt_symbol_word_t), &speed->rx_slots_config),
+                          err, TAG, "1-wire triplet receive failed");
+        ESP_GOTO_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->tx_copy_encoder, step_symbols, num_symbols * sizeof(rmt_symbol_word_t), &onewire_rmt_tx_config),
+                          err, TAG, "1-wire triplet transmit failed");
+        rmt_rx_done_event_data_t rmt_rx_evt_data;
+        ESP_GOTO_ON_FALSE(xQueueReceive(bus_rmt->receive_queue, &rmt_rx_evt_data, pdMS_TO_TICKS(1000)) == pdPASS, ESP_ERR_TIMEOUT,
+                          err, TAG, "1-wire triplet receive timeout");
+        ESP_GOTO_ON_FALSE(rmt_rx_evt_data.num_symbols == num_symbols, ESP_ERR_INVALID_RESPONSE, err, TAG, "1-wire triplet receive incomplete");
+
+        uint8_t bits = 0;
+        onewire_rmt_decode_data(speed, rmt_rx_evt_data.received_symbols + num_symbols - 2, 2, &bits, sizeof(bits));
+        const uint8_t id_bit = bits & 0x01;
+        const uint8_t cmp_id_bit = (bits >> 1) & 0x01;
+        if (id_bit && cmp_id_bit) {
+            ret = ESP_ERR_NOT_FOUND; // no devices participating in search
+            goto err;
+        }
+        direction = id_bit;
+        if (id_bit == cmp_id_bit) {
+            discrepancies[i / 8] |= mask;
+            direction = (directions[i / 8] & mask) ? 1 : 0;
+        }
+        if (direction) {
+            taken[i / 8] |= mask;
+        }
+    }
+    if (num_triplets) {
+        // direction of the last triplet
+        ESP_GOTO_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->tx_copy_encoder, direction ? &speed->bit1_symbol : &speed->bit0_symbol,
+                                       sizeof(rmt_symbol_word_t), &onewire_rmt_tx_config), err, TAG, "1-wire bit transmit failed");
+        ESP_GOTO_ON_ERROR(rmt_tx_wait_all_done(bus_rmt->tx_channel, 50), err, TAG, "wait for 1-wire bit transmit failed");
+    }
 
 err:
     xSemaphoreGive(bus_rmt->bus_mutex);
     return ret;
 }
 
+static void onewire_bus_rmt_async_task(void *arg)
+{
+    onewire_bus_rmt_obj_t *bus_rmt = (onewire_bus_rmt_obj_t *)arg;
+    onewire_bus_rmt_async_req_t req;
+
+    while (xQueueReceive(bus_rmt->async_queue, &req, portMAX_DELAY) == pdTRUE && req.done_cb) {
+        esp_err_t ret = onewire_bus_rmt_transaction(&bus_rmt->base, req.trans, req.num_trans);
+        req.done_cb(&bus_rmt->base, req.trans, req.num_trans, ret, req.user_ctx);
+    }
+
+    xSemaphoreGive(bus_rmt->async_task_stopped);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t onewire_bus_rmt_start_async_task(onewire_bus_rmt_obj_t *bus_rmt)
+{
+    esp_err_t ret = ESP_OK;
+    QueueHandle_t queue = xQueueCreate(ONEWIRE_RMT_ASYNC_QUEUE_SIZE, sizeof(onewire_bus_rmt_async_req_t));
+    bus_rmt->async_task_stopped = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(queue && bus_rmt->async_task_stopped, ESP_ERR_NO_MEM, err, TAG, "no mem for async transaction queue");
+    bus_rmt->async_queue = queue;
+    ESP_GOTO_ON_FALSE(xTaskCreate(onewire_bus_rmt_async_task, "onewire_rmt", ONEWIRE_RMT_ASYNC_TASK_STACK_SIZE, bus_rmt,
+                                  bus_rmt->async_task_priority, NULL) == pdPASS, ESP_ERR_NO_MEM, err, TAG, "create async task failed");
+    return ESP_OK;
+
+err:
+    bus_rmt->async_queue = NULL;
+    if (queue) {
+        vQueueDelete(queue);
+    }
+    if (bus_rmt->async_task_stopped) {
+        vSemaphoreDelete(bus_rmt->async_task_stopped);
+        bus_rmt->async_task_stopped = NULL;
+    }
+    return ret;
+}
+
+static esp_err_t onewire_bus_rmt_transaction_async(onewire_bus_handle_t bus, onewire_bus_transaction_t *trans, size_t num_trans,
+        onewire_bus_transaction_done_cb_t done_cb, void *user_ctx)
+{
+    onewire_bus_rmt_obj_t *bus_rmt = __containerof(bus, onewire_bus_rmt_obj_t, base);
+    for (size_t i = 0; i < num_trans; i++) {
+        ESP_RETURN_ON_FALSE(trans[i].rx_buf_size <= bus_rmt->max_rx_bytes, ESP_ERR_INVALID_ARG, TAG,
+                            "rx_buf_size of transaction %u too large for buffer to hold", (unsigned)i);
+    }
+
+    if (!bus_rmt->async_queue) {
+        // the bus mutex is not taken by the task yet, so this doesn't wait for other transactions
+        xSemaphoreTake(bus_rmt->bus_mutex, portMAX_DELAY);
+        esp_err_t ret = bus_rmt->async_queue ? ESP_OK : onewire_bus_rmt_start_async_task(bus_rmt);
+        xSemaphoreGive(bus_rmt->bus_mutex);
+        ESP_RETURN_ON_ERROR(ret, TAG, "start async task failed");
+    }
+
+    const onewire_bus_rmt_async_req_t req = {
+        .trans = trans,
+        .num_trans = num_trans,
+        .done_cb = done_cb,
+        .user_ctx = user_ctx,
+    };
+    ESP_RETURN_ON_FALSE(xQueueSend(bus_rmt->async_queue, &req, 0) == pdTRUE, ESP_ERR_INVALID_STATE, TAG, "too many pending transactions");
+    return ESP_OK;
+}
+
 static esp_err_t onewire_bus_rmt_write_bit(onewire_bus_handle_t bus, uint8_t tx_bit)
 {
     onewire_bus_rmt_obj_t *bus_rmt = __containerof(bus, onewire_bus_rmt_obj_t, base);
-    const rmt_symbol_word_t *symbol_to_transmit = tx_bit ? &onewire_bit1_symbol : &onewire_bit0_symbol;
     esp_err_t ret = ESP_OK;
 
     xSemaphoreTake(bus_rmt->bus_mutex, portMAX_DELAY);
+    const rmt_symbol_word_t *symbol_to_transmit = tx_bit ? &bus_rmt->speed->bit1_symbol : &bus_rmt->speed->bit0_symbol;
 
     // transmit bit
     ESP_GOTO_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->tx_copy_encoder, symbol_to_transmit, sizeof(rmt_symbol_word_t), &onewire_rmt_tx_config),
@@ -474,9 +925,9 @@ static esp_err_t onewire_bus_rmt_read_bit(onewire_bus_handle_t bus, uint8_t *rx_
     xSemaphoreTake(bus_rmt->bus_mutex, portMAX_DELAY);
 
     // transmit 1 bit while receiving
-    ESP_GOTO_ON_ERROR(rmt_receive(bus_rmt->rx_channel, bus_rmt->rx_symbols_buf, sizeof(rmt_symbol_word_t), &onewire_rmt_rx_config),
+    ESP_GOTO_ON_ERROR(rmt_receive(bus_rmt->rx_channel, bus_rmt->rx_symbols_buf, sizeof(rmt_symbol_word_t), &bus_rmt->speed->rx_config),
                       err, TAG, "1-wire bit receive failed");
-    ESP_GOTO_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->tx_copy_encoder, &onewire_bit1_symbol, sizeof(rmt_symbol_word_t), &onewire_rmt_tx_config),
+    ESP_GOTO_ON_ERROR(rmt_transmit(bus_rmt->tx_channel, bus_rmt->tx_copy_encoder, &bus_rmt->speed->bit1_symbol, sizeof(rmt_symbol_word_t), &onewire_rmt_tx_config),
                       err, TAG, "1-wire bit transmit failed");
 
     // wait the transmission finishes and decode data
@@ -484,10 +935,23 @@ static esp_err_t onewire_bus_rmt_read_bit(onewire_bus_handle_t bus, uint8_t *rx_
     ESP_GOTO_ON_FALSE(xQueueReceive(bus_rmt->receive_queue, &rmt_rx_evt_data, pdMS_TO_TICKS(1000)) == pdPASS, ESP_ERR_TIMEOUT,
                       err, TAG, "1-wire bit receive timeout");
     uint8_t rx_buffer = 0;
-    onewire_rmt_decode_data(rmt_rx_evt_data.received_symbols, rmt_rx_evt_data.num_symbols, &rx_buffer, sizeof(rx_buffer));
+    onewire_rmt_decode_data(bus_rmt->speed, rmt_rx_evt_data.received_symbols, rmt_rx_evt_data.num_symbols, &rx_buffer, sizeof(rx_buffer));
     *rx_bit = rx_buffer & 0x01;
 
 err:
     xSemaphoreGive(bus_rmt->bus_mutex);
     return ret;
 }
+
+static esp_err_t onewire_bus_rmt_set_speed(onewire_bus_handle_t bus, onewire_bus_speed_t speed)
+{
+    onewire_bus_rmt_obj_t *bus_rmt = __containerof(bus, onewire_bus_rmt_obj_t, base);
+    ESP_RETURN_ON_FALSE(speed == ONEWIRE_BUS_SPEED_STANDARD || speed == ONEWIRE_BUS_SPEED_OVERDRIVE, ESP_ERR_INVALID_ARG, TAG, "invalid speed");
+    ESP_RETURN_ON_FALSE(bus_rmt->speeds[speed].bytes_encoder, ESP_ERR_NOT_SUPPORTED, TAG, "overdrive not enabled in onewire_bus_rmt_config_t");
+
+    // the following operations use the new timings
+    xSemaphoreTake(bus_rmt->bus_mutex, portMAX_DELAY);
+    bus_rmt->speed = &bus_rmt->speeds[speed];
+    xSemaphoreGive(bus_rmt->bus_mutex);
+    return ESP_OK;
+}
@@ -65,45 +65,35 @@ esp_err_t onewire_device_iter_get_next(onewire_device_iter_handle_t iter, onewir
         ONEWIRE_CMD_SEARCH_NORMAL
     }, 1), TAG, "send ONEWIRE_CMD_SEARCH_NORMAL failed");
 
-    uint8_t last_zero = 0;
+    // directions to take at discrepancies: follow the previous ROM number before the last discrepancy, take 1 at it, 0 after it
+    uint8_t directions[sizeof(onewire_device_address_t)] = {0};
     for (uint16_t rom_bit_index = 0; rom_bit_index < sizeof(onewire_device_address_t) * 8; rom_bit_index ++) {
         uint8_t rom_byte_index = rom_bit_index / 8;
-        uint8_t rom_bit_mask = 1 << (rom_bit_index % 8); // calculate byte index and bit mask in advance for convenience
-
-        uint8_t rom_bit = 0;
-        uint8_t rom_bit_complement = 0;
-        ESP_RETURN_ON_ERROR(onewire_bus_read_bit(bus, &rom_bit), TAG, "read rom_bit error"); // write 1 bit to read from the bus
-        ESP_RETURN_ON_ERROR(onewire_bus_read_bit(bus, &rom_bit_complement), TAG, "read rom_bit_complement error"); // read a bit and its complement
-
-        // No devices participating in search.
-        if (rom_bit && rom_bit_complement) {
-            ESP_LOGE(TAG, "no devices participating in search");
-            return ESP_ERR_NOT_FOUND;
+        uint8_t rom_bit_mask = 1 << (rom_bit_index % 8);
+        if (rom_bit_index < iter->last_discrepancy) {
+            directions[rom_byte_index] |= iter->rom_number[rom_byte_index] & rom_bit_mask; // follow previous way
+        } else if (rom_bit_index == iter->last_discrepancy) {
+            directions[rom_byte_index] |= rom_bit_mask;
         }
+    }
 
-        uint8_t search_direction;
-        if (rom_bit != rom_bit_complement) { // There are only 0s or 1s in the bit of the participating ROM numbers.
-            search_direction = rom_bit;  // just go ahead
-        } else { // There are both 0s and 1s in the current bit position of the participating ROM numbers. This is a discrepancy.
-            if (rom_bit_index < iter->last_discrepancy) { // current id bit is before the last discrepancy bit
-                search_direction = (iter->rom_number[rom_byte_index] & rom_bit_mask) ? 0x01 : 0x00; // follow previous way
-            } else {
-                search_direction = (rom_bit_index == iter->last_discrepancy) ? 0x01 : 0x00; // search for 0 bit first
-            }
-
-            if (search_direction == 0) { // record zero's position in last zero
-                last_zero = rom_bit_index;
-            }
-        }
+    uint8_t discrepancies[sizeof(onewire_device_address_t)];
+    esp_err_t search_result = onewire_bus_search_triplets(bus, directions, iter->rom_number, discrepancies, sizeof(onewire_device_address_t) * 8);
+    // No devices participating in search.
+    if (search_result == ESP_ERR_NOT_FOUND) {
+        ESP_LOGE(TAG, "no devices participating in search");
+        return ESP_ERR_NOT_FOUND;
+    }
+    ESP_RETURN_ON_ERROR(search_result, TAG, "search triplets error");
 
-        if (search_direction == 1) { // set corrsponding rom bit by search direction
-            iter->rom_number[rom_byte_index] |= rom_bit_mask;
-        } else {
-            iter->rom_number[rom_byte_index] &= ~rom_bit_mask;
+    // record the last discrepancy where the 0 way was taken
+    uint8_t last_zero = 0;
+    for (uint16_t rom_bit_index = 0; rom_bit_index < sizeof(onewire_device_address_t) * 8; rom_bit_index ++) {
+        uint8_t rom_byte_index = rom_bit_index / 8;
+        uint8_t rom_bit_mask = 1 << (rom_bit_index % 8);
+        if ((discrepancies[rom_byte_index] & rom_bit_mask) && !(iter->rom_number[rom_byte_index] & rom_bit_mask)) {
+            last_zero = rom_bit_index;
         }
-
-        // set search direction
-        ESP_RETURN_ON_ERROR(onewire_bus_write_bit(bus, search_direction), TAG, "write direction bit error");
     }
 
     // if the search was successful
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include "esp_err.h"
 
 #ifdef __cplusplus
@@ -15,6 +17,10 @@ extern "C" {
 #define PCAP_DEFAULT_VERSION_MAJOR 0x02 /*!< Major Version */
 #define PCAP_DEFAULT_VERSION_MINOR 0x04 /*!< Minor Version */
 #define PCAP_DEFAULT_TIME_ZONE_GMT 0x00 /*!< Time Zone */
+#define PCAP_DEFAULT_WRITE_BUF_SIZE 4096 /*!< A write buffer size suitable for SD cards */
+#define PCAP_DEFAULT_RING_TASK_STACK_SIZE 4096 /*!< Default stack size of the capture ring writer task */
+#define PCAP_SOCKET_SINK_DEFAULT_SEND_TIMEOUT_MS 1000 /*!< Default send timeout of the socket sink */
+#define PCAP_DEFAULT_FLUSH_TASK_STACK_SIZE 4096 /*!< Stack size of the task flushing the write buffer every flush_interval_ms */
 
 /**
  * @brief Type of pcap file handle
@@ -22,6 +28,12 @@ extern "C" {
  */
 typedef struct pcap_file_t *pcap_file_handle_t;
 
+/**
+ * @brief Type of pcap reader handle
+ *
+ */
+typedef struct pcap_reader_t *pcap_reader_handle_t;
+
 /**
 * @brief Link layer Type Definition, used for Pcap reader to decode payload
 *
@@ -45,20 +57,169 @@ typedef enum {
     PCAP_LINK_TYPE_USBPCAP = 249,      /*!< USB packets, beginning with a USBPcap header */
 } pcap_link_type_t;
 
+/**
+* @brief Part of the data written to a sink
+*
+*/
+typedef struct {
+    const void *data;           /*!< Data */
+    size_t length;              /*!< Length of data */
+} pcap_iovec_t;
+
+/**
+* @brief Pcap sink Type Definition, receiving the pcap data in place of a file
+*
+*/
+typedef struct {
+    esp_err_t (*writev)(const pcap_iovec_t *iov, size_t count, void *user_ctx); /*!< Write all of the iov buffers, in order */
+    void (*close)(void *user_ctx);  /*!< Called by `pcap_del_session()`, optional */
+    void *user_ctx;                 /*!< User context passed to the callbacks */
+} pcap_sink_t;
+
+/**
+* @brief Socket sink configuration Type Definition
+*
+*/
+typedef struct {
+    int sock;                   /*!< Connected TCP or UDP socket, closed with the sink */
+    uint32_t send_timeout_ms;   /*!< Longest wait for a non-blocking socket to accept more data, after which the write fails
+                                     with ESP_ERR_TIMEOUT. 0 selects PCAP_SOCKET_SINK_DEFAULT_SEND_TIMEOUT_MS */
+} pcap_socket_sink_config_t;
+
+#define PCAP_FILTER_MAX_MATCH_LEN 8 /*!< Max number of bytes compared by a filter rule */
+
+/**
+* @brief Filter rule Type Definition
+*
+* The rule matches if the `length` bytes of the packet at `offset`, masked with `mask`, are equal to `value`.
+* A packet shorter than `offset + length` doesn't match.
+*
+*/
+typedef struct {
+    uint16_t offset;                           /*!< Offset of the compared bytes from the start of the packet */
+    uint8_t length;                            /*!< Number of compared bytes, up to PCAP_FILTER_MAX_MATCH_LEN */
+    bool negate;                               /*!< Whether the rule matches if the bytes are NOT equal instead */
+    uint8_t mask[PCAP_FILTER_MAX_MATCH_LEN];   /*!< Mask applied to the packet bytes, 0xFF to compare whole bytes */
+    uint8_t value[PCAP_FILTER_MAX_MATCH_LEN];  /*!< Expected value of the masked bytes */
+} pcap_filter_rule_t;
+
+/**
+* @brief Capture filter Type Definition
+*
+*/
+typedef struct {
+    const pcap_filter_rule_t *rules; /*!< Rules, copied into the session. NULL records every packet */
+    size_t rule_count;               /*!< Number of rules */
+    bool match_any;                  /*!< Whether one matching rule is enough to record a packet, instead of all */
+    uint32_t snaplen;                /*!< Max number of bytes recorded from each packet, longer packets are truncated.
+                                          0 keeps whole packets */
+} pcap_filter_config_t;
+
 /**
 * @brief Pcap configuration Type Definition
 *
 */
 typedef struct {
     FILE *fp;                   /*!< Pointer to a standard file handle */
+    const pcap_sink_t *sink;    /*!< Sink receiving the data when fp is NULL, e.g. created by `pcap_new_socket_sink()` */
     unsigned int major_version; /*!< Pcap version: major */
     unsigned int minor_version; /*!< Pcap version: minor */
     unsigned int time_zone;     /*!< Pcap timezone code */
+    size_t write_buf_size;      /*!< Size of the in-memory write buffer. Headers and packets are appended to it and only
+                                     written to the file when it is full, on `pcap_flush()` or by the flush timer.
+                                     0 writes and flushes every packet directly */
+    uint32_t flush_interval_ms; /*!< Period of the flush timer, only used with a write buffer. 0 disables the timer.
+                                     The timer notifies a task created at the priority of the caller, which flushes the buffer */
+    const pcap_filter_config_t *filter; /*!< Filter applied to captured packets before they are copied, NULL for none */
     struct {
         unsigned int little_endian: 1; /*!< Whether the pcap file is recored in little endian format */
+        unsigned int pcapng: 1;        /*!< Whether the file is written in pcapng format instead, with several interfaces
+                                            and nanosecond timestamps. The byte order is then the native one */
     } flags;
 } pcap_config_t;
 
+/**
+* @brief Capture ring configuration Type Definition
+*
+*/
+typedef struct {
+    size_t slot_count;          /*!< Number of packets the ring can hold */
+    size_t snaplen;             /*!< Max number of bytes kept from each packet, longer packets are truncated */
+    uint32_t task_stack_size;   /*!< Stack size of the writer task. 0 selects PCAP_DEFAULT_RING_TASK_STACK_SIZE */
+    unsigned task_priority;     /*!< Priority of the writer task. 0 selects the priority of the calling task */
+    int task_core_id;           /*!< Core the writer task is pinned to, or tskNO_AFFINITY */
+} pcap_capture_ring_config_t;
+
+/**
+* @brief Capture ring counters
+*
+*/
+typedef struct {
+    uint32_t captured;          /*!< Packets enqueued into the ring */
+    uint32_t dropped;           /*!< Packets dropped because the ring was full */
+    uint32_t truncated;         /*!< Packets truncated to the snaplen */
+    uint32_t filtered;          /*!< Packets rejected by the capture filter */
+    uint32_t write_errors;      /*!< Packets the writer task failed to write to the file */
+} pcap_capture_ring_stats_t;
+
+/**
+* @brief Pcap reader configuration Type Definition
+*
+*/
+typedef struct {
+    FILE *fp;                   /*!< File to read, positioned at the file header. It isn't closed by the reader */
+    size_t buf_size;            /*!< Size of the payload buffer, reused for every packet. Longer payloads are read
+                                     partially and the rest is skipped. 0 skips payloads entirely */
+    struct {
+        unsigned int build_index: 1; /*!< Whether to record the offset of the packets read, for `pcap_reader_seek()` */
+    } flags;
+} pcap_reader_config_t;
+
+/**
+* @brief File header of the file being read
+*
+*/
+typedef struct {
+    uint32_t magic;             /*!< Magic Number */
+    uint16_t major_version;     /*!< Major Version */
+    uint16_t minor_version;     /*!< Minor Version */
+    uint32_t snaplen;           /*!< Max Length to Capture */
+    uint32_t link_type;         /*!< Link Layer Type */
+} pcap_reader_info_t;
+
+/**
+* @brief Packet returned by the pcap reader
+*
+*/
+typedef struct {
+    uint32_t index;             /*!< Index of the packet in the file, starting from 0 */
+    uint32_t seconds;           /*!< Timestamp: seconds */
+    uint32_t microseconds;      /*!< Timestamp: microseconds */
+    uint32_t capture_length;    /*!< Number of bytes of the packet in the file */
+    uint32_t packet_length;     /*!< Actual length of the packet */
+    const uint8_t *payload;     /*!< Start of the payload, in the reader buffer and valid until the next call */
+    size_t payload_length;      /*!< Number of payload bytes read, at most `pcap_reader_config_t::buf_size` */
+} pcap_reader_packet_t;
+
+/**
+ * @brief Create a sink streaming the pcap data to a socket
+ *
+ * Everything written to the sink is sent with `sendmsg()`. On a TCP socket, the stream can be viewed live,
+ * e.g. with `nc -l 19000 | wireshark -k -i -`. On a UDP socket, every write becomes one datagram: use a write
+ * buffer (see `pcap_config_t::write_buf_size`) no larger than a datagram should be, so that packets are sent in
+ * batches, and note that the stream can't be recovered from lost datagrams. On a non-blocking socket, a write waits
+ * with `poll()` while the send buffer is full, and fails with ESP_ERR_TIMEOUT after `send_timeout_ms`: the stream is
+ * then cut in the middle of a record.
+ *
+ * @param[in] config socket sink configuration
+ * @param[out] ret_sink Returned sink, to be passed in `pcap_config_t::sink`
+ * @return
+ *      - ESP_OK: Create sink successfully
+ *      - ESP_ERR_INVALID_ARG: Create sink failed because of invalid argument
+ *      - ESP_ERR_NO_MEM: Create sink failed because out of memory
+ */
+esp_err_t pcap_new_socket_sink(const pcap_socket_sink_config_t *config, pcap_sink_t *ret_sink);
+
 /**
  * @brief Create a new pcap session, and returns pcap file handle
  *
@@ -75,7 +236,9 @@ typedef struct {
 esp_err_t pcap_new_session(const pcap_config_t *config, pcap_file_handle_t *ret_pcap);
 
 /**
- * @brief Delete the pcap session, and close the File Stream
+ * @brief Delete the pcap session, and close the File Stream or the sink
+ *
+ * @note Any data still held in the write buffer is written to the file before it is closed.
  *
  * @param[in] pcap pcap file handle created by `pcap_new_session()`
  * @return
@@ -88,6 +251,9 @@ esp_err_t pcap_del_session(pcap_file_handle_t pcap);
 /**
  * @brief Write pcap file header
  *
+ * @note In pcapng format, this writes the Section Header Block and describes the first interface (interface 0)
+ *       with the given link type. More interfaces can be added with `pcap_add_interface()`.
+ *
  * @param[in] pcap pcap file handle created by `pcap_new_session()`
  * @param[in] link_type Network link layer type
  * @return
@@ -97,9 +263,27 @@ esp_err_t pcap_del_session(pcap_file_handle_t pcap);
  */
 esp_err_t pcap_write_header(pcap_file_handle_t pcap, pcap_link_type_t link_type);
 
+/**
+ * @brief Describe another interface in a pcapng file
+ *
+ * @param[in] pcap pcap file handle created by `pcap_new_session()`, whose header has been written
+ * @param[in] link_type Network link layer type of the interface
+ * @param[out] ret_interface_id Returned interface id, to be passed to `pcap_capture_packet_ns()`
+ * @return
+ *      - ESP_OK: Add interface successfully
+ *      - ESP_ERR_INVALID_ARG: Add interface failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Add interface failed because the file header has not been written
+ *      - ESP_ERR_NOT_SUPPORTED: Add interface failed because the file is not in pcapng format
+ *      - ESP_FAIL: Add interface failed
+ */
+esp_err_t pcap_add_interface(pcap_file_handle_t pcap, pcap_link_type_t link_type, uint32_t *ret_interface_id);
+
 /**
  * @brief Capture one packet into pcap file
  *
+ * @note In pcapng format, the packet is recorded on interface 0.
+ * @note A packet rejected by the capture filter (see `pcap_config_t::filter`) is not recorded, and ESP_OK is returned.
+ *
  * @param[in] pcap pcap file handle created by `pcap_new_session()`
  * @param[in] payload pointer of the captured data buffer
  * @param[in] length length of captured data buffer
@@ -112,6 +296,96 @@ esp_err_t pcap_write_header(pcap_file_handle_t pcap, pcap_link_type_t link_type)
  */
 esp_err_t pcap_capture_packet(pcap_file_handle_t pcap, void *payload, uint32_t length, uint32_t seconds, uint32_t microseconds);
 
+/**
+ * @brief Capture one packet of an interface into pcap file, with a nanosecond timestamp
+ *
+ * @note Classic pcap files only have interface 0 and store microseconds.
+ * @note A packet rejected by the capture filter is not recorded, and ESP_OK is returned.
+ *
+ * @param[in] pcap pcap file handle created by `pcap_new_session()`
+ * @param[in] interface_id 0 or an interface id returned by `pcap_add_interface()`
+ * @param[in] payload pointer of the captured data buffer
+ * @param[in] length length of captured data buffer
+ * @param[in] timestamp_ns capture time in nanoseconds
+ * @return
+ *      - ESP_OK: Write network packet into pcap file successfully
+ *      - ESP_ERR_INVALID_ARG: Write network packet into pcap file failed because of invalid argument
+ *      - ESP_FAIL: Write network packet into pcap file failed
+ */
+esp_err_t pcap_capture_packet_ns(pcap_file_handle_t pcap, uint32_t interface_id, const void *payload, uint32_t length,
+                                 uint64_t timestamp_ns);
+
+/**
+ * @brief Start the capture ring of a pcap session
+ *
+ * The capture ring is a preallocated ring of packet slots. `pcap_capture_packet_from_isr()` copies packets into it
+ * without blocking, and a writer task writes them to the file with `pcap_capture_packet()`. Combine it with a write
+ * buffer (see `pcap_config_t::write_buf_size`) to batch the file writes as well.
+ *
+ * @param[in] pcap pcap file handle created by `pcap_new_session()`, whose header has been written
+ * @param[in] config capture ring configuration
+ * @return
+ *      - ESP_OK: Start capture ring successfully
+ *      - ESP_ERR_INVALID_ARG: Start capture ring failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Start capture ring failed because it is already started
+ *      - ESP_ERR_NO_MEM: Start capture ring failed because out of memory
+ */
+esp_err_t pcap_capture_ring_start(pcap_file_handle_t pcap, const pcap_capture_ring_config_t *config);
+
+/**
+ * @brief Write the remaining packets of the capture ring to the file and stop it
+ *
+ * @note `pcap_del_session()` stops the capture ring as well.
+ *
+ * @param[in] pcap pcap file handle created by `pcap_new_session()`
+ * @return
+ *      - ESP_OK: Stop capture ring successfully
+ *      - ESP_ERR_INVALID_ARG: Stop capture ring failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Stop capture ring failed because it is not started
+ */
+esp_err_t pcap_capture_ring_stop(pcap_file_handle_t pcap);
+
+/**
+ * @brief Capture one packet into the capture ring, without blocking
+ *
+ * The packet is stamped with the current time and copied into a free slot, truncated to the snaplen.
+ * It can be called from an ISR, or from a callback that must not block such as the Wi-Fi promiscuous RX callback.
+ *
+ * @note There must be one producer only: this function must not be called concurrently for the same session.
+ *
+ * @param[in] pcap pcap file handle created by `pcap_new_session()`, with a started capture ring
+ * @param[in] payload pointer of the captured data buffer
+ * @param[in] length length of captured data buffer
+ * @return
+ *      - ESP_OK: Capture packet successfully, or the packet was rejected by the capture filter
+ *      - ESP_ERR_INVALID_ARG: Capture packet failed because of invalid argument or the capture ring not started
+ *      - ESP_ERR_NO_MEM: Capture packet failed because the capture ring is full, the packet is counted as dropped
+ */
+esp_err_t pcap_capture_packet_from_isr(pcap_file_handle_t pcap, const void *payload, uint32_t length);
+
+/**
+ * @brief Get the counters of the capture ring
+ *
+ * @param[in] pcap pcap file handle created by `pcap_new_session()`
+ * @param[out] stats Returned counters
+ * @return
+ *      - ESP_OK: Get counters successfully
+ *      - ESP_ERR_INVALID_ARG: Get counters failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Get counters failed because the capture ring is not started
+ */
+esp_err_t pcap_get_capture_ring_stats(pcap_file_handle_t pcap, pcap_capture_ring_stats_t *stats);
+
+/**
+ * @brief Write the content of the write buffer into the file and flush the File Stream
+ *
+ * @param[in] pcap pcap file handle created by `pcap_new_session()`
+ * @return
+ *      - ESP_OK: Flush pcap file successfully
+ *      - ESP_ERR_INVALID_ARG: Flush pcap file failed because of invalid argument
+ *      - ESP_FAIL: Flush pcap file failed
+ */
+esp_err_t pcap_flush(pcap_file_handle_t pcap);
+
 /**
  * @brief Print the summary of pcap file into stream
  *
@@ -120,10 +394,97 @@ esp_err_t pcap_capture_packet(pcap_file_handle_t pcap, void *payload, uint32_t l
  * @return
  *      - ESP_OK: Print pcap file summary successfully
  *      - ESP_ERR_INVALID_ARG: Print pcap file summary failed because of invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED: Print pcap file summary failed because the file is in pcapng format, or the
+ *                               session writes to a sink
  *      - ESP_FAIL: Print pcap file summary failed
  */
 esp_err_t pcap_print_summary(pcap_file_handle_t pcap, FILE *print_file);
 
+/**
+ * @brief Open a pcap file for reading, and read its file header
+ *
+ * @note Only pcap files are supported, not pcapng ones. The files are read in the native byte order, as written by
+ *       this component.
+ *
+ * @param[in] config reader configuration
+ * @param[out] ret_reader Returned reader handle
+ * @return
+ *      - ESP_OK: Open reader successfully
+ *      - ESP_ERR_INVALID_ARG: Open reader failed because of invalid argument
+ *      - ESP_ERR_NOT_FOUND: Open reader failed because the file is empty
+ *      - ESP_ERR_NOT_SUPPORTED: Open reader failed because the file is not a pcap file
+ *      - ESP_ERR_NO_MEM: Open reader failed because out of memory
+ *      - ESP_FAIL: Open reader failed because the file header can't be read
+ */
+esp_err_t pcap_reader_open(const pcap_reader_config_t *config, pcap_reader_handle_t *ret_reader);
+
+/**
+ * @brief Get the file header of the file being read
+ *
+ * @param[in] reader pcap reader handle created by `pcap_reader_open()`
+ * @param[out] info Returned file header
+ * @return
+ *      - ESP_OK: Get file header successfully
+ *      - ESP_ERR_INVALID_ARG: Get file header failed because of invalid argument
+ */
+esp_err_t pcap_reader_get_info(pcap_reader_handle_t reader, pcap_reader_info_t *info);
+
+/**
+ * @brief Read the next packet
+ *
+ * The payload is read into the reader buffer, and the part not fitting in it is skipped with `fseek()`.
+ *
+ * @param[in] reader pcap reader handle created by `pcap_reader_open()`
+ * @param[out] packet Returned packet
+ * @return
+ *      - ESP_OK: Read packet successfully
+ *      - ESP_ERR_INVALID_ARG: Read packet failed because of invalid argument
+ *      - ESP_ERR_NOT_FOUND: Read packet failed because the end of the file is reached
+ *      - ESP_ERR_NO_MEM: Read packet failed because out of memory for the index
+ *      - ESP_FAIL: Read packet failed because the file is truncated or can't be read
+ */
+esp_err_t pcap_reader_next(pcap_reader_handle_t reader, pcap_reader_packet_t *packet);
+
+/**
+ * @brief Index all of the packets of the file, skipping their payloads
+ *
+ * The position of the reader is kept: the next packet read is the same as before.
+ *
+ * @param[in] reader pcap reader handle created by `pcap_reader_open()`, with `flags.build_index` set
+ * @param[out] ret_packet_count Returned number of packets in the file, can be NULL
+ * @return
+ *      - ESP_OK: Build index successfully
+ *      - ESP_ERR_INVALID_ARG: Build index failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Build index failed because the reader doesn't build an index
+ *      - ESP_ERR_NO_MEM: Build index failed because out of memory
+ *      - ESP_FAIL: Build index failed because the file is truncated or can't be read
+ */
+esp_err_t pcap_reader_build_index(pcap_reader_handle_t reader, uint32_t *ret_packet_count);
+
+/**
+ * @brief Move the reader to a packet already indexed, so that it is the next one read
+ *
+ * @param[in] reader pcap reader handle created by `pcap_reader_open()`, with `flags.build_index` set
+ * @param[in] index Index of the packet
+ * @return
+ *      - ESP_OK: Seek successfully
+ *      - ESP_ERR_INVALID_ARG: Seek failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Seek failed because the reader doesn't build an index
+ *      - ESP_ERR_NOT_FOUND: Seek failed because the packet is not indexed
+ *      - ESP_FAIL: Seek failed
+ */
+esp_err_t pcap_reader_seek(pcap_reader_handle_t reader, uint32_t index);
+
+/**
+ * @brief Close the reader, but not its file
+ *
+ * @param[in] reader pcap reader handle created by `pcap_reader_open()`
+ * @return
+ *      - ESP_OK: Close reader successfully
+ *      - ESP_ERR_INVALID_ARG: Close reader failed because of invalid argument
+ */
+esp_err_t pcap_reader_close(pcap_reader_handle_t reader);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,18 +6,67 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include <string.h>
 #include <inttypes.h>
+#include <stdatomic.h>
+#include <sys/time.h>
 #include "esp_log.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
 #include "esp_check.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 #include "pcap.h"
 
 static const char *TAG = "pcap";
 
 #define PCAP_MAGIC_BIG_ENDIAN 0xA1B2C3D4    /*!< Big-Endian */
 #define PCAP_MAGIC_LITTLE_ENDIAN 0xD4C3B2A1 /*!< Little-Endian */
+#define PCAP_SNAPLEN 0x40000                /*!< Max Length to Capture, written to the file headers */
+
+#define PCAPNG_BLOCK_SECTION_HEADER 0x0A0D0D0A  /*!< Section Header Block */
+#define PCAPNG_BLOCK_INTERFACE 0x00000001       /*!< Interface Description Block */
+#define PCAPNG_BLOCK_ENHANCED_PACKET 0x00000006 /*!< Enhanced Packet Block */
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D      /*!< Byte-Order Magic, written in native byte order */
+#define PCAPNG_OPT_END 0                        /*!< opt_endofopt */
+#define PCAPNG_OPT_IF_TSRESOL 9                 /*!< if_tsresol */
+
+#define PCAP_RING_POLL_MS 100 /*!< Longest time the ring writer task sleeps without being notified */
 
 typedef struct pcap_file_t pcap_file_t;
+typedef struct pcap_reader_t pcap_reader_t;
+
+/**
+ * @brief Slot of the capture ring, followed by the captured data
+ *
+ */
+typedef struct {
+    int64_t time_us;         /*!< Capture time, from esp_timer_get_time() */
+    uint32_t capture_length; /*!< Number of bytes of captured data, no longer than the snaplen */
+    uint32_t packet_length;  /*!< Actual length of the packet */
+    uint8_t data[];          /*!< Captured data */
+} pcap_ring_slot_t;
+
+/**
+ * @brief Single producer, single consumer ring of packet slots, drained to the file by a writer task
+ *
+ */
+typedef struct {
+    uint8_t *slots;                   /*!< slot_count slots of slot_size bytes */
+    size_t slot_count;                /*!< Number of slots, one of which always stays empty */
+    size_t slot_size;                 /*!< Size of a slot including the data */
+    size_t snaplen;                   /*!< Max length of captured data */
+    atomic_size_t head;               /*!< Next slot to fill, only written by the producer */
+    atomic_size_t tail;               /*!< Next slot to write out, only written by the writer task */
+    int64_t time_offset_us;           /*!< Offset from esp_timer time to wall clock time */
+    pcap_capture_ring_stats_t stats;  /*!< Counters */
+    TaskHandle_t task;                /*!< Writer task */
+    SemaphoreHandle_t done;           /*!< Given by the writer task when it exits */
+    volatile bool stop;               /*!< Asks the writer task to drain the ring and exit */
+} pcap_capture_ring_t;
 
 /**
  * @brief Pcap File Header
@@ -33,6 +82,54 @@ typedef struct {
     uint32_t link_type; /*!< Link Layer Type */
 } pcap_file_header_t;
 
+/**
+ * @brief Pcapng Section Header Block, without options
+ *
+ */
+typedef struct {
+    uint32_t type;                 /*!< PCAPNG_BLOCK_SECTION_HEADER */
+    uint32_t total_length;         /*!< Length of the block */
+    uint32_t byte_order_magic;     /*!< PCAPNG_BYTE_ORDER_MAGIC in the byte order of the section */
+    uint16_t major;                /*!< Major Version */
+    uint16_t minor;                /*!< Minor Version */
+    int64_t section_length;        /*!< Length of the section, -1 if not specified */
+    uint32_t total_length_trailer; /*!< Length of the block */
+} __attribute__((packed)) pcapng_section_header_block_t;
+
+/**
+ * @brief Pcapng Interface Description Block, with a timestamp resolution option
+ *
+ */
+typedef struct {
+    uint32_t type;                 /*!< PCAPNG_BLOCK_INTERFACE */
+    uint32_t total_length;         /*!< Length of the block */
+    uint16_t link_type;            /*!< Link Layer Type */
+    uint16_t reserved;             /*!< Reserved, 0 */
+    uint32_t snaplen;              /*!< Max Length to Capture */
+    struct {
+        uint16_t code;             /*!< PCAPNG_OPT_IF_TSRESOL */
+        uint16_t length;           /*!< 1 */
+        uint8_t value;             /*!< Resolution as a negative power of 10 */
+        uint8_t padding[3];        /*!< Padding to 32 bits */
+    } tsresol;                     /*!< Timestamp resolution option */
+    uint32_t end_of_options;       /*!< PCAPNG_OPT_END */
+    uint32_t total_length_trailer; /*!< Length of the block */
+} pcapng_interface_block_t;
+
+/**
+ * @brief Pcapng Enhanced Packet Block header, followed by the padded packet data and the block length
+ *
+ */
+typedef struct {
+    uint32_t type;                 /*!< PCAPNG_BLOCK_ENHANCED_PACKET */
+    uint32_t total_length;         /*!< Length of the block */
+    uint32_t interface_id;         /*!< Index of the interface in the section */
+    uint32_t timestamp_high;       /*!< Upper 32 bits of the timestamp, in units of the interface resolution */
+    uint32_t timestamp_low;        /*!< Lower 32 bits of the timestamp */
+    uint32_t capture_length;       /*!< Number of bytes of captured data */
+    uint32_t packet_length;        /*!< Actual length of the packet */
+} pcapng_packet_block_t;
+
 /**
  * @brief Pcap Packet Header
  *
@@ -49,31 +146,186 @@ typedef struct {
  *
  */
 struct pcap_file_t {
-    FILE *file;                 /*!< File handle */
+    FILE *file;                 /*!< File handle, NULL if writing to the sink */
+    pcap_sink_t sink;           /*!< Sink, used if there is no file */
     pcap_link_type_t link_type; /*!< Pcap Link Type */
     unsigned int major_version; /*!< Pcap version: major */
     unsigned int minor_version; /*!< Pcap version: minor */
     unsigned int time_zone;     /*!< Pcap timezone code */
     uint32_t endian_magic;      /*!< Magic value related to endian format */
+    uint8_t *write_buf;         /*!< Write buffer, NULL if data is written directly */
+    size_t write_buf_size;      /*!< Size of the write buffer */
+    size_t write_buf_len;       /*!< Length of the data in the write buffer */
+    SemaphoreHandle_t lock;     /*!< Protects the write buffer against the flush task */
+    esp_timer_handle_t flush_timer; /*!< Periodic flush timer, notifies the flush task */
+    TaskHandle_t flush_task;    /*!< Flushes the write buffer when notified, so that the esp_timer task doesn't block on the file */
+    SemaphoreHandle_t flush_done; /*!< Given by the flush task when it exits */
+    volatile bool flush_stop;   /*!< Asks the flush task to exit */
+    pcap_capture_ring_t *ring;  /*!< Capture ring, NULL if not started */
+    bool pcapng;                /*!< Whether the file is written in pcapng format */
+    uint32_t interface_count;   /*!< Number of interfaces described in the pcapng file */
+    pcap_filter_rule_t *filter_rules; /*!< Filter rules, NULL if every packet is recorded */
+    size_t filter_rule_count;   /*!< Number of filter rules */
+    bool filter_match_any;      /*!< Whether one matching rule is enough to record a packet */
+    uint32_t snaplen;           /*!< Max number of bytes recorded from each packet */
 };
 
+/* Write data out to the file or to the sink */
+static esp_err_t pcap_output(pcap_file_t *pcap, const pcap_iovec_t *iov, size_t count)
+{
+    if (!pcap->file) {
+        ESP_RETURN_ON_ERROR(pcap->sink.writev(iov, count, pcap->sink.user_ctx), TAG, "write pcap sink failed");
+        return ESP_OK;
+    }
+    for (size_t i = 0; i < count; i++) {
+        size_t real_write = fwrite(iov[i].data, sizeof(uint8_t), iov[i].length, pcap->file);
+        ESP_RETURN_ON_FALSE(real_write == iov[i].length, ESP_FAIL, TAG, "write pcap file failed");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t pcap_output_flush(pcap_file_t *pcap)
+{
+    if (pcap->file) {
+        ESP_RETURN_ON_FALSE(fflush(pcap->file) == 0, ESP_FAIL, TAG, "flush pcap file failed");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t pcap_flush_locked(pcap_file_t *pcap)
+{
+    if (pcap->write_buf_len) {
+        pcap_iovec_t iov = { pcap->write_buf, pcap->write_buf_len };
+        /* The buffer is emptied even on failure, so that a broken file doesn't block capturing */
+        pcap->write_buf_len = 0;
+        ESP_RETURN_ON_ERROR(pcap_output(pcap, &iov, 1), TAG, "write pcap file failed");
+    }
+    return pcap_output_flush(pcap);
+}
+
+/* Append data to the write buffer, writing it out first if it doesn't fit */
+static esp_err_t pcap_write_locked(pcap_file_t *pcap, const void *data, size_t length)
+{
+    if (pcap->write_buf_len + length > pcap->write_buf_size) {
+        ESP_RETURN_ON_ERROR(pcap_flush_locked(pcap), TAG, "flush pcap file failed");
+        if (length > pcap->write_buf_size) {
+            pcap_iovec_t iov = { data, length };
+            return pcap_output(pcap, &iov, 1);
+        }
+    }
+    memcpy(pcap->write_buf + pcap->write_buf_len, data, length);
+    pcap->write_buf_len += length;
+    return ESP_OK;
+}
+
+static void pcap_flush_task(void *arg)
+{
+    pcap_file_t *pcap = (pcap_file_t *)arg;
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (pcap->flush_stop) {
+            break;
+        }
+        pcap_flush(pcap);
+    }
+    xSemaphoreGive(pcap->flush_done);
+    vTaskDelete(NULL);
+}
+
+static void pcap_flush_timer_cb(void *arg)
+{
+    pcap_file_t *pcap = (pcap_file_t *)arg;
+    xTaskNotifyGive(pcap->flush_task);
+}
+
+static void pcap_flush_task_stop(pcap_file_t *pcap)
+{
+    pcap->flush_stop = true;
+    xTaskNotifyGive(pcap->flush_task);
+    xSemaphoreTake(pcap->flush_done, portMAX_DELAY);
+    pcap->flush_task = NULL;
+}
+
 esp_err_t pcap_new_session(const pcap_config_t *config, pcap_file_handle_t *ret_pcap)
 {
     esp_err_t ret = ESP_OK;
     pcap_file_t *pcap = NULL;
     ESP_GOTO_ON_FALSE(config && ret_pcap, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
-    ESP_GOTO_ON_FALSE(config->fp, ESP_ERR_INVALID_ARG, err, TAG, "pcap file handle can't be NULL");
+    ESP_GOTO_ON_FALSE(config->fp || (config->sink && config->sink->writev), ESP_ERR_INVALID_ARG, err, TAG,
+                      "pcap file handle and sink can't both be NULL");
     pcap = calloc(1, sizeof(pcap_file_t));
     ESP_GOTO_ON_FALSE(pcap, ESP_ERR_NO_MEM, err, TAG, "no mem for pcap file object");
     pcap->file = config->fp;
+    if (!config->fp) {
+        pcap->sink = *config->sink;
+    }
     pcap->major_version = config->major_version;
     pcap->minor_version = config->minor_version;
     pcap->endian_magic = config->flags.little_endian ? PCAP_MAGIC_LITTLE_ENDIAN : PCAP_MAGIC_BIG_ENDIAN;
     pcap->time_zone = config->time_zone;
+    pcap->pcapng = config->flags.pcapng;
+    pcap->snaplen = PCAP_SNAPLEN;
+    if (config->filter) {
+        const pcap_filter_config_t *filter = config->filter;
+        ESP_GOTO_ON_FALSE(filter->rules || !filter->rule_count, ESP_ERR_INVALID_ARG, err, TAG, "invalid filter rules");
+        if (filter->rules && filter->rule_count) {
+            for (size_t i = 0; i < filter->rule_count; i++) {
+                ESP_GOTO_ON_FALSE(filter->rules[i].length && filter->rules[i].length <= PCAP_FILTER_MAX_MATCH_LEN,
+                                  ESP_ERR_INVALID_ARG, err, TAG, "invalid filter rule length");
+            }
+            // The rules are evaluated in the capture callback, which may run while the flash cache is disabled
+            pcap->filter_rules = heap_caps_malloc(filter->rule_count * sizeof(pcap_filter_rule_t),
+                                                  MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+            ESP_GOTO_ON_FALSE(pcap->filter_rules, ESP_ERR_NO_MEM, err, TAG, "no mem for filter rules");
+            memcpy(pcap->filter_rules, filter->rules, filter->rule_count * sizeof(pcap_filter_rule_t));
+            pcap->filter_rule_count = filter->rule_count;
+            pcap->filter_match_any = filter->match_any;
+        }
+        if (filter->snaplen && filter->snaplen < PCAP_SNAPLEN) {
+            pcap->snaplen = filter->snaplen;
+        }
+    }
+    if (config->write_buf_size) {
+        pcap->write_buf = malloc(config->write_buf_size);
+        ESP_GOTO_ON_FALSE(pcap->write_buf, ESP_ERR_NO_MEM, err, TAG, "no mem for write buffer");
+        pcap->write_buf_size = config->write_buf_size;
+        pcap->lock = xSemaphoreCreateMutex();
+        ESP_GOTO_ON_FALSE(pcap->lock, ESP_ERR_NO_MEM, err, TAG, "no mem for write buffer lock");
+        if (config->flush_interval_ms) {
+            pcap->flush_done = xSemaphoreCreateBinary();
+            ESP_GOTO_ON_FALSE(pcap->flush_done, ESP_ERR_NO_MEM, err, TAG, "no mem for flush task");
+            ESP_GOTO_ON_FALSE(xTaskCreate(pcap_flush_task, "pcap_flush", PCAP_DEFAULT_FLUSH_TASK_STACK_SIZE, pcap,
+                                          uxTaskPriorityGet(NULL), &pcap->flush_task) == pdPASS,
+                              ESP_ERR_NO_MEM, err, TAG, "create flush task failed");
+            const esp_timer_create_args_t timer_args = {
+                .callback = pcap_flush_timer_cb,
+                .arg = pcap,
+                .name = "pcap_flush",
+            };
+            ESP_GOTO_ON_ERROR(esp_timer_create(&timer_args, &pcap->flush_timer), err, TAG, "create flush timer failed");
+            ESP_GOTO_ON_ERROR(esp_timer_start_periodic(pcap->flush_timer, config->flush_interval_ms * 1000ULL), err, TAG,
+                              "start flush timer failed");
+        }
+    }
     *ret_pcap = pcap;
     return ret;
 err:
     if (pcap) {
+        if (pcap->flush_timer) {
+            esp_timer_stop(pcap->flush_timer);
+            esp_timer_delete(pcap->flush_timer);
+        }
+        if (pcap->flush_task) {
+            pcap_flush_task_stop(pcap);
+        }
+        if (pcap->flush_done) {
+            vSemaphoreDelete(pcap->flush_done);
+        }
+        if (pcap->lock) {
+            vSemaphoreDelete(pcap->lock);
+        }
+        free(pcap->write_buf);
+        free(pcap->filter_rules);
         free(pcap);
     }
     return ret;
@@ -82,17 +334,85 @@ err:
 esp_err_t pcap_del_session(pcap_file_handle_t pcap)
 {
     ESP_RETURN_ON_FALSE(pcap, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (pcap->ring) {
+        pcap_capture_ring_stop(pcap);
+    }
+    if (pcap->flush_timer) {
+        esp_timer_stop(pcap->flush_timer);
+        esp_timer_delete(pcap->flush_timer);
+        pcap_flush_task_stop(pcap);
+        vSemaphoreDelete(pcap->flush_done);
+    }
+    if (pcap->write_buf) {
+        pcap_flush(pcap);
+        vSemaphoreDelete(pcap->lock);
+        free(pcap->write_buf);
+    }
     if (pcap->file) {
         fclose(pcap->file);
         pcap->file = NULL;
+    } else if (pcap->sink.close) {
+        pcap->sink.close(pcap->sink.user_ctx);
     }
+    free(pcap->filter_rules);
     free(pcap);
     return ESP_OK;
 }
 
+/* Write a record made of several chunks, through the write buffer if there is one */
+static esp_err_t pcap_write_chunks(pcap_file_t *pcap, const pcap_iovec_t *chunks, size_t count)
+{
+    esp_err_t ret = ESP_OK;
+    if (pcap->write_buf) {
+        xSemaphoreTake(pcap->lock, portMAX_DELAY);
+        for (size_t i = 0; i < count && ret == ESP_OK; i++) {
+            ret = pcap_write_locked(pcap, chunks[i].data, chunks[i].length);
+        }
+        xSemaphoreGive(pcap->lock);
+        return ret;
+    }
+    ESP_RETURN_ON_ERROR(pcap_output(pcap, chunks, count), TAG, "write pcap file failed");
+    /* Flush content in the buffer into device */
+    pcap_output_flush(pcap);
+    return ESP_OK;
+}
+
+static esp_err_t pcapng_write_interface(pcap_file_t *pcap, pcap_link_type_t link_type)
+{
+    pcapng_interface_block_t idb = {
+        .type = PCAPNG_BLOCK_INTERFACE,
+        .total_length = sizeof(pcapng_interface_block_t),
+        .link_type = link_type,
+        .snaplen = pcap->snaplen,
+        .tsresol = { .code = PCAPNG_OPT_IF_TSRESOL, .length = 1, .value = 9 },  // nanoseconds
+        .end_of_options = PCAPNG_OPT_END,
+        .total_length_trailer = sizeof(pcapng_interface_block_t),
+    };
+    pcap_iovec_t chunk = { &idb, sizeof(idb) };
+    return pcap_write_chunks(pcap, &chunk, 1);
+}
+
 esp_err_t pcap_write_header(pcap_file_handle_t pcap, pcap_link_type_t link_type)
 {
     ESP_RETURN_ON_FALSE(pcap, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    /* Save the link type to pcap file object */
+    pcap->link_type = link_type;
+    if (pcap->pcapng) {
+        pcapng_section_header_block_t shb = {
+            .type = PCAPNG_BLOCK_SECTION_HEADER,
+            .total_length = sizeof(pcapng_section_header_block_t),
+            .byte_order_magic = PCAPNG_BYTE_ORDER_MAGIC,
+            .major = 1,
+            .minor = 0,
+            .section_length = -1,   // not specified
+            .total_length_trailer = sizeof(pcapng_section_header_block_t),
+        };
+        pcap_iovec_t chunk = { &shb, sizeof(shb) };
+        ESP_RETURN_ON_ERROR(pcap_write_chunks(pcap, &chunk, 1), TAG, "write pcapng section header failed");
+        ESP_RETURN_ON_ERROR(pcapng_write_interface(pcap, link_type), TAG, "write pcapng interface failed");
+        pcap->interface_count = 1;
+        return ESP_OK;
+    }
     /* Write Pcap File header */
     pcap_file_header_t header = {
         .magic = pcap->endian_magic,
@@ -100,83 +420,450 @@ esp_err_t pcap_write_header(pcap_file_handle_t pcap, pcap_link_type_t link_type)
         .minor = pcap->minor_version,
         .zone = pcap->time_zone,
         .sigfigs = 0,
-        .snaplen = 0x40000,
+        .snaplen = pcap->snaplen,
         .link_type = link_type,
     };
-    size_t real_write = fwrite(&header, sizeof(header), 1, pcap->file);
-    ESP_RETURN_ON_FALSE(real_write == 1, ESP_FAIL, TAG, "write pcap file header failed");
-    /* Save the link type to pcap file object */
-    pcap->link_type = link_type;
-    /* Flush content in the buffer into device */
-    fflush(pcap->file);
+    pcap_iovec_t chunk = { &header, sizeof(header) };
+    ESP_RETURN_ON_ERROR(pcap_write_chunks(pcap, &chunk, 1), TAG, "write pcap file header failed");
     return ESP_OK;
 }
 
-esp_err_t pcap_capture_packet(pcap_file_handle_t pcap, void *payload, uint32_t length, uint32_t seconds, uint32_t microseconds)
+esp_err_t pcap_add_interface(pcap_file_handle_t pcap, pcap_link_type_t link_type, uint32_t *ret_interface_id)
 {
-    ESP_RETURN_ON_FALSE(pcap && payload, ESP_ERR_INVALID_ARG, TAG, "invalid argumnet");
-    size_t real_write = 0;
+    ESP_RETURN_ON_FALSE(pcap && ret_interface_id, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(pcap->pcapng, ESP_ERR_NOT_SUPPORTED, TAG, "only pcapng files have several interfaces");
+    ESP_RETURN_ON_FALSE(pcap->interface_count, ESP_ERR_INVALID_STATE, TAG, "pcapng header not written");
+    ESP_RETURN_ON_ERROR(pcapng_write_interface(pcap, link_type), TAG, "write pcapng interface failed");
+    *ret_interface_id = pcap->interface_count++;
+    return ESP_OK;
+}
+
+static esp_err_t pcap_write_packet(pcap_file_t *pcap, uint32_t interface_id, const void *payload, uint32_t length,
+                                   uint32_t packet_length, uint64_t timestamp_ns)
+{
+    if (pcap->pcapng) {
+        ESP_RETURN_ON_FALSE(interface_id < pcap->interface_count, ESP_ERR_INVALID_ARG, TAG, "invalid interface");
+        static const uint8_t padding[3] = { 0 };
+        uint32_t padding_length = (4 - length % 4) % 4;
+        uint32_t total_length = sizeof(pcapng_packet_block_t) + length + padding_length + sizeof(uint32_t);
+        pcapng_packet_block_t epb = {
+            .type = PCAPNG_BLOCK_ENHANCED_PACKET,
+            .total_length = total_length,
+            .interface_id = interface_id,
+            .timestamp_high = timestamp_ns >> 32,
+            .timestamp_low = (uint32_t)timestamp_ns,
+            .capture_length = length,
+            .packet_length = packet_length,
+        };
+        const pcap_iovec_t chunks[] = {
+            { &epb, sizeof(epb) },
+            { payload, length },
+            { padding, padding_length },
+            { &total_length, sizeof(total_length) },
+        };
+        ESP_RETURN_ON_ERROR(pcap_write_chunks(pcap, chunks, 4), TAG, "write packet failed");
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_FALSE(interface_id == 0, ESP_ERR_INVALID_ARG, TAG, "invalid interface");
     pcap_packet_header_t header = {
-        .seconds = seconds,
-        .microseconds = microseconds,
+        .seconds = timestamp_ns / 1000000000,
+        .microseconds = (timestamp_ns % 1000000000) / 1000,
         .capture_length = length,
-        .packet_length = length
+        .packet_length = packet_length
     };
-    real_write = fwrite(&header, sizeof(header), 1, pcap->file);
-    ESP_RETURN_ON_FALSE(real_write == 1, ESP_FAIL, TAG, "write packet header failed");
-    real_write = fwrite(payload, sizeof(uint8_t), length, pcap->file);
-    ESP_RETURN_ON_FALSE(real_write == length, ESP_FAIL, TAG, "write packet payload failed");
-    /* Flush content in the buffer into device */
-    fflush(pcap->file);
+    const pcap_iovec_t chunks[] = {
+        { &header, sizeof(header) },
+        { payload, length },
+    };
+    ESP_RETURN_ON_ERROR(pcap_write_chunks(pcap, chunks, 2), TAG, "write packet failed");
+    return ESP_OK;
+}
+
+/* Whether the packet passes the capture filter */
+static bool IRAM_ATTR pcap_filter_match(const pcap_file_t *pcap, const uint8_t *payload, uint32_t length)
+{
+    for (size_t i = 0; i < pcap->filter_rule_count; i++) {
+        const pcap_filter_rule_t *rule = &pcap->filter_rules[i];
+        bool match = (uint32_t)rule->offset + rule->length <= length;
+        for (size_t j = 0; match && j < rule->length; j++) {
+            match = (payload[rule->offset + j] & rule->mask[j]) == rule->value[j];
+        }
+        if (rule->negate) {
+            match = !match;
+        }
+        if (match == pcap->filter_match_any) {
+            // First matching rule when any is enough, or first failing rule when all are needed
+            return match;
+        }
+    }
+    return !pcap->filter_match_any || !pcap->filter_rule_count;
+}
+
+esp_err_t pcap_capture_packet(pcap_file_handle_t pcap, void *payload, uint32_t length, uint32_t seconds, uint32_t microseconds)
+{
+    ESP_RETURN_ON_FALSE(pcap && payload, ESP_ERR_INVALID_ARG, TAG, "invalid argumnet");
+    if (!pcap_filter_match(pcap, payload, length)) {
+        return ESP_OK;
+    }
+    return pcap_write_packet(pcap, 0, payload, length < pcap->snaplen ? length : pcap->snaplen, length,
+                             seconds * 1000000000ULL + microseconds * 1000ULL);
+}
+
+esp_err_t pcap_capture_packet_ns(pcap_file_handle_t pcap, uint32_t interface_id, const void *payload, uint32_t length,
+                                 uint64_t timestamp_ns)
+{
+    ESP_RETURN_ON_FALSE(pcap && payload, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (!pcap_filter_match(pcap, payload, length)) {
+        return ESP_OK;
+    }
+    return pcap_write_packet(pcap, interface_id, payload, length < pcap->snaplen ? length : pcap->snaplen, length,
+                             timestamp_ns);
+}
+
+static void pcap_capture_ring_task(void *arg)
+{
+    pcap_file_t *pcap = (pcap_file_t *)arg;
+    pcap_capture_ring_t *ring = pcap->ring;
+    while (1) {
+        // Sample the flag before draining: once it's set, nothing more is enqueued and an empty ring means done
+        bool stop = ring->stop;
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        while (tail != atomic_load_explicit(&ring->head, memory_order_acquire)) {
+            pcap_ring_slot_t *slot = (pcap_ring_slot_t *)(ring->slots + tail * ring->slot_size);
+            int64_t time_us = slot->time_us + ring->time_offset_us;
+            if (pcap_write_packet(pcap, 0, slot->data, slot->capture_length, slot->packet_length,
+                                  time_us * 1000ULL) != ESP_OK) {
+                ring->stats.write_errors++;
+            }
+            tail = (tail + 1 == ring->slot_count) ? 0 : tail + 1;
+            atomic_store_explicit(&ring->tail, tail, memory_order_release);
+        }
+        if (stop) {
+            break;
+        }
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(PCAP_RING_POLL_MS));
+    }
+    xSemaphoreGive(ring->done);
+    vTaskDelete(NULL);
+}
+
+static void pcap_capture_ring_free(pcap_capture_ring_t *ring)
+{
+    if (ring->done) {
+        vSemaphoreDelete(ring->done);
+    }
+    free(ring->slots);
+    free(ring);
+}
+
+esp_err_t pcap_capture_ring_start(pcap_file_handle_t pcap, const pcap_capture_ring_config_t *config)
+{
+    esp_err_t ret = ESP_OK;
+    pcap_capture_ring_t *ring = NULL;
+    ESP_RETURN_ON_FALSE(pcap && config && config->slot_count && config->snaplen, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!pcap->ring, ESP_ERR_INVALID_STATE, TAG, "capture ring already started");
+    ring = calloc(1, sizeof(pcap_capture_ring_t));
+    ESP_RETURN_ON_FALSE(ring, ESP_ERR_NO_MEM, TAG, "no mem for capture ring");
+    // One slot stays empty to tell a full ring from an empty one
+    ring->slot_count = config->slot_count + 1;
+    ring->snaplen = config->snaplen < pcap->snaplen ? config->snaplen : pcap->snaplen;
+    ring->slot_size = (sizeof(pcap_ring_slot_t) + ring->snaplen + 7) & ~7;
+    // The slots are written from the capture callback, which may run while the flash cache is disabled
+    ring->slots = heap_caps_malloc(ring->slot_count * ring->slot_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_GOTO_ON_FALSE(ring->slots, ESP_ERR_NO_MEM, err, TAG, "no mem for capture ring slots");
+    ring->done = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(ring->done, ESP_ERR_NO_MEM, err, TAG, "no mem for capture ring");
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    // Slots are stamped with esp_timer_get_time(), which can be read from an ISR, and converted to wall clock time here
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    ring->time_offset_us = (int64_t)now.tv_sec * 1000000 + now.tv_usec - esp_timer_get_time();
+
+    pcap->ring = ring;
+    uint32_t stack_size = config->task_stack_size ? config->task_stack_size : PCAP_DEFAULT_RING_TASK_STACK_SIZE;
+    UBaseType_t priority = config->task_priority ? config->task_priority : uxTaskPriorityGet(NULL);
+    ESP_GOTO_ON_FALSE(xTaskCreatePinnedToCore(pcap_capture_ring_task, "pcap_ring", stack_size, pcap, priority, &ring->task,
+                                              config->task_core_id) == pdPASS, ESP_ERR_NO_MEM, err, TAG, "create writer task failed");
+    return ESP_OK;
+err:
+    pcap->ring = NULL;
+    pcap_capture_ring_free(ring);
+    return ret;
+}
+
+esp_err_t pcap_capture_ring_stop(pcap_file_handle_t pcap)
+{
+    ESP_RETURN_ON_FALSE(pcap, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(pcap->ring, ESP_ERR_INVALID_STATE, TAG, "capture ring not started");
+    pcap_capture_ring_t *ring = pcap->ring;
+    ring->stop = true;
+    xTaskNotifyGive(ring->task);
+    xSemaphoreTake(ring->done, portMAX_DELAY);
+    pcap->ring = NULL;
+    pcap_capture_ring_free(ring);
+    return ESP_OK;
+}
+
+esp_err_t IRAM_ATTR pcap_capture_packet_from_isr(pcap_file_handle_t pcap, const void *payload, uint32_t length)
+{
+    if (!pcap || !pcap->ring || !payload) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pcap_capture_ring_t *ring = pcap->ring;
+    // Filter before anything is copied, so that uninteresting traffic doesn't take ring slots
+    if (!pcap_filter_match(pcap, payload, length)) {
+        ring->stats.filtered++;
+        return ESP_OK;
+    }
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t next = (head + 1 == ring->slot_count) ? 0 : head + 1;
+    if (next == atomic_load_explicit(&ring->tail, memory_order_acquire)) {
+        ring->stats.dropped++;
+        return ESP_ERR_NO_MEM;
+    }
+    pcap_ring_slot_t *slot = (pcap_ring_slot_t *)(ring->slots + head * ring->slot_size);
+    slot->time_us = esp_timer_get_time();
+    slot->packet_length = length;
+    slot->capture_length = length < ring->snaplen ? length : ring->snaplen;
+    memcpy(slot->data, payload, slot->capture_length);
+    atomic_store_explicit(&ring->head, next, memory_order_release);
+    ring->stats.captured++;
+    if (slot->capture_length < length) {
+        ring->stats.truncated++;
+    }
+
+    if (xPortInIsrContext()) {
+        BaseType_t need_yield = pdFALSE;
+        vTaskNotifyGiveFromISR(ring->task, &need_yield);
+        if (need_yield) {
+            portYIELD_FROM_ISR();
+        }
+    } else {
+        xTaskNotifyGive(ring->task);
+    }
+    return ESP_OK;
+}
+
+esp_err_t pcap_get_capture_ring_stats(pcap_file_handle_t pcap, pcap_capture_ring_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(pcap && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(pcap->ring, ESP_ERR_INVALID_STATE, TAG, "capture ring not started");
+    *stats = pcap->ring->stats;
+    return ESP_OK;
+}
+
+esp_err_t pcap_flush(pcap_file_handle_t pcap)
+{
+    ESP_RETURN_ON_FALSE(pcap, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (!pcap->write_buf) {
+        return pcap_output_flush(pcap);
+    }
+    xSemaphoreTake(pcap->lock, portMAX_DELAY);
+    esp_err_t ret = pcap_flush_locked(pcap);
+    xSemaphoreGive(pcap->lock);
+    return ret;
+}
+
+/**
+ * @brief Pcap Reader Handle
+ *
+ */
+struct pcap_reader_t {
+    FILE *file;                 /*!< File being read */
+    pcap_reader_info_t info;    /*!< File header */
+    uint8_t *buf;               /*!< Payload buffer, NULL if payloads are skipped */
+    size_t buf_size;            /*!< Size of the payload buffer */
+    long next_offset;           /*!< File offset of the next packet */
+    uint32_t next_index;        /*!< Index of the next packet */
+    bool build_index;           /*!< Whether packet offsets are recorded */
+    long *offsets;              /*!< File offsets of the packets indexed */
+    uint32_t indexed;           /*!< Number of packets indexed */
+    uint32_t offsets_size;      /*!< Capacity of the offsets array */
+};
+
+esp_err_t pcap_reader_open(const pcap_reader_config_t *config, pcap_reader_handle_t *ret_reader)
+{
+    esp_err_t ret = ESP_OK;
+    pcap_reader_t *reader = NULL;
+    ESP_GOTO_ON_FALSE(config && config->fp && ret_reader, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    reader = calloc(1, sizeof(pcap_reader_t));
+    ESP_GOTO_ON_FALSE(reader, ESP_ERR_NO_MEM, err, TAG, "no mem for pcap reader");
+    if (config->buf_size) {
+        reader->buf = malloc(config->buf_size);
+        ESP_GOTO_ON_FALSE(reader->buf, ESP_ERR_NO_MEM, err, TAG, "no mem for pcap reader buffer");
+        reader->buf_size = config->buf_size;
+    }
+    reader->file = config->fp;
+    reader->build_index = config->flags.build_index;
+    pcap_file_header_t file_header;
+    size_t real_read = fread(&file_header, 1, sizeof(pcap_file_header_t), reader->file);
+    ESP_GOTO_ON_FALSE(real_read, ESP_ERR_NOT_FOUND, err, TAG, "pcap file is empty");
+    ESP_GOTO_ON_FALSE(real_read == sizeof(pcap_file_header_t), ESP_FAIL, err, TAG, "read pcap file header failed");
+    ESP_GOTO_ON_FALSE(file_header.magic == PCAP_MAGIC_BIG_ENDIAN || file_header.magic == PCAP_MAGIC_LITTLE_ENDIAN,
+                      ESP_ERR_NOT_SUPPORTED, err, TAG, "not a pcap file");
+    reader->info.magic = file_header.magic;
+    reader->info.major_version = file_header.major;
+    reader->info.minor_version = file_header.minor;
+    reader->info.snaplen = file_header.snaplen;
+    reader->info.link_type = file_header.link_type;
+    reader->next_offset = ftell(reader->file);
+    *ret_reader = reader;
+    return ESP_OK;
+err:
+    if (reader) {
+        free(reader->buf);
+        free(reader);
+    }
+    return ret;
+}
+
+esp_err_t pcap_reader_get_info(pcap_reader_handle_t reader, pcap_reader_info_t *info)
+{
+    ESP_RETURN_ON_FALSE(reader && info, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    *info = reader->info;
+    return ESP_OK;
+}
+
+/* Read the header of the next packet and its payload into the buffer if requested, skip the rest */
+static esp_err_t pcap_reader_step(pcap_reader_t *reader, pcap_reader_packet_t *packet, bool read_payload)
+{
+    pcap_packet_header_t header;
+    size_t real_read = fread(&header, 1, sizeof(pcap_packet_header_t), reader->file);
+    if (!real_read) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    ESP_RETURN_ON_FALSE(real_read == sizeof(pcap_packet_header_t), ESP_FAIL, TAG, "read pcap packet header failed");
+    if (reader->build_index && reader->next_index == reader->indexed) {
+        if (reader->indexed == reader->offsets_size) {
+            // Grow geometrically, so that indexing takes few allocations
+            uint32_t size = reader->offsets_size ? reader->offsets_size * 2 : 64;
+            long *offsets = realloc(reader->offsets, size * sizeof(long));
+            ESP_RETURN_ON_FALSE(offsets, ESP_ERR_NO_MEM, TAG, "no mem for pcap index");
+            reader->offsets = offsets;
+            reader->offsets_size = size;
+        }
+        reader->offsets[reader->indexed++] = reader->next_offset;
+    }
+    size_t payload_length = 0;
+    if (read_payload) {
+        payload_length = header.capture_length < reader->buf_size ? header.capture_length : reader->buf_size;
+        real_read = fread(reader->buf, 1, payload_length, reader->file);
+        ESP_RETURN_ON_FALSE(real_read == payload_length, ESP_FAIL, TAG, "read payload error");
+    }
+    if (header.capture_length > payload_length) {
+        ESP_RETURN_ON_FALSE(fseek(reader->file, header.capture_length - payload_length, SEEK_CUR) == 0, ESP_FAIL, TAG,
+                            "skip payload error");
+    }
+    if (packet) {
+        packet->index = reader->next_index;
+        packet->seconds = header.seconds;
+        packet->microseconds = header.microseconds;
+        packet->capture_length = header.capture_length;
+        packet->packet_length = header.packet_length;
+        packet->payload = payload_length ? reader->buf : NULL;
+        packet->payload_length = payload_length;
+    }
+    reader->next_offset += sizeof(pcap_packet_header_t) + header.capture_length;
+    reader->next_index++;
+    return ESP_OK;
+}
+
+esp_err_t pcap_reader_next(pcap_reader_handle_t reader, pcap_reader_packet_t *packet)
+{
+    ESP_RETURN_ON_FALSE(reader && packet, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    return pcap_reader_step(reader, packet, reader->buf != NULL);
+}
+
+esp_err_t pcap_reader_seek(pcap_reader_handle_t reader, uint32_t index)
+{
+    ESP_RETURN_ON_FALSE(reader, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(reader->build_index, ESP_ERR_INVALID_STATE, TAG, "reader doesn't build an index");
+    ESP_RETURN_ON_FALSE(index < reader->indexed, ESP_ERR_NOT_FOUND, TAG, "packet not indexed");
+    ESP_RETURN_ON_FALSE(fseek(reader->file, reader->offsets[index], SEEK_SET) == 0, ESP_FAIL, TAG, "seek failed");
+    reader->next_offset = reader->offsets[index];
+    reader->next_index = index;
+    return ESP_OK;
+}
+
+esp_err_t pcap_reader_build_index(pcap_reader_handle_t reader, uint32_t *ret_packet_count)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(reader, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(reader->build_index, ESP_ERR_INVALID_STATE, TAG, "reader doesn't build an index");
+    long saved_offset = reader->next_offset;
+    uint32_t saved_index = reader->next_index;
+    // Resume after the last packet indexed
+    if (reader->indexed && reader->indexed > reader->next_index) {
+        ESP_RETURN_ON_ERROR(pcap_reader_seek(reader, reader->indexed - 1), TAG, "seek failed");
+        ESP_RETURN_ON_ERROR(pcap_reader_step(reader, NULL, false), TAG, "read packet failed");
+    }
+    while ((ret = pcap_reader_step(reader, NULL, false)) == ESP_OK) {
+    }
+    ESP_RETURN_ON_FALSE(ret == ESP_ERR_NOT_FOUND, ret, TAG, "read packet failed");
+    ESP_RETURN_ON_FALSE(fseek(reader->file, saved_offset, SEEK_SET) == 0, ESP_FAIL, TAG, "seek failed");
+    reader->next_offset = saved_offset;
+    reader->next_index = saved_index;
+    if (ret_packet_count) {
+        *ret_packet_count = reader->indexed;
+    }
+    return ESP_OK;
+}
+
+esp_err_t pcap_reader_close(pcap_reader_handle_t reader)
+{
+    ESP_RETURN_ON_FALSE(reader, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(reader->offsets);
+    free(reader->buf);
+    free(reader);
     return ESP_OK;
 }
 
 esp_err_t pcap_print_summary(pcap_file_handle_t pcap, FILE *print_file)
 {
     esp_err_t ret = ESP_OK;
-    long size = 0;
-    char *packet_payload = NULL;
+    pcap_reader_handle_t reader = NULL;
     ESP_RETURN_ON_FALSE(pcap && print_file, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
-    // get file size
-    fseek(pcap->file, 0L, SEEK_END);
-    size = ftell(pcap->file);
+    ESP_RETURN_ON_FALSE(!pcap->pcapng, ESP_ERR_NOT_SUPPORTED, TAG, "summary of pcapng files is not supported");
+    ESP_RETURN_ON_FALSE(pcap->file, ESP_ERR_NOT_SUPPORTED, TAG, "summary is only available for files");
+    ESP_RETURN_ON_ERROR(pcap_flush(pcap), TAG, "flush pcap file failed");
     fseek(pcap->file, 0L, SEEK_SET);
+    // Only the link layer addresses are printed, so the rest of the payloads is skipped
+    const pcap_reader_config_t reader_config = {
+        .fp = pcap->file,
+        .buf_size = 16,
+    };
+    ret = pcap_reader_open(&reader_config, &reader);
     // file empty is allowed, so return ESP_OK
-    ESP_RETURN_ON_FALSE(size, ESP_OK, TAG, "pcap file is empty");
-    // packet index (by bytes)
-    uint32_t index = 0;
-    pcap_file_header_t file_header;
-    size_t real_read = fread(&file_header, sizeof(pcap_file_header_t), 1, pcap->file);
-    ESP_RETURN_ON_FALSE(real_read == 1, ESP_FAIL, TAG, "read pcap file header failed");
-    index += sizeof(pcap_file_header_t);
+    if (ret == ESP_ERR_NOT_FOUND) {
+        fseek(pcap->file, 0L, SEEK_END);
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_ERROR(ret, TAG, "read pcap file header failed");
+    pcap_reader_info_t file_header;
+    pcap_reader_get_info(reader, &file_header);
     //print pcap header information
     fprintf(print_file, "------------------------------------------------------------------------\n");
     fprintf(print_file, "Pcap packet Head:\n");
     fprintf(print_file, "------------------------------------------------------------------------\n");
     fprintf(print_file, "Magic Number: %"PRIx32"\n", file_header.magic);
-    fprintf(print_file, "Major Version: %d\n", file_header.major);
-    fprintf(print_file, "Minor Version: %d\n", file_header.minor);
+    fprintf(print_file, "Major Version: %d\n", file_header.major_version);
+    fprintf(print_file, "Minor Version: %d\n", file_header.minor_version);
     fprintf(print_file, "SnapLen: %"PRIu32"\n", file_header.snaplen);
     fprintf(print_file, "LinkType: %"PRIu32"\n", file_header.link_type);
     fprintf(print_file, "------------------------------------------------------------------------\n");
     uint32_t packet_num = 0;
-    pcap_packet_header_t packet_header;
-    while (index < size) {
-        real_read = fread(&packet_header, sizeof(pcap_packet_header_t), 1, pcap->file);
-        ESP_GOTO_ON_FALSE(real_read == 1, ESP_FAIL, err, TAG, "read pcap packet header failed");
+    pcap_reader_packet_t packet;
+    while ((ret = pcap_reader_next(reader, &packet)) == ESP_OK) {
+        const uint8_t *packet_payload = packet.payload;
         // print packet header information
         fprintf(print_file, "Packet %"PRIu32":\n", packet_num);
-        fprintf(print_file, "Timestamp (Seconds): %"PRIu32"\n", packet_header.seconds);
-        fprintf(print_file, "Timestamp (Microseconds): %"PRIu32"\n", packet_header.microseconds);
-        fprintf(print_file, "Capture Length: %"PRIu32"\n", packet_header.capture_length);
-        fprintf(print_file, "Packet Length: %"PRIu32"\n", packet_header.packet_length);
-        size_t payload_length = packet_header.capture_length;
-        packet_payload = malloc(payload_length);
-        ESP_GOTO_ON_FALSE(packet_payload, ESP_ERR_NO_MEM, err, TAG, "no mem to save packet payload");
-        real_read = fread(packet_payload, payload_length, 1, pcap->file);
-        ESP_GOTO_ON_FALSE(real_read == 1, ESP_FAIL, err, TAG, "read payload error");
+        fprintf(print_file, "Timestamp (Seconds): %"PRIu32"\n", packet.seconds);
+        fprintf(print_file, "Timestamp (Microseconds): %"PRIu32"\n", packet.microseconds);
+        fprintf(print_file, "Capture Length: %"PRIu32"\n", packet.capture_length);
+        fprintf(print_file, "Packet Length: %"PRIu32"\n", packet.packet_length);
         // print packet information
-        if (file_header.link_type == PCAP_LINK_TYPE_802_11) {
+        if (file_header.link_type == PCAP_LINK_TYPE_802_11 && packet.payload_length >= 16) {
             // Frame Control Field is coded as LSB first
             fprintf(print_file, "Frame Type: %2x\n", (packet_payload[0] >> 2) & 0x03);
             fprintf(print_file, "Frame Subtype: %2x\n", (packet_payload[0] >> 4) & 0x0F);
@@ -191,7 +878,7 @@ esp_err_t pcap_print_summary(pcap_file_handle_t pcap, FILE *print_file)
             }
             fprintf(print_file, "%2x\n", packet_payload[15]);
             fprintf(print_file, "------------------------------------------------------------------------\n");
-        } else if (file_header.link_type == PCAP_LINK_TYPE_ETHERNET) {
+        } else if (file_header.link_type == PCAP_LINK_TYPE_ETHERNET && packet.payload_length >= 14) {
             fprintf(print_file, "Destination: ");
             for (int j = 0; j < 5; j++) {
                 fprintf(print_file, "%2x ", packet_payload[j]);
@@ -204,21 +891,20 @@ esp_err_t pcap_print_summary(pcap_file_handle_t pcap, FILE *print_file)
             fprintf(print_file, "%2x\n", packet_payload[11]);
             fprintf(print_file, "Type: 0x%x\n", packet_payload[13] | (packet_payload[12] << 8));
             fprintf(print_file, "------------------------------------------------------------------------\n");
+        } else if (file_header.link_type == PCAP_LINK_TYPE_802_11 || file_header.link_type == PCAP_LINK_TYPE_ETHERNET) {
+            fprintf(print_file, "Truncated packet\n");
+            fprintf(print_file, "------------------------------------------------------------------------\n");
         } else {
             fprintf(print_file, "Unknown link type:%"PRIu32"\n", file_header.link_type);
             fprintf(print_file, "------------------------------------------------------------------------\n");
         }
-        free(packet_payload);
-        packet_payload = NULL;
-        index += packet_header.capture_length + sizeof(pcap_packet_header_t);
         packet_num ++;
     }
+    pcap_reader_close(reader);
+    // Leave the file positioned at its end, for the next packets written
+    fseek(pcap->file, 0L, SEEK_END);
+    ESP_RETURN_ON_FALSE(ret == ESP_ERR_NOT_FOUND, ESP_FAIL, TAG, "read pcap packet failed");
     fprintf(print_file, "Pcap packet Number: %"PRIu32"\n", packet_num);
     fprintf(print_file, "------------------------------------------------------------------------\n");
-    return ret;
-err:
-    if (packet_payload) {
-        free(packet_payload);
-    }
-    return ret;
+    return ESP_OK;
 }
@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include "esp_log.h"
+#include "esp_check.h"
+#include "pcap.h"
+
+static const char *TAG = "pcap";
+
+#define PCAP_SOCKET_SINK_MAX_IOV 8 /*!< Max number of buffers sent with one sendmsg() call */
+
+typedef struct {
+    int sock;           /*!< Connected socket */
+    int timeout_ms;     /*!< Longest wait for the socket to accept more data */
+} pcap_socket_sink_t;
+
+static esp_err_t pcap_socket_sink_writev(const pcap_iovec_t *iov, size_t count, void *user_ctx)
+{
+    pcap_socket_sink_t *sink = (pcap_socket_sink_t *)user_ctx;
+    struct iovec msg_iov[PCAP_SOCKET_SINK_MAX_IOV];
+    ESP_RETURN_ON_FALSE(count <= PCAP_SOCKET_SINK_MAX_IOV, ESP_ERR_INVALID_SIZE, TAG, "too many buffers");
+    for (size_t i = 0; i < count; i++) {
+        msg_iov[i].iov_base = (void *)iov[i].data;
+        msg_iov[i].iov_len = iov[i].length;
+    }
+    struct msghdr msg = {
+        .msg_iov = msg_iov,
+        .msg_iovlen = count,
+    };
+    while (msg.msg_iovlen) {
+        ssize_t sent = sendmsg(sink->sock, &msg, 0);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ESP_RETURN_ON_FALSE(errno == EAGAIN || errno == EWOULDBLOCK, ESP_FAIL, TAG, "send failed, errno %d", errno);
+            // Non-blocking socket with a full send buffer: sleep until it drains instead of spinning on sendmsg()
+            struct pollfd pfd = {
+                .fd = sink->sock,
+                .events = POLLOUT,
+            };
+            int ready = poll(&pfd, 1, sink->timeout_ms);
+            if (ready < 0) {
+                ESP_RETURN_ON_FALSE(errno == EINTR, ESP_FAIL, TAG, "poll failed, errno %d", errno);
+            }
+            ESP_RETURN_ON_FALSE(ready != 0, ESP_ERR_TIMEOUT, TAG, "send timed out");
+            continue;
+        }
+        // A stream socket may take part of the data only, skip what has been sent
+        while (msg.msg_iovlen && (size_t)sent >= msg.msg_iov->iov_len) {
+            sent -= msg.msg_iov->iov_len;
+            msg.msg_iov++;
+            msg.msg_iovlen--;
+        }
+        if (msg.msg_iovlen) {
+            msg.msg_iov->iov_base = (uint8_t *)msg.msg_iov->iov_base + sent;
+            msg.msg_iov->iov_len -= sent;
+        }
+    }
+    return ESP_OK;
+}
+
+static void pcap_socket_sink_close(void *user_ctx)
+{
+    pcap_socket_sink_t *sink = (pcap_socket_sink_t *)user_ctx;
+    close(sink->sock);
+    free(sink);
+}
+
+esp_err_t pcap_new_socket_sink(const pcap_socket_sink_config_t *config, pcap_sink_t *ret_sink)
+{
+    ESP_RETURN_ON_FALSE(config && ret_sink && config->sock >= 0, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    pcap_socket_sink_t *sink = calloc(1, sizeof(pcap_socket_sink_t));
+    ESP_RETURN_ON_FALSE(sink, ESP_ERR_NO_MEM, TAG, "no mem for socket sink");
+    sink->sock = config->sock;
+    sink->timeout_ms = config->send_timeout_ms ? config->send_timeout_ms : PCAP_SOCKET_SINK_DEFAULT_SEND_TIMEOUT_MS;
+    ret_sink->writev = pcap_socket_sink_writev;
+    ret_sink->close = pcap_socket_sink_close;
+    ret_sink->user_ctx = sink;
+    return ESP_OK;
+}
@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "esp_err.h"
 
 #ifdef __cplusplus
@@ -75,6 +78,10 @@ esp_err_t pid_del_control_block(pid_ctrl_block_handle_t pid);
 /**
  * @brief Update PID parameters
  *
+ * @note The parameters are written to a second parameter set, which `pid_compute()` switches to atomically at its next call.
+ *       So it can be called from a task while `pid_compute()` runs in an ISR of higher priority or on the other core,
+ *       but not concurrently with itself.
+ *
  * @param[in] pid PID control block handle, created by `pid_new_control_block()`
  * @param[in] params PID parameters
  * @return
@@ -86,6 +93,8 @@ esp_err_t pid_update_parameters(pid_ctrl_block_handle_t pid, const pid_ctrl_para
 /**
  * @brief Input error and get PID control result
  *
+ * @note Can be called from ISR. Placed in IRAM if CONFIG_PID_CTRL_FUNC_IN_IRAM is enabled.
+ *
  * @param[in] pid PID control block handle, created by `pid_new_control_block()`
  * @param[in] input_error error data that feed to the PID controller
  * @param[out] ret_result result after PID calculation
@@ -105,6 +114,291 @@ esp_err_t pid_compute(pid_ctrl_block_handle_t pid, float input_error, float *ret
  */
 esp_err_t pid_reset_ctrl_block(pid_ctrl_block_handle_t pid);
 
+/**
+ * @brief Type of PID control bank handle
+ *
+ */
+typedef struct pid_ctrl_bank_t *pid_ctrl_bank_handle_t;
+
+/**
+ * @brief PID control bank configuration
+ *
+ */
+typedef struct {
+    size_t num_channels;           // Number of PID controllers in the bank
+    pid_calculate_type_t cal_type; // PID calculation type of all controllers
+} pid_ctrl_bank_config_t;
+
+/**
+ * @brief Create a bank of PID controllers, computed all at once
+ *
+ * @note Parameters and states of the controllers are stored in one array per field,
+ *       and all controllers are computed in one loop without indirect calls.
+ *       All parameters are zero after creation, set them by `pid_bank_update_parameters()`.
+ *
+ * @param[in] config PID control bank configuration
+ * @param[out] ret_bank Returned PID control bank handle
+ * @return
+ *      - ESP_OK: Created PID control bank successfully
+ *      - ESP_ERR_INVALID_ARG: Created PID control bank failed because of invalid argument
+ *      - ESP_ERR_NO_MEM: Created PID control bank failed because out of memory
+ */
+esp_err_t pid_new_control_bank(const pid_ctrl_bank_config_t *config, pid_ctrl_bank_handle_t *ret_bank);
+
+/**
+ * @brief Delete the PID control bank
+ *
+ * @param[in] bank PID control bank handle, created by `pid_new_control_bank()`
+ * @return
+ *      - ESP_OK: Delete PID control bank successfully
+ *      - ESP_ERR_INVALID_ARG: Delete PID control bank failed because of invalid argument
+ */
+esp_err_t pid_del_control_bank(pid_ctrl_bank_handle_t bank);
+
+/**
+ * @brief Update PID parameters of one controller of the bank
+ *
+ * @param[in] bank PID control bank handle, created by `pid_new_control_bank()`
+ * @param[in] channel Index of the controller
+ * @param[in] params PID parameters, the calculation type must be the one of the bank
+ * @return
+ *      - ESP_OK: Update PID parameters successfully
+ *      - ESP_ERR_INVALID_ARG: Update PID parameters failed because of invalid argument
+ */
+esp_err_t pid_bank_update_parameters(pid_ctrl_bank_handle_t bank, size_t channel, const pid_ctrl_parameter_t *params);
+
+/**
+ * @brief Input errors of all controllers of the bank and get their results
+ *
+ * @param[in] bank PID control bank handle, created by `pid_new_control_bank()`
+ * @param[in] input_errors errors fed to the controllers, `num_channels` items
+ * @param[out] ret_results results after PID calculation, `num_channels` items, must not overlap input_errors
+ * @return
+ *      - ESP_OK: Run PID computes successfully
+ *      - ESP_ERR_INVALID_ARG: Run PID computes failed because of invalid argument
+ */
+esp_err_t pid_bank_compute(pid_ctrl_bank_handle_t bank, const float *input_errors, float *ret_results);
+
+/**
+ * @brief Reset the accumulation of all controllers of the bank
+ *
+ * @param[in] bank PID control bank handle, created by `pid_new_control_bank()`
+ * @return
+ *      - ESP_OK: Reset successfully
+ *      - ESP_ERR_INVALID_ARG: Reset failed because of invalid argument
+ */
+esp_err_t pid_bank_reset(pid_ctrl_bank_handle_t bank);
+
+/**
+ * @brief Fixed-point format of a PID control block
+ *
+ */
+typedef enum {
+    PID_IQ_FORMAT_IQ24, /*!< 24 fractional bits, values in range [-128, 128) */
+    PID_IQ_FORMAT_IQ16, /*!< 16 fractional bits, values in range [-32768, 32768) */
+} pid_iq_format_t;
+
+/**
+ * @brief Type of fixed-point PID control block handle
+ *
+ */
+typedef struct pid_ctrl_iq_block_t *pid_ctrl_iq_block_handle_t;
+
+/**
+ * @brief Fixed-point PID control configuration
+ *
+ */
+typedef struct {
+    pid_ctrl_parameter_t init_param; // Initial parameters, converted to iq_format
+    pid_iq_format_t iq_format;       // Fixed-point format of parameters, errors and results
+} pid_ctrl_iq_config_t;
+
+/**
+ * @brief Create a new fixed-point PID control session, returns the handle of control block
+ *
+ * @note Computed by IQmath integer arithmetic with saturation, for targets without FPU.
+ *       Errors and results are IQ numbers (e.g. `_IQ24(x)`) in the format of the block.
+ *
+ * @param[in] config Fixed-point PID control configuration
+ * @param[out] ret_pid Returned fixed-point PID control block handle
+ * @return
+ *      - ESP_OK: Created PID control block successfully
+ *      - ESP_ERR_INVALID_ARG: Created PID control block failed because of invalid argument, or a parameter out of range of the format
+ *      - ESP_ERR_NO_MEM: Created PID control block failed because out of memory
+ */
+esp_err_t pid_new_iq_control_block(const pid_ctrl_iq_config_t *config, pid_ctrl_iq_block_handle_t *ret_pid);
+
+/**
+ * @brief Delete the fixed-point PID control block
+ *
+ * @param[in] pid Fixed-point PID control block handle, created by `pid_new_iq_control_block()`
+ * @return
+ *      - ESP_OK: Delete PID control block successfully
+ *      - ESP_ERR_INVALID_ARG: Delete PID control block failed because of invalid argument
+ */
+esp_err_t pid_del_iq_control_block(pid_ctrl_iq_block_handle_t pid);
+
+/**
+ * @brief Update parameters of the fixed-point PID control block
+ *
+ * @param[in] pid Fixed-point PID control block handle, created by `pid_new_iq_control_block()`
+ * @param[in] params PID parameters, converted to the format of the block
+ * @return
+ *      - ESP_OK: Update PID parameters successfully
+ *      - ESP_ERR_INVALID_ARG: Update PID parameters failed because of invalid argument, or a parameter out of range of the format
+ */
+esp_err_t pid_iq_update_parameters(pid_ctrl_iq_block_handle_t pid, const pid_ctrl_parameter_t *params);
+
+/**
+ * @brief Input error and get fixed-point PID control result
+ *
+ * @param[in] pid Fixed-point PID control block handle, created by `pid_new_iq_control_block()`
+ * @param[in] input_error error data that feed to the PID controller, in the format of the block
+ * @param[out] ret_result result after PID calculation, in the format of the block
+ * @return
+ *      - ESP_OK: Run a PID compute successfully
+ *      - ESP_ERR_INVALID_ARG: Run a PID compute failed because of invalid argument
+ */
+esp_err_t pid_iq_compute(pid_ctrl_iq_block_handle_t pid, int32_t input_error, int32_t *ret_result);
+
+/**
+ * @brief Reset the accumulation in fixed-point PID control block
+ *
+ * @param[in] pid Fixed-point PID control block handle, created by `pid_new_iq_control_block()`
+ * @return
+ *      - ESP_OK: Reset successfully
+ *      - ESP_ERR_INVALID_ARG: Reset failed because of invalid argument
+ */
+esp_err_t pid_iq_reset_ctrl_block(pid_ctrl_iq_block_handle_t pid);
+
+/**
+ * @brief Performance metrics of a PID control block
+ *
+ */
+typedef struct {
+    float iae;                 // Integral of absolute error, sum of |e(k)|, multiply by the control period to get it in time units
+    float overshoot;           // Largest error past the setpoint, relative to the first error, e.g. 0.1 for 10%
+    uint32_t settling_samples; // Samples until the error stayed within the settle band
+    uint32_t samples;          // Samples computed since the metrics were started
+    bool settled;              // Whether the last error is within the settle band
+} pid_ctrl_metrics_t;
+
+/**
+ * @brief Start tracking performance metrics of the PID control block, e.g. after a setpoint change
+ *
+ * @note The first error computed after this call is taken as the initial error of the step response.
+ *
+ * @param[in] pid PID control block handle, created by `pid_new_control_block()`
+ * @param[in] settle_band error band of a settled loop, relative to the initial error, e.g. 0.02 for 2%
+ * @return
+ *      - ESP_OK: Start tracking metrics successfully
+ *      - ESP_ERR_INVALID_ARG: Start tracking metrics failed because of invalid argument
+ */
+esp_err_t pid_start_metrics(pid_ctrl_block_handle_t pid, float settle_band);
+
+/**
+ * @brief Get performance metrics of the PID control block
+ *
+ * @param[in] pid PID control block handle, created by `pid_new_control_block()`
+ * @param[out] ret_metrics Returned metrics, since `pid_start_metrics()`
+ * @return
+ *      - ESP_OK: Get metrics successfully
+ *      - ESP_ERR_INVALID_ARG: Get metrics failed because of invalid argument
+ */
+esp_err_t pid_get_metrics(pid_ctrl_block_handle_t pid, pid_ctrl_metrics_t *ret_metrics);
+
+/**
+ * @brief PID tuning rule, computing gains from the ultimate gain and period
+ *
+ */
+typedef enum {
+    PID_AUTOTUNE_RULE_ZIEGLER_NICHOLS, /*!< Classic Ziegler-Nichols: Kp = 0.6Ku, Ti = Tu/2, Td = Tu/8 */
+    PID_AUTOTUNE_RULE_TYREUS_LUYBEN,   /*!< Tyreus-Luyben, less overshoot: Kp = Ku/2.2, Ti = 2.2Tu, Td = Tu/6.3 */
+} pid_autotune_rule_t;
+
+/**
+ * @brief Type of PID auto-tuner handle
+ *
+ */
+typedef struct pid_autotune_t *pid_autotune_handle_t;
+
+/**
+ * @brief PID auto-tuner configuration
+ *
+ */
+typedef struct {
+    float setpoint;                 // Process value around which the process oscillates
+    float output_bias;              // Output around which the relay switches, e.g. the output holding the process near setpoint
+    float relay_amplitude;          // Relay output is output_bias +/- relay_amplitude
+    float hysteresis;               // Hysteresis of the relay, above the noise of the process value
+    float sample_period_s;          // Control period of the PID control block, in seconds
+    uint32_t num_cycles;            // Oscillation cycles averaged, after the first one
+    uint32_t max_samples;           // Samples after which the experiment fails, 0 for no limit
+    pid_autotune_rule_t rule;       // Tuning rule
+    pid_ctrl_parameter_t base_param; // Limits and calculation type copied to the proposed parameters
+} pid_autotune_config_t;
+
+/**
+ * @brief Result of PID auto-tuning
+ *
+ */
+typedef struct {
+    float ultimate_gain;         // Estimated ultimate gain Ku
+    float ultimate_period_s;     // Estimated ultimate period Tu, in seconds
+    pid_ctrl_parameter_t params; // Proposed PID parameters, for `pid_update_parameters()`
+} pid_autotune_result_t;
+
+/**
+ * @brief Create a PID auto-tuner, running a relay feedback experiment
+ *
+ * @note The process is driven by a relay with hysteresis instead of the PID controller until it oscillates steadily.
+ *       The ultimate gain and period are estimated from the amplitude and period of the oscillation.
+ *
+ * @param[in] config PID auto-tuner configuration
+ * @param[out] ret_tuner Returned PID auto-tuner handle
+ * @return
+ *      - ESP_OK: Created PID auto-tuner successfully
+ *      - ESP_ERR_INVALID_ARG: Created PID auto-tuner failed because of invalid argument
+ *      - ESP_ERR_NO_MEM: Created PID auto-tuner failed because out of memory
+ */
+esp_err_t pid_new_autotune(const pid_autotune_config_t *config, pid_autotune_handle_t *ret_tuner);
+
+/**
+ * @brief Delete the PID auto-tuner
+ *
+ * @param[in] tuner PID auto-tuner handle, created by `pid_new_autotune()`
+ * @return
+ *      - ESP_OK: Delete PID auto-tuner successfully
+ *      - ESP_ERR_INVALID_ARG: Delete PID auto-tuner failed because of invalid argument
+ */
+esp_err_t pid_del_autotune(pid_autotune_handle_t tuner);
+
+/**
+ * @brief Input process value and get relay output, once per control period
+ *
+ * @param[in] tuner PID auto-tuner handle, created by `pid_new_autotune()`
+ * @param[in] process_value measured process value
+ * @param[out] ret_output output to apply to the process, output_bias once the experiment is done
+ * @param[out] ret_done whether enough oscillation cycles were measured
+ * @return
+ *      - ESP_OK: Run a relay step successfully
+ *      - ESP_ERR_INVALID_ARG: Run a relay step failed because of invalid argument
+ *      - ESP_ERR_TIMEOUT: Run a relay step failed because the process didn't oscillate within max_samples
+ */
+esp_err_t pid_autotune_step(pid_autotune_handle_t tuner, float process_value, float *ret_output, bool *ret_done);
+
+/**
+ * @brief Get ultimate gain and period and the proposed PID parameters
+ *
+ * @param[in] tuner PID auto-tuner handle, created by `pid_new_autotune()`
+ * @param[out] ret_result Returned result
+ * @return
+ *      - ESP_OK: Get result successfully
+ *      - ESP_ERR_INVALID_ARG: Get result failed because of invalid argument
+ *      - ESP_ERR_INVALID_STATE: Get result failed because the experiment isn't done, or the oscillation is within the hysteresis
+ */
+esp_err_t pid_autotune_get_result(pid_autotune_handle_t tuner, pid_autotune_result_t *ret_result);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,25 +4,36 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <math.h>
 #include <stdbool.h>
+#include <stdatomic.h>
+#include <string.h>
 #include <sys/param.h>
+#include "esp_attr.h"
 #include "esp_check.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
 #include "pid_ctrl.h"
 
+/* Compute functions can run from ISR while the cache is disabled */
+#if CONFIG_PID_CTRL_FUNC_IN_IRAM
+#define PID_CTRL_ATTR IRAM_ATTR
+#define PID_CTRL_MEM_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#else
+#define PID_CTRL_ATTR
+#define PID_CTRL_MEM_CAPS MALLOC_CAP_DEFAULT
+#endif
+
 static const char *TAG = "pid_ctrl";
 
 typedef struct pid_ctrl_block_t pid_ctrl_block_t;
-typedef float (*pid_cal_func_t)(pid_ctrl_block_t *pid, float error);
+typedef struct pid_ctrl_params_t pid_ctrl_params_t;
+typedef float (*pid_cal_func_t)(pid_ctrl_block_t *pid, const pid_ctrl_params_t *params, float error);
 
-struct pid_ctrl_block_t {
+struct pid_ctrl_params_t {
     float Kp; // PID Kp value
     float Ki; // PID Ki value
     float Kd; // PID Kd value
-    float previous_err1; // e(k-1)
-    float previous_err2; // e(k-2)
-    float integral_err;  // Sum of error
-    float last_output;  // PID output in last control period
     float max_output;   // PID maximum output limitation
     float min_output;   // PID minimum output limitation
     float max_integral; // PID maximum integral value limitation
@@ -30,24 +41,61 @@ struct pid_ctrl_block_t {
     pid_cal_func_t calculate_func; // calculation function, depends on actual PID type set by user
 };
 
-static float pid_calc_positional(pid_ctrl_block_t *pid, float error)
+/* Bits of pid_ctrl_block_t::params_state */
+#define PID_PARAMS_ACTIVE   (1 << 0) // index of the parameter set used by pid_compute()
+#define PID_PARAMS_PENDING  (1 << 1) // the other parameter set is updated, pid_compute() switches to it
+
+struct pid_ctrl_block_t {
+    float previous_err1; // e(k-1)
+    float previous_err2; // e(k-2)
+    float integral_err;  // Sum of error
+    float last_output;  // PID output in last control period
+    pid_ctrl_params_t params[2]; // Active parameter set and the one being updated
+    atomic_uint params_state;    // PID_PARAMS_xxx bits
+    bool metrics_enabled;        // Track performance metrics in pid_compute()
+    float initial_err;           // First error since the metrics were started
+    float settle_band;           // Absolute error band of a settled control loop
+    pid_ctrl_metrics_t metrics;  // Performance metrics since pid_start_metrics()
+};
+
+static void PID_CTRL_ATTR pid_update_metrics(pid_ctrl_block_t *pid, float error)
+{
+    pid_ctrl_metrics_t *metrics = &pid->metrics;
+    if (metrics->samples++ == 0) {
+        pid->initial_err = error;
+        pid->settle_band *= fabsf(error);
+    }
+    metrics->iae += fabsf(error);
+    /* Error of the opposite sign than the initial one: process value went past the setpoint */
+    if (error * pid->initial_err < 0) {
+        metrics->overshoot = MAX(metrics->overshoot, -error / pid->initial_err);
+    }
+    if (fabsf(error) > pid->settle_band) {
+        metrics->settling_samples = metrics->samples;
+        metrics->settled = false;
+    } else {
+        metrics->settled = true;
+    }
+}
+
+static float PID_CTRL_ATTR pid_calc_positional(pid_ctrl_block_t *pid, const pid_ctrl_params_t *params, float error)
 {
     float output = 0;
     /* Add current error to the integral error */
     pid->integral_err += error;
     /* If the integral error is out of the range, it will be limited */
-    pid->integral_err = MIN(pid->integral_err, pid->max_integral);
-    pid->integral_err = MAX(pid->integral_err, pid->min_integral);
+    pid->integral_err = MIN(pid->integral_err, params->max_integral);
+    pid->integral_err = MAX(pid->integral_err, params->min_integral);
 
     /* Calculate the pid control value by location formula */
     /* u(k) = e(k)*Kp + (e(k)-e(k-1))*Kd + integral*Ki */
-    output = error * pid->Kp +
-             (error - pid->previous_err1) * pid->Kd +
-             pid->integral_err * pid->Ki;
+    output = error * params->Kp +
+             (error - pid->previous_err1) * params->Kd +
+             pid->integral_err * params->Ki;
 
     /* If the output is out of the range, it will be limited */
-    output = MIN(output, pid->max_output);
-    output = MAX(output, pid->min_output);
+    output = MIN(output, params->max_output);
+    output = MAX(output, params->min_output);
 
     /* Update previous error */
     pid->previous_err1 = error;
@@ -55,21 +103,21 @@ static float pid_calc_positional(pid_ctrl_block_t *pid, float error)
     return output;
 }
 
-static float pid_calc_incremental(pid_ctrl_block_t *pid, float error)
+static float PID_CTRL_ATTR pid_calc_incremental(pid_ctrl_block_t *pid, const pid_ctrl_params_t *params, float error)
 {
     float output = 0;
 
     /* Calculate the pid control value by increment formula */
     /* du(k) = (e(k)-e(k-1))*Kp + (e(k)-2*e(k-1)+e(k-2))*Kd + e(k)*Ki */
     /* u(k) = du(k) + u(k-1) */
-    output = (error - pid->previous_err1) * pid->Kp +
-             (error - 2 * pid->previous_err1 + pid->previous_err2) * pid->Kd +
-             error * pid->Ki +
+    output = (error - pid->previous_err1) * params->Kp +
+             (error - 2 * pid->previous_err1 + pid->previous_err2) * params->Kd +
+             error * params->Ki +
              pid->last_output;
 
     /* If the output is beyond the range, it will be limited */
-    output = MIN(output, pid->max_output);
-    output = MAX(output, pid->min_output);
+    output = MIN(output, params->max_output);
+    output = MAX(output, params->min_output);
 
     /* Update previous error */
     pid->previous_err2 = pid->previous_err1;
@@ -88,7 +136,7 @@ esp_err_t pid_new_control_block(const pid_ctrl_config_t *config, pid_ctrl_block_
     /* Check the input pointer */
     ESP_GOTO_ON_FALSE(config && ret_pid, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
 
-    pid = calloc(1, sizeof(pid_ctrl_block_t));
+    pid = heap_caps_calloc(1, sizeof(pid_ctrl_block_t), PID_CTRL_MEM_CAPS);
     ESP_GOTO_ON_FALSE(pid, ESP_ERR_NO_MEM, err, TAG, "no mem for PID control block");
     ESP_GOTO_ON_ERROR(pid_update_parameters(pid, &config->init_param), err, TAG, "init PID parameters failed");
     *ret_pid = pid;
@@ -108,34 +156,51 @@ esp_err_t pid_del_control_block(pid_ctrl_block_handle_t pid)
     return ESP_OK;
 }
 
-esp_err_t pid_compute(pid_ctrl_block_handle_t pid, float input_error, float *ret_result)
+esp_err_t PID_CTRL_ATTR pid_compute(pid_ctrl_block_handle_t pid, float input_error, float *ret_result)
 {
-    ESP_RETURN_ON_FALSE(pid && ret_result, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
-    *ret_result = pid->calculate_func(pid, input_error);
+    ESP_RETURN_ON_FALSE_ISR(pid && ret_result, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    unsigned state = atomic_load(&pid->params_state);
+    /* Switch to the updated parameter set, unless the updater reclaimed it meanwhile */
+    if ((state & PID_PARAMS_PENDING) &&
+            atomic_compare_exchange_strong(&pid->params_state, &state, (state ^ PID_PARAMS_ACTIVE) & ~PID_PARAMS_PENDING)) {
+        state ^= PID_PARAMS_ACTIVE;
+    }
+    const pid_ctrl_params_t *params = &pid->params[state & PID_PARAMS_ACTIVE];
+    *ret_result = params->calculate_func(pid, params, input_error);
+    if (pid->metrics_enabled) {
+        pid_update_metrics(pid, input_error);
+    }
     return ESP_OK;
 }
 
 esp_err_t pid_update_parameters(pid_ctrl_block_handle_t pid, const pid_ctrl_parameter_t *params)
 {
     ESP_RETURN_ON_FALSE(pid && params, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
-    pid->Kp = params->kp;
-    pid->Ki = params->ki;
-    pid->Kd = params->kd;
-    pid->max_output = params->max_output;
-    pid->min_output = params->min_output;
-    pid->max_integral = params->max_integral;
-    pid->min_integral = params->min_integral;
+    pid_ctrl_params_t new_params = {
+        .Kp = params->kp,
+        .Ki = params->ki,
+        .Kd = params->kd,
+        .max_output = params->max_output,
+        .min_output = params->min_output,
+        .max_integral = params->max_integral,
+        .min_integral = params->min_integral,
+    };
     /* Set the calculate function according to the PID type */
     switch (params->cal_type) {
     case PID_CAL_TYPE_INCREMENTAL:
-        pid->calculate_func = pid_calc_incremental;
+        new_params.calculate_func = pid_calc_incremental;
         break;
     case PID_CAL_TYPE_POSITIONAL:
-        pid->calculate_func = pid_calc_positional;
+        new_params.calculate_func = pid_calc_positional;
         break;
     default:
         ESP_RETURN_ON_FALSE(false, ESP_ERR_INVALID_ARG, TAG, "invalid PID calculation type:%d", params->cal_type);
     }
+    /* Take back a parameter set not used by pid_compute() yet, so the active set can't change while the other one is written */
+    unsigned state = atomic_fetch_and(&pid->params_state, ~PID_PARAMS_PENDING);
+    pid->params[(state & PID_PARAMS_ACTIVE) ^ 1] = new_params;
+    /* Applied at the next pid_compute() */
+    atomic_fetch_or(&pid->params_state, PID_PARAMS_PENDING);
     return ESP_OK;
 }
 
@@ -148,3 +213,20 @@ esp_err_t pid_reset_ctrl_block(pid_ctrl_block_handle_t pid)
     pid->last_output = 0;
     return ESP_OK;
 }
+
+esp_err_t pid_start_metrics(pid_ctrl_block_handle_t pid, float settle_band)
+{
+    ESP_RETURN_ON_FALSE(pid && settle_band >= 0, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    pid->metrics_enabled = false;
+    memset(&pid->metrics, 0, sizeof(pid->metrics));
+    pid->settle_band = settle_band; // relative until the first error is known
+    pid->metrics_enabled = true;
+    return ESP_OK;
+}
+
+esp_err_t pid_get_metrics(pid_ctrl_block_handle_t pid, pid_ctrl_metrics_t *ret_metrics)
+{
+    ESP_RETURN_ON_FALSE(pid && ret_metrics, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    *ret_metrics = pid->metrics;
+    return ESP_OK;
+}
@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <sys/param.h>
+#include "esp_check.h"
+#include "esp_log.h"
+#include "pid_ctrl.h"
+
+static const char *TAG = "pid_autotune";
+
+struct pid_autotune_t {
+    pid_autotune_config_t config;
+    uint32_t samples;        // samples since the experiment started
+    bool relay_high;         // relay output is output_bias + relay_amplitude
+    uint32_t last_rise;      // sample of the last switch of the relay to high, 0 if none yet
+    uint32_t cycles;         // oscillation cycles measured, the first one is not used
+    float cycle_max;         // process value maximum in the current cycle
+    float cycle_min;         // process value minimum in the current cycle
+    float sum_amplitude;     // sum of peak to peak amplitudes of the measured cycles
+    uint32_t sum_period;     // sum of periods of the measured cycles, in samples
+    bool done;               // enough cycles measured
+};
+
+esp_err_t pid_new_autotune(const pid_autotune_config_t *config, pid_autotune_handle_t *ret_tuner)
+{
+    ESP_RETURN_ON_FALSE(config && ret_tuner, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->relay_amplitude > 0 && config->hysteresis >= 0 && config->sample_period_s > 0 && config->num_cycles,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid relay experiment configuration");
+    ESP_RETURN_ON_FALSE(config->rule == PID_AUTOTUNE_RULE_ZIEGLER_NICHOLS || config->rule == PID_AUTOTUNE_RULE_TYREUS_LUYBEN,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid tuning rule:%d", config->rule);
+    struct pid_autotune_t *tuner = calloc(1, sizeof(struct pid_autotune_t));
+    ESP_RETURN_ON_FALSE(tuner, ESP_ERR_NO_MEM, TAG, "no mem for PID auto-tuner");
+    tuner->config = *config;
+    tuner->relay_high = true;
+    tuner->cycle_max = -INFINITY;
+    tuner->cycle_min = INFINITY;
+    *ret_tuner = tuner;
+    return ESP_OK;
+}
+
+esp_err_t pid_del_autotune(pid_autotune_handle_t tuner)
+{
+    ESP_RETURN_ON_FALSE(tuner, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(tuner);
+    return ESP_OK;
+}
+
+esp_err_t pid_autotune_step(pid_autotune_handle_t tuner, float process_value, float *ret_output, bool *ret_done)
+{
+    ESP_RETURN_ON_FALSE(tuner && ret_output && ret_done, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    const pid_autotune_config_t *config = &tuner->config;
+    if (!tuner->done) {
+        ESP_RETURN_ON_FALSE(!config->max_samples || tuner->samples < config->max_samples, ESP_ERR_TIMEOUT, TAG,
+                            "no stable oscillation after %"PRIu32" samples", tuner->samples);
+        tuner->samples++;
+        tuner->cycle_max = MAX(tuner->cycle_max, process_value);
+        tuner->cycle_min = MIN(tuner->cycle_min, process_value);
+
+        /* Relay with hysteresis: drive towards the setpoint until the process value passed it */
+        const float error = config->setpoint - process_value;
+        if (tuner->relay_high && error < -config->hysteresis) {
+            tuner->relay_high = false;
+        } else if (!tuner->relay_high && error > config->hysteresis) {
+            tuner->relay_high = true;
+            /* A rise of the relay ends an oscillation cycle, the first cycle is a transient */
+            if (tuner->last_rise && tuner->cycles++) {
+                tuner->sum_period += tuner->samples - tuner->last_rise;
+                tuner->sum_amplitude += tuner->cycle_max - tuner->cycle_min;
+                tuner->done = tuner->cycles > config->num_cycles;
+            }
+            tuner->last_rise = tuner->samples;
+            tuner->cycle_max = process_value;
+            tuner->cycle_min = process_value;
+        }
+    }
+    /* Output the bias once the experiment is done */
+    *ret_output = config->output_bias;
+    if (!tuner->done) {
+        *ret_output += tuner->relay_high ? config->relay_amplitude : -config->relay_amplitude;
+    }
+    *ret_done = tuner->done;
+    return ESP_OK;
+}
+
+esp_err_t pid_autotune_get_result(pid_autotune_handle_t tuner, pid_autotune_result_t *ret_result)
+{
+    ESP_RETURN_ON_FALSE(tuner && ret_result, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(tuner->done, ESP_ERR_INVALID_STATE, TAG, "relay experiment not finished");
+    const pid_autotune_config_t *config = &tuner->config;
+    const uint32_t cycles = tuner->cycles - 1;
+
+    /* Describing function of a relay with hysteresis: Ku = 4d / (pi * sqrt(a^2 - eps^2)) */
+    const float amplitude = tuner->sum_amplitude / cycles / 2;
+    ESP_RETURN_ON_FALSE(amplitude > config->hysteresis, ESP_ERR_INVALID_STATE, TAG, "oscillation within hysteresis");
+    const float ku = 4 * config->relay_amplitude / ((float)M_PI * sqrtf(amplitude * amplitude - config->hysteresis * config->hysteresis));
+    const float tu = (float)tuner->sum_period / cycles * config->sample_period_s;
+
+    /* Gains by the tuning rule, Ti and Td are the integral and derivative times */
+    float kp = 0;
+    float ti = 0;
+    float td = 0;
+    switch (config->rule) {
+    case PID_AUTOTUNE_RULE_ZIEGLER_NICHOLS:
+        kp = 0.6f * ku;
+        ti = tu / 2;
+        td = tu / 8;
+        break;
+    case PID_AUTOTUNE_RULE_TYREUS_LUYBEN:
+        kp = ku / 2.2f;
+        ti = 2.2f * tu;
+        td = tu / 6.3f;
+        break;
+    }
+
+    ret_result->ultimate_gain = ku;
+    ret_result->ultimate_period_s = tu;
+    /* Discrete gains of pid_compute(), for both calculation types */
+    ret_result->params = config->base_param;
+    ret_result->params.kp = kp;
+    ret_result->params.ki = kp * config->sample_period_s / ti;
+    ret_result->params.kd = kp * td / config->sample_period_s;
+    return ESP_OK;
+}
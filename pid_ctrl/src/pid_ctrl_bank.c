@@ -0,0 +1,174 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+#include "esp_attr.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "pid_ctrl.h"
+
+/* Compute functions can run from ISR while the cache is disabled */
+#if CONFIG_PID_CTRL_FUNC_IN_IRAM
+#define PID_CTRL_ATTR IRAM_ATTR
+#define PID_CTRL_MEM_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#else
+#define PID_CTRL_ATTR
+#define PID_CTRL_MEM_CAPS MALLOC_CAP_DEFAULT
+#endif
+
+static const char *TAG = "pid_ctrl_bank";
+
+#define PID_BANK_ALIGN 16 // alignment of each array, for vector loads
+
+/* Parameters and states of all channels, one array per field, allocated after the struct */
+struct pid_ctrl_bank_t {
+    size_t num_channels;
+    pid_calculate_type_t cal_type;
+    float *Kp;            // PID Kp value
+    float *Ki;            // PID Ki value
+    float *Kd;            // PID Kd value
+    float *previous_err1; // e(k-1)
+    float *previous_err2; // e(k-2)
+    float *integral_err;  // Sum of error
+    float *last_output;   // PID output in last control period
+    float *max_output;    // PID maximum output limitation
+    float *min_output;    // PID minimum output limitation
+    float *max_integral;  // PID maximum integral value limitation
+    float *min_integral;  // PID minimum integral value limitation
+};
+
+#define PID_BANK_NUM_ARRAYS 11
+
+static void PID_CTRL_ATTR pid_bank_calc_positional(struct pid_ctrl_bank_t *bank, const float *restrict errors, float *restrict results)
+{
+    const float *restrict Kp = bank->Kp;
+    const float *restrict Ki = bank->Ki;
+    const float *restrict Kd = bank->Kd;
+    const float *restrict max_output = bank->max_output;
+    const float *restrict min_output = bank->min_output;
+    const float *restrict max_integral = bank->max_integral;
+    const float *restrict min_integral = bank->min_integral;
+    float *restrict previous_err1 = bank->previous_err1;
+    float *restrict integral_err = bank->integral_err;
+
+    /* Same formula as pid_calc_positional, the limits are applied by MIN/MAX without branches */
+    for (size_t i = 0; i < bank->num_channels; i++) {
+        const float error = errors[i];
+        float integral = integral_err[i] + error;
+        integral = MIN(integral, max_integral[i]);
+        integral = MAX(integral, min_integral[i]);
+        integral_err[i] = integral;
+
+        float output = error * Kp[i] + (error - previous_err1[i]) * Kd[i] + integral * Ki[i];
+        output = MIN(output, max_output[i]);
+        output = MAX(output, min_output[i]);
+
+        previous_err1[i] = error;
+        results[i] = output;
+    }
+}
+
+static void PID_CTRL_ATTR pid_bank_calc_incremental(struct pid_ctrl_bank_t *bank, const float *restrict errors, float *restrict results)
+{
+    const float *restrict Kp = bank->Kp;
+    const float *restrict Ki = bank->Ki;
+    const float *restrict Kd = bank->Kd;
+    const float *restrict max_output = bank->max_output;
+    const float *restrict min_output = bank->min_output;
+    float *restrict previous_err1 = bank->previous_err1;
+    float *restrict previous_err2 = bank->previous_err2;
+    float *restrict last_output = bank->last_output;
+
+    /* Same formula as pid_calc_incremental, the limits are applied by MIN/MAX without branches */
+    for (size_t i = 0; i < bank->num_channels; i++) {
+        const float error = errors[i];
+        const float err1 = previous_err1[i];
+        float output = (error - err1) * Kp[i] +
+                       (error - 2 * err1 + previous_err2[i]) * Kd[i] +
+                       error * Ki[i] +
+                       last_output[i];
+        output = MIN(output, max_output[i]);
+        output = MAX(output, min_output[i]);
+
+        previous_err2[i] = err1;
+        previous_err1[i] = error;
+        last_output[i] = output;
+        results[i] = output;
+    }
+}
+
+esp_err_t pid_new_control_bank(const pid_ctrl_bank_config_t *config, pid_ctrl_bank_handle_t *ret_bank)
+{
+    ESP_RETURN_ON_FALSE(config && ret_bank && config->num_channels, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->cal_type == PID_CAL_TYPE_INCREMENTAL || config->cal_type == PID_CAL_TYPE_POSITIONAL,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid PID calculation type:%d", config->cal_type);
+
+    /* Round each array up, so all of them are aligned */
+    const size_t stride = (config->num_channels * sizeof(float) + PID_BANK_ALIGN - 1) & ~(PID_BANK_ALIGN - 1);
+    struct pid_ctrl_bank_t *bank = heap_caps_calloc(1, sizeof(struct pid_ctrl_bank_t) + PID_BANK_ALIGN - 1 + stride * PID_BANK_NUM_ARRAYS,
+                                                    PID_CTRL_MEM_CAPS);
+    ESP_RETURN_ON_FALSE(bank, ESP_ERR_NO_MEM, TAG, "no mem for PID control bank");
+    const uintptr_t first_array = ((uintptr_t)(bank + 1) + PID_BANK_ALIGN - 1) & ~(uintptr_t)(PID_BANK_ALIGN - 1);
+    bank->num_channels = config->num_channels;
+    bank->cal_type = config->cal_type;
+
+    float **arrays[PID_BANK_NUM_ARRAYS] = {
+        &bank->Kp, &bank->Ki, &bank->Kd, &bank->previous_err1, &bank->previous_err2, &bank->integral_err,
+        &bank->last_output, &bank->max_output, &bank->min_output, &bank->max_integral, &bank->min_integral,
+    };
+    for (size_t i = 0; i < PID_BANK_NUM_ARRAYS; i++) {
+        *arrays[i] = (float *)(first_array + stride * i);
+    }
+    *ret_bank = bank;
+    return ESP_OK;
+}
+
+esp_err_t pid_del_control_bank(pid_ctrl_bank_handle_t bank)
+{
+    ESP_RETURN_ON_FALSE(bank, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(bank);
+    return ESP_OK;
+}
+
+esp_err_t pid_bank_update_parameters(pid_ctrl_bank_handle_t bank, size_t channel, const pid_ctrl_parameter_t *params)
+{
+    ESP_RETURN_ON_FALSE(bank && params && channel < bank->num_channels, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(params->cal_type == bank->cal_type, ESP_ERR_INVALID_ARG, TAG, "PID calculation type differs from the bank");
+    bank->Kp[channel] = params->kp;
+    bank->Ki[channel] = params->ki;
+    bank->Kd[channel] = params->kd;
+    bank->max_output[channel] = params->max_output;
+    bank->min_output[channel] = params->min_output;
+    bank->max_integral[channel] = params->max_integral;
+    bank->min_integral[channel] = params->min_integral;
+    return ESP_OK;
+}
+
+esp_err_t PID_CTRL_ATTR pid_bank_compute(pid_ctrl_bank_handle_t bank, const float *input_errors, float *ret_results)
+{
+    ESP_RETURN_ON_FALSE_ISR(bank && input_errors && ret_results, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (bank->cal_type == PID_CAL_TYPE_POSITIONAL) {
+        pid_bank_calc_positional(bank, input_errors, ret_results);
+    } else {
+        pid_bank_calc_incremental(bank, input_errors, ret_results);
+    }
+    return ESP_OK;
+}
+
+esp_err_t pid_bank_reset(pid_ctrl_bank_handle_t bank)
+{
+    ESP_RETURN_ON_FALSE(bank, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    const size_t size = bank->num_channels * sizeof(float);
+    memset(bank->integral_err, 0, size);
+    memset(bank->previous_err1, 0, size);
+    memset(bank->previous_err2, 0, size);
+    memset(bank->last_output, 0, size);
+    return ESP_OK;
+}
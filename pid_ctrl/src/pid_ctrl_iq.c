@@ -0,0 +1,174 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/param.h>
+#include "esp_check.h"
+#include "esp_log.h"
+#include "IQmathLib.h"
+#include "pid_ctrl.h"
+
+static const char *TAG = "pid_ctrl_iq";
+
+typedef struct pid_ctrl_iq_block_t pid_ctrl_iq_block_t;
+typedef int32_t (*pid_iq_mpy_func_t)(int32_t A, int32_t B);
+typedef int32_t (*pid_iq_cal_func_t)(pid_ctrl_iq_block_t *pid, int32_t error);
+
+struct pid_ctrl_iq_block_t {
+    int q_value;        // number of fractional bits
+    int32_t Kp;         // PID Kp value
+    int32_t Ki;         // PID Ki value
+    int32_t Kd;         // PID Kd value
+    int32_t previous_err1; // e(k-1)
+    int32_t previous_err2; // e(k-2)
+    int32_t integral_err;  // Sum of error
+    int32_t last_output;  // PID output in last control period
+    int32_t max_output;   // PID maximum output limitation
+    int32_t min_output;   // PID minimum output limitation
+    int32_t max_integral; // PID maximum integral value limitation
+    int32_t min_integral; // PID minimum integral value limitation
+    pid_iq_mpy_func_t mpy; // rounded and saturated multiplication in the IQ format of the block
+    pid_iq_cal_func_t calculate_func; // calculation function, depends on actual PID type set by user
+};
+
+/* Saturate a sum of IQ values to the given range */
+static inline int32_t pid_iq_sat(int64_t value, int32_t max, int32_t min)
+{
+    value = MIN(value, (int64_t)max);
+    value = MAX(value, (int64_t)min);
+    return (int32_t)value;
+}
+
+static int32_t pid_iq_calc_positional(pid_ctrl_iq_block_t *pid, int32_t error)
+{
+    /* Add current error to the integral error, limited to the range */
+    pid->integral_err = pid_iq_sat((int64_t)pid->integral_err + error, pid->max_integral, pid->min_integral);
+
+    /* u(k) = e(k)*Kp + (e(k)-e(k-1))*Kd + integral*Ki */
+    const int32_t derivative = pid_iq_sat((int64_t)error - pid->previous_err1, INT32_MAX, INT32_MIN);
+    const int64_t output = (int64_t)pid->mpy(error, pid->Kp) +
+                           pid->mpy(derivative, pid->Kd) +
+                           pid->mpy(pid->integral_err, pid->Ki);
+
+    /* Update previous error */
+    pid->previous_err1 = error;
+
+    return pid_iq_sat(output, pid->max_output, pid->min_output);
+}
+
+static int32_t pid_iq_calc_incremental(pid_ctrl_iq_block_t *pid, int32_t error)
+{
+    /* du(k) = (e(k)-e(k-1))*Kp + (e(k)-2*e(k-1)+e(k-2))*Kd + e(k)*Ki */
+    /* u(k) = du(k) + u(k-1) */
+    const int32_t proportional = pid_iq_sat((int64_t)error - pid->previous_err1, INT32_MAX, INT32_MIN);
+    const int32_t derivative = pid_iq_sat((int64_t)error - 2 * (int64_t)pid->previous_err1 + pid->previous_err2, INT32_MAX, INT32_MIN);
+    const int64_t output = (int64_t)pid->mpy(proportional, pid->Kp) +
+                           pid->mpy(derivative, pid->Kd) +
+                           pid->mpy(error, pid->Ki) +
+                           pid->last_output;
+
+    /* Update previous error */
+    pid->previous_err2 = pid->previous_err1;
+    pid->previous_err1 = error;
+
+    /* Update last output, limited to the range */
+    pid->last_output = pid_iq_sat(output, pid->max_output, pid->min_output);
+
+    return pid->last_output;
+}
+
+/* Convert a parameter to the IQ format of the block, fails if it's out of the format range */
+static esp_err_t pid_iq_from_float(const pid_ctrl_iq_block_t *pid, float value, int32_t *ret_value)
+{
+    const float limit = (float)(1 << (31 - pid->q_value));
+    ESP_RETURN_ON_FALSE(value >= -limit && value < limit, ESP_ERR_INVALID_ARG, TAG, "parameter %f out of IQ%d range", value, pid->q_value);
+    *ret_value = (int32_t)(value * (float)(1 << pid->q_value));
+    return ESP_OK;
+}
+
+esp_err_t pid_new_iq_control_block(const pid_ctrl_iq_config_t *config, pid_ctrl_iq_block_handle_t *ret_pid)
+{
+    esp_err_t ret = ESP_OK;
+    pid_ctrl_iq_block_t *pid = NULL;
+    /* Check the input pointer */
+    ESP_GOTO_ON_FALSE(config && ret_pid, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+
+    pid = calloc(1, sizeof(pid_ctrl_iq_block_t));
+    ESP_GOTO_ON_FALSE(pid, ESP_ERR_NO_MEM, err, TAG, "no mem for PID control block");
+    switch (config->iq_format) {
+    case PID_IQ_FORMAT_IQ24:
+        pid->q_value = 24;
+        pid->mpy = _IQ24rsmpy;
+        break;
+    case PID_IQ_FORMAT_IQ16:
+        pid->q_value = 16;
+        pid->mpy = _IQ16rsmpy;
+        break;
+    default:
+        ESP_GOTO_ON_FALSE(false, ESP_ERR_INVALID_ARG, err, TAG, "invalid IQ format:%d", config->iq_format);
+    }
+    ESP_GOTO_ON_ERROR(pid_iq_update_parameters(pid, &config->init_param), err, TAG, "init PID parameters failed");
+    *ret_pid = pid;
+    return ret;
+
+err:
+    if (pid) {
+        free(pid);
+    }
+    return ret;
+}
+
+esp_err_t pid_del_iq_control_block(pid_ctrl_iq_block_handle_t pid)
+{
+    ESP_RETURN_ON_FALSE(pid, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(pid);
+    return ESP_OK;
+}
+
+esp_err_t pid_iq_compute(pid_ctrl_iq_block_handle_t pid, int32_t input_error, int32_t *ret_result)
+{
+    ESP_RETURN_ON_FALSE(pid && ret_result, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    *ret_result = pid->calculate_func(pid, input_error);
+    return ESP_OK;
+}
+
+esp_err_t pid_iq_update_parameters(pid_ctrl_iq_block_handle_t pid, const pid_ctrl_parameter_t *params)
+{
+    ESP_RETURN_ON_FALSE(pid && params, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    pid_ctrl_iq_block_t converted = *pid;
+    ESP_RETURN_ON_ERROR(pid_iq_from_float(pid, params->kp, &converted.Kp), TAG, "invalid Kp");
+    ESP_RETURN_ON_ERROR(pid_iq_from_float(pid, params->ki, &converted.Ki), TAG, "invalid Ki");
+    ESP_RETURN_ON_ERROR(pid_iq_from_float(pid, params->kd, &converted.Kd), TAG, "invalid Kd");
+    ESP_RETURN_ON_ERROR(pid_iq_from_float(pid, params->max_output, &converted.max_output), TAG, "invalid max output");
+    ESP_RETURN_ON_ERROR(pid_iq_from_float(pid, params->min_output, &converted.min_output), TAG, "invalid min output");
+    ESP_RETURN_ON_ERROR(pid_iq_from_float(pid, params->max_integral, &converted.max_integral), TAG, "invalid max integral");
+    ESP_RETURN_ON_ERROR(pid_iq_from_float(pid, params->min_integral, &converted.min_integral), TAG, "invalid min integral");
+    /* Set the calculate function according to the PID type */
+    switch (params->cal_type) {
+    case PID_CAL_TYPE_INCREMENTAL:
+        converted.calculate_func = pid_iq_calc_incremental;
+        break;
+    case PID_CAL_TYPE_POSITIONAL:
+        converted.calculate_func = pid_iq_calc_positional;
+        break;
+    default:
+        ESP_RETURN_ON_FALSE(false, ESP_ERR_INVALID_ARG, TAG, "invalid PID calculation type:%d", params->cal_type);
+    }
+    *pid = converted;
+    return ESP_OK;
+}
+
+esp_err_t pid_iq_reset_ctrl_block(pid_ctrl_iq_block_handle_t pid)
+{
+    ESP_RETURN_ON_FALSE(pid, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    pid->integral_err = 0;
+    pid->previous_err1 = 0;
+    pid->previous_err2 = 0;
+    pid->last_output = 0;
+    return ESP_OK;
+}
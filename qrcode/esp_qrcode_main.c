@@ -5,6 +5,9 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include <esp_err.h>
 #include "esp_log.h"
 
@@ -60,6 +63,30 @@ void esp_qrcode_print_console(esp_qrcode_handle_t qrcode)
     printf("\n");
 }
 
+static enum qrcodegen_Ecc get_ecc_level(int qrcode_ecc_level)
+{
+    switch (qrcode_ecc_level) {
+    case ESP_QRCODE_ECC_LOW:
+        return qrcodegen_Ecc_LOW;
+    case ESP_QRCODE_ECC_MED:
+        return qrcodegen_Ecc_MEDIUM;
+    case ESP_QRCODE_ECC_QUART:
+        return qrcodegen_Ecc_QUARTILE;
+    case ESP_QRCODE_ECC_HIGH:
+        return qrcodegen_Ecc_HIGH;
+    default:
+        return qrcodegen_Ecc_LOW;
+    }
+}
+
+static enum qrcodegen_Mask get_mask(int qrcode_mask)
+{
+    if (qrcode_mask >= ESP_QRCODE_MASK_0 && qrcode_mask <= ESP_QRCODE_MASK_7) {
+        return (enum qrcodegen_Mask)(qrcodegen_Mask_0 + (qrcode_mask - ESP_QRCODE_MASK_0));
+    }
+    return qrcodegen_Mask_AUTO;
+}
+
 esp_err_t esp_qrcode_generate(esp_qrcode_config_t *cfg, const char *text)
 {
     enum qrcodegen_Ecc ecc_lvl;
@@ -77,23 +104,7 @@ esp_err_t esp_qrcode_generate(esp_qrcode_config_t *cfg, const char *text)
         return ESP_ERR_NO_MEM;
     }
 
-    switch (cfg->qrcode_ecc_level) {
-    case ESP_QRCODE_ECC_LOW:
-        ecc_lvl = qrcodegen_Ecc_LOW;
-        break;
-    case ESP_QRCODE_ECC_MED:
-        ecc_lvl = qrcodegen_Ecc_MEDIUM;
-        break;
-    case ESP_QRCODE_ECC_QUART:
-        ecc_lvl = qrcodegen_Ecc_QUARTILE;
-        break;
-    case ESP_QRCODE_ECC_HIGH:
-        ecc_lvl = qrcodegen_Ecc_HIGH;
-        break;
-    default:
-        ecc_lvl = qrcodegen_Ecc_LOW;
-        break;
-    }
+    ecc_lvl = get_ecc_level(cfg->qrcode_ecc_level);
 
     ESP_LOGI(TAG, "Encoding below text with ECC LVL %d & QR Code Version %d",
              ecc_lvl, cfg->max_qrcode_version);
@@ -101,7 +112,7 @@ esp_err_t esp_qrcode_generate(esp_qrcode_config_t *cfg, const char *text)
     // Make and print the QR Code symbol
     bool ok = qrcodegen_encodeText(text, tempbuf, qrcode, ecc_lvl,
                                    qrcodegen_VERSION_MIN, cfg->max_qrcode_version,
-                                   qrcodegen_Mask_AUTO, true);
+                                   get_mask(cfg->qrcode_mask), true);
     if (ok && cfg->display_func) {
         cfg->display_func((esp_qrcode_handle_t)qrcode);
         err = ESP_OK;
@@ -111,3 +122,177 @@ esp_err_t esp_qrcode_generate(esp_qrcode_config_t *cfg, const char *text)
     free(tempbuf);
     return err;
 }
+
+struct esp_qrcode_encoder {
+    int max_qrcode_version;
+    enum qrcodegen_Ecc ecc_lvl;
+    enum qrcodegen_Mask mask;
+    size_t buf_len;
+    uint8_t *qrcode;
+    uint8_t *tempbuf;
+    uint8_t *segbuf;    /* Segment data, allocated on the first use */
+};
+
+esp_err_t esp_qrcode_encoder_create(const esp_qrcode_config_t *cfg, esp_qrcode_encoder_handle_t *ret_encoder)
+{
+    if (!cfg || !ret_encoder || cfg->max_qrcode_version < qrcodegen_VERSION_MIN ||
+            cfg->max_qrcode_version > qrcodegen_VERSION_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t buf_len = qrcodegen_BUFFER_LEN_FOR_VERSION(cfg->max_qrcode_version);
+    struct esp_qrcode_encoder *encoder = calloc(1, sizeof(struct esp_qrcode_encoder) + 2 * buf_len);
+    if (!encoder) {
+        return ESP_ERR_NO_MEM;
+    }
+    encoder->max_qrcode_version = cfg->max_qrcode_version;
+    encoder->ecc_lvl = get_ecc_level(cfg->qrcode_ecc_level);
+    encoder->mask = get_mask(cfg->qrcode_mask);
+    encoder->buf_len = buf_len;
+    encoder->qrcode = (uint8_t *)(encoder + 1);
+    encoder->tempbuf = encoder->qrcode + buf_len;
+
+    *ret_encoder = encoder;
+    return ESP_OK;
+}
+
+void esp_qrcode_encoder_delete(esp_qrcode_encoder_handle_t encoder)
+{
+    if (encoder) {
+        free(encoder->segbuf);
+        free(encoder);
+    }
+}
+
+esp_err_t esp_qrcode_encode(esp_qrcode_encoder_handle_t encoder, const char *text, esp_qrcode_handle_t *ret_qrcode)
+{
+    if (!encoder || !text || !ret_qrcode) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    bool ok = qrcodegen_encodeText(text, encoder->tempbuf, encoder->qrcode, encoder->ecc_lvl,
+                                   qrcodegen_VERSION_MIN, encoder->max_qrcode_version,
+                                   encoder->mask, true);
+    if (!ok) {
+        ESP_LOGE(TAG, "Failed to encode text with QR Code Version up to %d", encoder->max_qrcode_version);
+        return ESP_FAIL;
+    }
+    *ret_qrcode = encoder->qrcode;
+    return ESP_OK;
+}
+
+esp_err_t esp_qrcode_encode_binary(esp_qrcode_encoder_handle_t encoder, const uint8_t *data, size_t len,
+                                   esp_qrcode_handle_t *ret_qrcode)
+{
+    if (!encoder || (!data && len) || !ret_qrcode) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (len > encoder->buf_len) {
+        ESP_LOGE(TAG, "Data too long for QR Code Version up to %d", encoder->max_qrcode_version);
+        return ESP_FAIL;
+    }
+
+    // qrcodegen_encodeBinary() takes the data in the temporary buffer
+    memcpy(encoder->tempbuf, data, len);
+    bool ok = qrcodegen_encodeBinary(encoder->tempbuf, len, encoder->qrcode, encoder->ecc_lvl,
+                                     qrcodegen_VERSION_MIN, encoder->max_qrcode_version,
+                                     encoder->mask, true);
+    if (!ok) {
+        ESP_LOGE(TAG, "Failed to encode data with QR Code Version up to %d", encoder->max_qrcode_version);
+        return ESP_FAIL;
+    }
+    *ret_qrcode = encoder->qrcode;
+    return ESP_OK;
+}
+
+esp_err_t esp_qrcode_encode_segments(esp_qrcode_encoder_handle_t encoder, const esp_qrcode_segment_t *segs, size_t count,
+                                     esp_qrcode_handle_t *ret_qrcode)
+{
+    if (!encoder || !segs || count == 0 || count > ESP_QRCODE_MAX_SEGMENTS || !ret_qrcode) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // The segment data must not overlap the buffers used for encoding
+    size_t segbuf_len = encoder->buf_len + ESP_QRCODE_MAX_SEGMENTS;
+    if (!encoder->segbuf) {
+        encoder->segbuf = malloc(segbuf_len);
+        if (!encoder->segbuf) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    struct qrcodegen_Segment qrsegs[ESP_QRCODE_MAX_SEGMENTS];
+    size_t used = 0;
+    for (size_t i = 0; i < count; i++) {
+        const char *text = segs[i].data;
+        enum qrcodegen_Mode mode;
+        size_t num_chars;
+        switch (segs[i].mode) {
+        case ESP_QRCODE_SEGMENT_NUMERIC:
+            if (!text || !qrcodegen_isNumeric(text)) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            mode = qrcodegen_Mode_NUMERIC;
+            num_chars = strlen(text);
+            break;
+        case ESP_QRCODE_SEGMENT_ALPHANUMERIC:
+            if (!text || !qrcodegen_isAlphanumeric(text)) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            mode = qrcodegen_Mode_ALPHANUMERIC;
+            num_chars = strlen(text);
+            break;
+        case ESP_QRCODE_SEGMENT_BYTE:
+            if (!segs[i].data && segs[i].len) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            mode = qrcodegen_Mode_BYTE;
+            num_chars = segs[i].len;
+            break;
+        default:
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        size_t seg_len = qrcodegen_calcSegmentBufferSize(mode, num_chars);
+        if (seg_len == SIZE_MAX || seg_len > segbuf_len - used) {
+            ESP_LOGE(TAG, "Segments too long for QR Code Version up to %d", encoder->max_qrcode_version);
+            return ESP_FAIL;
+        }
+        uint8_t *buf = encoder->segbuf + used;
+        used += seg_len;
+        if (mode == qrcodegen_Mode_NUMERIC) {
+            qrsegs[i] = qrcodegen_makeNumeric(text, buf);
+        } else if (mode == qrcodegen_Mode_ALPHANUMERIC) {
+            qrsegs[i] = qrcodegen_makeAlphanumeric(text, buf);
+        } else {
+            qrsegs[i] = qrcodegen_makeBytes(segs[i].data, segs[i].len, buf);
+        }
+    }
+
+    bool ok = qrcodegen_encodeSegmentsAdvanced(qrsegs, count, encoder->ecc_lvl,
+              qrcodegen_VERSION_MIN, encoder->max_qrcode_version,
+              encoder->mask, true, encoder->tempbuf, encoder->qrcode);
+    if (!ok) {
+        ESP_LOGE(TAG, "Failed to encode segments with QR Code Version up to %d", encoder->max_qrcode_version);
+        return ESP_FAIL;
+    }
+    *ret_qrcode = encoder->qrcode;
+    return ESP_OK;
+}
+
+esp_err_t esp_qrcode_encode_batch(esp_qrcode_encoder_handle_t encoder, const char *const texts[], size_t count,
+                                  esp_qrcode_batch_cb_t cb, void *arg)
+{
+    if (!encoder || (!texts && count) || !cb) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        esp_qrcode_handle_t qrcode;
+        esp_err_t err = esp_qrcode_encode(encoder, texts[i], &qrcode);
+        if (err != ESP_OK) {
+            return err;
+        }
+        cb(arg, i, qrcode);
+    }
+    return ESP_OK;
+}
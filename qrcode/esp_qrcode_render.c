@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <esp_err.h>
+
+#include "qrcodegen.h"
+#include "qrcode.h"
+
+static void fill_rgb565(uint8_t *row, int start, int len, uint16_t color)
+{
+    uint16_t *px = (uint16_t *)row + start;
+    for (int i = 0; i < len; i++) {
+        px[i] = color;
+    }
+}
+
+static void fill_mono(uint8_t *row, int start, int len, uint16_t color)
+{
+    int end = start + len;
+
+    /* Bits up to a byte boundary, whole bytes, then the remaining bits */
+    for (; start < end && (start & 7); start++) {
+        uint8_t mask = 0x80 >> (start & 7);
+        row[start >> 3] = color ? (row[start >> 3] | mask) : (row[start >> 3] & ~mask);
+    }
+    if (end - start >= 8) {
+        memset(row + (start >> 3), color ? 0xff : 0, (end - start) >> 3);
+        start += (end - start) & ~7;
+    }
+    for (; start < end; start++) {
+        uint8_t mask = 0x80 >> (start & 7);
+        row[start >> 3] = color ? (row[start >> 3] | mask) : (row[start >> 3] & ~mask);
+    }
+}
+
+esp_err_t esp_qrcode_render(esp_qrcode_handle_t qrcode, const esp_qrcode_render_config_t *cfg)
+{
+    if (!qrcode || !cfg || !cfg->buffer || cfg->scale < 1 || cfg->border < 0 || cfg->x < 0 || cfg->y < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    void (*fill)(uint8_t *row, int start, int len, uint16_t color);
+    int min_stride;
+    switch (cfg->format) {
+    case ESP_QRCODE_PIXEL_FORMAT_RGB565:
+        fill = fill_rgb565;
+        min_stride = cfg->width * 2;
+        break;
+    case ESP_QRCODE_PIXEL_FORMAT_MONO:
+        fill = fill_mono;
+        min_stride = (cfg->width + 7) / 8;
+        break;
+    default:
+        return ESP_ERR_INVALID_ARG;
+    }
+    int stride = cfg->stride ? cfg->stride : min_stride;
+    if (stride < min_stride) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int size = qrcodegen_getSize(qrcode);
+    int modules = size + 2 * cfg->border;
+    int pixels = modules * cfg->scale;
+    if (cfg->x + pixels > cfg->width || cfg->y + pixels > cfg->height) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint8_t *first_row = (uint8_t *)cfg->buffer + (size_t)cfg->y * stride;
+    for (int my = -cfg->border; my < size + cfg->border; my++) {
+        uint8_t *row = first_row + (size_t)(my + cfg->border) * cfg->scale * stride;
+
+        /* Draw runs of modules of the same color, qrcodegen_getModule() is light outside of the symbol */
+        int mx = -cfg->border;
+        while (mx < size + cfg->border) {
+            bool dark = qrcodegen_getModule(qrcode, mx, my);
+            int run = 1;
+            while (mx + run < size + cfg->border && qrcodegen_getModule(qrcode, mx + run, my) == dark) {
+                run++;
+            }
+            fill(row, cfg->x + (mx + cfg->border) * cfg->scale, run * cfg->scale,
+                 dark ? cfg->dark_color : cfg->light_color);
+            mx += run;
+        }
+
+        /* The other pixel rows of the module row are the same */
+        for (int i = 1; i < cfg->scale; i++) {
+            if (cfg->format == ESP_QRCODE_PIXEL_FORMAT_RGB565) {
+                memcpy(row + i * stride + cfg->x * 2, row + cfg->x * 2, pixels * 2);
+            } else {
+                uint8_t *dst = row + i * stride;
+                int start = cfg->x;
+                int end = cfg->x + pixels;
+                /* Copy whole bytes inside the span, and the partial bytes at its ends bit by bit */
+                while (start < end && (start & 7)) {
+                    fill_mono(dst, start, 1, row[start >> 3] & (0x80 >> (start & 7)));
+                    start++;
+                }
+                int bytes = (end - start) / 8;
+                memcpy(dst + (start >> 3), row + (start >> 3), bytes);
+                for (start += bytes * 8; start < end; start++) {
+                    fill_mono(dst, start, 1, row[start >> 3] & (0x80 >> (start & 7)));
+                }
+            }
+        }
+    }
+    return ESP_OK;
+}
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <esp_err.h>
 
 #ifdef __cplusplus
@@ -24,6 +26,7 @@ typedef struct {
     void (*display_func)(esp_qrcode_handle_t qrcode);   /**< Function called for displaying the QR Code after encoding is complete */
     int max_qrcode_version;                             /**< Max QR Code Version to be used. Range: 2 - 40 */
     int qrcode_ecc_level;                               /**< Error Correction Level for QR Code */
+    int qrcode_mask;                                    /**< Mask pattern for QR Code, ESP_QRCODE_MASK_AUTO to choose the best one */
 } esp_qrcode_config_t;
 
 /**
@@ -36,6 +39,25 @@ enum {
     ESP_QRCODE_ECC_HIGH     /**< QR Code Error Tolerance of 30% */
 };
 
+/**
+  * @brief  Mask pattern of a QR Code Symbol
+  *
+  * With ESP_QRCODE_MASK_AUTO, the QR Code is masked with each of the 8 patterns to
+  * choose the one which is easiest to scan, which takes most of the encoding time.
+  * A fixed pattern makes encoding faster, and the QR Code is still valid.
+  */
+enum {
+    ESP_QRCODE_MASK_AUTO,   /**< Choose the best mask pattern */
+    ESP_QRCODE_MASK_0,      /**< Mask pattern 0 */
+    ESP_QRCODE_MASK_1,      /**< Mask pattern 1 */
+    ESP_QRCODE_MASK_2,      /**< Mask pattern 2 */
+    ESP_QRCODE_MASK_3,      /**< Mask pattern 3 */
+    ESP_QRCODE_MASK_4,      /**< Mask pattern 4 */
+    ESP_QRCODE_MASK_5,      /**< Mask pattern 5 */
+    ESP_QRCODE_MASK_6,      /**< Mask pattern 6 */
+    ESP_QRCODE_MASK_7,      /**< Mask pattern 7 */
+};
+
 /**
   * @brief  Encodes the given string into a QR Code and calls the display function
   *
@@ -86,10 +108,191 @@ int esp_qrcode_get_size(esp_qrcode_handle_t qrcode);
   */
 bool esp_qrcode_get_module(esp_qrcode_handle_t qrcode, int x, int y);
 
+/**
+  * @brief  QR Code encoder handle, holding the buffers used for encoding
+  */
+typedef struct esp_qrcode_encoder *esp_qrcode_encoder_handle_t;
+
+/**
+  * @brief  Creates a QR Code encoder
+  *
+  * The encoder allocates the buffers for max_qrcode_version once, so that several
+  * QR Codes can be encoded without allocating memory. display_func is not used.
+  *
+  * @param  cfg          Configuration used for QR Code encoding.
+  * @param  ret_encoder  Created encoder.
+  *
+  * @return
+  *    - ESP_OK: succeed
+  *    - ESP_ERR_INVALID_ARG: Invalid argument
+  *    - ESP_ERR_NO_MEM: Failed to allocate buffers for given max_qrcode_version
+  */
+esp_err_t esp_qrcode_encoder_create(const esp_qrcode_config_t *cfg, esp_qrcode_encoder_handle_t *ret_encoder);
+
+/**
+  * @brief  Deletes a QR Code encoder and its buffers
+  *
+  * @param  encoder  Encoder to delete.
+  */
+void esp_qrcode_encoder_delete(esp_qrcode_encoder_handle_t encoder);
+
+/**
+  * @brief  Encodes the given string into a QR Code with an encoder
+  *
+  * @attention 1. The QR Code is stored in the encoder. It is valid until the next call to
+  *               esp_qrcode_encode() or esp_qrcode_encoder_delete() with the same encoder.
+  *
+  * @param  encoder     Encoder to use.
+  * @param  text        String to encode into a QR Code.
+  * @param  ret_qrcode  QR Code handle, which can be used with esp_qrcode_render() and the other functions.
+  *
+  * @return
+  *    - ESP_OK: succeed
+  *    - ESP_ERR_INVALID_ARG: Invalid argument
+  *    - ESP_FAIL: Failed to encode string into a QR Code
+  */
+esp_err_t esp_qrcode_encode(esp_qrcode_encoder_handle_t encoder, const char *text, esp_qrcode_handle_t *ret_qrcode);
+
+/**
+  * @brief  Encodes binary data into a QR Code with an encoder
+  *
+  * The data is encoded in byte mode as is, without having to be converted to text first.
+  *
+  * @attention 1. The QR Code is valid until the next encoding or esp_qrcode_encoder_delete() with the same encoder.
+  *
+  * @param  encoder     Encoder to use.
+  * @param  data        Data to encode into a QR Code.
+  * @param  len         Length of the data, up to 2953 bytes depending on max_qrcode_version and the ECC level.
+  * @param  ret_qrcode  QR Code handle.
+  *
+  * @return
+  *    - ESP_OK: succeed
+  *    - ESP_ERR_INVALID_ARG: Invalid argument
+  *    - ESP_FAIL: Failed to encode data into a QR Code
+  */
+esp_err_t esp_qrcode_encode_binary(esp_qrcode_encoder_handle_t encoder, const uint8_t *data, size_t len,
+                                   esp_qrcode_handle_t *ret_qrcode);
+
+/**
+  * @brief  Mode of a QR Code segment
+  */
+enum {
+    ESP_QRCODE_SEGMENT_NUMERIC,         /**< Digits, 3 per 10 bits */
+    ESP_QRCODE_SEGMENT_ALPHANUMERIC,    /**< Digits, upper case letters and " $%*+-./:", 2 per 11 bits */
+    ESP_QRCODE_SEGMENT_BYTE,            /**< Any bytes, 8 bits each */
+};
+
+/** Maximum number of segments of a QR Code encoded by esp_qrcode_encode_segments() */
+#define ESP_QRCODE_MAX_SEGMENTS 8
+
+/**
+  * @brief  QR Code segment
+  */
+typedef struct {
+    int mode;           /**< ESP_QRCODE_SEGMENT_NUMERIC, ESP_QRCODE_SEGMENT_ALPHANUMERIC or ESP_QRCODE_SEGMENT_BYTE */
+    const void *data;   /**< NUL terminated string for the numeric and alphanumeric modes, bytes for the byte mode */
+    size_t len;         /**< Number of bytes of data, only used in byte mode */
+} esp_qrcode_segment_t;
+
+/**
+  * @brief  Encodes segments of different modes into a QR Code with an encoder
+  *
+  * Encoding each part of the payload in the most compact mode, e.g. a numeric serial number
+  * followed by a URL in byte mode, may give a smaller QR Code than encoding the whole payload as text.
+  *
+  * @attention 1. The QR Code is valid until the next encoding or esp_qrcode_encoder_delete() with the same encoder.
+  * @attention 2. The encoder allocates a buffer for the segment data on the first call, which it keeps.
+  *
+  * @param  encoder     Encoder to use.
+  * @param  segs        Segments to encode, in order.
+  * @param  count       Number of segments, up to ESP_QRCODE_MAX_SEGMENTS.
+  * @param  ret_qrcode  QR Code handle.
+  *
+  * @return
+  *    - ESP_OK: succeed
+  *    - ESP_ERR_INVALID_ARG: Invalid argument, or the data of a segment is invalid for its mode
+  *    - ESP_ERR_NO_MEM: Failed to allocate the segment buffer
+  *    - ESP_FAIL: Failed to encode the segments into a QR Code
+  */
+esp_err_t esp_qrcode_encode_segments(esp_qrcode_encoder_handle_t encoder, const esp_qrcode_segment_t *segs, size_t count,
+                                     esp_qrcode_handle_t *ret_qrcode);
+
+/**
+  * @brief  Function called by esp_qrcode_encode_batch() for each QR Code
+  *
+  * @param  arg     Argument given to esp_qrcode_encode_batch().
+  * @param  index   Index of the text in the batch.
+  * @param  qrcode  QR Code of the text, valid until the function returns.
+  */
+typedef void (*esp_qrcode_batch_cb_t)(void *arg, size_t index, esp_qrcode_handle_t qrcode);
+
+/**
+  * @brief  Encodes several strings into QR Codes with an encoder
+  *
+  * The buffers of the encoder are reused for every QR Code, cb is called with each of them in turn,
+  * for example to print a label. Encoding stops at the first string which cannot be encoded.
+  *
+  * @param  encoder  Encoder to use.
+  * @param  texts    Strings to encode.
+  * @param  count    Number of strings.
+  * @param  cb       Function called with each QR Code.
+  * @param  arg      Argument passed to cb.
+  *
+  * @return
+  *    - ESP_OK: succeed
+  *    - ESP_ERR_INVALID_ARG: Invalid argument
+  *    - ESP_FAIL: Failed to encode one of the strings into a QR Code
+  */
+esp_err_t esp_qrcode_encode_batch(esp_qrcode_encoder_handle_t encoder, const char *const texts[], size_t count,
+                                  esp_qrcode_batch_cb_t cb, void *arg);
+
+/**
+  * @brief  Pixel format of the framebuffer used by esp_qrcode_render()
+  */
+typedef enum {
+    ESP_QRCODE_PIXEL_FORMAT_RGB565, /**< 16 bits per pixel */
+    ESP_QRCODE_PIXEL_FORMAT_MONO,   /**< 1 bit per pixel, most significant bit first */
+} esp_qrcode_pixel_format_t;
+
+/**
+  * @brief  Configuration of esp_qrcode_render()
+  */
+typedef struct {
+    void *buffer;                       /**< Framebuffer */
+    esp_qrcode_pixel_format_t format;   /**< Pixel format of the framebuffer */
+    int width;                          /**< Width of the framebuffer in pixels */
+    int height;                         /**< Height of the framebuffer in pixels */
+    int stride;                         /**< Bytes per row of the framebuffer, 0 for rows without padding */
+    int x;                              /**< Left of the QR Code in the framebuffer, including the border */
+    int y;                              /**< Top of the QR Code in the framebuffer, including the border */
+    int scale;                          /**< Pixels per module */
+    int border;                         /**< Width of the light border around the QR Code, in modules */
+    uint16_t dark_color;                /**< Color of dark modules, in the byte order of the framebuffer. For MONO, any value but 0 sets the bit. */
+    uint16_t light_color;               /**< Color of light modules and of the border, as dark_color */
+} esp_qrcode_render_config_t;
+
+/**
+  * @brief  Draws a QR Code into a framebuffer
+  *
+  * Each row of modules is drawn once, as spans of same colored modules, and is then
+  * copied to the other pixel rows of the module row.
+  * The QR Code takes (esp_qrcode_get_size() + 2 * border) * scale pixels in both directions.
+  *
+  * @param  qrcode  QR Code handle.
+  * @param  cfg     Framebuffer and placement of the QR Code.
+  *
+  * @return
+  *    - ESP_OK: succeed
+  *    - ESP_ERR_INVALID_ARG: Invalid argument
+  *    - ESP_ERR_INVALID_SIZE: The QR Code does not fit in the framebuffer at the given position
+  */
+esp_err_t esp_qrcode_render(esp_qrcode_handle_t qrcode, const esp_qrcode_render_config_t *cfg);
+
 #define ESP_QRCODE_CONFIG_DEFAULT() (esp_qrcode_config_t) { \
     .display_func = esp_qrcode_print_console, \
     .max_qrcode_version = 10, \
     .qrcode_ecc_level = ESP_QRCODE_ECC_LOW, \
+    .qrcode_mask = ESP_QRCODE_MASK_AUTO, \
 }
 
 #ifdef __cplusplus
@@ -72,6 +72,10 @@ static void fillRectangle(int left, int top, int width, int height, uint8_t qrco
 static void drawCodewords(const uint8_t data[], int dataLen, uint8_t qrcode[]);
 static void applyMask(const uint8_t functionModules[], uint8_t qrcode[], enum qrcodegen_Mask mask);
 static long getPenaltyScore(const uint8_t qrcode[]);
+static uint32_t lineMask(int n);
+static void getLineBits(const uint8_t qrcode[], int start, int step, uint32_t line[]);
+static void shiftLineRight(const uint32_t line[], int words, uint32_t result[]);
+static long getLinePenalty(const uint32_t line[], int qrsize);
 static int finderPenaltyCountPatterns(const int runHistory[7], int qrsize);
 static int finderPenaltyTerminateAndCount(bool currentRunColor, int currentRunLength, int runHistory[7], int qrsize);
 static void finderPenaltyAddHistory(int currentRunLength, int runHistory[7]);
@@ -680,91 +684,151 @@ static void applyMask(const uint8_t functionModules[], uint8_t qrcode[], enum qr
 }
 
 
+// Number of 32-bit words holding a row or a column of modules of the largest QR Code.
+#define LINE_WORDS ((qrcodegen_VERSION_MAX * 4 + 17 + 31) / 32)
+
 // Calculates and returns the penalty score based on state of the given QR Code's current modules.
 // This is used by the automatic mask choice algorithm to find the mask pattern that yields the lowest score.
+// Rows and columns are packed into words, bit x of a line being module x, so that runs are found
+// from the color changes of a line and 2*2 blocks and dark modules are counted a word at a time.
 static long getPenaltyScore(const uint8_t qrcode[])
 {
     int qrsize = qrcodegen_getSize(qrcode);
+    int words = (qrsize + 31) / 32;
     long result = 0;
+    uint32_t lines[2][LINE_WORDS];
+    int black = 0;
 
-    // Adjacent modules in row having same color, and finder-like patterns
+    // Rows: runs and finder-like patterns, 2*2 blocks with the previous row, and the dark modules
     for (int y = 0; y < qrsize; y++) {
-        bool runColor = false;
-        int runX = 0;
-        int runHistory[7] = {0};
-        int padRun = qrsize;  // Add white border to initial run
-        for (int x = 0; x < qrsize; x++) {
-            if (getModule(qrcode, x, y) == runColor) {
-                runX++;
-                if (runX == 5) {
-                    result += PENALTY_N1;
-                } else if (runX > 5) {
-                    result++;
-                }
-            } else {
-                finderPenaltyAddHistory(runX + padRun, runHistory);
-                padRun = 0;
-                if (!runColor) {
-                    result += finderPenaltyCountPatterns(runHistory, qrsize) * PENALTY_N3;
+        uint32_t *row = lines[y & 1];
+        const uint32_t *prev = lines[(y & 1) ^ 1];
+        getLineBits(qrcode, y * qrsize, 1, row);
+        result += getLinePenalty(row, qrsize);
+        if (y > 0) {
+            uint32_t prevShifted[LINE_WORDS], rowShifted[LINE_WORDS];
+            shiftLineRight(prev, words, prevShifted);
+            shiftLineRight(row, words, rowShifted);
+            for (int i = 0; i < words; i++) {
+                // Bit x set if modules x and x+1 of both rows have the same color
+                uint32_t same = ~(prev[i] ^ prevShifted[i]) & ~(row[i] ^ rowShifted[i]) & ~(prev[i] ^ row[i]);
+                if (i == words - 1) {
+                    same &= lineMask(qrsize - 1 - i * 32);
                 }
-                runColor = getModule(qrcode, x, y);
-                runX = 1;
+                result += (long)__builtin_popcount(same) * PENALTY_N2;
             }
         }
-        result += finderPenaltyTerminateAndCount(runColor, runX + padRun, runHistory, qrsize) * PENALTY_N3;
+        for (int i = 0; i < words; i++) {
+            black += __builtin_popcount(row[i]);
+        }
     }
-    // Adjacent modules in column having same color, and finder-like patterns
+
+    // Columns: runs and finder-like patterns
     for (int x = 0; x < qrsize; x++) {
-        bool runColor = false;
-        int runY = 0;
-        int runHistory[7] = {0};
-        int padRun = qrsize;  // Add white border to initial run
-        for (int y = 0; y < qrsize; y++) {
-            if (getModule(qrcode, x, y) == runColor) {
-                runY++;
-                if (runY == 5) {
-                    result += PENALTY_N1;
-                } else if (runY > 5) {
-                    result++;
-                }
-            } else {
-                finderPenaltyAddHistory(runY + padRun, runHistory);
-                padRun = 0;
-                if (!runColor) {
-                    result += finderPenaltyCountPatterns(runHistory, qrsize) * PENALTY_N3;
-                }
-                runColor = getModule(qrcode, x, y);
-                runY = 1;
-            }
-        }
-        result += finderPenaltyTerminateAndCount(runColor, runY + padRun, runHistory, qrsize) * PENALTY_N3;
+        getLineBits(qrcode, x, qrsize, lines[0]);
+        result += getLinePenalty(lines[0], qrsize);
     }
 
-    // 2*2 blocks of modules having same color
-    for (int y = 0; y < qrsize - 1; y++) {
-        for (int x = 0; x < qrsize - 1; x++) {
-            bool  color = getModule(qrcode, x, y);
-            if (  color == getModule(qrcode, x + 1, y) &&
-                    color == getModule(qrcode, x, y + 1) &&
-                    color == getModule(qrcode, x + 1, y + 1)) {
-                result += PENALTY_N2;
+    // Balance of black and white modules
+    int total = qrsize * qrsize;  // Note that size is odd, so black/total != 1/2
+    // Compute the smallest integer k >= 0 such that (45-5k)% <= black/total <= (55+5k)%
+    int k = (int)((labs(black * 20L - total * 10L) + total - 1) / total) - 1;
+    result += k * PENALTY_N4;
+    return result;
+}
+
+
+// Returns a mask of the low n bits of a word, n in [0, 32].
+static uint32_t lineMask(int n)
+{
+    return n >= 32 ? UINT32_MAX : ((uint32_t)1 << n) - 1;
+}
+
+
+// Packs qrsize modules of the QR Code, starting at module index start (y * qrsize + x)
+// and separated by step indices, into the words of line. Unused bits are cleared.
+static void getLineBits(const uint8_t qrcode[], int start, int step, uint32_t line[])
+{
+    int qrsize = qrcode[0];
+    memset(line, 0, LINE_WORDS * sizeof(line[0]));
+    if (step == 1) {
+        // Row: the modules are consecutive bits of the buffer, gathered a byte at a time
+        int end = start + qrsize;
+        for (int i = 0; i < qrsize; ) {
+            int index = start + i;
+            int bits = 8 - (index & 7);
+            if (bits > end - index) {
+                bits = end - index;
             }
+            uint32_t val = (qrcode[(index >> 3) + 1] >> (index & 7)) & lineMask(bits);
+            line[i >> 5] |= val << (i & 31);
+            if ((i & 31) + bits > 32) {
+                line[(i >> 5) + 1] |= val >> (32 - (i & 31));
+            }
+            i += bits;
+        }
+    } else {
+        for (int i = 0, index = start; i < qrsize; i++, index += step) {
+            line[i >> 5] |= (uint32_t)getBit(qrcode[(index >> 3) + 1], index & 7) << (i & 31);
         }
     }
+}
 
-    // Balance of black and white modules
-    int black = 0;
-    for (int y = 0; y < qrsize; y++) {
-        for (int x = 0; x < qrsize; x++) {
-            if (getModule(qrcode, x, y)) {
-                black++;
+
+// Shifts a packed line right by one module: bit x of the result is module x+1.
+static void shiftLineRight(const uint32_t line[], int words, uint32_t result[])
+{
+    for (int i = 0; i < words; i++) {
+        result[i] = (line[i] >> 1) | (i + 1 < words ? line[i + 1] << 31 : 0);
+    }
+}
+
+
+// Returns the penalty of the runs of same colored modules and of the finder-like
+// patterns of a packed row or column. Same result as scanning the line module by
+// module, but each run is found from the next color change of the line.
+static long getLinePenalty(const uint32_t line[], int qrsize)
+{
+    int words = (qrsize + 31) / 32;
+    uint32_t shifted[LINE_WORDS];
+    long result = 0;
+    bool runColor = false;
+    int runLength = 0;
+    int runHistory[7] = {0};
+    int padRun = qrsize;  // Add white border to initial run
+
+    shiftLineRight(line, words, shifted);
+    int start = 0;
+    for (int i = 0; i < words; i++) {
+        // Bit x set if modules x and x+1 differ, the last module always ends a run
+        uint32_t changes = line[i] ^ shifted[i];
+        if (i == words - 1) {
+            changes = (changes & lineMask(qrsize - 1 - i * 32)) | ((uint32_t)1 << ((qrsize - 1) & 31));
+        }
+        while (changes) {
+            int end = i * 32 + __builtin_ctz(changes);
+            changes &= changes - 1;
+            bool color = (line[start >> 5] >> (start & 31)) & 1;
+            int length = end - start + 1;
+            start = end + 1;
+
+            if (color != runColor) {
+                finderPenaltyAddHistory(runLength + padRun, runHistory);
+                padRun = 0;
+                if (!runColor) {
+                    result += finderPenaltyCountPatterns(runHistory, qrsize) * PENALTY_N3;
+                }
+                runColor = color;
+                runLength = 0;
+            }
+            // Only the first run of the line can follow a run of the same color, the white border
+            runLength += length;
+            if (length >= 5) {
+                result += PENALTY_N1 + (length - 5);
             }
         }
     }
-    int total = qrsize * qrsize;  // Note that size is odd, so black/total != 1/2
-    // Compute the smallest integer k >= 0 such that (45-5k)% <= black/total <= (55+5k)%
-    int k = (int)((labs(black * 20L - total * 10L) + total - 1) / total) - 1;
-    result += k * PENALTY_N4;
+    result += finderPenaltyTerminateAndCount(runColor, runLength + padRun, runHistory, qrsize) * PENALTY_N3;
     return result;
 }
 
@@ -0,0 +1,159 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "jpeg_decoder.h"
+#include "quirc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Decode a JPEG image into the image buffer of quirc
+ *
+ * The image is decoded to grayscale by esp_jpeg directly into the buffer returned by quirc_begin(),
+ * there is no RGB buffer nor extra copy. The quirc buffer is resized to the size of the scaled image if needed.
+ * After it returns, call quirc_end() to find the QR codes.
+ *
+ * @param q: quirc instance
+ * @param decoder: Reusable JPEG decoder, e.g. for camera frames, or NULL to allocate one for this image
+ * @param jpeg: JPEG image
+ * @param len: Size of the JPEG image
+ * @param scale: Scale of the image, a downscaled image is faster to decode and search for QR codes
+ *
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if invalid argument
+ *      - ESP_ERR_NO_MEM        if the quirc buffer cannot be resized
+ *      - ESP_ERR_NOT_SUPPORTED if esp_jpeg is configured without grayscale output
+ *      - ESP_FAIL              if the JPEG image cannot be decoded
+ */
+esp_err_t esp_quirc_load_jpeg(struct quirc *q, esp_jpeg_decoder_handle_t decoder, const uint8_t *jpeg, size_t len,
+                              esp_jpeg_image_scale_t scale);
+
+/**
+ * @brief Load the luma of a YUV422 frame into the image buffer of quirc
+ *
+ * The frame is packed as Y0 U Y1 V (YUYV), as output by cameras in YUV422 mode and by esp_jpeg.
+ * Only the Y bytes are read. With `downscale` > 1, each pixel of quirc is the average of a
+ * `downscale` x `downscale` block of the frame. The quirc buffer is resized if needed.
+ * After it returns, call quirc_end() to find the QR codes.
+ *
+ * @param q: quirc instance
+ * @param frame: YUV422 frame, `width * 2` bytes per row
+ * @param width: Width of the frame in pixels
+ * @param height: Height of the frame in pixels
+ * @param downscale: 1, 2 or 4
+ *
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if invalid argument
+ *      - ESP_ERR_NO_MEM        if the quirc buffer cannot be resized
+ */
+esp_err_t esp_quirc_load_yuv422(struct quirc *q, const uint8_t *frame, int width, int height, int downscale);
+
+/**
+ * @brief Handle of a QR code scanner
+ */
+typedef struct esp_quirc_scanner_s *esp_quirc_scanner_handle_t;
+
+/**
+ * @brief QR code scanner configuration
+ */
+typedef struct {
+    int max_codes;              /*!< Maximum number of candidate codes decoded per frame */
+    int roi_margin;             /*!< Margin around the codes found in the previous frame, in pixels */
+    int full_frame_interval;    /*!< Frames between two searches of the whole frame while tracking, 0 to always search the whole frame */
+    size_t task_stack_size;     /*!< Stack size of the decoding task on the other core, in bytes */
+    struct {
+        uint8_t dual_core: 1;   /*!< Decode half of the candidate codes on the other core */
+    } flags;
+} esp_quirc_scanner_config_t;
+
+/** Default QR code scanner configuration */
+#define ESP_QUIRC_SCANNER_DEFAULT_CONFIG() {    \
+    .max_codes = 4,                             \
+    .roi_margin = 48,                           \
+    .full_frame_interval = 15,                  \
+    .task_stack_size = 12288,                   \
+    .flags = {                                  \
+        .dual_core = 0,                         \
+    },                                          \
+}
+
+/**
+ * @brief QR code found by the scanner
+ */
+typedef struct {
+    struct quirc_point corners[4];  /*!< Corners of the code in the frame */
+    struct quirc_data data;         /*!< Decoded data */
+} esp_quirc_result_t;
+
+/**
+ * @brief Create a QR code scanner for continuous scanning of frames
+ *
+ * When a frame contains codes, the scanner searches the next frames only in the region around them,
+ * which is much faster than the whole frame. The whole frame is searched again when no code is found
+ * in the region, and every `full_frame_interval` frames to find new codes.
+ *
+ * @param config: Scanner configuration
+ * @param ret_scanner: Returned scanner handle
+ *
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if invalid argument
+ *      - ESP_ERR_NOT_SUPPORTED if `flags.dual_core` is set on a single core target
+ *      - ESP_ERR_NO_MEM        if there is no memory for the scanner
+ */
+esp_err_t esp_quirc_scanner_create(const esp_quirc_scanner_config_t *config, esp_quirc_scanner_handle_t *ret_scanner);
+
+/**
+ * @brief Delete a QR code scanner
+ *
+ * @param scanner: Scanner handle
+ */
+void esp_quirc_scanner_delete(esp_quirc_scanner_handle_t scanner);
+
+/**
+ * @brief Get the quirc instance holding the frames of a scanner
+ *
+ * Each frame is loaded into this instance before calling esp_quirc_scanner_scan(), with
+ * esp_quirc_load_jpeg(), esp_quirc_load_yuv422(), or quirc_resize() and quirc_begin().
+ *
+ * @param scanner: Scanner handle
+ *
+ * @return quirc instance of the scanner
+ */
+struct quirc *esp_quirc_scanner_get_quirc(esp_quirc_scanner_handle_t scanner);
+
+/**
+ * @brief Find and decode the QR codes of the frame loaded in a scanner
+ *
+ * The frame is consumed, it must be loaded again before the next scan.
+ * The calling task needs about 10 kB of stack, as for quirc_end() and quirc_decode().
+ *
+ * @param scanner: Scanner handle
+ * @param results: Array receiving the decoded codes
+ * @param max_results: Size of the results array
+ * @param ret_count: Number of decoded codes
+ *
+ * @return
+ *      - ESP_OK                on success, also when no code is found
+ *      - ESP_ERR_INVALID_ARG   if invalid argument
+ *      - ESP_ERR_NO_MEM        if there is no memory for the region of the previous codes
+ */
+esp_err_t esp_quirc_scanner_scan(esp_quirc_scanner_handle_t scanner, esp_quirc_result_t *results, int max_results,
+                                 int *ret_count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_check.h"
+#include "esp_quirc.h"
+
+static const char *TAG = "esp_quirc";
+
+static esp_err_t esp_quirc_prepare(struct quirc *q, int width, int height, uint8_t **image)
+{
+    int cur_width, cur_height;
+    quirc_begin(q, &cur_width, &cur_height);
+    if (cur_width != width || cur_height != height) {
+        ESP_RETURN_ON_FALSE(quirc_resize(q, width, height) == 0, ESP_ERR_NO_MEM, TAG, "Failed to resize quirc to %dx%d", width, height);
+    }
+    *image = quirc_begin(q, NULL, NULL);
+    return ESP_OK;
+}
+
+esp_err_t esp_quirc_load_jpeg(struct quirc *q, esp_jpeg_decoder_handle_t decoder, const uint8_t *jpeg, size_t len,
+                              esp_jpeg_image_scale_t scale)
+{
+    ESP_RETURN_ON_FALSE(q && jpeg && len && scale <= JPEG_IMAGE_SCALE_1_8, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+
+    esp_jpeg_image_cfg_t cfg = {
+        .indata = (uint8_t *)jpeg,
+        .indata_size = len,
+        .out_format = JPEG_IMAGE_FORMAT_GRAY,
+        .out_scale = scale,
+    };
+    esp_jpeg_image_info_t info;
+    ESP_RETURN_ON_ERROR(esp_jpeg_get_image_info(&cfg, &info), TAG, "Failed to parse JPEG headers");
+    ESP_RETURN_ON_FALSE(info.supported, ESP_FAIL, TAG, "Unsupported JPEG image");
+
+    const int div = 1 << scale;
+    uint8_t *image;
+    ESP_RETURN_ON_ERROR(esp_quirc_prepare(q, info.width / div, info.height / div, &image), TAG, "");
+
+    // Decode the grayscale image straight into the quirc buffer
+    cfg.outbuf = image;
+    cfg.outbuf_size = info.output_size[scale];
+    esp_jpeg_image_output_t img;
+    esp_err_t ret = decoder ? esp_jpeg_decoder_decode(decoder, &cfg, &img) : esp_jpeg_decode(&cfg, &img);
+    ESP_RETURN_ON_ERROR(ret, TAG, "Failed to decode JPEG image");
+    return ESP_OK;
+}
+
+esp_err_t esp_quirc_load_yuv422(struct quirc *q, const uint8_t *frame, int width, int height, int downscale)
+{
+    ESP_RETURN_ON_FALSE(q && frame && width > 0 && height > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(downscale == 1 || downscale == 2 || downscale == 4, ESP_ERR_INVALID_ARG, TAG, "Invalid downscale");
+
+    const int out_width = width / downscale;
+    const int out_height = height / downscale;
+    ESP_RETURN_ON_FALSE(out_width && out_height, ESP_ERR_INVALID_ARG, TAG, "Frame too small");
+    uint8_t *image;
+    ESP_RETURN_ON_ERROR(esp_quirc_prepare(q, out_width, out_height, &image), TAG, "");
+
+    const size_t stride = (size_t)width * 2;
+    if (downscale == 1) {
+        for (int y = 0; y < out_height; y++) {
+            const uint8_t *src = frame + y * stride;
+            for (int x = 0; x < out_width; x++) {
+                image[x] = src[x * 2];
+            }
+            image += out_width;
+        }
+        return ESP_OK;
+    }
+
+    // Average blocks of downscale x downscale luma samples
+    const int shift = downscale == 2 ? 2 : 4;
+    for (int y = 0; y < out_height; y++) {
+        const uint8_t *row = frame + (size_t)y * downscale * stride;
+        for (int x = 0; x < out_width; x++) {
+            const uint8_t *src = row + x * downscale * 2;
+            unsigned int sum = 0;
+            for (int dy = 0; dy < downscale; dy++) {
+                for (int dx = 0; dx < downscale; dx++) {
+                    sum += src[dx * 2];
+                }
+                src += stride;
+            }
+            image[x] = sum >> shift;
+        }
+        image += out_width;
+    }
+    return ESP_OK;
+}
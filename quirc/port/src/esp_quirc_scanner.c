@@ -0,0 +1,309 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_check.h"
+#include "esp_quirc.h"
+
+/* Decoding on the other core needs a second core */
+#if !CONFIG_FREERTOS_UNICORE && (portNUM_PROCESSORS > 1)
+#define SCANNER_DUAL_CORE_SUPPORTED 1
+#else
+#define SCANNER_DUAL_CORE_SUPPORTED 0
+#endif
+
+/* The region is rounded up to this size, so that it is not reallocated while the codes move a little */
+#define SCANNER_ROI_ALIGN   32
+
+static const char *TAG = "esp_quirc_scanner";
+
+typedef struct {
+    TaskHandle_t task;
+    SemaphoreHandle_t done;     /* Given by the worker when its codes are decoded */
+    bool exit;
+} scanner_worker_t;
+
+struct esp_quirc_scanner_s {
+    esp_quirc_scanner_config_t cfg;
+    struct quirc *frame;        /* Frames loaded by the user */
+    struct quirc *roi;          /* Copy of the region around the previous codes */
+    bool tracking;              /* Codes were found in the previous frame */
+    int roi_x, roi_y, roi_w, roi_h;
+    int frames_since_full;
+    struct quirc_code *codes;   /* Candidate codes of the current frame */
+    quirc_decode_error_t *errs;
+    esp_quirc_result_t *results;
+    int count;
+    scanner_worker_t *worker;
+};
+
+static void scanner_decode(struct esp_quirc_scanner_s *scanner, int first, int step)
+{
+    for (int i = first; i < scanner->count; i += step) {
+        scanner->errs[i] = quirc_decode(&scanner->codes[i], &scanner->results[i].data);
+    }
+}
+
+#if SCANNER_DUAL_CORE_SUPPORTED
+static void scanner_task(void *arg)
+{
+    struct esp_quirc_scanner_s *scanner = (struct esp_quirc_scanner_s *)arg;
+    scanner_worker_t *worker = scanner->worker;
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (worker->exit) {
+            break;
+        }
+        /* Odd codes, the even ones are decoded by the scanning task */
+        scanner_decode(scanner, 1, 2);
+        xSemaphoreGive(worker->done);
+    }
+
+    xSemaphoreGive(worker->done);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t scanner_worker_create(struct esp_quirc_scanner_s *scanner)
+{
+    esp_err_t ret = ESP_OK;
+    scanner_worker_t *worker = calloc(1, sizeof(scanner_worker_t));
+    ESP_RETURN_ON_FALSE(worker, ESP_ERR_NO_MEM, TAG, "no mem for scanner worker");
+    scanner->worker = worker;
+
+    worker->done = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(worker->done, ESP_ERR_NO_MEM, err, TAG, "no mem for scanner semaphore");
+
+    /* The worker runs on the other core with the same priority as the creator */
+    BaseType_t core = (xPortGetCoreID() == 0) ? 1 : 0;
+    BaseType_t res = xTaskCreatePinnedToCore(scanner_task, "quirc_decode", scanner->cfg.task_stack_size, scanner,
+                     uxTaskPriorityGet(NULL), &worker->task, core);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "no mem for scanner task");
+    return ESP_OK;
+
+err:
+    if (worker->done) {
+        vSemaphoreDelete(worker->done);
+    }
+    free(worker);
+    scanner->worker = NULL;
+    return ret;
+}
+
+static void scanner_worker_destroy(scanner_worker_t *worker)
+{
+    worker->exit = true;
+    xTaskNotifyGive(worker->task);
+    xSemaphoreTake(worker->done, portMAX_DELAY);
+
+    vSemaphoreDelete(worker->done);
+    free(worker);
+}
+#endif
+
+esp_err_t esp_quirc_scanner_create(const esp_quirc_scanner_config_t *config, esp_quirc_scanner_handle_t *ret_scanner)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_scanner, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->max_codes > 0 && config->roi_margin >= 0 && config->full_frame_interval >= 0,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid configuration");
+#if !SCANNER_DUAL_CORE_SUPPORTED
+    ESP_RETURN_ON_FALSE(!config->flags.dual_core, ESP_ERR_NOT_SUPPORTED, TAG, "dual core decoding not supported");
+#endif
+
+    struct esp_quirc_scanner_s *scanner = calloc(1, sizeof(struct esp_quirc_scanner_s));
+    ESP_RETURN_ON_FALSE(scanner, ESP_ERR_NO_MEM, TAG, "no mem for scanner");
+    scanner->cfg = *config;
+
+    scanner->frame = quirc_new();
+    scanner->roi = quirc_new();
+    scanner->codes = calloc(config->max_codes, sizeof(struct quirc_code));
+    scanner->errs = calloc(config->max_codes, sizeof(quirc_decode_error_t));
+    ESP_GOTO_ON_FALSE(scanner->frame && scanner->roi && scanner->codes && scanner->errs, ESP_ERR_NO_MEM, err, TAG,
+                      "no mem for scanner");
+
+#if SCANNER_DUAL_CORE_SUPPORTED
+    if (config->flags.dual_core) {
+        ESP_GOTO_ON_ERROR(scanner_worker_create(scanner), err, TAG, "failed to create scanner worker");
+    }
+#endif
+
+    *ret_scanner = scanner;
+    return ESP_OK;
+
+err:
+    esp_quirc_scanner_delete(scanner);
+    return ret;
+}
+
+void esp_quirc_scanner_delete(esp_quirc_scanner_handle_t scanner)
+{
+    if (!scanner) {
+        return;
+    }
+#if SCANNER_DUAL_CORE_SUPPORTED
+    if (scanner->worker) {
+        scanner_worker_destroy(scanner->worker);
+    }
+#endif
+    if (scanner->frame) {
+        quirc_destroy(scanner->frame);
+    }
+    if (scanner->roi) {
+        quirc_destroy(scanner->roi);
+    }
+    free(scanner->codes);
+    free(scanner->errs);
+    free(scanner);
+}
+
+struct quirc *esp_quirc_scanner_get_quirc(esp_quirc_scanner_handle_t scanner)
+{
+    return scanner ? scanner->frame : NULL;
+}
+
+/* Find the codes of a quirc instance and decode them into results, returns the number of decoded codes */
+static int scanner_find(struct esp_quirc_scanner_s *scanner, struct quirc *q, int x, int y,
+                        esp_quirc_result_t *results, int max_results)
+{
+    quirc_end(q);
+
+    int count = quirc_count(q);
+    if (count > scanner->cfg.max_codes) {
+        count = scanner->cfg.max_codes;
+    }
+    if (count > max_results) {
+        count = max_results;
+    }
+    for (int i = 0; i < count; i++) {
+        quirc_extract(q, i, &scanner->codes[i]);
+    }
+
+    scanner->results = results;
+    scanner->count = count;
+#if SCANNER_DUAL_CORE_SUPPORTED
+    if (scanner->worker && count > 1) {
+        xTaskNotifyGive(scanner->worker->task);
+        scanner_decode(scanner, 0, 2);
+        xSemaphoreTake(scanner->worker->done, portMAX_DELAY);
+    } else
+#endif
+    {
+        scanner_decode(scanner, 0, 1);
+    }
+
+    /* Keep the decoded codes only, with corners in frame coordinates */
+    int found = 0;
+    for (int i = 0; i < count; i++) {
+        if (scanner->errs[i] != QUIRC_SUCCESS) {
+            continue;
+        }
+        if (found != i) {
+            results[found].data = results[i].data;
+        }
+        for (int j = 0; j < 4; j++) {
+            results[found].corners[j].x = scanner->codes[i].corners[j].x + x;
+            results[found].corners[j].y = scanner->codes[i].corners[j].y + y;
+        }
+        found++;
+    }
+    return found;
+}
+
+/* Align a side of the region to SCANNER_ROI_ALIGN around its center, within the frame */
+static void scanner_align_roi(int *pos, int *len, int frame_len)
+{
+    int aligned = (*len + SCANNER_ROI_ALIGN - 1) & ~(SCANNER_ROI_ALIGN - 1);
+    if (aligned > frame_len) {
+        aligned = frame_len;
+    }
+    int start = *pos - (aligned - *len) / 2;
+    if (start + aligned > frame_len) {
+        start = frame_len - aligned;
+    }
+    if (start < 0) {
+        start = 0;
+    }
+    *pos = start;
+    *len = aligned;
+}
+
+static void scanner_track(struct esp_quirc_scanner_s *scanner, const esp_quirc_result_t *results, int count,
+                          int width, int height)
+{
+    if (count == 0 || scanner->cfg.full_frame_interval == 0) {
+        scanner->tracking = false;
+        return;
+    }
+
+    int left = width, top = height, right = 0, bottom = 0;
+    for (int i = 0; i < count; i++) {
+        for (int j = 0; j < 4; j++) {
+            const struct quirc_point *p = &results[i].corners[j];
+            left = p->x < left ? p->x : left;
+            top = p->y < top ? p->y : top;
+            right = p->x > right ? p->x : right;
+            bottom = p->y > bottom ? p->y : bottom;
+        }
+    }
+    left = left - scanner->cfg.roi_margin > 0 ? left - scanner->cfg.roi_margin : 0;
+    top = top - scanner->cfg.roi_margin > 0 ? top - scanner->cfg.roi_margin : 0;
+    right = right + scanner->cfg.roi_margin < width ? right + scanner->cfg.roi_margin : width;
+    bottom = bottom + scanner->cfg.roi_margin < height ? bottom + scanner->cfg.roi_margin : height;
+
+    scanner->roi_x = left;
+    scanner->roi_y = top;
+    scanner->roi_w = right - left;
+    scanner->roi_h = bottom - top;
+    scanner_align_roi(&scanner->roi_x, &scanner->roi_w, width);
+    scanner_align_roi(&scanner->roi_y, &scanner->roi_h, height);
+    /* Tracking is pointless if the region is the whole frame */
+    scanner->tracking = scanner->roi_w > 0 && scanner->roi_h > 0 && (scanner->roi_w < width || scanner->roi_h < height);
+}
+
+esp_err_t esp_quirc_scanner_scan(esp_quirc_scanner_handle_t scanner, esp_quirc_result_t *results, int max_results,
+                                 int *ret_count)
+{
+    ESP_RETURN_ON_FALSE(scanner && results && max_results > 0 && ret_count, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    int width, height;
+    const uint8_t *image = quirc_begin(scanner->frame, &width, &height);
+    int found = 0;
+
+    if (scanner->tracking && scanner->frames_since_full < scanner->cfg.full_frame_interval &&
+            scanner->roi_x + scanner->roi_w <= width && scanner->roi_y + scanner->roi_h <= height) {
+        /* The frame is kept intact, in case the whole frame must be searched */
+        int roi_width, roi_height;
+        quirc_begin(scanner->roi, &roi_width, &roi_height);
+        if (roi_width != scanner->roi_w || roi_height != scanner->roi_h) {
+            ESP_RETURN_ON_FALSE(quirc_resize(scanner->roi, scanner->roi_w, scanner->roi_h) == 0, ESP_ERR_NO_MEM, TAG,
+                                "no mem for %dx%d region", scanner->roi_w, scanner->roi_h);
+        }
+        uint8_t *roi = quirc_begin(scanner->roi, NULL, NULL);
+        const uint8_t *src = image + scanner->roi_y * width + scanner->roi_x;
+        for (int y = 0; y < scanner->roi_h; y++) {
+            memcpy(roi, src, scanner->roi_w);
+            roi += scanner->roi_w;
+            src += width;
+        }
+
+        found = scanner_find(scanner, scanner->roi, scanner->roi_x, scanner->roi_y, results, max_results);
+        scanner->frames_since_full++;
+    }
+
+    if (found == 0) {
+        found = scanner_find(scanner, scanner->frame, 0, 0, results, max_results);
+        scanner->frames_since_full = 0;
+    }
+
+    scanner_track(scanner, results, found, width, height);
+    *ret_count = found;
+    return ESP_OK;
+}
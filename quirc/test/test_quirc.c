@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdint.h>
@@ -12,6 +13,7 @@
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "quirc.h"
+#include "esp_quirc.h"
 #include "unity.h"
 
 static const char *TAG = "test_quirc";
@@ -19,21 +21,26 @@ static const char *TAG = "test_quirc";
 extern const uint8_t test_qrcode_pgm_start[] asm("_binary_test_qrcode_pgm_start");
 extern const uint8_t test_qrcode_pgm_end[]   asm("_binary_test_qrcode_pgm_end");
 
-static void copy_test_image_into_quirc_buffer(struct quirc *q)
+static const uint8_t *get_test_image(int *width, int *height)
 {
     // get the size of the image from the PGM header
     const uint8_t *p = test_qrcode_pgm_start;
+    sscanf((const char *)p, "P5 %d %d 255", width, height);
+    TEST_ASSERT_EQUAL_INT(128, *width);
+    TEST_ASSERT_EQUAL_INT(113, *height);
+
+    // find the start of the image data
+    return memchr(p, '\n', test_qrcode_pgm_end - p) + 1;
+}
+
+static void copy_test_image_into_quirc_buffer(struct quirc *q)
+{
     int width, height;
-    sscanf((const char *)p, "P5 %d %d 255", &width, &height);
-    TEST_ASSERT_EQUAL_INT(128, width);
-    TEST_ASSERT_EQUAL_INT(113, height);
+    const uint8_t *p = get_test_image(&width, &height);
 
     // resize the quirc buffer to match the image
     TEST_ASSERT_EQUAL_INT(0, quirc_resize(q, width, height));
 
-    // find the start of the image data
-    p = memchr(p, '\n', test_qrcode_pgm_end - p) + 1;
-
     // copy the image into the quirc buffer
     memcpy(quirc_begin(q, NULL, NULL), p, width * height);
 }
@@ -87,3 +94,103 @@ TEST_CASE("quirc can load a QR code", "[quirc]")
 
     quirc_destroy(q);
 }
+
+TEST_CASE("quirc can load the luma of a YUV422 frame", "[quirc]")
+{
+    struct quirc *q = quirc_new();
+    TEST_ASSERT_NOT_NULL(q);
+
+    int width, height;
+    const uint8_t *image = get_test_image(&width, &height);
+
+    // make a YUYV frame of twice the size of the test image
+    const int frame_width = width * 2;
+    const int frame_height = height * 2;
+    uint8_t *frame = malloc(frame_width * frame_height * 2);
+    TEST_ASSERT_NOT_NULL(frame);
+    for (int y = 0; y < frame_height; y++) {
+        for (int x = 0; x < frame_width; x++) {
+            frame[(y * frame_width + x) * 2] = image[(y / 2) * width + x / 2];
+            frame[(y * frame_width + x) * 2 + 1] = 128;
+        }
+    }
+
+    int w, h;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_quirc_load_yuv422(q, frame, frame_width, frame_height, 1));
+    uint8_t *buf = quirc_begin(q, &w, &h);
+    TEST_ASSERT_EQUAL_INT(frame_width, w);
+    TEST_ASSERT_EQUAL_INT(frame_height, h);
+    TEST_ASSERT_EQUAL_UINT8(image[width + 1], buf[2 * frame_width + 3]);
+
+    // downscaling by 2 gives back the test image
+    TEST_ASSERT_EQUAL(ESP_OK, esp_quirc_load_yuv422(q, frame, frame_width, frame_height, 2));
+    buf = quirc_begin(q, &w, &h);
+    TEST_ASSERT_EQUAL_INT(width, w);
+    TEST_ASSERT_EQUAL_INT(height, h);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(image, buf, width * height);
+    free(frame);
+
+    quirc_decode_task_args_t args = {
+        .q = q,
+        .done = xSemaphoreCreateBinary(),
+    };
+    TEST_ASSERT(xTaskCreate(quirc_decode_task, "quirc_decode_task", 12000, &args, 5, NULL));
+    TEST_ASSERT(xSemaphoreTake(args.done, pdMS_TO_TICKS(10000)));
+    vSemaphoreDelete(args.done);
+    TEST_ASSERT_EQUAL_STRING("test of quirc", args.data.payload);
+
+    quirc_destroy(q);
+}
+
+typedef struct {
+    esp_quirc_scanner_handle_t scanner;
+    esp_quirc_result_t *results;
+    int count[3];
+    SemaphoreHandle_t done;
+} quirc_scanner_task_args_t;
+
+static void quirc_scanner_task(void *arg)
+{
+    quirc_scanner_task_args_t *args = (quirc_scanner_task_args_t *)arg;
+    int width, height;
+    const uint8_t *image = get_test_image(&width, &height);
+
+    // the code moves in a VGA frame, the second and third scans search only the region around it
+    for (int i = 0; i < 3; i++) {
+        struct quirc *q = esp_quirc_scanner_get_quirc(args->scanner);
+        TEST_ASSERT_EQUAL_INT(0, quirc_resize(q, 640, 480));
+        uint8_t *frame = quirc_begin(q, NULL, NULL);
+        memset(frame, 255, 640 * 480);
+        for (int y = 0; y < height; y++) {
+            memcpy(frame + (200 + i * 8 + y) * 640 + 300 + i * 8, image + y * width, width);
+        }
+        TEST_ASSERT_EQUAL(ESP_OK, esp_quirc_scanner_scan(args->scanner, args->results, 2, &args->count[i]));
+    }
+    xSemaphoreGive(args->done);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("quirc scanner tracks a QR code", "[quirc]")
+{
+    esp_quirc_scanner_config_t config = ESP_QUIRC_SCANNER_DEFAULT_CONFIG();
+    quirc_scanner_task_args_t args = {
+        .results = calloc(2, sizeof(esp_quirc_result_t)),
+        .done = xSemaphoreCreateBinary(),
+    };
+    TEST_ASSERT_NOT_NULL(args.results);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_quirc_scanner_create(&config, &args.scanner));
+
+    TEST_ASSERT(xTaskCreate(quirc_scanner_task, "quirc_scanner_task", 12000, &args, 5, NULL));
+    TEST_ASSERT(xSemaphoreTake(args.done, pdMS_TO_TICKS(10000)));
+    vSemaphoreDelete(args.done);
+
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(1, args.count[i]);
+    }
+    // corners are in frame coordinates
+    TEST_ASSERT_INT_WITHIN(100, 300 + 16 + 64, args.results[0].corners[0].x);
+    TEST_ASSERT_EQUAL_STRING("test of quirc", args.results[0].data.payload);
+
+    esp_quirc_scanner_delete(args.scanner);
+    free(args.results);
+}
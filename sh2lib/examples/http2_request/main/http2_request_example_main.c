@@ -136,12 +136,11 @@ static void http2_task(void *args)
     /* HTTP GET  */
     sh2lib_do_get(&hd, HTTP2_STREAMING_GET_PATH, handle_get_response);
     while (1) {
-        /* Process HTTP2 send/receive */
-        if (sh2lib_execute(&hd) < 0) {
+        /* Wait for the socket and process HTTP2 send/receive */
+        if (sh2lib_execute_wait(&hd, 1000) < 0) {
             printf("Error in send/receive\n");
             break;
         }
-        vTaskDelay(2);
     }
 
     sh2lib_free(&hd);
@@ -12,22 +12,27 @@
 #include <string.h>
 #include <unistd.h>
 #include <ctype.h>
+#include <errno.h>
+#include <stdbool.h>
 #include <netdb.h>
+#include <sys/param.h>
+#include <sys/select.h>
 #include <esp_log.h>
 #include <http_parser.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
+#include "sdkconfig.h"
 #include "sh2lib.h"
+#include "nghttp2_port.h"
 
 static const char *TAG = "sh2lib";
 
 #define DBG_FRAME_SEND 1
 
-/*
- * The implementation of nghttp2_send_callback type. Here we write
- * |data| with size |length| to the network and return the number of
- * bytes actually written. See the documentation of
- * nghttp2_send_callback for the details.
- */
+#define SH2LIB_WRITE_SIZE   CONFIG_SH2LIB_TLS_WRITE_SIZE
+#define SH2LIB_OUT_BUF_SIZE CONFIG_SH2LIB_OUTPUT_BUFFER_SIZE
+
 static ssize_t callback_send_inner(struct sh2lib_handle *hd, const uint8_t *data,
                                    size_t length)
 {
@@ -42,19 +47,19 @@ static ssize_t callback_send_inner(struct sh2lib_handle *hd, const uint8_t *data
     return rv;
 }
 
-static ssize_t callback_send(nghttp2_session *session, const uint8_t *data,
-                             size_t length, int flags, void *user_data)
+/*
+ * Writes |data| in writes of at most SH2LIB_WRITE_SIZE bytes. Returns the
+ * number of bytes written, or the error of the first write if nothing could
+ * be written.
+ */
+static ssize_t write_chunked(struct sh2lib_handle *hd, const uint8_t *data, size_t length)
 {
-    int rv = 0;
-    struct sh2lib_handle *hd = user_data;
-
-    int copy_offset = 0;
-    int pending_data = length;
+    ssize_t rv = 0;
+    size_t copy_offset = 0;
 
-    /* Send data in 1000 byte chunks */
     while (copy_offset != length) {
-        int chunk_len = pending_data > 1000 ? 1000 : pending_data;
-        int subrv = callback_send_inner(hd, data + copy_offset, chunk_len);
+        size_t chunk_len = MIN(length - copy_offset, SH2LIB_WRITE_SIZE);
+        ssize_t subrv = callback_send_inner(hd, data + copy_offset, chunk_len);
         if (subrv <= 0) {
             if (copy_offset == 0) {
                 /* If no data is transferred, send the error code */
@@ -63,12 +68,67 @@ static ssize_t callback_send(nghttp2_session *session, const uint8_t *data,
             break;
         }
         copy_offset += subrv;
-        pending_data -= subrv;
         rv += subrv;
     }
     return rv;
 }
 
+/*
+ * Writes out the coalescing buffer. Returns 0 once it is empty, or
+ * NGHTTP2_ERR_WOULDBLOCK / NGHTTP2_ERR_CALLBACK_FAILURE. Data which could not
+ * be written stays at the start of the buffer; a blocked write is retried
+ * with the same length, as required by mbedTLS.
+ */
+static int flush_out_buf(struct sh2lib_handle *hd)
+{
+    while (hd->out_len > 0) {
+        size_t chunk_len = hd->out_retry ? hd->out_retry : MIN(hd->out_len, SH2LIB_WRITE_SIZE);
+        ssize_t rv = callback_send_inner(hd, hd->out_buf, chunk_len);
+        if (rv <= 0) {
+            hd->out_retry = (rv == NGHTTP2_ERR_WOULDBLOCK) ? chunk_len : 0;
+            return rv;
+        }
+        hd->out_retry = 0;
+        hd->out_len -= rv;
+        memmove(hd->out_buf, hd->out_buf + rv, hd->out_len);
+    }
+    return 0;
+}
+
+/*
+ * The implementation of nghttp2_send_callback type. Here we write
+ * |data| with size |length| to the network and return the number of
+ * bytes actually written. See the documentation of
+ * nghttp2_send_callback for the details.
+ *
+ * Frames are collected in the coalescing buffer while they fit. The buffer
+ * is written out when full, and at the end of every sh2lib_execute().
+ */
+static ssize_t callback_send(nghttp2_session *session, const uint8_t *data,
+                             size_t length, int flags, void *user_data)
+{
+    struct sh2lib_handle *hd = user_data;
+
+#if SH2LIB_OUT_BUF_SIZE > 0
+    if (hd->out_len == SH2LIB_OUT_BUF_SIZE) {
+        int rv = flush_out_buf(hd);
+        if (rv != 0) {
+            return rv;
+        }
+    }
+    if (hd->out_len == 0 && length >= SH2LIB_OUT_BUF_SIZE) {
+        return write_chunked(hd, data, length);
+    }
+
+    size_t n = MIN(length, SH2LIB_OUT_BUF_SIZE - hd->out_len);
+    memcpy(hd->out_buf + hd->out_len, data, n);
+    hd->out_len += n;
+    return n;
+#else
+    return write_chunked(hd, data, length);
+#endif
+}
+
 /*
  * The implementation of nghttp2_recv_callback type. Here we read data
  * from the network and write them in |buf|. The capacity of |buf| is
@@ -165,11 +225,18 @@ static int callback_on_stream_close(nghttp2_session *session, int32_t stream_id,
                                     uint32_t error_code, void *user_data)
 {
     ESP_LOGD(TAG, "[stream-close][sid %" PRIi32 "]", stream_id);
+    struct sh2lib_handle *h2 = user_data;
     sh2lib_frame_data_recv_cb_t data_recv_cb = nghttp2_session_get_stream_user_data(session, stream_id);
     if (data_recv_cb) {
-        struct sh2lib_handle *h2 = user_data;
         (*data_recv_cb)(h2, NULL, 0, DATA_RECV_RST_STREAM);
     }
+    if (h2->active_streams > 0) {
+        h2->active_streams--;
+    }
+    struct sh2lib_task_config_t *task_cfg = h2->task;
+    if (task_cfg && task_cfg->stream_close_cb) {
+        task_cfg->stream_close_cb(h2, stream_id, error_code, task_cfg->arg);
+    }
     return 0;
 }
 
@@ -199,7 +266,7 @@ static int callback_on_header(nghttp2_session *session, const nghttp2_frame *fra
     return 0;
 }
 
-static int do_http2_connect(struct sh2lib_handle *hd)
+static int do_http2_connect(struct sh2lib_handle *hd, const struct sh2lib_config_t *cfg)
 {
     int ret;
     nghttp2_session_callbacks *callbacks;
@@ -211,7 +278,10 @@ static int do_http2_connect(struct sh2lib_handle *hd)
     nghttp2_session_callbacks_set_on_stream_close_callback(callbacks, callback_on_stream_close);
     nghttp2_session_callbacks_set_on_data_chunk_recv_callback(callbacks, callback_on_data_chunk_recv);
     nghttp2_session_callbacks_set_on_header_callback(callbacks, callback_on_header);
-    ret = nghttp2_session_client_new(&hd->http2_sess, callbacks, hd);
+    nghttp2_option *option = nghttp2_port_option_new();
+    hd->http2_mem = nghttp2_port_mem_new();
+    ret = nghttp2_session_client_new3(&hd->http2_sess, callbacks, hd, option, hd->http2_mem);
+    nghttp2_option_del(option);
     if (ret != 0) {
         ESP_LOGE(TAG, "[sh2-connect] New http2 session failed");
         nghttp2_session_callbacks_del(callbacks);
@@ -220,11 +290,45 @@ static int do_http2_connect(struct sh2lib_handle *hd)
     nghttp2_session_callbacks_del(callbacks);
 
     /* Create the SETTINGS frame */
-    ret = nghttp2_submit_settings(hd->http2_sess, NGHTTP2_FLAG_NONE, NULL, 0);
+    nghttp2_settings_entry settings[4];
+    size_t num_settings = 0;
+    if (NGHTTP2_PORT_HEADER_TABLE_SIZE != NGHTTP2_DEFAULT_HEADER_TABLE_SIZE) {
+        settings[num_settings++] = (nghttp2_settings_entry) {
+            NGHTTP2_SETTINGS_HEADER_TABLE_SIZE, NGHTTP2_PORT_HEADER_TABLE_SIZE
+        };
+    }
+    if (cfg->initial_window_size) {
+        settings[num_settings++] = (nghttp2_settings_entry) {
+            NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE, cfg->initial_window_size
+        };
+    }
+    if (cfg->max_frame_size) {
+        settings[num_settings++] = (nghttp2_settings_entry) {
+            NGHTTP2_SETTINGS_MAX_FRAME_SIZE, cfg->max_frame_size
+        };
+    }
+    if (cfg->max_concurrent_streams) {
+        settings[num_settings++] = (nghttp2_settings_entry) {
+            NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, cfg->max_concurrent_streams
+        };
+    }
+    ret = nghttp2_submit_settings(hd->http2_sess, NGHTTP2_FLAG_NONE, settings, num_settings);
     if (ret != 0) {
         ESP_LOGE(TAG, "[sh2-connect] Submit settings failed");
         return -1;
     }
+
+    /* The connection window is not part of SETTINGS, it is grown by a WINDOW_UPDATE.
+     * nghttp2 then sends WINDOW_UPDATEs on its own as received data is handed to recv_cb.
+     */
+    if (cfg->connection_window_size) {
+        ret = nghttp2_session_set_local_window_size(hd->http2_sess, NGHTTP2_FLAG_NONE, 0,
+                                                    (int32_t)MIN(cfg->connection_window_size, NGHTTP2_MAX_WINDOW_SIZE));
+        if (ret != 0) {
+            ESP_LOGE(TAG, "[sh2-connect] Setting the connection window failed");
+            return -1;
+        }
+    }
     return 0;
 }
 
@@ -268,8 +372,16 @@ int sh2lib_connect(struct sh2lib_config_t *cfg, struct sh2lib_handle *hd)
     http_parser_parse_url(cfg->uri, strlen(cfg->uri), 0, &u);
     hd->hostname = strndup(&cfg->uri[u.field_data[UF_HOST].off], u.field_data[UF_HOST].len);
 
+#if SH2LIB_OUT_BUF_SIZE > 0
+    hd->out_buf = malloc(SH2LIB_OUT_BUF_SIZE);
+    if (!hd->out_buf) {
+        ESP_LOGE(TAG, "[sh2-connect] Failed to allocate output buffer");
+        goto error;
+    }
+#endif
+
     /* HTTP/2 Connection */
-    if (do_http2_connect(hd) != 0) {
+    if (do_http2_connect(hd, cfg) != 0) {
         ESP_LOGE(TAG, "[sh2-connect] HTTP2 Connection failed with %s", cfg->uri);
         goto error;
     }
@@ -286,6 +398,8 @@ void sh2lib_free(struct sh2lib_handle *hd)
         nghttp2_session_del(hd->http2_sess);
         hd->http2_sess = NULL;
     }
+    nghttp2_port_mem_del(hd->http2_mem);
+    hd->http2_mem = NULL;
     if (hd->http2_tls) {
         esp_tls_conn_destroy(hd->http2_tls);
         hd->http2_tls = NULL;
@@ -294,6 +408,10 @@ void sh2lib_free(struct sh2lib_handle *hd)
         free(hd->hostname);
         hd->hostname = NULL;
     }
+    free(hd->out_buf);
+    hd->out_buf = NULL;
+    hd->out_len = 0;
+    hd->out_retry = 0;
 }
 
 int sh2lib_execute(struct sh2lib_handle *hd)
@@ -305,6 +423,14 @@ int sh2lib_execute(struct sh2lib_handle *hd)
         return -1;
     }
 
+    if (hd->out_buf) {
+        ret = flush_out_buf(hd);
+        if (ret != 0 && ret != NGHTTP2_ERR_WOULDBLOCK) {
+            ESP_LOGE(TAG, "[sh2-execute] HTTP2 session flush failed %d", ret);
+            return -1;
+        }
+    }
+
     ret = nghttp2_session_recv(hd->http2_sess);
     if (ret != 0) {
         ESP_LOGE(TAG, "[sh2-execute] HTTP2 session recv failed %d", ret);
@@ -314,6 +440,116 @@ int sh2lib_execute(struct sh2lib_handle *hd)
     return 0;
 }
 
+/*
+ * Waits until the socket is ready for what the session wants to do. Returns 1
+ * when ready, 0 on timeout and -1 on error.
+ */
+static int sh2lib_wait_io(struct sh2lib_handle *hd, int timeout_ms)
+{
+    /* Records already decrypted by TLS do not show up on the socket */
+    if (esp_tls_get_bytes_avail(hd->http2_tls) > 0) {
+        return 1;
+    }
+
+    int fd;
+    if (esp_tls_get_conn_sockfd(hd->http2_tls, &fd) != ESP_OK) {
+        ESP_LOGE(TAG, "[sh2-wait] Failed to get socket");
+        return -1;
+    }
+
+    bool want_read = nghttp2_session_want_read(hd->http2_sess);
+    bool want_write = nghttp2_session_want_write(hd->http2_sess) || hd->out_len > 0;
+    if (!want_read && !want_write) {
+        return 1;
+    }
+
+    fd_set readset, writeset;
+    FD_ZERO(&readset);
+    FD_ZERO(&writeset);
+    if (want_read) {
+        FD_SET(fd, &readset);
+    }
+    if (want_write) {
+        FD_SET(fd, &writeset);
+    }
+    struct timeval tv = {
+        .tv_sec = timeout_ms / 1000,
+        .tv_usec = (timeout_ms % 1000) * 1000,
+    };
+    int ret = select(fd + 1, &readset, &writeset, NULL, timeout_ms < 0 ? NULL : &tv);
+    if (ret < 0) {
+        ESP_LOGE(TAG, "[sh2-wait] select failed, errno %d", errno);
+        return -1;
+    }
+    return ret > 0 ? 1 : 0;
+}
+
+int sh2lib_execute_wait(struct sh2lib_handle *hd, int timeout_ms)
+{
+    int ret = sh2lib_wait_io(hd, timeout_ms);
+    if (ret < 0) {
+        return -1;
+    }
+    if (ret == 0) {
+        return 0;
+    }
+    return sh2lib_execute(hd);
+}
+
+static void sh2lib_execute_task(void *arg)
+{
+    struct sh2lib_handle *hd = arg;
+    struct sh2lib_task_config_t *task_cfg = hd->task;
+    int result = 0;
+
+    while (hd->active_streams > 0 || nghttp2_session_want_write(hd->http2_sess) || hd->out_len > 0) {
+        int ret = sh2lib_wait_io(hd, task_cfg->timeout_ms);
+        if (ret == 0) {
+            ESP_LOGE(TAG, "[sh2-task] No socket activity for %d ms", task_cfg->timeout_ms);
+        }
+        if (ret <= 0 || sh2lib_execute(hd) != 0) {
+            result = -1;
+            break;
+        }
+    }
+
+    sh2lib_task_done_cb_t done_cb = task_cfg->done_cb;
+    void *cb_arg = task_cfg->arg;
+    hd->task = NULL;
+    free(task_cfg);
+    if (done_cb) {
+        done_cb(hd, result, cb_arg);
+    }
+    vTaskDelete(NULL);
+}
+
+int sh2lib_execute_task_start(struct sh2lib_handle *hd, const struct sh2lib_task_config_t *cfg)
+{
+    const struct sh2lib_task_config_t default_cfg = SH2LIB_TASK_DEFAULT_CONFIG();
+    if (hd->task) {
+        ESP_LOGE(TAG, "[sh2-task] Task already running");
+        return -1;
+    }
+
+    struct sh2lib_task_config_t *task_cfg = malloc(sizeof(*task_cfg));
+    if (!task_cfg) {
+        ESP_LOGE(TAG, "[sh2-task] Failed to allocate task configuration");
+        return -1;
+    }
+    *task_cfg = cfg ? *cfg : default_cfg;
+    hd->task = task_cfg;
+
+    BaseType_t core_id = task_cfg->core_id < 0 ? tskNO_AFFINITY : task_cfg->core_id;
+    if (xTaskCreatePinnedToCore(sh2lib_execute_task, "sh2lib", task_cfg->stack_size, hd,
+                                task_cfg->priority, NULL, core_id) != pdPASS) {
+        ESP_LOGE(TAG, "[sh2-task] Failed to create task");
+        hd->task = NULL;
+        free(task_cfg);
+        return -1;
+    }
+    return 0;
+}
+
 int sh2lib_do_get_with_nv(struct sh2lib_handle *hd, const nghttp2_nv *nva, size_t nvlen, sh2lib_frame_data_recv_cb_t recv_cb)
 {
     int ret = nghttp2_submit_request(hd->http2_sess, NULL, nva, nvlen, NULL, recv_cb);
@@ -321,6 +557,7 @@ int sh2lib_do_get_with_nv(struct sh2lib_handle *hd, const nghttp2_nv *nva, size_
         ESP_LOGE(TAG, "[sh2-do-get] HEADERS call failed");
         return -1;
     }
+    hd->active_streams++;
     return ret;
 }
 
@@ -356,6 +593,7 @@ int sh2lib_do_putpost_with_nv(struct sh2lib_handle *hd, const nghttp2_nv *nva, s
         ESP_LOGE(TAG, "[sh2-do-putpost] HEADERS call failed");
         return -1;
     }
+    hd->active_streams++;
     return ret;
 }
 
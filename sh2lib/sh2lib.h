@@ -30,8 +30,14 @@ extern "C" {
  */
 struct sh2lib_handle {
     nghttp2_session *http2_sess;   /*!< Pointer to the HTTP2 session handle */
+    nghttp2_mem     *http2_mem;    /*!< Allocator of the HTTP2 session, NULL for the default one */
     char            *hostname;     /*!< The hostname we are connected to */
     struct esp_tls  *http2_tls;    /*!< Pointer to the TLS session handle */
+    uint8_t         *out_buf;      /*!< Buffer coalescing frames into TLS writes, NULL if disabled */
+    size_t           out_len;      /*!< Number of bytes pending in out_buf */
+    size_t           out_retry;    /*!< Length of a blocked TLS write which must be retried unchanged */
+    int              active_streams; /*!< Number of streams opened by this handle and not closed yet */
+    void            *task;         /*!< Configuration of the running execute task, NULL when not running */
 };
 
 /**
@@ -44,6 +50,10 @@ struct sh2lib_config_t {
     esp_err_t (*crt_bundle_attach)(void *conf);
     /*!< Function pointer to esp_crt_bundle_attach. Enables the use of certification
          bundle for server verification, must be enabled in menuconfig */
+    uint32_t initial_window_size;       /*!< Receive window of each stream (SETTINGS_INITIAL_WINDOW_SIZE), 0 for the default of 65535 bytes */
+    uint32_t connection_window_size;    /*!< Receive window of the connection, 0 for the default of 65535 bytes */
+    uint32_t max_frame_size;            /*!< Largest frame the server may send (SETTINGS_MAX_FRAME_SIZE), 0 for the default of 16384 bytes */
+    uint32_t max_concurrent_streams;    /*!< Maximum number of streams the server may open (SETTINGS_MAX_CONCURRENT_STREAMS), 0 for no limit */
 };
 
 /** Flag indicating receive stream is reset */
@@ -88,6 +98,52 @@ typedef int (*sh2lib_frame_data_recv_cb_t)(struct sh2lib_handle *handle, const c
  */
 typedef int (*sh2lib_putpost_data_cb_t)(struct sh2lib_handle *handle, char *data, size_t len, uint32_t *data_flags);
 
+/**
+ * @brief Function Prototype for the stream close callback of the execute task
+ *
+ * @param[in] handle      Pointer to the sh2lib handle.
+ * @param[in] stream_id   Stream which was closed.
+ * @param[in] error_code  HTTP/2 error code the stream was closed with, NGHTTP2_NO_ERROR on success.
+ * @param[in] arg         User argument from the task configuration.
+ */
+typedef void (*sh2lib_stream_close_cb_t)(struct sh2lib_handle *handle, int32_t stream_id, uint32_t error_code, void *arg);
+
+/**
+ * @brief Function Prototype for the completion callback of the execute task
+ *
+ * Called from the execute task just before it exits. The handle may be freed
+ * or passed to sh2lib_execute_task_start() again from this callback.
+ *
+ * @param[in] handle   Pointer to the sh2lib handle.
+ * @param[in] result   0 if all streams completed, -1 on a connection error or timeout.
+ * @param[in] arg      User argument from the task configuration.
+ */
+typedef void (*sh2lib_task_done_cb_t)(struct sh2lib_handle *handle, int result, void *arg);
+
+/**
+ * @brief sh2lib execute task configuration structure
+ */
+struct sh2lib_task_config_t {
+    size_t stack_size;                          /*!< Stack size of the task, in bytes */
+    unsigned int priority;                      /*!< Priority of the task */
+    int core_id;                                /*!< Core to pin the task to, or -1 for no affinity */
+    int timeout_ms;                             /*!< Time without socket activity after which the task gives up, or -1 to wait forever */
+    sh2lib_stream_close_cb_t stream_close_cb;   /*!< Called from the task whenever a stream is closed, may be NULL */
+    sh2lib_task_done_cb_t done_cb;              /*!< Called from the task when it exits, may be NULL */
+    void *arg;                                  /*!< User argument passed to the callbacks */
+};
+
+/** Default configuration of the execute task */
+#define SH2LIB_TASK_DEFAULT_CONFIG() {  \
+    .stack_size = 4096,                 \
+    .priority = 5,                      \
+    .core_id = -1,                      \
+    .timeout_ms = 30000,                \
+    .stream_close_cb = NULL,            \
+    .done_cb = NULL,                    \
+    .arg = NULL,                        \
+}
+
 /**
  * @brief Connect to a URI using HTTP/2
  *
@@ -199,6 +255,42 @@ int sh2lib_do_put(struct sh2lib_handle *hd, const char *path,
  */
 int sh2lib_execute(struct sh2lib_handle *hd);
 
+/**
+ * @brief Wait for socket activity, then execute send/receive on an HTTP/2 connection
+ *
+ * Blocks in select() until the socket is readable, or writable when nghttp2
+ * has data to send, and then runs sh2lib_execute(). This replaces calling
+ * sh2lib_execute() in a loop with a delay.
+ *
+ * @param[in] hd          Pointer to a variable of the type 'struct sh2lib_handle'
+ * @param[in] timeout_ms  Maximum time to wait for the socket, or -1 to wait forever
+ *
+ * @return
+ *             - ESP_OK if the connection was processed or the wait timed out
+ *             - ESP_FAIL if the connection fails
+ */
+int sh2lib_execute_wait(struct sh2lib_handle *hd, int timeout_ms);
+
+/**
+ * @brief Drive an HTTP/2 connection from a background task
+ *
+ * Creates a task which waits for socket activity and executes the session,
+ * until all the streams opened on the handle are closed. The stream close and
+ * completion callbacks of the configuration are called from that task.
+ *
+ * While the task runs, it owns the session: further requests may only be set
+ * up from the sh2lib callbacks, which run in the task. The handle must not be
+ * freed before the completion callback was called.
+ *
+ * @param[in] hd      Pointer to a variable of the type 'struct sh2lib_handle'
+ * @param[in] cfg     Task configuration, SH2LIB_TASK_DEFAULT_CONFIG() if NULL
+ *
+ * @return
+ *             - ESP_OK if the task was started
+ *             - ESP_FAIL if the task is already running or could not be created
+ */
+int sh2lib_execute_task_start(struct sh2lib_handle *hd, const struct sh2lib_task_config_t *cfg);
+
 #define SH2LIB_MAKE_NV(NAME, VALUE)                                    \
   {                                                                    \
     (uint8_t *)NAME, (uint8_t *)VALUE, strlen(NAME), strlen(VALUE),    \
@@ -0,0 +1,409 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/param.h>
+#include <sys/queue.h>
+#include <sys/select.h>
+#include <esp_log.h>
+#include <http_parser.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_vfs_eventfd.h"
+
+#include "sh2lib_pool.h"
+
+static const char *TAG = "sh2lib-pool";
+
+typedef struct {
+    char *origin;       /* https://host[:port], key of the connection */
+    char *authority;    /* host[:port] */
+    char *path;
+    char *method;
+    sh2lib_putpost_data_cb_t send_cb;
+    sh2lib_frame_data_recv_cb_t recv_cb;
+} pool_req_t;
+
+typedef struct pool_conn {
+    struct sh2lib_handle hd;
+    char *origin;
+    bool idle;
+    TickType_t idle_since;
+    SLIST_ENTRY(pool_conn) next;
+} pool_conn_t;
+
+struct sh2lib_pool {
+    struct sh2lib_pool_config_t cfg;
+    QueueHandle_t queue;
+    int event_fd;
+    SLIST_HEAD(, pool_conn) conns;
+    int num_conns;
+    volatile bool stop;
+    SemaphoreHandle_t stopped;
+};
+
+static void pool_wakeup(struct sh2lib_pool *pool)
+{
+    uint64_t one = 1;
+    if (write(pool->event_fd, &one, sizeof(one)) != sizeof(one)) {
+        ESP_LOGW(TAG, "Failed to write eventfd");
+    }
+}
+
+static void req_fail(pool_req_t *req, struct sh2lib_handle *hd)
+{
+    if (req->recv_cb) {
+        req->recv_cb(hd, NULL, 0, DATA_RECV_RST_STREAM);
+    }
+}
+
+/* Closes a connection, telling the streams still open that they were reset */
+static void conn_close(struct sh2lib_pool *pool, pool_conn_t *conn)
+{
+    nghttp2_session *sess = conn->hd.http2_sess;
+    if (sess) {
+        int32_t next_id = nghttp2_session_get_next_stream_id(sess);
+        for (int32_t id = 1; id < next_id; id += 2) {
+            sh2lib_frame_data_recv_cb_t recv_cb = nghttp2_session_get_stream_user_data(sess, id);
+            if (recv_cb) {
+                recv_cb(&conn->hd, NULL, 0, DATA_RECV_RST_STREAM);
+            }
+        }
+    }
+    SLIST_REMOVE(&pool->conns, conn, pool_conn, next);
+    pool->num_conns--;
+    ESP_LOGD(TAG, "Closing connection to %s", conn->origin);
+    sh2lib_free(&conn->hd);
+    free(conn->origin);
+    free(conn);
+}
+
+static bool conn_is_idle(pool_conn_t *conn)
+{
+    return conn->hd.active_streams == 0 && conn->hd.out_len == 0 &&
+           !nghttp2_session_want_write(conn->hd.http2_sess);
+}
+
+static pool_conn_t *conn_get(struct sh2lib_pool *pool, const char *origin)
+{
+    pool_conn_t *conn;
+    SLIST_FOREACH(conn, &pool->conns, next) {
+        if (strcmp(conn->origin, origin) == 0) {
+            return conn;
+        }
+    }
+
+    if (pool->num_conns >= pool->cfg.max_connections) {
+        /* Make room by closing the connection idle for the longest time */
+        pool_conn_t *oldest = NULL;
+        SLIST_FOREACH(conn, &pool->conns, next) {
+            if (conn->idle && (!oldest || (int32_t)(conn->idle_since - oldest->idle_since) < 0)) {
+                oldest = conn;
+            }
+        }
+        if (!oldest) {
+            ESP_LOGE(TAG, "All %d connections are busy, cannot connect to %s", pool->num_conns, origin);
+            return NULL;
+        }
+        conn_close(pool, oldest);
+    }
+
+    conn = calloc(1, sizeof(*conn));
+    if (!conn) {
+        return NULL;
+    }
+    conn->origin = strdup(origin);
+    if (!conn->origin) {
+        free(conn);
+        return NULL;
+    }
+
+    struct sh2lib_config_t cfg = {
+        .uri = origin,
+        .cacert_buf = pool->cfg.cacert_buf,
+        .cacert_bytes = pool->cfg.cacert_bytes,
+        .crt_bundle_attach = pool->cfg.crt_bundle_attach,
+        .initial_window_size = pool->cfg.initial_window_size,
+        .connection_window_size = pool->cfg.connection_window_size,
+        .max_frame_size = pool->cfg.max_frame_size,
+        .max_concurrent_streams = pool->cfg.max_concurrent_streams,
+    };
+    ESP_LOGD(TAG, "Connecting to %s", origin);
+    if (sh2lib_connect(&cfg, &conn->hd) != 0) {
+        ESP_LOGE(TAG, "Failed to connect to %s", origin);
+        free(conn->origin);
+        free(conn);
+        return NULL;
+    }
+    SLIST_INSERT_HEAD(&pool->conns, conn, next);
+    pool->num_conns++;
+    return conn;
+}
+
+static void req_submit(struct sh2lib_pool *pool, pool_req_t *req)
+{
+    pool_conn_t *conn = conn_get(pool, req->origin);
+    if (!conn) {
+        req_fail(req, NULL);
+        return;
+    }
+
+    const nghttp2_nv nva[] = { SH2LIB_MAKE_NV(":method", req->method),
+                               SH2LIB_MAKE_NV(":scheme", "https"),
+                               SH2LIB_MAKE_NV(":authority", req->authority),
+                               SH2LIB_MAKE_NV(":path", req->path),
+                             };
+    int ret;
+    if (req->send_cb) {
+        ret = sh2lib_do_putpost_with_nv(&conn->hd, nva, sizeof(nva) / sizeof(nva[0]), req->send_cb, req->recv_cb);
+    } else {
+        ret = sh2lib_do_get_with_nv(&conn->hd, nva, sizeof(nva) / sizeof(nva[0]), req->recv_cb);
+    }
+    if (ret < 0) {
+        req_fail(req, &conn->hd);
+        return;
+    }
+    conn->idle = false;
+}
+
+static void pool_task(void *arg)
+{
+    struct sh2lib_pool *pool = arg;
+    const TickType_t idle_ticks = pdMS_TO_TICKS(pool->cfg.idle_timeout_ms);
+
+    while (!pool->stop) {
+        fd_set readset, writeset;
+        FD_ZERO(&readset);
+        FD_ZERO(&writeset);
+        FD_SET(pool->event_fd, &readset);
+        int maxfd = pool->event_fd;
+        bool pending = false;
+        TickType_t wait_ticks = portMAX_DELAY;
+        TickType_t now = xTaskGetTickCount();
+
+        pool_conn_t *conn;
+        SLIST_FOREACH(conn, &pool->conns, next) {
+            int fd;
+            if (esp_tls_get_conn_sockfd(conn->hd.http2_tls, &fd) != ESP_OK) {
+                continue;
+            }
+            /* Records already decrypted by TLS do not show up on the socket */
+            if (esp_tls_get_bytes_avail(conn->hd.http2_tls) > 0) {
+                pending = true;
+            }
+            if (nghttp2_session_want_read(conn->hd.http2_sess)) {
+                FD_SET(fd, &readset);
+            }
+            if (nghttp2_session_want_write(conn->hd.http2_sess) || conn->hd.out_len > 0) {
+                FD_SET(fd, &writeset);
+            }
+            maxfd = MAX(maxfd, fd);
+            if (conn->idle) {
+                TickType_t elapsed = now - conn->idle_since;
+                wait_ticks = MIN(wait_ticks, elapsed < idle_ticks ? idle_ticks - elapsed : 0);
+            }
+        }
+
+        struct timeval tv = { 0 };
+        if (!pending && wait_ticks != portMAX_DELAY) {
+            uint32_t wait_ms = pdTICKS_TO_MS(wait_ticks);
+            tv.tv_sec = wait_ms / 1000;
+            tv.tv_usec = (wait_ms % 1000) * 1000;
+        }
+        int ret = select(maxfd + 1, &readset, &writeset, NULL,
+                         (pending || wait_ticks != portMAX_DELAY) ? &tv : NULL);
+        if (ret < 0) {
+            ESP_LOGE(TAG, "select failed, errno %d", errno);
+            break;
+        }
+
+        if (FD_ISSET(pool->event_fd, &readset)) {
+            uint64_t count;
+            if (read(pool->event_fd, &count, sizeof(count)) != sizeof(count)) {
+                ESP_LOGW(TAG, "Failed to read eventfd");
+            }
+        }
+        pool_req_t *req;
+        while (!pool->stop && xQueueReceive(pool->queue, &req, 0) == pdTRUE) {
+            req_submit(pool, req);
+            free(req);
+        }
+
+        now = xTaskGetTickCount();
+        pool_conn_t *tmp;
+        SLIST_FOREACH_SAFE(conn, &pool->conns, next, tmp) {
+            if (sh2lib_execute(&conn->hd) != 0) {
+                conn_close(pool, conn);
+                continue;
+            }
+            if (!conn_is_idle(conn)) {
+                conn->idle = false;
+            } else if (!conn->idle) {
+                conn->idle = true;
+                conn->idle_since = now;
+            } else if (now - conn->idle_since >= idle_ticks) {
+                conn_close(pool, conn);
+            }
+        }
+    }
+
+    pool_conn_t *conn;
+    while ((conn = SLIST_FIRST(&pool->conns)) != NULL) {
+        conn_close(pool, conn);
+    }
+    pool_req_t *req;
+    while (xQueueReceive(pool->queue, &req, 0) == pdTRUE) {
+        req_fail(req, NULL);
+        free(req);
+    }
+    xSemaphoreGive(pool->stopped);
+    vTaskDelete(NULL);
+}
+
+int sh2lib_pool_create(const struct sh2lib_pool_config_t *cfg, sh2lib_pool_handle_t *pool_out)
+{
+    if (cfg == NULL || pool_out == NULL || cfg->max_connections <= 0 || cfg->queue_size <= 0) {
+        ESP_LOGE(TAG, "Invalid pool configuration");
+        return -1;
+    }
+
+    esp_vfs_eventfd_config_t eventfd_config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+    esp_err_t err = esp_vfs_eventfd_register(&eventfd_config);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "Failed to register eventfd");
+        return -1;
+    }
+
+    struct sh2lib_pool *pool = calloc(1, sizeof(*pool));
+    if (!pool) {
+        return -1;
+    }
+    pool->cfg = *cfg;
+    pool->event_fd = -1;
+    SLIST_INIT(&pool->conns);
+
+    pool->queue = xQueueCreate(cfg->queue_size, sizeof(pool_req_t *));
+    pool->stopped = xSemaphoreCreateBinary();
+    if (!pool->queue || !pool->stopped) {
+        goto error;
+    }
+    pool->event_fd = eventfd(0, 0);
+    if (pool->event_fd < 0) {
+        ESP_LOGE(TAG, "Failed to create eventfd");
+        goto error;
+    }
+
+    BaseType_t core_id = cfg->task_core_id < 0 ? tskNO_AFFINITY : cfg->task_core_id;
+    if (xTaskCreatePinnedToCore(pool_task, "sh2lib_pool", cfg->task_stack_size, pool,
+                                cfg->task_priority, NULL, core_id) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create pool task");
+        goto error;
+    }
+    *pool_out = pool;
+    return 0;
+
+error:
+    if (pool->event_fd >= 0) {
+        close(pool->event_fd);
+    }
+    if (pool->stopped) {
+        vSemaphoreDelete(pool->stopped);
+    }
+    if (pool->queue) {
+        vQueueDelete(pool->queue);
+    }
+    free(pool);
+    return -1;
+}
+
+void sh2lib_pool_delete(sh2lib_pool_handle_t pool)
+{
+    if (!pool) {
+        return;
+    }
+    pool->stop = true;
+    pool_wakeup(pool);
+    xSemaphoreTake(pool->stopped, portMAX_DELAY);
+
+    close(pool->event_fd);
+    vSemaphoreDelete(pool->stopped);
+    vQueueDelete(pool->queue);
+    free(pool);
+}
+
+int sh2lib_pool_request(sh2lib_pool_handle_t pool, const struct sh2lib_pool_request_t *req, int timeout_ms)
+{
+    if (!pool || !req || !req->uri) {
+        return -1;
+    }
+
+    const char *uri = req->uri;
+    struct http_parser_url u;
+    http_parser_url_init(&u);
+    if (http_parser_parse_url(uri, strlen(uri), 0, &u) != 0 ||
+            !(u.field_set & (1 << UF_HOST)) || !(u.field_set & (1 << UF_SCHEMA)) ||
+            u.field_data[UF_SCHEMA].len != strlen("https") ||
+            strncasecmp(&uri[u.field_data[UF_SCHEMA].off], "https", strlen("https")) != 0) {
+        ESP_LOGE(TAG, "Invalid URI %s, only 'https' URIs are supported", uri);
+        return -1;
+    }
+
+    /* The authority runs from the host to the end of the port, if any */
+    size_t authority_off = u.field_data[UF_HOST].off;
+    size_t authority_end = authority_off + u.field_data[UF_HOST].len;
+    if (u.field_set & (1 << UF_PORT)) {
+        authority_end = u.field_data[UF_PORT].off + u.field_data[UF_PORT].len;
+    }
+    size_t authority_len = authority_end - authority_off;
+    /* The path runs from the path to the end of the query, if any */
+    size_t path_off = 0, path_len = 0;
+    if (u.field_set & (1 << UF_PATH)) {
+        path_off = u.field_data[UF_PATH].off;
+        path_len = u.field_data[UF_PATH].len;
+        if (u.field_set & (1 << UF_QUERY)) {
+            path_len = u.field_data[UF_QUERY].off + u.field_data[UF_QUERY].len - path_off;
+        }
+    }
+    const char *method = req->method ? req->method : "GET";
+
+    /* Request and strings in a single allocation */
+    size_t origin_len = strlen("https://") + authority_len;
+    size_t size = sizeof(pool_req_t) + origin_len + 1 + authority_len + 1 +
+                  (path_len ? path_len : 1) + 1 + strlen(method) + 1;
+    pool_req_t *item = malloc(size);
+    if (!item) {
+        return -1;
+    }
+    char *p = (char *)(item + 1);
+    item->origin = p;
+    p += sprintf(p, "https://%.*s", (int)authority_len, &uri[authority_off]) + 1;
+    item->authority = p;
+    p += sprintf(p, "%.*s", (int)authority_len, &uri[authority_off]) + 1;
+    item->path = p;
+    p += sprintf(p, "%.*s", (int)(path_len ? path_len : 1), path_len ? &uri[path_off] : "/") + 1;
+    item->method = p;
+    strcpy(p, method);
+    item->send_cb = req->send_cb;
+    item->recv_cb = req->recv_cb;
+
+    TickType_t ticks = timeout_ms < 0 ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    if (xQueueSend(pool->queue, &item, ticks) != pdTRUE) {
+        ESP_LOGE(TAG, "Request queue full");
+        free(item);
+        return -1;
+    }
+    pool_wakeup(pool);
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "sh2lib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A pool of HTTP/2 connections shared by several tasks.
+ *
+ * Requests can be submitted from any task. They are queued to a single pool
+ * task, which owns all the sessions: it opens one connection per origin
+ * (scheme, host and port), multiplexes the streams of all the requests to that
+ * origin over it, and closes connections which stayed without streams for the
+ * idle timeout. All the request callbacks are called from the pool task.
+ *
+ * Connections are opened by the pool task, so a TLS handshake delays the
+ * other connections of the pool while it runs.
+ */
+
+/**
+ * @brief Handle of a connection pool
+ */
+typedef struct sh2lib_pool *sh2lib_pool_handle_t;
+
+/**
+ * @brief Connection pool configuration structure
+ */
+struct sh2lib_pool_config_t {
+    const unsigned char *cacert_buf;    /*!< Pointer to the buffer containing CA certificate */
+    unsigned int cacert_bytes;          /*!< Size of the CA certificate pointed by cacert_buf */
+    esp_err_t (*crt_bundle_attach)(void *conf);
+    /*!< Function pointer to esp_crt_bundle_attach. Enables the use of certification
+         bundle for server verification, must be enabled in menuconfig */
+    uint32_t initial_window_size;       /*!< Receive window of each stream, see struct sh2lib_config_t */
+    uint32_t connection_window_size;    /*!< Receive window of each connection, see struct sh2lib_config_t */
+    uint32_t max_frame_size;            /*!< Largest frame servers may send, see struct sh2lib_config_t */
+    uint32_t max_concurrent_streams;    /*!< Maximum number of streams servers may open, see struct sh2lib_config_t */
+    int max_connections;                /*!< Maximum number of open connections */
+    int idle_timeout_ms;                /*!< Time after which a connection without streams is closed */
+    int queue_size;                     /*!< Number of requests which can wait for the pool task */
+    size_t task_stack_size;             /*!< Stack size of the pool task, in bytes */
+    unsigned int task_priority;         /*!< Priority of the pool task */
+    int task_core_id;                   /*!< Core to pin the pool task to, or -1 for no affinity */
+};
+
+/** Default connection pool configuration, without server verification settings */
+#define SH2LIB_POOL_DEFAULT_CONFIG() {  \
+    .cacert_buf = NULL,                 \
+    .cacert_bytes = 0,                  \
+    .crt_bundle_attach = NULL,          \
+    .initial_window_size = 0,           \
+    .connection_window_size = 0,        \
+    .max_frame_size = 0,                \
+    .max_concurrent_streams = 0,        \
+    .max_connections = 2,               \
+    .idle_timeout_ms = 30000,           \
+    .queue_size = 8,                    \
+    .task_stack_size = 6144,            \
+    .task_priority = 5,                 \
+    .task_core_id = -1,                 \
+}
+
+/**
+ * @brief Request submitted to a connection pool
+ */
+struct sh2lib_pool_request_t {
+    const char *uri;                        /*!< 'https' URI of the resource, the origin selects the connection */
+    const char *method;                     /*!< HTTP method, "GET" if NULL */
+    sh2lib_putpost_data_cb_t send_cb;       /*!< Callback providing the request body, NULL for no body */
+    sh2lib_frame_data_recv_cb_t recv_cb;    /*!< Callback processing the response, may be NULL */
+};
+
+/**
+ * @brief Create a connection pool and its task
+ *
+ * @param[in]  cfg     Pointer to the pool configuration.
+ * @param[out] pool    Handle of the created pool.
+ *
+ * @return
+ *             - ESP_OK if the pool was created
+ *             - ESP_FAIL if the configuration is invalid or out of memory
+ */
+int sh2lib_pool_create(const struct sh2lib_pool_config_t *cfg, sh2lib_pool_handle_t *pool);
+
+/**
+ * @brief Delete a connection pool
+ *
+ * Stops the pool task and closes all the connections. The response callback
+ * of every request which did not complete is called with DATA_RECV_RST_STREAM.
+ * Must not be called from a request callback.
+ *
+ * @param[in] pool     Handle of the pool.
+ */
+void sh2lib_pool_delete(sh2lib_pool_handle_t pool);
+
+/**
+ * @brief Submit a request to a connection pool
+ *
+ * The request is copied and queued to the pool task, which opens a connection
+ * to the origin of the URI if there is none yet. The callbacks of the request
+ * are called from the pool task, as for sh2lib_do_putpost_with_nv(). If the
+ * connection cannot be opened or fails, the response callback is called with
+ * DATA_RECV_RST_STREAM, and with a NULL handle if no connection was opened.
+ *
+ * This function can be called from any task.
+ *
+ * @param[in] pool        Handle of the pool.
+ * @param[in] req         Request to submit.
+ * @param[in] timeout_ms  Time to wait for space in the request queue.
+ *
+ * @return
+ *             - ESP_OK if the request was queued
+ *             - ESP_FAIL if the URI is invalid, or the queue stayed full
+ */
+int sh2lib_pool_request(sh2lib_pool_handle_t pool, const struct sh2lib_pool_request_t *req, int timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
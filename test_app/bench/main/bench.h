@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Benchmark of a single operation
+ *
+ * setup and teardown are not timed, run is called once as warm-up and then iterations times in a row.
+ */
+typedef struct {
+    const char *name;               // Name of the benchmark in the results, without spaces
+    uint32_t iterations;            // Number of timed calls of run
+    bool (*setup)(void **ctx);      // Prepare the input of run, can be NULL
+    bool (*run)(void *ctx);         // Operation under benchmark, returns false if it failed
+    void (*teardown)(void *ctx);    // Free what setup allocated, can be NULL
+} bench_case_t;
+
+/* Benchmarks of each group of components, defined in bench_<group>.c */
+extern const bench_case_t bench_codecs_cases[];
+extern const size_t bench_codecs_num_cases;
+extern const bench_case_t bench_json_cases[];
+extern const size_t bench_json_num_cases;
+extern const bench_case_t bench_crypto_cases[];
+extern const size_t bench_crypto_num_cases;
+extern const bench_case_t bench_iqmath_cases[];
+extern const size_t bench_iqmath_num_cases;
+
+#define BENCH_NUM_CASES(cases) (sizeof(cases) / sizeof(cases[0]))
+
+#ifdef __cplusplus
+}
+#endif
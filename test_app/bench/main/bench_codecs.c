@@ -0,0 +1,240 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jpeg_decoder.h"
+#include "qrcode.h"
+#include "qrcodegen.h"
+#include "quirc.h"
+#include "zlib.h"
+#include "bench.h"
+
+extern const uint8_t logo_jpg_start[] asm("_binary_logo_jpg_start");
+extern const uint8_t logo_jpg_end[]   asm("_binary_logo_jpg_end");
+extern const uint8_t test_qrcode_pgm_start[] asm("_binary_test_qrcode_pgm_start");
+extern const uint8_t test_qrcode_pgm_end[]   asm("_binary_test_qrcode_pgm_end");
+
+/* esp_jpeg: decode the 46x46 logo of the esp_jpeg tests to RGB888 */
+
+#define LOGO_SIZE 46
+
+static bool jpeg_decode_setup(void **ctx)
+{
+    *ctx = malloc(LOGO_SIZE * LOGO_SIZE * 3);
+    return *ctx != NULL;
+}
+
+static bool jpeg_decode_run(void *ctx)
+{
+    esp_jpeg_image_cfg_t jpeg_cfg = {
+        .indata = (uint8_t *)logo_jpg_start,
+        .indata_size = logo_jpg_end - logo_jpg_start,
+        .outbuf = ctx,
+        .outbuf_size = LOGO_SIZE * LOGO_SIZE * 3,
+        .out_format = JPEG_IMAGE_FORMAT_RGB888,
+        .out_scale = JPEG_IMAGE_SCALE_0,
+    };
+    esp_jpeg_image_output_t outimg;
+    return esp_jpeg_decode(&jpeg_cfg, &outimg) == ESP_OK;
+}
+
+/* qrcode: encode a URL, the version is chosen by qrcodegen */
+
+#define QRCODE_MAX_VERSION 10
+
+typedef struct {
+    uint8_t temp[qrcodegen_BUFFER_LEN_FOR_VERSION(QRCODE_MAX_VERSION)];
+    uint8_t qrcode[qrcodegen_BUFFER_LEN_FOR_VERSION(QRCODE_MAX_VERSION)];
+} qrcode_encode_ctx_t;
+
+static bool qrcode_encode_setup(void **ctx)
+{
+    *ctx = malloc(sizeof(qrcode_encode_ctx_t));
+    return *ctx != NULL;
+}
+
+static bool qrcode_encode_run(void *ctx)
+{
+    qrcode_encode_ctx_t *qr = ctx;
+    return qrcodegen_encodeText("https://github.com/espressif/idf-extra-components", qr->temp, qr->qrcode,
+                                qrcodegen_Ecc_MEDIUM, qrcodegen_VERSION_MIN, QRCODE_MAX_VERSION,
+                                qrcodegen_Mask_AUTO, true);
+}
+
+/* qrcode: draw the URL's QR code into a 240x240 RGB565 framebuffer */
+
+#define QRCODE_FB_SIZE 240
+
+typedef struct {
+    esp_qrcode_encoder_handle_t encoder;
+    esp_qrcode_handle_t qrcode;
+    uint16_t fb[QRCODE_FB_SIZE * QRCODE_FB_SIZE];
+} qrcode_render_ctx_t;
+
+static bool qrcode_render_setup(void **ctx)
+{
+    esp_qrcode_config_t cfg = ESP_QRCODE_CONFIG_DEFAULT();
+    cfg.max_qrcode_version = QRCODE_MAX_VERSION;
+    cfg.qrcode_ecc_level = ESP_QRCODE_ECC_MED;
+    qrcode_render_ctx_t *qr = calloc(1, sizeof(qrcode_render_ctx_t));
+    *ctx = qr;
+    return qr != NULL &&
+           esp_qrcode_encoder_create(&cfg, &qr->encoder) == ESP_OK &&
+           esp_qrcode_encode(qr->encoder, "https://github.com/espressif/idf-extra-components", &qr->qrcode) == ESP_OK;
+}
+
+static bool qrcode_render_run(void *ctx)
+{
+    qrcode_render_ctx_t *qr = ctx;
+    int modules = esp_qrcode_get_size(qr->qrcode) + 4;
+    esp_qrcode_render_config_t cfg = {
+        .buffer = qr->fb,
+        .format = ESP_QRCODE_PIXEL_FORMAT_RGB565,
+        .width = QRCODE_FB_SIZE,
+        .height = QRCODE_FB_SIZE,
+        .scale = QRCODE_FB_SIZE / modules,
+        .border = 2,
+        .dark_color = 0x0000,
+        .light_color = 0xffff,
+    };
+    return esp_qrcode_render(qr->qrcode, &cfg) == ESP_OK;
+}
+
+static void qrcode_render_teardown(void *ctx)
+{
+    qrcode_render_ctx_t *qr = ctx;
+    if (qr) {
+        esp_qrcode_encoder_delete(qr->encoder);
+        free(qr);
+    }
+}
+
+/* quirc: find and decode the QR code in the image of the quirc tests */
+
+typedef struct {
+    struct quirc *q;
+    const uint8_t *image;
+    int width;
+    int height;
+} quirc_decode_ctx_t;
+
+static void quirc_decode_teardown(void *ctx)
+{
+    quirc_decode_ctx_t *dec = ctx;
+    if (dec && dec->q) {
+        quirc_destroy(dec->q);
+    }
+    free(dec);
+}
+
+static bool quirc_decode_setup(void **ctx)
+{
+    quirc_decode_ctx_t *dec = calloc(1, sizeof(quirc_decode_ctx_t));
+    if (!dec) {
+        return false;
+    }
+    *ctx = dec;
+
+    // The PGM header is followed by the 8-bit pixels
+    if (sscanf((const char *)test_qrcode_pgm_start, "P5 %d %d 255", &dec->width, &dec->height) != 2) {
+        return false;
+    }
+    dec->image = memchr(test_qrcode_pgm_start, '\n', test_qrcode_pgm_end - test_qrcode_pgm_start);
+    if (!dec->image) {
+        return false;
+    }
+    dec->image++;
+
+    dec->q = quirc_new();
+    return dec->q && quirc_resize(dec->q, dec->width, dec->height) == 0;
+}
+
+static bool quirc_decode_run(void *ctx)
+{
+    quirc_decode_ctx_t *dec = ctx;
+    struct quirc_code code;
+    struct quirc_data data;
+
+    // quirc_end() thresholds the image in place, copy it every time
+    memcpy(quirc_begin(dec->q, NULL, NULL), dec->image, dec->width * dec->height);
+    quirc_end(dec->q);
+    if (quirc_count(dec->q) != 1) {
+        return false;
+    }
+    quirc_extract(dec->q, 0, &code);
+    return quirc_decode(&code, &data) == QUIRC_SUCCESS;
+}
+
+/* zlib: inflate, deflate and CRC32 of 4 kB of text */
+
+#define ZLIB_DATA_SIZE 4096
+
+typedef struct {
+    uint8_t data[ZLIB_DATA_SIZE];
+    uint8_t compressed[ZLIB_DATA_SIZE + 64];
+    uLongf compressed_size;
+} zlib_inflate_ctx_t;
+
+static bool zlib_inflate_setup(void **ctx)
+{
+    zlib_inflate_ctx_t *z = malloc(sizeof(zlib_inflate_ctx_t));
+    if (!z) {
+        return false;
+    }
+    *ctx = z;
+
+    // Repeated words with varying numbers, compressible like a log or a JSON document
+    size_t len = 0;
+    for (int i = 0; len < ZLIB_DATA_SIZE; i++) {
+        len += snprintf((char *)z->data + len, ZLIB_DATA_SIZE - len, "{\"sensor\":%d,\"value\":%d},", i % 7, (i * 7919) % 1000);
+    }
+    z->compressed_size = sizeof(z->compressed);
+    return compress(z->compressed, &z->compressed_size, z->data, ZLIB_DATA_SIZE) == Z_OK;
+}
+
+static bool zlib_inflate_run(void *ctx)
+{
+    zlib_inflate_ctx_t *z = ctx;
+    uLongf size = ZLIB_DATA_SIZE;
+    return uncompress(z->data, &size, z->compressed, z->compressed_size) == Z_OK && size == ZLIB_DATA_SIZE;
+}
+
+static bool zlib_crc32_run(void *ctx)
+{
+    zlib_inflate_ctx_t *z = ctx;
+    return crc32(crc32(0, Z_NULL, 0), z->data, ZLIB_DATA_SIZE) != 0;
+}
+
+static bool zlib_deflate_run(void *ctx)
+{
+    zlib_inflate_ctx_t *z = ctx;
+    z_stream strm = { 0 };
+    // Small window and hash table, as used on devices without PSRAM
+    if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 10, 4, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    strm.next_in = z->data;
+    strm.avail_in = ZLIB_DATA_SIZE;
+    strm.next_out = z->compressed;
+    strm.avail_out = sizeof(z->compressed);
+    int ret = deflate(&strm, Z_FINISH);
+    z->compressed_size = strm.total_out;
+    deflateEnd(&strm);
+    return ret == Z_STREAM_END;
+}
+
+const bench_case_t bench_codecs_cases[] = {
+    { "esp_jpeg_decode_46x46_rgb888", 20, jpeg_decode_setup, jpeg_decode_run, free },
+    { "qrcodegen_encodeText", 20, qrcode_encode_setup, qrcode_encode_run, free },
+    { "esp_qrcode_render_240x240_rgb565", 50, qrcode_render_setup, qrcode_render_run, qrcode_render_teardown },
+    { "quirc_decode_128x113", 5, quirc_decode_setup, quirc_decode_run, quirc_decode_teardown },
+    { "zlib_uncompress_4k", 50, zlib_inflate_setup, zlib_inflate_run, free },
+    { "zlib_crc32_4k", 50, zlib_inflate_setup, zlib_crc32_run, free },
+    { "zlib_deflate_4k", 20, zlib_inflate_setup, zlib_deflate_run, free },
+};
+const size_t bench_codecs_num_cases = BENCH_NUM_CASES(bench_codecs_cases);
@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include "sodium.h"
+#include "bench.h"
+
+/* libsodium: hashing, authenticated encryption and signing of a 1 kB message, X25519 key exchange */
+
+#define MESSAGE_SIZE 1024
+
+typedef struct {
+    unsigned char message[MESSAGE_SIZE];
+    unsigned char hash[crypto_hash_sha256_BYTES];
+    unsigned char key[crypto_secretbox_KEYBYTES];
+    unsigned char nonce[crypto_secretbox_NONCEBYTES];
+    unsigned char ciphertext[crypto_secretbox_MACBYTES + MESSAGE_SIZE];
+    unsigned char public_key[crypto_sign_PUBLICKEYBYTES];
+    unsigned char secret_key[crypto_sign_SECRETKEYBYTES];
+    unsigned char signature[crypto_sign_BYTES];
+    unsigned char scalar[crypto_scalarmult_SCALARBYTES];
+    unsigned char point[crypto_scalarmult_BYTES];
+    unsigned char shared[crypto_scalarmult_BYTES];
+} sodium_ctx_t;
+
+static bool sodium_setup(void **ctx)
+{
+    if (sodium_init() < 0) {
+        return false;
+    }
+
+    sodium_ctx_t *s = malloc(sizeof(sodium_ctx_t));
+    if (!s) {
+        return false;
+    }
+    *ctx = s;
+
+    randombytes_buf(s->message, sizeof(s->message));
+    crypto_secretbox_keygen(s->key);
+    randombytes_buf(s->nonce, sizeof(s->nonce));
+    randombytes_buf(s->scalar, sizeof(s->scalar));
+    if (crypto_scalarmult_base(s->point, s->scalar) != 0) {
+        return false;
+    }
+    return crypto_sign_keypair(s->public_key, s->secret_key) == 0;
+}
+
+static bool sha256_run(void *ctx)
+{
+    sodium_ctx_t *s = ctx;
+    return crypto_hash_sha256(s->hash, s->message, sizeof(s->message)) == 0;
+}
+
+static bool secretbox_run(void *ctx)
+{
+    sodium_ctx_t *s = ctx;
+    return crypto_secretbox_easy(s->ciphertext, s->message, sizeof(s->message), s->nonce, s->key) == 0;
+}
+
+static bool secretbox_open_setup(void **ctx)
+{
+    return sodium_setup(ctx) && secretbox_run(*ctx);
+}
+
+static bool secretbox_open_run(void *ctx)
+{
+    sodium_ctx_t *s = ctx;
+    return crypto_secretbox_open_easy(s->message, s->ciphertext, sizeof(s->ciphertext), s->nonce, s->key) == 0;
+}
+
+static bool sign_run(void *ctx)
+{
+    sodium_ctx_t *s = ctx;
+    return crypto_sign_detached(s->signature, NULL, s->message, sizeof(s->message), s->secret_key) == 0;
+}
+
+static bool verify_setup(void **ctx)
+{
+    return sodium_setup(ctx) && sign_run(*ctx);
+}
+
+static bool verify_run(void *ctx)
+{
+    sodium_ctx_t *s = ctx;
+    return crypto_sign_verify_detached(s->signature, s->message, sizeof(s->message), s->public_key) == 0;
+}
+
+static bool scalarmult_base_run(void *ctx)
+{
+    sodium_ctx_t *s = ctx;
+    return crypto_scalarmult_base(s->shared, s->scalar) == 0;
+}
+
+static bool scalarmult_run(void *ctx)
+{
+    sodium_ctx_t *s = ctx;
+    return crypto_scalarmult(s->shared, s->scalar, s->point) == 0;
+}
+
+const bench_case_t bench_crypto_cases[] = {
+    { "sodium_sha256_1k", 50, sodium_setup, sha256_run, free },
+    { "sodium_secretbox_easy_1k", 50, sodium_setup, secretbox_run, free },
+    { "sodium_secretbox_open_easy_1k", 50, secretbox_open_setup, secretbox_open_run, free },
+    { "sodium_sign_detached_1k", 5, sodium_setup, sign_run, free },
+    { "sodium_sign_verify_detached_1k", 5, verify_setup, verify_run, free },
+    { "sodium_scalarmult_base_x25519", 5, sodium_setup, scalarmult_base_run, free },
+    { "sodium_scalarmult_x25519", 5, sodium_setup, scalarmult_run, free },
+};
+const size_t bench_crypto_num_cases = BENCH_NUM_CASES(bench_crypto_cases);
@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "IQmathLib.h"
+#include "bench.h"
+
+/* iqmath: each run calls the function on 256 inputs over (0, 4) in Q24 */
+
+#define IQ_NUM_INPUTS 256
+#define IQ_INPUT(i) ((_iq24)(((i) + 1) << 16))
+
+// Keeps the results alive, so the calls aren't optimized out
+static volatile _iq24 s_sink;
+
+static bool iq24_mpy_run(void *ctx)
+{
+    _iq24 acc = 0;
+    for (int i = 0; i < IQ_NUM_INPUTS; i++) {
+        acc += _IQ24mpy(IQ_INPUT(i), _IQ24(0.75));
+    }
+    s_sink = acc;
+    return true;
+}
+
+static bool iq24_div_run(void *ctx)
+{
+    _iq24 acc = 0;
+    for (int i = 0; i < IQ_NUM_INPUTS; i++) {
+        acc += _IQ24div(_IQ24(1.0), IQ_INPUT(i));
+    }
+    s_sink = acc;
+    return true;
+}
+
+static bool iq24_sqrt_run(void *ctx)
+{
+    _iq24 acc = 0;
+    for (int i = 0; i < IQ_NUM_INPUTS; i++) {
+        acc += _IQ24sqrt(IQ_INPUT(i));
+    }
+    s_sink = acc;
+    return true;
+}
+
+static bool iq24_sin_run(void *ctx)
+{
+    _iq24 acc = 0;
+    for (int i = 0; i < IQ_NUM_INPUTS; i++) {
+        acc += _IQ24sin(IQ_INPUT(i));
+    }
+    s_sink = acc;
+    return true;
+}
+
+static bool iq24_sin_fast_run(void *ctx)
+{
+    _iq24 acc = 0;
+    for (int i = 0; i < IQ_NUM_INPUTS; i++) {
+        acc += _IQ24sin_fast(IQ_INPUT(i));
+    }
+    s_sink = acc;
+    return true;
+}
+
+static bool iq24_exp_run(void *ctx)
+{
+    _iq24 acc = 0;
+    for (int i = 0; i < IQ_NUM_INPUTS; i++) {
+        acc += _IQ24exp(IQ_INPUT(i));
+    }
+    s_sink = acc;
+    return true;
+}
+
+static bool iq24_exp_fast_run(void *ctx)
+{
+    _iq24 acc = 0;
+    for (int i = 0; i < IQ_NUM_INPUTS; i++) {
+        acc += _IQ24exp_fast(IQ_INPUT(i));
+    }
+    s_sink = acc;
+    return true;
+}
+
+static bool iq24_log_run(void *ctx)
+{
+    _iq24 acc = 0;
+    for (int i = 0; i < IQ_NUM_INPUTS; i++) {
+        acc += _IQ24log(IQ_INPUT(i));
+    }
+    s_sink = acc;
+    return true;
+}
+
+static bool iq24_log_fast_run(void *ctx)
+{
+    _iq24 acc = 0;
+    for (int i = 0; i < IQ_NUM_INPUTS; i++) {
+        acc += _IQ24log_fast(IQ_INPUT(i));
+    }
+    s_sink = acc;
+    return true;
+}
+
+static bool iq24_atan2_run(void *ctx)
+{
+    _iq24 acc = 0;
+    for (int i = 0; i < IQ_NUM_INPUTS; i++) {
+        acc += _IQ24atan2(IQ_INPUT(i), _IQ24(2.0));
+    }
+    s_sink = acc;
+    return true;
+}
+
+const bench_case_t bench_iqmath_cases[] = {
+    { "iq24_mpy_x256", 100, NULL, iq24_mpy_run, NULL },
+    { "iq24_div_x256", 100, NULL, iq24_div_run, NULL },
+    { "iq24_sqrt_x256", 100, NULL, iq24_sqrt_run, NULL },
+    { "iq24_sin_x256", 100, NULL, iq24_sin_run, NULL },
+    { "iq24_sin_fast_x256", 100, NULL, iq24_sin_fast_run, NULL },
+    { "iq24_exp_x256", 100, NULL, iq24_exp_run, NULL },
+    { "iq24_exp_fast_x256", 100, NULL, iq24_exp_fast_run, NULL },
+    { "iq24_log_x256", 100, NULL, iq24_log_run, NULL },
+    { "iq24_log_fast_x256", 100, NULL, iq24_log_fast_run, NULL },
+    { "iq24_atan2_x256", 100, NULL, iq24_atan2_run, NULL },
+};
+const size_t bench_iqmath_num_cases = BENCH_NUM_CASES(bench_iqmath_cases);
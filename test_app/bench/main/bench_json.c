@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "json_parser.h"
+#include "json_generator.h"
+#include "bench.h"
+
+static const char s_json_doc[] =
+    "{\"device\":\"esp32-sensor\",\"fw_version\":\"1.4.2\",\"uptime\":86400,\"connected\":true,"
+    "\"config\":{\"interval\":60,\"threshold\":12.5,\"unit\":\"celsius\",\"alerts\":false},"
+    "\"readings\":[21.5,21.7,22.0,22.4,22.1,21.9,21.6,21.4],"
+    "\"peers\":[{\"id\":1,\"rssi\":-61},{\"id\":2,\"rssi\":-72},{\"id\":3,\"rssi\":-55}]}";
+
+/* json_parser: tokenize the document and read some values from it */
+
+static bool json_parse_run(void *ctx)
+{
+    jparse_ctx_t jctx;
+    int uptime = 0;
+    int interval = 0;
+    int num_readings = 0;
+
+    if (json_parse_start(&jctx, s_json_doc, sizeof(s_json_doc) - 1) != OS_SUCCESS) {
+        return false;
+    }
+    bool ok = json_obj_get_int(&jctx, "uptime", &uptime) == OS_SUCCESS &&
+              json_obj_get_object(&jctx, "config") == OS_SUCCESS &&
+              json_obj_get_int(&jctx, "interval", &interval) == OS_SUCCESS &&
+              json_obj_leave_object(&jctx) == OS_SUCCESS &&
+              json_obj_get_array(&jctx, "readings", &num_readings) == OS_SUCCESS &&
+              json_obj_leave_array(&jctx) == OS_SUCCESS;
+    json_parse_end(&jctx);
+    return ok && uptime == 86400 && interval == 60 && num_readings == 8;
+}
+
+/* json_generator: generate a document similar to the parsed one */
+
+#define JSON_GEN_BUF_SIZE 512
+
+static void json_gen_flush(char *buf, void *priv)
+{
+    // The buffer fits the whole document, nothing to flush to
+}
+
+static bool json_gen_run(void *ctx)
+{
+    static const float readings[] = { 21.5, 21.7, 22.0, 22.4, 22.1, 21.9, 21.6, 21.4 };
+    static char buf[JSON_GEN_BUF_SIZE];
+    json_gen_str_t jstr;
+
+    json_gen_str_start(&jstr, buf, sizeof(buf), json_gen_flush, NULL);
+    json_gen_start_object(&jstr);
+    json_gen_obj_set_string(&jstr, "device", "esp32-sensor");
+    json_gen_obj_set_string(&jstr, "fw_version", "1.4.2");
+    json_gen_obj_set_int(&jstr, "uptime", 86400);
+    json_gen_obj_set_bool(&jstr, "connected", true);
+    json_gen_push_object(&jstr, "config");
+    json_gen_obj_set_int(&jstr, "interval", 60);
+    json_gen_obj_set_float(&jstr, "threshold", 12.5);
+    json_gen_obj_set_string(&jstr, "unit", "celsius");
+    json_gen_obj_set_bool(&jstr, "alerts", false);
+    json_gen_pop_object(&jstr);
+    json_gen_push_array(&jstr, "readings");
+    for (size_t i = 0; i < sizeof(readings) / sizeof(readings[0]); i++) {
+        json_gen_arr_set_float(&jstr, readings[i]);
+    }
+    json_gen_pop_array(&jstr);
+    json_gen_end_object(&jstr);
+    return json_gen_str_end(&jstr) > 0 && buf[0] == '{';
+}
+
+const bench_case_t bench_json_cases[] = {
+    { "json_parse_start_get", 100, NULL, json_parse_run, NULL },
+    { "json_gen_str_object", 100, NULL, json_gen_run, NULL },
+};
+const size_t bench_json_num_cases = BENCH_NUM_CASES(bench_json_cases);
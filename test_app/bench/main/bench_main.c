@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "ccomp_timer.h"
+#include "bench.h"
+
+/*
+ * Every benchmark prints one line, parsed by pytest_bench.py:
+ *
+ *   BENCH <name> <iterations> <compensated µs per iteration> <wall-clock µs per iteration>
+ *   BENCH_FAIL <name>
+ *
+ * followed by BENCH_DONE once all of them ran.
+ */
+
+typedef struct {
+    const bench_case_t *cases;
+    const size_t *num_cases;
+} bench_group_t;
+
+static const bench_group_t s_groups[] = {
+    { bench_codecs_cases, &bench_codecs_num_cases },
+    { bench_json_cases, &bench_json_num_cases },
+    { bench_crypto_cases, &bench_crypto_num_cases },
+    { bench_iqmath_cases, &bench_iqmath_num_cases },
+};
+
+static bool bench_run(const bench_case_t *bench)
+{
+    void *ctx = NULL;
+    bool ok = true;
+
+    // teardown is called after a failed setup as well, to free what it allocated until then
+    if (bench->setup) {
+        ok = bench->setup(&ctx);
+    }
+
+    // Warm up the cache, the results of a cold run aren't reproducible
+    ok = ok && bench->run(ctx);
+
+    ccomp_timer_handle_t timer;
+    if (ok && ccomp_timer_create(&timer) != ESP_OK) {
+        ok = false;
+    }
+    if (ok) {
+        // Start right after a tick, other tasks of this core run less in the measurement
+        vTaskDelay(1);
+        int64_t wall_start = esp_timer_get_time();
+        ok = ccomp_timer_handle_start(timer) == ESP_OK;
+        for (uint32_t i = 0; ok && i < bench->iterations; i++) {
+            ok = bench->run(ctx);
+        }
+        int64_t time = -1;
+        ok = ccomp_timer_handle_stop(timer) == ESP_OK && ok;
+        ok = ccomp_timer_handle_get_time(timer, &time) == ESP_OK && ok;
+        int64_t wall_time = esp_timer_get_time() - wall_start;
+        ccomp_timer_delete(timer);
+
+        if (ok) {
+            printf("BENCH %s %"PRIu32" %.3f %.3f\n", bench->name, bench->iterations,
+                   (double)time / bench->iterations, (double)wall_time / bench->iterations);
+        }
+    }
+
+    if (bench->teardown) {
+        bench->teardown(ctx);
+    }
+    return ok;
+}
+
+void app_main(void)
+{
+    // The main task is pinned to a core, as the timed loop must not migrate
+    for (size_t i = 0; i < sizeof(s_groups) / sizeof(s_groups[0]); i++) {
+        for (size_t j = 0; j < *s_groups[i].num_cases; j++) {
+            const bench_case_t *bench = &s_groups[i].cases[j];
+            if (!bench_run(bench)) {
+                printf("BENCH_FAIL %s\n", bench->name);
+            }
+        }
+    }
+    printf("BENCH_DONE\n");
+}
@@ -0,0 +1,72 @@
+# SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+
+import json
+import logging
+import os
+import re
+
+from pytest_embedded import Dut
+
+# Allowed slowdown against the baseline, relative
+BENCH_TOLERANCE = float(os.getenv('BENCH_TOLERANCE', '0.10'))
+# Store the results as the new baseline of the target instead of comparing them
+BENCH_UPDATE_BASELINES = os.getenv('BENCH_UPDATE_BASELINES', '0') == '1'
+
+BENCH_LINE = re.compile(rb'(BENCH|BENCH_FAIL|BENCH_DONE)(?: (\S+))?(?: (\d+) ([\d.]+) ([\d.]+))?\r?\n')
+BASELINES_DIR = os.path.join(os.path.dirname(__file__), 'baselines')
+
+
+def read_results(dut: Dut) -> dict:
+    results = {}
+    failed = []
+    while True:
+        match = dut.expect(BENCH_LINE, timeout=120)
+        kind = match.group(1).decode()
+        if kind == 'BENCH_DONE':
+            break
+        name = match.group(2).decode()
+        if kind == 'BENCH_FAIL':
+            failed.append(name)
+        else:
+            results[name] = {
+                'iterations': int(match.group(3)),
+                'time_us': float(match.group(4)),
+                'wall_time_us': float(match.group(5)),
+            }
+    assert not failed, 'Benchmarks failed: {}'.format(', '.join(failed))
+    return results
+
+
+def test_bench(dut: Dut) -> None:
+    results = read_results(dut)
+    for name, result in results.items():
+        logging.info('%-32s %12.3f us %12.3f us wall', name, result['time_us'], result['wall_time_us'])
+
+    baseline_path = os.path.join(BASELINES_DIR, '{}.json'.format(dut.target))
+    if BENCH_UPDATE_BASELINES:
+        os.makedirs(BASELINES_DIR, exist_ok=True)
+        with open(baseline_path, 'w') as f:
+            json.dump({name: result['time_us'] for name, result in results.items()}, f, indent=4, sort_keys=True)
+            f.write('\n')
+        logging.info('Baseline written to %s', baseline_path)
+        return
+
+    if not os.path.exists(baseline_path):
+        logging.warning('No baseline for %s, results not compared', dut.target)
+        return
+
+    with open(baseline_path) as f:
+        baseline = json.load(f)
+
+    # Compare the compensated times, the wall-clock times depend on the cache state and interrupts
+    regressions = []
+    for name, base_time in baseline.items():
+        if name not in results:
+            regressions.append('{}: missing'.format(name))
+            continue
+        time = results[name]['time_us']
+        if time > base_time * (1 + BENCH_TOLERANCE):
+            regressions.append('{}: {:.3f} us, baseline {:.3f} us (+{:.1f}%)'.format(
+                name, time, base_time, (time / base_time - 1) * 100))
+    assert not regressions, 'Performance regressions:\n' + '\n'.join(regressions)
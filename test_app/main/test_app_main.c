@@ -1,14 +1,112 @@
 /*
- * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "esp_idf_version.h"
+#include "esp_timer.h"
 #include "unity.h"
 
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#include "ccomp_timer.h"
+#define TEST_APP_CCOMP_TIMER 1
+#endif
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
+#define TEST_APP_LOCAL_MIN_FREE 1
+#endif
+
+/*
+ * After every test, tearDown prints one line, parsed by pytest_test_app.py:
+ *
+ *   TEST_METRICS time_us=<n> wall_us=<n> heap_used=<n> min_free=<n> largest_block=<n> stack_hwm=<n> name=<test name>
+ *
+ * time_us:       Duration of the test, compensated for the cache stalls by ccomp_timer. -1 before IDF v5.0
+ * wall_us:       Wall-clock duration of the test
+ * heap_used:     Peak of the heap allocated during the test. -1 before IDF v5.3
+ * min_free:      Minimum free heap during the test, since boot before IDF v5.3
+ * largest_block: Largest free heap block after the test, lower when the test leaks or fragments the heap
+ * stack_hwm:     Minimum free stack of the test task during the test, in bytes
+ */
+
+#define STACK_FILL_BYTE     0xa5    // tskSTACK_FILL_BYTE, counted by uxTaskGetStackHighWaterMark
+#define STACK_PAINT_MARGIN  1024    // Below the frame of stack_paint, for the frames of memset and interrupts
+
+static struct {
+    size_t free_before;
+    int64_t wall_start;
+#if TEST_APP_CCOMP_TIMER
+    ccomp_timer_handle_t timer;
+#endif
+} s_metrics;
+
+/* Refill the unused stack of the task, so that its high water mark is the one of the next test only */
+static void __attribute__((noinline)) stack_paint(void)
+{
+    uint8_t *start = (uint8_t *)pxTaskGetStackStart(NULL);
+    uint8_t *end = (uint8_t *)__builtin_frame_address(0) - STACK_PAINT_MARGIN;
+    if (end > start) {
+        memset(start, STACK_FILL_BYTE, end - start);
+    }
+}
+
 void app_main(void)
 {
+#if TEST_APP_CCOMP_TIMER
+    // Created once, so that the timer isn't counted as an allocation of the tests
+    if (ccomp_timer_create(&s_metrics.timer) != ESP_OK) {
+        s_metrics.timer = NULL;
+    }
+#endif
     UNITY_BEGIN();
     unity_run_all_tests();
     UNITY_END();
 }
+
+/* setUp runs before every test */
+void setUp(void)
+{
+    stack_paint();
+    s_metrics.free_before = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+#if TEST_APP_LOCAL_MIN_FREE
+    heap_caps_monitor_local_minimum_free_size_start();
+#endif
+    s_metrics.wall_start = esp_timer_get_time();
+#if TEST_APP_CCOMP_TIMER
+    // The tests run in the main task, which is pinned to a core
+    if (s_metrics.timer) {
+        ccomp_timer_handle_start(s_metrics.timer);
+    }
+#endif
+}
+
+/* tearDown runs after every test */
+void tearDown(void)
+{
+    int64_t time = -1;
+#if TEST_APP_CCOMP_TIMER
+    if (s_metrics.timer && ccomp_timer_handle_stop(s_metrics.timer) == ESP_OK) {
+        ccomp_timer_handle_get_time(s_metrics.timer, &time);
+    }
+#endif
+    int64_t wall_time = esp_timer_get_time() - s_metrics.wall_start;
+
+    size_t min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    long heap_used = -1;
+#if TEST_APP_LOCAL_MIN_FREE
+    heap_caps_monitor_local_minimum_free_size_stop();
+    heap_used = (long)s_metrics.free_before - (long)min_free;
+#endif
+    size_t largest_block = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    unsigned stack_hwm = uxTaskGetStackHighWaterMark(NULL);
+
+    printf("TEST_METRICS time_us=%ld wall_us=%ld heap_used=%ld min_free=%u largest_block=%u stack_hwm=%u name=%s\n",
+           (long)time, (long)wall_time, heap_used, (unsigned)min_free, (unsigned)largest_block, stack_hwm,
+           Unity.CurrentTestName);
+}
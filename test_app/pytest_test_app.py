@@ -1,2 +1,88 @@
-def test_app(dut):
+import json
+import logging
+import os
+import re
+
+from pytest_embedded import Dut
+
+# Allowed regression against the baseline: relative, plus an absolute slack for the short tests and small sizes
+METRICS_TIME_TOLERANCE = float(os.getenv('METRICS_TIME_TOLERANCE', '0.25'))
+METRICS_TIME_SLACK_US = int(os.getenv('METRICS_TIME_SLACK_US', '100'))
+METRICS_MEM_TOLERANCE = float(os.getenv('METRICS_MEM_TOLERANCE', '0.10'))
+METRICS_MEM_SLACK = int(os.getenv('METRICS_MEM_SLACK', '256'))
+# Store the metrics as the new baseline of the target instead of comparing them
+METRICS_UPDATE_BASELINES = os.getenv('METRICS_UPDATE_BASELINES', '0') == '1'
+
+# Printed by tearDown in main/test_app_main.c
+METRICS_LINE = re.compile(r'TEST_METRICS ((?:\w+=-?\d+ )+)name=(.*?)\r?$', re.MULTILINE)
+BASELINES_DIR = os.path.join(os.path.dirname(__file__), 'baselines')
+
+# Compared metrics, True if a higher value is a regression. The wall-clock time and the minimum free heap
+# depend on the other tasks and on the tests run before, they are only recorded
+COMPARED_METRICS = {
+    'time_us': True,
+    'heap_used': True,
+    'largest_block': False,
+    'stack_hwm': False,
+}
+
+
+def read_metrics(dut: Dut) -> dict:
+    with open(dut.logfile, errors='replace') as f:
+        log = f.read()
+    metrics = {}
+    for match in METRICS_LINE.finditer(log):
+        metrics[match.group(2)] = {key: int(value) for key, value in
+                                   (item.split('=') for item in match.group(1).split())}
+    return metrics
+
+
+def is_regression(metric: str, value: int, base: int) -> bool:
+    # -1 is a metric not measured with this ESP-IDF version
+    if value < 0 or base < 0:
+        return False
+    if metric == 'time_us':
+        return value > base * (1 + METRICS_TIME_TOLERANCE) + METRICS_TIME_SLACK_US
+    if metric == 'stack_hwm':
+        # Free bytes of a stack sized with a margin, a relative tolerance would hide large increases of the usage
+        return value < base - METRICS_MEM_SLACK
+    if COMPARED_METRICS[metric]:
+        return value > base * (1 + METRICS_MEM_TOLERANCE) + METRICS_MEM_SLACK
+    return value < base * (1 - METRICS_MEM_TOLERANCE) - METRICS_MEM_SLACK
+
+
+def check_metrics(dut: Dut) -> None:
+    metrics = read_metrics(dut)
+    for name, values in metrics.items():
+        logging.info('%-64s %s', name, ' '.join('{}={}'.format(key, value) for key, value in values.items()))
+
+    baseline_path = os.path.join(BASELINES_DIR, '{}.json'.format(dut.target))
+    if METRICS_UPDATE_BASELINES:
+        os.makedirs(BASELINES_DIR, exist_ok=True)
+        with open(baseline_path, 'w') as f:
+            json.dump({name: {metric: values[metric] for metric in COMPARED_METRICS if metric in values}
+                       for name, values in metrics.items()}, f, indent=4, sort_keys=True)
+            f.write('\n')
+        logging.info('Baseline written to %s', baseline_path)
+        return
+
+    if not os.path.exists(baseline_path):
+        logging.warning('No baseline for %s, metrics not compared', dut.target)
+        return
+
+    with open(baseline_path) as f:
+        baseline = json.load(f)
+
+    # New tests and tests missing from this build (e.g. other ESP-IDF version) are not compared
+    regressions = []
+    for name, base_values in baseline.items():
+        for metric, base in base_values.items():
+            value = metrics.get(name, {}).get(metric)
+            if value is not None and is_regression(metric, value, base):
+                regressions.append('{}: {} {}, baseline {}'.format(name, metric, value, base))
+    assert not regressions, 'Test metrics regressions:\n' + '\n'.join(regressions)
+
+
+def test_app(dut: Dut) -> None:
     dut.expect_unity_test_output(timeout=240)
+    check_metrics(dut)
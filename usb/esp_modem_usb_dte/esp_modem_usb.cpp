@@ -6,6 +6,10 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
+#include <algorithm>
+#include <atomic>
+#include <vector>
 #include "esp_log.h"
 #include "esp_modem_config.h"
 #include "esp_modem_usb_config.h"
@@ -76,14 +80,29 @@ public:
         cdc_acm_host_install(&esp_modem_cdc_acm_driver_config);
 
         // Open CDC-ACM device
+        // With RX buffer, the device is polled by two transfers and the data are passed to esp_modem from rx_task
+        const bool rx_buffered = usb_config->rx_buffer_size > 0;
+        // Both ports of a dual port modem are interfaces of one USB device, the second one is found among already opened devices.
+        // Each port gets its own task for received data, so that PPP data don't delay AT command responses and vice versa
+        const bool own_rx_task = usb_config->secondary_interface_idx > -1 && !rx_buffered;
+        tx_async_enabled = usb_config->tx_transfer_count > 1;
         const cdc_acm_host_device_config_t esp_modem_cdc_acm_device_config = {
             .connection_timeout_ms = usb_config->timeout_ms,
             .out_buffer_size = config->dte_buffer_size,
             .in_buffer_size = config->dte_buffer_size,
             .event_cb = handle_notif,
-            .data_cb = handle_rx,
-            .user_arg = this
+            .data_cb = rx_buffered ? nullptr : handle_rx,
+            .user_arg = this,
+            .in_transfer_count = (rx_buffered || own_rx_task) ? 2U : 0U,
+            .out_transfer_count = tx_async_enabled ? (size_t)usb_config->tx_transfer_count : 0U,
+            .out_coalescing = tx_async_enabled,
+            .rx_ringbuf_size = rx_buffered ? std::max((size_t)usb_config->rx_buffer_size, (size_t)(2 * config->dte_buffer_size)) : 0U,
+            .rx_high_water = 0,
+            .event_task_stack_size = own_rx_task ? (size_t)config->task_stack_size : 0U,
+            .event_task_priority = (unsigned)config->task_priority,
+            .event_task_core_id = usb_config->xCoreID,
         };
+        dte_buffer_size = config->dte_buffer_size;
 
         // Determine Terminal interface index
         const uint8_t intf_idx = term_idx == 0 ? usb_config->interface_idx : usb_config->secondary_interface_idx;
@@ -97,11 +116,30 @@ public:
                 this->CdcAcmDevice::open_vendor_specific(usb_config->vid, usb_config->pid, intf_idx, &esp_modem_cdc_acm_device_config),
                 "USB Device open failed");
         }
+
+        if (rx_buffered) {
+            rx_task_done = xSemaphoreCreateBinary();
+            if (rx_task_done == NULL) {
+                this->CdcAcmDevice::close();
+                ESP_MODEM_THROW_IF_FALSE(false, "RX task semaphore failed");
+            }
+            rx_pending.reserve(dte_buffer_size);
+            if (pdTRUE != xTaskCreatePinnedToCore(rx_task, "usb_terminal_rx", config->task_stack_size, this, config->task_priority, &rx_task_hdl, usb_config->xCoreID)) {
+                rx_task_hdl = nullptr;
+                vSemaphoreDelete(rx_task_done);
+                this->CdcAcmDevice::close();
+                ESP_MODEM_THROW_IF_FALSE(false, "RX task failed");
+            }
+        }
     };
 
     ~UsbTerminal()
     {
+        stop_rx_task();
         this->CdcAcmDevice::close();
+        if (rx_task_done) {
+            vSemaphoreDelete(rx_task_done);
+        }
     };
 
     void start() override
@@ -117,8 +155,20 @@ public:
     int write(uint8_t *data, size_t len) override
     {
         ESP_LOG_BUFFER_HEXDUMP(TAG, data, len, ESP_LOG_DEBUG);
-        if (this->CdcAcmDevice::tx_blocking(data, len) != ESP_OK) {
-            return -1;
+        if (!tx_async_enabled) {
+            if (this->CdcAcmDevice::tx_blocking(data, len) != ESP_OK) {
+                return -1;
+            }
+            return len;
+        }
+
+        // Data are copied by the driver and appended to a transfer waiting for the one in flight,
+        // so short consecutive writes (e.g. AT commands) are sent in one transfer
+        for (size_t offset = 0; offset < len; offset += dte_buffer_size) {
+            const size_t chunk = std::min(len - offset, dte_buffer_size);
+            if (this->CdcAcmDevice::tx_async(data + offset, chunk, handle_tx_done, this) != ESP_OK) {
+                return offset > 0 ? (int)offset : -1;
+            }
         }
         return len;
     }
@@ -137,6 +187,81 @@ private:
     bool operator== (const UsbTerminal &param) const = delete;
     bool operator!= (const UsbTerminal &param) const = delete;
     static TaskHandle_t usb_host_lib_task; // Reused by multiple devices or between reconnections
+    size_t dte_buffer_size = 0;
+    bool tx_async_enabled = false;
+    TaskHandle_t rx_task_hdl = nullptr;
+    SemaphoreHandle_t rx_task_done = nullptr;
+    std::atomic<bool> rx_task_stop{false};
+    std::vector<uint8_t> rx_pending; // Data not consumed by on_read, they are passed again with the following data
+
+    /**
+     * @brief Pass data from RX ring buffer to esp_modem
+     *
+     * The data are passed directly from the ring buffer. If esp_modem doesn't consume them,
+     * they are copied to rx_pending and passed again together with the following data.
+     * While rx_pending is full, no more data are taken from the ring buffer. Once it fills up,
+     * the CDC-ACM driver stops polling the device until esp_modem consumes the pending data.
+     */
+    static void rx_task(void *arg)
+    {
+        auto *this_terminal = static_cast<UsbTerminal *>(arg);
+        std::vector<uint8_t> &pending = this_terminal->rx_pending;
+        while (!this_terminal->rx_task_stop) {
+            const size_t space = pending.capacity() - pending.size();
+            if (space == 0) {
+                if (handle_rx(pending.data(), pending.size(), this_terminal)) {
+                    pending.clear();
+                } else {
+                    vTaskDelay(pdMS_TO_TICKS(10));
+                }
+                continue;
+            }
+            const uint8_t *data;
+            size_t data_len;
+            if (this_terminal->read_acquire(&data, &data_len, space, 10) != ESP_OK) {
+                continue;
+            }
+            this_terminal->process_rx(data, data_len);
+            this_terminal->read_release(data);
+        }
+        xSemaphoreGive(this_terminal->rx_task_done);
+        vTaskDelete(NULL);
+    }
+
+    /**
+     * @brief Pass received data to esp_modem, data_len must fit in the free space of rx_pending
+     */
+    void process_rx(const uint8_t *data, size_t data_len)
+    {
+        if (rx_pending.empty()) {
+            if (!handle_rx(data, data_len, this)) {
+                rx_pending.assign(data, data + data_len);
+            }
+            return;
+        }
+
+        rx_pending.insert(rx_pending.end(), data, data + data_len);
+        if (handle_rx(rx_pending.data(), rx_pending.size(), this)) {
+            rx_pending.clear();
+        }
+    }
+
+    void stop_rx_task()
+    {
+        if (rx_task_hdl == nullptr) {
+            return;
+        }
+        rx_task_stop = true;
+        xSemaphoreTake(rx_task_done, portMAX_DELAY);
+        rx_task_hdl = nullptr;
+    }
+
+    static void handle_tx_done(cdc_acm_dev_hdl_t cdc_hdl, esp_err_t result, void *user_arg)
+    {
+        if (result != ESP_OK) {
+            ESP_LOGW(TAG, "USB write failed: %s", esp_err_to_name(result));
+        }
+    }
 
     static bool handle_rx(const uint8_t *data, size_t data_len, void *user_arg)
     {
@@ -165,6 +290,7 @@ private:
             if (this_terminal->on_error) {
                 this_terminal->on_error(terminal_error::DEVICE_GONE);
             }
+            this_terminal->stop_rx_task();
             this_terminal->close();
             break;
         case CDC_ACM_HOST_ERROR:
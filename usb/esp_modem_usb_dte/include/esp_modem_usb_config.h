@@ -21,6 +21,8 @@ struct esp_modem_usb_term_config {
     int xCoreID;                 /*!< Core affinity of created tasks: CDC-ACM driver task and optional USB Host task */
     bool cdc_compliant;          /*!< Treat the USB device as CDC-compliant. Read CDC-ACM driver documentation for more details */
     bool install_usb_host;       /*!< Flag whether USB Host driver should be installed */
+    int tx_transfer_count;       /*!< Number of USB transfers for writes. Writes are batched into one transfer while the others are in flight. 0 or 1 means blocking writes */
+    int rx_buffer_size;          /*!< Size of RX ring buffer. Data are passed to esp_modem from a separate task, which does not block USB. 0 passes data from the USB driver's task */
 };
 
 /**
@@ -55,7 +57,9 @@ struct esp_modem_usb_term_config {
         .timeout_ms = 0,                                             \
         .xCoreID = 0,                                                \
         .cdc_compliant = false,                                      \
-        .install_usb_host = true                                     \
+        .install_usb_host = true,                                    \
+        .tx_transfer_count = 1,                                      \
+        .rx_buffer_size = 0                                          \
     }
 #define ESP_MODEM_DEFAULT_USB_CONFIG(_vid, _pid, _intf) ESP_MODEM_DEFAULT_USB_CONFIG_DUAL(_vid, _pid, _intf, -1)
 
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "tinyusb_types.h"
 #include "esp_err.h"
@@ -19,6 +20,8 @@ extern "C" {
 
 /**
  * @brief On receive callback type
+ *
+ * In zero copy receive mode, returning ESP_OK keeps the buffer until tinyusb_net_recv_renew() is called.
  */
 typedef esp_err_t (*tusb_net_rx_cb_t)(void *buffer, uint16_t len, void *ctx);
 
@@ -47,6 +50,11 @@ typedef struct {
                                                */
     tusb_net_init_cb_t on_init_callback;      /*!< TinyUSB init network callback */
     void *user_context;                       /*!< User context to be passed to any of the callback */
+    bool zero_copy_rx;                        /*!< Receive buffer, passed to on_recv_callback, is owned by the user until tinyusb_net_recv_renew() is called.
+                                               *    - allows wrapping the received packet (e.g. in a custom lwIP pbuf) instead of copying it
+                                               *    - no other packet is received while the user holds the buffer
+                                               *    - if false, the buffer is valid only within the callback
+                                               */
 } tinyusb_net_config_t;
 
 /**
@@ -78,10 +86,14 @@ esp_err_t tinyusb_net_send_sync(void *buffer, uint16_t len, void *buff_free_arg,
 /**
  * @brief TinyUSB NET driver send data asynchronously
  *
+ * The packet is queued and sent from TinyUSB task as soon as the interface can transmit it,
+ * without waiting for the packets queued before.
+ *
  * @note If using asynchronous sends, you must free the buffer using free_tx_buffer() callback.
  * @note It is possible to use sync and async send interchangeably.
  * @note Async flavor of the send is useful when the USB stack runs faster than the caller,
  * since we have no control over the transmitted packets, if they get accepted or discarded.
+ * @note Up to CONFIG_TINYUSB_NET_TX_QUEUE_SIZE packets can be queued
  *
  * @param[in] buffer            USB send data
  * @param[in] len               Send data len
@@ -89,9 +101,21 @@ esp_err_t tinyusb_net_send_sync(void *buffer, uint16_t len, void *buff_free_arg,
  * @return  ESP_OK on success == packet has been consumed by tusb and will be freed
  *                              by free_tx_buffer() callback (if non null)
  *          ESP_ERR_INVALID_STATE if tusb not initialized
+ *          ESP_ERR_NO_MEM if the Tx queue is full
  */
 esp_err_t tinyusb_net_send_async(void *buffer, uint16_t len, void *buff_free_arg);
 
+/**
+ * @brief Return the receive buffer to TinyUSB NET driver in zero copy receive mode
+ *
+ * Must be called once for every received packet the on_recv_callback returned ESP_OK for, when the packet is not
+ * needed anymore. Can be called from any task.
+ *
+ * @return  ESP_OK on success
+ *          ESP_ERR_INVALID_STATE if zero copy receive is not enabled
+ */
+esp_err_t tinyusb_net_recv_renew(void);
+
 #endif // (CONFIG_TINYUSB_NET_MODE_NONE != 1)
 
 #ifdef __cplusplus
@@ -83,6 +83,19 @@ typedef struct {
  */
 typedef void(*tusb_cdcacm_callback_t)(int itf, cdcacm_event_t *event);
 
+/**
+ * @brief Callback type of a buffer sent by `tinyusb_cdcacm_write_buffer`
+ *
+ * Invoked from TinyUSB task, or from the task calling `tusb_cdc_acm_deinit`.
+ *
+ * @param[in] itf    Index of CDC interface
+ * @param[in] buf    The sent buffer, it is owned by the caller again
+ * @param[in] len    Length of the buffer
+ * @param[in] result ESP_OK if the buffer was sent, ESP_ERR_INVALID_STATE if the interface was de-initialized
+ * @param[in] arg    User argument passed to `tinyusb_cdcacm_write_buffer`
+ */
+typedef void(*tusb_cdcacm_tx_done_cb_t)(int itf, const uint8_t *buf, size_t len, esp_err_t result, void *arg);
+
 /*********************************************************************** Callbacks and events*/
 /* Other structs
    ********************************************************************* */
@@ -179,6 +192,30 @@ size_t tinyusb_cdcacm_write_queue(tinyusb_cdcacm_itf_t itf, const uint8_t *in_bu
  */
 esp_err_t tinyusb_cdcacm_write_flush(tinyusb_cdcacm_itf_t itf, uint32_t timeout_ticks);
 
+/**
+ * @brief Send a whole buffer without copying it
+ *
+ * The buffer is transferred directly from the memory of the caller in as few USB transfers as possible, bypassing
+ * the TX FIFO. Buffers are sent in order, up to CONFIG_TINYUSB_CDC_TX_BUFFER_QUEUE_SIZE of them can be queued.
+ * Useful for high rate data, the caller does not poll `tinyusb_cdcacm_write_flush`.
+ *
+ * @note The buffer must not be modified or freed until the callback is invoked
+ * @note Data queued by `tinyusb_cdcacm_write_queue` is not ordered with the buffers, do not mix them
+ *
+ * @param[in] itf      Index of CDC interface
+ * @param[in] buf      Data, in internal memory
+ * @param[in] len      Data size in bytes
+ * @param[in] callback Invoked once the buffer was sent, can be NULL
+ * @param[in] arg      User argument passed to the callback
+ * @return - ESP_OK                The buffer is queued
+ *         - ESP_ERR_INVALID_ARG   buf is NULL or len is 0
+ *         - ESP_ERR_INVALID_STATE Interface is not initialized or USB device is not mounted
+ *         - ESP_ERR_NOT_FOUND     Data IN endpoint of the interface was not found in the configuration descriptor
+ *         - ESP_ERR_NO_MEM        Queue is full
+ */
+esp_err_t tinyusb_cdcacm_write_buffer(tinyusb_cdcacm_itf_t itf, const uint8_t *buf, size_t len,
+                                      tusb_cdcacm_tx_done_cb_t callback, void *arg);
+
 /**
  * @brief Receive data from CDC interface
  *
@@ -114,6 +114,12 @@ extern "C" {
 // MSC Buffer size of Device Mass storage
 #define CFG_TUD_MSC_BUFSIZE         CONFIG_TINYUSB_MSC_BUFSIZE
 
+// NCM Transfer Block sizes
+#if CONFIG_TINYUSB_NET_MODE_NCM
+#define CFG_TUD_NCM_IN_NTB_MAX_SIZE             CONFIG_TINYUSB_NET_NCM_TX_NTB_SIZE
+#define CFG_TUD_NCM_IN_MAX_DATAGRAMS_PER_NTB    CONFIG_TINYUSB_NET_NCM_TX_DATAGRAMS_PER_NTB
+#endif
+
 // MIDI macros
 #define CFG_TUD_MIDI_EP_BUFSIZE     64
 #define CFG_TUD_MIDI_EPSIZE         CFG_TUD_MIDI_EP_BUFSIZE
@@ -11,7 +11,9 @@ extern "C" {
 #endif
 
 #include <stddef.h>
+#include <stdint.h>
 #include "esp_err.h"
+#include "esp_partition.h"
 #include "wear_levelling.h"
 #include "esp_vfs_fat.h"
 #if SOC_SDMMC_HOST_SUPPORTED
@@ -76,6 +78,62 @@ typedef struct {
     const esp_vfs_fat_mount_config_t mount_config; /*!< FATFS mount config */
 } tinyusb_msc_spiflash_config_t;
 
+/**
+ * @brief Operations of a block device exposed over MSC
+ *
+ * The functions are called from the TinyUSB task, or from the storage task if CONFIG_TINYUSB_MSC_ASYNC_IO is enabled,
+ * and from the application while the storage is mounted locally.
+ */
+typedef struct {
+    esp_err_t (*read)(void *ctx, uint32_t lba, uint32_t offset, size_t size, void *dest);  /*!< Read size bytes from byte offset of sector lba. The offset is not 0 only if the MSC buffer is smaller than a sector */
+    esp_err_t (*write)(void *ctx, uint32_t lba, size_t size, const void *src);             /*!< Write whole sectors starting at sector lba, size is a multiple of the sector size */
+    esp_err_t (*flush)(void *ctx);                                                         /*!< Optional: Commit the data cached by the block device, called when the host synchronizes the cache or the storage is mounted locally */
+    void (*deinit)(void *ctx);                                                             /*!< Optional: Release the block device, called by tinyusb_msc_storage_deinit() */
+} tinyusb_msc_blockdev_ops_t;
+
+/**
+ * @brief Configuration structure for block device initialization
+ *
+ * User configurable parameters that are used while
+ * initializing a custom storage media.
+ */
+typedef struct {
+    const tinyusb_msc_blockdev_ops_t *ops;          /*!< Operations of the block device, must stay valid until tinyusb_msc_storage_deinit() */
+    void *ctx;                                      /*!< Argument passed to the operations */
+    uint32_t sector_count;                          /*!< Number of sectors of the block device */
+    uint32_t sector_size;                           /*!< Size of a sector in bytes. Local mounting is supported for sizes FATFS is configured for */
+    tusb_msc_callback_t callback_mount_changed;     /*!< Pointer to the function callback that will be delivered AFTER mount/unmount operation is successfully finished */
+    tusb_msc_callback_t callback_premount_changed;  /*!< Pointer to the function callback that will be delivered BEFORE mount/unmount operation is started */
+    const esp_vfs_fat_mount_config_t mount_config; /*!< FATFS mount config */
+} tinyusb_msc_blockdev_config_t;
+
+/**
+ * @brief Configuration structure for raw partition initialization
+ *
+ * The partition is exposed without wear levelling, in sectors of the flash erase block size (4096 bytes).
+ * Every sector written by the host is erased and written once, so CONFIG_TINYUSB_MSC_BUFSIZE must be
+ * a multiple of the sector size.
+ */
+typedef struct {
+    const esp_partition_t *partition;               /*!< Partition to expose */
+    tusb_msc_callback_t callback_mount_changed;     /*!< Pointer to the function callback that will be delivered AFTER mount/unmount operation is successfully finished */
+    tusb_msc_callback_t callback_premount_changed;  /*!< Pointer to the function callback that will be delivered BEFORE mount/unmount operation is started */
+    const esp_vfs_fat_mount_config_t mount_config; /*!< FATFS mount config */
+} tinyusb_msc_partition_config_t;
+
+/**
+ * @brief Configuration structure for RAM disk initialization
+ */
+typedef struct {
+    size_t size;                                    /*!< Size of the RAM disk in bytes, rounded down to a multiple of the sector size */
+    uint32_t sector_size;                           /*!< Size of a sector in bytes, 512 if 0 */
+    void *buffer;                                   /*!< Memory of the RAM disk. If NULL, it is allocated with heap_caps */
+    uint32_t heap_caps;                             /*!< Capabilities of the allocated memory, e.g. MALLOC_CAP_SPIRAM. MALLOC_CAP_8BIT if 0 */
+    tusb_msc_callback_t callback_mount_changed;     /*!< Pointer to the function callback that will be delivered AFTER mount/unmount operation is successfully finished */
+    tusb_msc_callback_t callback_premount_changed;  /*!< Pointer to the function callback that will be delivered BEFORE mount/unmount operation is started */
+    const esp_vfs_fat_mount_config_t mount_config; /*!< FATFS mount config */
+} tinyusb_msc_ramdisk_config_t;
+
 /**
  * @brief Register storage type spiflash with tinyusb driver
  *
@@ -97,6 +155,42 @@ esp_err_t tinyusb_msc_storage_init_spiflash(const tinyusb_msc_spiflash_config_t
  */
 esp_err_t tinyusb_msc_storage_init_sdmmc(const tinyusb_msc_sdmmc_config_t *config);
 #endif
+
+/**
+ * @brief Register a custom block device with tinyusb driver
+ *
+ * @param config pointer to the block device configuration
+ * @return esp_err_t
+ *       - ESP_OK, if success;
+ *       - ESP_ERR_INVALID_ARG, if the operations, the sector count or the sector size are missing;
+ *       - ESP_ERR_NO_MEM, if there was no memory to allocate storage components;
+ */
+esp_err_t tinyusb_msc_storage_init_blockdev(const tinyusb_msc_blockdev_config_t *config);
+
+/**
+ * @brief Register a raw flash partition, without wear levelling, with tinyusb driver
+ *
+ * @param config pointer to the partition configuration
+ * @return esp_err_t
+ *       - ESP_OK, if success;
+ *       - ESP_ERR_INVALID_ARG, if the partition is missing or its size is not a multiple of the sector size;
+ *       - ESP_ERR_INVALID_STATE, if CONFIG_TINYUSB_MSC_BUFSIZE is not a multiple of the sector size;
+ *       - ESP_ERR_NO_MEM, if there was no memory to allocate storage components;
+ */
+esp_err_t tinyusb_msc_storage_init_partition(const tinyusb_msc_partition_config_t *config);
+
+/**
+ * @brief Register a RAM disk with tinyusb driver
+ *
+ * The contents are lost by tinyusb_msc_storage_deinit(), which also frees the memory if it was allocated by the driver.
+ *
+ * @param config pointer to the RAM disk configuration
+ * @return esp_err_t
+ *       - ESP_OK, if success;
+ *       - ESP_ERR_INVALID_ARG, if the size is smaller than a sector;
+ *       - ESP_ERR_NO_MEM, if there was no memory to allocate the RAM disk or storage components;
+ */
+esp_err_t tinyusb_msc_storage_init_ramdisk(const tinyusb_msc_ramdisk_config_t *config);
 /**
  * @brief Deregister storage with tinyusb driver and frees the memory
  *
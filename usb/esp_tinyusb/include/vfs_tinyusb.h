@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include "esp_err.h"
 #include "esp_vfs_common.h" // For esp_line_endings_t definitions
 
@@ -36,6 +37,15 @@ esp_err_t esp_vfs_tusb_cdc_register(int cdc_intf, char const *path);
  */
 esp_err_t esp_vfs_tusb_cdc_unregister(char const *path);
 
+/**
+ * @brief Get the count of bytes dropped because the TX ring buffer was full
+ *
+ * The ring buffer is enabled with CONFIG_TINYUSB_VFS_TX_RINGBUF_SIZE.
+ *
+ * @return Bytes dropped since the CDC was registered to VFS, after line ending conversion
+ */
+size_t esp_vfs_tusb_cdc_get_tx_dropped(void);
+
 /**
  * @brief Set the line endings to sent
  *
@@ -5,6 +5,8 @@
  */
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
+#include "freertos/queue.h"
+#include "esp_timer.h"
 #include "tinyusb_net.h"
 #include "descriptors_control.h"
 #include "usb_descriptors.h"
@@ -30,6 +32,11 @@ struct tinyusb_net_handle {
     char mac_str[2 * MAC_ADDR_LEN + 1];
     void *ctx;
     packet_t *packet_to_send;
+    QueueHandle_t tx_queue;             // Packets queued by tinyusb_net_send_async()
+    volatile bool tx_drain_scheduled;   // do_send_queued() is deferred to TinyUSB task already
+    bool tx_drain_waiting;              // The queue is drained again on the next transfer completion, TinyUSB task only
+    esp_timer_handle_t tx_aggregation_timer;
+    bool zero_copy_rx;
 };
 
 const static int TX_FINISHED_BIT = BIT0;
@@ -54,16 +61,49 @@ static void do_send_sync(void *ctx)
     xEventGroupSetBits(s_net_obj.tx_flags, TX_FINISHED_BIT);
 }
 
-static void do_send_async(void *ctx)
+static void do_send_queued(void *ctx);
+static void schedule_send_queued(void);
+
+#if CONFIG_TINYUSB_NET_TX_AGGREGATION_TIMEOUT_US > 0
+static void tx_aggregation_timer_cb(void *arg)
 {
-    packet_t *packet = ctx;
-    if (tud_network_can_xmit(packet->len)) {
-        tud_network_xmit(packet, packet->len);
-    } else if (s_net_obj.tx_buff_free_cb) {
-        ESP_LOGW(TAG, "Packet cannot be accepted on USB interface, dropping");
-        s_net_obj.tx_buff_free_cb(packet->buff_free_arg, s_net_obj.ctx);
+    (void) arg;
+    schedule_send_queued();
+}
+#endif
+
+static void schedule_send_queued(void)
+{
+    if (!s_net_obj.tx_drain_scheduled) {
+        s_net_obj.tx_drain_scheduled = true;
+        usbd_defer_func(do_send_queued, NULL, false);
+    }
+}
+
+static void do_send_queued(void *ctx)
+{
+    (void) ctx;
+    packet_t packet;
+    // Packets queued from now on schedule another run
+    s_net_obj.tx_drain_scheduled = false;
+    while (xQueuePeek(s_net_obj.tx_queue, &packet, 0) == pdTRUE) {
+        if (!tud_ready()) {
+            xQueueReceive(s_net_obj.tx_queue, &packet, 0);
+            ESP_LOGW(TAG, "Packet cannot be accepted on USB interface, dropping");
+            if (s_net_obj.tx_buff_free_cb) {
+                s_net_obj.tx_buff_free_cb(packet.buff_free_arg, s_net_obj.ctx);
+            }
+            continue;
+        }
+        if (!tud_network_can_xmit(packet.len)) {
+            // The previous packets are still being transmitted, resume once a transfer completes
+            s_net_obj.tx_drain_waiting = true;
+            return;
+        }
+        xQueueReceive(s_net_obj.tx_queue, &packet, 0);
+        // The packet is copied and freed by tud_network_xmit_cb() before this returns
+        tud_network_xmit(&packet, packet.len);
     }
-    free(packet);
 }
 
 esp_err_t tinyusb_net_send_async(void *buffer, uint16_t len, void *buff_free_arg)
@@ -72,12 +112,21 @@ esp_err_t tinyusb_net_send_async(void *buffer, uint16_t len, void *buff_free_arg
         return ESP_ERR_INVALID_STATE;
     }
 
-    packet_t *packet = calloc(1, sizeof(packet_t));
-    packet->len = len;
-    packet->buffer = buffer;
-    packet->buff_free_arg = buff_free_arg;
-    ESP_RETURN_ON_FALSE(packet, ESP_ERR_NO_MEM, TAG, "Failed to allocate packet to send");
-    usbd_defer_func(do_send_async, packet, false);
+    packet_t packet = {
+        .buffer = buffer,
+        .len = len,
+        .buff_free_arg = buff_free_arg
+    };
+    ESP_RETURN_ON_FALSE(xQueueSend(s_net_obj.tx_queue, &packet, 0) == pdTRUE, ESP_ERR_NO_MEM, TAG, "Tx queue is full");
+#if CONFIG_TINYUSB_NET_TX_AGGREGATION_TIMEOUT_US > 0
+    if (uxQueueMessagesWaiting(s_net_obj.tx_queue) < CONFIG_TINYUSB_NET_NCM_TX_DATAGRAMS_PER_NTB) {
+        // Wait for more packets to be sent in the same NTB, the timer is already running if some are queued
+        esp_timer_start_once(s_net_obj.tx_aggregation_timer, CONFIG_TINYUSB_NET_TX_AGGREGATION_TIMEOUT_US);
+        return ESP_OK;
+    }
+    esp_timer_stop(s_net_obj.tx_aggregation_timer);
+#endif
+    schedule_send_queued();
     return ESP_OK;
 }
 
@@ -124,8 +173,24 @@ esp_err_t tinyusb_net_init(tinyusb_usbdev_t usb_dev, const tinyusb_net_config_t
 
     ESP_RETURN_ON_FALSE(s_net_obj.initialized == false, ESP_ERR_INVALID_STATE, TAG, "TinyUSB Net class is already initialized");
 
+    // The queue is allocated once, as packets might still be queued when re-initialized
+    if (!s_net_obj.tx_queue) {
+        s_net_obj.tx_queue = xQueueCreate(CONFIG_TINYUSB_NET_TX_QUEUE_SIZE, sizeof(packet_t));
+        ESP_RETURN_ON_FALSE(s_net_obj.tx_queue, ESP_ERR_NO_MEM, TAG, "Failed to allocate Tx queue");
+    }
+#if CONFIG_TINYUSB_NET_TX_AGGREGATION_TIMEOUT_US > 0
+    if (!s_net_obj.tx_aggregation_timer) {
+        const esp_timer_create_args_t timer_args = {
+            .callback = tx_aggregation_timer_cb,
+            .name = "tusb_net_tx",
+        };
+        ESP_RETURN_ON_ERROR(esp_timer_create(&timer_args, &s_net_obj.tx_aggregation_timer), TAG, "Failed to create Tx timer");
+    }
+#endif
+
     // the semaphore and event flags are initialized only if needed
     s_net_obj.rx_cb = cfg->on_recv_callback;
+    s_net_obj.zero_copy_rx = cfg->zero_copy_rx;
     s_net_obj.init_cb = cfg->on_init_callback;
     s_net_obj.tx_buff_free_cb = cfg->free_tx_buffer;
     s_net_obj.ctx = cfg->user_context;
@@ -145,15 +210,77 @@ esp_err_t tinyusb_net_init(tinyusb_usbdev_t usb_dev, const tinyusb_net_config_t
 //--------------------------------------------------------------------+
 // tinyusb callbacks
 //--------------------------------------------------------------------+
+static void do_recv_renew(void *ctx)
+{
+    (void) ctx;
+    tud_network_recv_renew();
+}
+
+esp_err_t tinyusb_net_recv_renew(void)
+{
+    ESP_RETURN_ON_FALSE(s_net_obj.zero_copy_rx, ESP_ERR_INVALID_STATE, TAG, "Zero copy receive is not enabled");
+    // TinyUSB receive buffer must be renewed in TinyUSB task context
+    usbd_defer_func(do_recv_renew, NULL, false);
+    return ESP_OK;
+}
+
 bool tud_network_recv_cb(const uint8_t *src, uint16_t size)
 {
+    esp_err_t ret = ESP_FAIL;
     if (s_net_obj.rx_cb) {
-        s_net_obj.rx_cb((void *)src, size, s_net_obj.ctx);
+        ret = s_net_obj.rx_cb((void *)src, size, s_net_obj.ctx);
+    }
+    if (!s_net_obj.zero_copy_rx || ret != ESP_OK) {
+        // The buffer is not kept by the user, receive the next packet into it
+        tud_network_recv_renew();
     }
-    tud_network_recv_renew();
     return true;
 }
 
+/*
+ * The network class of TinyUSB reports no transmit completion. Its driver is wrapped in an application driver,
+ * which TinyUSB opens before the built-in one, so that the Tx queue is drained again from the completion of
+ * a transfer instead of polling tud_network_can_xmit().
+ */
+static void net_driver_init(void)
+{
+    // The built-in driver initializes and resets the shared class state
+}
+
+static void net_driver_reset(uint8_t rhport)
+{
+    (void) rhport;
+    s_net_obj.tx_drain_waiting = false;
+}
+
+static bool net_driver_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes)
+{
+    bool ret = netd_xfer_cb(rhport, ep_addr, result, xferred_bytes);
+    if (s_net_obj.tx_drain_waiting) {
+        s_net_obj.tx_drain_waiting = false;
+        do_send_queued(NULL);
+    }
+    return ret;
+}
+
+static const usbd_class_driver_t s_net_driver = {
+#if CFG_TUSB_DEBUG >= 2
+    .name = "NET_TX",
+#endif
+    .init = net_driver_init,
+    .reset = net_driver_reset,
+    .open = netd_open,
+    .control_xfer_cb = netd_control_xfer_cb,
+    .xfer_cb = net_driver_xfer_cb,
+    .sof = NULL,
+};
+
+usbd_class_driver_t const *usbd_app_driver_get_cb(uint8_t *driver_count)
+{
+    *driver_count = 1;
+    return &s_net_driver;
+}
+
 uint16_t tud_network_xmit_cb(uint8_t *dst, void *ref, uint16_t arg)
 {
     packet_t *packet = ref;
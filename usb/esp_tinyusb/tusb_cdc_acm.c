@@ -10,7 +10,9 @@
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
 #include "tusb.h"
+#include "device/usbd_pvt.h"
 #include "tusb_cdc_acm.h"
 #include "cdc.h"
 #include "sdkconfig.h"
@@ -22,11 +24,27 @@ static portMUX_TYPE cdc_acm_lock = portMUX_INITIALIZER_UNLOCKED;
 #define CDC_ACM_ENTER_CRITICAL()   portENTER_CRITICAL(&cdc_acm_lock)
 #define CDC_ACM_EXIT_CRITICAL()    portEXIT_CRITICAL(&cdc_acm_lock)
 
+// Largest USB transfer of a buffer, a multiple of both Full and High speed bulk packet size
+#define CDC_ACM_TX_CHUNK_MAX ((UINT16_MAX / 512) * 512)
+
+typedef struct {
+    const uint8_t *buf;
+    size_t len;
+    tusb_cdcacm_tx_done_cb_t callback;
+    void *arg;
+} cdcacm_tx_buffer_t; /*!< Buffer of tinyusb_cdcacm_write_buffer() */
+
 typedef struct {
     tusb_cdcacm_callback_t callback_rx;
     tusb_cdcacm_callback_t callback_rx_wanted_char;
     tusb_cdcacm_callback_t callback_line_state_changed;
     tusb_cdcacm_callback_t callback_line_coding_changed;
+    QueueHandle_t tx_queue;         /*!< Buffers waiting for the data IN endpoint */
+    cdcacm_tx_buffer_t tx_current;  /*!< Buffer being sent, buf is NULL if none */
+    size_t tx_offset;               /*!< Bytes of the current buffer already sent */
+    size_t tx_chunk;                /*!< Bytes of the current buffer in the USB transfer */
+    volatile bool tx_busy;          /*!< USB transfer of the current buffer is in progress */
+    uint8_t ep_in;                  /*!< Data IN endpoint address, 0 if not looked up yet */
 } esp_tusb_cdcacm_t; /*!< CDC_ACM object */
 
 static const char *TAG = "tusb_cdc_acm";
@@ -41,9 +59,147 @@ static inline esp_tusb_cdcacm_t *get_acm(tinyusb_cdcacm_itf_t itf)
 }
 
 
+/**
+ * @brief Find the data IN endpoint of a CDC interface in the active configuration descriptor
+ */
+static uint8_t find_data_ep_in(tinyusb_cdcacm_itf_t itf)
+{
+    const tusb_desc_configuration_t *config = (const tusb_desc_configuration_t *)tud_descriptor_configuration_cb(0);
+    const uint8_t *p_desc = (const uint8_t *)config;
+    const uint8_t *end = p_desc + config->wTotalLength;
+    int data_itf = -1;
+    bool in_wanted_itf = false;
+    while (p_desc < end) {
+        if (tu_desc_type(p_desc) == TUSB_DESC_INTERFACE) {
+            const tusb_desc_interface_t *desc_itf = (const tusb_desc_interface_t *)p_desc;
+            // Alternate settings do not count as another interface
+            if (desc_itf->bInterfaceClass == TUSB_CLASS_CDC_DATA && desc_itf->bAlternateSetting == 0) {
+                data_itf++;
+            }
+            in_wanted_itf = desc_itf->bInterfaceClass == TUSB_CLASS_CDC_DATA && data_itf == itf;
+        } else if (in_wanted_itf && tu_desc_type(p_desc) == TUSB_DESC_ENDPOINT) {
+            const tusb_desc_endpoint_t *desc_ep = (const tusb_desc_endpoint_t *)p_desc;
+            if (tu_edpt_dir(desc_ep->bEndpointAddress) == TUSB_DIR_IN) {
+                return desc_ep->bEndpointAddress;
+            }
+        }
+        p_desc = tu_desc_next(p_desc);
+    }
+    return 0;
+}
+
+/**
+ * @brief Continue sending the current buffer or start the next one, if the data IN endpoint is free
+ *
+ * Runs only in the TinyUSB task. The TX state is swapped under the lock, as deinit may cancel it from another task.
+ */
+static void cdcacm_tx_start(esp_tusb_cdcacm_t *acm)
+{
+    if (acm->tx_busy || !usbd_edpt_claim(TUD_OPT_RHPORT, acm->ep_in)) {
+        // The endpoint is busy, this is called again once its transfer is completed
+        return;
+    }
+    cdcacm_tx_buffer_t next;
+    CDC_ACM_ENTER_CRITICAL();
+    const bool has_current = acm->tx_current.buf != NULL;
+    CDC_ACM_EXIT_CRITICAL();
+    if (!has_current && xQueueReceive(acm->tx_queue, &next, 0) != pdTRUE) {
+        usbd_edpt_release(TUD_OPT_RHPORT, acm->ep_in);
+        return;
+    }
+
+    CDC_ACM_ENTER_CRITICAL();
+    if (!has_current) {
+        acm->tx_current = next;
+        acm->tx_offset = 0;
+    } else if (!acm->tx_current.buf) {
+        // Cancelled in the meantime
+        CDC_ACM_EXIT_CRITICAL();
+        usbd_edpt_release(TUD_OPT_RHPORT, acm->ep_in);
+        return;
+    }
+    acm->tx_chunk = MIN(acm->tx_current.len - acm->tx_offset, CDC_ACM_TX_CHUNK_MAX);
+    acm->tx_busy = true;
+    uint8_t *data = (uint8_t *)acm->tx_current.buf + acm->tx_offset;
+    const uint16_t chunk = acm->tx_chunk;
+    CDC_ACM_EXIT_CRITICAL();
+
+    if (!usbd_edpt_xfer(TUD_OPT_RHPORT, acm->ep_in, data, chunk)) {
+        ESP_LOGE(TAG, "Failed to submit transfer");
+        acm->tx_busy = false;
+        usbd_edpt_release(TUD_OPT_RHPORT, acm->ep_in);
+    }
+}
+
+/**
+ * @brief Start sending from the TinyUSB task, param is the interface number
+ */
+static void cdcacm_tx_start_deferred(void *param)
+{
+    esp_tusb_cdcacm_t *acm = get_acm((tinyusb_cdcacm_itf_t)(intptr_t)param);
+    if (acm && acm->tx_queue && acm->ep_in) {
+        cdcacm_tx_start(acm);
+    }
+}
+
+/**
+ * @brief Return all queued buffers to their owners with an error
+ */
+static void cdcacm_tx_cancel(tinyusb_cdcacm_itf_t itf, esp_tusb_cdcacm_t *acm)
+{
+    CDC_ACM_ENTER_CRITICAL();
+    cdcacm_tx_buffer_t txb = acm->tx_current;
+    const bool busy = acm->tx_busy;
+    acm->tx_current.buf = NULL;
+    acm->tx_offset = 0;
+    acm->tx_busy = false;
+    CDC_ACM_EXIT_CRITICAL();
+    if (txb.buf) {
+        if (busy) {
+            ESP_LOGW(TAG, "Buffer transfer of CDC no.%d still in progress", itf);
+        }
+        if (txb.callback) {
+            txb.callback(itf, txb.buf, txb.len, ESP_ERR_INVALID_STATE, txb.arg);
+        }
+    }
+    while (xQueueReceive(acm->tx_queue, &txb, 0) == pdTRUE) {
+        if (txb.callback) {
+            txb.callback(itf, txb.buf, txb.len, ESP_ERR_INVALID_STATE, txb.arg);
+        }
+    }
+}
+
 /* TinyUSB callbacks
    ********************************************************************* */
 
+/* Invoked by cdc interface when the data IN endpoint transfer completed */
+void tud_cdc_tx_complete_cb(uint8_t itf)
+{
+    esp_tusb_cdcacm_t *acm = get_acm(itf);
+    if (!acm || !acm->tx_queue || !acm->ep_in) {
+        // Buffers were never sent on this interface
+        return;
+    }
+    cdcacm_tx_buffer_t done = { 0 };
+    CDC_ACM_ENTER_CRITICAL();
+    if (acm->tx_busy) {
+        // Our transfer completed, the endpoint was claimed for it
+        acm->tx_busy = false;
+        acm->tx_offset += acm->tx_chunk;
+        if (acm->tx_offset == acm->tx_current.len) {
+            done = acm->tx_current;
+            acm->tx_current.buf = NULL;
+            acm->tx_offset = 0;
+        }
+    }
+    CDC_ACM_EXIT_CRITICAL();
+    if (done.buf && done.callback) {
+        done.callback(itf, done.buf, done.len, ESP_OK, done.arg);
+    }
+    // If nothing is started here, TinyUSB flushes the TX FIFO or sends a ZLP after a buffer of a multiple of packet size
+    cdcacm_tx_start(acm);
+}
+
 /* Invoked by cdc interface when line state changed e.g connected/disconnected */
 void tud_cdc_line_state_cb(uint8_t itf, bool dtr, bool rts)
 {
@@ -242,6 +398,29 @@ size_t tinyusb_cdcacm_write_queue(tinyusb_cdcacm_itf_t itf, const uint8_t *in_bu
     return tud_cdc_n_write(itf, in_buf, MIN(in_size, size_available));
 }
 
+esp_err_t tinyusb_cdcacm_write_buffer(tinyusb_cdcacm_itf_t itf, const uint8_t *buf, size_t len,
+                                      tusb_cdcacm_tx_done_cb_t callback, void *arg)
+{
+    esp_tusb_cdcacm_t *acm = get_acm(itf);
+    ESP_RETURN_ON_FALSE(acm, ESP_ERR_INVALID_STATE, TAG, "Interface is not initialized. Use `tinyusb_cdc_init` for initialization");
+    ESP_RETURN_ON_FALSE(buf && len, ESP_ERR_INVALID_ARG, TAG, "Empty buffer");
+    ESP_RETURN_ON_FALSE(tud_mounted(), ESP_ERR_INVALID_STATE, TAG, "USB device is not mounted");
+    if (!acm->ep_in) {
+        acm->ep_in = find_data_ep_in(itf);
+        ESP_RETURN_ON_FALSE(acm->ep_in, ESP_ERR_NOT_FOUND, TAG, "Data IN endpoint of CDC no.%d not found", itf);
+    }
+    const cdcacm_tx_buffer_t txb = {
+        .buf = buf,
+        .len = len,
+        .callback = callback,
+        .arg = arg,
+    };
+    ESP_RETURN_ON_FALSE(xQueueSend(acm->tx_queue, &txb, 0) == pdTRUE, ESP_ERR_NO_MEM, TAG, "TX buffer queue is full");
+    // The TX state is owned by the TinyUSB task, which also runs the completion callback
+    usbd_defer_func(cdcacm_tx_start_deferred, (void *)(intptr_t)itf, false);
+    return ESP_OK;
+}
+
 static uint32_t tud_cdc_n_write_occupied(tinyusb_cdcacm_itf_t itf)
 {
     return CFG_TUD_CDC_TX_BUFSIZE - tud_cdc_n_write_available(itf);
@@ -286,10 +465,16 @@ static esp_err_t alloc_obj(tinyusb_cdcacm_itf_t itf)
     if (cdc_inst == NULL) {
         return ESP_FAIL;
     }
-    cdc_inst->subclass_obj = calloc(1, sizeof(esp_tusb_cdcacm_t));
-    if (cdc_inst->subclass_obj == NULL) {
+    esp_tusb_cdcacm_t *acm = calloc(1, sizeof(esp_tusb_cdcacm_t));
+    if (acm == NULL) {
         return ESP_FAIL;
     }
+    acm->tx_queue = xQueueCreate(CONFIG_TINYUSB_CDC_TX_BUFFER_QUEUE_SIZE, sizeof(cdcacm_tx_buffer_t));
+    if (acm->tx_queue == NULL) {
+        free(acm);
+        return ESP_FAIL;
+    }
+    cdc_inst->subclass_obj = acm;
     return ESP_OK;
 }
 
@@ -329,6 +514,12 @@ fail:
 
 esp_err_t tusb_cdc_acm_deinit(int itf)
 {
+    esp_tusb_cdcacm_t *acm = get_acm(itf);
+    if (acm && acm->tx_queue) {
+        cdcacm_tx_cancel(itf, acm);
+        vQueueDelete(acm->tx_queue);
+        acm->tx_queue = NULL;
+    }
     return tinyusb_cdc_deinit(itf);
 }
 
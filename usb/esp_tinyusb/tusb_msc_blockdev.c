@@ -0,0 +1,152 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_partition.h"
+#include "tusb_msc_storage.h"
+
+static const char *TAG = "tinyusb_msc_blockdev";
+
+#define PARTITION_SECTOR_SIZE   4096 // Flash erase block, every sector is erased and written at once
+#define RAMDISK_SECTOR_SIZE     512
+
+/* Raw partition, without wear levelling
+   ********************************************************************* */
+
+static esp_err_t partition_read(void *ctx, uint32_t lba, uint32_t offset, size_t size, void *dest)
+{
+    const esp_partition_t *partition = (const esp_partition_t *)ctx;
+    return esp_partition_read(partition, (size_t)lba * PARTITION_SECTOR_SIZE + offset, dest, size);
+}
+
+static esp_err_t partition_write(void *ctx, uint32_t lba, size_t size, const void *src)
+{
+    const esp_partition_t *partition = (const esp_partition_t *)ctx;
+    const size_t addr = (size_t)lba * PARTITION_SECTOR_SIZE;
+    ESP_RETURN_ON_ERROR(esp_partition_erase_range(partition, addr, size), TAG, "erase failed addr %u size %u", addr, size);
+    return esp_partition_write(partition, addr, src, size);
+}
+
+static const tinyusb_msc_blockdev_ops_t s_partition_ops = {
+    .read = partition_read,
+    .write = partition_write,
+};
+
+esp_err_t tinyusb_msc_storage_init_partition(const tinyusb_msc_partition_config_t *config)
+{
+    const esp_partition_t *partition = config->partition;
+    ESP_RETURN_ON_FALSE(partition, ESP_ERR_INVALID_ARG, TAG, "partition is required");
+    ESP_RETURN_ON_FALSE(partition->size >= PARTITION_SECTOR_SIZE && partition->size % PARTITION_SECTOR_SIZE == 0,
+                        ESP_ERR_INVALID_ARG, TAG, "partition size %lu is not a multiple of %d", partition->size, PARTITION_SECTOR_SIZE);
+    // TinyUSB passes writes in chunks of the MSC buffer, they must cover whole erase blocks
+    ESP_RETURN_ON_FALSE(CONFIG_TINYUSB_MSC_BUFSIZE % PARTITION_SECTOR_SIZE == 0, ESP_ERR_INVALID_STATE, TAG,
+                        "CONFIG_TINYUSB_MSC_BUFSIZE must be a multiple of %d", PARTITION_SECTOR_SIZE);
+
+    const tinyusb_msc_blockdev_config_t blockdev_config = {
+        .ops = &s_partition_ops,
+        .ctx = (void *)partition,
+        .sector_count = partition->size / PARTITION_SECTOR_SIZE,
+        .sector_size = PARTITION_SECTOR_SIZE,
+        .callback_mount_changed = config->callback_mount_changed,
+        .callback_premount_changed = config->callback_premount_changed,
+        .mount_config = config->mount_config,
+    };
+    return tinyusb_msc_storage_init_blockdev(&blockdev_config);
+}
+
+/* RAM disk
+   ********************************************************************* */
+
+typedef struct {
+    uint8_t *buf;           /*!< Contents of the disk */
+    uint32_t sector_size;   /*!< Size of a sector */
+    uint32_t sector_count;  /*!< Number of sectors */
+    bool is_allocated;      /*!< The buffer was allocated by the driver and is freed by deinit */
+} ramdisk_t;
+
+/* The LBA, offset and size come from the USB host, they must not reach past the end of the disk */
+static bool ramdisk_in_range(const ramdisk_t *disk, uint32_t lba, uint32_t offset, size_t size)
+{
+    if (lba >= disk->sector_count) {
+        return false;
+    }
+    const size_t remaining = (size_t)(disk->sector_count - lba) * disk->sector_size;
+    return offset <= remaining && size <= remaining - offset;
+}
+
+static esp_err_t ramdisk_read(void *ctx, uint32_t lba, uint32_t offset, size_t size, void *dest)
+{
+    const ramdisk_t *disk = (const ramdisk_t *)ctx;
+    ESP_RETURN_ON_FALSE(ramdisk_in_range(disk, lba, offset, size), ESP_ERR_INVALID_SIZE, TAG,
+                        "read of %u bytes at sector %lu + %lu is out of the RAM disk", size, lba, offset);
+    memcpy(dest, disk->buf + (size_t)lba * disk->sector_size + offset, size);
+    return ESP_OK;
+}
+
+static esp_err_t ramdisk_write(void *ctx, uint32_t lba, size_t size, const void *src)
+{
+    ramdisk_t *disk = (ramdisk_t *)ctx;
+    ESP_RETURN_ON_FALSE(ramdisk_in_range(disk, lba, 0, size), ESP_ERR_INVALID_SIZE, TAG,
+                        "write of %u bytes at sector %lu is out of the RAM disk", size, lba);
+    memcpy(disk->buf + (size_t)lba * disk->sector_size, src, size);
+    return ESP_OK;
+}
+
+static void ramdisk_deinit(void *ctx)
+{
+    ramdisk_t *disk = (ramdisk_t *)ctx;
+    if (disk->is_allocated) {
+        heap_caps_free(disk->buf);
+    }
+    free(disk);
+}
+
+static const tinyusb_msc_blockdev_ops_t s_ramdisk_ops = {
+    .read = ramdisk_read,
+    .write = ramdisk_write,
+    .deinit = ramdisk_deinit,
+};
+
+esp_err_t tinyusb_msc_storage_init_ramdisk(const tinyusb_msc_ramdisk_config_t *config)
+{
+    esp_err_t ret;
+    const uint32_t sector_size = config->sector_size ? config->sector_size : RAMDISK_SECTOR_SIZE;
+    const size_t sector_count = config->size / sector_size;
+    ESP_RETURN_ON_FALSE(sector_count > 0, ESP_ERR_INVALID_ARG, TAG, "RAM disk size %u is smaller than a sector", config->size);
+
+    ramdisk_t *disk = calloc(1, sizeof(ramdisk_t));
+    ESP_RETURN_ON_FALSE(disk, ESP_ERR_NO_MEM, TAG, "could not allocate RAM disk");
+    disk->sector_size = sector_size;
+    disk->sector_count = sector_count;
+    disk->buf = config->buffer;
+    if (!disk->buf) {
+        const uint32_t caps = config->heap_caps ? config->heap_caps : MALLOC_CAP_8BIT;
+        disk->buf = heap_caps_calloc(sector_count, sector_size, caps);
+        ESP_GOTO_ON_FALSE(disk->buf, ESP_ERR_NO_MEM, fail, TAG, "could not allocate %u bytes for RAM disk", sector_count * sector_size);
+        disk->is_allocated = true;
+    }
+
+    const tinyusb_msc_blockdev_config_t blockdev_config = {
+        .ops = &s_ramdisk_ops,
+        .ctx = disk,
+        .sector_count = sector_count,
+        .sector_size = sector_size,
+        .callback_mount_changed = config->callback_mount_changed,
+        .callback_premount_changed = config->callback_premount_changed,
+        .mount_config = config->mount_config,
+    };
+    ESP_GOTO_ON_ERROR(tinyusb_msc_storage_init_blockdev(&blockdev_config), fail, TAG, "could not register RAM disk");
+    return ESP_OK;
+
+fail:
+    ramdisk_deinit(disk);
+    return ret;
+}
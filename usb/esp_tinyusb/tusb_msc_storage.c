@@ -5,6 +5,7 @@
  */
 
 #include <string.h>
+#include <sys/param.h>
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_check.h"
@@ -21,9 +22,65 @@
 #if SOC_SDMMC_HOST_SUPPORTED
 #include "diskio_sdmmc.h"
 #endif
+#if CONFIG_TINYUSB_MSC_ASYNC_IO
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#endif
 
 static const char *TAG = "tinyusb_msc_storage";
 
+#if CONFIG_TINYUSB_MSC_SPIFLASH_CACHE
+#define SPIFLASH_CACHE_BLOCK_SIZE 4096 // Flash erase block, writing any part of it erases all of it
+
+/**
+ * @brief Cache of one flash erase block
+ *
+ * Host writes smaller than the erase block are gathered here, so that the block is erased and written once.
+ */
+typedef struct {
+    uint8_t *buf;           /*!< Contents of the cached block */
+    size_t block_addr;      /*!< Address of the cached block, relative to the beginning of the partition */
+    uint32_t valid;         /*!< Bit per sector of the block with current contents in buf, 0 if nothing is cached */
+    uint32_t dirty;         /*!< Bit per sector written by the host and not committed to flash yet */
+} spiflash_cache_t;
+#endif
+
+#if CONFIG_TINYUSB_MSC_ASYNC_IO
+#define MSC_ASYNC_BUF_COUNT 2 // One buffer is transferred over USB while the storage task works on the other
+
+typedef enum {
+    MSC_ASYNC_IDLE,         /*!< Buffer is free */
+    MSC_ASYNC_PENDING,      /*!< Buffer is queued to or processed by the storage task */
+    MSC_ASYNC_DONE,         /*!< Storage task finished the I/O of the buffer */
+} msc_async_state_t;
+
+/**
+ * @brief Buffer of one chunk of a READ10 or WRITE10 command, processed by the storage task
+ */
+typedef struct {
+    uint8_t *buf;                       /*!< Data of the chunk */
+    uint32_t lba;                       /*!< LBA of the chunk, as passed by TinyUSB */
+    uint32_t offset;                    /*!< Offset of the chunk from the LBA, as passed by TinyUSB */
+    size_t size;                        /*!< Size of the chunk */
+    bool is_write;                      /*!< Write to the storage or read from it */
+    bool discard;                       /*!< Read data is outdated by a following write */
+    volatile msc_async_state_t state;   /*!< State of the buffer */
+    esp_err_t err;                      /*!< Result of the I/O */
+} msc_async_buf_t;
+
+typedef struct {
+    TaskHandle_t task;                      /*!< Storage task performing the I/O */
+    TaskHandle_t stop_waiter;               /*!< Task waiting for the storage task to stop */
+    QueueHandle_t queue;                    /*!< Buffers to be processed, NULL stops the storage task */
+    SemaphoreHandle_t done;                 /*!< Given for every buffer processed */
+    msc_async_buf_t bufs[MSC_ASYNC_BUF_COUNT];
+    esp_err_t write_err;                    /*!< Error of a write that was already acknowledged to the host */
+} msc_async_t;
+#endif
+
 typedef struct {
     bool is_fat_mounted;
     const char *base_path;
@@ -32,9 +89,18 @@ typedef struct {
 #if SOC_SDMMC_HOST_SUPPORTED
         sdmmc_card_t *card;
 #endif
+        struct {
+            const tinyusb_msc_blockdev_ops_t *ops;
+            void *ctx;
+            uint32_t sector_count;
+            uint32_t sector_size;
+            BYTE pdrv;              /*!< Drive number while mounted locally, 0xFF otherwise */
+        } blockdev;
     };
     esp_err_t (*mount)(BYTE pdrv);
     esp_err_t (*unmount)(void);
+    esp_err_t (*flush)(void);       /*!< Optional, commits the data cached by the storage media */
+    void (*deinit)(void);           /*!< Optional, releases the storage media */
     uint32_t (*sector_count)(void);
     uint32_t (*sector_size)(void);
     esp_err_t (*read)(size_t sector_size, uint32_t lba, uint32_t offset, size_t size, void *dest);
@@ -42,6 +108,12 @@ typedef struct {
     tusb_msc_callback_t callback_mount_changed;
     tusb_msc_callback_t callback_premount_changed;
     int max_files;
+#if CONFIG_TINYUSB_MSC_SPIFLASH_CACHE
+    spiflash_cache_t cache;
+#endif
+#if CONFIG_TINYUSB_MSC_ASYNC_IO
+    msc_async_t async;
+#endif
 } tinyusb_msc_storage_handle_s; /*!< MSC object */
 
 /* handle of tinyusb driver connected to application */
@@ -114,6 +186,205 @@ static esp_err_t _write_sector_spiflash(size_t sector_size,
     return wl_write(s_storage_handle->wl_handle, addr, src, size);
 }
 
+#if CONFIG_TINYUSB_MSC_SPIFLASH_CACHE
+static inline uint32_t _cache_sector_bits(size_t sector_size, size_t offset, size_t size)
+{
+    const uint32_t first = offset / sector_size;
+    const uint32_t count = size / sector_size;
+    return ((1UL << count) - 1) << first;
+}
+
+static inline uint32_t _cache_all_bits(size_t sector_size)
+{
+    return _cache_sector_bits(sector_size, 0, SPIFLASH_CACHE_BLOCK_SIZE);
+}
+
+/**
+ * @brief Fill the sectors of the cached block that are not valid yet from flash
+ */
+static esp_err_t _cache_fill(size_t sector_size)
+{
+    spiflash_cache_t *cache = &s_storage_handle->cache;
+    for (size_t offset = 0; offset < SPIFLASH_CACHE_BLOCK_SIZE; offset += sector_size) {
+        if (!(cache->valid & _cache_sector_bits(sector_size, offset, sector_size))) {
+            ESP_RETURN_ON_ERROR(wl_read(s_storage_handle->wl_handle, cache->block_addr + offset, cache->buf + offset, sector_size),
+                                TAG, "Failed to read");
+        }
+    }
+    cache->valid = _cache_all_bits(sector_size);
+    return ESP_OK;
+}
+
+/**
+ * @brief Commit the sectors written by the host to flash, with one erase and write of the whole block
+ */
+static esp_err_t _cache_flush(void)
+{
+    spiflash_cache_t *cache = &s_storage_handle->cache;
+    if (!cache->dirty) {
+        return ESP_OK;
+    }
+    const size_t sector_size = tinyusb_msc_storage_get_sector_size();
+    ESP_RETURN_ON_ERROR(_cache_fill(sector_size), TAG, "Failed to fill cache");
+    ESP_RETURN_ON_ERROR(wl_erase_range(s_storage_handle->wl_handle, cache->block_addr, SPIFLASH_CACHE_BLOCK_SIZE),
+                        TAG, "Failed to erase");
+    ESP_RETURN_ON_ERROR(wl_write(s_storage_handle->wl_handle, cache->block_addr, cache->buf, SPIFLASH_CACHE_BLOCK_SIZE),
+                        TAG, "Failed to write");
+    cache->dirty = 0;
+    return ESP_OK;
+}
+
+static esp_err_t _read_sector_spiflash_cached(size_t sector_size,
+        uint32_t lba,
+        uint32_t offset,
+        size_t size,
+        void *dest)
+{
+    spiflash_cache_t *cache = &s_storage_handle->cache;
+    if (sector_size >= SPIFLASH_CACHE_BLOCK_SIZE) {
+        return _read_sector_spiflash(sector_size, lba, offset, size, dest);
+    }
+    size_t temp = 0;
+    size_t addr = 0; // Address of the data to be read, relative to the beginning of the partition.
+    ESP_RETURN_ON_FALSE(!__builtin_umul_overflow(lba, sector_size, &temp), ESP_ERR_INVALID_SIZE, TAG, "overflow lba %lu sector_size %u", lba, sector_size);
+    ESP_RETURN_ON_FALSE(!__builtin_uadd_overflow(temp, offset, &addr), ESP_ERR_INVALID_SIZE, TAG, "overflow addr %u offset %lu", temp, offset);
+
+    uint8_t *dest_ptr = (uint8_t *)dest;
+    while (size) {
+        const size_t block_addr = addr & ~(SPIFLASH_CACHE_BLOCK_SIZE - 1);
+        const size_t block_offset = addr - block_addr;
+        const size_t len = MIN(size, SPIFLASH_CACHE_BLOCK_SIZE - block_offset);
+        if (cache->valid && cache->block_addr == block_addr) {
+            // Sectors not written by the host are current in flash
+            ESP_RETURN_ON_ERROR(_cache_fill(sector_size), TAG, "Failed to fill cache");
+            memcpy(dest_ptr, cache->buf + block_offset, len);
+        } else if (cache->dirty) {
+            // Do not evict the written sectors just for reading
+            ESP_RETURN_ON_ERROR(wl_read(s_storage_handle->wl_handle, addr, dest_ptr, len), TAG, "Failed to read");
+        } else {
+            // Read the whole block, the following sectors are likely to be read next
+            cache->block_addr = block_addr;
+            cache->valid = 0;
+            ESP_RETURN_ON_ERROR(_cache_fill(sector_size), TAG, "Failed to fill cache");
+            memcpy(dest_ptr, cache->buf + block_offset, len);
+        }
+        addr += len;
+        dest_ptr += len;
+        size -= len;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t _write_sector_spiflash_cached(size_t sector_size,
+        size_t addr,
+        uint32_t lba,
+        uint32_t offset,
+        size_t size,
+        const void *src)
+{
+    spiflash_cache_t *cache = &s_storage_handle->cache;
+    if (sector_size >= SPIFLASH_CACHE_BLOCK_SIZE) {
+        return _write_sector_spiflash(sector_size, addr, lba, offset, size, src);
+    }
+
+    const uint8_t *src_ptr = (const uint8_t *)src;
+    while (size) {
+        const size_t block_addr = addr & ~(SPIFLASH_CACHE_BLOCK_SIZE - 1);
+        const size_t block_offset = addr - block_addr;
+        const size_t len = MIN(size, SPIFLASH_CACHE_BLOCK_SIZE - block_offset);
+        if (cache->valid && cache->block_addr != block_addr) {
+            ESP_RETURN_ON_ERROR(_cache_flush(), TAG, "Failed to flush cache");
+            cache->valid = 0;
+        }
+        cache->block_addr = block_addr;
+        memcpy(cache->buf + block_offset, src_ptr, len);
+        cache->valid |= _cache_sector_bits(sector_size, block_offset, len);
+        cache->dirty |= _cache_sector_bits(sector_size, block_offset, len);
+        if (cache->dirty == _cache_all_bits(sector_size)) {
+            // The whole block is written, nothing to wait for
+            ESP_RETURN_ON_ERROR(_cache_flush(), TAG, "Failed to flush cache");
+        }
+        addr += len;
+        src_ptr += len;
+        size -= len;
+    }
+    return ESP_OK;
+}
+#endif
+
+#if CONFIG_TINYUSB_MSC_ASYNC_IO
+/**
+ * @brief Return the buffers the storage task is done with, except for the one still to be consumed
+ */
+static void msc_async_reclaim(const msc_async_buf_t *keep)
+{
+    msc_async_t *async = &s_storage_handle->async;
+    for (int i = 0; i < MSC_ASYNC_BUF_COUNT; i++) {
+        msc_async_buf_t *abuf = &async->bufs[i];
+        if (abuf == keep || abuf->state != MSC_ASYNC_DONE) {
+            continue;
+        }
+        if (abuf->is_write && abuf->err != ESP_OK) {
+            async->write_err = abuf->err;
+        }
+        abuf->state = MSC_ASYNC_IDLE;
+    }
+}
+
+/**
+ * @brief Wait for the storage task to finish all queued I/O
+ *
+ * @return Error of a write acknowledged to the host before it was performed
+ */
+static esp_err_t msc_async_drain(void)
+{
+    msc_async_t *async = &s_storage_handle->async;
+    if (!async->task) {
+        return ESP_OK;
+    }
+    for (int i = 0; i < MSC_ASYNC_BUF_COUNT; i++) {
+        while (async->bufs[i].state == MSC_ASYNC_PENDING) {
+            xSemaphoreTake(async->done, portMAX_DELAY);
+        }
+    }
+    msc_async_reclaim(NULL);
+    const esp_err_t err = async->write_err;
+    async->write_err = ESP_OK;
+    return err;
+}
+#endif
+
+/**
+ * @brief Commit the cached writes of the host to the storage
+ */
+static esp_err_t msc_storage_flush(void)
+{
+#if CONFIG_TINYUSB_MSC_ASYNC_IO
+    ESP_RETURN_ON_ERROR(msc_async_drain(), TAG, "Deferred write failed");
+#endif
+#if CONFIG_TINYUSB_MSC_SPIFLASH_CACHE
+    if (s_storage_handle->cache.buf) {
+        return _cache_flush();
+    }
+#endif
+    if (s_storage_handle->flush) {
+        return (s_storage_handle->flush)();
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Commit the cached writes and drop the cached contents, the application is about to modify the storage
+ */
+static esp_err_t msc_storage_invalidate_cache(void)
+{
+    ESP_RETURN_ON_ERROR(msc_storage_flush(), TAG, "Failed to flush cache");
+#if CONFIG_TINYUSB_MSC_SPIFLASH_CACHE
+    s_storage_handle->cache.valid = 0;
+#endif
+    return ESP_OK;
+}
+
 #if SOC_SDMMC_HOST_SUPPORTED
 static esp_err_t _mount_sdmmc(BYTE pdrv)
 {
@@ -170,6 +441,134 @@ static esp_err_t _write_sector_sdmmc(size_t sector_size,
 }
 #endif
 
+/* FATFS disk driver of a block device, to mount it locally */
+static DSTATUS _blockdev_disk_initialize(BYTE pdrv)
+{
+    return 0;
+}
+
+static DSTATUS _blockdev_disk_status(BYTE pdrv)
+{
+    return 0;
+}
+
+static DRESULT _blockdev_disk_read(BYTE pdrv, BYTE *buff, uint32_t sector, UINT count)
+{
+    const size_t size = (size_t)count * s_storage_handle->blockdev.sector_size;
+    esp_err_t err = s_storage_handle->blockdev.ops->read(s_storage_handle->blockdev.ctx, sector, 0, size, buff);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "block device read failed (0x%x)", err);
+        return RES_ERROR;
+    }
+    return RES_OK;
+}
+
+static DRESULT _blockdev_disk_write(BYTE pdrv, const BYTE *buff, uint32_t sector, UINT count)
+{
+    const size_t size = (size_t)count * s_storage_handle->blockdev.sector_size;
+    esp_err_t err = s_storage_handle->blockdev.ops->write(s_storage_handle->blockdev.ctx, sector, size, buff);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "block device write failed (0x%x)", err);
+        return RES_ERROR;
+    }
+    return RES_OK;
+}
+
+static DRESULT _blockdev_disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+{
+    switch (cmd) {
+    case CTRL_SYNC:
+        if (s_storage_handle->blockdev.ops->flush &&
+                s_storage_handle->blockdev.ops->flush(s_storage_handle->blockdev.ctx) != ESP_OK) {
+            return RES_ERROR;
+        }
+        return RES_OK;
+    case GET_SECTOR_COUNT:
+        *((DWORD *) buff) = s_storage_handle->blockdev.sector_count;
+        return RES_OK;
+    case GET_SECTOR_SIZE:
+        *((WORD *) buff) = s_storage_handle->blockdev.sector_size;
+        return RES_OK;
+    case GET_BLOCK_SIZE:
+        *((DWORD *) buff) = 1;
+        return RES_OK;
+    }
+    return RES_ERROR;
+}
+
+static esp_err_t _mount_blockdev(BYTE pdrv)
+{
+    const uint32_t sector_size = s_storage_handle->blockdev.sector_size;
+    ESP_RETURN_ON_FALSE(sector_size >= FF_MIN_SS && sector_size <= FF_MAX_SS, ESP_ERR_NOT_SUPPORTED, TAG,
+                        "FATFS does not support sector size %lu", sector_size);
+    static const ff_diskio_impl_t blockdev_impl = {
+        .init = &_blockdev_disk_initialize,
+        .status = &_blockdev_disk_status,
+        .read = &_blockdev_disk_read,
+        .write = &_blockdev_disk_write,
+        .ioctl = &_blockdev_disk_ioctl
+    };
+    ff_diskio_register(pdrv, &blockdev_impl);
+    s_storage_handle->blockdev.pdrv = pdrv;
+    return ESP_OK;
+}
+
+static esp_err_t _unmount_blockdev(void)
+{
+    const BYTE pdrv = s_storage_handle->blockdev.pdrv;
+    if (pdrv == 0xff) {
+        ESP_LOGE(TAG, "Invalid state");
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_storage_handle->blockdev.pdrv = 0xff;
+
+    char drv[3] = {(char)('0' + pdrv), ':', 0};
+    f_mount(0, drv, 0);
+    ff_diskio_unregister(pdrv);
+
+    return ESP_OK;
+}
+
+static esp_err_t _flush_blockdev(void)
+{
+    return s_storage_handle->blockdev.ops->flush(s_storage_handle->blockdev.ctx);
+}
+
+static void _deinit_blockdev(void)
+{
+    s_storage_handle->blockdev.ops->deinit(s_storage_handle->blockdev.ctx);
+}
+
+static uint32_t _get_sector_count_blockdev(void)
+{
+    return s_storage_handle->blockdev.sector_count;
+}
+
+static uint32_t _get_sector_size_blockdev(void)
+{
+    return s_storage_handle->blockdev.sector_size;
+}
+
+static esp_err_t _read_sector_blockdev(size_t sector_size,
+                                       uint32_t lba,
+                                       uint32_t offset,
+                                       size_t size,
+                                       void *dest)
+{
+    return s_storage_handle->blockdev.ops->read(s_storage_handle->blockdev.ctx, lba, offset, size, dest);
+}
+
+static esp_err_t _write_sector_blockdev(size_t sector_size,
+                                        size_t addr,
+                                        uint32_t lba,
+                                        uint32_t offset,
+                                        size_t size,
+                                        const void *src)
+{
+    // msc_storage_write_sector() only passes whole sectors, so the offset is 0
+    return s_storage_handle->blockdev.ops->write(s_storage_handle->blockdev.ctx, lba, size, src);
+}
+
 static esp_err_t msc_storage_read_sector(uint32_t lba,
         uint32_t offset,
         size_t size,
@@ -203,6 +602,210 @@ static esp_err_t msc_storage_write_sector(uint32_t lba,
     return (s_storage_handle->write)(sector_size, addr, lba, offset, size, src);
 }
 
+#if CONFIG_TINYUSB_MSC_ASYNC_IO
+static void msc_async_task(void *arg)
+{
+    msc_async_t *async = (msc_async_t *)arg;
+    msc_async_buf_t *abuf;
+    while (xQueueReceive(async->queue, &abuf, portMAX_DELAY) == pdTRUE && abuf) {
+        if (abuf->is_write) {
+            abuf->err = msc_storage_write_sector(abuf->lba, abuf->offset, abuf->size, abuf->buf);
+        } else {
+            abuf->err = msc_storage_read_sector(abuf->lba, abuf->offset, abuf->size, abuf->buf);
+        }
+        abuf->state = MSC_ASYNC_DONE;
+        xSemaphoreGive(async->done);
+    }
+    xTaskNotifyGive(async->stop_waiter);
+    vTaskDelete(NULL);
+}
+
+static void msc_async_deinit(void)
+{
+    msc_async_t *async = &s_storage_handle->async;
+    if (async->task) {
+        msc_async_buf_t *stop = NULL;
+        async->stop_waiter = xTaskGetCurrentTaskHandle();
+        xQueueSend(async->queue, &stop, portMAX_DELAY);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        async->task = NULL;
+    }
+    if (async->queue) {
+        vQueueDelete(async->queue);
+        async->queue = NULL;
+    }
+    if (async->done) {
+        vSemaphoreDelete(async->done);
+        async->done = NULL;
+    }
+    for (int i = 0; i < MSC_ASYNC_BUF_COUNT; i++) {
+        free(async->bufs[i].buf);
+        async->bufs[i].buf = NULL;
+    }
+}
+
+static esp_err_t msc_async_init(void)
+{
+    msc_async_t *async = &s_storage_handle->async;
+    memset(async, 0, sizeof(msc_async_t));
+    for (int i = 0; i < MSC_ASYNC_BUF_COUNT; i++) {
+        async->bufs[i].buf = heap_caps_malloc(CONFIG_TINYUSB_MSC_BUFSIZE, MALLOC_CAP_DMA);
+        if (!async->bufs[i].buf) {
+            goto fail;
+        }
+    }
+    async->queue = xQueueCreate(MSC_ASYNC_BUF_COUNT + 1, sizeof(msc_async_buf_t *));
+    async->done = xSemaphoreCreateCounting(MSC_ASYNC_BUF_COUNT, 0);
+    if (!async->queue || !async->done) {
+        goto fail;
+    }
+    xTaskCreatePinnedToCore(msc_async_task, "TinyUSB MSC", CONFIG_TINYUSB_MSC_ASYNC_TASK_STACK_SIZE, async,
+                            CONFIG_TINYUSB_MSC_ASYNC_TASK_PRIORITY, &async->task, CONFIG_TINYUSB_MSC_ASYNC_TASK_AFFINITY);
+    if (!async->task) {
+        goto fail;
+    }
+    return ESP_OK;
+
+fail:
+    msc_async_deinit();
+    return ESP_ERR_NO_MEM;
+}
+
+static msc_async_buf_t *msc_async_find(uint32_t lba, uint32_t offset, size_t size)
+{
+    for (int i = 0; i < MSC_ASYNC_BUF_COUNT; i++) {
+        msc_async_buf_t *abuf = &s_storage_handle->async.bufs[i];
+        if (abuf->state != MSC_ASYNC_IDLE && !abuf->is_write && !abuf->discard &&
+                abuf->lba == lba && abuf->offset == offset && abuf->size == size) {
+            return abuf;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Queue a chunk to the storage task
+ *
+ * @return Buffer of the chunk, NULL if all buffers are busy
+ */
+static msc_async_buf_t *msc_async_submit(bool is_write, uint32_t lba, uint32_t offset, size_t size, const void *src)
+{
+    msc_async_t *async = &s_storage_handle->async;
+    for (int i = 0; i < MSC_ASYNC_BUF_COUNT; i++) {
+        msc_async_buf_t *abuf = &async->bufs[i];
+        if (abuf->state != MSC_ASYNC_IDLE) {
+            continue;
+        }
+        abuf->is_write = is_write;
+        abuf->discard = false;
+        abuf->lba = lba;
+        abuf->offset = offset;
+        abuf->size = size;
+        if (is_write) {
+            memcpy(abuf->buf, src, size);
+        }
+        abuf->state = MSC_ASYNC_PENDING;
+        // The queue holds all buffers, so this does not block
+        xQueueSend(async->queue, &abuf, 0);
+        return abuf;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Wait a little for the storage task, instead of letting TinyUSB retry the callback in a busy loop
+ */
+static void msc_async_yield(void)
+{
+    xSemaphoreTake(s_storage_handle->async.done, 1);
+}
+
+/**
+ * @brief Read the following chunks of the command into the free buffers, while the current one is sent to the host
+ */
+static void msc_async_read_ahead(uint32_t lba, uint32_t offset, size_t size)
+{
+    const uint32_t sector_size = tinyusb_msc_storage_get_sector_size();
+    const uint64_t end = (uint64_t)tinyusb_msc_storage_get_sector_count() * sector_size;
+    uint64_t addr = (uint64_t)lba * sector_size + offset;
+    for (int i = 1; i < MSC_ASYNC_BUF_COUNT + 1; i++) {
+        addr += size;
+        if (addr >= end) {
+            return;
+        }
+        size = MIN(size, end - addr);
+        // TinyUSB passes the offset within the sector
+        if (!msc_async_find(addr / sector_size, addr % sector_size, size) &&
+                !msc_async_submit(false, addr / sector_size, addr % sector_size, size, NULL)) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief READ10 chunk, the data is read by the storage task
+ *
+ * @return Size of the chunk when done, 0 to be called again, negative on error
+ */
+static int32_t msc_async_read(uint32_t lba, uint32_t offset, void *buffer, uint32_t bufsize)
+{
+    msc_async_buf_t *abuf = msc_async_find(lba, offset, bufsize);
+    // Finished writes and read-ahead chunks the host did not ask for free their buffers
+    msc_async_reclaim(abuf);
+    if (!abuf) {
+        // First chunk of the command. If all buffers are busy, it is queued in a following call.
+        if (msc_async_submit(false, lba, offset, bufsize, NULL)) {
+            msc_async_read_ahead(lba, offset, bufsize);
+        }
+        msc_async_yield();
+        return 0;
+    }
+    if (abuf->state == MSC_ASYNC_PENDING) {
+        msc_async_yield();
+        return 0;
+    }
+    const esp_err_t err = abuf->err;
+    if (err == ESP_OK) {
+        memcpy(buffer, abuf->buf, bufsize);
+    }
+    abuf->state = MSC_ASYNC_IDLE;
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "msc_storage_read_sector failed: 0x%x", err);
+        return -1;
+    }
+    msc_async_read_ahead(lba, offset, bufsize);
+    return bufsize;
+}
+
+/**
+ * @brief WRITE10 chunk, the data is copied and written by the storage task while the next chunk is received
+ *
+ * @return Size of the chunk when queued, 0 to be called again, negative on error
+ */
+static int32_t msc_async_write(uint32_t lba, uint32_t offset, const uint8_t *buffer, uint32_t bufsize)
+{
+    msc_async_t *async = &s_storage_handle->async;
+    msc_async_reclaim(NULL);
+    if (async->write_err != ESP_OK) {
+        // A write acknowledged before failed, fail the current command instead
+        ESP_LOGE(TAG, "msc_storage_write_sector failed: 0x%x", async->write_err);
+        async->write_err = ESP_OK;
+        return -1;
+    }
+    // Chunks read ahead before this write may be outdated by it
+    for (int i = 0; i < MSC_ASYNC_BUF_COUNT; i++) {
+        if (!async->bufs[i].is_write) {
+            async->bufs[i].discard = true;
+        }
+    }
+    if (!msc_async_submit(true, lba, offset, bufsize, buffer)) {
+        msc_async_yield();
+        return 0;
+    }
+    return bufsize;
+}
+#endif
+
 static esp_err_t _mount(char *drv, FATFS *fs)
 {
     void *workbuf = NULL;
@@ -222,7 +825,7 @@ static esp_err_t _mount(char *drv, FATFS *fs)
             goto fail;
         }
         size_t alloc_unit_size = esp_vfs_fat_get_allocation_unit_size(
-                                     CONFIG_WL_SECTOR_SIZE,
+                                     tinyusb_msc_storage_get_sector_size(),
                                      4096);
         ESP_LOGW(TAG, "formatting card, allocation unit size=%d", alloc_unit_size);
         const MKFS_PARM opt = {(BYTE)FM_FAT, 0, 0, 0, alloc_unit_size};
@@ -273,6 +876,10 @@ esp_err_t tinyusb_msc_storage_mount(const char *base_path)
         base_path = CONFIG_TINYUSB_MSC_MOUNT_PATH;
     }
 
+    if (msc_storage_invalidate_cache() != ESP_OK) {
+        ESP_LOGW(TAG, "Writes of the host may be lost");
+    }
+
     // connect driver to FATFS
     BYTE pdrv = 0xFF;
     ESP_RETURN_ON_ERROR(ff_diskio_get_drive(&pdrv), TAG,
@@ -344,6 +951,8 @@ esp_err_t tinyusb_msc_storage_unmount(void)
         return err;
     }
     err = esp_vfs_fat_unregister_path(s_storage_handle->base_path);
+    // The application might have modified the storage
+    msc_storage_invalidate_cache();
     s_storage_handle->base_path = NULL;
     s_storage_handle->is_fat_mounted = false;
 
@@ -384,9 +993,35 @@ esp_err_t tinyusb_msc_storage_init_spiflash(const tinyusb_msc_spiflash_config_t
     s_storage_handle->sector_size = &_get_sector_size_spiflash;
     s_storage_handle->read = &_read_sector_spiflash;
     s_storage_handle->write = &_write_sector_spiflash;
+    s_storage_handle->flush = NULL;
+    s_storage_handle->deinit = NULL;
     s_storage_handle->is_fat_mounted = false;
     s_storage_handle->base_path = NULL;
     s_storage_handle->wl_handle = config->wl_handle;
+#if CONFIG_TINYUSB_MSC_SPIFLASH_CACHE
+    s_storage_handle->cache.valid = 0;
+    s_storage_handle->cache.dirty = 0;
+    s_storage_handle->cache.buf = malloc(SPIFLASH_CACHE_BLOCK_SIZE);
+    if (!s_storage_handle->cache.buf) {
+        free(s_storage_handle);
+        s_storage_handle = NULL;
+        ESP_LOGE(TAG, "could not allocate cache for storage");
+        return ESP_ERR_NO_MEM;
+    }
+    s_storage_handle->read = &_read_sector_spiflash_cached;
+    s_storage_handle->write = &_write_sector_spiflash_cached;
+#endif
+#if CONFIG_TINYUSB_MSC_ASYNC_IO
+    if (msc_async_init() != ESP_OK) {
+#if CONFIG_TINYUSB_MSC_SPIFLASH_CACHE
+        free(s_storage_handle->cache.buf);
+#endif
+        free(s_storage_handle);
+        s_storage_handle = NULL;
+        ESP_LOGE(TAG, "could not start storage task");
+        return ESP_ERR_NO_MEM;
+    }
+#endif
     // In case the user does not set mount_config.max_files
     // and for backward compatibility with versions <1.4.2
     // max_files is set to 2
@@ -420,9 +1055,24 @@ esp_err_t tinyusb_msc_storage_init_sdmmc(const tinyusb_msc_sdmmc_config_t *confi
     s_storage_handle->sector_size = &_get_sector_size_sdmmc;
     s_storage_handle->read = &_read_sector_sdmmc;
     s_storage_handle->write = &_write_sector_sdmmc;
+    s_storage_handle->flush = NULL;
+    s_storage_handle->deinit = NULL;
     s_storage_handle->is_fat_mounted = false;
     s_storage_handle->base_path = NULL;
     s_storage_handle->card = config->card;
+#if CONFIG_TINYUSB_MSC_SPIFLASH_CACHE
+    s_storage_handle->cache.buf = NULL;
+    s_storage_handle->cache.valid = 0;
+    s_storage_handle->cache.dirty = 0;
+#endif
+#if CONFIG_TINYUSB_MSC_ASYNC_IO
+    if (msc_async_init() != ESP_OK) {
+        free(s_storage_handle);
+        s_storage_handle = NULL;
+        ESP_LOGE(TAG, "could not start storage task");
+        return ESP_ERR_NO_MEM;
+    }
+#endif
     // In case the user does not set mount_config.max_files
     // and for backward compatibility with versions <1.4.2
     // max_files is set to 2
@@ -445,9 +1095,76 @@ esp_err_t tinyusb_msc_storage_init_sdmmc(const tinyusb_msc_sdmmc_config_t *confi
 }
 #endif
 
+esp_err_t tinyusb_msc_storage_init_blockdev(const tinyusb_msc_blockdev_config_t *config)
+{
+    assert(!s_storage_handle);
+    ESP_RETURN_ON_FALSE(config->ops && config->ops->read && config->ops->write, ESP_ERR_INVALID_ARG, TAG,
+                        "block device read and write are required");
+    ESP_RETURN_ON_FALSE(config->sector_count && config->sector_size, ESP_ERR_INVALID_ARG, TAG,
+                        "block device sector count and size are required");
+    s_storage_handle = (tinyusb_msc_storage_handle_s *)malloc(sizeof(tinyusb_msc_storage_handle_s));
+    ESP_RETURN_ON_FALSE(s_storage_handle, ESP_ERR_NO_MEM, TAG, "could not allocate new handle for storage");
+    s_storage_handle->mount = &_mount_blockdev;
+    s_storage_handle->unmount = &_unmount_blockdev;
+    s_storage_handle->sector_count = &_get_sector_count_blockdev;
+    s_storage_handle->sector_size = &_get_sector_size_blockdev;
+    s_storage_handle->read = &_read_sector_blockdev;
+    s_storage_handle->write = &_write_sector_blockdev;
+    s_storage_handle->flush = config->ops->flush ? &_flush_blockdev : NULL;
+    s_storage_handle->deinit = config->ops->deinit ? &_deinit_blockdev : NULL;
+    s_storage_handle->is_fat_mounted = false;
+    s_storage_handle->base_path = NULL;
+    s_storage_handle->blockdev.ops = config->ops;
+    s_storage_handle->blockdev.ctx = config->ctx;
+    s_storage_handle->blockdev.sector_count = config->sector_count;
+    s_storage_handle->blockdev.sector_size = config->sector_size;
+    s_storage_handle->blockdev.pdrv = 0xff;
+#if CONFIG_TINYUSB_MSC_SPIFLASH_CACHE
+    s_storage_handle->cache.buf = NULL;
+    s_storage_handle->cache.valid = 0;
+    s_storage_handle->cache.dirty = 0;
+#endif
+#if CONFIG_TINYUSB_MSC_ASYNC_IO
+    if (msc_async_init() != ESP_OK) {
+        free(s_storage_handle);
+        s_storage_handle = NULL;
+        ESP_LOGE(TAG, "could not start storage task");
+        return ESP_ERR_NO_MEM;
+    }
+#endif
+    const int max_files = config->mount_config.max_files;
+    s_storage_handle->max_files = max_files > 0 ? max_files : 2;
+
+    /* Callbacks setting up*/
+    if (config->callback_mount_changed) {
+        tinyusb_msc_register_callback(TINYUSB_MSC_EVENT_MOUNT_CHANGED, config->callback_mount_changed);
+    } else {
+        tinyusb_msc_unregister_callback(TINYUSB_MSC_EVENT_MOUNT_CHANGED);
+    }
+    if (config->callback_premount_changed) {
+        tinyusb_msc_register_callback(TINYUSB_MSC_EVENT_PREMOUNT_CHANGED, config->callback_premount_changed);
+    } else {
+        tinyusb_msc_unregister_callback(TINYUSB_MSC_EVENT_PREMOUNT_CHANGED);
+    }
+
+    return ESP_OK;
+}
+
 void tinyusb_msc_storage_deinit(void)
 {
     assert(s_storage_handle);
+    if (msc_storage_flush() != ESP_OK) {
+        ESP_LOGW(TAG, "Writes of the host may be lost");
+    }
+#if CONFIG_TINYUSB_MSC_ASYNC_IO
+    msc_async_deinit();
+#endif
+#if CONFIG_TINYUSB_MSC_SPIFLASH_CACHE
+    free(s_storage_handle->cache.buf);
+#endif
+    if (s_storage_handle->deinit) {
+        (s_storage_handle->deinit)();
+    }
     free(s_storage_handle);
     s_storage_handle = NULL;
 }
@@ -500,6 +1217,9 @@ bool tinyusb_msc_storage_in_use_by_usb_host(void)
 #define SCSI_CODE_ASC_MEDIUM_NOT_PRESENT 0x3A /** SCSI ASC code for 'MEDIUM NOT PRESENT' **/
 #define SCSI_CODE_ASC_INVALID_COMMAND_OPERATION_CODE 0x20 /** SCSI ASC code for 'INVALID COMMAND OPERATION CODE' **/
 #define SCSI_CODE_ASCQ 0x00
+#define SCSI_CODE_ASC_WRITE_ERROR 0x0C /** SCSI ASC code for 'WRITE ERROR' **/
+#define SCSI_CODE_ASC_UNRECOVERED_READ_ERROR 0x11 /** SCSI ASC code for 'UNRECOVERED READ ERROR' **/
+#define SCSI_CMD_SYNCHRONIZE_CACHE_10 0x35 /** SCSI SYNCHRONIZE CACHE (10) command **/
 
 // Invoked when received SCSI_CMD_INQUIRY
 // Application fill vendor id, product id and revision with string up to 8, 16, 4 characters respectively
@@ -529,6 +1249,10 @@ bool tud_msc_test_unit_ready_cb(uint8_t lun)
         if (tinyusb_msc_storage_unmount() != ESP_OK) {
             ESP_LOGW(TAG, "tud_msc_test_unit_ready_cb() unmount Fails");
         }
+        // Hosts poll the unit while idle, so the cached writes are committed shortly after the host stops writing
+        if (msc_storage_flush() != ESP_OK) {
+            ESP_LOGW(TAG, "tud_msc_test_unit_ready_cb() flush Fails");
+        }
         result = true;
     }
     return result;
@@ -567,6 +1291,19 @@ bool tud_msc_start_stop_cb(uint8_t lun, uint8_t power_condition, bool start, boo
 // - Application fill the buffer (up to bufsize) with address contents and return number of read byte.
 int32_t tud_msc_read10_cb(uint8_t lun, uint32_t lba, uint32_t offset, void *buffer, uint32_t bufsize)
 {
+#if CONFIG_TINYUSB_MSC_ASYNC_IO
+    if (bufsize <= CONFIG_TINYUSB_MSC_BUFSIZE) {
+        int32_t ret = msc_async_read(lba, offset, buffer, bufsize);
+        if (ret < 0) {
+            tud_msc_set_sense(lun, SCSI_SENSE_MEDIUM_ERROR, SCSI_CODE_ASC_UNRECOVERED_READ_ERROR, SCSI_CODE_ASCQ);
+        }
+        return ret;
+    }
+    // Keep the order with the queued writes
+    if (msc_async_drain() != ESP_OK) {
+        ESP_LOGW(TAG, "Deferred write failed");
+    }
+#endif
     esp_err_t err = msc_storage_read_sector(lba, offset, bufsize, buffer);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "msc_storage_read_sector failed: 0x%x", err);
@@ -580,6 +1317,20 @@ int32_t tud_msc_read10_cb(uint8_t lun, uint32_t lba, uint32_t offset, void *buff
 // - Application write data from buffer to address contents (up to bufsize) and return number of written byte.
 int32_t tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *buffer, uint32_t bufsize)
 {
+#if CONFIG_TINYUSB_MSC_ASYNC_IO
+    if (bufsize <= CONFIG_TINYUSB_MSC_BUFSIZE) {
+        int32_t ret = msc_async_write(lba, offset, buffer, bufsize);
+        if (ret < 0) {
+            tud_msc_set_sense(lun, SCSI_SENSE_MEDIUM_ERROR, SCSI_CODE_ASC_WRITE_ERROR, SCSI_CODE_ASCQ);
+        }
+        return ret;
+    }
+    // Keep the order with the queued writes
+    if (msc_async_drain() != ESP_OK) {
+        tud_msc_set_sense(lun, SCSI_SENSE_MEDIUM_ERROR, SCSI_CODE_ASC_WRITE_ERROR, SCSI_CODE_ASCQ);
+        return -1;
+    }
+#endif
     esp_err_t err = msc_storage_write_sector(lba, offset, bufsize, buffer);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "msc_storage_write_sector failed: 0x%x", err);
@@ -615,6 +1366,14 @@ int32_t tud_msc_scsi_cb(uint8_t lun, uint8_t const scsi_cmd[16], void *buffer, u
         the storage media/partition. */
         ret = 0;
         break;
+    case SCSI_CMD_SYNCHRONIZE_CACHE_10:
+        if (msc_storage_flush() != ESP_OK) {
+            tud_msc_set_sense(lun, SCSI_SENSE_MEDIUM_ERROR, SCSI_CODE_ASC_WRITE_ERROR, SCSI_CODE_ASCQ);
+            ret = -1;
+        } else {
+            ret = 0;
+        }
+        break;
     default:
         ESP_LOGW(TAG, "tud_msc_scsi_cb() invoked: %d", scsi_cmd[0]);
         tud_msc_set_sense(lun, SCSI_SENSE_ILLEGAL_REQUEST, SCSI_CODE_ASC_INVALID_COMMAND_OPERATION_CODE, SCSI_CODE_ASCQ);
@@ -5,6 +5,7 @@
  */
 
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdio_ext.h>
@@ -17,6 +18,9 @@
 #include "esp_log.h"
 #include "esp_vfs.h"
 #include "esp_vfs_dev.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "tinyusb.h"
 #include "tusb_cdc_acm.h"
 #include "vfs_tinyusb.h"
@@ -52,6 +56,33 @@ const static char *TAG = "tusb_vfs";
 #   define DEFAULT_RX_MODE ESP_LINE_ENDINGS_LF
 #endif
 
+#if CONFIG_TINYUSB_VFS_TX_RINGBUF_SIZE > 0
+#define TX_RING_CHUNK_SIZE      128     // Bytes moved from the ring to CDC at once
+#define TX_RING_TASK_STACK_SIZE 2048
+#define TX_RING_WAIT_MS         10      // A blocked writer checks this often whether the host is still connected
+
+/**
+ * @brief Ring buffer of the written data
+ *
+ * Single producer (writers serialized by write_lock), single consumer (the drain task), lock-free.
+ * head and tail are free running, head - tail is the count of waiting bytes.
+ * To drop the oldest data, the producer advances tail too. The consumer copies the data out first and commits it
+ * with compare-and-swap of tail, so data dropped and overwritten meanwhile is discarded, not sent.
+ */
+typedef struct {
+    uint8_t *buf;
+    uint32_t size;                  // Power of two
+    atomic_uint_least32_t head;     // Next byte to be written
+    atomic_uint_least32_t tail;     // Oldest byte not sent yet
+    atomic_size_t dropped;          // Bytes dropped by overflows
+    SemaphoreHandle_t space;        // Given by the drain task when a writer waits for space
+    volatile bool writer_waiting;
+    TaskHandle_t task;
+    TaskHandle_t stop_waiter;
+    volatile bool stop;
+} vfs_tusb_tx_ring_t;
+#endif
+
 typedef struct {
     _lock_t write_lock;
     _lock_t read_lock;
@@ -60,6 +91,9 @@ typedef struct {
     uint32_t flags;
     char vfs_path[VFS_TUSB_MAX_PATH];
     int cdc_intf;
+#if CONFIG_TINYUSB_VFS_TX_RINGBUF_SIZE > 0
+    vfs_tusb_tx_ring_t tx_ring;
+#endif
 } vfs_tinyusb_t;
 
 static vfs_tinyusb_t s_vfstusb;
@@ -113,35 +147,210 @@ static int tusb_open(const char *path, int flags, int mode)
     return 0;
 }
 
+#if CONFIG_TINYUSB_VFS_TX_RINGBUF_SIZE > 0
+static void tx_ring_task(void *arg)
+{
+    vfs_tusb_tx_ring_t *ring = (vfs_tusb_tx_ring_t *)arg;
+    const int itf = s_vfstusb.cdc_intf;
+    uint8_t chunk[TX_RING_CHUNK_SIZE];
+    while (!ring->stop) {
+        uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        const uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        if (head == tail) {
+            tud_cdc_n_write_flush(itf);
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+        const uint32_t fifo_space = tud_cdc_n_write_available(itf);
+        if (fifo_space == 0) {
+            // Wait for the host to read
+            tud_cdc_n_write_flush(itf);
+            vTaskDelay(1);
+            continue;
+        }
+        const size_t len = MIN(MIN(head - tail, fifo_space), sizeof(chunk));
+        const uint32_t idx = tail & (ring->size - 1);
+        const size_t first = MIN(len, ring->size - idx);
+        memcpy(chunk, ring->buf + idx, first);
+        memcpy(chunk + first, ring->buf, len - first);
+        if (!atomic_compare_exchange_strong_explicit(&ring->tail, &tail, tail + len,
+                memory_order_acq_rel, memory_order_acquire)) {
+            // A writer dropped this data and might have overwritten it
+            continue;
+        }
+        if (ring->writer_waiting) {
+            ring->writer_waiting = false;
+            xSemaphoreGive(ring->space);
+        }
+        tinyusb_cdcacm_write_queue(itf, chunk, len);
+    }
+    xTaskNotifyGive(ring->stop_waiter);
+    vTaskDelete(NULL);
+}
+
+static void tx_ring_copy_in(vfs_tusb_tx_ring_t *ring, uint32_t pos, const char *data, size_t len)
+{
+    const uint32_t idx = pos & (ring->size - 1);
+    const size_t first = MIN(len, ring->size - idx);
+    memcpy(ring->buf + idx, data, first);
+    memcpy(ring->buf, data + first, len - first);
+}
+
+/**
+ * @brief Append data to the ring buffer
+ *
+ * @return Always len, the data that does not fit is dropped and counted
+ */
+static size_t tx_ring_put(const char *data, size_t len, bool all)
+{
+    (void) all; // The ring takes everything
+    vfs_tusb_tx_ring_t *ring = &s_vfstusb.tx_ring;
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+#if CONFIG_TINYUSB_VFS_TX_OVERFLOW_DROP_OLDEST
+    size_t n = len;
+    if (n > ring->size) {
+        // Only the end of the data fits
+        atomic_fetch_add(&ring->dropped, n - ring->size);
+        data += n - ring->size;
+        n = ring->size;
+    }
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    while (ring->size - (head - tail) < n) {
+        const uint32_t drop = n - (ring->size - (head - tail));
+        if (atomic_compare_exchange_weak_explicit(&ring->tail, &tail, tail + drop,
+                memory_order_acq_rel, memory_order_acquire)) {
+            atomic_fetch_add(&ring->dropped, drop);
+            break;
+        }
+        // tail was updated, the drain task freed some space meanwhile
+    }
+    tx_ring_copy_in(ring, head, data, n);
+    atomic_store_explicit(&ring->head, head + n, memory_order_release);
+#else
+    size_t stored = 0;
+    while (stored < len) {
+        const uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        const uint32_t space = ring->size - (head - tail);
+        if (space == 0) {
+            if (!tud_cdc_n_connected(s_vfstusb.cdc_intf)) {
+                // Nobody would read the data, do not block forever
+                atomic_fetch_add(&ring->dropped, len - stored);
+                break;
+            }
+            ring->writer_waiting = true;
+            xTaskNotifyGive(ring->task);
+            xSemaphoreTake(ring->space, pdMS_TO_TICKS(TX_RING_WAIT_MS));
+            continue;
+        }
+        const size_t n = MIN(space, len - stored);
+        tx_ring_copy_in(ring, head, data + stored, n);
+        head += n;
+        atomic_store_explicit(&ring->head, head, memory_order_release);
+        stored += n;
+    }
+#endif
+    return len;
+}
+
+static void tx_ring_stop(void)
+{
+    vfs_tusb_tx_ring_t *ring = &s_vfstusb.tx_ring;
+    if (ring->task) {
+        ring->stop_waiter = xTaskGetCurrentTaskHandle();
+        ring->stop = true;
+        xTaskNotifyGive(ring->task);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        ring->task = NULL;
+    }
+    if (ring->space) {
+        vSemaphoreDelete(ring->space);
+        ring->space = NULL;
+    }
+    free(ring->buf);
+    ring->buf = NULL;
+}
+
+static esp_err_t tx_ring_start(void)
+{
+    vfs_tusb_tx_ring_t *ring = &s_vfstusb.tx_ring;
+    // Round down to a power of two
+    ring->size = 1UL << (31 - __builtin_clz(CONFIG_TINYUSB_VFS_TX_RINGBUF_SIZE));
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->dropped, 0);
+    ring->writer_waiting = false;
+    ring->stop = false;
+    ring->buf = malloc(ring->size);
+    ring->space = xSemaphoreCreateBinary();
+    if (!ring->buf || !ring->space ||
+            xTaskCreate(tx_ring_task, "tusb_vfs_tx", TX_RING_TASK_STACK_SIZE, ring,
+                        CONFIG_TINYUSB_VFS_TX_TASK_PRIORITY, &ring->task) != pdPASS) {
+        ring->task = NULL;
+        tx_ring_stop();
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+#else
+/**
+ * @brief Queue data to the CDC TX FIFO
+ *
+ * @param all Queue either all of the data or nothing
+ * @return Bytes queued
+ */
+static size_t tx_fifo_put(const char *data, size_t len, bool all)
+{
+    if (all && tud_cdc_n_write_available(s_vfstusb.cdc_intf) < len) {
+        return 0;
+    }
+    return tinyusb_cdcacm_write_queue(s_vfstusb.cdc_intf, (const uint8_t *)data, len);
+}
+#endif
+
 static ssize_t tusb_write(int fd, const void *data, size_t size)
 {
     FD_CHECK(fd, -1);
     size_t written_sz = 0;
     const char *data_c = (const char *)data;
+#if CONFIG_TINYUSB_VFS_TX_RINGBUF_SIZE > 0
+    size_t (*put)(const char *data, size_t len, bool all) = tx_ring_put;
+#else
+    size_t (*put)(const char *data, size_t len, bool all) = tx_fifo_put;
+#endif
+    const char *line_ending;
+    switch (s_vfstusb.tx_mode) {
+    case ESP_LINE_ENDINGS_CRLF:
+        line_ending = "\r\n";
+        break;
+    case ESP_LINE_ENDINGS_CR:
+        line_ending = "\r";
+        break;
+    default:
+        line_ending = "\n";
+        break;
+    }
+    const size_t line_ending_len = strlen(line_ending);
+
     _lock_acquire(&(s_vfstusb.write_lock));
-    for (size_t i = 0; i < size; i++) {
-        int c = data_c[i];
-        if (c != '\n') {
-            if (!tinyusb_cdcacm_write_queue_char(s_vfstusb.cdc_intf, c)) {
-                break; // can't write anymore
-            }
-        } else {
-            if (s_vfstusb.tx_mode == ESP_LINE_ENDINGS_CRLF || s_vfstusb.tx_mode == ESP_LINE_ENDINGS_CR) {
-                char cr = '\r';
-                if (!tinyusb_cdcacm_write_queue_char(s_vfstusb.cdc_intf, cr)) {
-                    break; // can't write anymore
-                }
-            }
-            if (s_vfstusb.tx_mode == ESP_LINE_ENDINGS_CRLF || s_vfstusb.tx_mode == ESP_LINE_ENDINGS_LF) {
-                char lf = '\n';
-                if (!tinyusb_cdcacm_write_queue_char(s_vfstusb.cdc_intf, lf)) {
-                    break; // can't write anymore
-                }
-            }
+    while (written_sz < size) {
+        // Data up to the next newline is written at once
+        const char *newline = memchr(data_c + written_sz, '\n', size - written_sz);
+        const size_t run = (newline ? (size_t)(newline - data_c) : size) - written_sz;
+        const size_t queued = put(data_c + written_sz, run, false);
+        written_sz += queued;
+        if (queued < run || !newline) {
+            break; // can't write anymore or all written
+        }
+        if (!put(line_ending, line_ending_len, true)) {
+            break; // can't write anymore
         }
         written_sz++;
     }
+#if CONFIG_TINYUSB_VFS_TX_RINGBUF_SIZE > 0
+    xTaskNotifyGive(s_vfstusb.tx_ring.task);
+#else
     tud_cdc_n_write_flush(s_vfstusb.cdc_intf);
+#endif
     _lock_release(&(s_vfstusb.write_lock));
     return written_sz;
 }
@@ -248,6 +457,9 @@ esp_err_t esp_vfs_tusb_cdc_unregister(char const *path)
         ESP_LOGE(TAG, "Can't unregister CDC-VFS driver from '%s' (err: 0x%x)", s_vfstusb.vfs_path, res);
     } else {
         ESP_LOGD(TAG, "Unregistered CDC-VFS driver");
+#if CONFIG_TINYUSB_VFS_TX_RINGBUF_SIZE > 0
+        tx_ring_stop();
+#endif
         vfstusb_deinit();
     }
     return res;
@@ -266,6 +478,13 @@ esp_err_t esp_vfs_tusb_cdc_register(int cdc_intf, char const *path)
     if (res != ESP_OK) {
         return res;
     }
+#if CONFIG_TINYUSB_VFS_TX_RINGBUF_SIZE > 0
+    res = tx_ring_start();
+    if (res != ESP_OK) {
+        ESP_LOGE(TAG, "Can't allocate TX ring buffer");
+        return res;
+    }
+#endif
 
     esp_vfs_t vfs = {
         .flags = ESP_VFS_FLAG_DEFAULT,
@@ -280,12 +499,24 @@ esp_err_t esp_vfs_tusb_cdc_register(int cdc_intf, char const *path)
     res = esp_vfs_register(s_vfstusb.vfs_path, &vfs, NULL);
     if (res != ESP_OK) {
         ESP_LOGE(TAG, "Can't register CDC-VFS driver (err: %x)", res);
+#if CONFIG_TINYUSB_VFS_TX_RINGBUF_SIZE > 0
+        tx_ring_stop();
+#endif
     } else {
         ESP_LOGD(TAG, "CDC-VFS registered (%s)", s_vfstusb.vfs_path);
     }
     return res;
 }
 
+size_t esp_vfs_tusb_cdc_get_tx_dropped(void)
+{
+#if CONFIG_TINYUSB_VFS_TX_RINGBUF_SIZE > 0
+    return atomic_load(&s_vfstusb.tx_ring.dropped);
+#else
+    return 0;
+#endif
+}
+
 void esp_vfs_tusb_cdc_set_rx_line_endings(esp_line_endings_t mode)
 {
     _lock_acquire(&(s_vfstusb.read_lock));
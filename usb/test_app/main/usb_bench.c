@@ -0,0 +1,722 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_idf_version.h"
+#include "esp_timer.h"
+#include "soc/soc_caps.h"
+#include "unity.h"
+
+#if SOC_USB_OTG_SUPPORTED
+#include "esp_private/usb_phy.h"
+#include "usb/usb_host.h"
+#include "usb/cdc_acm_host.h"
+#include "usb/msc_host.h"
+#include "usb/usb_host_daemon.h"
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#include "tinyusb.h"
+#include "tusb_cdc_acm.h"
+#endif
+
+/*
+ * Paired USB throughput benchmark
+ *
+ * One board runs a mock device, the other one runs the host drivers against it:
+ *
+ *   [usb_bench_cdc_device] Dual CDC-ACM device: interface 0 sinks all received data, interface 2 sends data
+ *                          while DTR is set. A PC host can be used instead of the host board
+ *   [usb_bench_cdc]        usb_host_cdc_acm: TX to the sink and RX from the source, with the driver's own task
+ *                          (class=cdc) and from usb_host_daemon, on its client (class=cdc_daemon) or polled
+ *                          every poll_period_ms (class=cdc_polled)
+ *   [usb_msc_device]       MSC mock device of usb_host_msc tests
+ *   [usb_bench_msc]        usb_host_msc: asynchronous sector reads and writes, with and without the pipelined mode
+ *
+ * Every measurement prints one line, parsed by pytest_usb_host.py and pytest_usb_device.py:
+ *
+ *   USB_BENCH class=<c> dir=<rx|tx|sink|source> size=<n> inflight=<n> bytes=<n> us=<n> kBps=<n> transfers=<n>
+ *             lat_avg_us=<n> lat_max_us=<n> errors=<n> cpu0=<%> [cpu1=<%>]
+ *
+ * size:     Bytes per transfer
+ * inflight: Transfers submitted at once
+ * lat_*:    From submission to completion of a transfer, for RX the interval between completed IN transfers
+ * cpu<n>:   Load of the core during the measurement, from the time left to idle spinning tasks
+ */
+
+#define BENCH_DURATION_US       (1000 * 1000)   // Duration of every measurement
+#define BENCH_WARMUP_MS         100             // Streaming before a RX measurement starts
+#define BENCH_MAX_INFLIGHT      4
+#define BENCH_CDC_VID           0x303A
+#define BENCH_CDC_PID           0x4002
+#define BENCH_CDC_SINK_ITF      0       // Interface index of the first CDC function
+#define BENCH_CDC_SOURCE_ITF    2       // Interface index of the second CDC function
+#define BENCH_MSC_WINDOW        64      // Sectors read and written back by the MSC measurements
+
+static const size_t bench_cdc_sizes[] = { 64, 512, 4096, 16384 };
+static const size_t bench_msc_sectors[] = { 1, 8, 16 };
+static const size_t bench_inflight[] = { 1, 2, BENCH_MAX_INFLIGHT };
+
+#define BENCH_LEN(array) (sizeof(array) / sizeof((array)[0]))
+
+/* ------------------------------- CPU load --------------------------------- */
+
+static struct {
+    volatile uint32_t count[portNUM_PROCESSORS];
+    volatile bool stop;
+    SemaphoreHandle_t done;
+    uint32_t idle_per_ms[portNUM_PROCESSORS];   // Count of a core running nothing else
+} s_load;
+
+static void load_spin_task(void *arg)
+{
+    volatile uint32_t *count = arg;
+    while (!s_load.stop) {
+        (*count)++;
+    }
+    xSemaphoreGive(s_load.done);
+    vTaskDelete(NULL);
+}
+
+static void load_start(void)
+{
+    s_load.stop = false;
+    s_load.done = xSemaphoreCreateCounting(portNUM_PROCESSORS, 0);
+    TEST_ASSERT_NOT_NULL(s_load.done);
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        s_load.count[core] = 0;
+        TEST_ASSERT_EQUAL(pdTRUE, xTaskCreatePinnedToCore(load_spin_task, "bench_load", 2048, (void *)&s_load.count[core],
+                          tskIDLE_PRIORITY, NULL, core));
+    }
+}
+
+static void load_stop(uint32_t counts[portNUM_PROCESSORS])
+{
+    s_load.stop = true;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        xSemaphoreTake(s_load.done, portMAX_DELAY);
+    }
+    vSemaphoreDelete(s_load.done);
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        counts[core] = s_load.count[core];
+    }
+}
+
+/* Measure the spinning rate of idle cores, the USB stack must be installed but quiet */
+static void load_calibrate(void)
+{
+    uint32_t counts[portNUM_PROCESSORS];
+    const int64_t start = esp_timer_get_time();
+    load_start();
+    vTaskDelay(pdMS_TO_TICKS(100));
+    load_stop(counts);
+    const int64_t us = esp_timer_get_time() - start;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        s_load.idle_per_ms[core] = (uint64_t)counts[core] * 1000 / us;
+    }
+}
+
+/* Turn the counts of a measurement of 'us' into the load of the cores in percent */
+static void load_percent(const uint32_t counts[portNUM_PROCESSORS], int64_t us, uint32_t load[portNUM_PROCESSORS])
+{
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        const uint64_t idle = (uint64_t)s_load.idle_per_ms[core] * us / 1000;
+        const uint64_t spun = MIN((uint64_t)counts[core] * 100, idle * 100);
+        load[core] = idle ? 100 - spun / idle : 0;
+    }
+}
+
+/* ------------------------------- Results ---------------------------------- */
+
+typedef struct {
+    uint64_t bytes;
+    uint32_t transfers;
+    uint32_t errors;
+    uint64_t lat_total_us;
+    uint32_t lat_max_us;
+} bench_stats_t;
+
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Account one completed transfer, called from the tasks of the drivers */
+static void stats_add(bench_stats_t *stats, size_t bytes, bool ok, int64_t lat_us)
+{
+    portENTER_CRITICAL_SAFE(&s_stats_lock);
+    if (ok) {
+        stats->bytes += bytes;
+        stats->transfers++;
+    } else {
+        stats->errors++;
+    }
+    if (lat_us >= 0) {
+        stats->lat_total_us += lat_us;
+        stats->lat_max_us = MAX(stats->lat_max_us, (uint32_t)lat_us);
+    }
+    portEXIT_CRITICAL_SAFE(&s_stats_lock);
+}
+
+static void stats_get(bench_stats_t *stats, bench_stats_t *copy)
+{
+    portENTER_CRITICAL_SAFE(&s_stats_lock);
+    *copy = *stats;
+    portEXIT_CRITICAL_SAFE(&s_stats_lock);
+}
+
+/* load is NULL when the cores were not monitored during the measurement */
+static void bench_print(const char *class, const char *dir, size_t size, size_t inflight, const bench_stats_t *stats,
+                        int64_t us, const uint32_t *load)
+{
+    printf("USB_BENCH class=%s dir=%s size=%u inflight=%u bytes=%" PRIu64 " us=%" PRId64 " kBps=%" PRIu64
+           " transfers=%" PRIu32 " lat_avg_us=%" PRIu64 " lat_max_us=%" PRIu32 " errors=%" PRIu32,
+           class, dir, (unsigned)size, (unsigned)inflight, stats->bytes, us, us ? stats->bytes * 1000 / us : 0,
+           stats->transfers, stats->transfers ? stats->lat_total_us / stats->transfers : 0, stats->lat_max_us,
+           stats->errors);
+    for (int core = 0; load && core < portNUM_PROCESSORS; core++) {
+        printf(" cpu%d=%" PRIu32, core, load[core]);
+    }
+    printf("\n");
+}
+
+/* ------------------------------- USB Host --------------------------------- */
+
+static SemaphoreHandle_t s_host_done;
+
+static void bench_usb_lib_task(void *arg)
+{
+    usb_phy_handle_t phy_hdl = NULL;
+    // Initialize the internal USB PHY to connect to the USB OTG peripheral. We manually install the USB PHY for testing
+    const usb_phy_config_t phy_config = {
+        .controller = USB_PHY_CTRL_OTG,
+        .target = USB_PHY_TARGET_INT,
+        .otg_mode = USB_OTG_MODE_HOST,
+        .otg_speed = USB_PHY_SPEED_UNDEFINED,   //In Host mode, the speed is determined by the connected device
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, usb_new_phy(&phy_config, &phy_hdl));
+    const usb_host_config_t host_config = {
+        .skip_phy_setup = true,
+        .intr_flags = ESP_INTR_FLAG_LEVEL1,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_install(&host_config));
+    xTaskNotifyGive(arg);
+
+    bool all_clients_gone = false;
+    bool all_dev_free = false;
+    while (!all_clients_gone || !all_dev_free) {
+        uint32_t event_flags;
+        usb_host_lib_handle_events(portMAX_DELAY, &event_flags);
+        if (event_flags & USB_HOST_LIB_EVENT_FLAGS_NO_CLIENTS) {
+            usb_host_device_free_all();
+            all_clients_gone = true;
+        }
+        if (event_flags & USB_HOST_LIB_EVENT_FLAGS_ALL_FREE) {
+            all_dev_free = true;
+        }
+    }
+
+    vTaskDelay(10); // Short delay to allow clients clean-up
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_uninstall());
+    TEST_ASSERT_EQUAL(ESP_OK, usb_del_phy(phy_hdl));
+    xSemaphoreGive(s_host_done);
+    vTaskDelete(NULL);
+}
+
+static void bench_host_install(void)
+{
+    s_host_done = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(s_host_done);
+    TEST_ASSERT_EQUAL(pdTRUE, xTaskCreatePinnedToCore(bench_usb_lib_task, "usb_lib", 4096, xTaskGetCurrentTaskHandle(), 10, NULL, 0));
+    ulTaskNotifyTake(false, 1000);
+}
+
+/* Wait for the USB Host Library to be uninstalled, once the class driver is */
+static void bench_host_wait_uninstalled(void)
+{
+    xSemaphoreTake(s_host_done, portMAX_DELAY);
+    vSemaphoreDelete(s_host_done);
+    vTaskDelay(10); // Wait for FreeRTOS to clean up deleted tasks
+}
+
+static usb_phy_handle_t s_daemon_phy_hdl;
+
+/* USB Host Library installed and handled by usb_host_daemon, at the priority of bench_usb_lib_task() */
+static void bench_daemon_install(void)
+{
+    const usb_phy_config_t phy_config = {
+        .controller = USB_PHY_CTRL_OTG,
+        .target = USB_PHY_TARGET_INT,
+        .otg_mode = USB_OTG_MODE_HOST,
+        .otg_speed = USB_PHY_SPEED_UNDEFINED,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, usb_new_phy(&phy_config, &s_daemon_phy_hdl));
+    const usb_host_config_t host_config = {
+        .skip_phy_setup = true,
+        .intr_flags = ESP_INTR_FLAG_LEVEL1,
+    };
+    usb_host_daemon_config_t daemon_config = USB_HOST_DAEMON_CONFIG_DEFAULT();
+    daemon_config.host_config = &host_config;
+    daemon_config.task_priority = 10;
+    daemon_config.task_core_id = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_install(&daemon_config));
+}
+
+static void bench_daemon_uninstall(void)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_uninstall());
+    TEST_ASSERT_EQUAL(ESP_OK, usb_del_phy(s_daemon_phy_hdl));
+    vTaskDelay(10); // Wait for FreeRTOS to clean up deleted tasks
+}
+
+/* State of the measurement in progress, shared with the callbacks */
+static struct {
+    bench_stats_t stats;
+    volatile bool running;
+    int64_t last_us;                            // Completion of the previous IN transfer
+    int64_t submit_us[BENCH_MAX_INFLIGHT];      // Submission of the transfers in flight, by sequence number
+    size_t len;                                 // Bytes of every transfer
+    SemaphoreHandle_t slots;                    // Transfers which can be submitted
+} s_bench;
+
+static void bench_reset(size_t len)
+{
+    memset(&s_bench.stats, 0, sizeof(s_bench.stats));
+    s_bench.last_us = 0;
+    s_bench.len = len;
+}
+
+/* Completion of the transfer with the sequence number 'seq', submitted when a slot was free */
+static void bench_complete(uint32_t seq, bool ok)
+{
+    stats_add(&s_bench.stats, s_bench.len, ok, esp_timer_get_time() - s_bench.submit_us[seq % BENCH_MAX_INFLIGHT]);
+    xSemaphoreGive(s_bench.slots);
+}
+
+/* Keep 'inflight' transfers submitted by 'submit' until the measurement is over and all of them completed */
+static void bench_run_submitted(const char *class, const char *dir, size_t inflight, size_t min_transfers,
+                                void (*submit)(uint32_t seq, void *ctx), void *ctx)
+{
+    s_bench.slots = xSemaphoreCreateCounting(inflight, inflight);
+    TEST_ASSERT_NOT_NULL(s_bench.slots);
+    uint32_t counts[portNUM_PROCESSORS];
+    uint32_t load[portNUM_PROCESSORS];
+
+    load_start();
+    const int64_t start = esp_timer_get_time();
+    const int64_t end = start + BENCH_DURATION_US;
+    uint32_t seq = 0;
+    while (esp_timer_get_time() < end || seq < min_transfers) {
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(s_bench.slots, pdMS_TO_TICKS(5000)));
+        s_bench.submit_us[seq % BENCH_MAX_INFLIGHT] = esp_timer_get_time();
+        submit(seq, ctx);
+        seq++;
+    }
+    for (int i = 0; i < inflight; i++) {
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(s_bench.slots, pdMS_TO_TICKS(5000)));
+    }
+    const int64_t us = esp_timer_get_time() - start;
+    load_stop(counts);
+    load_percent(counts, us, load);
+    vSemaphoreDelete(s_bench.slots);
+
+    bench_stats_t stats;
+    stats_get(&s_bench.stats, &stats);
+    bench_print(class, dir, s_bench.len, inflight, &stats, us, load);
+    TEST_ASSERT_EQUAL(0, stats.errors);
+}
+
+/* ------------------------------- CDC-ACM Host ----------------------------- */
+
+static bool bench_cdc_rx_cb(const uint8_t *data, size_t data_len, void *arg)
+{
+    const int64_t now = esp_timer_get_time();
+    if (s_bench.running) {
+        stats_add(&s_bench.stats, data_len, true, s_bench.last_us ? now - s_bench.last_us : -1);
+        s_bench.last_us = now;
+    }
+    return true;
+}
+
+static void bench_cdc_tx_done(cdc_acm_dev_hdl_t cdc_hdl, esp_err_t result, void *arg)
+{
+    bench_complete((uintptr_t)arg, result == ESP_OK);
+}
+
+static void bench_cdc_tx_submit(uint32_t seq, void *ctx)
+{
+    cdc_acm_dev_hdl_t cdc_dev = ctx;
+    static const uint8_t data[16384];
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_data_tx_async(cdc_dev, data, s_bench.len, bench_cdc_tx_done, (void *)(uintptr_t)seq, 1000));
+}
+
+/* Host to device, the bench device discards the data */
+static void bench_cdc_tx(const char *class, size_t size, size_t inflight)
+{
+    cdc_acm_dev_hdl_t cdc_dev = NULL;
+    const cdc_acm_host_device_config_t dev_config = {
+        .connection_timeout_ms = 5000,
+        .out_buffer_size = size,
+        .out_transfer_count = inflight,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_open(BENCH_CDC_VID, BENCH_CDC_PID, BENCH_CDC_SINK_ITF, &dev_config, &cdc_dev));
+    // DTR marks the measurement for the device, which prints its side of it when DTR is cleared
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_set_control_line_state(cdc_dev, true, false));
+    bench_reset(size);
+    bench_run_submitted(class, "tx", inflight, 0, bench_cdc_tx_submit, cdc_dev);
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_set_control_line_state(cdc_dev, false, false));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_close(cdc_dev));
+}
+
+/* Device to host, the bench device streams data while DTR is set */
+static void bench_cdc_rx(const char *class, size_t size, size_t inflight)
+{
+    cdc_acm_dev_hdl_t cdc_dev = NULL;
+    const cdc_acm_host_device_config_t dev_config = {
+        .connection_timeout_ms = 5000,
+        .in_buffer_size = size,
+        .in_transfer_count = inflight,
+        .data_cb = bench_cdc_rx_cb,
+    };
+    uint32_t counts[portNUM_PROCESSORS];
+    uint32_t load[portNUM_PROCESSORS];
+    bench_stats_t stats;
+
+    s_bench.running = false;
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_open(BENCH_CDC_VID, BENCH_CDC_PID, BENCH_CDC_SOURCE_ITF, &dev_config, &cdc_dev));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_set_control_line_state(cdc_dev, true, false));
+    vTaskDelay(pdMS_TO_TICKS(BENCH_WARMUP_MS));
+
+    bench_reset(size);
+    load_start();
+    const int64_t start = esp_timer_get_time();
+    s_bench.running = true;
+    vTaskDelay(pdMS_TO_TICKS(BENCH_DURATION_US / 1000));
+    s_bench.running = false;
+    const int64_t us = esp_timer_get_time() - start;
+    load_stop(counts);
+    load_percent(counts, us, load);
+    stats_get(&s_bench.stats, &stats);
+
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_set_control_line_state(cdc_dev, false, false));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_close(cdc_dev));
+    bench_print(class, "rx", size, inflight, &stats, us, load);
+    TEST_ASSERT_GREATER_THAN(0, stats.bytes);
+}
+
+static void bench_cdc_all(const char *class)
+{
+    for (int i = 0; i < BENCH_LEN(bench_cdc_sizes); i++) {
+        for (int j = 0; j < BENCH_LEN(bench_inflight); j++) {
+            bench_cdc_tx(class, bench_cdc_sizes[i], bench_inflight[j]);
+            bench_cdc_rx(class, bench_cdc_sizes[i], bench_inflight[j]);
+        }
+    }
+}
+
+TEST_CASE("cdc", "[usb_bench_cdc]")
+{
+    bench_host_install();
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_install(NULL));
+    load_calibrate();
+
+    bench_cdc_all("cdc");
+
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_uninstall());
+    bench_host_wait_uninstalled();
+}
+
+/* The driver uses the client of the daemon, whose task blocks until the events arrive */
+TEST_CASE("cdc_daemon", "[usb_bench_cdc]")
+{
+    load_calibrate();
+    bench_daemon_install();
+    const cdc_acm_host_driver_config_t driver_config = {
+        .client_hdl = usb_host_daemon_get_client(),
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_install(&driver_config));
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_add_driver(cdc_acm_host_handle_client_event, NULL));
+
+    bench_cdc_all("cdc_daemon");
+
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_remove_driver(cdc_acm_host_handle_client_event, NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_uninstall());
+    bench_daemon_uninstall();
+}
+
+static esp_err_t bench_cdc_handle_events(void *arg, uint32_t timeout_ms)
+{
+    return cdc_acm_host_handle_events(timeout_ms);
+}
+
+/* The driver keeps its client, polled by the daemon in turn with the daemon client */
+TEST_CASE("cdc_polled", "[usb_bench_cdc]")
+{
+    load_calibrate();
+    bench_daemon_install();
+    const cdc_acm_host_driver_config_t driver_config = {
+        .driver_task_stack_size = 0,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_install(&driver_config));
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_add_client(bench_cdc_handle_events, NULL));
+
+    bench_cdc_all("cdc_polled");
+
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_remove_client(bench_cdc_handle_events, NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_uninstall());
+    bench_daemon_uninstall();
+}
+
+/* ------------------------------- MSC Host --------------------------------- */
+
+typedef struct {
+    msc_host_device_handle_t device;
+    bool write;
+    uint8_t *window;            // Content of the first BENCH_MSC_WINDOW sectors
+    size_t sector_size;
+    size_t sectors;             // Per transfer
+} bench_msc_ctx_t;
+
+static void bench_msc_io_done(msc_host_device_handle_t device, esp_err_t result, void *arg)
+{
+    bench_complete((uintptr_t)arg, result == ESP_OK);
+}
+
+/* Transfer 'seq' goes to the next chunk of the window, so that the transfers in flight don't share a buffer */
+static void bench_msc_submit(uint32_t seq, void *ctx)
+{
+    const bench_msc_ctx_t *msc = ctx;
+    const size_t sector = (seq % (BENCH_MSC_WINDOW / msc->sectors)) * msc->sectors;
+    uint8_t *data = msc->window + sector * msc->sector_size;
+    const size_t size = msc->sectors * msc->sector_size;
+    if (msc->write) {
+        TEST_ASSERT_EQUAL(ESP_OK, msc_host_write_sector_async(msc->device, sector, data, size, bench_msc_io_done, (void *)(uintptr_t)seq));
+    } else {
+        TEST_ASSERT_EQUAL(ESP_OK, msc_host_read_sector_async(msc->device, sector, data, size, bench_msc_io_done, (void *)(uintptr_t)seq));
+    }
+}
+
+static void bench_msc_event_cb(const msc_host_event_t *event, void *arg)
+{
+    xQueueSend((QueueHandle_t)arg, event, 10);
+}
+
+static void bench_msc(const char *class, size_t pipeline_depth)
+{
+    QueueHandle_t events = xQueueCreate(5, sizeof(msc_host_event_t));
+    TEST_ASSERT_NOT_NULL(events);
+    bench_host_install();
+    const msc_host_driver_config_t msc_config = {
+        .create_backround_task = true,
+        .task_priority = 5,
+        .stack_size = 4096,
+        .callback = bench_msc_event_cb,
+        .callback_arg = events,
+        .pipeline_depth = pipeline_depth,
+        .pipeline_transfer_size = 4096,
+        .async_queue_size = BENCH_MAX_INFLIGHT,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, msc_host_install(&msc_config));
+
+    msc_host_event_t event;
+    TEST_ASSERT_EQUAL(pdTRUE, xQueueReceive(events, &event, pdMS_TO_TICKS(5000)));
+    TEST_ASSERT_EQUAL(MSC_DEVICE_CONNECTED, event.event);
+    bench_msc_ctx_t msc = { 0 };
+    TEST_ASSERT_EQUAL(ESP_OK, msc_host_install_device(event.device.address, &msc.device));
+    msc_host_device_info_t info;
+    TEST_ASSERT_EQUAL(ESP_OK, msc_host_get_device_info(msc.device, &info));
+    TEST_ASSERT_GREATER_OR_EQUAL(BENCH_MSC_WINDOW, info.sector_count);
+    msc.sector_size = info.sector_size;
+    msc.window = heap_caps_malloc(BENCH_MSC_WINDOW * msc.sector_size, MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(msc.window);
+    load_calibrate();
+
+    // Reads fill the window with the content of the sectors, which the writes of the same size put back unchanged
+    for (int i = 0; i < BENCH_LEN(bench_msc_sectors); i++) {
+        for (int j = 0; j < BENCH_LEN(bench_inflight); j++) {
+            msc.sectors = bench_msc_sectors[i];
+            const size_t chunks = BENCH_MSC_WINDOW / msc.sectors;
+            TEST_ASSERT_GREATER_OR_EQUAL(bench_inflight[j], chunks);
+            bench_reset(msc.sectors * msc.sector_size);
+            msc.write = false;
+            bench_run_submitted(class, "rx", bench_inflight[j], chunks, bench_msc_submit, &msc);
+            bench_reset(msc.sectors * msc.sector_size);
+            msc.write = true;
+            bench_run_submitted(class, "tx", bench_inflight[j], chunks, bench_msc_submit, &msc);
+        }
+    }
+
+    free(msc.window);
+    TEST_ASSERT_EQUAL(ESP_OK, msc_host_uninstall_device(msc.device));
+    TEST_ASSERT_EQUAL(ESP_OK, msc_host_uninstall());
+    bench_host_wait_uninstalled();
+    vQueueDelete(events);
+}
+
+TEST_CASE("msc", "[usb_bench_msc]")
+{
+    bench_msc("msc", 0);
+}
+
+TEST_CASE("msc_pipelined", "[usb_bench_msc]")
+{
+    bench_msc("msc_pipelined", 2);
+}
+
+/* ------------------------------- CDC-ACM Device --------------------------- */
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#define BENCH_SOURCE_BUF_SIZE   4096
+#define BENCH_SOURCE_BUFS       CONFIG_TINYUSB_CDC_TX_BUFFER_QUEUE_SIZE
+
+static const tusb_desc_device_t bench_device_descriptor = {
+    .bLength = sizeof(bench_device_descriptor),
+    .bDescriptorType = TUSB_DESC_DEVICE,
+    .bcdUSB = 0x0200,
+    .bDeviceClass = TUSB_CLASS_MISC,
+    .bDeviceSubClass = MISC_SUBCLASS_COMMON,
+    .bDeviceProtocol = MISC_PROTOCOL_IAD,
+    .bMaxPacketSize0 = CFG_TUD_ENDPOINT0_SIZE,
+    .idVendor = BENCH_CDC_VID,
+    .idProduct = BENCH_CDC_PID,
+    .bcdDevice = 0x0100,
+    .iManufacturer = 0x01,
+    .iProduct = 0x02,
+    .iSerialNumber = 0x03,
+    .bNumConfigurations = 0x01
+};
+
+static const uint16_t bench_desc_config_len = TUD_CONFIG_DESC_LEN + 2 * TUD_CDC_DESC_LEN;
+static const uint8_t bench_desc_configuration[] = {
+    TUD_CONFIG_DESCRIPTOR(1, 4, 0, bench_desc_config_len, TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP, 100),
+    TUD_CDC_DESCRIPTOR(BENCH_CDC_SINK_ITF, 4, 0x81, 8, 0x02, 0x82, 64),
+    TUD_CDC_DESCRIPTOR(BENCH_CDC_SOURCE_ITF, 4, 0x83, 8, 0x04, 0x84, 64),
+};
+
+/* All callbacks run in the TinyUSB task, the device state needs no lock */
+static struct {
+    bool active[2];                 // DTR of the interface
+    int64_t start_us[2];
+    int64_t last_rx_us;
+    bench_stats_t stats[2];
+    int load_owner;                 // Interface whose measurement monitors the cores, -1 if none
+    uint8_t rx_buf[CONFIG_TINYUSB_CDC_RX_BUFSIZE];
+    uint8_t tx_bufs[BENCH_SOURCE_BUFS][BENCH_SOURCE_BUF_SIZE];
+    bool tx_busy[BENCH_SOURCE_BUFS];
+    int64_t tx_submit_us[BENCH_SOURCE_BUFS];
+} s_dev = { .load_owner = -1 };
+
+static void bench_dev_source_submit(int buf);
+
+static void bench_dev_source_done(int itf, const uint8_t *buf, size_t len, esp_err_t result, void *arg)
+{
+    const int i = (intptr_t)arg;
+    s_dev.tx_busy[i] = false;
+    if (s_dev.active[TINYUSB_CDC_ACM_1]) {
+        stats_add(&s_dev.stats[TINYUSB_CDC_ACM_1], len, result == ESP_OK, esp_timer_get_time() - s_dev.tx_submit_us[i]);
+        bench_dev_source_submit(i);
+    }
+}
+
+static void bench_dev_source_submit(int i)
+{
+    s_dev.tx_submit_us[i] = esp_timer_get_time();
+    s_dev.tx_busy[i] = tinyusb_cdcacm_write_buffer(TINYUSB_CDC_ACM_1, s_dev.tx_bufs[i], BENCH_SOURCE_BUF_SIZE,
+                                                   bench_dev_source_done, (void *)(intptr_t)i) == ESP_OK;
+}
+
+static void bench_dev_rx(int itf, cdcacm_event_t *event)
+{
+    size_t rx_size = 0;
+    ESP_ERROR_CHECK(tinyusb_cdcacm_read(itf, s_dev.rx_buf, sizeof(s_dev.rx_buf), &rx_size));
+    if (itf == TINYUSB_CDC_ACM_0 && s_dev.active[itf]) {
+        const int64_t now = esp_timer_get_time();
+        stats_add(&s_dev.stats[itf], rx_size, true, s_dev.last_rx_us ? now - s_dev.last_rx_us : -1);
+        s_dev.last_rx_us = now;
+    }
+}
+
+static void bench_dev_line_state(int itf, cdcacm_event_t *event)
+{
+    const bool dtr = event->line_state_changed_data.dtr;
+    if (dtr == s_dev.active[itf]) {
+        return;
+    }
+    if (dtr) {
+        memset(&s_dev.stats[itf], 0, sizeof(s_dev.stats[itf]));
+        s_dev.last_rx_us = 0;
+        if (s_dev.load_owner < 0) {
+            s_dev.load_owner = itf;
+            load_start();
+        }
+        s_dev.start_us[itf] = esp_timer_get_time();
+        s_dev.active[itf] = true;
+        for (int i = 0; itf == TINYUSB_CDC_ACM_1 && i < BENCH_SOURCE_BUFS; i++) {
+            if (!s_dev.tx_busy[i]) {
+                bench_dev_source_submit(i);
+            }
+        }
+        return;
+    }
+
+    s_dev.active[itf] = false;
+    const int64_t us = esp_timer_get_time() - s_dev.start_us[itf];
+    uint32_t counts[portNUM_PROCESSORS];
+    uint32_t load[portNUM_PROCESSORS];
+    const bool load_measured = s_dev.load_owner == itf;
+    if (load_measured) {
+        s_dev.load_owner = -1;
+        load_stop(counts);
+        load_percent(counts, us, load);
+    }
+    if (itf == TINYUSB_CDC_ACM_0) {
+        bench_print("cdc_device", "sink", CONFIG_TINYUSB_CDC_RX_BUFSIZE, 1, &s_dev.stats[itf], us,
+                    load_measured ? load : NULL);
+    } else {
+        bench_print("cdc_device", "source", BENCH_SOURCE_BUF_SIZE, BENCH_SOURCE_BUFS, &s_dev.stats[itf], us,
+                    load_measured ? load : NULL);
+    }
+}
+
+/**
+ * @brief Bench device, for [usb_bench_cdc] or a PC host
+ *
+ * Interface 0 discards everything it receives. Interface 2 sends BENCH_SOURCE_BUFS buffers at once, without copying
+ * them, as long as DTR is set. The device prints its side of a measurement when DTR is cleared.
+ */
+TEST_CASE("cdc_device", "[usb_bench_cdc_device][ignore]")
+{
+    // Before the USB device starts, while the cores are idle
+    load_calibrate();
+    for (int i = 0; i < BENCH_SOURCE_BUFS; i++) {
+        memset(s_dev.tx_bufs[i], 'a' + i, BENCH_SOURCE_BUF_SIZE);
+    }
+
+    const tinyusb_config_t tusb_cfg = {
+        .external_phy = false,
+        .device_descriptor = &bench_device_descriptor,
+        .configuration_descriptor = bench_desc_configuration,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, tinyusb_driver_install(&tusb_cfg));
+
+    tinyusb_config_cdcacm_t acm_cfg = {
+        .usb_dev = TINYUSB_USBDEV_0,
+        .cdc_port = TINYUSB_CDC_ACM_0,
+        .callback_rx = bench_dev_rx,
+        .callback_line_state_changed = bench_dev_line_state,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, tusb_cdc_acm_init(&acm_cfg));
+    acm_cfg.cdc_port = TINYUSB_CDC_ACM_1;
+    TEST_ASSERT_EQUAL(ESP_OK, tusb_cdc_acm_init(&acm_cfg));
+
+    printf("USB initialization DONE\n");
+}
+#endif /* ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0) */
+
+#endif /* SOC_USB_OTG_SUPPORTED */
@@ -1,11 +1,12 @@
-# SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+# SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: CC0-1.0
 
+import logging
 from typing import Tuple
 
 import pytest
 from pytest_embedded_idf.dut import IdfDut
-from time import sleep
+from time import monotonic, sleep
 from serial import Serial
 from serial.tools.list_ports import comports
 
@@ -75,3 +76,57 @@ def test_usb_device(dut) -> None:
             assert b'text\n' in res
 
             return
+
+
+# Chunk sizes written to and read from the bench device, and duration of every measurement
+BENCH_CHUNK_SIZES = [64, 512, 4096, 16384]
+BENCH_DURATION_S = 1.0
+
+
+@pytest.mark.esp32s2
+@pytest.mark.esp32s3
+@pytest.mark.usb_device
+@pytest.mark.parametrize('build_dir', ['build_bench'], indirect=True)
+def test_usb_device_bench(dut) -> None:
+    '''
+    Throughput benchmark of the esp_tinyusb CDC-ACM device with the PC as USB host, see main/usb_bench.c
+
+    The PC writes to the sink interface and reads from the source interface, which streams while the port is open.
+    The DUT prints its side of every measurement, with its CPU load, when the port is closed.
+    '''
+    dut.expect_exact('Press ENTER to see the list of tests.')
+    dut.write('[usb_bench_cdc_device]')
+    dut.expect_exact('USB initialization DONE')
+    sleep(2)  # Some time for the OS to enumerate our USB device
+
+    # The sink is the first CDC function of the device, the source the second one
+    ports = sorted((p for p in comports() if '303A:4002' in p.hwid), key=lambda p: p.location or p.device)
+    if len(ports) != 2:
+        raise Exception('TinyUSB COM port not found')
+    sink, source = ports[0].device, ports[1].device
+
+    for size in BENCH_CHUNK_SIZES:
+        data = bytes(size)
+        with Serial(sink, write_timeout=5) as cdc:
+            start = monotonic()
+            written = 0
+            while monotonic() - start < BENCH_DURATION_S:
+                written += cdc.write(data)
+            cdc.flush()
+            elapsed = monotonic() - start
+        device = dut.expect(r'USB_BENCH class=cdc_device dir=sink .*bytes=(\d+) .*kBps=(\d+)')
+        logging.info('PC TX %6d B chunks: %8d kB/s, device received %s kB/s', size, written / elapsed / 1000,
+                     device[2].decode())
+        # Data still buffered by the OS when the port is closed are not counted by the device
+        assert int(device[1].decode()) > 0
+
+        with Serial(source, timeout=1) as cdc:
+            start = monotonic()
+            received = 0
+            while monotonic() - start < BENCH_DURATION_S:
+                received += len(cdc.read(size))
+            elapsed = monotonic() - start
+        device = dut.expect(r'USB_BENCH class=cdc_device dir=source .*kBps=(\d+)')
+        logging.info('PC RX %6d B chunks: %8d kB/s, device sent %s kB/s', size, received / elapsed / 1000,
+                     device[1].decode())
+        assert received > 0
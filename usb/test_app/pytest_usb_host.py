@@ -1,11 +1,31 @@
-# SPDX-FileCopyrightText: 2022-2023 Espressif Systems (Shanghai) CO LTD
+# SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: CC0-1.0
 
+import logging
+import re
 from typing import Tuple
 
 import pytest
 from pytest_embedded_idf.dut import IdfDut
 
+# Printed by main/usb_bench.c for every measurement
+BENCH_LINE = re.compile(r'USB_BENCH ((?:\w+=\S+ ?)+)\r?$', re.MULTILINE)
+
+
+def read_bench_results(dut: IdfDut) -> list:
+    with open(dut.logfile, errors='replace') as f:
+        log = f.read()
+    return [dict(item.split('=') for item in match.group(1).split()) for match in BENCH_LINE.finditer(log)]
+
+
+def log_bench_results(results: list) -> None:
+    logging.info('%-14s %-6s %6s %8s %8s %10s %10s %s', 'class', 'dir', 'size', 'inflight', 'kB/s',
+                 'lat_avg_us', 'lat_max_us', 'cpu %')
+    for r in results:
+        cpu = ' '.join(value for key, value in sorted(r.items()) if key.startswith('cpu'))
+        logging.info('%-14s %-6s %6s %8s %8s %10s %10s %s', r['class'], r['dir'], r['size'], r['inflight'], r['kBps'],
+                     r['lat_avg_us'], r['lat_max_us'], cpu)
+
 
 @pytest.mark.esp32s2
 @pytest.mark.esp32s3
@@ -51,3 +71,40 @@ def test_usb_host(dut: Tuple[IdfDut, IdfDut]) -> None:
 
     # 3.4 Run HID tests
     host.run_all_single_board_cases(group='hid_host')
+
+
+@pytest.mark.esp32s2
+@pytest.mark.esp32s3
+@pytest.mark.usb_host
+@pytest.mark.parametrize('count, build_dir', [
+    (2, 'build_bench'),
+], indirect=True)
+def test_usb_host_bench(dut: Tuple[IdfDut, IdfDut]) -> None:
+    '''
+    Throughput benchmark of the USB Host class drivers against esp_tinyusb devices, see main/usb_bench.c
+
+    Every measurement is logged, the throughput is not compared against any limit.
+    Runs the bench configuration of sdkconfig.ci.bench, built in build_bench.
+    '''
+    device = dut[0]
+    host = dut[1]
+
+    # 1. CDC-ACM: host TX to the sink and RX from the source of the bench device
+    device.expect_exact('Press ENTER to see the list of tests.')
+    device.write('[usb_bench_cdc_device]')
+    device.expect_exact('USB initialization DONE')
+    host.run_all_single_board_cases(group='usb_bench_cdc', timeout=300)
+
+    # 2. MSC: asynchronous sector reads and writes
+    device.serial.hard_reset()
+    device.expect_exact('Press ENTER to see the list of tests.')
+    device.write('[usb_msc_device]')
+    device.expect_exact('USB initialization DONE')
+    host.run_all_single_board_cases(group='usb_bench_msc', timeout=300)
+
+    host_results = read_bench_results(host)
+    assert host_results, 'No benchmark results'
+    assert all(int(r['kBps']) > 0 for r in host_results)
+    log_bench_results(host_results)
+    # Device side of the CDC measurements, printed when the host clears DTR
+    log_bench_results(read_bench_results(device))
@@ -8,15 +8,19 @@
 #include "inttypes.h"
 #include <stdio.h>
 #include <string.h>
+#include <sys/param.h>
 #include <sys/queue.h>
 #include "usb/usb_host.h"
 #include "usb/cdc_acm_host.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "freertos/ringbuf.h"
 #include "freertos/event_groups.h"
 #include "esp_check.h"
 #include "esp_system.h"
+#include "esp_timer.h"
 
 static const char *TAG = "cdc_acm";
 
@@ -55,10 +59,13 @@ static portMUX_TYPE cdc_acm_lock = portMUX_INITIALIZER_UNLOCKED;
 // CDC-ACM driver object
 typedef struct {
     usb_host_client_handle_t cdc_acm_client_hdl;        /*!< USB Host handle reused for all CDC-ACM devices in the system */
-    SemaphoreHandle_t open_close_mutex;
+    SemaphoreHandle_t open_close_mutex;                 /*!< Protects traversal of cdc_devices_list and removal of devices from it */
+    int open_in_progress;                               /*!< Number of cdc_acm_host_open() calls in progress, protected by the CDC-ACM spinlock */
     EventGroupHandle_t event_group;
     cdc_acm_new_dev_callback_t new_dev_cb;
     SLIST_HEAD(list_dev, cdc_dev_s) cdc_devices_list;   /*!< List of open pseudo devices */
+    bool client_task;                                   /*!< Client events are handled by the driver's task, otherwise by cdc_acm_host_handle_events() */
+    bool shared_client;                                 /*!< cdc_acm_client_hdl is registered by the application, its events are passed to cdc_acm_host_handle_client_event() */
 } cdc_acm_obj_t;
 
 static cdc_acm_obj_t *p_cdc_acm_obj = NULL;
@@ -116,18 +123,51 @@ typedef struct {
     } bmCapabilities;
 } __attribute__((packed)) cdc_acm_acm_desc_t;
 
+#define CDC_ACM_TX_CALLBACKS_MAX 8 // Maximum number of coalesced writes in one OUT transfer
+
 typedef struct cdc_dev_s cdc_dev_t;
+
+/**
+ * @brief OUT transfer of asynchronous transmit
+ */
+typedef struct {
+    usb_transfer_t *xfer;                 // OUT data transfer
+    cdc_dev_t *cdc_dev;                   // Device of the transfer
+    size_t cb_count;                      // Number of writes in the transfer
+    struct {
+        cdc_acm_tx_done_callback_t cb;    // User's callback of the write, can be NULL
+        void *arg;                        // User's argument of the callback
+    } cbs[CDC_ACM_TX_CALLBACKS_MAX];
+} cdc_acm_tx_slot_t;
+
 struct cdc_dev_s {
     usb_device_handle_t dev_hdl;          // USB device handle
     void *cb_arg;                         // Common argument for user's callbacks (data IN and Notification)
     struct {
         usb_transfer_t *out_xfer;         // OUT data transfer
-        usb_transfer_t *in_xfer;          // IN data transfer
+        usb_transfer_t **in_xfers;        // IN data transfers, all of them are in flight while the device is polled
+        size_t in_xfer_count;             // Number of IN data transfers
+        usb_transfer_t *in_held;          // IN transfer with data not processed by the user, only with multiple IN transfers
+        size_t in_held_len;               // Length of not processed data in in_held
         cdc_acm_data_callback_t in_cb;    // User's callback for async (non-blocking) data IN
         uint16_t in_mps;                  // IN endpoint Maximum Packet Size
-        uint8_t *in_data_buffer_base;     // Pointer to IN data buffer in usb_transfer_t
+        uint8_t *in_data_buffer_base;     // Pointer to IN data buffer in usb_transfer_t, only with a single IN transfer
         const usb_intf_desc_t *intf_desc; // Pointer to data interface descriptor
         SemaphoreHandle_t out_mux;        // OUT mutex
+        cdc_acm_tx_slot_t *out_slots;     // OUT transfers of asynchronous transmit
+        size_t out_slot_count;            // Number of asynchronous OUT transfers
+        QueueHandle_t out_free;           // Asynchronous OUT transfers that are not used
+        SemaphoreHandle_t out_async_mux;  // Mutex of out_pending and out_in_flight
+        cdc_acm_tx_slot_t *out_pending;   // Transfer collecting coalesced writes, submitted when no transfer is in flight
+        size_t out_in_flight;             // Number of asynchronous OUT transfers in flight
+        bool out_coalescing;              // Coalescing of asynchronous writes is enabled
+        RingbufHandle_t rx_ring;          // RX ring buffer read by cdc_acm_host_read(), NULL if data are passed to in_cb
+        size_t rx_reserved;               // Space of the RX ring buffer reserved for IN transfers in flight
+        size_t rx_high_water;             // Fill level of the RX ring buffer that triggers CDC_ACM_HOST_RX_HIGH_WATER
+        bool rx_high_water_reported;      // CDC_ACM_HOST_RX_HIGH_WATER was reported since the fill level was below rx_high_water
+        usb_transfer_t **rx_held;         // IN transfers waiting for space in the RX ring buffer
+        size_t rx_held_count;             // Number of transfers in rx_held
+        const uint8_t *rx_acquired;       // Data of the RX ring buffer borrowed by cdc_acm_host_read_acquire(), NULL if none
     } data;
 
     struct {
@@ -139,6 +179,18 @@ struct cdc_dev_s {
     usb_transfer_t *ctrl_transfer;        // CTRL (endpoint 0) transfer
     SemaphoreHandle_t ctrl_mux;           // CTRL mutex
     cdc_acm_uart_state_t serial_state;    // Serial State
+    struct {
+        cdc_acm_host_stats_t counters;    // Statistics of the device, the averages are computed by cdc_acm_host_get_stats()
+        uint64_t rx_cb_total_us;          // Sum of the data RX callback durations
+        uint32_t rx_cb_count;             // Number of data RX callback calls
+        uint64_t tx_wait_total_us;        // Sum of the waits in cdc_acm_host_data_tx_blocking()
+        uint32_t tx_wait_count;           // Number of cdc_acm_host_data_tx_blocking() calls
+    } stats;                              // Structure with statistics, protected by the CDC-ACM spinlock
+    struct {
+        TaskHandle_t task;                // Task processing IN data and notification transfers of this device, NULL if they are processed in the driver's task
+        QueueHandle_t queue;              // Completed transfers waiting for the task, NULL terminates the task
+        SemaphoreHandle_t done;           // Given by the task before it exits
+    } event;                              // Structure with the device's event task
     cdc_comm_protocol_t comm_protocol;
     cdc_data_protocol_t data_protocol;
     int             num_cdc_intf_desc;    // Number of CDC Interface descriptors in following array
@@ -164,6 +216,15 @@ static void notif_xfer_cb(usb_transfer_t *transfer);
  */
 static void in_xfer_cb(usb_transfer_t *transfer);
 
+/**
+ * @brief Completed IN transfer callback of a device with its own event task
+ *
+ * Passes the transfer to the device's task, which calls notif_xfer_cb() or in_xfer_cb()
+ *
+ * @param[in] transfer Transfer that triggered the callback
+ */
+static void deferred_xfer_cb(usb_transfer_t *transfer);
+
 /**
  * @brief Data send callback
  *
@@ -173,6 +234,23 @@ static void in_xfer_cb(usb_transfer_t *transfer);
  */
 static void out_xfer_cb(usb_transfer_t *transfer);
 
+/**
+ * @brief Asynchronous data send callback
+ *
+ * Calls the user's callbacks of the transfer and submits the transfer with coalesced writes, if there is one
+ *
+ * @param[in] transfer Transfer that triggered the callback
+ */
+static void out_async_xfer_cb(usb_transfer_t *transfer);
+
+/**
+ * @brief Call the user's callbacks of an asynchronous transfer and return the transfer to the free ones
+ *
+ * @param[in] slot   Transfer that is done
+ * @param[in] result Result passed to the callbacks
+ */
+static void cdc_acm_tx_slot_done(cdc_acm_tx_slot_t *slot, esp_err_t result);
+
 /**
  * @brief USB Host Client event callback
  *
@@ -211,13 +289,70 @@ static esp_err_t send_cdc_request(cdc_dev_t *cdc_dev, bool in_transfer, cdc_requ
  */
 static void cdc_acm_reset_in_transfer(cdc_dev_t *cdc_dev)
 {
-    assert(cdc_dev->data.in_xfer);
-    usb_transfer_t *transfer = cdc_dev->data.in_xfer;
+    assert(cdc_dev->data.in_xfers);
+    usb_transfer_t *transfer = cdc_dev->data.in_xfers[0];
     uint8_t **ptr = (uint8_t **)(&(transfer->data_buffer));
     *ptr = cdc_dev->data.in_data_buffer_base;
     transfer->num_bytes = transfer->data_buffer_size;
 }
 
+/**
+ * @brief Add a duration to a latency histogram
+ *
+ * @param[inout] histogram Histogram of CDC_ACM_STATS_HISTOGRAM_BINS bins
+ * @param[in]    us        Duration in [us]
+ */
+static void cdc_acm_stats_histogram_add(uint32_t *histogram, uint32_t us)
+{
+    int bin = 0;
+    while (bin < CDC_ACM_STATS_HISTOGRAM_BINS - 1 && us >= ((uint32_t)CDC_ACM_STATS_HISTOGRAM_BASE_US << bin)) {
+        bin++;
+    }
+    histogram[bin]++;
+}
+
+/**
+ * @brief Pass received data to the user's data callback and measure its duration
+ *
+ * @param[in] cdc_dev  Pointer to CDC device
+ * @param[in] data     Received data
+ * @param[in] data_len Length of received data
+ * @return Return value of the user's callback
+ */
+static bool cdc_acm_call_in_cb(cdc_dev_t *cdc_dev, const uint8_t *data, size_t data_len)
+{
+    const int64_t start = esp_timer_get_time();
+    const bool data_processed = cdc_dev->data.in_cb(data, data_len, cdc_dev->cb_arg);
+    const uint32_t us = (uint32_t)(esp_timer_get_time() - start);
+
+    CDC_ACM_ENTER_CRITICAL();
+    cdc_acm_host_stats_t *counters = &cdc_dev->stats.counters;
+    counters->rx_cb_max_us = MAX(counters->rx_cb_max_us, us);
+    cdc_acm_stats_histogram_add(counters->rx_cb_histogram, us);
+    cdc_dev->stats.rx_cb_total_us += us;
+    cdc_dev->stats.rx_cb_count++;
+    CDC_ACM_EXIT_CRITICAL();
+    return data_processed;
+}
+
+/**
+ * @brief Count a finished OUT transfer
+ *
+ * @param[in] cdc_dev Pointer to CDC device
+ * @param[in] len     Number of bytes sent, 0 if the transfer failed
+ */
+static void cdc_acm_stats_tx(cdc_dev_t *cdc_dev, size_t len)
+{
+    CDC_ACM_ENTER_CRITICAL();
+    if (len) {
+        cdc_dev->stats.counters.tx_bytes += len;
+        cdc_dev->stats.counters.tx_transfers++;
+    } else {
+        cdc_dev->stats.counters.tx_errors++;
+    }
+    CDC_ACM_EXIT_CRITICAL();
+}
+
 /**
  * @brief CDC-ACM driver handling task
  *
@@ -290,9 +425,15 @@ static esp_err_t cdc_acm_start(cdc_dev_t *cdc_dev, cdc_acm_host_dev_callback_t e
 
     // Claim data interface and start polling its IN endpoint
     ESP_GOTO_ON_ERROR(usb_host_interface_claim(p_cdc_acm_obj->cdc_acm_client_hdl, cdc_dev->dev_hdl, cdc_dev->data.intf_desc->bInterfaceNumber, 0), err, TAG,);
-    if (cdc_dev->data.in_xfer) {
-        ESP_LOGD("CDC_ACM", "Submitting poll for BULK IN transfer");
-        ESP_ERROR_CHECK(usb_host_transfer_submit(cdc_dev->data.in_xfer));
+    if (cdc_dev->data.in_xfers) {
+        ESP_LOGD("CDC_ACM", "Submitting poll for BULK IN transfers");
+        if (cdc_dev->data.rx_ring) {
+            // Checked in cdc_acm_rx_ring_create() that the ring buffer fits all transfers
+            cdc_dev->data.rx_reserved = cdc_dev->data.in_xfer_count * cdc_dev->data.in_xfers[0]->data_buffer_size;
+        }
+        for (size_t i = 0; i < cdc_dev->data.in_xfer_count; i++) {
+            ESP_ERROR_CHECK(usb_host_transfer_submit(cdc_dev->data.in_xfers[i]));
+        }
     }
 
     // If notification are supported, claim its interface and start polling its IN endpoint
@@ -320,6 +461,7 @@ err:
 }
 
 static void cdc_acm_transfers_free(cdc_dev_t *cdc_dev);
+static void cdc_acm_event_task_stop(cdc_dev_t *cdc_dev);
 /**
  * @brief Helper function that releases resources claimed by CDC device
  *
@@ -331,7 +473,14 @@ static void cdc_acm_transfers_free(cdc_dev_t *cdc_dev);
 static void cdc_acm_device_remove(cdc_dev_t *cdc_dev)
 {
     assert(cdc_dev);
+    cdc_acm_event_task_stop(cdc_dev);
     cdc_acm_transfers_free(cdc_dev);
+    if (cdc_dev->event.queue) {
+        vQueueDelete(cdc_dev->event.queue);
+    }
+    if (cdc_dev->event.done) {
+        vSemaphoreDelete(cdc_dev->event.done);
+    }
     free(cdc_dev->cdc_intf_desc);
     // We don't check the error code of usb_host_device_close, as the close might fail, if someone else is still using the device (not all interfaces are released)
     usb_host_device_close(p_cdc_acm_obj->cdc_acm_client_hdl, cdc_dev->dev_hdl); // Gracefully continue on error
@@ -365,15 +514,18 @@ static esp_err_t cdc_acm_find_and_open_usb_device(uint16_t vid, uint16_t pid, in
     // First, check list of already opened CDC devices
     ESP_LOGD(TAG, "Checking list of opened USB devices");
     cdc_dev_t *cdc_dev;
+    xSemaphoreTake(p_cdc_acm_obj->open_close_mutex, portMAX_DELAY);
     SLIST_FOREACH(cdc_dev, &p_cdc_acm_obj->cdc_devices_list, list_entry) {
         const usb_device_desc_t *device_desc;
         ESP_ERROR_CHECK(usb_host_get_device_descriptor(cdc_dev->dev_hdl, &device_desc));
         if (device_desc->idVendor == vid && device_desc->idProduct == pid) {
             // Return path 1:
             (*dev)->dev_hdl = cdc_dev->dev_hdl;
+            xSemaphoreGive(p_cdc_acm_obj->open_close_mutex);
             return ESP_OK;
         }
     }
+    xSemaphoreGive(p_cdc_acm_obj->open_close_mutex);
 
     // Second, poll connected devices until new device is connected or timeout
     TickType_t timeout_ticks = (timeout_ms == 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
@@ -427,24 +579,30 @@ esp_err_t cdc_acm_host_install(const cdc_acm_host_driver_config_t *driver_config
     EventGroupHandle_t event_group = xEventGroupCreate();
     SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
     TaskHandle_t driver_task_h = NULL;
-    xTaskCreatePinnedToCore(
-        cdc_acm_client_task, "USB-CDC", driver_config->driver_task_stack_size, NULL,
-        driver_config->driver_task_priority, &driver_task_h, driver_config->xCoreID);
+    const bool shared_client = driver_config->client_hdl != NULL;
+    const bool client_task = !shared_client && driver_config->driver_task_stack_size != 0;
+    if (client_task) {
+        xTaskCreatePinnedToCore(
+            cdc_acm_client_task, "USB-CDC", driver_config->driver_task_stack_size, NULL,
+            driver_config->driver_task_priority, &driver_task_h, driver_config->xCoreID);
+    }
 
-    if (cdc_acm_obj == NULL || driver_task_h == NULL || event_group == NULL || mutex == NULL) {
+    if (cdc_acm_obj == NULL || (client_task && driver_task_h == NULL) || event_group == NULL || mutex == NULL) {
         ret = ESP_ERR_NO_MEM;
         goto err;
     }
 
-    // Register USB Host client
-    usb_host_client_handle_t usb_client = NULL;
-    const usb_host_client_config_t client_config = {
-        .is_synchronous = false,
-        .max_num_event_msg = 3,
-        .async.client_event_callback = usb_event_cb,
-        .async.callback_arg = NULL
-    };
-    ESP_GOTO_ON_ERROR(usb_host_client_register(&client_config, &usb_client), err, TAG, "Failed to register USB host client");
+    // Register USB Host client, unless the driver uses the client of the application
+    usb_host_client_handle_t usb_client = driver_config->client_hdl;
+    if (!shared_client) {
+        const usb_host_client_config_t client_config = {
+            .is_synchronous = false,
+            .max_num_event_msg = 3,
+            .async.client_event_callback = usb_event_cb,
+            .async.callback_arg = NULL
+        };
+        ESP_GOTO_ON_ERROR(usb_host_client_register(&client_config, &usb_client), err, TAG, "Failed to register USB host client");
+    }
 
     // Initialize CDC-ACM driver structure
     SLIST_INIT(&(cdc_acm_obj->cdc_devices_list));
@@ -452,6 +610,8 @@ esp_err_t cdc_acm_host_install(const cdc_acm_host_driver_config_t *driver_config
     cdc_acm_obj->open_close_mutex = mutex;
     cdc_acm_obj->cdc_acm_client_hdl = usb_client;
     cdc_acm_obj->new_dev_cb = driver_config->new_dev_cb;
+    cdc_acm_obj->client_task = client_task;
+    cdc_acm_obj->shared_client = shared_client;
 
     // Between 1st call of this function and following section, another task might try to install this driver:
     // Make sure that there is only one instance of this driver in the system
@@ -467,11 +627,15 @@ esp_err_t cdc_acm_host_install(const cdc_acm_host_driver_config_t *driver_config
     CDC_ACM_EXIT_CRITICAL();
 
     // Everything OK: Start CDC-Driver task and return
-    vTaskResume(driver_task_h);
+    if (driver_task_h) {
+        vTaskResume(driver_task_h);
+    }
     return ESP_OK;
 
 client_err:
-    usb_host_client_deregister(usb_client);
+    if (!shared_client) {
+        usb_host_client_deregister(usb_client);
+    }
 err: // Clean-up
     free(cdc_acm_obj);
     if (event_group) {
@@ -495,10 +659,11 @@ esp_err_t cdc_acm_host_uninstall()
     cdc_acm_obj_t *cdc_acm_obj = p_cdc_acm_obj; // Save Driver's handle to temporary handle
     CDC_ACM_EXIT_CRITICAL();
 
-    xSemaphoreTake(p_cdc_acm_obj->open_close_mutex, portMAX_DELAY); // Wait for all open/close calls to finish
+    xSemaphoreTake(p_cdc_acm_obj->open_close_mutex, portMAX_DELAY); // Wait for all close calls to finish
 
     CDC_ACM_ENTER_CRITICAL();
-    if (SLIST_EMPTY(&p_cdc_acm_obj->cdc_devices_list)) { // Check that device list is empty (all devices closed)
+    // Check that device list is empty (all devices closed) and no device is being opened
+    if (SLIST_EMPTY(&p_cdc_acm_obj->cdc_devices_list) && p_cdc_acm_obj->open_in_progress == 0) {
         p_cdc_acm_obj = NULL; // NULL static driver pointer: No open/close calls form this point
     } else {
         ret = ESP_ERR_INVALID_STATE;
@@ -507,12 +672,16 @@ esp_err_t cdc_acm_host_uninstall()
     }
     CDC_ACM_EXIT_CRITICAL();
 
-    // Signal to CDC task to stop, unblock it and wait for its deletion
-    xEventGroupSetBits(cdc_acm_obj->event_group, CDC_ACM_TEARDOWN);
-    usb_host_client_unblock(cdc_acm_obj->cdc_acm_client_hdl);
-    ESP_GOTO_ON_FALSE(
-        xEventGroupWaitBits(cdc_acm_obj->event_group, CDC_ACM_TEARDOWN_COMPLETE, pdFALSE, pdFALSE, pdMS_TO_TICKS(100)),
-        ESP_ERR_NOT_FINISHED, unblock, TAG,);
+    if (cdc_acm_obj->client_task) {
+        // Signal to CDC task to stop, unblock it and wait for its deletion
+        xEventGroupSetBits(cdc_acm_obj->event_group, CDC_ACM_TEARDOWN);
+        usb_host_client_unblock(cdc_acm_obj->cdc_acm_client_hdl);
+        ESP_GOTO_ON_FALSE(
+            xEventGroupWaitBits(cdc_acm_obj->event_group, CDC_ACM_TEARDOWN_COMPLETE, pdFALSE, pdFALSE, pdMS_TO_TICKS(100)),
+            ESP_ERR_NOT_FINISHED, unblock, TAG,);
+    } else if (!cdc_acm_obj->shared_client) {
+        ESP_GOTO_ON_ERROR(usb_host_client_deregister(cdc_acm_obj->cdc_acm_client_hdl), unblock, TAG, "Failed to deregister USB host client");
+    }
 
     // Free remaining resources and return
     vEventGroupDelete(cdc_acm_obj->event_group);
@@ -526,6 +695,23 @@ unblock:
     return ret;
 }
 
+esp_err_t cdc_acm_host_handle_events(uint32_t timeout_ms)
+{
+    CDC_ACM_CHECK(p_cdc_acm_obj, ESP_ERR_INVALID_STATE);
+    CDC_ACM_CHECK(!p_cdc_acm_obj->client_task && !p_cdc_acm_obj->shared_client, ESP_ERR_INVALID_STATE);
+    const TickType_t timeout = (timeout_ms == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    return usb_host_client_handle_events(p_cdc_acm_obj->cdc_acm_client_hdl, timeout);
+}
+
+void cdc_acm_host_handle_client_event(const usb_host_client_event_msg_t *event_msg, void *arg)
+{
+    // The driver can be called by the client of the application before its installation and after its uninstallation
+    if (p_cdc_acm_obj == NULL || !p_cdc_acm_obj->shared_client) {
+        return;
+    }
+    usb_event_cb(event_msg, arg);
+}
+
 esp_err_t cdc_acm_host_register_new_dev_callback(cdc_acm_new_dev_callback_t new_dev_cb)
 {
     CDC_ACM_ENTER_CRITICAL();
@@ -546,10 +732,25 @@ static void cdc_acm_transfers_free(cdc_dev_t *cdc_dev)
     if (cdc_dev->notif.xfer != NULL) {
         usb_host_transfer_free(cdc_dev->notif.xfer);
     }
-    if (cdc_dev->data.in_xfer != NULL) {
-        cdc_acm_reset_in_transfer(cdc_dev);
-        usb_host_transfer_free(cdc_dev->data.in_xfer);
+    if (cdc_dev->data.in_xfers != NULL) {
+        for (size_t i = 0; i < cdc_dev->data.in_xfer_count; i++) {
+            if (cdc_dev->data.in_xfers[i] == NULL) {
+                continue;
+            }
+            if (i == 0) {
+                cdc_acm_reset_in_transfer(cdc_dev);
+            }
+            usb_host_transfer_free(cdc_dev->data.in_xfers[i]);
+        }
+        free(cdc_dev->data.in_xfers);
+        cdc_dev->data.in_xfers = NULL;
+    }
+    if (cdc_dev->data.rx_ring != NULL) {
+        vRingbufferDelete(cdc_dev->data.rx_ring);
+        cdc_dev->data.rx_ring = NULL;
     }
+    free(cdc_dev->data.rx_held);
+    cdc_dev->data.rx_held = NULL;
     if (cdc_dev->data.out_xfer != NULL) {
         if (cdc_dev->data.out_xfer->context != NULL) {
             vSemaphoreDelete((SemaphoreHandle_t)cdc_dev->data.out_xfer->context);
@@ -559,6 +760,23 @@ static void cdc_acm_transfers_free(cdc_dev_t *cdc_dev)
         }
         usb_host_transfer_free(cdc_dev->data.out_xfer);
     }
+    if (cdc_dev->data.out_slots != NULL) {
+        for (size_t i = 0; i < cdc_dev->data.out_slot_count; i++) {
+            if (cdc_dev->data.out_slots[i].xfer != NULL) {
+                usb_host_transfer_free(cdc_dev->data.out_slots[i].xfer);
+            }
+        }
+        free(cdc_dev->data.out_slots);
+        cdc_dev->data.out_slots = NULL;
+    }
+    if (cdc_dev->data.out_free != NULL) {
+        vQueueDelete(cdc_dev->data.out_free);
+        cdc_dev->data.out_free = NULL;
+    }
+    if (cdc_dev->data.out_async_mux != NULL) {
+        vSemaphoreDelete(cdc_dev->data.out_async_mux);
+        cdc_dev->data.out_async_mux = NULL;
+    }
     if (cdc_dev->ctrl_transfer != NULL) {
         if (cdc_dev->ctrl_transfer->context != NULL) {
             vSemaphoreDelete((SemaphoreHandle_t)cdc_dev->ctrl_transfer->context);
@@ -577,11 +795,13 @@ static void cdc_acm_transfers_free(cdc_dev_t *cdc_dev)
  * @param[in] notif_ep_desc Pointer to notification EP descriptor
  * @param[in] in_ep_desc-   Pointer to data IN EP descriptor
  * @param[in] in_buf_len    Length of data IN buffer
+ * @param[in] in_xfer_count Number of data IN transfers
  * @param[in] out_ep_desc   Pointer to data OUT EP descriptor
  * @param[in] out_buf_len   Length of data OUT buffer
+ * @param[in] out_xfer_count Number of asynchronous data OUT transfers
  * @return esp_err_t
  */
-static esp_err_t cdc_acm_transfers_allocate(cdc_dev_t *cdc_dev, const usb_ep_desc_t *notif_ep_desc, const usb_ep_desc_t *in_ep_desc, size_t in_buf_len, const usb_ep_desc_t *out_ep_desc, size_t out_buf_len)
+static esp_err_t cdc_acm_transfers_allocate(cdc_dev_t *cdc_dev, const usb_ep_desc_t *notif_ep_desc, const usb_ep_desc_t *in_ep_desc, size_t in_buf_len, size_t in_xfer_count, const usb_ep_desc_t *out_ep_desc, size_t out_buf_len, size_t out_xfer_count)
 {
     esp_err_t ret;
 
@@ -615,18 +835,25 @@ static esp_err_t cdc_acm_transfers_allocate(cdc_dev_t *cdc_dev, const usb_ep_des
 
     // 3. Setup IN data transfer (if it is required (in_buf_len > 0))
     if (in_buf_len != 0) {
-        ESP_GOTO_ON_ERROR(
-            usb_host_transfer_alloc(in_buf_len, 0, &cdc_dev->data.in_xfer),
-            err, TAG,
-        );
-        assert(cdc_dev->data.in_xfer);
-        cdc_dev->data.in_xfer->callback = in_xfer_cb;
-        cdc_dev->data.in_xfer->num_bytes = in_buf_len;
-        cdc_dev->data.in_xfer->bEndpointAddress = in_ep_desc->bEndpointAddress;
-        cdc_dev->data.in_xfer->device_handle = cdc_dev->dev_hdl;
-        cdc_dev->data.in_xfer->context = cdc_dev;
+        in_xfer_count = in_xfer_count ? in_xfer_count : 1;
+        cdc_dev->data.in_xfers = calloc(in_xfer_count, sizeof(usb_transfer_t *));
+        ESP_GOTO_ON_FALSE(cdc_dev->data.in_xfers, ESP_ERR_NO_MEM, err, TAG,);
+        cdc_dev->data.in_xfer_count = in_xfer_count;
+        for (size_t i = 0; i < in_xfer_count; i++) {
+            ESP_GOTO_ON_ERROR(
+                usb_host_transfer_alloc(in_buf_len, 0, &cdc_dev->data.in_xfers[i]),
+                err, TAG,
+            );
+            usb_transfer_t *in_xfer = cdc_dev->data.in_xfers[i];
+            assert(in_xfer);
+            in_xfer->callback = in_xfer_cb;
+            in_xfer->num_bytes = in_buf_len;
+            in_xfer->bEndpointAddress = in_ep_desc->bEndpointAddress;
+            in_xfer->device_handle = cdc_dev->dev_hdl;
+            in_xfer->context = cdc_dev;
+        }
         cdc_dev->data.in_mps = USB_EP_DESC_GET_MPS(in_ep_desc);
-        cdc_dev->data.in_data_buffer_base = cdc_dev->data.in_xfer->data_buffer;
+        cdc_dev->data.in_data_buffer_base = cdc_dev->data.in_xfers[0]->data_buffer;
     }
 
     // 4. Setup OUT bulk transfer (if it is required (out_buf_len > 0))
@@ -644,6 +871,30 @@ static esp_err_t cdc_acm_transfers_allocate(cdc_dev_t *cdc_dev, const usb_ep_des
         cdc_dev->data.out_xfer->bEndpointAddress = out_ep_desc->bEndpointAddress;
         cdc_dev->data.out_xfer->callback = out_xfer_cb;
     }
+
+    // 5. Setup OUT bulk transfers for asynchronous transmit (if they are required (out_xfer_count > 0))
+    if (out_buf_len != 0 && out_xfer_count != 0) {
+        cdc_dev->data.out_slots = calloc(out_xfer_count, sizeof(cdc_acm_tx_slot_t));
+        ESP_GOTO_ON_FALSE(cdc_dev->data.out_slots, ESP_ERR_NO_MEM, err, TAG,);
+        cdc_dev->data.out_slot_count = out_xfer_count;
+        cdc_dev->data.out_free = xQueueCreate(out_xfer_count, sizeof(cdc_acm_tx_slot_t *));
+        ESP_GOTO_ON_FALSE(cdc_dev->data.out_free, ESP_ERR_NO_MEM, err, TAG,);
+        cdc_dev->data.out_async_mux = xSemaphoreCreateMutex();
+        ESP_GOTO_ON_FALSE(cdc_dev->data.out_async_mux, ESP_ERR_NO_MEM, err, TAG,);
+        for (size_t i = 0; i < out_xfer_count; i++) {
+            cdc_acm_tx_slot_t *slot = &cdc_dev->data.out_slots[i];
+            ESP_GOTO_ON_ERROR(
+                usb_host_transfer_alloc(out_buf_len, 0, &slot->xfer),
+                err, TAG,
+            );
+            slot->cdc_dev = cdc_dev;
+            slot->xfer->device_handle = cdc_dev->dev_hdl;
+            slot->xfer->bEndpointAddress = out_ep_desc->bEndpointAddress;
+            slot->xfer->callback = out_async_xfer_cb;
+            slot->xfer->context = slot;
+            xQueueSend(cdc_dev->data.out_free, &slot, 0);
+        }
+    }
     return ESP_OK;
 
 err:
@@ -651,6 +902,109 @@ err:
     return ret;
 }
 
+/**
+ * @brief Create RX ring buffer, if it is configured
+ *
+ * @note Must be called after cdc_acm_transfers_allocate()
+ * @param[in] cdc_dev    Pointer to CDC device
+ * @param[in] dev_config Configuration of the device
+ * @return esp_err_t
+ */
+static esp_err_t cdc_acm_rx_ring_create(cdc_dev_t *cdc_dev, const cdc_acm_host_device_config_t *dev_config)
+{
+    if (dev_config->rx_ringbuf_size == 0 || cdc_dev->data.in_xfers == NULL) {
+        return ESP_OK;
+    }
+    const size_t in_buf_len = cdc_dev->data.in_xfers[0]->data_buffer_size;
+    ESP_RETURN_ON_FALSE(dev_config->rx_ringbuf_size >= cdc_dev->data.in_xfer_count * in_buf_len, ESP_ERR_INVALID_ARG, TAG,
+                        "RX ring buffer must fit %u IN transfers of %u bytes", cdc_dev->data.in_xfer_count, in_buf_len);
+    cdc_dev->data.rx_held = calloc(cdc_dev->data.in_xfer_count, sizeof(usb_transfer_t *));
+    ESP_RETURN_ON_FALSE(cdc_dev->data.rx_held, ESP_ERR_NO_MEM, TAG,);
+    cdc_dev->data.rx_ring = xRingbufferCreate(dev_config->rx_ringbuf_size, RINGBUF_TYPE_BYTEBUF);
+    ESP_RETURN_ON_FALSE(cdc_dev->data.rx_ring, ESP_ERR_NO_MEM, TAG,);
+    cdc_dev->data.rx_high_water = dev_config->rx_high_water;
+    return ESP_OK;
+}
+
+/**
+ * @brief Task processing completed IN transfers of one device
+ *
+ * @param[in] arg CDC device
+ */
+static void cdc_acm_event_task(void *arg)
+{
+    cdc_dev_t *cdc_dev = (cdc_dev_t *)arg;
+    usb_transfer_t *transfer;
+    while (xQueueReceive(cdc_dev->event.queue, &transfer, portMAX_DELAY) == pdTRUE && transfer != NULL) {
+        if (transfer == cdc_dev->notif.xfer) {
+            notif_xfer_cb(transfer);
+        } else {
+            in_xfer_cb(transfer);
+        }
+    }
+    xSemaphoreGive(cdc_dev->event.done);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Create the device's event task, if it is configured
+ *
+ * The IN data and notification transfers are redirected to the task, so that the user's callbacks of this device
+ * do not delay the other devices handled by the driver's task.
+ *
+ * @param[in] cdc_dev    Pointer to CDC device
+ * @param[in] dev_config Configuration of the device
+ * @return esp_err_t
+ */
+static esp_err_t cdc_acm_event_task_create(cdc_dev_t *cdc_dev, const cdc_acm_host_device_config_t *dev_config)
+{
+    if (dev_config->event_task_stack_size == 0) {
+        return ESP_OK;
+    }
+    // Each transfer is queued at most once before it is resubmitted by the task, plus the terminating NULL
+    const size_t queue_len = cdc_dev->data.in_xfer_count + 2;
+    cdc_dev->event.queue = xQueueCreate(queue_len, sizeof(usb_transfer_t *));
+    ESP_RETURN_ON_FALSE(cdc_dev->event.queue, ESP_ERR_NO_MEM, TAG,);
+    cdc_dev->event.done = xSemaphoreCreateBinary();
+    ESP_RETURN_ON_FALSE(cdc_dev->event.done, ESP_ERR_NO_MEM, TAG,);
+    ESP_RETURN_ON_FALSE(
+        xTaskCreatePinnedToCore(cdc_acm_event_task, "USB-CDC-dev", dev_config->event_task_stack_size, cdc_dev,
+                                dev_config->event_task_priority, &cdc_dev->event.task, dev_config->event_task_core_id) == pdPASS,
+        ESP_ERR_NO_MEM, TAG, "Could not create device's task");
+
+    if (cdc_dev->notif.xfer) {
+        cdc_dev->notif.xfer->callback = deferred_xfer_cb;
+    }
+    for (size_t i = 0; i < cdc_dev->data.in_xfer_count; i++) {
+        cdc_dev->data.in_xfers[i]->callback = deferred_xfer_cb;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Stop the device's event task
+ *
+ * The transfers completed afterwards are processed in the driver's task again. Does nothing if the device has no task.
+ *
+ * @param[in] cdc_dev Pointer to CDC device
+ */
+static void cdc_acm_event_task_stop(cdc_dev_t *cdc_dev)
+{
+    if (cdc_dev->event.task == NULL) {
+        return;
+    }
+    if (cdc_dev->notif.xfer) {
+        cdc_dev->notif.xfer->callback = notif_xfer_cb;
+    }
+    for (size_t i = 0; i < cdc_dev->data.in_xfer_count; i++) {
+        cdc_dev->data.in_xfers[i]->callback = in_xfer_cb;
+    }
+    const usb_transfer_t *terminate = NULL;
+    xQueueSend(cdc_dev->event.queue, &terminate, portMAX_DELAY);
+    xSemaphoreTake(cdc_dev->event.done, portMAX_DELAY);
+    cdc_dev->event.task = NULL;
+}
+
 /**
  * @brief Find CDC interface descriptor and its endpoint descriptors
  *
@@ -749,14 +1103,39 @@ static esp_err_t cdc_acm_find_intf_and_ep_desc(cdc_dev_t *cdc_dev, uint8_t intf_
     return ESP_ERR_NOT_FOUND;
 }
 
+/**
+ * @brief Start of device open
+ *
+ * Descriptors are parsed and transfers allocated without any lock, the driver cannot be uninstalled until cdc_acm_open_end() is called.
+ *
+ * @return esp_err_t ESP_ERR_INVALID_STATE if the driver is not installed
+ */
+static esp_err_t cdc_acm_open_begin(void)
+{
+    CDC_ACM_ENTER_CRITICAL();
+    CDC_ACM_CHECK_FROM_CRIT(p_cdc_acm_obj, ESP_ERR_INVALID_STATE);
+    p_cdc_acm_obj->open_in_progress++;
+    CDC_ACM_EXIT_CRITICAL();
+    return ESP_OK;
+}
+
+/**
+ * @brief End of device open started by cdc_acm_open_begin()
+ */
+static void cdc_acm_open_end(void)
+{
+    CDC_ACM_ENTER_CRITICAL();
+    p_cdc_acm_obj->open_in_progress--;
+    CDC_ACM_EXIT_CRITICAL();
+}
+
 esp_err_t cdc_acm_host_open(uint16_t vid, uint16_t pid, uint8_t interface_idx, const cdc_acm_host_device_config_t *dev_config, cdc_acm_dev_hdl_t *cdc_hdl_ret)
 {
     esp_err_t ret;
-    CDC_ACM_CHECK(p_cdc_acm_obj, ESP_ERR_INVALID_STATE);
     CDC_ACM_CHECK(dev_config, ESP_ERR_INVALID_ARG);
     CDC_ACM_CHECK(cdc_hdl_ret, ESP_ERR_INVALID_ARG);
+    ESP_RETURN_ON_ERROR(cdc_acm_open_begin(), TAG,);
 
-    xSemaphoreTake(p_cdc_acm_obj->open_close_mutex, portMAX_DELAY);
     // Find underlying USB device
     cdc_dev_t *cdc_dev;
     ESP_GOTO_ON_ERROR(
@@ -784,19 +1163,22 @@ esp_err_t cdc_acm_host_open(uint16_t vid, uint16_t pid, uint8_t interface_idx, c
 
     // The following line is here for backward compatibility with v1.0.*
     // where fixed size of IN buffer (equal to IN Maximum Packe Size) was used
-    const size_t in_buf_size = (dev_config->data_cb && (dev_config->in_buffer_size == 0)) ? USB_EP_DESC_GET_MPS(in_ep) : dev_config->in_buffer_size;
+    const size_t in_buf_size = ((dev_config->data_cb || dev_config->rx_ringbuf_size) && (dev_config->in_buffer_size == 0)) ? USB_EP_DESC_GET_MPS(in_ep) : dev_config->in_buffer_size;
 
     // Allocate USB transfers, claim CDC interfaces and return CDC-ACM handle
-    ESP_GOTO_ON_ERROR(cdc_acm_transfers_allocate(cdc_dev, notif_ep, in_ep, in_buf_size, out_ep, dev_config->out_buffer_size), err, TAG,);
+    cdc_dev->data.out_coalescing = dev_config->out_coalescing;
+    ESP_GOTO_ON_ERROR(cdc_acm_transfers_allocate(cdc_dev, notif_ep, in_ep, in_buf_size, dev_config->in_transfer_count, out_ep, dev_config->out_buffer_size, dev_config->out_transfer_count), err, TAG,);
+    ESP_GOTO_ON_ERROR(cdc_acm_rx_ring_create(cdc_dev, dev_config), err, TAG,);
+    ESP_GOTO_ON_ERROR(cdc_acm_event_task_create(cdc_dev, dev_config), err, TAG,);
     ESP_GOTO_ON_ERROR(cdc_acm_start(cdc_dev, dev_config->event_cb, dev_config->data_cb, dev_config->user_arg), err, TAG,);
     *cdc_hdl_ret = (cdc_acm_dev_hdl_t)cdc_dev;
-    xSemaphoreGive(p_cdc_acm_obj->open_close_mutex);
+    cdc_acm_open_end();
     return ESP_OK;
 
 err:
     cdc_acm_device_remove(cdc_dev);
 exit:
-    xSemaphoreGive(p_cdc_acm_obj->open_close_mutex);
+    cdc_acm_open_end();
     *cdc_hdl_ret = NULL;
     return ret;
 }
@@ -804,11 +1186,10 @@ exit:
 esp_err_t cdc_acm_host_open_vendor_specific(uint16_t vid, uint16_t pid, uint8_t interface_num, const cdc_acm_host_device_config_t *dev_config, cdc_acm_dev_hdl_t *cdc_hdl_ret)
 {
     esp_err_t ret;
-    CDC_ACM_CHECK(p_cdc_acm_obj, ESP_ERR_INVALID_STATE);
     CDC_ACM_CHECK(dev_config, ESP_ERR_INVALID_ARG);
     CDC_ACM_CHECK(cdc_hdl_ret, ESP_ERR_INVALID_ARG);
+    ESP_RETURN_ON_ERROR(cdc_acm_open_begin(), TAG,);
 
-    xSemaphoreTake(p_cdc_acm_obj->open_close_mutex, portMAX_DELAY);
 
     // Find underlying USB device
     cdc_dev_t *cdc_dev;
@@ -853,18 +1234,21 @@ esp_err_t cdc_acm_host_open_vendor_specific(uint16_t vid, uint16_t pid, uint8_t
 
     // The following line is here for backward compatibility with v1.0.*
     // where fixed size of IN buffer (equal to IN Maximum Packet Size) was used
-    const size_t in_buf_size = (dev_config->data_cb && (dev_config->in_buffer_size == 0)) ? USB_EP_DESC_GET_MPS(in_ep) : dev_config->in_buffer_size;
+    const size_t in_buf_size = ((dev_config->data_cb || dev_config->rx_ringbuf_size) && (dev_config->in_buffer_size == 0)) ? USB_EP_DESC_GET_MPS(in_ep) : dev_config->in_buffer_size;
 
     // Allocate USB transfers, claim CDC interfaces and return CDC-ACM handle
-    ESP_GOTO_ON_ERROR(cdc_acm_transfers_allocate(cdc_dev, notif_ep, in_ep, in_buf_size, out_ep, dev_config->out_buffer_size), err, TAG, );
+    cdc_dev->data.out_coalescing = dev_config->out_coalescing;
+    ESP_GOTO_ON_ERROR(cdc_acm_transfers_allocate(cdc_dev, notif_ep, in_ep, in_buf_size, dev_config->in_transfer_count, out_ep, dev_config->out_buffer_size, dev_config->out_transfer_count), err, TAG, );
+    ESP_GOTO_ON_ERROR(cdc_acm_rx_ring_create(cdc_dev, dev_config), err, TAG, );
+    ESP_GOTO_ON_ERROR(cdc_acm_event_task_create(cdc_dev, dev_config), err, TAG, );
     ESP_GOTO_ON_ERROR(cdc_acm_start(cdc_dev, dev_config->event_cb, dev_config->data_cb, dev_config->user_arg), err, TAG,);
     *cdc_hdl_ret = (cdc_acm_dev_hdl_t)cdc_dev;
-    xSemaphoreGive(p_cdc_acm_obj->open_close_mutex);
+    cdc_acm_open_end();
     return ESP_OK;
 err:
     cdc_acm_device_remove(cdc_dev);
 exit:
-    xSemaphoreGive(p_cdc_acm_obj->open_close_mutex);
+    cdc_acm_open_end();
     return ret;
 }
 
@@ -873,17 +1257,29 @@ esp_err_t cdc_acm_host_close(cdc_acm_dev_hdl_t cdc_hdl)
     CDC_ACM_CHECK(p_cdc_acm_obj, ESP_ERR_INVALID_STATE);
     CDC_ACM_CHECK(cdc_hdl, ESP_ERR_INVALID_ARG);
 
-    xSemaphoreTake(p_cdc_acm_obj->open_close_mutex, portMAX_DELAY);
-
     cdc_dev_t *cdc_dev = (cdc_dev_t *)cdc_hdl;
+    CDC_ACM_CHECK(cdc_dev->event.task == NULL || cdc_dev->event.task != xTaskGetCurrentTaskHandle(), ESP_ERR_INVALID_STATE); // Task cannot wait for its own termination
 
     // Cancel polling of BULK IN and INTERRUPT IN
     CDC_ACM_ENTER_CRITICAL();
     cdc_dev->notif.cb = NULL;
     cdc_dev->data.in_cb = NULL;
     CDC_ACM_EXIT_CRITICAL();
-    if (cdc_dev->data.in_xfer) {
-        ESP_ERROR_CHECK(cdc_acm_reset_transfer_endpoint(cdc_dev->dev_hdl, cdc_dev->data.in_xfer));
+    cdc_acm_event_task_stop(cdc_dev);
+    if (cdc_dev->data.in_xfers) {
+        // All IN transfers share the endpoint, they are all canceled at once
+        ESP_ERROR_CHECK(cdc_acm_reset_transfer_endpoint(cdc_dev->dev_hdl, cdc_dev->data.in_xfers[0]));
+    }
+    if (cdc_dev->data.out_slots) {
+        // Cancel asynchronous transfers in flight, the writes waiting for them are not sent
+        ESP_ERROR_CHECK(cdc_acm_reset_transfer_endpoint(cdc_dev->dev_hdl, cdc_dev->data.out_slots[0].xfer));
+        xSemaphoreTake(cdc_dev->data.out_async_mux, portMAX_DELAY);
+        cdc_acm_tx_slot_t *pending = cdc_dev->data.out_pending;
+        cdc_dev->data.out_pending = NULL;
+        xSemaphoreGive(cdc_dev->data.out_async_mux);
+        if (pending) {
+            cdc_acm_tx_slot_done(pending, ESP_ERR_INVALID_STATE);
+        }
     }
     if (cdc_dev->notif.xfer != NULL) {
         ESP_ERROR_CHECK(cdc_acm_reset_transfer_endpoint(cdc_dev->dev_hdl, cdc_dev->notif.xfer));
@@ -895,6 +1291,7 @@ esp_err_t cdc_acm_host_close(cdc_acm_dev_hdl_t cdc_hdl)
         ESP_ERROR_CHECK(usb_host_interface_release(p_cdc_acm_obj->cdc_acm_client_hdl, cdc_dev->dev_hdl, cdc_dev->notif.intf_desc->bInterfaceNumber));
     }
 
+    xSemaphoreTake(p_cdc_acm_obj->open_close_mutex, portMAX_DELAY);
     CDC_ACM_ENTER_CRITICAL();
     SLIST_REMOVE(&p_cdc_acm_obj->cdc_devices_list, cdc_dev, cdc_dev_s, list_entry);
     CDC_ACM_EXIT_CRITICAL();
@@ -1005,17 +1402,177 @@ static bool cdc_acm_is_transfer_completed(usb_transfer_t *transfer)
     return completed;
 }
 
+/**
+ * @brief Inform the user about IN buffer overflow
+ *
+ * @param[in] cdc_dev Pointer to CDC device
+ */
+static void cdc_acm_in_overflow(cdc_dev_t *cdc_dev)
+{
+    ESP_LOGW(TAG, "IN buffer overflow");
+    CDC_ACM_ENTER_CRITICAL();
+    cdc_dev->stats.counters.rx_overflows++;
+    CDC_ACM_EXIT_CRITICAL();
+    cdc_dev->serial_state.bOverRun = true;
+    if (cdc_dev->notif.cb) {
+        const cdc_acm_host_dev_event_data_t serial_state_event = {
+            .type = CDC_ACM_HOST_SERIAL_STATE,
+            .data.serial_state = cdc_dev->serial_state
+        };
+        cdc_dev->notif.cb(&serial_state_event, cdc_dev->cb_arg);
+    }
+    cdc_dev->serial_state.bOverRun = false;
+}
+
+/**
+ * @brief Handle received data with multiple IN transfers
+ *
+ * The transfers are resubmitted right away, so that the endpoint is polled while the user processes the data.
+ * Data that the user did not process is kept in its transfer, which is held back from polling.
+ * The data of the following transfers is then appended to it.
+ *
+ * @param[in] cdc_dev  Pointer to CDC device
+ * @param[in] transfer Completed IN transfer
+ */
+static void in_xfer_multi_cb(cdc_dev_t *cdc_dev, usb_transfer_t *transfer)
+{
+    usb_transfer_t *held = cdc_dev->data.in_held;
+    if (held && cdc_dev->data.in_held_len + transfer->actual_num_bytes > held->data_buffer_size) {
+        // The new data does not fit behind the not processed data, drop the old data
+        cdc_acm_in_overflow(cdc_dev);
+        cdc_dev->data.in_held = NULL;
+        usb_host_transfer_submit(held);
+        held = NULL;
+    }
+
+    if (!held) {
+        const bool data_processed = cdc_acm_call_in_cb(cdc_dev, transfer->data_buffer, transfer->actual_num_bytes);
+        if (!data_processed) {
+            cdc_dev->data.in_held = transfer;
+            cdc_dev->data.in_held_len = transfer->actual_num_bytes;
+            return;
+        }
+        usb_host_transfer_submit(transfer);
+        return;
+    }
+
+    memcpy(held->data_buffer + cdc_dev->data.in_held_len, transfer->data_buffer, transfer->actual_num_bytes);
+    cdc_dev->data.in_held_len += transfer->actual_num_bytes;
+    usb_host_transfer_submit(transfer);
+    const bool data_processed = cdc_acm_call_in_cb(cdc_dev, held->data_buffer, cdc_dev->data.in_held_len);
+    if (!data_processed && held->data_buffer_size - cdc_dev->data.in_held_len >= cdc_dev->data.in_mps) {
+        return;
+    }
+    if (!data_processed) {
+        // The IN buffer cannot accept more data, inform the user and reset the buffer
+        cdc_acm_in_overflow(cdc_dev);
+    }
+    cdc_dev->data.in_held = NULL;
+    usb_host_transfer_submit(held);
+}
+
+/**
+ * @brief Submit IN transfer, if there is space for its data in the RX ring buffer
+ *
+ * Otherwise the transfer is held back until cdc_acm_host_read() frees space.
+ *
+ * @param[in] cdc_dev  Pointer to CDC device
+ * @param[in] transfer IN transfer to be submitted, NULL to submit a held back transfer
+ */
+static void cdc_acm_rx_ring_submit(cdc_dev_t *cdc_dev, usb_transfer_t *transfer)
+{
+    bool submit = false;
+    const bool was_held = (transfer == NULL);
+    CDC_ACM_ENTER_CRITICAL();
+    // Sampled together with rx_reserved: completed transfers release their reservation only after sending their data
+    const size_t free_size = xRingbufferGetCurFreeSize(cdc_dev->data.rx_ring);
+    if (was_held && cdc_dev->data.rx_held_count > 0) {
+        transfer = cdc_dev->data.rx_held[--cdc_dev->data.rx_held_count];
+    }
+    if (transfer) {
+        if (free_size >= cdc_dev->data.rx_reserved + transfer->data_buffer_size) {
+            cdc_dev->data.rx_reserved += transfer->data_buffer_size;
+            submit = true;
+        } else {
+            if (!was_held) {
+                cdc_dev->stats.counters.rx_throttled++;
+            }
+            cdc_dev->data.rx_held[cdc_dev->data.rx_held_count++] = transfer;
+        }
+    }
+    CDC_ACM_EXIT_CRITICAL();
+    if (submit) {
+        usb_host_transfer_submit(transfer);
+    }
+}
+
+/**
+ * @brief Report RX ring buffer fill level crossing rx_high_water
+ *
+ * @param[in] cdc_dev Pointer to CDC device
+ * @param[in] report  Report the crossing, false only rearms the report when the fill level dropped below rx_high_water
+ */
+static void cdc_acm_rx_ring_check_high_water(cdc_dev_t *cdc_dev, bool report)
+{
+    if (cdc_dev->data.rx_high_water == 0) {
+        return;
+    }
+    const size_t buffered = xRingbufferGetMaxItemSize(cdc_dev->data.rx_ring) - xRingbufferGetCurFreeSize(cdc_dev->data.rx_ring);
+    if (buffered < cdc_dev->data.rx_high_water) {
+        cdc_dev->data.rx_high_water_reported = false;
+    } else if (report && !cdc_dev->data.rx_high_water_reported) {
+        cdc_dev->data.rx_high_water_reported = true;
+        if (cdc_dev->notif.cb) {
+            const cdc_acm_host_dev_event_data_t high_water_event = {
+                .type = CDC_ACM_HOST_RX_HIGH_WATER,
+                .data.rx_buffered = buffered
+            };
+            cdc_dev->notif.cb(&high_water_event, cdc_dev->cb_arg);
+        }
+    }
+}
+
 static void in_xfer_cb(usb_transfer_t *transfer)
 {
     ESP_LOGD("CDC_ACM", "in xfer cb");
     cdc_dev_t *cdc_dev = (cdc_dev_t *)transfer->context;
 
     if (!cdc_acm_is_transfer_completed(transfer)) {
+        if (cdc_dev->data.rx_ring) {
+            // The transfer is not resubmitted, release its space
+            CDC_ACM_ENTER_CRITICAL();
+            cdc_dev->data.rx_reserved -= transfer->data_buffer_size;
+            CDC_ACM_EXIT_CRITICAL();
+        }
+        return;
+    }
+
+    CDC_ACM_ENTER_CRITICAL();
+    cdc_dev->stats.counters.rx_bytes += transfer->actual_num_bytes;
+    cdc_dev->stats.counters.rx_transfers++;
+    CDC_ACM_EXIT_CRITICAL();
+
+    if (cdc_dev->data.rx_ring) {
+        // The space was reserved when the transfer was submitted, so the data should always fit
+        if (transfer->actual_num_bytes > 0 &&
+                xRingbufferSend(cdc_dev->data.rx_ring, transfer->data_buffer, transfer->actual_num_bytes, 0) != pdTRUE) {
+            cdc_acm_in_overflow(cdc_dev);
+        }
+        CDC_ACM_ENTER_CRITICAL();
+        cdc_dev->data.rx_reserved -= transfer->data_buffer_size;
+        CDC_ACM_EXIT_CRITICAL();
+        cdc_acm_rx_ring_check_high_water(cdc_dev, true);
+        cdc_acm_rx_ring_submit(cdc_dev, transfer);
+        return;
+    }
+
+    if (cdc_dev->data.in_cb && cdc_dev->data.in_xfer_count > 1) {
+        in_xfer_multi_cb(cdc_dev, transfer);
         return;
     }
 
     if (cdc_dev->data.in_cb) {
-        const bool data_processed = cdc_dev->data.in_cb(transfer->data_buffer, transfer->actual_num_bytes, cdc_dev->cb_arg);
+        const bool data_processed = cdc_acm_call_in_cb(cdc_dev, transfer->data_buffer, transfer->actual_num_bytes);
 
         // Information for developers:
         // In order to save RAM and CPU time, the application can indicate that the received data was not processed and that the application expects more data.
@@ -1033,18 +1590,8 @@ static void in_xfer_cb(usb_transfer_t *transfer)
 
             if (transfer->num_bytes == 0) {
                 // The IN buffer cannot accept more data, inform the user and reset the buffer
-                ESP_LOGW(TAG, "IN buffer overflow");
-                cdc_dev->serial_state.bOverRun = true;
-                if (cdc_dev->notif.cb) {
-                    const cdc_acm_host_dev_event_data_t serial_state_event = {
-                        .type = CDC_ACM_HOST_SERIAL_STATE,
-                        .data.serial_state = cdc_dev->serial_state
-                    };
-                    cdc_dev->notif.cb(&serial_state_event, cdc_dev->cb_arg);
-                }
-
+                cdc_acm_in_overflow(cdc_dev);
                 cdc_acm_reset_in_transfer(cdc_dev);
-                cdc_dev->serial_state.bOverRun = false;
             }
         } else {
             cdc_acm_reset_in_transfer(cdc_dev);
@@ -1052,7 +1599,13 @@ static void in_xfer_cb(usb_transfer_t *transfer)
     }
 
     ESP_LOGD("CDC_ACM", "Submitting poll for BULK IN transfer");
-    usb_host_transfer_submit(cdc_dev->data.in_xfer);
+    usb_host_transfer_submit(transfer);
+}
+
+static void deferred_xfer_cb(usb_transfer_t *transfer)
+{
+    cdc_dev_t *cdc_dev = (cdc_dev_t *)transfer->context;
+    xQueueSend(cdc_dev->event.queue, &transfer, 0);
 }
 
 static void notif_xfer_cb(usb_transfer_t *transfer)
@@ -1104,6 +1657,69 @@ static void out_xfer_cb(usb_transfer_t *transfer)
     xSemaphoreGive((SemaphoreHandle_t)transfer->context);
 }
 
+static void cdc_acm_tx_slot_done(cdc_acm_tx_slot_t *slot, esp_err_t result)
+{
+    cdc_dev_t *cdc_dev = slot->cdc_dev;
+    for (size_t i = 0; i < slot->cb_count; i++) {
+        if (slot->cbs[i].cb) {
+            slot->cbs[i].cb((cdc_acm_dev_hdl_t)cdc_dev, result, slot->cbs[i].arg);
+        }
+    }
+    slot->cb_count = 0;
+    xQueueSend(cdc_dev->data.out_free, &slot, 0);
+}
+
+/**
+ * @brief Append a write to an asynchronous transfer
+ *
+ * @return true if the write fits into the transfer
+ */
+static bool cdc_acm_tx_slot_append(cdc_acm_tx_slot_t *slot, const uint8_t *data, size_t data_len, cdc_acm_tx_done_callback_t done_cb, void *user_arg)
+{
+    if (slot->cb_count == CDC_ACM_TX_CALLBACKS_MAX || slot->xfer->num_bytes + data_len > slot->xfer->data_buffer_size) {
+        return false;
+    }
+    memcpy(slot->xfer->data_buffer + slot->xfer->num_bytes, data, data_len);
+    slot->xfer->num_bytes += data_len;
+    slot->cbs[slot->cb_count].cb = done_cb;
+    slot->cbs[slot->cb_count].arg = user_arg;
+    slot->cb_count++;
+    return true;
+}
+
+static void out_async_xfer_cb(usb_transfer_t *transfer)
+{
+    ESP_LOGD("CDC_ACM", "out async xfer cb");
+    cdc_acm_tx_slot_t *slot = (cdc_acm_tx_slot_t *)transfer->context;
+    cdc_dev_t *cdc_dev = slot->cdc_dev;
+    const esp_err_t result = (transfer->status == USB_TRANSFER_STATUS_COMPLETED && transfer->actual_num_bytes == transfer->num_bytes) ?
+                             ESP_OK : ESP_ERR_INVALID_RESPONSE;
+
+    // Send the writes coalesced while this transfer was in flight
+    cdc_acm_tx_slot_t *failed = NULL;
+    xSemaphoreTake(cdc_dev->data.out_async_mux, portMAX_DELAY);
+    cdc_dev->data.out_in_flight--;
+    if (cdc_dev->data.out_pending && transfer->status != USB_TRANSFER_STATUS_CANCELED) {
+        cdc_acm_tx_slot_t *pending = cdc_dev->data.out_pending;
+        cdc_dev->data.out_pending = NULL;
+        if (usb_host_transfer_submit(pending->xfer) == ESP_OK) {
+            cdc_dev->data.out_in_flight++;
+        } else {
+            failed = pending;
+        }
+    }
+    xSemaphoreGive(cdc_dev->data.out_async_mux);
+
+    if (result != ESP_OK) {
+        ESP_LOGE(TAG, "Bulk OUT transfer error: Status %d", transfer->status);
+    }
+    cdc_acm_stats_tx(cdc_dev, result == ESP_OK ? transfer->num_bytes : 0);
+    cdc_acm_tx_slot_done(slot, result);
+    if (failed) {
+        cdc_acm_tx_slot_done(failed, ESP_ERR_INVALID_STATE);
+    }
+}
+
 static void usb_event_cb(const usb_host_client_event_msg_t *event_msg, void *arg)
 {
     switch (event_msg->event) {
@@ -1157,10 +1773,12 @@ esp_err_t cdc_acm_host_data_tx_blocking(cdc_acm_dev_hdl_t cdc_hdl, const uint8_t
     CDC_ACM_CHECK(data && (data_len > 0), ESP_ERR_INVALID_ARG);
     CDC_ACM_CHECK(cdc_dev->data.out_xfer, ESP_ERR_NOT_SUPPORTED); // Device was opened as read-only.
     CDC_ACM_CHECK(data_len <= cdc_dev->data.out_xfer->data_buffer_size, ESP_ERR_INVALID_SIZE);
+    const int64_t start = esp_timer_get_time();
 
     // Take OUT mutex and fill the OUT transfer
     BaseType_t taken = xSemaphoreTake(cdc_dev->data.out_mux, pdMS_TO_TICKS(timeout_ms));
     if (taken != pdTRUE) {
+        cdc_acm_stats_tx(cdc_dev, 0);
         return ESP_ERR_TIMEOUT;
     }
 
@@ -1185,9 +1803,159 @@ esp_err_t cdc_acm_host_data_tx_blocking(cdc_acm_dev_hdl_t cdc_hdl, const uint8_t
 
 unblock:
     xSemaphoreGive(cdc_dev->data.out_mux);
+    const uint32_t us = (uint32_t)(esp_timer_get_time() - start);
+    cdc_acm_stats_tx(cdc_dev, ret == ESP_OK ? data_len : 0);
+    CDC_ACM_ENTER_CRITICAL();
+    cdc_dev->stats.counters.tx_wait_max_us = MAX(cdc_dev->stats.counters.tx_wait_max_us, us);
+    cdc_acm_stats_histogram_add(cdc_dev->stats.counters.tx_wait_histogram, us);
+    cdc_dev->stats.tx_wait_total_us += us;
+    cdc_dev->stats.tx_wait_count++;
+    CDC_ACM_EXIT_CRITICAL();
     return ret;
 }
 
+esp_err_t cdc_acm_host_data_tx_async(cdc_acm_dev_hdl_t cdc_hdl, const uint8_t *data, size_t data_len,
+                                     cdc_acm_tx_done_callback_t done_cb, void *user_arg, uint32_t timeout_ms)
+{
+    esp_err_t ret = ESP_OK;
+    CDC_ACM_CHECK(cdc_hdl, ESP_ERR_INVALID_ARG);
+    cdc_dev_t *cdc_dev = (cdc_dev_t *)cdc_hdl;
+    CDC_ACM_CHECK(data && (data_len > 0), ESP_ERR_INVALID_ARG);
+    CDC_ACM_CHECK(cdc_dev->data.out_slots, ESP_ERR_NOT_SUPPORTED); // Device was opened without asynchronous transfers
+    CDC_ACM_CHECK(data_len <= cdc_dev->data.out_slots[0].xfer->data_buffer_size, ESP_ERR_INVALID_SIZE);
+
+    // Append to the transfer waiting for the transfer in flight, if it has space left
+    if (cdc_dev->data.out_coalescing) {
+        xSemaphoreTake(cdc_dev->data.out_async_mux, portMAX_DELAY);
+        const bool appended = cdc_dev->data.out_pending &&
+                              cdc_acm_tx_slot_append(cdc_dev->data.out_pending, data, data_len, done_cb, user_arg);
+        xSemaphoreGive(cdc_dev->data.out_async_mux);
+        if (appended) {
+            return ESP_OK;
+        }
+    }
+
+    cdc_acm_tx_slot_t *slot;
+    if (xQueueReceive(cdc_dev->data.out_free, &slot, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    slot->xfer->num_bytes = 0;
+    slot->cb_count = 0;
+    cdc_acm_tx_slot_append(slot, data, data_len, done_cb, user_arg);
+
+    cdc_acm_tx_slot_t *failed = NULL; // Transfer with writes already accepted, that could not be submitted
+    xSemaphoreTake(cdc_dev->data.out_async_mux, portMAX_DELAY);
+    if (cdc_dev->data.out_coalescing && cdc_dev->data.out_in_flight > 0) {
+        cdc_acm_tx_slot_t *pending = cdc_dev->data.out_pending;
+        if (pending && cdc_acm_tx_slot_append(pending, data, data_len, done_cb, user_arg)) {
+            // Another write made a pending transfer meanwhile, this one is not needed
+            slot->cb_count = 0;
+            xQueueSend(cdc_dev->data.out_free, &slot, 0);
+        } else if (!pending) {
+            // Sent when the transfer in flight completes
+            cdc_dev->data.out_pending = slot;
+        } else {
+            // The pending transfer is full, send it now and collect the next writes in this one
+            cdc_dev->data.out_pending = slot;
+            if (usb_host_transfer_submit(pending->xfer) == ESP_OK) {
+                cdc_dev->data.out_in_flight++;
+            } else {
+                failed = pending;
+            }
+        }
+    } else {
+        ESP_LOGD("CDC_ACM", "Submitting async BULK OUT transfer");
+        ret = usb_host_transfer_submit(slot->xfer);
+        if (ret == ESP_OK) {
+            cdc_dev->data.out_in_flight++;
+        } else {
+            // The callback is not called for a write that returns an error
+            slot->cb_count = 0;
+            xQueueSend(cdc_dev->data.out_free, &slot, 0);
+        }
+    }
+    xSemaphoreGive(cdc_dev->data.out_async_mux);
+
+    if (failed) {
+        ESP_LOGE(TAG, "Failed to submit Bulk OUT transfer");
+        cdc_acm_tx_slot_done(failed, ESP_ERR_INVALID_STATE);
+    }
+    return ret;
+}
+
+/**
+ * @brief Resume the IN transfers held back for space after data were taken out of the RX ring buffer
+ *
+ * @param[in] cdc_dev Pointer to CDC device
+ */
+static void cdc_acm_rx_ring_resume(cdc_dev_t *cdc_dev)
+{
+    for (size_t i = 0; i < cdc_dev->data.in_xfer_count; i++) {
+        cdc_acm_rx_ring_submit(cdc_dev, NULL);
+    }
+    cdc_acm_rx_ring_check_high_water(cdc_dev, false);
+}
+
+esp_err_t cdc_acm_host_read(cdc_acm_dev_hdl_t cdc_hdl, uint8_t *buf, size_t buf_len, size_t *read_len, uint32_t timeout_ms)
+{
+    CDC_ACM_CHECK(cdc_hdl, ESP_ERR_INVALID_ARG);
+    cdc_dev_t *cdc_dev = (cdc_dev_t *)cdc_hdl;
+    CDC_ACM_CHECK(buf && (buf_len > 0) && read_len, ESP_ERR_INVALID_ARG);
+    CDC_ACM_CHECK(cdc_dev->data.rx_ring, ESP_ERR_NOT_SUPPORTED); // Device was opened without RX ring buffer
+    CDC_ACM_CHECK(!cdc_dev->data.rx_acquired, ESP_ERR_INVALID_STATE);
+
+    // The data may wrap around the end of the ring buffer, then it is received in two parts
+    *read_len = 0;
+    TickType_t ticks = pdMS_TO_TICKS(timeout_ms);
+    for (int part = 0; part < 2 && *read_len < buf_len; part++) {
+        size_t size = 0;
+        uint8_t *data = xRingbufferReceiveUpTo(cdc_dev->data.rx_ring, &size, ticks, buf_len - *read_len);
+        if (!data) {
+            break;
+        }
+        memcpy(buf + *read_len, data, size);
+        vRingbufferReturnItem(cdc_dev->data.rx_ring, data);
+        *read_len += size;
+        ticks = 0;
+    }
+    if (*read_len == 0) {
+        return ESP_ERR_TIMEOUT;
+    }
+    cdc_acm_rx_ring_resume(cdc_dev);
+    return ESP_OK;
+}
+
+esp_err_t cdc_acm_host_read_acquire(cdc_acm_dev_hdl_t cdc_hdl, const uint8_t **data, size_t *data_len, size_t max_len, uint32_t timeout_ms)
+{
+    CDC_ACM_CHECK(cdc_hdl, ESP_ERR_INVALID_ARG);
+    cdc_dev_t *cdc_dev = (cdc_dev_t *)cdc_hdl;
+    CDC_ACM_CHECK(data && data_len && (max_len > 0), ESP_ERR_INVALID_ARG);
+    CDC_ACM_CHECK(cdc_dev->data.rx_ring, ESP_ERR_NOT_SUPPORTED); // Device was opened without RX ring buffer
+    CDC_ACM_CHECK(!cdc_dev->data.rx_acquired, ESP_ERR_INVALID_STATE); // Byte ring buffer lends one part at a time
+
+    size_t size = 0;
+    const uint8_t *rx_data = xRingbufferReceiveUpTo(cdc_dev->data.rx_ring, &size, pdMS_TO_TICKS(timeout_ms), max_len);
+    if (!rx_data) {
+        return ESP_ERR_TIMEOUT;
+    }
+    cdc_dev->data.rx_acquired = rx_data;
+    *data = rx_data;
+    *data_len = size;
+    return ESP_OK;
+}
+
+esp_err_t cdc_acm_host_read_release(cdc_acm_dev_hdl_t cdc_hdl, const uint8_t *data)
+{
+    CDC_ACM_CHECK(cdc_hdl, ESP_ERR_INVALID_ARG);
+    cdc_dev_t *cdc_dev = (cdc_dev_t *)cdc_hdl;
+    CDC_ACM_CHECK(data && data == cdc_dev->data.rx_acquired, ESP_ERR_INVALID_ARG);
+
+    vRingbufferReturnItem(cdc_dev->data.rx_ring, (void *)data);
+    cdc_dev->data.rx_acquired = NULL;
+    cdc_acm_rx_ring_resume(cdc_dev);
+    return ESP_OK;
+}
+
 esp_err_t cdc_acm_host_line_coding_get(cdc_acm_dev_hdl_t cdc_hdl, cdc_acm_line_coding_t *line_coding)
 {
     CDC_ACM_CHECK(line_coding, ESP_ERR_INVALID_ARG);
@@ -1305,6 +2073,35 @@ static esp_err_t send_cdc_request(cdc_dev_t *cdc_dev, bool in_transfer, cdc_requ
     return cdc_acm_host_send_custom_request((cdc_acm_dev_hdl_t) cdc_dev, req_type, request, value, cdc_dev->notif.intf_desc->bInterfaceNumber, data_len, data);
 }
 
+esp_err_t cdc_acm_host_get_stats(cdc_acm_dev_hdl_t cdc_hdl, cdc_acm_host_stats_t *stats)
+{
+    CDC_ACM_CHECK(cdc_hdl && stats, ESP_ERR_INVALID_ARG);
+    cdc_dev_t *cdc_dev = (cdc_dev_t *)cdc_hdl;
+
+    CDC_ACM_ENTER_CRITICAL();
+    *stats = cdc_dev->stats.counters;
+    const uint64_t rx_cb_total_us = cdc_dev->stats.rx_cb_total_us;
+    const uint32_t rx_cb_count = cdc_dev->stats.rx_cb_count;
+    const uint64_t tx_wait_total_us = cdc_dev->stats.tx_wait_total_us;
+    const uint32_t tx_wait_count = cdc_dev->stats.tx_wait_count;
+    CDC_ACM_EXIT_CRITICAL();
+
+    stats->rx_cb_avg_us = rx_cb_count ? (uint32_t)(rx_cb_total_us / rx_cb_count) : 0;
+    stats->tx_wait_avg_us = tx_wait_count ? (uint32_t)(tx_wait_total_us / tx_wait_count) : 0;
+    return ESP_OK;
+}
+
+esp_err_t cdc_acm_host_reset_stats(cdc_acm_dev_hdl_t cdc_hdl)
+{
+    CDC_ACM_CHECK(cdc_hdl, ESP_ERR_INVALID_ARG);
+    cdc_dev_t *cdc_dev = (cdc_dev_t *)cdc_hdl;
+
+    CDC_ACM_ENTER_CRITICAL();
+    memset(&cdc_dev->stats, 0, sizeof(cdc_dev->stats));
+    CDC_ACM_EXIT_CRITICAL();
+    return ESP_OK;
+}
+
 esp_err_t cdc_acm_host_protocols_get(cdc_acm_dev_hdl_t cdc_hdl, cdc_comm_protocol_t *comm, cdc_data_protocol_t *data)
 {
     CDC_ACM_CHECK(cdc_hdl, ESP_ERR_INVALID_ARG);
@@ -54,7 +54,8 @@ typedef enum {
     CDC_ACM_HOST_ERROR,
     CDC_ACM_HOST_SERIAL_STATE,
     CDC_ACM_HOST_NETWORK_CONNECTION,
-    CDC_ACM_HOST_DEVICE_DISCONNECTED
+    CDC_ACM_HOST_DEVICE_DISCONNECTED,
+    CDC_ACM_HOST_RX_HIGH_WATER
 } cdc_acm_host_dev_event_t;
 
 /**
@@ -68,9 +69,34 @@ typedef struct {
         cdc_acm_uart_state_t serial_state; //!< Serial (UART) state
         bool network_connected;            //!< Network connection event
         cdc_acm_dev_hdl_t cdc_hdl;         //!< Disconnection event
+        size_t rx_buffered;                //!< RX ring buffer high water event: Number of bytes in the ring buffer
     } data;
 } cdc_acm_host_dev_event_data_t;
 
+#define CDC_ACM_STATS_HISTOGRAM_BINS    8   //!< Number of bins of the latency histograms
+#define CDC_ACM_STATS_HISTOGRAM_BASE_US 128 //!< Upper bound of the first bin, every following bin doubles it. The last bin counts all longer durations
+
+/**
+ * @brief CDC-ACM device statistics
+ *
+ * Durations are in [us]. Bin i of a histogram counts durations shorter than CDC_ACM_STATS_HISTOGRAM_BASE_US << i.
+ */
+typedef struct {
+    uint64_t rx_bytes;                                  //!< Bytes received
+    uint32_t rx_transfers;                              //!< IN transfers completed
+    uint32_t rx_overflows;                              //!< IN buffer or RX ring buffer overflows, reported with bOverRun serial state
+    uint32_t rx_throttled;                              //!< IN transfers held back for space in the RX ring buffer
+    uint32_t rx_cb_max_us;                              //!< Longest duration of the data RX callback
+    uint32_t rx_cb_avg_us;                              //!< Average duration of the data RX callback
+    uint32_t rx_cb_histogram[CDC_ACM_STATS_HISTOGRAM_BINS];  //!< Histogram of the data RX callback durations
+    uint64_t tx_bytes;                                  //!< Bytes sent
+    uint32_t tx_transfers;                              //!< OUT transfers completed
+    uint32_t tx_errors;                                 //!< OUT transfers failed or timed out
+    uint32_t tx_wait_max_us;                            //!< Longest wait in cdc_acm_host_data_tx_blocking()
+    uint32_t tx_wait_avg_us;                            //!< Average wait in cdc_acm_host_data_tx_blocking()
+    uint32_t tx_wait_histogram[CDC_ACM_STATS_HISTOGRAM_BINS]; //!< Histogram of the waits in cdc_acm_host_data_tx_blocking()
+} cdc_acm_host_stats_t;
+
 /**
  * @brief New USB device callback
  *
@@ -100,15 +126,28 @@ typedef bool (*cdc_acm_data_callback_t)(const uint8_t *data, size_t data_len, vo
  */
 typedef void (*cdc_acm_host_dev_callback_t)(const cdc_acm_host_dev_event_data_t *event, void *user_ctx);
 
+/**
+ * @brief Asynchronous transmit done callback type
+ *
+ * Called from the CDC-ACM driver task when the data were sent or the transfer failed.
+ *
+ * @param[in] cdc_hdl  CDC handle the data were sent to
+ * @param[in] result   ESP_OK if all data were sent, error otherwise
+ * @param[in] user_arg User's argument passed to cdc_acm_host_data_tx_async()
+ */
+typedef void (*cdc_acm_tx_done_callback_t)(cdc_acm_dev_hdl_t cdc_hdl, esp_err_t result, void *user_arg);
+
 /**
  * @brief Configuration structure of USB Host CDC-ACM driver
  *
  */
 typedef struct {
-    size_t driver_task_stack_size;         /**< Stack size of the driver's task */
+    size_t driver_task_stack_size;         /**< Stack size of the driver's task. 0: no task is created, the events are handled by cdc_acm_host_handle_events() */
     unsigned driver_task_priority;         /**< Priority of the driver's task */
     int  xCoreID;                          /**< Core affinity of the driver's task */
     cdc_acm_new_dev_callback_t new_dev_cb; /**< New USB device connected callback. Can be NULL. */
+    usb_host_client_handle_t client_hdl;   /**< USB Host client registered by the application, e.g. usb_host_daemon_get_client(), whose events are passed to cdc_acm_host_handle_client_event().
+                                                NULL: the driver registers its own client. When set, no task is created and driver_task_stack_size is ignored */
 } cdc_acm_host_driver_config_t;
 
 /**
@@ -122,6 +161,14 @@ typedef struct {
     cdc_acm_host_dev_callback_t event_cb; /**< Device's event callback function. Can be NULL */
     cdc_acm_data_callback_t data_cb;      /**< Device's data RX callback function. Can be NULL for write-only devices */
     void *user_arg;                       /**< User's argument that will be passed to the callbacks */
+    size_t in_transfer_count;             /**< Number of USB bulk in transfers of in_buffer_size in flight, so that the device is polled while the data are processed. 0 means 1 */
+    size_t out_transfer_count;            /**< Number of USB bulk out transfers of out_buffer_size for cdc_acm_host_data_tx_async(), 0 disables asynchronous transmit */
+    bool out_coalescing;                  /**< Append asynchronous writes to a transfer waiting for the transfer in flight, instead of sending each of them separately */
+    size_t rx_ringbuf_size;               /**< Size of the RX ring buffer read by cdc_acm_host_read(), at least in_transfer_count * in_buffer_size. 0 delivers the data to data_cb instead */
+    size_t rx_high_water;                 /**< Number of bytes in the RX ring buffer that triggers CDC_ACM_HOST_RX_HIGH_WATER event, 0 disables the event */
+    size_t event_task_stack_size;         /**< Stack size of the device's own task processing its received data and notifications. 0 processes them in the driver's task */
+    unsigned event_task_priority;         /**< Priority of the device's task */
+    int event_task_core_id;               /**< Core affinity of the device's task */
 } cdc_acm_host_device_config_t;
 
 /**
@@ -144,6 +191,31 @@ esp_err_t cdc_acm_host_install(const cdc_acm_host_driver_config_t *driver_config
  */
 esp_err_t cdc_acm_host_uninstall(void);
 
+/**
+ * @brief Handle the USB Host client events of the CDC-ACM driver
+ *
+ * Only for a driver installed with driver_task_stack_size set to 0, e.g. from a task shared with other USB Host class drivers.
+ * Must be called repeatedly while the driver is installed, and not any more when cdc_acm_host_uninstall() is called.
+ *
+ * @param[in] timeout_ms Maximum time to wait for an event, UINT32_MAX waits forever
+ * @return
+ *   - ESP_OK: Events were handled
+ *   - ESP_ERR_TIMEOUT: No event within the timeout
+ *   - ESP_ERR_INVALID_STATE: The driver is not installed, or is installed with its own task or client_hdl
+ */
+esp_err_t cdc_acm_host_handle_events(uint32_t timeout_ms);
+
+/**
+ * @brief Handle an event of the USB Host client given in client_hdl of the driver configuration
+ *
+ * Client event callback, e.g. added with usb_host_daemon_add_driver(). The transfer callbacks of the driver run in
+ * the task handling the events of this client. Events received while the driver is not installed are ignored.
+ *
+ * @param[in] event_msg Client event
+ * @param[in] arg       Unused
+ */
+void cdc_acm_host_handle_client_event(const usb_host_client_event_msg_t *event_msg, void *arg);
+
 /**
  * @brief Register new USB device callback
  *
@@ -160,6 +232,8 @@ esp_err_t cdc_acm_host_register_new_dev_callback(cdc_acm_new_dev_callback_t new_
  * CDC-ACM compliant device must contain either an Interface Association Descriptor or CDC-Union descriptor,
  * which are used for the driver's configuration.
  *
+ * Multiple devices can be opened and closed concurrently from different tasks.
+ *
  * @param[in] vid           Device's Vendor ID
  * @param[in] pid           Device's Product ID
  * @param[in] interface_idx Index of device's interface used for CDC-ACM communication
@@ -204,6 +278,78 @@ esp_err_t cdc_acm_host_close(cdc_acm_dev_hdl_t cdc_hdl);
  */
 esp_err_t cdc_acm_host_data_tx_blocking(cdc_acm_dev_hdl_t cdc_hdl, const uint8_t *data, size_t data_len, uint32_t timeout_ms);
 
+/**
+ * @brief Transmit data - asynchronous mode
+ *
+ * The data are copied to one of out_transfer_count transfers and queued, so that multiple transfers can be in flight.
+ * With out_coalescing, data written while a transfer is in flight is appended to the next transfer,
+ * which is sent when the transfer in flight completes.
+ *
+ * @param cdc_hdl CDC handle obtained from cdc_acm_host_open()
+ * @param[in] data       Data to be sent, can be released when this function returns
+ * @param[in] data_len   Data length, up to out_buffer_size
+ * @param[in] done_cb    Callback called when the data were sent, can be NULL
+ * @param[in] user_arg   Argument passed to done_cb
+ * @param[in] timeout_ms Timeout of waiting for a free transfer in [ms]
+ * @return esp_err_t
+ *   - ESP_OK: Data were queued, done_cb will be called
+ *   - ESP_ERR_NOT_SUPPORTED: Device was opened without asynchronous transfers
+ *   - ESP_ERR_INVALID_SIZE: data_len is bigger than out_buffer_size
+ *   - ESP_ERR_TIMEOUT: No free transfer within timeout_ms
+ */
+esp_err_t cdc_acm_host_data_tx_async(cdc_acm_dev_hdl_t cdc_hdl, const uint8_t *data, size_t data_len,
+                                     cdc_acm_tx_done_callback_t done_cb, void *user_arg, uint32_t timeout_ms);
+
+/**
+ * @brief Read received data from the RX ring buffer
+ *
+ * Received data are copied to the RX ring buffer in USB context. When the ring buffer is full,
+ * the IN transfers are not resubmitted until this function frees enough space, so no data are lost.
+ * This function must not be called from multiple tasks at once, nor concurrently with cdc_acm_host_close().
+ *
+ * @param cdc_hdl CDC handle obtained from cdc_acm_host_open()
+ * @param[out] buf       Buffer for the data
+ * @param[in]  buf_len   Size of the buffer
+ * @param[out] read_len  Number of bytes read
+ * @param[in]  timeout_ms Timeout of waiting for data in [ms]
+ * @return esp_err_t
+ *   - ESP_OK: At least one byte was read
+ *   - ESP_ERR_NOT_SUPPORTED: Device was opened without RX ring buffer
+ *   - ESP_ERR_TIMEOUT: No data received within timeout_ms
+ */
+esp_err_t cdc_acm_host_read(cdc_acm_dev_hdl_t cdc_hdl, uint8_t *buf, size_t buf_len, size_t *read_len, uint32_t timeout_ms);
+
+/**
+ * @brief Borrow received data from the RX ring buffer without copying them
+ *
+ * The data stay in the RX ring buffer and occupy its space until they are returned by cdc_acm_host_read_release().
+ * Only one part of the ring buffer can be borrowed at a time, cdc_acm_host_read() can't be used meanwhile.
+ * The same restrictions on calling tasks as for cdc_acm_host_read() apply.
+ *
+ * @param cdc_hdl CDC handle obtained from cdc_acm_host_open()
+ * @param[out] data       Received data
+ * @param[out] data_len   Number of received bytes, can be less than available if the data wrap around the end of the ring buffer
+ * @param[in]  max_len    Maximum number of bytes to borrow
+ * @param[in]  timeout_ms Timeout of waiting for data in [ms]
+ * @return esp_err_t
+ *   - ESP_OK: At least one byte was borrowed
+ *   - ESP_ERR_NOT_SUPPORTED: Device was opened without RX ring buffer
+ *   - ESP_ERR_INVALID_STATE: Previously borrowed data were not released
+ *   - ESP_ERR_TIMEOUT: No data received within timeout_ms
+ */
+esp_err_t cdc_acm_host_read_acquire(cdc_acm_dev_hdl_t cdc_hdl, const uint8_t **data, size_t *data_len, size_t max_len, uint32_t timeout_ms);
+
+/**
+ * @brief Return data borrowed by cdc_acm_host_read_acquire() to the RX ring buffer
+ *
+ * @param cdc_hdl CDC handle obtained from cdc_acm_host_open()
+ * @param[in] data Data returned by cdc_acm_host_read_acquire()
+ * @return esp_err_t
+ *   - ESP_OK: Data released
+ *   - ESP_ERR_INVALID_ARG: Data were not borrowed
+ */
+esp_err_t cdc_acm_host_read_release(cdc_acm_dev_hdl_t cdc_hdl, const uint8_t *data);
+
 /**
  * @brief SetLineCoding function
  *
@@ -260,6 +406,23 @@ esp_err_t cdc_acm_host_send_break(cdc_acm_dev_hdl_t cdc_hdl, uint16_t duration_m
  */
 void cdc_acm_host_desc_print(cdc_acm_dev_hdl_t cdc_hdl);
 
+/**
+ * @brief Get statistics of the device
+ *
+ * @param cdc_hdl    CDC handle obtained from cdc_acm_host_open()
+ * @param[out] stats Statistics since the device was opened or the statistics were reset
+ * @return esp_err_t
+ */
+esp_err_t cdc_acm_host_get_stats(cdc_acm_dev_hdl_t cdc_hdl, cdc_acm_host_stats_t *stats);
+
+/**
+ * @brief Reset statistics of the device
+ *
+ * @param cdc_hdl CDC handle obtained from cdc_acm_host_open()
+ * @return esp_err_t
+ */
+esp_err_t cdc_acm_host_reset_stats(cdc_acm_dev_hdl_t cdc_hdl);
+
 /**
  * @brief Get protocols defined in USB-CDC interface descriptors
  *
@@ -307,6 +470,31 @@ public:
         return cdc_acm_host_data_tx_blocking(this->cdc_hdl, data, len, timeout_ms);
     }
 
+    inline esp_err_t tx_async(const uint8_t *data, size_t len, cdc_acm_tx_done_callback_t done_cb = NULL, void *user_arg = NULL, uint32_t timeout_ms = 100)
+    {
+        return cdc_acm_host_data_tx_async(this->cdc_hdl, data, len, done_cb, user_arg, timeout_ms);
+    }
+
+    inline esp_err_t read(uint8_t *buf, size_t buf_len, size_t *read_len, uint32_t timeout_ms = 100)
+    {
+        return cdc_acm_host_read(this->cdc_hdl, buf, buf_len, read_len, timeout_ms);
+    }
+
+    inline esp_err_t read_acquire(const uint8_t **data, size_t *data_len, size_t max_len, uint32_t timeout_ms = 100)
+    {
+        return cdc_acm_host_read_acquire(this->cdc_hdl, data, data_len, max_len, timeout_ms);
+    }
+
+    inline esp_err_t read_release(const uint8_t *data)
+    {
+        return cdc_acm_host_read_release(this->cdc_hdl, data);
+    }
+
+    inline esp_err_t get_stats(cdc_acm_host_stats_t *stats)
+    {
+        return cdc_acm_host_get_stats(this->cdc_hdl, stats);
+    }
+
     inline esp_err_t open(uint16_t vid, uint16_t pid, uint8_t interface_idx, const cdc_acm_host_device_config_t *dev_config)
     {
         return cdc_acm_host_open(vid, pid, interface_idx, dev_config, &this->cdc_hdl);
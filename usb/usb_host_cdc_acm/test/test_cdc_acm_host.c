@@ -11,12 +11,14 @@
 #include "esp_system.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_err.h"
 
 #include "esp_private/usb_phy.h"
 #include "usb/usb_host.h"
 #include "usb/cdc_acm_host.h"
+#include "usb/usb_host_daemon.h"
 #include <string.h>
 
 #include "esp_intr_alloc.h"
@@ -131,6 +133,7 @@ static void notif_cb(const cdc_acm_host_dev_event_data_t *event, void *user_ctx)
         }
         break;
     case CDC_ACM_HOST_NETWORK_CONNECTION:
+    case CDC_ACM_HOST_RX_HIGH_WATER:
         break;
     case CDC_ACM_HOST_DEVICE_DISCONNECTED:
         printf("Disconnection event\n");
@@ -520,6 +523,381 @@ TEST_CASE("rx_buffer", "[cdc_acm]")
     vTaskDelay(20);
 }
 
+/* Test receiving with multiple IN transfers in flight, in normal and 'not processed' mode */
+TEST_CASE("rx_multiple_transfers", "[cdc_acm]")
+{
+    test_install_cdc_driver();
+    nb_of_responses = 0;
+
+    cdc_acm_dev_hdl_t cdc_dev;
+    cdc_acm_host_device_config_t dev_config = {
+        .connection_timeout_ms = 500,
+        .out_buffer_size = 64,
+        .event_cb = notif_cb,
+        .data_cb = handle_rx,
+        .user_arg = tx_buf,
+        .in_transfer_count = 3,
+    };
+
+    // 1. Every response is received with the transfers rotating
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_open(0x303A, 0x4002, 0, &dev_config, &cdc_dev));
+    TEST_ASSERT_NOT_NULL(cdc_dev);
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_data_tx_blocking(cdc_dev, tx_buf, sizeof(tx_buf), 1000));
+        vTaskDelay(5);
+    }
+    vTaskDelay(20);
+    TEST_ASSERT_EQUAL(10, nb_of_responses);
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_close(cdc_dev));
+
+    // 2. Data not processed is appended across transfers until the buffer overflows
+    bool process_data = false;
+    dev_config.in_buffer_size = 512;
+    dev_config.data_cb = handle_rx_advanced;
+    dev_config.user_arg = &process_data;
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_open(0x303A, 0x4002, 0, &dev_config, &cdc_dev));
+    uint8_t tx_data[64] = {0};
+    for (int i = 0; i < 7; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_data_tx_blocking(cdc_dev, tx_data, sizeof(tx_data), 1000));
+        vTaskDelay(5);
+    }
+    TEST_ASSERT_FALSE_MESSAGE(rx_overflow, "RX overflowed");
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_data_tx_blocking(cdc_dev, tx_data, sizeof(tx_data), 1000));
+    vTaskDelay(5);
+    TEST_ASSERT_TRUE_MESSAGE(rx_overflow, "RX did not overflow");
+    rx_overflow = false;
+
+    // Clean-up
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_close(cdc_dev));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_uninstall());
+    vTaskDelay(20);
+}
+
+static void tx_done_cb(cdc_acm_dev_hdl_t cdc_hdl, esp_err_t result, void *arg)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, result);
+    (*(int *)arg)++;
+}
+
+/* Test asynchronous transmit with multiple OUT transfers and coalescing of small writes */
+TEST_CASE("tx_async", "[cdc_acm]")
+{
+    test_install_cdc_driver();
+    int tx_done = 0;
+
+    cdc_acm_dev_hdl_t cdc_dev;
+    const cdc_acm_host_device_config_t dev_config = {
+        .connection_timeout_ms = 500,
+        .out_buffer_size = 64,
+        .event_cb = notif_cb,
+        .data_cb = NULL,
+        .user_arg = NULL,
+        .out_transfer_count = 3,
+        .out_coalescing = true,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_open(0x303A, 0x4002, 0, &dev_config, &cdc_dev));
+    TEST_ASSERT_NOT_NULL(cdc_dev);
+
+    uint8_t too_big[65] = {0};
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, cdc_acm_host_data_tx_async(cdc_dev, too_big, sizeof(too_big), NULL, NULL, 0));
+
+    for (int i = 0; i < 50; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_data_tx_async(cdc_dev, tx_buf, sizeof(tx_buf), tx_done_cb, &tx_done, 1000));
+    }
+    vTaskDelay(50); // Wait until all transfers are done
+    TEST_ASSERT_EQUAL(50, tx_done);
+
+    // Clean-up
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_close(cdc_dev));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_uninstall());
+    vTaskDelay(20);
+}
+
+/* Test reading received data from the RX ring buffer */
+TEST_CASE("rx_ringbuf", "[cdc_acm]")
+{
+    test_install_cdc_driver();
+
+    cdc_acm_dev_hdl_t cdc_dev;
+    const cdc_acm_host_device_config_t dev_config = {
+        .connection_timeout_ms = 500,
+        .out_buffer_size = 64,
+        .event_cb = notif_cb,
+        .data_cb = NULL,
+        .user_arg = NULL,
+        .in_transfer_count = 2,
+        .rx_ringbuf_size = 256,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_open(0x303A, 0x4002, 0, &dev_config, &cdc_dev));
+    TEST_ASSERT_NOT_NULL(cdc_dev);
+
+    uint8_t rx_data[64];
+    size_t rx_len;
+    TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, cdc_acm_host_read(cdc_dev, rx_data, sizeof(rx_data), &rx_len, 10));
+
+    // Responses are kept in the ring buffer until they are read
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_data_tx_blocking(cdc_dev, tx_buf, sizeof(tx_buf), 1000));
+    }
+    vTaskDelay(20);
+    for (int i = 0; i < 5; i++) {
+        size_t total = 0;
+        while (total < sizeof(tx_buf)) {
+            TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_read(cdc_dev, rx_data + total, sizeof(tx_buf) - total, &rx_len, 100));
+            total += rx_len;
+        }
+        TEST_ASSERT_EQUAL_MEMORY(tx_buf, rx_data, sizeof(tx_buf));
+    }
+
+    // Received data can be borrowed from the ring buffer without copying
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_data_tx_blocking(cdc_dev, tx_buf, sizeof(tx_buf), 1000));
+    const uint8_t *borrowed;
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_read_acquire(cdc_dev, &borrowed, &rx_len, sizeof(tx_buf), 100));
+    TEST_ASSERT_EQUAL_MEMORY(tx_buf, borrowed, rx_len);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, cdc_acm_host_read(cdc_dev, rx_data, sizeof(rx_data), &rx_len, 10));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, cdc_acm_host_read_release(cdc_dev, rx_data));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_read_release(cdc_dev, borrowed));
+
+    // Clean-up
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_close(cdc_dev));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_uninstall());
+    vTaskDelay(20);
+}
+
+/* Test per-device statistics */
+TEST_CASE("stats", "[cdc_acm]")
+{
+    nb_of_responses = 0;
+    test_install_cdc_driver();
+
+    cdc_acm_dev_hdl_t cdc_dev;
+    const cdc_acm_host_device_config_t dev_config = {
+        .connection_timeout_ms = 500,
+        .out_buffer_size = 64,
+        .event_cb = notif_cb,
+        .data_cb = handle_rx,
+        .user_arg = tx_buf,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_open(0x303A, 0x4002, 0, &dev_config, &cdc_dev));
+    TEST_ASSERT_NOT_NULL(cdc_dev);
+
+    cdc_acm_host_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, cdc_acm_host_get_stats(cdc_dev, NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_get_stats(cdc_dev, &stats));
+    TEST_ASSERT_EQUAL(0, stats.tx_transfers);
+
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_data_tx_blocking(cdc_dev, tx_buf, sizeof(tx_buf), 1000));
+    }
+    vTaskDelay(20);
+
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_get_stats(cdc_dev, &stats));
+    TEST_ASSERT_EQUAL(5, stats.tx_transfers);
+    TEST_ASSERT_EQUAL(5 * sizeof(tx_buf), stats.tx_bytes);
+    TEST_ASSERT_EQUAL(0, stats.tx_errors);
+    TEST_ASSERT_EQUAL(nb_of_responses, stats.rx_transfers);
+    TEST_ASSERT_EQUAL(5 * sizeof(tx_buf), stats.rx_bytes);
+    uint32_t histogram_sum = 0;
+    for (int i = 0; i < CDC_ACM_STATS_HISTOGRAM_BINS; i++) {
+        histogram_sum += stats.tx_wait_histogram[i];
+    }
+    TEST_ASSERT_EQUAL(5, histogram_sum);
+    TEST_ASSERT_LESS_OR_EQUAL(stats.tx_wait_max_us, stats.tx_wait_avg_us);
+
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_reset_stats(cdc_dev));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_get_stats(cdc_dev, &stats));
+    TEST_ASSERT_EQUAL(0, stats.tx_transfers);
+    TEST_ASSERT_EQUAL(0, stats.rx_bytes);
+
+    // Clean-up
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_close(cdc_dev));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_uninstall());
+    vTaskDelay(20);
+}
+
+typedef struct {
+    uint8_t interface_idx;
+    const cdc_acm_host_device_config_t *dev_config;
+    cdc_acm_dev_hdl_t cdc_dev;
+    esp_err_t result;
+    SemaphoreHandle_t done;
+} open_task_args_t;
+
+static void open_task(void *arg)
+{
+    open_task_args_t *args = (open_task_args_t *)arg;
+    args->result = cdc_acm_host_open(0x303A, 0x4002, args->interface_idx, args->dev_config, &args->cdc_dev);
+    xSemaphoreGive(args->done);
+    vTaskDelete(NULL);
+}
+
+/* Test opening two devices concurrently, each of them processing its events in its own task */
+TEST_CASE("concurrent_open_event_task", "[cdc_acm]")
+{
+    nb_of_responses = 0;
+    nb_of_responses2 = 0;
+    test_install_cdc_driver();
+
+    const cdc_acm_host_device_config_t dev_config1 = {
+        .connection_timeout_ms = 1000,
+        .out_buffer_size = 64,
+        .event_cb = notif_cb,
+        .data_cb = handle_rx,
+        .user_arg = tx_buf,
+        .event_task_stack_size = 4096,
+        .event_task_priority = 5,
+        .event_task_core_id = 0,
+    };
+    cdc_acm_host_device_config_t dev_config2 = dev_config1;
+    dev_config2.data_cb = handle_rx2;
+    dev_config2.user_arg = tx_buf2;
+
+    open_task_args_t args[2] = {
+        {.interface_idx = 0, .dev_config = &dev_config1, .done = xSemaphoreCreateCounting(2, 0)},
+        {.interface_idx = 2, .dev_config = &dev_config2},
+    };
+    TEST_ASSERT_NOT_NULL(args[0].done);
+    args[1].done = args[0].done;
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(open_task, "open", 4096, &args[i], 4, NULL));
+    }
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(args[0].done, pdMS_TO_TICKS(2000)));
+    }
+    vSemaphoreDelete(args[0].done);
+    TEST_ASSERT_EQUAL(ESP_OK, args[0].result);
+    TEST_ASSERT_EQUAL(ESP_OK, args[1].result);
+
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_data_tx_blocking(args[0].cdc_dev, tx_buf, sizeof(tx_buf), 1000));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_data_tx_blocking(args[1].cdc_dev, tx_buf2, sizeof(tx_buf2), 1000));
+    vTaskDelay(100); // Wait for RX callbacks
+    TEST_ASSERT_EQUAL(1, nb_of_responses);
+    TEST_ASSERT_EQUAL(1, nb_of_responses2);
+
+    // Driver cannot be uninstalled while there are open devices
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, cdc_acm_host_uninstall());
+
+    // Clean-up
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_close(args[0].cdc_dev));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_close(args[1].cdc_dev));
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_uninstall());
+    vTaskDelay(20);
+}
+
+static esp_err_t cdc_acm_daemon_handle_events(void *arg, uint32_t timeout_ms)
+{
+    return cdc_acm_host_handle_events(timeout_ms);
+}
+
+/* CDC-ACM driver without its own task, its events are handled by the USB Host daemon */
+TEST_CASE("usb_host_daemon", "[cdc_acm]")
+{
+    nb_of_responses = 0;
+    usb_phy_config_t phy_config = {
+        .controller = USB_PHY_CTRL_OTG,
+        .target = USB_PHY_TARGET_INT,
+        .otg_mode = USB_OTG_MODE_HOST,
+        .otg_speed = USB_PHY_SPEED_UNDEFINED,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, usb_new_phy(&phy_config, &phy_hdl));
+    const usb_host_config_t host_config = {
+        .skip_phy_setup = true,
+        .intr_flags = ESP_INTR_FLAG_LEVEL1,
+    };
+    usb_host_daemon_config_t daemon_config = USB_HOST_DAEMON_CONFIG_DEFAULT();
+    daemon_config.host_config = &host_config;
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_install(&daemon_config));
+
+    const cdc_acm_host_driver_config_t driver_config = {
+        .driver_task_stack_size = 0,
+        .new_dev_cb = NULL,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_install(&driver_config));
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_add_client(cdc_acm_daemon_handle_events, NULL));
+
+    const cdc_acm_host_device_config_t dev_config = {
+        .connection_timeout_ms = 1000,
+        .out_buffer_size = 64,
+        .event_cb = notif_cb,
+        .data_cb = handle_rx,
+        .user_arg = tx_buf,
+    };
+    cdc_acm_dev_hdl_t cdc_dev = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_open(0x303A, 0x4002, 0, &dev_config, &cdc_dev));
+    TEST_ASSERT_NOT_NULL(cdc_dev);
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_data_tx_blocking(cdc_dev, tx_buf, sizeof(tx_buf), 1000));
+    vTaskDelay(100); // Wait until the response is processed
+    TEST_ASSERT_EQUAL(1, nb_of_responses);
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_close(cdc_dev));
+
+    // A notification pending on the calling task does not end the removal early, nor is it consumed
+    xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_remove_client(cdc_acm_daemon_handle_events, NULL));
+    TEST_ASSERT_EQUAL(1, ulTaskNotifyTake(pdTRUE, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, usb_host_daemon_remove_client(cdc_acm_daemon_handle_events, NULL));
+
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_uninstall());
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_uninstall());
+    TEST_ASSERT_EQUAL(ESP_OK, usb_del_phy(phy_hdl));
+    phy_hdl = NULL;
+    vTaskDelay(20);
+}
+
+/* CDC-ACM driver using the client of the USB Host daemon, which blocks until its events arrive */
+TEST_CASE("usb_host_daemon_driver", "[cdc_acm]")
+{
+    nb_of_responses = 0;
+    usb_phy_config_t phy_config = {
+        .controller = USB_PHY_CTRL_OTG,
+        .target = USB_PHY_TARGET_INT,
+        .otg_mode = USB_OTG_MODE_HOST,
+        .otg_speed = USB_PHY_SPEED_UNDEFINED,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, usb_new_phy(&phy_config, &phy_hdl));
+    const usb_host_config_t host_config = {
+        .skip_phy_setup = true,
+        .intr_flags = ESP_INTR_FLAG_LEVEL1,
+    };
+    usb_host_daemon_config_t daemon_config = USB_HOST_DAEMON_CONFIG_DEFAULT();
+    daemon_config.host_config = &host_config;
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_install(&daemon_config));
+    TEST_ASSERT_NOT_NULL(usb_host_daemon_get_client());
+
+    const cdc_acm_host_driver_config_t driver_config = {
+        .new_dev_cb = NULL,
+        .client_hdl = usb_host_daemon_get_client(),
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_install(&driver_config));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, cdc_acm_host_handle_events(0));
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_add_driver(cdc_acm_host_handle_client_event, NULL));
+
+    const cdc_acm_host_device_config_t dev_config = {
+        .connection_timeout_ms = 1000,
+        .out_buffer_size = 64,
+        .event_cb = notif_cb,
+        .data_cb = handle_rx,
+        .user_arg = tx_buf,
+    };
+    cdc_acm_dev_hdl_t cdc_dev = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_open(0x303A, 0x4002, 0, &dev_config, &cdc_dev));
+    TEST_ASSERT_NOT_NULL(cdc_dev);
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_data_tx_blocking(cdc_dev, tx_buf, sizeof(tx_buf), 1000));
+    vTaskDelay(100); // Wait until the response is processed
+    TEST_ASSERT_EQUAL(1, nb_of_responses);
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_close(cdc_dev));
+
+    // The daemon is blocked on its client without timeout: the removal unblocks it
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_remove_driver(cdc_acm_host_handle_client_event, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, usb_host_daemon_remove_driver(cdc_acm_host_handle_client_event, NULL));
+
+    TEST_ASSERT_EQUAL(ESP_OK, cdc_acm_host_uninstall());
+    TEST_ASSERT_EQUAL(ESP_OK, usb_host_daemon_uninstall());
+    TEST_ASSERT_NULL(usb_host_daemon_get_client());
+    TEST_ASSERT_EQUAL(ESP_OK, usb_del_phy(phy_hdl));
+    phy_hdl = NULL;
+    vTaskDelay(20);
+}
+
 /* Following test case implements dual CDC-ACM USB device that can be used as mock device for CDC-ACM Host tests */
 void run_usb_dual_cdc_device(void);
 TEST_CASE("mock_device_app", "[cdc_acm_device][ignore]")
@@ -0,0 +1,172 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "usb/usb_host.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define USB_HOST_DAEMON_MAX_CLIENTS 8   /**< Maximum number of clients and drivers added to the daemon */
+
+/**
+ * @brief Event handling function of a class driver
+ *
+ * Handles the USB Host client events of the driver, waiting for them at most timeout_ms,
+ * e.g. a wrapper of cdc_acm_host_handle_events(), msc_host_handle_events() or hid_host_handle_events().
+ *
+ * @param[in] arg        Argument given to usb_host_daemon_add_client()
+ * @param[in] timeout_ms Maximum time to wait for an event
+ * @return ESP_FAIL if the driver is being uninstalled: the client is removed and the function is not called any more.
+ *         Other values are ignored.
+ */
+typedef esp_err_t (*usb_host_daemon_client_fn_t)(void *arg, uint32_t timeout_ms);
+
+/**
+ * @brief Configuration of the USB Host daemon
+ */
+typedef struct {
+    const usb_host_config_t *host_config;  /**< Configuration of the USB Host Library installed by the daemon. NULL if the application installs it */
+    size_t task_stack_size;                /**< Stack size of the daemon task, large enough for the callbacks of the class drivers */
+    unsigned task_priority;                /**< Priority of the daemon task */
+    int task_core_id;                      /**< Core affinity of the daemon task, tskNO_AFFINITY for any core */
+    uint32_t poll_period_ms;               /**< Maximum time between two calls of the event handling function of a client */
+    size_t lib_task_stack_size;            /**< Stack size of the task handling the USB Host Library events, 0 for task_stack_size */
+} usb_host_daemon_config_t;
+
+/**
+ * @brief Default configuration, the USB Host Library is installed by the application
+ */
+#define USB_HOST_DAEMON_CONFIG_DEFAULT() {  \
+    .host_config = NULL,                    \
+    .task_stack_size = 4096,                \
+    .task_priority = 5,                     \
+    .task_core_id = tskNO_AFFINITY,         \
+    .poll_period_ms = 10,                   \
+    .lib_task_stack_size = 2048,            \
+}
+
+/**
+ * @brief Install the USB Host daemon
+ *
+ * Registers one USB Host client, whose events are dispatched to the class drivers added with
+ * usb_host_daemon_add_driver(), and creates two tasks: one blocked on the USB Host Library events, and one blocked
+ * on the events of the daemon client, which also polls the clients added with usb_host_daemon_add_client().
+ * This replaces one task per class driver and one for the USB Host Library.
+ * When all the clients are deregistered from the USB Host Library, all the devices are freed.
+ *
+ * @param[in] config Configuration of the daemon
+ * @return
+ *   - ESP_OK: The daemon is running
+ *   - ESP_ERR_INVALID_ARG: Invalid configuration
+ *   - ESP_ERR_INVALID_STATE: The daemon is already installed
+ *   - ESP_ERR_NO_MEM: Not enough memory
+ *   - Other: Error of usb_host_install()
+ */
+esp_err_t usb_host_daemon_install(const usb_host_daemon_config_t *config);
+
+/**
+ * @brief Uninstall the USB Host daemon
+ *
+ * All the clients and drivers must be removed before, and the devices opened through the daemon client closed.
+ * If the daemon installed the USB Host Library, the devices are freed
+ * and the library is uninstalled.
+ *
+ * @return
+ *   - ESP_OK: The daemon is uninstalled
+ *   - ESP_ERR_INVALID_STATE: The daemon is not installed, or clients are still added
+ *   - Other: Error of usb_host_client_deregister() or usb_host_uninstall()
+ */
+esp_err_t usb_host_daemon_uninstall(void);
+
+/**
+ * @brief Get the USB Host client of the daemon
+ *
+ * Class drivers added with usb_host_daemon_add_driver() open their devices and submit their transfers with this
+ * client, e.g. through the client_hdl member of cdc_acm_host_driver_config_t. A device can be opened only once
+ * per client: the interfaces of a composite device handled by different class drivers need the polled clients of
+ * usb_host_daemon_add_client().
+ *
+ * @return Client handle, NULL if the daemon is not installed
+ */
+usb_host_client_handle_t usb_host_daemon_get_client(void);
+
+/**
+ * @brief Add a class driver using the client of the daemon
+ *
+ * event_cb is called from the daemon task for every event of the daemon client, and the transfer callbacks of the
+ * devices opened with usb_host_daemon_get_client() run in the same task. While only such drivers are added, the
+ * daemon task blocks until an event arrives: the events are handled without the delay nor the periodic wake-ups
+ * of the polled clients.
+ *
+ * @param[in] event_cb Client event callback of the class driver, e.g. cdc_acm_host_handle_client_event()
+ * @param[in] arg      Argument of event_cb
+ * @return
+ *   - ESP_OK: The driver is added
+ *   - ESP_ERR_INVALID_ARG: event_cb is NULL
+ *   - ESP_ERR_INVALID_STATE: The daemon is not installed
+ *   - ESP_ERR_NO_MEM: USB_HOST_DAEMON_MAX_CLIENTS clients and drivers are already added
+ */
+esp_err_t usb_host_daemon_add_driver(usb_host_client_event_cb_t event_cb, void *arg);
+
+/**
+ * @brief Remove a class driver added with usb_host_daemon_add_driver()
+ *
+ * Once this function returns, event_cb is not called any more. Must not be called from the daemon task.
+ *
+ * @param[in] event_cb Client event callback of the class driver
+ * @param[in] arg      Argument of event_cb
+ * @return
+ *   - ESP_OK: The driver is removed
+ *   - ESP_ERR_INVALID_ARG: event_cb is NULL
+ *   - ESP_ERR_INVALID_STATE: The daemon is not installed, or called from the daemon task
+ *   - ESP_ERR_NOT_FOUND: The driver was not added
+ */
+esp_err_t usb_host_daemon_remove_driver(usb_host_client_event_cb_t event_cb, void *arg);
+
+/**
+ * @brief Add a class driver with its own USB Host client, polled by the daemon task
+ *
+ * The class driver must be installed without its own event handling task. The polled clients and the daemon client
+ * are served in turn: each of them blocks the daemon for at most poll_period_ms / (number of polled clients + 1),
+ * so its events are handled within poll_period_ms. While a polled client is added, an event can wait up to
+ * poll_period_ms and the daemon task wakes up (number of polled clients + 1) times per poll period when idle.
+ * Prefer usb_host_daemon_add_driver() for the drivers supporting it.
+ *
+ * @param[in] handle_events Event handling function of the class driver
+ * @param[in] arg           Argument of handle_events
+ * @return
+ *   - ESP_OK: The client is added
+ *   - ESP_ERR_INVALID_ARG: handle_events is NULL
+ *   - ESP_ERR_INVALID_STATE: The daemon is not installed
+ *   - ESP_ERR_NO_MEM: USB_HOST_DAEMON_MAX_CLIENTS clients are already added
+ */
+esp_err_t usb_host_daemon_add_client(usb_host_daemon_client_fn_t handle_events, void *arg);
+
+/**
+ * @brief Remove a class driver added with usb_host_daemon_add_client()
+ *
+ * Once this function returns, handle_events is not called any more. Must not be called from handle_events,
+ * nor from a callback of a class driver called by it.
+ *
+ * @param[in] handle_events Event handling function of the class driver
+ * @param[in] arg           Argument of handle_events
+ * @return
+ *   - ESP_OK: The client is removed
+ *   - ESP_ERR_INVALID_STATE: The daemon is not installed, or called from the daemon task
+ *   - ESP_ERR_NOT_FOUND: The client was not added
+ */
+esp_err_t usb_host_daemon_remove_client(usb_host_daemon_client_fn_t handle_events, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
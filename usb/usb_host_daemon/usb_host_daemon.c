@@ -0,0 +1,356 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "usb/usb_host.h"
+#include "usb/usb_host_daemon.h"
+
+static const char *TAG = "usb_host_daemon";
+
+static portMUX_TYPE daemon_lock = portMUX_INITIALIZER_UNLOCKED;
+#define DAEMON_ENTER_CRITICAL()    portENTER_CRITICAL(&daemon_lock)
+#define DAEMON_EXIT_CRITICAL()     portEXIT_CRITICAL(&daemon_lock)
+
+typedef struct {
+    usb_host_daemon_client_fn_t handle_events;  // Client with its own USB Host client, polled by the daemon
+    usb_host_client_event_cb_t event_cb;        // Driver using the client of the daemon
+    void *arg;
+    SemaphoreHandle_t removed;  // Given once the entry is removed, NULL if not being removed
+} daemon_client_t;
+
+typedef struct {
+    TaskHandle_t task;          // Events of the daemon client and of the polled clients
+    TaskHandle_t lib_task;      // Events of the USB Host Library
+    SemaphoreHandle_t done;     // Given by each task when it exits
+    usb_host_client_handle_t client_hdl;
+    TickType_t poll_period;
+    bool host_installed;
+    volatile bool exit;
+    volatile bool lib_exit;
+    esp_err_t uninstall_err;
+    daemon_client_t clients[USB_HOST_DAEMON_MAX_CLIENTS];
+} usb_host_daemon_t;
+
+static usb_host_daemon_t *s_daemon = NULL;
+
+static void daemon_uninstall_host(usb_host_daemon_t *daemon)
+{
+    if (usb_host_device_free_all() == ESP_ERR_NOT_FINISHED) {
+        // The devices are freed by the event handling of the library
+        for (int i = 0; i < 10; i++) {
+            uint32_t event_flags = 0;
+            usb_host_lib_handle_events(pdMS_TO_TICKS(100), &event_flags);
+            if (event_flags & USB_HOST_LIB_EVENT_FLAGS_ALL_FREE) {
+                break;
+            }
+        }
+    }
+    daemon->uninstall_err = usb_host_uninstall();
+}
+
+static void daemon_lib_task(void *arg)
+{
+    usb_host_daemon_t *daemon = (usb_host_daemon_t *)arg;
+
+    while (!daemon->lib_exit) {
+        uint32_t event_flags = 0;
+        usb_host_lib_handle_events(portMAX_DELAY, &event_flags);
+        if (event_flags & USB_HOST_LIB_EVENT_FLAGS_NO_CLIENTS) {
+            ESP_LOGD(TAG, "No more clients: free all devices");
+            usb_host_device_free_all();
+        }
+    }
+
+    if (daemon->host_installed) {
+        daemon_uninstall_host(daemon);
+    }
+    xSemaphoreGive(daemon->done);
+    vTaskDelete(NULL);
+}
+
+// Called from usb_host_client_handle_events() of the daemon client
+static void daemon_client_event_cb(const usb_host_client_event_msg_t *event_msg, void *arg)
+{
+    usb_host_daemon_t *daemon = (usb_host_daemon_t *)arg;
+
+    for (int i = 0; i < USB_HOST_DAEMON_MAX_CLIENTS; i++) {
+        DAEMON_ENTER_CRITICAL();
+        usb_host_client_event_cb_t event_cb = daemon->clients[i].event_cb;
+        void *driver_arg = daemon->clients[i].arg;
+        DAEMON_EXIT_CRITICAL();
+        if (event_cb) {
+            event_cb(event_msg, driver_arg);
+        }
+    }
+}
+
+static void daemon_task(void *arg)
+{
+    usb_host_daemon_t *daemon = (usb_host_daemon_t *)arg;
+
+    while (!daemon->exit) {
+        int count = 0;
+        DAEMON_ENTER_CRITICAL();
+        for (int i = 0; i < USB_HOST_DAEMON_MAX_CLIENTS; i++) {
+            count += (daemon->clients[i].handle_events != NULL);
+        }
+        DAEMON_EXIT_CRITICAL();
+
+        if (count == 0) {
+            // Only the drivers of the daemon client: sleep until their next event, or usb_host_client_unblock()
+            usb_host_client_handle_events(daemon->client_hdl, portMAX_DELAY);
+        } else {
+            // The daemon client and every polled client wait in turn, so that each of them is served within the poll period
+            const TickType_t slice = MAX(daemon->poll_period / (count + 1), 1);
+            usb_host_client_handle_events(daemon->client_hdl, slice);
+
+            for (int i = 0; i < USB_HOST_DAEMON_MAX_CLIENTS; i++) {
+                DAEMON_ENTER_CRITICAL();
+                usb_host_daemon_client_fn_t handle_events = daemon->clients[i].handle_events;
+                void *client_arg = daemon->clients[i].arg;
+                DAEMON_EXIT_CRITICAL();
+                if (handle_events && handle_events(client_arg, slice * portTICK_PERIOD_MS) == ESP_FAIL) {
+                    // The driver is being uninstalled, as msc_host_handle_events() reports it
+                    DAEMON_ENTER_CRITICAL();
+                    if (daemon->clients[i].removed == NULL) {
+                        daemon->clients[i].handle_events = NULL;
+                        daemon->clients[i].arg = NULL;
+                    }
+                    DAEMON_EXIT_CRITICAL();
+                }
+            }
+        }
+
+        // Clients and drivers removed during the turn are not called any more from here
+        for (int i = 0; i < USB_HOST_DAEMON_MAX_CLIENTS; i++) {
+            DAEMON_ENTER_CRITICAL();
+            SemaphoreHandle_t removed = daemon->clients[i].removed;
+            if (removed) {
+                daemon->clients[i].handle_events = NULL;
+                daemon->clients[i].event_cb = NULL;
+                daemon->clients[i].arg = NULL;
+                daemon->clients[i].removed = NULL;
+            }
+            DAEMON_EXIT_CRITICAL();
+            if (removed) {
+                xSemaphoreGive(removed);
+            }
+        }
+    }
+
+    // The devices opened through the daemon client must have been closed by their drivers
+    daemon->uninstall_err = usb_host_client_deregister(daemon->client_hdl);
+    xSemaphoreGive(daemon->done);
+    vTaskDelete(NULL);
+}
+
+esp_err_t usb_host_daemon_install(const usb_host_daemon_config_t *config)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && config->poll_period_ms > 0, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(s_daemon == NULL, ESP_ERR_INVALID_STATE, TAG, "daemon already installed");
+
+    usb_host_daemon_t *daemon = calloc(1, sizeof(usb_host_daemon_t));
+    ESP_RETURN_ON_FALSE(daemon, ESP_ERR_NO_MEM, TAG, "no mem for daemon");
+    daemon->poll_period = MAX(pdMS_TO_TICKS(config->poll_period_ms), 1);
+    daemon->done = xSemaphoreCreateCounting(2, 0);
+    ESP_GOTO_ON_FALSE(daemon->done, ESP_ERR_NO_MEM, err, TAG, "no mem for daemon semaphore");
+
+    if (config->host_config) {
+        ESP_GOTO_ON_ERROR(usb_host_install(config->host_config), err, TAG, "USB Host install failed");
+        daemon->host_installed = true;
+    }
+    const usb_host_client_config_t client_config = {
+        .is_synchronous = false,
+        .max_num_event_msg = USB_HOST_DAEMON_MAX_CLIENTS,  // One pending event per driver
+        .async.client_event_callback = daemon_client_event_cb,
+        .async.callback_arg = daemon,
+    };
+    ESP_GOTO_ON_ERROR(usb_host_client_register(&client_config, &daemon->client_hdl), err, TAG,
+                      "USB Host client register failed");
+
+    DAEMON_ENTER_CRITICAL();
+    if (s_daemon) {
+        DAEMON_EXIT_CRITICAL();
+        ret = ESP_ERR_INVALID_STATE;
+        goto err;
+    }
+    s_daemon = daemon;
+    DAEMON_EXIT_CRITICAL();
+
+    const size_t lib_task_stack_size = config->lib_task_stack_size ? config->lib_task_stack_size : config->task_stack_size;
+    BaseType_t task_created = xTaskCreatePinnedToCore(daemon_lib_task, "usb_daemon_lib", lib_task_stack_size, daemon,
+                              config->task_priority, &daemon->lib_task, config->task_core_id);
+    if (task_created == pdPASS) {
+        task_created = xTaskCreatePinnedToCore(daemon_task, "usb_daemon", config->task_stack_size, daemon,
+                                               config->task_priority, &daemon->task, config->task_core_id);
+        if (task_created != pdPASS) {
+            // The library task uninstalls the library on exit, once no client is left
+            usb_host_client_deregister(daemon->client_hdl);
+            daemon->client_hdl = NULL;
+            daemon->lib_exit = true;
+            usb_host_lib_unblock();
+            xSemaphoreTake(daemon->done, portMAX_DELAY);
+            daemon->host_installed = false;
+        }
+    }
+    if (task_created != pdPASS) {
+        DAEMON_ENTER_CRITICAL();
+        s_daemon = NULL;
+        DAEMON_EXIT_CRITICAL();
+        ESP_LOGE(TAG, "no mem for daemon task");
+        ret = ESP_ERR_NO_MEM;
+        goto err;
+    }
+    return ESP_OK;
+
+err:
+    if (daemon->client_hdl) {
+        usb_host_client_deregister(daemon->client_hdl);
+    }
+    if (daemon->host_installed) {
+        usb_host_uninstall();
+    }
+    if (daemon->done) {
+        vSemaphoreDelete(daemon->done);
+    }
+    free(daemon);
+    return ret;
+}
+
+esp_err_t usb_host_daemon_uninstall(void)
+{
+    DAEMON_ENTER_CRITICAL();
+    usb_host_daemon_t *daemon = s_daemon;
+    bool has_clients = false;
+    for (int i = 0; daemon && i < USB_HOST_DAEMON_MAX_CLIENTS; i++) {
+        has_clients |= (daemon->clients[i].handle_events != NULL || daemon->clients[i].event_cb != NULL);
+    }
+    if (daemon && !has_clients) {
+        s_daemon = NULL;
+    }
+    DAEMON_EXIT_CRITICAL();
+    ESP_RETURN_ON_FALSE(daemon, ESP_ERR_INVALID_STATE, TAG, "daemon not installed");
+    ESP_RETURN_ON_FALSE(!has_clients, ESP_ERR_INVALID_STATE, TAG, "clients still added");
+
+    // The daemon client is deregistered before the library is uninstalled
+    daemon->exit = true;
+    usb_host_client_unblock(daemon->client_hdl);
+    xSemaphoreTake(daemon->done, portMAX_DELAY);
+    esp_err_t ret = daemon->uninstall_err;
+    daemon->lib_exit = true;
+    usb_host_lib_unblock();
+    xSemaphoreTake(daemon->done, portMAX_DELAY);
+    if (ret == ESP_OK) {
+        ret = daemon->uninstall_err;
+    }
+
+    vSemaphoreDelete(daemon->done);
+    free(daemon);
+    return ret;
+}
+
+usb_host_client_handle_t usb_host_daemon_get_client(void)
+{
+    DAEMON_ENTER_CRITICAL();
+    usb_host_client_handle_t client_hdl = s_daemon ? s_daemon->client_hdl : NULL;
+    DAEMON_EXIT_CRITICAL();
+    return client_hdl;
+}
+
+static esp_err_t daemon_add(usb_host_daemon_client_fn_t handle_events, usb_host_client_event_cb_t event_cb, void *arg)
+{
+    esp_err_t ret = ESP_ERR_NO_MEM;
+    usb_host_client_handle_t client_hdl = NULL;
+    DAEMON_ENTER_CRITICAL();
+    if (s_daemon == NULL) {
+        ret = ESP_ERR_INVALID_STATE;
+    } else {
+        for (int i = 0; i < USB_HOST_DAEMON_MAX_CLIENTS; i++) {
+            daemon_client_t *client = &s_daemon->clients[i];
+            if (client->handle_events == NULL && client->event_cb == NULL) {
+                client->handle_events = handle_events;
+                client->event_cb = event_cb;
+                client->arg = arg;
+                client_hdl = s_daemon->client_hdl;
+                ret = ESP_OK;
+                break;
+            }
+        }
+    }
+    DAEMON_EXIT_CRITICAL();
+
+    if (ret == ESP_OK && handle_events) {
+        // Stop waiting for the daemon client only, the polled client is served from the next turn
+        usb_host_client_unblock(client_hdl);
+    }
+    return ret;
+}
+
+static esp_err_t daemon_remove(usb_host_daemon_client_fn_t handle_events, usb_host_client_event_cb_t event_cb,
+                               void *arg)
+{
+    // The caller's task notifications are left to the application
+    StaticSemaphore_t removed_buf;
+    SemaphoreHandle_t removed = xSemaphoreCreateBinaryStatic(&removed_buf);
+    usb_host_client_handle_t client_hdl = NULL;
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    DAEMON_ENTER_CRITICAL();
+    if (s_daemon == NULL || s_daemon->task == xTaskGetCurrentTaskHandle()) {
+        ret = ESP_ERR_INVALID_STATE;
+    } else {
+        for (int i = 0; i < USB_HOST_DAEMON_MAX_CLIENTS; i++) {
+            daemon_client_t *client = &s_daemon->clients[i];
+            if (client->handle_events == handle_events && client->event_cb == event_cb && client->arg == arg &&
+                    client->removed == NULL) {
+                client->removed = removed;
+                client_hdl = s_daemon->client_hdl;
+                ret = ESP_OK;
+                break;
+            }
+        }
+    }
+    DAEMON_EXIT_CRITICAL();
+
+    if (ret == ESP_OK) {
+        // Given by the daemon at the end of its turn, which may be waiting for the daemon client without timeout
+        usb_host_client_unblock(client_hdl);
+        xSemaphoreTake(removed, portMAX_DELAY);
+    }
+    vSemaphoreDelete(removed);
+    return ret;
+}
+
+esp_err_t usb_host_daemon_add_driver(usb_host_client_event_cb_t event_cb, void *arg)
+{
+    ESP_RETURN_ON_FALSE(event_cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    return daemon_add(NULL, event_cb, arg);
+}
+
+esp_err_t usb_host_daemon_remove_driver(usb_host_client_event_cb_t event_cb, void *arg)
+{
+    ESP_RETURN_ON_FALSE(event_cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    return daemon_remove(NULL, event_cb, arg);
+}
+
+esp_err_t usb_host_daemon_add_client(usb_host_daemon_client_fn_t handle_events, void *arg)
+{
+    ESP_RETURN_ON_FALSE(handle_events, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    return daemon_add(handle_events, NULL, arg);
+}
+
+esp_err_t usb_host_daemon_remove_client(usb_host_daemon_client_fn_t handle_events, void *arg)
+{
+    ESP_RETURN_ON_FALSE(handle_events, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    return daemon_remove(handle_events, NULL, arg);
+}
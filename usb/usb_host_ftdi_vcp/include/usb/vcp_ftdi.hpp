@@ -22,6 +22,8 @@
 #define FTDI_CMD_SET_LINE_CTL (0x04)
 #define FTDI_CMD_GET_MDMSTS   (0x05) // Modem status
 
+#define FTDI_RX_PACKET_SIZE   (64)   // Max packet size of bulk IN endpoint of full-speed FT23x, every packet starts with 2 status bytes
+
 namespace esp_usb {
 class FT23x : public CdcAcmDevice {
 public:
@@ -67,11 +69,30 @@ private:
     const cdc_acm_host_dev_callback_t user_event_cb;
     void *user_arg;
     uint16_t uart_state;
+    const uint8_t *rx_held;         // Payload not processed by the user, nullptr if there is none
+    size_t rx_held_len;             // Length of payload at rx_held
+    const uint8_t *rx_held_raw_end; // End of raw data, whose payload is at rx_held
+
+    /**
+     * @brief Strip status bytes from raw FT23x packets in place
+     *
+     * Payload of every packet is moved at most once, directly behind the payload of the previous packet.
+     * Error bits of all packets and modem lines of the last packet are collected in uart_state.
+     *
+     * @param[in]  raw      Raw received data, starting at packet boundary
+     * @param[in]  raw_len  Length of raw data
+     * @param[out] dest     Where the payload is moved to, at most raw
+     * @param[out] state    Serial state collected from the status bytes
+     * @return size_t       Length of the payload
+     */
+    static size_t strip_status(const uint8_t *raw, size_t raw_len, uint8_t *dest, cdc_acm_uart_state_t *state);
 
     /**
      * @brief FT23x's RX data handler
      *
-     * First two bytes are status bytes, the RX data start at data[2].
+     * Every packet of FTDI_RX_PACKET_SIZE bytes starts with two status bytes, the remaining bytes are RX data.
+     * The status bytes are stripped in place, in one pass over the data, and the user gets contiguous RX data.
+     * If the user does not process the data, the RX data of the next transfer are stripped behind them.
      * Coding of status bytes:
      * Byte 0:
      *      Bit 0: Full Speed packet
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <algorithm>
 #include <string.h>
 #include <inttypes.h>
 #include "usb/vcp_ftdi.hpp"
@@ -22,7 +23,7 @@
 namespace esp_usb {
 FT23x::FT23x(uint16_t pid, const cdc_acm_host_device_config_t *dev_config, uint8_t interface_idx)
     : intf(interface_idx), user_data_cb(dev_config->data_cb), user_event_cb(dev_config->event_cb),
-      user_arg(dev_config->user_arg), uart_state(0)
+      user_arg(dev_config->user_arg), uart_state(0), rx_held(nullptr), rx_held_len(0), rx_held_raw_end(nullptr)
 {
     cdc_acm_host_device_config_t ftdi_config;
     memcpy(&ftdi_config, dev_config, sizeof(cdc_acm_host_device_config_t));
@@ -34,10 +35,9 @@ FT23x::FT23x(uint16_t pid, const cdc_acm_host_device_config_t *dev_config, uint8
         ftdi_config.user_arg = this;
     }
 
-    if (dev_config->event_cb) {
-        ftdi_config.event_cb = ftdi_event;
-        ftdi_config.user_arg = this;
-    }
+    // RX overflow reported by the CDC-ACM driver resets the stripping of not processed data, so we always need the events
+    ftdi_config.event_cb = ftdi_event;
+    ftdi_config.user_arg = this;
 
     esp_err_t err;
     err = this->open_vendor_specific(vid, pid, this->intf, &ftdi_config);
@@ -86,42 +86,101 @@ esp_err_t FT23x::set_control_line_state(bool dtr, bool rts)
     return this->send_custom_request(FTDI_WRITE_REQ, FTDI_CMD_SET_MHS, rts ? 0x21 : 0x20, this->intf, 0, NULL); // RTS
 }
 
+size_t FT23x::strip_status(const uint8_t *raw, size_t raw_len, uint8_t *dest, cdc_acm_uart_state_t *state)
+{
+    size_t payload_len = 0;
+    for (size_t pos = 0; pos + 2 <= raw_len; pos += FTDI_RX_PACKET_SIZE) {
+        const uint8_t *packet = raw + pos;
+        // Modem lines are taken from the latest packet, errors are collected from all packets
+        state->bRxCarrier =  packet[0] & 0x80; // DCD
+        state->bTxCarrier =  packet[0] & 0x20; // DSR
+        state->bRingSignal = packet[0] & 0x40;
+        state->bBreak |=     (packet[1] & 0x10) != 0;
+        state->bFraming |=   (packet[1] & 0x08) != 0;
+        state->bParity |=    (packet[1] & 0x04) != 0;
+        state->bOverRun |=   (packet[1] & 0x02) != 0;
+
+        const size_t packet_len = std::min(raw_len - pos, (size_t)FTDI_RX_PACKET_SIZE) - 2;
+        if (dest + payload_len != packet + 2) {
+            memmove(dest + payload_len, packet + 2, packet_len);
+        }
+        payload_len += packet_len;
+    }
+    return payload_len;
+}
+
 bool FT23x::ftdi_rx(const uint8_t *data, size_t data_len, void *user_arg)
 {
     FT23x *this_ftdi = (FT23x *)user_arg;
 
+    // Find the raw data not stripped yet. Not processed data are kept by the CDC-ACM driver and new data are appended behind them:
+    // With multiple IN transfers, the driver passes all data from the beginning again.
+    // With a single IN transfer, the driver passes only the new data, placed right behind the old ones.
+    const uint8_t *raw = data;
+    size_t raw_len = data_len;
+    const uint8_t *payload = data;
+    if (this_ftdi->rx_held && data == this_ftdi->rx_held && data + data_len > this_ftdi->rx_held_raw_end) {
+        raw = this_ftdi->rx_held_raw_end;
+        raw_len = data + data_len - raw;
+    } else if (this_ftdi->rx_held && data == this_ftdi->rx_held_raw_end) {
+        payload = this_ftdi->rx_held + this_ftdi->rx_held_len;
+    } else {
+        this_ftdi->rx_held = nullptr;
+        this_ftdi->rx_held_len = 0;
+    }
+
+    // The data are in the IN transfer buffer owned by the CDC-ACM driver, we can modify them
+    uint8_t *dest = const_cast<uint8_t *>(this_ftdi->rx_held ? this_ftdi->rx_held + this_ftdi->rx_held_len : data);
+    cdc_acm_uart_state_t new_state;
+    new_state.val = 0;
+    const size_t payload_len = strip_status(raw, raw_len, dest, &new_state);
+
     // Dispatch serial state if it has changed
-    if (this_ftdi->user_event_cb) {
-        cdc_acm_uart_state_t new_state;
-        new_state.val = 0;
-        new_state.bRxCarrier =  data[0] & 0x80; // DCD
-        new_state.bTxCarrier =  data[0] & 0x20; // DSR
-        new_state.bBreak =      data[1] & 0x10;
-        new_state.bRingSignal = data[0] & 0x40;
-        new_state.bFraming =    data[1] & 0x08;
-        new_state.bParity =     data[1] & 0x04;
-        new_state.bOverRun =    data[1] & 0x02;
-
-        if (this_ftdi->uart_state != new_state.val) {
-            cdc_acm_host_dev_event_data_t serial_event;
-            serial_event.type = CDC_ACM_HOST_SERIAL_STATE;
-            serial_event.data.serial_state = new_state;
-            this_ftdi->user_event_cb(&serial_event, this_ftdi->user_arg);
-            this_ftdi->uart_state = new_state.val;
-        }
+    if (this_ftdi->user_event_cb && this_ftdi->uart_state != new_state.val) {
+        cdc_acm_host_dev_event_data_t serial_event;
+        serial_event.type = CDC_ACM_HOST_SERIAL_STATE;
+        serial_event.data.serial_state = new_state;
+        this_ftdi->user_event_cb(&serial_event, this_ftdi->user_arg);
     }
+    this_ftdi->uart_state = new_state.val;
 
     // Dispatch data if any
-    if (data_len > 2) {
-        return this_ftdi->user_data_cb(&data[2], data_len - 2, this_ftdi->user_arg);
+    if (!this_ftdi->user_data_cb) {
+        return true;
+    }
+    if (payload_len == 0) {
+        // Packets with status bytes only; keep the not processed data, if there are any
+        if (this_ftdi->rx_held) {
+            this_ftdi->rx_held_raw_end = raw + raw_len;
+            return false;
+        }
+        return true;
     }
-    return true;
+    const uint8_t *held = this_ftdi->rx_held ? this_ftdi->rx_held : data;
+    const size_t held_len = this_ftdi->rx_held_len;
+    const bool processed = this_ftdi->user_data_cb(payload, dest + payload_len - payload, this_ftdi->user_arg);
+    if (processed) {
+        this_ftdi->rx_held = nullptr;
+        this_ftdi->rx_held_len = 0;
+    } else {
+        this_ftdi->rx_held = held;
+        this_ftdi->rx_held_len = held_len + payload_len;
+        this_ftdi->rx_held_raw_end = raw + raw_len;
+    }
+    return processed;
 }
 
 void FT23x::ftdi_event(const cdc_acm_host_dev_event_data_t *event, void *user_ctx)
 {
     FT23x *this_ftdi = (FT23x *)user_ctx;
-    this_ftdi->user_event_cb(event, this_ftdi->user_arg);
+    if (event->type == CDC_ACM_HOST_SERIAL_STATE && event->data.serial_state.bOverRun) {
+        // FT23x has no notification endpoint, this is the driver dropping the not processed data
+        this_ftdi->rx_held = nullptr;
+        this_ftdi->rx_held_len = 0;
+    }
+    if (this_ftdi->user_event_cb) {
+        this_ftdi->user_event_cb(event, this_ftdi->user_arg);
+    }
 }
 
 int FT23x::calculate_baudrate(uint32_t baudrate, uint16_t *wValue, uint16_t *wIndex)
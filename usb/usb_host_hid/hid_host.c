@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdatomic.h>
 #include <sys/queue.h>
 #include <sys/param.h>
 #include "esp_log.h"
@@ -81,6 +82,20 @@ typedef enum {
     HID_INTERFACE_STATE_MAX
 } hid_iface_state_t;
 
+/**
+ * @brief Received input reports waiting to be read by the user
+ *
+ * Single producer (IN transfer callback), single consumer (hid_host_device_get_raw_input_report_data()) ring of slots.
+ * Each slot holds the length and data of one report.
+ */
+typedef struct {
+    uint8_t *buf;                           /**< Slots, each of slot_size bytes */
+    size_t slot_size;                       /**< Size of one slot: length followed by ep_in_mps bytes of data */
+    size_t num_slots;                       /**< Number of slots */
+    atomic_uint_least32_t head;             /**< Next slot to be written */
+    atomic_uint_least32_t tail;             /**< Oldest slot not read yet */
+} hid_report_queue_t;
+
 /**
  * @brief HID Interface structure in device to interact with. After HID device opening keeps the interface configuration
  *
@@ -94,7 +109,17 @@ typedef struct hid_interface {
     uint8_t country_code;                   /**< Country code */
     uint16_t report_desc_size;              /**< Size of Report */
     uint8_t *report_desc;                   /**< Pointer to HID Report */
-    usb_transfer_t *in_xfer;                /**< Pointer to IN transfer buffer */
+    usb_transfer_t **in_xfers;              /**< IN transfers, all of them are in flight while the interface is active */
+    size_t in_xfer_count;                   /**< Number of IN transfers */
+    hid_report_queue_t reports;             /**< Received reports */
+    hid_host_dev_stats_t stats;             /**< Report statistics */
+    bool direct_dispatch;                   /**< Report callback is called with the report still in the IN transfer */
+    usb_transfer_t *direct_xfer;            /**< IN transfer being dispatched directly, NULL otherwise */
+    struct {
+        TaskHandle_t handle;                /**< Interface's task calling the report callback, NULL if the driver's task calls it */
+        SemaphoreHandle_t done;             /**< Given by the task when it ends */
+        volatile bool stop;                 /**< Request the task to end */
+    } cb_task;
     hid_host_interface_event_cb_t user_cb;  /**< Interface application callback */
     void *user_cb_arg;                      /**< Interface application callback arg */
     hid_iface_state_t state;                /**< Interface state */
@@ -612,24 +637,148 @@ static void client_event_cb(const usb_host_client_event_msg_t *event, void *arg)
 }
 
 /**
- * @brief HID Host claim Interface and prepare transfer, change state to READY
+ * @brief Free IN transfers and report queue of an Interface
+ *
+ * @param[in] iface       Pointer to Interface structure
+ */
+static void hid_host_interface_free_transfers(hid_iface_t *iface)
+{
+    if (iface->in_xfers) {
+        for (size_t i = 0; i < iface->in_xfer_count; i++) {
+            if (iface->in_xfers[i]) {
+                ESP_ERROR_CHECK( usb_host_transfer_free(iface->in_xfers[i]) );
+            }
+        }
+        free(iface->in_xfers);
+        iface->in_xfers = NULL;
+    }
+    iface->in_xfer_count = 0;
+    free(iface->reports.buf);
+    iface->reports.buf = NULL;
+}
+
+/**
+ * @brief HID Host claim Interface and prepare transfers, change state to READY
  *
  * @param[in] iface       Pointer to Interface structure,
+ * @param[in] config      Configuration of the Interface
  * @return esp_err_t
  */
-static esp_err_t hid_host_interface_claim_and_prepare_transfer(hid_iface_t *iface)
+static esp_err_t hid_host_interface_claim_and_prepare_transfer(hid_iface_t *iface,
+        const hid_host_device_config_t *config)
 {
+    esp_err_t ret;
+    const size_t in_xfer_count = config->in_transfer_count ? config->in_transfer_count : 1;
+    const size_t num_slots = config->report_queue_len ? config->report_queue_len : in_xfer_count;
+
     HID_RETURN_ON_ERROR( usb_host_interface_claim( s_hid_driver->client_handle,
                          iface->parent->dev_hdl,
                          iface->dev_params.iface_num, 0),
                          "Unable to claim Interface");
 
-    HID_RETURN_ON_ERROR( usb_host_transfer_alloc(iface->ep_in_mps, 0, &iface->in_xfer),
-                         "Unable to allocate transfer buffer for EP IN");
+    HID_GOTO_ON_FALSE( iface->in_xfers = calloc(in_xfer_count, sizeof(usb_transfer_t *)),
+                       ESP_ERR_NO_MEM,
+                       "Unable to allocate memory");
+    iface->in_xfer_count = in_xfer_count;
+    for (size_t i = 0; i < in_xfer_count; i++) {
+        HID_GOTO_ON_ERROR( usb_host_transfer_alloc(iface->ep_in_mps, 0, &iface->in_xfers[i]),
+                           "Unable to allocate transfer buffer for EP IN");
+    }
+
+    iface->reports.slot_size = sizeof(uint16_t) + iface->ep_in_mps;
+    iface->reports.num_slots = num_slots;
+    HID_GOTO_ON_FALSE( iface->reports.buf = calloc(num_slots, iface->reports.slot_size),
+                       ESP_ERR_NO_MEM,
+                       "Unable to allocate report queue");
+    atomic_init(&iface->reports.head, 0);
+    atomic_init(&iface->reports.tail, 0);
+    memset(&iface->stats, 0, sizeof(iface->stats));
 
     // Change state
     iface->state = HID_INTERFACE_STATE_READY;
     return ESP_OK;
+
+fail:
+    hid_host_interface_free_transfers(iface);
+    usb_host_interface_release(s_hid_driver->client_handle,
+                               iface->parent->dev_hdl,
+                               iface->dev_params.iface_num);
+    return ret;
+}
+
+/**
+ * @brief Interface's task calling the report callback
+ *
+ * Each notification corresponds to one queued report.
+ *
+ * @param[in] arg   Pointer to Interface structure
+ */
+static void hid_iface_callback_task(void *arg)
+{
+    hid_iface_t *iface = (hid_iface_t *)arg;
+    while (1) {
+        ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+        if (iface->cb_task.stop) {
+            break;
+        }
+        hid_host_user_interface_callback(iface, HID_HOST_INTERFACE_EVENT_INPUT_REPORT);
+    }
+    xSemaphoreGive(iface->cb_task.done);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Create Interface's task calling the report callback, if it is configured
+ *
+ * @param[in] iface       Pointer to Interface structure
+ * @param[in] config      Configuration of the Interface
+ * @return esp_err_t
+ */
+static esp_err_t hid_iface_callback_task_start(hid_iface_t *iface,
+        const hid_host_device_config_t *config)
+{
+    if (config->callback_task_stack_size == 0) {
+        return ESP_OK;
+    }
+
+    HID_RETURN_ON_FALSE( iface->cb_task.done = xSemaphoreCreateBinary(),
+                         ESP_ERR_NO_MEM,
+                         "Unable to create semaphore");
+    iface->cb_task.stop = false;
+    if (pdPASS != xTaskCreatePinnedToCore(hid_iface_callback_task,
+                                          "USB HID iface",
+                                          config->callback_task_stack_size,
+                                          iface,
+                                          config->callback_task_priority,
+                                          &iface->cb_task.handle,
+                                          config->callback_task_core_id)) {
+        vSemaphoreDelete(iface->cb_task.done);
+        iface->cb_task.done = NULL;
+        iface->cb_task.handle = NULL;
+        ESP_LOGE(TAG, "Unable to create Interface task");
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Stop Interface's task calling the report callback
+ *
+ * Reports queued for the task are not passed to the callback anymore. Does nothing if the Interface has no task.
+ *
+ * @param[in] iface       Pointer to Interface structure
+ */
+static void hid_iface_callback_task_stop(hid_iface_t *iface)
+{
+    if (iface->cb_task.handle == NULL) {
+        return;
+    }
+    iface->cb_task.stop = true;
+    xTaskNotifyGive(iface->cb_task.handle);
+    xSemaphoreTake(iface->cb_task.done, portMAX_DELAY);
+    vSemaphoreDelete(iface->cb_task.done);
+    iface->cb_task.done = NULL;
+    iface->cb_task.handle = NULL;
 }
 
 /**
@@ -652,7 +801,8 @@ static esp_err_t hid_host_interface_release_and_free_transfer(hid_iface_t *iface
                          iface->dev_params.iface_num),
                          "Unable to release HID Interface");
 
-    ESP_ERROR_CHECK( usb_host_transfer_free(iface->in_xfer) );
+    hid_iface_callback_task_stop(iface);
+    hid_host_interface_free_transfers(iface);
 
     // Change state
     iface->state = HID_INTERFACE_STATE_IDLE;
@@ -689,6 +839,39 @@ static esp_err_t hid_host_disable_interface(hid_iface_t *iface)
     return ESP_OK;
 }
 
+/**
+ * @brief Add received report to the Interface's report queue
+ *
+ * Called only from IN transfer callbacks, which run in the USB Host client task.
+ *
+ * @param[in] iface       Pointer to Interface structure
+ * @param[in] data        Report data
+ * @param[in] len         Report length
+ * @return true if the report was queued, false if it was dropped
+ */
+static bool hid_report_queue_push(hid_iface_t *iface, const uint8_t *data, size_t len)
+{
+    hid_report_queue_t *queue = &iface->reports;
+    const uint32_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    const uint32_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+    iface->stats.reports++;
+    if (head - tail >= queue->num_slots) {
+        iface->stats.dropped++;
+        return false;
+    }
+    if (head != tail) {
+        iface->stats.overlapped++;
+    }
+
+    uint8_t *slot = &queue->buf[(head % queue->num_slots) * queue->slot_size];
+    const uint16_t slot_len = MIN(len, iface->ep_in_mps);
+    memcpy(slot, &slot_len, sizeof(slot_len));
+    memcpy(slot + sizeof(slot_len), data, slot_len);
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return true;
+}
+
 /**
  * @brief HID IN Transfer complete callback
  *
@@ -705,12 +888,29 @@ static void in_xfer_done(usb_transfer_t *in_xfer)
     assert(get_hid_device_from_context(in_xfer) == iface->parent);
 
     switch (in_xfer->status) {
-    case USB_TRANSFER_STATUS_COMPLETED:
-        // Notify user
-        hid_host_user_interface_callback(iface, HID_HOST_INTERFACE_EVENT_INPUT_REPORT);
-        // Relaunch transfer
+    case USB_TRANSFER_STATUS_COMPLETED: {
+        if (iface->direct_dispatch) {
+            // User reads the report from the transfer, which is relaunched afterwards
+            iface->stats.reports++;
+            iface->direct_xfer = in_xfer;
+            hid_host_user_interface_callback(iface, HID_HOST_INTERFACE_EVENT_INPUT_REPORT);
+            iface->direct_xfer = NULL;
+            usb_host_transfer_submit(in_xfer);
+            return;
+        }
+        // Copy the report and relaunch the transfer right away, so that the endpoint is polled while the user reads it
+        const bool queued = hid_report_queue_push(iface, in_xfer->data_buffer, in_xfer->actual_num_bytes);
         usb_host_transfer_submit(in_xfer);
+        if (queued) {
+            // Notify user
+            if (iface->cb_task.handle) {
+                xTaskNotifyGive(iface->cb_task.handle);
+            } else {
+                hid_host_user_interface_callback(iface, HID_HOST_INTERFACE_EVENT_INPUT_REPORT);
+            }
+        }
         return;
+    }
     case USB_TRANSFER_STATUS_NO_DEVICE:
     case USB_TRANSFER_STATUS_CANCELED:
         // User is notified about device disconnection from usb_event_cb
@@ -1208,13 +1408,26 @@ esp_err_t hid_host_device_open(hid_host_device_handle_t hid_dev_handle,
                         ESP_ERR_INVALID_STATE,
                         "Interface wrong state");
 
+    HID_RETURN_ON_FALSE(!(config->direct_dispatch && config->callback_task_stack_size),
+                        ESP_ERR_INVALID_ARG,
+                        "Direct dispatch can't be used with Interface task");
+
     // Claim interface, allocate xfer and save report callback
-    HID_RETURN_ON_ERROR( hid_host_interface_claim_and_prepare_transfer(hid_iface),
+    HID_RETURN_ON_ERROR( hid_host_interface_claim_and_prepare_transfer(hid_iface, config),
                          "Unable to claim interface");
 
     // Save HID Interface callback
     hid_iface->user_cb = config->callback;
     hid_iface->user_cb_arg = config->callback_arg;
+    hid_iface->direct_dispatch = config->direct_dispatch;
+
+    esp_err_t ret = hid_iface_callback_task_start(hid_iface, config);
+    if (ret != ESP_OK) {
+        hid_host_interface_release_and_free_transfer(hid_iface);
+        hid_iface->user_cb = NULL;
+        hid_iface->user_cb_arg = NULL;
+        return ret;
+    }
 
     return ESP_OK;
 }
@@ -1298,14 +1511,57 @@ esp_err_t hid_host_device_get_raw_input_report_data(hid_host_device_handle_t hid
                         ESP_ERR_INVALID_ARG,
                         "Wrong argument");
 
-    size_t copied = (data_length_max >= iface->in_xfer->actual_num_bytes)
-                    ? iface->in_xfer->actual_num_bytes
+    if (iface->direct_xfer) {
+        const usb_transfer_t *in_xfer = iface->direct_xfer;
+        size_t copied = (data_length_max >= in_xfer->actual_num_bytes)
+                        ? in_xfer->actual_num_bytes
+                        : data_length_max;
+        memcpy(data, in_xfer->data_buffer, copied);
+        *data_length = copied;
+        return ESP_OK;
+    }
+
+    hid_report_queue_t *queue = &iface->reports;
+    HID_RETURN_ON_FALSE(queue->buf,
+                        ESP_ERR_INVALID_STATE,
+                        "Interface is not opened");
+
+    const uint32_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    const uint32_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    if (head == tail) {
+        *data_length = 0;
+        return ESP_OK;
+    }
+
+    const uint8_t *slot = &queue->buf[(tail % queue->num_slots) * queue->slot_size];
+    uint16_t slot_len;
+    memcpy(&slot_len, slot, sizeof(slot_len));
+    size_t copied = (data_length_max >= slot_len)
+                    ? slot_len
                     : data_length_max;
-    memcpy(data, iface->in_xfer->data_buffer, copied);
+    memcpy(data, slot + sizeof(slot_len), copied);
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
     *data_length = copied;
     return ESP_OK;
 }
 
+esp_err_t hid_host_device_get_stats(hid_host_device_handle_t hid_dev_handle,
+                                    hid_host_dev_stats_t *stats)
+{
+    hid_iface_t *iface = get_iface_by_handle(hid_dev_handle);
+
+    HID_RETURN_ON_FALSE(iface,
+                        ESP_ERR_INVALID_STATE,
+                        "HID Interface not found");
+
+    HID_RETURN_ON_FALSE(stats,
+                        ESP_ERR_INVALID_ARG,
+                        "Wrong argument");
+
+    memcpy(stats, &iface->stats, sizeof(hid_host_dev_stats_t));
+    return ESP_OK;
+}
+
 // ------------------------ USB HID Host driver API ----------------------------
 
 esp_err_t hid_host_device_start(hid_host_device_handle_t hid_dev_handle)
@@ -1313,7 +1569,7 @@ esp_err_t hid_host_device_start(hid_host_device_handle_t hid_dev_handle)
     hid_iface_t *iface = get_iface_by_handle(hid_dev_handle);
 
     HID_RETURN_ON_INVALID_ARG(iface);
-    HID_RETURN_ON_INVALID_ARG(iface->in_xfer);
+    HID_RETURN_ON_INVALID_ARG(iface->in_xfers);
     HID_RETURN_ON_INVALID_ARG(iface->parent);
 
     HID_RETURN_ON_FALSE(is_interface_in_list(iface),
@@ -1324,18 +1580,24 @@ esp_err_t hid_host_device_start(hid_host_device_handle_t hid_dev_handle)
                          ESP_ERR_INVALID_STATE,
                          "Interface wrong state");
 
-    // prepare transfer
-    iface->in_xfer->device_handle = iface->parent->dev_hdl;
-    iface->in_xfer->callback = in_xfer_done;
-    iface->in_xfer->context = iface->parent;
-    iface->in_xfer->timeout_ms = DEFAULT_TIMEOUT_MS;
-    iface->in_xfer->bEndpointAddress = iface->ep_in;
-    iface->in_xfer->num_bytes = iface->ep_in_mps;
+    // Reports left from previous start are stale
+    atomic_store(&iface->reports.tail, atomic_load(&iface->reports.head));
 
     iface->state = HID_INTERFACE_STATE_ACTIVE;
 
-    // start data transfer
-    return usb_host_transfer_submit(iface->in_xfer);
+    // prepare and start data transfers
+    for (size_t i = 0; i < iface->in_xfer_count; i++) {
+        usb_transfer_t *in_xfer = iface->in_xfers[i];
+        in_xfer->device_handle = iface->parent->dev_hdl;
+        in_xfer->callback = in_xfer_done;
+        in_xfer->context = iface->parent;
+        in_xfer->timeout_ms = DEFAULT_TIMEOUT_MS;
+        in_xfer->bEndpointAddress = iface->ep_in;
+        in_xfer->num_bytes = iface->ep_in_mps;
+        HID_RETURN_ON_ERROR( usb_host_transfer_submit(in_xfer),
+                             "Unable to submit IN transfer");
+    }
+    return ESP_OK;
 }
 
 esp_err_t hid_host_device_stop(hid_host_device_handle_t hid_dev_handle)
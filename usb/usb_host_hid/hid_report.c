@@ -0,0 +1,532 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "usb/hid_report.h"
+
+static const char *TAG = "hid-report";
+
+// Item prefix, see 6.2.2.2 Short Items, p.26 of Device Class Definition for Human Interface Devices (HID) Version 1.11
+#define HID_ITEM_LONG               0xFE
+#define HID_ITEM_TYPE_MAIN          0
+#define HID_ITEM_TYPE_GLOBAL        1
+#define HID_ITEM_TYPE_LOCAL         2
+
+#define HID_MAIN_INPUT              0x8
+#define HID_MAIN_OUTPUT             0x9
+#define HID_MAIN_COLLECTION         0xA
+#define HID_MAIN_FEATURE            0xB
+#define HID_MAIN_END_COLLECTION     0xC
+
+#define HID_GLOBAL_USAGE_PAGE       0x0
+#define HID_GLOBAL_LOGICAL_MIN      0x1
+#define HID_GLOBAL_LOGICAL_MAX      0x2
+#define HID_GLOBAL_REPORT_SIZE      0x7
+#define HID_GLOBAL_REPORT_ID        0x8
+#define HID_GLOBAL_REPORT_COUNT     0x9
+#define HID_GLOBAL_PUSH             0xA
+#define HID_GLOBAL_POP              0xB
+
+#define HID_LOCAL_USAGE             0x0
+#define HID_LOCAL_USAGE_MIN         0x1
+#define HID_LOCAL_USAGE_MAX         0x2
+
+#define HID_REPORT_GLOBAL_STACK     4   // Depth of Push/Pop stack
+#define HID_REPORT_MAX_USAGES       32  // Usages and usage ranges of one main item
+#define HID_REPORT_TYPES            3   // Input, Output, Feature
+
+/**
+ * @brief Global item state
+ */
+typedef struct {
+    uint16_t usage_page;
+    int32_t logical_min;
+    uint32_t logical_max;           // Raw value, its sign depends on logical_min
+    uint8_t logical_max_size;       // Size of the Logical Maximum item data in bytes
+    uint32_t report_size;
+    uint32_t report_count;
+    uint8_t report_id;
+} hid_global_state_t;
+
+/**
+ * @brief Usage or usage range of a local item
+ */
+typedef struct {
+    uint16_t page;
+    uint16_t min;
+    uint16_t max;
+} hid_usage_range_t;
+
+/**
+ * @brief Parser context
+ */
+typedef struct {
+    hid_global_state_t global;
+    hid_global_state_t stack[HID_REPORT_GLOBAL_STACK];
+    size_t stack_depth;
+    hid_usage_range_t usages[HID_REPORT_MAX_USAGES];
+    size_t num_usages;
+    bool usage_min_set;             // Usage Minimum waits for its Usage Maximum
+    uint32_t bit_offsets[HID_REPORT_TYPES][256]; // Current offset in each report
+    hid_report_info_t *info;
+    size_t fields_capacity;
+} hid_parser_t;
+
+/**
+ * @brief Compiled extraction of one usage
+ */
+typedef struct {
+    uint16_t byte_offset;           // First byte of the field in the report, including report ID
+    uint8_t num_bytes;              // Number of bytes covering the field
+    uint8_t shift;                  // Bit position of the field in its first byte
+    uint32_t mask;                  // Mask of the field after shift
+    uint32_t sign_bit;              // Sign bit of the field after shift, 0 if unsigned
+    uint16_t dst_offset;            // Offset in user's structure
+    uint8_t dst_size;               // Size of the user's member
+} hid_report_op_t;
+
+struct hid_report_map {
+    bool has_report_id;             // Report starts with report ID
+    uint8_t report_id;              // Report ID of all ops
+    size_t min_report_len;          // Report length covering all ops
+    size_t num_ops;
+    hid_report_op_t ops[];
+};
+
+/**
+ * @brief Read item data as unsigned value
+ */
+static uint32_t item_udata(const uint8_t *data, size_t size)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < size; i++) {
+        value |= (uint32_t)data[i] << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Read item data as signed value
+ */
+static int32_t item_sdata(const uint8_t *data, size_t size)
+{
+    const uint32_t value = item_udata(data, size);
+    if (size == 0 || size == 4) {
+        return (int32_t)value;
+    }
+    const uint32_t sign = 1UL << (8 * size - 1);
+    return (int32_t)((value ^ sign) - sign);
+}
+
+/**
+ * @brief Logical maximum of the global state
+ *
+ * Devices often describe e.g. 0..255 by 1 byte items, so the maximum is unsigned when the minimum is not negative.
+ */
+static int32_t global_logical_max(const hid_global_state_t *global)
+{
+    if (global->logical_min >= 0) {
+        return (int32_t)global->logical_max;
+    }
+    uint8_t data[4];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = global->logical_max >> (8 * i);
+    }
+    return item_sdata(data, global->logical_max_size);
+}
+
+/**
+ * @brief Usage of the n-th element of a main item
+ *
+ * Elements beyond the declared usages use the last usage.
+ */
+static hid_usage_range_t nth_usage(const hid_parser_t *parser, size_t n)
+{
+    hid_usage_range_t usage = {0};
+    for (size_t i = 0; i < parser->num_usages; i++) {
+        const hid_usage_range_t *range = &parser->usages[i];
+        const size_t range_len = (size_t)range->max - range->min + 1;
+        usage.page = range->page;
+        if (n < range_len) {
+            usage.min = usage.max = range->min + n;
+            return usage;
+        }
+        n -= range_len;
+        usage.min = usage.max = range->max;
+    }
+    return usage;
+}
+
+static esp_err_t add_field(hid_parser_t *parser, const hid_report_field_t *field)
+{
+    hid_report_info_t *info = parser->info;
+    if (info->num_fields == parser->fields_capacity) {
+        const size_t capacity = parser->fields_capacity ? parser->fields_capacity * 2 : 16;
+        hid_report_field_t *fields = realloc(info->fields, capacity * sizeof(hid_report_field_t));
+        ESP_RETURN_ON_FALSE(fields, ESP_ERR_NO_MEM, TAG, "Could not allocate fields");
+        info->fields = fields;
+        parser->fields_capacity = capacity;
+    }
+    info->fields[info->num_fields++] = *field;
+    return ESP_OK;
+}
+
+/**
+ * @brief Create fields of an Input, Output or Feature item and advance the report offset
+ */
+static esp_err_t main_data_item(hid_parser_t *parser, hid_report_type_t report_type, uint32_t flags)
+{
+    const hid_global_state_t *global = &parser->global;
+    uint32_t *bit_offset = &parser->bit_offsets[report_type - HID_REPORT_TYPE_INPUT][global->report_id];
+    ESP_RETURN_ON_FALSE(global->report_size <= UINT16_MAX && global->report_count <= UINT16_MAX, ESP_ERR_INVALID_SIZE, TAG, "Report too long");
+    const uint32_t total_bits = global->report_size * global->report_count;
+    ESP_RETURN_ON_FALSE(*bit_offset + total_bits <= UINT16_MAX, ESP_ERR_INVALID_SIZE, TAG, "Report too long");
+
+    const bool padding = (flags & HID_REPORT_FLAG_CONSTANT) || parser->num_usages == 0;
+    if (padding || global->report_size == 0 || global->report_count == 0) {
+        *bit_offset += total_bits;
+        return ESP_OK;
+    }
+    if (global->report_size > 32) {
+        ESP_LOGD(TAG, "Ignoring field of %"PRIu32" bits", global->report_size);
+        *bit_offset += total_bits;
+        return ESP_OK;
+    }
+
+    hid_report_field_t field = {
+        .report_type = report_type,
+        .report_id = global->report_id,
+        .flags = flags & (HID_REPORT_FLAG_CONSTANT | HID_REPORT_FLAG_VARIABLE | HID_REPORT_FLAG_RELATIVE),
+        .bit_size = global->report_size,
+        .logical_min = global->logical_min,
+        .logical_max = global_logical_max(global),
+    };
+
+    if (flags & HID_REPORT_FLAG_VARIABLE) {
+        field.count = 1;
+        for (uint32_t i = 0; i < global->report_count; i++) {
+            const hid_usage_range_t usage = nth_usage(parser, i);
+            field.bit_offset = *bit_offset + i * global->report_size;
+            field.usage_page = usage.page;
+            field.usage = field.usage_max = usage.min;
+            ESP_RETURN_ON_ERROR(add_field(parser, &field), TAG,);
+        }
+    } else {
+        // Array elements are indexes to the usages, which are usually one range
+        field.count = global->report_count;
+        field.bit_offset = *bit_offset;
+        field.usage_page = parser->usages[0].page;
+        field.usage = parser->usages[0].min;
+        field.usage_max = parser->usages[parser->num_usages - 1].max;
+        ESP_RETURN_ON_ERROR(add_field(parser, &field), TAG,);
+    }
+    *bit_offset += total_bits;
+    return ESP_OK;
+}
+
+static esp_err_t global_item(hid_parser_t *parser, uint8_t tag, const uint8_t *data, size_t size)
+{
+    hid_global_state_t *global = &parser->global;
+    switch (tag) {
+    case HID_GLOBAL_USAGE_PAGE:
+        global->usage_page = item_udata(data, size);
+        break;
+    case HID_GLOBAL_LOGICAL_MIN:
+        global->logical_min = item_sdata(data, size);
+        break;
+    case HID_GLOBAL_LOGICAL_MAX:
+        global->logical_max = item_udata(data, size);
+        global->logical_max_size = size;
+        break;
+    case HID_GLOBAL_REPORT_SIZE:
+        global->report_size = item_udata(data, size);
+        break;
+    case HID_GLOBAL_REPORT_ID: {
+        const uint32_t report_id = item_udata(data, size);
+        ESP_RETURN_ON_FALSE(report_id > 0 && report_id <= UINT8_MAX, ESP_ERR_INVALID_SIZE, TAG, "Invalid report ID");
+        global->report_id = report_id;
+        parser->info->has_report_ids = true;
+        break;
+    }
+    case HID_GLOBAL_REPORT_COUNT:
+        global->report_count = item_udata(data, size);
+        break;
+    case HID_GLOBAL_PUSH:
+        ESP_RETURN_ON_FALSE(parser->stack_depth < HID_REPORT_GLOBAL_STACK, ESP_ERR_INVALID_SIZE, TAG, "Push too deep");
+        parser->stack[parser->stack_depth++] = *global;
+        break;
+    case HID_GLOBAL_POP:
+        ESP_RETURN_ON_FALSE(parser->stack_depth > 0, ESP_ERR_INVALID_SIZE, TAG, "Pop without push");
+        *global = parser->stack[--parser->stack_depth];
+        break;
+    default:
+        break; // Physical values and units are not needed for extraction
+    }
+    return ESP_OK;
+}
+
+static esp_err_t local_item(hid_parser_t *parser, uint8_t tag, const uint8_t *data, size_t size)
+{
+    // 4 byte usages contain their usage page in the upper half
+    const uint32_t value = item_udata(data, size);
+    const uint16_t page = size == 4 ? value >> 16 : parser->global.usage_page;
+    const uint16_t usage = value & 0xFFFF;
+
+    switch (tag) {
+    case HID_LOCAL_USAGE:
+    case HID_LOCAL_USAGE_MIN:
+        if (parser->num_usages == HID_REPORT_MAX_USAGES) {
+            ESP_LOGD(TAG, "Too many usages, ignoring");
+            return ESP_OK;
+        }
+        parser->usages[parser->num_usages++] = (hid_usage_range_t) {
+            .page = page, .min = usage, .max = usage
+        };
+        parser->usage_min_set = (tag == HID_LOCAL_USAGE_MIN);
+        break;
+    case HID_LOCAL_USAGE_MAX:
+        ESP_RETURN_ON_FALSE(parser->usage_min_set, ESP_ERR_INVALID_SIZE, TAG, "Usage Maximum without Usage Minimum");
+        ESP_RETURN_ON_FALSE(usage >= parser->usages[parser->num_usages - 1].min, ESP_ERR_INVALID_SIZE, TAG, "Invalid usage range");
+        parser->usages[parser->num_usages - 1].max = usage;
+        parser->usage_min_set = false;
+        break;
+    default:
+        break; // Designators and strings are not needed for extraction
+    }
+    return ESP_OK;
+}
+
+static esp_err_t main_item(hid_parser_t *parser, uint8_t tag, const uint8_t *data, size_t size)
+{
+    esp_err_t ret = ESP_OK;
+    const uint32_t flags = item_udata(data, size);
+    switch (tag) {
+    case HID_MAIN_INPUT:
+        ret = main_data_item(parser, HID_REPORT_TYPE_INPUT, flags);
+        break;
+    case HID_MAIN_OUTPUT:
+        ret = main_data_item(parser, HID_REPORT_TYPE_OUTPUT, flags);
+        break;
+    case HID_MAIN_FEATURE:
+        ret = main_data_item(parser, HID_REPORT_TYPE_FEATURE, flags);
+        break;
+    default:
+        break; // Collections only group the fields
+    }
+    // Local items apply to the following main item only
+    parser->num_usages = 0;
+    parser->usage_min_set = false;
+    return ret;
+}
+
+esp_err_t hid_report_parse(const uint8_t *desc, size_t desc_len, hid_report_info_t **info)
+{
+    ESP_RETURN_ON_FALSE(desc && info, ESP_ERR_INVALID_ARG, TAG, "Argument error");
+    esp_err_t ret = ESP_OK;
+
+    hid_parser_t *parser = calloc(1, sizeof(hid_parser_t));
+    ESP_RETURN_ON_FALSE(parser, ESP_ERR_NO_MEM, TAG, "Could not allocate parser");
+    parser->info = calloc(1, sizeof(hid_report_info_t));
+    ESP_GOTO_ON_FALSE(parser->info, ESP_ERR_NO_MEM, fail, TAG, "Could not allocate report info");
+
+    size_t pos = 0;
+    while (pos < desc_len) {
+        const uint8_t prefix = desc[pos];
+        if (prefix == HID_ITEM_LONG) {
+            // Long items are reserved, skip them
+            ESP_GOTO_ON_FALSE(pos + 1 < desc_len, ESP_ERR_INVALID_SIZE, fail, TAG, "Truncated long item");
+            pos += 3 + desc[pos + 1];
+            continue;
+        }
+        const size_t size = (prefix & 0x03) == 3 ? 4 : (prefix & 0x03);
+        const uint8_t type = (prefix >> 2) & 0x03;
+        const uint8_t tag = prefix >> 4;
+        const uint8_t *data = &desc[pos + 1];
+        ESP_GOTO_ON_FALSE(pos + 1 + size <= desc_len, ESP_ERR_INVALID_SIZE, fail, TAG, "Truncated item at %u", (unsigned)pos);
+
+        switch (type) {
+        case HID_ITEM_TYPE_MAIN:
+            ret = main_item(parser, tag, data, size);
+            break;
+        case HID_ITEM_TYPE_GLOBAL:
+            ret = global_item(parser, tag, data, size);
+            break;
+        case HID_ITEM_TYPE_LOCAL:
+            ret = local_item(parser, tag, data, size);
+            break;
+        default:
+            break; // Reserved
+        }
+        ESP_GOTO_ON_ERROR(ret, fail, TAG, "Invalid item at %u", (unsigned)pos);
+        pos += 1 + size;
+    }
+    ESP_GOTO_ON_FALSE(pos == desc_len, ESP_ERR_INVALID_SIZE, fail, TAG, "Truncated long item");
+
+    *info = parser->info;
+    free(parser);
+    return ESP_OK;
+
+fail:
+    hid_report_info_free(parser->info);
+    free(parser);
+    return ret;
+}
+
+void hid_report_info_free(hid_report_info_t *info)
+{
+    if (info) {
+        free(info->fields);
+        free(info);
+    }
+}
+
+const hid_report_field_t *hid_report_find_field(const hid_report_info_t *info, hid_report_type_t report_type,
+        uint16_t usage_page, uint16_t usage)
+{
+    if (info == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < info->num_fields; i++) {
+        const hid_report_field_t *field = &info->fields[i];
+        if (field->report_type == report_type && field->usage_page == usage_page &&
+                usage >= field->usage && usage <= field->usage_max) {
+            return field;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Compute extraction of a field element from a report
+ *
+ * @param[in]  field         Field
+ * @param[in]  index         Element index
+ * @param[in]  has_report_id Report starts with report ID byte
+ * @param[out] op            Extraction, dst_* members are not filled
+ */
+static void compile_op(const hid_report_field_t *field, size_t index, bool has_report_id, hid_report_op_t *op)
+{
+    const uint32_t bit_offset = field->bit_offset + index * field->bit_size;
+    op->byte_offset = bit_offset / 8 + (has_report_id ? 1 : 0);
+    op->shift = bit_offset % 8;
+    op->num_bytes = (op->shift + field->bit_size + 7) / 8;
+    op->mask = field->bit_size == 32 ? UINT32_MAX : (1UL << field->bit_size) - 1;
+    op->sign_bit = field->logical_min < 0 ? 1UL << (field->bit_size - 1) : 0;
+}
+
+static inline uint32_t extract_op(const hid_report_op_t *op, const uint8_t *report)
+{
+    const uint8_t *src = &report[op->byte_offset];
+    uint64_t raw = 0;
+    for (uint8_t i = 0; i < op->num_bytes; i++) {
+        raw |= (uint64_t)src[i] << (8 * i);
+    }
+    uint32_t value = (raw >> op->shift) & op->mask;
+    if (value & op->sign_bit) {
+        value |= ~op->mask;
+    }
+    return value;
+}
+
+esp_err_t hid_report_get_value(const hid_report_field_t *field, size_t index,
+                               const uint8_t *report, size_t report_len, int32_t *value)
+{
+    ESP_RETURN_ON_FALSE(field && report && value && index < field->count, ESP_ERR_INVALID_ARG, TAG, "Argument error");
+    const bool has_report_id = field->report_id != 0;
+    ESP_RETURN_ON_FALSE(!has_report_id || report[0] == field->report_id, ESP_ERR_INVALID_ARG, TAG, "Different report ID");
+
+    hid_report_op_t op;
+    compile_op(field, index, has_report_id, &op);
+    ESP_RETURN_ON_FALSE(op.byte_offset + op.num_bytes <= report_len, ESP_ERR_INVALID_ARG, TAG, "Report too short");
+    *value = (int32_t)extract_op(&op, report);
+    return ESP_OK;
+}
+
+esp_err_t hid_report_map_create(const hid_report_info_t *info, hid_report_type_t report_type,
+                                const hid_report_map_entry_t *entries, size_t num_entries,
+                                hid_report_map_handle_t *map)
+{
+    ESP_RETURN_ON_FALSE(info && entries && num_entries && map, ESP_ERR_INVALID_ARG, TAG, "Argument error");
+
+    struct hid_report_map *new_map = calloc(1, sizeof(struct hid_report_map) + num_entries * sizeof(hid_report_op_t));
+    ESP_RETURN_ON_FALSE(new_map, ESP_ERR_NO_MEM, TAG, "Could not allocate map");
+    esp_err_t ret = ESP_OK;
+
+    new_map->has_report_id = info->has_report_ids;
+    new_map->num_ops = num_entries;
+    for (size_t i = 0; i < num_entries; i++) {
+        const hid_report_map_entry_t *entry = &entries[i];
+        ESP_GOTO_ON_FALSE(entry->size == 1 || entry->size == 2 || entry->size == 4, ESP_ERR_INVALID_ARG, fail, TAG,
+                          "Invalid size of usage 0x%x:0x%x", entry->usage_page, entry->usage);
+        const hid_report_field_t *field = hid_report_find_field(info, report_type, entry->usage_page, entry->usage);
+        ESP_GOTO_ON_FALSE(field, ESP_ERR_NOT_FOUND, fail, TAG, "Usage 0x%x:0x%x not found", entry->usage_page, entry->usage);
+        ESP_GOTO_ON_FALSE(field->flags & HID_REPORT_FLAG_VARIABLE, ESP_ERR_NOT_SUPPORTED, fail, TAG,
+                          "Usage 0x%x:0x%x is an array", entry->usage_page, entry->usage);
+        if (i == 0) {
+            new_map->report_id = field->report_id;
+        }
+        ESP_GOTO_ON_FALSE(field->report_id == new_map->report_id, ESP_ERR_INVALID_ARG, fail, TAG,
+                          "Usage 0x%x:0x%x is in report %d", entry->usage_page, entry->usage, field->report_id);
+
+        hid_report_op_t *op = &new_map->ops[i];
+        compile_op(field, 0, new_map->has_report_id, op);
+        op->dst_offset = entry->offset;
+        op->dst_size = entry->size;
+        const size_t end = (size_t)op->byte_offset + op->num_bytes;
+        if (end > new_map->min_report_len) {
+            new_map->min_report_len = end;
+        }
+    }
+    *map = new_map;
+    return ESP_OK;
+
+fail:
+    free(new_map);
+    return ret;
+}
+
+void hid_report_map_free(hid_report_map_handle_t map)
+{
+    free(map);
+}
+
+esp_err_t hid_report_decode(hid_report_map_handle_t map, const uint8_t *report, size_t report_len, void *out)
+{
+    ESP_RETURN_ON_FALSE(map && report && out, ESP_ERR_INVALID_ARG, TAG, "Argument error");
+    if (map->has_report_id && (report_len == 0 || report[0] != map->report_id)) {
+        return ESP_ERR_NOT_FOUND; // Not an error, devices interleave their reports
+    }
+    ESP_RETURN_ON_FALSE(report_len >= map->min_report_len, ESP_ERR_INVALID_SIZE, TAG, "Report too short");
+
+    uint8_t *dst = (uint8_t *)out;
+    for (size_t i = 0; i < map->num_ops; i++) {
+        const hid_report_op_t *op = &map->ops[i];
+        const uint32_t value = extract_op(op, report);
+        switch (op->dst_size) {
+        case 1: {
+            const uint8_t v = value;
+            memcpy(dst + op->dst_offset, &v, sizeof(v));
+            break;
+        }
+        case 2: {
+            const uint16_t v = value;
+            memcpy(dst + op->dst_offset, &v, sizeof(v));
+            break;
+        }
+        default:
+            memcpy(dst + op->dst_offset, &value, sizeof(value));
+            break;
+        }
+    }
+    return ESP_OK;
+}
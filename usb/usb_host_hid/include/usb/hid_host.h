@@ -89,8 +89,23 @@ typedef struct {
 typedef struct {
     hid_host_interface_event_cb_t callback;     /**< Callback invoked when HID Interface event occurs */
     void *callback_arg;                         /**< User provided argument passed to callback */
+    size_t in_transfer_count;                   /**< Number of interrupt IN transfers in flight, so that reports are not missed while one is processed. 0 means 1 */
+    size_t report_queue_len;                    /**< Number of received reports waiting to be read by hid_host_device_get_raw_input_report_data(). 0 means in_transfer_count */
+    bool direct_dispatch;                       /**< Call the callback with the report still in the IN transfer, before it is resubmitted. Saves the copy to the report queue, but the callback must not block and must read the report */
+    size_t callback_task_stack_size;            /**< Stack size of the Interface's own task calling the callback on input reports. 0 calls it from the HID driver's task. Can't be used with direct_dispatch */
+    unsigned callback_task_priority;            /**< Priority of the Interface's task */
+    BaseType_t callback_task_core_id;           /**< Select core on which the Interface's task will run or tskNO_AFFINITY */
 } hid_host_device_config_t;
 
+/**
+ * @brief HID Interface report statistics
+*/
+typedef struct {
+    uint32_t reports;                           /**< Number of received input reports */
+    uint32_t dropped;                           /**< Number of reports dropped because the report queue was full */
+    uint32_t overlapped;                        /**< Number of reports received while previous reports were not read yet */
+} hid_host_dev_stats_t;
+
 /**
  * @brief USB HID Host install USB Host HID Class driver
  *
@@ -150,6 +165,8 @@ esp_err_t hid_host_device_get_params(hid_host_device_handle_t hid_dev_handle,
  *
  * This functions should be called after HID Interface device event HID_HOST_INTERFACE_EVENT_INPUT_REPORT
  * to get the actual raw data of input report.
+ * Each event corresponds to one queued report, the oldest report is copied and removed from the queue.
+ * If the queue is empty, data_length is set to 0.
  *
  * @param[in] hid_dev_handle    HID Device handle
  * @param[in] data              Pointer to buffer where the input data will be copied
@@ -163,6 +180,19 @@ esp_err_t hid_host_device_get_raw_input_report_data(hid_host_device_handle_t hid
         size_t data_length_max,
         size_t *data_length);
 
+/**
+ * @brief HID Host get report statistics of an Interface
+ *
+ * The statistics are cleared when the Interface is opened.
+ *
+ * @param[in] hid_dev_handle    HID Device handle
+ * @param[out] stats            Pointer to a stats struct to fill
+ *
+ * @return esp_err_t
+ */
+esp_err_t hid_host_device_get_stats(hid_host_device_handle_t hid_dev_handle,
+                                    hid_host_dev_stats_t *stats);
+
 // ------------------------ USB HID Host driver API ----------------------------
 
 /**
@@ -0,0 +1,172 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#include "hid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Flags of a report field, copied from its Input, Output or Feature item
+ *
+ * @see 6.2.2.5 Input, Output, and Feature Items, p.38 of Device Class Definition for Human Interface Devices (HID) Version 1.11
+ */
+#define HID_REPORT_FLAG_CONSTANT    (1 << 0)    /**< Constant (padding) instead of data */
+#define HID_REPORT_FLAG_VARIABLE    (1 << 1)    /**< Variable instead of array */
+#define HID_REPORT_FLAG_RELATIVE    (1 << 2)    /**< Relative instead of absolute */
+
+/**
+ * @brief Field of a report, as described by the report descriptor
+ *
+ * A variable of the descriptor becomes one field per usage.
+ * An array of the descriptor becomes one field, whose elements contain indexes to the usage range usage..usage_max.
+ */
+typedef struct {
+    hid_report_type_t report_type;  /**< Type of the report containing the field */
+    uint8_t report_id;              /**< Report ID, 0 if the descriptor doesn't use report IDs */
+    uint8_t flags;                  /**< HID_REPORT_FLAG_* */
+    uint8_t bit_size;               /**< Size of one element in bits, 1 to 32 */
+    uint16_t bit_offset;            /**< Offset of the first element in bits, from the start of report data following the report ID */
+    uint16_t count;                 /**< Number of elements, 1 for variables */
+    uint16_t usage_page;            /**< Usage page */
+    uint16_t usage;                 /**< Usage, or the first usage of an array */
+    uint16_t usage_max;             /**< Last usage of an array, same as usage for variables */
+    int32_t logical_min;            /**< Logical minimum */
+    int32_t logical_max;            /**< Logical maximum */
+} hid_report_field_t;
+
+/**
+ * @brief Fields of all reports of a report descriptor
+ */
+typedef struct {
+    bool has_report_ids;            /**< Reports start with a report ID byte */
+    size_t num_fields;              /**< Number of fields */
+    hid_report_field_t *fields;     /**< Fields, in the order of the report descriptor */
+} hid_report_info_t;
+
+/**
+ * @brief Destination of one usage in user's structure, see hid_report_map_create()
+ */
+typedef struct {
+    uint16_t usage_page;            /**< Usage page of the field */
+    uint16_t usage;                 /**< Usage of the field */
+    uint16_t offset;                /**< Offset of the destination member in user's structure, use offsetof() */
+    uint8_t size;                   /**< Size of the destination member in bytes: 1, 2 or 4 */
+} hid_report_map_entry_t;
+
+typedef struct hid_report_map *hid_report_map_handle_t; /**< Handle to a compiled report map */
+
+/**
+ * @brief Parse a report descriptor into a table of fields
+ *
+ * Padding (constant items) is skipped, fields larger than 32 bits are ignored.
+ *
+ * @param[in]  desc     Report descriptor, e.g. from hid_host_get_report_descriptor()
+ * @param[in]  desc_len Length of report descriptor
+ * @param[out] info     Parsed fields, must be freed by hid_report_info_free()
+ * @return esp_err_t
+ *   - ESP_OK: Success
+ *   - ESP_ERR_INVALID_ARG: Invalid argument
+ *   - ESP_ERR_INVALID_SIZE: Malformed report descriptor
+ *   - ESP_ERR_NO_MEM: Not enough memory
+ */
+esp_err_t hid_report_parse(const uint8_t *desc, size_t desc_len, hid_report_info_t **info);
+
+/**
+ * @brief Free fields returned by hid_report_parse()
+ *
+ * @param[in] info Parsed fields, can be NULL
+ */
+void hid_report_info_free(hid_report_info_t *info);
+
+/**
+ * @brief Find a field by its usage
+ *
+ * Arrays are found by any usage of their usage range.
+ *
+ * @param[in] info        Parsed fields
+ * @param[in] report_type Type of the report
+ * @param[in] usage_page  Usage page
+ * @param[in] usage       Usage
+ * @return Pointer to the first matching field, NULL if there is none
+ */
+const hid_report_field_t *hid_report_find_field(const hid_report_info_t *info, hid_report_type_t report_type,
+        uint16_t usage_page, uint16_t usage);
+
+/**
+ * @brief Read an element of a field from a report
+ *
+ * The value is sign extended if the field's logical minimum is negative.
+ * Use hid_report_map_create() and hid_report_decode() to read multiple fields of frequent reports.
+ *
+ * @param[in] field      Field of the report
+ * @param[in] index      Element index, 0 for variables
+ * @param[in] report     Report, including the report ID if the descriptor uses them
+ * @param[in] report_len Length of report
+ * @param[out] value     Value of the element
+ * @return esp_err_t
+ *   - ESP_OK: Success
+ *   - ESP_ERR_INVALID_ARG: Invalid argument or the element is not in the report
+ */
+esp_err_t hid_report_get_value(const hid_report_field_t *field, size_t index,
+                               const uint8_t *report, size_t report_len, int32_t *value);
+
+/**
+ * @brief Compile usages of one report into a map for hid_report_decode()
+ *
+ * Positions, shifts, masks and sign extensions of the fields are computed once,
+ * so that decoding a report doesn't search the fields or the report descriptor.
+ * All entries must be variables of the same report.
+ *
+ * @param[in]  info        Parsed fields
+ * @param[in]  report_type Type of the report
+ * @param[in]  entries     Usages and their destinations in user's structure
+ * @param[in]  num_entries Number of entries
+ * @param[out] map         Compiled map, must be freed by hid_report_map_free()
+ * @return esp_err_t
+ *   - ESP_OK: Success
+ *   - ESP_ERR_INVALID_ARG: Invalid argument, or the usages are in different reports
+ *   - ESP_ERR_NOT_FOUND: A usage is not in the report descriptor
+ *   - ESP_ERR_NOT_SUPPORTED: A usage is an array
+ *   - ESP_ERR_NO_MEM: Not enough memory
+ */
+esp_err_t hid_report_map_create(const hid_report_info_t *info, hid_report_type_t report_type,
+                                const hid_report_map_entry_t *entries, size_t num_entries,
+                                hid_report_map_handle_t *map);
+
+/**
+ * @brief Free a map returned by hid_report_map_create()
+ *
+ * @param[in] map Compiled map, can be NULL
+ */
+void hid_report_map_free(hid_report_map_handle_t map);
+
+/**
+ * @brief Decode a report into user's structure
+ *
+ * @param[in]  map        Compiled map
+ * @param[in]  report     Report, including the report ID if the descriptor uses them
+ * @param[in]  report_len Length of report
+ * @param[out] out        User's structure, members not in the map are left untouched
+ * @return esp_err_t
+ *   - ESP_OK: Success
+ *   - ESP_ERR_INVALID_ARG: Invalid argument
+ *   - ESP_ERR_NOT_FOUND: The report has a different report ID than the map
+ *   - ESP_ERR_INVALID_SIZE: The report is too short
+ */
+esp_err_t hid_report_decode(hid_report_map_handle_t map, const uint8_t *report, size_t report_len, void *out);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
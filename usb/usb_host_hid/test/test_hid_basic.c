@@ -7,6 +7,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <inttypes.h>
 #include "unity.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
@@ -173,6 +174,47 @@ void hid_host_test_concurrent(hid_host_device_handle_t hid_device_handle,
     }
 }
 
+void hid_host_test_stats_interface_callback(hid_host_device_handle_t hid_device_handle,
+        const hid_host_interface_event_t event,
+        void *arg)
+{
+    if (event == HID_HOST_INTERFACE_EVENT_DISCONNECTED) {
+        // Every report was read in the callback, none could be dropped
+        hid_host_dev_stats_t stats;
+        TEST_ASSERT_EQUAL(ESP_OK, hid_host_device_get_stats(hid_device_handle, &stats));
+        printf("Reports %"PRIu32", dropped %"PRIu32", overlapped %"PRIu32"\n",
+               stats.reports, stats.dropped, stats.overlapped);
+        TEST_ASSERT_EQUAL(0, stats.dropped);
+    }
+    hid_host_test_interface_callback(hid_device_handle, event, arg);
+}
+
+void hid_host_test_multiple_in_transfers(hid_host_device_handle_t hid_device_handle,
+        const hid_host_driver_event_t event,
+        void *arg)
+{
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(&user_arg_value, arg, "User argument has lost");
+
+    switch (event) {
+    case HID_HOST_DRIVER_EVENT_CONNECTED: {
+        const hid_host_device_config_t dev_config = {
+            .callback = hid_host_test_stats_interface_callback,
+            .callback_arg = &user_arg_value,
+            .in_transfer_count = 2,
+        };
+
+        TEST_ASSERT_EQUAL(ESP_OK,  hid_host_device_open(hid_device_handle, &dev_config) );
+        TEST_ASSERT_EQUAL(ESP_OK,  hid_host_device_start(hid_device_handle) );
+
+        global_hdl = hid_device_handle;
+        break;
+    }
+    default:
+        TEST_FAIL_MESSAGE("HID Driver unhandled event");
+        break;
+    }
+}
+
 void hid_host_test_device_callback_to_queue(hid_host_device_handle_t hid_device_handle,
         const hid_host_driver_event_t event,
         void *arg)
@@ -600,6 +642,20 @@ TEST_CASE("sudden_disconnect", "[hid_host]")
     test_hid_teardown();
 }
 
+TEST_CASE("multiple_in_transfers", "[hid_host]")
+{
+    // Install USB and HID driver with 'hid_host_test_multiple_in_transfers', two IN transfers per interface
+    test_hid_setup(hid_host_test_multiple_in_transfers);
+    // Wait for USB device appearing for 250 msec
+    vTaskDelay(250);
+    // Reports are still read in the interface callback while control requests are sent
+    test_num_passed = 0;
+    test_multiple_tasks_access();
+    // Tear down test, the statistics are checked on disconnection
+    test_hid_teardown();
+    TEST_ASSERT_EQUAL(MULTIPLE_TASKS_TASKS_NUM, test_num_passed);
+}
+
 TEST_CASE("mock_hid_device", "[hid_device][ignore]")
 {
     hid_mock_device(TUSB_IFACE_COUNT_ONE);
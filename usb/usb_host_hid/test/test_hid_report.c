@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "unity.h"
+#include "usb/hid_report.h"
+
+// Gamepad: report 1 with 12 buttons, 4 bit hat switch, signed 8 bit X/Y and 10 bit throttle;
+// report 2 with an array of 2 keyboard keys
+static const uint8_t gamepad_report_desc[] = {
+    0x05, 0x01,         // Usage Page (Generic Desktop)
+    0x09, 0x05,         // Usage (Game Pad)
+    0xA1, 0x01,         // Collection (Application)
+    0x85, 0x01,         //   Report ID (1)
+    0x05, 0x09,         //   Usage Page (Button)
+    0x19, 0x01,         //   Usage Minimum (1)
+    0x29, 0x0C,         //   Usage Maximum (12)
+    0x15, 0x00,         //   Logical Minimum (0)
+    0x25, 0x01,         //   Logical Maximum (1)
+    0x75, 0x01,         //   Report Size (1)
+    0x95, 0x0C,         //   Report Count (12)
+    0x81, 0x02,         //   Input (Data, Variable, Absolute)
+    0x05, 0x01,         //   Usage Page (Generic Desktop)
+    0x09, 0x39,         //   Usage (Hat switch)
+    0x25, 0x07,         //   Logical Maximum (7)
+    0x75, 0x04,         //   Report Size (4)
+    0x95, 0x01,         //   Report Count (1)
+    0x81, 0x42,         //   Input (Data, Variable, Absolute, Null State)
+    0x09, 0x30,         //   Usage (X)
+    0x09, 0x31,         //   Usage (Y)
+    0x15, 0x81,         //   Logical Minimum (-127)
+    0x25, 0x7F,         //   Logical Maximum (127)
+    0x75, 0x08,         //   Report Size (8)
+    0x95, 0x02,         //   Report Count (2)
+    0x81, 0x02,         //   Input (Data, Variable, Absolute)
+    0x05, 0x02,         //   Usage Page (Simulation Controls)
+    0x09, 0xBB,         //   Usage (Throttle)
+    0x15, 0x00,         //   Logical Minimum (0)
+    0x26, 0xFF, 0x03,   //   Logical Maximum (1023)
+    0x75, 0x0A,         //   Report Size (10)
+    0x95, 0x01,         //   Report Count (1)
+    0x81, 0x02,         //   Input (Data, Variable, Absolute)
+    0x75, 0x06,         //   Report Size (6)
+    0x81, 0x03,         //   Input (Constant)
+    0x85, 0x02,         //   Report ID (2)
+    0x05, 0x07,         //   Usage Page (Keyboard)
+    0x19, 0x00,         //   Usage Minimum (0)
+    0x29, 0xFF,         //   Usage Maximum (255)
+    0x26, 0xFF, 0x00,   //   Logical Maximum (255)
+    0x75, 0x08,         //   Report Size (8)
+    0x95, 0x02,         //   Report Count (2)
+    0x81, 0x00,         //   Input (Data, Array, Absolute)
+    0xC0,               // End Collection
+};
+
+typedef struct {
+    uint16_t buttons[12];
+    uint8_t hat;
+    int8_t x;
+    int8_t y;
+    uint16_t throttle;
+} gamepad_state_t;
+
+TEST_CASE("report_descriptor_parser", "[hid_report]")
+{
+    hid_report_info_t *info = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, hid_report_parse(gamepad_report_desc, sizeof(gamepad_report_desc), &info));
+    TEST_ASSERT_TRUE(info->has_report_ids);
+    TEST_ASSERT_EQUAL(12 + 1 + 2 + 1 + 1, info->num_fields);
+
+    const hid_report_field_t *field = hid_report_find_field(info, HID_REPORT_TYPE_INPUT, 0x02, 0xBB);
+    TEST_ASSERT_NOT_NULL(field);
+    TEST_ASSERT_EQUAL(1, field->report_id);
+    TEST_ASSERT_EQUAL(32, field->bit_offset);
+    TEST_ASSERT_EQUAL(10, field->bit_size);
+    TEST_ASSERT_EQUAL(1023, field->logical_max);
+
+    field = hid_report_find_field(info, HID_REPORT_TYPE_INPUT, 0x01, 0x30);
+    TEST_ASSERT_NOT_NULL(field);
+    TEST_ASSERT_EQUAL(-127, field->logical_min);
+    TEST_ASSERT_EQUAL(127, field->logical_max);
+
+    // Arrays are found by any usage of their range
+    field = hid_report_find_field(info, HID_REPORT_TYPE_INPUT, 0x07, 0x04);
+    TEST_ASSERT_NOT_NULL(field);
+    TEST_ASSERT_EQUAL(2, field->report_id);
+    TEST_ASSERT_EQUAL(2, field->count);
+    TEST_ASSERT_FALSE(field->flags & HID_REPORT_FLAG_VARIABLE);
+    const uint8_t key_report[] = {0x02, 0x04, 0x05};
+    int32_t key;
+    TEST_ASSERT_EQUAL(ESP_OK, hid_report_get_value(field, 1, key_report, sizeof(key_report), &key));
+    TEST_ASSERT_EQUAL(0x05, key);
+    TEST_ASSERT_NULL(hid_report_find_field(info, HID_REPORT_TYPE_OUTPUT, 0x07, 0x04));
+
+    // Malformed descriptor
+    hid_report_info_t *truncated = NULL;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, hid_report_parse(gamepad_report_desc, sizeof(gamepad_report_desc) - 2, &truncated));
+    TEST_ASSERT_NULL(truncated);
+
+    hid_report_info_free(info);
+}
+
+TEST_CASE("report_map_decode", "[hid_report]")
+{
+    hid_report_info_t *info = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, hid_report_parse(gamepad_report_desc, sizeof(gamepad_report_desc), &info));
+
+    hid_report_map_entry_t entries[12 + 4] = {
+        {0x01, 0x39, offsetof(gamepad_state_t, hat), sizeof(uint8_t)},
+        {0x01, 0x30, offsetof(gamepad_state_t, x), sizeof(int8_t)},
+        {0x01, 0x31, offsetof(gamepad_state_t, y), sizeof(int8_t)},
+        {0x02, 0xBB, offsetof(gamepad_state_t, throttle), sizeof(uint16_t)},
+    };
+    for (int i = 0; i < 12; i++) {
+        entries[4 + i] = (hid_report_map_entry_t) {
+            0x09, i + 1, offsetof(gamepad_state_t, buttons) + i * sizeof(uint16_t), sizeof(uint16_t)
+        };
+    }
+    hid_report_map_handle_t map = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, hid_report_map_create(info, HID_REPORT_TYPE_INPUT, entries, 16, &map));
+
+    // Buttons 1 and 12, hat 5, X -2, Y 100, throttle 1000
+    const uint8_t report[] = {0x01, 0x01, 0x58, 0xFE, 0x64, 0xE8, 0x03};
+    gamepad_state_t state = {0};
+    TEST_ASSERT_EQUAL(ESP_OK, hid_report_decode(map, report, sizeof(report), &state));
+    for (int i = 0; i < 12; i++) {
+        TEST_ASSERT_EQUAL((i == 0 || i == 11) ? 1 : 0, state.buttons[i]);
+    }
+    TEST_ASSERT_EQUAL(5, state.hat);
+    TEST_ASSERT_EQUAL(-2, state.x);
+    TEST_ASSERT_EQUAL(100, state.y);
+    TEST_ASSERT_EQUAL(1000, state.throttle);
+
+    // Reports with other report IDs and short reports are rejected
+    const uint8_t key_report[] = {0x02, 0x04, 0x05};
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, hid_report_decode(map, key_report, sizeof(key_report), &state));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, hid_report_decode(map, report, sizeof(report) - 1, &state));
+    hid_report_map_free(map);
+
+    // Arrays and usages of different reports can't be mapped
+    const hid_report_map_entry_t array_entry = {0x07, 0x04, 0, sizeof(uint8_t)};
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, hid_report_map_create(info, HID_REPORT_TYPE_INPUT, &array_entry, 1, &map));
+    const hid_report_map_entry_t missing_entry = {0x01, 0x32, 0, sizeof(uint8_t)};
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, hid_report_map_create(info, HID_REPORT_TYPE_INPUT, &missing_entry, 1, &map));
+
+    hid_report_info_free(info);
+}
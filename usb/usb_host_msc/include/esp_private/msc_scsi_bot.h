@@ -15,6 +15,8 @@ extern "C"
 {
 #endif
 
+#define SCSI_VERSION_SPC3 5 // Version of the standard INQUIRY data from which the devices may report VPD pages
+
 typedef struct {
     uint8_t key;
     uint8_t code;
@@ -33,15 +35,63 @@ esp_err_t scsi_cmd_write10(msc_host_device_handle_t device,
                            uint32_t num_sectors,
                            uint32_t sector_size);
 
+esp_err_t scsi_cmd_read16(msc_host_device_handle_t device,
+                          uint8_t *data,
+                          uint64_t sector_address,
+                          uint32_t num_sectors,
+                          uint32_t sector_size);
+
+esp_err_t scsi_cmd_write16(msc_host_device_handle_t device,
+                           const uint8_t *data,
+                           uint64_t sector_address,
+                           uint32_t num_sectors,
+                           uint32_t sector_size);
+
+/**
+ * @brief Read sectors with as few commands as possible
+ *
+ * READ(10) is used for sectors below 2^32, READ(16) otherwise.
+ * Reads longer than the device's max transfer length, or than the length field of the command, are split into several commands.
+ */
+esp_err_t scsi_cmd_read(msc_host_device_handle_t device,
+                        uint8_t *data,
+                        uint64_t sector_address,
+                        uint32_t num_sectors,
+                        uint32_t sector_size);
+
+/**
+ * @brief Write sectors with as few commands as possible
+ *
+ * Counterpart of scsi_cmd_read(), with WRITE(10) and WRITE(16).
+ */
+esp_err_t scsi_cmd_write(msc_host_device_handle_t device,
+                         const uint8_t *data,
+                         uint64_t sector_address,
+                         uint32_t num_sectors,
+                         uint32_t sector_size);
+
 esp_err_t scsi_cmd_read_capacity(msc_host_device_handle_t device,
                                  uint32_t *block_size,
                                  uint32_t *block_count);
 
+esp_err_t scsi_cmd_read_capacity16(msc_host_device_handle_t device,
+                                   uint32_t *block_size,
+                                   uint64_t *block_count);
+
 esp_err_t scsi_cmd_sense(msc_host_device_handle_t device, scsi_sense_data_t *sense);
 
 esp_err_t scsi_cmd_unit_ready(msc_host_device_handle_t device);
 
-esp_err_t scsi_cmd_inquiry(msc_host_device_handle_t device);
+esp_err_t scsi_cmd_inquiry(msc_host_device_handle_t device, uint8_t *version);
+
+/**
+ * @brief Read the max transfer length from the Block Limits VPD page
+ *
+ * @param[in]  device              MSC device handle
+ * @param[out] max_transfer_length Max number of sectors of one READ or WRITE command, 0 if not limited
+ * @return esp_err_t ESP_ERR_NOT_SUPPORTED if the device does not return the page
+ */
+esp_err_t scsi_cmd_block_limits(msc_host_device_handle_t device, uint32_t *max_transfer_length);
 
 esp_err_t scsi_cmd_prevent_removal(msc_host_device_handle_t device, bool prevent);
 
@@ -46,24 +46,81 @@ typedef struct {
 */
 typedef void (*msc_host_event_cb_t)(const msc_host_event_t *event, void *arg);
 
+/**
+ * @brief Completion callback of an asynchronous sector read or write
+ *
+ * Called from the I/O task of the device. The data buffer can be accessed again from this call on.
+ *
+ * @param[in] device Device handle
+ * @param[in] result Result of the read or write
+ * @param[in] arg    User provided argument passed to msc_host_read_sector_async() or msc_host_write_sector_async()
+ */
+typedef void (*msc_host_io_cb_t)(msc_host_device_handle_t device, esp_err_t result, void *arg);
+
+/**
+ * @brief Time spent in one stage of the BOT commands
+ */
+typedef struct {
+    uint32_t count;     /**< Number of times the stage was run */
+    uint64_t total_us;  /**< Total time in microseconds */
+    uint32_t max_us;    /**< Longest time in microseconds */
+} msc_host_stage_stats_t;
+
+/**
+ * @brief Statistics of a MSC device, collected only if enabled by enable_stats
+ *
+ * Commands in the pipelined mode run their stages in parallel, so only their total time is recorded in 'command'.
+ */
+typedef struct {
+    msc_host_stage_stats_t command; /**< Whole BOT commands */
+    msc_host_stage_stats_t cbw;     /**< Command transport */
+    msc_host_stage_stats_t data;    /**< Data transport */
+    msc_host_stage_stats_t csw;     /**< Status transport */
+    msc_host_stage_stats_t wakeup;  /**< From the transfer completion callback to the waiting task running again */
+    msc_host_stage_stats_t copy;    /**< Copying data that is not in DMA capable memory */
+    uint64_t bytes_read;            /**< Bytes received in data transports */
+    uint64_t bytes_written;         /**< Bytes sent in data transports */
+    uint32_t pipelined_commands;    /**< Commands run in the pipelined mode */
+    uint32_t bounce_buf_transfers;  /**< Transfers through the preallocated bounce buffer */
+    uint32_t alloc_buf_transfers;   /**< Transfers through a DMA capable buffer allocated for them */
+    uint32_t errors;                /**< Failed commands */
+} msc_host_stats_t;
+
 /**
  * @brief MSC configuration structure.
 */
 typedef struct {
     bool create_backround_task;     /**< When set to true, background task handling usb events is created.
                                          Otherwise user has to periodically call msc_host_handle_events function */
-    size_t task_priority;           /**< Task priority of crated background task */
-    size_t stack_size;              /**< Stack size of crated background task */
+    size_t task_priority;           /**< Task priority of crated background task, and of the I/O tasks of the devices */
+    size_t stack_size;              /**< Stack size of crated background task, and of the I/O tasks of the devices */
     BaseType_t core_id;             /**< Select core on which background task will run or tskNO_AFFINITY  */
     msc_host_event_cb_t callback;   /**< Callback invoked when MSC event occurs. Must not be NULL. */
     void *callback_arg;             /**< User provided argument passed to callback */
+    size_t dma_bounce_buf_size;     /**< Size of the DMA capable bounce buffer preallocated for every device, rounded down to
+                                         a multiple of the max packet size. Data that is not in DMA capable memory, e.g. in
+                                         PSRAM, is copied through it, and larger transfers are split. If 0, a DMA capable
+                                         buffer is allocated for every such transfer instead */
+    size_t read_ahead_sectors;      /**< Number of sectors read at once by sequential reads through Virtual File System,
+                                         so that the following reads are served from memory. 0 disables read-ahead */
+    size_t write_back_sectors;      /**< Number of adjacent sectors written through Virtual File System gathered into one
+                                         write. They are written out on sync, e.g. fsync() or fclose(), and on
+                                         unregistering the Virtual File System. 0 disables write-back */
+    size_t pipeline_depth;          /**< Number of data transfers in flight together in the pipelined mode. The CBW, data
+                                         and CSW transfers of a command are then queued without waiting for each other,
+                                         and data is split into several transfers. 0 disables the pipelined mode */
+    size_t pipeline_transfer_size;  /**< Max size of one data transfer in the pipelined mode, rounded down to a multiple of
+                                         the max packet size */
+    size_t async_queue_size;        /**< Max number of outstanding asynchronous sector reads and writes of a device. They are
+                                         processed by an I/O task created for every device. 0 disables the asynchronous API */
+    bool enable_stats;              /**< Collect msc_host_stats_t of every device, with a timestamp at every stage */
 } msc_host_driver_config_t;
 
 /**
  * @brief MSC device info.
 */
 typedef struct {
-    uint32_t sector_count;
+    uint32_t sector_count;          /**< Number of sectors, saturated at UINT32_MAX for larger devices */
     uint32_t sector_size;
     uint16_t idProduct;
     uint16_t idVendor;
@@ -139,6 +196,47 @@ __attribute__((deprecated("use API from esp_private/msc_scsi_bot.h")));
 esp_err_t msc_host_write_sector(msc_host_device_handle_t device, size_t sector, const void *data, size_t size)
 __attribute__((deprecated("use API from esp_private/msc_scsi_bot.h")));
 
+/**
+ * @brief Read sectors from mass storage device asynchronously
+ *
+ * The read is queued to the I/O task of the device and the call returns immediately.
+ * The callback is called from the I/O task once the read is finished.
+ *
+ * @note The asynchronous reads and writes bypass the block cache of the Virtual File System
+ *       and should not be combined with accesses to the same sectors through file system.
+ *
+ * @param[in]  device   Device handle
+ * @param[in]  sector   Number of the first sector to be read
+ * @param[out] data     Buffer into which data will be written, must not be accessed until the callback is called.
+ *                      Should be DMA capable, to be transferred without copy
+ * @param[in]  size     Number of bytes to be read, a multiple of the sector size
+ * @param[in]  callback Completion callback
+ * @param[in]  arg      User provided argument passed to callback
+ * @return
+ *     - ESP_OK:                The read was queued
+ *     - ESP_ERR_INVALID_SIZE:  Size is not a multiple of the sector size
+ *     - ESP_ERR_INVALID_STATE: The asynchronous API is not enabled by async_queue_size
+ *     - ESP_ERR_TIMEOUT:       async_queue_size reads and writes are already outstanding
+ */
+esp_err_t msc_host_read_sector_async(msc_host_device_handle_t device, size_t sector, void *data, size_t size,
+                                     msc_host_io_cb_t callback, void *arg);
+
+/**
+ * @brief Write sectors to mass storage device asynchronously
+ *
+ * Counterpart of msc_host_read_sector_async().
+ *
+ * @param[in]  device   Device handle
+ * @param[in]  sector   Number of the first sector to be written
+ * @param[in]  data     Data to be written, must not be modified until the callback is called
+ * @param[in]  size     Number of bytes to be written, a multiple of the sector size
+ * @param[in]  callback Completion callback
+ * @param[in]  arg      User provided argument passed to callback
+ * @return See msc_host_read_sector_async()
+ */
+esp_err_t msc_host_write_sector_async(msc_host_device_handle_t device, size_t sector, const void *data, size_t size,
+                                      msc_host_io_cb_t callback, void *arg);
+
 /**
  * @brief Handle MSC HOST events.
  *
@@ -163,6 +261,25 @@ esp_err_t msc_host_handle_events(uint32_t timeout);
  */
 esp_err_t msc_host_get_device_info(msc_host_device_handle_t device, msc_host_device_info_t *info);
 
+/**
+ * @brief Get statistics of the device
+ *
+ * @param[in]  device Handle to device
+ * @param[out] stats  Statistics since the device was installed or since msc_host_reset_stats()
+ * @return
+ *     - ESP_OK:                Statistics returned
+ *     - ESP_ERR_INVALID_STATE: Statistics are not enabled by enable_stats
+ */
+esp_err_t msc_host_get_stats(msc_host_device_handle_t device, msc_host_stats_t *stats);
+
+/**
+ * @brief Reset statistics of the device
+ *
+ * @param[in]  device Handle to device
+ * @return See msc_host_get_stats()
+ */
+esp_err_t msc_host_reset_stats(msc_host_device_handle_t device);
+
 /**
  * @brief Print configuration descriptor.
  *
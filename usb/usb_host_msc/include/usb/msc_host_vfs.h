@@ -39,6 +39,54 @@ esp_err_t msc_host_vfs_register(msc_host_device_handle_t device,
  */
 esp_err_t msc_host_vfs_unregister(msc_host_vfs_handle_t vfs_handle);
 
+/**
+ * @brief Create a file of contiguous sectors
+ *
+ * The file is created, or truncated if it exists, and a contiguous area of clusters is allocated for it
+ * with f_expand(). Its size is set to the requested size and its content is undefined. Preallocating the
+ * file spares the cluster allocation during the writes, and the file can be written with
+ * msc_host_vfs_write_sectors() in transfers as long as the data, without going through FATFS.
+ *
+ * @note Requires FF_USE_EXPAND in the FATFS configuration.
+ *
+ * @param[in]  vfs_handle   VFS handle obtained from msc_host_vfs_register()
+ * @param[in]  path         Path of the file, starting with the base path, e.g. "/usb/log.bin"
+ * @param[in]  size         Size of the file in bytes
+ * @param[out] first_sector First sector of the file, can be NULL
+ * @return
+ *     - ESP_OK: The file is created
+ *     - ESP_ERR_INVALID_ARG: The path is not in the file system of vfs_handle
+ *     - ESP_ERR_INVALID_SIZE: The size is 0
+ *     - ESP_ERR_NO_MEM: Not enough memory, or no contiguous free area large enough on the device
+ *     - ESP_ERR_NOT_SUPPORTED: f_expand() is not enabled in the FATFS configuration
+ *     - ESP_FAIL: The file could not be created
+ */
+esp_err_t msc_host_vfs_create_contiguous_file(msc_host_vfs_handle_t vfs_handle, const char *path, size_t size,
+        uint32_t *first_sector);
+
+/**
+ * @brief Write whole sectors to the device, bypassing FATFS
+ *
+ * The sectors are written with as few SCSI commands as the device allows, and the block cache of the
+ * Virtual File System is kept consistent: the write is serialized with the disk accesses of FATFS, so other files
+ * of the volume can be used meanwhile. Used to write a file created by msc_host_vfs_create_contiguous_file():
+ * the sectors from first_sector to first_sector + (file size / sector size) belong to the file.
+ *
+ * @warning The sectors are not checked to belong to a file, writing other sectors can corrupt the file system.
+ *          The file must not be written through the Virtual File System at the same time.
+ *
+ * @param[in] vfs_handle VFS handle obtained from msc_host_vfs_register()
+ * @param[in] sector     First sector to write
+ * @param[in] data       Data to write, in DMA capable memory to avoid copies
+ * @param[in] size       Number of bytes to write, a multiple of the sector size
+ * @return
+ *     - ESP_OK: The sectors are written
+ *     - ESP_ERR_INVALID_ARG: vfs_handle or data is NULL
+ *     - ESP_ERR_INVALID_SIZE: size is not a multiple of the sector size, or the sectors are beyond the end of the device
+ *     - Other: Error of the SCSI WRITE command
+ */
+esp_err_t msc_host_vfs_write_sectors(msc_host_vfs_handle_t vfs_handle, uint32_t sector, const void *data, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
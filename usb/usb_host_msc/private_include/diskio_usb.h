@@ -6,6 +6,11 @@
 
 #pragma once
 
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -15,9 +20,69 @@ extern "C" {
  */
 typedef struct {
     uint32_t block_size;    /**< Block size */
-    uint32_t block_count;   /**< Block count */
+    uint64_t block_count;   /**< Block count */
+    uint32_t read_ahead_blocks;  /**< Number of blocks read at once by sequential reads, 0 disables read-ahead */
+    uint32_t write_back_blocks;  /**< Number of adjacent blocks gathered into one write, 0 disables write-back */
+    uint8_t *read_buf;      /**< Read-ahead buffer */
+    uint32_t read_start;    /**< First block in the read-ahead buffer */
+    uint32_t read_count;    /**< Number of valid blocks in the read-ahead buffer */
+    uint32_t next_read;     /**< Block following the last read, to detect sequential reads */
+    uint8_t *write_buf;     /**< Write-back buffer */
+    uint32_t write_start;   /**< First block in the write-back buffer */
+    uint32_t write_count;   /**< Number of blocks waiting in the write-back buffer */
+    SemaphoreHandle_t lock; /**< Serializes the block cache between FATFS and writes bypassing it */
 } usb_disk_t;
 
+/**
+ * @brief Allocate the block cache buffers and the lock of the disk, as configured by read_ahead_blocks and write_back_blocks
+ *
+ * @param[in] disk usb_disk_t structure
+ * @return esp_err_t
+ */
+esp_err_t usb_disk_cache_init(usb_disk_t *disk);
+
+/**
+ * @brief Write the blocks waiting in the write-back buffer to the disk
+ *
+ * @param[in] disk usb_disk_t structure
+ * @return esp_err_t
+ */
+esp_err_t usb_disk_cache_flush(usb_disk_t *disk);
+
+/**
+ * @brief Prepare the block cache for blocks written to the disk without going through it
+ *
+ * Blocks waiting for write-back are written if they overlap, and the read-ahead blocks are dropped if they overlap.
+ * The caller must hold the disk lock until the blocks are written, so that FATFS does not read them into the cache meanwhile.
+ *
+ * @param[in] disk  usb_disk_t structure
+ * @param[in] start First block written
+ * @param[in] count Number of blocks written
+ * @return esp_err_t
+ */
+esp_err_t usb_disk_cache_invalidate(usb_disk_t *disk, uint32_t start, uint32_t count);
+
+/**
+ * @brief Take the disk lock, held by FATFS disk accesses
+ *
+ * @param[in] disk usb_disk_t structure
+ */
+void usb_disk_lock(usb_disk_t *disk);
+
+/**
+ * @brief Give the disk lock taken by usb_disk_lock()
+ *
+ * @param[in] disk usb_disk_t structure
+ */
+void usb_disk_unlock(usb_disk_t *disk);
+
+/**
+ * @brief Free the block cache buffers and the lock of the disk, without flushing the buffers
+ *
+ * @param[in] disk usb_disk_t structure
+ */
+void usb_disk_cache_deinit(usb_disk_t *disk);
+
 /**
  * @brief Register mass storage disk to fat file system
  *
@@ -8,12 +8,16 @@
 
 #include <stdint.h>
 #include <sys/queue.h>
+#include <sys/param.h>
 #include "esp_err.h"
 #include "esp_check.h"
 #include "diskio_usb.h"
 #include "usb/usb_host.h"
 #include "usb/usb_types_stack.h"
 #include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "esp_timer.h"
+#include "usb/msc_host.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -32,21 +36,66 @@ typedef struct {
     uint8_t iface_num;
 } msc_config_t;
 
+struct msc_pipeline_xfer;
+
+typedef struct {
+    struct msc_pipeline_xfer *xfers;    // CBW transfer, CSW transfer, then the data transfers
+    size_t xfer_count;
+    size_t transfer_size;               // Max size of one data transfer
+    SemaphoreHandle_t transfer_done;    // Given once for every completed transfer
+} msc_pipeline_t;
+
 typedef struct msc_host_device {
     STAILQ_ENTRY(msc_host_device) tailq_entry;
     SemaphoreHandle_t transfer_done;
     usb_device_handle_t handle;
     usb_transfer_t *xfer;
+    uint8_t *bounce_buf;            // DMA capable buffer for transfers of data that is not DMA capable, NULL if not used
+    size_t bounce_buf_size;
+    msc_pipeline_t *pipeline;       // Transfers of the pipelined mode, NULL if not used
+    uint32_t max_transfer_blocks;   // Max number of blocks of one READ or WRITE command, 0 if not limited
+    SemaphoreHandle_t command_lock; // Serializes BOT commands from the I/O task and from other tasks
+    QueueHandle_t async_queue;      // Asynchronous reads and writes waiting for the I/O task, NULL if not used
+    SemaphoreHandle_t async_task_done;
+    volatile bool async_stopping;   // Outstanding asynchronous reads and writes are canceled
+    msc_host_stats_t *stats;        // Statistics, NULL if not enabled
+    volatile int64_t xfer_done_us;  // Time of the last transfer completion callback, for the wake-up statistics
     msc_config_t config;
     usb_disk_t disk;
 } msc_device_t;
 
+/**
+ * @brief Timestamp for a stage of the statistics
+ *
+ * @return Current time in microseconds, 0 if the statistics are not enabled
+ */
+static inline int64_t msc_stats_start(const msc_device_t *device)
+{
+    return device->stats ? esp_timer_get_time() : 0;
+}
+
+/**
+ * @brief Record the end of a stage started at msc_stats_start()
+ *
+ * @param[in] stage    Stage of device->stats, which must not be NULL
+ * @param[in] start_us Timestamp from msc_stats_start()
+ */
+static inline void msc_stats_record(msc_host_stage_stats_t *stage, int64_t start_us)
+{
+    const uint32_t elapsed_us = esp_timer_get_time() - start_us;
+    stage->count++;
+    stage->total_us += elapsed_us;
+    stage->max_us = MAX(stage->max_us, elapsed_us);
+}
+
 /**
  * @brief Trigger a BULK transfer to device: zero copy
  *
  * Data buffer ownership is transferred to the MSC driver and the application cannot access it before the transfer finishes.
  * This function is true zero-copy only if the passed data buffer is in DMA capable memory, as the USB Host uses DMA transfers.
- * If the buffer is NOT DMA capable, an intermediate DMA capable buffer is allocated and used for the transfer, resulting in memory coping.
+ * If the buffer is NOT DMA capable, the data is copied through the device's preallocated DMA capable bounce buffer,
+ * in several transfers if it is larger than the bounce buffer. Without a bounce buffer, an intermediate DMA capable buffer is allocated
+ * and used for the transfer, resulting in memory coping.
  *
  * This function significantly improves performance with C Standard Library, which creates its own buffer for each opened file.
  * The STD lib buffer is then used for USB transfers too, which eliminates need of 2 large buffers and unnecessary copying of the data.
@@ -60,6 +109,41 @@ typedef struct msc_host_device {
  */
 esp_err_t msc_bulk_transfer_zcpy(msc_device_t *device_handle, uint8_t *data, size_t size, msc_endpoint_t ep);
 
+/**
+ * @brief Allocate the transfers of the pipelined mode
+ *
+ * @param[in] device        MSC device handle
+ * @param[in] depth         Number of data transfers in flight together
+ * @param[in] transfer_size Max size of one data transfer, rounded down to a multiple of MPS
+ * @return esp_err_t
+ */
+esp_err_t msc_pipeline_init(msc_device_t *device, size_t depth, size_t transfer_size);
+
+/**
+ * @brief Free the transfers of the pipelined mode
+ *
+ * @param[in] device MSC device handle
+ */
+void msc_pipeline_deinit(msc_device_t *device);
+
+/**
+ * @brief Run the three stages of a BOT command with their transfers in flight together
+ *
+ * The CBW, the data transfers and the CSW are queued right behind each other, without waiting for the previous stage to finish.
+ * The data stage is split into several transfers of the pipeline transfer size. The data buffer must be DMA capable.
+ *
+ * @param[in]    device   MSC device handle
+ * @param[in]    cbw      Command Block Wrapper
+ * @param[in]    cbw_size Size of the CBW in bytes
+ * @param[inout] data     DMA capable data buffer, or NULL if there is no data stage. Direction depends on 'ep'.
+ * @param[in]    size     Size of data in bytes
+ * @param[in]    ep       Direction of the data stage
+ * @param[out]   csw      Received Command Status Wrapper
+ * @return esp_err_t ESP_ERR_MSC_STALL if the data or the status transport stalled
+ */
+esp_err_t msc_bulk_transfer_pipelined(msc_device_t *device, const uint8_t *cbw, size_t cbw_size,
+                                      uint8_t *data, size_t size, msc_endpoint_t ep, uint8_t *csw);
+
 /**
  * @brief Trigger a CTRL transfer to device
  *
@@ -4,10 +4,13 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <sys/param.h>
 #include "diskio_impl.h"
 #include "ffconf.h"
 #include "ff.h"
 #include "esp_log.h"
+#include "esp_heap_caps.h"
 #include "diskio_usb.h"
 #include "msc_scsi_bot.h"
 #include "msc_common.h"
@@ -27,41 +30,195 @@ static DSTATUS usb_disk_status (BYTE pdrv)
     return RES_OK;
 }
 
-static DRESULT usb_disk_read (BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+static inline msc_device_t *disk_to_device(usb_disk_t *disk)
 {
-    assert(pdrv < FF_VOLUMES);
-    assert(s_disks[pdrv]);
+    return __containerof(disk, msc_device_t, disk);
+}
 
-    usb_disk_t *disk = s_disks[pdrv];
+esp_err_t usb_disk_cache_init(usb_disk_t *disk)
+{
+    disk->lock = xSemaphoreCreateMutex();
+    MSC_RETURN_ON_FALSE(disk->lock, ESP_ERR_NO_MEM);
+    // DMA capable, so that the cached blocks are transferred without copy
+    if (disk->read_ahead_blocks) {
+        disk->read_buf = heap_caps_malloc(disk->read_ahead_blocks * disk->block_size, MALLOC_CAP_DMA);
+        if (!disk->read_buf) {
+            usb_disk_cache_deinit(disk);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    if (disk->write_back_blocks) {
+        disk->write_buf = heap_caps_malloc(disk->write_back_blocks * disk->block_size, MALLOC_CAP_DMA);
+        if (!disk->write_buf) {
+            usb_disk_cache_deinit(disk);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    disk->read_count = 0;
+    disk->write_count = 0;
+    return ESP_OK;
+}
+
+esp_err_t usb_disk_cache_flush(usb_disk_t *disk)
+{
+    if (disk->write_count == 0) {
+        return ESP_OK;
+    }
+    esp_err_t err = scsi_cmd_write(disk_to_device(disk), disk->write_buf, disk->write_start, disk->write_count, disk->block_size);
+    disk->write_count = 0;
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "scsi_cmd_write failed (%d)", err);
+    }
+    return err;
+}
+
+void usb_disk_cache_deinit(usb_disk_t *disk)
+{
+    heap_caps_free(disk->read_buf);
+    heap_caps_free(disk->write_buf);
+    disk->read_buf = NULL;
+    disk->write_buf = NULL;
+    disk->read_count = 0;
+    disk->write_count = 0;
+    if (disk->lock) {
+        vSemaphoreDelete(disk->lock);
+        disk->lock = NULL;
+    }
+}
+
+void usb_disk_lock(usb_disk_t *disk)
+{
+    xSemaphoreTake(disk->lock, portMAX_DELAY);
+}
+
+void usb_disk_unlock(usb_disk_t *disk)
+{
+    xSemaphoreGive(disk->lock);
+}
+
+static inline bool blocks_overlap(uint32_t start1, uint32_t count1, uint32_t start2, uint32_t count2)
+{
+    return start1 < start2 + count2 && start2 < start1 + count1;
+}
+
+esp_err_t usb_disk_cache_invalidate(usb_disk_t *disk, uint32_t start, uint32_t count)
+{
+    if (disk->read_count && blocks_overlap(start, count, disk->read_start, disk->read_count)) {
+        disk->read_count = 0;
+    }
+    if (disk->write_count && blocks_overlap(start, count, disk->write_start, disk->write_count)) {
+        return usb_disk_cache_flush(disk);
+    }
+    return ESP_OK;
+}
+
+static DRESULT usb_disk_read_blocks(usb_disk_t *disk, BYTE *buff, DWORD sector, UINT count)
+{
     size_t sector_size = disk->block_size;
-    msc_device_t *dev = __containerof(disk, msc_device_t, disk);
+    msc_device_t *dev = disk_to_device(disk);
+    esp_err_t err;
+
+    // Blocks waiting for write-back are newer than those on the disk
+    if (disk->write_count && blocks_overlap(sector, count, disk->write_start, disk->write_count)) {
+        if (usb_disk_cache_flush(disk) != ESP_OK) {
+            return RES_ERROR;
+        }
+    }
+    const bool sequential = (sector == disk->next_read);
+    disk->next_read = sector + count;
+
+    if (disk->read_count && sector >= disk->read_start && sector + count <= disk->read_start + disk->read_count) {
+        memcpy(buff, disk->read_buf + (sector - disk->read_start) * sector_size, count * sector_size);
+        return RES_OK;
+    }
+    if (sequential && count < disk->read_ahead_blocks) {
+        // Read ahead the following blocks, that sequential reads are going to ask for next
+        const uint32_t read_count = MIN(disk->read_ahead_blocks, disk->block_count - sector);
+        disk->read_count = 0;
+        if (disk->write_count && blocks_overlap(sector, read_count, disk->write_start, disk->write_count)) {
+            if (usb_disk_cache_flush(disk) != ESP_OK) {
+                return RES_ERROR;
+            }
+        }
+        err = scsi_cmd_read(dev, disk->read_buf, sector, read_count, sector_size);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "scsi_cmd_read failed (%d)", err);
+            return RES_ERROR;
+        }
+        disk->read_start = sector;
+        disk->read_count = read_count;
+        memcpy(buff, disk->read_buf, count * sector_size);
+        return RES_OK;
+    }
 
-    esp_err_t err = scsi_cmd_read10(dev, buff, sector, count, sector_size);
+    err = scsi_cmd_read(dev, buff, sector, count, sector_size);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "scsi_cmd_read10 failed (%d)", err);
+        ESP_LOGE(TAG, "scsi_cmd_read failed (%d)", err);
         return RES_ERROR;
     }
 
     return RES_OK;
 }
 
-static DRESULT usb_disk_write (BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
+static DRESULT usb_disk_write_blocks(usb_disk_t *disk, const BYTE *buff, DWORD sector, UINT count)
 {
-    assert(pdrv < FF_VOLUMES);
-    assert(s_disks[pdrv]);
-
-    usb_disk_t *disk = s_disks[pdrv];
     size_t sector_size = disk->block_size;
-    msc_device_t *dev = __containerof(disk, msc_device_t, disk);
+    msc_device_t *dev = disk_to_device(disk);
+
+    if (disk->read_count && blocks_overlap(sector, count, disk->read_start, disk->read_count)) {
+        disk->read_count = 0;
+    }
+
+    if (disk->write_back_blocks) {
+        // Append to the blocks waiting for write-back if adjacent, write them out otherwise
+        if (disk->write_count &&
+                (sector != disk->write_start + disk->write_count || disk->write_count + count > disk->write_back_blocks)) {
+            if (usb_disk_cache_flush(disk) != ESP_OK) {
+                return RES_ERROR;
+            }
+        }
+        if (count < disk->write_back_blocks || disk->write_count) {
+            if (disk->write_count == 0) {
+                disk->write_start = sector;
+            }
+            memcpy(disk->write_buf + disk->write_count * sector_size, buff, count * sector_size);
+            disk->write_count += count;
+            return RES_OK;
+        }
+    }
 
-    esp_err_t err = scsi_cmd_write10(dev, buff, sector, count, sector_size);
+    esp_err_t err = scsi_cmd_write(dev, buff, sector, count, sector_size);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "scsi_cmd_write10 failed (%d)", err);
+        ESP_LOGE(TAG, "scsi_cmd_write failed (%d)", err);
         return RES_ERROR;
     }
     return RES_OK;
 }
 
+static DRESULT usb_disk_read (BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+    assert(pdrv < FF_VOLUMES);
+    assert(s_disks[pdrv]);
+
+    usb_disk_t *disk = s_disks[pdrv];
+    usb_disk_lock(disk);
+    const DRESULT res = usb_disk_read_blocks(disk, buff, sector, count);
+    usb_disk_unlock(disk);
+    return res;
+}
+
+static DRESULT usb_disk_write (BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
+{
+    assert(pdrv < FF_VOLUMES);
+    assert(s_disks[pdrv]);
+
+    usb_disk_t *disk = s_disks[pdrv];
+    usb_disk_lock(disk);
+    const DRESULT res = usb_disk_write_blocks(disk, buff, sector, count);
+    usb_disk_unlock(disk);
+    return res;
+}
+
 static DRESULT usb_disk_ioctl (BYTE pdrv, BYTE cmd, void *buff)
 {
     assert(pdrv < FF_VOLUMES);
@@ -70,10 +227,15 @@ static DRESULT usb_disk_ioctl (BYTE pdrv, BYTE cmd, void *buff)
     usb_disk_t *disk = s_disks[pdrv];
 
     switch (cmd) {
-    case CTRL_SYNC:
-        return RES_OK;
+    case CTRL_SYNC: {
+        usb_disk_lock(disk);
+        const esp_err_t err = usb_disk_cache_flush(disk);
+        usb_disk_unlock(disk);
+        return err == ESP_OK ? RES_OK : RES_ERROR;
+    }
     case GET_SECTOR_COUNT:
-        *((DWORD *) buff) = disk->block_count;
+        // The sector numbers of FATFS are 32 bit
+        *((DWORD *) buff) = MIN(disk->block_count, UINT32_MAX);
         return RES_OK;
     case GET_SECTOR_SIZE:
         *((WORD *) buff) = disk->block_size;
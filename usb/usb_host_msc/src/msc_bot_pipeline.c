@@ -0,0 +1,269 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "usb/usb_host.h"
+#include "usb/usb_helpers.h"
+#include "usb/msc_host.h"
+#include "msc_common.h"
+
+#define PIPELINE_TIMEOUT_MS 5000
+#define CSW_SIZE            13
+#define CSW_SIGNATURE       0x53425355
+
+static const char *TAG = "USB_MSC_PIPELINE";
+
+/**
+ * @brief One transfer of the pipeline
+ */
+typedef struct msc_pipeline_xfer {
+    usb_transfer_t *xfer;
+    msc_pipeline_t *pipeline;
+    uint8_t *own_buffer;        // Buffer allocated with the transfer, data transfers point to the user data instead
+    size_t own_buffer_size;
+    volatile bool done;
+    bool in_flight;
+} msc_pipeline_xfer_t;
+
+static void pipeline_transfer_callback(usb_transfer_t *transfer)
+{
+    msc_pipeline_xfer_t *pxfer = (msc_pipeline_xfer_t *)transfer->context;
+    pxfer->done = true;
+    xSemaphoreGive(pxfer->pipeline->transfer_done);
+}
+
+esp_err_t msc_pipeline_init(msc_device_t *device, size_t depth, size_t transfer_size)
+{
+    esp_err_t ret;
+    const size_t mps = device->config.bulk_in_mps;
+    msc_pipeline_t *pipeline = calloc(1, sizeof(msc_pipeline_t));
+    MSC_RETURN_ON_FALSE(pipeline, ESP_ERR_NO_MEM);
+    device->pipeline = pipeline;
+
+    // Two more transfers for the CBW and the CSW
+    pipeline->xfer_count = depth + 2;
+    // Multiple of MPS, so that only the last data transfer can end with a short packet
+    pipeline->transfer_size = MAX(mps, transfer_size / mps * mps);
+    MSC_GOTO_ON_FALSE( pipeline->transfer_done = xSemaphoreCreateCounting(pipeline->xfer_count, 0), ESP_ERR_NO_MEM );
+    MSC_GOTO_ON_FALSE( pipeline->xfers = calloc(pipeline->xfer_count, sizeof(msc_pipeline_xfer_t)), ESP_ERR_NO_MEM );
+    for (size_t i = 0; i < pipeline->xfer_count; i++) {
+        msc_pipeline_xfer_t *pxfer = &pipeline->xfers[i];
+        // The CSW is received in MPS sized transfer
+        MSC_GOTO_ON_ERROR( usb_host_transfer_alloc(mps, 0, &pxfer->xfer) );
+        pxfer->pipeline = pipeline;
+        pxfer->own_buffer = pxfer->xfer->data_buffer;
+        pxfer->own_buffer_size = pxfer->xfer->data_buffer_size;
+        pxfer->xfer->device_handle = device->handle;
+        pxfer->xfer->callback = pipeline_transfer_callback;
+        pxfer->xfer->context = pxfer;
+        pxfer->xfer->timeout_ms = PIPELINE_TIMEOUT_MS;
+    }
+    return ESP_OK;
+
+fail:
+    msc_pipeline_deinit(device);
+    return ret;
+}
+
+void msc_pipeline_deinit(msc_device_t *device)
+{
+    msc_pipeline_t *pipeline = device->pipeline;
+    if (!pipeline) {
+        return;
+    }
+    if (pipeline->xfers) {
+        for (size_t i = 0; i < pipeline->xfer_count; i++) {
+            msc_pipeline_xfer_t *pxfer = &pipeline->xfers[i];
+            if (pxfer->xfer) {
+                // Give the transfer its own buffer back before freeing it
+                *(uint8_t **)(&(pxfer->xfer->data_buffer)) = pxfer->own_buffer;
+                *(size_t *)(&(pxfer->xfer->data_buffer_size)) = pxfer->own_buffer_size;
+                usb_host_transfer_free(pxfer->xfer);
+            }
+        }
+        free(pipeline->xfers);
+    }
+    if (pipeline->transfer_done) {
+        vSemaphoreDelete(pipeline->transfer_done);
+    }
+    free(pipeline);
+    device->pipeline = NULL;
+}
+
+static esp_err_t pipeline_submit(msc_device_t *device, msc_pipeline_xfer_t *pxfer, uint8_t *data, size_t size, msc_endpoint_t ep)
+{
+    usb_transfer_t *xfer = pxfer->xfer;
+    // Attention: Here we modify 'private' members data_buffer and data_buffer_size, as in msc_bulk_transfer_zcpy()
+    uint8_t **ptr = (uint8_t **)(&(xfer->data_buffer));
+    size_t *siz = (size_t *)(&(xfer->data_buffer_size));
+
+    if (ep == MSC_EP_IN) {
+        xfer->bEndpointAddress = device->config.bulk_in_ep;
+        xfer->num_bytes = usb_round_up_to_mps(size, device->config.bulk_in_mps);
+    } else {
+        xfer->bEndpointAddress = device->config.bulk_out_ep;
+        xfer->num_bytes = size;
+    }
+    *ptr = data ? data : pxfer->own_buffer;
+    *siz = data ? xfer->num_bytes : pxfer->own_buffer_size;
+    pxfer->done = false;
+    esp_err_t err = usb_host_transfer_submit(xfer);
+    pxfer->in_flight = (err == ESP_OK);
+    return err;
+}
+
+static bool pipeline_wait(msc_pipeline_t *pipeline, msc_pipeline_xfer_t *pxfer, TickType_t timeout)
+{
+    // The semaphore is given for every completed transfer, so it may wake up for another transfer than this one.
+    // Completions are tracked by the flags, the extra counts only cost extra loops.
+    while (!pxfer->done) {
+        if (xSemaphoreTake(pipeline->transfer_done, timeout) != pdTRUE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Cancel all transfers in flight and wait for all of them to be returned
+ */
+static void pipeline_cancel(msc_device_t *device)
+{
+    msc_pipeline_t *pipeline = device->pipeline;
+    const uint8_t endpoints[] = { device->config.bulk_out_ep, device->config.bulk_in_ep };
+    for (int i = 0; i < sizeof(endpoints); i++) {
+        usb_host_endpoint_halt(device->handle, endpoints[i]);
+        usb_host_endpoint_flush(device->handle, endpoints[i]);
+        usb_host_endpoint_clear(device->handle, endpoints[i]);
+    }
+    for (size_t i = 0; i < pipeline->xfer_count; i++) {
+        msc_pipeline_xfer_t *pxfer = &pipeline->xfers[i];
+        if (pxfer->in_flight) {
+            // Since we flushed the EPs, this should return immediately
+            pipeline_wait(pipeline, pxfer, portMAX_DELAY);
+            pxfer->in_flight = false;
+        }
+    }
+    while (xSemaphoreTake(pipeline->transfer_done, 0) == pdTRUE) {
+    }
+}
+
+static esp_err_t pipeline_status_to_err(usb_transfer_status_t status)
+{
+    switch (status) {
+    case USB_TRANSFER_STATUS_COMPLETED:
+        return ESP_OK;
+    case USB_TRANSFER_STATUS_STALL:
+        return ESP_ERR_MSC_STALL;
+    default:
+        return ESP_ERR_MSC_INTERNAL;
+    }
+}
+
+/**
+ * @brief Wait for a transfer to complete
+ *
+ * @return esp_err_t Error of the transfer, all transfers in flight are canceled if it failed
+ */
+static esp_err_t pipeline_complete(msc_device_t *device, msc_pipeline_xfer_t *pxfer)
+{
+    msc_pipeline_t *pipeline = device->pipeline;
+    esp_err_t err;
+    if (!pipeline_wait(pipeline, pxfer, pdMS_TO_TICKS(PIPELINE_TIMEOUT_MS))) {
+        err = ESP_ERR_MSC_INTERNAL;
+    } else {
+        pxfer->in_flight = false;
+        err = pipeline_status_to_err(pxfer->xfer->status);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Transfer failed: Status %d", pxfer->xfer->status);
+        }
+    }
+    if (err != ESP_OK) {
+        pipeline_cancel(device);
+    }
+    return err;
+}
+
+esp_err_t msc_bulk_transfer_pipelined(msc_device_t *device, const uint8_t *cbw, size_t cbw_size,
+                                      uint8_t *data, size_t size, msc_endpoint_t ep, uint8_t *csw)
+{
+    esp_err_t ret = ESP_OK;
+    msc_pipeline_t *pipeline = device->pipeline;
+    msc_pipeline_xfer_t *cbw_xfer = &pipeline->xfers[0];
+    msc_pipeline_xfer_t *csw_xfer = &pipeline->xfers[1];
+    msc_pipeline_xfer_t *data_xfers = &pipeline->xfers[2];
+    const size_t depth = pipeline->xfer_count - 2;
+    const size_t chunk_count = data ? (size + pipeline->transfer_size - 1) / pipeline->transfer_size : 0;
+    size_t submitted = 0;   // Data transfers submitted
+    size_t completed = 0;   // Data transfers completed
+    const uint32_t csw_signature = CSW_SIGNATURE;
+
+    // 1. Command transport, the following stages are queued right behind it
+    memcpy(cbw_xfer->own_buffer, cbw, cbw_size);
+    MSC_GOTO_ON_ERROR( pipeline_submit(device, cbw_xfer, NULL, cbw_size, MSC_EP_OUT) );
+
+    // 2. Data transport, split into transfers in flight together
+    while (completed < chunk_count) {
+        while (submitted < chunk_count && submitted - completed < depth) {
+            const size_t offset = submitted * pipeline->transfer_size;
+            msc_pipeline_xfer_t *pxfer = &data_xfers[submitted % depth];
+            MSC_GOTO_ON_ERROR( pipeline_submit(device, pxfer, data + offset, MIN(pipeline->transfer_size, size - offset), ep) );
+            submitted++;
+        }
+        // 3. Status transport is queued as soon as the last data transfer is
+        if (submitted == chunk_count && !csw_xfer->in_flight) {
+            MSC_GOTO_ON_ERROR( pipeline_submit(device, csw_xfer, NULL, CSW_SIZE, MSC_EP_IN) );
+        }
+        if (cbw_xfer->in_flight) {
+            MSC_RETURN_ON_ERROR( pipeline_complete(device, cbw_xfer) );
+        }
+        msc_pipeline_xfer_t *pxfer = &data_xfers[completed % depth];
+        const size_t expected = MIN(pipeline->transfer_size, size - completed * pipeline->transfer_size);
+        MSC_RETURN_ON_ERROR( pipeline_complete(device, pxfer) );
+        completed++;
+        if (ep == MSC_EP_IN && pxfer->xfer->actual_num_bytes < expected && completed < chunk_count) {
+            // Short packet: the device ended the data stage early, so the next IN transfer receives the CSW
+            msc_pipeline_xfer_t *next = &data_xfers[completed % depth];
+            if (next->in_flight) {
+                MSC_RETURN_ON_ERROR( pipeline_complete(device, next) );
+                const bool is_csw = next->xfer->actual_num_bytes == CSW_SIZE &&
+                                    memcmp(next->xfer->data_buffer, &csw_signature, sizeof(csw_signature)) == 0;
+                if (is_csw) {
+                    memcpy(csw, next->xfer->data_buffer, CSW_SIZE);
+                }
+                // The rest of the transfers will not complete
+                pipeline_cancel(device);
+                return is_csw ? ESP_OK : ESP_ERR_MSC_INTERNAL;
+            }
+            // No data transfer queued behind this one: the CSW transfer receives the CSW
+            break;
+        }
+    }
+
+    if (!csw_xfer->in_flight) {
+        MSC_GOTO_ON_ERROR( pipeline_submit(device, csw_xfer, NULL, CSW_SIZE, MSC_EP_IN) );
+    }
+    if (cbw_xfer->in_flight) {
+        MSC_RETURN_ON_ERROR( pipeline_complete(device, cbw_xfer) );
+    }
+    // A stall of the status transport is returned, so that the caller reads the status again
+    MSC_RETURN_ON_ERROR( pipeline_complete(device, csw_xfer) );
+    memcpy(csw, csw_xfer->own_buffer, CSW_SIZE);
+    return ESP_OK;
+
+fail:
+    // Submitting failed, return the transfers already in flight
+    pipeline_cancel(device);
+    return ret;
+}
@@ -87,11 +87,33 @@ static portMUX_TYPE msc_lock = portMUX_INITIALIZER_UNLOCKED;
 #define MSC_NOT_READY       0x02
 #define MSC_UNIT_ATTENTION  0x06
 
+/**
+ * @brief Asynchronous read or write, queued to the I/O task of the device
+ */
+typedef struct {
+    bool write;
+    size_t sector;
+    uint32_t sector_count;
+    uint8_t *data;
+    msc_host_io_cb_t callback;  // NULL stops the I/O task
+    void *arg;
+} msc_async_request_t;
+
 static const char *TAG = "USB_MSC";
 typedef struct {
     usb_host_client_handle_t client_handle;
     msc_host_event_cb_t user_cb;
     void *user_arg;
+    size_t dma_bounce_buf_size;
+    size_t read_ahead_sectors;
+    size_t write_back_sectors;
+    size_t pipeline_depth;
+    size_t pipeline_transfer_size;
+    size_t async_queue_size;
+    bool enable_stats;
+    size_t task_priority;
+    size_t stack_size;
+    BaseType_t core_id;
     SemaphoreHandle_t all_events_handled;
     volatile bool end_client_event_handling;
     bool event_handling_started;
@@ -254,6 +276,63 @@ static esp_err_t extract_config_from_descriptor(const usb_config_desc_t *cfg_des
     return ESP_OK;
 }
 
+/**
+ * @brief I/O task of a device, processes the asynchronous reads and writes one by one
+ *
+ * The transfers are completed by the USB client event handling, so the reads and writes cannot be processed there.
+ */
+static void async_io_task(void *arg)
+{
+    msc_device_t *dev = (msc_device_t *)arg;
+    msc_async_request_t request;
+
+    while (xQueueReceive(dev->async_queue, &request, portMAX_DELAY) == pdTRUE && request.callback) {
+        esp_err_t err;
+        if (dev->async_stopping) {
+            err = ESP_ERR_INVALID_STATE;
+        } else if (request.write) {
+            err = scsi_cmd_write(dev, request.data, request.sector, request.sector_count, dev->disk.block_size);
+        } else {
+            err = scsi_cmd_read(dev, request.data, request.sector, request.sector_count, dev->disk.block_size);
+        }
+        request.callback(dev, err, request.arg);
+    }
+    xSemaphoreGive(dev->async_task_done);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t async_io_start(msc_device_t *dev)
+{
+    dev->async_queue = xQueueCreate(s_msc_driver->async_queue_size, sizeof(msc_async_request_t));
+    MSC_RETURN_ON_FALSE(dev->async_queue, ESP_ERR_NO_MEM);
+    dev->async_task_done = xSemaphoreCreateBinary();
+    MSC_RETURN_ON_FALSE(dev->async_task_done, ESP_ERR_NO_MEM);
+    BaseType_t task_created = xTaskCreatePinnedToCore(async_io_task, "USB MSC I/O", s_msc_driver->stack_size, dev,
+                                                      s_msc_driver->task_priority, NULL, s_msc_driver->core_id);
+    if (!task_created) {
+        // Nothing to wait for on deinit
+        vSemaphoreDelete(dev->async_task_done);
+        dev->async_task_done = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+static void async_io_stop(msc_device_t *dev)
+{
+    if (dev->async_task_done) {
+        // Outstanding requests are completed with an error, then the task stops at the request without callback
+        const msc_async_request_t stop = { 0 };
+        dev->async_stopping = true;
+        xQueueSend(dev->async_queue, &stop, portMAX_DELAY);
+        xSemaphoreTake(dev->async_task_done, portMAX_DELAY);
+        vSemaphoreDelete(dev->async_task_done);
+    }
+    if (dev->async_queue) {
+        vQueueDelete(dev->async_queue);
+    }
+}
+
 static esp_err_t msc_deinit_device(msc_device_t *dev, bool install_failed)
 {
     MSC_ENTER_CRITICAL();
@@ -261,9 +340,17 @@ static esp_err_t msc_deinit_device(msc_device_t *dev, bool install_failed)
     STAILQ_REMOVE(&s_msc_driver->devices_tailq, dev, msc_host_device, tailq_entry);
     MSC_EXIT_CRITICAL();
 
+    async_io_stop(dev);
     if (dev->transfer_done) {
         vSemaphoreDelete(dev->transfer_done);
     }
+    if (dev->command_lock) {
+        vSemaphoreDelete(dev->command_lock);
+    }
+    free(dev->stats);
+    heap_caps_free(dev->bounce_buf);
+    usb_disk_cache_deinit(&dev->disk);
+    msc_pipeline_deinit(dev);
     if (install_failed) {
         // Error code is unchecked, as it's unknown at what point installation failed.
         usb_host_interface_release(s_msc_driver->client_handle, dev->handle, dev->config.iface_num);
@@ -397,7 +484,7 @@ esp_err_t msc_host_install(const msc_host_driver_config_t *config)
 
     MSC_RETURN_ON_INVALID_ARG(config);
     MSC_RETURN_ON_INVALID_ARG(config->callback);
-    if ( config->create_backround_task ) {
+    if ( config->create_backround_task || config->async_queue_size ) {
         MSC_RETURN_ON_FALSE(config->stack_size != 0, ESP_ERR_INVALID_ARG);
         MSC_RETURN_ON_FALSE(config->task_priority != 0, ESP_ERR_INVALID_ARG);
     }
@@ -407,6 +494,16 @@ esp_err_t msc_host_install(const msc_host_driver_config_t *config)
     MSC_RETURN_ON_FALSE(driver, ESP_ERR_NO_MEM);
     driver->user_cb = config->callback;
     driver->user_arg = config->callback_arg;
+    driver->dma_bounce_buf_size = config->dma_bounce_buf_size;
+    driver->read_ahead_sectors = config->read_ahead_sectors;
+    driver->write_back_sectors = config->write_back_sectors;
+    driver->pipeline_depth = config->pipeline_depth;
+    driver->pipeline_transfer_size = config->pipeline_transfer_size;
+    driver->async_queue_size = config->async_queue_size;
+    driver->enable_stats = config->enable_stats;
+    driver->task_priority = config->task_priority;
+    driver->stack_size = config->stack_size;
+    driver->core_id = config->core_id;
 
     usb_host_client_config_t client_config = {
         .async.client_event_callback = client_event_cb,
@@ -478,6 +575,8 @@ esp_err_t msc_host_install_device(uint8_t device_address, msc_host_device_handle
 {
     esp_err_t ret;
     uint32_t block_size, block_count;
+    uint64_t block_count64;
+    uint8_t scsi_version;
     const usb_config_desc_t *config_desc;
     msc_device_t *msc_device;
 
@@ -490,21 +589,50 @@ esp_err_t msc_host_install_device(uint8_t device_address, msc_host_device_handle
     MSC_EXIT_CRITICAL();
 
     MSC_GOTO_ON_FALSE( msc_device->transfer_done = xSemaphoreCreateBinary(), ESP_ERR_NO_MEM);
+    MSC_GOTO_ON_FALSE( msc_device->command_lock = xSemaphoreCreateMutex(), ESP_ERR_NO_MEM);
+    if (s_msc_driver->enable_stats) {
+        MSC_GOTO_ON_FALSE( msc_device->stats = calloc(1, sizeof(msc_host_stats_t)), ESP_ERR_NO_MEM );
+    }
     MSC_GOTO_ON_ERROR( usb_host_device_open(s_msc_driver->client_handle, device_address, &msc_device->handle) );
     MSC_GOTO_ON_ERROR( usb_host_get_active_config_descriptor(msc_device->handle, &config_desc) );
     MSC_GOTO_ON_ERROR( extract_config_from_descriptor(config_desc, &msc_device->config) );
     MSC_GOTO_ON_ERROR( usb_host_transfer_alloc(DEFAULT_XFER_SIZE, 0, &msc_device->xfer) );
+    if (s_msc_driver->dma_bounce_buf_size) {
+        // Multiple of MPS, so that only the last chunk of an IN transfer can be a short packet
+        const size_t mps = msc_device->config.bulk_in_mps;
+        msc_device->bounce_buf_size = MAX(mps, s_msc_driver->dma_bounce_buf_size / mps * mps);
+        MSC_GOTO_ON_FALSE( msc_device->bounce_buf = heap_caps_malloc(msc_device->bounce_buf_size, MALLOC_CAP_DMA), ESP_ERR_NO_MEM );
+    }
+    if (s_msc_driver->pipeline_depth) {
+        MSC_GOTO_ON_ERROR( msc_pipeline_init(msc_device, s_msc_driver->pipeline_depth, s_msc_driver->pipeline_transfer_size) );
+    }
     MSC_GOTO_ON_ERROR( usb_host_interface_claim(
                            s_msc_driver->client_handle,
                            msc_device->handle,
                            msc_device->config.iface_num, 0) );
 
-    MSC_GOTO_ON_ERROR( scsi_cmd_inquiry(msc_device) );
+    MSC_GOTO_ON_ERROR( scsi_cmd_inquiry(msc_device, &scsi_version) );
     MSC_GOTO_ON_ERROR( msc_wait_for_ready_state(msc_device, WAIT_FOR_READY_TIMEOUT_MS) );
     MSC_GOTO_ON_ERROR( scsi_cmd_read_capacity(msc_device, &block_size, &block_count) );
+    block_count64 = block_count;
+    if (block_count == UINT32_MAX) {
+        // The capacity does not fit into READ CAPACITY(10)
+        MSC_GOTO_ON_ERROR( scsi_cmd_read_capacity16(msc_device, &block_size, &block_count64) );
+    }
+    // Many USB devices do not handle VPD pages well, so ask only those that claim to support them
+    if (scsi_version >= SCSI_VERSION_SPC3 &&
+            scsi_cmd_block_limits(msc_device, &msc_device->max_transfer_blocks) != ESP_OK) {
+        ESP_LOGD(TAG, "Block limits not reported");
+        msc_device->max_transfer_blocks = 0;
+    }
 
     msc_device->disk.block_size = block_size;
-    msc_device->disk.block_count = block_count;
+    msc_device->disk.block_count = block_count64;
+    msc_device->disk.read_ahead_blocks = s_msc_driver->read_ahead_sectors;
+    msc_device->disk.write_back_blocks = s_msc_driver->write_back_sectors;
+    if (s_msc_driver->async_queue_size) {
+        MSC_GOTO_ON_ERROR( async_io_start(msc_device) );
+    }
     *msc_device_handle = msc_device;
 
     return ESP_OK;
@@ -525,7 +653,7 @@ esp_err_t msc_host_read_sector(msc_host_device_handle_t device, size_t sector, v
     MSC_RETURN_ON_INVALID_ARG(device);
     msc_device_t *dev = (msc_device_t *)device;
 
-    return scsi_cmd_read10(dev, data, sector, 1, dev->disk.block_size);
+    return scsi_cmd_read(dev, data, sector, 1, dev->disk.block_size);
 }
 
 esp_err_t msc_host_write_sector(msc_host_device_handle_t device, size_t sector, const void *data, size_t size)
@@ -533,7 +661,68 @@ esp_err_t msc_host_write_sector(msc_host_device_handle_t device, size_t sector,
     MSC_RETURN_ON_INVALID_ARG(device);
     msc_device_t *dev = (msc_device_t *)device;
 
-    return scsi_cmd_write10(dev, data, sector, 1, dev->disk.block_size);
+    return scsi_cmd_write(dev, data, sector, 1, dev->disk.block_size);
+}
+
+static esp_err_t queue_async_request(msc_device_t *dev, bool write, size_t sector, void *data, size_t size,
+                                     msc_host_io_cb_t callback, void *arg)
+{
+    MSC_RETURN_ON_FALSE(dev->async_queue, ESP_ERR_INVALID_STATE);
+    MSC_RETURN_ON_FALSE(size % dev->disk.block_size == 0, ESP_ERR_INVALID_SIZE);
+
+    const msc_async_request_t request = {
+        .write = write,
+        .sector = sector,
+        .sector_count = size / dev->disk.block_size,
+        .data = data,
+        .callback = callback,
+        .arg = arg,
+    };
+    return xQueueSend(dev->async_queue, &request, 0) == pdTRUE ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+esp_err_t msc_host_read_sector_async(msc_host_device_handle_t device, size_t sector, void *data, size_t size,
+                                     msc_host_io_cb_t callback, void *arg)
+{
+    MSC_RETURN_ON_INVALID_ARG(device);
+    MSC_RETURN_ON_INVALID_ARG(data);
+    MSC_RETURN_ON_INVALID_ARG(callback);
+    return queue_async_request((msc_device_t *)device, false, sector, data, size, callback, arg);
+}
+
+esp_err_t msc_host_write_sector_async(msc_host_device_handle_t device, size_t sector, const void *data, size_t size,
+                                      msc_host_io_cb_t callback, void *arg)
+{
+    MSC_RETURN_ON_INVALID_ARG(device);
+    MSC_RETURN_ON_INVALID_ARG(data);
+    MSC_RETURN_ON_INVALID_ARG(callback);
+    return queue_async_request((msc_device_t *)device, true, sector, (void *)data, size, callback, arg);
+}
+
+esp_err_t msc_host_get_stats(msc_host_device_handle_t device, msc_host_stats_t *stats)
+{
+    MSC_RETURN_ON_INVALID_ARG(device);
+    MSC_RETURN_ON_INVALID_ARG(stats);
+    msc_device_t *dev = (msc_device_t *)device;
+    MSC_RETURN_ON_FALSE(dev->stats, ESP_ERR_INVALID_STATE);
+
+    // The statistics are updated by the commands, take a consistent copy between them
+    xSemaphoreTake(dev->command_lock, portMAX_DELAY);
+    *stats = *dev->stats;
+    xSemaphoreGive(dev->command_lock);
+    return ESP_OK;
+}
+
+esp_err_t msc_host_reset_stats(msc_host_device_handle_t device)
+{
+    MSC_RETURN_ON_INVALID_ARG(device);
+    msc_device_t *dev = (msc_device_t *)device;
+    MSC_RETURN_ON_FALSE(dev->stats, ESP_ERR_INVALID_STATE);
+
+    xSemaphoreTake(dev->command_lock, portMAX_DELAY);
+    memset(dev->stats, 0, sizeof(msc_host_stats_t));
+    xSemaphoreGive(dev->command_lock);
+    return ESP_OK;
 }
 
 static void copy_string_desc(wchar_t *dest, const usb_str_desc_t *src)
@@ -567,7 +756,7 @@ esp_err_t msc_host_get_device_info(msc_host_device_handle_t device, msc_host_dev
     info->idProduct = desc->idProduct;
     info->idVendor = desc->idVendor;
     info->sector_size = dev->disk.block_size;
-    info->sector_count = dev->disk.block_count;
+    info->sector_count = MIN(dev->disk.block_count, UINT32_MAX);
 
     copy_string_desc(info->iManufacturer, dev_info.str_desc_manufacturer);
     copy_string_desc(info->iProduct, dev_info.str_desc_product);
@@ -596,6 +785,9 @@ static void transfer_callback(usb_transfer_t *transfer)
         ESP_LOGE("Transfer failed", "Status %d", transfer->status);
     }
 
+    if (device->stats) {
+        device->xfer_done_us = esp_timer_get_time();
+    }
     xSemaphoreGive(device->transfer_done);
 }
 
@@ -611,23 +803,26 @@ static usb_transfer_status_t wait_for_transfer_done(usb_transfer_t *xfer)
         usb_host_endpoint_clear(xfer->device_handle, xfer->bEndpointAddress);
         xSemaphoreTake(device->transfer_done, portMAX_DELAY); // Since we flushed the EP, this should return immediately
         status = USB_TRANSFER_STATUS_TIMED_OUT;
+    } else if (device->stats) {
+        msc_stats_record(&device->stats->wakeup, device->xfer_done_us);
     }
 
     return status;
 }
 
-esp_err_t msc_bulk_transfer_zcpy(msc_device_t *device, uint8_t *data, size_t size, msc_endpoint_t ep)
+/**
+ * @brief Submit one BULK transfer and wait for it to finish
+ *
+ * @param[in]    device      MSC device handle
+ * @param[inout] data        DMA capable data buffer, at least 'size' rounded up to MPS long for IN transfers
+ * @param[in]    size        Size of the transfer in bytes
+ * @param[in]    ep          Direction of the transfer
+ * @param[out]   actual_size Number of bytes transferred
+ * @return esp_err_t
+ */
+static esp_err_t msc_bulk_transfer_submit(msc_device_t *device, uint8_t *data, size_t size, msc_endpoint_t ep, size_t *actual_size)
 {
     esp_err_t ret = ESP_OK;
-    uint8_t *data_cpy = NULL; // Pointer to copy of data in DMA capable region
-    bool realloc_data = !esp_ptr_dma_capable(data); // Flag that the data must be moved to DMA capable region
-
-    // Data that is not in DMA capable memory must be copied to DMA capable memory
-    if (realloc_data) {
-        data_cpy = heap_caps_malloc(size, MALLOC_CAP_DMA);
-        ESP_RETURN_ON_FALSE(data_cpy != NULL, ESP_ERR_NO_MEM, TAG, "Could not allocate %d bytes in DMA capable memory", size);
-    }
-
     usb_transfer_t *xfer = device->xfer;
     uint8_t *backup_buffer = xfer->data_buffer;
     size_t backup_size = xfer->data_buffer_size;
@@ -638,9 +833,6 @@ esp_err_t msc_bulk_transfer_zcpy(msc_device_t *device, uint8_t *data, size_t siz
     } else {
         xfer->bEndpointAddress = device->config.bulk_out_ep;
         xfer->num_bytes = size;
-        if (realloc_data) {
-            memcpy(data_cpy, data, size);
-        }
     }
 
     // Get pointers to start of data buffer and buffer size, so we can change it
@@ -648,7 +840,7 @@ esp_err_t msc_bulk_transfer_zcpy(msc_device_t *device, uint8_t *data, size_t siz
     size_t *siz = (size_t *)(&(xfer->data_buffer_size));
 
     // Attention: Here we modify 'private' members data_buffer and data_buffer_size
-    *ptr = realloc_data ? data_cpy : data; // This is actually xfer->data_buffer
+    *ptr = data; // This is actually xfer->data_buffer
     *siz = xfer->num_bytes; // This is actually xfer->data_buffer_size
     xfer->device_handle = device->handle;
     xfer->callback = transfer_callback;
@@ -659,9 +851,7 @@ esp_err_t msc_bulk_transfer_zcpy(msc_device_t *device, uint8_t *data, size_t siz
     const usb_transfer_status_t status = wait_for_transfer_done(xfer);
     switch (status) {
     case USB_TRANSFER_STATUS_COMPLETED:
-        if (realloc_data && (ep == MSC_EP_IN)) {
-            memcpy(data, data_cpy, xfer->actual_num_bytes);
-        }
+        *actual_size = MIN(xfer->actual_num_bytes, size);
         ret = ESP_OK;
         break;
     case USB_TRANSFER_STATUS_STALL:
@@ -671,14 +861,70 @@ esp_err_t msc_bulk_transfer_zcpy(msc_device_t *device, uint8_t *data, size_t siz
     }
 
 fail:
-    if (realloc_data) {
-        heap_caps_free(data_cpy);
-    }
     *ptr = backup_buffer;
     *siz = backup_size;
     return ret;
 }
 
+// Copy data between DMA capable memory and the user buffer, timed in the statistics
+static void copy_data(msc_device_t *device, void *dest, const void *src, size_t len)
+{
+    const int64_t start = msc_stats_start(device);
+    memcpy(dest, src, len);
+    if (device->stats) {
+        msc_stats_record(&device->stats->copy, start);
+    }
+}
+
+esp_err_t msc_bulk_transfer_zcpy(msc_device_t *device, uint8_t *data, size_t size, msc_endpoint_t ep)
+{
+    esp_err_t ret = ESP_OK;
+    size_t actual_size = 0;
+
+    if (esp_ptr_dma_capable(data)) {
+        return msc_bulk_transfer_submit(device, data, size, ep, &actual_size);
+    }
+
+    // Data that is not in DMA capable memory must be copied to DMA capable memory
+    if (!device->bounce_buf) {
+        uint8_t *data_cpy = heap_caps_malloc(usb_round_up_to_mps(size, device->config.bulk_in_mps), MALLOC_CAP_DMA);
+        ESP_RETURN_ON_FALSE(data_cpy != NULL, ESP_ERR_NO_MEM, TAG, "Could not allocate %d bytes in DMA capable memory", size);
+        if (ep == MSC_EP_OUT) {
+            copy_data(device, data_cpy, data, size);
+        }
+        ret = msc_bulk_transfer_submit(device, data_cpy, size, ep, &actual_size);
+        if (ret == ESP_OK && ep == MSC_EP_IN) {
+            copy_data(device, data, data_cpy, actual_size);
+        }
+        heap_caps_free(data_cpy);
+        if (device->stats) {
+            device->stats->alloc_buf_transfers++;
+        }
+        return ret;
+    }
+
+    // The data stage can be split into several transfers, so large data goes through the bounce buffer in chunks
+    size_t offset = 0;
+    do {
+        const size_t chunk_size = MIN(size - offset, device->bounce_buf_size);
+        if (ep == MSC_EP_OUT) {
+            copy_data(device, device->bounce_buf, data + offset, chunk_size);
+        }
+        MSC_RETURN_ON_ERROR( msc_bulk_transfer_submit(device, device->bounce_buf, chunk_size, ep, &actual_size) );
+        if (device->stats) {
+            device->stats->bounce_buf_transfers++;
+        }
+        if (ep == MSC_EP_IN) {
+            copy_data(device, data + offset, device->bounce_buf, actual_size);
+            if (actual_size < chunk_size) {
+                break; // Short packet, the device ended the data stage
+            }
+        }
+        offset += chunk_size;
+    } while (offset < size);
+    return ESP_OK;
+}
+
 esp_err_t msc_control_transfer(msc_device_t *device, size_t len)
 {
     usb_transfer_t *xfer = device->xfer;
@@ -14,6 +14,7 @@
 #include "ffconf.h"
 #include "ff.h"
 #include "esp_idf_version.h"
+#include "msc_scsi_bot.h"
 
 #define DRIVE_STR_LEN 3
 
@@ -21,20 +22,31 @@ typedef struct msc_host_vfs {
     char drive[DRIVE_STR_LEN];
     char *base_path;
     uint8_t pdrv;
+    usb_disk_t *disk;
 } msc_host_vfs_t;
 
 static const char *TAG = "MSC VFS";
 
+// f_mkfs() writes the file system tables by pieces of the work buffer size
+#define FORMAT_WORKBUF_SIZE_MIN 4096
+#define FORMAT_WORKBUF_SIZE_MAX (32 * 1024)
+
 static esp_err_t msc_format_storage(size_t block_size, size_t allocation_size, const char *drv)
 {
     void *workbuf = NULL;
-    const size_t workbuf_size = 4096;
-
-    MSC_RETURN_ON_FALSE( workbuf = ff_memalloc(workbuf_size), ESP_ERR_NO_MEM );
 
     // Valid value of cluster size is between sector_size and 128 * sector_size.
     size_t cluster_size = MIN(MAX(allocation_size, block_size), 128 * block_size);
 
+    // One cluster at a time if the memory allows it
+    size_t workbuf_size = MIN(MAX(cluster_size, FORMAT_WORKBUF_SIZE_MIN), FORMAT_WORKBUF_SIZE_MAX);
+    workbuf = ff_memalloc(workbuf_size);
+    if (!workbuf && workbuf_size > FORMAT_WORKBUF_SIZE_MIN) {
+        workbuf_size = FORMAT_WORKBUF_SIZE_MIN;
+        workbuf = ff_memalloc(workbuf_size);
+    }
+    MSC_RETURN_ON_FALSE( workbuf, ESP_ERR_NO_MEM );
+
 #if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
     FRESULT err = f_mkfs(drv, FM_ANY | FM_SFD, cluster_size, workbuf, workbuf_size);
 #else
@@ -81,13 +93,15 @@ esp_err_t msc_host_vfs_register(msc_host_device_handle_t device,
 
     MSC_GOTO_ON_ERROR( ff_diskio_get_drive(&pdrv) );
 
-    ff_diskio_register_msc(pdrv, &dev->disk);
     char drive[DRIVE_STR_LEN] = {(char)('0' + pdrv), ':', 0};
+    MSC_GOTO_ON_ERROR( usb_disk_cache_init(&dev->disk) );
+    ff_diskio_register_msc(pdrv, &dev->disk);
     diskio_registered = true;
 
     strncpy(vfs->drive, drive, DRIVE_STR_LEN);
     MSC_GOTO_ON_FALSE( vfs->base_path = strdup(base_path), ESP_ERR_NO_MEM );
     vfs->pdrv = pdrv;
+    vfs->disk = &dev->disk;
 
     MSC_GOTO_ON_ERROR( esp_vfs_fat_register(base_path, drive, mount_config->max_files, &fs) );
 
@@ -110,6 +124,7 @@ fail:
     if (diskio_registered) {
         ff_diskio_unregister(pdrv);
     }
+    usb_disk_cache_deinit(&dev->disk);
     esp_vfs_fat_unregister_path(base_path);
     if (fs) {
         f_mount(NULL, drive, 0);
@@ -124,8 +139,79 @@ esp_err_t msc_host_vfs_unregister(msc_host_vfs_handle_t vfs_handle)
     msc_host_vfs_t *vfs = (msc_host_vfs_t *)vfs_handle;
 
     f_mount(NULL, vfs->drive, 0);
+    usb_disk_cache_flush(vfs->disk);
+    usb_disk_cache_deinit(vfs->disk);
     ff_diskio_unregister(vfs->pdrv);
     esp_vfs_fat_unregister_path(vfs->base_path);
     dealloc_msc_vfs(vfs);
     return ESP_OK;
 }
+
+esp_err_t msc_host_vfs_create_contiguous_file(msc_host_vfs_handle_t vfs_handle, const char *path, size_t size,
+        uint32_t *first_sector)
+{
+    MSC_RETURN_ON_INVALID_ARG(vfs_handle);
+    MSC_RETURN_ON_INVALID_ARG(path);
+#if FF_USE_EXPAND
+    msc_host_vfs_t *vfs = (msc_host_vfs_t *)vfs_handle;
+    const size_t base_len = strlen(vfs->base_path);
+    MSC_RETURN_ON_FALSE(strncmp(path, vfs->base_path, base_len) == 0 && path[base_len] == '/', ESP_ERR_INVALID_ARG);
+    MSC_RETURN_ON_FALSE(size > 0, ESP_ERR_INVALID_SIZE);
+
+    esp_err_t ret = ESP_FAIL;
+    // FIL holds a sector buffer, too large for the stack
+    FIL *file = calloc(1, sizeof(FIL));
+    char *drive_path = malloc(DRIVE_STR_LEN + strlen(path) - base_len);
+    MSC_GOTO_ON_FALSE(file && drive_path, ESP_ERR_NO_MEM);
+    sprintf(drive_path, "%s%s", vfs->drive, path + base_len);
+
+    FRESULT fresult = f_open(file, drive_path, FA_WRITE | FA_CREATE_ALWAYS);
+    if (fresult != FR_OK) {
+        ESP_LOGE(TAG, "f_open failed (%d)", fresult);
+        goto fail;
+    }
+    fresult = f_expand(file, size, 1);
+    if (fresult == FR_OK && first_sector) {
+        // The clusters are numbered from 2 in the data area
+        const FATFS *fs = file->obj.fs;
+        *first_sector = fs->database + fs->csize * (file->obj.sclust - 2);
+    }
+    if (fresult != FR_OK) {
+        ESP_LOGE(TAG, "f_expand failed (%d)", fresult);
+        f_close(file);
+        f_unlink(drive_path);
+        ret = (fresult == FR_DENIED) ? ESP_ERR_NO_MEM : ESP_FAIL;
+        goto fail;
+    }
+    MSC_GOTO_ON_FALSE(f_close(file) == FR_OK, ESP_FAIL);
+    ret = ESP_OK;
+
+fail:
+    free(drive_path);
+    free(file);
+    return ret;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t msc_host_vfs_write_sectors(msc_host_vfs_handle_t vfs_handle, uint32_t sector, const void *data, size_t size)
+{
+    MSC_RETURN_ON_INVALID_ARG(vfs_handle);
+    MSC_RETURN_ON_INVALID_ARG(data);
+    msc_host_vfs_t *vfs = (msc_host_vfs_t *)vfs_handle;
+    usb_disk_t *disk = vfs->disk;
+    MSC_RETURN_ON_FALSE(size % disk->block_size == 0, ESP_ERR_INVALID_SIZE);
+    const uint32_t count = size / disk->block_size;
+    MSC_RETURN_ON_FALSE(sector + (uint64_t)count <= MIN(disk->block_count, UINT32_MAX), ESP_ERR_INVALID_SIZE);
+
+    // The block cache must not hold older copies of these sectors, nor read them from the device before they are written
+    usb_disk_lock(disk);
+    esp_err_t ret = usb_disk_cache_invalidate(disk, sector, count);
+    if (ret == ESP_OK) {
+        msc_device_t *dev = __containerof(disk, msc_device_t, disk);
+        ret = scsi_cmd_write(dev, data, sector, count, disk->block_size);
+    }
+    usb_disk_unlock(disk);
+    return ret;
+}
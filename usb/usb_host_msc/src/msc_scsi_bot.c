@@ -11,11 +11,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <sys/param.h>
 #include "esp_check.h"
 #include "esp_log.h"
 #include "msc_common.h"
 #include "msc_scsi_bot.h"
 #include "usb/msc_host.h"
+#include "soc/soc_memory_layout.h"
 
 static const char *TAG = "USB_MSC_SCSI";
 
@@ -31,7 +33,9 @@ static const char *TAG = "USB_MSC_SCSI";
 #define SCSI_CMD_PREVENT_ALLOW_MEDIUM_REMOVAL 0x1E
 #define SCSI_CMD_READ10 0x28
 #define SCSI_CMD_READ12 0xA8
+#define SCSI_CMD_READ16 0x88
 #define SCSI_CMD_READ_CAPACITY 0x25
+#define SCSI_CMD_SERVICE_ACTION_IN16 0x9E
 #define SCSI_CMD_READ_FORMAT_CAPACITIES 0x23
 #define SCSI_CMD_REQUEST_SENSE 0x03
 #define SCSI_CMD_REZERO 0x01
@@ -42,8 +46,16 @@ static const char *TAG = "USB_MSC_SCSI";
 #define SCSI_CMD_VERIFY 0x2F
 #define SCSI_CMD_WRITE10 0x2A
 #define SCSI_CMD_WRITE12 0xAA
+#define SCSI_CMD_WRITE16 0x8A
 #define SCSI_CMD_WRITE_AND_VERIFY 0x2E
 
+#define SCSI_SA_READ_CAPACITY16 0x10
+
+#define INQUIRY_FLAG_EVPD           (1 << 0)
+#define INQUIRY_VPD_BLOCK_LIMITS    0xB0
+
+#define READ10_MAX_BLOCKS   UINT16_MAX
+
 #define IN_DIR   CWB_FLAG_DIRECTION_IN
 #define OUT_DIR  0
 
@@ -118,6 +130,17 @@ typedef struct __attribute__((packed))
     uint8_t reserved2[1];
 } cbw_write10_t;
 
+typedef struct __attribute__((packed))
+{
+    msc_cbw_t base;
+    uint8_t opcode;
+    uint8_t flags;
+    uint64_t address;
+    uint32_t length;
+    uint8_t group;
+    uint8_t control;
+} cbw_read16_t, cbw_write16_t;
+
 typedef struct __attribute__((packed))
 {
     msc_cbw_t base;
@@ -127,6 +150,24 @@ typedef struct __attribute__((packed))
     uint8_t reserved[6];
 } cbw_read_capacity_t;
 
+typedef struct __attribute__((packed))
+{
+    msc_cbw_t base;
+    uint8_t opcode;
+    uint8_t service_action;
+    uint64_t address;
+    uint32_t allocation_length;
+    uint8_t pmi;
+    uint8_t control;
+} cbw_read_capacity16_t;
+
+typedef struct __attribute__((packed))
+{
+    uint64_t block_count;
+    uint32_t block_size;
+    uint8_t reserved[20];
+} cbw_read_capacity16_response_t;
+
 typedef struct __attribute__((packed))
 {
     uint32_t block_count;
@@ -203,9 +244,29 @@ typedef struct __attribute__((packed))
 
 typedef struct __attribute__((packed))
 {
-    uint8_t data[36];
+    uint8_t peripheral;
+    uint8_t rmb;
+    uint8_t version;
+    uint8_t data[33];
 } cbw_inquiry_response_t;
 
+/**
+ * @brief Block Limits VPD page, in the short form of SBC-2 that every version of the page starts with
+ *
+ * @see SCSI Block Commands - 3, Chapter 6.5.3
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t peripheral;
+    uint8_t page_code;
+    uint16_t page_length;
+    uint8_t reserved;
+    uint8_t max_compare_and_write_length;
+    uint16_t optimal_transfer_length_granularity;
+    uint32_t max_transfer_length;
+    uint32_t optimal_transfer_length;
+} cbw_block_limits_response_t;
+
 // Unique number based on which MSC protocol pairs request and response
 static uint32_t cbw_tag;
 
@@ -221,6 +282,70 @@ static esp_err_t check_csw(msc_csw_t *csw, uint32_t tag)
     return csw_ok ? ESP_OK : ESP_FAIL;
 }
 
+// Execute BOT command, with the command lock of the device taken
+static esp_err_t bot_execute_command_locked(msc_device_t *device, msc_cbw_t *cbw, void *data, size_t size)
+{
+    msc_csw_t csw;
+    esp_err_t err;
+    msc_endpoint_t ep = (cbw->flags & CWB_FLAG_DIRECTION_IN) ? MSC_EP_IN : MSC_EP_OUT;
+    msc_host_stats_t *stats = device->stats;
+    int64_t start;
+
+    if (device->pipeline && (!data || esp_ptr_dma_capable(data))) {
+        // 1. - 3. All stages queued together
+        err = msc_bulk_transfer_pipelined(device, (uint8_t *)cbw, CBW_SIZE, data, size, ep, (uint8_t *)&csw);
+        if (stats) {
+            stats->pipelined_commands++;
+        }
+    } else {
+        // 1. Command transport
+        start = msc_stats_start(device);
+        MSC_RETURN_ON_ERROR( msc_bulk_transfer_zcpy(device, (uint8_t *)cbw, CBW_SIZE, MSC_EP_OUT) );
+        if (stats) {
+            msc_stats_record(&stats->cbw, start);
+        }
+
+        // 2. Optional data transport
+        if (data) {
+            start = msc_stats_start(device);
+            MSC_RETURN_ON_ERROR( msc_bulk_transfer_zcpy(device, (uint8_t *)data, size, ep) );
+            if (stats) {
+                msc_stats_record(&stats->data, start);
+            }
+        }
+
+        // 3. Status transport
+        start = msc_stats_start(device);
+        err = msc_bulk_transfer_zcpy(device, (uint8_t *)&csw, sizeof(msc_csw_t), MSC_EP_IN);
+        if (stats) {
+            msc_stats_record(&stats->csw, start);
+        }
+    }
+    if (stats && data && err == ESP_OK) {
+        if (ep == MSC_EP_IN) {
+            stats->bytes_read += size;
+        } else {
+            stats->bytes_written += size;
+        }
+    }
+
+    // 3.1 Error recovery
+    if (err == ESP_ERR_MSC_STALL) {
+        // In case of the status transport failure, we can try reading the status again after clearing feature
+        ESP_RETURN_ON_ERROR( clear_feature(device, device->config.bulk_in_ep), TAG, "Clear feature failed" );
+        err = msc_bulk_transfer_zcpy(device, (uint8_t *)&csw, sizeof(msc_csw_t), MSC_EP_IN);
+        if (ESP_OK != err) {
+            // In case the repeated status transport failed we do reset recovery
+            // We don't check the error code here, the command has already failed.
+            msc_host_reset_recovery(device);
+        }
+    }
+
+    MSC_RETURN_ON_ERROR(err);
+
+    return check_csw(&csw, cbw->tag);
+}
+
 /**
  * @brief Execute BOT command
  *
@@ -242,35 +367,18 @@ static esp_err_t check_csw(msc_csw_t *csw, uint32_t tag)
  */
 esp_err_t bot_execute_command(msc_device_t *device, msc_cbw_t *cbw, void *data, size_t size)
 {
-    msc_csw_t csw;
-    msc_endpoint_t ep = (cbw->flags & CWB_FLAG_DIRECTION_IN) ? MSC_EP_IN : MSC_EP_OUT;
-
-    // 1. Command transport
-    MSC_RETURN_ON_ERROR( msc_bulk_transfer_zcpy(device, (uint8_t *)cbw, CBW_SIZE, MSC_EP_OUT) );
-
-    // 2. Optional data transport
-    if (data) {
-        MSC_RETURN_ON_ERROR( msc_bulk_transfer_zcpy(device, (uint8_t *)data, size, ep) );
-    }
-
-    // 3. Status transport
-    esp_err_t err = msc_bulk_transfer_zcpy(device, (uint8_t *)&csw, sizeof(msc_csw_t), MSC_EP_IN);
-
-    // 3.1 Error recovery
-    if (err == ESP_ERR_MSC_STALL) {
-        // In case of the status transport failure, we can try reading the status again after clearing feature
-        ESP_RETURN_ON_ERROR( clear_feature(device, device->config.bulk_in_ep), TAG, "Clear feature failed" );
-        err = msc_bulk_transfer_zcpy(device, (uint8_t *)&csw, sizeof(msc_csw_t), MSC_EP_IN);
-        if (ESP_OK != err) {
-            // In case the repeated status transport failed we do reset recovery
-            // We don't check the error code here, the command has already failed.
-            msc_host_reset_recovery(device);
+    // Commands may come from the I/O task and from the application at the same time
+    xSemaphoreTake(device->command_lock, portMAX_DELAY);
+    const int64_t start = msc_stats_start(device);
+    esp_err_t err = bot_execute_command_locked(device, cbw, data, size);
+    if (device->stats) {
+        msc_stats_record(&device->stats->command, start);
+        if (err != ESP_OK) {
+            device->stats->errors++;
         }
     }
-
-    MSC_RETURN_ON_ERROR(err);
-
-    return check_csw(&csw, cbw->tag);
+    xSemaphoreGive(device->command_lock);
+    return err;
 }
 
 
@@ -309,6 +417,103 @@ esp_err_t scsi_cmd_write10(msc_host_device_handle_t dev,
     return bot_execute_command(device, &cbw.base, (void *)data, num_sectors * sector_size);
 }
 
+esp_err_t scsi_cmd_read16(msc_host_device_handle_t dev,
+                          uint8_t *data,
+                          uint64_t sector_address,
+                          uint32_t num_sectors,
+                          uint32_t sector_size)
+{
+    msc_device_t *device = (msc_device_t *)dev;
+    cbw_read16_t cbw = {
+        CBW_BASE_INIT(IN_DIR, CBW_CMD_SIZE(cbw_read16_t), num_sectors * sector_size),
+        .opcode = SCSI_CMD_READ16,
+        .address = __builtin_bswap64(sector_address),
+        .length = __builtin_bswap32(num_sectors),
+    };
+
+    return bot_execute_command(device, &cbw.base, data, num_sectors * sector_size);
+}
+
+esp_err_t scsi_cmd_write16(msc_host_device_handle_t dev,
+                           const uint8_t *data,
+                           uint64_t sector_address,
+                           uint32_t num_sectors,
+                           uint32_t sector_size)
+{
+    msc_device_t *device = (msc_device_t *)dev;
+    cbw_write16_t cbw = {
+        CBW_BASE_INIT(OUT_DIR, CBW_CMD_SIZE(cbw_write16_t), num_sectors * sector_size),
+        .opcode = SCSI_CMD_WRITE16,
+        .address = __builtin_bswap64(sector_address),
+        .length = __builtin_bswap32(num_sectors),
+    };
+
+    return bot_execute_command(device, &cbw.base, (void *)data, num_sectors * sector_size);
+}
+
+/**
+ * @brief Max number of sectors of one command
+ *
+ * Limited by the device's max transfer length, the length field of the command and the 32 bit data length of the CBW
+ */
+static uint32_t max_command_sectors(const msc_device_t *device, bool len16, uint32_t sector_size)
+{
+    uint32_t max_sectors = len16 ? UINT32_MAX / sector_size : READ10_MAX_BLOCKS;
+    if (device->max_transfer_blocks) {
+        max_sectors = MIN(max_sectors, device->max_transfer_blocks);
+    }
+    return max_sectors;
+}
+
+static inline bool needs_cmd16(uint64_t sector_address, uint32_t num_sectors)
+{
+    return sector_address + num_sectors - 1 > UINT32_MAX;
+}
+
+esp_err_t scsi_cmd_read(msc_host_device_handle_t dev,
+                        uint8_t *data,
+                        uint64_t sector_address,
+                        uint32_t num_sectors,
+                        uint32_t sector_size)
+{
+    msc_device_t *device = (msc_device_t *)dev;
+    while (num_sectors) {
+        const bool cmd16 = needs_cmd16(sector_address, num_sectors);
+        const uint32_t count = MIN(num_sectors, max_command_sectors(device, cmd16, sector_size));
+        if (cmd16) {
+            MSC_RETURN_ON_ERROR( scsi_cmd_read16(device, data, sector_address, count, sector_size) );
+        } else {
+            MSC_RETURN_ON_ERROR( scsi_cmd_read10(device, data, sector_address, count, sector_size) );
+        }
+        data += count * sector_size;
+        sector_address += count;
+        num_sectors -= count;
+    }
+    return ESP_OK;
+}
+
+esp_err_t scsi_cmd_write(msc_host_device_handle_t dev,
+                         const uint8_t *data,
+                         uint64_t sector_address,
+                         uint32_t num_sectors,
+                         uint32_t sector_size)
+{
+    msc_device_t *device = (msc_device_t *)dev;
+    while (num_sectors) {
+        const bool cmd16 = needs_cmd16(sector_address, num_sectors);
+        const uint32_t count = MIN(num_sectors, max_command_sectors(device, cmd16, sector_size));
+        if (cmd16) {
+            MSC_RETURN_ON_ERROR( scsi_cmd_write16(device, data, sector_address, count, sector_size) );
+        } else {
+            MSC_RETURN_ON_ERROR( scsi_cmd_write10(device, data, sector_address, count, sector_size) );
+        }
+        data += count * sector_size;
+        sector_address += count;
+        num_sectors -= count;
+    }
+    return ESP_OK;
+}
+
 esp_err_t scsi_cmd_read_capacity(msc_host_device_handle_t dev, uint32_t *block_size, uint32_t *block_count)
 {
     msc_device_t *device = (msc_device_t *)dev;
@@ -327,6 +532,26 @@ esp_err_t scsi_cmd_read_capacity(msc_host_device_handle_t dev, uint32_t *block_s
     return ESP_OK;
 }
 
+esp_err_t scsi_cmd_read_capacity16(msc_host_device_handle_t dev, uint32_t *block_size, uint64_t *block_count)
+{
+    msc_device_t *device = (msc_device_t *)dev;
+    cbw_read_capacity16_response_t response;
+
+    cbw_read_capacity16_t cbw = {
+        CBW_BASE_INIT(IN_DIR, CBW_CMD_SIZE(cbw_read_capacity16_t), sizeof(response)),
+        .opcode = SCSI_CMD_SERVICE_ACTION_IN16,
+        .service_action = SCSI_SA_READ_CAPACITY16,
+        .allocation_length = __builtin_bswap32(sizeof(response)),
+    };
+
+    MSC_RETURN_ON_ERROR( bot_execute_command(device, &cbw.base, &response, sizeof(response)) );
+
+    *block_count = __builtin_bswap64(response.block_count);
+    *block_size = __builtin_bswap32(response.block_size);
+
+    return ESP_OK;
+}
+
 esp_err_t scsi_cmd_unit_ready(msc_host_device_handle_t dev)
 {
     msc_device_t *device = (msc_device_t *)dev;
@@ -363,7 +588,7 @@ esp_err_t scsi_cmd_sense(msc_host_device_handle_t dev, scsi_sense_data_t *sense)
     return ESP_OK;
 }
 
-esp_err_t scsi_cmd_inquiry(msc_host_device_handle_t dev)
+esp_err_t scsi_cmd_inquiry(msc_host_device_handle_t dev, uint8_t *version)
 {
     msc_device_t *device = (msc_device_t *)dev;
     cbw_inquiry_response_t response = { 0 };
@@ -374,7 +599,32 @@ esp_err_t scsi_cmd_inquiry(msc_host_device_handle_t dev)
         .allocation_length = sizeof(response),
     };
 
-    return bot_execute_command(device, &cbw.base, &response, sizeof(response) );
+    MSC_RETURN_ON_ERROR( bot_execute_command(device, &cbw.base, &response, sizeof(response)) );
+
+    if (version) {
+        *version = response.version;
+    }
+    return ESP_OK;
+}
+
+esp_err_t scsi_cmd_block_limits(msc_host_device_handle_t dev, uint32_t *max_transfer_length)
+{
+    msc_device_t *device = (msc_device_t *)dev;
+    cbw_block_limits_response_t response = { 0 };
+
+    cbw_inquiry_t cbw = {
+        CBW_BASE_INIT(IN_DIR, CBW_CMD_SIZE(cbw_inquiry_t), sizeof(response)),
+        .opcode = SCSI_CMD_INQUIRY,
+        .flags = INQUIRY_FLAG_EVPD,
+        .page_code = INQUIRY_VPD_BLOCK_LIMITS,
+        .allocation_length = sizeof(response),
+    };
+
+    MSC_RETURN_ON_ERROR( bot_execute_command(device, &cbw.base, &response, sizeof(response)) );
+    MSC_RETURN_ON_FALSE( response.page_code == INQUIRY_VPD_BLOCK_LIMITS, ESP_ERR_NOT_SUPPORTED );
+
+    *max_transfer_length = __builtin_bswap32(response.max_transfer_length);
+    return ESP_OK;
 }
 
 esp_err_t scsi_cmd_mode_sense(msc_host_device_handle_t dev)
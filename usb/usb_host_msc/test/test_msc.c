@@ -7,6 +7,7 @@
 
 #include "unity.h"
 #include <string.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include <inttypes.h>
 #include "esp_private/usb_phy.h"
@@ -15,6 +16,8 @@
 #include "usb/msc_host_vfs.h"
 #include "test_common.h"
 #include "esp_idf_version.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
 #include "../private_include/msc_common.h"
 
 #if SOC_USB_OTG_SUPPORTED
@@ -220,19 +223,26 @@ static void msc_test_wait_and_install_device(void)
     ESP_OK_ASSERT( msc_host_vfs_register(device, "/usb", &mount_config, &vfs_handle) );
 }
 
-static void msc_setup(void)
+#define MSC_TEST_DRIVER_CONFIG_DEFAULT() {  \
+    .create_backround_task = true,          \
+    .callback = msc_event_cb,               \
+    .stack_size = 4096,                     \
+    .task_priority = 5,                     \
+}
+
+static void msc_setup_with_config(const msc_host_driver_config_t *msc_config)
 {
     msc_test_init();
-    const msc_host_driver_config_t msc_config = {
-        .create_backround_task = true,
-        .callback = msc_event_cb,
-        .stack_size = 4096,
-        .task_priority = 5,
-    };
-    ESP_OK_ASSERT( msc_host_install(&msc_config) );
+    ESP_OK_ASSERT( msc_host_install(msc_config) );
     msc_test_wait_and_install_device();
 }
 
+static void msc_setup(void)
+{
+    const msc_host_driver_config_t msc_config = MSC_TEST_DRIVER_CONFIG_DEFAULT();
+    msc_setup_with_config(&msc_config);
+}
+
 static void msc_test_uninstall_device(void)
 {
     ESP_OK_ASSERT( msc_host_vfs_unregister(vfs_handle) );
@@ -427,6 +437,244 @@ TEST_CASE("setvbuf", "[usb_msc]")
     msc_teardown();
 }
 
+/**
+ * @brief Files are written and read through the block cache
+ *
+ * The file is written and read in pieces smaller than a sector, so that the read-ahead and write-back buffers
+ * are partially hit. The file is checked again after remounting, to make sure that the write-back buffer is flushed.
+ */
+TEST_CASE("block_cache", "[usb_msc]")
+{
+    const size_t file_size = 16 * 1024;
+    const size_t piece_size = 100;
+    msc_host_driver_config_t msc_config = MSC_TEST_DRIVER_CONFIG_DEFAULT();
+    msc_config.read_ahead_sectors = 8;
+    msc_config.write_back_sectors = 8;
+    msc_setup_with_config(&msc_config);
+
+    uint8_t *buf = malloc(piece_size);
+    TEST_ASSERT_NOT_NULL(buf);
+    FILE *file = fopen("/usb/cache", "w");
+    TEST_ASSERT_NOT_NULL(file);
+    setvbuf(file, NULL, _IONBF, 0); // Every fwrite() goes to the file system
+    for (size_t offset = 0; offset < file_size; offset += piece_size) {
+        for (size_t i = 0; i < piece_size; i++) {
+            buf[i] = (offset + i) & 0xFF;
+        }
+        TEST_ASSERT_EQUAL(piece_size, fwrite(buf, 1, piece_size, file));
+    }
+    fclose(file);
+
+    for (int remount = 0; remount < 2; remount++) {
+        if (remount) {
+            ESP_OK_ASSERT( msc_host_vfs_unregister(vfs_handle) );
+            ESP_OK_ASSERT( msc_host_vfs_register(device, "/usb", &mount_config, &vfs_handle) );
+        }
+        file = fopen("/usb/cache", "r");
+        TEST_ASSERT_NOT_NULL(file);
+        setvbuf(file, NULL, _IONBF, 0);
+        for (size_t offset = 0; offset < file_size; offset += piece_size) {
+            TEST_ASSERT_EQUAL(piece_size, fread(buf, 1, piece_size, file));
+            for (size_t i = 0; i < piece_size; i++) {
+                TEST_ASSERT_EQUAL_HEX8((offset + i) & 0xFF, buf[i]);
+            }
+        }
+        fclose(file);
+    }
+
+    free(buf);
+    msc_teardown();
+}
+
+/**
+ * @brief A contiguous file is written by sectors and read through the file system
+ *
+ * The read-ahead buffer holds the start of the file before it is written, to make sure that it is invalidated.
+ */
+TEST_CASE("contiguous_file", "[usb_msc]")
+{
+    const size_t file_size = 8 * DISK_BLOCK_SIZE;
+    msc_host_driver_config_t msc_config = MSC_TEST_DRIVER_CONFIG_DEFAULT();
+    msc_config.read_ahead_sectors = 8;
+    msc_setup_with_config(&msc_config);
+
+    uint32_t first_sector;
+    esp_err_t err = msc_host_vfs_create_contiguous_file(vfs_handle, "/usb/contig", file_size, &first_sector);
+    if (err == ESP_ERR_NOT_SUPPORTED) {
+        msc_teardown();
+        TEST_IGNORE_MESSAGE("f_expand() not enabled in FATFS");
+    }
+    ESP_OK_ASSERT(err);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, msc_host_vfs_create_contiguous_file(vfs_handle, "/other/file", file_size, NULL));
+
+    uint8_t *buf = heap_caps_malloc(file_size, MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(buf);
+    FILE *file = fopen("/usb/contig", "r");
+    TEST_ASSERT_NOT_NULL(file);
+    setvbuf(file, NULL, _IONBF, 0);
+    TEST_ASSERT_EQUAL(DISK_BLOCK_SIZE, fread(buf, 1, DISK_BLOCK_SIZE, file));
+
+    for (size_t i = 0; i < file_size; i++) {
+        buf[i] = i & 0xFF;
+    }
+    ESP_OK_ASSERT( msc_host_vfs_write_sectors(vfs_handle, first_sector, buf, file_size) );
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, msc_host_vfs_write_sectors(vfs_handle, first_sector, buf, 100));
+
+    memset(buf, 0, file_size);
+    rewind(file);
+    TEST_ASSERT_EQUAL(file_size, fread(buf, 1, file_size, file));
+    for (size_t i = 0; i < file_size; i++) {
+        TEST_ASSERT_EQUAL_HEX8(i & 0xFF, buf[i]);
+    }
+    fclose(file);
+
+    free(buf);
+    msc_teardown();
+}
+
+static void async_io_done(msc_host_device_handle_t dev, esp_err_t result, void *arg)
+{
+    TEST_ASSERT_EQUAL(device, dev);
+    ESP_OK_ASSERT(result);
+    xSemaphoreGive((SemaphoreHandle_t)arg);
+}
+
+/**
+ * @brief Sectors are written and read asynchronously
+ *
+ * Both halves of a double buffer are queued before waiting for any of them, up to the queue size.
+ */
+TEST_CASE("async_sector_io", "[usb_msc]")
+{
+    const size_t sectors = 4;
+    const size_t half = sectors * DISK_BLOCK_SIZE;
+    msc_host_driver_config_t msc_config = MSC_TEST_DRIVER_CONFIG_DEFAULT();
+    msc_config.async_queue_size = 2;
+    msc_setup_with_config(&msc_config);
+
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(2, 0);
+    uint8_t *write_data = heap_caps_malloc(2 * half, MALLOC_CAP_DMA);
+    uint8_t *read_data = heap_caps_calloc(1, 2 * half, MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(done);
+    TEST_ASSERT_NOT_NULL(write_data);
+    TEST_ASSERT_NOT_NULL(read_data);
+    for (int i = 0; i < 2 * half; i++) {
+        write_data[i] = (i * 5) & 0xFF;
+    }
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, msc_host_write_sector_async(device, 10, write_data, 1, async_io_done, done));
+    ESP_OK_ASSERT( msc_host_write_sector_async(device, 10, write_data, half, async_io_done, done) );
+    ESP_OK_ASSERT( msc_host_write_sector_async(device, 10 + sectors, write_data + half, half, async_io_done, done) );
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_TRUE( xSemaphoreTake(done, pdMS_TO_TICKS(5000)) );
+    }
+    ESP_OK_ASSERT( msc_host_read_sector_async(device, 10, read_data, half, async_io_done, done) );
+    ESP_OK_ASSERT( msc_host_read_sector_async(device, 10 + sectors, read_data + half, half, async_io_done, done) );
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_TRUE( xSemaphoreTake(done, pdMS_TO_TICKS(5000)) );
+    }
+    TEST_ASSERT_EQUAL_MEMORY(write_data, read_data, 2 * half);
+
+    vSemaphoreDelete(done);
+    free(write_data);
+    free(read_data);
+    msc_teardown();
+}
+
+/**
+ * @brief Reads and writes longer than the max transfer length are split into several commands
+ */
+TEST_CASE("max_transfer_length", "[usb_msc]")
+{
+    const size_t sectors = 6;
+    msc_setup();
+    msc_device_t *dev = (msc_device_t *)device;
+    const uint32_t max_transfer_blocks = dev->max_transfer_blocks;
+    dev->max_transfer_blocks = 4;
+
+    uint8_t *write_data = heap_caps_malloc(sectors * DISK_BLOCK_SIZE, MALLOC_CAP_DMA);
+    uint8_t *read_data = heap_caps_calloc(1, sectors * DISK_BLOCK_SIZE, MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(write_data);
+    TEST_ASSERT_NOT_NULL(read_data);
+    for (int i = 0; i < sectors * DISK_BLOCK_SIZE; i++) {
+        write_data[i] = (i * 3) & 0xFF;
+    }
+
+    ESP_OK_ASSERT( scsi_cmd_write(device, write_data, 10, sectors, DISK_BLOCK_SIZE) );
+    ESP_OK_ASSERT( scsi_cmd_read(device, read_data, 10, sectors, DISK_BLOCK_SIZE) );
+    TEST_ASSERT_EQUAL_MEMORY(write_data, read_data, sectors * DISK_BLOCK_SIZE);
+
+    free(write_data);
+    free(read_data);
+    dev->max_transfer_blocks = max_transfer_blocks;
+    msc_teardown();
+}
+
+/**
+ * @brief Sectors are read and written with pipelined transfers
+ *
+ * The transfer size is smaller than the data, so that the data stage is split into more transfers than the pipeline depth.
+ */
+TEST_CASE("pipelined_transfers", "[usb_msc]")
+{
+    const size_t sectors = 16;
+    msc_host_driver_config_t msc_config = MSC_TEST_DRIVER_CONFIG_DEFAULT();
+    msc_config.pipeline_depth = 2;
+    msc_config.pipeline_transfer_size = DISK_BLOCK_SIZE;
+    msc_setup_with_config(&msc_config);
+
+    uint8_t *write_data = heap_caps_malloc(sectors * DISK_BLOCK_SIZE, MALLOC_CAP_DMA);
+    uint8_t *read_data = heap_caps_calloc(1, sectors * DISK_BLOCK_SIZE, MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(write_data);
+    TEST_ASSERT_NOT_NULL(read_data);
+    for (int i = 0; i < sectors * DISK_BLOCK_SIZE; i++) {
+        write_data[i] = (i * 7) & 0xFF;
+    }
+
+    ESP_OK_ASSERT( scsi_cmd_write10(device, write_data, 10, sectors, DISK_BLOCK_SIZE) );
+    ESP_OK_ASSERT( scsi_cmd_read10(device, read_data, 10, sectors, DISK_BLOCK_SIZE) );
+    TEST_ASSERT_EQUAL_MEMORY(write_data, read_data, sectors * DISK_BLOCK_SIZE);
+
+    // Commands without data stage are pipelined too
+    ESP_OK_ASSERT( scsi_cmd_unit_ready(device) );
+    write_read_file(FILE_NAME);
+
+    free(write_data);
+    free(read_data);
+    msc_teardown();
+}
+
+#if CONFIG_SPIRAM
+/**
+ * @brief Sectors in PSRAM go through the bounce buffer
+ *
+ * The bounce buffer is smaller than the transfer, so that the data stage is split into several transfers.
+ */
+TEST_CASE("sectors_in_psram_through_bounce_buffer", "[usb_msc]")
+{
+    const size_t sectors = 4;
+    msc_host_driver_config_t msc_config = MSC_TEST_DRIVER_CONFIG_DEFAULT();
+    msc_config.dma_bounce_buf_size = DISK_BLOCK_SIZE;
+    msc_setup_with_config(&msc_config);
+
+    uint8_t *write_data = heap_caps_malloc(sectors * DISK_BLOCK_SIZE, MALLOC_CAP_SPIRAM);
+    uint8_t *read_data = heap_caps_calloc(1, sectors * DISK_BLOCK_SIZE, MALLOC_CAP_SPIRAM);
+    TEST_ASSERT_NOT_NULL(write_data);
+    TEST_ASSERT_NOT_NULL(read_data);
+    for (int i = 0; i < sectors * DISK_BLOCK_SIZE; i++) {
+        write_data[i] = i & 0xFF;
+    }
+
+    ESP_OK_ASSERT( scsi_cmd_write10(device, write_data, 10, sectors, DISK_BLOCK_SIZE) );
+    ESP_OK_ASSERT( scsi_cmd_read10(device, read_data, 10, sectors, DISK_BLOCK_SIZE) );
+    TEST_ASSERT_EQUAL_MEMORY(write_data, read_data, sectors * DISK_BLOCK_SIZE);
+
+    free(write_data);
+    free(read_data);
+    msc_teardown();
+}
+#endif /* CONFIG_SPIRAM */
+
 /**
  * @brief USB MSC format testcase
  * @attention This testcase deletes all content on the USB MSC device.
@@ -529,6 +777,88 @@ TEST_CASE("no_background_task_2", "[usb_msc]")
     msc_test_deinit();
 }
 
+static void print_stage_stats(const char *name, const msc_host_stage_stats_t *stage)
+{
+    printf("\t %-8s count %6"PRIu32", avg %6"PRIu64" us, max %6"PRIu32" us\n", name, stage->count,
+           stage->count ? stage->total_us / stage->count : 0, stage->max_us);
+}
+
+static void print_stats(const msc_host_stats_t *stats)
+{
+    print_stage_stats("command", &stats->command);
+    print_stage_stats("cbw", &stats->cbw);
+    print_stage_stats("data", &stats->data);
+    print_stage_stats("csw", &stats->csw);
+    print_stage_stats("wakeup", &stats->wakeup);
+    print_stage_stats("copy", &stats->copy);
+    printf("\t read %"PRIu64" B, written %"PRIu64" B, pipelined %"PRIu32", bounce %"PRIu32", alloc %"PRIu32", errors %"PRIu32"\n",
+           stats->bytes_read, stats->bytes_written, stats->pipelined_commands,
+           stats->bounce_buf_transfers, stats->alloc_buf_transfers, stats->errors);
+}
+
+/**
+ * @brief Sequential and random throughput of raw sector access
+ *
+ * Not a part of the [usb_msc] tests, run it manually to compare the numbers between changes.
+ * The sectors are written back with the data read from them, so the contents of the disk is kept.
+ */
+TEST_CASE("benchmark", "[usb_msc_benchmark]")
+{
+    const size_t sector_counts[] = { 1, 8, 32, 64 };
+    const int iterations = 50;
+    const size_t max_sectors = 64;
+    msc_host_driver_config_t msc_config = MSC_TEST_DRIVER_CONFIG_DEFAULT();
+    msc_config.enable_stats = true;
+    msc_setup_with_config(&msc_config);
+
+    msc_host_device_info_t info;
+    msc_host_stats_t stats;
+    ESP_OK_ASSERT( msc_host_get_device_info(device, &info) );
+    const size_t sector_size = info.sector_size;
+    TEST_ASSERT_GREATER_OR_EQUAL(max_sectors, info.sector_count);
+    uint8_t *data = heap_caps_malloc(max_sectors * sector_size, MALLOC_CAP_DMA);
+    TEST_ASSERT_NOT_NULL(data);
+
+    for (int i = 0; i < sizeof(sector_counts) / sizeof(sector_counts[0]); i++) {
+        const size_t sectors = sector_counts[i];
+        ESP_OK_ASSERT( msc_host_reset_stats(device) );
+        int64_t read_us = 0, write_us = 0;
+        for (int n = 0; n < iterations; n++) {
+            const uint32_t sector = (n * sectors) % (info.sector_count - sectors + 1);
+            int64_t start = esp_timer_get_time();
+            ESP_OK_ASSERT( scsi_cmd_read(device, data, sector, sectors, sector_size) );
+            read_us += esp_timer_get_time() - start;
+            start = esp_timer_get_time();
+            ESP_OK_ASSERT( scsi_cmd_write(device, data, sector, sectors, sector_size) );
+            write_us += esp_timer_get_time() - start;
+        }
+        const uint64_t bytes = (uint64_t)iterations * sectors * sector_size;
+        printf("Sequential %u sectors: read %"PRIu64" kB/s, write %"PRIu64" kB/s\n", sectors,
+               bytes * 1000 / read_us, bytes * 1000 / write_us);
+        ESP_OK_ASSERT( msc_host_get_stats(device, &stats) );
+        print_stats(&stats);
+    }
+
+    ESP_OK_ASSERT( msc_host_reset_stats(device) );
+    int64_t read_us = 0, write_us = 0;
+    for (int n = 0; n < iterations; n++) {
+        const uint32_t sector = rand() % info.sector_count;
+        int64_t start = esp_timer_get_time();
+        ESP_OK_ASSERT( scsi_cmd_read(device, data, sector, 1, sector_size) );
+        read_us += esp_timer_get_time() - start;
+        start = esp_timer_get_time();
+        ESP_OK_ASSERT( scsi_cmd_write(device, data, sector, 1, sector_size) );
+        write_us += esp_timer_get_time() - start;
+    }
+    printf("Random 1 sector: read %"PRIu64" IOPS, write %"PRIu64" IOPS\n",
+           iterations * 1000000ULL / read_us, iterations * 1000000ULL / write_us);
+    ESP_OK_ASSERT( msc_host_get_stats(device, &stats) );
+    print_stats(&stats);
+
+    free(data);
+    msc_teardown();
+}
+
 /**
  * @brief USB MSC Device Mock
  *
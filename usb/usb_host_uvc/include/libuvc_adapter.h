@@ -6,8 +6,10 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "esp_err.h"
+#include "libuvc/libuvc.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -60,6 +62,150 @@ esp_err_t libuvc_adapter_print_descriptors(uvc_device_handle_t *device);
  */
 esp_err_t libuvc_adapter_handle_events(uint32_t timeout_ms);
 
+/**
+ * @brief Negotiates stream parameters fitting isochronous bandwidth of the host
+ *
+ * - Replaces `uvc_get_stream_ctrl_format_size`. Frame rates of the resolution are tried from the highest one,
+ *   until the camera commits `dwMaxPayloadTransferSize` fitting an alternate setting supported by the host.
+ *   `dwMaxPayloadTransferSize` is then set to the smallest such alternate setting, which `uvc_start_streaming` selects.
+ * - If no frame rate fits, the lowest frame rate is used with `dwMaxPayloadTransferSize` limited to the largest alternate setting.
+ *
+ * @param[in]  device  Device handle obtained from `uvc_open`
+ * @param[out] ctrl    Negotiated stream control
+ * @param[in]  format  Frame format
+ * @param[in]  width   Frame width
+ * @param[in]  height  Frame height
+ * @param[in]  max_fps Highest frame rate to try, 0 for no limit
+ * @return esp_err_t ESP_ERR_NOT_FOUND if the camera doesn't support the format and resolution
+ */
+esp_err_t libuvc_adapter_negotiate_stream_ctrl(uvc_device_handle_t *device, uvc_stream_ctrl_t *ctrl,
+        enum uvc_frame_format format, int width, int height, int max_fps);
+
+/**
+ * @brief Stream statistics
+ *
+ * - Statistics are gathered from isochronous packets and UVC payload headers of video stream transfers,
+ *   frames are counted by payload header End of Frame and Frame ID bits.
+ */
+typedef struct {
+    uint32_t frames;                /**< Frames received from the camera */
+    uint32_t incomplete_frames;     /**< Frames with a missed packet or with payload header Error bit set */
+    uint32_t isoc_packets;          /**< Isochronous packets received */
+    uint32_t isoc_packet_errors;    /**< Isochronous packets not completed */
+    uint64_t payload_bytes;         /**< Bytes received in isochronous packets, including payload headers */
+    uint64_t reserved_bytes;        /**< Bytes reserved by isochronous packets, i.e. MPS of the alternate setting per packet */
+    uint32_t callback_time_avg_us;  /**< Average time spent in libuvc transfer callback */
+    uint32_t callback_time_max_us;  /**< Maximum time spent in libuvc transfer callback */
+    float fps;                      /**< Complete frames per second since the start of stream */
+    float bandwidth_utilization;    /**< payload_bytes / reserved_bytes, low value means an alternate setting with smaller MPS suffices */
+} libuvc_adapter_stream_stats_t;
+
+/**
+ * @brief Gets statistics of video stream
+ *
+ * - Statistics are reset when streaming starts (non-zero alternate setting is selected)
+ *   or by `libuvc_adapter_reset_stream_stats`
+ *
+ * @param[in]  device Device handle obtained from `uvc_open`
+ * @param[out] stats  Stream statistics
+ * @return esp_err_t
+ */
+esp_err_t libuvc_adapter_get_stream_stats(uvc_device_handle_t *device, libuvc_adapter_stream_stats_t *stats);
+
+/**
+ * @brief Resets statistics of video stream
+ *
+ * @param[in] device Device handle obtained from `uvc_open`
+ * @return esp_err_t
+ */
+esp_err_t libuvc_adapter_reset_stream_stats(uvc_device_handle_t *device);
+
+/**
+ * @brief Frame pool configuration structure
+ */
+typedef struct {
+    size_t num_frames;              /**< Number of preallocated frame buffers, both queued and lent to the consumer */
+    size_t max_frame_size;          /**< Size of each frame buffer. Larger frames are dropped */
+    size_t queue_len;               /**< Number of frames waiting for the consumer. The oldest frame is dropped when a new one doesn't fit.
+                                         0 means num_frames - 1, so that the consumer can hold one frame */
+    uint32_t heap_caps;             /**< Memory capabilities of frame buffers, e.g. MALLOC_CAP_SPIRAM. 0 means MALLOC_CAP_DEFAULT */
+} libuvc_adapter_frame_pool_config_t;
+
+/**
+ * @brief Frame pool statistics
+ */
+typedef struct {
+    uint32_t received;              /**< Frames passed to the pool by libuvc */
+    uint32_t dropped_oldest;        /**< Queued frames dropped in favour of a newer frame */
+    uint32_t dropped_too_large;     /**< Frames larger than max_frame_size */
+    uint32_t dropped_no_buffer;     /**< Frames dropped because all buffers were lent to the consumer */
+} libuvc_adapter_frame_pool_stats_t;
+
+typedef struct libuvc_adapter_frame_pool *libuvc_adapter_frame_pool_handle_t;
+
+/**
+ * @brief Creates a pool of preallocated frame buffers
+ *
+ * - Pass `libuvc_adapter_frame_pool_cb` and the pool to `uvc_start_streaming`.
+ *   Each frame is copied once from libuvc to a free buffer and queued for the consumer.
+ * - The consumer takes frames by `libuvc_adapter_frame_pool_take` and returns them
+ *   by `libuvc_adapter_frame_pool_return`, e.g. after passing them to a JPEG decoder or a socket.
+ *
+ * @param[in]  config Configuration structure
+ * @param[out] pool   Created frame pool
+ * @return esp_err_t
+ */
+esp_err_t libuvc_adapter_frame_pool_create(const libuvc_adapter_frame_pool_config_t *config,
+        libuvc_adapter_frame_pool_handle_t *pool);
+
+/**
+ * @brief Deletes a frame pool
+ *
+ * - Streaming must be stopped and all frames returned to the pool
+ *
+ * @param[in] pool Frame pool
+ * @return esp_err_t ESP_ERR_INVALID_STATE if some frames were not returned
+ */
+esp_err_t libuvc_adapter_frame_pool_delete(libuvc_adapter_frame_pool_handle_t pool);
+
+/**
+ * @brief Frame callback of libuvc, storing frames to a pool
+ *
+ * @param[in] frame Frame assembled by libuvc
+ * @param[in] ptr   Frame pool
+ */
+void libuvc_adapter_frame_pool_cb(uvc_frame_t *frame, void *ptr);
+
+/**
+ * @brief Takes the oldest queued frame from a pool
+ *
+ * - Frame data are valid until the frame is returned by `libuvc_adapter_frame_pool_return`
+ *
+ * @param[in]  pool       Frame pool
+ * @param[out] frame      Lent frame
+ * @param[in]  timeout_ms Timeout in miliseconds
+ * @return esp_err_t ESP_ERR_TIMEOUT if no frame was received
+ */
+esp_err_t libuvc_adapter_frame_pool_take(libuvc_adapter_frame_pool_handle_t pool, uvc_frame_t **frame, uint32_t timeout_ms);
+
+/**
+ * @brief Returns a frame lent by `libuvc_adapter_frame_pool_take`
+ *
+ * @param[in] pool  Frame pool
+ * @param[in] frame Lent frame
+ * @return esp_err_t
+ */
+esp_err_t libuvc_adapter_frame_pool_return(libuvc_adapter_frame_pool_handle_t pool, uvc_frame_t *frame);
+
+/**
+ * @brief Gets frame pool statistics
+ *
+ * @param[in]  pool  Frame pool
+ * @param[out] stats Statistics
+ * @return esp_err_t
+ */
+esp_err_t libuvc_adapter_frame_pool_get_stats(libuvc_adapter_frame_pool_handle_t pool, libuvc_adapter_frame_pool_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
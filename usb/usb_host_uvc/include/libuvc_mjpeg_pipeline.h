@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "jpeg_decoder.h"
+#include "libuvc_adapter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Callback called after each frame is decoded
+ *
+ * @param[in] user_ctx User context from configuration
+ * @param[in] img      Size of the decoded image
+ */
+typedef void (*libuvc_mjpeg_frame_done_cb_t)(void *user_ctx, const esp_jpeg_image_output_t *img);
+
+/**
+ * @brief MJPEG pipeline configuration structure
+ */
+typedef struct {
+    libuvc_adapter_frame_pool_handle_t frame_pool;  /**< Frame pool receiving MJPEG frames from libuvc */
+    esp_jpeg_image_format_t out_format;             /**< Output format, e.g. JPEG_IMAGE_FORMAT_RGB565 */
+    esp_jpeg_image_scale_t out_scale;               /**< Output scale */
+    bool swap_color_bytes;                          /**< Swap color bytes, as required by most SPI LCD panels */
+    uint8_t *framebuffer;                           /**< Buffer receiving whole decoded frames, e.g. LCD panel frame buffer.
+                                                         Not used if band_cb is set */
+    size_t framebuffer_size;                        /**< Size of framebuffer */
+    esp_jpeg_out_cb_t band_cb;                      /**< Band callback, e.g. drawing each band by esp_lcd_panel_draw_bitmap.
+                                                         Bands are decoded to an internal buffer of one MCU row */
+    libuvc_mjpeg_frame_done_cb_t frame_done_cb;     /**< Called after each decoded frame (optional) */
+    void *user_ctx;                                 /**< User context passed to band_cb and frame_done_cb */
+    uint32_t task_stack_size;                       /**< Decoding task stack size, 0 means 4096 */
+    unsigned task_priority;                         /**< Decoding task priority, 0 means 5 */
+    int task_core_id;                               /**< Decoding task core, typically the other core than USB Host and libuvc tasks.
+                                                         Use tskNO_AFFINITY to not pin the task */
+} libuvc_mjpeg_pipeline_config_t;
+
+/**
+ * @brief MJPEG pipeline statistics
+ *
+ * - Frames dropped before reaching the pipeline are counted by `libuvc_adapter_frame_pool_get_stats`
+ */
+typedef struct {
+    uint32_t decoded;               /**< Successfully decoded frames */
+    uint32_t skipped;               /**< Frames skipped because a newer frame was already waiting */
+    uint32_t errors;                /**< Frames not in MJPEG format or failed to decode */
+} libuvc_mjpeg_pipeline_stats_t;
+
+typedef struct libuvc_mjpeg_pipeline *libuvc_mjpeg_pipeline_handle_t;
+
+/**
+ * @brief Creates MJPEG decoding pipeline
+ *
+ * - A task takes frames from the frame pool and decodes them with a reusable esp_jpeg decoder,
+ *   either to the frame buffer or in bands to `band_cb`.
+ * - If more frames are waiting when the task takes a frame, older frames are skipped and only the latest one is decoded.
+ *
+ * @param[in]  config   Configuration structure
+ * @param[out] pipeline Created pipeline
+ * @return esp_err_t
+ */
+esp_err_t libuvc_mjpeg_pipeline_create(const libuvc_mjpeg_pipeline_config_t *config, libuvc_mjpeg_pipeline_handle_t *pipeline);
+
+/**
+ * @brief Stops the decoding task and deletes the pipeline
+ *
+ * - The frame pool is not deleted
+ *
+ * @param[in] pipeline Pipeline handle
+ * @return esp_err_t
+ */
+esp_err_t libuvc_mjpeg_pipeline_delete(libuvc_mjpeg_pipeline_handle_t pipeline);
+
+/**
+ * @brief Gets MJPEG pipeline statistics
+ *
+ * @param[in]  pipeline Pipeline handle
+ * @param[out] stats    Statistics
+ * @return esp_err_t
+ */
+esp_err_t libuvc_mjpeg_pipeline_get_stats(libuvc_mjpeg_pipeline_handle_t pipeline, libuvc_mjpeg_pipeline_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,6 +9,8 @@
 extern "C" {
 #endif
 
+struct uvc_format_desc;
+
 /**
  * @brief Converts raw buffer containing config descriptor into libusb_config_descriptor
  *
@@ -35,6 +37,36 @@ void clear_config_descriptor(struct libusb_config_descriptor *config);
  */
 void print_usb_class_descriptors(const usb_standard_desc_t *desc);
 
+/**
+ * @brief Finds the smallest isochronous IN endpoint among the alternate settings of the interface,
+ *        which fits the payload and is supported by the host
+ *
+ * @param[in]  config_desc   configuration descriptor
+ * @param[in]  interface     video streaming interface number
+ * @param[in]  payload_size  maximum payload per (micro)frame
+ * @param[out] largest_mps   largest endpoint packet size supported by the host, 0 if none
+ * @return packet size of the endpoint, 0 if none fits the payload
+ */
+uint16_t find_smallest_fitting_mps(const usb_config_desc_t *config_desc, uint8_t interface,
+                                   uint32_t payload_size, uint16_t *largest_mps);
+
+/**
+ * @brief Collects frame rates of all frame descriptors with the resolution, in descending order
+ *
+ * Discrete frame intervals give their own frame rates, continuous ones a fixed list of common rates.
+ * If there are more than max_count rates, the highest ones are kept.
+ *
+ * @param[in]  formats    list of format descriptors
+ * @param[in]  width      frame width
+ * @param[in]  height     frame height
+ * @param[in]  max_fps    highest frame rate included, 0 for all
+ * @param[out] fps        frame rates without duplicates
+ * @param[in]  max_count  size of fps
+ * @return number of frame rates stored in fps
+ */
+size_t get_fps_ladder(const struct uvc_format_desc *formats, int width, int height, int max_fps, int *fps,
+                      size_t max_count);
+
 #ifdef __cplusplus
 }
 #endif
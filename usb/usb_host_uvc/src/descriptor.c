@@ -15,6 +15,8 @@
 #include "usb/usb_types_ch9.h"
 #include "sys/param.h"
 #include <inttypes.h>
+#include "libuvc/libuvc.h"
+#include "descriptor.h"
 
 typedef struct {
     uint8_t bLength;
@@ -32,6 +34,8 @@ typedef struct {
 #define USB_MAXENDPOINTS    32
 #define USB_MAXINTERFACES   32
 #define USB_MAXCONFIG       8
+// Isochronous packet size supported by the host
+#define UVC_MAX_ISOC_MPS    512
 
 #define TAG "DESC"
 
@@ -234,6 +238,91 @@ int raw_desc_to_libusb_config(const uint8_t *buf, int size, struct libusb_config
     return LIBUSB_SUCCESS;
 }
 
+uint16_t find_smallest_fitting_mps(const usb_config_desc_t *config_desc, uint8_t interface,
+        uint32_t payload_size, uint16_t *largest_mps)
+{
+    int offset = 0;
+    size_t total_length = config_desc->wTotalLength;
+    const usb_standard_desc_t *next_desc = (const usb_standard_desc_t *)config_desc;
+    uint16_t best_mps = 0;
+
+    *largest_mps = 0;
+    while ( (next_desc = usb_parse_next_descriptor_of_type(next_desc, total_length,
+                         USB_B_DESCRIPTOR_TYPE_INTERFACE, &offset)) ) {
+        const usb_intf_desc_t *ifc_desc = (const usb_intf_desc_t *)next_desc;
+        if (ifc_desc->bInterfaceNumber != interface || ifc_desc->bAlternateSetting == 0 || ifc_desc->bNumEndpoints == 0) {
+            continue;
+        }
+        next_desc = usb_parse_next_descriptor_of_type(next_desc, total_length, USB_B_DESCRIPTOR_TYPE_ENDPOINT,
+                    &offset);
+        if (next_desc == NULL) {
+            break;
+        }
+        const usb_ep_desc_t *ep_desc = (const usb_ep_desc_t *)next_desc;
+        if (USB_EP_DESC_GET_XFERTYPE(ep_desc) != USB_BM_ATTRIBUTES_XFER_ISOC || !USB_EP_DESC_GET_EP_DIR(ep_desc)) {
+            continue;
+        }
+        const uint16_t mps = (ep_desc->wMaxPacketSize & 0x7FF) * (((ep_desc->wMaxPacketSize >> 11) & 0x3) + 1);
+        if (mps > UVC_MAX_ISOC_MPS) {
+            continue;
+        }
+        *largest_mps = MAX(*largest_mps, mps);
+        if (mps >= payload_size && (best_mps == 0 || mps < best_mps)) {
+            best_mps = mps;
+        }
+    }
+
+    return best_mps;
+}
+
+size_t get_fps_ladder(const uvc_format_desc_t *formats, int width, int height, int max_fps, int *fps,
+                      size_t max_count)
+{
+    static const int continuous_fps[] = {60, 30, 25, 20, 15, 10, 5, 1};
+    size_t count = 0;
+
+    for (const uvc_format_desc_t *format = formats; format; format = format->next) {
+        for (const uvc_frame_desc_t *frame = format->frame_descs; frame; frame = frame->next) {
+            if (frame->wWidth != width || frame->wHeight != height) {
+                continue;
+            }
+            for (int i = 0; ; i++) {
+                int candidate;
+                if (frame->intervals) {
+                    if (frame->intervals[i] == 0) {
+                        break;
+                    }
+                    candidate = 10000000 / frame->intervals[i];
+                } else {
+                    if (i >= (int)(sizeof(continuous_fps) / sizeof(continuous_fps[0]))) {
+                        break;
+                    }
+                    candidate = continuous_fps[i];
+                }
+                if (candidate == 0 || (max_fps && candidate > max_fps)) {
+                    continue;
+                }
+                // Insert keeping descending order without duplicates, a full ladder drops its lowest rate
+                size_t pos = 0;
+                while (pos < count && fps[pos] > candidate) {
+                    pos++;
+                }
+                if ((pos < count && fps[pos] == candidate) || pos == max_count) {
+                    continue;
+                }
+                if (count == max_count) {
+                    count--;
+                }
+                memmove(&fps[pos + 1], &fps[pos], (count - pos) * sizeof(int));
+                fps[pos] = candidate;
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
 typedef struct {
     uint8_t bLength;
     uint8_t bDescriptorType;
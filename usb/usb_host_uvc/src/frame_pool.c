@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "libuvc/libuvc.h"
+#include "libuvc_adapter.h"
+
+static const char *TAG = "UVC_FRAME_POOL";
+
+struct libuvc_adapter_frame_pool {
+    uvc_frame_t *frames;            // Frames pointing to preallocated buffers
+    size_t num_frames;
+    size_t max_frame_size;
+    QueueHandle_t free_queue;       // Frames available to libuvc callback
+    QueueHandle_t ready_queue;      // Frames waiting for the consumer, oldest first
+    libuvc_adapter_frame_pool_stats_t stats;
+};
+
+esp_err_t libuvc_adapter_frame_pool_create(const libuvc_adapter_frame_pool_config_t *config,
+        libuvc_adapter_frame_pool_handle_t *pool)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && pool && config->num_frames > 0 && config->max_frame_size > 0,
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    const size_t queue_len = config->queue_len ? MIN(config->queue_len, config->num_frames) : MAX(config->num_frames - 1, 1);
+    const uint32_t caps = config->heap_caps ? config->heap_caps : MALLOC_CAP_DEFAULT;
+
+    struct libuvc_adapter_frame_pool *new_pool = calloc(1, sizeof(struct libuvc_adapter_frame_pool));
+    ESP_RETURN_ON_FALSE(new_pool, ESP_ERR_NO_MEM, TAG, "Failed to allocate frame pool");
+    new_pool->num_frames = config->num_frames;
+    new_pool->max_frame_size = config->max_frame_size;
+
+    new_pool->frames = calloc(config->num_frames, sizeof(uvc_frame_t));
+    ESP_GOTO_ON_FALSE(new_pool->frames, ESP_ERR_NO_MEM, fail, TAG, "Failed to allocate frames");
+    new_pool->free_queue = xQueueCreate(config->num_frames, sizeof(uvc_frame_t *));
+    new_pool->ready_queue = xQueueCreate(queue_len, sizeof(uvc_frame_t *));
+    ESP_GOTO_ON_FALSE(new_pool->free_queue && new_pool->ready_queue, ESP_ERR_NO_MEM, fail, TAG, "Failed to create queues");
+
+    for (size_t i = 0; i < config->num_frames; i++) {
+        uvc_frame_t *frame = &new_pool->frames[i];
+        frame->data = heap_caps_malloc(config->max_frame_size, caps);
+        ESP_GOTO_ON_FALSE(frame->data, ESP_ERR_NO_MEM, fail, TAG, "Failed to allocate frame buffer of %u bytes",
+                          (unsigned)config->max_frame_size);
+        frame->library_owns_data = 0;
+        xQueueSend(new_pool->free_queue, &frame, 0);
+    }
+
+    *pool = new_pool;
+    return ESP_OK;
+
+fail:
+    if (new_pool->frames) {
+        for (size_t i = 0; i < config->num_frames; i++) {
+            heap_caps_free(new_pool->frames[i].data);
+        }
+        free(new_pool->frames);
+    }
+    if (new_pool->free_queue) {
+        vQueueDelete(new_pool->free_queue);
+    }
+    if (new_pool->ready_queue) {
+        vQueueDelete(new_pool->ready_queue);
+    }
+    free(new_pool);
+    return ret;
+}
+
+esp_err_t libuvc_adapter_frame_pool_delete(libuvc_adapter_frame_pool_handle_t pool)
+{
+    ESP_RETURN_ON_FALSE(pool, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    const size_t returned = uxQueueMessagesWaiting(pool->free_queue) + uxQueueMessagesWaiting(pool->ready_queue);
+    ESP_RETURN_ON_FALSE(returned == pool->num_frames, ESP_ERR_INVALID_STATE, TAG, "%u frames not returned",
+                        (unsigned)(pool->num_frames - returned));
+
+    for (size_t i = 0; i < pool->num_frames; i++) {
+        heap_caps_free(pool->frames[i].data);
+    }
+    free(pool->frames);
+    vQueueDelete(pool->free_queue);
+    vQueueDelete(pool->ready_queue);
+    free(pool);
+    return ESP_OK;
+}
+
+void libuvc_adapter_frame_pool_cb(uvc_frame_t *frame, void *ptr)
+{
+    struct libuvc_adapter_frame_pool *pool = ptr;
+    uvc_frame_t *dst;
+
+    pool->stats.received++;
+    if (frame->data_bytes > pool->max_frame_size) {
+        pool->stats.dropped_too_large++;
+        return;
+    }
+
+    // Under backpressure, all free buffers are queued: reuse the oldest queued one
+    if (xQueueReceive(pool->free_queue, &dst, 0) != pdTRUE) {
+        if (xQueueReceive(pool->ready_queue, &dst, 0) != pdTRUE) {
+            pool->stats.dropped_no_buffer++;
+            return;
+        }
+        pool->stats.dropped_oldest++;
+    }
+
+    memcpy(dst->data, frame->data, frame->data_bytes);
+    dst->data_bytes = frame->data_bytes;
+    dst->width = frame->width;
+    dst->height = frame->height;
+    dst->frame_format = frame->frame_format;
+    dst->step = frame->step;
+    dst->sequence = frame->sequence;
+    dst->capture_time = frame->capture_time;
+    dst->source = frame->source;
+
+    if (xQueueSend(pool->ready_queue, &dst, 0) != pdTRUE) {
+        // Queue is shorter than the pool: drop the oldest queued frame
+        uvc_frame_t *oldest;
+        if (xQueueReceive(pool->ready_queue, &oldest, 0) == pdTRUE) {
+            xQueueSend(pool->free_queue, &oldest, 0);
+            pool->stats.dropped_oldest++;
+        }
+        xQueueSend(pool->ready_queue, &dst, 0);
+    }
+}
+
+esp_err_t libuvc_adapter_frame_pool_take(libuvc_adapter_frame_pool_handle_t pool, uvc_frame_t **frame, uint32_t timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(pool && frame, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    if (xQueueReceive(pool->ready_queue, frame, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
+esp_err_t libuvc_adapter_frame_pool_return(libuvc_adapter_frame_pool_handle_t pool, uvc_frame_t *frame)
+{
+    ESP_RETURN_ON_FALSE(pool && frame, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(frame >= pool->frames && frame < pool->frames + pool->num_frames,
+                        ESP_ERR_INVALID_ARG, TAG, "Frame is not from this pool");
+    xQueueSend(pool->free_queue, &frame, 0);
+    return ESP_OK;
+}
+
+esp_err_t libuvc_adapter_frame_pool_get_stats(libuvc_adapter_frame_pool_handle_t pool, libuvc_adapter_frame_pool_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(pool && stats, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    *stats = pool->stats;
+    return ESP_OK;
+}
@@ -5,6 +5,7 @@
  */
 #include "libusb.h"
 #include <stdio.h>
+#include <inttypes.h>
 #include <wchar.h>
 #include <assert.h>
 #include <stdlib.h>
@@ -17,6 +18,7 @@
 #include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_check.h"
+#include "esp_timer.h"
 #include "usb/usb_host.h"
 #include "usb/usb_types_ch9.h"
 #include "usb/usb_types_stack.h"
@@ -47,11 +49,34 @@
 
 #define COUNT_OF(array) (sizeof(array) / sizeof(array[0]))
 
+#ifndef LIBUVC_NUM_TRANSFER_BUFS
+#define LIBUVC_NUM_TRANSFER_BUFS 10
+#endif
+#define UVC_MAX_FPS_LADDER 16
+
+// Stream transfers and status transfer of one camera
+#define UVC_TRANSFER_POOL_SIZE (LIBUVC_NUM_TRANSFER_BUFS + 1)
+
+// bmHeaderInfo of UVC payload header
+#define UVC_PAYLOAD_HEADER_FID  (1 << 0)
+#define UVC_PAYLOAD_HEADER_EOF  (1 << 1)
+#define UVC_PAYLOAD_HEADER_ERR  (1 << 6)
+
 typedef struct {
     usb_transfer_t *xfer;
     struct libusb_transfer libusb_xfer;
 } uvc_transfer_t;
 
+typedef struct {
+    libuvc_adapter_stream_stats_t stats;
+    int64_t start_us;
+    uint64_t callback_time_sum_us;
+    uint32_t callbacks;
+    uint8_t fid;
+    bool in_frame;
+    bool frame_error;
+} uvc_stream_stats_t;
+
 typedef struct opened_camera {
     uint8_t address;
     uint8_t open_count;
@@ -61,6 +86,7 @@ typedef struct opened_camera {
     usb_transfer_t *control_xfer;
     SemaphoreHandle_t transfer_done;
     usb_transfer_status_t transfer_status;
+    uvc_stream_stats_t stream;
     STAILQ_ENTRY(opened_camera) tailq_entry;
 } uvc_camera_t;
 
@@ -74,6 +100,11 @@ typedef struct {
 static portMUX_TYPE s_uvc_lock = portMUX_INITIALIZER_UNLOCKED;
 static uvc_driver_t *s_uvc_driver;
 
+// Transfers freed by libuvc, reused when a stream is restarted or the camera reconnected
+static usb_transfer_t *s_transfer_pool[UVC_TRANSFER_POOL_SIZE];
+
+static void transfer_pool_free_all(void);
+
 static libuvc_adapter_config_t s_config = {
     .create_background_task = true,
     .task_priority = 5,
@@ -91,6 +122,11 @@ static const usb_standard_desc_t *next_endpoint_desc(const usb_standard_desc_t *
     return usb_parse_next_descriptor_of_type(desc, len, USB_B_DESCRIPTOR_TYPE_ENDPOINT, (int *)offset);
 }
 
+static inline bool is_in_endpoint(uint8_t endpoint)
+{
+    return endpoint & USB_B_ENDPOINT_ADDRESS_EP_DIR_MASK ? true : false;
+}
+
 // Find endpoint number under specified interface.
 static esp_err_t find_endpoint_of_interface(const usb_config_desc_t *config_desc, uint8_t interface, uint8_t *endpoint)
 {
@@ -192,6 +228,82 @@ esp_err_t libuvc_adapter_print_descriptors(uvc_device_handle_t *device)
     return ESP_OK;
 }
 
+esp_err_t libuvc_adapter_get_stream_stats(uvc_device_handle_t *device, libuvc_adapter_stream_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(device && stats, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    uvc_camera_t *camera = (uvc_camera_t *)(device->usb_devh);
+
+    UVC_ENTER_CRITICAL();
+    uvc_stream_stats_t stream = camera->stream;
+    UVC_EXIT_CRITICAL();
+
+    *stats = stream.stats;
+    const int64_t elapsed_us = stream.start_us ? esp_timer_get_time() - stream.start_us : 0;
+    if (elapsed_us > 0) {
+        stats->fps = (stats->frames - stats->incomplete_frames) * 1000000.0f / elapsed_us;
+    }
+    if (stats->reserved_bytes) {
+        stats->bandwidth_utilization = (float)stats->payload_bytes / stats->reserved_bytes;
+    }
+    if (stream.callbacks) {
+        stats->callback_time_avg_us = stream.callback_time_sum_us / stream.callbacks;
+    }
+    return ESP_OK;
+}
+
+esp_err_t libuvc_adapter_reset_stream_stats(uvc_device_handle_t *device)
+{
+    ESP_RETURN_ON_FALSE(device, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    uvc_camera_t *camera = (uvc_camera_t *)(device->usb_devh);
+
+    UVC_ENTER_CRITICAL();
+    memset(&camera->stream, 0, sizeof(camera->stream));
+    camera->stream.start_us = esp_timer_get_time();
+    UVC_EXIT_CRITICAL();
+    return ESP_OK;
+}
+
+esp_err_t libuvc_adapter_negotiate_stream_ctrl(uvc_device_handle_t *device, uvc_stream_ctrl_t *ctrl,
+        enum uvc_frame_format format, int width, int height, int max_fps)
+{
+    ESP_RETURN_ON_FALSE(device && ctrl, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    uvc_camera_t *camera = (uvc_camera_t *)(device->usb_devh);
+    const usb_config_desc_t *config_desc;
+    int fps_ladder[UVC_MAX_FPS_LADDER];
+    uvc_stream_ctrl_t fallback;
+    bool has_fallback = false;
+    uint16_t largest_mps = 0;
+
+    RETURN_ON_ERROR( usb_host_get_active_config_descriptor(camera->handle, &config_desc) );
+
+    const size_t steps = get_fps_ladder(uvc_get_format_descs(device), width, height, max_fps, fps_ladder,
+                         COUNT_OF(fps_ladder));
+    for (size_t i = 0; i < steps; i++) {
+        if (uvc_get_stream_ctrl_format_size(device, ctrl, format, width, height, fps_ladder[i]) != UVC_SUCCESS) {
+            continue;
+        }
+        const uint16_t mps = find_smallest_fitting_mps(config_desc, ctrl->bInterfaceNumber,
+                             ctrl->dwMaxPayloadTransferSize, &largest_mps);
+        if (mps) {
+            ESP_LOGI(TAG, "%dx%d@%d fps, payload %"PRIu32" in packets of %u bytes",
+                     width, height, fps_ladder[i], ctrl->dwMaxPayloadTransferSize, mps);
+            // libuvc selects the first alternate setting fitting the payload
+            ctrl->dwMaxPayloadTransferSize = mps;
+            return ESP_OK;
+        }
+        fallback = *ctrl;
+        has_fallback = true;
+    }
+
+    ESP_RETURN_ON_FALSE(has_fallback && largest_mps, ESP_ERR_NOT_FOUND, TAG, "No stream for %dx%d", width, height);
+
+    // Payload of even the lowest frame rate is larger than any packet: limit it, as camera usually sends less
+    *ctrl = fallback;
+    ESP_LOGW(TAG, "Payload %"PRIu32" limited to %u bytes", ctrl->dwMaxPayloadTransferSize, largest_mps);
+    ctrl->dwMaxPayloadTransferSize = largest_mps;
+    return ESP_OK;
+}
+
 esp_err_t libuvc_adapter_handle_events(uint32_t timeout_ms)
 {
     if (s_uvc_driver == NULL) {
@@ -340,6 +452,7 @@ void libusb_exit(struct libusb_context *ctx)
     vSemaphoreDelete(s_uvc_driver->client_task_deleted);
     s_uvc_driver = NULL;
     free(driver);
+    transfer_pool_free_all();
 }
 
 int32_t libusb_get_device_list(struct libusb_context *ctx, libusb_device ***list)
@@ -452,10 +565,77 @@ void libusb_close(libusb_device_handle *dev_handle)
     }
 }
 
+// Returns transfer to the pool, frees it if the pool is full
+static void transfer_pool_put(usb_transfer_t *xfer)
+{
+    UVC_ENTER_CRITICAL();
+    for (int i = 0; i < COUNT_OF(s_transfer_pool); i++) {
+        if (s_transfer_pool[i] == NULL) {
+            s_transfer_pool[i] = xfer;
+            UVC_EXIT_CRITICAL();
+            return;
+        }
+    }
+    UVC_EXIT_CRITICAL();
+    usb_host_transfer_free(xfer);
+}
+
+// Takes the smallest transfer of the pool, which fits the length and number of isochronous packets
+static usb_transfer_t *transfer_pool_get(size_t length, int num_iso_packets)
+{
+    int best = -1;
+    UVC_ENTER_CRITICAL();
+    for (int i = 0; i < COUNT_OF(s_transfer_pool); i++) {
+        usb_transfer_t *xfer = s_transfer_pool[i];
+        if (xfer && xfer->data_buffer_size >= length && xfer->num_isoc_packets == num_iso_packets &&
+                (best < 0 || xfer->data_buffer_size < s_transfer_pool[best]->data_buffer_size)) {
+            best = i;
+        }
+    }
+    usb_transfer_t *xfer = NULL;
+    if (best >= 0) {
+        xfer = s_transfer_pool[best];
+        s_transfer_pool[best] = NULL;
+    }
+    UVC_EXIT_CRITICAL();
+    return xfer;
+}
+
+static void transfer_pool_free_all(void)
+{
+    for (int i = 0; i < COUNT_OF(s_transfer_pool); i++) {
+        UVC_ENTER_CRITICAL();
+        usb_transfer_t *xfer = s_transfer_pool[i];
+        s_transfer_pool[i] = NULL;
+        UVC_EXIT_CRITICAL();
+        if (xfer) {
+            usb_host_transfer_free(xfer);
+        }
+    }
+}
+
+// Transfers are taken from the pool when possible, as allocating large DMA capable buffers
+// on every stream start can fail on fragmented heap
+static esp_err_t transfer_alloc(size_t length, int num_iso_packets, usb_transfer_t **xfer)
+{
+    *xfer = transfer_pool_get(length, num_iso_packets);
+    if (*xfer) {
+        return ESP_OK;
+    }
+    if (usb_host_transfer_alloc(length, num_iso_packets, xfer) == ESP_OK) {
+        return ESP_OK;
+    }
+    // Pooled transfers of other sizes may block the allocation
+    transfer_pool_free_all();
+    return usb_host_transfer_alloc(length, num_iso_packets, xfer);
+}
+
 void libusb_free_transfer(struct libusb_transfer *transfer)
 {
     uvc_transfer_t *trans = __containerof(transfer, uvc_transfer_t, libusb_xfer);
-    usb_host_transfer_free(trans->xfer);
+    if (trans->xfer) {
+        transfer_pool_put(trans->xfer);
+    }
     free(trans);
 }
 
@@ -472,9 +652,71 @@ struct libusb_transfer *libusb_alloc_transfer(int iso_packets)
     return &xfer->libusb_xfer;
 }
 
-static inline bool is_in_endpoint(uint8_t endpoint)
+// Copies only received data, not the whole transfer buffer. Isochronous packets are placed
+// at the same offsets in both buffers, but cameras usually fill only a part of each packet.
+static void copy_received_data(const usb_transfer_t *xfer, struct libusb_transfer *libusb_trans)
 {
-    return endpoint & USB_B_ENDPOINT_ADDRESS_EP_DIR_MASK ? true : false;
+    if (xfer->num_isoc_packets == 0) {
+        memcpy(libusb_trans->buffer, xfer->data_buffer, MIN(xfer->actual_num_bytes, libusb_trans->length));
+        return;
+    }
+
+    size_t offset = 0;
+    for (int i = 0; i < xfer->num_isoc_packets; i++) {
+        const size_t packet_len = libusb_trans->iso_packet_desc[i].length;
+        const size_t received = MIN(xfer->isoc_packet_desc[i].actual_num_bytes, packet_len);
+        if (offset + received > (size_t)libusb_trans->length) {
+            break;
+        }
+        memcpy(libusb_trans->buffer + offset, xfer->data_buffer + offset, received);
+        offset += packet_len;
+    }
+}
+
+static void stream_stats_end_frame(uvc_stream_stats_t *stream)
+{
+    stream->stats.frames++;
+    if (stream->frame_error) {
+        stream->stats.incomplete_frames++;
+    }
+    stream->in_frame = false;
+    stream->frame_error = false;
+}
+
+// Counts packets and frames of isochronous IN transfer from packet statuses and UVC payload headers
+static void stream_stats_update(uvc_stream_stats_t *stream, const usb_transfer_t *xfer)
+{
+    size_t offset = 0;
+
+    stream->stats.isoc_packets += xfer->num_isoc_packets;
+    for (int i = 0; i < xfer->num_isoc_packets; i++) {
+        const usb_isoc_packet_desc_t *packet = &xfer->isoc_packet_desc[i];
+        const uint8_t *payload = xfer->data_buffer + offset;
+        offset += packet->num_bytes;
+
+        stream->stats.reserved_bytes += packet->num_bytes;
+        if (packet->status != USB_TRANSFER_STATUS_COMPLETED) {
+            stream->stats.isoc_packet_errors++;
+            stream->frame_error |= stream->in_frame;
+            continue;
+        }
+        stream->stats.payload_bytes += packet->actual_num_bytes;
+        if (packet->actual_num_bytes < 2 || payload[0] < 2 || payload[0] > packet->actual_num_bytes) {
+            continue; // Empty packet or invalid payload header
+        }
+
+        const uint8_t info = payload[1];
+        const uint8_t fid = info & UVC_PAYLOAD_HEADER_FID;
+        if (stream->in_frame && fid != stream->fid) {
+            stream_stats_end_frame(stream); // Frame ended without EOF bit
+        }
+        stream->in_frame = true;
+        stream->fid = fid;
+        stream->frame_error |= (info & UVC_PAYLOAD_HEADER_ERR) != 0;
+        if (info & UVC_PAYLOAD_HEADER_EOF) {
+            stream_stats_end_frame(stream);
+        }
+    }
 }
 
 // Copies data from usb_transfer_t back to libusb_transfer and invokes user provided callback
@@ -482,6 +724,8 @@ void transfer_cb(usb_transfer_t *xfer)
 {
     uvc_transfer_t *trans = xfer->context;
     struct libusb_transfer *libusb_trans = &trans->libusb_xfer;
+    uvc_camera_t *device = (uvc_camera_t *)libusb_trans->dev_handle;
+    const bool is_stream = xfer->num_isoc_packets && is_in_endpoint(libusb_trans->endpoint);
 
     size_t isoc_actual_length = 0;
 
@@ -498,10 +742,28 @@ void transfer_cb(usb_transfer_t *xfer)
     libusb_trans->actual_length = xfer->num_isoc_packets ? isoc_actual_length : xfer->actual_num_bytes;
 
     if (is_in_endpoint(libusb_trans->endpoint)) {
-        memcpy(libusb_trans->buffer, xfer->data_buffer, libusb_trans->length);
+        copy_received_data(xfer, libusb_trans);
     }
 
+    if (!is_stream) {
+        libusb_trans->callback(libusb_trans);
+        return;
+    }
+
+    // Transfer may be resubmitted from the callback, so it is inspected before
+    UVC_ENTER_CRITICAL();
+    stream_stats_update(&device->stream, xfer);
+    UVC_EXIT_CRITICAL();
+
+    const int64_t start_us = esp_timer_get_time();
     libusb_trans->callback(libusb_trans);
+    const uint32_t callback_time_us = esp_timer_get_time() - start_us;
+
+    UVC_ENTER_CRITICAL();
+    device->stream.callbacks++;
+    device->stream.callback_time_sum_us += callback_time_us;
+    device->stream.stats.callback_time_max_us = MAX(device->stream.stats.callback_time_max_us, callback_time_us);
+    UVC_EXIT_CRITICAL();
 }
 
 // This function copies libusb_transfer data into usb_transfer_t structure
@@ -524,11 +786,12 @@ int libusb_submit_transfer(struct libusb_transfer *libusb_trans)
 
     // Transfers are allocated/reallocated based on transfer size, as libusb
     // doesn't store buffers in DMA capable region
-    if (!trans->xfer || trans->xfer->data_buffer_size < libusb_trans->length) {
+    if (!trans->xfer || trans->xfer->data_buffer_size < length || trans->xfer->num_isoc_packets != num_iso_packets) {
         if (trans->xfer) {
-            usb_host_transfer_free(trans->xfer);
+            transfer_pool_put(trans->xfer);
+            trans->xfer = NULL;
         }
-        err = usb_host_transfer_alloc(length, num_iso_packets, &trans->xfer);
+        err = transfer_alloc(length, num_iso_packets, &trans->xfer);
         if (err) {
             ESP_LOGE(TAG, "Failed to allocate transfer with length: %u", length);
             return esp_to_libusb_error(err);
@@ -787,6 +1050,14 @@ int libusb_set_interface_alt_setting(libusb_device_handle *dev_handle, int32_t i
 
     USB_SETUP_PACKET_INIT_SET_INTERFACE(&request, inferface, alt_settings);
     int result = control_transfer(dev_handle, &request, data, 2000);
+
+    // Streaming starts with non-zero alternate setting
+    if (result > 0 && alt_settings != 0) {
+        UVC_ENTER_CRITICAL();
+        memset(&device->stream, 0, sizeof(device->stream));
+        device->stream.start_us = esp_timer_get_time();
+        UVC_EXIT_CRITICAL();
+    }
     return result > 0 ? LIBUSB_SUCCESS : result;
 }
 
@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "jpeg_decoder.h"
+#include "libuvc/libuvc.h"
+#include "libuvc_adapter.h"
+#include "libuvc_mjpeg_pipeline.h"
+
+static const char *TAG = "UVC_MJPEG";
+
+#define MJPEG_TASK_STACK_SIZE_DEFAULT   4096
+#define MJPEG_TASK_PRIORITY_DEFAULT     5
+#define MJPEG_TAKE_TIMEOUT_MS           100
+
+struct libuvc_mjpeg_pipeline {
+    libuvc_mjpeg_pipeline_config_t config;
+    esp_jpeg_decoder_handle_t decoder;
+    volatile bool stop_task;
+    SemaphoreHandle_t task_stopped;
+    libuvc_mjpeg_pipeline_stats_t stats;
+};
+
+static void mjpeg_decode_frame(struct libuvc_mjpeg_pipeline *pipeline, uvc_frame_t *frame)
+{
+    const libuvc_mjpeg_pipeline_config_t *config = &pipeline->config;
+
+    if (frame->frame_format != UVC_FRAME_FORMAT_MJPEG) {
+        pipeline->stats.errors++;
+        return;
+    }
+
+    esp_jpeg_image_cfg_t jpeg_cfg = {
+        .indata = frame->data,
+        .indata_size = frame->data_bytes,
+        .out_format = config->out_format,
+        .out_scale = config->out_scale,
+        .flags.swap_color_bytes = config->swap_color_bytes,
+    };
+    if (config->band_cb) {
+        jpeg_cfg.out_cb = config->band_cb;
+        jpeg_cfg.out_user_data = config->user_ctx;
+    } else {
+        jpeg_cfg.outbuf = config->framebuffer;
+        jpeg_cfg.outbuf_size = config->framebuffer_size;
+    }
+
+    esp_jpeg_image_output_t img;
+    if (esp_jpeg_decoder_decode(pipeline->decoder, &jpeg_cfg, &img) != ESP_OK) {
+        pipeline->stats.errors++;
+        return;
+    }
+    pipeline->stats.decoded++;
+    if (config->frame_done_cb) {
+        config->frame_done_cb(config->user_ctx, &img);
+    }
+}
+
+static void mjpeg_task(void *arg)
+{
+    struct libuvc_mjpeg_pipeline *pipeline = arg;
+    libuvc_adapter_frame_pool_handle_t pool = pipeline->config.frame_pool;
+    uvc_frame_t *frame;
+    uvc_frame_t *newer;
+
+    while (!pipeline->stop_task) {
+        if (libuvc_adapter_frame_pool_take(pool, &frame, MJPEG_TAKE_TIMEOUT_MS) != ESP_OK) {
+            continue;
+        }
+        // Decoding is late: skip to the latest frame
+        while (libuvc_adapter_frame_pool_take(pool, &newer, 0) == ESP_OK) {
+            libuvc_adapter_frame_pool_return(pool, frame);
+            frame = newer;
+            pipeline->stats.skipped++;
+        }
+        mjpeg_decode_frame(pipeline, frame);
+        libuvc_adapter_frame_pool_return(pool, frame);
+    }
+
+    xSemaphoreGive(pipeline->task_stopped);
+    vTaskDelete(NULL);
+}
+
+esp_err_t libuvc_mjpeg_pipeline_create(const libuvc_mjpeg_pipeline_config_t *config, libuvc_mjpeg_pipeline_handle_t *pipeline)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && pipeline && config->frame_pool, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(config->band_cb || config->framebuffer, ESP_ERR_INVALID_ARG, TAG, "No frame buffer nor band callback");
+
+    struct libuvc_mjpeg_pipeline *new_pipeline = calloc(1, sizeof(struct libuvc_mjpeg_pipeline));
+    ESP_RETURN_ON_FALSE(new_pipeline, ESP_ERR_NO_MEM, TAG, "Failed to allocate pipeline");
+    new_pipeline->config = *config;
+
+    ESP_GOTO_ON_ERROR(esp_jpeg_decoder_create(NULL, &new_pipeline->decoder), fail, TAG, "Failed to create decoder");
+    new_pipeline->task_stopped = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(new_pipeline->task_stopped, ESP_ERR_NO_MEM, fail, TAG, "Failed to create semaphore");
+
+    const uint32_t stack_size = config->task_stack_size ? config->task_stack_size : MJPEG_TASK_STACK_SIZE_DEFAULT;
+    const unsigned priority = config->task_priority ? config->task_priority : MJPEG_TASK_PRIORITY_DEFAULT;
+    ESP_GOTO_ON_FALSE(xTaskCreatePinnedToCore(mjpeg_task, "uvc_mjpeg", stack_size, new_pipeline, priority, NULL,
+                      config->task_core_id) == pdPASS, ESP_ERR_NO_MEM, fail, TAG, "Failed to create task");
+
+    *pipeline = new_pipeline;
+    return ESP_OK;
+
+fail:
+    if (new_pipeline->task_stopped) {
+        vSemaphoreDelete(new_pipeline->task_stopped);
+    }
+    if (new_pipeline->decoder) {
+        esp_jpeg_decoder_destroy(new_pipeline->decoder);
+    }
+    free(new_pipeline);
+    return ret;
+}
+
+esp_err_t libuvc_mjpeg_pipeline_delete(libuvc_mjpeg_pipeline_handle_t pipeline)
+{
+    ESP_RETURN_ON_FALSE(pipeline, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+
+    pipeline->stop_task = true;
+    xSemaphoreTake(pipeline->task_stopped, portMAX_DELAY);
+
+    vSemaphoreDelete(pipeline->task_stopped);
+    esp_jpeg_decoder_destroy(pipeline->decoder);
+    free(pipeline);
+    return ESP_OK;
+}
+
+esp_err_t libuvc_mjpeg_pipeline_get_stats(libuvc_mjpeg_pipeline_handle_t pipeline, libuvc_mjpeg_pipeline_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(pipeline && stats, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    *stats = pipeline->stats;
+    return ESP_OK;
+}
@@ -20,6 +20,7 @@
 #include "unity.h"
 
 #include "libusb.h"
+#include "libuvc/libuvc.h"
 #include "descriptor.h"
 
 #define TAG "UVC_TEST"
@@ -214,4 +215,105 @@ TEST_CASE("Compare config descriptor parser", "[usb_uvc]")
     COMPARE_DESCRIPTORS(unknown_camera);
 }
 
+
+// Interface 1 with isochronous OUT, high bandwidth (2 x 128 and 3 x 256 bytes) and bulk endpoints
+const uint8_t ISOC_ENDPOINT_KINDS[] = {
+    0x09, 0x02, 0x52, 0x00, 0x01, 0x01, 0x00, 0x80, 0x32,
+    0x09, 0x04, 0x01, 0x00, 0x00, 0x0e, 0x02, 0x00, 0x00,
+    0x09, 0x04, 0x01, 0x01, 0x01, 0x0e, 0x02, 0x00, 0x00, 0x07, 0x05, 0x01, 0x05, 0x40, 0x00, 0x01,
+    0x09, 0x04, 0x01, 0x02, 0x01, 0x0e, 0x02, 0x00, 0x00, 0x07, 0x05, 0x81, 0x05, 0x80, 0x08, 0x01,
+    0x09, 0x04, 0x01, 0x03, 0x01, 0x0e, 0x02, 0x00, 0x00, 0x07, 0x05, 0x81, 0x05, 0x00, 0x11, 0x01,
+    0x09, 0x04, 0x01, 0x04, 0x01, 0x0e, 0x02, 0x00, 0x00, 0x07, 0x05, 0x82, 0x02, 0x40, 0x00, 0x00,
+};
+
+TEST_CASE("Find smallest fitting isochronous packet size", "[usb_uvc]")
+{
+    const usb_config_desc_t *canyon = (const usb_config_desc_t *)CANYON_CNE_CWC2;
+    uint16_t largest_mps;
+
+    // Alternate settings of interface 1 have packets of 128, 256, 512, 600, 800 and 956 bytes
+    TEST_ASSERT_EQUAL(128, find_smallest_fitting_mps(canyon, 1, 1, &largest_mps));
+    TEST_ASSERT_EQUAL(512, largest_mps);
+    TEST_ASSERT_EQUAL(256, find_smallest_fitting_mps(canyon, 1, 200, &largest_mps));
+    // Exact fit
+    TEST_ASSERT_EQUAL(256, find_smallest_fitting_mps(canyon, 1, 256, &largest_mps));
+    TEST_ASSERT_EQUAL(512, find_smallest_fitting_mps(canyon, 1, 512, &largest_mps));
+    // Packets larger than the host supports do not fit
+    TEST_ASSERT_EQUAL(0, find_smallest_fitting_mps(canyon, 1, 513, &largest_mps));
+    TEST_ASSERT_EQUAL(512, largest_mps);
+    // Only the endpoints of the interface
+    TEST_ASSERT_EQUAL(32, find_smallest_fitting_mps(canyon, 3, 16, &largest_mps));
+    TEST_ASSERT_EQUAL(32, largest_mps);
+    TEST_ASSERT_EQUAL(0, find_smallest_fitting_mps(canyon, 2, 16, &largest_mps));
+    TEST_ASSERT_EQUAL(0, largest_mps);
+
+    // Only isochronous IN endpoints, with the transactions per microframe
+    const usb_config_desc_t *kinds = (const usb_config_desc_t *)ISOC_ENDPOINT_KINDS;
+    TEST_ASSERT_EQUAL(256, find_smallest_fitting_mps(kinds, 1, 1, &largest_mps));
+    TEST_ASSERT_EQUAL(256, largest_mps);
+    TEST_ASSERT_EQUAL(0, find_smallest_fitting_mps(kinds, 1, 257, &largest_mps));
+    TEST_ASSERT_EQUAL(256, largest_mps);
+}
+
+TEST_CASE("Frame rate ladder of discrete and continuous intervals", "[usb_uvc]")
+{
+    // 30, 15 and 10 fps, and 60 fps at a lower resolution
+    uint32_t mjpeg_vga_intervals[] = {333333, 666666, 1000000, 0};
+    uint32_t mjpeg_qvga_intervals[] = {166666, 0};
+    // 25, 30 again, 5 fps and an interval under 1 fps
+    uint32_t yuy2_vga_intervals[] = {400000, 333333, 2000000, 20000000, 0};
+    // 24 fps, the same resolution is continuous in the other format
+    uint32_t yuy2_hd_intervals[] = {416666, 0};
+
+    uvc_frame_desc_t mjpeg_hd = {.wWidth = 1280, .wHeight = 720, .intervals = NULL,
+                                 .dwMinFrameInterval = 166666, .dwMaxFrameInterval = 10000000, .dwFrameIntervalStep = 1
+                                };
+    uvc_frame_desc_t mjpeg_qvga = {.wWidth = 320, .wHeight = 240, .intervals = mjpeg_qvga_intervals, .next = &mjpeg_hd};
+    uvc_frame_desc_t mjpeg_vga = {.wWidth = 640, .wHeight = 480, .intervals = mjpeg_vga_intervals, .next = &mjpeg_qvga};
+    uvc_frame_desc_t yuy2_hd = {.wWidth = 1280, .wHeight = 720, .intervals = yuy2_hd_intervals};
+    uvc_frame_desc_t yuy2_vga = {.wWidth = 640, .wHeight = 480, .intervals = yuy2_vga_intervals, .next = &yuy2_hd};
+    uvc_format_desc_t yuy2 = {.frame_descs = &yuy2_vga};
+    uvc_format_desc_t mjpeg = {.frame_descs = &mjpeg_vga, .next = &yuy2};
+
+    int fps[16];
+    size_t count;
+
+    // Discrete intervals of both formats, without duplicates
+    count = get_fps_ladder(&mjpeg, 640, 480, 0, fps, 16);
+    const int vga_all[] = {30, 25, 15, 10, 5};
+    TEST_ASSERT_EQUAL(sizeof(vga_all) / sizeof(vga_all[0]), count);
+    TEST_ASSERT_EQUAL_INT_ARRAY(vga_all, fps, count);
+
+    count = get_fps_ladder(&mjpeg, 640, 480, 20, fps, 16);
+    const int vga_max_20[] = {15, 10, 5};
+    TEST_ASSERT_EQUAL(sizeof(vga_max_20) / sizeof(vga_max_20[0]), count);
+    TEST_ASSERT_EQUAL_INT_ARRAY(vga_max_20, fps, count);
+
+    // A full ladder keeps the highest rates, also found after lower ones
+    count = get_fps_ladder(&mjpeg, 640, 480, 0, fps, 2);
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_EQUAL_INT_ARRAY(vga_all, fps, count);
+
+    count = get_fps_ladder(&mjpeg, 320, 240, 30, fps, 16);
+    TEST_ASSERT_EQUAL(0, count);
+
+    // Continuous intervals give the common rates, merged with the discrete ones
+    count = get_fps_ladder(&mjpeg, 1280, 720, 0, fps, 16);
+    const int hd_all[] = {60, 30, 25, 24, 20, 15, 10, 5, 1};
+    TEST_ASSERT_EQUAL(sizeof(hd_all) / sizeof(hd_all[0]), count);
+    TEST_ASSERT_EQUAL_INT_ARRAY(hd_all, fps, count);
+
+    count = get_fps_ladder(&yuy2, 1280, 720, 0, fps, 16);
+    TEST_ASSERT_EQUAL(1, count);
+    TEST_ASSERT_EQUAL_INT(24, fps[0]);
+
+    count = get_fps_ladder(&mjpeg, 1280, 720, 24, fps, 16);
+    const int hd_max_24[] = {24, 20, 15, 10, 5, 1};
+    TEST_ASSERT_EQUAL(sizeof(hd_max_24) / sizeof(hd_max_24[0]), count);
+    TEST_ASSERT_EQUAL_INT_ARRAY(hd_max_24, fps, count);
+
+    // No frame with the resolution
+    TEST_ASSERT_EQUAL(0, get_fps_ladder(&mjpeg, 800, 600, 0, fps, 16));
+}
+
 #endif
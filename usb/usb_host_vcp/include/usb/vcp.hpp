@@ -6,8 +6,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <unordered_map>
 #include <vector>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 #include "usb/cdc_acm_host.h"
 
 namespace esp_usb {
@@ -31,6 +36,8 @@ namespace esp_usb {
  */
 class VCP {
 public:
+    class Stream;
+
     /**
      * @brief Register VCP driver to VCP service
      *
@@ -52,6 +59,9 @@ public:
             return static_cast<CdcAcmDevice *> (new T(pid, dev_config, interface_idx)); // Lambda function: Open factory method
         }, T::vid, pids);
         drivers.push_back(new_driver);
+        for (uint16_t pid : pids) {
+            driver_index[driver_key(T::vid, pid)] = drivers.size() - 1;
+        }
     }
 
     /**
@@ -80,7 +90,12 @@ public:
      * This function will block until a valid VCP device is found or
      * until dev_config->connection_timeout_ms expires. Set timeout to 0 to wait forever.
      *
+     * Already connected devices are tried first. Then the function waits for new devices reported by the CDC-ACM driver
+     * and opens the first one supported by a registered driver as soon as it is connected.
+     *
      * @note If there are more USB devices connected, the VCP service will return first successfully opened device
+     * @note While waiting, this function registers its own new device callback with cdc_acm_host_register_new_dev_callback().
+     *       The callback is unregistered (set to NULL) before returning, a callback registered by the user is replaced.
      * @attention USB Host Library must be installed before calling this function!
      *
      * @param[in] dev_config    Configuration of the device
@@ -112,5 +127,206 @@ private:
      * @brief List of registered VCP drivers
      */
     static std::vector<vcp_driver> drivers;
+
+    /**
+     * @brief Index of drivers by their VID and PID, see driver_key()
+     */
+    static std::unordered_map<uint32_t, size_t> driver_index;
+
+    static constexpr uint32_t driver_key(uint16_t vid, uint16_t pid)
+    {
+        return (static_cast<uint32_t>(vid) << 16) | pid;
+    }
+
+    static CdcAcmDevice *open_driver(const vcp_driver &drv, uint16_t pid, const cdc_acm_host_device_config_t *dev_config, uint8_t interface_idx);
+    static CdcAcmDevice *wait_and_open(const cdc_acm_host_device_config_t *dev_config, uint8_t interface_idx, TimeOut_t *connection_timeout, TickType_t timeout_ticks);
+    static void new_dev_cb(usb_device_handle_t usb_dev);
 }; // VCP class
+
+/**
+ * @brief Stream interface of an opened VCP device
+ *
+ * Received data are borrowed from the RX ring buffer of the CDC-ACM driver without copying.
+ * Written data are split to OUT transfers and pipelined through the asynchronous transmit of the driver.
+ * The device must be opened with rx_ringbuf_size > 0 and out_transfer_count > 0.
+ *
+ * Example usage:
+ * \code{.cpp}
+ * auto stream = VCP::Stream::open(&dev_config);
+ * stream->write(request, sizeof(request));
+ * VCP::Stream::RxBuffer rx = stream->read(1000);
+ * parse(rx.data(), rx.size()); // rx returns the data to the driver when it goes out of scope
+ * \endcode
+ *
+ * @note The stream must be read by one task at a time.
+ */
+class VCP::Stream {
+public:
+    /**
+     * @brief Received data borrowed from the driver
+     *
+     * The data occupy the RX ring buffer until the handle is released or destroyed. When the ring buffer
+     * fills up, the driver stops polling the device until data are released, so no data are lost.
+     * The handle is move-only and must not outlive its Stream.
+     */
+    class RxBuffer {
+    public:
+        RxBuffer() noexcept : dev(nullptr), ptr(nullptr), len(0) {}
+        RxBuffer(RxBuffer &&other) noexcept : dev(other.dev), ptr(other.ptr), len(other.len)
+        {
+            other.dev = nullptr;
+            other.ptr = nullptr;
+            other.len = 0;
+        }
+        RxBuffer &operator=(RxBuffer &&other) noexcept
+        {
+            if (this != &other) {
+                release();
+                dev = other.dev;
+                ptr = other.ptr;
+                len = other.len;
+                other.dev = nullptr;
+                other.ptr = nullptr;
+                other.len = 0;
+            }
+            return *this;
+        }
+        RxBuffer(const RxBuffer &) = delete;
+        RxBuffer &operator=(const RxBuffer &) = delete;
+        ~RxBuffer()
+        {
+            release();
+        }
+
+        const uint8_t *data() const noexcept
+        {
+            return ptr;
+        }
+        size_t size() const noexcept
+        {
+            return len;
+        }
+        bool empty() const noexcept
+        {
+            return len == 0;
+        }
+        explicit operator bool() const noexcept
+        {
+            return len != 0;
+        }
+        const uint8_t *begin() const noexcept
+        {
+            return ptr;
+        }
+        const uint8_t *end() const noexcept
+        {
+            return ptr + len;
+        }
+
+        /**
+         * @brief Return the data to the driver before the handle is destroyed
+         */
+        void release() noexcept
+        {
+            if (dev != nullptr) {
+                dev->read_release(ptr);
+                dev = nullptr;
+                ptr = nullptr;
+                len = 0;
+            }
+        }
+
+    private:
+        friend class VCP::Stream;
+        RxBuffer(CdcAcmDevice *_dev, const uint8_t *_ptr, size_t _len) noexcept : dev(_dev), ptr(_ptr), len(_len) {}
+        CdcAcmDevice *dev;
+        const uint8_t *ptr;
+        size_t len;
+    };
+
+    /**
+     * @brief Open any registered VCP device as a stream
+     *
+     * @param[in] dev_config    Configuration of the device, with rx_ringbuf_size > 0 and out_transfer_count > 0
+     * @param[in] interface_idx USB interface to use
+     * @return std::unique_ptr<Stream> Opened stream, nullptr if no device was opened
+     */
+    static std::unique_ptr<Stream> open(const cdc_acm_host_device_config_t *dev_config, uint8_t interface_idx = 0);
+
+    /**
+     * @brief Create a stream over an opened device
+     *
+     * @param[in] dev             Device opened with rx_ringbuf_size > 0 and out_transfer_count > 0, the stream takes its ownership
+     * @param[in] out_buffer_size out_buffer_size the device was opened with, writes are split to chunks of this size
+     */
+    Stream(CdcAcmDevice *dev, size_t out_buffer_size);
+    ~Stream();
+    Stream(const Stream &) = delete;
+    Stream &operator=(const Stream &) = delete;
+
+    /**
+     * @brief Borrow received data
+     *
+     * @param[in] timeout_ms Timeout of waiting for data in [ms]
+     * @param[in] max_len    Maximum number of bytes to borrow
+     * @return RxBuffer Received data, empty on timeout or if the previous RxBuffer was not released
+     */
+    RxBuffer read(uint32_t timeout_ms = 100, size_t max_len = SIZE_MAX);
+
+    /**
+     * @brief Queue data for transmission
+     *
+     * Data are copied to OUT transfers, so the buffer can be reused when this function returns.
+     * The call blocks only while all OUT transfers are in flight.
+     *
+     * @param[in] data       Data to send
+     * @param[in] len        Length of the data
+     * @param[in] timeout_ms Timeout of waiting for a free OUT transfer in [ms], per chunk
+     * @return esp_err_t ESP_ERR_TIMEOUT if the device does not keep up with the writes, the rest of the data was not queued
+     */
+    esp_err_t write(const uint8_t *data, size_t len, uint32_t timeout_ms = 100);
+
+    /**
+     * @brief Queue contents of a contiguous container (std::vector, std::array, std::string...) for transmission
+     */
+    template<class Container>
+    esp_err_t write(const Container &buf, uint32_t timeout_ms = 100)
+    {
+        return write(reinterpret_cast<const uint8_t *>(buf.data()), buf.size() * sizeof(*buf.data()), timeout_ms);
+    }
+
+    /**
+     * @brief Wait until all queued data are sent
+     *
+     * @param[in] timeout_ms Timeout in [ms]
+     * @return esp_err_t Error of the first failed transfer since last flush, ESP_ERR_TIMEOUT if data are still in flight
+     */
+    esp_err_t flush(uint32_t timeout_ms = 1000);
+
+    /**
+     * @brief Number of queued writes that are not sent yet
+     *
+     * Use this for backpressure: the producer can slow down while this number grows.
+     */
+    size_t tx_pending() const noexcept
+    {
+        return pending.load();
+    }
+
+    /**
+     * @brief Underlying device, e.g. for line coding
+     */
+    CdcAcmDevice *device() const noexcept
+    {
+        return dev.get();
+    }
+
+private:
+    static void tx_done(cdc_acm_dev_hdl_t cdc_hdl, esp_err_t result, void *user_arg);
+    size_t chunk_size;
+    std::atomic<size_t> pending;
+    std::atomic<esp_err_t> first_error;
+    SemaphoreHandle_t idle;
+    std::unique_ptr<CdcAcmDevice> dev; // Declared last, so that it is closed before the other members are destroyed
+};
 }  // namespace esp_usb
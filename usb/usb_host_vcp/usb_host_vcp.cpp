@@ -4,16 +4,56 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <mutex>
 #include <stdexcept>
 #include "usb/vcp.hpp"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
 
 static const char *TAG = "VCP service";
 
+// Keys of newly connected devices supported by a registered driver, see VCP::driver_key()
+static QueueHandle_t new_dev_queue = NULL;
+static std::mutex new_dev_mutex; // Only one VCP::open() can wait for new devices at a time
+
 namespace esp_usb {
 std::vector<VCP::vcp_driver> VCP::drivers;
+std::unordered_map<uint32_t, size_t> VCP::driver_index;
+
+/**
+ * @brief Open device with a driver
+ *
+ * @return Opened device, nullptr if the device was not found
+ * @throw std::bad_alloc if there is not enough memory
+ * @throw esp_err_t on other errors
+ */
+CdcAcmDevice *VCP::open_driver(const vcp_driver &drv, uint16_t pid, const cdc_acm_host_device_config_t *dev_config, uint8_t interface_idx)
+{
+    try {
+        return drv.open(pid, dev_config, interface_idx);
+    } catch (esp_err_t &e) {
+        switch (e) {
+        case ESP_ERR_NOT_FOUND: return nullptr;
+        case ESP_ERR_NO_MEM: throw std::bad_alloc();
+        default: throw;
+        }
+    }
+}
+
+void VCP::new_dev_cb(usb_device_handle_t usb_dev)
+{
+    const usb_device_desc_t *device_desc;
+    if (usb_host_get_device_descriptor(usb_dev, &device_desc) != ESP_OK) {
+        return;
+    }
+    const uint32_t key = driver_key(device_desc->idVendor, device_desc->idProduct);
+    if (driver_index.find(key) != driver_index.end()) {
+        xQueueSend(new_dev_queue, &key, 0);
+    }
+}
+
 CdcAcmDevice *VCP::open(uint16_t _vid, uint16_t _pid, const cdc_acm_host_device_config_t *dev_config, uint8_t interface_idx)
 {
     // In case user didn't install CDC-ACM driver, we try to install it here.
@@ -24,24 +64,15 @@ CdcAcmDevice *VCP::open(uint16_t _vid, uint16_t _pid, const cdc_acm_host_device_
     default: ESP_LOGE(TAG, "Failed to install CDC-ACM driver"); return nullptr;
     }
 
-    for (vcp_driver drv : drivers) {
-        if (drv.vid == _vid) {
-            for (uint16_t p : drv.pids) {
-                if (p == _pid) {
-                    try {
-                        return drv.open(_pid, dev_config, interface_idx);
-                    } catch (esp_err_t &e) {
-                        switch (e) {
-                        case ESP_ERR_NO_MEM: throw std::bad_alloc();
-                        case ESP_ERR_NOT_FOUND: // fallthrough
-                        default: return nullptr;
-                        }
-                    }
-                }
-            }
-        }
+    const auto it = driver_index.find(driver_key(_vid, _pid));
+    if (it == driver_index.end()) {
+        return nullptr;
+    }
+    try {
+        return open_driver(drivers[it->second], _pid, dev_config, interface_idx);
+    } catch (esp_err_t &e) {
+        return nullptr;
     }
-    return nullptr;
 }
 
 CdcAcmDevice *VCP::open(const cdc_acm_host_device_config_t *dev_config, uint8_t interface_idx)
@@ -64,23 +95,54 @@ CdcAcmDevice *VCP::open(const cdc_acm_host_device_config_t *dev_config, uint8_t
     cdc_acm_host_device_config_t _config = *dev_config;
     _config.connection_timeout_ms = 1;
 
-    // Try opening all registered devices, return on first success
-    do {
-        for (vcp_driver drv : drivers) {
-            for (uint16_t pid : drv.pids) {
-                try {
-                    return drv.open(pid, &_config, interface_idx);
-                } catch (esp_err_t &e) {
-                    switch (e) {
-                    case ESP_ERR_NOT_FOUND: break;
-                    case ESP_ERR_NO_MEM: throw std::bad_alloc();
-                    default: return nullptr;
-                    }
-                }
+    std::lock_guard<std::mutex> lock(new_dev_mutex);
+    if (new_dev_queue == NULL) {
+        new_dev_queue = xQueueCreate(4, sizeof(uint32_t)); // Never deleted, the callback may still run after it is unregistered
+        if (new_dev_queue == NULL) {
+            throw std::bad_alloc();
+        }
+    }
+    xQueueReset(new_dev_queue);
+    // Register the callback before trying connected devices, so that a device connected meanwhile is not missed
+    cdc_acm_host_register_new_dev_callback(new_dev_cb);
+
+    CdcAcmDevice *dev = nullptr;
+    try {
+        dev = wait_and_open(&_config, interface_idx, &connection_timeout, timeout_ticks);
+    } catch (esp_err_t &e) {
+        dev = nullptr;
+    } catch (...) {
+        cdc_acm_host_register_new_dev_callback(NULL);
+        throw;
+    }
+    cdc_acm_host_register_new_dev_callback(NULL);
+    return dev;
+}
+
+CdcAcmDevice *VCP::wait_and_open(const cdc_acm_host_device_config_t *dev_config, uint8_t interface_idx, TimeOut_t *connection_timeout, TickType_t timeout_ticks)
+{
+    // Try opening all registered devices, that are already connected
+    for (const vcp_driver &drv : drivers) {
+        for (uint16_t pid : drv.pids) {
+            CdcAcmDevice *dev = open_driver(drv, pid, dev_config, interface_idx);
+            if (dev) {
+                return dev;
             }
         }
-        vTaskDelay(pdMS_TO_TICKS(50));
-    } while (xTaskCheckForTimeOut(&connection_timeout, &timeout_ticks) == pdFALSE);
+    }
+
+    // Wait for a supported device to be connected and open it immediately
+    do {
+        uint32_t key;
+        if (xQueueReceive(new_dev_queue, &key, timeout_ticks) != pdTRUE) {
+            continue;
+        }
+        const uint16_t pid = key & 0xFFFF;
+        CdcAcmDevice *dev = open_driver(drivers[driver_index.at(key)], pid, dev_config, interface_idx);
+        if (dev) {
+            return dev;
+        }
+    } while (xTaskCheckForTimeOut(connection_timeout, &timeout_ticks) == pdFALSE);
     return nullptr;
 }
 } // namespace esp_usb
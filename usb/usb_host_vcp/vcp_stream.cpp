@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <new>
+#include "usb/vcp.hpp"
+#include "esp_log.h"
+#include "freertos/task.h"
+
+static const char *TAG = "VCP stream";
+
+namespace esp_usb {
+std::unique_ptr<VCP::Stream> VCP::Stream::open(const cdc_acm_host_device_config_t *dev_config, uint8_t interface_idx)
+{
+    if (dev_config->rx_ringbuf_size == 0 || dev_config->out_transfer_count == 0) {
+        ESP_LOGE(TAG, "Stream requires rx_ringbuf_size and out_transfer_count");
+        return nullptr;
+    }
+    CdcAcmDevice *dev = VCP::open(dev_config, interface_idx);
+    if (dev == nullptr) {
+        return nullptr;
+    }
+    return std::unique_ptr<Stream>(new Stream(dev, dev_config->out_buffer_size));
+}
+
+VCP::Stream::Stream(CdcAcmDevice *_dev, size_t out_buffer_size)
+    : chunk_size(out_buffer_size), pending(0), first_error(ESP_OK), idle(xSemaphoreCreateBinary()), dev(_dev)
+{
+    if (idle == nullptr) {
+        throw std::bad_alloc();
+    }
+}
+
+VCP::Stream::~Stream()
+{
+    // Closing the device completes the writes in flight, their callbacks still use this object
+    dev.reset();
+    vSemaphoreDelete(idle);
+}
+
+VCP::Stream::RxBuffer VCP::Stream::read(uint32_t timeout_ms, size_t max_len)
+{
+    const uint8_t *data;
+    size_t len;
+    if (dev->read_acquire(&data, &len, max_len, timeout_ms) != ESP_OK) {
+        return RxBuffer();
+    }
+    return RxBuffer(dev.get(), data, len);
+}
+
+esp_err_t VCP::Stream::write(const uint8_t *data, size_t len, uint32_t timeout_ms)
+{
+    while (len > 0) {
+        const size_t chunk = std::min(len, chunk_size);
+        pending++;
+        const esp_err_t ret = dev->tx_async(data, chunk, tx_done, this, timeout_ms);
+        if (ret != ESP_OK) {
+            pending--;
+            return ret;
+        }
+        data += chunk;
+        len -= chunk;
+    }
+    return ESP_OK;
+}
+
+esp_err_t VCP::Stream::flush(uint32_t timeout_ms)
+{
+    TickType_t timeout_ticks = pdMS_TO_TICKS(timeout_ms);
+    TimeOut_t timeout;
+    vTaskSetTimeOutState(&timeout);
+    // The semaphore may have been given before earlier writes were done, the number of pending writes is checked again
+    while (pending.load() != 0) {
+        if (xTaskCheckForTimeOut(&timeout, &timeout_ticks) != pdFALSE) {
+            return ESP_ERR_TIMEOUT;
+        }
+        xSemaphoreTake(idle, timeout_ticks);
+    }
+    return first_error.exchange(ESP_OK);
+}
+
+void VCP::Stream::tx_done(cdc_acm_dev_hdl_t cdc_hdl, esp_err_t result, void *user_arg)
+{
+    Stream *stream = static_cast<Stream *>(user_arg);
+    if (result != ESP_OK) {
+        esp_err_t expected = ESP_OK;
+        stream->first_error.compare_exchange_strong(expected, result);
+    }
+    if (--stream->pending == 0) {
+        xSemaphoreGive(stream->idle);
+    }
+}
+} // namespace esp_usb
@@ -0,0 +1,311 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Format of the compressed stream
+ */
+typedef enum {
+    ZLIB_STREAM_FORMAT_ZLIB,    /*!< zlib wrapper (RFC 1950) */
+    ZLIB_STREAM_FORMAT_GZIP,    /*!< gzip wrapper (RFC 1952), e.g. "Content-Encoding: gzip" */
+    ZLIB_STREAM_FORMAT_RAW,     /*!< Raw deflate data (RFC 1951) */
+    ZLIB_STREAM_FORMAT_AUTO,    /*!< zlib or gzip, detected from the header */
+} zlib_stream_format_t;
+
+/**
+ * @brief Streaming inflate configuration
+ */
+typedef struct {
+    zlib_stream_format_t format;    /*!< Format of the compressed stream */
+    int window_bits;                /*!< Base two logarithm of the window size, 8..15. Must be at least the
+                                         window size the data was compressed with, 15 is always safe */
+    void *work_mem;                 /*!< Memory holding the decoder state, window and output buffer, e.g. a
+                                         static or PSRAM buffer. NULL to allocate them from the heap */
+    size_t work_mem_size;           /*!< Size of work_mem, see ZLIB_INFLATE_WORK_MEM_SIZE() */
+    size_t out_buf_size;            /*!< Size of the output buffer, the largest chunk passed to the output callback */
+} zlib_inflate_config_t;
+
+/** Default configuration: auto-detected format, 32 kB window, heap memory */
+#define ZLIB_INFLATE_DEFAULT_CONFIG() {     \
+    .format = ZLIB_STREAM_FORMAT_AUTO,      \
+    .window_bits = 15,                      \
+    .work_mem = NULL,                       \
+    .work_mem_size = 0,                     \
+    .out_buf_size = 1024,                   \
+}
+
+/**
+ * @brief Size of work_mem needed for a configuration
+ *
+ * Covers the inflate state of zlib (about 7 kB), the window and the output buffer.
+ */
+#define ZLIB_INFLATE_WORK_MEM_SIZE(window_bits, out_buf_size) (8192 + (1 << (window_bits)) + (out_buf_size))
+
+/**
+ * @brief Output callback, called with each chunk of decompressed data
+ *
+ * @return ESP_OK to continue, any other value aborts decoding and is returned to the caller
+ */
+typedef esp_err_t (*zlib_stream_write_cb_t)(void *ctx, const uint8_t *data, size_t len);
+
+/**
+ * @brief Input callback of zlib_inflate_stream()
+ *
+ * Points *data to the next chunk of compressed data, which must stay valid until the
+ * next call of the callback.
+ *
+ * @return Length of the chunk, 0 at the end of the input, or a negative value on error
+ */
+typedef int (*zlib_stream_read_cb_t)(void *ctx, const uint8_t **data);
+
+/**
+ * @brief Handle of a streaming decoder
+ */
+typedef struct zlib_inflate *zlib_inflate_handle_t;
+
+/**
+ * @brief Create a streaming decoder
+ *
+ * @param[in]  config    Decoder configuration
+ * @param[in]  write_cb  Callback receiving the decompressed data
+ * @param[in]  ctx       Argument of write_cb
+ * @param[out] ret_handle  Created decoder
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid configuration
+ *     - ESP_ERR_NO_MEM: work_mem is too small, or out of heap memory
+ */
+esp_err_t zlib_inflate_new(const zlib_inflate_config_t *config, zlib_stream_write_cb_t write_cb, void *ctx,
+                           zlib_inflate_handle_t *ret_handle);
+
+/**
+ * @brief Decompress a chunk of input
+ *
+ * Calls the output callback for all the data which can be decompressed from the input
+ * received so far. Input following the end of the compressed stream is ignored.
+ *
+ * @param[in] handle  Decoder
+ * @param[in] data    Compressed data
+ * @param[in] len     Length of data
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_RESPONSE: The input is not valid compressed data
+ *     - ESP_ERR_NO_MEM: work_mem is too small for the window
+ *     - Error returned by the output callback
+ */
+esp_err_t zlib_inflate_feed(zlib_inflate_handle_t handle, const void *data, size_t len);
+
+/**
+ * @brief Check that the whole compressed stream was decoded
+ *
+ * @param[in] handle  Decoder
+ *
+ * @return
+ *     - ESP_OK: The end of the compressed stream was reached and its checksum matched
+ *     - ESP_ERR_INVALID_SIZE: The input ended before the end of the compressed stream
+ */
+esp_err_t zlib_inflate_finish(zlib_inflate_handle_t handle);
+
+/**
+ * @brief Reset a decoder to decode a new stream, keeping its memory
+ *
+ * @param[in] handle  Decoder
+ *
+ * @return
+ *     - ESP_OK: Success
+ */
+esp_err_t zlib_inflate_reset(zlib_inflate_handle_t handle);
+
+/**
+ * @brief Delete a decoder
+ *
+ * The work_mem of the configuration can be reused once this returns.
+ *
+ * @param[in] handle  Decoder, may be NULL
+ */
+void zlib_inflate_delete(zlib_inflate_handle_t handle);
+
+/**
+ * @brief Decompress a whole stream from an input callback to an output callback
+ *
+ * @param[in] config    Decoder configuration
+ * @param[in] read_cb   Callback providing the compressed data
+ * @param[in] read_ctx  Argument of read_cb
+ * @param[in] write_cb  Callback receiving the decompressed data
+ * @param[in] write_ctx Argument of write_cb
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_FAIL: The input callback returned an error
+ *     - Errors of zlib_inflate_new(), zlib_inflate_feed() and zlib_inflate_finish()
+ */
+esp_err_t zlib_inflate_stream(const zlib_inflate_config_t *config,
+                              zlib_stream_read_cb_t read_cb, void *read_ctx,
+                              zlib_stream_write_cb_t write_cb, void *write_ctx);
+
+/**
+ * @brief Streaming deflate configuration
+ *
+ * The encoder needs (1 << (window_bits + 2)) + (1 << (mem_level + 9)) bytes for its
+ * window and hash tables, plus about 6 kB of state. zlib's deflateInit() defaults
+ * (window_bits 15, mem_level 8) take about 256 kB.
+ */
+typedef struct {
+    zlib_stream_format_t format;    /*!< Format of the compressed stream, ZLIB_STREAM_FORMAT_AUTO is not allowed */
+    int level;                      /*!< Compression level, 0..9 or Z_DEFAULT_COMPRESSION (-1) */
+    int window_bits;                /*!< Base two logarithm of the window size, 9..15 */
+    int mem_level;                  /*!< Memory used for the match hash table, 1..9 */
+    void *work_mem;                 /*!< Memory holding the encoder state, window, tables and output buffer,
+                                         e.g. a static or PSRAM buffer. NULL to allocate them from the heap */
+    size_t work_mem_size;           /*!< Size of work_mem, see ZLIB_DEFLATE_WORK_MEM_SIZE() */
+    size_t out_buf_size;            /*!< Size of the output buffer, the largest chunk passed to the output callback */
+} zlib_deflate_config_t;
+
+/** Balanced profile: zlib format, 4 kB window, about 38 kB of memory */
+#define ZLIB_DEFLATE_DEFAULT_CONFIG() {     \
+    .format = ZLIB_STREAM_FORMAT_ZLIB,      \
+    .level = 6,                             \
+    .window_bits = 12,                      \
+    .mem_level = 5,                         \
+    .work_mem = NULL,                       \
+    .work_mem_size = 0,                     \
+    .out_buf_size = 1024,                   \
+}
+
+/** Low memory profile for logs and telemetry: zlib format, 1 kB window, about 19 kB of memory */
+#define ZLIB_DEFLATE_LOW_MEM_CONFIG() {     \
+    .format = ZLIB_STREAM_FORMAT_ZLIB,      \
+    .level = 6,                             \
+    .window_bits = 10,                      \
+    .mem_level = 4,                         \
+    .work_mem = NULL,                       \
+    .work_mem_size = 0,                     \
+    .out_buf_size = 512,                    \
+}
+
+/**
+ * @brief Size of work_mem needed for a deflate configuration
+ */
+#define ZLIB_DEFLATE_WORK_MEM_SIZE(window_bits, mem_level, out_buf_size) \
+    (8192 + (1 << ((window_bits) + 2)) + (1 << ((mem_level) + 9)) + (out_buf_size))
+
+/**
+ * @brief Handle of a streaming encoder
+ */
+typedef struct zlib_deflate *zlib_deflate_handle_t;
+
+/**
+ * @brief Create a streaming encoder
+ *
+ * @param[in]  config    Encoder configuration
+ * @param[in]  write_cb  Callback receiving the compressed data
+ * @param[in]  ctx       Argument of write_cb
+ * @param[out] ret_handle  Created encoder
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid configuration
+ *     - ESP_ERR_NO_MEM: work_mem is too small, or out of heap memory
+ */
+esp_err_t zlib_deflate_new(const zlib_deflate_config_t *config, zlib_stream_write_cb_t write_cb, void *ctx,
+                           zlib_deflate_handle_t *ret_handle);
+
+/**
+ * @brief Compress a chunk of input
+ *
+ * The output callback is called whenever the output buffer fills up.
+ *
+ * @param[in] handle  Encoder
+ * @param[in] data    Data to compress
+ * @param[in] len     Length of data
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_STATE: zlib_deflate_finish() was already called
+ *     - Error returned by the output callback
+ */
+esp_err_t zlib_deflate_feed(zlib_deflate_handle_t handle, const void *data, size_t len);
+
+/**
+ * @brief Output all the data compressed so far
+ *
+ * Ends the current deflate block on a byte boundary, so that a receiver can decompress
+ * everything fed so far, e.g. at the end of a telemetry batch. Flushing often reduces
+ * the compression ratio.
+ *
+ * @param[in] handle  Encoder
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_STATE: zlib_deflate_finish() was already called
+ *     - Error returned by the output callback
+ */
+esp_err_t zlib_deflate_flush(zlib_deflate_handle_t handle);
+
+/**
+ * @brief End the compressed stream
+ *
+ * Outputs the remaining data and the stream trailer.
+ *
+ * @param[in] handle  Encoder
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - Error returned by the output callback
+ */
+esp_err_t zlib_deflate_finish(zlib_deflate_handle_t handle);
+
+/**
+ * @brief Reset an encoder to compress a new stream, keeping its memory
+ *
+ * @param[in] handle  Encoder
+ *
+ * @return
+ *     - ESP_OK: Success
+ */
+esp_err_t zlib_deflate_reset(zlib_deflate_handle_t handle);
+
+/**
+ * @brief Delete an encoder
+ *
+ * The work_mem of the configuration can be reused once this returns.
+ *
+ * @param[in] handle  Encoder, may be NULL
+ */
+void zlib_deflate_delete(zlib_deflate_handle_t handle);
+
+/**
+ * @brief Compress a whole stream from an input callback to an output callback
+ *
+ * @param[in] config    Encoder configuration
+ * @param[in] read_cb   Callback providing the data to compress
+ * @param[in] read_ctx  Argument of read_cb
+ * @param[in] write_cb  Callback receiving the compressed data
+ * @param[in] write_ctx Argument of write_cb
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_FAIL: The input callback returned an error
+ *     - Errors of zlib_deflate_new(), zlib_deflate_feed() and zlib_deflate_finish()
+ */
+esp_err_t zlib_deflate_stream(const zlib_deflate_config_t *config,
+                              zlib_stream_read_cb_t read_cb, void *read_ctx,
+                              zlib_stream_write_cb_t write_cb, void *write_ctx);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,33 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+
+#if CONFIG_ZLIB_CRC32_USE_ROM
+#include <stdint.h>
+#include "esp_rom_crc.h"
+#include "zlib.h"
+
+/* Replace zlib's crc32() and crc32_z() with the ROM implementation, through -Wl,--wrap */
+
+uLong __wrap_crc32_z(uLong crc, const Bytef *buf, z_size_t len)
+{
+    if (buf == Z_NULL) {
+        return 0;
+    }
+    while (len > UINT32_MAX) {
+        crc = esp_rom_crc32_le(crc, buf, UINT32_MAX);
+        buf += UINT32_MAX;
+        len -= UINT32_MAX;
+    }
+    return esp_rom_crc32_le(crc, buf, len);
+}
+
+uLong __wrap_crc32(uLong crc, const Bytef *buf, uInt len)
+{
+    return __wrap_crc32_z(crc, buf, len);
+}
+#endif // CONFIG_ZLIB_CRC32_USE_ROM
@@ -0,0 +1,367 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_check.h"
+#include "zlib.h"
+#include "zlib_stream.h"
+
+static const char *TAG = "zlib_stream";
+
+#define WORK_MEM_ALIGN 8
+
+/* Bump allocator over the part of work_mem following the handle */
+typedef struct {
+    uint8_t *next;
+    uint8_t *end;
+} work_mem_t;
+
+/* Common part of the inflate and deflate handles */
+typedef struct {
+    z_stream strm;
+    zlib_stream_write_cb_t write_cb;
+    void *ctx;
+    uint8_t *out_buf;
+    size_t out_buf_size;
+    bool done;
+    bool heap;                      /* Allocated from the heap rather than work_mem */
+    work_mem_t mem;
+} zlib_stream_t;
+
+struct zlib_inflate {
+    zlib_stream_t s;
+};
+
+struct zlib_deflate {
+    zlib_stream_t s;
+};
+
+static void *work_mem_alloc(work_mem_t *mem, size_t size)
+{
+    uintptr_t next = ((uintptr_t)mem->next + WORK_MEM_ALIGN - 1) & ~(uintptr_t)(WORK_MEM_ALIGN - 1);
+    if (next > (uintptr_t)mem->end || size > (uintptr_t)mem->end - next) {
+        return NULL;
+    }
+    mem->next = (uint8_t *)(next + size);
+    return (void *)next;
+}
+
+static voidpf work_mem_zalloc(voidpf opaque, uInt items, uInt size)
+{
+    if (size != 0 && items > SIZE_MAX / size) {
+        return Z_NULL;
+    }
+    return work_mem_alloc((work_mem_t *)opaque, (size_t)items * size);
+}
+
+/* Memory of work_mem is released all at once with the decoder */
+static void work_mem_zfree(voidpf opaque, voidpf address)
+{
+}
+
+static int to_zlib_window_bits(zlib_stream_format_t format, int window_bits)
+{
+    switch (format) {
+    case ZLIB_STREAM_FORMAT_GZIP:
+        return window_bits + 16;
+    case ZLIB_STREAM_FORMAT_RAW:
+        return -window_bits;
+    case ZLIB_STREAM_FORMAT_AUTO:
+        return window_bits + 32;
+    case ZLIB_STREAM_FORMAT_ZLIB:
+    default:
+        return window_bits;
+    }
+}
+
+/*
+ * Allocates a handle of handle_size bytes starting with a zlib_stream_t, with its output
+ * buffer, from work_mem or from the heap.
+ */
+static esp_err_t stream_alloc(size_t handle_size, void *work_mem, size_t work_mem_size, size_t out_buf_size,
+                              zlib_stream_write_cb_t write_cb, void *ctx, zlib_stream_t **ret_stream)
+{
+    ESP_RETURN_ON_FALSE(write_cb && ret_stream, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(out_buf_size > 0, ESP_ERR_INVALID_ARG, TAG, "out_buf_size must not be 0");
+
+    zlib_stream_t *stream;
+    if (work_mem) {
+        ESP_RETURN_ON_FALSE(((uintptr_t)work_mem & (WORK_MEM_ALIGN - 1)) == 0, ESP_ERR_INVALID_ARG, TAG,
+                            "work_mem must be %d byte aligned", WORK_MEM_ALIGN);
+        ESP_RETURN_ON_FALSE(work_mem_size >= handle_size + out_buf_size, ESP_ERR_NO_MEM, TAG,
+                            "work_mem too small");
+        stream = work_mem;
+        memset(stream, 0, handle_size);
+        stream->mem.next = (uint8_t *)work_mem + handle_size;
+        stream->mem.end = (uint8_t *)work_mem + work_mem_size;
+        stream->out_buf = work_mem_alloc(&stream->mem, out_buf_size);
+        stream->strm.zalloc = work_mem_zalloc;
+        stream->strm.zfree = work_mem_zfree;
+        stream->strm.opaque = &stream->mem;
+    } else {
+        stream = calloc(1, handle_size + out_buf_size);
+        ESP_RETURN_ON_FALSE(stream, ESP_ERR_NO_MEM, TAG, "Failed to allocate stream");
+        stream->heap = true;
+        stream->out_buf = (uint8_t *)stream + handle_size;
+        stream->strm.zalloc = Z_NULL;
+        stream->strm.zfree = Z_NULL;
+        stream->strm.opaque = Z_NULL;
+    }
+    stream->out_buf_size = out_buf_size;
+    stream->write_cb = write_cb;
+    stream->ctx = ctx;
+    *ret_stream = stream;
+    return ESP_OK;
+}
+
+static void stream_free(zlib_stream_t *stream)
+{
+    if (stream->heap) {
+        free(stream);
+    }
+}
+
+static esp_err_t init_error(zlib_stream_t *stream, const char *func, int ret)
+{
+    ESP_LOGE(TAG, "%s failed: %d", func, ret);
+    stream_free(stream);
+    return ret == Z_MEM_ERROR ? ESP_ERR_NO_MEM : ESP_FAIL;
+}
+
+/*
+ * Runs inflate() or deflate() with the given flush mode until the input is consumed
+ * and no output is pending, passing the output to the callback.
+ */
+static esp_err_t stream_run(zlib_stream_t *stream, int (*func)(z_streamp, int), int flush)
+{
+    z_stream *strm = &stream->strm;
+    do {
+        strm->next_out = stream->out_buf;
+        strm->avail_out = stream->out_buf_size;
+        int ret = func(strm, flush);
+        size_t produced = stream->out_buf_size - strm->avail_out;
+        if (produced > 0) {
+            esp_err_t err = stream->write_cb(stream->ctx, stream->out_buf, produced);
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
+        switch (ret) {
+        case Z_STREAM_END:
+            stream->done = true;
+            return ESP_OK;
+        case Z_OK:
+            break;
+        case Z_BUF_ERROR:
+            /* No progress possible, more input is needed */
+            return ESP_OK;
+        case Z_MEM_ERROR:
+            ESP_LOGE(TAG, "Out of memory");
+            return ESP_ERR_NO_MEM;
+        default:
+            ESP_LOGE(TAG, "zlib error %d: %s", ret, strm->msg ? strm->msg : "unknown error");
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        /* A full output buffer may leave data pending inside zlib */
+    } while (strm->avail_in > 0 || strm->avail_out == 0);
+    return ESP_OK;
+}
+
+esp_err_t zlib_inflate_new(const zlib_inflate_config_t *config, zlib_stream_write_cb_t write_cb, void *ctx,
+                           zlib_inflate_handle_t *ret_handle)
+{
+    ESP_RETURN_ON_FALSE(config && ret_handle, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(config->window_bits >= 8 && config->window_bits <= 15, ESP_ERR_INVALID_ARG, TAG,
+                        "window_bits must be within 8..15");
+    ESP_RETURN_ON_FALSE(config->format <= ZLIB_STREAM_FORMAT_AUTO, ESP_ERR_INVALID_ARG, TAG, "Invalid format");
+
+    zlib_stream_t *stream;
+    ESP_RETURN_ON_ERROR(stream_alloc(sizeof(struct zlib_inflate), config->work_mem, config->work_mem_size,
+                                     config->out_buf_size, write_cb, ctx, &stream), TAG, "Failed to create decoder");
+
+    int ret = inflateInit2(&stream->strm, to_zlib_window_bits(config->format, config->window_bits));
+    if (ret != Z_OK) {
+        return init_error(stream, "inflateInit2", ret);
+    }
+    *ret_handle = (zlib_inflate_handle_t)stream;
+    return ESP_OK;
+}
+
+esp_err_t zlib_inflate_feed(zlib_inflate_handle_t handle, const void *data, size_t len)
+{
+    ESP_RETURN_ON_FALSE(handle && (data || len == 0), ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    if (handle->s.done) {
+        return ESP_OK;
+    }
+    handle->s.strm.next_in = (z_const Bytef *)data;
+    handle->s.strm.avail_in = len;
+    return stream_run(&handle->s, inflate, Z_NO_FLUSH);
+}
+
+esp_err_t zlib_inflate_finish(zlib_inflate_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    return handle->s.done ? ESP_OK : ESP_ERR_INVALID_SIZE;
+}
+
+esp_err_t zlib_inflate_reset(zlib_inflate_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    handle->s.done = false;
+    return inflateReset(&handle->s.strm) == Z_OK ? ESP_OK : ESP_FAIL;
+}
+
+void zlib_inflate_delete(zlib_inflate_handle_t handle)
+{
+    if (!handle) {
+        return;
+    }
+    inflateEnd(&handle->s.strm);
+    stream_free(&handle->s);
+}
+
+esp_err_t zlib_inflate_stream(const zlib_inflate_config_t *config,
+                              zlib_stream_read_cb_t read_cb, void *read_ctx,
+                              zlib_stream_write_cb_t write_cb, void *write_ctx)
+{
+    ESP_RETURN_ON_FALSE(read_cb, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+
+    zlib_inflate_handle_t handle;
+    esp_err_t err = zlib_inflate_new(config, write_cb, write_ctx, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    while (!handle->s.done) {
+        const uint8_t *data = NULL;
+        int len = read_cb(read_ctx, &data);
+        if (len < 0) {
+            ESP_LOGE(TAG, "Read callback failed: %d", len);
+            err = ESP_FAIL;
+            break;
+        }
+        if (len == 0) {
+            break;
+        }
+        err = zlib_inflate_feed(handle, data, len);
+        if (err != ESP_OK) {
+            break;
+        }
+    }
+    if (err == ESP_OK) {
+        err = zlib_inflate_finish(handle);
+    }
+    zlib_inflate_delete(handle);
+    return err;
+}
+
+esp_err_t zlib_deflate_new(const zlib_deflate_config_t *config, zlib_stream_write_cb_t write_cb, void *ctx,
+                           zlib_deflate_handle_t *ret_handle)
+{
+    ESP_RETURN_ON_FALSE(config && ret_handle, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(config->window_bits >= 9 && config->window_bits <= 15, ESP_ERR_INVALID_ARG, TAG,
+                        "window_bits must be within 9..15");
+    ESP_RETURN_ON_FALSE(config->mem_level >= 1 && config->mem_level <= 9, ESP_ERR_INVALID_ARG, TAG,
+                        "mem_level must be within 1..9");
+    ESP_RETURN_ON_FALSE(config->format != ZLIB_STREAM_FORMAT_AUTO && config->format <= ZLIB_STREAM_FORMAT_AUTO,
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid format");
+
+    zlib_stream_t *stream;
+    ESP_RETURN_ON_ERROR(stream_alloc(sizeof(struct zlib_deflate), config->work_mem, config->work_mem_size,
+                                     config->out_buf_size, write_cb, ctx, &stream), TAG, "Failed to create encoder");
+
+    int ret = deflateInit2(&stream->strm, config->level, Z_DEFLATED,
+                           to_zlib_window_bits(config->format, config->window_bits),
+                           config->mem_level, Z_DEFAULT_STRATEGY);
+    if (ret != Z_OK) {
+        return init_error(stream, "deflateInit2", ret);
+    }
+    *ret_handle = (zlib_deflate_handle_t)stream;
+    return ESP_OK;
+}
+
+esp_err_t zlib_deflate_feed(zlib_deflate_handle_t handle, const void *data, size_t len)
+{
+    ESP_RETURN_ON_FALSE(handle && (data || len == 0), ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(!handle->s.done, ESP_ERR_INVALID_STATE, TAG, "Stream already finished");
+    if (len == 0) {
+        return ESP_OK;
+    }
+    handle->s.strm.next_in = (z_const Bytef *)data;
+    handle->s.strm.avail_in = len;
+    return stream_run(&handle->s, deflate, Z_NO_FLUSH);
+}
+
+esp_err_t zlib_deflate_flush(zlib_deflate_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(!handle->s.done, ESP_ERR_INVALID_STATE, TAG, "Stream already finished");
+    handle->s.strm.avail_in = 0;
+    return stream_run(&handle->s, deflate, Z_SYNC_FLUSH);
+}
+
+esp_err_t zlib_deflate_finish(zlib_deflate_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    if (handle->s.done) {
+        return ESP_OK;
+    }
+    handle->s.strm.avail_in = 0;
+    esp_err_t err = stream_run(&handle->s, deflate, Z_FINISH);
+    if (err == ESP_OK && !handle->s.done) {
+        err = ESP_FAIL;
+    }
+    return err;
+}
+
+esp_err_t zlib_deflate_reset(zlib_deflate_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    handle->s.done = false;
+    return deflateReset(&handle->s.strm) == Z_OK ? ESP_OK : ESP_FAIL;
+}
+
+void zlib_deflate_delete(zlib_deflate_handle_t handle)
+{
+    if (!handle) {
+        return;
+    }
+    deflateEnd(&handle->s.strm);
+    stream_free(&handle->s);
+}
+
+esp_err_t zlib_deflate_stream(const zlib_deflate_config_t *config,
+                              zlib_stream_read_cb_t read_cb, void *read_ctx,
+                              zlib_stream_write_cb_t write_cb, void *write_ctx)
+{
+    ESP_RETURN_ON_FALSE(read_cb, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+
+    zlib_deflate_handle_t handle;
+    esp_err_t err = zlib_deflate_new(config, write_cb, write_ctx, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    while (true) {
+        const uint8_t *data = NULL;
+        int len = read_cb(read_ctx, &data);
+        if (len < 0) {
+            ESP_LOGE(TAG, "Read callback failed: %d", len);
+            err = ESP_FAIL;
+            break;
+        }
+        if (len == 0) {
+            err = zlib_deflate_finish(handle);
+            break;
+        }
+        err = zlib_deflate_feed(handle, data, len);
+        if (err != ESP_OK) {
+            break;
+        }
+    }
+    zlib_deflate_delete(handle);
+    return err;
+}